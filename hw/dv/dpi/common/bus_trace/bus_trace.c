@@ -0,0 +1,139 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// popen() and pclose() are POSIX rather than ISO C.
+#define _POSIX_C_SOURCE 200809L
+
+#include "bus_trace.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUS_TRACE_MAGIC "OTBT"
+#define BUS_TRACE_VERSION 1
+
+#define HDR_BYTES 16
+#define REC_BYTES 16
+
+// Records are collected here and written out in large blocks.
+#define BUF_RECS 4096
+
+struct bus_trace {
+  FILE *file;
+  // Non-zero if file is a pipe to zstd
+  int piped;
+  size_t nrecs;
+  uint8_t buf[BUF_RECS * REC_BYTES];
+};
+
+static void put_le16(uint8_t *p, uint16_t v) {
+  p[0] = v & 0xff;
+  p[1] = v >> 8;
+}
+
+static int has_suffix(const char *s, const char *suffix) {
+  size_t n = strlen(s);
+  size_t m = strlen(suffix);
+  return n >= m && !strcmp(s + n - m, suffix);
+}
+
+static void flush_recs(struct bus_trace *trace) {
+  if (!trace->nrecs) {
+    return;
+  }
+  size_t n = fwrite(trace->buf, REC_BYTES, trace->nrecs, trace->file);
+  if (n != trace->nrecs) {
+    fprintf(stderr, "bus_trace: Write failed: %s\n", strerror(errno));
+  }
+  trace->nrecs = 0;
+}
+
+struct bus_trace *bus_trace_open(const char *path, uint16_t source,
+                                 uint32_t loglevel) {
+  struct bus_trace *trace =
+      (struct bus_trace *)calloc(1, sizeof(struct bus_trace));
+  assert(trace);
+
+  if (has_suffix(path, ".zst")) {
+    size_t cmd_len = strlen(path) + 32;
+    char *cmd = (char *)malloc(cmd_len);
+    assert(cmd);
+    snprintf(cmd, cmd_len, "zstd -q -f -o '%s'", path);
+    trace->file = popen(cmd, "w");
+    trace->piped = 1;
+    free(cmd);
+  } else {
+    trace->file = fopen(path, "wb");
+  }
+  if (!trace->file) {
+    fprintf(stderr, "bus_trace: Unable to open %s: %s\n", path,
+            strerror(errno));
+    free(trace);
+    return NULL;
+  }
+  // We do our own buffering.
+  setvbuf(trace->file, NULL, _IONBF, 0);
+
+  uint8_t hdr[HDR_BYTES] = {0};
+  memcpy(hdr, BUS_TRACE_MAGIC, 4);
+  put_le16(hdr + 4, BUS_TRACE_VERSION);
+  put_le16(hdr + 6, source);
+  bus_trace_put_le32(hdr + 8, loglevel);
+  if (fwrite(hdr, sizeof(hdr), 1, trace->file) != 1) {
+    fprintf(stderr, "bus_trace: Write failed: %s\n", strerror(errno));
+  }
+  return trace;
+}
+
+static void put_record(struct bus_trace *trace, uint32_t tick, uint8_t type,
+                       uint8_t flags, uint8_t aux, const void *data,
+                       size_t len) {
+  assert(len <= BUS_TRACE_REC_DATA);
+  uint8_t *rec = trace->buf + trace->nrecs * REC_BYTES;
+  bus_trace_put_le32(rec, tick);
+  rec[4] = type;
+  rec[5] = flags;
+  rec[6] = (uint8_t)len;
+  rec[7] = aux;
+  memset(rec + 8, 0, BUS_TRACE_REC_DATA);
+  if (len) {
+    memcpy(rec + 8, data, len);
+  }
+  if (++trace->nrecs == BUF_RECS) {
+    flush_recs(trace);
+  }
+}
+
+void bus_trace_record(struct bus_trace *trace, uint32_t tick, uint8_t type,
+                      uint8_t aux, const void *data, size_t len) {
+  put_record(trace, tick, type, 0, aux, data, len);
+}
+
+void bus_trace_payload(struct bus_trace *trace, uint32_t tick, uint8_t type,
+                       uint8_t aux, const void *data, size_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+  do {
+    size_t n = len > BUS_TRACE_REC_DATA ? BUS_TRACE_REC_DATA : len;
+    uint8_t flags = (len > n) ? BUS_TRACE_FLAG_MORE : 0;
+    put_record(trace, tick, type, flags, aux, p, n);
+    p += n;
+    len -= n;
+  } while (len);
+}
+
+void bus_trace_close(struct bus_trace *trace) {
+  if (!trace) {
+    return;
+  }
+  flush_recs(trace);
+  if (trace->piped) {
+    pclose(trace->file);
+  } else {
+    fclose(trace->file);
+  }
+  free(trace);
+}
@@ -0,0 +1,90 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_DPI_COMMON_BUS_TRACE_BUS_TRACE_H_
+#define OPENTITAN_HW_DV_DPI_COMMON_BUS_TRACE_BUS_TRACE_H_
+
+/**
+ * Compact binary traces for DPI bus monitors
+ *
+ * A trace is a 16-byte file header followed by 16-byte records, all fields
+ * little-endian. Monitors emit records instead of formatted text, and
+ * bus_trace_decode.py turns them back into text, JSON or pcap offline. See
+ * README.md for the format.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Values of the source field in the file header
+#define BUS_TRACE_SRC_SPI 1
+#define BUS_TRACE_SRC_USB 2
+
+// Bytes of payload carried by a single record
+#define BUS_TRACE_REC_DATA 8
+
+// Record flag: the payload continues in the next record
+#define BUS_TRACE_FLAG_MORE 0x1
+
+struct bus_trace;
+
+/**
+ * Store a 32-bit value little-endian, for building record payloads
+ */
+static inline void bus_trace_put_le32(uint8_t *p, uint32_t v) {
+  p[0] = v & 0xff;
+  p[1] = (v >> 8) & 0xff;
+  p[2] = (v >> 16) & 0xff;
+  p[3] = v >> 24;
+}
+
+/**
+ * Open a binary trace file
+ *
+ * If path ends in ".zst", the trace is compressed by piping it through the
+ * zstd command-line tool.
+ *
+ * @param path file to write
+ * @param source BUS_TRACE_SRC_* value recorded in the header
+ * @param loglevel log level of the monitor, recorded in the header
+ * @return trace handle, or NULL if the file couldn't be opened
+ */
+struct bus_trace *bus_trace_open(const char *path, uint16_t source,
+                                 uint32_t loglevel);
+
+/**
+ * Append a single record
+ *
+ * @param trace trace handle
+ * @param tick simulation time of the event
+ * @param type monitor-specific record type
+ * @param aux monitor-specific detail, such as a direction
+ * @param data payload bytes (may be NULL if len is 0)
+ * @param len number of payload bytes, at most BUS_TRACE_REC_DATA
+ */
+void bus_trace_record(struct bus_trace *trace, uint32_t tick, uint8_t type,
+                      uint8_t aux, const void *data, size_t len);
+
+/**
+ * Append a payload of any length, split over as many records as needed
+ *
+ * All but the last record have BUS_TRACE_FLAG_MORE set. An empty payload
+ * still produces one record.
+ */
+void bus_trace_payload(struct bus_trace *trace, uint32_t tick, uint8_t type,
+                       uint8_t aux, const void *data, size_t len);
+
+/**
+ * Flush any buffered records and close the trace
+ */
+void bus_trace_close(struct bus_trace *trace);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // OPENTITAN_HW_DV_DPI_COMMON_BUS_TRACE_BUS_TRACE_H_
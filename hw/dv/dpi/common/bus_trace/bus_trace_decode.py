@@ -0,0 +1,412 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Decode binary bus monitor traces written by the SPI and USB DPI models.
+
+The trace format is described in README.md alongside this script. Traces can
+be turned back into the text log that the monitor would have written, into
+JSON (one object per line) or, for USB, into a pcap file that Wireshark can
+dissect (link type USB 2.0).
+"""
+
+import argparse
+import json
+import struct
+import subprocess
+import sys
+
+MAGIC = b'OTBT'
+HDR = struct.Struct('<4sHHI4x')
+REC = struct.Struct('<IBBBB8s')
+FLAG_MORE = 0x1
+
+SRC_SPI = 1
+SRC_USB = 2
+
+# SPI record types and signal bits (see monitor_spi.c and spidpi.h)
+SPI_REC_TITLE = 0
+SPI_REC_SIGNALS = 1
+SPI_REC_TSU = 2
+SPI_REC_PACKET = 3
+SPI_TSU_SDI = 0x1
+SPI_TSU_SDO = 0x2
+P2D_SCK = 0x1
+P2D_CSB = 0x2
+P2D_SDI = 0x4
+D2P_SDO_EN = 0x1
+D2P_SDO = 0x2
+
+# USB record types (see usb_monitor.c)
+USB_REC_TEXT = 0
+USB_REC_CLASH = 1
+USB_REC_IDLE = 2
+USB_REC_SOP = 3
+USB_REC_PID = 4
+USB_REC_BITSTUFF = 5
+USB_REC_PACKET = 6
+
+USB_PID_OUT = 0xE1
+USB_PID_IN = 0x69
+USB_PID_SOF = 0xA5
+USB_PID_SETUP = 0x2D
+USB_PID_DATA0 = 0xC3
+USB_PID_DATA1 = 0x4B
+
+# Must match MON_BYTES_SIZE in usb_monitor.c
+USB_MON_BYTES_SIZE = 1024
+
+# USB full speed bit rate, in bits per microsecond
+USB_BITS_PER_US = 12
+
+PCAP_LINKTYPE_USB_2_0 = 288
+
+PID_NAMES = [
+    'Rsvd', 'OUT', 'ACK', 'DATA0', 'PING', 'SOF', 'NYET', 'DATA2', 'SPLIT',
+    'IN', 'NAK', 'DATA1', 'PRE/ERR', 'SETUP', 'STALL', 'MDATA'
+]
+
+# Waveform drawing, indexed by new value, new enable, old value, old enable
+VERT = [
+    ' | ', '\\  ', ' | ', '  /', '/  ', '|  ', '/  ', ' / ', ' | ', '\\  ',
+    ' | ', '  /', '  \\', ' \\ ', '  \\', '  |'
+]
+
+
+def open_trace(path):
+    '''Return the contents of a trace, decompressing it if need be.'''
+    if path.endswith('.zst'):
+        return subprocess.run(['zstd', '-dc', path],
+                              check=True,
+                              stdout=subprocess.PIPE).stdout
+    with open(path, 'rb') as f:
+        return f.read()
+
+
+def read_events(data):
+    '''Parse a trace into its header fields and a list of events.
+
+    Each event is a tuple of (tick, type, aux, payload), where payloads split
+    over several records have been joined back together.
+    '''
+    if len(data) < HDR.size:
+        raise ValueError('trace is too short')
+    magic, version, source, loglevel = HDR.unpack_from(data)
+    if magic != MAGIC:
+        raise ValueError('not a bus trace (bad magic)')
+    if version != 1:
+        raise ValueError('unsupported trace version {}'.format(version))
+
+    events = []
+    payload = b''
+    for off in range(HDR.size, len(data) - REC.size + 1, REC.size):
+        tick, rtype, flags, length, aux, rdata = REC.unpack_from(data, off)
+        payload += rdata[:length]
+        if flags & FLAG_MORE:
+            continue
+        events.append((tick, rtype, aux, payload))
+        payload = b''
+    return source, loglevel, events
+
+
+def vertical_bit(cur, old, mask, enmask):
+    if enmask:
+        cur_en = 0x4 if cur & enmask else 0
+        old_en = 0x1 if old & enmask else 0
+    else:
+        cur_en = 0x4
+        old_en = 0x1
+    return VERT[(0x8 if cur & mask else 0) | (0x2 if old & mask else 0) |
+                cur_en | old_en]
+
+
+def spi_text(loglevel, events, out):
+    '''Write the text log that monitor_spi() would have produced.'''
+    logpkts = loglevel & 0x8
+    prev_p2d = 0
+    prev_d2p = 0
+    # monitor_spi() ends a line of signals once the tick has been handled
+    pending_nl = False
+    for tick, rtype, aux, payload in events:
+        if rtype == SPI_REC_TITLE:
+            out.write('              CSB SCK MO  MI\n')
+        elif rtype == SPI_REC_SIGNALS:
+            if pending_nl:
+                out.write('\n')
+            p2d, d2p = struct.unpack('<II', payload)
+            out.write('{:8d} SPI: '.format(tick))
+            out.write(vertical_bit(p2d, prev_p2d, P2D_CSB, 0) + '  ')
+            out.write(vertical_bit(p2d, prev_p2d, P2D_SCK, 0) + '  ')
+            out.write(vertical_bit(p2d, prev_p2d, P2D_SDI, 0) + '  ')
+            out.write(vertical_bit(d2p, prev_d2p, D2P_SDO, D2P_SDO_EN) + '  ')
+            prev_p2d, prev_d2p = p2d, d2p
+            pending_nl = bool(logpkts)
+            if not logpkts:
+                out.write('\n')
+        elif rtype == SPI_REC_TSU:
+            if aux & SPI_TSU_SDI:
+                out.write('Check SDI tSU ')
+            if aux & SPI_TSU_SDO:
+                out.write('Check SDO tSU ')
+        elif rtype == SPI_REC_PACKET:
+            n = len(payload) // 2
+            out.write('H>D: ')
+            out.write(''.join('{:02x} '.format(b) for b in payload[:n]))
+            out.write('D>H: ')
+            out.write(''.join('{:02x} '.format(b) for b in payload[n:]))
+            out.write('\n')
+            pending_nl = False
+    if pending_nl:
+        out.write('\n')
+
+
+def spi_json(events, out):
+    for tick, rtype, aux, payload in events:
+        if rtype == SPI_REC_SIGNALS:
+            p2d, d2p = struct.unpack('<II', payload)
+            obj = {'tick': tick, 'event': 'signals', 'p2d': p2d, 'd2p': d2p}
+        elif rtype == SPI_REC_TSU:
+            obj = {
+                'tick': tick,
+                'event': 'tsu',
+                'sdi': bool(aux & SPI_TSU_SDI),
+                'sdo': bool(aux & SPI_TSU_SDO)
+            }
+        elif rtype == SPI_REC_PACKET:
+            n = len(payload) // 2
+            obj = {
+                'tick': tick,
+                'event': 'packet',
+                'h2d': payload[:n].hex(),
+                'd2h': payload[n:].hex()
+            }
+        else:
+            continue
+        out.write(json.dumps(obj) + '\n')
+
+
+def pid_valid(pid):
+    return ((pid ^ 0xf0) >> 4) == (pid & 0xf)
+
+
+def decode_pid(pid):
+    return PID_NAMES[pid & 0xf] if pid_valid(pid) else '???'
+
+
+def crc5(value, nbits):
+    crc = 0x1f
+    for _ in range(nbits):
+        if (value ^ crc) & 1:
+            crc = (crc >> 1) ^ 0x14
+        else:
+            crc >>= 1
+        value >>= 1
+    return crc ^ 0x1f
+
+
+def crc16(data):
+    crc = 0xffff
+    for b in data:
+        for _ in range(8):
+            if (b ^ crc) & 1:
+                crc = (crc >> 1) ^ 0xa001
+            else:
+                crc >>= 1
+            b >>= 1
+    return crc ^ 0xffff
+
+
+def pid_2data(pid, d0, d1):
+    '''Describe a token or short packet, as pid_2data() in usb_monitor.c.'''
+    comp_crc = crc5((d1 & 7) << 8 | d0, 11)
+    crcok = 'OK' if comp_crc == d1 >> 3 else 'BAD'
+    if pid == USB_PID_SOF:
+        return 'SOF {:03x} (CRC5 {:02x} {})'.format((d1 & 7) << 8 | d0,
+                                                    d1 >> 3, crcok)
+    if pid in (USB_PID_SETUP, USB_PID_OUT, USB_PID_IN):
+        return '{} {}.{} (CRC5 {:02x} {})'.format(decode_pid(pid), d0 & 0x7f,
+                                                  (d1 & 7) << 1 | d0 >> 7,
+                                                  d1 >> 3, crcok)
+    if pid in (USB_PID_DATA0, USB_PID_DATA1):
+        return '{} {:02x}, {:02x} ({})'.format(decode_pid(pid), d0, d1,
+                                              'CRC16 BAD' if d0 | d1 else
+                                              'NULL')
+    bad = '' if pid_valid(pid) else 'BAD PID '
+    return '{}{} {:02x}, {:02x} (CRC5 {})'.format(bad, decode_pid(pid), d0, d1,
+                                                   crcok)
+
+
+def dump_bytes(out, prefix, data):
+    for i in range(0, len(data), 16):
+        row = data[i:i + 16]
+        hexes = ''.join('{:02x} '.format(b) for b in row).ljust(16 * 3)
+        chars = ''.join(chr(b) if 0x20 <= b < 0x7f else '.' for b in row)
+        out.write(prefix + hexes + chars + '\n')
+
+
+def usb_packet_text(out, log, compact, tick, drv, payload):
+    sop_at, pid, got_bytes = struct.unpack_from('<IBB', payload)
+    data = payload[6:]
+    if (log or compact) and got_bytes and data:
+        if compact and len(data) == 2:
+            out.write('mon: {:8d} -- {:8d}: ({}) SOP, PID {}, EOP\n'.format(
+                sop_at, tick, drv, pid_2data(pid, data[0], data[1])))
+        elif compact and len(data) == 1:
+            out.write('mon: {:8d} -- {:8d}: ({}) SOP, PID {} {:02x} EOP\n'.format(
+                sop_at, tick, drv, decode_pid(pid), data[0]))
+        else:
+            if compact:
+                out.write('mon: {:8d} -- {:8d}: ({}) SOP, PID {}, EOP\n'.format(
+                    sop_at, tick, drv, decode_pid(pid)))
+            out.write('mon:     {}:\n'.format('h->d' if drv == 'H' else 'd->h'))
+            body = data[:-2]
+            comp_crc16 = crc16(body)
+            pkt_crc16 = data[-2] | (data[-1] << 8)
+            dump_bytes(out, 'mon:          ', body)
+            out.write('\nmon:          (CRC16 {:02x} {:02x}'.format(
+                data[-2], data[-1]))
+            more = '...' if len(data) == USB_MON_BYTES_SIZE else ''
+            if comp_crc16 == pkt_crc16:
+                out.write('{} OK)\n'.format(more))
+            else:
+                out.write('{} BAD)\nmon:           CRC16 {:04x} BAD expected '
+                          '{:04x}\n'.format(more, pkt_crc16, comp_crc16))
+    elif compact:
+        out.write('mon: {:8d} -- {:8d}: ({}) SOP, PID {} EOP\n'.format(
+            sop_at, tick, drv, decode_pid(pid)))
+    if log:
+        out.write('mon: {:8d}: ({}) EOP\n'.format(tick, drv))
+
+
+def usb_text(loglevel, events, out):
+    '''Write the text log that usb_monitor() would have produced.'''
+    log = loglevel & 0x2
+    compact = loglevel & 0x1
+    for tick, rtype, aux, payload in events:
+        drv = chr(aux) if aux else ''
+        if rtype == USB_REC_TEXT:
+            out.write(payload.decode('utf-8', errors='replace'))
+        elif rtype == USB_REC_CLASH:
+            out.write('mon: {:8d}: Bus clash\n'.format(tick))
+        elif rtype == USB_REC_IDLE and log:
+            if aux:
+                (d2p, ) = struct.unpack('<I', payload)
+                out.write('mon: {:8d}: Idle, FS resistor (d2p 0x{:x})\n'.format(
+                    tick, d2p))
+            else:
+                out.write('mon: {:8d}: Idle, SE0\n'.format(tick))
+        elif rtype == USB_REC_SOP and log:
+            out.write('mon: {:8d}: ({}) SOP\n'.format(tick, drv))
+        elif rtype == USB_REC_PID and log:
+            pid, ok = payload[0], payload[1]
+            if ok:
+                out.write('mon: {:8d}: ({}) PID {} (0x{:x})\n'.format(
+                    tick, drv, decode_pid(pid), pid))
+            else:
+                out.write('mon: {:8d}: ({}) BAD PID 0x{:x}\n'.format(
+                    tick, drv, pid))
+        elif rtype == USB_REC_BITSTUFF:
+            (rawbits, ) = struct.unpack('<I', payload)
+            out.write(
+                'mon: {:8d}: ({}) Bitstuff error, got 1 after 0x{:x}\n'.format(
+                    tick, drv, rawbits))
+        elif rtype == USB_REC_PACKET:
+            usb_packet_text(out, log, compact, tick, drv, payload)
+
+
+def usb_json(events, out):
+    names = {
+        USB_REC_TEXT: 'text',
+        USB_REC_CLASH: 'clash',
+        USB_REC_IDLE: 'idle',
+        USB_REC_SOP: 'sop',
+        USB_REC_PID: 'pid',
+        USB_REC_BITSTUFF: 'bitstuff',
+        USB_REC_PACKET: 'packet'
+    }
+    for tick, rtype, aux, payload in events:
+        obj = {'tick': tick, 'event': names.get(rtype, rtype)}
+        if rtype in (USB_REC_SOP, USB_REC_PID, USB_REC_BITSTUFF,
+                     USB_REC_PACKET):
+            obj['dir'] = 'h2d' if aux == ord('H') else 'd2h'
+        if rtype == USB_REC_TEXT:
+            obj['text'] = payload.decode('utf-8', errors='replace')
+        elif rtype == USB_REC_IDLE:
+            obj['pullup'] = bool(aux)
+        elif rtype == USB_REC_PID:
+            obj['pid'] = decode_pid(payload[0])
+            obj['valid'] = bool(payload[1])
+        elif rtype == USB_REC_PACKET:
+            sop_at, pid, _ = struct.unpack_from('<IBB', payload)
+            obj['sop'] = sop_at
+            obj['pid'] = decode_pid(pid)
+            obj['data'] = payload[6:].hex()
+        out.write(json.dumps(obj) + '\n')
+
+
+def usb_pcap(events, out):
+    '''Write one pcap record (PID followed by the packet bytes) per packet.'''
+    out.write(
+        struct.pack('<IHHiIII', 0xa1b2c3d4, 2, 4, 0, 0, 65535,
+                    PCAP_LINKTYPE_USB_2_0))
+    for tick, rtype, aux, payload in events:
+        if rtype != USB_REC_PACKET:
+            continue
+        sop_at, pid, _ = struct.unpack_from('<IBB', payload)
+        pkt = bytes([pid]) + payload[6:]
+        usecs = sop_at // USB_BITS_PER_US
+        out.write(
+            struct.pack('<IIII', usecs // 1000000, usecs % 1000000, len(pkt),
+                        len(pkt)))
+        out.write(pkt)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('trace', help='trace file (.zst for compressed)')
+    parser.add_argument('--format',
+                        choices=['text', 'json', 'pcap'],
+                        default='text',
+                        help='output format (pcap is only for USB traces)')
+    parser.add_argument('--loglevel',
+                        type=lambda s: int(s, 0),
+                        help='log level for text output (default: the one '
+                        'recorded in the trace)')
+    parser.add_argument('-o',
+                        '--output',
+                        help='output file (default: standard output)')
+    args = parser.parse_args()
+
+    try:
+        source, loglevel, events = read_events(open_trace(args.trace))
+    except (OSError, ValueError, subprocess.CalledProcessError) as err:
+        print('{}: {}'.format(args.trace, err), file=sys.stderr)
+        return 1
+    if args.loglevel is not None:
+        loglevel = args.loglevel
+    if source not in (SRC_SPI, SRC_USB):
+        print('{}: unknown trace source {}'.format(args.trace, source),
+              file=sys.stderr)
+        return 1
+    if args.format == 'pcap' and source != SRC_USB:
+        print('pcap output is only supported for USB traces', file=sys.stderr)
+        return 1
+
+    if args.format == 'pcap':
+        out = open(args.output, 'wb') if args.output else sys.stdout.buffer
+        usb_pcap(events, out)
+    else:
+        out = open(args.output, 'w') if args.output else sys.stdout
+        if args.format == 'json':
+            (spi_json if source == SRC_SPI else usb_json)(events, out)
+        elif source == SRC_SPI:
+            spi_text(loglevel, events, out)
+        else:
+            usb_text(loglevel, events, out)
+    if args.output:
+        out.close()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
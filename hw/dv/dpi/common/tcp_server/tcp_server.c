@@ -14,19 +14,37 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/socket.h>
-#include <sys/time.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 /**
- * Simple buffer for passing data between TCP sockets and DPI modules
+ * Single-producer, single-consumer ring buffer for passing data between TCP
+ * sockets and DPI modules
+ *
+ * One side of each buffer is the server thread and the other is the simulation
+ * thread. rptr and wptr are free-running counters: only the consumer writes
+ * rptr and only the producer writes wptr. Each side publishes its counter with
+ * a release store and reads the other side's with an acquire load, which makes
+ * sure the data bytes are visible before the counter that covers them.
+ *
+ * BUFSIZE_BYTE must be a power of two.
  */
-#define BUFSIZE_BYTE 256
+#define BUFSIZE_BYTE 16384
+
+// The maximum number of bytes that the server thread moves with a single
+// recv() or send() call.
+#define XFER_CHUNK_BYTE 4096
+
+// How long the server thread sleeps in poll() if nothing wakes it up. Host-side
+// activity and socket activity both cause an earlier wakeup, so this only
+// bounds the latency of noticing a missed wakeup.
+#define POLL_TIMEOUT_MS 10
 
 struct tcp_buf {
   unsigned int rptr;
@@ -48,38 +66,100 @@ struct tcp_server_ctx {
   int sfd;  // socket fd
   int cfd;  // client fd
   pthread_t sock_thread;
+  // Used by the host thread to wake up the server thread from poll(). The
+  // server sets waiting before it goes to sleep and whoever clears it is
+  // responsible for the wakeup, so the host only makes a syscall when the
+  // server is actually asleep.
+  int wake_fds[2];
+  int waiting;
 };
 
+static unsigned int tcp_buffer_used(struct tcp_buf *buf) {
+  unsigned int wptr = __atomic_load_n(&buf->wptr, __ATOMIC_ACQUIRE);
+  unsigned int rptr = __atomic_load_n(&buf->rptr, __ATOMIC_ACQUIRE);
+  return wptr - rptr;
+}
+
 static bool tcp_buffer_is_full(struct tcp_buf *buf) {
-  if (buf->wptr >= buf->rptr) {
-    return (buf->wptr - buf->rptr) == (BUFSIZE_BYTE - 1);
-  } else {
-    return (buf->rptr - buf->wptr) == 1;
-  }
+  return tcp_buffer_used(buf) == BUFSIZE_BYTE;
 }
 
 static bool tcp_buffer_is_empty(struct tcp_buf *buf) {
-  return (buf->wptr == buf->rptr);
+  return tcp_buffer_used(buf) == 0;
 }
 
-static void tcp_buffer_put_byte(struct tcp_buf *buf, char dat) {
-  bool done = false;
-  while (!done) {
-    if (!tcp_buffer_is_full(buf)) {
-      buf->buf[buf->wptr++] = dat;
-      buf->wptr %= BUFSIZE_BYTE;
-      done = true;
-    }
+/**
+ * Find the contiguous readable region of a buffer (consumer side)
+ *
+ * @param buf buffer
+ * @param dat set to the first readable byte
+ * @return number of bytes that can be read from *dat
+ */
+static size_t tcp_buffer_peek(struct tcp_buf *buf, const char **dat) {
+  unsigned int rptr = buf->rptr;
+  unsigned int wptr = __atomic_load_n(&buf->wptr, __ATOMIC_ACQUIRE);
+  unsigned int offset = rptr % BUFSIZE_BYTE;
+  size_t avail = wptr - rptr;
+  size_t contig = BUFSIZE_BYTE - offset;
+  *dat = &buf->buf[offset];
+  return avail < contig ? avail : contig;
+}
+
+/**
+ * Release bytes returned by tcp_buffer_peek() (consumer side)
+ */
+static void tcp_buffer_consume(struct tcp_buf *buf, size_t len) {
+  __atomic_store_n(&buf->rptr, buf->rptr + (unsigned int)len,
+                   __ATOMIC_RELEASE);
+}
+
+/**
+ * Copy up to len bytes into a buffer without blocking (producer side)
+ *
+ * @return number of bytes copied
+ */
+static size_t tcp_buffer_put(struct tcp_buf *buf, const char *dat,
+                             size_t len) {
+  unsigned int wptr = buf->wptr;
+  unsigned int rptr = __atomic_load_n(&buf->rptr, __ATOMIC_ACQUIRE);
+  size_t space = BUFSIZE_BYTE - (wptr - rptr);
+  if (len > space) {
+    len = space;
   }
+
+  unsigned int offset = wptr % BUFSIZE_BYTE;
+  size_t first = BUFSIZE_BYTE - offset;
+  if (first > len) {
+    first = len;
+  }
+  memcpy(&buf->buf[offset], dat, first);
+  memcpy(&buf->buf[0], dat + first, len - first);
+
+  __atomic_store_n(&buf->wptr, wptr + (unsigned int)len, __ATOMIC_RELEASE);
+  return len;
 }
 
-static bool tcp_buffer_get_byte(struct tcp_buf *buf, char *dat) {
-  if (tcp_buffer_is_empty(buf)) {
-    return false;
+/**
+ * Copy up to len bytes out of a buffer without blocking (consumer side)
+ *
+ * @return number of bytes copied
+ */
+static size_t tcp_buffer_get(struct tcp_buf *buf, char *dat, size_t len) {
+  size_t done = 0;
+  while (done < len) {
+    const char *src;
+    size_t avail = tcp_buffer_peek(buf, &src);
+    if (!avail) {
+      break;
+    }
+    if (avail > len - done) {
+      avail = len - done;
+    }
+    memcpy(dat + done, src, avail);
+    tcp_buffer_consume(buf, avail);
+    done += avail;
   }
-  *dat = buf->buf[buf->rptr++];
-  buf->rptr %= BUFSIZE_BYTE;
-  return true;
+  return done;
 }
 
 static struct tcp_buf *tcp_buffer_new(void) {
@@ -95,6 +175,29 @@ static void tcp_buffer_free(struct tcp_buf **buf) {
   *buf = NULL;
 }
 
+/**
+ * Wake up the server thread if it is sleeping in poll()
+ *
+ * Called by the host thread after it has changed the state of one of the
+ * buffers.
+ *
+ * @param ctx context object
+ */
+static void wake_server(struct tcp_server_ctx *ctx) {
+  // Pairs with the fence in server_wait(): either the server sees our buffer
+  // update before sleeping, or we see that it's waiting.
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (!__atomic_load_n(&ctx->waiting, __ATOMIC_RELAXED)) {
+    return;
+  }
+  if (!__atomic_exchange_n(&ctx->waiting, 0, __ATOMIC_ACQ_REL)) {
+    return;
+  }
+  char dummy = 0;
+  // If the pipe is full, there's already a wakeup pending.
+  (void)!write(ctx->wake_fds[1], &dummy, 1);
+}
+
 /**
  * Start a TCP server
  *
@@ -227,64 +330,128 @@ static void stop(struct tcp_server_ctx *ctx) {
 }
 
 /**
- * Receive a byte from a connected client
+ * Receive as much data from a connected client as fits in buf_in
  *
  * @param ctx context object
- * @param cmd byte received
- * @return true if a byte was read
  */
-static bool get_byte(struct tcp_server_ctx *ctx, char *cmd) {
+static void client_recv(struct tcp_server_ctx *ctx) {
   assert(ctx);
 
-  ssize_t num_read = read(ctx->cfd, cmd, 1);
+  char chunk[XFER_CHUNK_BYTE];
+  while (ctx->cfd) {
+    size_t space = BUFSIZE_BYTE - tcp_buffer_used(ctx->buf_in);
+    if (space == 0) {
+      return;
+    }
+    if (space > sizeof(chunk)) {
+      space = sizeof(chunk);
+    }
 
-  if (num_read == 0) {
-    return false;
-  }
-  if (num_read == -1) {
-    if (errno == EAGAIN || errno == EWOULDBLOCK) {
-      return false;
-    } else if (errno == EBADF) {
-      // Possibly client went away? Accept a new connection.
-      fprintf(stderr, "%s: Client disappeared.\n", ctx->display_name);
+    ssize_t num_read = recv(ctx->cfd, chunk, space, 0);
+
+    if (num_read == 0) {
+      printf("%s: Client disconnected.\n", ctx->display_name);
       tcp_server_client_close(ctx);
-      return false;
-    } else {
-      fprintf(stderr, "%s: Error while reading from client: %s (%d)\n",
-              ctx->display_name, strerror(errno), errno);
-      assert(0 && "Error reading from client");
+      return;
+    }
+    if (num_read == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      } else if (errno == EINTR) {
+        continue;
+      } else if (errno == EBADF || errno == ECONNRESET) {
+        // Possibly client went away? Accept a new connection.
+        fprintf(stderr, "%s: Client disappeared.\n", ctx->display_name);
+        tcp_server_client_close(ctx);
+        return;
+      } else {
+        fprintf(stderr, "%s: Error while reading from client: %s (%d)\n",
+                ctx->display_name, strerror(errno), errno);
+        assert(0 && "Error reading from client");
+      }
     }
+
+    size_t num_put = tcp_buffer_put(ctx->buf_in, chunk, num_read);
+    assert(num_put == (size_t)num_read);
+    (void)num_put;
   }
-  assert(num_read == 1);
-  return true;
 }
 
 /**
- * Send a byte to a connected client
+ * Send as much of buf_out to a connected client as the socket will take
  *
  * @param ctx context object
- * @param cmd byte to send
  */
-static void put_byte(struct tcp_server_ctx *ctx, char cmd) {
-  while (1) {
-    ssize_t num_written = send(ctx->cfd, &cmd, sizeof(cmd), MSG_NOSIGNAL);
+static void client_send(struct tcp_server_ctx *ctx) {
+  while (ctx->cfd) {
+    const char *dat;
+    size_t len = tcp_buffer_peek(ctx->buf_out, &dat);
+    if (len == 0) {
+      return;
+    }
+
+    ssize_t num_written = send(ctx->cfd, dat, len, MSG_NOSIGNAL);
     if (num_written == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // Wait for POLLOUT
+        return;
+      } else if (errno == EINTR) {
         continue;
-      } else if (errno == EPIPE) {
+      } else if (errno == EPIPE || errno == ECONNRESET) {
         printf("%s: Remote disconnected.\n", ctx->display_name);
         tcp_server_client_close(ctx);
-        break;
+        return;
       } else {
         fprintf(stderr, "%s: Error while writing to client: %s (%d)\n",
                 ctx->display_name, strerror(errno), errno);
         assert(0 && "Error writing to client.");
       }
     }
-    if (num_written >= 1) {
-      break;
+    tcp_buffer_consume(ctx->buf_out, num_written);
+  }
+}
+
+/**
+ * Wait until there is something for the server thread to do
+ *
+ * @param ctx context object
+ * @return result of poll(), with fds filled in with the returned events
+ */
+static int server_wait(struct tcp_server_ctx *ctx, struct pollfd *fds) {
+  // fds[0]: wakeup pipe, fds[1]: listening socket, fds[2]: client socket
+  fds[0].fd = ctx->wake_fds[0];
+  fds[0].events = POLLIN;
+  fds[1].fd = (ctx->sfd && !ctx->cfd) ? ctx->sfd : -1;
+  fds[1].events = POLLIN;
+  fds[2].fd = ctx->cfd ? ctx->cfd : -1;
+  fds[2].events = 0;
+  fds[0].revents = fds[1].revents = fds[2].revents = 0;
+
+  __atomic_store_n(&ctx->waiting, 1, __ATOMIC_RELAXED);
+  // Pairs with the fence in wake_server().
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+  // Only ask for data if there is space to put it, and only ask for write
+  // space if there is data to send. Otherwise we would spin, because the host
+  // thread (not the socket) is what will unblock us.
+  bool have_in_space = !tcp_buffer_is_full(ctx->buf_in);
+  bool have_out_data = !tcp_buffer_is_empty(ctx->buf_out);
+  if (ctx->cfd) {
+    fds[2].events =
+        (have_in_space ? POLLIN : 0) | (have_out_data ? POLLOUT : 0);
+  }
+
+  // Don't sleep if we've been told to stop since the top of the loop.
+  int rv = poll(fds, 3, ctx->socket_run ? POLL_TIMEOUT_MS : 0);
+
+  __atomic_store_n(&ctx->waiting, 0, __ATOMIC_RELAXED);
+
+  if (fds[0].revents & POLLIN) {
+    char drain[64];
+    while (read(ctx->wake_fds[0], drain, sizeof(drain)) > 0) {
     }
   }
+  return rv;
 }
 
 /**
@@ -293,6 +460,11 @@ static void put_byte(struct tcp_server_ctx *ctx, char cmd) {
  * @param ctx context object
  */
 static void ctx_free(struct tcp_server_ctx *ctx) {
+  // Close the wakeup pipe
+  if (ctx->wake_fds[0]) {
+    close(ctx->wake_fds[0]);
+    close(ctx->wake_fds[1]);
+  }
   // Free the buffers
   tcp_buffer_free(&ctx->buf_in);
   tcp_buffer_free(&ctx->buf_out);
@@ -312,7 +484,7 @@ static void ctx_free(struct tcp_server_ctx *ctx) {
 static void *server_create(void *ctx_void) {
   // Cast to a server struct
   struct tcp_server_ctx *ctx = (struct tcp_server_ctx *)ctx_void;
-  struct timeval timeout;
+  struct pollfd fds[3];
 
   // Start the server
   int rv = start(ctx);
@@ -322,54 +494,32 @@ static void *server_create(void *ctx_void) {
     goto err_cleanup_return;
   }
 
-  // Initialise timeout
-  timeout.tv_sec = 0;
-
-  // Initialise fd_set
-
   // Start waiting for connection / data
-  char xfer_data;
   while (ctx->socket_run) {
-    // Initialise structure of fds
-    fd_set read_fds;
-    FD_ZERO(&read_fds);
-    if (ctx->sfd) {
-      FD_SET(ctx->sfd, &read_fds);
-    }
-    if (ctx->cfd) {
-      FD_SET(ctx->cfd, &read_fds);
-    }
-    // max fd num
-    int mfd = (ctx->cfd > ctx->sfd) ? ctx->cfd : ctx->sfd;
+    // Send anything that the host has queued up before sleeping: in the common
+    // case the socket has space and this avoids a trip through poll().
+    client_send(ctx);
 
-    // Set timeout - 50us gives good performance
-    timeout.tv_usec = 50;
-
-    // Wait for socket activity or timeout
-    rv = select(mfd + 1, &read_fds, NULL, NULL, &timeout);
+    rv = server_wait(ctx, fds);
 
     if (rv < 0) {
-      printf("%s: Socket read failed, port: %d\n", ctx->display_name,
+      if (errno == EINTR) {
+        continue;
+      }
+      printf("%s: Socket poll failed, port: %d\n", ctx->display_name,
              ctx->listen_port);
       tcp_server_client_close(ctx);
+      continue;
     }
 
     // New connection
-    if (FD_ISSET(ctx->sfd, &read_fds)) {
+    if (fds[1].revents & POLLIN) {
       client_tryaccept(ctx);
     }
 
-    // New client data
-    if (FD_ISSET(ctx->cfd, &read_fds)) {
-      while (get_byte(ctx, &xfer_data)) {
-        tcp_buffer_put_byte(ctx->buf_in, xfer_data);
-      }
-    }
-
-    if (ctx->cfd != 0) {
-      while (tcp_buffer_get_byte(ctx->buf_out, &xfer_data)) {
-        put_byte(ctx, xfer_data);
-      }
+    // New client data (or a hangup, which recv() will report)
+    if (fds[2].revents & (POLLIN | POLLHUP | POLLERR)) {
+      client_recv(ctx);
     }
   }
 
@@ -405,28 +555,62 @@ struct tcp_server_ctx *tcp_server_create(const char *display_name,
   ctx->display_name = strdup(display_name);
   assert(ctx->display_name);
 
+  // Set up the wakeup pipe. Both ends are non-blocking: the host never waits
+  // to signal a wakeup and the server drains the pipe until it's empty.
+  if (pipe(ctx->wake_fds) != 0 ||
+      fcntl(ctx->wake_fds[0], F_SETFL, O_NONBLOCK) != 0 ||
+      fcntl(ctx->wake_fds[1], F_SETFL, O_NONBLOCK) != 0) {
+    fprintf(stderr, "%s: Unable to create wakeup pipe: %s (%d)\n",
+            ctx->display_name, strerror(errno), errno);
+    ctx_free(ctx);
+    return NULL;
+  }
+
   if (pthread_create(&ctx->sock_thread, NULL, server_create, (void *)ctx) !=
       0) {
     fprintf(stderr, "%s: Unable to create TCP socket thread\n",
             ctx->display_name);
     ctx_free(ctx);
-    free(ctx);
     return NULL;
   }
   return ctx;
 }
 
 bool tcp_server_read(struct tcp_server_ctx *ctx, char *dat) {
-  return tcp_buffer_get_byte(ctx->buf_in, dat);
+  return tcp_server_read_buf(ctx, dat, 1) == 1;
+}
+
+size_t tcp_server_read_buf(struct tcp_server_ctx *ctx, char *dat, size_t len) {
+  bool was_full = tcp_buffer_is_full(ctx->buf_in);
+  size_t num_read = tcp_buffer_get(ctx->buf_in, dat, len);
+  // The server stops reading from the socket while buf_in is full, so let it
+  // know that there's space again.
+  if (was_full && num_read) {
+    wake_server(ctx);
+  }
+  return num_read;
 }
 
 void tcp_server_write(struct tcp_server_ctx *ctx, char dat) {
-  tcp_buffer_put_byte(ctx->buf_out, dat);
+  tcp_server_write_buf(ctx, &dat, 1);
+}
+
+void tcp_server_write_buf(struct tcp_server_ctx *ctx, const char *dat,
+                          size_t len) {
+  while (len) {
+    size_t num_put = tcp_buffer_put(ctx->buf_out, dat, len);
+    dat += num_put;
+    len -= num_put;
+    if (num_put || len) {
+      wake_server(ctx);
+    }
+  }
 }
 
 void tcp_server_close(struct tcp_server_ctx *ctx) {
   // Shut down the socket thread
   ctx->socket_run = false;
+  wake_server(ctx);
   pthread_join(ctx->sock_thread, NULL);
   ctx_free(ctx);
 }
@@ -17,6 +17,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 struct tcp_server_ctx;
@@ -41,6 +42,33 @@ bool tcp_server_read(struct tcp_server_ctx *ctx, char *dat);
  */
 void tcp_server_write(struct tcp_server_ctx *ctx, char dat);
 
+/**
+ * Non-blocking read of up to len bytes from a connected client
+ *
+ * This is much cheaper than calling tcp_server_read() once per byte when the
+ * caller can handle several bytes at a time.
+ *
+ * @param ctx tcp server context object
+ * @param dat buffer to fill with received bytes
+ * @param len maximum number of bytes to read
+ * @return number of bytes read (0 if no data was available)
+ */
+size_t tcp_server_read_buf(struct tcp_server_ctx *ctx, char *dat, size_t len);
+
+/**
+ * Write len bytes to a connected client
+ *
+ * Like tcp_server_write(), this is buffered and only blocks while the internal
+ * buffer is full. The bytes are handed to the server thread together, so they
+ * will normally be sent with a single syscall.
+ *
+ * @param ctx tcp server context object
+ * @param dat bytes to send
+ * @param len number of bytes to send
+ */
+void tcp_server_write_buf(struct tcp_server_ctx *ctx, const char *dat,
+                          size_t len);
+
 /**
  * Create a new TCP server instance
  *
@@ -82,12 +82,112 @@ struct dmi_sig_values {
   uint8_t dmi_rst_n;
 };
 
+// Size of the local queue of commands received from the client, and of the
+// buffer of responses that haven't been sent yet.
+#define CMD_BUF_SIZE 4096
+#define RSP_BUF_SIZE 1024
+
+// The largest scan that can be sent with a single fast scan command (see
+// start_scan()). The whole command must fit in the command queue.
+#define SCAN_MAX_BITS 4096
+#define SCAN_MAX_BYTES (SCAN_MAX_BITS / 8)
+#define SCAN_HDR_BYTES 3
+
+// Fast scan command byte. This isn't used by the remote_bitbang protocol, so
+// a stock OpenOCD client never sends it.
+#define CMD_SCAN 'S'
+
+// Messages on the direct DMI socket (see README.md). A request is an op byte
+// (1: read, 2: write), an address byte and 4 bytes of little-endian data. A
+// response is a status byte (the DMI resp field) then 4 bytes of data.
+#define DMI_MSG_REQ_BYTES 6
+#define DMI_MSG_RSP_BYTES 5
+
+enum dmi_req_src_t { DmiSrcJtag, DmiSrcDirect };
+
+struct jtag_scan {
+  uint16_t num_bits;
+  uint16_t pos;
+  uint8_t tms[SCAN_MAX_BYTES];
+  uint8_t tdi[SCAN_MAX_BYTES];
+  uint8_t tdo[SCAN_MAX_BYTES];
+};
+
 struct dmidpi_ctx {
   struct tcp_server_ctx *sock;
   struct jtag_ctx jtag;
   struct dmi_sig_values sig;
+  // Direct DMI transaction server (NULL if not enabled)
+  struct tcp_server_ctx *dmi_sock;
+  // The partially received direct DMI request
+  uint8_t dmi_msg[DMI_MSG_REQ_BYTES];
+  size_t dmi_msg_len;
+  // Which interface issued the outstanding DMI request
+  enum dmi_req_src_t dmi_src;
+  // Commands received from the client: cmd_buf[cmd_rd..cmd_wr) are pending
+  char cmd_buf[CMD_BUF_SIZE];
+  size_t cmd_rd;
+  size_t cmd_wr;
+  // Responses waiting to be sent to the client
+  char rsp_buf[RSP_BUF_SIZE];
+  size_t rsp_len;
+  // The current fast scan (if scan_active)
+  bool scan_active;
+  struct jtag_scan scan;
 };
 
+/**
+ * Pull any new commands from the client into the local command queue
+ *
+ * @param ctx dmidpi context object
+ */
+static void refill_cmds(struct dmidpi_ctx *ctx) {
+  // Move any partially-consumed commands to the front of the queue
+  if (ctx->cmd_rd) {
+    memmove(ctx->cmd_buf, ctx->cmd_buf + ctx->cmd_rd,
+            ctx->cmd_wr - ctx->cmd_rd);
+    ctx->cmd_wr -= ctx->cmd_rd;
+    ctx->cmd_rd = 0;
+  }
+  ctx->cmd_wr += tcp_server_read_buf(ctx->sock, ctx->cmd_buf + ctx->cmd_wr,
+                                     CMD_BUF_SIZE - ctx->cmd_wr);
+}
+
+/**
+ * Send all buffered responses to the client
+ *
+ * @param ctx dmidpi context object
+ */
+static void flush_rsp(struct dmidpi_ctx *ctx) {
+  if (ctx->rsp_len) {
+    tcp_server_write_buf(ctx->sock, ctx->rsp_buf, ctx->rsp_len);
+    ctx->rsp_len = 0;
+  }
+}
+
+/**
+ * Queue response bytes to be sent to the client
+ *
+ * @param ctx dmidpi context object
+ * @param dat bytes to send
+ * @param len number of bytes
+ */
+static void queue_rsp(struct dmidpi_ctx *ctx, const char *dat, size_t len) {
+  while (len) {
+    if (ctx->rsp_len == RSP_BUF_SIZE) {
+      flush_rsp(ctx);
+    }
+    size_t num = RSP_BUF_SIZE - ctx->rsp_len;
+    if (num > len) {
+      num = len;
+    }
+    memcpy(ctx->rsp_buf + ctx->rsp_len, dat, num);
+    ctx->rsp_len += num;
+    dat += num;
+    len -= num;
+  }
+}
+
 /**
  * Setup the correct shift register data
  *
@@ -121,6 +221,7 @@ static void set_dr_data(struct dmidpi_ctx *ctx) {
  */
 static void issue_dmi_req(struct dmidpi_ctx *ctx) {
   ctx->jtag.dmi_outstanding = 1;
+  ctx->dmi_src = DmiSrcJtag;
   ctx->sig.dmi_req_valid = 1;
   ctx->sig.dmi_req_addr = (ctx->jtag.dr_captured >> 34) & 0x7F;
   ctx->sig.dmi_req_op = ctx->jtag.dr_captured & 0x3;
@@ -306,7 +407,7 @@ static bool process_cmd_byte(struct dmidpi_ctx *ctx, char cmd) {
   } else if (cmd == 'R') {
     // JTAG read, send tdo as response
     char tdo_ascii = ctx->jtag.jtag_tdo + '0';
-    tcp_server_write(ctx->sock, tdo_ascii);
+    queue_rsp(ctx, &tdo_ascii, 1);
   } else if (cmd == 'B') {
     // printf("DMI DPI: BLINK ON!\n");
   } else if (cmd == 'b') {
@@ -314,6 +415,8 @@ static bool process_cmd_byte(struct dmidpi_ctx *ctx, char cmd) {
   } else if (cmd == 'Q') {
     // quit (client disconnect)
     printf("DMI DPI: Remote disconnected.\n");
+    ctx->cmd_rd = ctx->cmd_wr = 0;
+    ctx->rsp_len = 0;
     tcp_server_client_close(ctx->sock);
   } else {
     fprintf(stderr,
@@ -337,14 +440,143 @@ static void process_dmi_inputs(struct dmidpi_ctx *ctx) {
   }
   // Always ready for a resp
   ctx->sig.dmi_rsp_ready = 1;
-  if (ctx->sig.dmi_rsp_valid) {
-    ctx->jtag.dr_captured = (uint64_t)ctx->sig.dmi_rsp_data << 2;
-    ctx->jtag.dr_captured |= (uint64_t)ctx->sig.dmi_rsp_resp & 0x3;
+  if (ctx->sig.dmi_rsp_valid && ctx->jtag.dmi_outstanding) {
+    if (ctx->dmi_src == DmiSrcDirect) {
+      // Send the response straight back to the direct DMI client
+      uint32_t data = ctx->sig.dmi_rsp_data;
+      char rsp[DMI_MSG_RSP_BYTES] = {
+          (char)(ctx->sig.dmi_rsp_resp & 0x3), (char)(data & 0xff),
+          (char)((data >> 8) & 0xff), (char)((data >> 16) & 0xff),
+          (char)((data >> 24) & 0xff)};
+      tcp_server_write_buf(ctx->dmi_sock, rsp, sizeof(rsp));
+    } else {
+      ctx->jtag.dr_captured = (uint64_t)ctx->sig.dmi_rsp_data << 2;
+      ctx->jtag.dr_captured |= (uint64_t)ctx->sig.dmi_rsp_resp & 0x3;
+    }
     // Clear req outstanding flag
     ctx->jtag.dmi_outstanding = 0;
   }
 }
 
+/**
+ * Issue a DMI request from the direct DMI socket, if a whole one has arrived
+ *
+ * @param ctx dmidpi context object
+ * @return true if a request was issued
+ */
+static bool try_issue_direct_dmi_req(struct dmidpi_ctx *ctx) {
+  if (!ctx->dmi_sock) {
+    return false;
+  }
+
+  ctx->dmi_msg_len += tcp_server_read_buf(
+      ctx->dmi_sock, (char *)ctx->dmi_msg + ctx->dmi_msg_len,
+      DMI_MSG_REQ_BYTES - ctx->dmi_msg_len);
+  if (ctx->dmi_msg_len < DMI_MSG_REQ_BYTES) {
+    return false;
+  }
+  ctx->dmi_msg_len = 0;
+
+  uint8_t op = ctx->dmi_msg[0];
+  uint8_t addr = ctx->dmi_msg[1];
+  if ((op != 1 && op != 2) || (addr & 0x80)) {
+    fprintf(stderr,
+            "DMI DPI: Protocol violation detected: bad direct DMI request "
+            "(op %u, addr 0x%x)\n",
+            op, addr);
+    exit(1);
+  }
+
+  // A direct client never drives the TAP, so make sure that the DMI isn't
+  // being held in reset.
+  ctx->sig.dmi_rst_n = 1;
+
+  ctx->jtag.dmi_outstanding = 1;
+  ctx->dmi_src = DmiSrcDirect;
+  ctx->sig.dmi_req_valid = 1;
+  ctx->sig.dmi_req_addr = addr;
+  ctx->sig.dmi_req_op = op;
+  ctx->sig.dmi_req_data = (uint32_t)ctx->dmi_msg[2] |
+                          ((uint32_t)ctx->dmi_msg[3] << 8) |
+                          ((uint32_t)ctx->dmi_msg[4] << 16) |
+                          ((uint32_t)ctx->dmi_msg[5] << 24);
+  return true;
+}
+
+/**
+ * Try to start a fast scan from the command queue
+ *
+ * The command is a CMD_SCAN byte, then the number of bits as a 16-bit
+ * little-endian value, then the TMS bits and then the TDI bits, each packed
+ * LSB first into (num_bits + 7) / 8 bytes. On completion, the TDO bits are
+ * sent back to the client packed in the same way. Each bit has the same
+ * effect as the bitbang sequence "0-3, R, 4-7".
+ *
+ * @param ctx dmidpi context object
+ * @return false if the whole command hasn't been received yet
+ */
+static bool start_scan(struct dmidpi_ctx *ctx) {
+  const uint8_t *cmd = (const uint8_t *)ctx->cmd_buf + ctx->cmd_rd;
+  size_t avail = ctx->cmd_wr - ctx->cmd_rd;
+  if (avail < SCAN_HDR_BYTES) {
+    return false;
+  }
+
+  unsigned num_bits = cmd[1] | ((unsigned)cmd[2] << 8);
+  if (num_bits == 0 || num_bits > SCAN_MAX_BITS) {
+    fprintf(stderr,
+            "DMI DPI: Protocol violation detected: bad scan length %u\n",
+            num_bits);
+    exit(1);
+  }
+  size_t num_bytes = (num_bits + 7) / 8;
+  if (avail < SCAN_HDR_BYTES + 2 * num_bytes) {
+    return false;
+  }
+
+  struct jtag_scan *scan = &ctx->scan;
+  scan->num_bits = num_bits;
+  scan->pos = 0;
+  memcpy(scan->tms, cmd + SCAN_HDR_BYTES, num_bytes);
+  memcpy(scan->tdi, cmd + SCAN_HDR_BYTES + num_bytes, num_bytes);
+  memset(scan->tdo, 0, num_bytes);
+  ctx->scan_active = true;
+
+  ctx->cmd_rd += SCAN_HDR_BYTES + 2 * num_bytes;
+  return true;
+}
+
+/**
+ * Run the current fast scan until it finishes or a command completes
+ *
+ * Since the TAP is modelled in software, several bits can be run in one tick.
+ * We stop early when a bit completes a command (a DMI request or a reset), so
+ * that the design sees it in the same way as with the bitbang protocol.
+ *
+ * @param ctx dmidpi context object
+ */
+static void run_scan(struct dmidpi_ctx *ctx) {
+  struct jtag_scan *scan = &ctx->scan;
+  while (scan->pos < scan->num_bits) {
+    unsigned byte = scan->pos / 8;
+    unsigned bit = scan->pos % 8;
+    bool tms = (scan->tms[byte] >> bit) & 0x1;
+    bool tdi = (scan->tdi[byte] >> bit) & 0x1;
+
+    process_jtag_cmd(ctx, tdi, tms, false);
+    scan->tdo[byte] |= (ctx->jtag.jtag_tdo & 0x1) << bit;
+    scan->pos++;
+    if (process_jtag_cmd(ctx, tdi, tms, true)) {
+      break;
+    }
+  }
+
+  if (scan->pos == scan->num_bits) {
+    ctx->scan_active = false;
+    queue_rsp(ctx, (const char *)scan->tdo, (scan->num_bits + 7) / 8);
+  }
+}
+
 /**
  * Advance DMI internal state
  *
@@ -362,19 +594,44 @@ static void update_dmi_state(struct dmidpi_ctx *ctx) {
     return;
   }
 
-  char done = 0;
-  while (!done) {
-    // read a command byte
-    char cmd;
-    if (!tcp_server_read(ctx->sock, &cmd)) {
-      return;
-    }
+  // Direct DMI requests take priority: each one is a complete transaction, so
+  // it can't leave the JTAG side in an inconsistent state.
+  if (try_issue_direct_dmi_req(ctx)) {
+    return;
+  }
+
+  refill_cmds(ctx);
+
+  if (ctx->scan_active) {
+    run_scan(ctx);
+  } else {
+    char done = 0;
     // Process command bytes until a command completes
-    done = process_cmd_byte(ctx, cmd);
+    while (!done && ctx->cmd_rd < ctx->cmd_wr) {
+      char cmd = ctx->cmd_buf[ctx->cmd_rd];
+      if (cmd == CMD_SCAN) {
+        if (!start_scan(ctx)) {
+          // Wait for the rest of the command to arrive
+          break;
+        }
+        run_scan(ctx);
+        break;
+      }
+      ctx->cmd_rd++;
+      done = process_cmd_byte(ctx, cmd);
+    }
+  }
+
+  // The client can't send anything that depends on a response before it has
+  // seen it, so we only need to send responses once we've run out of commands
+  // (or of buffer space). This turns a stream of reads into a few large sends.
+  if (!ctx->scan_active && ctx->cmd_rd == ctx->cmd_wr) {
+    flush_rsp(ctx);
   }
 }
 
-void *dmidpi_create(const char *display_name, int listen_port) {
+void *dmidpi_create(const char *display_name, int listen_port,
+                    int dmi_listen_port) {
   // Create context
   struct dmidpi_ctx *ctx =
       (struct dmidpi_ctx *)calloc(1, sizeof(struct dmidpi_ctx));
@@ -392,6 +649,20 @@ void *dmidpi_create(const char *display_name, int listen_port) {
       "  remote_bitbang_port %d\n",
       display_name, listen_port, listen_port);
 
+  if (dmi_listen_port) {
+    size_t name_len = strlen(display_name) + sizeof("-dmi");
+    char *dmi_name = (char *)malloc(name_len);
+    assert(dmi_name);
+    snprintf(dmi_name, name_len, "%s-dmi", display_name);
+    ctx->dmi_sock = tcp_server_create(dmi_name, dmi_listen_port);
+    free(dmi_name);
+
+    printf(
+        "\n"
+        "DMI: Direct DMI transaction interface %s is listening on port %d.\n",
+        display_name, dmi_listen_port);
+  }
+
   return (void *)ctx;
 }
 
@@ -401,8 +672,11 @@ void dmidpi_close(void *ctx_void) {
     return;
   }
 
-  // Shut down the server
+  // Shut down the servers
   tcp_server_close(ctx->sock);
+  if (ctx->dmi_sock) {
+    tcp_server_close(ctx->dmi_sock);
+  }
 
   free(ctx);
 }
@@ -17,10 +17,13 @@ extern "C" {
  * Call from a initial block.
  *
  * @param display_name Name of the interface (for display purposes only)
- * @param listen_port Port to listen on
+ * @param listen_port Port to listen on for remote_bitbang JTAG connections
+ * @param dmi_listen_port Port to listen on for direct DMI transactions, or 0
+ *                        to disable the direct DMI interface
  * @return an initialized struct dmidpi_ctx context object
  */
-void *dmidpi_create(const char *display_name, int listen_port);
+void *dmidpi_create(const char *display_name, int listen_port,
+                    int dmi_listen_port);
 
 /**
  * Destructor: Close all connections and free all resources
@@ -29,6 +29,18 @@
 // This module currently is capable of implementing 32 GPIOs.
 #define NUM_GPIO 32
 
+// Sizes of the records in binary mode (see README.md). All fields are
+// little-endian.
+//
+// Device to host: cycle (u64), changed (u32), data (u32), oe (u32)
+#define BIN_D2H_RECORD_BYTES 20
+// Host to device: delay (u32), mask (u32), value (u32), weak (u32)
+#define BIN_H2D_RECORD_BYTES 16
+
+// Buffer sizes, in records, for binary mode.
+#define BIN_D2H_BUF_RECORDS 256
+#define BIN_H2D_BUF_RECORDS 256
+
 // This file does a lot of bit setting and getting; these macros are intended to
 // make that a little more readable.
 #define GET_BIT(word, bit_idx) (((word) >> (bit_idx)) & 1)
@@ -47,6 +59,36 @@ struct gpiodpi_ctx {
   // avoid excessive `read` syscalls to the pipe fd.
   uint32_t counter;
 
+  // The number of calls to host_to_device_tick so far (i.e. the cycle count),
+  // used to timestamp binary records.
+  uint64_t cycle;
+
+  // Whether to use the binary protocol rather than text.
+  bool binary;
+  // Changes in the device's pins are held back until coalesce_cycles cycles
+  // after the first one and then reported together (0 to report immediately).
+  uint32_t coalesce_cycles;
+  // The last reported pin state and whether there is an unreported change
+  // (waiting for coalescing), in which case pending_since is the cycle of
+  // the first unreported change.
+  uint32_t reported_data;
+  uint32_t reported_oe;
+  uint32_t pending_data;
+  uint32_t pending_oe;
+  bool change_pending;
+  uint64_t pending_since;
+
+  // Binary device-to-host records that haven't been written yet.
+  uint8_t d2h_buf[BIN_D2H_BUF_RECORDS * BIN_D2H_RECORD_BYTES];
+  size_t d2h_len;
+
+  // Binary host-to-device bytes that have been read but not yet applied.
+  // The first record is applied once its delay has elapsed since
+  // last_apply_cycle.
+  uint8_t h2d_buf[BIN_H2D_BUF_RECORDS * BIN_H2D_RECORD_BYTES];
+  size_t h2d_len;
+  uint64_t last_apply_cycle;
+
   // File descriptors and paths for the device-to-host and host-to-device
   // FIFOs.
   int dev_to_host_fifo;
@@ -107,9 +149,83 @@ static void print_usage(char *rfifo, char *wfifo, int n_bits) {
          wfifo);
 }
 
-void *gpiodpi_create(const char *name, int n_bits) {
+static void put_le(uint8_t *buf, uint64_t val, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    buf[i] = (val >> (8 * i)) & 0xff;
+  }
+}
+
+static uint32_t get_le32(const uint8_t *buf) {
+  return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+         ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/**
+ * Write out any buffered binary device-to-host records.
+ */
+static void flush_d2h(struct gpiodpi_ctx *ctx) {
+  size_t done = 0;
+  while (done < ctx->d2h_len) {
+    ssize_t written =
+        write(ctx->dev_to_host_fifo, ctx->d2h_buf + done, ctx->d2h_len - done);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    assert(written > 0 && "Write to GPIO FIFO failed.");
+    done += written;
+  }
+  ctx->d2h_len = 0;
+}
+
+/**
+ * Report the pin state in ctx->pending_* to the host.
+ */
+static void report_pins(struct gpiodpi_ctx *ctx) {
+  uint32_t data = ctx->pending_data;
+  uint32_t oe = ctx->pending_oe;
+  ctx->change_pending = false;
+
+  if (ctx->binary) {
+    // Report a pin as changed if its value or its output enable changed.
+    uint32_t changed = (data ^ ctx->reported_data) | (oe ^ ctx->reported_oe);
+    uint8_t *rec = ctx->d2h_buf + ctx->d2h_len;
+    put_le(rec, ctx->cycle, 8);
+    put_le(rec + 8, changed, 4);
+    put_le(rec + 12, data, 4);
+    put_le(rec + 16, oe, 4);
+    ctx->d2h_len += BIN_D2H_RECORD_BYTES;
+    if (ctx->d2h_len == sizeof(ctx->d2h_buf)) {
+      flush_d2h(ctx);
+    }
+  } else {
+    // Write 0, 1, or X (when oe is not set) for each GPIO pin, in big endian
+    // order (i.e., pin 0 is the last character written). Finish it with a
+    // newline.
+    char gpio_str[32 + 1];
+    char *pin_char = gpio_str;
+    for (int i = ctx->n_bits - 1; i >= 0; --i, ++pin_char) {
+      if (!GET_BIT(oe, i)) {
+        *pin_char = 'X';
+      } else if (GET_BIT(data, i)) {
+        *pin_char = '1';
+      } else {
+        *pin_char = '0';
+      }
+    }
+    *pin_char = '\n';
+
+    ssize_t written = write(ctx->dev_to_host_fifo, gpio_str, ctx->n_bits + 1);
+    assert(written == ctx->n_bits + 1);
+  }
+
+  ctx->reported_data = data;
+  ctx->reported_oe = oe;
+}
+
+void *gpiodpi_create(const char *name, int n_bits, int binary,
+                     int coalesce_cycles) {
   struct gpiodpi_ctx *ctx =
-      (struct gpiodpi_ctx *)malloc(sizeof(struct gpiodpi_ctx));
+      (struct gpiodpi_ctx *)calloc(1, sizeof(struct gpiodpi_ctx));
   assert(ctx);
 
   // n_bits > 32 requires more sophisticated handling of svBitVecVal which we
@@ -120,6 +236,8 @@ void *gpiodpi_create(const char *name, int n_bits) {
   ctx->driven_pin_values = 0;
   ctx->weak_pins = 0;
   ctx->counter = 0;
+  ctx->binary = binary != 0;
+  ctx->coalesce_cycles = coalesce_cycles > 0 ? coalesce_cycles : 0;
 
   char cwd_buf[PATH_MAX];
   char *cwd = getcwd(cwd_buf, sizeof(cwd_buf));
@@ -145,7 +263,14 @@ void *gpiodpi_create(const char *name, int n_bits) {
   int flags = fcntl(ctx->host_to_dev_fifo, F_GETFL, 0);
   fcntl(ctx->host_to_dev_fifo, F_SETFL, flags | O_NONBLOCK);
 
-  print_usage(ctx->dev_to_host_path, ctx->host_to_dev_path, ctx->n_bits);
+  if (ctx->binary) {
+    printf(
+        "\nGPIO: FIFO pipes created at %s (read) and %s (write) for %d-bit "
+        "wide GPIO, using the binary protocol.\n",
+        ctx->dev_to_host_path, ctx->host_to_dev_path, ctx->n_bits);
+  } else {
+    print_usage(ctx->dev_to_host_path, ctx->host_to_dev_path, ctx->n_bits);
+  }
 
   return (void *)ctx;
 }
@@ -155,24 +280,16 @@ void gpiodpi_device_to_host(void *ctx_void, svBitVecVal *gpio_data,
   struct gpiodpi_ctx *ctx = (struct gpiodpi_ctx *)ctx_void;
   assert(ctx);
 
-  // Write 0, 1, or X (when oe is not set) for each GPIO pin, in big endian
-  // order (i.e., pin 0 is the last character written). Finish it with a
-  // newline.
-  char gpio_str[32 + 1];
-  char *pin_char = gpio_str;
-  for (int i = ctx->n_bits - 1; i >= 0; --i, ++pin_char) {
-    if (!GET_BIT(gpio_oe[0], i)) {
-      *pin_char = 'X';
-    } else if (GET_BIT(gpio_data[0], i)) {
-      *pin_char = '1';
-    } else {
-      *pin_char = '0';
-    }
+  ctx->pending_data = gpio_data[0];
+  ctx->pending_oe = gpio_oe[0];
+  if (!ctx->change_pending) {
+    ctx->change_pending = true;
+    ctx->pending_since = ctx->cycle;
   }
-  *pin_char = '\n';
 
-  ssize_t written = write(ctx->dev_to_host_fifo, gpio_str, ctx->n_bits + 1);
-  assert(written == ctx->n_bits + 1);
+  if (ctx->coalesce_cycles == 0) {
+    report_pins(ctx);
+  }
 }
 
 /**
@@ -211,13 +328,71 @@ static void set_bit_val(uint32_t *word, uint32_t idx, bool val) {
   }
 }
 
+/**
+ * Read and apply binary host-to-device records.
+ *
+ * Each record is applied once its delay (in cycles) has passed since the
+ * previous record was applied, so a host can queue up a pattern in advance
+ * and have it played back with exact timing.
+ */
+static void host_to_device_binary(struct gpiodpi_ctx *ctx,
+                                  svBitVecVal *gpio_oe) {
+  if (ctx->counter % TICKS_PER_SYSCALL == 0 &&
+      ctx->h2d_len < sizeof(ctx->h2d_buf)) {
+    ssize_t read_len = read(ctx->host_to_dev_fifo, ctx->h2d_buf + ctx->h2d_len,
+                            sizeof(ctx->h2d_buf) - ctx->h2d_len);
+    if (read_len > 0) {
+      ctx->h2d_len += read_len;
+    }
+  }
+
+  size_t pos = 0;
+  while (ctx->h2d_len - pos >= BIN_H2D_RECORD_BYTES) {
+    const uint8_t *rec = ctx->h2d_buf + pos;
+    uint32_t delay = get_le32(rec);
+    if (ctx->cycle - ctx->last_apply_cycle < delay) {
+      break;
+    }
+    uint32_t mask = get_le32(rec + 4);
+    uint32_t value = get_le32(rec + 8);
+    uint32_t weak = get_le32(rec + 12);
+
+    if (mask & ~gpio_oe[0]) {
+      fprintf(stderr, "GPIO: Host tried to drive disabled pins: 0x%08x\n",
+              mask & ~gpio_oe[0]);
+    }
+    ctx->driven_pin_values = (ctx->driven_pin_values & ~mask) | (value & mask);
+    ctx->weak_pins = (ctx->weak_pins & ~mask) | (weak & mask);
+    ctx->last_apply_cycle = ctx->cycle;
+    pos += BIN_H2D_RECORD_BYTES;
+  }
+
+  if (pos) {
+    memmove(ctx->h2d_buf, ctx->h2d_buf + pos, ctx->h2d_len - pos);
+    ctx->h2d_len -= pos;
+  }
+}
+
 uint32_t gpiodpi_host_to_device_tick(void *ctx_void, svBitVecVal *gpio_oe,
                                      svBitVecVal *gpio_pull_en,
                                      svBitVecVal *gpio_pull_sel) {
   struct gpiodpi_ctx *ctx = (struct gpiodpi_ctx *)ctx_void;
   assert(ctx);
 
-  if (ctx->counter % TICKS_PER_SYSCALL == 0) {
+  // Report coalesced changes from the device
+  if (ctx->change_pending &&
+      ctx->cycle - ctx->pending_since >= ctx->coalesce_cycles) {
+    report_pins(ctx);
+  }
+  // Buffered binary records are written out at the same rate that we poll
+  // for input, or sooner if the buffer fills up.
+  if (ctx->binary && ctx->counter % TICKS_PER_SYSCALL == 0) {
+    flush_d2h(ctx);
+  }
+
+  if (ctx->binary) {
+    host_to_device_binary(ctx, gpio_oe);
+  } else if (ctx->counter % TICKS_PER_SYSCALL == 0) {
     char gpio_str[256];
     ssize_t read_len =
         read(ctx->host_to_dev_fifo, gpio_str, sizeof(gpio_str) - 1);
@@ -284,6 +459,7 @@ uint32_t gpiodpi_host_to_device_tick(void *ctx_void, svBitVecVal *gpio_oe,
 
 parse_loop_end:
   ctx->counter += 1;
+  ctx->cycle += 1;
   // The verilated module simulates logic, but the weak/strong inputs result
   // from the properties of the IO pads and the selection of external pull
   // resistors. Since the verilated model doesn't model the analog properties
@@ -305,6 +481,11 @@ void gpiodpi_close(void *ctx_void) {
     return;
   }
 
+  if (ctx->change_pending) {
+    report_pins(ctx);
+  }
+  flush_d2h(ctx);
+
   if (close(ctx->dev_to_host_fifo) != 0) {
     printf("GPIO: Failed to close FIFO file at %s: %s\n", ctx->dev_to_host_path,
            strerror(errno));
@@ -17,8 +17,13 @@ extern "C" {
  * @param name a name to use when creating the inner FIFO.
  * @param n_bits number of bits to write in each direction; this must be at
  *        most 32 bits.
+ * @param binary if nonzero, use the binary protocol on both FIFOs rather than
+ *        text.
+ * @param coalesce_cycles report changes to the device's pins at most once
+ *        every this many cycles (0 to report every change immediately).
  */
-void *gpiodpi_create(const char *name, int n_bits);
+void *gpiodpi_create(const char *name, int n_bits, int binary,
+                     int coalesce_cycles);
 
 /**
  * Attempt to post the current GPIO state to the outside world.
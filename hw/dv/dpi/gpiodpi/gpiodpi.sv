@@ -18,7 +18,8 @@ module gpiodpi
   input  logic [N_GPIO-1:0] gpio_pull_sel
 );
    import "DPI-C" function
-     chandle gpiodpi_create(input string name, input int n_bits);
+     chandle gpiodpi_create(input string name, input int n_bits, input int binary,
+                            input int coalesce_cycles);
 
    import "DPI-C" function
      void gpiodpi_device_to_host(input chandle ctx, input logic [N_GPIO-1:0] gpio_d2p,
@@ -36,8 +37,14 @@ module gpiodpi
    chandle ctx;
 
    function automatic void initialize();
+     int binary = 0;
+     int coalesce_cycles = 0;
+     // Use the binary protocol (see README.md) instead of text.
+     if ($test$plusargs({"GPIODPI_BINARY_", NAME})) binary = 1;
+     // Report pin changes at most once every N cycles.
+     void'($value$plusargs({"GPIODPI_COALESCE_", NAME, "=%d"}, coalesce_cycles));
      $display($time, "GPIO: creating gpiodpi");
-     ctx = gpiodpi_create(NAME, N_GPIO);
+     ctx = gpiodpi_create(NAME, N_GPIO, binary, coalesce_cycles);
    endfunction
 
    // Allow being activated past initial time.
@@ -12,6 +12,39 @@
 
 #include "tcp_server.h"
 
+// Size of the local queue of commands received from the client. Commands are
+// pulled from the TCP server in bulk and executed over the following ticks.
+#define CMD_BUF_SIZE 4096
+
+// Size of the buffer of not-yet-sent responses to the client.
+#define RSP_BUF_SIZE 1024
+
+// The largest scan that can be sent with a single fast scan command. The whole
+// command (header and payload) must fit in the command queue.
+#define SCAN_MAX_BITS 4096
+#define SCAN_MAX_BYTES (SCAN_MAX_BITS / 8)
+#define SCAN_HDR_BYTES 3
+
+// Fast scan command byte. This isn't used by the remote_bitbang protocol, so
+// a stock OpenOCD client never sends it.
+#define CMD_SCAN 'S'
+
+/**
+ * State of a fast scan that is being executed
+ *
+ * Each bit takes two ticks: the first drives TCK low with the bit's TMS and
+ * TDI values and the second samples TDO and drives TCK high. This is exactly
+ * what the bitbang sequence "0-3, R, 4-7" does.
+ */
+struct jtag_scan {
+  uint16_t num_bits;
+  uint16_t pos;
+  bool tck_high_next;
+  uint8_t tms[SCAN_MAX_BYTES];
+  uint8_t tdi[SCAN_MAX_BYTES];
+  uint8_t tdo[SCAN_MAX_BYTES];
+};
+
 struct jtagdpi_ctx {
   // Server context
   struct tcp_server_ctx *sock;
@@ -22,6 +55,16 @@ struct jtagdpi_ctx {
   uint8_t tdo;
   uint8_t trst_n;
   uint8_t srst_n;
+  // Commands received from the client: cmd_buf[cmd_rd..cmd_wr) are pending
+  char cmd_buf[CMD_BUF_SIZE];
+  size_t cmd_rd;
+  size_t cmd_wr;
+  // Responses waiting to be sent to the client
+  char rsp_buf[RSP_BUF_SIZE];
+  size_t rsp_len;
+  // The current fast scan (if scan_active)
+  bool scan_active;
+  struct jtag_scan scan;
 };
 
 /**
@@ -42,11 +85,127 @@ static void reset_jtag_signals(struct jtagdpi_ctx *ctx) {
 }
 
 /**
- * Update the JTAG signals in the context structure
+ * Pull any new commands from the client into the local command queue
  */
-static void update_jtag_signals(struct jtagdpi_ctx *ctx) {
-  assert(ctx);
+static void refill_cmds(struct jtagdpi_ctx *ctx) {
+  // Move any partially-consumed commands to the front of the queue
+  if (ctx->cmd_rd) {
+    memmove(ctx->cmd_buf, ctx->cmd_buf + ctx->cmd_rd,
+            ctx->cmd_wr - ctx->cmd_rd);
+    ctx->cmd_wr -= ctx->cmd_rd;
+    ctx->cmd_rd = 0;
+  }
+  ctx->cmd_wr += tcp_server_read_buf(ctx->sock, ctx->cmd_buf + ctx->cmd_wr,
+                                     CMD_BUF_SIZE - ctx->cmd_wr);
+}
+
+/**
+ * Send all buffered responses to the client
+ */
+static void flush_rsp(struct jtagdpi_ctx *ctx) {
+  if (ctx->rsp_len) {
+    tcp_server_write_buf(ctx->sock, ctx->rsp_buf, ctx->rsp_len);
+    ctx->rsp_len = 0;
+  }
+}
+
+/**
+ * Queue response bytes to be sent to the client
+ */
+static void queue_rsp(struct jtagdpi_ctx *ctx, const char *dat, size_t len) {
+  while (len) {
+    if (ctx->rsp_len == RSP_BUF_SIZE) {
+      flush_rsp(ctx);
+    }
+    size_t num = RSP_BUF_SIZE - ctx->rsp_len;
+    if (num > len) {
+      num = len;
+    }
+    memcpy(ctx->rsp_buf + ctx->rsp_len, dat, num);
+    ctx->rsp_len += num;
+    dat += num;
+    len -= num;
+  }
+}
+
+/**
+ * Try to start a fast scan from the command queue
+ *
+ * The command is a CMD_SCAN byte, then the number of bits as a 16-bit
+ * little-endian value, then the TMS bits and then the TDI bits, each packed
+ * LSB first into (num_bits + 7) / 8 bytes. On completion, the TDO bits are
+ * sent back to the client packed in the same way.
+ *
+ * @return false if the whole command hasn't been received yet
+ */
+static bool start_scan(struct jtagdpi_ctx *ctx) {
+  const uint8_t *cmd = (const uint8_t *)ctx->cmd_buf + ctx->cmd_rd;
+  size_t avail = ctx->cmd_wr - ctx->cmd_rd;
+  if (avail < SCAN_HDR_BYTES) {
+    return false;
+  }
+
+  unsigned num_bits = cmd[1] | ((unsigned)cmd[2] << 8);
+  if (num_bits == 0 || num_bits > SCAN_MAX_BITS) {
+    fprintf(stderr,
+            "JTAG DPI Protocol violation detected: bad scan length %u\n",
+            num_bits);
+    exit(1);
+  }
+  size_t num_bytes = (num_bits + 7) / 8;
+  if (avail < SCAN_HDR_BYTES + 2 * num_bytes) {
+    return false;
+  }
+
+  struct jtag_scan *scan = &ctx->scan;
+  scan->num_bits = num_bits;
+  scan->pos = 0;
+  scan->tck_high_next = false;
+  memcpy(scan->tms, cmd + SCAN_HDR_BYTES, num_bytes);
+  memcpy(scan->tdi, cmd + SCAN_HDR_BYTES + num_bytes, num_bytes);
+  memset(scan->tdo, 0, num_bytes);
+  ctx->scan_active = true;
+
+  ctx->cmd_rd += SCAN_HDR_BYTES + 2 * num_bytes;
+  return true;
+}
+
+/**
+ * Advance the current fast scan by one tick
+ */
+static void step_scan(struct jtagdpi_ctx *ctx) {
+  struct jtag_scan *scan = &ctx->scan;
+  unsigned byte = scan->pos / 8;
+  unsigned bit = scan->pos % 8;
+
+  ctx->tms = (scan->tms[byte] >> bit) & 0x1;
+  ctx->tdi = (scan->tdi[byte] >> bit) & 0x1;
 
+  if (!scan->tck_high_next) {
+    ctx->tck = 0;
+    scan->tck_high_next = true;
+    return;
+  }
+
+  // ctx->tdo reflects the pins we drove on the previous (TCK low) tick
+  scan->tdo[byte] |= (ctx->tdo & 0x1) << bit;
+  ctx->tck = 1;
+  scan->tck_high_next = false;
+
+  if (++scan->pos == scan->num_bits) {
+    ctx->scan_active = false;
+    queue_rsp(ctx, (const char *)scan->tdo, (scan->num_bits + 7) / 8);
+  }
+}
+
+/**
+ * Execute queued commands until one of them changes the JTAG pins
+ *
+ * TDO reads and other commands that don't drive pins are handled straight
+ * away, so each tick consumes any number of those plus at most one pin
+ * update.
+ */
+static void process_cmds(struct jtagdpi_ctx *ctx) {
   /*
    * Documentation pointer:
    * The remote_bitbang protocol implemented below is documented in the OpenOCD
@@ -54,53 +213,76 @@ static void update_jtag_signals(struct jtagdpi_ctx *ctx) {
    * https://repo.or.cz/openocd.git/blob/HEAD:/doc/manual/jtag/drivers/remote_bitbang.txt
    */
 
-  // read a command byte
-  char cmd;
-  if (!tcp_server_read(ctx->sock, &cmd)) {
-    return;
-  }
+  while (ctx->cmd_rd < ctx->cmd_wr) {
+    char cmd = ctx->cmd_buf[ctx->cmd_rd];
 
-  bool act_send_resp = false;
-  bool act_quit = false;
-
-  // parse received command byte
-  if (cmd >= '0' && cmd <= '7') {
-    // JTAG write
-    char cmd_bit = cmd - '0';
-    ctx->tdi = (cmd_bit >> 0) & 0x1;
-    ctx->tms = (cmd_bit >> 1) & 0x1;
-    ctx->tck = (cmd_bit >> 2) & 0x1;
-  } else if (cmd >= 'r' && cmd <= 'u') {
-    // JTAG reset (active high from OpenOCD)
-    char cmd_bit = cmd - 'r';
-    ctx->srst_n = !((cmd_bit >> 0) & 0x1);
-    ctx->trst_n = !((cmd_bit >> 1) & 0x1);
-  } else if (cmd == 'R') {
-    // JTAG read
-    act_send_resp = true;
-  } else if (cmd == 'B') {
-    // printf("%s: BLINK ON!\n", ctx->display_name);
-  } else if (cmd == 'b') {
-    // printf("%s: BLINK OFF!\n", ctx->display_name);
-  } else if (cmd == 'Q') {
-    // quit (client disconnect)
-    act_quit = true;
-  } else {
-    fprintf(stderr,
-            "JTAG DPI Protocol violation detected: unsupported command %c\n",
-            cmd);
-    exit(1);
+    // parse received command byte
+    if (cmd >= '0' && cmd <= '7') {
+      // JTAG write
+      char cmd_bit = cmd - '0';
+      ctx->tdi = (cmd_bit >> 0) & 0x1;
+      ctx->tms = (cmd_bit >> 1) & 0x1;
+      ctx->tck = (cmd_bit >> 2) & 0x1;
+      ctx->cmd_rd++;
+      return;
+    } else if (cmd >= 'r' && cmd <= 'u') {
+      // JTAG reset (active high from OpenOCD)
+      char cmd_bit = cmd - 'r';
+      ctx->srst_n = !((cmd_bit >> 0) & 0x1);
+      ctx->trst_n = !((cmd_bit >> 1) & 0x1);
+      ctx->cmd_rd++;
+      return;
+    } else if (cmd == CMD_SCAN) {
+      if (!start_scan(ctx)) {
+        // Wait for the rest of the command to arrive
+        return;
+      }
+      step_scan(ctx);
+      return;
+    } else if (cmd == 'R') {
+      // JTAG read, send tdo as response
+      char tdo_ascii = ctx->tdo + '0';
+      queue_rsp(ctx, &tdo_ascii, 1);
+    } else if (cmd == 'B') {
+      // printf("%s: BLINK ON!\n", ctx->display_name);
+    } else if (cmd == 'b') {
+      // printf("%s: BLINK OFF!\n", ctx->display_name);
+    } else if (cmd == 'Q') {
+      // quit (client disconnect)
+      printf("JTAG DPI: Remote disconnected.\n");
+      ctx->cmd_rd = ctx->cmd_wr = 0;
+      ctx->rsp_len = 0;
+      tcp_server_client_close(ctx->sock);
+      return;
+    } else {
+      fprintf(stderr,
+              "JTAG DPI Protocol violation detected: unsupported command %c\n",
+              cmd);
+      exit(1);
+    }
+    ctx->cmd_rd++;
   }
+}
 
-  // send tdo as response
-  if (act_send_resp) {
-    char tdo_ascii = ctx->tdo + '0';
-    tcp_server_write(ctx->sock, tdo_ascii);
+/**
+ * Update the JTAG signals in the context structure
+ */
+static void update_jtag_signals(struct jtagdpi_ctx *ctx) {
+  assert(ctx);
+
+  refill_cmds(ctx);
+
+  if (ctx->scan_active) {
+    step_scan(ctx);
+  } else {
+    process_cmds(ctx);
   }
 
-  if (act_quit) {
-    printf("JTAG DPI: Remote disconnected.\n");
-    tcp_server_client_close(ctx->sock);
+  // The client can't send anything that depends on a response before it has
+  // seen it, so we only need to send responses once we've run out of commands
+  // (or of buffer space). This turns a stream of reads into a few large sends.
+  if (!ctx->scan_active && ctx->cmd_rd == ctx->cmd_wr) {
+    flush_rsp(ctx);
   }
 }
 
@@ -6,11 +6,23 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "bus_trace.h"
 #include "spidpi.h"
 
 #define MON_BUFLEN 65
 
+// Record types in binary traces
+#define SPI_REC_TITLE 0
+#define SPI_REC_SIGNALS 1
+#define SPI_REC_TSU 2
+#define SPI_REC_PACKET 3
+
+// Bits in the aux field of SPI_REC_TSU
+#define SPI_TSU_SDI 0x1
+#define SPI_TSU_SDO 0x2
+
 struct mon_ctx {
   int cpol;
   int cpha;
@@ -19,12 +31,14 @@ struct mon_ctx {
   uint32_t prev_d2p;
   int bpos;
   int poff;
+  // If non-NULL, write records here instead of text
+  struct bus_trace *trace;
 
   unsigned char mobuf[MON_BUFLEN];
   unsigned char sobuf[MON_BUFLEN];
 };
 
-void *monitor_spi_init(int mode) {
+void *monitor_spi_init(int mode, struct bus_trace *trace) {
   struct mon_ctx *mon = (struct mon_ctx *)calloc(1, sizeof(struct mon_ctx));
   assert(mon);
 
@@ -37,10 +51,20 @@ void *monitor_spi_init(int mode) {
   mon->prev_p2d = 0;
   mon->prev_d2p = 0;
   mon->msbfirst = 1;
+  mon->trace = trace;
 
   return (void *)mon;
 }
 
+void monitor_spi_close(void *mon_void) {
+  struct mon_ctx *mon = (struct mon_ctx *)mon_void;
+  if (!mon) {
+    return;
+  }
+  bus_trace_close(mon->trace);
+  free(mon);
+}
+
 /*
  * Simple drawing of a waveform vertically (line by line)
  *
@@ -107,6 +131,13 @@ const char *vertical_bit(int cur, int old, int mask, int enmask) {
 
 static void log_signals(struct mon_ctx *mon, FILE *mon_file, int tick, int p2d,
                         int d2p) {
+  if (mon->trace) {
+    uint8_t data[8];
+    bus_trace_put_le32(data, p2d);
+    bus_trace_put_le32(data + 4, d2p);
+    bus_trace_record(mon->trace, tick, SPI_REC_SIGNALS, 0, data, sizeof(data));
+    return;
+  }
   fprintf(mon_file, "%8d SPI: ", tick);
   fprintf(mon_file, "%s  ", vertical_bit(p2d, mon->prev_p2d, P2D_CSB, 0));
   fprintf(mon_file, "%s  ", vertical_bit(p2d, mon->prev_p2d, P2D_SCK, 0));
@@ -115,7 +146,15 @@ static void log_signals(struct mon_ctx *mon, FILE *mon_file, int tick, int p2d,
           vertical_bit(d2p, mon->prev_d2p, D2P_SDO, D2P_SDO_EN));
 }
 
-static void log_packet(struct mon_ctx *mon, FILE *mon_file) {
+static void log_packet(struct mon_ctx *mon, FILE *mon_file, int tick) {
+  if (mon->trace) {
+    // The bytes sent by the host, followed by the bytes the device returned
+    uint8_t data[2 * MON_BUFLEN];
+    memcpy(data, mon->mobuf, mon->poff);
+    memcpy(data + mon->poff, mon->sobuf, mon->poff);
+    bus_trace_payload(mon->trace, tick, SPI_REC_PACKET, 0, data, 2 * mon->poff);
+    return;
+  }
   fprintf(mon_file, "H>D: ");
   for (int i = 0; i < mon->poff; i++) {
     fprintf(mon_file, "%02x ", mon->mobuf[i]);
@@ -127,17 +166,29 @@ static void log_packet(struct mon_ctx *mon, FILE *mon_file) {
   fprintf(mon_file, "\n");
 }
 
-static void capture_bit(struct mon_ctx *mon, FILE *mon_file, int p2d, int d2p) {
+static void capture_bit(struct mon_ctx *mon, FILE *mon_file, int tick,
+                        int p2d, int d2p) {
   if (((mon->cpol == mon->cpha) && (p2d & P2D_SCK)) ||
       ((mon->cpol != mon->cpha) && !(p2d & P2D_SCK))) {
     uint32_t new_mobit = (p2d & P2D_SDI) ? mon->bpos : 0;
     uint32_t new_sobit = (d2p & D2P_SDO) ? mon->bpos : 0;
     // check for setup time
+    int tsu = 0;
     if ((p2d & P2D_SDI) != (mon->prev_p2d & P2D_SDI)) {
-      fprintf(mon_file, "Check SDI tSU ");
+      tsu |= SPI_TSU_SDI;
     }
     if ((d2p & D2P_SDO) != (mon->prev_d2p & D2P_SDO)) {
-      fprintf(mon_file, "Check SDO tSU ");
+      tsu |= SPI_TSU_SDO;
+    }
+    if (tsu && mon->trace) {
+      bus_trace_record(mon->trace, tick, SPI_REC_TSU, tsu, NULL, 0);
+    } else if (tsu) {
+      if (tsu & SPI_TSU_SDI) {
+        fprintf(mon_file, "Check SDI tSU ");
+      }
+      if (tsu & SPI_TSU_SDO) {
+        fprintf(mon_file, "Check SDO tSU ");
+      }
     }
     mon->mobuf[mon->poff] |= new_mobit;
     mon->sobuf[mon->poff] |= new_sobit;
@@ -157,7 +208,7 @@ static void capture_bit(struct mon_ctx *mon, FILE *mon_file, int p2d, int d2p) {
  * SPI device monitor
  *
  * @param mon_void - monitor context structure
- * @param mon_file - FILE * for output to be written
+ * @param mon_file - FILE * for output to be written (unused for binary traces)
  * @param loglevel - details to log
  * @param tick - simulation time
  * @param p2d - bits of signals from pins to device
@@ -172,7 +223,11 @@ void monitor_spi(void *mon_void, FILE *mon_file, int loglevel, int tick,
   int logpkts = (loglevel & 0x8);
 
   if ((tick == 1) && logbits) {
-    fprintf(mon_file, "              CSB SCK MO  MI\n");
+    if (mon->trace) {
+      bus_trace_record(mon->trace, tick, SPI_REC_TITLE, 0, NULL, 0);
+    } else {
+      fprintf(mon_file, "              CSB SCK MO  MI\n");
+    }
   }
   if ((p2d == mon->prev_p2d) && (d2p == mon->prev_d2p) && (p2d & P2D_CSB)) {
     return;
@@ -183,14 +238,16 @@ void monitor_spi(void *mon_void, FILE *mon_file, int loglevel, int tick,
   }
 
   if (!logpkts) {
-    fprintf(mon_file, "\n");
+    if (!mon->trace) {
+      fprintf(mon_file, "\n");
+    }
     mon->prev_p2d = p2d;
     mon->prev_d2p = d2p;
     return;
   }
   if ((p2d & P2D_CSB) && !(mon->prev_p2d & P2D_CSB)) {
     // end of packet
-    log_packet(mon, mon_file);
+    log_packet(mon, mon_file, tick);
     mon->poff = 0;
   } else {
     if (!(p2d & P2D_CSB) && (mon->prev_p2d & P2D_CSB)) {
@@ -204,10 +261,10 @@ void monitor_spi(void *mon_void, FILE *mon_file, int loglevel, int tick,
       // inside packet
       if ((p2d & P2D_SCK) != (mon->prev_p2d & P2D_SCK)) {
         // found a clock edge, check if it is one to capture on
-        capture_bit(mon, mon_file, p2d, d2p);
+        capture_bit(mon, mon_file, tick, p2d, d2p);
       }
     }
-    if (logbits) {
+    if (logbits && !mon->trace) {
       fprintf(mon_file, "\n");
     }
   }
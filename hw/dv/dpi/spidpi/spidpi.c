@@ -13,6 +13,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -28,6 +29,42 @@
 
 // This holds the necessary SPI state.
 #define MAX_TRANSACTION 4
+
+// Transaction-level protocol (see README.md): a 12-byte header, then
+// write_len bytes of payload. The response is read_len bytes.
+#define XACT_HDR_BYTES 12
+#define XACT_MAX_LEN 65535
+// The phases of a transaction: command, address, dummy, write, read.
+#define XACT_NUM_SEGS 5
+
+/**
+ * One phase of a transaction, as a run of bits on `lanes` data lines
+ */
+struct xact_seg {
+  int lanes;
+  int nbits;
+  // Bits to send, MSB of data[0] first (NULL for dummy and read phases)
+  const uint8_t *data;
+  // If true, sample data into the response
+  int read;
+};
+
+struct spidpi_xact {
+  uint8_t opcode;
+  uint8_t addr[4];
+  struct xact_seg segs[XACT_NUM_SEGS];
+  int seg;
+  int bit;
+  // Header and write payload, as received from the host
+  uint8_t req[XACT_HDR_BYTES + XACT_MAX_LEN];
+  size_t req_len;
+  // Data sampled during the read phase, and how much of it has been sent
+  uint8_t rsp[XACT_MAX_LEN];
+  size_t rsp_len;
+  size_t rsp_sent;
+  size_t rsp_bits;
+};
+
 struct spidpi_ctx {
   int loglevel;
   char ptyname[64];
@@ -46,9 +83,12 @@ struct spidpi_ctx {
   int bin;
   int din;
   int nmax;
-  char driving;
+  int driving;
   int state;
   char buf[MAX_TRANSACTION];
+  // Use the transaction-level protocol instead of raw 4-byte transfers
+  int xact_mode;
+  struct spidpi_xact *xact;
 };
 
 // SPI Host States
@@ -59,18 +99,188 @@ struct spidpi_ctx {
 #define SP_CSRISE 4
 #define SP_FINISH 99
 
+// Additional states for the transaction-level protocol
+#define SP_XMOVE 10
+#define SP_XEND 11
+
 // Enable this define to stop tracing at cycle 4
 // and resume at the first SPI packet
 // #define CONTROL_TRACE
 
-void *spidpi_create(const char *name, int mode, int loglevel) {
+static int lanes_from_code(int code) { return 1 << code; }
+
+/**
+ * Parse a complete request in ctx->xact->req and set up its phases
+ *
+ * @return 0 on success, -1 if the request is malformed
+ */
+static int xact_setup(struct spidpi_ctx *ctx) {
+  struct spidpi_xact *x = ctx->xact;
+  const uint8_t *hdr = x->req;
+  int flags = hdr[0];
+  int addr_bytes = hdr[2];
+  int dummy_cycles = hdr[3];
+  uint32_t addr = (uint32_t)hdr[4] | ((uint32_t)hdr[5] << 8) |
+                  ((uint32_t)hdr[6] << 16) | ((uint32_t)hdr[7] << 24);
+  int write_len = hdr[8] | (hdr[9] << 8);
+  int read_len = hdr[10] | (hdr[11] << 8);
+
+  if ((flags & 0x3) == 3 || ((flags >> 2) & 0x3) == 3 ||
+      ((flags >> 4) & 0x3) == 3 || (flags & 0xc0) || addr_bytes > 4) {
+    return -1;
+  }
+  int cmd_lanes = lanes_from_code(flags & 0x3);
+  int addr_lanes = lanes_from_code((flags >> 2) & 0x3);
+  int data_lanes = lanes_from_code((flags >> 4) & 0x3);
+
+  x->opcode = hdr[1];
+  // The address goes out MSB first
+  for (int i = 0; i < addr_bytes; ++i) {
+    x->addr[i] = (addr >> (8 * (addr_bytes - 1 - i))) & 0xff;
+  }
+
+  struct xact_seg segs[XACT_NUM_SEGS] = {
+      {cmd_lanes, 8, &x->opcode, 0},
+      {addr_lanes, 8 * addr_bytes, x->addr, 0},
+      {1, dummy_cycles, NULL, 0},
+      {data_lanes, 8 * write_len, x->req + XACT_HDR_BYTES, 0},
+      {data_lanes, 8 * read_len, NULL, 1},
+  };
+  memcpy(x->segs, segs, sizeof(segs));
+
+  x->seg = 0;
+  x->bit = 0;
+  x->rsp_len = read_len;
+  x->rsp_sent = 0;
+  x->rsp_bits = 0;
+  memset(x->rsp, 0, read_len);
+  return 0;
+}
+
+/**
+ * Skip over empty phases
+ *
+ * @return 0 if there are no more bits in the transaction
+ */
+static int xact_skip_empty(struct spidpi_xact *x) {
+  while (x->seg < XACT_NUM_SEGS && x->bit >= x->segs[x->seg].nbits) {
+    x->seg++;
+    x->bit = 0;
+  }
+  return x->seg < XACT_NUM_SEGS;
+}
+
+/**
+ * Compute the data lines to drive for the current beat of a transaction
+ *
+ * @return P2D_SD and P2D_SD_EN bits
+ */
+static int xact_drive(struct spidpi_xact *x) {
+  const struct xact_seg *seg = &x->segs[x->seg];
+  if (seg->read && seg->lanes == 1) {
+    // Keep driving SDI low while reading the single data line
+    return P2D_SD_EN(0);
+  }
+  if (!seg->data) {
+    return 0;
+  }
+  int ret = 0;
+  for (int lane = 0; lane < seg->lanes; ++lane) {
+    // The highest lane carries the most significant bit of each group
+    int bit = x->bit + (seg->lanes - 1 - lane);
+    if ((seg->data[bit / 8] >> (7 - (bit % 8))) & 1) {
+      ret |= P2D_SD(lane);
+    }
+    ret |= P2D_SD_EN(lane);
+  }
+  return ret;
+}
+
+/**
+ * Sample the data lines for the current beat and move on to the next one
+ */
+static void xact_sample(struct spidpi_xact *x, int d2p) {
+  const struct xact_seg *seg = &x->segs[x->seg];
+  if (seg->read) {
+    for (int lane = seg->lanes - 1; lane >= 0; --lane) {
+      int val = (seg->lanes == 1) ? !!(d2p & D2P_SDO) : !!(d2p & D2P_SD(lane));
+      if (val) {
+        x->rsp[x->rsp_bits / 8] |= 0x80 >> (x->rsp_bits % 8);
+      }
+      x->rsp_bits++;
+    }
+  }
+  x->bit += seg->lanes;
+}
+
+/**
+ * Send as much of the last transaction's response as the terminal will take
+ */
+static void xact_flush_rsp(struct spidpi_ctx *ctx) {
+  struct spidpi_xact *x = ctx->xact;
+  while (x->rsp_sent < x->rsp_len) {
+    ssize_t rv =
+        write(ctx->host, x->rsp + x->rsp_sent, x->rsp_len - x->rsp_sent);
+    if (rv <= 0) {
+      return;
+    }
+    x->rsp_sent += rv;
+  }
+}
+
+/**
+ * Read the next request from the host (transaction-level protocol)
+ *
+ * @return 1 when a complete request is ready to run
+ */
+static int xact_read_req(struct spidpi_ctx *ctx) {
+  struct spidpi_xact *x = ctx->xact;
+
+  // Don't start a new transaction until the last response has gone out.
+  xact_flush_rsp(ctx);
+  if (x->rsp_sent < x->rsp_len) {
+    return 0;
+  }
+
+  size_t want = XACT_HDR_BYTES;
+  if (x->req_len >= XACT_HDR_BYTES) {
+    want += x->req[8] | (x->req[9] << 8);
+  }
+  while (x->req_len < want) {
+    ssize_t n = read(ctx->host, x->req + x->req_len, want - x->req_len);
+    if (n <= 0) {
+      if (n == -1 && errno != EAGAIN) {
+        fprintf(stderr, "Read on SPI FIFO gave %s\n", strerror(errno));
+      }
+      return 0;
+    }
+    x->req_len += n;
+    if (x->req_len == XACT_HDR_BYTES) {
+      want += x->req[8] | (x->req[9] << 8);
+    }
+  }
+
+  x->req_len = 0;
+  if (xact_setup(ctx) != 0) {
+    fprintf(stderr, "SPI: Ignoring malformed transaction header\n");
+    return 0;
+  }
+  return 1;
+}
+
+void *spidpi_create(const char *name, int mode, int loglevel, int xact_mode,
+                    const char *trace_path) {
   int i;
   struct spidpi_ctx *ctx =
       (struct spidpi_ctx *)calloc(1, sizeof(struct spidpi_ctx));
   assert(ctx);
 
   ctx->loglevel = loglevel;
-  ctx->mon = monitor_spi_init(mode);
+  ctx->xact_mode = xact_mode;
+  if (xact_mode) {
+    ctx->xact = (struct spidpi_xact *)calloc(1, sizeof(struct spidpi_xact));
+    assert(ctx->xact);
+  }
   ctx->tick = 0;
   ctx->msbfirst = 1;
   ctx->nmax = MAX_TRANSACTION;
@@ -109,10 +319,26 @@ void *spidpi_create(const char *name, int mode, int loglevel) {
   printf(
       "\n"
       "SPI: Created %s for %s. Connect to it with any terminal program, e.g.\n"
-      "$ screen %s\n"
-      "NOTE: a SPI transaction is run for every 4 characters entered.\n",
+      "$ screen %s\n",
       ctx->ptyname, name, ctx->ptyname);
+  if (xact_mode) {
+    printf("NOTE: using the transaction-level protocol.\n");
+  } else {
+    printf("NOTE: a SPI transaction is run for every 4 characters entered.\n");
+  }
+
+  if (trace_path && *trace_path) {
+    struct bus_trace *trace =
+        bus_trace_open(trace_path, BUS_TRACE_SRC_SPI, loglevel);
+    if (!trace) {
+      return NULL;
+    }
+    ctx->mon = monitor_spi_init(mode, trace);
+    printf("SPI: Binary monitor trace written to %s\n", trace_path);
+    return (void *)ctx;
+  }
 
+  ctx->mon = monitor_spi_init(mode, NULL);
   rv = snprintf(ctx->mon_pathname, PATH_MAX, "%s/%s.log", cwd, name);
   assert(rv <= PATH_MAX && rv > 0);
   ctx->mon_file = fopen(ctx->mon_pathname, "w");
@@ -131,24 +357,76 @@ void *spidpi_create(const char *name, int mode, int loglevel) {
   return (void *)ctx;
 }
 
-char spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data) {
-  struct spidpi_ctx *ctx = (struct spidpi_ctx *)ctx_void;
-  assert(ctx);
-  int d2p = d2p_data->aval;
+/**
+ * Advance a transaction-level transfer by one tick
+ */
+static int xact_tick(struct spidpi_ctx *ctx, int d2p) {
+  struct spidpi_xact *x = ctx->xact;
 
-  // Will tick at the host clock
-  ctx->tick++;
+  if (ctx->state == SP_IDLE) {
+    if (!xact_read_req(ctx)) {
+      return ctx->driving | P2D_SD_EN(0);
+    }
+    ctx->state = SP_CSFALL;
+  }
+  // SPI clock toggles every 4th tick (i.e. freq=primary_frequency/8)
+  if (ctx->tick & 3) {
+    return ctx->driving;
+  }
 
-#ifdef VERILATOR
-#ifdef CONTROL_TRACE
-  if (ctx->tick == 4) {
-    VerilatorSimCtrl::GetInstance().TraceOff();
+  int internal_sck = (ctx->tick & 4) ? 1 : 0;
+  int set_sck = (internal_sck ? P2D_SCK : 0);
+  if (ctx->cpol) {
+    set_sck ^= P2D_SCK;
   }
-#endif
-#endif
 
-  monitor_spi(ctx->mon, ctx->mon_file, ctx->loglevel, ctx->tick, ctx->driving,
-              d2p);
+  if (internal_sck == ctx->cpha) {
+    // host driving edge (falling for mode 0)
+    switch (ctx->state) {
+      case SP_XMOVE:
+        ctx->driving = set_sck | xact_drive(x);
+        break;
+      case SP_XEND:
+        ctx->state = SP_CSRISE;
+        // fallthrough
+      default:
+        ctx->driving = set_sck | (ctx->driving & ~P2D_SCK);
+        break;
+    }
+  } else {
+    // host other edge (rising for mode 0)
+    switch (ctx->state) {
+      case SP_CSFALL:
+        // CSB low, clock at its idle level, drive the first beat
+        if (!xact_skip_empty(x)) {
+          ctx->state = SP_XEND;
+          break;
+        }
+        ctx->driving = (ctx->cpol ? P2D_SCK : 0) | xact_drive(x);
+        ctx->state = SP_XMOVE;
+        break;
+      case SP_XMOVE:
+        xact_sample(x, d2p);
+        if (!xact_skip_empty(x)) {
+          ctx->state = SP_XEND;
+        }
+        ctx->driving = set_sck | (ctx->driving & ~P2D_SCK);
+        break;
+      case SP_CSRISE:
+        // CSB high, clock stopped. Send the response in one go.
+        ctx->driving = P2D_CSB | (ctx->cpol ? P2D_SCK : 0);
+        ctx->state = SP_IDLE;
+        xact_flush_rsp(ctx);
+        break;
+      default:
+        ctx->driving = set_sck | (ctx->driving & ~P2D_SCK);
+        break;
+    }
+  }
+  return ctx->driving;
+}
+
+static int legacy_tick(struct spidpi_ctx *ctx, int d2p) {
 
   if (ctx->state == SP_IDLE) {
     int n = read(ctx->host, &(ctx->buf[ctx->nin]), ctx->nmax - ctx->nin);
@@ -249,11 +527,43 @@ char spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data) {
   return ctx->driving;
 }
 
+int spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data) {
+  struct spidpi_ctx *ctx = (struct spidpi_ctx *)ctx_void;
+  assert(ctx);
+  int d2p = d2p_data->aval;
+
+  // Will tick at the host clock
+  ctx->tick++;
+
+#ifdef VERILATOR
+#ifdef CONTROL_TRACE
+  if (ctx->tick == 4) {
+    VerilatorSimCtrl::GetInstance().TraceOff();
+  }
+#endif
+#endif
+
+  monitor_spi(ctx->mon, ctx->mon_file, ctx->loglevel, ctx->tick, ctx->driving,
+              d2p);
+
+  if (ctx->xact_mode) {
+    return xact_tick(ctx, d2p);
+  }
+
+  // The raw protocol only uses SDI, which is data line 0.
+  int driving = legacy_tick(ctx, d2p);
+  return driving | ((driving & P2D_SDI) ? P2D_SD(0) : 0) | P2D_SD_EN(0);
+}
+
 void spidpi_close(void *ctx_void) {
   struct spidpi_ctx *ctx = (struct spidpi_ctx *)ctx_void;
   if (!ctx) {
     return;
   }
-  fclose(ctx->mon_file);
+  if (ctx->mon_file) {
+    fclose(ctx->mon_file);
+  }
+  monitor_spi_close(ctx->mon);
+  free(ctx->xact);
   free(ctx);
 }
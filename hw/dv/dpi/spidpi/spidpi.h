@@ -7,6 +7,8 @@
 
 #include <svdpi.h>
 
+#include "bus_trace.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -14,20 +16,28 @@ extern "C" {
 // Bits in data to C
 #define D2P_SDO 0x2
 #define D2P_SDO_EN 0x1
+// Data lines 0-3 and their output enables, for dual and quad transfers
+#define D2P_SD(lane) (1 << (2 + (lane)))
+#define D2P_SD_EN(lane) (1 << (6 + (lane)))
 
-// Bits in char from C
+// Bits in value from C
 #define P2D_SCK 0x1
 #define P2D_CSB 0x2
 #define P2D_SDI 0x4
+// Data lines 0-3 as driven by the host, and whether the host is driving them
+#define P2D_SD(lane) (1 << (3 + (lane)))
+#define P2D_SD_EN(lane) (1 << (7 + (lane)))
 
-void *spidpi_create(const char *name, int mode, int loglevel);
-char spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data);
+void *spidpi_create(const char *name, int mode, int loglevel, int xact_mode,
+                    const char *trace_path);
+int spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data);
 void spidpi_close(void *ctx_void);
 
 // monitor
 void monitor_spi(void *mon_void, FILE *mon_file, int loglevel, int tick,
                  int p2d, int d2p);
-void *monitor_spi_init(int mode);
+void *monitor_spi_init(int mode, struct bus_trace *trace);
+void monitor_spi_close(void *mon_void);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -7,6 +7,12 @@
 // Bits in LOG_LEVEL sets what is output on info socket
 // 0x01 -- monitor packets
 // 0x08 -- bit level
+//
+// The spi_device_sd_* ports are the four data lines used for dual and quad
+// transfers. Hosts that only need single-lane transfers may connect just the
+// sdi/sdo ports. Pass +SPIDPI_TRANSACTION_<NAME> to use the transaction-level
+// host protocol described in README.md, and +SPIDPI_TRACE_<NAME>=<file> to write a binary
+// monitor trace instead of the text log.
 
 module spidpi
   #(
@@ -20,22 +26,32 @@ module spidpi
   output logic spi_device_csb_o,
   output logic spi_device_sdi_o,
   input  logic spi_device_sdo_i,
-  input  logic spi_device_sdo_en_i
-
+  input  logic spi_device_sdo_en_i,
+  output logic [3:0] spi_device_sd_o,
+  output logic [3:0] spi_device_sd_en_o,
+  input  logic [3:0] spi_device_sd_i,
+  input  logic [3:0] spi_device_sd_en_i
 );
   import "DPI-C" function
-    chandle spidpi_create(input string name, input int mode, input int loglevel);
+    chandle spidpi_create(input string name, input int mode, input int loglevel,
+                          input int xact_mode, input string trace_path);
 
   import "DPI-C" function
     void spidpi_close(input chandle ctx);
 
   import "DPI-C" function
-    byte spidpi_tick(input chandle ctx_void, input logic [1:0] d2p_data);
+    int spidpi_tick(input chandle ctx_void, input logic [9:0] d2p_data);
 
   chandle ctx;
 
   initial begin
-    ctx = spidpi_create(NAME, MODE, LOG_LEVEL);
+    int xact_mode = 0;
+    string trace_path = "";
+    if ($test$plusargs({"SPIDPI_TRANSACTION_", NAME})) begin
+      xact_mode = 1;
+    end
+    $value$plusargs({"SPIDPI_TRACE_", NAME, "=%s"}, trace_path);
+    ctx = spidpi_create(NAME, MODE, LOG_LEVEL, xact_mode, trace_path);
   end
 
   final begin
@@ -43,16 +59,18 @@ module spidpi
   end
 
   logic       unused_rst = rst_ni;
-  logic [1:0] d2p;
+  logic [9:0] d2p;
   logic       unused_dummy;
 
-  assign d2p = { spi_device_sdo_i, spi_device_sdo_en_i};
+  assign d2p = {spi_device_sd_en_i, spi_device_sd_i, spi_device_sdo_i, spi_device_sdo_en_i};
   always_ff @(posedge clk_i) begin
-    automatic byte p2d = spidpi_tick(ctx, d2p);
-    spi_device_sck_o <= p2d[0];
-    spi_device_csb_o <= p2d[1];
-    spi_device_sdi_o <= p2d[2];
+    automatic int p2d = spidpi_tick(ctx, d2p);
+    spi_device_sck_o   <= p2d[0];
+    spi_device_csb_o   <= p2d[1];
+    spi_device_sdi_o   <= p2d[2];
+    spi_device_sd_o    <= p2d[6:3];
+    spi_device_sd_en_o <= p2d[10:7];
     // stop verilator warning
-    unused_dummy <= |p2d[7:3];
+    unused_dummy <= |p2d[31:11];
   end
 endmodule
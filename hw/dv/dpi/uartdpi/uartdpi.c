@@ -11,14 +11,45 @@
 #endif
 
 #include <assert.h>
+#include <stdint.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+// Size of the buffers between the pseudo-terminal and the simulation. Must be
+// a power of two.
+#define UART_BUF_SIZE 4096
+
+// If there is no I/O thread, the number of calls to uartdpi_can_read() between
+// attempts to read from the pseudo-terminal (and to flush buffered output) if
+// not overridden through uartdpi_create(). Like TICKS_PER_SYSCALL in gpiodpi,
+// this trades the latency of host input against the cost of a syscall every
+// cycle.
+#define DEFAULT_CHECK_INTERVAL 1024
+
+// How long the I/O thread waits for the pseudo-terminal before checking for
+// new output from the simulation.
+#define IO_THREAD_POLL_MS 1
+
+/**
+ * Single-producer, single-consumer byte ring
+ *
+ * rptr and wptr are free-running counters, each written only by one side and
+ * published with a release store, so the ring can be shared between the
+ * simulation and the I/O thread without a lock.
+ */
+struct uart_buf {
+  unsigned int rptr;
+  unsigned int wptr;
+  char buf[UART_BUF_SIZE];
+};
+
 // This keeps the necessary uart state.
 struct uartdpi_ctx {
   char ptyname[64];
@@ -26,11 +57,211 @@ struct uartdpi_ctx {
   int device;
   char tmp_read;
   FILE *log_file;
+  // Host to device (RX from the host's point of view is TX into the design)
+  struct uart_buf to_dev;
+  // Device to host
+  struct uart_buf from_dev;
+  // Polling state if there's no I/O thread
+  unsigned int check_interval;
+  unsigned int check_count;
+  // Set once we've had to discard output because the terminal is full
+  bool dropped_output;
+  // Set when a UART's FIFOs are connected to this terminal directly (see
+  // uartdpi_ff_port()), in which case the pin-level interface is idle.
+  bool ff_attached;
+  char *ff_scope;
+  struct uartdpi_ctx *ff_next;
+  // I/O thread state
+  bool use_io_thread;
+  volatile bool io_thread_run;
+  pthread_t io_thread;
 };
 
-void *uartdpi_create(const char *name, const char *log_file_path) {
+static unsigned int uart_buf_used(struct uart_buf *buf) {
+  return __atomic_load_n(&buf->wptr, __ATOMIC_ACQUIRE) -
+         __atomic_load_n(&buf->rptr, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Get the contiguous free space in a buffer (producer side)
+ */
+static size_t uart_buf_space(struct uart_buf *buf, char **dat) {
+  unsigned int wptr = buf->wptr;
+  unsigned int rptr = __atomic_load_n(&buf->rptr, __ATOMIC_ACQUIRE);
+  unsigned int offset = wptr % UART_BUF_SIZE;
+  size_t space = UART_BUF_SIZE - (wptr - rptr);
+  size_t contig = UART_BUF_SIZE - offset;
+  *dat = &buf->buf[offset];
+  return space < contig ? space : contig;
+}
+
+static void uart_buf_produce(struct uart_buf *buf, size_t len) {
+  __atomic_store_n(&buf->wptr, buf->wptr + (unsigned int)len,
+                   __ATOMIC_RELEASE);
+}
+
+/**
+ * Get the contiguous readable data in a buffer (consumer side)
+ */
+static size_t uart_buf_data(struct uart_buf *buf, const char **dat) {
+  unsigned int rptr = buf->rptr;
+  unsigned int wptr = __atomic_load_n(&buf->wptr, __ATOMIC_ACQUIRE);
+  unsigned int offset = rptr % UART_BUF_SIZE;
+  size_t avail = wptr - rptr;
+  size_t contig = UART_BUF_SIZE - offset;
+  *dat = &buf->buf[offset];
+  return avail < contig ? avail : contig;
+}
+
+static void uart_buf_consume(struct uart_buf *buf, size_t len) {
+  __atomic_store_n(&buf->rptr, buf->rptr + (unsigned int)len,
+                   __ATOMIC_RELEASE);
+}
+
+/**
+ * Read as much as possible from the pseudo-terminal into to_dev
+ */
+static void fill_from_host(struct uartdpi_ctx *ctx) {
+  for (;;) {
+    char *dat;
+    size_t space = uart_buf_space(&ctx->to_dev, &dat);
+    if (!space) {
+      return;
+    }
+    ssize_t rv = read(ctx->host, dat, space);
+    if (rv <= 0) {
+      // Nothing to read (EAGAIN), or no client has the terminal open (EIO)
+      return;
+    }
+    uart_buf_produce(&ctx->to_dev, rv);
+  }
+}
+
+/**
+ * Write as much as possible from from_dev to the pseudo-terminal
+ */
+static void flush_to_host(struct uartdpi_ctx *ctx) {
+  for (;;) {
+    const char *dat;
+    size_t len = uart_buf_data(&ctx->from_dev, &dat);
+    if (!len) {
+      return;
+    }
+    ssize_t rv = write(ctx->host, dat, len);
+    if (rv <= 0) {
+      // The terminal's buffer is full: leave the rest for later.
+      assert((rv == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) &&
+             "Write to pseudo-terminal failed.");
+      return;
+    }
+    uart_buf_consume(&ctx->from_dev, rv);
+  }
+}
+
+/**
+ * Thread function that moves data between the pseudo-terminal and the buffers
+ */
+static void *io_thread_run(void *ctx_void) {
+  struct uartdpi_ctx *ctx = (struct uartdpi_ctx *)ctx_void;
+
+  while (ctx->io_thread_run) {
+    struct pollfd pfd;
+    pfd.fd = ctx->host;
+    pfd.events = 0;
+    if (uart_buf_used(&ctx->to_dev) != UART_BUF_SIZE) {
+      pfd.events |= POLLIN;
+    }
+    if (uart_buf_used(&ctx->from_dev) != 0) {
+      pfd.events |= POLLOUT;
+    }
+    pfd.revents = 0;
+
+    // New output from the simulation doesn't wake us, so this timeout bounds
+    // its latency.
+    poll(&pfd, 1, IO_THREAD_POLL_MS);
+
+    fill_from_host(ctx);
+    flush_to_host(ctx);
+  }
+  return NULL;
+}
+
+/**
+ * The UART side of a fast-forward connection
+ *
+ * A port is created by each UART core that supports fast-forwarding and is
+ * bound to a terminal when one is registered with a matching scope. Ports and
+ * terminals can be created in either order, since they're both created from
+ * initial blocks.
+ */
+struct uartdpi_ff_port {
+  char *scope;
+  struct uartdpi_ctx *ctx;
+  struct uartdpi_ff_port *next;
+};
+
+// All ports and all terminals that have been registered for fast-forwarding.
+// These are only changed from initial and final blocks.
+static struct uartdpi_ff_port *ff_ports;
+static struct uartdpi_ctx *ff_ctxs;
+
+/**
+ * Check whether the hierarchical path `path` has the components in `scope`
+ *
+ * For example, "top.u_dut.u_uart0.uart_core" matches "u_uart0" and
+ * "u_dut.u_uart0", but not "uart0".
+ */
+static bool scope_matches(const char *path, const char *scope) {
+  size_t len = strlen(scope);
+  if (!len) {
+    return false;
+  }
+  for (const char *p = strstr(path, scope); p; p = strstr(p + 1, scope)) {
+    bool start_ok = p == path || p[-1] == '.';
+    bool end_ok = p[len] == '\0' || p[len] == '.';
+    if (start_ok && end_ok) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void ff_try_bind(struct uartdpi_ff_port *port,
+                        struct uartdpi_ctx *ctx) {
+  if (port->ctx || ctx->ff_attached ||
+      !scope_matches(port->scope, ctx->ff_scope)) {
+    return;
+  }
+  port->ctx = ctx;
+  ctx->ff_attached = true;
+  printf("UART: Fast-forwarding %s to %s at FIFO level.\n", port->scope,
+         ctx->ptyname);
+}
+
+static int can_read(struct uartdpi_ctx *ctx) {
+  // Without an I/O thread, only touch the pseudo-terminal every
+  // check_interval calls. Buffered input is still returned straight away.
+  if (!ctx->use_io_thread && ++ctx->check_count >= ctx->check_interval) {
+    ctx->check_count = 0;
+    flush_to_host(ctx);
+    if (uart_buf_used(&ctx->to_dev) == 0) {
+      fill_from_host(ctx);
+    }
+  }
+
+  const char *dat;
+  if (!uart_buf_data(&ctx->to_dev, &dat)) {
+    return 0;
+  }
+  ctx->tmp_read = *dat;
+  uart_buf_consume(&ctx->to_dev, 1);
+  return 1;
+}
+
+void *uartdpi_create(const char *name, const char *log_file_path,
+                     int check_interval, int use_io_thread) {
   struct uartdpi_ctx *ctx =
-      (struct uartdpi_ctx *)malloc(sizeof(struct uartdpi_ctx));
+      (struct uartdpi_ctx *)calloc(1, sizeof(struct uartdpi_ctx));
   assert(ctx);
 
   int rv;
@@ -50,6 +281,20 @@ void *uartdpi_create(const char *name, const char *log_file_path) {
   int new_flags = fcntl(ctx->host, F_SETFL, cur_flags | O_NONBLOCK);
   assert(new_flags != -1 && "Unable to set FD flags");
 
+  ctx->check_interval =
+      check_interval > 0 ? check_interval : DEFAULT_CHECK_INTERVAL;
+  ctx->use_io_thread = use_io_thread != 0;
+  if (ctx->use_io_thread) {
+    ctx->io_thread_run = true;
+    rv = pthread_create(&ctx->io_thread, NULL, io_thread_run, (void *)ctx);
+    if (rv != 0) {
+      fprintf(stderr,
+              "UART: Unable to create I/O thread for %s, polling instead.\n",
+              name);
+      ctx->use_io_thread = false;
+    }
+  }
+
   printf(
       "\n"
       "UART: Created %s for %s. Connect to it with any terminal program, e.g.\n"
@@ -93,6 +338,27 @@ void uartdpi_close(void *ctx_void) {
     return;
   }
 
+  if (ctx->use_io_thread) {
+    ctx->io_thread_run = false;
+    pthread_join(ctx->io_thread, NULL);
+  }
+
+  // Detach from any fast-forward port
+  for (struct uartdpi_ff_port *port = ff_ports; port; port = port->next) {
+    if (port->ctx == ctx) {
+      port->ctx = NULL;
+    }
+  }
+  for (struct uartdpi_ctx **pp = &ff_ctxs; *pp; pp = &(*pp)->ff_next) {
+    if (*pp == ctx) {
+      *pp = ctx->ff_next;
+      break;
+    }
+  }
+  free(ctx->ff_scope);
+  // Send anything that's still buffered
+  flush_to_host(ctx);
+
   close(ctx->host);
   close(ctx->device);
 
@@ -110,11 +376,11 @@ void uartdpi_close(void *ctx_void) {
 
 int uartdpi_can_read(void *ctx_void) {
   struct uartdpi_ctx *ctx = (struct uartdpi_ctx *)ctx_void;
-  if (ctx == NULL) {
+  // When fast-forwarding, input goes to the UART's FIFO instead
+  if (ctx == NULL || ctx->ff_attached) {
     return 0;
   }
-  int rv = read(ctx->host, &ctx->tmp_read, 1);
-  return (rv == 1);
+  return can_read(ctx);
 }
 
 char uartdpi_read(void *ctx_void) {
@@ -130,11 +396,82 @@ void uartdpi_write(void *ctx_void, char c) {
     return;
   }
 
-  rv = write(ctx->host, &c, 1);
-  assert(rv == 1 && "Write to pseudo-terminal failed.");
+  char *dat;
+  if (!uart_buf_space(&ctx->from_dev, &dat) && !ctx->use_io_thread) {
+    flush_to_host(ctx);
+  }
+  if (uart_buf_space(&ctx->from_dev, &dat)) {
+    *dat = c;
+    uart_buf_produce(&ctx->from_dev, 1);
+  } else if (!ctx->dropped_output) {
+    // Nothing is reading the terminal. Drop its output rather than stalling
+    // the simulation (the log file still gets everything).
+    fprintf(stderr,
+            "UART: %s is not being read; dropping terminal output.\n",
+            ctx->ptyname);
+    ctx->dropped_output = true;
+  }
+
+  // Send complete lines promptly, so that anything watching the terminal for
+  // a particular message doesn't have to wait for the next check.
+  if (!ctx->use_io_thread && c == '\n') {
+    flush_to_host(ctx);
+  }
 
   if (ctx->log_file) {
     rv = fwrite(&c, sizeof(char), 1, ctx->log_file);
     assert(rv == 1 && "Write to log file failed.");
   }
 }
+
+void uartdpi_ff_register(void *ctx_void, const char *scope) {
+  struct uartdpi_ctx *ctx = (struct uartdpi_ctx *)ctx_void;
+  if (ctx == NULL || ctx->ff_scope) {
+    return;
+  }
+  ctx->ff_scope = strdup(scope);
+  assert(ctx->ff_scope);
+  ctx->ff_next = ff_ctxs;
+  ff_ctxs = ctx;
+
+  for (struct uartdpi_ff_port *port = ff_ports; port; port = port->next) {
+    ff_try_bind(port, ctx);
+  }
+}
+
+void *uartdpi_ff_port(const char *scope) {
+  struct uartdpi_ff_port *port =
+      (struct uartdpi_ff_port *)calloc(1, sizeof(struct uartdpi_ff_port));
+  assert(port);
+  port->scope = strdup(scope);
+  assert(port->scope);
+  port->next = ff_ports;
+  ff_ports = port;
+
+  for (struct uartdpi_ctx *ctx = ff_ctxs; ctx; ctx = ctx->ff_next) {
+    ff_try_bind(port, ctx);
+  }
+  return (void *)port;
+}
+
+int uartdpi_ff_enabled(void *port_void) {
+  struct uartdpi_ff_port *port = (struct uartdpi_ff_port *)port_void;
+  return port && port->ctx;
+}
+
+int uartdpi_ff_read(void *port_void, svBitVecVal *data) {
+  struct uartdpi_ff_port *port = (struct uartdpi_ff_port *)port_void;
+  if (!port || !port->ctx || !can_read(port->ctx)) {
+    return 0;
+  }
+  *data = (uint8_t)port->ctx->tmp_read;
+  return 1;
+}
+
+void uartdpi_ff_write(void *port_void, const svBitVecVal *data) {
+  struct uartdpi_ff_port *port = (struct uartdpi_ff_port *)port_void;
+  if (!port || !port->ctx) {
+    return;
+  }
+  uartdpi_write(port->ctx, (char)(*data & 0xff));
+}
@@ -5,16 +5,63 @@
 #ifndef OPENTITAN_HW_DV_DPI_UARTDPI_UARTDPI_H_
 #define OPENTITAN_HW_DV_DPI_UARTDPI_UARTDPI_H_
 
+#include <svdpi.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void *uartdpi_create(const char *name, const char *log_file_path);
+/**
+ * Create a UART connected to a new pseudo-terminal
+ *
+ * @param name name of the UART (for display purposes only)
+ * @param log_file_path file to copy device output to ("-" for stdout, "" for
+ *                      none)
+ * @param check_interval if there's no I/O thread, the number of calls to
+ *                       uartdpi_can_read() between checks of the
+ *                       pseudo-terminal (0 for the default)
+ * @param use_io_thread if nonzero, do all pseudo-terminal I/O from a
+ *                      background thread
+ */
+void *uartdpi_create(const char *name, const char *log_file_path,
+                     int check_interval, int use_io_thread);
 void uartdpi_close(void *ctx_void);
 int uartdpi_can_read(void *ctx_void);
 char uartdpi_read(void *ctx_void);
 void uartdpi_write(void *ctx_void, char c);
 
+/**
+ * Offer a terminal for fast-forwarding
+ *
+ * The terminal is connected to the FIFOs of any UART core whose hierarchical
+ * path contains the components in scope (e.g. "u_uart0"). Its pin-level
+ * interface is idle from then on.
+ */
+void uartdpi_ff_register(void *ctx_void, const char *scope);
+
+/**
+ * Create the UART side of a fast-forward connection
+ *
+ * Called by a UART core built with UART_FAST_FORWARD.
+ *
+ * @param scope hierarchical path of the UART core
+ * @return port handle, to pass to the functions below
+ */
+void *uartdpi_ff_port(const char *scope);
+
+/** Return nonzero if a terminal is connected to the port */
+int uartdpi_ff_enabled(void *port_void);
+
+/**
+ * Non-blocking read of a byte from the host
+ *
+ * @return nonzero if a byte was read into *data
+ */
+int uartdpi_ff_read(void *port_void, svBitVecVal *data);
+
+/** Send a byte to the host */
+void uartdpi_ff_write(void *port_void, const svBitVecVal *data);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
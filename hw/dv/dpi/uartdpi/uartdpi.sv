@@ -5,7 +5,16 @@
 module uartdpi #(
   parameter integer BAUD = 'x,
   parameter integer FREQ = 'x,
-  parameter string NAME = "uart0"
+  parameter string NAME = "uart0",
+  // Number of idle TX cycles between checks of the host terminal, unless the
+  // I/O thread is used (0: use the C model's default). Can be overridden with
+  // the `UARTDPI_CHECK_INTERVAL_<name>` plusarg.
+  parameter int CHECK_INTERVAL = 0,
+  // Hierarchical scope (e.g. "u_uart0") of the UART core that this terminal can
+  // be connected to at FIFO level, bypassing the pins. This needs the UART to
+  // be built with UART_FAST_FORWARD and is enabled at runtime with the
+  // `UARTDPI_FAST_FORWARD_<name>` plusarg.
+  parameter string FAST_FORWARD_SCOPE = ""
 )(
   input  logic clk_i,
   input  logic rst_ni,
@@ -21,11 +30,15 @@ module uartdpi #(
   localparam int CYCLES_PER_SYMBOL = FREQ / BAUD;
 
   import "DPI-C" function
-    chandle uartdpi_create(input string name, input string log_file_path);
+    chandle uartdpi_create(input string name, input string log_file_path,
+                           input int check_interval, input int use_io_thread);
 
   import "DPI-C" function
     void uartdpi_close(input chandle ctx);
 
+  import "DPI-C" function
+    void uartdpi_ff_register(input chandle ctx, input string scope);
+
   import "DPI-C" function
     byte uartdpi_read(input chandle ctx);
 
@@ -37,10 +50,18 @@ module uartdpi #(
 
   chandle ctx;
   string log_file_path = DEFAULT_LOG_FILE;
+  int check_interval = CHECK_INTERVAL;
+  int use_io_thread = 0;
 
   function automatic void initialize();
     $value$plusargs({"UARTDPI_LOG_", NAME, "=%s"}, log_file_path);
-    ctx = uartdpi_create(NAME, log_file_path);
+    $value$plusargs({"UARTDPI_CHECK_INTERVAL_", NAME, "=%d"}, check_interval);
+    // Move all terminal I/O to a background thread
+    if ($test$plusargs({"UARTDPI_IO_THREAD_", NAME})) use_io_thread = 1;
+    ctx = uartdpi_create(NAME, log_file_path, check_interval, use_io_thread);
+    if (FAST_FORWARD_SCOPE != "" && $test$plusargs({"UARTDPI_FAST_FORWARD_", NAME})) begin
+      uartdpi_ff_register(ctx, FAST_FORWARD_SCOPE);
+    end
   endfunction
 
   initial begin
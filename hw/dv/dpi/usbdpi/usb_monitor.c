@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "bus_trace.h"
 #include "usb_utils.h"
 #include "usbdpi.h"
 
@@ -26,6 +27,19 @@ typedef enum { M_NONE = 0, M_HOST, M_DEVICE } usbmon_driver_t;
 // Number of bytes in max output buffer line
 #define MAX_OBUF 80
 
+// Record types in binary traces. The aux field holds the bus driver ('H' or
+// 'D') where one applies.
+#define USB_REC_TEXT 0
+#define USB_REC_CLASH 1
+#define USB_REC_IDLE 2
+#define USB_REC_SOP 3
+#define USB_REC_PID 4
+#define USB_REC_BITSTUFF 5
+#define USB_REC_PACKET 6
+
+// Bytes of USB_REC_PACKET payload ahead of the packet bytes
+#define PKT_HDR_BYTES 6
+
 /**
  * USB monitor context
  */
@@ -34,6 +48,14 @@ struct usb_monitor_ctx {
    * Log file
    */
   FILE *file;
+  /**
+   * Binary trace; if non-NULL, this replaces the log file
+   */
+  struct bus_trace *trace;
+  /**
+   * Time of the most recent call to usb_monitor(), for timestamping messages
+   */
+  uint32_t tick_bits;
   /**
    * Monitor state, reflecting the current state of the USB
    */
@@ -79,6 +101,7 @@ static inline void data_callback(usb_monitor_ctx_t *mon,
  * Create and initialize a USB monitor instance
  */
 usb_monitor_ctx_t *usb_monitor_init(const char *filename,
+                                    const char *trace_path, int loglevel,
                                     usb_monitor_data_callback_t data_cb,
                                     void *data_ctx) {
   usb_monitor_ctx_t *mon =
@@ -94,6 +117,16 @@ usb_monitor_ctx_t *usb_monitor_init(const char *filename,
   mon->data_callback = data_cb;
   mon->data_ctx = data_ctx;
 
+  if (trace_path && *trace_path) {
+    mon->trace = bus_trace_open(trace_path, BUS_TRACE_SRC_USB, loglevel);
+    if (!mon->trace) {
+      free(mon);
+      return NULL;
+    }
+    printf("\nUSBDPI: Binary monitor trace written to %s\n", trace_path);
+    return mon;
+  }
+
   mon->file = fopen(filename, "w");
   if (!mon->file) {
     fprintf(stderr, "USBDPI: Unable to open monitor file at %s: %s\n", filename,
@@ -116,7 +149,11 @@ usb_monitor_ctx_t *usb_monitor_init(const char *filename,
  * Finalize a USB monitor
  */
 void usb_monitor_fin(usb_monitor_ctx_t *mon) {
-  fclose(mon->file);
+  if (mon->trace) {
+    bus_trace_close(mon->trace);
+  } else {
+    fclose(mon->file);
+  }
   free(mon);
 }
 
@@ -129,13 +166,27 @@ void usb_monitor_log(usb_monitor_ctx_t *ctx, const char *fmt, ...) {
   va_start(ap, fmt);
   int n = vsnprintf(obuf, MAX_OBUF, fmt, ap);
   va_end(ap);
+  // Output is truncated at the buffer size
+  if (n >= MAX_OBUF) {
+    n = MAX_OBUF - 1;
+  }
+  if (ctx->trace) {
+    bus_trace_payload(ctx->trace, ctx->tick_bits, USB_REC_TEXT, 0, obuf,
+                      (size_t)n);
+    return;
+  }
   size_t written = fwrite(obuf, sizeof(char), (size_t)n, ctx->file);
   assert(written == (size_t)n);
 }
 
 #define DR_SIZE 128
-static char dr[DR_SIZE];
-char *pid_2data(int pid, unsigned char d0, unsigned char d1) {
+
+// Format a description of a token or short packet into dr, which must have
+// space for DR_SIZE characters. This writes to a caller-supplied buffer,
+// rather than a static one, so that monitors can run on different threads in
+// a multi-threaded simulation.
+static const char *pid_2data(char *dr, int pid, unsigned char d0,
+                             unsigned char d1) {
   int comp_crc = CRC5((d1 & 7) << 8 | d0, 11);
   const char *crcok = (comp_crc == d1 >> 3) ? "OK" : "BAD";
 
@@ -172,6 +223,24 @@ char *pid_2data(int pid, unsigned char d0, unsigned char d1) {
   return dr;
 }
 
+// Bus driver, as shown in the log
+static inline char driver_char(const usb_monitor_ctx_t *mon) {
+  return mon->driver == M_HOST ? 'H' : 'D';
+}
+
+// Record a complete packet in the binary trace: the time of the SOP, the PID,
+// whether any bytes followed the PID, then the bytes (including any CRC16).
+static void trace_packet(usb_monitor_ctx_t *mon, uint32_t tick_bits) {
+  uint8_t data[PKT_HDR_BYTES + MON_BYTES_SIZE];
+  bus_trace_put_le32(data, mon->sopAt);
+  data[4] = mon->lastpid;
+  data[5] = (mon->state == MS_GET_BYTES);
+  size_t nbytes = (mon->state == MS_GET_BYTES) ? mon->byte : 0;
+  memcpy(data + PKT_HDR_BYTES, mon->bytes, nbytes);
+  bus_trace_payload(mon->trace, tick_bits, USB_REC_PACKET, driver_char(mon),
+                    data, PKT_HDR_BYTES + nbytes);
+}
+
 /**
  * Per-cycle monitoring of the USB
  */
@@ -181,13 +250,16 @@ void usb_monitor(usb_monitor_ctx_t *mon, int loglevel, uint32_t tick_bits,
   bool compact = ((loglevel & 0x1) != 0);
 
   assert(mon);
+  mon->tick_bits = tick_bits;
 
   // Ascertain state of D+/D- pair; these may have been swapped in some use
   // cases, but we can ascertain this by looking at the pull-up enables.
   // The DUT is a full speed device so the pull up should be on D+
   int dp, dn;
   if ((d2p & D2P_DP_EN) || (d2p & D2P_DN_EN) || (d2p & D2P_D_EN)) {
-    if (hdrive) {
+    if (hdrive && mon->trace) {
+      bus_trace_record(mon->trace, tick_bits, USB_REC_CLASH, 0, NULL, 0);
+    } else if (hdrive) {
       fprintf(mon->file, "mon: %8d: Bus clash\n", tick_bits);
     }
     if (d2p & D2P_TX_USE_D_SE0) {
@@ -222,7 +294,12 @@ void usb_monitor(usb_monitor_ctx_t *mon, int loglevel, uint32_t tick_bits,
     mon->driver = M_HOST;
   } else {
     if ((mon->driver != M_NONE) || (mon->pu != (d2p & D2P_PU))) {
-      if (log) {
+      if (mon->trace) {
+        uint8_t data[4];
+        bus_trace_put_le32(data, d2p);
+        bus_trace_record(mon->trace, tick_bits, USB_REC_IDLE,
+                         (d2p & D2P_PU) ? 1 : 0, data, sizeof(data));
+      } else if (log) {
         if (d2p & D2P_PU) {
           fprintf(mon->file, "mon: %8d: Idle, FS resistor (d2p 0x%x)\n",
                   tick_bits, d2p);
@@ -249,7 +326,10 @@ void usb_monitor(usb_monitor_ctx_t *mon, int loglevel, uint32_t tick_bits,
   if (mon->state == MS_IDLE) {
     if ((mon->line & 0xfff) == ((DK << 10) | (DJ << 8) | (DK << 6) | (DJ << 4) |
                                 (DK << 2) | (DK << 0))) {
-      if (log) {
+      if (mon->trace) {
+        bus_trace_record(mon->trace, tick_bits, USB_REC_SOP, driver_char(mon),
+                         NULL, 0);
+      } else if (log) {
         fprintf(mon->file, "mon: %8d: (%c) SOP\n", tick_bits,
                 mon->driver == M_HOST ? 'H' : 'D');
       }
@@ -263,13 +343,21 @@ void usb_monitor(usb_monitor_ctx_t *mon, int loglevel, uint32_t tick_bits,
 
   // EOP detection, calculate and check the CRC16 on any data field
   if ((mon->line & 0x3f) == ((SE0 << 4) | (SE0 << 2) | (DJ << 0))) {
+    if (mon->trace) {
+      // The decoder does the formatting and CRC checks offline.
+      trace_packet(mon, tick_bits);
+      mon->state = MS_IDLE;
+      data_callback(mon, UsbMon_DataType_EOP, 0U);
+      return;
+    }
     if ((log || compact) && (mon->state == MS_GET_BYTES) && (mon->byte > 0)) {
       uint32_t pkt_crc16, comp_crc16;
 
       if (compact && mon->byte == 2) {
+        char dr[DR_SIZE];
         fprintf(mon->file, "mon: %8d -- %8d: (%c) SOP, PID %s, EOP\n",
                 mon->sopAt, tick_bits, mon->driver == M_HOST ? 'H' : 'D',
-                pid_2data(mon->lastpid, mon->bytes[0], mon->bytes[1]));
+                pid_2data(dr, mon->lastpid, mon->bytes[0], mon->bytes[1]));
       } else if (compact && mon->byte == 1) {
         fprintf(mon->file, "mon: %8d -- %8d: (%c) SOP, PID %s %02x EOP\n",
                 mon->sopAt, tick_bits, mon->driver == M_HOST ? 'H' : 'D',
@@ -318,7 +406,12 @@ void usb_monitor(usb_monitor_ctx_t *mon, int loglevel, uint32_t tick_bits,
   int newbit = (((mon->line & 0xc) >> 2) == (mon->line & 0x3)) ? 1 : 0;
   mon->rawbits = (mon->rawbits << 1) | newbit;
   if ((mon->rawbits & 0x7e) == 0x7e) {
-    if (newbit == 1) {
+    if (newbit == 1 && mon->trace) {
+      uint8_t data[4];
+      bus_trace_put_le32(data, mon->rawbits);
+      bus_trace_record(mon->trace, tick_bits, USB_REC_BITSTUFF,
+                       driver_char(mon), data, sizeof(data));
+    } else if (newbit == 1) {
       fprintf(mon->file, "mon: %8d: (%c) Bitstuff error, got 1 after 0x%x\n",
               tick_bits, mon->driver == M_HOST ? 'H' : 'D', mon->rawbits);
     }
@@ -337,15 +430,21 @@ void usb_monitor(usb_monitor_ctx_t *mon, int loglevel, uint32_t tick_bits,
       // Any byte for which the upper nibble is not the exact complement
       // of the lower nibble is invalid
       uint8_t pid = (uint8_t)mon->bits;
-      if (((pid ^ 0xf0) >> 4) ^ (pid & 0x0f)) {
-        if (log) {
+      bool pid_ok = !(((pid ^ 0xf0) >> 4) ^ (pid & 0x0f));
+      if (mon->trace) {
+        uint8_t data[2] = {pid, pid_ok};
+        bus_trace_record(mon->trace, tick_bits, USB_REC_PID, driver_char(mon),
+                         data, sizeof(data));
+      }
+      if (!pid_ok) {
+        if (log && !mon->trace) {
           fprintf(mon->file, "mon: %8d: (%c) BAD PID 0x%x\n", tick_bits,
                   mon->driver == M_HOST ? 'H' : 'D', pid);
         }
       } else {
         *lastpid = pid;
         mon->lastpid = pid;
-        if (log) {
+        if (log && !mon->trace) {
           fprintf(mon->file, "mon: %8d: (%c) PID %s (0x%x)\n", tick_bits,
                   mon->driver == M_HOST ? 'H' : 'D', decode_pid(pid), pid);
         }
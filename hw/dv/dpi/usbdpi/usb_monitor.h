@@ -29,12 +29,15 @@ typedef void (*usb_monitor_data_callback_t)(void *ctx_v,
 /**
  * Create and initialize a USB monitor instance
  *
- * @param  filename  Filename to be used for log file
- * @param  data_cb   USB data callback function
- * @param  data_ctx  Context for data callback
- * @return           USB monitor context
+ * @param  filename    Filename to be used for log file
+ * @param  trace_path  If non-empty, write a binary trace here instead
+ * @param  loglevel    Log level, recorded in the binary trace for its decoder
+ * @param  data_cb     USB data callback function
+ * @param  data_ctx    Context for data callback
+ * @return             USB monitor context
  */
 usb_monitor_ctx_t *usb_monitor_init(const char *filename,
+                                    const char *trace_path, int loglevel,
                                     usb_monitor_data_callback_t data_cb,
                                     void *data_ctx);
 
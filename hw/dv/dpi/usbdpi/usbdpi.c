@@ -21,7 +21,8 @@
 
 // Indexed directly by ctx->state (ST_)
 static const char *st_states[] = {"ST_IDLE 0", "ST_SEND 1", "ST_GET 2",
-                                  "ST_SYNC 3", "ST_EOP 4",  "ST_EOP0 5"};
+                                  "ST_SYNC 3", "ST_EOP 4",  "ST_EOP0 5",
+                                  "ST_PACKET 6"};
 
 // Indexed directly by ct-x>hostSt (HS_)
 static const char *hs_states[] = {
@@ -105,7 +106,7 @@ static void usbdpi_data_callback(void *ctx_v, usbmon_data_type_t type,
 /**
  * Create a USB DPI instance, returning a 'chandle' for later use
  */
-void *usbdpi_create(const char *name, int loglevel) {
+void *usbdpi_create(const char *name, int loglevel, const char *trace_path) {
   // Use calloc for zero-initialisation
   usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)calloc(1, sizeof(usbdpi_ctx_t));
   assert(ctx);
@@ -132,7 +133,8 @@ void *usbdpi_create(const char *name, int loglevel) {
   int rv = snprintf(ctx->mon_pathname, FILENAME_MAX, "%s/%s.log", cwd, name);
   assert(rv <= FILENAME_MAX && rv > 0);
 
-  ctx->mon = usb_monitor_init(ctx->mon_pathname, usbdpi_data_callback, ctx);
+  ctx->mon = usb_monitor_init(ctx->mon_pathname, trace_path, loglevel,
+                              usbdpi_data_callback, ctx);
 
   // Prepare the transfer descriptors for use
   usb_transfer_setup(ctx);
@@ -140,6 +142,54 @@ void *usbdpi_create(const char *name, int loglevel) {
   return (void *)ctx;
 }
 
+// Advance the bus state at the end of a packet from the device
+static void device_eop(usbdpi_ctx_t *ctx) {
+  switch (ctx->bus_state) {
+    // Control Transfers
+    case kUsbControlSetup:
+      ctx->bus_state = kUsbControlSetupAck;
+      break;
+    case kUsbControlDataOut:
+      ctx->bus_state = kUsbControlDataOutAck;
+      break;
+    case kUsbControlStatusInToken:
+      ctx->bus_state = kUsbControlStatusInData;
+      break;
+    case kUsbControlDataInToken:
+      ctx->bus_state = kUsbControlDataInData;
+      break;
+    case kUsbControlStatusOut:
+      ctx->bus_state = kUsbControlStatusOutAck;
+      break;
+
+    // Isochronous Transfers
+    case kUsbIsoInToken:
+      ctx->bus_state = kUsbIsoInData;
+      break;
+
+    // Bulk Transfers
+    case kUsbBulkOut:
+      ctx->bus_state = kUsbBulkOutAck;
+      break;
+    case kUsbBulkInToken:
+      ctx->bus_state = kUsbBulkInData;
+      break;
+
+    // Interrupt Transfers
+    case kUsbInterruptOut:
+      ctx->bus_state = kUsbInterruptOutAck;
+      break;
+    case kUsbInterruptInToken:
+      ctx->bus_state = kUsbInterruptInData;
+      break;
+
+    // TODO - this shall become an error condition; we're not expecting
+    //        a transmission from the device, and thus no EOP either
+    default:
+      break;
+  }
+}
+
 void usbdpi_device_to_host(void *ctx_void, const svBitVecVal *usb_d2p) {
   usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_void;
   assert(ctx);
@@ -188,6 +238,7 @@ void usbdpi_device_to_host(void *ctx_void, const svBitVecVal *usb_d2p) {
       case ST_SEND:
       case ST_EOP:
       case ST_EOP0:
+      case ST_PACKET:
         printf(
             "[usbdpi] frame 0x%x tick_bits 0x%x error state %s hs %s and "
             "device "
@@ -255,51 +306,26 @@ void usbdpi_device_to_host(void *ctx_void, const svBitVecVal *usb_d2p) {
 
   // Device-to-Host EOP
   if (ctx->state == ST_GET && dp == 0 && dn == 0) {
-    switch (ctx->bus_state) {
-      // Control Transfers
-      case kUsbControlSetup:
-        ctx->bus_state = kUsbControlSetupAck;
-        break;
-      case kUsbControlDataOut:
-        ctx->bus_state = kUsbControlDataOutAck;
-        break;
-      case kUsbControlStatusInToken:
-        ctx->bus_state = kUsbControlStatusInData;
-        break;
-      case kUsbControlDataInToken:
-        ctx->bus_state = kUsbControlDataInData;
-        break;
-      case kUsbControlStatusOut:
-        ctx->bus_state = kUsbControlStatusOutAck;
-        break;
-
-      // Isochronous Transfers
-      case kUsbIsoInToken:
-        ctx->bus_state = kUsbIsoInData;
-        break;
-
-      // Bulk Transfers
-      case kUsbBulkOut:
-        ctx->bus_state = kUsbBulkOutAck;
-        break;
-      case kUsbBulkInToken:
-        ctx->bus_state = kUsbBulkInData;
-        break;
-
-      // Interrupt Transfers
-      case kUsbInterruptOut:
-        ctx->bus_state = kUsbInterruptOutAck;
-        break;
-      case kUsbInterruptInToken:
-        ctx->bus_state = kUsbInterruptInData;
-        break;
+    device_eop(ctx);
+  }
+}
 
-      // TODO - this shall become an error condition; we're not expecting
-      //        a transmission from the device, and thus no EOP either
-      default:
-        break;
-    }
+// Pass a packet from the device straight to the host, as if it had been
+// received on the bus
+void usbdpi_device_packet(usbdpi_ctx_t *ctx, const uint8_t *pkt,
+                          unsigned len) {
+  assert(ctx && len > 0U);
+  usbdpi_drv_state_t state = ctx->state;
+  ctx->state = ST_GET;
+  usbdpi_data_callback(ctx, UsbMon_DataType_Sync, 0U);
+  usbdpi_data_callback(ctx, UsbMon_DataType_PID, pkt[0]);
+  for (unsigned i = 1U; i < len; i++) {
+    usbdpi_data_callback(ctx, UsbMon_DataType_Byte, pkt[i]);
   }
+  usbdpi_data_callback(ctx, UsbMon_DataType_EOP, 0U);
+  ctx->lastrxpid = pkt[0];
+  device_eop(ctx);
+  ctx->state = state;
 }
 
 // Callback for USB data detection
@@ -1133,7 +1159,9 @@ uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p) {
 
   // Monitor, analyse and record USB bus activity
   usb_monitor(ctx->mon, ctx->loglevel, ctx->tick_bits,
-              (ctx->state != ST_IDLE) && (ctx->state != ST_GET), ctx->driving,
+              (ctx->state != ST_IDLE) && (ctx->state != ST_GET) &&
+                  (ctx->state != ST_PACKET),
+              ctx->driving,
               d2p, &(ctx->lastrxpid));
 
   if (ctx->tick_bits == SENSE_AT) {
@@ -1361,6 +1389,13 @@ uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p) {
     } break;
 
     case ST_SYNC:
+      // With a packet-level connection, everything except SOF goes straight
+      // to the device; see usbdpi_packet.c
+      if (ctx->pkt_port && ctx->byte == 0 &&
+          ctx->sending->data[0] != USB_PID_SOF) {
+        ctx->state = ST_PACKET;
+        break;
+      }
       dat = ((USB_SYNC & ctx->bit)) ? P2D_DP : P2D_DN;
       ctx->driving = set_driving(ctx, d2p, dat, true);
       force_stat = 1;
@@ -1434,6 +1469,10 @@ uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p) {
       // Device is driving the bus; nothing to do here
       break;
 
+    case ST_PACKET:
+      // Packet is being collected by the device; see usbdpi_pkt_rx()
+      break;
+
     default:
       assert(!"Unknown/invalid USBDPI drive state");
       break;
@@ -1473,6 +1512,7 @@ void usbdpi_close(void *ctx_void) {
   if (!ctx) {
     return;
   }
+  usbdpi_pkt_unregister(ctx);
   usb_monitor_fin(ctx->mon);
   free(ctx);
 }
@@ -180,7 +180,9 @@ typedef enum {
   ST_GET = 2,
   ST_SYNC = 3,
   ST_EOP = 4,
-  ST_EOP0 = 5
+  ST_EOP0 = 5,
+  // Host packet is being passed to the device at its packet interface
+  ST_PACKET = 6
 } usbdpi_drv_state_t;
 
 // Host states
@@ -240,6 +242,9 @@ typedef enum usbdpi_bus_state {
   kUsbInterruptInData,
 } usbdpi_bus_state_t;
 
+// Device side of a packet-level connection (see usbdpi_packet.c)
+struct usbdpi_pkt_port;
+
 /**
  * USB DPI state information
  */
@@ -384,6 +389,14 @@ struct usbdpi_ctx {
    * Length of configuration descriptor
    */
   uint16_t cfg_desc_len;
+  /**
+   * Packet-level connection to the device (NULL iff none), the scope of the
+   * device that may be connected, and the next host offering a connection
+   */
+  struct usbdpi_pkt_port *pkt_port;
+  char *pkt_scope;
+  usbdpi_ctx_t *pkt_next;
+
   /**
    * Linked-list of free transfer descriptors
    */
@@ -398,7 +411,7 @@ struct usbdpi_ctx {
 /**
  * Create a USB DPI instance, returning a 'chandle' for later use
  */
-void *usbdpi_create(const char *name, int loglevel);
+void *usbdpi_create(const char *name, int loglevel, const char *trace_path);
 /**
  * Close a USB DPI instance
  */
@@ -419,6 +432,58 @@ uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p);
  */
 void usbdpi_diags(void *ctx_void, svBitVecVal *diags);
 
+/**
+ * Pass a complete packet (PID first, including any CRC16) from the device to
+ * the host without bus-level signalling
+ */
+void usbdpi_device_packet(usbdpi_ctx_t *ctx, const uint8_t *pkt,
+                          unsigned len);
+
+/**
+ * Offer a host for packet-level connection
+ *
+ * The host exchanges packets directly with the protocol engine of any usbdev
+ * whose hierarchical path contains the components in scope (e.g. "u_usbdev").
+ * SOF packets and bus resets are still signalled on the bus.
+ */
+void usbdpi_pkt_register(void *ctx_void, const char *scope);
+
+/**
+ * Withdraw a host from packet-level connection
+ */
+void usbdpi_pkt_unregister(usbdpi_ctx_t *ctx);
+
+/**
+ * Create the device side of a packet-level connection
+ *
+ * Called by usbdev when built with USBDEV_PACKET_DPI.
+ *
+ * @param scope hierarchical path of the protocol engine
+ * @return port handle, to pass to the functions below
+ */
+void *usbdpi_pkt_port(const char *scope);
+
+/**
+ * Return nonzero if a host is connected to the port
+ */
+int usbdpi_pkt_enabled(void *port_void);
+
+/**
+ * Retrieve the next host-to-device packet event, if any, for this clock cycle
+ *
+ * @param data PID, token or data byte, or validity flags at the packet end
+ * @return event type; see usb_fs_nb_pe.sv
+ */
+int usbdpi_pkt_rx(void *port_void, svBitVecVal *data);
+
+/**
+ * Collect a device-to-host packet from the protocol engine, in place of
+ * usb_fs_tx
+ *
+ * @return bit 0 to take the data byte, bit 1 at the end of the packet
+ */
+int usbdpi_pkt_tx(void *port_void, int start, int pid, int avail, int data);
+
 /**
  * Calculate 5-bit CRC used to check token packets
  */
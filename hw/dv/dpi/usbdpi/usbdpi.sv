@@ -8,10 +8,18 @@
 // 0x01 -- monitor_usb (packet level)
 // 0x02 -- more verbose monitor
 // 0x08 -- bit level
+//
+// Pass +USBDPI_TRACE_<NAME>=<file> to write a binary monitor trace instead of the text log; see
+// hw/dv/dpi/common/bus_trace/README.md.
 
 module usbdpi #(
   parameter string NAME = "usb0",
-  parameter int LOG_LEVEL = 1
+  parameter int LOG_LEVEL = 1,
+  // Hierarchical scope (e.g. "u_usbdev") of the usbdev with which this host can exchange packets
+  // directly, bypassing bit-level signalling for everything except SOF packets and bus resets.
+  // This needs usbdev to be built with USBDEV_PACKET_DPI and is enabled at runtime with the
+  // `USBDPI_PACKET_<NAME>` plusarg.
+  parameter string PACKET_SCOPE = ""
 )(
   input  logic clk_i,
   input  logic rst_ni,
@@ -37,7 +45,7 @@ module usbdpi #(
   input  logic pullupdn_d2p
 );
   import "DPI-C" function
-    chandle usbdpi_create(input string name, input int loglevel);
+    chandle usbdpi_create(input string name, input int loglevel, input string trace_path);
 
   import "DPI-C" function
     void usbdpi_device_to_host(input chandle ctx, input bit [10:0] d2p);
@@ -45,6 +53,9 @@ module usbdpi #(
   import "DPI-C" function
     void usbdpi_close(input chandle ctx);
 
+  import "DPI-C" function
+    void usbdpi_pkt_register(input chandle ctx, input string scope);
+
   import "DPI-C" function
     byte usbdpi_host_to_device(input chandle ctx, input bit [10:0] d2p);
 
@@ -54,7 +65,12 @@ module usbdpi #(
   chandle ctx;
 
   initial begin
-    ctx = usbdpi_create(NAME, LOG_LEVEL);
+    string trace_path = "";
+    $value$plusargs({"USBDPI_TRACE_", NAME, "=%s"}, trace_path);
+    ctx = usbdpi_create(NAME, LOG_LEVEL, trace_path);
+    if (PACKET_SCOPE != "" && $test$plusargs({"USBDPI_PACKET_", NAME})) begin
+      usbdpi_pkt_register(ctx, PACKET_SCOPE);
+    end
   end
 
   final begin
@@ -153,7 +169,8 @@ module usbdpi #(
     ST_GET = 2,
     ST_SYNC = 3,
     ST_EOP = 4,
-    ST_EOP0 = 5
+    ST_EOP0 = 5,
+    ST_PACKET = 6
   } usbdpi_drv_state_t;
 
   // Test steps
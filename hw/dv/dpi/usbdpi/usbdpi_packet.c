@@ -0,0 +1,298 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Transaction-level connection between the DPI host and usbdev
+//
+// A usbdev built with USBDEV_PACKET_DPI creates a port for its protocol
+// engine, and a host registered with a matching scope is bound to it. From
+// then on, tokens, data packets and handshakes are exchanged with the protocol
+// engine at its packet interface instead of being serialized onto D+/D-. SOF
+// packets and bus resets are still signalled on the bus, so that link state
+// detection within usbdev (activity, suspend, reset) continues to work.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "usb_utils.h"
+#include "usbdpi.h"
+
+// Clock cycles between successive packet bytes delivered to the device; one
+// bit interval, compared with eight on the bus
+#define PKT_RX_BYTE_CLKS 4U
+// Clock cycles between the token and data packets of a transfer
+#define PKT_RX_GAP_CLKS 16U
+// Clock cycles before the first byte of a device packet is collected, and
+// between subsequent bytes
+#define PKT_TX_FIRST_CLKS 16U
+#define PKT_TX_BYTE_CLKS 8U
+
+// Events returned by usbdpi_pkt_rx(); see usb_fs_nb_pe.sv
+enum {
+  kPktRxNone = 0,
+  kPktRxStart = 1,
+  kPktRxToken = 2,
+  kPktRxData = 3,
+  kPktRxEnd = 4,
+};
+
+// Flags returned by usbdpi_pkt_tx()
+#define PKT_TX_DATA_GET 0x1
+#define PKT_TX_END 0x2
+
+// Flags accompanying kPktRxEnd
+#define PKT_RX_PID_VALID 0x1
+#define PKT_RX_PKT_VALID 0x2
+
+/**
+ * The device side of a packet-level connection
+ */
+struct usbdpi_pkt_port {
+  char *scope;
+  usbdpi_ctx_t *ctx;
+  struct usbdpi_pkt_port *next;
+
+  // Host to device: offset of the current packet within ctx->sending, and
+  // whether its PID has been delivered
+  unsigned rx_start;
+  bool rx_in_pkt;
+  unsigned rx_delay;
+
+  // Device to host: packet being collected from the protocol engine, PID first
+  bool tx_active;
+  unsigned tx_delay;
+  unsigned tx_len;
+  uint8_t tx_pkt[USBDPI_MAX_DATA];
+};
+
+// All ports and all hosts that have been registered for packet-level
+// connection. These are only changed from initial and final blocks.
+static struct usbdpi_pkt_port *pkt_ports;
+static usbdpi_ctx_t *pkt_ctxs;
+
+/**
+ * Check whether the hierarchical path `path` has the components in `scope`
+ *
+ * For example, "top.u_dut.u_usbdev.u_usb_fs_nb_pe" matches "u_usbdev", but
+ * not "usbdev"; this follows the matching of uartdpi fast-forward ports.
+ */
+static bool scope_matches(const char *path, const char *scope) {
+  size_t len = strlen(scope);
+  if (!len) {
+    return false;
+  }
+  for (const char *p = strstr(path, scope); p; p = strstr(p + 1, scope)) {
+    bool start_ok = p == path || p[-1] == '.';
+    bool end_ok = p[len] == '\0' || p[len] == '.';
+    if (start_ok && end_ok) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void pkt_try_bind(struct usbdpi_pkt_port *port, usbdpi_ctx_t *ctx) {
+  if (port->ctx || ctx->pkt_port ||
+      !scope_matches(port->scope, ctx->pkt_scope)) {
+    return;
+  }
+  port->ctx = ctx;
+  ctx->pkt_port = port;
+  printf("[usbdpi] Exchanging packets with %s directly.\n", port->scope);
+}
+
+// Record a packet in the monitor log, since it doesn't appear on the bus
+static void pkt_log(usbdpi_ctx_t *ctx, const char *dir, const uint8_t *pkt,
+                    unsigned len) {
+  if (!(ctx->loglevel & LOG_MON)) {
+    return;
+  }
+  char text[3U * USBDPI_MAX_DATA + 1U];
+  for (unsigned i = 0U; i < len; i++) {
+    snprintf(&text[3U * i], 4U, " %02x", pkt[i]);
+  }
+  text[3U * len] = '\0';
+  usb_monitor_log(ctx->mon, "0x%-3x 0x%-8x Packet %s%s\n", ctx->frame,
+                  ctx->tick_bits, dir, text);
+}
+
+// Check the PID, length and CRC of a host packet, as usb_fs_rx would
+static int pkt_rx_flags(const uint8_t *pkt, unsigned len) {
+  uint8_t pid = pkt[0];
+  if (((pid ^ 0xf0U) >> 4) != (pid & 0xfU)) {
+    return 0;
+  }
+  bool valid;
+  switch (pid & 3U) {
+    case 1U:  // Token
+      valid = (len == 3U) &&
+              ((unsigned)(pkt[2] >> 3) ==
+               CRC5(pkt[1] | ((pkt[2] & 7U) << 8), 11));
+      break;
+    case 3U:  // Data
+      valid = (len >= 3U) &&
+              (CRC16(&pkt[1], len - 3U) ==
+               (uint32_t)(pkt[len - 2U] | (pkt[len - 1U] << 8)));
+      break;
+    case 2U:  // Handshake
+      valid = (len == 1U);
+      break;
+    default:  // Special
+      valid = false;
+      break;
+  }
+  return PKT_RX_PID_VALID | (valid ? PKT_RX_PKT_VALID : 0);
+}
+
+void usbdpi_pkt_register(void *ctx_void, const char *scope) {
+  usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_void;
+  if (ctx == NULL || ctx->pkt_scope) {
+    return;
+  }
+  ctx->pkt_scope = strdup(scope);
+  assert(ctx->pkt_scope);
+  ctx->pkt_next = pkt_ctxs;
+  pkt_ctxs = ctx;
+
+  for (struct usbdpi_pkt_port *port = pkt_ports; port; port = port->next) {
+    pkt_try_bind(port, ctx);
+  }
+}
+
+void usbdpi_pkt_unregister(usbdpi_ctx_t *ctx) {
+  if (ctx->pkt_port) {
+    ctx->pkt_port->ctx = NULL;
+    ctx->pkt_port = NULL;
+  }
+  for (usbdpi_ctx_t **pp = &pkt_ctxs; *pp; pp = &(*pp)->pkt_next) {
+    if (*pp == ctx) {
+      *pp = ctx->pkt_next;
+      break;
+    }
+  }
+  free(ctx->pkt_scope);
+  ctx->pkt_scope = NULL;
+}
+
+void *usbdpi_pkt_port(const char *scope) {
+  struct usbdpi_pkt_port *port =
+      (struct usbdpi_pkt_port *)calloc(1, sizeof(struct usbdpi_pkt_port));
+  assert(port);
+  port->scope = strdup(scope);
+  assert(port->scope);
+  port->next = pkt_ports;
+  pkt_ports = port;
+
+  for (usbdpi_ctx_t *ctx = pkt_ctxs; ctx; ctx = ctx->pkt_next) {
+    pkt_try_bind(port, ctx);
+  }
+  return (void *)port;
+}
+
+int usbdpi_pkt_enabled(void *port_void) {
+  struct usbdpi_pkt_port *port = (struct usbdpi_pkt_port *)port_void;
+  return port && port->ctx;
+}
+
+int usbdpi_pkt_rx(void *port_void, svBitVecVal *data) {
+  struct usbdpi_pkt_port *port = (struct usbdpi_pkt_port *)port_void;
+  if (!port || !port->ctx) {
+    return kPktRxNone;
+  }
+  usbdpi_ctx_t *ctx = port->ctx;
+  if (ctx->state != ST_PACKET) {
+    // Rewind in case the transfer was abandoned, eg. by a disconnection
+    port->rx_start = 0U;
+    port->rx_in_pkt = false;
+    port->rx_delay = 0U;
+    return kPktRxNone;
+  }
+  if (port->rx_delay) {
+    port->rx_delay--;
+    return kPktRxNone;
+  }
+
+  const usbdpi_transfer_t *sending = ctx->sending;
+  assert(sending);
+  // A transfer holds either a single packet, or a token packet followed by a
+  // data packet starting at data_start
+  unsigned start = port->rx_in_pkt ? port->rx_start : (unsigned)ctx->byte;
+  unsigned end = sending->num_bytes;
+  if (start < sending->data_start && sending->data_start < end) {
+    end = sending->data_start;
+  }
+
+  port->rx_delay = PKT_RX_BYTE_CLKS - 1U;
+  if (!port->rx_in_pkt) {
+    uint8_t pid = sending->data[ctx->byte++];
+    port->rx_start = start;
+    port->rx_in_pkt = true;
+    // The bus monitor would have recorded this PID
+    if (((pid ^ 0xf0U) >> 4) == (pid & 0xfU)) {
+      ctx->lastrxpid = pid;
+    }
+    *data = pid;
+    return kPktRxStart;
+  }
+  if ((unsigned)ctx->byte < end) {
+    bool is_data = (sending->data[start] & 3U) == 3U;
+    *data = sending->data[ctx->byte++];
+    return is_data ? kPktRxData : kPktRxToken;
+  }
+
+  const uint8_t *pkt = &sending->data[start];
+  unsigned len = end - start;
+  *data = pkt_rx_flags(pkt, len);
+  pkt_log(ctx, "H>D", pkt, len);
+  port->rx_in_pkt = false;
+  if (end < sending->num_bytes) {
+    port->rx_delay = PKT_RX_GAP_CLKS - 1U;
+  } else {
+    ctx->state = ST_IDLE;
+  }
+  return kPktRxEnd;
+}
+
+int usbdpi_pkt_tx(void *port_void, int start, int pid, int avail, int data) {
+  struct usbdpi_pkt_port *port = (struct usbdpi_pkt_port *)port_void;
+  if (!port || !port->ctx) {
+    return 0;
+  }
+  if (start) {
+    // Complete the PID with its check bits, as usb_fs_tx does
+    port->tx_active = true;
+    port->tx_pkt[0] = (uint8_t)((pid & 0xf) | ((~pid & 0xf) << 4));
+    port->tx_len = 1U;
+    port->tx_delay = PKT_TX_FIRST_CLKS - 1U;
+    return 0;
+  }
+  if (!port->tx_active) {
+    return 0;
+  }
+  if (port->tx_delay) {
+    port->tx_delay--;
+    return 0;
+  }
+  // Only data packets carry bytes beyond the PID
+  bool is_data = (port->tx_pkt[0] & 3U) == 3U;
+  if (is_data && avail) {
+    assert(port->tx_len < 1U + USBDEV_MAX_PACKET_SIZE);
+    port->tx_pkt[port->tx_len++] = (uint8_t)data;
+    port->tx_delay = PKT_TX_BYTE_CLKS - 1U;
+    return PKT_TX_DATA_GET;
+  }
+
+  // Append the CRC16 of any data field, as usb_fs_tx does
+  if (is_data) {
+    uint32_t crc = CRC16(&port->tx_pkt[1], port->tx_len - 1U);
+    port->tx_pkt[port->tx_len++] = (uint8_t)crc;
+    port->tx_pkt[port->tx_len++] = (uint8_t)(crc >> 8);
+  }
+  port->tx_active = false;
+
+  pkt_log(port->ctx, "D>H", port->tx_pkt, port->tx_len);
+  usbdpi_device_packet(port->ctx, port->tx_pkt, port->tx_len);
+  return PKT_TX_END;
+}
@@ -22,6 +22,18 @@
       (uint8_t)((lfsr) << 1) ^ \
       ((((lfsr) >> 1) ^ ((lfsr) >> 2) ^ ((lfsr) >> 3) ^ ((lfsr) >> 7)) & 1U))
 
+// Period of the LFSR; the all-zeroes state is never entered from any other
+#define LFSR_PERIOD 255U
+
+// Keystream table: one full cycle of the LFSR output, repeated so that any
+// run of up to LFSR_PERIOD bytes from any starting state is contiguous
+static uint8_t lfsr_seq[2U * LFSR_PERIOD];
+// Offset of each LFSR state within lfsr_seq
+static uint8_t lfsr_pos[0x100U];
+// Output of an LFSR in the (stuck) all-zeroes state
+static const uint8_t lfsr_zeroes[LFSR_PERIOD] = {0};
+static bool lfsr_table_ready = false;
+
 // Stream signature words
 #define STREAM_SIGNATURE_HEAD 0x579EA01AU
 #define STREAM_SIGNATURE_TAIL 0x160AE975U
@@ -62,6 +74,58 @@ static usbdpi_transfer_t *stream_data_process(usbdpi_ctx_t *ctx,
 static bool stream_sig_check(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
                              usbdpi_transfer_t *rx);
 
+// Build the LFSR keystream table
+static void lfsr_table_init(void) {
+  if (lfsr_table_ready) {
+    return;
+  }
+  uint8_t lfsr = 1U;
+  for (unsigned idx = 0U; idx < LFSR_PERIOD; idx++) {
+    lfsr_pos[lfsr] = (uint8_t)idx;
+    lfsr_seq[idx] = lfsr;
+    lfsr_seq[idx + LFSR_PERIOD] = lfsr;
+    lfsr = LFSR_ADVANCE(lfsr);
+  }
+  assert(lfsr == 1U);
+  lfsr_table_ready = true;
+}
+
+// Return the next `len` (at most LFSR_PERIOD) bytes of output from an LFSR,
+// without advancing it
+static inline const uint8_t *lfsr_keystream(uint8_t lfsr, unsigned len) {
+  assert(len <= LFSR_PERIOD);
+  (void)len;
+  return lfsr ? &lfsr_seq[lfsr_pos[lfsr]] : lfsr_zeroes;
+}
+
+// Return the state of an LFSR after `len` more bytes of output
+static inline uint8_t lfsr_skip(uint8_t lfsr, unsigned len) {
+  return lfsr ? lfsr_seq[(lfsr_pos[lfsr] + len) % LFSR_PERIOD] : 0U;
+}
+
+// Append a transfer to the list of those received on a stream
+static inline void received_append(usbdpi_stream_t *s,
+                                   usbdpi_transfer_t *tr) {
+  tr->next = NULL;
+  if (s->received) {
+    s->received_tail->next = tr;
+  } else {
+    s->received = tr;
+  }
+  s->received_tail = tr;
+}
+
+// Remove and return the oldest transfer received on a stream
+static inline usbdpi_transfer_t *received_remove(usbdpi_stream_t *s) {
+  usbdpi_transfer_t *tr = s->received;
+  assert(tr);
+  s->received = tr->next;
+  if (!s->received) {
+    s->received_tail = NULL;
+  }
+  return tr;
+}
+
 // Determine the next stream for which IN data packets shall be requested
 inline unsigned in_stream_next(usbdpi_ctx_t *ctx) {
   uint8_t id = ctx->stream_in;
@@ -93,6 +157,8 @@ bool streams_init(usbdpi_ctx_t *ctx, unsigned nstreams,
     return false;
   }
 
+  lfsr_table_init();
+
   if (verbose) {
     printf("[usbdpi] Stream test running with %u streams(s)\n", nstreams);
     printf("[usbdpi] - retrieve %c checking %c retrying %c send %c\n",
@@ -135,6 +201,7 @@ bool streams_init(usbdpi_ctx_t *ctx, unsigned nstreams,
     ctx->stream[id].nretries = 0U;
     // No received packets
     ctx->stream[id].received = NULL;
+    ctx->stream[id].received_tail = NULL;
   }
   return true;
 }
@@ -197,18 +264,21 @@ bool stream_data_check(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
         // Note: use a local copy of the LFSR so that we can check the data
         //       field even on those packets that we choose to reject
         uint8_t tst_lfsr = s->tst_lfsr;
-        while (num_bytes-- > 0U) {
-          uint8_t recvd = *sp++;
-          if (recvd != tst_lfsr) {
-            printf(
-                "[usbdpi] %c%u: Mismatched data from device 0x%02x, "
-                "expected 0x%02x\n",
-                xfr_sym[s->xfr_type], s->id, recvd, tst_lfsr);
-            ok = false;
+        const uint8_t *expected = lfsr_keystream(tst_lfsr, num_bytes);
+        if (memcmp(sp, expected, num_bytes)) {
+          // Report each of the mismatched bytes
+          for (unsigned idx = 0U; idx < num_bytes; idx++) {
+            if (sp[idx] != expected[idx]) {
+              printf(
+                  "[usbdpi] %c%u: Mismatched data from device 0x%02x, "
+                  "expected 0x%02x\n",
+                  xfr_sym[s->xfr_type], s->id, sp[idx], expected[idx]);
+            }
           }
-          // Advance our local LFSR
-          tst_lfsr = LFSR_ADVANCE(tst_lfsr);
+          ok = false;
         }
+        // Advance our local LFSR
+        tst_lfsr = lfsr_skip(tst_lfsr, num_bytes);
 
         // Update the LFSR only if we've accepted valid data and will not
         // be receiving this data again
@@ -236,10 +306,8 @@ usbdpi_transfer_t *stream_data_gen(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
     ctx->ep_in[s->ep_in].next_data = DATA_TOGGLE_ADVANCE(data);
     // ...and that the data is as expected
     uint8_t *dp = transfer_data_start(tr, data, len);
-    for (unsigned idx = 0U; idx < len; idx++) {
-      dp[idx] = s->tst_lfsr;
-      s->tst_lfsr = LFSR_ADVANCE(s->tst_lfsr);
-    }
+    memcpy(dp, lfsr_keystream(s->tst_lfsr, len), len);
+    s->tst_lfsr = lfsr_skip(s->tst_lfsr, len);
     transfer_data_end(tr, dp + len);
   }
   return tr;
@@ -301,20 +369,19 @@ usbdpi_transfer_t *stream_data_process(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
   // failure
   s->dpi_rewind_lfsr = s->dpi_lfsr;
 
-  while (num_bytes-- > 0U) {
-    uint8_t recvd = *sp++;
-
-    // Simply XOR the two LFSR-generated streams together
-    *dp++ = recvd ^ s->dpi_lfsr;
+  // Simply XOR the two LFSR-generated streams together
+  const uint8_t *ks = lfsr_keystream(s->dpi_lfsr, num_bytes);
+  for (unsigned idx = 0U; idx < num_bytes; idx++) {
+    dp[idx] = sp[idx] ^ ks[idx];
     if (verbose) {
-      printf("[usbdpi] 0x%02x <- 0x%02x ^ 0x%02x\n", *(dp - 1), recvd,
-             s->dpi_lfsr);
+      printf("[usbdpi] 0x%02x <- 0x%02x ^ 0x%02x\n", dp[idx], sp[idx],
+             ks[idx]);
     }
-    // Advance our local copy of the LFSR
-    s->dpi_lfsr = LFSR_ADVANCE(s->dpi_lfsr);
   }
+  // Advance our local copy of the LFSR
+  s->dpi_lfsr = lfsr_skip(s->dpi_lfsr, num_bytes);
 
-  transfer_data_end(reply, dp);
+  transfer_data_end(reply, dp + num_bytes);
 
   return reply;
 }
@@ -476,9 +543,7 @@ void streams_service(usbdpi_ctx_t *ctx) {
         } else {
           // We're not sending anything - discard any received data
           while (s->received) {
-            usbdpi_transfer_t *tr = s->received;
-            s->received = tr->next;
-            transfer_release(ctx, tr);
+            transfer_release(ctx, received_remove(s));
           }
         }
       } else {
@@ -560,10 +625,7 @@ void streams_service(usbdpi_ctx_t *ctx) {
       if (accepted) {
         // Transmitted packet was accepted, so we can retire it...
         usbdpi_stream_t *s = &ctx->stream[ctx->stream_out];
-        usbdpi_transfer_t *rx = s->received;
-        assert(rx);
-        s->received = rx->next;
-        transfer_release(ctx, rx);
+        transfer_release(ctx, received_remove(s));
         // No data toggling for Isochronous
         if (s->xfr_type != USB_TRANSFER_TYPE_ISOCHRONOUS) {
           uint8_t ep_out = s->ep_out;
@@ -628,7 +690,10 @@ void streams_service(usbdpi_ctx_t *ctx) {
           if (s->send && !s->received) {
             // For simplicity we just create max length packets
             const unsigned len = USBDEV_MAX_PACKET_SIZE;
-            s->received = stream_data_gen(ctx, s, len);
+            usbdpi_transfer_t *tr = stream_data_gen(ctx, s, len);
+            if (tr) {
+              received_append(s, tr);
+            }
           }
           ctx->hostSt = HS_STREAMOUT;
         }
@@ -754,14 +819,7 @@ void streams_service(usbdpi_ctx_t *ctx) {
               if (accept) {
                 // Collect the received packets in preparation for later
                 // transmission with modification back to the device
-                usbdpi_transfer_t *tr = s->received;
-                if (tr) {
-                  while (tr->next)
-                    tr = tr->next;
-                  tr->next = rx;
-                } else {
-                  s->received = rx;
-                }
+                received_append(s, rx);
               } else {
                 transfer_release(ctx, rx);
               }
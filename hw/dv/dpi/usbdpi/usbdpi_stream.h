@@ -83,6 +83,10 @@ typedef struct usbdpi_stream {
    * Linked-list of received transfers
    */
   usbdpi_transfer_t *received;
+  /**
+   * Last transfer in the list of received transfers, for appending
+   */
+  usbdpi_transfer_t *received_tail;
 } usbdpi_stream_t;
 
 /**
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <libelf.h>
 #include <sstream>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <vector>
@@ -32,36 +33,78 @@ class ElfError : public std::exception {
   std::string msg_;
 };
 
-// Class wrapping an open ELF file
+// Class wrapping a read-only memory mapping of a file. The mapping is private
+// and copy-on-write, so libelf can update it in place (if it needs to) without
+// touching the underlying file.
+class MappedFile {
+ public:
+  MappedFile(const std::string &path) : data_(nullptr), size_(0) {
+    int fd = open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      throw ElfError(path, "could not open file.");
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw ElfError(path, "could not stat file.");
+    }
+
+    size_ = st.st_size;
+    if (size_ > 0) {
+      void *ptr =
+          mmap(NULL, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (ptr == MAP_FAILED) {
+        close(fd);
+        throw ElfError(path, "could not map file.");
+      }
+      data_ = static_cast<char *>(ptr);
+    }
+
+    // The mapping stays valid after the file descriptor is closed.
+    close(fd);
+  }
+
+  ~MappedFile() {
+    if (data_) {
+      munmap(data_, size_);
+    }
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  char *data_;
+  size_t size_;
+};
+
+// Class wrapping an open ELF file. The file's contents are memory-mapped and
+// the mapping is available through GetMapping(), so that callers can hold
+// views into the file contents after the ElfFile itself has gone away.
 class ElfFile {
  public:
-  ElfFile(const std::string &path) : path_(path) {
+  ElfFile(const std::string &path)
+      : path_(path), mapping_(std::make_shared<MappedFile>(path)) {
     (void)elf_errno();
     if (elf_version(EV_CURRENT) == EV_NONE) {
       throw std::runtime_error(elf_errmsg(-1));
     }
 
-    fd_ = open(path.c_str(), O_RDONLY, 0);
-    if (fd_ < 0) {
-      throw ElfError(path, "could not open file.");
-    }
-
-    ptr_ = elf_begin(fd_, ELF_C_READ, NULL);
+    ptr_ = elf_memory(mapping_->data_, mapping_->size_);
     if (!ptr_) {
-      close(fd_);
       throw ElfError(path, elf_errmsg(-1));
     }
 
     if (elf_kind(ptr_) != ELF_K_ELF) {
       elf_end(ptr_);
-      close(fd_);
       throw ElfError(path, "not an ELF file.");
     }
   }
 
-  ~ElfFile() {
-    elf_end(ptr_);
-    close(fd_);
+  ~ElfFile() { elf_end(ptr_); }
+
+  const std::shared_ptr<const MappedFile> &GetMapping() const {
+    return mapping_;
   }
 
   size_t GetPhdrNum() {
@@ -80,7 +123,7 @@ class ElfFile {
   }
 
   std::string path_;
-  int fd_;
+  std::shared_ptr<const MappedFile> mapping_;
   Elf *ptr_;
 };
 }  // namespace
@@ -207,26 +250,23 @@ static std::vector<uint8_t> FlattenElfFile(const std::string &filepath) {
       continue;
 
     uint32_t off = phdr.p_paddr - low;
-    std::vector<uint8_t> seg(phdr.p_filesz, 0);
-    memcpy(&seg[0], file_data + phdr.p_offset, phdr.p_filesz);
-    ret.AddSegment(off, std::move(seg));
+    ret.AddSegment(
+        off, StagedSeg(elf.GetMapping(),
+                       (const uint8_t *)file_data + phdr.p_offset,
+                       phdr.p_filesz));
   }
 
+  ret.Build();
   return ret.GetFlat();
 }
 
 // Merge seg0 and seg1, overwriting any overlapping data in seg0 with
 // that from seg1. rng0/rng1 is the base and top address of seg0/seg1,
 // respectively.
-static std::vector<uint8_t> MergeSegments(const AddrRange<uint32_t> &rng0,
-                                          std::vector<uint8_t> &&seg0,
-                                          const AddrRange<uint32_t> &rng1,
-                                          std::vector<uint8_t> &&seg1) {
-  // First, deal with the special case where seg1 completely contains
-  // seg0 (since there's no copying needed at all).
-  if (rng1.lo <= rng0.lo && rng0.hi <= rng1.hi) {
-    return std::move(seg1);
-  }
+static std::vector<uint8_t> MergeVectors(const AddrRange<uint32_t> &rng0,
+                                         std::vector<uint8_t> &&seg0,
+                                         const AddrRange<uint32_t> &rng1,
+                                         std::vector<uint8_t> &&seg1) {
 
   uint32_t new_bot = std::min(rng0.lo, rng1.lo);
   uint32_t new_top = std::max(rng0.hi, rng1.hi);
@@ -277,7 +317,57 @@ static std::vector<uint8_t> MergeSegments(const AddrRange<uint32_t> &rng0,
   return ret;
 }
 
+// Merge seg0 and seg1 as above. If seg1 completely contains seg0, this just
+// returns seg1 (which might be a view). Otherwise, it materialises the two
+// segments as vectors and merges them.
+static StagedSeg MergeSegments(const AddrRange<uint32_t> &rng0,
+                               StagedSeg &&seg0,
+                               const AddrRange<uint32_t> &rng1,
+                               StagedSeg &&seg1) {
+  // First, deal with the special case where seg1 completely contains
+  // seg0 (since there's no copying needed at all).
+  if (rng1.lo <= rng0.lo && rng0.hi <= rng1.hi) {
+    return std::move(seg1);
+  }
+
+  return StagedSeg(
+      MergeVectors(rng0, seg0.TakeVector(), rng1, seg1.TakeVector()));
+}
+
+StagedSeg &StagedSeg::operator=(StagedSeg &&other) {
+  // Moving a std::vector doesn't move its heap buffer, so data_ stays valid
+  // for owned data.
+  keep_alive_ = std::move(other.keep_alive_);
+  owned_ = std::move(other.owned_);
+  data_ = other.data_;
+  size_ = other.size_;
+
+  other.owned_.clear();
+  other.data_ = nullptr;
+  other.size_ = 0;
+  return *this;
+}
+
+std::vector<uint8_t> StagedSeg::TakeVector() {
+  std::vector<uint8_t> ret;
+  if (IsView()) {
+    ret.assign(data_, data_ + size_);
+  } else {
+    ret = std::move(owned_);
+  }
+
+  keep_alive_.reset();
+  owned_.clear();
+  data_ = nullptr;
+  size_ = 0;
+  return ret;
+}
+
 void StagedMem::AddSegment(uint32_t offset, std::vector<uint8_t> &&seg) {
+  AddSegment(offset, StagedSeg(std::move(seg)));
+}
+
+void StagedMem::AddSegment(uint32_t offset, StagedSeg &&seg) {
   if (seg.empty())
     return;
 
@@ -286,10 +376,30 @@ void StagedMem::AddSegment(uint32_t offset, std::vector<uint8_t> &&seg) {
 
   min_addr_ = std::min(min_addr_, offset);
   max_addr_ = std::max(max_addr_, seg_top);
-  segs_.Emplace(offset, seg_top, std::move(seg), MergeSegments);
+
+  AddrRange<uint32_t> rng = {.lo = offset, .hi = seg_top};
+  pending_.emplace_back(rng, std::move(seg));
+}
+
+void StagedMem::Build() {
+  if (pending_.empty())
+    return;
+
+  // Any segments that we already have are older than the pending ones, so
+  // they go at the front of the list.
+  std::vector<SegMap::entry_t> entries = segs_.Release();
+  entries.reserve(entries.size() + pending_.size());
+  for (auto &entry : pending_) {
+    entries.push_back(std::move(entry));
+  }
+  pending_.clear();
+
+  segs_.Build(std::move(entries), MergeSegments);
 }
 
 std::vector<uint8_t> StagedMem::GetFlat() const {
+  assert(pending_.empty());
+
   // Since max_addr_ and min_addr_ are inclusive, the size to allocate
   // is 1+(max-min). We cast to size_t to make sure the +1 doesn't
   // overflow.
@@ -298,14 +408,14 @@ std::vector<uint8_t> StagedMem::GetFlat() const {
 
   for (const auto &pr : segs_) {
     const AddrRange<uint32_t> &rng = pr.first;
-    const std::vector<uint8_t> &seg = pr.second;
+    const StagedSeg &seg = pr.second;
     assert(seg.size() == 1 + (rng.hi - rng.lo));
     assert(min_addr_ <= rng.lo);
 
     uint32_t off = rng.lo - min_addr_;
     assert(off + seg.size() <= ret.size());
 
-    memcpy(&ret[off], &seg[0], seg.size());
+    memcpy(&ret[off], seg.data(), seg.size());
   }
   return ret;
 }
@@ -417,10 +527,31 @@ void DpiMemUtil::LoadFileToNamedMem(bool verbose, const std::string &name,
   }
 }
 
+void DpiMemUtil::SetImageCacheDir(const std::string &dir) {
+  image_cache_.reset(dir.empty() ? nullptr : new MemImageCache(dir));
+}
+
 void DpiMemUtil::LoadElfToMemories(bool verbose, const std::string &filepath) {
+  std::string cache_key;
+  if (image_cache_) {
+    MappedFile file(filepath);
+    cache_key =
+        MemImageCache::MakeKey((const uint8_t *)file.data_, file.size_);
+
+    MemImageCache::Entry entry;
+    if (image_cache_->Lookup(cache_key, entry) &&
+        LoadCachedImage(verbose, filepath, entry)) {
+      return;
+    }
+  }
+
   // Load the contents of the ELF file into the staging area
   StageElf(verbose, filepath);
 
+  // If we're populating the cache, collect the physical words that we write
+  // for each memory.
+  MemImageCache::Entry entry;
+
   for (const auto &pr : staging_area_) {
     const std::string &mem_name = pr.first;
     const StagedMem &staged_mem = pr.second;
@@ -429,16 +560,39 @@ void DpiMemUtil::LoadElfToMemories(bool verbose, const std::string &filepath) {
     assert(mem_area_it != name_to_mem_.end());
 
     const MemArea &mem_area = *mem_areas_[mem_area_it->second];
+    MemArea::Transaction txn(mem_area);
+
+    MemImageCache::MemEntry *mem_entry = nullptr;
+    if (image_cache_) {
+      entry.emplace_back();
+      mem_entry = &entry.back();
+      mem_entry->mem_name = mem_name;
+    }
 
     for (const auto &seg_pr : staged_mem.GetSegs()) {
       const AddrRange<uint32_t> &seg_rng = seg_pr.first;
-      const std::vector<uint8_t> &seg_data = seg_pr.second;
+      const StagedSeg &seg_data = seg_pr.second;
 
       assert(seg_rng.lo % mem_area.GetWidthByte() == 0);
       uint32_t lo_word = seg_rng.lo / mem_area.GetWidthByte();
 
       try {
-        mem_area.Write(lo_word, seg_data);
+        if (mem_entry) {
+          // Encode into a separate image for this segment, so that we write
+          // each segment as we go (just like Write would).
+          MemArea::PhysImage seg_image;
+          mem_area.Encode(lo_word, seg_data.data(), seg_data.size(),
+                          seg_image);
+          mem_area.WritePhys(seg_image);
+
+          MemArea::PhysImage &image = mem_entry->image;
+          image.addrs.insert(image.addrs.end(), seg_image.addrs.begin(),
+                             seg_image.addrs.end());
+          image.bits.insert(image.bits.end(), seg_image.bits.begin(),
+                            seg_image.bits.end());
+        } else {
+          mem_area.Write(lo_word, seg_data.data(), seg_data.size());
+        }
       } catch (const SVScoped::Error &err) {
         std::ostringstream oss;
         oss << "No memory found at `" << err.scope_name_
@@ -448,7 +602,71 @@ void DpiMemUtil::LoadElfToMemories(bool verbose, const std::string &filepath) {
         throw std::runtime_error(oss.str());
       }
     }
+
+    // Take the encoding description last: we know that the scope is valid,
+    // because we've just written to it.
+    if (mem_entry) {
+      mem_entry->encoding_desc = mem_area.GetEncodingDesc();
+    }
+  }
+
+  if (image_cache_) {
+    image_cache_->Store(cache_key, entry);
+  }
+}
+
+bool DpiMemUtil::LoadCachedImage(bool verbose, const std::string &filepath,
+                                 const MemImageCache::Entry &entry) {
+  // Check that every memory in the entry is still registered, with the same
+  // encoding, before we write anything. If not, the entry is stale and the
+  // caller will load the ELF file itself.
+  std::vector<const MemArea *> mem_areas;
+  for (const MemImageCache::MemEntry &mem_entry : entry) {
+    auto mem_area_it = name_to_mem_.find(mem_entry.mem_name);
+    if (mem_area_it == name_to_mem_.end())
+      return false;
+
+    const MemArea &mem_area = *mem_areas_[mem_area_it->second];
+    for (uint32_t phys_addr : mem_entry.image.addrs) {
+      if (phys_addr >= mem_area.GetSizeWords())
+        return false;
+    }
+
+    try {
+      if (mem_area.GetEncodingDesc() != mem_entry.encoding_desc)
+        return false;
+    } catch (const SVScoped::Error &err) {
+      return false;
+    }
+
+    mem_areas.push_back(&mem_area);
   }
+
+  // The staging area is only filled in by parsing the ELF file, which we
+  // aren't going to do.
+  staging_area_.clear();
+
+  for (size_t i = 0; i < entry.size(); ++i) {
+    const MemImageCache::MemEntry &mem_entry = entry[i];
+
+    if (verbose) {
+      std::cout << "Loading cached image of ELF file `" << filepath
+                << "' into memory `" << mem_entry.mem_name << "'."
+                << std::endl;
+    }
+
+    try {
+      mem_areas[i]->WritePhys(mem_entry.image);
+    } catch (const SVScoped::Error &err) {
+      std::ostringstream oss;
+      oss << "No memory found at `" << err.scope_name_
+          << "' (the scope associated with region `" << mem_entry.mem_name
+          << "').";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  return true;
 }
 
 void DpiMemUtil::StageElf(bool verbose, const std::string &path) {
@@ -516,11 +734,15 @@ void DpiMemUtil::StageElf(bool verbose, const std::string &path) {
     // there isn't one, make a new empty one.
     StagedMem &staged_mem = staging_area_[name];
 
-    const char *seg_data = file_data + phdr.p_offset;
-    std::vector<uint8_t> vec(phdr.p_filesz, 0);
-    memcpy(&vec[0], seg_data, phdr.p_filesz);
+    // Stage a view of the segment in the mapped file, rather than a copy.
+    const uint8_t *seg_data = (const uint8_t *)file_data + phdr.p_offset;
+    staged_mem.AddSegment(
+        local_base, StagedSeg(elf.GetMapping(), seg_data, phdr.p_filesz));
+  }
 
-    staged_mem.AddSegment(local_base, std::move(vec));
+  // Merge the segments for each memory, now that we've seen all of them.
+  for (auto &pr : staging_area_) {
+    pr.second.Build();
   }
 }
 
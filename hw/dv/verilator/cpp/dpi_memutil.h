@@ -4,6 +4,7 @@
 #ifndef OPENTITAN_HW_DV_VERILATOR_CPP_DPI_MEMUTIL_H_
 #define OPENTITAN_HW_DV_VERILATOR_CPP_DPI_MEMUTIL_H_
 
+#include <cassert>
 #include <map>
 #include <memory>
 #include <string>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "mem_area.h"
+#include "mem_image_cache.h"
 #include "ranged_map.h"
 
 // Forward declaration for the Elf type from libelf.
@@ -22,10 +24,58 @@ enum MemImageType {
   kMemImageVmem,
 };
 
+// A contiguous run of bytes staged for loading into a memory.
+//
+// This either owns its data or is a read-only view into some other buffer
+// (typically a memory-mapped ELF file). In the latter case, it holds a
+// reference to whatever owns the buffer, so the view stays valid for as long
+// as the segment exists.
+class StagedSeg {
+ public:
+  StagedSeg() : data_(nullptr), size_(0) {}
+
+  // Construct a segment that owns its data
+  explicit StagedSeg(std::vector<uint8_t> &&vec)
+      : owned_(std::move(vec)), data_(owned_.data()), size_(owned_.size()) {}
+
+  // Construct a segment that is a view of size bytes at data. The buffer must
+  // stay valid for as long as keep_alive (or a copy of it) exists.
+  StagedSeg(std::shared_ptr<const void> keep_alive, const uint8_t *data,
+            size_t size)
+      : keep_alive_(std::move(keep_alive)), data_(data), size_(size) {}
+
+  StagedSeg(StagedSeg &&other) { *this = std::move(other); }
+  StagedSeg &operator=(StagedSeg &&other);
+
+  StagedSeg(const StagedSeg &) = delete;
+  StagedSeg &operator=(const StagedSeg &) = delete;
+
+  const uint8_t *data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const uint8_t &operator[](size_t idx) const { return data_[idx]; }
+
+  // True if this segment is a view into a buffer it doesn't own
+  bool IsView() const { return data_ && data_ != owned_.data(); }
+
+  // Return the contents of the segment as a vector. For a segment that owns
+  // its data, this moves it out, leaving the segment empty. For a view, this
+  // copies the data.
+  std::vector<uint8_t> TakeVector();
+
+ private:
+  std::shared_ptr<const void> keep_alive_;
+  std::vector<uint8_t> owned_;
+  const uint8_t *data_;
+  size_t size_;
+};
+
 // Staged data for a given memory area.
 //
 // This is represented as an ordered list of disjoint segments (as loaded from
-// an ELF file).
+// an ELF file). Segments that don't overlap any other segment are held as
+// views into the memory-mapped ELF file and are only copied if they have to
+// be merged with a neighbour.
 //
 // Once it is nonempty, the class maintains the invariant that min_addr_ /
 // max_addr_ is the smallest / largest byte offset with valid data.
@@ -33,22 +83,33 @@ class StagedMem {
  public:
   StagedMem() : min_addr_(~(uint32_t)0), max_addr_(0) {}
 
-  // Add a segment to the tracked memory
+  // Add a segment to the tracked memory. Segments are collected and then
+  // merged in one go by Build(), which must be called before GetFlat() or
+  // GetSegs().
   void AddSegment(uint32_t offset, std::vector<uint8_t> &&seg);
+  void AddSegment(uint32_t offset, StagedSeg &&seg);
+
+  // Merge any segments added since the last call into the tracked memory.
+  // Where segments overlap, later ones take precedence.
+  void Build();
 
   // Glob together the tracked segments, interspersing them with
   // zeros, and return as a single flat array.
   std::vector<uint8_t> GetFlat() const;
 
-  typedef RangedMap<uint32_t, std::vector<uint8_t>> SegMap;
+  typedef FlatRangedMap<uint32_t, StagedSeg> SegMap;
 
   std::pair<uint32_t, uint32_t> GetBounds() const {
     return std::make_pair(min_addr_, max_addr_);
   }
-  const SegMap &GetSegs() const { return segs_; }
+  const SegMap &GetSegs() const {
+    assert(pending_.empty());
+    return segs_;
+  }
 
  private:
   uint32_t min_addr_, max_addr_;
+  std::vector<SegMap::entry_t> pending_;
   SegMap segs_;
 };
 
@@ -116,9 +177,22 @@ class DpiMemUtil {
    * Load an ELF file, placing segments in memories by LMA.
    *
    * Replaces any data currently in the staging area.
+   *
+   * If an image cache directory has been set with SetImageCacheDir() and it
+   * contains the encoded contents of this ELF file for memories with the
+   * same encoding, the cached physical words are written directly. In that
+   * case, the ELF file isn't parsed at all: the staging area is left empty
+   * and OnElfLoaded() is not called.
    */
   void LoadElfToMemories(bool verbose, const std::string &filepath);
 
+  /**
+   * Use the directory at dir as a cache of encoded ELF images for
+   * LoadElfToMemories(). An empty string disables the cache (the default).
+   * Throws a std::runtime_error if the directory can't be created.
+   */
+  void SetImageCacheDir(const std::string &dir);
+
   /**
    * Load an ELF file into a staging area in this object, which can then be
    * accessed with GetMemoryData().
@@ -159,6 +233,17 @@ class DpiMemUtil {
   std::map<std::string, StagedMem> staging_area_;
   const StagedMem empty_;
 
+  // Cache of encoded ELF images (null if disabled)
+  std::unique_ptr<MemImageCache> image_cache_;
+
+  /**
+   * Write the memory contents from a cache entry for the ELF file at filepath.
+   * Returns false without writing anything if the entry doesn't match the
+   * registered memories.
+   */
+  bool LoadCachedImage(bool verbose, const std::string &filepath,
+                       const MemImageCache::Entry &entry);
+
   /**
    * Find the index of a memory area containing the given segment's addresses.
    * Raises a std::exception if none is found.
@@ -30,49 +30,42 @@ void Ecc32MemArea::LoadVmem(const std::string &path) const {
       "vmem files are not supported for memories with ECC bits");
 }
 
+std::string Ecc32MemArea::GetEncodingDesc() const {
+  return "ecc32;" + MemArea::GetEncodingDesc();
+}
+
+uint32_t Ecc32MemArea::GetPhysWidthByte() const {
+  return (39 * (width_byte_ / 4) + 7) / 8;
+}
+
 Ecc32MemArea::EccWords Ecc32MemArea::ReadWithIntegrity(
     uint32_t word_offset, uint32_t num_words) const {
   assert(word_offset + num_words <= num_words_);
 
-  // See MemArea::Write for an explanation for this buffer.
-  uint8_t minibuf[SV_MEM_WIDTH_BYTES];
-  memset(minibuf, 0, sizeof minibuf);
-  assert(width_byte_ <= sizeof minibuf);
-
   EccWords ret;
   ret.reserve(num_words);
 
-  for (uint32_t i = 0; i < num_words; ++i) {
-    uint32_t src_word = word_offset + i;
-    uint32_t phys_addr = ToPhysAddr(src_word);
-
-    ReadToMinibuf(minibuf, phys_addr);
-    ReadBufferWithIntegrity(ret, minibuf, src_word);
-  }
+  ReadWords(word_offset, num_words,
+            [&](const uint8_t buf[SV_MEM_WIDTH_BYTES], uint32_t i) {
+              ReadBufferWithIntegrity(ret, buf, word_offset + i);
+            });
 
   return ret;
 }
 
 void Ecc32MemArea::WriteWithIntegrity(uint32_t word_offset,
                                       const EccWords &data) const {
-  // See MemArea::Write for an explanation for this buffer.
-  uint8_t minibuf[SV_MEM_WIDTH_BYTES];
-  memset(minibuf, 0, sizeof minibuf);
-  assert(width_byte_ <= sizeof minibuf);
-
   uint32_t width_32 = width_byte_ / 4;
   uint32_t to_write = data.size() / width_32;
 
   assert((data.size() % width_32) == 0);
   assert(word_offset + to_write <= num_words_);
 
-  for (uint32_t i = 0; i < to_write; ++i) {
-    uint32_t dst_word = word_offset + i;
-    uint32_t phys_addr = ToPhysAddr(dst_word);
-
-    WriteBufferWithIntegrity(minibuf, data, i * width_32, dst_word);
-    WriteFromMinibuf(phys_addr, minibuf, dst_word);
-  }
+  WriteWords(word_offset, to_write,
+             [&](uint8_t buf[SV_MEM_WIDTH_BYTES], uint32_t i) {
+               WriteBufferWithIntegrity(buf, data, i * width_32,
+                                        word_offset + i);
+             });
 }
 
 // Zero enough of the buffer to fill it with a word using insert_bits
@@ -155,11 +148,17 @@ static uint8_t extract_bits(const uint8_t *buf, unsigned bit_idx,
 }
 
 void Ecc32MemArea::WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
-                               const std::vector<uint8_t> &data,
+                               const uint8_t *data, size_t data_len,
                                size_t start_idx, uint32_t dst_word) const {
   zero_buffer(buf, width_byte_);
   for (uint32_t i = 0; i < width_byte_ / 4; ++i) {
-    const uint8_t *src_data = &data[start_idx + 4 * i];
+    // Zero-extend if the data ends part way through this 32-bit word
+    uint8_t src_data[4] = {0, 0, 0, 0};
+    size_t src_idx = start_idx + 4 * i;
+    if (src_idx < data_len) {
+      memcpy(src_data, data + src_idx,
+             std::min(data_len - src_idx, sizeof src_data));
+    }
     insert_word(buf, 39 * i, src_data, enc_secded_inv_39_32(src_data));
   }
 }
@@ -176,7 +175,7 @@ void Ecc32MemArea::WriteBufferWithIntegrity(uint8_t buf[SV_MEM_WIDTH_BYTES],
     for (uint32_t j = 0; j < 4; ++j) {
       src_data[j] = (word.second >> 8 * j) & 0xff;
     }
-    uint8_t check_bits = enc_secded_inv_39_32(src_data);
+    uint8_t check_bits = enc_secded_inv_39_32_word(word.second);
 
     // Invert (and thus corrupt) check bits if needed
     if (!word.first)
@@ -200,15 +199,13 @@ void Ecc32MemArea::ReadBufferWithIntegrity(
     EccWords &data, const uint8_t buf[SV_MEM_WIDTH_BYTES],
     uint32_t src_word) const {
   for (uint32_t i = 0; i < width_byte_ / 4; ++i) {
-    uint8_t buf32[4];
     uint32_t w32 = 0;
     for (uint32_t j = 0; j < 4; ++j) {
       uint8_t byte = extract_bits(buf, 39 * i + 8 * j, 8);
-      buf32[j] = byte;
       w32 |= (uint32_t)byte << 8 * j;
     }
 
-    uint8_t exp_check_bits = enc_secded_inv_39_32(buf32);
+    uint8_t exp_check_bits = enc_secded_inv_39_32_word(w32);
     uint8_t check_bits = extract_bits(buf, 39 * i + 32, 7);
     bool good = check_bits == exp_check_bits;
 
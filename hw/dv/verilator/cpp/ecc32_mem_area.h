@@ -24,6 +24,9 @@ class Ecc32MemArea : public MemArea {
 
   void LoadVmem(const std::string &path) const override;
 
+  std::string GetEncodingDesc() const override;
+  uint32_t GetPhysWidthByte() const override;
+
   typedef std::pair<bool, uint32_t> EccWord;
   typedef std::vector<EccWord> EccWords;
 
@@ -54,8 +57,8 @@ class Ecc32MemArea : public MemArea {
   void WriteWithIntegrity(uint32_t word_offset, const EccWords &data) const;
 
  protected:
-  void WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
-                   const std::vector<uint8_t> &data, size_t start_idx,
+  void WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES], const uint8_t *data,
+                   size_t data_len, size_t start_idx,
                    uint32_t dst_word) const override;
 
   void ReadBuffer(std::vector<uint8_t> &data,
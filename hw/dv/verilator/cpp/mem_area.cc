@@ -16,38 +16,35 @@ extern "C" {
 void simutil_memload(const char *file);
 int simutil_set_mem(int index, const svBitVecVal *val);
 int simutil_get_mem(int index, svBitVecVal *val);
+int simutil_set_mem_block(int index, int num_words, const svBitVecVal *val);
+int simutil_get_mem_block(int index, int num_words, svBitVecVal *val);
 }
 
 MemArea::MemArea(const std::string &scope, uint32_t num_words,
                  uint32_t width_byte)
-    : scope_(scope), num_words_(num_words), width_byte_(width_byte) {
+    : scope_(scope),
+      num_words_(num_words),
+      width_byte_(width_byte),
+      txn_depth_(0) {
   assert(0 < num_words);
   assert(width_byte <= SV_MEM_WIDTH_BYTES);
 }
 
 void MemArea::Write(uint32_t word_offset,
                     const std::vector<uint8_t> &data) const {
-  // This "mini buffer" is used to transfer each write to SystemVerilog.
-  // `simutil_set_mem` takes a fixed SV_MEM_WIDTH_BITS-bit vector but it will
-  // only use the bits required for the RAM width. As an example, for a 32-bit
-  // wide RAM only elements 3:0 of `minibuf` will be written to memory. Since
-  // the simulator may still read bits from minibuf it does not use, we must
-  // use a fixed allocation of the full bit vector size to avoid an out of
-  // bounds access.
-  uint8_t minibuf[SV_MEM_WIDTH_BYTES];
-  memset(minibuf, 0, sizeof minibuf);
-  assert(width_byte_ <= sizeof minibuf);
-
-  uint32_t data_words = (data.size() + width_byte_ - 1) / width_byte_;
-  assert(word_offset + data_words <= num_words_);
+  Write(word_offset, data.data(), data.size());
+}
 
-  for (uint32_t i = 0; i < data_words; ++i) {
-    uint32_t dst_word = word_offset + i;
-    uint32_t phys_addr = ToPhysAddr(dst_word);
+void MemArea::Write(uint32_t word_offset, const uint8_t *data,
+                    size_t data_len) const {
+  uint32_t data_words = (data_len + width_byte_ - 1) / width_byte_;
+  assert(word_offset + data_words <= num_words_);
 
-    WriteBuffer(minibuf, data, i * width_byte_, dst_word);
-    WriteFromMinibuf(phys_addr, minibuf, dst_word);
-  }
+  WriteWords(word_offset, data_words,
+             [&](uint8_t buf[SV_MEM_WIDTH_BYTES], uint32_t i) {
+               WriteBuffer(buf, data, data_len, i * width_byte_,
+                           word_offset + i);
+             });
 }
 
 std::vector<uint8_t> MemArea::Read(uint32_t word_offset,
@@ -57,23 +54,75 @@ std::vector<uint8_t> MemArea::Read(uint32_t word_offset,
   uint32_t num_bytes = width_byte_ * num_words;
   assert(num_words <= num_bytes);
 
-  // See Write for an explanation for this buffer.
-  uint8_t minibuf[SV_MEM_WIDTH_BYTES];
-  memset(minibuf, 0, sizeof minibuf);
-  assert(width_byte_ <= sizeof minibuf);
-
   std::vector<uint8_t> ret;
   ret.reserve(num_bytes);
 
-  for (uint32_t i = 0; i < num_words; ++i) {
-    uint32_t src_word = word_offset + i;
-    uint32_t phys_addr = ToPhysAddr(src_word);
+  ReadWords(word_offset, num_words,
+            [&](const uint8_t buf[SV_MEM_WIDTH_BYTES], uint32_t i) {
+              ReadBuffer(ret, buf, word_offset + i);
+            });
+
+  return ret;
+}
+
+void MemArea::WriteBlock(uint32_t phys_addr, const uint8_t *buf,
+                         uint32_t num_words) const {
+  assert(phys_addr + num_words <= num_words_);
+
+  SVScoped scoped(scope_);
+  for (uint32_t done = 0; done < num_words; done += SV_MEM_BLOCK_WORDS) {
+    uint32_t chunk = std::min(num_words - done, (uint32_t)SV_MEM_BLOCK_WORDS);
+
+    // The SystemVerilog side takes a fixed-size array, but will only look at
+    // the first chunk entries. As with the single-word transfers, it might
+    // still read other bits, so we pass a pointer into a buffer of the full
+    // size when this is the last chunk.
+    const uint8_t *src = buf + done * SV_MEM_WIDTH_BYTES;
+    uint8_t tail[SV_MEM_BLOCK_WORDS * SV_MEM_WIDTH_BYTES];
+    if (chunk < SV_MEM_BLOCK_WORDS) {
+      memset(tail, 0, sizeof tail);
+      memcpy(tail, src, chunk * SV_MEM_WIDTH_BYTES);
+      src = tail;
+    }
 
-    ReadToMinibuf(minibuf, phys_addr);
-    ReadBuffer(ret, minibuf, src_word);
+    if (!simutil_set_mem_block(phys_addr + done, chunk,
+                               (const svBitVecVal *)src)) {
+      std::ostringstream oss;
+      oss << "Could not set " << chunk
+          << " memory words starting at physical index 0x" << std::hex
+          << phys_addr + done << ".";
+      throw std::runtime_error(oss.str());
+    }
   }
+}
 
-  return ret;
+void MemArea::ReadBlock(uint8_t *buf, uint32_t phys_addr,
+                        uint32_t num_words) const {
+  assert(phys_addr + num_words <= num_words_);
+
+  SVScoped scoped(scope_);
+  for (uint32_t done = 0; done < num_words; done += SV_MEM_BLOCK_WORDS) {
+    uint32_t chunk = std::min(num_words - done, (uint32_t)SV_MEM_BLOCK_WORDS);
+
+    // As in WriteBlock, the SystemVerilog side may write to the full array
+    // so the last chunk goes through a temporary buffer.
+    uint8_t *dst = buf + done * SV_MEM_WIDTH_BYTES;
+    uint8_t tail[SV_MEM_BLOCK_WORDS * SV_MEM_WIDTH_BYTES];
+    uint8_t *sv_dst = (chunk < SV_MEM_BLOCK_WORDS) ? tail : dst;
+
+    if (!simutil_get_mem_block(phys_addr + done, chunk,
+                               (svBitVecVal *)sv_dst)) {
+      std::ostringstream oss;
+      oss << "Could not read " << chunk
+          << " memory words starting at physical index 0x" << std::hex
+          << phys_addr + done << ".";
+      throw std::runtime_error(oss.str());
+    }
+
+    if (sv_dst != dst) {
+      memcpy(dst, tail, chunk * SV_MEM_WIDTH_BYTES);
+    }
+  }
 }
 
 void MemArea::LoadVmem(const std::string &path) const {
@@ -82,15 +131,86 @@ void MemArea::LoadVmem(const std::string &path) const {
   simutil_memload(path.c_str());
 }
 
+void MemArea::Encode(uint32_t word_offset, const uint8_t *data,
+                     size_t data_len, PhysImage &image) const {
+  uint32_t data_words = (data_len + width_byte_ - 1) / width_byte_;
+  assert(word_offset + data_words <= num_words_);
+
+  Transaction txn(*this);
+
+  size_t base = image.bits.size();
+  image.addrs.reserve(image.addrs.size() + data_words);
+  image.bits.resize(base + (size_t)data_words * SV_MEM_WIDTH_BYTES, 0);
+
+  for (uint32_t i = 0; i < data_words; ++i) {
+    uint32_t dst_word = word_offset + i;
+    uint8_t *buf = &image.bits[base + (size_t)i * SV_MEM_WIDTH_BYTES];
+    WriteBuffer(buf, data, data_len, i * width_byte_, dst_word);
+
+    // WriteBuffer needn't clear bits above the memory width, but we want the
+    // image to be reproducible.
+    uint32_t phys_width_byte = GetPhysWidthByte();
+    memset(buf + phys_width_byte, 0, SV_MEM_WIDTH_BYTES - phys_width_byte);
+
+    image.addrs.push_back(ToPhysAddr(dst_word));
+  }
+}
+
+void MemArea::WritePhys(const PhysImage &image) const {
+  assert(image.bits.size() == image.addrs.size() * SV_MEM_WIDTH_BYTES);
+
+  size_t num_words = image.addrs.size();
+  size_t run_start = 0;
+  while (run_start < num_words) {
+    size_t run_end = run_start + 1;
+    while (run_end < num_words &&
+           image.addrs[run_end] == image.addrs[run_end - 1] + 1) {
+      ++run_end;
+    }
+
+    uint32_t phys_addr = image.addrs[run_start];
+    const uint8_t *buf = &image.bits[run_start * SV_MEM_WIDTH_BYTES];
+    if (run_end - run_start == 1) {
+      // A single word (as is typical for scrambled memories) doesn't need the
+      // full-size block buffer that WriteBlock uses for a partial block.
+      WriteFromMinibuf(phys_addr, buf, phys_addr);
+    } else {
+      WriteBlock(phys_addr, buf, run_end - run_start);
+    }
+
+    run_start = run_end;
+  }
+}
+
+std::string MemArea::GetEncodingDesc() const {
+  std::ostringstream oss;
+  oss << "plain;words=" << num_words_ << ";width_byte=" << width_byte_;
+  return oss.str();
+}
+
+void MemArea::BeginTransaction() const {
+  if (txn_depth_ == 0) {
+    OnTransactionStart();
+  }
+  ++txn_depth_;
+}
+
+void MemArea::EndTransaction() const {
+  assert(txn_depth_ > 0);
+  if (--txn_depth_ == 0) {
+    OnTransactionEnd();
+  }
+}
+
 void MemArea::WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
-                          const std::vector<uint8_t> &data, size_t start_idx,
-                          uint32_t dst_word) const {
-  size_t words_left = data.size() - start_idx;
+                          const uint8_t *data, size_t data_len,
+                          size_t start_idx, uint32_t dst_word) const {
+  size_t words_left = data_len - start_idx;
   size_t to_copy = std::min(words_left, (size_t)width_byte_);
   if (to_copy < width_byte_) {
     memset(buf, 0, SV_MEM_WIDTH_BYTES);
   }
-  memcpy(buf, &data[start_idx], to_copy);
+  memcpy(buf, data + start_idx, to_copy);
 }
 
 void MemArea::ReadBuffer(std::vector<uint8_t> &data,
@@ -101,6 +221,71 @@ void MemArea::ReadBuffer(std::vector<uint8_t> &data,
               std::back_inserter(data));
 }
 
+void MemArea::WriteWords(uint32_t word_offset, uint32_t num_words,
+                         const WordWriter &fill) const {
+  Transaction txn(*this);
+
+  if (!HasLinearPhysAddrs()) {
+    // This "mini buffer" is used to transfer each write to SystemVerilog.
+    // `simutil_set_mem` takes a fixed SV_MEM_WIDTH_BITS-bit vector but it will
+    // only use the bits required for the RAM width. As an example, for a
+    // 32-bit wide RAM only elements 3:0 of `minibuf` will be written to
+    // memory. Since the simulator may still read bits from minibuf it does not
+    // use, we must use a fixed allocation of the full bit vector size to avoid
+    // an out of bounds access.
+    uint8_t minibuf[SV_MEM_WIDTH_BYTES];
+    memset(minibuf, 0, sizeof minibuf);
+    assert(width_byte_ <= sizeof minibuf);
+
+    for (uint32_t i = 0; i < num_words; ++i) {
+      uint32_t dst_word = word_offset + i;
+      fill(minibuf, i);
+      WriteFromMinibuf(ToPhysAddr(dst_word), minibuf, dst_word);
+    }
+    return;
+  }
+
+  // If logical and physical addresses match, we can fill a block of
+  // consecutive words at a time and transfer them with a single DPI call.
+  uint8_t blockbuf[SV_MEM_BLOCK_WORDS * SV_MEM_WIDTH_BYTES];
+  memset(blockbuf, 0, sizeof blockbuf);
+
+  for (uint32_t done = 0; done < num_words; done += SV_MEM_BLOCK_WORDS) {
+    uint32_t chunk = std::min(num_words - done, (uint32_t)SV_MEM_BLOCK_WORDS);
+    for (uint32_t i = 0; i < chunk; ++i) {
+      fill(&blockbuf[i * SV_MEM_WIDTH_BYTES], done + i);
+    }
+    WriteBlock(word_offset + done, blockbuf, chunk);
+  }
+}
+
+void MemArea::ReadWords(uint32_t word_offset, uint32_t num_words,
+                        const WordReader &consume) const {
+  Transaction txn(*this);
+
+  if (!HasLinearPhysAddrs()) {
+    // See WriteWords for an explanation for this buffer.
+    uint8_t minibuf[SV_MEM_WIDTH_BYTES];
+    memset(minibuf, 0, sizeof minibuf);
+    assert(width_byte_ <= sizeof minibuf);
+
+    for (uint32_t i = 0; i < num_words; ++i) {
+      ReadToMinibuf(minibuf, ToPhysAddr(word_offset + i));
+      consume(minibuf, i);
+    }
+    return;
+  }
+
+  uint8_t blockbuf[SV_MEM_BLOCK_WORDS * SV_MEM_WIDTH_BYTES];
+  for (uint32_t done = 0; done < num_words; done += SV_MEM_BLOCK_WORDS) {
+    uint32_t chunk = std::min(num_words - done, (uint32_t)SV_MEM_BLOCK_WORDS);
+    ReadBlock(blockbuf, word_offset + done, chunk);
+    for (uint32_t i = 0; i < chunk; ++i) {
+      consume(&blockbuf[i * SV_MEM_WIDTH_BYTES], done + i);
+    }
+  }
+}
+
 void MemArea::ReadToMinibuf(uint8_t *minibuf, uint32_t phys_addr) const {
   SVScoped scoped(scope_);
   if (!simutil_get_mem(phys_addr, (svBitVecVal *)minibuf)) {
@@ -6,6 +6,7 @@
 #define OPENTITAN_HW_DV_VERILATOR_CPP_MEM_AREA_H_
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,11 @@
 // using the svBitVecVal type, we have to round up to the next 32-bit word.
 #define SV_MEM_WIDTH_BYTES (4 * ((SV_MEM_WIDTH_BITS + 31) / 32))
 
+// This is the maximum number of words that can be transferred with a single
+// call to simutil_set_mem_block or simutil_get_mem_block (defined in
+// prim_util_memload.svh)
+#define SV_MEM_BLOCK_WORDS 64
+
 /**
  * A "memory area", representing a memory in the simulated design.
  */
@@ -28,7 +34,8 @@ class MemArea {
    * @param scope  The SystemVerilog scope where the instantiated memory can be
    *               found. This needs to support the DPI-C interfaces \c
    *               simutil_memload and \c simutil_set_mem (used for vmem and
-   *               ELF files, respectively).
+   *               ELF files, respectively), together with the other
+   *               functions defined in prim_util_memload.svh.
    *
    * @param size   The size of the memory in bytes (must be positive and a
    *               multiple of \p width_byte)
@@ -43,7 +50,7 @@ class MemArea {
    *
    * This assumes that the result will fit in the memory. If the scope cannot
    * be set, this throws an SVScoped::Error. If a call to \c simutil_set_mem
-   * fails, this throws a \c std::runtime_error.
+   * or \c simutil_set_mem_block fails, this throws a \c std::runtime_error.
    *
    * @param word_offset The offset, in words, of the first word that should be
    *                    written.
@@ -55,13 +62,32 @@ class MemArea {
   virtual void Write(uint32_t word_offset,
                      const std::vector<uint8_t> &data) const;
 
+  /** Write data to this memory area at the given word offset
+   *
+   * This is equivalent to the std::vector version of Write, but takes the
+   * data as a pointer and length. This lets callers write data that lives in
+   * some other buffer (such as a memory-mapped file) without copying it.
+   *
+   * @param word_offset The offset, in words, of the first word that should be
+   *                    written.
+   *
+   * @param data        The data that should be written.
+   *
+   * @param data_len    The length of \p data in bytes. If this is not a
+   *                    multiple of \p width_byte, the last word will be
+   *                    zero-extended.
+   */
+  virtual void Write(uint32_t word_offset, const uint8_t *data,
+                     size_t data_len) const;
+
   /** Read data from this memory area, starting at the given offset.
    *
    * This assumes that there are <tt>word_offset + num_words</tt> words in the
    * memory. Returns a vector with <tt>num_words * width_byte_</tt> elements.
    *
    * If the scope cannot be set, this throws an SVScoped::Error. If a call to
-   * simutil_get_mem fails, this throws a std::runtime_error.
+   * simutil_get_mem or simutil_get_mem_block fails, this throws a
+   * std::runtime_error.
    *
    * @param word_offset The offset, in words, of the first word that should be
    *                    written.
@@ -71,20 +97,158 @@ class MemArea {
   virtual std::vector<uint8_t> Read(uint32_t word_offset,
                                     uint32_t num_words) const;
 
+  /** Write a block of physical memory words, starting at a physical index
+   *
+   * This writes the raw bits in \p buf to consecutive physical words of the
+   * memory, with no ECC, scrambling or address mapping, using one call to \c
+   * simutil_set_mem_block for up to SV_MEM_BLOCK_WORDS words. If the scope
+   * cannot be set, this throws an SVScoped::Error. If a call to \c
+   * simutil_set_mem_block fails, this throws a \c std::runtime_error.
+   *
+   * @param phys_addr  The physical index of the first word to write
+   *
+   * @param buf        Physical memory bits. Each word takes
+   *                   SV_MEM_WIDTH_BYTES bytes, of which only the bits used by
+   *                   the memory are read.
+   *
+   * @param num_words  The number of words to write
+   */
+  void WriteBlock(uint32_t phys_addr, const uint8_t *buf,
+                  uint32_t num_words) const;
+
+  /** Read a block of physical memory words, starting at a physical index
+   *
+   * This is the inverse of WriteBlock. It reads \p num_words words into \p
+   * buf, which must have space for <tt>num_words * SV_MEM_WIDTH_BYTES</tt>
+   * bytes. Bits beyond the memory width are zero.
+   */
+  void ReadBlock(uint8_t *buf, uint32_t phys_addr, uint32_t num_words) const;
+
   /** Use \c simutil_memload to load a vmem file into the memory */
   virtual void LoadVmem(const std::string &path) const;
 
+  /**
+   * Physical memory words, as they would be written by WriteBlock.
+   *
+   * The bits for the word at physical index addrs[i] are stored at
+   * <tt>bits[i * SV_MEM_WIDTH_BYTES]</tt>.
+   */
+  struct PhysImage {
+    std::vector<uint32_t> addrs;
+    std::vector<uint8_t> bits;
+  };
+
+  /** Encode data as it would be written by Write, without writing it
+   *
+   * The arguments have the same meaning as for Write. The resulting physical
+   * words are appended to \p image and can be written to the memory later
+   * with WritePhys. This might need to read state from the simulation (such
+   * as a scrambling key), so it can throw the same exceptions as Write.
+   */
+  void Encode(uint32_t word_offset, const uint8_t *data, size_t data_len,
+              PhysImage &image) const;
+
+  /** Write physical memory words to the memory
+   *
+   * Runs of words with consecutive physical indices are transferred with
+   * WriteBlock. This throws the same exceptions as Write.
+   */
+  void WritePhys(const PhysImage &image) const;
+
+  /** Return a description of how logical data is encoded in this memory
+   *
+   * Two memory areas with the same description will give the same result
+   * from Encode for the same data. This might need to read state from the
+   * simulation (such as a scrambling key).
+   */
+  virtual std::string GetEncodingDesc() const;
+
+  /** The number of bytes of each physical memory word that are used */
+  virtual uint32_t GetPhysWidthByte() const { return width_byte_; }
+
   const std::string &GetScope() const { return scope_; }
   uint32_t GetSizeWords() const { return num_words_; }
   uint32_t GetSizeBytes() const { return num_words_ * width_byte_; }
   uint32_t GetWidthByte() const { return width_byte_; }
   uint32_t GetWidth() const { return 8 * width_byte_; }
 
+  /**
+   * A guard object for a "bulk transaction" on a memory area.
+   *
+   * While at least one Transaction for a memory area is alive, the area is
+   * allowed to cache any state that it would otherwise have to fetch from
+   * the simulation for each word (such as scrambling keys). This is used by
+   * Write(), Read() and friends, but callers that do several accesses in a
+   * row can also hold one across all of them. Transactions nest.
+   *
+   * The cached state is dropped when the outermost Transaction is destroyed,
+   * so the caller must not hold one across anything that might change the
+   * state in the simulation.
+   */
+  class Transaction {
+   public:
+    explicit Transaction(const MemArea &area) : area_(area) {
+      area_.BeginTransaction();
+    }
+    ~Transaction() { area_.EndTransaction(); }
+
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+
+   private:
+    const MemArea &area_;
+  };
+
  protected:
   std::string scope_;    ///< Design scope (used for accesses over DPI)
   uint32_t num_words_;   ///< Size of the memory area in words
   uint32_t width_byte_;  ///< Size of each word in bytes
 
+  /** Called when the first (outermost) Transaction starts.
+   *
+   * The default implementation does nothing. Subclasses that need to fetch
+   * per-memory state over DPI can override this to fetch it once.
+   */
+  virtual void OnTransactionStart() const {}
+
+  /** Called when the last (outermost) Transaction finishes. */
+  virtual void OnTransactionEnd() const {}
+
+  /** True if there is at least one live Transaction for this memory area */
+  bool InTransaction() const { return txn_depth_ > 0; }
+
+  /** True if ToPhysAddr is the identity function.
+   *
+   * For such memories, consecutive logical words are transferred in blocks,
+   * using WriteBlock and ReadBlock.
+   */
+  virtual bool HasLinearPhysAddrs() const { return true; }
+
+  typedef std::function<void(uint8_t buf[SV_MEM_WIDTH_BYTES], uint32_t idx)>
+      WordWriter;
+  typedef std::function<void(const uint8_t buf[SV_MEM_WIDTH_BYTES],
+                             uint32_t idx)>
+      WordReader;
+
+  /** Write num_words logical words, starting at word_offset
+   *
+   * For each word, this calls \p fill with a buffer to fill with physical
+   * memory bits and the index of the word (counting from zero). It then writes
+   * the buffer to the memory at the corresponding physical address. Bits in
+   * buf beyond those that fill wrote may be nonzero but are ignored.
+   */
+  void WriteWords(uint32_t word_offset, uint32_t num_words,
+                  const WordWriter &fill) const;
+
+  /** Read num_words logical words, starting at word_offset
+   *
+   * For each word, this calls \p consume with a buffer containing the
+   * physical memory bits and the index of the word (counting from zero). Words
+   * are passed to \p consume in order.
+   */
+  void ReadWords(uint32_t word_offset, uint32_t num_words,
+                 const WordReader &consume) const;
+
   /** Write to buf with the data that should be copied to the physical memory
    * for a single memory word.
    *
@@ -95,12 +259,13 @@ class MemArea {
    *
    * @param buf       Destination buffer
    * @param data      A large buffer that contains the data to be written
+   * @param data_len  The length of \p data in bytes
    * @param start_idx An offset into \p data for the start of the memory word
    * @param dst_word  Logical address of the location being written
    */
   virtual void WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
-                           const std::vector<uint8_t> &data, size_t start_idx,
-                           uint32_t dst_word) const;
+                           const uint8_t *data, size_t data_len,
+                           size_t start_idx, uint32_t dst_word) const;
 
   /** Extract the logical memory contents corresponding to the physical
    * memory contents in \p buf and append them to \p data.
@@ -145,6 +310,12 @@ class MemArea {
    */
   void WriteFromMinibuf(uint32_t phys_addr, const uint8_t *minibuf,
                         uint32_t dst_word) const;
+
+ private:
+  void BeginTransaction() const;
+  void EndTransaction() const;
+
+  mutable uint32_t txn_depth_;  ///< Number of live Transaction objects
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_CPP_MEM_AREA_H_
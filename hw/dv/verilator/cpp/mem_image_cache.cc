@@ -0,0 +1,204 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mem_image_cache.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The first bytes of every cache file. Bump the version if the format changes
+// or if the encoding of any memory area changes in a way that isn't reflected
+// in its encoding description.
+static const char kMagic[8] = {'O', 'T', 'M', 'E', 'M', 'I', 'M', 'G'};
+static const uint32_t kVersion = 1;
+
+// Sanity limit on the length of strings in a cache file, so that a corrupt
+// file doesn't cause a huge allocation.
+static const uint32_t kMaxStringLen = 4096;
+
+// Similarly, a limit on the number of words for a single memory.
+static const uint32_t kMaxWords = 1u << 24;
+static const uint32_t kMaxMems = 256;
+
+namespace {
+// Helpers for reading fixed-size fields. Each returns false on a short read.
+bool ReadU32(std::istream &is, uint32_t &val) {
+  return bool(is.read(reinterpret_cast<char *>(&val), sizeof val));
+}
+
+bool ReadString(std::istream &is, std::string &str) {
+  uint32_t len;
+  if (!ReadU32(is, len) || len > kMaxStringLen)
+    return false;
+  str.resize(len);
+  return bool(is.read(&str[0], len));
+}
+
+void WriteU32(std::ostream &os, uint32_t val) {
+  os.write(reinterpret_cast<const char *>(&val), sizeof val);
+}
+
+void WriteString(std::ostream &os, const std::string &str) {
+  WriteU32(os, str.size());
+  os.write(str.data(), str.size());
+}
+
+// Read a single MemEntry. Physical words are stored on disk with just the
+// bytes that are used by the memory (phys_width_byte of them) and are expanded
+// to SV_MEM_WIDTH_BYTES in memory.
+bool ReadMemEntry(std::istream &is, MemImageCache::MemEntry &mem) {
+  uint32_t phys_width_byte, num_words;
+  if (!ReadString(is, mem.mem_name) || !ReadString(is, mem.encoding_desc) ||
+      !ReadU32(is, phys_width_byte) || !ReadU32(is, num_words))
+    return false;
+
+  if (phys_width_byte == 0 || phys_width_byte > SV_MEM_WIDTH_BYTES ||
+      num_words > kMaxWords)
+    return false;
+
+  mem.image.addrs.resize(num_words);
+  if (!is.read(reinterpret_cast<char *>(mem.image.addrs.data()),
+               (size_t)num_words * sizeof(uint32_t)))
+    return false;
+
+  mem.image.bits.assign((size_t)num_words * SV_MEM_WIDTH_BYTES, 0);
+  for (uint32_t i = 0; i < num_words; ++i) {
+    char *dst =
+        reinterpret_cast<char *>(&mem.image.bits[i * SV_MEM_WIDTH_BYTES]);
+    if (!is.read(dst, phys_width_byte))
+      return false;
+  }
+
+  return true;
+}
+
+void WriteMemEntry(std::ostream &os, const MemImageCache::MemEntry &mem,
+                   uint32_t phys_width_byte) {
+  const MemArea::PhysImage &image = mem.image;
+  assert(image.bits.size() == image.addrs.size() * SV_MEM_WIDTH_BYTES);
+
+  WriteString(os, mem.mem_name);
+  WriteString(os, mem.encoding_desc);
+  WriteU32(os, phys_width_byte);
+  WriteU32(os, image.addrs.size());
+  os.write(reinterpret_cast<const char *>(image.addrs.data()),
+           image.addrs.size() * sizeof(uint32_t));
+  for (size_t i = 0; i < image.addrs.size(); ++i) {
+    const uint8_t *word = &image.bits[i * SV_MEM_WIDTH_BYTES];
+    os.write(reinterpret_cast<const char *>(word), phys_width_byte);
+  }
+}
+
+// The number of leading bytes of each word in image that might be nonzero.
+// Encoded words are zero above the physical width of the memory, so this
+// gives the number of bytes that need storing on disk.
+uint32_t GetUsedWidth(const MemArea::PhysImage &image) {
+  uint32_t used = 1;
+  for (size_t i = 0; i < image.addrs.size(); ++i) {
+    const uint8_t *word = &image.bits[i * SV_MEM_WIDTH_BYTES];
+    for (uint32_t j = SV_MEM_WIDTH_BYTES; j > used; --j) {
+      if (word[j - 1]) {
+        used = j;
+        break;
+      }
+    }
+  }
+  return used;
+}
+}  // namespace
+
+MemImageCache::MemImageCache(const std::string &dir) : dir_(dir) {
+  if (mkdir(dir.c_str(), 0777) != 0 && errno != EEXIST) {
+    std::ostringstream oss;
+    oss << "Could not create memory image cache directory `" << dir
+        << "': " << strerror(errno) << ".";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+std::string MemImageCache::MakeKey(const uint8_t *data, size_t len) {
+  // This is a 64-bit FNV-1a hash. It's not cryptographically strong, but we're
+  // guarding against accidental collisions between images from a build tree,
+  // not an attacker. Including the length makes those even less likely.
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= data[i];
+    hash *= 0x100000001b3ull;
+  }
+
+  std::ostringstream oss;
+  oss << std::hex << std::setfill('0') << std::setw(16) << hash << "-" << len;
+  return oss.str();
+}
+
+std::string MemImageCache::GetPath(const std::string &key) const {
+  return dir_ + "/" + key + ".memimg";
+}
+
+bool MemImageCache::Lookup(const std::string &key, Entry &entry) const {
+  std::ifstream is(GetPath(key), std::ios::binary);
+  if (!is)
+    return false;
+
+  char magic[sizeof kMagic];
+  uint32_t version, num_mems;
+  if (!is.read(magic, sizeof magic) || memcmp(magic, kMagic, sizeof magic) ||
+      !ReadU32(is, version) || version != kVersion || !ReadU32(is, num_mems) ||
+      num_mems > kMaxMems)
+    return false;
+
+  Entry ret(num_mems);
+  for (MemEntry &mem : ret) {
+    if (!ReadMemEntry(is, mem))
+      return false;
+  }
+
+  entry = std::move(ret);
+  return true;
+}
+
+void MemImageCache::Store(const std::string &key, const Entry &entry) const {
+  std::string path = GetPath(key);
+
+  // Write to a file with a name that's unique to this process, then rename it
+  // into place. rename() is atomic, so a concurrent reader will either see the
+  // old file (or no file) or the complete new one.
+  std::ostringstream tmp_oss;
+  tmp_oss << path << ".tmp." << getpid();
+  std::string tmp_path = tmp_oss.str();
+
+  {
+    std::ofstream os(tmp_path, std::ios::binary | std::ios::trunc);
+    os.write(kMagic, sizeof kMagic);
+    WriteU32(os, kVersion);
+    WriteU32(os, entry.size());
+    for (const MemEntry &mem : entry) {
+      WriteMemEntry(os, mem, GetUsedWidth(mem.image));
+    }
+
+    if (os) {
+      os.close();
+    }
+    if (!os) {
+      std::cerr << "WARNING: Could not write memory image cache file `"
+                << tmp_path << "'." << std::endl;
+      remove(tmp_path.c_str());
+      return;
+    }
+  }
+
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::cerr << "WARNING: Could not rename `" << tmp_path << "' to `" << path
+              << "': " << strerror(errno) << "." << std::endl;
+    remove(tmp_path.c_str());
+  }
+}
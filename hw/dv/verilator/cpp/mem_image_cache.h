@@ -0,0 +1,71 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_VERILATOR_CPP_MEM_IMAGE_CACHE_H_
+#define OPENTITAN_HW_DV_VERILATOR_CPP_MEM_IMAGE_CACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mem_area.h"
+
+/**
+ * An on-disk cache of encoded memory images.
+ *
+ * Each entry in the cache is the result of loading some image file (such as an
+ * ELF file) into one or more memory areas, stored as the physical words that
+ * were written (after ECC, scrambling and address mapping). Entries are keyed
+ * by a hash of the contents of the image file. Each memory in an entry also
+ * records the encoding description of the memory area that it was encoded for
+ * (see MemArea::GetEncodingDesc), which the caller should check before using
+ * the cached words.
+ *
+ * Cache files are written to a temporary file and then renamed into place, so
+ * several simulations can share a cache directory. They are stored in host
+ * byte order and aren't intended to be portable between machines.
+ */
+class MemImageCache {
+ public:
+  /** The cached contents for a single memory area */
+  struct MemEntry {
+    std::string mem_name;
+    std::string encoding_desc;
+    MemArea::PhysImage image;
+  };
+
+  typedef std::vector<MemEntry> Entry;
+
+  /** Constructor
+   *
+   * @param dir  The directory in which to store cache files. This is created
+   *             (but not its parents) if it doesn't already exist.
+   */
+  explicit MemImageCache(const std::string &dir);
+
+  /** Compute the key for an image with the given contents */
+  static std::string MakeKey(const uint8_t *data, size_t len);
+
+  /** Look up an entry in the cache
+   *
+   * Returns true and fills in \p entry if there is a valid cache file for \p
+   * key. Returns false (rather than throwing an error) if the file doesn't
+   * exist or can't be parsed.
+   */
+  bool Lookup(const std::string &key, Entry &entry) const;
+
+  /** Store an entry in the cache
+   *
+   * This is a best-effort operation: if the cache file can't be written, a
+   * warning is printed and the cache is left unchanged.
+   */
+  void Store(const std::string &key, const Entry &entry) const;
+
+ private:
+  std::string GetPath(const std::string &key) const;
+
+  std::string dir_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_CPP_MEM_IMAGE_CACHE_H_
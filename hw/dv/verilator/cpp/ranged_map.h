@@ -6,8 +6,11 @@
 
 // Utility class representing disjoint segments of memory
 
+#include <algorithm>
 #include <cassert>
 #include <map>
+#include <utility>
+#include <vector>
 
 // The type used to represent address ranges. This is essentially a std::pair,
 // but we need a operator< custom for the internal map.
@@ -153,6 +156,15 @@ class RangedMap {
   const_iterator end() const { return const_iterator(map_.end()); }
   size_t size() const { return map_.size(); }
 
+  // Move all the entries (in address order) onto the end of dst, leaving
+  // this map empty.
+  void MoveTo(std::vector<std::pair<rng_t, val_t>> &dst) {
+    for (auto &pr : map_) {
+      dst.emplace_back(pr.first, std::move(pr.second));
+    }
+    map_.clear();
+  }
+
   // Try to find an entry hitting the given address. Returns end() if there is
   // none.
   const_iterator find(addr_t addr) const {
@@ -180,4 +192,104 @@ class RangedMap {
   std::map<rng_t, val_t> map_;
 };
 
+// A map of disjoint address ranges, stored as a sorted vector
+//
+// This holds the same data as a RangedMap, but is built in one go from a list
+// of (possibly overlapping) ranges, rather than one range at a time. Lookups
+// are binary searches over a contiguous array, which is much friendlier to the
+// cache than walking a tree. Use RangedMap if you need to add ranges
+// incrementally and this class if all the ranges are known up front.
+template <typename addr_t, typename val_t>
+class FlatRangedMap {
+ public:
+  using rng_t = AddrRange<addr_t>;
+  using entry_t = std::pair<rng_t, val_t>;
+  using MergeFun = typename RangedMap<addr_t, val_t>::MergeFun;
+
+  // Replace the contents of the map with entries, which needn't be sorted.
+  //
+  // Overlapping entries are merged with merge. The result is the same as
+  // calling RangedMap::Emplace for each entry in order: where entries
+  // overlap, later entries are treated as newer than earlier ones.
+  void Build(std::vector<entry_t> &&entries, MergeFun merge) {
+    entries_.clear();
+    entries_.reserve(entries.size());
+
+    // Sort (the indices of) the entries by start address. Use a stable sort
+    // so that entries with the same start address stay in input order.
+    std::vector<size_t> order(entries.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      assert(entries[i].first.lo <= entries[i].first.hi);
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return entries[a].first.lo < entries[b].first.lo;
+    });
+
+    // Walk through the sorted entries, finding clusters of entries that are
+    // connected by overlaps. An entry that doesn't overlap anything (the
+    // common case) is moved straight into place. A cluster is resolved by
+    // emplacing its members into a RangedMap in input order, which merges
+    // them just as an incremental build would have done.
+    size_t start = 0;
+    while (start < order.size()) {
+      addr_t hi = entries[order[start]].first.hi;
+      size_t end = start + 1;
+      while (end < order.size() && entries[order[end]].first.lo <= hi) {
+        hi = std::max(hi, entries[order[end]].first.hi);
+        ++end;
+      }
+
+      if (end == start + 1) {
+        entries_.push_back(std::move(entries[order[start]]));
+      } else {
+        std::vector<size_t> cluster(order.begin() + start, order.begin() + end);
+        std::sort(cluster.begin(), cluster.end());
+
+        RangedMap<addr_t, val_t> merged;
+        for (size_t idx : cluster) {
+          entry_t &entry = entries[idx];
+          merged.Emplace(entry.first.lo, entry.first.hi,
+                         std::move(entry.second), merge);
+        }
+        merged.MoveTo(entries_);
+      }
+
+      start = end;
+    }
+  }
+
+  // Move the entries (in address order) out of the map, leaving it empty.
+  std::vector<entry_t> Release() {
+    std::vector<entry_t> ret = std::move(entries_);
+    entries_.clear();
+    return ret;
+  }
+
+  // Iteration interface (matching RangedMap)
+  using const_iterator = typename std::vector<entry_t>::const_iterator;
+
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+  size_t size() const { return entries_.size(); }
+
+  // Try to find an entry hitting the given address. Returns end() if there is
+  // none.
+  const_iterator find(addr_t addr) const {
+    // Find the first entry that starts strictly after addr. The entry before
+    // it (if there is one) is the only one that might contain addr.
+    auto it = std::upper_bound(
+        entries_.begin(), entries_.end(), addr,
+        [](addr_t a, const entry_t &entry) { return a < entry.first.lo; });
+    if (it == entries_.begin())
+      return end();
+
+    --it;
+    return (addr <= it->first.hi) ? it : end();
+  }
+
+ private:
+  std::vector<entry_t> entries_;
+};
+
 #endif  // OPENTITAN_HW_DV_VERILATOR_CPP_RANGED_MAP_H_
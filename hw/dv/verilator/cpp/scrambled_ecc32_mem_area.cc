@@ -17,34 +17,6 @@
 static const uint32_t kScrMaxNonceWidth = 320;
 static const uint32_t kScrMaxNonceWidthByte = (kScrMaxNonceWidth + 7) / 8;
 
-// Functions to convert from integer address to/from a little-endian vector of
-// bytes, addr_width is given in bits
-static std::vector<uint8_t> AddrIntToBytes(uint32_t addr, uint32_t addr_width) {
-  uint32_t addr_width_bytes = (addr_width + 7) / 8;
-  std::vector<uint8_t> addr_bytes(addr_width_bytes);
-
-  for (uint32_t i = 0; i < addr_width_bytes; ++i) {
-    addr_bytes[i] = addr & 0xff;
-    addr >>= 8;
-  }
-
-  return addr_bytes;
-}
-
-static uint32_t AddrBytesToInt(const std::vector<uint8_t> &addr) {
-  assert(addr.size() <= 4);
-
-  uint32_t addr_out = 0;
-  int cur_shift = 0;
-
-  for (uint8_t byte : addr) {
-    addr_out |= ((uint32_t)byte << cur_shift);
-    cur_shift += 8;
-  }
-
-  return addr_out;
-}
-
 // Converts svBitVecVal (bit[m:n] SV type) into a byte vector
 static std::vector<uint8_t> ByteVecFromSV(svBitVecVal sv_val[],
                                           uint32_t bytes) {
@@ -86,7 +58,7 @@ int simutil_get_scramble_key(svBitVecVal *key);
 int simutil_get_scramble_nonce(svBitVecVal *nonce);
 }
 
-std::vector<uint8_t> ScrambledEcc32MemArea::GetScrambleKey() const {
+std::vector<uint8_t> ScrambledEcc32MemArea::FetchScrambleKey() const {
   SVScoped scoped(scr_scope_);
   svBitVecVal key_minibuf[((kPrinceWidthByte * 2) + 3) / 4];
 
@@ -99,7 +71,7 @@ std::vector<uint8_t> ScrambledEcc32MemArea::GetScrambleKey() const {
   return ByteVecFromSV(key_minibuf, kPrinceWidthByte * 2);
 }
 
-std::vector<uint8_t> ScrambledEcc32MemArea::GetScrambleNonce() const {
+std::vector<uint8_t> ScrambledEcc32MemArea::FetchScrambleNonce() const {
   assert(GetNonceWidthByte() <= kScrMaxNonceWidthByte);
 
   SVScoped scoped(scr_scope_);
@@ -114,6 +86,25 @@ std::vector<uint8_t> ScrambledEcc32MemArea::GetScrambleNonce() const {
   return ByteVecFromSV(nonce_minibuf, GetNonceWidthByte());
 }
 
+void ScrambledEcc32MemArea::OnTransactionStart() const {
+  scramble_key_ = FetchScrambleKey();
+  scramble_nonce_ = FetchScrambleNonce();
+}
+
+const std::vector<uint8_t> &ScrambledEcc32MemArea::GetScrambleKey() const {
+  if (!InTransaction()) {
+    scramble_key_ = FetchScrambleKey();
+  }
+  return scramble_key_;
+}
+
+const std::vector<uint8_t> &ScrambledEcc32MemArea::GetScrambleNonce() const {
+  if (!InTransaction()) {
+    scramble_nonce_ = FetchScrambleNonce();
+  }
+  return scramble_nonce_;
+}
+
 ScrambledEcc32MemArea::ScrambledEcc32MemArea(const std::string &scope,
                                              uint32_t size, uint32_t width_32,
                                              bool repeat_keystream)
@@ -126,12 +117,24 @@ ScrambledEcc32MemArea::ScrambledEcc32MemArea(const std::string &scope,
   repeat_keystream_ = repeat_keystream;
 }
 
-uint32_t ScrambledEcc32MemArea::GetPhysWidth() const {
-  return (GetWidthByte() / 4) * 39;
+std::string ScrambledEcc32MemArea::GetEncodingDesc() const {
+  Transaction txn(*this);
+
+  std::ostringstream oss;
+  oss << "scrambled;" << Ecc32MemArea::GetEncodingDesc()
+      << ";repeat_keystream=" << repeat_keystream_ << ";key=" << std::hex;
+  for (uint8_t byte : GetScrambleKey()) {
+    oss << (unsigned)byte << ".";
+  }
+  oss << ";nonce=";
+  for (uint8_t byte : GetScrambleNonce()) {
+    oss << (unsigned)byte << ".";
+  }
+  return oss.str();
 }
 
-uint32_t ScrambledEcc32MemArea::GetPhysWidthByte() const {
-  return (GetPhysWidth() + 7) / 8;
+uint32_t ScrambledEcc32MemArea::GetPhysWidth() const {
+  return (GetWidthByte() / 4) * 39;
 }
 
 uint32_t ScrambledEcc32MemArea::GetPrinceReplications() const {
@@ -151,36 +154,37 @@ uint32_t ScrambledEcc32MemArea::GetNonceWidthByte() const {
 }
 
 void ScrambledEcc32MemArea::WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
-                                        const std::vector<uint8_t> &data,
+                                        const uint8_t *data, size_t data_len,
                                         size_t start_idx,
                                         uint32_t dst_word) const {
   // Compute integrity
-  Ecc32MemArea::WriteBuffer(buf, data, start_idx, dst_word);
+  Ecc32MemArea::WriteBuffer(buf, data, data_len, start_idx, dst_word);
   ScrambleBuffer(buf, dst_word);
 }
 
-std::vector<uint8_t> ScrambledEcc32MemArea::ReadUnscrambled(
-    const uint8_t buf[SV_MEM_WIDTH_BYTES], uint32_t src_word) const {
-  std::vector<uint8_t> scrambled_data(buf, buf + GetPhysWidthByte());
-  return scramble_decrypt_data(scrambled_data, GetPhysWidth(), 39,
-                               AddrIntToBytes(src_word, addr_width_),
-                               addr_width_, GetScrambleNonce(),
-                               GetScrambleKey(), repeat_keystream_, false);
+void ScrambledEcc32MemArea::ReadUnscrambled(
+    uint8_t dst[SV_MEM_WIDTH_BYTES], const uint8_t buf[SV_MEM_WIDTH_BYTES],
+    uint32_t src_word) const {
+  scramble_decrypt_data_buf(dst, buf, GetPhysWidth(), 39, src_word,
+                            addr_width_, &GetScrambleNonce()[0],
+                            &GetScrambleKey()[0], repeat_keystream_, false);
 }
 
 void ScrambledEcc32MemArea::ReadBuffer(std::vector<uint8_t> &data,
                                        const uint8_t buf[SV_MEM_WIDTH_BYTES],
                                        uint32_t src_word) const {
-  std::vector<uint8_t> unscrambled_data = ReadUnscrambled(buf, src_word);
+  uint8_t unscrambled_data[SV_MEM_WIDTH_BYTES];
+  ReadUnscrambled(unscrambled_data, buf, src_word);
   // Strip integrity to give final result
-  Ecc32MemArea::ReadBuffer(data, &unscrambled_data[0], src_word);
+  Ecc32MemArea::ReadBuffer(data, unscrambled_data, src_word);
 }
 
 void ScrambledEcc32MemArea::ReadBufferWithIntegrity(
     EccWords &data, const uint8_t buf[SV_MEM_WIDTH_BYTES],
     uint32_t src_word) const {
-  std::vector<uint8_t> unscrambled_data = ReadUnscrambled(buf, src_word);
-  Ecc32MemArea::ReadBufferWithIntegrity(data, &unscrambled_data[0], src_word);
+  uint8_t unscrambled_data[SV_MEM_WIDTH_BYTES];
+  ReadUnscrambled(unscrambled_data, buf, src_word);
+  Ecc32MemArea::ReadBufferWithIntegrity(data, unscrambled_data, src_word);
 }
 
 void ScrambledEcc32MemArea::WriteBufferWithIntegrity(
@@ -192,21 +196,14 @@ void ScrambledEcc32MemArea::WriteBufferWithIntegrity(
 
 void ScrambledEcc32MemArea::ScrambleBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
                                            uint32_t dst_word) const {
-  std::vector<uint8_t> scramble_buf(buf, buf + GetPhysWidthByte());
-
-  // Scramble data with integrity
-  scramble_buf = scramble_encrypt_data(
-      scramble_buf, GetPhysWidth(), 39, AddrIntToBytes(dst_word, addr_width_),
-      addr_width_, GetScrambleNonce(), GetScrambleKey(), repeat_keystream_,
-      false);
-
-  // Copy scrambled data to write buffer
-  std::copy(scramble_buf.begin(), scramble_buf.end(), &buf[0]);
+  // Scramble data with integrity in place
+  scramble_encrypt_data_buf(buf, buf, GetPhysWidth(), 39, dst_word,
+                            addr_width_, &GetScrambleNonce()[0],
+                            &GetScrambleKey()[0], repeat_keystream_, false);
 }
 
 uint32_t ScrambledEcc32MemArea::ToPhysAddr(uint32_t logical_addr) const {
   // Scramble logical address to get physical address
-  return AddrBytesToInt(scramble_addr(AddrIntToBytes(logical_addr, addr_width_),
-                                      addr_width_, GetScrambleNonce(),
-                                      GetNonceWidth()));
+  return scramble_addr_u32(logical_addr, addr_width_, &GetScrambleNonce()[0],
+                           GetNonceWidth());
 }
@@ -32,13 +32,18 @@ class ScrambledEcc32MemArea : public Ecc32MemArea {
   ScrambledEcc32MemArea(const std::string &scope, uint32_t size,
                         uint32_t width_32, bool repeat_keystream = true);
 
+  // The description includes the current scrambling key and nonce, so data
+  // encoded for one key won't be mistaken for data encoded for another.
+  std::string GetEncodingDesc() const override;
+
  private:
-  void WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
-                   const std::vector<uint8_t> &data, size_t start_idx,
+  void WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES], const uint8_t *data,
+                   size_t data_len, size_t start_idx,
                    uint32_t dst_word) const override;
 
-  std::vector<uint8_t> ReadUnscrambled(const uint8_t buf[SV_MEM_WIDTH_BYTES],
-                                       uint32_t src_word) const;
+  void ReadUnscrambled(uint8_t dst[SV_MEM_WIDTH_BYTES],
+                       const uint8_t buf[SV_MEM_WIDTH_BYTES],
+                       uint32_t src_word) const;
 
   void ReadBuffer(std::vector<uint8_t> &data,
                   const uint8_t buf[SV_MEM_WIDTH_BYTES],
@@ -55,19 +60,32 @@ class ScrambledEcc32MemArea : public Ecc32MemArea {
   void ScrambleBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES], uint32_t dst_word) const;
 
   uint32_t ToPhysAddr(uint32_t logical_addr) const override;
+  bool HasLinearPhysAddrs() const override { return false; }
 
   uint32_t GetPhysWidth() const;
-  uint32_t GetPhysWidthByte() const;
   uint32_t GetPrinceReplications() const;
   uint32_t GetNonceWidth() const;
   uint32_t GetNonceWidthByte() const;
 
-  std::vector<uint8_t> GetScrambleKey() const;
-  std::vector<uint8_t> GetScrambleNonce() const;
+  // Fetch the scramble key and nonce over DPI and store them in
+  // scramble_key_ and scramble_nonce_.
+  void OnTransactionStart() const override;
+
+  // Return the current scramble key and nonce. Inside a transaction, these
+  // are the values that were fetched when it started. Outside of one, they
+  // are fetched over DPI on each call.
+  const std::vector<uint8_t> &GetScrambleKey() const;
+  const std::vector<uint8_t> &GetScrambleNonce() const;
+
+  std::vector<uint8_t> FetchScrambleKey() const;
+  std::vector<uint8_t> FetchScrambleNonce() const;
 
   std::string scr_scope_;
   uint32_t addr_width_;
   bool repeat_keystream_;
+
+  mutable std::vector<uint8_t> scramble_key_;
+  mutable std::vector<uint8_t> scramble_nonce_;
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_CPP_SCRAMBLED_ECC32_MEM_AREA_H_
@@ -78,6 +78,8 @@ static void PrintHelp() {
                "  Load ELF file, using segment LMAs to pick memory regions\n\n"
                "-l list|--meminit=list\n"
                "  Print registered memory regions\n\n"
+               "--mem-image-cache=DIR\n"
+               "  Cache encoded images of ELF files from --load-elf in DIR\n\n"
                "--verbose-mem-load\n"
                "  Print a message for each memory load\n\n"
                "-h|--help\n"
@@ -101,6 +103,7 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
       {"otpinit", required_argument, nullptr, 'o'},
       {"meminit", required_argument, nullptr, 'l'},
       {"verbose-mem-load", no_argument, nullptr, 'V'},
+      {"mem-image-cache", required_argument, nullptr, 'C'},
       {"load-elf", required_argument, nullptr, 'E'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, no_argument, nullptr, 0}};
@@ -158,6 +161,14 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
       case 'V':
         verbose = true;
         break;
+      case 'C':
+        try {
+          mem_util_->SetImageCacheDir(optarg);
+        } catch (const std::runtime_error &err) {
+          std::cerr << "ERROR: " << err.what() << std::endl;
+          return false;
+        }
+        break;
       case 'E':
         load_args.push_back(
             {.name = "", .filepath = optarg, .type = kMemImageElf});
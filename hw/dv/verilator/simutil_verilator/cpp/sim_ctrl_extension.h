@@ -5,6 +5,23 @@
 #ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SIM_CTRL_EXTENSION_H_
 #define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SIM_CTRL_EXTENSION_H_
 
+#include <string>
+
+/**
+ * An extension to VerilatorSimCtrl
+ *
+ * All of the callbacks below are called from the thread that runs the
+ * simulation, between calls to the model's eval() function. This is true even
+ * if the model was Verilated with --threads, so the callbacks never run
+ * concurrently with each other or with the design.
+ *
+ * Code that is called from the design over DPI is different: with a
+ * multi-threaded model, it may run on one of Verilator's worker threads. By
+ * default (--threads-dpi pure), Verilator only calls DPI imports that are
+ * declared pure from worker threads. If an extension shares state with DPI
+ * code that might run on a worker thread, it must synchronise accesses to
+ * that state itself.
+ */
 class SimCtrlExtension {
  public:
   virtual ~SimCtrlExtension() = default;
@@ -43,6 +60,27 @@ class SimCtrlExtension {
    * Function to be called after executing the simulation
    */
   virtual void PostExec() {}
+
+  /**
+   * Save any state that the extension needs to resume from a checkpoint
+   *
+   * This is called when VerilatorSimCtrl saves a checkpoint of the
+   * simulation. The extension should serialise its state into state. The
+   * default implementation is for a stateless extension and saves nothing.
+   *
+   * @return true on success. If false, the checkpoint is abandoned.
+   */
+  virtual bool SaveState(std::string &state) { return true; }
+
+  /**
+   * Restore state saved by SaveState
+   *
+   * This is called when VerilatorSimCtrl restores a checkpoint, after the
+   * model state has been restored and before the simulation continues.
+   *
+   * @return true on success. If false, the simulation doesn't start.
+   */
+  virtual bool RestoreState(const std::string &state) { return true; }
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SIM_CTRL_EXTENSION_H_
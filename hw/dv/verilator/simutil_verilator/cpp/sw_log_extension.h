@@ -0,0 +1,252 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SW_LOG_EXTENSION_H_
+#define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SW_LOG_EXTENSION_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <getopt.h>
+#include <iostream>
+#include <libelf.h>
+#include <map>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "sim_ctrl_extension.h"
+
+/**
+ * Decoder for DV log bypass writes
+ *
+ * Software built with a non-zero `kDeviceLogBypassUartAddress` writes the
+ * address of each log's `log_fields_t` to the sim SRAM, followed by its
+ * arguments, instead of formatting the log and sending it through the UART.
+ * This extension resolves those addresses against the `.logs.fields` section
+ * and the read-only data of the ELF given with `--sw-log-elf` and prints the
+ * formatted log to stdout, as sw_logger_if does for the DV testbench.
+ *
+ * The toplevel testbench is responsible for forwarding each word written to
+ * the log bypass address to Write(), usually through a DPI function.
+ */
+class SwLogExtension : public SimCtrlExtension {
+ public:
+  bool ParseCLIArguments(int argc, char **argv, bool &exit_app) override {
+    const struct option long_options[] = {
+        {"sw-log-elf", required_argument, nullptr, 'L'},
+        {nullptr, no_argument, nullptr, 0}};
+
+    // Reset the command parsing index in-case other utils have already parsed
+    // some arguments
+    optind = 1;
+    while (1) {
+      int c = getopt_long(argc, argv, "-:", long_options, nullptr);
+      if (c == -1) {
+        break;
+      }
+
+      // Disable error reporting by getopt
+      opterr = 0;
+
+      if (c == 'L' && !LoadElf(optarg)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Consumes one word written to the log bypass address.
+   */
+  void Write(uint32_t data) {
+    if (!pending_) {
+      auto it = fields_.find(data);
+      if (it == fields_.end()) {
+        std::cout << "SW log: unknown log fields address 0x" << std::hex
+                  << data << std::dec << std::endl;
+        return;
+      }
+      pending_ = &it->second;
+      args_.clear();
+    } else {
+      args_.push_back(data);
+    }
+    if (args_.size() == pending_->nargs) {
+      Print(*pending_);
+      pending_ = nullptr;
+    }
+  }
+
+ private:
+  // Mirrors log_fields_t in sw/device/lib/runtime/log.h.
+  struct LogFields {
+    uint32_t severity;
+    std::string file_name;
+    uint32_t line;
+    uint32_t nargs;
+    std::string format;
+  };
+
+  bool LoadElf(const char *path) {
+    int fd = open(path, O_RDONLY, 0);
+    if (fd < 0) {
+      std::cerr << "ERROR: Could not open SW log ELF " << path << std::endl;
+      return false;
+    }
+    (void)elf_version(EV_CURRENT);
+    Elf *elf = elf_begin(fd, ELF_C_READ, nullptr);
+    size_t shstrndx;
+    bool ok = elf && elf_getshdrstrndx(elf, &shstrndx) == 0;
+    std::vector<uint8_t> logs;
+    uint32_t logs_addr = 0;
+    for (Elf_Scn *scn = nullptr; ok && (scn = elf_nextscn(elf, scn));) {
+      const Elf32_Shdr *shdr = elf32_getshdr(scn);
+      const char *name = elf_strptr(elf, shstrndx, shdr->sh_name);
+      Elf_Data *data = elf_getdata(scn, nullptr);
+      if (!name || !data || !data->d_buf || shdr->sh_type != SHT_PROGBITS ||
+          strncmp(name, ".debug", 6) == 0) {
+        continue;
+      }
+      const uint8_t *buf = static_cast<const uint8_t *>(data->d_buf);
+      std::vector<uint8_t> contents(buf, buf + data->d_size);
+      if (strcmp(name, ".logs.fields") == 0) {
+        logs_addr = shdr->sh_addr;
+        logs = std::move(contents);
+      } else {
+        sections_[shdr->sh_addr] = std::move(contents);
+      }
+    }
+    if (elf) {
+      elf_end(elf);
+    }
+    close(fd);
+    if (!ok) {
+      std::cerr << "ERROR: Could not parse SW log ELF " << path << std::endl;
+      return false;
+    }
+
+    // Each log_fields_t is five little-endian words.
+    auto word = [&](size_t offset) {
+      uint32_t value;
+      memcpy(&value, &logs[offset], sizeof(value));
+      return value;
+    };
+    for (size_t offset = 0; offset + 20 <= logs.size(); offset += 20) {
+      fields_[logs_addr + offset] = {
+          .severity = word(offset),
+          .file_name = ReadString(word(offset + 4)),
+          .line = word(offset + 8),
+          .nargs = word(offset + 12),
+          .format = ReadString(word(offset + 16)),
+      };
+    }
+    return true;
+  }
+
+  std::string ReadString(uint32_t addr) const {
+    auto it = sections_.upper_bound(addr);
+    if (it == sections_.begin()) {
+      return "";
+    }
+    --it;
+    const std::vector<uint8_t> &contents = it->second;
+    size_t offset = addr - it->first;
+    if (offset >= contents.size()) {
+      return "";
+    }
+    const char *str = reinterpret_cast<const char *>(&contents[offset]);
+    return std::string(str, strnlen(str, contents.size() - offset));
+  }
+
+  void Print(const LogFields &log) const {
+    static const char kSeverities[] = "IWEF";
+    std::string base_name = log.file_name;
+    size_t slash = base_name.rfind('/');
+    if (slash != std::string::npos) {
+      base_name = base_name.substr(slash + 1);
+    }
+
+    std::string out;
+    size_t arg = 0;
+    auto next_arg = [&]() { return arg < args_.size() ? args_[arg++] : 0; };
+    for (size_t i = 0; i < log.format.size(); ++i) {
+      if (log.format[i] != '%') {
+        out += log.format[i];
+        continue;
+      }
+      // Collect the flags and width, which are passed on to snprintf.
+      std::string spec = "%";
+      while (++i < log.format.size() &&
+             strchr("-+ #0123456789", log.format[i])) {
+        spec += log.format[i];
+      }
+      if (i >= log.format.size()) {
+        break;
+      }
+      char buf[64];
+      char conv = log.format[i];
+      switch (conv) {
+        case '%':
+          out += '%';
+          continue;
+        case 'c':
+          out += static_cast<char>(next_arg());
+          continue;
+        case 's':
+          out += ReadString(next_arg());
+          continue;
+        case 'd':
+        case 'i':
+          snprintf(buf, sizeof(buf), (spec + "d").c_str(),
+                   static_cast<int32_t>(next_arg()));
+          break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+          snprintf(buf, sizeof(buf), (spec + conv).c_str(), next_arg());
+          break;
+        case 'h':
+        case 'H':
+          snprintf(buf, sizeof(buf), (spec + (conv == 'h' ? 'x' : 'X')).c_str(),
+                   next_arg());
+          break;
+        case 'p':
+          snprintf(buf, sizeof(buf), "0x%08x", next_arg());
+          break;
+        default:
+          // %b, %C, %r and the %! forms are not decoded; show the raw
+          // arguments instead. The %! forms take a length and a pointer.
+          if (conv == '!' && i + 1 < log.format.size()) {
+            ++i;
+            snprintf(buf, sizeof(buf), "<%%!%c", log.format[i]);
+            out += buf;
+            if (log.format[i] != 'b') {
+              snprintf(buf, sizeof(buf), " 0x%x", next_arg());
+              out += buf;
+            }
+          } else {
+            snprintf(buf, sizeof(buf), "<%%%c", conv);
+            out += buf;
+          }
+          snprintf(buf, sizeof(buf), " 0x%x>", next_arg());
+          break;
+      }
+      out += buf;
+    }
+
+    std::cout << "SW log: "
+              << (log.severity < 4 ? kSeverities[log.severity] : '?') << " "
+              << base_name << ":" << log.line << "] " << out << std::endl;
+  }
+
+  std::map<uint32_t, std::vector<uint8_t>> sections_;
+  std::map<uint32_t, LogFields> fields_;
+  const LogFields *pending_ = nullptr;
+  std::vector<uint32_t> args_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SW_LOG_EXTENSION_H_
@@ -0,0 +1,67 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_TEST_DONE_EXTENSION_H_
+#define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_TEST_DONE_EXTENSION_H_
+
+#include <iostream>
+#include <string>
+
+#include "sim_ctrl_extension.h"
+#include "verilator_sim_ctrl.h"
+
+/**
+ * VerilatorSimCtrl extension for self-checking testbenches
+ *
+ * The testbench does all of its checking in the design and reports the
+ * outcome on two outputs: test_done_o, which goes high once the test has
+ * finished, and test_passed_o, which is valid whenever test_done_o is high.
+ * The extension stops the simulation as soon as the test is done.
+ */
+template <class Top>
+class TestDoneExtension : public SimCtrlExtension {
+ public:
+  explicit TestDoneExtension(const Top *top) : top_(top) {}
+
+  void OnClock(unsigned long sim_time) override {
+    if (top_->test_done_o) {
+      VerilatorSimCtrl::GetInstance().RequestStop(top_->test_passed_o);
+    }
+  }
+
+ private:
+  const Top *top_;
+};
+
+/**
+ * Run a self-checking testbench to completion
+ *
+ * This sets up VerilatorSimCtrl for top, whose clock and active-low reset
+ * are clk_i and rst_ni, registers a TestDoneExtension and runs the
+ * simulation. All the usual VerilatorSimCtrl options (tracing windows,
+ * cycle limits and so on) are available, and the simulation speed is
+ * reported at the end.
+ *
+ * @param top The Verilated testbench
+ * @param title Title printed before the simulation starts
+ * @param argc, argv Standard C command line arguments
+ * @return Process return code, 0 if the test passed
+ */
+template <class Top>
+int RunTestDoneSim(Top &top, const std::string &title, int argc, char **argv) {
+  VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
+  simctrl.SetTop(&top, &top.clk_i, &top.rst_ni,
+                 VerilatorSimCtrlFlags::ResetPolarityNegative);
+
+  TestDoneExtension<Top> test_done(&top);
+  simctrl.RegisterExtension(&test_done);
+
+  std::cout << title << std::endl
+            << std::string(title.size(), '=') << std::endl
+            << std::endl;
+
+  return simctrl.Exec(argc, argv).first;
+}
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_TEST_DONE_EXTENSION_H_
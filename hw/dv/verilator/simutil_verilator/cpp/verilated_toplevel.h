@@ -43,6 +43,19 @@
 #endif
 #endif
 
+// VM_SAVABLE must be set to 1 by the user when calling Verilator with
+// --savable. This enables saving and restoring the state of the model.
+#ifndef VM_SAVABLE
+#define VM_SAVABLE 0
+#endif
+
+#if VM_SAVABLE == 1
+#include "verilated_save.h"
+#else
+class VerilatedSerialize;
+class VerilatedDeserialize;
+#endif
+
 #if VM_TRACE == 1
 /**
  * "Base" for all tracers in Verilator with common functionality
@@ -123,6 +136,16 @@ class VerilatedToplevel {
   virtual const char *name() const = 0;
   virtual void trace(VerilatedTracer &tfp, int levels, int options) = 0;
 
+  /**
+   * Save or restore the state of the model
+   *
+   * This is only supported if the model was Verilated with --savable (and
+   * VM_SAVABLE is set). Use Savable() to check.
+   */
+  virtual void save(VerilatedSerialize &os) = 0;
+  virtual void restore(VerilatedDeserialize &is) = 0;
+  static bool Savable() { return VM_SAVABLE == 1; }
+
   /**
    * Get the Verilator-generated device under test
    *
@@ -148,6 +171,20 @@ class TOPLEVEL_NAME : public VERILATED_TOPLEVEL_NAME, public VerilatedToplevel {
                                    levels, options);
 #else
     assert(0 && "Tracing not enabled.");
+#endif
+  }
+  void save(VerilatedSerialize &os) {
+#if VM_SAVABLE == 1
+    os << *static_cast<VERILATED_TOPLEVEL_NAME *>(this);
+#else
+    assert(0 && "Model is not savable.");
+#endif
+  }
+  void restore(VerilatedDeserialize &is) {
+#if VM_SAVABLE == 1
+    is >> *static_cast<VERILATED_TOPLEVEL_NAME *>(this);
+#else
+    assert(0 && "Model is not savable.");
 #endif
   }
 };
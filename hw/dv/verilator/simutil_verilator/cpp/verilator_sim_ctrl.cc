@@ -4,6 +4,8 @@
 
 #include "verilator_sim_ctrl.h"
 
+#include <cstdio>
+#include <cstring>
 #include <getopt.h>
 #include <iostream>
 #include <signal.h>
@@ -22,6 +24,20 @@
  */
 double sc_time_stamp() { return VerilatorSimCtrl::GetInstance().GetTime(); }
 
+/**
+ * Start tracing (if possible) from the design
+ *
+ * This can be imported with
+ *
+ *   import "DPI-C" function void simutil_verilator_trace_trigger();
+ *
+ * and called when some event of interest happens, so that a trace file only
+ * contains the part of the simulation that follows it.
+ */
+extern "C" void simutil_verilator_trace_trigger() {
+  VerilatorSimCtrl::GetInstance().TraceTrigger();
+}
+
 #ifdef VL_USER_STOP
 /**
  * A simulation stop was requested, e.g. through $stop() or $error()
@@ -110,7 +126,16 @@ static bool read_ul_arg(unsigned long *arg_val, const char *arg_name,
 bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
   const struct option long_options[] = {
       {"term-after-cycles", required_argument, nullptr, 'c'},
+      {"sim-threads", required_argument, nullptr, 'T'},
+      {"stats-interval", required_argument, nullptr, 'I'},
+      {"stats-file", required_argument, nullptr, 'F'},
+      {"checkpoint-save", required_argument, nullptr, 'K'},
+      {"checkpoint-cycle", required_argument, nullptr, 'k'},
+      {"checkpoint-restore", required_argument, nullptr, 'L'},
       {"trace", optional_argument, nullptr, 't'},
+      {"trace-start", required_argument, nullptr, 'S'},
+      {"trace-stop", required_argument, nullptr, 'P'},
+      {"trace-ring", required_argument, nullptr, 'R'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, no_argument, nullptr, 0}};
 
@@ -139,12 +164,70 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
         }
         TraceOn();
         break;
+      case 'S':
+      case 'P':
+      case 'R': {
+        if (!tracing_possible_) {
+          std::cerr << "ERROR: Tracing has not been enabled at compile time."
+                    << std::endl;
+          exit_app = true;
+          return false;
+        }
+        unsigned long *dst = (c == 'S')   ? &trace_start_cycle_
+                             : (c == 'P') ? &trace_stop_cycle_
+                                          : &trace_ring_cycles_;
+        const char *name = (c == 'S')   ? "trace-start"
+                           : (c == 'P') ? "trace-stop"
+                                        : "trace-ring";
+        if (!read_ul_arg(dst, name, optarg)) {
+          exit_app = true;
+          return false;
+        }
+        break;
+      }
       case 'c':
         if (!read_ul_arg(&term_after_cycles_, "term-after-cycles", optarg)) {
           exit_app = true;
           return false;
         }
         break;
+      case 'T':
+        if (!read_ul_arg(&sim_threads_, "sim-threads", optarg)) {
+          exit_app = true;
+          return false;
+        }
+        if (!CheckSimThreads()) {
+          exit_app = true;
+          return false;
+        }
+        break;
+      case 'I':
+        if (!read_ul_arg(&stats_interval_, "stats-interval", optarg)) {
+          exit_app = true;
+          return false;
+        }
+        break;
+      case 'F':
+        stats_file_path_.assign(optarg);
+        break;
+      case 'K':
+      case 'L':
+        if (!VerilatedToplevel::Savable()) {
+          std::cerr << "ERROR: Checkpoints need a model Verilated with "
+                       "--savable (and VM_SAVABLE=1)."
+                    << std::endl;
+          exit_app = true;
+          return false;
+        }
+        (c == 'K' ? checkpoint_save_path_ : checkpoint_restore_path_)
+            .assign(optarg);
+        break;
+      case 'k':
+        if (!read_ul_arg(&checkpoint_cycle_, "checkpoint-cycle", optarg)) {
+          exit_app = true;
+          return false;
+        }
+        break;
       case 'h':
         PrintHelp();
         exit_app = true;
@@ -160,6 +243,27 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
     }
   }
 
+  if (!checkpoint_save_path_.empty() && !checkpoint_cycle_) {
+    std::cerr << "ERROR: --checkpoint-save needs a nonzero --checkpoint-cycle."
+              << std::endl;
+    exit_app = true;
+    return false;
+  }
+
+  if (trace_stop_cycle_ && trace_stop_cycle_ <= trace_start_cycle_) {
+    std::cerr << "ERROR: The trace-stop cycle must be after the trace-start "
+                 "cycle."
+              << std::endl;
+    exit_app = true;
+    return false;
+  }
+
+  // Ring-buffer mode needs tracing to be on. If there's no trace window, start
+  // tracing straight away.
+  if (trace_ring_cycles_ && !trace_start_cycle_) {
+    TraceOn();
+  }
+
   // Pass args to verilator
   Verilated::commandArgs(argc, argv);
 
@@ -185,6 +289,11 @@ void VerilatorSimCtrl::RunSimulation() {
               << std::endl
               << "$ kill -USR1 " << getpid() << std::endl;
   }
+  if (trace_ring_cycles_) {
+    std::cout << "Keeping the last " << trace_ring_cycles_
+              << " traced cycles in " << GetTraceRingFileName(0) << " and "
+              << GetTraceRingFileName(1) << "." << std::endl;
+  }
   // Call all extension pre-exec methods
   for (auto it = extension_array_.begin(); it != extension_array_.end(); ++it) {
     (*it)->PreExec();
@@ -198,7 +307,9 @@ void VerilatorSimCtrl::RunSimulation() {
   // Print simulation speed info
   PrintStatistics();
   // Print helper message for tracing
-  if (TracingEverEnabled()) {
+  // In ring-buffer mode, trace files are only kept for failing simulations
+  // (and FinishTraceRing has already printed their names).
+  if (TracingEverEnabled() && !trace_ring_cycles_) {
     std::cout << std::endl
               << "You can view the simulation traces by calling" << std::endl
               << "$ gtkwave " << GetTraceFileName() << std::endl;
@@ -218,8 +329,18 @@ void VerilatorSimCtrl::SetTimeout(unsigned int cycles) {
 }
 
 void VerilatorSimCtrl::RequestStop(bool simulation_success) {
+  // Clear simulation_success_ before setting request_stop_, so that the main
+  // loop sees the final result once it sees the request.
+  if (!simulation_success) {
+    simulation_success_ = false;
+  }
   request_stop_ = true;
-  simulation_success_ &= simulation_success;
+}
+
+void VerilatorSimCtrl::TraceTrigger() {
+  if (!TracingEnabled()) {
+    TraceOn();
+  }
 }
 
 void VerilatorSimCtrl::RegisterExtension(SimCtrlExtension *ext) {
@@ -243,7 +364,17 @@ VerilatorSimCtrl::VerilatorSimCtrl()
       request_stop_(false),
       simulation_success_(true),
       tracer_(VerilatedTracer()),
-      term_after_cycles_(0) {
+      term_after_cycles_(0),
+      sim_threads_(0),
+      trace_start_cycle_(0),
+      trace_stop_cycle_(0),
+      trace_ring_cycles_(0),
+      trace_ring_idx_(0),
+      trace_ring_seg_start_(0),
+      checkpoint_cycle_(0),
+      stats_interval_(0),
+      stats_file_path_("sim_stats.jsonl"),
+      stats_last_time_(0) {
 }
 
 void VerilatorSimCtrl::RegisterSignalHandler() {
@@ -279,10 +410,33 @@ void VerilatorSimCtrl::PrintHelp() const {
   if (tracing_possible_) {
     std::cout << "-t|--trace\n"
                  "   --trace=FILE\n"
-                 "  Write a trace file from the start\n\n";
+                 "  Write a trace file from the start\n\n"
+                 "--trace-start=N\n"
+                 "  Start tracing at cycle N\n\n"
+                 "--trace-stop=N\n"
+                 "  Stop tracing at cycle N\n\n"
+                 "--trace-ring=N\n"
+                 "  Only keep (at least) the last N traced cycles, in two\n"
+                 "  trace files that are used alternately. The files are\n"
+                 "  deleted if the simulation passes.\n\n";
   }
   std::cout << "-c|--term-after-cycles=N\n"
                "  Terminate simulation after N cycles. 0 means no timeout.\n\n"
+               "--stats-interval=N\n"
+               "  Every N cycles, append a line of statistics (as JSON) to\n"
+               "  the statistics file\n\n"
+               "--stats-file=FILE\n"
+               "  Write periodic statistics to FILE\n"
+               "  (default: sim_stats.jsonl)\n\n"
+               "--checkpoint-save=FILE\n"
+               "--checkpoint-cycle=N\n"
+               "  Save a checkpoint of the simulation to FILE at cycle N\n\n"
+               "--checkpoint-restore=FILE\n"
+               "  Start the simulation from the checkpoint in FILE\n\n"
+               "--sim-threads=N\n"
+               "  Check that the model evaluates the design with N threads.\n"
+               "  The thread count is fixed when the model is Verilated\n"
+               "  (with --threads).\n\n"
                "-h|--help\n"
                "  Show help\n\n"
                "All arguments are passed to the design and can be used "
@@ -309,6 +463,39 @@ bool VerilatorSimCtrl::TraceOff() {
   return tracing_enabled_;
 }
 
+unsigned int VerilatorSimCtrl::GetModelThreads() const {
+  // VerilatedContext only reports the thread count from Verilator 5.
+#if defined(VERILATOR_VERSION_INTEGER) && VERILATOR_VERSION_INTEGER >= 5000000
+  return Verilated::threadContextp()->threads();
+#else
+  return 0;
+#endif
+}
+
+bool VerilatorSimCtrl::CheckSimThreads() const {
+  if (sim_threads_ == 0) {
+    return true;
+  }
+
+  unsigned int model_threads = GetModelThreads();
+  if (model_threads == 0) {
+    std::cerr << "WARNING: This version of Verilator doesn't report the number "
+                 "of threads used by the model, so --sim-threads can't be "
+                 "checked."
+              << std::endl;
+    return true;
+  }
+  if (sim_threads_ != model_threads) {
+    std::cerr << "ERROR: --sim-threads=" << sim_threads_
+              << " was requested, but this model evaluates the design with "
+              << model_threads
+              << " thread(s). Re-Verilate with --threads=" << sim_threads_
+              << " to change this." << std::endl;
+    return false;
+  }
+  return true;
+}
+
 void VerilatorSimCtrl::PrintStatistics() const {
   double speed_hz = time_ / 2 / (GetExecutionTimeMs() / 1000.0);
   double speed_khz = speed_hz / 1000.0;
@@ -317,6 +504,10 @@ void VerilatorSimCtrl::PrintStatistics() const {
             << "Simulation statistics" << std::endl
             << "=====================" << std::endl
             << "Executed cycles:  " << std::dec << time_ / 2 << std::endl
+            << "Model threads:    "
+            << (GetModelThreads() ? std::to_string(GetModelThreads())
+                                  : std::string("unknown"))
+            << std::endl
             << "Wallclock time:   " << GetExecutionTimeMs() / 1000.0 << " s"
             << std::endl
             << "Simulation speed: " << speed_hz << " cycles/s "
@@ -329,9 +520,27 @@ void VerilatorSimCtrl::PrintStatistics() const {
 }
 
 std::string VerilatorSimCtrl::GetTraceFileName() const {
+  if (trace_ring_cycles_) {
+    return GetTraceRingFileName(trace_ring_idx_);
+  }
   return trace_file_path_;
 }
 
+std::string VerilatorSimCtrl::GetTraceRingFileName(unsigned int idx) const {
+  std::string suffix = "." + std::to_string(idx);
+
+  // Insert the suffix before the extension (if there is one), so that the
+  // files can still be recognised by waveform viewers.
+  size_t slash = trace_file_path_.rfind('/');
+  size_t dot = trace_file_path_.rfind('.');
+  if (dot == std::string::npos || dot == 0 ||
+      (slash != std::string::npos && dot < slash)) {
+    return trace_file_path_ + suffix;
+  }
+  return trace_file_path_.substr(0, dot) + suffix +
+         trace_file_path_.substr(dot);
+}
+
 void VerilatorSimCtrl::Run() {
   assert(top_ && "Use SetTop() first.");
 
@@ -341,14 +550,37 @@ void VerilatorSimCtrl::Run() {
     top_->trace(tracer_, 99, 0);
   }
 
+  // A checkpoint must be restored before the first evaluation. Its model
+  // state says that initial blocks have already run, so they won't run again.
+  bool restored = false;
+  if (!checkpoint_restore_path_.empty()) {
+    if (!RestoreCheckpoint()) {
+      simulation_success_ = false;
+      time_begin_ = time_end_ = std::chrono::steady_clock::now();
+      return;
+    }
+    restored = true;
+  }
+
   // Evaluate all initial blocks, including the DPI setup routines
   top_->eval();
 
   std::cout << std::endl
             << "Simulation running, end by pressing CTRL-c." << std::endl;
 
+  if (!OpenStatsFile()) {
+    simulation_success_ = false;
+    time_begin_ = time_end_ = std::chrono::steady_clock::now();
+    return;
+  }
+
   time_begin_ = std::chrono::steady_clock::now();
-  UnsetReset();
+  stats_last_wall_ = time_begin_;
+  stats_last_time_ = time_;
+  // The reset input is part of the restored state
+  if (!restored) {
+    UnsetReset();
+  }
   Trace();
 
   unsigned long start_reset_cycle_ = initial_reset_delay_cycles_;
@@ -367,17 +599,25 @@ void VerilatorSimCtrl::Run() {
 
     // Call all extension on-clock methods
     if (*sig_clk_) {
-      for (auto it = extension_array_.begin(); it != extension_array_.end();
-           ++it) {
-        (*it)->OnClock(time_);
-      }
+      CallOnClock();
     }
 
     top_->eval();
     time_++;
 
+    if (stats_interval_ && time_ % (2 * stats_interval_) == 0) {
+      ReportStats(false);
+    }
+
+    UpdateTraceWindow(time_ / 2);
     Trace();
 
+    if (!checkpoint_save_path_.empty() && time_ == 2 * checkpoint_cycle_) {
+      if (!SaveCheckpoint()) {
+        RequestStop(false);
+      }
+    }
+
     if (request_stop_) {
       std::cout << "Received stop request, shutting down simulation."
                 << std::endl;
@@ -398,9 +638,18 @@ void VerilatorSimCtrl::Run() {
   top_->final();
   time_end_ = std::chrono::steady_clock::now();
 
+  if (stats_interval_) {
+    ReportStats(true);
+    stats_file_.close();
+  }
+
   if (TracingEverEnabled()) {
     tracer_.close();
   }
+
+  if (trace_ring_cycles_ && TracingEverEnabled()) {
+    FinishTraceRing();
+  }
 }
 
 std::string VerilatorSimCtrl::GetName() const {
@@ -460,11 +709,238 @@ void VerilatorSimCtrl::Trace() {
     return;
   }
 
+  RotateTraceRing(GetTime() / 2);
+
   if (!tracer_.isOpen()) {
+    trace_ring_seg_start_ = GetTime() / 2;
     tracer_.open(GetTraceFileName().c_str());
-    std::cout << "Writing simulation traces to " << GetTraceFileName()
-              << std::endl;
+    if (!trace_ring_cycles_) {
+      std::cout << "Writing simulation traces to " << GetTraceFileName()
+                << std::endl;
+    }
   }
 
   tracer_.dump(GetTime());
 }
+
+void VerilatorSimCtrl::UpdateTraceWindow(unsigned long cycle) {
+  if (trace_start_cycle_ && cycle == trace_start_cycle_) {
+    TraceOn();
+  } else if (trace_stop_cycle_ && cycle == trace_stop_cycle_) {
+    TraceOff();
+  }
+}
+
+void VerilatorSimCtrl::RotateTraceRing(unsigned long cycle) {
+  if (!trace_ring_cycles_ || !tracer_.isOpen()) {
+    return;
+  }
+  if (cycle - trace_ring_seg_start_ < trace_ring_cycles_) {
+    return;
+  }
+
+  // Close the current file and switch to the other one. This discards
+  // whatever it held before, but we still have at least trace_ring_cycles_
+  // cycles of history in the file we just closed. Trace() will open the new
+  // file.
+  tracer_.close();
+  trace_ring_idx_ ^= 1;
+}
+
+void VerilatorSimCtrl::FinishTraceRing() {
+  if (WasSimulationSuccessful()) {
+    for (unsigned int idx = 0; idx < 2; ++idx) {
+      remove(GetTraceRingFileName(idx).c_str());
+    }
+    return;
+  }
+
+  // The current file holds the most recent cycles and the other one (if it
+  // exists) holds the ones before that.
+  std::cout << std::endl
+            << "Simulation failed. The last traced cycles are in "
+            << GetTraceRingFileName(trace_ring_idx_);
+  int size_byte;
+  if (FileSize(GetTraceRingFileName(trace_ring_idx_ ^ 1), size_byte)) {
+    std::cout << " (preceded by " << GetTraceRingFileName(trace_ring_idx_ ^ 1)
+              << ")";
+  }
+  std::cout << "." << std::endl;
+}
+
+// Checkpoint file header. Bump kCheckpointVersion if the format changes.
+static const char kCheckpointMagic[8] = {'O', 'T', 'S', 'I',
+                                         'M', 'C', 'K', 'P'};
+static const uint32_t kCheckpointVersion = 1;
+
+bool VerilatorSimCtrl::SaveCheckpoint() {
+#if VM_SAVABLE == 1
+  // Collect extension state first, so that a failure doesn't leave a partial
+  // checkpoint file behind.
+  std::vector<std::string> ext_states(extension_array_.size());
+  for (size_t i = 0; i < extension_array_.size(); ++i) {
+    if (!extension_array_[i]->SaveState(ext_states[i])) {
+      std::cerr << "ERROR: Extension " << i
+                << " could not save its state for a checkpoint." << std::endl;
+      return false;
+    }
+  }
+
+  VerilatedSave os;
+  os.open(checkpoint_save_path_.c_str());
+  if (!os.isOpen()) {
+    std::cerr << "ERROR: Could not open `" << checkpoint_save_path_
+              << "' to save a checkpoint." << std::endl;
+    return false;
+  }
+
+  uint32_t version = kCheckpointVersion;
+  vluint64_t time = time_;
+  uint32_t num_exts = ext_states.size();
+  os.write(kCheckpointMagic, sizeof kCheckpointMagic);
+  os << version << time;
+  top_->save(os);
+  os << num_exts;
+  for (const std::string &state : ext_states) {
+    uint32_t len = state.size();
+    os << len;
+    os.write(state.data(), len);
+  }
+  os.close();
+
+  std::cout << "Saved checkpoint at cycle " << time_ / 2 << " to "
+            << checkpoint_save_path_ << "." << std::endl;
+  return true;
+#else
+  assert(0 && "Model is not savable.");
+  return false;
+#endif
+}
+
+bool VerilatorSimCtrl::RestoreCheckpoint() {
+#if VM_SAVABLE == 1
+  VerilatedRestore is;
+  is.open(checkpoint_restore_path_.c_str());
+  if (!is.isOpen()) {
+    std::cerr << "ERROR: Could not open checkpoint `"
+              << checkpoint_restore_path_ << "'." << std::endl;
+    return false;
+  }
+
+  char magic[sizeof kCheckpointMagic];
+  uint32_t version;
+  vluint64_t time;
+  is.read(magic, sizeof magic);
+  is >> version >> time;
+  if (memcmp(magic, kCheckpointMagic, sizeof magic) ||
+      version != kCheckpointVersion) {
+    std::cerr << "ERROR: `" << checkpoint_restore_path_
+              << "' is not a checkpoint file (or has the wrong version)."
+              << std::endl;
+    return false;
+  }
+
+  // Verilator checks that the model matches as part of this (and exits with
+  // a fatal error if not).
+  top_->restore(is);
+
+  uint32_t num_exts;
+  is >> num_exts;
+  if (num_exts != extension_array_.size()) {
+    std::cerr << "ERROR: Checkpoint `" << checkpoint_restore_path_
+              << "' has state for " << num_exts << " extension(s), but "
+              << extension_array_.size() << " are registered." << std::endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < num_exts; ++i) {
+    uint32_t len;
+    is >> len;
+    std::string state(len, '\0');
+    is.read(&state[0], len);
+    if (!extension_array_[i]->RestoreState(state)) {
+      std::cerr << "ERROR: Extension " << i
+                << " could not restore its state from checkpoint `"
+                << checkpoint_restore_path_ << "'." << std::endl;
+      return false;
+    }
+  }
+  is.close();
+
+  time_ = time;
+  std::cout << "Restored checkpoint at cycle " << time_ / 2 << " from "
+            << checkpoint_restore_path_ << "." << std::endl;
+  return true;
+#else
+  assert(0 && "Model is not savable.");
+  return false;
+#endif
+}
+
+void VerilatorSimCtrl::CallOnClock() {
+  if (!stats_interval_) {
+    for (auto it = extension_array_.begin(); it != extension_array_.end();
+         ++it) {
+      (*it)->OnClock(time_);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < extension_array_.size(); ++i) {
+    auto start = std::chrono::steady_clock::now();
+    extension_array_[i]->OnClock(time_);
+    ext_on_clock_time_[i] += std::chrono::steady_clock::now() - start;
+  }
+}
+
+bool VerilatorSimCtrl::OpenStatsFile() {
+  if (!stats_interval_) {
+    return true;
+  }
+
+  ext_on_clock_time_.assign(extension_array_.size(),
+                            std::chrono::steady_clock::duration::zero());
+
+  stats_file_.open(stats_file_path_, std::ios::out | std::ios::trunc);
+  if (!stats_file_) {
+    std::cerr << "ERROR: Could not open statistics file `" << stats_file_path_
+              << "'." << std::endl;
+    return false;
+  }
+
+  std::cout << "Writing statistics every " << stats_interval_
+            << " cycles to " << stats_file_path_ << "." << std::endl;
+  return true;
+}
+
+void VerilatorSimCtrl::ReportStats(bool final) {
+  auto now = std::chrono::steady_clock::now();
+  auto to_s = [](std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  };
+
+  double wall_s = to_s(now - time_begin_);
+  double interval_wall_s = to_s(now - stats_last_wall_);
+  unsigned long cycle = time_ / 2;
+  unsigned long interval_cycles = (time_ - stats_last_time_) / 2;
+
+  int trace_size_byte = 0;
+  if (tracing_enabled_) {
+    FileSize(GetTraceFileName(), trace_size_byte);
+  }
+
+  stats_file_ << "{\"cycle\": " << cycle << ", \"wall_s\": " << wall_s
+              << ", \"cycles_per_s\": " << (wall_s > 0 ? cycle / wall_s : 0)
+              << ", \"interval_cycles_per_s\": "
+              << (interval_wall_s > 0 ? interval_cycles / interval_wall_s : 0)
+              << ", \"trace_bytes\": " << trace_size_byte
+              << ", \"ext_on_clock_s\": [";
+  for (size_t i = 0; i < ext_on_clock_time_.size(); ++i) {
+    stats_file_ << (i ? ", " : "") << to_s(ext_on_clock_time_[i]);
+  }
+  stats_file_ << "], \"final\": " << (final ? "true" : "false") << "}"
+              << std::endl;
+
+  stats_last_time_ = time_;
+  stats_last_wall_ = now;
+}
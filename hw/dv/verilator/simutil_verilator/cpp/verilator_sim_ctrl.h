@@ -5,7 +5,9 @@
 #ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_CTRL_H_
 #define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_CTRL_H_
 
+#include <atomic>
 #include <chrono>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -108,9 +110,23 @@ class VerilatorSimCtrl {
 
   /**
    * Request the simulation to stop
+   *
+   * This may be called from any thread (including a Verilator worker thread,
+   * from DPI code running inside eval()) and from a signal handler. The stop
+   * takes effect after the current call to eval() returns.
    */
   void RequestStop(bool simulation_success);
 
+  /**
+   * Start tracing in response to an event in the design
+   *
+   * This is called by the simutil_verilator_trace_trigger() DPI function. It
+   * has the same effect as sending SIGUSR1 when tracing is off, except that
+   * it never turns tracing off. If tracing support isn't compiled into the
+   * simulation, it does nothing.
+   */
+  void TraceTrigger();
+
   /**
    * Register an extension to be called automatically
    */
@@ -134,12 +150,36 @@ class VerilatorSimCtrl {
   bool tracing_possible_;
   unsigned int initial_reset_delay_cycles_;
   unsigned int reset_duration_cycles_;
-  volatile unsigned int request_stop_;
-  volatile bool simulation_success_;
+  std::atomic<bool> request_stop_;
+  std::atomic<bool> simulation_success_;
   std::chrono::steady_clock::time_point time_begin_;
   std::chrono::steady_clock::time_point time_end_;
   VerilatedTracer tracer_;
   unsigned long term_after_cycles_;
+  unsigned long sim_threads_;
+  // Trace window: if nonzero, turn tracing on/off at this cycle
+  unsigned long trace_start_cycle_;
+  unsigned long trace_stop_cycle_;
+  // Ring-buffer tracing: if nonzero, alternate between two trace files, each
+  // covering this many cycles.
+  unsigned long trace_ring_cycles_;
+  unsigned int trace_ring_idx_;
+  unsigned long trace_ring_seg_start_;
+  // Checkpointing: save to checkpoint_save_path_ at checkpoint_cycle_ and/or
+  // restore from checkpoint_restore_path_ at the start of the simulation.
+  std::string checkpoint_save_path_;
+  std::string checkpoint_restore_path_;
+  unsigned long checkpoint_cycle_;
+  // Periodic statistics: if stats_interval_ is nonzero, write a report to
+  // stats_file_ every stats_interval_ cycles.
+  unsigned long stats_interval_;
+  std::string stats_file_path_;
+  std::ofstream stats_file_;
+  unsigned long stats_last_time_;
+  std::chrono::steady_clock::time_point stats_last_wall_;
+  // Time spent in each extension's OnClock (only measured if stats_interval_
+  // is nonzero).
+  std::vector<std::chrono::steady_clock::duration> ext_on_clock_time_;
   std::vector<SimCtrlExtension *> extension_array_;
 
   /**
@@ -200,6 +240,19 @@ class VerilatorSimCtrl {
    */
   bool TracingPossible() const { return tracing_possible_; }
 
+  /**
+   * Get the number of threads that the Verilated model uses to evaluate
+   * the design. This is 1 unless the model was Verilated with --threads.
+   */
+  unsigned int GetModelThreads() const;
+
+  /**
+   * Check that the model has the thread count requested with --sim-threads
+   *
+   * @return true if there was no request or the thread count matches
+   */
+  bool CheckSimThreads() const;
+
   /**
    * Print statistics about the simulation run
    */
@@ -248,6 +301,76 @@ class VerilatorSimCtrl {
    * Perform tracing in Verilator if required
    */
   void Trace();
+
+  /**
+   * Call OnClock for each registered extension, measuring the time spent in
+   * each if periodic statistics are enabled
+   */
+  void CallOnClock();
+
+  /**
+   * Open stats_file_ (if periodic statistics are enabled)
+   *
+   * @return true on success
+   */
+  bool OpenStatsFile();
+
+  /**
+   * Write a line of statistics to stats_file_
+   *
+   * Each line is a JSON object, giving the current cycle, the wall clock time
+   * since the start of the simulation, the simulation speed over the last
+   * interval and overall, the size of the trace file and the total time spent
+   * in each extension's OnClock.
+   */
+  void ReportStats(bool final);
+
+  /**
+   * Save a checkpoint of the simulation to checkpoint_save_path_
+   *
+   * The checkpoint contains the state of the model, the current time and the
+   * state of each registered extension (see SimCtrlExtension::SaveState).
+   * This must be called between calls to eval().
+   *
+   * @return true on success
+   */
+  bool SaveCheckpoint();
+
+  /**
+   * Restore a checkpoint from checkpoint_restore_path_
+   *
+   * This must be called before the first call to eval(). The same extensions
+   * must be registered (in the same order) as when the checkpoint was saved.
+   *
+   * @return true on success
+   */
+  bool RestoreCheckpoint();
+
+  /**
+   * Turn tracing on or off if we have reached the start or end of the trace
+   * window set with --trace-start / --trace-stop
+   */
+  void UpdateTraceWindow(unsigned long cycle);
+
+  /**
+   * In ring-buffer mode, switch to the other trace file if the current one
+   * covers trace_ring_cycles_ cycles.
+   */
+  void RotateTraceRing(unsigned long cycle);
+
+  /**
+   * Get the name of one of the two trace files used in ring-buffer mode
+   *
+   * This is the name of the trace file with ".0" or ".1" inserted before the
+   * extension.
+   */
+  std::string GetTraceRingFileName(unsigned int idx) const;
+
+  /**
+   * At the end of a simulation in ring-buffer mode, delete the trace files if
+   * the simulation passed or print their names if it failed.
+   */
+  void FinishTraceRing();
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_CTRL_H_
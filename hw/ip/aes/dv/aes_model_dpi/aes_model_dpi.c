@@ -13,6 +13,115 @@
 #include "crypto.h"
 #include "svdpi.h"
 
+// Key schedule of the most recently used key, so that the C model does not
+// repeat the key expansion for consecutive calls with the same key.
+static aes_key_sched_t key_sched;
+static unsigned char key_sched_key[32];
+static int key_sched_valid = 0;
+
+// Return the key schedule for the given key, expanding it if required.
+static const aes_key_sched_t *aes_key_sched_get(const unsigned char *key,
+                                                int key_len) {
+  if (!key_sched_valid || key_sched.key_len != key_len ||
+      memcmp(key_sched_key, key, key_len)) {
+    aes_key_sched_init(&key_sched, key, key_len);
+    memcpy(key_sched_key, key, key_len);
+    key_sched_valid = 1;
+  }
+  return &key_sched;
+}
+
+// Get packed data block from simulation into `data`; see aes_data_get().
+static void aes_data_load(const svBitVecVal *data_i, unsigned char *data) {
+  for (int i = 0; i < 4; i++) {
+    svBitVecVal value = data_i[i];
+    for (int j = 0; j < 4; j++) {
+      data[i + j * 4] = (unsigned char)(value >> (8 * j));
+    }
+  }
+}
+
+// Write packed data block to simulation; see aes_data_put().
+static void aes_data_store(svBitVecVal *data_o, const unsigned char *data) {
+  for (int i = 0; i < 4; i++) {
+    svBitVecVal value = 0;
+    for (int j = 0; j < 4; j++) {
+      value |= (svBitVecVal)((data[i + 4 * j]) << (8 * j));
+    }
+    data_o[i] = value;
+  }
+}
+
+// Get packed key from simulation into `key`; see aes_key_get().
+static void aes_key_load(const svBitVecVal *key_i, unsigned char *key) {
+  for (int i = 0; i < 8; i++) {
+    svBitVecVal value = key_i[i];
+    key[4 * i + 0] = (unsigned char)(value >> 0);
+    key[4 * i + 1] = (unsigned char)(value >> 8);
+    key[4 * i + 2] = (unsigned char)(value >> 16);
+    key[4 * i + 3] = (unsigned char)(value >> 24);
+  }
+}
+
+// Perform encryption/decryption of a message with the C model, which does ECB
+// only; the other modes are built on top of it here.
+static void aes_crypt_message_model(const aes_key_sched_t *sched,
+                                    unsigned char op, crypto_mode_t mode,
+                                    const unsigned char *iv,
+                                    const unsigned char *in, unsigned char *out,
+                                    int len) {
+  unsigned char chain[16];
+  unsigned char block[16];
+  memcpy(chain, iv, 16);
+
+  for (int off = 0; off < len; off += 16) {
+    const unsigned char *in_blk = &in[off];
+    unsigned char *out_blk = &out[off];
+    if (mode == kCryptoAesEcb) {
+      if (!op) {
+        aes_encrypt_block_sched(sched, in_blk, out_blk);
+      } else {
+        aes_decrypt_block_sched(sched, in_blk, out_blk);
+      }
+    } else if (mode == kCryptoAesCbc) {
+      if (!op) {
+        for (int i = 0; i < 16; ++i) {
+          block[i] = in_blk[i] ^ chain[i];
+        }
+        aes_encrypt_block_sched(sched, block, out_blk);
+        memcpy(chain, out_blk, 16);
+      } else {
+        aes_decrypt_block_sched(sched, in_blk, block);
+        for (int i = 0; i < 16; ++i) {
+          block[i] ^= chain[i];
+        }
+        memcpy(chain, in_blk, 16);
+        memcpy(out_blk, block, 16);
+      }
+    } else {
+      // CFB, OFB and CTR all XOR the input with an encrypted chaining value.
+      aes_encrypt_block_sched(sched, chain, block);
+      if (mode == kCryptoAesCfb) {
+        // The next chaining value is the cipher text.
+        memcpy(chain, op ? in_blk : block, 16);
+        if (!op) {
+          for (int i = 0; i < 16; ++i) {
+            chain[i] ^= in_blk[i];
+          }
+        }
+      } else if (mode == kCryptoAesOfb) {
+        memcpy(chain, block, 16);
+      } else {  // CTR: increment the 128-bit big-endian counter.
+        for (int i = 15; i >= 0 && !++chain[i]; --i) {
+        }
+      }
+      for (int i = 0; i < 16; ++i) {
+        out_blk[i] = block[i] ^ in_blk[i];
+      }
+    }
+  }
+}
+
 void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
                            const svBitVecVal *mode_i, const svBitVecVal *iv_i,
                            const svBitVecVal *key_len_i,
@@ -38,67 +147,21 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
   }
 
   // get input data from simulator
-  unsigned char *key = aes_key_get(key_i);
-  unsigned char *ref_in = aes_data_get(data_i);
+  unsigned char key[32];
+  unsigned char ref_in[16];
+  aes_key_load(key_i, key);
+  aes_data_load(data_i, ref_in);
 
   // Modes other than ECB require an IV from the simulator.
-  unsigned char *iv;
+  unsigned char iv[16] = {0};
   if (mode != kCryptoAesEcb) {
-    iv = aes_data_get(iv_i);
-  } else {
-    iv = (unsigned char *)calloc(16, sizeof(unsigned char));
-    assert(iv);
+    aes_data_load(iv_i, iv);
   }
 
-  // allocate memory
-  unsigned char *ref_out = (unsigned char *)malloc(16 * sizeof(unsigned char));
-  assert(ref_out);
-
+  unsigned char ref_out[16];
   if (impl == 0) {
-    // The C model does ECB only. We "emulate" other modes here.
-    unsigned char data_in[16];
-    unsigned char data_out[16];
-
-    if (mode == kCryptoAesCbc) {
-      if (!op) {
-        // data_in = ref_in XOR iv (or previous data_out)
-        for (int i = 0; i < 16; ++i) {
-          data_in[i] = ref_in[i] ^ iv[i];
-        }
-        aes_encrypt_block(data_in, key, key_len, ref_out);
-      } else {
-        aes_decrypt_block(ref_in, key, key_len, data_out);
-        // ref_out = data_out XOR iv (or previous data_out)
-        for (int i = 0; i < 16; ++i) {
-          ref_out[i] = data_out[i] ^ iv[i];
-        }
-      }
-    } else if (mode == kCryptoAesCfb || mode == kCryptoAesOfb) {
-      // data_in = iv
-      for (int i = 0; i < 16; ++i) {
-        data_in[i] = iv[i];
-      }
-      aes_encrypt_block(data_in, key, key_len, data_out);
-      // ref_out = data_out XOR ref_in
-      for (int i = 0; i < 16; ++i) {
-        ref_out[i] = data_out[i] ^ ref_in[i];
-      }
-    } else if (mode == kCryptoAesCtr) {
-      // data_in = counter value
-      for (int i = 0; i < 16; ++i) {
-        data_in[i] = iv[i];
-      }
-      aes_encrypt_block(data_in, key, key_len, data_out);
-      for (int i = 0; i < 16; ++i) {
-        ref_out[i] = data_out[i] ^ ref_in[i];
-      }
-    } else {  // ECB
-      if (!op) {
-        aes_encrypt_block(ref_in, key, key_len, ref_out);
-      } else {
-        aes_decrypt_block(ref_in, key, key_len, ref_out);
-      }
-    }
+    aes_crypt_message_model(aes_key_sched_get(key, key_len), op, mode, iv,
+                            ref_in, ref_out, 16);
   } else {  // OpenSSL/BoringSSL
     if (!op) {
       crypto_encrypt(ref_out, iv, ref_in, 16, key, key_len, mode);
@@ -107,13 +170,8 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
     }
   }
 
-  // write output data back to simulator, free ref_out
-  aes_data_put(data_o, ref_out);
-
-  // free memory
-  free(iv);
-  free(key);
-  free(ref_in);
+  // write output data back to simulator
+  aes_data_store(data_o, ref_out);
 
   return;
 }
@@ -144,20 +202,21 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
     key_len = 32;
   }
 
-  if (impl == 0) {
-    // The C model is currently not supported.
+  // Get message length.
+  int data_len = svSize(data_i, 1);
+  if ((int)data_len % 16) {
     printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
+        "ERROR: Message length must be a multiple of 16 bytes (the block "
+        "size).\n");
     return;
   }
 
   // Get key from simulator.
-  unsigned char *key = aes_key_get(key_i);
+  unsigned char key[32];
+  aes_key_load(key_i, key);
 
   // Modes other than ECB require an IV from the simulator.
-  unsigned char *iv = (unsigned char *)malloc(16 * sizeof(unsigned char));
-  assert(iv);
+  unsigned char iv[16] = {0};
   if (mode != kCryptoAesEcb) {
     // iv_i is a 1D array of words (4x32bit), but we need 16 bytes.
     svBitVecVal value;
@@ -168,13 +227,8 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
       iv[4 * i + 2] = (unsigned char)(value >> 16);
       iv[4 * i + 3] = (unsigned char)(value >> 24);
     }
-  } else {
-    memset(iv, 0, 16);
   }
 
-  // Get message length.
-  int data_len = svSize(data_i, 1);
-
   // Get input data from simulator.
   unsigned char *ref_in = aes_data_unpacked_get(data_i);
 
@@ -183,19 +237,9 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
       (unsigned char *)malloc(data_len * sizeof(unsigned char));
   assert(ref_out);
 
-  // OpenSSL/BoringSSL
-  if ((int)data_len % 16) {
-    printf(
-        "ERROR: Message length must be a multiple of 16 bytes (the block "
-        "size).\n");
-    return;
-  }
-
   if (impl == 0) {
-    // The C model is currently not supported.
-    printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
+    aes_crypt_message_model(aes_key_sched_get(key, key_len), op, mode, iv,
+                            ref_in, ref_out, data_len);
   } else {  // OpenSSL/BoringSSL
     if (!op) {
       crypto_encrypt(ref_out, iv, ref_in, data_len, key, key_len, mode);
@@ -208,8 +252,7 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
   aes_data_unpacked_put(data_o, ref_out);
 
   // Free memory.
-  free(iv);
-  free(key);
+  free(ref_in);
 }
 
 void c_dpi_aes_sub_bytes(const unsigned char op_i, const svBitVecVal *data_i,
@@ -41,7 +41,7 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
                            svBitVecVal *data_o);
 
 /**
- * Perform encryption/decryption of an entire message using OpenSSL/BoringSSL.
+ * Perform encryption/decryption of an entire message.
  *
  * @param  impl_i    Select reference impl.: 0 = C model, 1 = OpenSSL/BoringSSL
  * @param  op_i      Operation: 0 = encrypt, 1 = decrypt
@@ -121,6 +121,164 @@ int aes_decrypt_block(const unsigned char *cipher_text,
   return 0;
 }
 
+// Round lookup tables; te[0][x] holds the MixColumns column (2, 1, 1, 3) * S(x)
+// and td[0][x] the InvMixColumns column (14, 9, 13, 11) * InvS(x), each as a
+// big-endian word. Tables 1 to 3 are the same rotated right by 8, 16 and 24
+// bits.
+static uint32_t te[4][256];
+static uint32_t td[4][256];
+static int tables_ready = 0;
+
+// Multiply in GF(2^8).
+static unsigned char aes_mul(unsigned char a, unsigned char b);
+
+static uint32_t aes_ror32(uint32_t w, int n) {
+  return (w >> n) | (w << (32 - n));
+}
+
+static void aes_tables_init(void) {
+  for (int x = 0; x < 256; x++) {
+    unsigned char s = sbox[x];
+    unsigned char is = inv_sbox[x];
+    uint32_t e = ((uint32_t)aes_mul(s, 2) << 24) | ((uint32_t)s << 16) |
+                 ((uint32_t)s << 8) | aes_mul(s, 3);
+    uint32_t d = ((uint32_t)aes_mul(is, 14) << 24) |
+                 ((uint32_t)aes_mul(is, 9) << 16) |
+                 ((uint32_t)aes_mul(is, 13) << 8) | aes_mul(is, 11);
+    for (int t = 0; t < 4; t++) {
+      te[t][x] = t ? aes_ror32(e, 8 * t) : e;
+      td[t][x] = t ? aes_ror32(d, 8 * t) : d;
+    }
+  }
+  tables_ready = 1;
+}
+
+static uint32_t aes_load32(const unsigned char *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void aes_store32(unsigned char *p, uint32_t w) {
+  p[0] = (unsigned char)(w >> 24);
+  p[1] = (unsigned char)(w >> 16);
+  p[2] = (unsigned char)(w >> 8);
+  p[3] = (unsigned char)w;
+}
+
+static uint32_t aes_sub_word(uint32_t w) {
+  return ((uint32_t)sbox[w >> 24] << 24) |
+         ((uint32_t)sbox[(w >> 16) & 0xFF] << 16) |
+         ((uint32_t)sbox[(w >> 8) & 0xFF] << 8) | sbox[w & 0xFF];
+}
+
+int aes_key_sched_init(aes_key_sched_t *sched, const unsigned char *key,
+                       const int key_len) {
+  int num_rounds = aes_get_num_rounds(key_len);
+  if (num_rounds < 0) {
+    printf("ERROR: aes_get_num_rounds() failed\n");
+    return -EINVAL;
+  }
+  if (!tables_ready) {
+    aes_tables_init();
+  }
+  sched->key_len = key_len;
+  sched->num_rounds = num_rounds;
+
+  // Key expansion as specified in FIPS-197.
+  const int num_k = key_len / 4;
+  const int num_w = 4 * (num_rounds + 1);
+  uint32_t *w = sched->enc_rk;
+  unsigned char rcon = 0;
+  for (int i = 0; i < num_k; i++) {
+    w[i] = aes_load32(&key[4 * i]);
+  }
+  for (int i = num_k; i < num_w; i++) {
+    uint32_t temp = w[i - 1];
+    if (i % num_k == 0) {
+      aes_rcon_next(&rcon);
+      temp = aes_sub_word(aes_ror32(temp, 24)) ^ ((uint32_t)rcon << 24);
+    } else if (num_k > 6 && i % num_k == 4) {
+      temp = aes_sub_word(temp);
+    }
+    w[i] = w[i - num_k] ^ temp;
+  }
+
+  // The Equivalent Inverse Cipher uses the round keys in reverse order, with
+  // InvMixColumns applied to all but the first and last.
+  for (int r = 0; r <= num_rounds; r++) {
+    for (int c = 0; c < 4; c++) {
+      uint32_t k = w[4 * (num_rounds - r) + c];
+      if (r > 0 && r < num_rounds) {
+        k = td[0][sbox[k >> 24]] ^ td[1][sbox[(k >> 16) & 0xFF]] ^
+            td[2][sbox[(k >> 8) & 0xFF]] ^ td[3][sbox[k & 0xFF]];
+      }
+      sched->dec_rk[4 * r + c] = k;
+    }
+  }
+
+  return 0;
+}
+
+void aes_encrypt_block_sched(const aes_key_sched_t *sched,
+                             const unsigned char *plain_text,
+                             unsigned char *cipher_text) {
+  const uint32_t *rk = sched->enc_rk;
+  uint32_t s[4], t[4];
+  for (int c = 0; c < 4; c++) {
+    s[c] = aes_load32(&plain_text[4 * c]) ^ rk[c];
+  }
+  for (int r = 1; r < sched->num_rounds; r++) {
+    rk += 4;
+    for (int c = 0; c < 4; c++) {
+      t[c] = te[0][s[c] >> 24] ^ te[1][(s[(c + 1) & 3] >> 16) & 0xFF] ^
+             te[2][(s[(c + 2) & 3] >> 8) & 0xFF] ^
+             te[3][s[(c + 3) & 3] & 0xFF] ^ rk[c];
+    }
+    for (int c = 0; c < 4; c++) {
+      s[c] = t[c];
+    }
+  }
+  // Final round without MixColumns.
+  rk += 4;
+  for (int c = 0; c < 4; c++) {
+    t[c] = ((uint32_t)sbox[s[c] >> 24] << 24) |
+           ((uint32_t)sbox[(s[(c + 1) & 3] >> 16) & 0xFF] << 16) |
+           ((uint32_t)sbox[(s[(c + 2) & 3] >> 8) & 0xFF] << 8) |
+           sbox[s[(c + 3) & 3] & 0xFF];
+    aes_store32(&cipher_text[4 * c], t[c] ^ rk[c]);
+  }
+}
+
+void aes_decrypt_block_sched(const aes_key_sched_t *sched,
+                             const unsigned char *cipher_text,
+                             unsigned char *plain_text) {
+  const uint32_t *rk = sched->dec_rk;
+  uint32_t s[4], t[4];
+  for (int c = 0; c < 4; c++) {
+    s[c] = aes_load32(&cipher_text[4 * c]) ^ rk[c];
+  }
+  for (int r = 1; r < sched->num_rounds; r++) {
+    rk += 4;
+    for (int c = 0; c < 4; c++) {
+      t[c] = td[0][s[c] >> 24] ^ td[1][(s[(c + 3) & 3] >> 16) & 0xFF] ^
+             td[2][(s[(c + 2) & 3] >> 8) & 0xFF] ^
+             td[3][s[(c + 1) & 3] & 0xFF] ^ rk[c];
+    }
+    for (int c = 0; c < 4; c++) {
+      s[c] = t[c];
+    }
+  }
+  // Final round without InvMixColumns.
+  rk += 4;
+  for (int c = 0; c < 4; c++) {
+    t[c] = ((uint32_t)inv_sbox[s[c] >> 24] << 24) |
+           ((uint32_t)inv_sbox[(s[(c + 3) & 3] >> 16) & 0xFF] << 16) |
+           ((uint32_t)inv_sbox[(s[(c + 2) & 3] >> 8) & 0xFF] << 8) |
+           inv_sbox[s[(c + 1) & 3] & 0xFF];
+    aes_store32(&plain_text[4 * c], t[c] ^ rk[c]);
+  }
+}
+
 void aes_print_block(const unsigned char *data, const int num_bytes) {
   for (int i = 0; i < num_bytes; i++) {
     if ((i > 0) && (i % 8 == 0)) {
@@ -187,6 +345,19 @@ static unsigned char aes_mul4(unsigned char in) {
   return out;
 }
 
+static unsigned char aes_mul(unsigned char a, unsigned char b) {
+  unsigned char out = 0x0;
+  while (b) {
+    if (b & 0x1) {
+      out ^= a;
+    }
+    a = aes_mul2(a);
+    b >>= 1;
+  }
+
+  return out;
+}
+
 void aes_add_round_key(unsigned char *state, const unsigned char *round_key) {
   for (int i = 0; i < 16; i++) {
     state[i] ^= round_key[i];
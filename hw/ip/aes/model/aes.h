@@ -5,6 +5,8 @@
 #ifndef OPENTITAN_HW_IP_AES_MODEL_AES_H_
 #define OPENTITAN_HW_IP_AES_MODEL_AES_H_
 
+#include <stdint.h>
+
 /**
  * Encrypt one data block (16 Bytes) in ECB mode.
  *
@@ -30,6 +32,67 @@ int aes_decrypt_block(const unsigned char *cipher_text,
                       const unsigned char *key, const int key_len,
                       unsigned char *plain_text);
 
+/**
+ * Expanded key schedule for the table-based block functions below.
+ *
+ * Expanding the key once lets many blocks be processed under the same key
+ * without repeating the key expansion for every block.
+ */
+typedef struct aes_key_sched {
+  /**
+   * Key length in bytes (16, 24, 32).
+   */
+  int key_len;
+  /**
+   * Number of cipher rounds.
+   */
+  int num_rounds;
+  /**
+   * Encryption round keys, 4 big-endian words per round.
+   */
+  uint32_t enc_rk[60];
+  /**
+   * Decryption round keys for the Equivalent Inverse Cipher.
+   */
+  uint32_t dec_rk[60];
+} aes_key_sched_t;
+
+/**
+ * Expand a key for use with aes_encrypt_block_sched() and
+ * aes_decrypt_block_sched().
+ * @param  sched   Key schedule to initialize
+ * @param  key     Initial encryption key
+ * @param  key_len Key length in bytes (16, 24, 32)
+ * @return 0 on success, -ERRNO otherwise
+ */
+int aes_key_sched_init(aes_key_sched_t *sched, const unsigned char *key,
+                       const int key_len);
+
+/**
+ * Encrypt one data block (16 Bytes) in ECB mode using lookup tables that
+ * combine SubBytes, ShiftRows and MixColumns.
+ *
+ * Produces the same result as aes_encrypt_block() at a fraction of the cost.
+ * @param  sched       Expanded key schedule
+ * @param  plain_text  Input block to enrypt
+ * @param  cipher_text Encrypted output block
+ */
+void aes_encrypt_block_sched(const aes_key_sched_t *sched,
+                             const unsigned char *plain_text,
+                             unsigned char *cipher_text);
+
+/**
+ * Decrypt one data block (16 Bytes) in ECB mode using lookup tables.
+ *
+ * Produces the same result as aes_decrypt_block() at a fraction of the cost.
+ * @param  sched       Expanded key schedule
+ * @param  cipher_text Encrypted input block
+ * @param  plain_text  Decrypted output block
+ */
+void aes_decrypt_block_sched(const aes_key_sched_t *sched,
+                             const unsigned char *cipher_text,
+                             unsigned char *plain_text);
+
 /**
  * Print block of data in readable format to stdout
  *
@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "hmac.h"
 #include "hmac_wrap.h"
@@ -198,3 +199,110 @@ extern void c_dpi_HMAC_SHA512(const svOpenArrayHandle key, uint64_t key_len,
 
   free(key_arr);
 }
+
+// Persistent hash contexts, which allow the message to be supplied in pieces
+// as it becomes available rather than being re-hashed in its entirety for
+// every digest.
+typedef enum {
+  kCryptocDpiSha256 = 0,
+  kCryptocDpiSha384 = 1,
+  kCryptocDpiSha512 = 2,
+  kCryptocDpiHmacSha256 = 3,
+  kCryptocDpiHmacSha384 = 4,
+  kCryptocDpiHmacSha512 = 5,
+} cryptoc_dpi_alg_t;
+
+typedef struct cryptoc_dpi_ctx {
+  cryptoc_dpi_alg_t alg;
+  union {
+    HASH_CTX hash;
+    LITE_HMAC_CTX hmac_lite;
+    HMAC_CTX hmac;
+  } u;
+} cryptoc_dpi_ctx_t;
+
+extern void *c_dpi_hash_init(uint32_t alg, const svOpenArrayHandle key,
+                             uint64_t key_len) {
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)malloc(sizeof(*ctx));
+  assert(ctx);
+  ctx->alg = (cryptoc_dpi_alg_t)alg;
+
+  uint8_t *key_arr = NULL;
+  if (alg >= kCryptocDpiHmacSha256 && key_len > 0u) {
+    key_arr = collect_bytes(key, key_len);
+    assert(key_arr);
+  }
+
+  switch (alg) {
+    case kCryptocDpiSha256:
+      SHA256_init(&ctx->u.hash);
+      break;
+    case kCryptocDpiSha384:
+      SHA384_init(&ctx->u.hash);
+      break;
+    case kCryptocDpiSha512:
+      SHA512_init(&ctx->u.hash);
+      break;
+    case kCryptocDpiHmacSha256:
+      HMAC_SHA256_init(&ctx->u.hmac_lite, key_arr, key_len);
+      break;
+    case kCryptocDpiHmacSha384:
+      HMAC_SHA384_init(&ctx->u.hmac, key_arr, key_len);
+      break;
+    case kCryptocDpiHmacSha512:
+      HMAC_SHA512_init(&ctx->u.hmac, key_arr, key_len);
+      break;
+    default:
+      printf("ERROR: c_dpi_hash_init: unsupported algorithm %u\n", alg);
+      free(ctx);
+      ctx = NULL;
+      break;
+  }
+
+  free(key_arr);
+  return ctx;
+}
+
+extern void c_dpi_hash_update(void *handle, const svOpenArrayHandle msg,
+                              uint64_t msg_len) {
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)handle;
+  if (msg_len > 0u) {
+    uint8_t *arr = collect_bytes(msg, msg_len);
+    assert(arr);
+    // The HMAC contexts start with the inner hash context.
+    HASH_update(&ctx->u.hash, arr, msg_len);
+    free(arr);
+  }
+}
+
+extern void c_dpi_hash_final(void *handle, uint32_t digest[16]) {
+  // Finalize a copy, so that the message may be extended further.
+  cryptoc_dpi_ctx_t ctx = *(const cryptoc_dpi_ctx_t *)handle;
+  const uint8_t *result;
+  switch (ctx.alg) {
+    case kCryptocDpiHmacSha256:
+      result = HMAC_final_LITE(&ctx.u.hmac_lite);
+      break;
+    case kCryptocDpiHmacSha384:
+    case kCryptocDpiHmacSha512:
+      result = HMAC_final(&ctx.u.hmac);
+      break;
+    default:
+      result = HASH_final(&ctx.u.hash);
+      break;
+  }
+  memcpy(digest, result, HASH_size(&ctx.u.hash));
+}
+
+extern void *c_dpi_hash_save(void *handle) {
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)malloc(sizeof(*ctx));
+  assert(ctx);
+  *ctx = *(const cryptoc_dpi_ctx_t *)handle;
+  return ctx;
+}
+
+extern void c_dpi_hash_restore(void *handle, void *saved) {
+  *(cryptoc_dpi_ctx_t *)handle = *(const cryptoc_dpi_ctx_t *)saved;
+}
+
+extern void c_dpi_hash_free(void *handle) { free(handle); }
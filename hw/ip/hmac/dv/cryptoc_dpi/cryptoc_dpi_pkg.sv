@@ -54,6 +54,36 @@ package cryptoc_dpi_pkg;
                                                          input longint unsigned msg_len,
                                                          output int unsigned hmac[16]);
 
+  // Persistent hash contexts, allowing a message to be hashed incrementally as it is supplied.
+  // The digest may be read at any point without terminating the message; a context may also be
+  // saved into a new handle and later restored from it.
+  typedef enum int unsigned {
+    CryptocDpiSha256     = 0,
+    CryptocDpiSha384     = 1,
+    CryptocDpiSha512     = 2,
+    CryptocDpiHmacSha256 = 3,
+    CryptocDpiHmacSha384 = 4,
+    CryptocDpiHmacSha512 = 5
+  } cryptoc_dpi_alg_e;
+
+  import "DPI-C" context function chandle c_dpi_hash_init(input cryptoc_dpi_alg_e alg,
+                                                          input bit[7:0] key[],
+                                                          input longint unsigned key_len);
+
+  import "DPI-C" context function void c_dpi_hash_update(input chandle handle,
+                                                         input bit[7:0] msg[],
+                                                         input longint unsigned msg_len);
+
+  import "DPI-C" context function void c_dpi_hash_final(input chandle handle,
+                                                        output int unsigned digest[16]);
+
+  import "DPI-C" context function chandle c_dpi_hash_save(input chandle handle);
+
+  import "DPI-C" context function void c_dpi_hash_restore(input chandle handle,
+                                                          input chandle saved);
+
+  import "DPI-C" context function void c_dpi_hash_free(input chandle handle);
+
   // sv wrapper functions
   function automatic void sv_dpi_get_sha_digest(input bit[7:0] msg[],
                                                 output int unsigned hash[8]);
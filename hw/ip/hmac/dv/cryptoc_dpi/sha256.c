@@ -16,6 +16,12 @@
 #include <stdint.h>
 #include <string.h>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_NI_SUPPORT
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 #define ror(value, bits) (((value) >> (bits)) | ((value) << (32 - (bits))))
 #define shr(value, bits) ((value) >> (bits))
 
@@ -32,61 +38,150 @@ static const uint32_t K[64] = {
     0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
 
-static void SHA256_Transform(LITE_SHA256_CTX *ctx) {
-  uint32_t W[64];
-  uint32_t A, B, C, D, E, F, G, H;
-  uint8_t *p = ctx->buf;
-  int t;
-
-  for (t = 0; t < 16; ++t) {
-    uint32_t tmp = *p++ << 24;
-    tmp |= *p++ << 16;
-    tmp |= *p++ << 8;
-    tmp |= *p++;
-    W[t] = tmp;
+#define Ch(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define Maj(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define Sigma0(x) (ror(x, 2) ^ ror(x, 13) ^ ror(x, 22))
+#define Sigma1(x) (ror(x, 6) ^ ror(x, 11) ^ ror(x, 25))
+#define sigma0(x) (ror(x, 7) ^ ror(x, 18) ^ shr(x, 3))
+#define sigma1(x) (ror(x, 17) ^ ror(x, 19) ^ shr(x, 10))
+
+// One round, keeping only the last 16 words of the message schedule; the
+// working variables are renamed by the caller rather than shuffled.
+#define ROUND(a, b, c, d, e, f, g, h, t)                                   \
+  do {                                                                     \
+    if ((t) >= 16) {                                                       \
+      W[(t)&15] += sigma1(W[((t)-2) & 15]) + W[((t)-7) & 15] +             \
+                   sigma0(W[((t)-15) & 15]);                               \
+    }                                                                      \
+    uint32_t t1 = (h) + Sigma1(e) + Ch(e, f, g) + K[t] + W[(t)&15];        \
+    (d) += t1;                                                             \
+    (h) = t1 + Sigma0(a) + Maj(a, b, c);                                   \
+  } while (0)
+
+static void SHA256_Transform_Generic(uint32_t *state, const uint8_t *p,
+                                     size_t nblocks) {
+  for (; nblocks > 0; --nblocks, p += 64) {
+    uint32_t W[16];
+    uint32_t A, B, C, D, E, F, G, H;
+    int t;
+
+    for (t = 0; t < 16; ++t) {
+      W[t] = ((uint32_t)p[4 * t] << 24) | ((uint32_t)p[4 * t + 1] << 16) |
+             ((uint32_t)p[4 * t + 2] << 8) | p[4 * t + 3];
+    }
+
+    A = state[0];
+    B = state[1];
+    C = state[2];
+    D = state[3];
+    E = state[4];
+    F = state[5];
+    G = state[6];
+    H = state[7];
+
+    for (t = 0; t < 64; t += 8) {
+      ROUND(A, B, C, D, E, F, G, H, t + 0);
+      ROUND(H, A, B, C, D, E, F, G, t + 1);
+      ROUND(G, H, A, B, C, D, E, F, t + 2);
+      ROUND(F, G, H, A, B, C, D, E, t + 3);
+      ROUND(E, F, G, H, A, B, C, D, t + 4);
+      ROUND(D, E, F, G, H, A, B, C, t + 5);
+      ROUND(C, D, E, F, G, H, A, B, t + 6);
+      ROUND(B, C, D, E, F, G, H, A, t + 7);
+    }
+
+    state[0] += A;
+    state[1] += B;
+    state[2] += C;
+    state[3] += D;
+    state[4] += E;
+    state[5] += F;
+    state[6] += G;
+    state[7] += H;
   }
+}
 
-  for (; t < 64; t++) {
-    uint32_t s0 = ror(W[t - 15], 7) ^ ror(W[t - 15], 18) ^ shr(W[t - 15], 3);
-    uint32_t s1 = ror(W[t - 2], 17) ^ ror(W[t - 2], 19) ^ shr(W[t - 2], 10);
-    W[t] = W[t - 16] + s0 + W[t - 7] + s1;
+#ifdef SHA256_NI_SUPPORT
+// Compression function using the x86 SHA extensions.
+__attribute__((target("sha,sse4.1"))) static void SHA256_Transform_NI(
+    uint32_t *state, const uint8_t *p, size_t nblocks) {
+  const __m128i kMask =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i M[4];
+  __m128i tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+  __m128i state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+
+  // Rearrange the state words into the ABEF/CDGH order that the instructions
+  // operate upon.
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);
+  state1 = _mm_shuffle_epi32(state1, 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  for (; nblocks > 0; --nblocks, p += 64) {
+    const __m128i abef = state0;
+    const __m128i cdgh = state1;
+    for (int g = 0; g < 16; ++g) {
+      if (g < 4) {
+        M[g] = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *)&p[16 * g]), kMask);
+      } else {
+        __m128i x = _mm_sha256msg1_epu32(M[g & 3], M[(g + 1) & 3]);
+        x = _mm_add_epi32(
+            x, _mm_alignr_epi8(M[(g + 3) & 3], M[(g + 2) & 3], 4));
+        M[g & 3] = _mm_sha256msg2_epu32(x, M[(g + 3) & 3]);
+      }
+      __m128i msg =
+          _mm_add_epi32(M[g & 3], _mm_loadu_si128((const __m128i *)&K[4 * g]));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    }
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
   }
 
-  A = ctx->state[0];
-  B = ctx->state[1];
-  C = ctx->state[2];
-  D = ctx->state[3];
-  E = ctx->state[4];
-  F = ctx->state[5];
-  G = ctx->state[6];
-  H = ctx->state[7];
-
-  for (t = 0; t < 64; t++) {
-    uint32_t s0 = ror(A, 2) ^ ror(A, 13) ^ ror(A, 22);
-    uint32_t maj = (A & B) ^ (A & C) ^ (B & C);
-    uint32_t t2 = s0 + maj;
-    uint32_t s1 = ror(E, 6) ^ ror(E, 11) ^ ror(E, 25);
-    uint32_t ch = (E & F) ^ ((~E) & G);
-    uint32_t t1 = H + s1 + ch + K[t] + W[t];
-
-    H = G;
-    G = F;
-    F = E;
-    E = D + t1;
-    D = C;
-    C = B;
-    B = A;
-    A = t1 + t2;
+  // Restore the natural order of the state words.
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128((__m128i *)&state[0], state0);
+  _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+static int SHA256_NI_available(void) {
+  static int available = -1;
+  if (available < 0) {
+    unsigned int eax, ebx, ecx, edx;
+    available = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_1) &&
+                __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+                (ebx & bit_SHA);
   }
+  return available;
+}
+#endif  // SHA256_NI_SUPPORT
 
-  ctx->state[0] += A;
-  ctx->state[1] += B;
-  ctx->state[2] += C;
-  ctx->state[3] += D;
-  ctx->state[4] += E;
-  ctx->state[5] += F;
-  ctx->state[6] += G;
-  ctx->state[7] += H;
+// Process `nblocks` 64-byte blocks starting at `p`.
+static void SHA256_Transform(LITE_SHA256_CTX *ctx, const uint8_t *p,
+                             size_t nblocks) {
+  uint32_t state[8];
+  int i;
+
+  for (i = 0; i < 8; i++) {
+    state[i] = (uint32_t)ctx->state[i];
+  }
+#ifdef SHA256_NI_SUPPORT
+  if (SHA256_NI_available()) {
+    SHA256_Transform_NI(state, p, nblocks);
+  } else
+#endif
+  {
+    SHA256_Transform_Generic(state, p, nblocks);
+  }
+  for (i = 0; i < 8; i++) {
+    ctx->state[i] = state[i];
+  }
 }
 
 static const HASH_VTAB SHA256_VTAB = {SHA256_init, SHA256_update, SHA256_final,
@@ -106,18 +201,32 @@ void SHA256_init(LITE_SHA256_CTX *ctx) {
 }
 
 void SHA256_update(LITE_SHA256_CTX *ctx, const void *data, size_t len) {
-  int i = (int)(ctx->count & 63);
+  size_t i = (size_t)(ctx->count & 63);
   const uint8_t *p = (const uint8_t *)data;
 
   ctx->count += len;
 
-  while (len--) {
-    ctx->buf[i++] = *p++;
-    if (i == 64) {
-      SHA256_Transform(ctx);
-      i = 0;
+  // Complete any partially filled block.
+  if (i) {
+    size_t fill = 64 - i;
+    if (len < fill) {
+      memcpy(&ctx->buf[i], p, len);
+      return;
     }
+    memcpy(&ctx->buf[i], p, fill);
+    SHA256_Transform(ctx, ctx->buf, 1);
+    p += fill;
+    len -= fill;
   }
+
+  // Process whole blocks directly from the input.
+  if (len >= 64) {
+    SHA256_Transform(ctx, p, len / 64);
+    p += len & ~(size_t)63;
+    len &= 63;
+  }
+
+  memcpy(ctx->buf, p, len);
 }
 
 const uint8_t *SHA256_final(LITE_SHA256_CTX *ctx) {
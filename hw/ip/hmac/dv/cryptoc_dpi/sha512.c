@@ -52,71 +52,71 @@ static const uint64_t K[80] = {
     0x431D67C49C100D4Cll, 0x4CC5D4BECB3E42B6ll, 0x597F299CFC657E2All,
     0x5FCB6FAB3AD6FAECll, 0x6C44198C4A475817ll};
 
-static void SHA512_Transform(LITE_SHA512_CTX *ctx) {
-  uint64_t W[80];
-  uint64_t A, B, C, D, E, F, G, H;
-  uint8_t *p = ctx->buf;
-  int t;
-
-  for (t = 0; t < 16; t++) {
-    uint64_t tmp = (uint64_t)(*p++) << 56;
-    tmp |= (uint64_t)(*p++) << 48;
-    tmp |= (uint64_t)(*p++) << 40;
-    tmp |= (uint64_t)(*p++) << 32;
-    tmp |= (uint64_t)(*p++) << 24;
-    tmp |= (uint64_t)(*p++) << 16;
-    tmp |= (uint64_t)(*p++) << 8;
-    tmp |= (uint64_t)(*p++);
-    W[t] = tmp;
-  }
-
-  for (; t < 80; t++) {
-    uint64_t Wt2 = W[t - 2];
-    uint64_t Wt7 = W[t - 7];
-    uint64_t Wt15 = W[t - 15];
-    uint64_t Wt16 = W[t - 16];
-
-    uint64_t s0 = ror(Wt15, 1) ^ ror(Wt15, 8) ^ shr(Wt15, 7);
-    uint64_t s1 = ror(Wt2, 19) ^ ror(Wt2, 61) ^ shr(Wt2, 6);
+#define Ch(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define Maj(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define Sigma0(x) (ror(x, 28) ^ ror(x, 34) ^ ror(x, 39))
+#define Sigma1(x) (ror(x, 14) ^ ror(x, 18) ^ ror(x, 41))
+#define sigma0(x) (ror(x, 1) ^ ror(x, 8) ^ shr(x, 7))
+#define sigma1(x) (ror(x, 19) ^ ror(x, 61) ^ shr(x, 6))
+
+// One round, keeping only the last 16 words of the message schedule; the
+// working variables are renamed by the caller rather than shuffled.
+#define ROUND(a, b, c, d, e, f, g, h, t)                                   \
+  do {                                                                     \
+    if ((t) >= 16) {                                                       \
+      W[(t)&15] += sigma1(W[((t)-2) & 15]) + W[((t)-7) & 15] +             \
+                   sigma0(W[((t)-15) & 15]);                               \
+    }                                                                      \
+    uint64_t t1 = (h) + Sigma1(e) + Ch(e, f, g) + K[t] + W[(t)&15];        \
+    (d) += t1;                                                             \
+    (h) = t1 + Sigma0(a) + Maj(a, b, c);                                   \
+  } while (0)
+
+// Process `nblocks` 128-byte blocks starting at `p`.
+static void SHA512_Transform(LITE_SHA512_CTX *ctx, const uint8_t *p,
+                             size_t nblocks) {
+  for (; nblocks > 0; --nblocks, p += 128) {
+    uint64_t W[16];
+    uint64_t A, B, C, D, E, F, G, H;
+    int t;
+
+    for (t = 0; t < 16; t++) {
+      const uint8_t *q = &p[8 * t];
+      W[t] = ((uint64_t)q[0] << 56) | ((uint64_t)q[1] << 48) |
+             ((uint64_t)q[2] << 40) | ((uint64_t)q[3] << 32) |
+             ((uint64_t)q[4] << 24) | ((uint64_t)q[5] << 16) |
+             ((uint64_t)q[6] << 8) | q[7];
+    }
 
-    W[t] = s1 + Wt7 + s0 + Wt16;
-  }
+    A = ctx->state[0];
+    B = ctx->state[1];
+    C = ctx->state[2];
+    D = ctx->state[3];
+    E = ctx->state[4];
+    F = ctx->state[5];
+    G = ctx->state[6];
+    H = ctx->state[7];
+
+    for (t = 0; t < 80; t += 8) {
+      ROUND(A, B, C, D, E, F, G, H, t + 0);
+      ROUND(H, A, B, C, D, E, F, G, t + 1);
+      ROUND(G, H, A, B, C, D, E, F, t + 2);
+      ROUND(F, G, H, A, B, C, D, E, t + 3);
+      ROUND(E, F, G, H, A, B, C, D, t + 4);
+      ROUND(D, E, F, G, H, A, B, C, t + 5);
+      ROUND(C, D, E, F, G, H, A, B, t + 6);
+      ROUND(B, C, D, E, F, G, H, A, t + 7);
+    }
 
-  A = ctx->state[0];
-  B = ctx->state[1];
-  C = ctx->state[2];
-  D = ctx->state[3];
-  E = ctx->state[4];
-  F = ctx->state[5];
-  G = ctx->state[6];
-  H = ctx->state[7];
-
-  for (t = 0; t < 80; t++) {
-    uint64_t s0 = ror(A, 28) ^ ror(A, 34) ^ ror(A, 39);
-    uint64_t maj = (A & B) ^ (A & C) ^ (B & C);
-    uint64_t t2 = s0 + maj;
-    uint64_t s1 = ror(E, 14) ^ ror(E, 18) ^ ror(E, 41);
-    uint64_t ch = (E & F) ^ ((~E) & G);
-    uint64_t t1 = H + s1 + ch + K[t] + W[t];
-
-    H = G;
-    G = F;
-    F = E;
-    E = D + t1;
-    D = C;
-    C = B;
-    B = A;
-    A = t1 + t2;
+    ctx->state[0] += A;
+    ctx->state[1] += B;
+    ctx->state[2] += C;
+    ctx->state[3] += D;
+    ctx->state[4] += E;
+    ctx->state[5] += F;
+    ctx->state[6] += G;
+    ctx->state[7] += H;
   }
-
-  ctx->state[0] += A;
-  ctx->state[1] += B;
-  ctx->state[2] += C;
-  ctx->state[3] += D;
-  ctx->state[4] += E;
-  ctx->state[5] += F;
-  ctx->state[6] += G;
-  ctx->state[7] += H;
 }
 
 static const HASH_VTAB SHA512_VTAB = {SHA512_init, SHA512_update, SHA512_final,
@@ -136,18 +136,32 @@ void SHA512_init(LITE_SHA512_CTX *ctx) {
 }
 
 void SHA512_update(LITE_SHA512_CTX *ctx, const void *data, size_t len) {
-  int i = (int)(ctx->count & 127);
+  size_t i = (size_t)(ctx->count & 127);
   const uint8_t *p = (const uint8_t *)data;
 
   ctx->count += len;
 
-  while (len--) {
-    ctx->buf[i++] = *p++;
-    if (i == 128) {
-      SHA512_Transform(ctx);
-      i = 0;
+  // Complete any partially filled block.
+  if (i) {
+    size_t fill = 128 - i;
+    if (len < fill) {
+      memcpy(&ctx->buf[i], p, len);
+      return;
     }
+    memcpy(&ctx->buf[i], p, fill);
+    SHA512_Transform(ctx, ctx->buf, 1);
+    p += fill;
+    len -= fill;
   }
+
+  // Process whole blocks directly from the input.
+  if (len >= 128) {
+    SHA512_Transform(ctx, p, len / 128);
+    p += len & ~(size_t)127;
+    len &= 127;
+  }
+
+  memcpy(ctx->buf, p, len);
 }
 
 const uint8_t *SHA512_final(LITE_SHA512_CTX *ctx) {
@@ -7,43 +7,189 @@
 #include <cstdlib>
 #include <cstring>
 #include <list>
+#include <type_traits>
+#include <vector>
 
 #include "svdpi.h"
 #include "vendor/kerukuro_digestpp/algorithm/kmac.hpp"
 #include "vendor/kerukuro_digestpp/algorithm/sha3.hpp"
 #include "vendor/kerukuro_digestpp/algorithm/shake.hpp"
 
-extern "C" {
+namespace {
 
-//////////////////////
-// HELPER FUNCTIONS //
-//////////////////////
+/**
+ * Contiguous C view of the first `len` bytes of an SV byte array.
+ *
+ * When the simulator stores the array with one byte per element the view
+ * refers directly to the simulator memory; otherwise the elements are gathered
+ * into a local copy, using the C layout when it is available and the
+ * element-wise accessors as a fallback.
+ */
+class ArrayView {
+ public:
+  ArrayView(const svOpenArrayHandle arr, uint64_t len) : data_(nullptr) {
+    // Note: the dimensions of an empty open array cannot be queried reliably.
+    if (!len) {
+      return;
+    }
+    const void *ptr = svGetArrayPtr(arr);
+    if (ptr && svLeft(arr, 1) == svLow(arr, 1) &&
+        (uint64_t)svSizeOfArray(arr) == (uint64_t)svSize(arr, 1)) {
+      data_ = (const uint8_t *)ptr;
+      return;
+    }
+    copy_.resize(len);
+    if (ptr && svLeft(arr, 1) == svLow(arr, 1) &&
+        (uint64_t)svSizeOfArray(arr) ==
+            (uint64_t)svSize(arr, 1) * sizeof(svBitVecVal)) {
+      // C-style layout with one canonical vector per element.
+      const svBitVecVal *elems = (const svBitVecVal *)ptr;
+      for (uint64_t i = 0; i < len; i++) {
+        copy_[i] = (uint8_t)elems[i];
+      }
+    } else {
+      for (uint64_t i = 0; i < len; i++) {
+        svBitVecVal val;
+        svGetBitArrElem1VecVal(&val, arr, i);
+        copy_[i] = (uint8_t)val;
+      }
+    }
+    data_ = copy_.data();
+  }
+
+  const uint8_t *data() const { return data_; }
+
+ private:
+  const uint8_t *data_;
+  std::vector<uint8_t> copy_;
+};
 
 /**
- * Generic function to load an unsized array from SV memory into C memory.
+ * Hasher that may absorb a message in any number of chunks.
  */
-static void load_arr_from_simulator(const svOpenArrayHandle arr,
-                                    uint8_t *array_out, uint64_t array_len) {
-  for (uint64_t i = 0; i < array_len; i++) {
-    svBitVecVal val;
-    svGetBitArrElem1VecVal(&val, arr, i);
-    array_out[i] = (uint8_t)val;
+class DigestppHasher {
+ public:
+  virtual ~DigestppHasher() = default;
+  virtual void Absorb(const uint8_t *data, size_t len) = 0;
+  /**
+   * Produces `len` bytes of output for the message absorbed so far, without
+   * disturbing the state of the hasher.
+   */
+  virtual void Digest(uint8_t *out, size_t len) const = 0;
+};
+
+template <typename H, bool kXof>
+class DigestppHasherImpl : public DigestppHasher {
+ public:
+  explicit DigestppHasherImpl(const H &hasher) : hasher_(hasher) {}
+  void Absorb(const uint8_t *data, size_t len) override {
+    hasher_.absorb(data, len);
   }
+  void Digest(uint8_t *out, size_t len) const override {
+    Finish(out, len, std::integral_constant<bool, kXof>());
+  }
+
+ private:
+  void Finish(uint8_t *out, size_t len, std::false_type) const {
+    hasher_.digest(out, len);
+  }
+  void Finish(uint8_t *out, size_t len, std::true_type) const {
+    // Squeezing advances the sponge, so work on a copy.
+    H copy(hasher_);
+    copy.squeeze(out, len);
+  }
+
+  H hasher_;
+};
+
+template <typename H>
+H make_cshake(const char *function_name, const char *customization_str) {
+  H shake;
+  shake.set_function_name(function_name, strlen(function_name));
+  shake.set_customization(customization_str, strlen(customization_str));
+  return shake;
+}
+
+template <typename H>
+H make_kmac(H kmac, const svOpenArrayHandle key, uint64_t key_len,
+                   const char *customization_str) {
+  ArrayView key_arr(key, key_len);
+  kmac.set_customization(customization_str, strlen(customization_str));
+  kmac.set_key(key_arr.data(), key_len);
+  return kmac;
 }
 
+/**
+ * Algorithms supported by the incremental hashing API; must match
+ * `digestpp_dpi_pkg::digestpp_alg_e`.
+ */
+enum DigestppAlg {
+  kDigestppSha3_224 = 0,
+  kDigestppSha3_256 = 1,
+  kDigestppSha3_384 = 2,
+  kDigestppSha3_512 = 3,
+  kDigestppShake128 = 4,
+  kDigestppShake256 = 5,
+  kDigestppCShake128 = 6,
+  kDigestppCShake256 = 7,
+  kDigestppKmac128 = 8,
+  kDigestppKmac128Xof = 9,
+  kDigestppKmac256 = 10,
+  kDigestppKmac256Xof = 11,
+};
+
+}  // namespace
+
+extern "C" {
+
+//////////////////////
+// HELPER FUNCTIONS //
+//////////////////////
+
 /**
  * Generic function to write an unsized array from C memory into SV memory.
  */
 static void write_array_to_simulator(const svOpenArrayHandle arr,
-                                     uint8_t *data) {
+                                     const uint8_t *data, uint64_t data_len) {
   uint64_t arr_len = svSize(arr, 1);
+  if (arr_len > data_len) {
+    arr_len = data_len;
+  }
 
+  void *ptr = svGetArrayPtr(arr);
+  if (ptr && svLeft(arr, 1) == svLow(arr, 1) &&
+      (uint64_t)svSizeOfArray(arr) == (uint64_t)svSize(arr, 1)) {
+    memcpy(ptr, data, arr_len);
+    return;
+  }
   for (uint64_t i = 0; i < arr_len; ++i) {
     svBitVecVal data_val = (svBitVecVal)data[i];
     svPutBitArrElem1VecVal(arr, &data_val, i);
   }
 }
 
+/**
+ * Helper function to absorb a message from SV memory into a hasher.
+ */
+static void absorb_from_simulator(DigestppHasher *hasher,
+                                  const svOpenArrayHandle msg,
+                                  uint64_t msg_len) {
+  ArrayView msg_arr(msg, msg_len);
+  hasher->Absorb(msg_arr.data(), msg_len);
+}
+/**
+ * Helper function to compute a digest of `output_len` bytes over a complete
+ * message and return it to SV code.
+ */
+static void get_digest(DigestppHasher &&hasher, const svOpenArrayHandle msg,
+                       uint64_t msg_len, uint64_t output_len,
+                       svOpenArrayHandle digest) {
+  std::vector<uint8_t> digest_arr(output_len);
+  absorb_from_simulator(&hasher, msg, msg_len);
+  hasher.Digest(digest_arr.data(), digest_arr.size());
+  write_array_to_simulator(digest, digest_arr.data(), digest_arr.size());
+}
+
 /**
  * Helper function to calculate generic length SHA3 algorithm.
  *
@@ -53,26 +199,8 @@ static void write_array_to_simulator(const svOpenArrayHandle arr,
  */
 static void get_sha3_digest(uint64_t sha_len, const svOpenArrayHandle msg,
                             uint64_t msg_len, svOpenArrayHandle digest) {
-  // Number of bytes in result digest
-  uint64_t digest_len = sha_len / 8;
-
-  uint8_t digest_arr[digest_len];
-
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  // Compute the digest
-  digestpp::sha3 sha3(sha_len);
-  sha3.absorb(msg_arr, msg_len);
-  sha3.digest(digest_arr, sizeof(digest_arr));
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  // Return the digest array so that SV can access it
-  write_array_to_simulator(digest, digest_arr);
+  get_digest(DigestppHasherImpl<digestpp::sha3, false>(digestpp::sha3(sha_len)),
+             msg, msg_len, sha_len / 8, digest);
 }
 
 //////////////
@@ -112,23 +240,8 @@ extern void c_dpi_sha3_512(const svOpenArrayHandle msg, uint64_t msg_len,
 //////////////
 extern void c_dpi_shake128(const svOpenArrayHandle msg, uint64_t msg_len,
                            uint64_t output_len, svOpenArrayHandle digest) {
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  uint8_t digest_arr[output_len];
-
-  // Compute the digest
-  digestpp::shake128 shake;
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+  get_digest(DigestppHasherImpl<digestpp::shake128, true>(digestpp::shake128()),
+             msg, msg_len, output_len, digest);
 }
 
 //////////////
@@ -136,23 +249,8 @@ extern void c_dpi_shake128(const svOpenArrayHandle msg, uint64_t msg_len,
 //////////////
 extern void c_dpi_shake256(const svOpenArrayHandle msg, uint64_t msg_len,
                            uint64_t output_len, svOpenArrayHandle digest) {
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  uint8_t digest_arr[output_len];
-
-  // Compute the digest
-  digestpp::shake256 shake;
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+  get_digest(DigestppHasherImpl<digestpp::shake256, true>(digestpp::shake256()),
+             msg, msg_len, output_len, digest);
 }
 
 ///////////////
@@ -162,25 +260,10 @@ extern void c_dpi_cshake128(const svOpenArrayHandle msg,
                             const char *function_name,
                             const char *customization_str, uint64_t msg_len,
                             uint64_t output_len, svOpenArrayHandle digest) {
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  uint8_t digest_arr[output_len];
-
-  // Compute the digest
-  digestpp::cshake128 shake;
-  shake.set_function_name(function_name, strlen(function_name));
-  shake.set_customization(customization_str, strlen(customization_str));
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+  get_digest(DigestppHasherImpl<digestpp::cshake128, true>(
+                 make_cshake<digestpp::cshake128>(function_name,
+                                                  customization_str)),
+             msg, msg_len, output_len, digest);
 }
 
 ///////////////
@@ -190,25 +273,10 @@ extern void c_dpi_cshake256(const svOpenArrayHandle msg,
                             const char *function_name,
                             const char *customization_str, uint64_t msg_len,
                             uint64_t output_len, svOpenArrayHandle digest) {
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  uint8_t digest_arr[output_len];
-
-  // Compute the digest
-  digestpp::cshake256 shake;
-  shake.set_function_name(function_name, strlen(function_name));
-  shake.set_customization(customization_str, strlen(customization_str));
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+  get_digest(DigestppHasherImpl<digestpp::cshake256, true>(
+                 make_cshake<digestpp::cshake256>(function_name,
+                                                  customization_str)),
+             msg, msg_len, output_len, digest);
 }
 
 /////////////
@@ -217,36 +285,11 @@ extern void c_dpi_cshake256(const svOpenArrayHandle msg,
 extern void c_dpi_kmac128(const svOpenArrayHandle msg, uint64_t msg_len,
                           const svOpenArrayHandle key, uint64_t key_len,
                           const char *customization_str, uint64_t output_len,
-                          svBitVecVal *digest) {
-  uint64_t output_len_bits = output_len * 8;
-
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  // Load key from SV memory
-  uint8_t *key_arr = (uint8_t *)malloc(key_len * sizeof(uint8_t));
-  load_arr_from_simulator(key, key_arr, key_len);
-
-  uint8_t digest_arr[output_len];
-
-  // Compute the digest
-  digestpp::kmac128 kmac(output_len_bits);
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.digest(digest_arr, sizeof(digest_arr));
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  if (key_arr != nullptr) {
-    free(key_arr);
-  }
-
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+                          svOpenArrayHandle digest) {
+  get_digest(DigestppHasherImpl<digestpp::kmac128, false>(
+                 make_kmac(digestpp::kmac128(output_len * 8), key, key_len,
+                           customization_str)),
+             msg, msg_len, output_len, digest);
 }
 
 /////////////////
@@ -255,34 +298,11 @@ extern void c_dpi_kmac128(const svOpenArrayHandle msg, uint64_t msg_len,
 extern void c_dpi_kmac128_xof(const svOpenArrayHandle msg, uint64_t msg_len,
                               const svOpenArrayHandle key, uint64_t key_len,
                               const char *customization_str,
-                              uint64_t output_len, svBitVecVal *digest) {
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  // Load key from SV memory
-  uint8_t *key_arr = (uint8_t *)malloc(key_len * sizeof(uint8_t));
-  load_arr_from_simulator(key, key_arr, key_len);
-
-  uint8_t digest_arr[output_len];
-
-  // Compute the digest
-  digestpp::kmac128_xof kmac;
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.squeeze(digest_arr, sizeof(digest_arr));
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  if (key_arr != nullptr) {
-    free(key_arr);
-  }
-
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+                              uint64_t output_len, svOpenArrayHandle digest) {
+  get_digest(DigestppHasherImpl<digestpp::kmac128_xof, true>(
+                 make_kmac(digestpp::kmac128_xof(), key, key_len,
+                           customization_str)),
+             msg, msg_len, output_len, digest);
 }
 
 /////////////
@@ -291,36 +311,11 @@ extern void c_dpi_kmac128_xof(const svOpenArrayHandle msg, uint64_t msg_len,
 extern void c_dpi_kmac256(const svOpenArrayHandle msg, uint64_t msg_len,
                           const svOpenArrayHandle key, uint64_t key_len,
                           const char *customization_str, uint64_t output_len,
-                          svBitVecVal *digest) {
-  uint64_t output_len_bits = output_len * 8;
-
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  // Load key from SV memory
-  uint8_t *key_arr = (uint8_t *)malloc(key_len * sizeof(uint8_t));
-  load_arr_from_simulator(key, key_arr, key_len);
-
-  uint8_t digest_arr[output_len];
-
-  // Compute the digest
-  digestpp::kmac256 kmac(output_len_bits);
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.digest(digest_arr, sizeof(digest_arr));
-
-  if (msg_arr != nullptr) {
-    free(msg_arr);
-  }
-
-  if (key_arr != nullptr) {
-    free(key_arr);
-  }
-
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+                          svOpenArrayHandle digest) {
+  get_digest(DigestppHasherImpl<digestpp::kmac256, false>(
+                 make_kmac(digestpp::kmac256(output_len * 8), key, key_len,
+                           customization_str)),
+             msg, msg_len, output_len, digest);
 }
 
 /////////////////
@@ -329,33 +324,101 @@ extern void c_dpi_kmac256(const svOpenArrayHandle msg, uint64_t msg_len,
 extern void c_dpi_kmac256_xof(const svOpenArrayHandle msg, uint64_t msg_len,
                               const svOpenArrayHandle key, uint64_t key_len,
                               const char *customization_str,
-                              uint64_t output_len, svBitVecVal *digest) {
-  // Load message from SV memory
-  uint8_t *msg_arr = (uint8_t *)malloc(msg_len * sizeof(uint8_t));
-  load_arr_from_simulator(msg, msg_arr, msg_len);
-
-  // Load key from SV memory
-  uint8_t *key_arr = (uint8_t *)malloc(key_len * sizeof(uint8_t));
-  load_arr_from_simulator(key, key_arr, key_len);
-
-  uint8_t digest_arr[output_len];
+                              uint64_t output_len, svOpenArrayHandle digest) {
+  get_digest(DigestppHasherImpl<digestpp::kmac256_xof, true>(
+                 make_kmac(digestpp::kmac256_xof(), key, key_len,
+                           customization_str)),
+             msg, msg_len, output_len, digest);
+}
 
-  // Compute the digest
-  digestpp::kmac256_xof kmac;
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.squeeze(digest_arr, sizeof(digest_arr));
+/////////////////////////
+// INCREMENTAL HASHING //
+/////////////////////////
 
-  if (msg_arr != nullptr) {
-    free(msg_arr);
+/**
+ * Creates a hasher that absorbs a message in chunks as they become available,
+ * rather than over the complete message at once.
+ *
+ * `alg` is a `digestpp_dpi_pkg::digestpp_alg_e` value. `function_name` is
+ * only used by cSHAKE, `key` by KMAC and `customization_str` by both.
+ * `output_len` is the digest length in bytes, which fixed-length KMAC encodes
+ * into the message.
+ *
+ * @return Handle to the hasher, or NULL if `alg` is not recognized.
+ */
+extern void *c_dpi_digestpp_new(uint32_t alg, const char *function_name,
+                                const char *customization_str,
+                                const svOpenArrayHandle key, uint64_t key_len,
+                                uint64_t output_len) {
+  switch (alg) {
+    case kDigestppSha3_224:
+      return new DigestppHasherImpl<digestpp::sha3, false>(
+          digestpp::sha3(224));
+    case kDigestppSha3_256:
+      return new DigestppHasherImpl<digestpp::sha3, false>(
+          digestpp::sha3(256));
+    case kDigestppSha3_384:
+      return new DigestppHasherImpl<digestpp::sha3, false>(
+          digestpp::sha3(384));
+    case kDigestppSha3_512:
+      return new DigestppHasherImpl<digestpp::sha3, false>(
+          digestpp::sha3(512));
+    case kDigestppShake128:
+      return new DigestppHasherImpl<digestpp::shake128, true>(
+          digestpp::shake128());
+    case kDigestppShake256:
+      return new DigestppHasherImpl<digestpp::shake256, true>(
+          digestpp::shake256());
+    case kDigestppCShake128:
+      return new DigestppHasherImpl<digestpp::cshake128, true>(
+          make_cshake<digestpp::cshake128>(function_name, customization_str));
+    case kDigestppCShake256:
+      return new DigestppHasherImpl<digestpp::cshake256, true>(
+          make_cshake<digestpp::cshake256>(function_name, customization_str));
+    case kDigestppKmac128:
+      return new DigestppHasherImpl<digestpp::kmac128, false>(
+          make_kmac(digestpp::kmac128(output_len * 8), key, key_len,
+                    customization_str));
+    case kDigestppKmac128Xof:
+      return new DigestppHasherImpl<digestpp::kmac128_xof, true>(make_kmac(
+          digestpp::kmac128_xof(), key, key_len, customization_str));
+    case kDigestppKmac256:
+      return new DigestppHasherImpl<digestpp::kmac256, false>(
+          make_kmac(digestpp::kmac256(output_len * 8), key, key_len,
+                    customization_str));
+    case kDigestppKmac256Xof:
+      return new DigestppHasherImpl<digestpp::kmac256_xof, true>(make_kmac(
+          digestpp::kmac256_xof(), key, key_len, customization_str));
+    default:
+      fprintf(stderr, "c_dpi_digestpp_new: unknown algorithm %u\n", alg);
+      return nullptr;
   }
+}
 
-  if (key_arr != nullptr) {
-    free(key_arr);
-  }
+/**
+ * Absorbs the next `msg_len` bytes of the message.
+ */
+extern void c_dpi_digestpp_absorb(void *hasher, const svOpenArrayHandle msg,
+                                  uint64_t msg_len) {
+  absorb_from_simulator((DigestppHasher *)hasher, msg, msg_len);
+}
 
-  // Return the digest array to SV code
-  write_array_to_simulator(digest, digest_arr);
+/**
+ * Computes the digest of the message absorbed so far; more of the message may
+ * be absorbed afterwards.
+ */
+extern void c_dpi_digestpp_digest(void *hasher, uint64_t output_len,
+                                  svOpenArrayHandle digest) {
+  std::vector<uint8_t> digest_arr(output_len);
+  ((const DigestppHasher *)hasher)
+      ->Digest(digest_arr.data(), digest_arr.size());
+  write_array_to_simulator(digest, digest_arr.data(), digest_arr.size());
+}
+
+/**
+ * Releases a hasher created by `c_dpi_digestpp_new()`.
+ */
+extern void c_dpi_digestpp_free(void *hasher) {
+  delete (DigestppHasher *)hasher;
 }
 }
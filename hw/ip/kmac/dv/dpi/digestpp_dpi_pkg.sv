@@ -10,6 +10,22 @@ package digestpp_dpi_pkg;
 
   // parameters
 
+  // Algorithms supported by the incremental hashing functions
+  typedef enum int unsigned {
+    DigestppSha3_224   = 0,
+    DigestppSha3_256   = 1,
+    DigestppSha3_384   = 2,
+    DigestppSha3_512   = 3,
+    DigestppShake128   = 4,
+    DigestppShake256   = 5,
+    DigestppCShake128  = 6,
+    DigestppCShake256  = 7,
+    DigestppKmac128    = 8,
+    DigestppKmac128Xof = 9,
+    DigestppKmac256    = 10,
+    DigestppKmac256Xof = 11
+  } digestpp_alg_e;
+
   // DPI-C imports
   import "DPI-C" context function void c_dpi_sha3_224(
     input bit[7:0]          msg[],
@@ -107,4 +123,32 @@ package digestpp_dpi_pkg;
     output bit[7:0]         digest[]
   );
 
+  // Incremental hashing: create a hasher, absorb the message in any number of
+  // chunks as they become available, and compute the digest of the message
+  // absorbed so far at any point. `output_len` is in bytes.
+  import "DPI-C" context function chandle c_dpi_digestpp_new(
+    input digestpp_alg_e    alg,
+    input string            function_name,
+    input string            customization_str,
+    input bit[7:0]          key[],
+    input longint unsigned  key_len,
+    input longint unsigned  output_len
+  );
+
+  import "DPI-C" context function void c_dpi_digestpp_absorb(
+    input chandle           hasher,
+    input bit[7:0]          msg[],
+    input longint unsigned  msg_len
+  );
+
+  import "DPI-C" context function void c_dpi_digestpp_digest(
+    input chandle           hasher,
+    input longint unsigned  output_len,
+    output bit[7:0]         digest[]
+  );
+
+  import "DPI-C" function void c_dpi_digestpp_free(
+    input chandle           hasher
+  );
+
 endpackage
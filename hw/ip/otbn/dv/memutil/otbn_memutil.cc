@@ -6,6 +6,7 @@
 
 #include <cassert>
 #include <cstring>
+#include <fstream>
 #include <gelf.h>
 #include <iostream>
 #include <libelf.h>
@@ -30,6 +31,69 @@ void OtbnMemUtil::LoadElf(const std::string &elf_path) {
   LoadElfToMemories(false, elf_path);
 }
 
+void OtbnMemUtil::LoadLoopWarpFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open loop warp file: " + path);
+  }
+
+  LoopWarps warps;
+  std::string line;
+  for (int line_no = 1; std::getline(file, line); ++line_no) {
+    line = line.substr(0, line.find('#'));
+
+    std::istringstream iss(line);
+    std::string addr_str;
+    if (!(iss >> addr_str)) {
+      // An empty line (or just a comment)
+      continue;
+    }
+
+    uint64_t from_cnt, to_cnt;
+    char *end;
+    errno = 0;
+    unsigned long addr = strtoul(addr_str.c_str(), &end, 0);
+    bool good = (errno == 0) && (*end == '\0') &&
+                (addr <= std::numeric_limits<uint32_t>::max()) &&
+                (iss >> from_cnt >> to_cnt) && (iss >> std::ws).eof() &&
+                (from_cnt <= to_cnt) &&
+                (to_cnt <= std::numeric_limits<uint32_t>::max());
+    if (!good) {
+      std::ostringstream oss;
+      oss << path << ":" << line_no << ": Bad loop warp line. Expected "
+          << "ADDR FROM TO, with FROM <= TO.";
+      throw std::runtime_error(oss.str());
+    }
+
+    auto key = std::make_pair(static_cast<uint32_t>(addr),
+                              static_cast<uint32_t>(from_cnt));
+    if (!warps.insert(std::make_pair(key, to_cnt)).second) {
+      std::ostringstream oss;
+      oss << path << ":" << line_no << ": Duplicate loop warp for address 0x"
+          << std::hex << addr << " and initial count " << std::dec << from_cnt
+          << ".";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  // Check for clashes with the warps that we have already before changing
+  // anything, so that a bad file doesn't leave a partial set of warps.
+  for (const auto &pr : warps) {
+    if (loop_warp_.count(pr.first)) {
+      std::ostringstream oss;
+      oss << "Loop warp for address 0x" << std::hex << pr.first.first
+          << " and initial count " << std::dec << pr.first.second
+          << " in " << path << " is already defined.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  for (const auto &pr : warps) {
+    file_loop_warp_.insert(pr);
+    loop_warp_.insert(pr);
+  }
+}
+
 const StagedMem::SegMap &OtbnMemUtil::GetSegs(bool is_imem) const {
   return GetMemoryData(is_imem ? "imem" : "dmem").GetSegs();
 }
@@ -71,6 +135,11 @@ void OtbnMemUtil::OnElfLoaded(Elf *elf_file) {
     }
     break;
   }
+
+  // Add back any warps that came from a loop warp file
+  for (const auto &pr : file_loop_warp_) {
+    AddLoopWarp(pr.first.first, pr.first.second, pr.second);
+  }
 }
 
 void OtbnMemUtil::OnSymbol(const std::string &name, uint32_t value) {
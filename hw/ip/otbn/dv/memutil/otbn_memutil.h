@@ -25,6 +25,16 @@ class OtbnMemUtil : public DpiMemUtil {
   // If something goes wrong, throws a std::exception.
   void LoadElf(const std::string &elf_path);
 
+  // Load loop warps from a text file, as written by the ISS with
+  // --profile-loops. Each line has an address and the "from" and "to" counts
+  // of a warp (see otbnsim/README.md). Blank lines and anything after a '#'
+  // are ignored.
+  //
+  // These warps are kept when a new ELF file is loaded and are added to those
+  // given by its loop warp symbols. If something goes wrong (including a warp
+  // that clashes with one that is already defined), throws a std::exception.
+  void LoadLoopWarpFile(const std::string &path);
+
   // Get access to the segments currently staged for imem/dmem
   const StagedMem::SegMap &GetSegs(bool is_imem) const;
 
@@ -55,6 +65,10 @@ class OtbnMemUtil : public DpiMemUtil {
   ScrambledEcc32MemArea imem_, dmem_;
   int expected_end_addr_;
   LoopWarps loop_warp_;
+
+  // Warps loaded by LoadLoopWarpFile. These are merged into loop_warp_
+  // whenever it is rebuilt.
+  LoopWarps file_loop_warp_;
 };
 
 // DPI-accessible wrappers
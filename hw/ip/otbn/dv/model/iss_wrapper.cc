@@ -7,7 +7,6 @@
 #include <cassert>
 #include <cstring>
 #include <fcntl.h>
-#include <ftw.h>
 #include <iomanip>
 #include <iostream>
 #ifdef __MACH__
@@ -17,6 +16,7 @@
 #include <regex>
 #include <signal.h>
 #include <sstream>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 
@@ -30,78 +30,74 @@ struct CStrDeleter {
 }  // namespace
 typedef std::unique_ptr<char, CStrDeleter> c_str_ptr;
 
-// Guard class to create (and possibly delete) temporary directories.
-struct TmpDir {
-  std::string path;
-
-  TmpDir() : path(TmpDir::make_tmp_dir()) {}
-  ~TmpDir() { cleanup(); }
-
- private:
-  // A wrapper around mkdtemp that respects TMPDIR
-  static std::string make_tmp_dir() {
-    const char *tmpdir = getenv("TMPDIR");
-    if (!tmpdir)
-      tmpdir = "/tmp";
+// Guard class to create, map and grow a POSIX shared memory region. The
+// region is unlinked as soon as it has been created, so it only lives as long
+// as the processes that have a file descriptor for it.
+struct SharedMem {
+  int fd;
+  uint8_t *data;
+  size_t size;
+
+  SharedMem() : fd(SharedMem::open_shm()), data(nullptr), size(0) {}
+  ~SharedMem() {
+    if (data)
+      munmap(data, size);
+    close(fd);
+  }
 
-    std::string tmp_template(tmpdir);
-    tmp_template += "/otbn_XXXXXX";
+  // Return the start of the region, first growing it to at least len bytes if
+  // necessary. On failure, throws a std::runtime_error.
+  uint8_t *reserve(size_t len) {
+    if (len <= size)
+      return data;
 
-    if (!mkdtemp(&tmp_template.at(0))) {
+    if (ftruncate(fd, len) != 0) {
       std::ostringstream oss;
-      oss << ("Cannot create temporary directory for OTBN simulation "
-              "with template ")
-          << tmp_template << ": " << strerror(errno);
+      oss << "Cannot resize shared memory for OTBN simulation to " << len
+          << " bytes: " << strerror(errno);
       throw std::runtime_error(oss.str());
     }
-
-    // The backing string for tmp_template will have been populated by mkdtemp.
-    return tmp_template;
-  }
-
-  // Return true if the OTBN_MODEL_KEEP_TMP environment variable is set to 1.
-  static bool should_keep_tmp() {
-    const char *keep_str = getenv("OTBN_MODEL_KEEP_TMP");
-    if (!keep_str)
-      return false;
-    return (strcmp(keep_str, "1") == 0) ? true : false;
-  }
-
-  // Called by nftw when we're deleting the temporary directory
-  static int ftw_callback(const char *fpath, const struct stat *sb,
-                          int typeflag, struct FTW *ftwbuf) {
-    // The libc remove() function calls unlink or rmdir as necessary. Ignore
-    // any failures: we'll check that we managed to delete the directory when
-    // nftw finishes.
-    remove(fpath);
-
-    // Tell nftw to keep going
-    return 0;
+    void *new_data = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (new_data == MAP_FAILED) {
+      std::ostringstream oss;
+      oss << "Cannot map shared memory for OTBN simulation: "
+          << strerror(errno);
+      throw std::runtime_error(oss.str());
+    }
+    if (data)
+      munmap(data, size);
+    data = static_cast<uint8_t *>(new_data);
+    size = len;
+    return data;
   }
 
-  // Recursively delete the temporary directory
-  void cleanup() {
-    if (path.empty())
-      return;
+ private:
+  // Create a new shared memory object with a unique name and unlink it again,
+  // returning its file descriptor (with FD_CLOEXEC set).
+  static int open_shm() {
+    static unsigned counter = 0;
+
+    for (int attempt = 0; attempt < 16; ++attempt) {
+      std::ostringstream name;
+      name << "/otbn_" << getpid() << "_" << counter++;
+
+      int fd = shm_open(name.str().c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+      if (fd < 0 && errno == EEXIST)
+        continue;
+      if (fd < 0) {
+        std::ostringstream oss;
+        oss << "Cannot create shared memory for OTBN simulation: "
+            << strerror(errno);
+        throw std::runtime_error(oss.str());
+      }
 
-    if (TmpDir::should_keep_tmp()) {
-      std::cerr << "Keeping temporary directory at " << path
-                << " because OTBN_MODEL_KEEP_TMP=1.\n";
-      return;
+      shm_unlink(name.str().c_str());
+      fcntl(fd, F_SETFD, FD_CLOEXEC);
+      return fd;
     }
 
-    // We're not supposed to keep the directory. Try to delete it and its
-    // contents. Ignore any failures: we'll just check whether it's gone
-    // afterwards.
-    nftw(path.c_str(), TmpDir::ftw_callback, 4, FTW_DEPTH | FTW_PHYS);
-
-    // Is there still anything at path? If so, we failed. Print something to
-    // stderr to tell the user what's going on.
-    struct stat statbuf;
-    if (stat(path.c_str(), &statbuf) == 0) {
-      std::cerr << "ERROR: Failed to delete OTBN temporary directory at "
-                << path << ".\n";
-    }
+    throw std::runtime_error(
+        "Cannot find an unused name for OTBN simulation shared memory.");
   }
 };
 
@@ -202,6 +198,74 @@ static std::string find_otbn_model() {
   return std::string(abs_path.get());
 }
 
+// Kinds of binary response frame and the layout of FRAME_STEP payloads, which
+// must match stepped.py
+enum { kFrameText = 0, kFrameStep = 1, kFrameBatch = 2 };
+enum {
+  kStepRegStatus,
+  kStepRegInsnCnt,
+  kStepRegErrBits,
+  kStepRegStopPc,
+  kStepRegRndReq,
+  kStepRegWipeStart,
+  kNumStepRegs
+};
+
+// Return true if the OTBN_ISS_TEXT_PROTOCOL environment variable is set to 1.
+static bool use_text_protocol() {
+  const char *text_str = getenv("OTBN_ISS_TEXT_PROTOCOL");
+  return text_str && strcmp(text_str, "1") == 0;
+}
+
+// Read the OTBN_ISS_BATCH_CYCLES environment variable: the number of cycles
+// that the ISS may run ahead in one command. Defaults to 1 (no batching).
+static uint32_t get_batch_cycles() {
+  const char *batch_str = getenv("OTBN_ISS_BATCH_CYCLES");
+  if (!batch_str)
+    return 1;
+
+  char *end;
+  unsigned long cycles = strtoul(batch_str, &end, 0);
+  if (*batch_str == '\0' || *end != '\0' || cycles == 0 ||
+      cycles > UINT32_MAX) {
+    std::ostringstream oss;
+    oss << "Invalid value for OTBN_ISS_BATCH_CYCLES: `" << batch_str << "'.";
+    throw std::runtime_error(oss.str());
+  }
+  return (uint32_t)cycles;
+}
+
+// Read the OTBN_ISS_POOL_SIZE environment variable: the number of idle ISS
+// processes that we keep for reuse. Defaults to 1.
+static size_t get_pool_size() {
+  const char *pool_str = getenv("OTBN_ISS_POOL_SIZE");
+  if (!pool_str)
+    return 1;
+
+  char *end;
+  unsigned long size = strtoul(pool_str, &end, 0);
+  if (*pool_str == '\0' || *end != '\0' || size > 64) {
+    std::ostringstream oss;
+    oss << "Invalid value for OTBN_ISS_POOL_SIZE: `" << pool_str << "'.";
+    throw std::runtime_error(oss.str());
+  }
+  return size;
+}
+
+// Idle ISS wrappers, waiting to be handed out by ISSWrapper::acquire. Their
+// processes are killed by the wrappers' destructors when the simulation
+// exits.
+static std::vector<std::unique_ptr<ISSWrapper>> &idle_wrappers() {
+  static std::vector<std::unique_ptr<ISSWrapper>> pool;
+  return pool;
+}
+
+// Read a little-endian uint32_t from a binary payload
+static uint32_t read_le_32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
 // Read 8 hex characters from str as a uint32_t.
 static uint32_t read_hex_32(const char *str) {
   char buf[9];
@@ -266,7 +330,10 @@ void MirroredRegs::reset() {
   wipe_start = false;
 }
 
-ISSWrapper::ISSWrapper() : tmpdir(new TmpDir()) {
+ISSWrapper::ISSWrapper()
+    : binary_(!use_text_protocol()),
+      batch_cycles_(get_batch_cycles()),
+      shm_(new SharedMem()) {
   std::string model_path(find_otbn_model());
 
   // We want two pipes: one for writing to the child process, and the other for
@@ -314,9 +381,18 @@ ISSWrapper::ISSWrapper() : tmpdir(new TmpDir()) {
                 << "\n";
       abort();
     }
+    // Let the ISS inherit the shared memory, which it maps for itself
+    fcntl(shm_->fd, F_SETFD, 0);
+    std::string shm_fd = std::to_string(shm_->fd);
+
     // Finally, exec the ISS
-    execl("/usr/bin/env", "/usr/bin/env", "python3", "-u", model_path.c_str(),
-          NULL);
+    std::vector<const char *> argv = {"/usr/bin/env", "python3", "-u",
+                                      model_path.c_str(), "--shm-fd",
+                                      shm_fd.c_str()};
+    if (binary_)
+      argv.push_back("--binary");
+    argv.push_back(nullptr);
+    execv("/usr/bin/env", const_cast<char *const *>(argv.data()));
   }
 
   // We are the parent process and pid is the PID of the child. Close the pipe
@@ -337,6 +413,42 @@ ISSWrapper::ISSWrapper() : tmpdir(new TmpDir()) {
   assert(child_read_file);
 }
 
+std::unique_ptr<ISSWrapper> ISSWrapper::acquire() {
+  auto &pool = idle_wrappers();
+  if (pool.empty())
+    return std::unique_ptr<ISSWrapper>(new ISSWrapper());
+
+  std::unique_ptr<ISSWrapper> iss(std::move(pool.back()));
+  pool.pop_back();
+  return iss;
+}
+
+void ISSWrapper::release(std::unique_ptr<ISSWrapper> iss) {
+  if (!iss)
+    return;
+
+  try {
+    auto &pool = idle_wrappers();
+    if (pool.size() >= get_pool_size())
+      return;
+
+    // Wrappers in the pool must look just like new ones. Resetting the ISS
+    // gives it a fresh simulator object (including loop warps), and the
+    // wrapper drops its mirrored registers and any cycles it ran ahead.
+    iss->reset(false);
+    pool.push_back(std::move(iss));
+  } catch (const std::runtime_error &) {
+    // Something went wrong with the ISS (or with the pool size). Drop this
+    // wrapper: the next call to acquire will start a new one.
+  }
+}
+
+void ISSWrapper::prewarm() {
+  auto &pool = idle_wrappers();
+  if (pool.empty() && get_pool_size() > 0)
+    pool.emplace_back(new ISSWrapper());
+}
+
 ISSWrapper::~ISSWrapper() {
   // Stop the child process if it's still running. No need to be nice: we'll
   // just send a SIGKILL. Also, no need to check whether it's running first: we
@@ -351,15 +463,17 @@ ISSWrapper::~ISSWrapper() {
   fclose(child_read_file);
 }
 
-void ISSWrapper::load_d(const std::string &path) {
+void ISSWrapper::load_d(const std::vector<uint8_t> &data) {
+  memcpy(shm_->reserve(data.size()), data.data(), data.size());
   std::ostringstream oss;
-  oss << "load_d " << path << "\n";
+  oss << "load_d_shm " << data.size() << "\n";
   run_command(oss.str(), nullptr);
 }
 
-void ISSWrapper::load_i(const std::string &path) {
+void ISSWrapper::load_i(const std::vector<uint8_t> &data) {
+  memcpy(shm_->reserve(data.size()), data.data(), data.size());
   std::ostringstream oss;
-  oss << "load_i " << path << "\n";
+  oss << "load_i_shm " << data.size() << "\n";
   run_command(oss.str(), nullptr);
 }
 
@@ -375,10 +489,13 @@ void ISSWrapper::clear_loop_warps() {
   run_command("clear_loop_warps\n", nullptr);
 }
 
-void ISSWrapper::dump_d(const std::string &path) const {
+const uint8_t *ISSWrapper::dump_d(size_t num_words) const {
+  size_t len = 5 * num_words;
+  const uint8_t *data = shm_->reserve(len);
   std::ostringstream oss;
-  oss << "dump_d " << path << "\n";
+  oss << "dump_d_shm " << len << "\n";
   run_command(oss.str(), nullptr);
+  return data;
 }
 
 void ISSWrapper::start_operation(command_t command) {
@@ -451,6 +568,9 @@ void ISSWrapper::set_keymgr_value(const std::array<uint32_t, 12> &key0_arr,
 }
 
 int ISSWrapper::step(bool gen_trace) {
+  if (binary_)
+    return binary_step(gen_trace);
+
   std::vector<std::string> lines;
 
   run_command("step\n", &lines);
@@ -483,6 +603,131 @@ int ISSWrapper::step(bool gen_trace) {
   return done ? 1 : 0;
 }
 
+int ISSWrapper::binary_step(bool gen_trace) {
+  if (!pending_steps_.empty()) {
+    std::vector<uint8_t> payload(std::move(pending_steps_.front()));
+    pending_steps_.pop_front();
+    return apply_step(payload, gen_trace);
+  }
+
+  bool batch = batch_cycles_ > 1;
+  if (batch) {
+    fprintf(child_write_file, "step_batch %u\n", (unsigned)batch_cycles_);
+  } else {
+    fputs("step\n", child_write_file);
+  }
+  fflush(child_write_file);
+
+  std::vector<uint8_t> payload;
+  int kind = read_child_frame(&payload);
+  if (kind < 0) {
+    throw std::runtime_error("Failed to run command 'step': EOF from ISS.");
+  }
+  if (kind != (batch ? kFrameBatch : kFrameStep)) {
+    throw std::runtime_error("Unexpected response frame from ISS for step.");
+  }
+  if (batch) {
+    take_step_batch(payload);
+    assert(!pending_steps_.empty());
+    payload = std::move(pending_steps_.front());
+    pending_steps_.pop_front();
+  }
+  return apply_step(payload, gen_trace);
+}
+
+void ISSWrapper::take_step_batch(const std::vector<uint8_t> &payload) {
+  // The payload is a count of cycles, followed by a length and FRAME_STEP
+  // payload for each one.
+  const uint8_t *p = payload.data();
+  size_t pos = 4;
+  if (payload.size() < pos) {
+    throw std::runtime_error("Truncated step_batch response from ISS.");
+  }
+  uint32_t num_cycles = read_le_32(p);
+  if (num_cycles == 0) {
+    throw std::runtime_error("Empty step_batch response from ISS.");
+  }
+  for (uint32_t i = 0; i < num_cycles; ++i) {
+    if (payload.size() - pos < 4) {
+      throw std::runtime_error("Truncated step_batch response from ISS.");
+    }
+    uint32_t len = read_le_32(p + pos);
+    pos += 4;
+    if (payload.size() - pos < len) {
+      throw std::runtime_error("Truncated step_batch response from ISS.");
+    }
+    pending_steps_.emplace_back(p + pos, p + pos + len);
+    pos += len;
+  }
+  if (pos != payload.size()) {
+    throw std::runtime_error("Malformed step_batch response from ISS.");
+  }
+}
+
+int ISSWrapper::apply_step(const std::vector<uint8_t> &payload,
+                           bool gen_trace) {
+  // The payload is a valid mask, the register values, a line count and the
+  // line offsets (all 32-bit words), followed by the trace text.
+  const size_t hdr_words = 2 + kNumStepRegs;
+  if (payload.size() < 4 * hdr_words) {
+    throw std::runtime_error("Truncated step response from ISS.");
+  }
+  const uint8_t *p = payload.data();
+  uint32_t valid = read_le_32(p);
+  uint32_t values[kNumStepRegs];
+  for (int i = 0; i < kNumStepRegs; ++i) {
+    values[i] = read_le_32(p + 4 * (1 + i));
+  }
+  uint32_t num_lines = read_le_32(p + 4 * (1 + kNumStepRegs));
+  size_t text_start = 4 * (hdr_words + num_lines + 1);
+  if (payload.size() < text_start ||
+      payload.size() - text_start !=
+          read_le_32(p + 4 * (hdr_words + num_lines))) {
+    throw std::runtime_error("Malformed step response from ISS.");
+  }
+
+  if (gen_trace && num_lines) {
+    std::vector<std::string> lines;
+    lines.reserve(num_lines);
+    const char *text = (const char *)p + text_start;
+    for (uint32_t i = 0; i < num_lines; ++i) {
+      uint32_t from = read_le_32(p + 4 * (hdr_words + i));
+      uint32_t to = read_le_32(p + 4 * (hdr_words + i + 1));
+      lines.emplace_back(text + from, to - from);
+    }
+    if (!OtbnTraceChecker::get().OnIssTrace(lines)) {
+      return -1;
+    }
+  }
+
+  // Update the mirrored registers as step() does, but from the fixed fields
+  // rather than by searching the trace.
+  for (int i : {kStepRegRndReq, kStepRegWipeStart}) {
+    if (((valid >> i) & 1) && values[i] > 1) {
+      std::cerr << "ERROR: Unexpected update to "
+                << (i == kStepRegRndReq ? "RND_REQ" : "WIPE_START")
+                << " with value 0x" << std::hex << values[i] << std::dec
+                << " when we expected a boolean flag.";
+      return -1;
+    }
+  }
+
+  bool was_stopped = mirrored_.stopped();
+  uint32_t *regs[] = {&mirrored_.status, &mirrored_.insn_cnt,
+                      &mirrored_.err_bits, &mirrored_.stop_pc};
+  for (int i = kStepRegStatus; i <= kStepRegStopPc; ++i) {
+    if ((valid >> i) & 1)
+      *regs[i] = values[i];
+  }
+  if ((valid >> kStepRegRndReq) & 1)
+    mirrored_.rnd_req = values[kStepRegRndReq] != 0;
+  if ((valid >> kStepRegWipeStart) & 1)
+    mirrored_.wipe_start = values[kStepRegWipeStart] != 0;
+
+  bool done = mirrored_.stopped() && !was_stopped;
+  return done ? 1 : 0;
+}
+
 void ISSWrapper::invalidate_imem() {
   run_command("invalidate_imem\n", nullptr);
 }
@@ -523,6 +768,9 @@ void ISSWrapper::reset(bool gen_trace) {
   if (gen_trace)
     OtbnTraceChecker::get().Flush();
 
+  // Any cycles that the ISS ran ahead are thrown away along with its state
+  pending_steps_.clear();
+
   run_command("reset\n", nullptr);
 
   // Reset all mirrored registers.
@@ -543,11 +791,23 @@ void ISSWrapper::set_rma_req(uint8_t rma_req) {
 }
 
 void ISSWrapper::get_regs(std::array<uint32_t, 32> *gprs,
-                          std::array<u256_t, 32> *wdrs) {
+                          std::array<u256_t, 32> *wdrs, uint32_t gpr_mask,
+                          uint32_t wdr_mask) {
   assert(gprs && wdrs);
 
+  uint64_t expected_mask = ((uint64_t)wdr_mask << 32) | gpr_mask;
+  if (!expected_mask)
+    return;
+
   std::vector<std::string> lines;
-  run_command("print_regs\n", &lines);
+  if (expected_mask == ~(uint64_t)0) {
+    run_command("print_regs\n", &lines);
+  } else {
+    std::ostringstream oss;
+    oss << "print_regs 0x" << std::hex << gpr_mask << " 0x" << wdr_mask
+        << "\n";
+    run_command(oss.str(), &lines);
+  }
 
   // A record of which registers we've seen (to check we see each
   // register exactly once). GPR i sets bit i. WDR i sets bit 32 + i.
@@ -614,11 +874,12 @@ void ISSWrapper::get_regs(std::array<uint32_t, 32> *gprs,
     seen_mask |= ((uint64_t)1 << idx_seen);
   }
 
-  // Check that we've seen all the registers
-  if (~seen_mask) {
+  // Check that we've seen all the registers that we asked for
+  if (seen_mask != expected_mask) {
     std::ostringstream oss;
-    oss << "Some registers were missing from print_register output. Mask: 0x"
-        << std::hex << seen_mask << ".";
+    oss << "Registers in print_register output don't match the ones we "
+        << "asked for. Saw mask 0x" << std::hex << seen_mask
+        << ", but expected 0x" << expected_mask << ".";
     throw std::runtime_error(oss.str());
   }
 }
@@ -660,11 +921,43 @@ std::vector<uint32_t> ISSWrapper::get_call_stack() {
   return call_stack;
 }
 
-std::string ISSWrapper::make_tmp_path(const std::string &relative) const {
-  return tmpdir->path + "/" + relative;
+int ISSWrapper::read_child_frame(std::vector<uint8_t> *payload) const {
+  assert(payload);
+
+  uint8_t hdr[5];
+  if (fread(hdr, 1, sizeof hdr, child_read_file) != sizeof hdr) {
+    return -1;
+  }
+  payload->resize(read_le_32(hdr));
+  if (payload->size() &&
+      fread(payload->data(), 1, payload->size(), child_read_file) !=
+          payload->size()) {
+    return -1;
+  }
+  return hdr[4];
 }
 
 bool ISSWrapper::read_child_response(std::vector<std::string> *dst) const {
+  if (binary_) {
+    std::vector<uint8_t> payload;
+    int kind = read_child_frame(&payload);
+    if (kind < 0) {
+      return false;
+    }
+    if (kind != kFrameText) {
+      throw std::runtime_error("Unexpected binary response frame from ISS.");
+    }
+    // The payload is the lines of text that the command printed
+    if (dst && payload.size()) {
+      std::istringstream iss(std::string(payload.begin(), payload.end()));
+      std::string line;
+      while (std::getline(iss, line)) {
+        dst->push_back(line);
+      }
+    }
+    return true;
+  }
+
   char buf[256];
   bool continuation = false;
 
@@ -718,6 +1011,17 @@ void ISSWrapper::run_command(const std::string &cmd,
   assert(cmd.size() > 0);
   assert(cmd.back() == '\n');
 
+  // If the ISS has run ahead of the RTL (see step()), it is already past the
+  // cycle where this command should take effect.
+  if (!pending_steps_.empty()) {
+    std::ostringstream oss;
+    std::string cmd_line = cmd.substr(0, cmd.size() - 1);
+    oss << "Cannot run command '" << cmd_line << "': the ISS has run "
+        << pending_steps_.size()
+        << " cycles ahead. Unset OTBN_ISS_BATCH_CYCLES for this test.";
+    throw std::runtime_error(oss.str());
+  }
+
   fputs(cmd.c_str(), child_write_file);
   fflush(child_write_file);
   if (!read_child_response(dst)) {
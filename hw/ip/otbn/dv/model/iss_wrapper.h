@@ -7,13 +7,14 @@
 #include <array>
 #include <cstdint>
 #include <cstdio>
+#include <deque>
 #include <memory>
 #include <string>
 #include <unistd.h>
 #include <vector>
 
 // Forward declaration (the implementation is private in iss_wrapper.cc)
-struct TmpDir;
+struct SharedMem;
 
 // OTBN has some externally visible CSRs that can be updated by hardware
 // (without explicit writes from software). The ISSWrapper mirrors the ISS's
@@ -57,9 +58,31 @@ struct ISSWrapper {
   ISSWrapper();
   ~ISSWrapper();
 
-  // Load new contents of DMEM / IMEM
-  void load_d(const std::string &path);
-  void load_i(const std::string &path);
+  // Return an ISSWrapper whose ISS is in its reset state. This reuses an idle
+  // wrapper from the pool if there is one (so doesn't have to wait for Python
+  // to start), and otherwise constructs a new one. Throws a std::runtime_error
+  // on failure.
+  static std::unique_ptr<ISSWrapper> acquire();
+
+  // Give a wrapper back to the pool once it is no longer needed. The ISS is
+  // reset so that acquire can hand it out again. If the pool is already full
+  // or the reset fails, the wrapper is destroyed instead.
+  static void release(std::unique_ptr<ISSWrapper> iss);
+
+  // If the pool is empty, start an ISS process and put its wrapper in the
+  // pool. The ISS starts up in the background, so this doesn't block. Throws
+  // a std::runtime_error on failure.
+  //
+  // The maximum number of idle wrappers is given by the OTBN_ISS_POOL_SIZE
+  // environment variable (default 1). If it's zero, release and prewarm do
+  // nothing.
+  static void prewarm();
+
+  // Load new contents of DMEM / IMEM. data holds 5 bytes per 32-bit word: a
+  // validity byte (0 or 1), followed by the word in little-endian order. It is
+  // passed to the ISS through memory shared with it.
+  void load_d(const std::vector<uint8_t> &data);
+  void load_i(const std::vector<uint8_t> &data);
 
   // Add a loop warp instruction to the simulation
   void add_loop_warp(uint32_t addr, uint32_t from_cnt, uint32_t to_cnt);
@@ -67,8 +90,10 @@ struct ISSWrapper {
   // Clear any loop warp instructions from the simulation
   void clear_loop_warps();
 
-  // Dump the contents of DMEM to a file
-  void dump_d(const std::string &path) const;
+  // Read the first num_words words of DMEM, in the same format as load_d. The
+  // result points into memory shared with the ISS and is only valid until the
+  // next call to load_d, load_i or dump_d.
+  const uint8_t *dump_d(size_t num_words) const;
 
   // Start an operation (execute, dmem wipe or imem wipe)
   void start_operation(command_t command);
@@ -112,6 +137,14 @@ struct ISSWrapper {
   // Updates mirrored versions of STATUS and INSN_CNT registers. If execution
   // finishes (so we return 1), also updates mirrored versions of ERR_BITS and
   // the final PC (see get_stop_pc()).
+  //
+  // If OTBN_ISS_BATCH_CYCLES is set to some N > 1, the ISS may be asked to run
+  // up to N cycles ahead in one go while it is executing code and nothing
+  // externally visible happens. The results of those cycles are buffered here
+  // and handed out (and checked against the RTL trace) one per call. Sending
+  // the ISS any other command while it is ahead is an error, so this should
+  // only be used by simulations that don't drive asynchronous inputs, such as
+  // escalations, into OTBN while it runs.
   int step(bool gen_trace);
 
   // Mark all of IMEM as invalid so that any fetch causes an integrity error.
@@ -143,17 +176,14 @@ struct ISSWrapper {
 
   const MirroredRegs &get_mirrored() const { return mirrored_; }
 
-  // Read contents of the register file
-  void get_regs(std::array<uint32_t, 32> *gprs, std::array<u256_t, 32> *wdrs);
+  // Read contents of the register file. Only the GPRs and WDRs with bits set
+  // in gpr_mask and wdr_mask are read: other entries are left unchanged.
+  void get_regs(std::array<uint32_t, 32> *gprs, std::array<u256_t, 32> *wdrs,
+                uint32_t gpr_mask = ~0u, uint32_t wdr_mask = ~0u);
 
   // Read the contents of the call stack
   std::vector<uint32_t> get_call_stack();
 
-  // Resolve a path relative to the convenience temporary directory.
-  // relative should be a relative path (it is just appended to the
-  // path of the temporary directory).
-  std::string make_tmp_path(const std::string &relative) const;
-
  private:
   // Read line by line from the child process until we get ".\n".
   // Return true if we got the ".\n" terminator, false if EOF. If dst
@@ -164,12 +194,37 @@ struct ISSWrapper {
   // response, raise a runtime_error.
   void run_command(const std::string &cmd, std::vector<std::string> *dst) const;
 
+  // Read a binary response frame from the child into *payload. Return the
+  // kind of frame, or -1 on EOF.
+  int read_child_frame(std::vector<uint8_t> *payload) const;
+
+  // Run a single cycle, using the binary protocol (see step())
+  int binary_step(bool gen_trace);
+
+  // Apply the results of a cycle from a FRAME_STEP payload: pass any trace to
+  // the trace checker and update the mirrored registers. Returns as step().
+  int apply_step(const std::vector<uint8_t> &payload, bool gen_trace);
+
+  // Read a FRAME_BATCH payload into pending_steps_
+  void take_step_batch(const std::vector<uint8_t> &payload);
+
+  // True if the child writes binary response frames (see stepped.py). This is
+  // the default; set OTBN_ISS_TEXT_PROTOCOL=1 to fall back to text responses,
+  // which are easier to read when debugging.
+  bool binary_;
+
+  // The maximum number of cycles to ask the ISS to run in one go (see
+  // step()), and the results of cycles that it has run but we have not yet
+  // stepped past.
+  uint32_t batch_cycles_;
+  std::deque<std::vector<uint8_t>> pending_steps_;
+
   pid_t child_pid;
   FILE *child_write_file;
   FILE *child_read_file;
 
-  // A temporary directory for communicating with the child process
-  std::unique_ptr<TmpDir> tmpdir;
+  // Memory shared with the child process, for passing memory contents
+  std::unique_ptr<SharedMem> shm_;
 
   // Mirrored copies of registers
   MirroredRegs mirrored_;
@@ -7,7 +7,6 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -40,45 +39,31 @@ int otbn_stack_element_peek(int index, svBitVecVal *val);
 #define STATUS_BUSY_SEC_WIPE_INT 0x04
 #define STATUS_LOCKED 0xFF
 
-// Read (the start of) the contents of a file at path as a vector of bytes.
-// Expects num_bytes bytes of data. On failure, throws a std::runtime_error.
-static Ecc32MemArea::EccWords read_words_from_file(const std::string &path,
-                                                   size_t num_words) {
-  std::filebuf fb;
-  if (!fb.open(path.c_str(), std::ios::in | std::ios::binary)) {
-    std::ostringstream oss;
-    oss << "Cannot open the file '" << path << "'.";
-    throw std::runtime_error(oss.str());
-  }
-
+// Decode num_words memory words in the format used by ISSWrapper::dump_d (a
+// validity byte, then a little-endian 32-bit word). On failure, throws a
+// std::runtime_error.
+static Ecc32MemArea::EccWords decode_words(const uint8_t *data,
+                                           size_t num_words) {
   Ecc32MemArea::EccWords ret;
   ret.reserve(num_words);
 
-  char minibuf[5];
   for (size_t i = 0; i < num_words; ++i) {
-    std::streamsize chars_in = fb.sgetn(minibuf, 5);
-    if (chars_in != 5) {
-      std::ostringstream oss;
-      oss << "Cannot read word " << i << " from " << path
-          << " (expected 5 bytes, but actually got " << chars_in << ").";
-      throw std::runtime_error(oss.str());
-    }
+    const uint8_t *bytes = data + 5 * i;
 
     // The layout should be a validity byte (either 0 or 1), followed
     // by 4 bytes with a little-endian 32-bit word.
-    uint8_t vld_byte = minibuf[0];
+    uint8_t vld_byte = bytes[0];
     if (vld_byte > 2) {
       std::ostringstream oss;
-      oss << "Word " << i << " at " << path
-          << " had a validity byte with value " << (int)vld_byte
-          << "; not 0 or 1.";
+      oss << "Word " << i << " from the ISS had a validity byte with value "
+          << (int)vld_byte << "; not 0 or 1.";
       throw std::runtime_error(oss.str());
     }
     bool valid = vld_byte == 1;
 
     uint32_t word = 0;
     for (int j = 0; j < 4; ++j) {
-      word |= (uint32_t)(uint8_t)minibuf[j + 1] << 8 * j;
+      word |= (uint32_t)bytes[j + 1] << 8 * j;
     }
 
     ret.push_back(std::make_pair(valid, word));
@@ -87,41 +72,34 @@ static Ecc32MemArea::EccWords read_words_from_file(const std::string &path,
   return ret;
 }
 
-// Write some words to a new file at path. On failure, throws a
-// std::runtime_error.
-static void write_words_to_file(const std::string &path,
-                                const Ecc32MemArea::EccWords &words) {
-  std::filebuf fb;
-  if (!fb.open(path.c_str(), std::ios::out | std::ios::binary)) {
-    std::ostringstream oss;
-    oss << "Cannot open the file '" << path << "'.";
-    throw std::runtime_error(oss.str());
-  }
+// Encode some words in the format used by ISSWrapper::load_d and load_i. If
+// zero_invalid is true, the data of any invalid word is encoded as zero, as
+// the ISS does when dumping memory.
+static std::vector<uint8_t> encode_words(const Ecc32MemArea::EccWords &words,
+                                         bool zero_invalid) {
+  std::vector<uint8_t> ret(5 * words.size());
+  uint8_t *bytes = ret.data();
 
   for (const Ecc32MemArea::EccWord &word : words) {
-    uint8_t bytes[5];
-
     bool valid = word.first;
-    uint32_t w32 = word.second;
+    uint32_t w32 = (valid || !zero_invalid) ? word.second : 0;
 
     bytes[0] = valid ? 1 : 0;
     for (int j = 0; j < 4; ++j) {
       bytes[j + 1] = (w32 >> (8 * j)) & 0xff;
     }
-
-    std::streamsize chars_out =
-        fb.sputn(reinterpret_cast<const char *>(&bytes), 5);
-    if (chars_out != 5) {
-      std::ostringstream oss;
-      oss << "Failed to write to " << path << ".";
-      throw std::runtime_error(oss.str());
-    }
+    bytes += 5;
   }
+
+  return ret;
 }
 
+// Read the registers whose bits are set in mask, leaving the other entries
+// zero.
 template <typename T>
-static std::array<T, 32> get_rtl_regs(const std::string &reg_scope) {
-  std::array<T, 32> ret;
+static std::array<T, 32> get_rtl_regs(const std::string &reg_scope,
+                                      uint32_t mask) {
+  std::array<T, 32> ret{};
   static_assert(sizeof(T) <= 256 / 8, "Can only copy 256 bits");
 
   SVScoped scoped(reg_scope);
@@ -132,6 +110,8 @@ static std::array<T, 32> get_rtl_regs(const std::string &reg_scope) {
   svBitVecVal buf[256 / 8 / sizeof(svBitVecVal)];
 
   for (int i = 0; i < 32; ++i) {
+    if (!((mask >> i) & 1))
+      continue;
     if (!otbn_rf_peek(i, buf)) {
       std::ostringstream oss;
       oss << "Failed to peek into RTL to get value of register " << i
@@ -193,9 +173,17 @@ OtbnModel::OtbnModel(const std::string &mem_scope,
                      const std::string &design_scope)
     : mem_util_(mem_scope), design_scope_(design_scope) {
   assert(mem_scope.size() && design_scope.size());
+
+  // Start an ISS process now, so that Python has started by the time that
+  // ensure_wrapper needs it. If this fails, ignore the error here: we'll try
+  // again (and report what went wrong) when the ISS is actually needed.
+  try {
+    ISSWrapper::prewarm();
+  } catch (const std::runtime_error &) {
+  }
 }
 
-OtbnModel::~OtbnModel() {}
+OtbnModel::~OtbnModel() { ISSWrapper::release(std::move(iss_)); }
 
 int OtbnModel::take_loop_warps(const OtbnMemUtil &memutil) {
   ISSWrapper *iss = ensure_wrapper();
@@ -239,14 +227,8 @@ int OtbnModel::start_operation(command_t command) {
         cmd_desc = "execute";
         iss_command = ISSWrapper::Execute;
 
-        std::string dfname(iss->make_tmp_path("dmem"));
-        std::string ifname(iss->make_tmp_path("imem"));
-
-        write_words_to_file(dfname, get_sim_memory(false));
-        write_words_to_file(ifname, get_sim_memory(true));
-
-        iss->load_d(dfname);
-        iss->load_i(ifname);
+        iss->load_d(encode_words(get_sim_memory(false), false));
+        iss->load_i(encode_words(get_sim_memory(true), false));
       } break;
 
       case DmemWipe:
@@ -462,6 +444,18 @@ int OtbnModel::check() const {
 
   good &= OtbnTraceChecker::get().Finish();
 
+  // Only compare registers that either side has written since the last check
+  // (or all of them, if the full check is enabled). Any change at all that
+  // doesn't appear in the traces needs a full check to spot it.
+  uint32_t gpr_mask, wdr_mask;
+  bool call_stack_dirty;
+  OtbnTraceChecker::get().TakeDirtyRegs(&gpr_mask, &wdr_mask,
+                                        &call_stack_dirty);
+  if (full_reg_check_) {
+    gpr_mask = wdr_mask = ~0u;
+    call_stack_dirty = true;
+  }
+
   // Check DMEM only when we are about to start Secure Wipe because otherwise
   // we would not have a valid scrambling key anymore. That would result with
   // not getting a valid nonce and therefore an error.
@@ -475,13 +469,13 @@ int OtbnModel::check() const {
   }
 
   try {
-    good &= check_regs(*iss);
+    good &= check_regs(*iss, gpr_mask, wdr_mask);
   } catch (const std::exception &err) {
     std::cerr << "Failed to check registers: " << err.what() << "\n";
     return -1;
   }
 
-  if (stack_check_enabled_) {
+  if (stack_check_enabled_ && call_stack_dirty) {
     try {
       good &= check_call_stack(*iss);
     } catch (const std::exception &err) {
@@ -502,12 +496,10 @@ int OtbnModel::load_dmem() {
 
   const MemArea &dmem = mem_util_.GetMemArea(false);
 
-  std::string dfname(iss->make_tmp_path("dmem_out"));
   try {
     // Read DMEM from the ISS
-    iss->dump_d(dfname);
-    set_sim_memory(false,
-                   read_words_from_file(dfname, dmem.GetSizeBytes() / 4));
+    size_t num_words = dmem.GetSizeBytes() / 4;
+    set_sim_memory(false, decode_words(iss->dump_d(num_words), num_words));
   } catch (const std::exception &err) {
     std::cerr << "Error when loading dmem from ISS: " << err.what() << "\n";
     return -1;
@@ -566,6 +558,11 @@ int OtbnModel::set_no_sec_wipe_chk() {
   return 0;
 }
 
+int OtbnModel::enable_full_reg_check() {
+  full_reg_check_ = true;
+  return 0;
+}
+
 int OtbnModel::disable_stack_check() {
   stack_check_enabled_ = false;
   return 0;
@@ -661,7 +658,7 @@ bool OtbnModel::is_at_start_of_wipe() const {
 ISSWrapper *OtbnModel::ensure_wrapper() {
   if (!iss_) {
     try {
-      iss_.reset(new ISSWrapper());
+      iss_ = ISSWrapper::acquire();
     } catch (const std::runtime_error &err) {
       std::cerr << "Error when constructing ISS wrapper: " << err.what()
                 << "\n";
@@ -686,16 +683,20 @@ bool OtbnModel::check_dmem(ISSWrapper &iss) const {
   const MemArea &dmem = mem_util_.GetMemArea(false);
   uint32_t dmem_bytes = dmem.GetSizeBytes();
 
-  std::string dfname(iss.make_tmp_path("dmem_out"));
-
-  iss.dump_d(dfname);
-  Ecc32MemArea::EccWords iss_words =
-      read_words_from_file(dfname, dmem_bytes / 4);
-  assert(iss_words.size() == dmem_bytes / 4);
+  const uint8_t *iss_data = iss.dump_d(dmem_bytes / 4);
 
   Ecc32MemArea::EccWords rtl_words = get_sim_memory(false);
   assert(rtl_words.size() == dmem_bytes / 4);
 
+  // The common case is that the memories match exactly, which we can check
+  // without decoding the ISS's copy.
+  std::vector<uint8_t> rtl_data = encode_words(rtl_words, true);
+  if (memcmp(rtl_data.data(), iss_data, rtl_data.size()) == 0)
+    return true;
+
+  Ecc32MemArea::EccWords iss_words = decode_words(iss_data, dmem_bytes / 4);
+  assert(iss_words.size() == dmem_bytes / 4);
+
   std::ios old_state(nullptr);
   old_state.copyfmt(std::cerr);
 
@@ -748,7 +749,13 @@ bool OtbnModel::check_dmem(ISSWrapper &iss) const {
   return bad_count == 0;
 }
 
-bool OtbnModel::check_regs(ISSWrapper &iss) const {
+bool OtbnModel::check_regs(ISSWrapper &iss, uint32_t gpr_mask,
+                           uint32_t wdr_mask) const {
+  // Register index 1 is call stack, which is checked separately
+  gpr_mask &= ~(1u << 1);
+  if (!gpr_mask && !wdr_mask)
+    return true;
+
   std::string base_scope =
       design_scope_ +
       ".u_otbn_rf_base.gen_rf_base_ff.u_otbn_rf_base_inner.u_snooper";
@@ -756,20 +763,16 @@ bool OtbnModel::check_regs(ISSWrapper &iss) const {
       design_scope_ +
       ".u_otbn_rf_bignum.gen_rf_bignum_ff.u_otbn_rf_bignum_inner.u_snooper";
 
-  auto rtl_gprs = get_rtl_regs<uint32_t>(base_scope);
-  auto rtl_wdrs = get_rtl_regs<ISSWrapper::u256_t>(wide_scope);
+  auto rtl_gprs = get_rtl_regs<uint32_t>(base_scope, gpr_mask);
+  auto rtl_wdrs = get_rtl_regs<ISSWrapper::u256_t>(wide_scope, wdr_mask);
 
-  std::array<uint32_t, 32> iss_gprs;
-  std::array<ISSWrapper::u256_t, 32> iss_wdrs;
-  iss.get_regs(&iss_gprs, &iss_wdrs);
+  std::array<uint32_t, 32> iss_gprs{};
+  std::array<ISSWrapper::u256_t, 32> iss_wdrs{};
+  iss.get_regs(&iss_gprs, &iss_wdrs, gpr_mask, wdr_mask);
 
   bool good = true;
 
   for (int i = 0; i < 32; ++i) {
-    // Register index 1 is call stack, which is checked separately
-    if (i == 1)
-      continue;
-
     if (rtl_gprs[i] != iss_gprs[i]) {
       std::ios old_state(nullptr);
       old_state.copyfmt(std::cerr);
@@ -1039,6 +1042,11 @@ int otbn_disable_stack_check(OtbnModel *model) {
   return model->disable_stack_check();
 }
 
+int otbn_enable_full_reg_check(OtbnModel *model) {
+  assert(model);
+  return model->enable_full_reg_check();
+}
+
 int otbn_model_step_crc(OtbnModel *model, svBitVecVal *item /* bit [47:0] */,
                         svBitVecVal *state /* inout bit [31:0] */) {
   assert(model && item && state);
@@ -74,7 +74,9 @@ class OtbnModel {
 
   // Check model against RTL (if there is any) when a run has finished. Prints
   // messages to stderr on failure or mismatch. Returns 1 for a match, 0 for a
-  // mismatch, -1 for some other failure.
+  // mismatch, -1 for some other failure. Unless enable_full_reg_check has been
+  // called, this only compares registers that were written since the last
+  // check, and only compares the call stack if it might have changed.
   int check() const;
 
   // Grab contents of dmem from the model and load it back into the RTL
@@ -129,6 +131,10 @@ class OtbnModel {
   // Disable stack integrity checks
   int disable_stack_check();
 
+  // Make check() compare every register and the call stack, rather than just
+  // those written since the last check. Returns 0.
+  int enable_full_reg_check();
+
  private:
   // Constructs an ISS wrapper if necessary. If something goes wrong, this
   // function prints a message and then returns null. If ensure is true, it
@@ -147,10 +153,11 @@ class OtbnModel {
   // on mismatch. Throws a std::runtime_error on failure.
   bool check_dmem(ISSWrapper &iss) const;
 
-  // Compare contents of ISS registers with those from the design. Prints
-  // messages to stderr on failure or mismatch. Returns true on success; false
-  // on mismatch. Throws a std::runtime_error on failure.
-  bool check_regs(ISSWrapper &iss) const;
+  // Compare contents of ISS registers with those from the design, for the
+  // GPRs and WDRs with bits set in gpr_mask and wdr_mask. Prints messages to
+  // stderr on failure or mismatch. Returns true on success; false on mismatch.
+  // Throws a std::runtime_error on failure.
+  bool check_regs(ISSWrapper &iss, uint32_t gpr_mask, uint32_t wdr_mask) const;
 
   // Compare contents of ISS call stack with those from the design. Prints
   // messages to stderr on failure or mismatch. Returns true on success; false
@@ -159,14 +166,19 @@ class OtbnModel {
 
   // We want to create the model in an initial block in the SystemVerilog
   // simulation, but might not actually want to spawn the ISS. To handle that
-  // in a non-racy way, the most convenient thing is to spawn the ISS the first
-  // time it's actually needed. Use ensure_wrapper() to create as needed.
+  // in a non-racy way, the most convenient thing is to attach an ISS the first
+  // time it's actually needed. Use ensure_wrapper() to create as needed. This
+  // takes a wrapper from the pool in ISSWrapper (which the constructor fills
+  // in the background) and the destructor gives it back.
   std::unique_ptr<ISSWrapper> iss_;
 
   OtbnMemUtil mem_util_;
   std::string design_scope_;
 
   bool stack_check_enabled_ = true;
+
+  // If true, check() compares all registers, not just dirty ones
+  bool full_reg_check_ = false;
 };
 
 #endif  // OPENTITAN_HW_IP_OTBN_DV_MODEL_OTBN_MODEL_H_
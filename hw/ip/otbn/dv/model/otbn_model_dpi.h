@@ -119,6 +119,11 @@ int otbn_set_no_sec_wipe_chk(OtbnModel *model);
 // Disable stack integrity checks
 int otbn_disable_stack_check(OtbnModel *model);
 
+// Compare every register on each check, rather than only those written since
+// the previous check. Tests that might change registers in a way that isn't
+// visible in the traces should use this.
+int otbn_enable_full_reg_check(OtbnModel *model);
+
 // Step the CRC calculation for item
 //
 // state is an inout parameter and should be updated in-place. This is
@@ -21,7 +21,11 @@ OtbnTraceChecker::OtbnTraceChecker()
       iss_pending_(false),
       done_(true),
       seen_err_(false),
-      last_data_vld_(false) {
+      disabled_(false),
+      last_data_vld_(false),
+      dirty_gprs_(~0u),
+      dirty_wdrs_(~0u),
+      call_stack_dirty_(true) {
   OtbnTraceSource::get().AddListener(this);
 }
 
@@ -53,6 +57,24 @@ void OtbnTraceChecker::AcceptTraceString(const std::string &trace,
     seen_err_ = true;
     return;
   }
+  trace_entry.mark_dirty_regs(&dirty_gprs_, &dirty_wdrs_, &call_stack_dirty_);
+  AcceptRtlEntry(trace_entry);
+}
+
+void OtbnTraceChecker::AcceptTraceEvent(const OtbnTraceEvent &event) {
+  assert(!(rtl_pending_ && iss_pending_));
+
+  if (seen_err_)
+    return;
+
+  done_ = false;
+  OtbnTraceEntry trace_entry;
+  trace_entry.from_rtl_event(event);
+  trace_entry.mark_dirty_regs(&dirty_gprs_, &dirty_wdrs_, &call_stack_dirty_);
+  AcceptRtlEntry(trace_entry);
+}
+
+void OtbnTraceChecker::AcceptRtlEntry(OtbnTraceEntry &trace_entry) {
   if (trace_entry.trace_type() == OtbnTraceEntry::Invalid) {
     std::cerr << "ERROR: Invalid RTL trace entry with invalid header:\n";
     trace_entry.print("  ", std::cerr);
@@ -156,6 +178,9 @@ void OtbnTraceChecker::AcceptTraceString(const std::string &trace,
 bool OtbnTraceChecker::OnIssTrace(const std::vector<std::string> &lines) {
   assert(!(rtl_pending_ && iss_pending_));
 
+  if (disabled_) {
+    return true;
+  }
   if (seen_err_) {
     return false;
   }
@@ -166,6 +191,7 @@ bool OtbnTraceChecker::OnIssTrace(const std::vector<std::string> &lines) {
     // Just return false to pass the error code along.
     return false;
   }
+  trace_entry.mark_dirty_regs(&dirty_gprs_, &dirty_wdrs_, &call_stack_dirty_);
 
   done_ = false;
 
@@ -208,6 +234,9 @@ void OtbnTraceChecker::Flush() {
   iss_pending_ = false;
   iss_started_ = false;
   no_sec_wipe_data_chk_ = false;
+  dirty_gprs_ = ~0u;
+  dirty_wdrs_ = ~0u;
+  call_stack_dirty_ = true;
 }
 
 bool OtbnTraceChecker::Finish() {
@@ -245,6 +274,29 @@ const OtbnIssTraceEntry::IssData *OtbnTraceChecker::PopIssData() {
 
 void OtbnTraceChecker::set_no_sec_wipe_chk() { no_sec_wipe_data_chk_ = true; }
 
+void OtbnTraceChecker::TakeDirtyRegs(uint32_t *gprs, uint32_t *wdrs,
+                                     bool *call_stack) {
+  assert(gprs && wdrs && call_stack);
+  if (disabled_) {
+    *gprs = *wdrs = ~0u;
+    *call_stack = true;
+    return;
+  }
+  *gprs = dirty_gprs_;
+  *wdrs = dirty_wdrs_;
+  *call_stack = call_stack_dirty_;
+  dirty_gprs_ = 0;
+  dirty_wdrs_ = 0;
+  call_stack_dirty_ = false;
+}
+
+void OtbnTraceChecker::Disable() {
+  if (!disabled_) {
+    OtbnTraceSource::get().RemoveListener(this);
+    disabled_ = true;
+  }
+}
+
 bool OtbnTraceChecker::MatchPair() {
   if (!(rtl_pending_ && iss_pending_)) {
     return true;
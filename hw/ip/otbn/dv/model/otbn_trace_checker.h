@@ -35,6 +35,7 @@
 // To catch these cases, the ISS simulation must call the Finish() method when
 // it is done (which checks there are no outstanding events missing).
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -55,6 +56,10 @@ class OtbnTraceChecker : public OtbnTraceListener {
   void AcceptTraceString(const std::string &trace,
                          unsigned int cycle_count) override;
 
+  // Take a structured trace entry from the wrapped RTL. This behaves like
+  // AcceptTraceString, but doesn't need the record in text form.
+  void AcceptTraceEvent(const OtbnTraceEvent &event) override;
+
   // Take a trace entry from the wrapped ISS.
   //
   // Prints an error message to stderr and returns false on mismatch.
@@ -80,6 +85,17 @@ class OtbnTraceChecker : public OtbnTraceListener {
   // secure wipe entry.
   void set_no_sec_wipe_chk();
 
+  // Return and clear the registers that have been written (on either side)
+  // since the last call, as masks of GPRs and WDRs, and whether the call stack
+  // might have changed. Everything is dirty before the first call and after a
+  // flush, since there may have been changes that we didn't see.
+  void TakeDirtyRegs(uint32_t *gprs, uint32_t *wdrs, bool *call_stack);
+
+  // Stop comparing RTL and ISS trace entries. The checker stops listening to
+  // the RTL, ignores ISS entries and reports every register as dirty, so that
+  // OtbnModel::check() still compares the complete final state.
+  void Disable();
+
  private:
   // If rtl_pending_ and iss_pending_ are not both true, return true
   // immediately with no other change. Otherwise, compare the two pending trace
@@ -87,6 +103,10 @@ class OtbnTraceChecker : public OtbnTraceListener {
   // message to stderr and return false.
   bool MatchPair();
 
+  // Handle a trace entry from the wrapped RTL, once it has been parsed by
+  // AcceptTraceString or AcceptTraceEvent.
+  void AcceptRtlEntry(OtbnTraceEntry &trace_entry);
+
   bool rtl_started_;
   bool rtl_pending_;
   OtbnTraceEntry rtl_entry_;
@@ -97,12 +117,19 @@ class OtbnTraceChecker : public OtbnTraceListener {
 
   bool done_;
   bool seen_err_;
+  bool disabled_;
 
   // The ISS entry for the last pair of trace entries that went through
   // MatchPair.
   bool last_data_vld_;
   OtbnIssTraceEntry::IssData last_data_;
   bool no_sec_wipe_data_chk_;
+
+  // Registers written and possible call stack changes since the last call to
+  // TakeDirtyRegs.
+  uint32_t dirty_gprs_;
+  uint32_t dirty_wdrs_;
+  bool call_stack_dirty_;
 };
 
 #endif  // OPENTITAN_HW_IP_OTBN_DV_MODEL_OTBN_TRACE_CHECKER_H_
@@ -5,31 +5,51 @@
 #include "otbn_trace_entry.h"
 
 #include <cassert>
+#include <cctype>
 #include <iostream>
-#include <regex>
 #include <sstream>
+#include <unordered_set>
+
+const std::string *OtbnTraceBodyLine::intern_loc(const char *str,
+                                                 size_t len) {
+  static std::unordered_set<std::string> locs;
+  // Element addresses in an unordered_set are stable, even across a rehash.
+  return &*locs.emplace(str, len).first;
+}
 
 bool OtbnTraceBodyLine::fill_from_string(const std::string &src,
                                          const std::string &line) {
-  // A valid line matches the following regex
-  std::regex re("(.) ([^:]+): (.+)");
-  std::smatch match;
-
-  if (!std::regex_match(line, match, re)) {
+  // A valid line has the form "T LOC: VALUE", where T is a single character,
+  // LOC is non-empty and contains no colon and VALUE is non-empty.
+  size_t colon = line.find(':', 2);
+  bool ok = line.size() > 2 && line[1] == ' ' && colon != std::string::npos &&
+            colon > 2 && line.size() > colon + 2 && line[colon + 1] == ' ' &&
+            line.find_first_of("\r\n") == std::string::npos;
+  if (!ok) {
     std::cerr << "OTBN trace body line from " << src
               << " does not have expected format. Saw: `" << line << "'.\n";
     return false;
   }
 
-  assert(match.size() == 4);
-
   raw_ = line;
-  type_ = match[1].str()[0];
-  loc_ = match[2].str();
-  value_ = match[3].str();
+  type_ = line[0];
+  loc_ = intern_loc(line.data() + 2, colon - 2);
+  value_pos_ = colon + 2;
   return true;
 }
 
+void OtbnTraceBodyLine::fill(char type, const std::string &loc,
+                             const std::string &value) {
+  raw_.assign(1, type);
+  raw_ += ' ';
+  raw_ += loc;
+  raw_ += ": ";
+  value_pos_ = raw_.size();
+  raw_ += value;
+  type_ = type;
+  loc_ = intern_loc(loc.data(), loc.size());
+}
+
 bool OtbnTraceBodyLine::operator==(const OtbnTraceBodyLine &other) const {
   // If the raw lines are identical, the two objects are identical and no
   // further checks are required.
@@ -40,25 +60,27 @@ bool OtbnTraceBodyLine::operator==(const OtbnTraceBodyLine &other) const {
   // If the raw lines are not identical, the two objects can be identical if one
   // of them contains unknown values.
 
-  // Type and location have to be identical, though.
+  // Type and location have to be identical, though. Locations are interned,
+  // so can be compared by address.
   if (type_ != other.type_ || loc_ != other.loc_) {
     return false;
   }
 
   // The values have to be of identical length.
-  if (value_.size() != other.value_.size()) {
+  size_t value_len = raw_.size() - value_pos_;
+  if (value_len != other.raw_.size() - other.value_pos_) {
     return false;
   }
 
   // Compare values digit by digit and treat `x` as unknown value, which is
   // identical to any other value.
-  std::string::const_iterator other_it = other.value_.begin();
-  for (std::string::const_iterator it = value_.begin(); it != value_.end();
-       it++) {
-    if (*it != *other_it && !(*it == 'x' || *other_it == 'x')) {
+  const char *value = raw_.data() + value_pos_;
+  const char *other_value = other.raw_.data() + other.value_pos_;
+  for (size_t i = 0; i < value_len; ++i) {
+    char c = value[i], other_c = other_value[i];
+    if (c != other_c && !(c == 'x' || other_c == 'x')) {
       return false;
     }
-    other_it++;
   }
   return true;
 }
@@ -71,14 +93,20 @@ bool OtbnTraceEntry::from_rtl_trace(const std::string &trace) {
   while (eol != std::string::npos) {
     size_t bol = eol + 1;
     eol = trace.find('\n', bol);
+
+    // Reads of x1 pop from the call stack, so we need to know about them
+    if (trace.compare(bol, 6, "< x01:") == 0)
+      reads_call_stack_ = true;
+
+    // We're only interested in register writes, so don't bother copying out
+    // any other lines.
+    if (!(bol < trace.size() && trace[bol] == '>'))
+      continue;
+
     size_t line_len =
         (eol == std::string::npos) ? std::string::npos : eol - bol;
     std::string line = trace.substr(bol, line_len);
 
-    // We're only interested in register writes
-    if (!(line.size() > 0 && line[0] == '>'))
-      continue;
-
     OtbnTraceBodyLine parsed_line;
     if (!parsed_line.fill_from_string("RTL", line)) {
       return false;
@@ -88,6 +116,35 @@ bool OtbnTraceEntry::from_rtl_trace(const std::string &trace) {
   return true;
 }
 
+void OtbnTraceEntry::from_rtl_event(const OtbnTraceEvent &event) {
+  // The first line of the record is the first header if there is one, or a
+  // stray change header if there are only body lines (see
+  // OtbnTraceEvent::ToString).
+  if (!event.headers.empty()) {
+    hdr_ = event.headers.front().ToString();
+  } else {
+    hdr_ = event.accesses.empty() ? "" : "Z ";
+  }
+  trace_type_ = hdr_to_trace_type(hdr_);
+  writes_.clear();
+  reads_call_stack_ = false;
+
+  std::string loc, value;
+  for (const OtbnTraceAccess &access : event.accesses) {
+    if (access.prefix == '<' && access.space == OtbnTraceAccess::Gpr &&
+        access.index == 1)
+      reads_call_stack_ = true;
+
+    if (access.prefix != '>')
+      continue;
+
+    access.Format(&loc, &value);
+    OtbnTraceBodyLine line;
+    line.fill(access.prefix, loc, value);
+    writes_[line.get_loc()].push_back(line);
+  }
+}
+
 bool OtbnTraceEntry::compare_rtl_iss_entries(const OtbnTraceEntry &other,
                                              bool no_sec_wipe_data_chk,
                                              std::string *err_desc) const {
@@ -221,6 +278,34 @@ bool OtbnTraceEntry::is_final() const {
           (trace_type_ == OtbnTraceEntry::Stray));
 }
 
+void OtbnTraceEntry::mark_dirty_regs(uint32_t *gprs, uint32_t *wdrs,
+                                     bool *call_stack) const {
+  assert(gprs && wdrs && call_stack);
+
+  if (reads_call_stack_)
+    *call_stack = true;
+
+  // Register locations are an 'x' or 'w' followed by two decimal digits. Any
+  // other location (an ISPR or flag group) isn't part of the register files.
+  for (const auto &write : writes_) {
+    const std::string &loc = write.first;
+    if (loc.size() != 3 || !isdigit(loc[1]) || !isdigit(loc[2]))
+      continue;
+
+    unsigned idx = 10 * (loc[1] - '0') + (loc[2] - '0');
+    if (idx >= 32)
+      continue;
+
+    if (loc[0] == 'x') {
+      *gprs |= 1u << idx;
+      if (idx == 1)
+        *call_stack = true;
+    } else if (loc[0] == 'w') {
+      *wdrs |= 1u << idx;
+    }
+  }
+}
+
 bool OtbnTraceEntry::check_entries_compatible(
     trace_type_t type, const std::string &key,
     const std::vector<OtbnTraceBodyLine> &rtl_lines,
@@ -294,14 +379,45 @@ OtbnTraceEntry::trace_type_t OtbnTraceEntry::hdr_to_trace_type(
   }
 }
 
+// Parse a "special" ISS line of the form "# @0x" ADDR ": " MNEMONIC, where
+// ADDR is exactly 8 lowercase hex digits, into *data. Returns false if the
+// line doesn't have that form.
+static bool read_special_line(const std::string &line,
+                              OtbnIssTraceEntry::IssData *data) {
+  static const char prefix[] = "# @0x";
+  const size_t prefix_len = sizeof prefix - 1;
+  const size_t addr_end = prefix_len + 8;
+
+  if (line.size() < addr_end + 2 || line.compare(0, prefix_len, prefix) != 0 ||
+      line[addr_end] != ':' || line[addr_end + 1] != ' ' ||
+      line.find_first_of("\r\n") != std::string::npos) {
+    return false;
+  }
+
+  uint32_t addr = 0;
+  for (size_t i = prefix_len; i < addr_end; ++i) {
+    char c = line[i];
+    uint32_t digit;
+    if ('0' <= c && c <= '9') {
+      digit = c - '0';
+    } else if ('a' <= c && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else {
+      return false;
+    }
+    addr = (addr << 4) | digit;
+  }
+
+  data->insn_addr = addr;
+  data->mnemonic.assign(line, addr_end + 2, std::string::npos);
+  return true;
+}
+
 bool OtbnIssTraceEntry::from_iss_trace(const std::vector<std::string> &lines) {
   // Read FSM. state 0 = read header; state 1 = read mnemonic (for E
   // lines); state 2 = read writes
   int state = 0;
 
-  std::regex re("# @0x([0-9a-f]{8}): (.*)");
-  std::smatch match;
-
   for (const std::string &line : lines) {
     switch (state) {
       case 0:
@@ -318,15 +434,11 @@ bool OtbnIssTraceEntry::from_iss_trace(const std::vector<std::string> &lines) {
         //
         // where ADDR is an 8-digit instruction address (in hex) and mnemonic
         // is the string mnemonic.
-        if (!std::regex_match(line, match, re)) {
+        if (!read_special_line(line, &data_)) {
           std::cerr << "Bad 'special' line for ISS trace with header `" << hdr_
                     << "': `" << line << "'.\n";
           return false;
         }
-        assert(match.size() == 3);
-        data_.insn_addr =
-            (uint32_t)strtoul(match[1].str().c_str(), nullptr, 16);
-        data_.mnemonic = match[2].str();
         state = 2;
         break;
 
@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 
+#include "otbn_trace_event.h"
+
 // This models a body line in an OTBN trace entry (type '<', '>', 'R' or 'W').
 // Each of these lines is of the format
 //
@@ -24,19 +26,30 @@ class OtbnTraceBodyLine {
   // say where the line came from) and return false.
   bool fill_from_string(const std::string &src, const std::string &line);
 
+  // Fill this object from the parts of a line that is known to be well-formed
+  // (such as one generated from an OtbnTraceAccess).
+  void fill(char type, const std::string &loc, const std::string &value);
+
   bool operator==(const OtbnTraceBodyLine &other) const;
 
   // Return the location that is being read or written
-  const std::string &get_loc() const { return loc_; }
+  const std::string &get_loc() const { return *loc_; }
 
   // Return the original string format for the entry
   const std::string &get_string() const { return raw_; }
 
  private:
+  // Return a pointer to the single copy of the location name len bytes long
+  // at str. There are only a few dozen of these (register names and the
+  // like), so interning them means that each line only stores a pointer and
+  // locations can be compared by address.
+  static const std::string *intern_loc(const char *str, size_t len);
+
   std::string raw_;
   char type_;
-  std::string loc_;
-  std::string value_;
+  const std::string *loc_;
+  // The value is the rest of raw_, starting at this offset
+  size_t value_pos_;
 };
 
 class OtbnTraceEntry {
@@ -56,6 +69,11 @@ class OtbnTraceEntry {
   // message to stderr and return false.
   bool from_rtl_trace(const std::string &trace);
 
+  // Fill this object from a structured trace record from the RTL. This gives
+  // the same result as from_rtl_trace on the string form of the record, but
+  // only formats the header and register writes.
+  void from_rtl_event(const OtbnTraceEvent &event);
+
   bool compare_rtl_iss_entries(const OtbnTraceEntry &other,
                                bool no_sec_wipe_data_chk,
                                std::string *err_desc) const;
@@ -76,6 +94,12 @@ class OtbnTraceEntry {
   // True if this entry is "final" (Exec or WipeComplete)
   bool is_final() const;
 
+  // Set bit i of *gprs for each write to xi and bit i of *wdrs for each write
+  // to wi. Set *call_stack if the entry might have pushed to or popped from
+  // the call stack (for an RTL entry, a read or write of x1; the ISS trace
+  // doesn't show reads, so only a write for an ISS entry).
+  void mark_dirty_regs(uint32_t *gprs, uint32_t *wdrs, bool *call_stack) const;
+
  protected:
   static bool check_entries_compatible(
       trace_type_t type, const std::string &key,
@@ -87,6 +111,8 @@ class OtbnTraceEntry {
 
   trace_type_t trace_type_;
   std::string hdr_;
+  // True if the entry included a read of x1 (which pops from the call stack)
+  bool reads_call_stack_ = false;
   // The register writes for this trace entry, keyed by destination
   std::map<std::string, std::vector<OtbnTraceBodyLine>> writes_;
 };
@@ -5,6 +5,7 @@
 from typing import Dict, List, Optional
 
 from .constants import ErrBits
+from .loop_profile import LoopProfile
 from .trace import Trace
 
 
@@ -71,6 +72,10 @@ class LoopStack:
         self.err_flag = False
         self._pop_stack_on_commit = False
 
+        # If this is not None, it records the start of each loop (used to
+        # generate loop warp files)
+        self.profile = None  # type: Optional[LoopProfile]
+
     def start_loop(self,
                    start_addr: int,
                    loop_count: int,
@@ -93,6 +98,8 @@ class LoopStack:
             self.err_flag = True
 
         self.trace.append(TraceLoopStart(depth, loop_count, insn_count))
+        if self.profile is not None:
+            self.profile.on_loop_start(start_addr, loop_count)
         self.stack.append(LoopLevel(start_addr, insn_count, loop_count - 1))
 
     def is_last_insn_in_loop_body(self, pc: int) -> bool:
@@ -0,0 +1,140 @@
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''Loop profiling, used to generate loop warp files
+
+A loop warp file is a text file with one warp per line, in the form
+
+  ADDR FROM TO
+
+where ADDR is the address where the warp applies (usually written in hex with
+a 0x prefix) and FROM and TO are decimal iteration counts, with the same
+meaning as for _loop_warp_FROM_TO symbols (see sim.py). Blank lines and
+anything after a '#' are ignored. The same files are read by otbn_top_sim
+(with --otbn-loop-warps) and by OtbnMemUtil::LoadLoopWarpFile.
+
+'''
+
+from typing import Dict, List, Optional, Set, TextIO, Tuple
+
+# A loop warp as it appears in a file: (addr, from_cnt, to_cnt)
+LoopWarp = Tuple[int, int, int]
+
+
+class LoopRecord:
+    '''What we have seen of the loop whose body starts at some address'''
+    def __init__(self, iterations: int) -> None:
+        self.entries = 1
+        self.min_iterations = iterations
+        self.max_iterations = iterations
+
+    def add(self, iterations: int) -> None:
+        self.entries += 1
+        self.min_iterations = min(self.min_iterations, iterations)
+        self.max_iterations = max(self.max_iterations, iterations)
+
+
+class LoopProfile:
+    '''Iteration counts for the loops that are started during a run'''
+    def __init__(self) -> None:
+        # Keyed by the address of the first instruction in the loop body
+        self.loops = {}  # type: Dict[int, LoopRecord]
+
+    def on_loop_start(self, start_addr: int, iterations: int) -> None:
+        rec = self.loops.get(start_addr)
+        if rec is None:
+            self.loops[start_addr] = LoopRecord(iterations)
+        else:
+            rec.add(iterations)
+
+    def get_warps(self,
+                  min_iterations: int,
+                  existing: Dict[int, Dict[int, int]]) -> List[LoopWarp]:
+        '''Pick warps that skip the middle iterations of hot loops
+
+        A loop is warped if it ran with the same number of iterations (at
+        least min_iterations) every time that it was started. The warp runs
+        the first iteration and then jumps to the last one, so each loop
+        still runs its body twice. Loops whose bodies start with another loop
+        instruction are skipped (a warp at that address would apply to the
+        inner loop), as are loops that already have warps in existing.
+
+        Since a warp skips iterations, a warped program will usually compute
+        something different. These warps are meant for runs where that is
+        acceptable, such as delay loops or long tests where both RTL and ISS
+        apply the same warps and are compared against each other.
+
+        '''
+        assert min_iterations >= 3
+
+        ret = []  # type: List[LoopWarp]
+        for start_addr, rec in sorted(self.loops.items()):
+            if rec.min_iterations != rec.max_iterations:
+                continue
+            if rec.max_iterations < min_iterations:
+                continue
+            if start_addr in existing:
+                continue
+
+            # If the first instruction of the body is itself a loop
+            # instruction, the inner loop's body starts just after it.
+            if start_addr + 4 in self.loops:
+                continue
+
+            ret.append((start_addr, 1, rec.max_iterations - 1))
+
+        return ret
+
+    def dump(self, tgt: TextIO) -> None:
+        '''Write a human-readable summary of the loops that were seen'''
+        tgt.write('# Loops seen (body start address, times started, '
+                  'iterations)\n')
+        for start_addr, rec in sorted(self.loops.items()):
+            if rec.min_iterations == rec.max_iterations:
+                iters = str(rec.min_iterations)
+            else:
+                iters = '{}-{}'.format(rec.min_iterations, rec.max_iterations)
+            tgt.write('#   {:#06x}: {} x {}\n'
+                      .format(start_addr, rec.entries, iters))
+
+
+def write_loop_warps(tgt: TextIO, warps: List[LoopWarp]) -> None:
+    '''Write warps in the loop warp file format'''
+    for addr, from_cnt, to_cnt in warps:
+        tgt.write('{:#x} {} {}\n'.format(addr, from_cnt, to_cnt))
+
+
+def read_loop_warps(src: TextIO) -> List[LoopWarp]:
+    '''Read warps in the loop warp file format
+
+    Raises a ValueError if the file is malformed.
+
+    '''
+    ret = []  # type: List[LoopWarp]
+    seen = set()  # type: Set[Tuple[int, int]]
+    for line_no, line in enumerate(src, 1):
+        fields = line.split('#', 1)[0].split()
+        if not fields:
+            continue
+
+        warp = None  # type: Optional[LoopWarp]
+        if len(fields) == 3:
+            try:
+                warp = (int(fields[0], 0), int(fields[1]), int(fields[2]))
+            except ValueError:
+                pass
+
+        if warp is None or not (0 <= warp[0] and 0 <= warp[1] <= warp[2]):
+            raise ValueError('{}:{}: Bad loop warp line. Expected '
+                             'ADDR FROM TO, with FROM <= TO.'
+                             .format(src.name, line_no))
+
+        if warp[:2] in seen:
+            raise ValueError('{}:{}: Duplicate loop warp for address {:#x} '
+                             'and initial count {}.'
+                             .format(src.name, line_no, warp[0], warp[1]))
+        seen.add(warp[:2])
+        ret.append(warp)
+
+    return ret
@@ -7,6 +7,7 @@ import argparse
 import sys
 
 from sim.load_elf import load_elf
+from sim.loop_profile import LoopProfile, read_loop_warps, write_loop_warps
 from sim.standalonesim import StandaloneSim
 from sim.stats import ExecutionStatAnalyzer
 
@@ -36,13 +37,60 @@ def main() -> int:
         help=("after execution, write execution statistics to this file. "
               "Use '-' to write to STDOUT.")
     )
+    parser.add_argument(
+        '--loop-warps',
+        metavar="FILE",
+        type=argparse.FileType('r'),
+        help=("apply loop warps from this file, as well as any given by "
+              "symbols in the ELF file.")
+    )
+    parser.add_argument(
+        '--profile-loops',
+        metavar="FILE",
+        type=argparse.FileType('w'),
+        help=("after execution, write a loop warp file to FILE that skips "
+              "the middle iterations of hot loops. Use '-' to write to "
+              "STDOUT.")
+    )
+    parser.add_argument(
+        '--profile-loops-min',
+        metavar="N",
+        type=int,
+        default=16,
+        help=("with --profile-loops, only warp loops that run at least N "
+              "iterations (default: %(default)s).")
+    )
 
     args = parser.parse_args()
 
     collect_stats = args.dump_stats is not None
 
+    if args.profile_loops is not None and args.profile_loops_min < 3:
+        print('--profile-loops-min must be at least 3.', file=sys.stderr)
+        return 1
+
     sim = StandaloneSim()
     exp_end_addr = load_elf(sim, args.elf)
+
+    if args.loop_warps is not None:
+        try:
+            file_warps = read_loop_warps(args.loop_warps)
+        except ValueError as err:
+            print(err, file=sys.stderr)
+            return 1
+        for addr, from_cnt, to_cnt in file_warps:
+            if from_cnt in sim.loop_warps.get(addr, {}):
+                print('Loop warp for address {:#x} and initial count {} in {} '
+                      'is already defined.'
+                      .format(addr, from_cnt, args.loop_warps.name),
+                      file=sys.stderr)
+                return 1
+            sim.add_loop_warp(addr, from_cnt, to_cnt)
+
+    profile = None
+    if args.profile_loops is not None:
+        profile = LoopProfile()
+        sim.state.loop_stack.profile = profile
     key0 = int((str("deadbeef") * 12), 16)
     key1 = int((str("baadf00d") * 12), 16)
     sim.state.wsrs.set_sideload_keys(key0, key1)
@@ -67,6 +115,12 @@ def main() -> int:
         stat_analyzer = ExecutionStatAnalyzer(sim.stats, args.elf)
         args.dump_stats.write(stat_analyzer.dump())
 
+    if profile is not None:
+        profile.dump(args.profile_loops)
+        write_loop_warps(args.profile_loops,
+                         profile.get_warps(args.profile_loops_min,
+                                           sim.loop_warps))
+
     return 0
 
 
@@ -17,6 +17,10 @@ prefixed with "0x" if they are hexadecimal.
     step                    Run one instruction. Print trace information to
                             stdout.
 
+    step_batch <max>        Run up to <max> cycles, stopping early after any
+                            cycle that the outside world might react to (see
+                            below). Only supported with --binary.
+
     load_elf <path>         Load the ELF file at <path>, replacing current
                             contents of DMEM and IMEM.
 
@@ -37,7 +41,16 @@ prefixed with "0x" if they are hexadecimal.
     dump_d <path>           Write the current contents of DMEM to <path> (same
                             format as for load).
 
-    print_regs              Write the hex contents of all registers to stdout
+    load_d_shm <len>        Like load_d, load_i and dump_d, but reading or
+    load_i_shm <len>        writing the first <len> bytes of the region shared
+    dump_d_shm <len>        with the process that started us (see --shm-fd)
+                            instead of a file. For dump_d_shm, <len> must be
+                            the size of the dump.
+
+    print_regs [<gprs> <wdrs>]
+                            Write the hex contents of all registers to stdout.
+                            If <gprs> and <wdrs> are given, they are bit masks
+                            and only the selected registers are written.
 
     edn_rnd_step            Send 32b RND Data to the model.
 
@@ -70,15 +83,92 @@ prefixed with "0x" if they are hexadecimal.
     send_err_escalation     React to an injected error.
 
     set_software_errs_fatal Set software_errs_fatal bit.
+
+When run with --shm-fd <fd>, <fd> is an open file descriptor for a shared
+memory object, which is mapped for the *_shm commands.
+
+When run with --binary, commands are read in the same way but each response
+is written as a binary frame instead of lines of text terminated by ".". A
+frame is a little-endian header of a 32-bit payload length and an 8-bit kind,
+followed by the payload. Most commands give a FRAME_TEXT payload, which is the
+text that would have been printed (without the terminator). The step command
+gives a FRAME_STEP payload with a fixed layout of 32-bit words:
+
+    valid                   Bitmask of the mirrored registers below that were
+                            written during the cycle (bit i for values[i])
+
+    values[6]               STATUS, INSN_CNT, ERR_BITS, STOP_PC, RND_REQ and
+                            WIPE_START, as last written during the cycle
+
+    num_lines               Number of trace lines
+
+    offsets[num_lines + 1]  Offset of each trace line, then the end of the last
+                            one, within the trace text that follows
+
+followed by the trace text itself, with no separators between lines. This
+saves the other side from parsing trace text just to track those registers.
+
+The step_batch command gives a FRAME_BATCH payload. This is a 32-bit count of
+cycles, then for each cycle a 32-bit length and a FRAME_STEP payload. The batch
+only continues while OTBN is executing code and the cycle just run changed no
+external register other than INSN_CNT, with no RND request outstanding. Any
+other cycle (an EDN request, a change of STATUS or ERR_BITS, the end of the
+operation, ...) is the last one in the batch.
 '''
 
+import argparse
 import binascii
+import contextlib
+import io
+import mmap
+import struct
 import sys
-from typing import List, Optional
+from typing import List, Optional, Tuple
 
-from sim.decode import decode_file
+from sim.decode import decode_bytes, decode_file
+from sim.ext_regs import TraceExtRegChange
 from sim.load_elf import load_elf
 from sim.sim import OTBNSim
+from sim.state import FsmState
+
+# Kinds of binary response frame (see the module docstring)
+FRAME_TEXT = 0
+FRAME_STEP = 1
+FRAME_BATCH = 2
+
+# Mirrored registers reported in FRAME_STEP payloads, in order
+_STEP_REGS = ['STATUS', 'INSN_CNT', 'ERR_BITS', 'STOP_PC', 'RND_REQ',
+              'WIPE_START']
+
+
+class SharedMem:
+    '''A shared memory region, passed to us as a file descriptor'''
+    def __init__(self, fd: int) -> None:
+        self.fd = fd
+        self.buf = None  # type: Optional[mmap.mmap]
+
+    def view(self, length: int) -> mmap.mmap:
+        '''Return a mapping of at least the first length bytes
+
+        The other side grows the region before asking us to use more of it, so
+        remap if our current mapping is too small.
+
+        '''
+        if self.buf is None or len(self.buf) < length:
+            if self.buf is not None:
+                self.buf.close()
+            self.buf = mmap.mmap(self.fd, length)
+        return self.buf
+
+
+# The region given with --shm-fd, if any
+_SHARED_MEM = None  # type: Optional[SharedMem]
+
+
+def get_shared_mem(cmd: str) -> SharedMem:
+    if _SHARED_MEM is None:
+        raise RuntimeError(f'{cmd} needs a shared memory region (--shm-fd).')
+    return _SHARED_MEM
 
 
 def read_word(arg_name: str, word_data: str, bits: int) -> int:
@@ -132,10 +222,13 @@ def on_start_operation(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     return None
 
 
-def on_step(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
-    '''Step one instruction'''
-    check_arg_count('step', 0, args)
+def step_trace(sim: OTBNSim) -> Tuple[List[str], List[TraceExtRegChange]]:
+    '''Step one instruction, returning its trace lines
 
+    Also returns any changes to external registers, which also appear in the
+    trace lines.
+
+    '''
     pc = sim.state.pc
     assert 0 == pc & 3
 
@@ -173,14 +266,75 @@ def on_step(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     if hdr is None and rtl_changes:
         hdr = 'STALL'
 
-    if hdr is not None:
-        print(hdr)
-        for rt in rtl_changes:
-            print(rt)
+    ext_changes = [c for c in changes if isinstance(c, TraceExtRegChange)]
+    return ([] if hdr is None else [hdr] + rtl_changes), ext_changes
+
+
+def on_step(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
+    '''Step one instruction'''
+    check_arg_count('step', 0, args)
+
+    lines, _ = step_trace(sim)
+    for line in lines:
+        print(line)
 
     return None
 
 
+def on_step_batch(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
+    '''Step several cycles (only meaningful with binary responses)'''
+    raise RuntimeError('step_batch is only supported with --binary.')
+
+
+def _step_payload(lines: List[str],
+                  ext_changes: List[TraceExtRegChange]) -> bytes:
+    '''Encode the results of a single cycle as a FRAME_STEP payload'''
+    valid = 0
+    values = [0] * len(_STEP_REGS)
+    for change in ext_changes:
+        if change.name in _STEP_REGS:
+            idx = _STEP_REGS.index(change.name)
+            valid |= 1 << idx
+            values[idx] = change.erc.new_value
+
+    encoded = [line.encode('utf-8') for line in lines]
+    offsets = [0]
+    for line_bytes in encoded:
+        offsets.append(offsets[-1] + len(line_bytes))
+
+    words = [valid] + values + [len(lines)] + offsets
+    return struct.pack('<{}I'.format(len(words)), *words) + b''.join(encoded)
+
+
+def binary_step(sim: OTBNSim) -> bytes:
+    '''Step one instruction, returning a FRAME_STEP payload'''
+    return _step_payload(*step_trace(sim))
+
+
+def binary_step_batch(sim: OTBNSim, max_cycles: int) -> bytes:
+    '''Step up to max_cycles cycles, returning a FRAME_BATCH payload'''
+    steps = []
+    while len(steps) < max_cycles:
+        lines, ext_changes = step_trace(sim)
+        steps.append(_step_payload(lines, ext_changes))
+
+        # Stop after any cycle whose effects might be visible outside OTBN.
+        # INSN_CNT changes on most cycles, but nothing outside OTBN reacts to
+        # it.
+        if any(change.name != 'INSN_CNT' for change in ext_changes):
+            break
+        if sim.state.get_fsm_state() != FsmState.EXEC:
+            break
+        if sim.state.ext_regs.read('RND_REQ', True):
+            break
+
+    parts = [struct.pack('<I', len(steps))]
+    for step in steps:
+        parts.append(struct.pack('<I', len(step)))
+        parts.append(step)
+    return b''.join(parts)
+
+
 def on_load_elf(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     '''Load contents of ELF at path given by only argument'''
     check_arg_count('load_elf', 1, args)
@@ -251,6 +405,49 @@ def on_load_i(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     return None
 
 
+def on_load_d_shm(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
+    '''Load contents of data memory from the shared memory region'''
+    check_arg_count('load_d_shm', 1, args)
+
+    length = read_word('len', args[0], 32)
+    buf = get_shared_mem('load_d_shm').view(length)
+
+    print('LOAD_D_SHM {}'.format(length))
+    sim.load_data(buf[:length], has_validity=True)
+
+    return None
+
+
+def on_load_i_shm(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
+    '''Load contents of insn memory from the shared memory region'''
+    check_arg_count('load_i_shm', 1, args)
+
+    length = read_word('len', args[0], 32)
+    buf = get_shared_mem('load_i_shm').view(length)
+
+    print('LOAD_I_SHM {}'.format(length))
+    sim.load_program(decode_bytes(0, buf[:length], 'shared memory'))
+
+    return None
+
+
+def on_dump_d_shm(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
+    '''Dump contents of data memory to the shared memory region'''
+    check_arg_count('dump_d_shm', 1, args)
+
+    length = read_word('len', args[0], 32)
+    data = sim.state.dmem.dump_le_words()
+    if len(data) != length:
+        raise ValueError('dump_d_shm was given a length of {}, but the '
+                         'dump is {} bytes.'.format(length, len(data)))
+    buf = get_shared_mem('dump_d_shm').view(length)
+
+    print('DUMP_D_SHM {}'.format(length))
+    buf[:length] = data
+
+    return None
+
+
 def on_dump_d(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     '''Dump contents of data memory to file at path given by only argument'''
     check_arg_count('dump_d', 1, args)
@@ -266,14 +463,27 @@ def on_dump_d(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
 
 
 def on_print_regs(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
-    '''Print registers to stdout'''
-    check_arg_count('print_regs', 0, args)
+    '''Print registers to stdout
+
+    With no arguments, this prints every register. Otherwise, the arguments
+    are a mask of GPRs and a mask of WDRs, and only registers whose bits are
+    set are printed.
+
+    '''
+    if args:
+        check_arg_count('print_regs', 2, args)
+        gpr_mask = read_word('gpr_mask', args[0], 32)
+        wdr_mask = read_word('wdr_mask', args[1], 32)
+    else:
+        gpr_mask = wdr_mask = (1 << 32) - 1
 
     print('PRINT_REGS')
     for idx, value in enumerate(sim.state.gprs.peek_unsigned_values()):
-        print(' x{:<2} = 0x{:08x}'.format(idx, value))
+        if (gpr_mask >> idx) & 1:
+            print(' x{:<2} = 0x{:08x}'.format(idx, value))
     for idx, value in enumerate(sim.state.wdrs.peek_unsigned_values()):
-        print(' w{:<2} = 0x{:064x}'.format(idx, value))
+        if (wdr_mask >> idx) & 1:
+            print(' w{:<2} = 0x{:064x}'.format(idx, value))
 
     return None
 
@@ -406,12 +616,16 @@ _HANDLERS = {
     'start_operation': on_start_operation,
     'otp_key_cdc_done': on_otp_cdc_done,
     'step': on_step,
+    'step_batch': on_step_batch,
     'load_elf': on_load_elf,
     'add_loop_warp': on_add_loop_warp,
     'clear_loop_warps': on_clear_loop_warps,
     'load_d': on_load_d,
     'load_i': on_load_i,
     'dump_d': on_dump_d,
+    'load_d_shm': on_load_d_shm,
+    'load_i_shm': on_load_i_shm,
+    'dump_d_shm': on_dump_d_shm,
     'print_regs': on_print_regs,
     'print_call_stack': on_print_call_stack,
     'reset': on_reset,
@@ -431,7 +645,13 @@ _HANDLERS = {
 }
 
 
-def on_input(sim: OTBNSim, line: str) -> Optional[OTBNSim]:
+def write_frame(kind: int, payload: bytes) -> None:
+    '''Write a binary response frame to stdout and flush'''
+    sys.stdout.buffer.write(struct.pack('<IB', len(payload), kind) + payload)
+    sys.stdout.buffer.flush()
+
+
+def on_input(sim: OTBNSim, line: str, binary: bool) -> Optional[OTBNSim]:
     '''Process an input command'''
     words = line.split()
 
@@ -444,18 +664,48 @@ def on_input(sim: OTBNSim, line: str) -> Optional[OTBNSim]:
     if handler is None:
         raise RuntimeError('Unknown command: {!r}'.format(verb))
 
-    ret = handler(sim, words[1:])
-    print('.')
-    sys.stdout.flush()
+    if not binary:
+        ret = handler(sim, words[1:])
+        end_command()
+        return ret
+
+    if verb == 'step':
+        check_arg_count('step', 0, words[1:])
+        write_frame(FRAME_STEP, binary_step(sim))
+        return None
 
+    if verb == 'step_batch':
+        check_arg_count('step_batch', 1, words[1:])
+        max_cycles = read_word('max', words[1], 32)
+        if max_cycles == 0:
+            raise ValueError('step_batch needs a nonzero cycle count.')
+        write_frame(FRAME_BATCH, binary_step_batch(sim, max_cycles))
+        return None
+
+    # Other commands are rare, so just capture whatever they print.
+    text = io.StringIO()
+    with contextlib.redirect_stdout(text):
+        ret = handler(sim, words[1:])
+    write_frame(FRAME_TEXT, text.getvalue().rstrip('\n').encode('utf-8'))
     return ret
 
 
 def main() -> int:
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--binary', action='store_true',
+                        help='Write responses as binary frames')
+    parser.add_argument('--shm-fd', type=int,
+                        help='File descriptor of a shared memory region')
+    args = parser.parse_args()
+
+    global _SHARED_MEM
+    if args.shm_fd is not None:
+        _SHARED_MEM = SharedMem(args.shm_fd)
+
     sim = OTBNSim()
     try:
         for line in sys.stdin:
-            ret = on_input(sim, line)
+            ret = on_input(sim, line, args.binary)
             if ret is not None:
                 sim = ret
 
@@ -0,0 +1,102 @@
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''Test loop profiling and loop warp files.'''
+
+import io
+
+import py
+import pytest
+
+from sim.loop_profile import LoopProfile, read_loop_warps, write_loop_warps
+from testutil import prepare_sim_for_asm_str
+
+_NESTED_LOOPS_ASM = """
+    /* An outer loop of 4 iterations whose body starts with an inner loop of
+       20 iterations, then a loop of 100 iterations. */
+    loopi 4, 3
+      loopi 20, 1
+        addi x2, x2, 1
+      addi x3, x3, 1
+
+    loopi 100, 1
+      addi x4, x4, 1
+
+    ecall
+"""
+
+
+def test_get_warps() -> None:
+    '''Check which loops get warped.'''
+    profile = LoopProfile()
+
+    # A hot loop that always runs the same number of iterations
+    for _ in range(3):
+        profile.on_loop_start(0x10, 50)
+
+    # A loop whose iteration count changes
+    profile.on_loop_start(0x20, 50)
+    profile.on_loop_start(0x20, 60)
+
+    # A loop that isn't hot enough
+    profile.on_loop_start(0x30, 5)
+
+    # A loop whose body starts with the loop instruction at 0x40
+    profile.on_loop_start(0x40, 50)
+    profile.on_loop_start(0x44, 50)
+
+    # A hot loop that already has a warp
+    profile.on_loop_start(0x50, 50)
+
+    warps = profile.get_warps(16, {0x50: {3: 10}})
+    assert warps == [(0x10, 1, 49), (0x44, 1, 49)]
+
+
+def test_warp_file_round_trip() -> None:
+    '''Check that warp files can be read back after being written.'''
+    warps = [(0x10, 1, 49), (0x44, 2, 3)]
+    buf = io.StringIO()
+    write_loop_warps(buf, warps)
+
+    text = '# A comment\n\n' + buf.getvalue() + '0x80 0 0  # trailing\n'
+    src = io.StringIO(text)
+    src.name = 'warps.txt'
+    assert read_loop_warps(src) == warps + [(0x80, 0, 0)]
+
+
+@pytest.mark.parametrize('text', ['0x10 1\n', '0x10 5 1\n', 'foo 1 2\n',
+                                  '0x10 1 2\n0x10 1 3\n'])
+def test_bad_warp_file(text: str) -> None:
+    '''Check that malformed warp files are rejected.'''
+    src = io.StringIO(text)
+    src.name = 'warps.txt'
+    with pytest.raises(ValueError):
+        read_loop_warps(src)
+
+
+def test_profile_and_warp(tmpdir: py.path.local) -> None:
+    '''Profile a program, then check the warps it generates are applied.'''
+    sim = prepare_sim_for_asm_str(_NESTED_LOOPS_ASM, tmpdir, True)
+    profile = LoopProfile()
+    sim.state.loop_stack.profile = profile
+    sim.run(verbose=False, dump_file=None)
+    assert sim.state.ext_regs.read('ERR_BITS', False) == 0
+    assert sim.stats is not None
+    assert sim.stats.get_insn_count() == 2 + 4 * 22 + 100 + 1
+
+    warps = profile.get_warps(16, sim.loop_warps)
+
+    # The outer loop isn't hot and the inner loop starts at its first
+    # instruction, so the inner loop and the last loop get warped.
+    assert warps == [(0x8, 1, 19), (0x14, 1, 99)]
+
+    sim = prepare_sim_for_asm_str(_NESTED_LOOPS_ASM, tmpdir, True)
+    for addr, from_cnt, to_cnt in warps:
+        sim.add_loop_warp(addr, from_cnt, to_cnt)
+    sim.run(verbose=False, dump_file=None)
+    assert sim.state.ext_regs.read('ERR_BITS', False) == 0
+
+    # Each warped loop runs its first and last iterations
+    assert sim.stats is not None
+    assert sim.stats.get_insn_count() == 2 + 4 * 4 + 2 + 1
@@ -35,6 +35,13 @@ class LogTraceListener : public OtbnTraceListener {
   LogTraceListener(const std::string &log_filename);
   void AcceptTraceString(const std::string &trace,
                          unsigned int cycle_count) override;
+
+  /**
+   * Write a trace record to os in the format described above. This is also
+   * used by listeners that store the same text in other ways.
+   */
+  static void WriteTrace(std::ostream &os, const std::string &trace,
+                         unsigned int cycle_count);
 };
 
 #endif  // OPENTITAN_HW_IP_OTBN_DV_TRACER_CPP_LOG_TRACE_LISTENER_H_
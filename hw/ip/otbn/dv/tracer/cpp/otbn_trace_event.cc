@@ -0,0 +1,212 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "otbn_trace_event.h"
+
+#include <cassert>
+#include <cstdio>
+
+// Names for ISPRs, indexed by otbn_pkg::ispr_e. This must be kept in sync
+// with otbn_pkg.sv.
+static const char *const ispr_names[] = {"MOD", "RND", "ACC", "FLAGS", "URND"};
+static const unsigned num_ispr_names =
+    sizeof(ispr_names) / sizeof(ispr_names[0]);
+static const unsigned ispr_flags = 3;
+
+// Append the 32 bits of a four-state word as 8 hex digits, following the
+// SystemVerilog rules for %x: a digit is 'x' or 'z' if all of its bits are X
+// or Z, and otherwise 'X' or 'Z' if some of them are.
+static void append_hex_word(std::string *dst, uint32_t aval, uint32_t bval) {
+  static const char digits[] = "0123456789abcdef";
+  for (int shift = 28; shift >= 0; shift -= 4) {
+    unsigned a = (aval >> shift) & 0xf;
+    unsigned b = (bval >> shift) & 0xf;
+    unsigned x_bits = a & b;
+    unsigned z_bits = ~a & b;
+
+    char c;
+    if (!b) {
+      c = digits[a];
+    } else if (x_bits == 0xf) {
+      c = 'x';
+    } else if (z_bits == 0xf) {
+      c = 'z';
+    } else {
+      c = x_bits ? 'X' : 'Z';
+    }
+    dst->push_back(c);
+  }
+}
+
+// Append a WLEN-bit value as 32-bit chunks, most significant first, separated
+// with '_'.
+static void append_wlen(std::string *dst, const OtbnTraceValue &value) {
+  *dst += "0x";
+  for (int i = OtbnTraceValue::kNumWords - 1; i >= 0; --i) {
+    append_hex_word(dst, value.aval[i], value.bval[i]);
+    if (i) {
+      dst->push_back('_');
+    }
+  }
+}
+
+// Append a single bit of a four-state value, as SystemVerilog formats a
+// one-bit value with %d.
+static void append_bit(std::string *dst, const OtbnTraceValue &value,
+                       int bit) {
+  unsigned a = (value.aval[0] >> bit) & 1;
+  unsigned b = (value.bval[0] >> bit) & 1;
+  dst->push_back(b ? (a ? 'x' : 'z') : (a ? '1' : '0'));
+}
+
+static void append_addr(std::string *dst, uint32_t addr) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "[0x%08x]", addr);
+  *dst += buf;
+}
+
+// If mask is all ones, return -1. If it is all ones in exactly one 32-bit
+// word and zeros elsewhere, return the index of that word. Otherwise, return
+// -2. Unknown mask bits never match.
+static int classify_mask(const OtbnTraceValue &mask) {
+  int full_words = 0, word = -1;
+  for (int i = 0; i < OtbnTraceValue::kNumWords; ++i) {
+    if (mask.bval[i]) {
+      return -2;
+    }
+    if (mask.aval[i] == 0xffffffff) {
+      ++full_words;
+      word = i;
+    } else if (mask.aval[i] != 0) {
+      return -2;
+    }
+  }
+  if (full_words == OtbnTraceValue::kNumWords) {
+    return -1;
+  }
+  return (full_words == 1) ? word : -2;
+}
+
+std::string OtbnTraceHeader::ToString() const {
+  std::string ret(1, prefix);
+  ret.push_back(' ');
+  if (!has_insn) {
+    return ret;
+  }
+
+  char buf[32];
+  snprintf(buf, sizeof(buf), "PC: 0x%08x, insn: ", pc);
+  ret += buf;
+  if (fetch_err) {
+    ret += "??";
+  } else {
+    ret += "0x";
+    append_hex_word(&ret, insn_aval, insn_bval);
+  }
+  return ret;
+}
+
+void OtbnTraceAccess::Format(std::string *loc, std::string *value_str) const {
+  assert(loc && value_str);
+  loc->clear();
+  value_str->clear();
+
+  char buf[16];
+  switch (space) {
+    case Gpr:
+      snprintf(buf, sizeof(buf), "x%02u", index);
+      *loc = buf;
+      *value_str = "0x";
+      append_hex_word(value_str, value.aval[0], value.bval[0]);
+      break;
+
+    case Wdr:
+      snprintf(buf, sizeof(buf), "w%02u", index);
+      *loc = buf;
+      append_wlen(value_str, value);
+      break;
+
+    case Ispr:
+      *loc = index < num_ispr_names ? ispr_names[index] : "UNKNOWN_ISPR";
+      append_wlen(value_str, value);
+      break;
+
+    case Flags:
+      snprintf(buf, sizeof(buf), "%s%u", ispr_names[ispr_flags], index);
+      *loc = buf;
+      *value_str = "{C: ";
+      append_bit(value_str, value, 0);
+      *value_str += ", M: ";
+      append_bit(value_str, value, 1);
+      *value_str += ", L: ";
+      append_bit(value_str, value, 2);
+      *value_str += ", Z: ";
+      append_bit(value_str, value, 3);
+      *value_str += "}";
+      break;
+
+    case Mem: {
+      // Reads and full-width writes show all the data. A write of a single
+      // 32-bit word just shows that word, at its own address. Any other mask
+      // is unexpected, so is shown in full alongside the data.
+      int mask_word = (prefix == 'W') ? classify_mask(mask) : -1;
+      if (mask_word == -1) {
+        append_addr(loc, index);
+        append_wlen(value_str, value);
+      } else if (mask_word >= 0) {
+        append_addr(loc, index + 4 * mask_word);
+        *value_str = "0x";
+        append_hex_word(value_str, value.aval[mask_word],
+                        value.bval[mask_word]);
+      } else {
+        append_addr(loc, index);
+        *value_str = "Mask ERR Mask: ";
+        append_wlen(value_str, mask);
+        *value_str += " Data: ";
+        append_wlen(value_str, value);
+      }
+      break;
+    }
+  }
+}
+
+std::string OtbnTraceAccess::ToString() const {
+  std::string loc, value_str;
+  Format(&loc, &value_str);
+
+  std::string ret(1, prefix);
+  ret.push_back(' ');
+  ret += loc;
+  ret += ": ";
+  ret += value_str;
+  return ret;
+}
+
+void OtbnTraceEvent::Clear(unsigned int new_cycle_count) {
+  cycle_count = new_cycle_count;
+  headers.clear();
+  accesses.clear();
+  str_valid_ = false;
+}
+
+const std::string &OtbnTraceEvent::ToString() const {
+  if (str_valid_) {
+    return str_;
+  }
+
+  str_.clear();
+  if (headers.empty() && !accesses.empty()) {
+    str_ += "Z \n";
+  }
+  for (const OtbnTraceHeader &header : headers) {
+    str_ += header.ToString();
+    str_.push_back('\n');
+  }
+  for (const OtbnTraceAccess &access : accesses) {
+    str_ += access.ToString();
+    str_.push_back('\n');
+  }
+  str_valid_ = true;
+  return str_;
+}
@@ -0,0 +1,118 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_OTBN_DV_TRACER_CPP_OTBN_TRACE_EVENT_H_
+#define OPENTITAN_HW_IP_OTBN_DV_TRACER_CPP_OTBN_TRACE_EVENT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A four-state value of up to WLEN bits, laid out like an array of
+ * svLogicVecVal: word i holds bits [32*i+31:32*i]. A bit is 0 or 1 if its bval
+ * bit is clear. Otherwise, it is X if its aval bit is set and Z if not.
+ */
+struct OtbnTraceValue {
+  static const int kNumWords = 8;
+
+  uint32_t aval[kNumWords];
+  uint32_t bval[kNumWords];
+};
+
+/**
+ * A header line of a trace record (see the trace format in
+ * hw/ip/otbn/dv/tracer/README.md).
+ */
+struct OtbnTraceHeader {
+  // One of 'E', 'S', 'U' or 'V'
+  char prefix;
+
+  // If true, this is an 'E' or 'S' line; the remaining fields are only valid
+  // in that case.
+  bool has_insn;
+
+  // If true, there was an integrity error when fetching the instruction so its
+  // bits aren't reported.
+  bool fetch_err;
+
+  uint32_t pc;
+  uint32_t insn_aval;
+  uint32_t insn_bval;
+
+  // Format the header as a trace line, without a trailing newline
+  std::string ToString() const;
+};
+
+/**
+ * A body line of a trace record: a register or memory access.
+ */
+struct OtbnTraceAccess {
+  enum Space {
+    // A base register (x0 - x31); only the bottom word of value is used
+    Gpr,
+    // A wide register (w0 - w31)
+    Wdr,
+    // An ISPR other than the flags, indexed by otbn_pkg::ispr_e
+    Ispr,
+    // A flag group; bits 0 to 3 of value are C, M, L and Z
+    Flags,
+    // A DMEM access at a byte address. Writes also have a mask.
+    Mem
+  };
+
+  // One of '<', '>', 'R' or 'W'
+  char prefix;
+  Space space;
+  // Register index, ISPR, flag group or memory address, depending on space
+  uint32_t index;
+  OtbnTraceValue value;
+  OtbnTraceValue mask;
+
+  // Format the location and value parts of the access, as they appear in the
+  // trace line "PREFIX LOC: VALUE".
+  void Format(std::string *loc, std::string *value_str) const;
+
+  // Format the access as a trace line, without a trailing newline
+  std::string ToString() const;
+};
+
+/**
+ * A structured trace record from OTBN, as generated by otbn_tracer.sv for a
+ * single cycle.
+ *
+ * Listeners that only want to look at a few fields of the record can read
+ * them directly. The string form that is passed to text listeners is only
+ * generated (once) if something asks for it.
+ */
+class OtbnTraceEvent {
+ public:
+  OtbnTraceEvent() : cycle_count(0), str_valid_(false) {}
+
+  // Empty the event so that it can be refilled for a new cycle. This keeps
+  // the allocated storage, so filling an event doesn't usually allocate.
+  void Clear(unsigned int new_cycle_count);
+
+  // True if this event has neither header nor body lines
+  bool empty() const { return headers.empty() && accesses.empty(); }
+
+  // Return the event in the multi-line string format that the tracer has
+  // always generated. If there are body lines but no header, a 'Z' (stray
+  // change) header is added first.
+  const std::string &ToString() const;
+
+  unsigned int cycle_count;
+
+  // Header lines, in the order that they appear in the record
+  std::vector<OtbnTraceHeader> headers;
+
+  // Body lines, in the order that they appear in the record
+  std::vector<OtbnTraceAccess> accesses;
+
+ private:
+  mutable bool str_valid_;
+  mutable std::string str_;
+};
+
+#endif  // OPENTITAN_HW_IP_OTBN_DV_TRACER_CPP_OTBN_TRACE_EVENT_H_
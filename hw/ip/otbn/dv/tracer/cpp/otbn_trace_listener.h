@@ -5,14 +5,15 @@
 #ifndef OPENTITAN_HW_IP_OTBN_DV_TRACER_CPP_OTBN_TRACE_LISTENER_H_
 #define OPENTITAN_HW_IP_OTBN_DV_TRACER_CPP_OTBN_TRACE_LISTENER_H_
 
-#include <sstream>
 #include <string>
 #include <vector>
 
+#include "otbn_trace_event.h"
+
 /**
  * Base class for anything that wants to examine trace output from OTBN. The
  * simulation that hosts the tracer is responsible for setting up listeners and
- * routing the DPI `accept_otbn_trace_string` calls to them.
+ * registering them with OtbnTraceSource, which routes trace records to them.
  */
 class OtbnTraceListener {
  public:
@@ -23,13 +24,19 @@ class OtbnTraceListener {
    * @return A vector of lines from the trace
    */
   static std::vector<std::string> SplitTraceLines(const std::string &trace) {
-    std::stringstream trace_ss(trace);
-    std::string trace_line;
-
     std::vector<std::string> trace_lines;
 
-    while (std::getline(trace_ss, trace_line, '\n')) {
-      trace_lines.push_back(trace_line);
+    // Split at each newline, as std::getline would: a trailing newline does
+    // not start another (empty) line.
+    size_t pos = 0;
+    while (pos < trace.size()) {
+      size_t eol = trace.find('\n', pos);
+      if (eol == std::string::npos) {
+        trace_lines.emplace_back(trace, pos, std::string::npos);
+        break;
+      }
+      trace_lines.emplace_back(trace, pos, eol - pos);
+      pos = eol + 1;
     }
 
     return trace_lines;
@@ -43,6 +50,21 @@ class OtbnTraceListener {
    */
   virtual void AcceptTraceString(const std::string &trace,
                                  unsigned int cycle_count) = 0;
+
+  /**
+   * Called to process a structured OTBN trace record, called a maximum of once
+   * per cycle
+   *
+   * The default implementation passes the string form of the record to
+   * AcceptTraceString. Listeners that don't need the text can override this
+   * to look at the record directly, in which case the string is never built.
+   *
+   * @param event Trace record from OTBN
+   */
+  virtual void AcceptTraceEvent(const OtbnTraceEvent &event) {
+    AcceptTraceString(event.ToString(), event.cycle_count);
+  }
+
   virtual ~OtbnTraceListener() {}
 };
 
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <svdpi.h>
 
 static std::unique_ptr<OtbnTraceSource> trace_source;
 
@@ -34,8 +35,75 @@ void OtbnTraceSource::Broadcast(const std::string &trace,
   }
 }
 
+void OtbnTraceSource::BroadcastEvent(const OtbnTraceEvent &event) {
+  for (OtbnTraceListener *listener : listeners_) {
+    listener->AcceptTraceEvent(event);
+  }
+}
+
 extern "C" void accept_otbn_trace_string(const char *trace,
                                          unsigned int cycle_count) {
   assert(trace != nullptr);
   OtbnTraceSource::get().Broadcast(trace, cycle_count);
 }
+
+extern "C" void otbn_trace_begin(unsigned int cycle_count) {
+  OtbnTraceSource::get().pending_event().Clear(cycle_count);
+}
+
+extern "C" void otbn_trace_header(char prefix, svBit has_insn, svBit fetch_err,
+                                  unsigned int pc, const svLogicVecVal *insn) {
+  assert(insn);
+  OtbnTraceHeader header;
+  header.prefix = prefix;
+  header.has_insn = has_insn;
+  header.fetch_err = fetch_err;
+  header.pc = pc;
+  header.insn_aval = insn->aval;
+  header.insn_bval = insn->bval;
+  OtbnTraceSource::get().pending_event().headers.push_back(header);
+}
+
+extern "C" void otbn_trace_access(char prefix, char space, unsigned int index,
+                                  const svLogicVecVal *value,
+                                  const svLogicVecVal *mask) {
+  assert(value && mask);
+  std::vector<OtbnTraceAccess> &accesses =
+      OtbnTraceSource::get().pending_event().accesses;
+  accesses.emplace_back();
+  OtbnTraceAccess &access = accesses.back();
+
+  access.prefix = prefix;
+  switch (space) {
+    case 'x':
+      access.space = OtbnTraceAccess::Gpr;
+      break;
+    case 'w':
+      access.space = OtbnTraceAccess::Wdr;
+      break;
+    case 'i':
+      access.space = OtbnTraceAccess::Ispr;
+      break;
+    case 'f':
+      access.space = OtbnTraceAccess::Flags;
+      break;
+    default:
+      assert(space == 'm');
+      access.space = OtbnTraceAccess::Mem;
+      break;
+  }
+  access.index = index;
+  for (int i = 0; i < OtbnTraceValue::kNumWords; ++i) {
+    access.value.aval[i] = value[i].aval;
+    access.value.bval[i] = value[i].bval;
+    access.mask.aval[i] = mask[i].aval;
+    access.mask.bval[i] = mask[i].bval;
+  }
+}
+
+extern "C" void otbn_trace_end() {
+  OtbnTraceSource &source = OtbnTraceSource::get();
+  if (!source.pending_event().empty()) {
+    source.BroadcastEvent(source.pending_event());
+  }
+}
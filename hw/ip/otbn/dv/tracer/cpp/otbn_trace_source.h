@@ -13,9 +13,12 @@
 // This is a singleton class, which will be constructed on the first call to
 // get() or the first trace data that comes back from the simulation.
 //
-// The object is in charge of taking trace data from the simulation (which is
-// sent by calling the accept_otbn_trace_string DPI function) and passing it
-// out to registered listeners.
+// The object is in charge of taking trace data from the simulation and passing
+// it out to registered listeners. otbn_tracer.sv describes each cycle with a
+// series of DPI calls (otbn_trace_begin, then otbn_trace_header and
+// otbn_trace_access for each line, then otbn_trace_end), which the source
+// gathers into an OtbnTraceEvent. Trace strings sent by calling the
+// accept_otbn_trace_string DPI function are passed on as they are.
 
 class OtbnTraceSource {
  public:
@@ -31,8 +34,15 @@ class OtbnTraceSource {
   // Send a trace string to all listeners
   void Broadcast(const std::string &trace, unsigned cycle_count);
 
+  // Send a structured trace record to all listeners
+  void BroadcastEvent(const OtbnTraceEvent &event);
+
+  // The record being assembled from DPI calls for the current cycle
+  OtbnTraceEvent &pending_event() { return pending_event_; }
+
  private:
   std::vector<OtbnTraceListener *> listeners_;
+  OtbnTraceEvent pending_event_;
 };
 
 #endif  // OPENTITAN_HW_IP_OTBN_DV_TRACER_CPP_OTBN_TRACE_SOURCE_H_
@@ -5,9 +5,10 @@
 `ifndef SYNTHESIS
 
 /**
- * Tracer module for OTBN. This produces a multi-line string as trace output at most once every
- * cycle and provides it to the simulation environment via a DPI call. It uses `otbn_trace_if` to
- * get the information it needs. For further information see `hw/ip/otbn/dv/tracer/README.md`.
+ * Tracer module for OTBN. This describes what happened in each cycle to the simulation environment
+ * through a series of DPI calls, which build up a trace record that the environment can pass to
+ * C++ listeners without formatting it as text on the way. It uses `otbn_trace_if` to get the
+ * information it needs. For further information see `hw/ip/otbn/dv/tracer/README.md`.
  */
 module otbn_tracer (
   input  logic  clk_i,
@@ -17,244 +18,153 @@ module otbn_tracer (
 );
   import otbn_pkg::*;
 
-  // Prefixes used in trace lines. Formats are documented in `hw/ip/otbn/dv/tracer/README.md`
-  parameter string InsnExecutePrefix = "E";
-  parameter string InsnStallPrefix = "S";
-  parameter string WipeInProgressPrefix = "U";
-  parameter string WipeCompletePrefix = "V";
-  parameter string StrayChangePrefix = "Z";
-  parameter string RegReadPrefix = "<";
-  parameter string RegWritePrefix = ">";
-  parameter string MemWritePrefix = "W";
-  parameter string MemReadPrefix = "R";
+  // Prefixes used in trace lines. Formats are documented in `hw/ip/otbn/dv/tracer/README.md`. The
+  // 'Z' prefix for stray changes is added by the C++ side when a record has no header.
+  parameter byte InsnExecutePrefix = "E";
+  parameter byte InsnStallPrefix = "S";
+  parameter byte WipeInProgressPrefix = "U";
+  parameter byte WipeCompletePrefix = "V";
+  parameter byte RegReadPrefix = "<";
+  parameter byte RegWritePrefix = ">";
+  parameter byte MemWritePrefix = "W";
+  parameter byte MemReadPrefix = "R";
+
+  // Register spaces for otbn_trace_access. These must match the C++ implementation in
+  // otbn_trace_source.cc.
+  parameter byte SpaceGpr = "x";
+  parameter byte SpaceWdr = "w";
+  parameter byte SpaceIspr = "i";
+  parameter byte SpaceFlags = "f";
+  parameter byte SpaceMem = "m";
 
   logic [31:0] cycle_count;
 
-  // Given a WLEN size word output a hex string with the data split into 32-bit chunks separated
-  // with '_'. WLEN must be a multiple of 32.
-  function automatic string otbn_wlen_data_str(logic [WLEN-1:0] data);
-    string data_str;
+  // Start a new trace record for the current cycle
+  import "DPI-C" function void otbn_trace_begin(int unsigned cycle_count);
 
-    assert ((WLEN % 32) == 0) else $error("WLEN must be a multiple of 32 in otbn_wlen_data_str");
+  // Add a header line to the record. Headers appear in the record in the order that they are
+  // added. If has_insn is false, the remaining arguments are ignored.
+  import "DPI-C" function void otbn_trace_header(byte prefix, bit has_insn, bit fetch_err,
+                                                 int unsigned pc, logic [31:0] insn);
 
-    for (int i = WLEN; i > 0; i-= 32) begin
-      if (i != WLEN) begin
-        data_str = $sformatf("%s_", data_str);
-      end else begin
-        data_str = "0x";
-      end
-
-      data_str = $sformatf("%s%08x", data_str, data[i-1 -: 32]);
-    end
-
-    return data_str;
-  endfunction
-
-  // Produce trace output string for dmem writes. For a 256-bit write, the address and full data is
-  // output. For 32-bit writes (determined by looking at the mask) only the relevant 32-bit chunk is
-  // output along with the address modified so it refers to that chunk.
-  function automatic string otbn_dmem_write_str(logic [31:0] addr,
-                                                logic [WLEN-1:0] data,
-                                                logic [WLEN-1:0] wmask);
-
-    logic [WLEN-1:0] cur_base_mask;
-
-    // For a full WLEN write output all of the data.
-    if (wmask == '1) begin
-      return $sformatf("[0x%08x]: %s", addr, otbn_wlen_data_str(data));
-    end
-
-    // Iterate through the possible 32-bit chunks
-    cur_base_mask = {{(WLEN-32){1'b0}}, 32'hFFFF_FFFF};
+  // Add a body line for a register or memory access to the record. The meaning of index depends on
+  // space: it is a register index, an ISPR (as an ispr_e), a flag group or a DMEM byte address.
+  // Only DMEM writes use mask.
+  import "DPI-C" function void otbn_trace_access(byte prefix, byte space, int unsigned index,
+                                                 logic [WLEN-1:0] value, logic [WLEN-1:0] mask);
 
-    for (int i = 0; i < WLEN; i += 32) begin
-      // If mask matches current chunk alone output trace indicating a single 32-bit write.
-      if (wmask == cur_base_mask) begin
-        return $sformatf("[0x%08x]: 0x%08x", addr + (i / 8), data[i*32 +: 32]);
-      end
-
-      cur_base_mask = cur_base_mask << 32;
-    end
-
-    // Fallback where mask isn't as expected, indicate ERR in the trace and provide both full mask
-    // and data.
-    return $sformatf("[0x%08x]: Mask ERR Mask: %s Data: %s", addr, otbn_wlen_data_str(wmask),
-      otbn_wlen_data_str(data));
-  endfunction
-
-  // Determine name for an ISPR
-  function automatic string otbn_ispr_name_str(ispr_e ispr);
-    unique case (ispr)
-      IsprMod: return "MOD";
-      IsprAcc: return "ACC";
-      IsprRnd: return "RND";
-      IsprFlags: return "FLAGS";
-      IsprUrnd: return "URND";
-      default: return "UNKNOWN_ISPR";
-    endcase
-  endfunction
+  // Finish the record for the current cycle, passing it to listeners if it has any lines at all
+  import "DPI-C" function void otbn_trace_end();
 
-  // Format flag information into a string
-  function automatic string otbn_flags_str(flags_t f);
-    return $sformatf("{C: %d, M: %d, L: %d, Z: %d}", f.C, f.M, f.L, f.Z);
+  function automatic void trace_reg(byte prefix, byte space, int unsigned index,
+                                    logic [WLEN-1:0] value);
+    otbn_trace_access(prefix, space, index, value, '0);
   endfunction
 
-  // Called by other trace functions to append their trace lines to the output buffer
-  function automatic string output_trace(string work, string prefix, string trace_line);
-    return $sformatf("%s%s %s\n", work, prefix, trace_line);
-  endfunction
-
-  // Called by some trace functions to prepend their trace lines to the output buffer
-  function automatic string prepend_trace(string work, string prefix, string trace_line);
-    return $sformatf("%s %s\n%s", prefix, trace_line, work);
-  endfunction
-
-  function automatic string trace_base_rf(string work);
+  function automatic void trace_base_rf();
     if (otbn_trace.rf_base_rd_en_a) begin
-      work = output_trace(work, RegReadPrefix,
-                          $sformatf("x%02d: 0x%08x", otbn_trace.rf_base_rd_addr_a,
-                                    otbn_trace.rf_base_rd_data_a));
+      trace_reg(RegReadPrefix, SpaceGpr, otbn_trace.rf_base_rd_addr_a,
+                WLEN'(otbn_trace.rf_base_rd_data_a));
     end
 
     if (otbn_trace.rf_base_rd_en_b) begin
-      work = output_trace(work, RegReadPrefix,
-                          $sformatf("x%02d: 0x%08x", otbn_trace.rf_base_rd_addr_b,
-                                    otbn_trace.rf_base_rd_data_b));
+      trace_reg(RegReadPrefix, SpaceGpr, otbn_trace.rf_base_rd_addr_b,
+                WLEN'(otbn_trace.rf_base_rd_data_b));
     end
 
     if (|otbn_trace.rf_base_wr_en && otbn_trace.rf_base_wr_commit &&
         otbn_trace.rf_base_wr_addr != '0) begin
-      work = output_trace(work, RegWritePrefix,
-                          $sformatf("x%02d: 0x%08x", otbn_trace.rf_base_wr_addr,
-                                    otbn_trace.rf_base_wr_data));
+      trace_reg(RegWritePrefix, SpaceGpr, otbn_trace.rf_base_wr_addr,
+                WLEN'(otbn_trace.rf_base_wr_data));
     end
-
-    return work;
   endfunction
 
-  function automatic string trace_bignum_rf(string work);
+  function automatic void trace_bignum_rf();
     if (otbn_trace.rf_bignum_rd_en_a) begin
-      work = output_trace(work, RegReadPrefix,
-                          $sformatf("w%02d: %s", otbn_trace.rf_bignum_rd_addr_a,
-                                    otbn_wlen_data_str(otbn_trace.rf_bignum_rd_data_a)));
+      trace_reg(RegReadPrefix, SpaceWdr, otbn_trace.rf_bignum_rd_addr_a,
+                otbn_trace.rf_bignum_rd_data_a);
     end
 
     if (otbn_trace.rf_bignum_rd_en_b) begin
-      work = output_trace(work, RegReadPrefix,
-                          $sformatf("w%02d: %s", otbn_trace.rf_bignum_rd_addr_b,
-                                    otbn_wlen_data_str(otbn_trace.rf_bignum_rd_data_b)));
+      trace_reg(RegReadPrefix, SpaceWdr, otbn_trace.rf_bignum_rd_addr_b,
+                otbn_trace.rf_bignum_rd_data_b);
     end
 
     if (|otbn_trace.rf_bignum_wr_en & otbn_trace.rf_bignum_wr_commit) begin
-      work = output_trace(work, RegWritePrefix,
-                          $sformatf("w%02d: %s", otbn_trace.rf_bignum_wr_addr,
-                                    otbn_wlen_data_str(otbn_trace.rf_bignum_wr_data)));
+      trace_reg(RegWritePrefix, SpaceWdr, otbn_trace.rf_bignum_wr_addr,
+                otbn_trace.rf_bignum_wr_data);
     end
-
-    return work;
   endfunction
 
-  function automatic string trace_bignum_mem(string work);
+  function automatic void trace_bignum_mem();
     if (otbn_trace.dmem_write) begin
-      work = output_trace(work, MemWritePrefix,
-                          otbn_dmem_write_str(otbn_trace.dmem_write_addr,
-                                              otbn_trace.dmem_write_data,
-                                              otbn_trace.dmem_write_mask));
+      otbn_trace_access(MemWritePrefix, SpaceMem, otbn_trace.dmem_write_addr,
+                        otbn_trace.dmem_write_data, otbn_trace.dmem_write_mask);
     end
 
     if (otbn_trace.dmem_read) begin
-      work = output_trace(work, MemReadPrefix,
-                          $sformatf("[0x%08x]: %s", otbn_trace.dmem_read_addr,
-                                    otbn_wlen_data_str(otbn_trace.dmem_read_data)));
+      trace_reg(MemReadPrefix, SpaceMem, otbn_trace.dmem_read_addr, otbn_trace.dmem_read_data);
     end
-
-    return work;
   endfunction
 
-  function automatic string trace_ispr_accesses(string work);
+  function automatic void trace_ispr_accesses();
     // Iterate through all ISPRs outputting reg reads and writes where ISPR accesses have occurred
     for (int i_ispr = 0; i_ispr < NIspr; i_ispr++) begin
       if (ispr_e'(i_ispr) == IsprFlags) begin
         // Special handling for flags ISPR to provide per flag field output
         for (int i_fg = 0; i_fg < NFlagGroups; i_fg++) begin
           if (otbn_trace.flags_read[i_fg]) begin
-            work = output_trace(work, RegReadPrefix,
-                                $sformatf("%s%1d: %s", otbn_ispr_name_str(ispr_e'(i_ispr)), i_fg,
-                                          otbn_flags_str(otbn_trace.flags_read_data[i_fg])));
+            trace_reg(RegReadPrefix, SpaceFlags, i_fg, WLEN'(otbn_trace.flags_read_data[i_fg]));
           end
 
           if (otbn_trace.flags_write[i_fg]) begin
-            work = output_trace(work, RegWritePrefix,
-                                $sformatf("%s%1d: %s", otbn_ispr_name_str(ispr_e'(i_ispr)), i_fg,
-                                          otbn_flags_str(otbn_trace.flags_write_data[i_fg])));
+            trace_reg(RegWritePrefix, SpaceFlags, i_fg, WLEN'(otbn_trace.flags_write_data[i_fg]));
           end
         end
       end else begin
         // For all other ISPRs just dump out the full 256-bits of data being read/written
         if (otbn_trace.ispr_read[i_ispr]) begin
-          work = output_trace(work, RegReadPrefix,
-                              $sformatf("%s: %s", otbn_ispr_name_str(ispr_e'(i_ispr)),
-                                        otbn_wlen_data_str(otbn_trace.ispr_read_data[i_ispr])));
+          trace_reg(RegReadPrefix, SpaceIspr, i_ispr, otbn_trace.ispr_read_data[i_ispr]);
         end
 
         if (otbn_trace.ispr_write[i_ispr]) begin
-          work = output_trace(work, RegWritePrefix,
-                              $sformatf("%s: %s", otbn_ispr_name_str(ispr_e'(i_ispr)),
-                                        otbn_wlen_data_str(otbn_trace.ispr_write_data[i_ispr])));
+          trace_reg(RegWritePrefix, SpaceIspr, i_ispr, otbn_trace.ispr_write_data[i_ispr]);
         end
       end
     end
-    return work;
   endfunction
 
-  function automatic string prepend_trace_header(string work);
-    bit added_header = 1'b0;
-
-    if (otbn_trace.secure_wipe_ack_r) begin
-      work = prepend_trace(work, WipeCompletePrefix, "");
-      added_header = 1'b1;
-    end else if (otbn_trace.secure_wipe_req || !otbn_trace.initial_secure_wipe_done) begin
-      work = prepend_trace(work, WipeInProgressPrefix, "");
-      added_header = 1'b1;
-    end
-
+  function automatic void trace_header();
     if (otbn_trace.insn_valid) begin
       if (otbn_trace.insn_fetch_err) begin
         // This means that we've seen an IMEM integrity error. Squash the reported instruction bits
         // and ignore any stall: this will be the last cycle of the instruction either way.
-        work = prepend_trace(work, InsnExecutePrefix,
-                             $sformatf("PC: 0x%08x, insn: ??", otbn_trace.insn_addr));
+        otbn_trace_header(InsnExecutePrefix, 1'b1, 1'b1, otbn_trace.insn_addr, '0);
       end else begin
         // We have a valid instruction, either stalled or completing its execution
-        work = prepend_trace(work, otbn_trace.insn_stall ? InsnStallPrefix : InsnExecutePrefix,
-                             $sformatf("PC: 0x%08x, insn: 0x%08x", otbn_trace.insn_addr,
-                                       otbn_trace.insn_data));
+        otbn_trace_header(otbn_trace.insn_stall ? InsnStallPrefix : InsnExecutePrefix, 1'b1, 1'b0,
+                          otbn_trace.insn_addr, otbn_trace.insn_data);
       end
-      added_header = 1'b1;
     end
 
-    if (work != "" && !added_header) begin
-      work = prepend_trace(work, StrayChangePrefix, "");
+    if (otbn_trace.secure_wipe_ack_r) begin
+      otbn_trace_header(WipeCompletePrefix, 1'b0, 1'b0, '0, '0);
+    end else if (otbn_trace.secure_wipe_req || !otbn_trace.initial_secure_wipe_done) begin
+      otbn_trace_header(WipeInProgressPrefix, 1'b0, 1'b0, '0, '0);
     end
-
-    return work;
   endfunction
 
-  import "DPI-C" function void accept_otbn_trace_string(string trace, int unsigned cycle_count);
-
   function automatic void do_trace();
-    string work;
+    otbn_trace_begin(cycle_count);
 
-    work = trace_bignum_rf(work);
-    work = trace_base_rf(work);
-    work = trace_bignum_mem(work);
-    work = trace_ispr_accesses(work);
+    trace_header();
 
-    work = prepend_trace_header(work);
+    trace_bignum_rf();
+    trace_base_rf();
+    trace_bignum_mem();
+    trace_ispr_accesses();
 
-    if (work != "") begin
-      accept_otbn_trace_string(work, cycle_count);
-    end
+    otbn_trace_end();
   endfunction
 
   always @(posedge clk_i or negedge rst_ni) begin
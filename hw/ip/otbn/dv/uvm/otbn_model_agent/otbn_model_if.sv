@@ -132,6 +132,12 @@ interface otbn_model_if
                     "Failed to disable stack integrity checks", "otbn_model_if")
   endfunction
 
+  function automatic void otbn_enable_full_reg_check();
+    `uvm_info("otbn_model_if", "Enabling full register checks", UVM_HIGH);
+    `DV_CHECK_FATAL(u_model.otbn_enable_full_reg_check(handle) == 0,
+                    "Failed to enable full register checks", "otbn_model_if")
+  endfunction
+
   // The err signal is asserted by the model if it fails to find the DUT or if it finds a mismatch
   // in results. It should never go high.
   `ASSERT(NoModelErrs, !err)
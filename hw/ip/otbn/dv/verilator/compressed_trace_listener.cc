@@ -0,0 +1,118 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "compressed_trace_listener.h"
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <zlib.h>
+
+#include "log_trace_listener.h"
+
+// Format version written in the file header
+static const uint16_t kVersion = 1;
+
+static void put_le16(std::string *dst, uint16_t v) {
+  dst->push_back(v & 0xff);
+  dst->push_back(v >> 8);
+}
+
+static void put_le32(std::string *dst, uint32_t v) {
+  for (int i = 0; i < 4; ++i) {
+    dst->push_back((v >> (8 * i)) & 0xff);
+  }
+}
+
+static void put_le64(std::string *dst, uint64_t v) {
+  put_le32(dst, v & 0xffffffff);
+  put_le32(dst, v >> 32);
+}
+
+CompressedTraceListener::CompressedTraceListener(const std::string &filename,
+                                                 size_t block_size)
+    : file_(filename, std::ios::out | std::ios::binary),
+      block_size_(block_size),
+      first_cycle_(0),
+      last_cycle_(0),
+      offset_(0) {
+  if (!file_.is_open()) {
+    std::ostringstream oss;
+    oss << "Could not open compressed trace file: " << filename;
+    throw std::runtime_error(oss.str());
+  }
+
+  std::string hdr = "OTTZ";
+  put_le16(&hdr, kVersion);
+  put_le16(&hdr, 0);
+  put_le32(&hdr, block_size_);
+  put_le32(&hdr, 0);
+  file_.write(hdr.data(), hdr.size());
+  offset_ = hdr.size();
+}
+
+CompressedTraceListener::~CompressedTraceListener() {
+  FlushBlock();
+
+  // The index is followed by a footer that gives its offset, so that readers
+  // can find it from the end of the file. If the simulation stops before we
+  // get here, the blocks can still be found by walking through their headers.
+  std::string idx = "OTIX";
+  put_le32(&idx, index_.size());
+  for (const IndexEntry &entry : index_) {
+    put_le32(&idx, entry.first_cycle);
+    put_le32(&idx, entry.last_cycle);
+    put_le64(&idx, entry.offset);
+  }
+  put_le64(&idx, offset_);
+  idx += "OTIE";
+  file_.write(idx.data(), idx.size());
+}
+
+void CompressedTraceListener::AcceptTraceString(const std::string &trace,
+                                                unsigned int cycle_count) {
+  assert(file_.is_open());
+
+  // Blocks always hold whole records, so each one can be read on its own
+  if (text_.tellp() == 0) {
+    first_cycle_ = cycle_count;
+  }
+  last_cycle_ = cycle_count;
+  LogTraceListener::WriteTrace(text_, trace, cycle_count);
+
+  if (static_cast<size_t>(text_.tellp()) >= block_size_) {
+    FlushBlock();
+  }
+}
+
+void CompressedTraceListener::FlushBlock() {
+  std::string text = text_.str();
+  if (text.empty()) {
+    return;
+  }
+  text_.str("");
+
+  uLongf comp_len = compressBound(text.size());
+  std::vector<Bytef> comp(comp_len);
+  int err = compress2(comp.data(), &comp_len,
+                      reinterpret_cast<const Bytef *>(text.data()),
+                      text.size(), Z_DEFAULT_COMPRESSION);
+  if (err != Z_OK) {
+    std::cerr << "ERROR: Failed to compress OTBN trace block (zlib error "
+              << err << "). Cycles " << first_cycle_ << " to " << last_cycle_
+              << " are missing from the trace.\n";
+    return;
+  }
+
+  std::string hdr = "OTBK";
+  put_le32(&hdr, first_cycle_);
+  put_le32(&hdr, last_cycle_);
+  put_le32(&hdr, text.size());
+  put_le32(&hdr, comp_len);
+  file_.write(hdr.data(), hdr.size());
+  file_.write(reinterpret_cast<const char *>(comp.data()), comp_len);
+
+  index_.push_back({first_cycle_, last_cycle_, offset_});
+  offset_ += hdr.size() + comp_len;
+}
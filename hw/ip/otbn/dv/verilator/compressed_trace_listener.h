@@ -0,0 +1,65 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_OTBN_DV_VERILATOR_COMPRESSED_TRACE_LISTENER_H_
+#define OPENTITAN_HW_IP_OTBN_DV_VERILATOR_COMPRESSED_TRACE_LISTENER_H_
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "otbn_trace_listener.h"
+
+/**
+ * An OtbnTraceListener that writes the same text as LogTraceListener, but
+ * split into independently compressed blocks with an index of the cycles that
+ * each block covers. This keeps archived traces of long runs small, and
+ * read-trace.py can use the index to extract a range of cycles without
+ * decompressing the whole file.
+ *
+ * The file format is described in hw/ip/otbn/dv/tracer/README.md.
+ */
+class CompressedTraceListener : public OtbnTraceListener {
+ public:
+  // The default amount of text (before compression) in each block
+  static const size_t kDefaultBlockSize = 1 << 20;
+
+  /**
+   * Constructor that takes a filename to write the trace to. It throws
+   * std::runtime_error if the file cannot be opened.
+   */
+  CompressedTraceListener(const std::string &filename,
+                          size_t block_size = kDefaultBlockSize);
+
+  // Flush any buffered text and write the index
+  ~CompressedTraceListener();
+
+  void AcceptTraceString(const std::string &trace,
+                         unsigned int cycle_count) override;
+
+ private:
+  struct IndexEntry {
+    uint32_t first_cycle;
+    uint32_t last_cycle;
+    uint64_t offset;
+  };
+
+  // Compress the buffered text into a block and write it out
+  void FlushBlock();
+
+  std::ofstream file_;
+  size_t block_size_;
+
+  // Text for the block that is being built, and the cycles it covers
+  std::ostringstream text_;
+  uint32_t first_cycle_;
+  uint32_t last_cycle_;
+
+  uint64_t offset_;
+  std::vector<IndexEntry> index_;
+};
+
+#endif  // OPENTITAN_HW_IP_OTBN_DV_VERILATOR_COMPRESSED_TRACE_LISTENER_H_
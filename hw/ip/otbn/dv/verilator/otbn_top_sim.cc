@@ -2,6 +2,7 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <deque>
 #include <fstream>
 #include <getopt.h>
 #include <iomanip>
@@ -9,8 +10,10 @@
 #include <memory>
 #include <string>
 #include <svdpi.h>
+#include <vector>
 
 #include "Votbn_top_sim__Syms.h"
+#include "compressed_trace_listener.h"
 #include "log_trace_listener.h"
 #include "otbn_memutil.h"
 #include "otbn_model.h"
@@ -33,15 +36,27 @@ extern int otbn_core_get_stop_pc();
 /**
  * SimCtrlExtension that adds a '--otbn-trace-file' command line option. If set
  * it sets up a LogTraceListener that will dump out the trace to the given log
- * file
+ * file. If the file name ends in ".otz", it sets up a CompressedTraceListener
+ * instead.
  */
 class OtbnTraceUtil : public SimCtrlExtension {
  private:
-  std::unique_ptr<LogTraceListener> log_trace_listener_;
+  std::unique_ptr<OtbnTraceListener> log_trace_listener_;
+
+  static bool IsCompressedLog(const std::string &log_filename) {
+    const std::string suffix = ".otz";
+    return log_filename.size() > suffix.size() &&
+           log_filename.compare(log_filename.size() - suffix.size(),
+                                suffix.size(), suffix) == 0;
+  }
 
   bool SetupTraceLog(const std::string &log_filename) {
     try {
-      log_trace_listener_.reset(new LogTraceListener(log_filename));
+      if (IsCompressedLog(log_filename)) {
+        log_trace_listener_.reset(new CompressedTraceListener(log_filename));
+      } else {
+        log_trace_listener_.reset(new LogTraceListener(log_filename));
+      }
       OtbnTraceSource::get().AddListener(log_trace_listener_.get());
       return true;
     } catch (const std::runtime_error &err) {
@@ -56,7 +71,8 @@ class OtbnTraceUtil : public SimCtrlExtension {
   void PrintHelp() {
     std::cout << "Trace log utilities:\n\n"
                  "--otbn-trace-file=FILE\n"
-                 "  Write OTBN trace log to FILE\n\n";
+                 "  Write OTBN trace log to FILE. If FILE ends in .otz, write\n"
+                 "  a compressed trace for read-trace.py instead.\n\n";
   }
 
  public:
@@ -96,12 +112,232 @@ class OtbnTraceUtil : public SimCtrlExtension {
   }
 };
 
+/**
+ * SimCtrlExtension that adds a '--otbn-loop-warps' command line option. If
+ * set, it loads loop warps from the given file (as written by the ISS's
+ * --profile-loops option) into an OtbnMemUtil. These are applied to both the
+ * RTL and the model, in the same way as loop warp symbols in the ELF file.
+ */
+class OtbnLoopWarpUtil : public SimCtrlExtension {
+ private:
+  OtbnMemUtil *mem_util_;
+
+  void PrintHelp() {
+    std::cout << "Loop warp utilities:\n\n"
+                 "--otbn-loop-warps=FILE\n"
+                 "  Apply loop warps from FILE, as well as any given by\n"
+                 "  symbols in the ELF file.\n\n";
+  }
+
+ public:
+  OtbnLoopWarpUtil(OtbnMemUtil *mem_util) : mem_util_(mem_util) {}
+
+  virtual bool ParseCLIArguments(int argc, char **argv, bool &exit_app) {
+    const struct option long_options[] = {
+        {"otbn-loop-warps", required_argument, nullptr, 'w'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, no_argument, nullptr, 0}};
+
+    // Reset the command parsing index in-case other utils have already parsed
+    // some arguments
+    optind = 1;
+    while (1) {
+      int c = getopt_long(argc, argv, "-h", long_options, nullptr);
+      if (c == -1) {
+        break;
+      }
+
+      switch (c) {
+        case 0:
+        case 1:
+          break;
+        case 'w':
+          try {
+            mem_util_->LoadLoopWarpFile(optarg);
+          } catch (const std::exception &err) {
+            std::cerr << "ERROR: Failed to load loop warps: " << err.what()
+                      << std::endl;
+            return false;
+          }
+          break;
+        case 'h':
+          PrintHelp();
+          break;
+      }
+    }
+
+    return true;
+  }
+};
+
 static otbn_top_sim *verilator_top;
 static OtbnMemUtil otbn_memutil("TOP.otbn_top_sim");
 
+// Check the outcome of the program that has just finished: the model must not
+// have seen an error and, if the ELF file gave an expected end address, OTBN
+// must have stopped there. Returns true if everything matched.
+static bool CheckProgramResult() {
+  SVScoped top_scope("TOP.otbn_top_sim");
+
+  svBit model_err = otbn_err_get();
+  if (model_err) {
+    return false;
+  }
+
+  int exp_stop_pc = otbn_memutil.GetExpEndAddr();
+  if (exp_stop_pc >= 0) {
+    SVScoped core_scope("TOP.otbn_top_sim.u_otbn_core_model");
+    int act_stop_pc = otbn_core_get_stop_pc();
+    if (exp_stop_pc != act_stop_pc) {
+      std::cerr << "ERROR: Expected stop PC from ELF file was 0x" << std::hex
+                << exp_stop_pc << ", but simulation actually stopped at 0x"
+                << act_stop_pc << ".\n";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * SimCtrlExtension that adds '--otbn-batch-elf' and '--otbn-no-lockstep'
+ * command line options, for using otbn_top_sim as a benchmark.
+ *
+ * Each '--otbn-batch-elf' names a program to run. The programs run back to
+ * back in the same Verilated model: when one finishes, its result is checked,
+ * the next ELF file is loaded and the design is reset. The number of cycles
+ * from reset to the end of each program (including the initial secure wipe)
+ * is printed as it finishes.
+ *
+ * '--otbn-no-lockstep' disables the instruction by instruction comparison of
+ * the RTL and ISS traces. The model still runs and checks the final DMEM and
+ * register contents when each program finishes.
+ */
+class OtbnBatchUtil : public SimCtrlExtension {
+ private:
+  otbn_top_sim *top_;
+  OtbnMemUtil *mem_util_;
+  std::deque<std::string> elfs_;
+  std::string cur_elf_;
+  unsigned long start_cycle_;
+  unsigned reset_cycles_;
+  bool failed_;
+  bool finished_;
+
+  // Cycles to hold the design in reset between two programs
+  static const unsigned kResetCycles = 10;
+
+  bool LoadNextElf() {
+    cur_elf_ = elfs_.front();
+    elfs_.pop_front();
+    try {
+      mem_util_->LoadElf(cur_elf_);
+    } catch (const std::exception &err) {
+      std::cerr << "ERROR: Failed to load " << cur_elf_ << ": " << err.what()
+                << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  void PrintHelp() {
+    std::cout << "Batch utilities:\n\n"
+                 "--otbn-batch-elf=FILE\n"
+                 "  Run the program in FILE. Give this more than once to run\n"
+                 "  several programs back to back.\n\n"
+                 "--otbn-no-lockstep\n"
+                 "  Only compare the final state of the RTL and the model,\n"
+                 "  not the trace of each instruction.\n\n";
+  }
+
+ public:
+  OtbnBatchUtil(otbn_top_sim *top, OtbnMemUtil *mem_util)
+      : top_(top),
+        mem_util_(mem_util),
+        start_cycle_(0),
+        reset_cycles_(0),
+        failed_(false),
+        finished_(false) {}
+
+  virtual bool ParseCLIArguments(int argc, char **argv, bool &exit_app) {
+    const struct option long_options[] = {
+        {"otbn-batch-elf", required_argument, nullptr, 'b'},
+        {"otbn-no-lockstep", no_argument, nullptr, 'n'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, no_argument, nullptr, 0}};
+
+    // Reset the command parsing index in-case other utils have already parsed
+    // some arguments
+    optind = 1;
+    while (1) {
+      int c = getopt_long(argc, argv, "-h", long_options, nullptr);
+      if (c == -1) {
+        break;
+      }
+
+      switch (c) {
+        case 0:
+        case 1:
+          break;
+        case 'b':
+          elfs_.push_back(optarg);
+          break;
+        case 'n':
+          OtbnTraceChecker::get().Disable();
+          break;
+        case 'h':
+          PrintHelp();
+          break;
+      }
+    }
+
+    return elfs_.empty() || LoadNextElf();
+  }
+
+  bool IsBatch() const { return !cur_elf_.empty(); }
+
+  // Return true if every program in the batch ran and passed.
+  bool Passed() const { return finished_ && !failed_; }
+
+  // Called over DPI (through OtbnTopProgramDone) when a program has finished.
+  // Returns true if the simulation should stop.
+  bool ProgramDone() {
+    unsigned long cycles = VerilatorSimCtrl::GetInstance().GetTime() / 2 -
+                           start_cycle_;
+    bool passed = CheckProgramResult();
+    failed_ |= !passed;
+    std::cout << cur_elf_ << ": " << (passed ? "PASS" : "FAIL") << " in "
+              << std::dec << cycles << " cycles" << std::endl;
+
+    if (elfs_.empty()) {
+      finished_ = true;
+      return true;
+    }
+    if (!LoadNextElf()) {
+      failed_ = true;
+      return true;
+    }
+    reset_cycles_ = kResetCycles;
+    return false;
+  }
+
+  virtual void OnClock(unsigned long sim_time) {
+    if (reset_cycles_) {
+      top_->IO_RST_N = --reset_cycles_ ? 0 : 1;
+    }
+    if (!top_->IO_RST_N) {
+      start_cycle_ = sim_time / 2 + 1;
+    }
+  }
+};
+
+// Make the OtbnBatchUtil object visible to OtbnTopProgramDone.
+static OtbnBatchUtil *otbn_batchutil;
+
 int main(int argc, char **argv) {
   VerilatorMemUtil memutil(&otbn_memutil);
   OtbnTraceUtil traceutil;
+  OtbnLoopWarpUtil loopwarputil(&otbn_memutil);
 
   otbn_top_sim top;
   // Make the otbn_top_sim object visible to OtbnTopApplyLoopWarp.
@@ -115,6 +351,11 @@ int main(int argc, char **argv) {
                  VerilatorSimCtrlFlags::ResetPolarityNegative);
   simctrl.RegisterExtension(&memutil);
   simctrl.RegisterExtension(&traceutil);
+  simctrl.RegisterExtension(&loopwarputil);
+
+  OtbnBatchUtil batchutil(&top, &otbn_memutil);
+  simctrl.RegisterExtension(&batchutil);
+  otbn_batchutil = &batchutil;
 
   std::cout << "Simulation of OTBN" << std::endl
             << "==================" << std::endl
@@ -128,31 +369,31 @@ int main(int argc, char **argv) {
     return ret_code;
   }
 
-  svSetScope(svGetScopeFromName("TOP.otbn_top_sim"));
-
-  svBit model_err = otbn_err_get();
-  if (model_err) {
-    return 1;
+  // In batch mode, each program was checked as it finished.
+  if (batchutil.IsBatch()) {
+    return batchutil.Passed() ? 0 : 1;
   }
 
-  int exp_stop_pc = otbn_memutil.GetExpEndAddr();
-  if (exp_stop_pc >= 0) {
-    SVScoped core_scope("TOP.otbn_top_sim.u_otbn_core_model");
-    int act_stop_pc = otbn_core_get_stop_pc();
-    if (exp_stop_pc != act_stop_pc) {
-      std::cerr << "ERROR: Expected stop PC from ELF file was 0x" << std::hex
-                << exp_stop_pc << ", but simulation actually stopped at 0x"
-                << act_stop_pc << ".\n";
-      return 1;
-    }
-  }
+  return CheckProgramResult() ? 0 : 1;
+}
 
-  return 0;
+// This is executed over DPI a few cycles after OTBN signals done. It returns
+// 1 if the simulation should finish, or 0 if OtbnBatchUtil has loaded another
+// program and is about to reset the design to run it.
+extern "C" svBit OtbnTopProgramDone() {
+  if (!otbn_batchutil || !otbn_batchutil->IsBatch()) {
+    return 1;
+  }
+  return otbn_batchutil->ProgramDone() ? 1 : 0;
 }
 
+// The iteration counts of the loops that the RTL is currently running, as
+// tracked by OtbnTopApplyLoopWarp.
+static std::vector<uint32_t> loop_count_stack;
+
 // This is executed over DPI on the first posedge of the clock after each
 // reset. It's in charge of telling the model about any loop warp symbols in
-// the ELF file.
+// the ELF file (and any warps loaded with --otbn-loop-warps).
 extern "C" int OtbnTopInstallLoopWarps() {
   // Cast to the right base class of otbn_top_sim. Otherwise, you can't access
   // the "otbn_top_sim" member because you get the derived class's constructor
@@ -170,6 +411,10 @@ extern "C" int OtbnTopInstallLoopWarps() {
 
   OtbnModel *model_handle = (OtbnModel *)sv_model_handle;
 
+  // A reset abandons any loops that were running when the last program
+  // stopped.
+  loop_count_stack.clear();
+
   if (model_handle->take_loop_warps(otbn_memutil) != 0) {
     // Something went wrong when trying to update the model. We've already
     // written to something to stderr, so should just pass the non-zero return
@@ -231,8 +476,6 @@ auto get_loop_counter(LoopControllerT *loop_controller, uint32_t counter_idx)
 // updating the top of the loop stack if necessary to match loop warp symbols
 // in the ELF file.
 extern "C" void OtbnTopApplyLoopWarp() {
-  static std::vector<uint32_t> loop_count_stack;
-
   // See not in OtbnTopInstallLoopWarps for why this upcast is needed.
   Votbn_top_sim &top = *verilator_top;
 
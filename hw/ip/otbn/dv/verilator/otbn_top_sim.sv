@@ -328,9 +328,13 @@ module otbn_top_sim (
     .alert_o          (                         )
   );
 
-  // When OTBN is done let a few more cycles run then finish simulation
+  // When OTBN is done let a few more cycles run then finish simulation, unless otbn_top_sim.cc has
+  // another program to run (in which case it loads that program and resets the design).
   logic [1:0] finish_counter;
 
+  // Defined in otbn_top_sim.cc
+  import "DPI-C" context function bit OtbnTopProgramDone();
+
   always @(posedge IO_CLK or negedge IO_RST_N) begin
     if (!IO_RST_N) begin
       finish_counter <= 2'd0;
@@ -344,7 +348,9 @@ module otbn_top_sim (
       end
 
       if (finish_counter == 2'd3) begin
-        $finish;
+        if (OtbnTopProgramDone()) begin
+          $finish;
+        end
       end
     end
   end
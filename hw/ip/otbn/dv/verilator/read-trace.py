@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''Extract records from an OTBN trace log
+
+This reads the trace logs that otbn_top_sim writes with --otbn-trace-file.
+These are either plain text or, if the file name ended in .otz, compressed
+blocks with an index (see hw/ip/otbn/dv/tracer/README.md for the format).
+Records are printed in the plain text format, so
+
+    read-trace.py trace.otz > trace.log
+
+gives the log that the simulation would otherwise have written. Use --cycles
+to extract a range of cycles (which only decompresses the blocks that cover
+it) and --pc or --reg to pick out records for particular instructions or
+registers:
+
+    read-trace.py --cycles 100000:100500 trace.otz
+    read-trace.py --pc 0x158 --reg w20 trace.otz
+
+'''
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+from typing import BinaryIO, Iterator, List, Optional, Tuple
+
+_FILE_HDR = struct.Struct('<4sHHII')
+_BLOCK_HDR = struct.Struct('<4sIIII')
+_INDEX_HDR = struct.Struct('<4sI')
+_INDEX_ENTRY = struct.Struct('<IIQ')
+_FOOTER = struct.Struct('<Q4s')
+
+# (first cycle, last cycle, offset of the block header)
+IndexEntry = Tuple[int, int, int]
+
+# The first line of a record that gives a cycle count (an 'E', 'S' or '!'
+# line). The PC is only there for 'E' and 'S' lines.
+_RECORD_RE = re.compile(r'([ES!]) (\d+)(?: PC: 0x([0-9a-fA-F]+))?')
+
+# A register name at the start of a '<' or '>' line
+_REG_RE = re.compile(r'[<>] ([^:]+):')
+
+
+def read_index(handle: BinaryIO) -> List[IndexEntry]:
+    '''Read the block index of a compressed trace
+
+    If the trace has no index (because the simulation that wrote it didn't
+    finish cleanly), build one by walking through the block headers.
+
+    '''
+    handle.seek(0, 2)
+    size = handle.tell()
+    if size >= _FILE_HDR.size + _FOOTER.size:
+        handle.seek(size - _FOOTER.size)
+        idx_off, magic = _FOOTER.unpack(handle.read(_FOOTER.size))
+        if magic == b'OTIE':
+            handle.seek(idx_off)
+            magic, count = _INDEX_HDR.unpack(handle.read(_INDEX_HDR.size))
+            if magic == b'OTIX':
+                data = handle.read(count * _INDEX_ENTRY.size)
+                return list(_INDEX_ENTRY.iter_unpack(data))
+
+    index = []
+    offset = _FILE_HDR.size
+    while offset + _BLOCK_HDR.size <= size:
+        handle.seek(offset)
+        magic, first, last, _, comp_len = \
+            _BLOCK_HDR.unpack(handle.read(_BLOCK_HDR.size))
+        if magic != b'OTBK':
+            break
+        if offset + _BLOCK_HDR.size + comp_len > size:
+            print(f'Warning: block at offset {offset} is truncated.',
+                  file=sys.stderr)
+            break
+        index.append((first, last, offset))
+        offset += _BLOCK_HDR.size + comp_len
+    return index
+
+
+def read_block(handle: BinaryIO, offset: int) -> str:
+    '''Read and decompress the text of the block at offset'''
+    handle.seek(offset)
+    magic, _, _, text_len, comp_len = \
+        _BLOCK_HDR.unpack(handle.read(_BLOCK_HDR.size))
+    if magic != b'OTBK':
+        raise ValueError(f'No block header at offset {offset}.')
+    text = zlib.decompress(handle.read(comp_len))
+    if len(text) != text_len:
+        raise ValueError(f'Block at offset {offset} decompressed to '
+                         f'{len(text)} bytes, not {text_len}.')
+    return text.decode('utf-8')
+
+
+def compressed_lines(handle: BinaryIO,
+                     first: Optional[int],
+                     last: Optional[int]) -> Iterator[str]:
+    '''Yield lines of a compressed trace from blocks that might overlap the
+    cycle range [first, last]'''
+    for blk_first, blk_last, offset in read_index(handle):
+        if first is not None and blk_last < first:
+            continue
+        if last is not None and blk_first > last:
+            continue
+        yield from read_block(handle, offset).splitlines()
+
+
+def records(
+        lines: Iterator[str]) -> Iterator[Tuple[Optional[int], List[str]]]:
+    '''Group lines into records, yielding (cycle, lines) for each
+
+    A record starts with a line that is not indented. The cycle is None if
+    that line doesn't give one.
+
+    '''
+    cycle = None  # type: Optional[int]
+    record = []  # type: List[str]
+    for line in lines:
+        if record and not line.startswith('    '):
+            yield (cycle, record)
+            record = []
+        if not record:
+            match = _RECORD_RE.match(line)
+            cycle = int(match.group(2)) if match else None
+        record.append(line)
+    if record:
+        yield (cycle, record)
+
+
+def record_pc(record: List[str]) -> Optional[int]:
+    match = _RECORD_RE.match(record[0])
+    if match is None or match.group(3) is None:
+        return None
+    return int(match.group(3), 16)
+
+
+def record_regs(record: List[str]) -> List[str]:
+    regs = []
+    for line in record:
+        match = _REG_RE.match(line.strip())
+        if match:
+            regs.append(match.group(1).lower())
+    return regs
+
+
+def parse_cycles(arg: str) -> Tuple[Optional[int], Optional[int]]:
+    '''Parse a cycle range of the form FIRST:LAST, FIRST: or :LAST, or a
+    single cycle'''
+    if ':' not in arg:
+        return (int(arg, 0), int(arg, 0))
+    first, last = arg.split(':', 1)
+    return (int(first, 0) if first else None,
+            int(last, 0) if last else None)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('trace', help='Trace log (plain text or .otz)')
+    parser.add_argument('--cycles', type=parse_cycles,
+                        help=('Only show records for these cycles, given '
+                              'as FIRST:LAST (inclusive); either end can '
+                              'be omitted'))
+    parser.add_argument('--pc', type=lambda s: int(s, 0), action='append',
+                        help=('Only show records for instructions at this '
+                              'PC. Can be given more than once.'))
+    parser.add_argument('--reg', action='append',
+                        help=('Only show records that read or write this '
+                              'register (such as x5, w20, ACC or FLAGS0). '
+                              'Can be given more than once.'))
+    parser.add_argument('--index', action='store_true',
+                        help=('Print the block index of a compressed trace '
+                              'instead of any records'))
+    args = parser.parse_args()
+
+    first, last = args.cycles if args.cycles is not None else (None, None)
+    pcs = set(args.pc or [])
+    regs = set(reg.lower() for reg in args.reg or [])
+
+    with open(args.trace, 'rb') as handle:
+        magic = handle.read(_FILE_HDR.size)
+        compressed = magic[:4] == b'OTTZ'
+        if compressed:
+            version = _FILE_HDR.unpack(magic)[1]
+            if version != 1:
+                print(f'Unsupported compressed trace version: {version}.',
+                      file=sys.stderr)
+                return 1
+
+        if args.index:
+            if not compressed:
+                print(f'{args.trace} is not a compressed trace.',
+                      file=sys.stderr)
+                return 1
+            for blk_first, blk_last, offset in read_index(handle):
+                print(f'{offset:#010x}: cycles {blk_first} to {blk_last}')
+            return 0
+
+        if compressed:
+            lines = compressed_lines(handle, first, last)
+        else:
+            handle.seek(0)
+            lines = (line.decode('utf-8').rstrip('\n') for line in handle)
+
+        try:
+            for cycle, record in records(lines):
+                if cycle is not None:
+                    if first is not None and cycle < first:
+                        continue
+                    if last is not None and cycle > last:
+                        continue
+                elif first is not None or last is not None:
+                    continue
+                if pcs and record_pc(record) not in pcs:
+                    continue
+                if regs and not regs.intersection(record_regs(record)):
+                    continue
+                print('\n'.join(record))
+        except BrokenPipeError:
+            # The output was probably piped to something like head
+            sys.stderr.close()
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -683,3 +683,179 @@ dif_result_t dif_otp_ctrl_read_blocking(const dif_otp_ctrl_t *otp,
                                  len * sizeof(uint32_t));
   return kDifOk;
 }
+
+/**
+ * Issues the DAI read of the word `read` is currently positioned at.
+ */
+static void dai_read_issue(const dif_otp_ctrl_t *otp,
+                           const dif_otp_ctrl_dai_read_t *read) {
+  uint32_t address = kPartitions[read->partition].start_addr + read->address;
+  mmio_region_write32(otp->base_addr, OTP_CTRL_DIRECT_ACCESS_ADDRESS_REG_OFFSET,
+                      address);
+
+  uint32_t cmd =
+      bitfield_bit32_write(0, OTP_CTRL_DIRECT_ACCESS_CMD_RD_BIT, true);
+  mmio_region_write32(otp->base_addr, OTP_CTRL_DIRECT_ACCESS_CMD_REG_OFFSET,
+                      cmd);
+}
+
+dif_result_t dif_otp_ctrl_dai_read_batch_start(
+    const dif_otp_ctrl_t *otp, dif_otp_ctrl_dai_read_t *read,
+    dif_otp_ctrl_partition_t partition, uint32_t address, uint32_t *buf,
+    size_t len) {
+  if (otp == NULL || read == NULL || partition >= ARRAYSIZE(kPartitions) ||
+      buf == NULL || len == 0) {
+    return kDifBadArg;
+  }
+
+  uint32_t align_mask = kPartitions[partition].align_mask;
+  if ((address & align_mask) != 0) {
+    return kDifUnaligned;
+  }
+
+  if (address >= kPartitions[partition].len ||
+      len > (kPartitions[partition].len - address) / sizeof(uint32_t)) {
+    return kDifOutOfRange;
+  }
+
+  // Secret partitions are read in 64-bit words.
+  if (((len * sizeof(uint32_t)) & align_mask) != 0) {
+    return kDifUnaligned;
+  }
+
+  *read = (dif_otp_ctrl_dai_read_t){
+      .partition = partition,
+      .address = address,
+      .buf = buf,
+      .words_left = len,
+  };
+  dai_read_issue(otp, read);
+
+  return kDifOk;
+}
+
+dif_result_t dif_otp_ctrl_dai_read_batch_service(const dif_otp_ctrl_t *otp,
+                                                 dif_otp_ctrl_dai_read_t *read,
+                                                 bool *done) {
+  if (otp == NULL || read == NULL || done == NULL) {
+    return kDifBadArg;
+  }
+
+  if (read->words_left == 0) {
+    *done = true;
+    return kDifOk;
+  }
+
+  uint32_t status =
+      mmio_region_read32(otp->base_addr, OTP_CTRL_STATUS_REG_OFFSET);
+  if (bitfield_bit32_read(status, OTP_CTRL_STATUS_DAI_ERROR_BIT)) {
+    return kDifError;
+  }
+  if (!bitfield_bit32_read(status, OTP_CTRL_STATUS_DAI_IDLE_BIT)) {
+    *done = false;
+    return kDifOk;
+  }
+
+  size_t words = 1;
+  read->buf[0] = mmio_region_read32(otp->base_addr,
+                                    OTP_CTRL_DIRECT_ACCESS_RDATA_0_REG_OFFSET);
+  if (kPartitions[read->partition].align_mask == 0x7) {
+    read->buf[1] = mmio_region_read32(
+        otp->base_addr, OTP_CTRL_DIRECT_ACCESS_RDATA_1_REG_OFFSET);
+    words = 2;
+  }
+  read->buf += words;
+  read->address += words * sizeof(uint32_t);
+  read->words_left -= words;
+
+  // Start the next word straight away so the DAI does not sit idle while the
+  // caller handles this one.
+  if (read->words_left > 0) {
+    dai_read_issue(otp, read);
+  }
+  *done = read->words_left == 0;
+
+  return kDifOk;
+}
+
+dif_result_t dif_otp_ctrl_partition_cache_init(
+    dif_otp_ctrl_partition_cache_t *cache, dif_otp_ctrl_partition_t partition,
+    uint32_t *buf, size_t len) {
+  if (cache == NULL || partition >= ARRAYSIZE(kPartitions) || buf == NULL ||
+      len < kPartitions[partition].len / sizeof(uint32_t)) {
+    return kDifBadArg;
+  }
+
+  *cache = (dif_otp_ctrl_partition_cache_t){
+      .partition = partition,
+      .buf = buf,
+      .valid = false,
+  };
+  return kDifOk;
+}
+
+/**
+ * Fills `cache` with the contents of its partition.
+ *
+ * Software partitions are copied through the memory-mapped window; all other
+ * partitions are read through the DAI, busy-waiting for each word.
+ */
+static dif_result_t partition_cache_fill(
+    const dif_otp_ctrl_t *otp, dif_otp_ctrl_partition_cache_t *cache) {
+  const partition_info_t *info = &kPartitions[cache->partition];
+  if (info->is_software) {
+    mmio_region_memcpy_from_mmio32(
+        otp->base_addr, OTP_CTRL_SW_CFG_WINDOW_REG_OFFSET + info->start_addr,
+        cache->buf, info->len);
+  } else {
+    dif_otp_ctrl_dai_read_t read;
+    DIF_RETURN_IF_ERROR(dif_otp_ctrl_dai_read_batch_start(
+        otp, &read, cache->partition, 0, cache->buf,
+        info->len / sizeof(uint32_t)));
+    bool done = false;
+    while (!done) {
+      DIF_RETURN_IF_ERROR(
+          dif_otp_ctrl_dai_read_batch_service(otp, &read, &done));
+    }
+  }
+  cache->valid = true;
+  return kDifOk;
+}
+
+dif_result_t dif_otp_ctrl_partition_cache_read(
+    const dif_otp_ctrl_t *otp, dif_otp_ctrl_partition_cache_t *cache,
+    uint32_t address, uint32_t *buf, size_t len) {
+  if (otp == NULL || cache == NULL || buf == NULL) {
+    return kDifBadArg;
+  }
+
+  const partition_info_t *info = &kPartitions[cache->partition];
+  if ((address & info->align_mask) != 0) {
+    return kDifUnaligned;
+  }
+
+  if (address >= info->len ||
+      len > (info->len - address) / sizeof(uint32_t)) {
+    return kDifOutOfRange;
+  }
+
+  if (!cache->valid) {
+    DIF_RETURN_IF_ERROR(partition_cache_fill(otp, cache));
+  }
+
+  const uint32_t *src = &cache->buf[address / sizeof(uint32_t)];
+  for (size_t i = 0; i < len; ++i) {
+    buf[i] = src[i];
+  }
+  return kDifOk;
+}
+
+dif_result_t dif_otp_ctrl_partition_cache_invalidate(
+    dif_otp_ctrl_partition_cache_t *cache) {
+  if (cache == NULL) {
+    return kDifBadArg;
+  }
+
+  cache->valid = false;
+  return kDifOk;
+}
@@ -16,20 +16,8 @@
 static const uint8_t sbox4[16] = {0xc, 0x5, 0x6, 0xb, 0x9, 0x0, 0xa, 0xd,
                                   0x3, 0xe, 0xf, 0x8, 0x4, 0x7, 0x1, 0x2};
 
-static const uint8_t sbox4_inv[16] = {0x5, 0xe, 0xf, 0x8, 0xc, 0x1, 0x2, 0xd,
-                                      0xb, 0x4, 0x6, 0x3, 0x0, 0x7, 0x9, 0xa};
-
-static const uint8_t bit_perm[64] = {
-    0,  16, 32, 48, 1,  17, 33, 49, 2,  18, 34, 50, 3,  19, 35, 51,
-    4,  20, 36, 52, 5,  21, 37, 53, 6,  22, 38, 54, 7,  23, 39, 55,
-    8,  24, 40, 56, 9,  25, 41, 57, 10, 26, 42, 58, 11, 27, 43, 59,
-    12, 28, 44, 60, 13, 29, 45, 61, 14, 30, 46, 62, 15, 31, 47, 63};
-
-static const uint8_t bit_perm_inv[64] = {
-    0, 4, 8,  12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60,
-    1, 5, 9,  13, 17, 21, 25, 29, 33, 37, 41, 45, 49, 53, 57, 61,
-    2, 6, 10, 14, 18, 22, 26, 30, 34, 38, 42, 46, 50, 54, 58, 62,
-    3, 7, 11, 15, 19, 23, 27, 31, 35, 39, 43, 47, 51, 55, 59, 63};
+// Bit 0 of each nibble in a 64-bit word
+static const uint64_t kNibbleLsbs = 0x1111111111111111;
 
 static uint64_t mask64(int bits) { return ((uint64_t)1 << bits) - 1; }
 
@@ -50,6 +38,13 @@ class PresentState {
   // round and with is_last_round set, then count down.
   uint64_t dec_round(uint64_t input, unsigned round, bool is_last_round) const;
 
+  // Run rounds 1 to num_rounds of enc_round, with is_last_round set on the
+  // final one.
+  uint64_t encrypt(uint64_t input, unsigned num_rounds) const;
+
+  // The inverse of encrypt.
+  uint64_t decrypt(uint64_t input, unsigned num_rounds) const;
+
  private:
   static key128_t next_round_key(const key128_t &k, unsigned key_size,
                                  unsigned round_count);
@@ -119,6 +114,22 @@ uint64_t PresentState::dec_round(uint64_t input, unsigned round,
   return w4;
 }
 
+uint64_t PresentState::encrypt(uint64_t input, unsigned num_rounds) const {
+  uint64_t state = input;
+  for (unsigned round = 1; round <= num_rounds; ++round) {
+    state = enc_round(state, round, round == num_rounds);
+  }
+  return state;
+}
+
+uint64_t PresentState::decrypt(uint64_t input, unsigned num_rounds) const {
+  uint64_t state = input;
+  for (unsigned round = num_rounds; round > 0; --round) {
+    state = dec_round(state, round, round == num_rounds);
+  }
+  return state;
+}
+
 key128_t PresentState::next_round_key(const key128_t &k, unsigned key_size,
                                       unsigned round_count) {
   assert((round_count >> 5) == 0);
@@ -187,21 +198,60 @@ uint64_t PresentState::add_round_key(uint64_t data, const key128_t &k,
   return data ^ k64;
 }
 
+// Bit-sliced SBOX applied to every nibble of data. Each output bit is the
+// algebraic normal form of the corresponding SBOX output bit, evaluated on all
+// 16 nibbles at once.
 uint64_t PresentState::sbox_layer(bool inverse, uint64_t data) {
-  uint64_t ret = 0;
-  for (int i = 0; i < 64 / 4; ++i) {
-    unsigned nibble = (data >> (4 * i)) & 0xf;
-    uint64_t subst = inverse ? sbox4_inv[nibble] : sbox4[nibble];
-    ret |= subst << (4 * i);
+  const uint64_t x0 = data & kNibbleLsbs;
+  const uint64_t x1 = (data >> 1) & kNibbleLsbs;
+  const uint64_t x2 = (data >> 2) & kNibbleLsbs;
+  const uint64_t x3 = (data >> 3) & kNibbleLsbs;
+  const uint64_t one = kNibbleLsbs;
+
+  const uint64_t x01 = x0 & x1, x02 = x0 & x2, x12 = x1 & x2, x13 = x1 & x3;
+  const uint64_t x23 = x2 & x3, x03 = x0 & x3, x012 = x01 & x2;
+  const uint64_t x013 = x01 & x3, x023 = x0 & x23;
+
+  uint64_t y0, y1, y2, y3;
+  if (!inverse) {
+    y0 = x0 ^ x2 ^ x12 ^ x3;
+    y1 = x1 ^ x012 ^ x3 ^ x13 ^ x013 ^ x23 ^ x023;
+    y2 = one ^ x01 ^ x2 ^ x3 ^ x03 ^ x13 ^ x013 ^ x023;
+    y3 = one ^ x0 ^ x1 ^ x12 ^ x012 ^ x3 ^ x013 ^ x023;
+  } else {
+    y0 = one ^ x0 ^ x2 ^ x13;
+    y1 = x0 ^ x1 ^ x02 ^ x012 ^ x3 ^ x13 ^ x013 ^ x23 ^ x023;
+    y2 = one ^ x01 ^ x02 ^ x12 ^ x012 ^ x3 ^ x03 ^ x13 ^ x013 ^ x023;
+    y3 = x0 ^ x1 ^ x01 ^ x2 ^ x012 ^ x3 ^ x023;
   }
-  return ret;
+
+  return y0 | (y1 << 1) | (y2 << 2) | (y3 << 3);
+}
+
+// Swap the bits of x selected by mask with the bits delta places above them
+static uint64_t delta_swap(uint64_t x, uint64_t mask, unsigned delta) {
+  uint64_t t = ((x >> delta) ^ x) & mask;
+  return x ^ t ^ (t << delta);
 }
 
+// The permutation moves bit 4 * i + j to bit 16 * j + i. Viewing a bit index
+// as 6 bits, that is a rotation of the index by two places, which is done by
+// swapping pairs of index bits with a delta swap each. Each swap is its own
+// inverse, so the inverse permutation applies them in the opposite order.
 uint64_t PresentState::perm_layer(bool inverse, uint64_t data) {
-  uint64_t ret = 0;
-  for (int i = 0; i < 64; ++i) {
-    uint64_t bit = (data >> i) & 1;
-    ret |= bit << (inverse ? bit_perm_inv[i] : bit_perm[i]);
+  static const struct {
+    uint64_t mask;
+    unsigned delta;
+  } swaps[] = {{0x0a0a0a0a0a0a0a0a, 3},
+               {0x00cc00cc00cc00cc, 6},
+               {0x0000f0f00000f0f0, 12},
+               {0x00000000ff00ff00, 24}};
+  const int num_swaps = sizeof(swaps) / sizeof(swaps[0]);
+
+  uint64_t ret = data;
+  for (int i = 0; i < num_swaps; ++i) {
+    int idx = inverse ? num_swaps - 1 - i : i;
+    ret = delta_swap(ret, swaps[idx].mask, swaps[idx].delta);
   }
   return ret;
 }
@@ -254,4 +304,63 @@ void c_dpi_present_dec_round(const PresentState *ps, unsigned round,
   dst[1] = out64 >> 32;
   dst[0] = (uint32_t)out64;
 }
+
+void c_dpi_present_encrypt(const PresentState *ps, unsigned num_rounds,
+                           const svBitVecVal *src, svBitVecVal *dst) {
+  assert(ps);
+
+  uint64_t in64 = ((uint64_t)src[1] << 32) | src[0];
+  uint64_t out64 = ps->encrypt(in64, num_rounds);
+
+  dst[1] = out64 >> 32;
+  dst[0] = (uint32_t)out64;
+}
+
+void c_dpi_present_decrypt(const PresentState *ps, unsigned num_rounds,
+                           const svBitVecVal *src, svBitVecVal *dst) {
+  assert(ps);
+
+  uint64_t in64 = ((uint64_t)src[1] << 32) | src[0];
+  uint64_t out64 = ps->decrypt(in64, num_rounds);
+
+  dst[1] = out64 >> 32;
+  dst[0] = (uint32_t)out64;
+}
+
+// Encrypt or decrypt every element of the open array src into the
+// corresponding element of dst, which must have the same size.
+static void present_blocks(const PresentState *ps, unsigned num_rounds,
+                           bool decrypt, const svOpenArrayHandle src,
+                           const svOpenArrayHandle dst) {
+  assert(ps);
+
+  int num_blocks = svSize(src, 1);
+  assert(svSize(dst, 1) == num_blocks);
+
+  int src_low = svLow(src, 1), dst_low = svLow(dst, 1);
+  for (int i = 0; i < num_blocks; ++i) {
+    svBitVecVal w32s[2];
+    svGetBitArrElem1VecVal(w32s, src, src_low + i);
+
+    uint64_t in64 = ((uint64_t)w32s[1] << 32) | w32s[0];
+    uint64_t out64 = decrypt ? ps->decrypt(in64, num_rounds)
+                             : ps->encrypt(in64, num_rounds);
+
+    w32s[1] = out64 >> 32;
+    w32s[0] = (uint32_t)out64;
+    svPutBitArrElem1VecVal(dst, w32s, dst_low + i);
+  }
+}
+
+void c_dpi_present_encrypt_blocks(const PresentState *ps, unsigned num_rounds,
+                                  const svOpenArrayHandle src,
+                                  const svOpenArrayHandle dst) {
+  present_blocks(ps, num_rounds, false, src, dst);
+}
+
+void c_dpi_present_decrypt_blocks(const PresentState *ps, unsigned num_rounds,
+                                  const svOpenArrayHandle src,
+                                  const svOpenArrayHandle dst) {
+  present_blocks(ps, num_rounds, true, src, dst);
+}
 }
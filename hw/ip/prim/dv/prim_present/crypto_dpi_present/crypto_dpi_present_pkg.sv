@@ -24,6 +24,27 @@ package crypto_dpi_present_pkg;
                                                        bit [DataWidth-1:0]        in,
                                                        output bit [DataWidth-1:0] out);
 
+  // Run all num_rounds rounds of the cipher in a single call.
+  import "DPI-C" function void c_dpi_present_encrypt(chandle                    h,
+                                                     int unsigned               num_rounds,
+                                                     bit [DataWidth-1:0]        in,
+                                                     output bit [DataWidth-1:0] out);
+  import "DPI-C" function void c_dpi_present_decrypt(chandle                    h,
+                                                     int unsigned               num_rounds,
+                                                     bit [DataWidth-1:0]        in,
+                                                     output bit [DataWidth-1:0] out);
+
+  // Batch variants, which process every element of the input array with the same key. The output
+  // array must have the same size as the input array.
+  import "DPI-C" function void c_dpi_present_encrypt_blocks(chandle                    h,
+                                                            int unsigned               num_rounds,
+                                                            bit [DataWidth-1:0]        in[],
+                                                            output bit [DataWidth-1:0] out[]);
+  import "DPI-C" function void c_dpi_present_decrypt_blocks(chandle                    h,
+                                                            int unsigned               num_rounds,
+                                                            bit [DataWidth-1:0]        in[],
+                                                            output bit [DataWidth-1:0] out[]);
+
   // This function encrypts the input plaintext with the PRESENT encryption algorithm.
   //
   // This produces a list of all intermediate values produced after each round of the algorithm,
@@ -36,15 +57,9 @@ package crypto_dpi_present_pkg;
     output bit [DataWidth-1:0]  ciphertext
   );
 
-    bit [DataWidth-1:0] round_in, round_out;
     chandle h = c_dpi_present_mk(key_size, key);
 
-    round_out = plaintext;
-    for (int i = 1; i <= num_rounds; i++) begin
-      round_in = round_out;
-      c_dpi_present_enc_round(h, i, i == num_rounds, round_in, round_out);
-    end
-    ciphertext = round_out;
+    c_dpi_present_encrypt(h, num_rounds, plaintext, ciphertext);
 
     c_dpi_present_free(h);
 
@@ -62,15 +77,9 @@ package crypto_dpi_present_pkg;
     output bit [DataWidth-1:0]  plaintext
   );
 
-    bit [DataWidth-1:0] round_in, round_out;
     chandle h = c_dpi_present_mk(key_size, key);
 
-    round_in = ciphertext;
-    for (int i = num_rounds; i > 0; i--) begin
-      c_dpi_present_dec_round(h, i, i == num_rounds, round_in, round_out);
-      round_in = round_out;
-    end
-    plaintext = round_out;
+    c_dpi_present_decrypt(h, num_rounds, ciphertext, plaintext);
 
     c_dpi_present_free(h);
 
@@ -6,6 +6,7 @@
 extern "C" {
 #endif
 
+#include <assert.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -28,6 +29,53 @@ extern uint64_t c_dpi_prince_decrypt(const uint64_t ciphertext,
                                old_key_schedule);
 }
 
+// Encrypts or decrypts every element of the open array `in` into the
+// corresponding element of `out`, which must have the same size.
+static void prince_blocks(const svOpenArrayHandle in,
+                          const svOpenArrayHandle out, uint64_t key0,
+                          uint64_t key1, int decrypt, int num_half_rounds,
+                          int old_key_schedule) {
+  const int num_blocks = svSize(in, 1);
+  assert(svSize(out, 1) == num_blocks);
+
+  const uint64_t *in_ptr = (const uint64_t *)svGetArrayPtr(in);
+  uint64_t *out_ptr = (uint64_t *)svGetArrayPtr(out);
+  if (in_ptr && out_ptr) {
+    // C-style layout
+    prince_enc_dec_uint64_blocks(in_ptr, out_ptr, num_blocks, key0, key1,
+                                 decrypt, num_half_rounds, old_key_schedule);
+    return;
+  }
+
+  const int in_low = svLow(in, 1);
+  const int out_low = svLow(out, 1);
+  for (int i = 0; i < num_blocks; ++i) {
+    const uint64_t *src = (const uint64_t *)svGetArrElemPtr1(in, in_low + i);
+    uint64_t *dst = (uint64_t *)svGetArrElemPtr1(out, out_low + i);
+    assert(src && dst);
+    *dst = prince_enc_dec_uint64(*src, key0, key1, decrypt, num_half_rounds,
+                                 old_key_schedule);
+  }
+}
+
+extern void c_dpi_prince_encrypt_blocks(const svOpenArrayHandle plaintext,
+                                        const svOpenArrayHandle ciphertext,
+                                        uint64_t key0, uint64_t key1,
+                                        int num_half_rounds,
+                                        int old_key_schedule) {
+  prince_blocks(plaintext, ciphertext, key0, key1, 0, num_half_rounds,
+                old_key_schedule);
+}
+
+extern void c_dpi_prince_decrypt_blocks(const svOpenArrayHandle ciphertext,
+                                        const svOpenArrayHandle plaintext,
+                                        uint64_t key0, uint64_t key1,
+                                        int num_half_rounds,
+                                        int old_key_schedule) {
+  prince_blocks(ciphertext, plaintext, key0, key1, 1, num_half_rounds,
+                old_key_schedule);
+}
+
 #ifdef _cplusplus
 }
 #endif
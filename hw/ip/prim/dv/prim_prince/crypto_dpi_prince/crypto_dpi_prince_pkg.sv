@@ -27,6 +27,26 @@ package crypto_dpi_prince_pkg;
     input int unsigned      new_key_schedule
   );
 
+  // Batch variants, which process every element of the input array with the same key. The output
+  // array must have the same size as the input array.
+  import "DPI-C" context function void c_dpi_prince_encrypt_blocks(
+    input longint unsigned  data[],
+    output longint unsigned out[],
+    input longint unsigned  key0,
+    input longint unsigned  key1,
+    input int unsigned      num_half_rounds,
+    input int unsigned      new_key_schedule
+  );
+
+  import "DPI-C" context function void c_dpi_prince_decrypt_blocks(
+    input longint unsigned  data[],
+    output longint unsigned out[],
+    input longint unsigned  key0,
+    input longint unsigned  key1,
+    input int unsigned      num_half_rounds,
+    input int unsigned      new_key_schedule
+  );
+
   //////////////////////////////////////////////////////
   // SV wrapper functions to be used by the testbench //
   //////////////////////////////////////////////////////
@@ -33,8 +33,14 @@
  *      schedule detailed in the original PRINCE paper and a newer key schedule.
  *    - Modification of `prince_core(...)` to handle the new key schedule and
  *      user-specified number of half-rounds.
+ *    - Replacement of the per-nibble S-box lookups and the bitwise matrix
+ *      multiplication in the S and M' steps with table-free 64-bit word
+ *      operations.
+ *    - Addition of `prince_enc_dec_uint64_blocks(...)` to process several
+ *      blocks with the same key.
  */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -86,109 +92,100 @@ static uint64_t prince_round_constant(const unsigned int round) {
 }
 
 /**
- * The 4 bit Prince sbox.
- *
- * Only the 4 lsb are taken into account to preserve nibble granularity.
+ * Masks selecting bit `i` of every nibble, or every nibble of a 16-bit lane.
  */
-static unsigned int prince_sbox(unsigned int nibble) {
-  const unsigned int sbox[] = {0xb, 0xf, 0x3, 0x2, 0xa, 0xc, 0x9, 0x1,
-                               0x6, 0x7, 0x8, 0x0, 0xe, 0x5, 0xd, 0x4};
-  return sbox[nibble & 0xF];
-}
-
-/**
- * The 4 bit Prince inverse sbox.
- *
- * Only the 4 lsb are taken into account to preserve nibble granularity.
- */
-static unsigned int prince_sbox_inv(unsigned int nibble) {
-  const unsigned int sbox[] = {0xb, 0x7, 0x3, 0x2, 0xf, 0xd, 0x8, 0x9,
-                               0xa, 0x6, 0x4, 0x0, 0x5, 0xe, 0xc, 0x1};
-  return sbox[nibble & 0xF];
-}
+#define PRINCE_NIBBLE_BIT0 0x1111111111111111
+#define PRINCE_LANE_NIBBLE0 0x000F000F000F000F
 
 /**
  * The S step of the Prince cipher.
+ *
+ * All 16 S-boxes are evaluated at once: `xi` holds bit i of every nibble and
+ * each output bit is computed from the algebraic normal form of the S-box.
  */
 static uint64_t prince_s_layer(const uint64_t s_in) {
-  uint64_t s_out = 0;
-  for (unsigned int i = 0; i < 16; i++) {
-    const unsigned int shift = i * 4;
-    const unsigned int sbox_in = s_in >> shift;
-    const uint64_t sbox_out = prince_sbox(sbox_in);
-    s_out |= sbox_out << shift;
-  }
-  return s_out;
+  const uint64_t mask = PRINCE_NIBBLE_BIT0;
+  const uint64_t x0 = s_in & mask;
+  const uint64_t x1 = (s_in >> 1) & mask;
+  const uint64_t x2 = (s_in >> 2) & mask;
+  const uint64_t x3 = (s_in >> 3) & mask;
+  const uint64_t x01 = x0 & x1;
+  const uint64_t x02 = x0 & x2;
+  const uint64_t x12 = x1 & x2;
+  const uint64_t x03 = x0 & x3;
+  const uint64_t x13 = x1 & x3;
+  const uint64_t x23 = x2 & x3;
+  const uint64_t x012 = x01 & x2;
+  const uint64_t x013 = x01 & x3;
+  const uint64_t x023 = x02 & x3;
+  const uint64_t x123 = x12 & x3;
+  const uint64_t y0 = mask ^ x01 ^ x2 ^ x12 ^ x012 ^ x3 ^ x03 ^ x23;
+  const uint64_t y1 = mask ^ x02 ^ x12 ^ x012 ^ x13 ^ x123;
+  const uint64_t y2 = x0 ^ x01 ^ x3 ^ x03 ^ x13 ^ x013 ^ x123;
+  const uint64_t y3 = mask ^ x1 ^ x12 ^ x012 ^ x3 ^ x013 ^ x23 ^ x023;
+  return y0 | (y1 << 1) | (y2 << 2) | (y3 << 3);
 }
 
 /**
  * The S^-1 step of the Prince cipher.
  */
 static uint64_t prince_s_inv_layer(const uint64_t s_inv_in) {
-  uint64_t s_inv_out = 0;
-  for (unsigned int i = 0; i < 16; i++) {
-    const unsigned int shift = i * 4;
-    const unsigned int sbox_in = s_inv_in >> shift;
-    const uint64_t sbox_out = prince_sbox_inv(sbox_in);
-    s_inv_out |= sbox_out << shift;
-  }
-  return s_inv_out;
-}
-
-static uint64_t gf2_mat_mult16_1(const uint64_t in, const uint64_t mat[16]) {
-  uint64_t out = 0;
-  for (unsigned int i = 0; i < 16; i++) {
-    if ((in >> i) & 1)
-      out ^= mat[i];
-  }
-  return out;
+  const uint64_t mask = PRINCE_NIBBLE_BIT0;
+  const uint64_t x0 = s_inv_in & mask;
+  const uint64_t x1 = (s_inv_in >> 1) & mask;
+  const uint64_t x2 = (s_inv_in >> 2) & mask;
+  const uint64_t x3 = (s_inv_in >> 3) & mask;
+  const uint64_t x01 = x0 & x1;
+  const uint64_t x02 = x0 & x2;
+  const uint64_t x12 = x1 & x2;
+  const uint64_t x13 = x1 & x3;
+  const uint64_t x23 = x2 & x3;
+  const uint64_t x012 = x01 & x2;
+  const uint64_t x013 = x01 & x3;
+  const uint64_t x023 = x02 & x3;
+  const uint64_t x123 = x12 & x3;
+  const uint64_t y0 = mask ^ x01 ^ x12 ^ x3 ^ x013 ^ x23 ^ x023;
+  const uint64_t y1 = mask ^ x02 ^ x12 ^ x012 ^ x13 ^ x23;
+  const uint64_t y2 = x0 ^ x01 ^ x2 ^ x02 ^ x12 ^ x012 ^ x13 ^ x013;
+  const uint64_t y3 =
+      mask ^ x0 ^ x1 ^ x01 ^ x02 ^ x12 ^ x012 ^ x23 ^ x023 ^ x123;
+  return y0 | (y1 << 1) | (y2 << 2) | (y3 << 3);
 }
 
 /**
- * Build Prince's 16 bit matrices M0 and M1.
+ * Rotates each 16-bit lane of `in` left by `shift` bits, 0 < shift < 16.
  */
-static inline void prince_m16_matrices(uint64_t m16[2][16]) {
-  // 4 bits matrices m0 to m3 are stored in array m4
-  const uint64_t m4[4][4] = {// m0
-                             {0x0, 0x2, 0x4, 0x8},
-                             // m1
-                             {0x1, 0x0, 0x4, 0x8},
-                             // m2
-                             {0x1, 0x2, 0x0, 0x8},
-                             // m3
-                             {0x1, 0x2, 0x4, 0x0}};
-  // build 16 bits matrices
-  for (unsigned int i = 0; i < 16; i++) {
-    const unsigned int base = i / 4;
-    m16[0][i] =
-        (m4[(base + 3) % 4][i % 4] << 8) | (m4[(base + 2) % 4][i % 4] << 4) |
-        (m4[(base + 1) % 4][i % 4] << 0) | (m4[(base + 0) % 4][i % 4] << 12);
-    m16[1][i] =
-        (m16[0][i] >> 12) |
-        (0xFFFF & (m16[0][i] << 4));  // m1 is just a rotated version of m0
-  }
+static uint64_t prince_rotl16_lanes(const uint64_t in, unsigned int shift) {
+  const uint64_t lane_lo = 0x0001000100010001 * ((1u << shift) - 1);
+  return ((in << shift) & ~lane_lo) | ((in >> (16 - shift)) & lane_lo);
 }
 
 /**
  * The M' step of the Prince cipher.
+ *
+ * M' applies M0 to the outer and M1 to the inner 16-bit chunks. Bit b of
+ * output nibble r of M0 is the XOR of bit b of all input nibbles except
+ * nibble (3 + b - r) mod 4, and M1 is M0 with the output rotated by one
+ * nibble. All four chunks are processed together.
  */
 static uint64_t prince_m_prime_layer(const uint64_t m_prime_in) {
-  // 16 bits matrices M0 and M1, generated using the code below
-  // uint64_t m16[2][16];prince_m16_matrices(m16);
-  // for(unsigned int i=0;i<16;i++) PRINCE_PRINT(m16[0][i]);
-  // for(unsigned int i=0;i<16;i++) PRINCE_PRINT(m16[1][i]);
-  static const uint64_t m16[2][16] = {
-      {0x0111, 0x2220, 0x4404, 0x8088, 0x1011, 0x0222, 0x4440, 0x8808, 0x1101,
-       0x2022, 0x0444, 0x8880, 0x1110, 0x2202, 0x4044, 0x0888},
-
-      {0x1110, 0x2202, 0x4044, 0x0888, 0x0111, 0x2220, 0x4404, 0x8088, 0x1011,
-       0x0222, 0x4440, 0x8808, 0x1101, 0x2022, 0x0444, 0x8880}};
-  const uint64_t chunk0 = gf2_mat_mult16_1(m_prime_in >> (0 * 16), m16[0]);
-  const uint64_t chunk1 = gf2_mat_mult16_1(m_prime_in >> (1 * 16), m16[1]);
-  const uint64_t chunk2 = gf2_mat_mult16_1(m_prime_in >> (2 * 16), m16[1]);
-  const uint64_t chunk3 = gf2_mat_mult16_1(m_prime_in >> (3 * 16), m16[0]);
-  const uint64_t m_prime_out = (chunk3 << (3 * 16)) | (chunk2 << (2 * 16)) |
-                               (chunk1 << (1 * 16)) | (chunk0 << (0 * 16));
+  const uint64_t x = m_prime_in;
+  const uint64_t all = x ^ prince_rotl16_lanes(x, 4) ^
+                       prince_rotl16_lanes(x, 8) ^ prince_rotl16_lanes(x, 12);
+  // Reverse the order of the nibbles in each chunk.
+  const uint64_t rev = ((x & PRINCE_LANE_NIBBLE0) << 12) |
+                       ((x & (PRINCE_LANE_NIBBLE0 << 4)) << 4) |
+                       ((x >> 4) & (PRINCE_LANE_NIBBLE0 << 4)) |
+                       ((x >> 12) & PRINCE_LANE_NIBBLE0);
+  const uint64_t excluded =
+      (rev & PRINCE_NIBBLE_BIT0) |
+      (prince_rotl16_lanes(rev, 4) & (PRINCE_NIBBLE_BIT0 << 1)) |
+      (prince_rotl16_lanes(rev, 8) & (PRINCE_NIBBLE_BIT0 << 2)) |
+      (prince_rotl16_lanes(rev, 12) & (PRINCE_NIBBLE_BIT0 << 3));
+  const uint64_t m0_out = all ^ excluded;
+  const uint64_t m_prime_out =
+      (m0_out & 0xFFFF00000000FFFF) |
+      (prince_rotl16_lanes(m0_out, 4) & 0x0000FFFFFFFF0000);
   return m_prime_out;
 }
 
@@ -267,14 +264,18 @@ static uint64_t prince_core(const uint64_t core_input, const uint64_t k0_new,
 }
 
 /**
- * Top level function for Prince encryption/decryption.
+ * Top level function for Prince encryption/decryption of several blocks.
+ *
+ * Each of the `num_blocks` blocks in `input` is processed with the same key
+ * and the results are written to `output`, which may alias `input`.
  *
  * enc_k0 and enc_k1 must be the same for encryption and decryption.
  * The handling of decryption is done internally.
  */
-uint64_t prince_enc_dec_uint64(const uint64_t input, const uint64_t enc_k0,
-                               const uint64_t enc_k1, int decrypt,
-                               int num_half_rounds, int old_key_schedule) {
+void prince_enc_dec_uint64_blocks(const uint64_t *input, uint64_t *output,
+                                  size_t num_blocks, const uint64_t enc_k0,
+                                  const uint64_t enc_k1, int decrypt,
+                                  int num_half_rounds, int old_key_schedule) {
   const uint64_t prince_alpha = 0xc0ac29b7c97c50dd;
   const uint64_t k1 = enc_k1 ^ (decrypt ? prince_alpha : 0);
   const uint64_t k0_new =
@@ -283,13 +284,29 @@ uint64_t prince_enc_dec_uint64(const uint64_t input, const uint64_t enc_k0,
   const uint64_t k0 = decrypt ? enc_k0_prime : enc_k0;
   const uint64_t k0_prime = decrypt ? enc_k0 : enc_k0_prime;
   PRINCE_PRINT(k0);
-  PRINCE_PRINT(input);
-  const uint64_t core_input = input ^ k0;
-  const uint64_t core_output =
-      prince_core(core_input, k0_new, k1, num_half_rounds);
-  const uint64_t output = core_output ^ k0_prime;
-  PRINCE_PRINT(k0_prime);
-  PRINCE_PRINT(output);
+  for (size_t i = 0; i < num_blocks; i++) {
+    PRINCE_PRINT(input[i]);
+    const uint64_t core_input = input[i] ^ k0;
+    const uint64_t core_output =
+        prince_core(core_input, k0_new, k1, num_half_rounds);
+    output[i] = core_output ^ k0_prime;
+    PRINCE_PRINT(k0_prime);
+    PRINCE_PRINT(output[i]);
+  }
+}
+
+/**
+ * Top level function for Prince encryption/decryption.
+ *
+ * enc_k0 and enc_k1 must be the same for encryption and decryption.
+ * The handling of decryption is done internally.
+ */
+uint64_t prince_enc_dec_uint64(const uint64_t input, const uint64_t enc_k0,
+                               const uint64_t enc_k1, int decrypt,
+                               int num_half_rounds, int old_key_schedule) {
+  uint64_t output;
+  prince_enc_dec_uint64_blocks(&input, &output, 1, enc_k0, enc_k1, decrypt,
+                               num_half_rounds, old_key_schedule);
   return output;
 }
 
@@ -6,316 +6,402 @@
 
 #include <algorithm>
 #include <cassert>
-#include <functional>
-#include <iostream>
+#include <cstring>
 #include <stdint.h>
 #include <vector>
 
 #include "prince_ref.h"
 
-uint8_t PRESENT_SBOX4[] = {0xc, 0x5, 0x6, 0xb, 0x9, 0x0, 0xa, 0xd,
-                           0x3, 0xe, 0xf, 0x8, 0x4, 0x7, 0x1, 0x2};
-
-uint8_t PRESENT_SBOX4_INV[] = {0x5, 0xe, 0xf, 0x8, 0xc, 0x1, 0x2, 0xd,
-                               0xb, 0x4, 0x6, 0x3, 0x0, 0x7, 0x9, 0xa};
-
 static const uint32_t kNumAddrSubstPermRounds = 2;
 static const uint32_t kNumDataSubstPermRounds = 2;
 static const uint32_t kNumPrinceHalfRounds = 3;
 
-static std::vector<uint8_t> byte_reverse_vector(
-    const std::vector<uint8_t> &vec_in) {
-  std::vector<uint8_t> vec_out(vec_in.size());
-
-  std::reverse_copy(std::begin(vec_in), std::end(vec_in), std::begin(vec_out));
-
-  return vec_out;
-}
-
-static uint8_t read_vector_bit(const std::vector<uint8_t> &vec,
-                               uint32_t bit_pos) {
-  assert(bit_pos / 8 < vec.size());
+// Bit 0 of each nibble in a 64-bit word
+static const uint64_t kNibbleLsbs = 0x1111111111111111;
 
-  return (vec[bit_pos / 8] >> (bit_pos % 8)) & 1;
+// Return a mask with the bottom width bits set (width <= 64)
+static uint64_t low_mask64(uint32_t width) {
+  assert(width <= 64);
+  return (width == 64) ? ~(uint64_t)0 : (((uint64_t)1 << width) - 1);
 }
 
-static void or_vector_bit(std::vector<uint8_t> &vec, uint32_t bit_pos,
-                          uint8_t bit) {
-  assert(bit_pos / 8 < vec.size());
+// Read width bits (width <= 64) from the little-endian byte buffer buf,
+// starting at bit lsb.
+static uint64_t read_buf_bits(const uint8_t *buf, uint32_t lsb,
+                              uint32_t width) {
+  uint64_t ret = 0;
+  uint32_t done = 0;
+
+  while (done < width) {
+    uint32_t bit_pos = lsb + done;
+    uint32_t bit_idx = bit_pos % 8;
+    uint32_t to_take = std::min(8 - bit_idx, width - done);
+    uint64_t chunk = (buf[bit_pos / 8] >> bit_idx) & ((1u << to_take) - 1);
+
+    ret |= chunk << done;
+    done += to_take;
+  }
 
-  vec[bit_pos / 8] |= bit << (bit_pos % 8);
+  return ret;
 }
 
-static std::vector<uint8_t> xor_vectors(const std::vector<uint8_t> &vec_a,
-                                        const std::vector<uint8_t> &vec_b) {
-  assert(vec_a.size() == vec_b.size());
-
-  std::vector<uint8_t> vec_out(vec_a.size());
+// OR the bottom width bits (width <= 64) of bits into the little-endian byte
+// buffer buf, starting at bit lsb.
+static void or_buf_bits(uint8_t *buf, uint32_t lsb, uint32_t width,
+                        uint64_t bits) {
+  uint32_t done = 0;
 
-  std::transform(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_out.begin(),
-                 std::bit_xor<uint8_t>{});
+  while (done < width) {
+    uint32_t bit_pos = lsb + done;
+    uint32_t bit_idx = bit_pos % 8;
+    uint32_t to_take = std::min(8 - bit_idx, width - done);
+    uint8_t chunk = (bits >> done) & ((1u << to_take) - 1);
 
-  return vec_out;
+    buf[bit_pos / 8] |= chunk << bit_idx;
+    done += to_take;
+  }
 }
 
-// Run each 4-bit chunk of bytes from `in` through the SBOX. Where `bit_width`
-// isn't a multiple of 4 the remaining bits are just copied straight through.
-// `invert` choose whether to use the inverted SBOX or not.
-static std::vector<uint8_t> scramble_sbox_layer(const std::vector<uint8_t> &in,
-                                                uint32_t bit_width,
-                                                uint8_t sbox[16]) {
-  assert(in.size() == ((bit_width + 7) / 8));
-  std::vector<uint8_t> out(in.size(), 0);
+// Bit-sliced PRESENT SBOX applied to every nibble of x. Each output bit is
+// the algebraic normal form of the corresponding SBOX output bit, evaluated
+// on all 16 nibbles at once.
+static uint64_t present_sbox_layer64(uint64_t x) {
+  const uint64_t x0 = x & kNibbleLsbs;
+  const uint64_t x1 = (x >> 1) & kNibbleLsbs;
+  const uint64_t x2 = (x >> 2) & kNibbleLsbs;
+  const uint64_t x3 = (x >> 3) & kNibbleLsbs;
+  const uint64_t one = kNibbleLsbs;
+
+  const uint64_t x01 = x0 & x1, x12 = x1 & x2, x13 = x1 & x3, x23 = x2 & x3;
+  const uint64_t x03 = x0 & x3, x012 = x01 & x2, x013 = x01 & x3;
+  const uint64_t x023 = x0 & x23;
+
+  const uint64_t y0 = x0 ^ x2 ^ x12 ^ x3;
+  const uint64_t y1 = x1 ^ x012 ^ x3 ^ x13 ^ x013 ^ x23 ^ x023;
+  const uint64_t y2 = one ^ x01 ^ x2 ^ x3 ^ x03 ^ x13 ^ x013 ^ x023;
+  const uint64_t y3 = one ^ x0 ^ x1 ^ x12 ^ x012 ^ x3 ^ x013 ^ x023;
+
+  return y0 | (y1 << 1) | (y2 << 2) | (y3 << 3);
+}
 
-  // Iterate through each 4 bit chunk of the data and apply the appropriate SBOX
-  for (uint32_t i = 0; i < bit_width / 4; ++i) {
-    uint8_t sbox_in, sbox_out;
+// Bit-sliced inverse of present_sbox_layer64.
+static uint64_t present_sbox_inv_layer64(uint64_t x) {
+  const uint64_t x0 = x & kNibbleLsbs;
+  const uint64_t x1 = (x >> 1) & kNibbleLsbs;
+  const uint64_t x2 = (x >> 2) & kNibbleLsbs;
+  const uint64_t x3 = (x >> 3) & kNibbleLsbs;
+  const uint64_t one = kNibbleLsbs;
+
+  const uint64_t x01 = x0 & x1, x02 = x0 & x2, x12 = x1 & x2, x13 = x1 & x3;
+  const uint64_t x23 = x2 & x3, x03 = x0 & x3, x012 = x01 & x2;
+  const uint64_t x013 = x01 & x3, x023 = x0 & x23;
+
+  const uint64_t y0 = one ^ x0 ^ x2 ^ x13;
+  const uint64_t y1 = x0 ^ x1 ^ x02 ^ x012 ^ x3 ^ x13 ^ x013 ^ x23 ^ x023;
+  const uint64_t y2 =
+      one ^ x01 ^ x02 ^ x12 ^ x012 ^ x3 ^ x03 ^ x13 ^ x013 ^ x023;
+  const uint64_t y3 = x0 ^ x1 ^ x01 ^ x2 ^ x012 ^ x3 ^ x023;
+
+  return y0 | (y1 << 1) | (y2 << 2) | (y3 << 3);
+}
 
-    sbox_in = in[i / 2];
+// Run each complete 4-bit chunk of the bottom bit_width bits of `in` through
+// the SBOX. Where `bit_width` isn't a multiple of 4 the remaining bits are
+// just copied straight through.
+static uint64_t scramble_sbox_layer64(uint64_t in, uint32_t bit_width,
+                                      bool invert) {
+  uint64_t sbox_mask = low_mask64(4 * (bit_width / 4));
+  uint64_t sbox_out =
+      invert ? present_sbox_inv_layer64(in) : present_sbox_layer64(in);
 
-    int shift = (i % 2) ? 4 : 0;
-    sbox_in = (sbox_in >> shift) & 0xf;
+  return (sbox_out & sbox_mask) | (in & ~sbox_mask & low_mask64(bit_width));
+}
 
-    sbox_out = sbox[sbox_in];
+// Reverse the bottom bit_width bits of in
+static uint64_t scramble_flip_layer64(uint64_t in, uint32_t bit_width) {
+  assert(0 < bit_width && bit_width <= 64);
 
-    out[i / 2] |= sbox_out << shift;
-  }
+  uint64_t x = in;
+  x = ((x >> 1) & 0x5555555555555555) | ((x & 0x5555555555555555) << 1);
+  x = ((x >> 2) & 0x3333333333333333) | ((x & 0x3333333333333333) << 2);
+  x = ((x >> 4) & 0x0f0f0f0f0f0f0f0f) | ((x & 0x0f0f0f0f0f0f0f0f) << 4);
+  x = ((x >> 8) & 0x00ff00ff00ff00ff) | ((x & 0x00ff00ff00ff00ff) << 8);
+  x = ((x >> 16) & 0x0000ffff0000ffff) | ((x & 0x0000ffff0000ffff) << 16);
+  x = (x >> 32) | (x << 32);
 
-  // Where bit_width is not a multiple of 4 copy over the remaining bits
-  if (bit_width % 4) {
-    int shift = ((bit_width % 8) >= 4) ? 4 : 0;
-    uint8_t nibble = (in[bit_width / 8] >> shift) & 0xf;
-    out[bit_width / 8] |= nibble << shift;
-  }
+  return x >> (64 - bit_width);
+}
 
-  return out;
+// Gather the even bits of x into the bottom 32 bits of the result
+static uint64_t compress_even_bits64(uint64_t x) {
+  x &= 0x5555555555555555;
+  x = (x | (x >> 1)) & 0x3333333333333333;
+  x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0f;
+  x = (x | (x >> 4)) & 0x00ff00ff00ff00ff;
+  x = (x | (x >> 8)) & 0x0000ffff0000ffff;
+  x = (x | (x >> 16)) & 0x00000000ffffffff;
+  return x;
 }
 
-// Reverse bits from incoming byte vector
-static std::vector<uint8_t> scramble_flip_layer(const std::vector<uint8_t> &in,
-                                                uint32_t bit_width) {
-  assert(in.size() == ((bit_width + 7) / 8));
-  std::vector<uint8_t> out(in.size(), 0);
+// Spread the bottom 32 bits of x into the even bits of the result (the
+// inverse of compress_even_bits64)
+static uint64_t spread_even_bits64(uint64_t x) {
+  x &= 0x00000000ffffffff;
+  x = (x | (x << 16)) & 0x0000ffff0000ffff;
+  x = (x | (x << 8)) & 0x00ff00ff00ff00ff;
+  x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0f;
+  x = (x | (x << 2)) & 0x3333333333333333;
+  x = (x | (x << 1)) & 0x5555555555555555;
+  return x;
+}
 
-  for (uint32_t i = 0; i < bit_width; ++i) {
-    or_vector_bit(out, bit_width - i - 1, read_vector_bit(in, i));
-  }
+// Apply butterfly to the bottom bit_width bits of in. Even bits are placed in
+// the lower half of the output, odd bits are placed in the upper half of the
+// output.
+static uint64_t scramble_perm_layer64(uint64_t in, uint32_t bit_width,
+                                      bool invert) {
+  assert(bit_width <= 64);
 
-  return out;
-}
+  uint32_t half_width = bit_width / 2;
+  uint64_t half_mask = low_mask64(half_width);
+  uint64_t out;
 
-// Apply butterfly to incoming byte vector. Even bits are placed in the lower
-// half of the output, odd bits are placed in the upper half of the output.
-static std::vector<uint8_t> scramble_perm_layer(const std::vector<uint8_t> &in,
-                                                uint32_t bit_width,
-                                                bool invert) {
-  assert(in.size() == ((bit_width + 7) / 8));
-  std::vector<uint8_t> out(in.size(), 0);
-
-  for (uint32_t i = 0; i < bit_width / 2; ++i) {
-    if (invert) {
-      or_vector_bit(out, i * 2, read_vector_bit(in, i));
-      or_vector_bit(out, i * 2 + 1, read_vector_bit(in, i + (bit_width / 2)));
-    } else {
-      or_vector_bit(out, i, read_vector_bit(in, i * 2));
-      or_vector_bit(out, i + (bit_width / 2), read_vector_bit(in, i * 2 + 1));
-    }
+  if (invert) {
+    out = spread_even_bits64(in & half_mask) |
+          (spread_even_bits64((in >> half_width) & half_mask) << 1);
+  } else {
+    uint64_t body = in & low_mask64(2 * half_width);
+    out = compress_even_bits64(body) |
+          (compress_even_bits64(body >> 1) << half_width);
   }
 
   if (bit_width % 2) {
     // Where bit_width isn't even, the final bit is copied across to the same
     // position
-    or_vector_bit(out, bit_width - 1, read_vector_bit(in, bit_width - 1));
+    out |= in & ((uint64_t)1 << (bit_width - 1));
   }
 
   return out;
 }
 
-// Apply a full set of subsitution/permutation rounds for encrypt to the
-// incoming byte vector
-static std::vector<uint8_t> scramble_subst_perm_enc(
-    const std::vector<uint8_t> &in, const std::vector<uint8_t> &key,
-    uint32_t bit_width, uint32_t num_rounds) {
-  assert(in.size() == ((bit_width + 7) / 8));
-  assert(key.size() == ((bit_width + 7) / 8));
+uint64_t scramble_subst_perm_enc64(uint64_t in, uint64_t key,
+                                   uint32_t bit_width, uint32_t num_rounds) {
+  assert(0 < bit_width && bit_width <= 64);
 
-  std::vector<uint8_t> state(in);
+  uint64_t mask = low_mask64(bit_width);
+  uint64_t state = in & mask;
+  key &= mask;
 
   for (uint32_t i = 0; i < num_rounds; ++i) {
-    state = xor_vectors(state, key);
+    state ^= key;
 
-    state = scramble_sbox_layer(state, bit_width, PRESENT_SBOX4);
-    state = scramble_flip_layer(state, bit_width);
-    state = scramble_perm_layer(state, bit_width, false);
+    state = scramble_sbox_layer64(state, bit_width, false);
+    state = scramble_flip_layer64(state, bit_width);
+    state = scramble_perm_layer64(state, bit_width, false);
   }
 
-  state = xor_vectors(state, key);
-
-  return state;
+  return state ^ key;
 }
 
-// Apply a full set of substitution/permutation rounds for decrypt to the
-// incoming byte vector
-static std::vector<uint8_t> scramble_subst_perm_dec(
-    const std::vector<uint8_t> &in, const std::vector<uint8_t> &key,
-    uint32_t bit_width, uint32_t num_rounds) {
-  assert(in.size() == ((bit_width + 7) / 8));
-  assert(key.size() == ((bit_width + 7) / 8));
+uint64_t scramble_subst_perm_dec64(uint64_t in, uint64_t key,
+                                   uint32_t bit_width, uint32_t num_rounds) {
+  assert(0 < bit_width && bit_width <= 64);
 
-  std::vector<uint8_t> state(in);
+  uint64_t mask = low_mask64(bit_width);
+  uint64_t state = in & mask;
+  key &= mask;
 
   for (uint32_t i = 0; i < num_rounds; ++i) {
-    state = xor_vectors(state, key);
+    state ^= key;
 
-    state = scramble_perm_layer(state, bit_width, true);
-    state = scramble_flip_layer(state, bit_width);
-    state = scramble_sbox_layer(state, bit_width, PRESENT_SBOX4_INV);
+    state = scramble_perm_layer64(state, bit_width, true);
+    state = scramble_flip_layer64(state, bit_width);
+    state = scramble_sbox_layer64(state, bit_width, true);
   }
 
-  state = xor_vectors(state, key);
+  return state ^ key;
+}
 
-  return state;
+// Read a little-endian 64-bit value from 8 bytes at buf
+static uint64_t load_le64(const uint8_t *buf) {
+  uint64_t ret = 0;
+  for (int i = 7; i >= 0; --i) {
+    ret = (ret << 8) | buf[i];
+  }
+  return ret;
 }
 
-// Generate a keystream for XORing with data using PRINCE.
-// If repeat_keystream is set to true, the output from one PRINCE instance is
+// XOR a keystream for the data at address addr into buf, which holds
+// data_width bits. The keystream is generated using PRINCE. If
+// repeat_keystream is set to true, the output from one PRINCE instance is
 // repeated when the keystream is greater than a single PRINCE width (64bit).
 // Otherwise, multiple PRINCEs are instantiated to form the keystream.
-static std::vector<uint8_t> scramble_gen_keystream(
-    const std::vector<uint8_t> &addr, uint32_t addr_width,
-    const std::vector<uint8_t> &nonce, const std::vector<uint8_t> &key,
-    uint32_t keystream_width, uint32_t num_half_rounds, bool repeat_keystream) {
-  assert(key.size() == (kPrinceWidthByte * 2));
-
-  // Determine how many PRINCE replications are required
-  uint32_t num_princes, num_repetitions;
-  if (repeat_keystream) {
-    num_princes = 1;
-    num_repetitions = (keystream_width + kPrinceWidth - 1) / kPrinceWidth;
-  } else {
-    num_princes = (keystream_width + kPrinceWidth - 1) / kPrinceWidth;
-    num_repetitions = 1;
+static void scramble_xor_keystream(uint8_t *buf, uint32_t data_width,
+                                   uint32_t addr, uint32_t addr_width,
+                                   const uint8_t *nonce, const uint8_t *key,
+                                   uint32_t num_half_rounds,
+                                   bool repeat_keystream) {
+  assert(addr_width <= 32);
+
+  // The C reference model takes K0 from the top half of the (little-endian)
+  // key and K1 from the bottom half.
+  uint64_t k0 = load_le64(key + kPrinceWidthByte);
+  uint64_t k1 = load_le64(key);
+
+  uint32_t nonce_bits_per_prince = kPrinceWidth - addr_width;
+  uint32_t data_bytes = (data_width + 7) / 8;
+  uint32_t num_blocks =
+      repeat_keystream ? 1 : (data_bytes + kPrinceWidthByte - 1) /
+                                 kPrinceWidthByte;
+
+  // Initial vectors are data for PRINCE to encrypt. The bottom addr_width
+  // bits are the address and the other bits are taken from the nonce. Each
+  // PRINCE instantiation uses different nonce bits. All blocks share a key,
+  // so encrypt them in a single call.
+  uint64_t blocks[(kScrambleMaxDataWidthByte + kPrinceWidthByte - 1) /
+                  kPrinceWidthByte];
+  assert(num_blocks <= sizeof blocks / sizeof blocks[0]);
+  for (uint32_t block_idx = 0; block_idx < num_blocks; ++block_idx) {
+    uint64_t iv = addr & low_mask64(addr_width);
+    iv |= read_buf_bits(nonce, block_idx * nonce_bits_per_prince,
+                        nonce_bits_per_prince)
+          << addr_width;
+    blocks[block_idx] = iv;
   }
+  prince_enc_dec_uint64_blocks(blocks, blocks, num_blocks, k0, k1, 0,
+                               num_half_rounds, 0);
 
-  std::vector<uint8_t> keystream;
-
-  for (uint32_t i = 0; i < num_princes; ++i) {
-    // Initial vector is data for PRINCE to encrypt. Formed from nonce and data
-    // address
-    std::vector<uint8_t> iv(8, 0);
-
-    for (uint32_t j = 0; j < kPrinceWidth; ++j) {
-      if (j < addr_width) {
-        // Bottom addr_width bits of IV are address
-        or_vector_bit(iv, j, read_vector_bit(addr, j));
-      } else {
-        // Other bits are taken from nonce. Each PRINCE instantiation will use
-        // different nonce bits.
-        int nonce_bit = (j - addr_width) + i * (kPrinceWidth - addr_width);
-        or_vector_bit(iv, j, read_vector_bit(nonce, nonce_bit));
-      }
-    }
+  for (uint32_t i = 0; i < data_bytes; ++i) {
+    uint32_t block_idx = repeat_keystream ? 0 : i / kPrinceWidthByte;
+    uint32_t block_byte = i % kPrinceWidthByte;
 
-    // PRINCE C reference model works on big-endian byte order
-    iv = byte_reverse_vector(iv);
-    auto key_be = byte_reverse_vector(key);
-
-    // Apply PRINCE to IV to produce keystream
-    std::vector<uint8_t> keystream_block(kPrinceWidthByte);
-    prince_enc_dec(&iv[0], &key_be[0], &keystream_block[0], 0, num_half_rounds,
-                   0);
-
-    // Flip keystream into little endian order and add to keystream vector
-    keystream_block = byte_reverse_vector(keystream_block);
-    // Repeat the output of a single PRINCE instance if needed
-    for (uint32_t k = 0; k < num_repetitions; ++k) {
-      keystream.insert(keystream.end(), keystream_block.begin(),
-                       keystream_block.end());
-    }
-  }
+    uint8_t ks_byte = blocks[block_idx] >> (8 * block_byte);
 
-  // Total keystream bits generated are some multiple of kPrinceWidth. This can
-  // result in unused keystream bits. Remove the unused bytes from the keystream
-  // vector and zero out top unused bits in the final byte if required.
-  uint32_t keystream_bytes = (keystream_width + 7) / 8;
-  uint32_t keystream_bytes_to_erase = keystream.size() - keystream_bytes;
-  if (keystream_bytes_to_erase) {
-    keystream.erase(keystream.end() - keystream_bytes_to_erase,
-                    keystream.end());
-  }
+    // Zero out unused keystream bits in the final byte
+    if (i == data_bytes - 1 && (data_width % 8)) {
+      ks_byte &= (1 << (data_width % 8)) - 1;
+    }
 
-  if (keystream_width % 8) {
-    keystream[keystream.size() - 1] &= (1 << (keystream_width % 8)) - 1;
+    buf[i] ^= ks_byte;
   }
-
-  return keystream;
 }
 
-// Split incoming data into subst_perm_width chunks and individually apply the
-// substitution/permutation layer to each
-static std::vector<uint8_t> scramble_subst_perm_full_width(
-    const std::vector<uint8_t> &in, uint32_t bit_width,
-    uint32_t subst_perm_width, bool enc) {
-  assert(in.size() == ((bit_width + 7) / 8));
+// Split data_width bits of buf into subst_perm_width chunks and individually
+// apply the substitution/permutation layer to each. This writes the result
+// back to buf and clears any bits above data_width in the final byte.
+static void scramble_subst_perm_full_width(uint8_t *buf, uint32_t data_width,
+                                           uint32_t subst_perm_width,
+                                           bool enc) {
+  assert(0 < subst_perm_width && subst_perm_width <= 64);
 
-  // Determine how many bytes each subst_perm_width chunk is and how many
-  // chunks are needed to cover the full bit_width.
-  uint32_t subst_perm_bytes = (subst_perm_width + 7) / 8;
   uint32_t subst_perm_blocks =
-      (bit_width + subst_perm_width - 1) / subst_perm_width;
-
-  std::vector<uint8_t> out(in.size(), 0);
-  std::vector<uint8_t> zero_key(subst_perm_bytes, 0);
+      (data_width + subst_perm_width - 1) / subst_perm_width;
 
-  auto sp_scrambler = enc ? scramble_subst_perm_enc : scramble_subst_perm_dec;
+  // Blocks needn't start on a byte boundary, so build the result in a
+  // separate buffer rather than updating buf in place.
+  uint8_t out[kScrambleMaxDataWidthByte];
+  memset(out, 0, sizeof out);
 
   for (uint32_t i = 0; i < subst_perm_blocks; ++i) {
-    // Where bit_width does not evenly divide into subst_perm_width the
+    // Where data_width does not evenly divide into subst_perm_width the
     // final block is smaller.
     uint32_t bits_so_far = subst_perm_width * i;
-    uint32_t block_width = std::min(subst_perm_width, bit_width - bits_so_far);
+    uint32_t block_width = std::min(subst_perm_width, data_width - bits_so_far);
+    uint64_t block = read_buf_bits(buf, bits_so_far, block_width);
 
-    std::vector<uint8_t> subst_perm_data(subst_perm_bytes, 0);
+    block = enc ? scramble_subst_perm_enc64(block, 0, block_width,
+                                            kNumDataSubstPermRounds)
+                : scramble_subst_perm_dec64(block, 0, block_width,
+                                            kNumDataSubstPermRounds);
 
-    // Extract bits from in for this chunk
-    for (uint32_t j = 0; j < block_width; ++j) {
-      or_vector_bit(subst_perm_data, j,
-                    read_vector_bit(in, j + i * subst_perm_width));
-    }
+    or_buf_bits(out, bits_so_far, block_width, block);
+  }
 
-    // Apply the substitution/permutation layer to the chunk
-    auto subst_perm_out = sp_scrambler(subst_perm_data, zero_key, block_width,
-                                       kNumDataSubstPermRounds);
+  memcpy(buf, out, (data_width + 7) / 8);
+}
 
-    // Write the result to the `out` vector
-    for (uint32_t j = 0; j < block_width; ++j) {
-      or_vector_bit(out, j + i * subst_perm_width,
-                    read_vector_bit(subst_perm_out, j));
-    }
+uint32_t scramble_addr_u32(uint32_t addr_in, uint32_t addr_width,
+                           const uint8_t *nonce, uint32_t nonce_width) {
+  assert(0 < addr_width && addr_width <= 32);
+  assert(addr_width <= nonce_width);
+
+  // Address is scrambled by using substitution/permutation layer with the nonce
+  // used as a key (from the top addr_width bits of the nonce).
+  uint64_t addr_enc_nonce =
+      read_buf_bits(nonce, nonce_width - addr_width, addr_width);
+
+  return scramble_subst_perm_enc64(addr_in, addr_enc_nonce, addr_width,
+                                   kNumAddrSubstPermRounds);
+}
+
+void scramble_encrypt_data_buf(uint8_t *data_out, const uint8_t *data_in,
+                               uint32_t data_width, uint32_t subst_perm_width,
+                               uint32_t addr, uint32_t addr_width,
+                               const uint8_t *nonce, const uint8_t *key,
+                               bool repeat_keystream, bool use_sp_layer) {
+  assert(data_width <= 8 * kScrambleMaxDataWidthByte);
+
+  // Data is encrypted by XORing with keystream then applying
+  // substitution/permutation layer
+  if (data_out != data_in) {
+    memmove(data_out, data_in, (data_width + 7) / 8);
   }
 
-  return out;
+  scramble_xor_keystream(data_out, data_width, addr, addr_width, nonce, key,
+                         kNumPrinceHalfRounds, repeat_keystream);
+
+  if (use_sp_layer) {
+    scramble_subst_perm_full_width(data_out, data_width, subst_perm_width,
+                                   true);
+  }
+}
+
+void scramble_decrypt_data_buf(uint8_t *data_out, const uint8_t *data_in,
+                               uint32_t data_width, uint32_t subst_perm_width,
+                               uint32_t addr, uint32_t addr_width,
+                               const uint8_t *nonce, const uint8_t *key,
+                               bool repeat_keystream, bool use_sp_layer) {
+  assert(data_width <= 8 * kScrambleMaxDataWidthByte);
+
+  if (data_out != data_in) {
+    memmove(data_out, data_in, (data_width + 7) / 8);
+  }
+
+  // Data is decrypted by reversing substitution/permutation layer then XORing
+  // with keystream
+  if (use_sp_layer) {
+    scramble_subst_perm_full_width(data_out, data_width, subst_perm_width,
+                                   false);
+  }
+
+  scramble_xor_keystream(data_out, data_width, addr, addr_width, nonce, key,
+                         kNumPrinceHalfRounds, repeat_keystream);
+}
+
+// Convert a little-endian address byte vector to an integer
+static uint32_t addr_vec_to_u32(const std::vector<uint8_t> &addr,
+                                uint32_t addr_width) {
+  assert(addr.size() == ((addr_width + 7) / 8));
+  assert(addr_width <= 32);
+
+  return read_buf_bits(&addr[0], 0, addr_width);
 }
 
 std::vector<uint8_t> scramble_addr(const std::vector<uint8_t> &addr_in,
                                    uint32_t addr_width,
                                    const std::vector<uint8_t> &nonce,
                                    uint32_t nonce_width) {
-  assert(addr_in.size() == ((addr_width + 7) / 8));
+  assert((nonce_width + 7) / 8 <= nonce.size());
 
-  std::vector<uint8_t> addr_enc_nonce(addr_in.size(), 0);
+  uint32_t addr_out = scramble_addr_u32(addr_vec_to_u32(addr_in, addr_width),
+                                        addr_width, &nonce[0], nonce_width);
 
-  // Address is scrambled by using substitution/permutation layer with the nonce
-  // used as a key.
-  // Extract relevant nonce bits for key
-  for (uint32_t i = 0; i < addr_width; ++i) {
-    or_vector_bit(addr_enc_nonce, i,
-                  read_vector_bit(nonce, nonce_width - addr_width + i));
+  std::vector<uint8_t> ret(addr_in.size());
+  for (size_t i = 0; i < ret.size(); ++i) {
+    ret[i] = addr_out >> (8 * i);
   }
 
-  // Apply substitution/permutation layer
-  return scramble_subst_perm_enc(addr_in, addr_enc_nonce, addr_width,
-                                 kNumAddrSubstPermRounds);
+  return ret;
 }
 
 std::vector<uint8_t> scramble_encrypt_data(
@@ -324,23 +410,14 @@ std::vector<uint8_t> scramble_encrypt_data(
     uint32_t addr_width, const std::vector<uint8_t> &nonce,
     const std::vector<uint8_t> &key, bool repeat_keystream, bool use_sp_layer) {
   assert(data_in.size() == ((data_width + 7) / 8));
-  assert(addr.size() == ((addr_width + 7) / 8));
-
-  // Data is encrypted by XORing with keystream then applying
-  // substitution/permutation layer
-
-  auto keystream =
-      scramble_gen_keystream(addr, addr_width, nonce, key, data_width,
-                             kNumPrinceHalfRounds, repeat_keystream);
+  assert(key.size() == (kPrinceWidthByte * 2));
 
-  auto data_enc = xor_vectors(data_in, keystream);
+  std::vector<uint8_t> ret(data_in);
+  scramble_encrypt_data_buf(&ret[0], &ret[0], data_width, subst_perm_width,
+                            addr_vec_to_u32(addr, addr_width), addr_width,
+                            &nonce[0], &key[0], repeat_keystream, use_sp_layer);
 
-  if (use_sp_layer) {
-    return scramble_subst_perm_full_width(data_enc, data_width,
-                                          subst_perm_width, true);
-  } else {
-    return data_enc;
-  }
+  return ret;
 }
 
 std::vector<uint8_t> scramble_decrypt_data(
@@ -349,18 +426,12 @@ std::vector<uint8_t> scramble_decrypt_data(
     uint32_t addr_width, const std::vector<uint8_t> &nonce,
     const std::vector<uint8_t> &key, bool repeat_keystream, bool use_sp_layer) {
   assert(data_in.size() == ((data_width + 7) / 8));
-  assert(addr.size() == ((addr_width + 7) / 8));
+  assert(key.size() == (kPrinceWidthByte * 2));
 
-  auto keystream =
-      scramble_gen_keystream(addr, addr_width, nonce, key, data_width,
-                             kNumPrinceHalfRounds, repeat_keystream);
-  if (use_sp_layer) {
-    // Data is decrypted by reversing substitution/permutation layer then XORing
-    // with keystream
-    auto data_sp_out = scramble_subst_perm_full_width(data_in, data_width,
-                                                      subst_perm_width, false);
-    return xor_vectors(data_sp_out, keystream);
-  } else {
-    return xor_vectors(data_in, keystream);
-  }
+  std::vector<uint8_t> ret(data_in);
+  scramble_decrypt_data_buf(&ret[0], &ret[0], data_width, subst_perm_width,
+                            addr_vec_to_u32(addr, addr_width), addr_width,
+                            &nonce[0], &key[0], repeat_keystream, use_sp_layer);
+
+  return ret;
 }
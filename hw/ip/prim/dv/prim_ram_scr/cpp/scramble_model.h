@@ -11,6 +11,9 @@
 const uint32_t kPrinceWidth = 64;
 const uint32_t kPrinceWidthByte = kPrinceWidth / 8;
 
+// The widest data word supported by the fixed-width functions below
+const uint32_t kScrambleMaxDataWidthByte = 40;
+
 // C++ model of memory scrambling. All byte vectors are in little endian byte
 // order (least significant byte at index 0).
 
@@ -76,4 +79,63 @@ std::vector<uint8_t> scramble_encrypt_data(
     uint32_t addr_width, const std::vector<uint8_t> &nonce,
     const std::vector<uint8_t> &key, bool repeat_keystream, bool use_sp_layer);
 
+// Fixed-width variants of the model.
+//
+// These give the same results as the functions above (which are implemented
+// in terms of them) but don't allocate. Keys and nonces are passed as
+// little-endian byte buffers: key must hold 2 * kPrinceWidthByte bytes and
+// nonce must hold at least as many bits as are needed for the given
+// configuration.
+
+/** Apply the substitution/permutation encryption network to a word of up to
+ * 64 bits.
+ *
+ * @param in          Data to encrypt (in the bottom bit_width bits)
+ * @param key         Key to XOR in before and after each round
+ * @param bit_width   Width of the data and key in bits
+ * @param num_rounds  Number of S&P rounds
+ * @return Encrypted data
+ */
+uint64_t scramble_subst_perm_enc64(uint64_t in, uint64_t key,
+                                   uint32_t bit_width, uint32_t num_rounds);
+
+/** Inverse of scramble_subst_perm_enc64 */
+uint64_t scramble_subst_perm_dec64(uint64_t in, uint64_t key,
+                                   uint32_t bit_width, uint32_t num_rounds);
+
+/** Scramble an address to give the physical address used to access the
+ * scrambled memory.
+ *
+ * @param addr_in      Address (at most 32 bits wide)
+ * @param addr_width   Width of the address in bits
+ * @param nonce        Buffer holding the scrambling nonce
+ * @param nonce_width  Width of scramble nonce in bits
+ * @return Scrambled address
+ */
+uint32_t scramble_addr_u32(uint32_t addr_in, uint32_t addr_width,
+                           const uint8_t *nonce, uint32_t nonce_width);
+
+/** Encrypt scrambled data into a caller-provided buffer.
+ *
+ * The arguments have the same meaning as for scramble_encrypt_data, except
+ * that data_width must be at most 8 * kScrambleMaxDataWidthByte and the
+ * address is passed as an integer. data_out and data_in may be equal. Both
+ * must hold at least (data_width + 7) / 8 bytes.
+ */
+void scramble_encrypt_data_buf(uint8_t *data_out, const uint8_t *data_in,
+                               uint32_t data_width, uint32_t subst_perm_width,
+                               uint32_t addr, uint32_t addr_width,
+                               const uint8_t *nonce, const uint8_t *key,
+                               bool repeat_keystream, bool use_sp_layer);
+
+/** Decrypt scrambled data into a caller-provided buffer.
+ *
+ * See scramble_encrypt_data_buf for the constraints on the arguments.
+ */
+void scramble_decrypt_data_buf(uint8_t *data_out, const uint8_t *data_in,
+                               uint32_t data_width, uint32_t subst_perm_width,
+                               uint32_t addr, uint32_t addr_width,
+                               const uint8_t *nonce, const uint8_t *key,
+                               bool repeat_keystream, bool use_sp_layer);
+
 #endif  // OPENTITAN_HW_IP_PRIM_DV_PRIM_RAM_SCR_CPP_SCRAMBLE_MODEL_H_
@@ -8,26 +8,26 @@
 #include "secded_enc.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 // Calculates even parity for a 64-bit word
-static uint8_t calc_parity(uint64_t word, bool invert) {
-  bool parity = false;
+static inline uint8_t calc_parity(uint64_t word, bool invert) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint8_t)__builtin_parityll(word) ^ invert;
+#else
+  word ^= word >> 32;
+  word ^= word >> 16;
+  word ^= word >> 8;
+  word ^= word >> 4;
+  word ^= word >> 2;
+  word ^= word >> 1;
 
-  while (word) {
-    if (word & 1) {
-      parity = !parity;
-    }
-
-    word >>= 1;
-  }
-
-  return parity ^ invert;
+  return (uint8_t)(word & 1) ^ invert;
+#endif
 }
 
-uint8_t enc_secded_22_16(const uint8_t bytes[2]) {
-  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
-
+uint8_t enc_secded_22_16_word(uint16_t word) {
   return (calc_parity(word & 0x496e, false) << 0) |
          (calc_parity(word & 0xf20b, false) << 1) |
          (calc_parity(word & 0x8ed8, false) << 2) |
@@ -36,10 +36,20 @@ uint8_t enc_secded_22_16(const uint8_t bytes[2]) {
          (calc_parity(word & 0x11f3, false) << 5);
 }
 
-uint8_t enc_secded_28_22(const uint8_t bytes[3]) {
-  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16);
+uint8_t enc_secded_22_16(const uint8_t bytes[2]) {
+  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
 
+  return enc_secded_22_16_word(word);
+}
+
+void enc_secded_22_16_words(const uint16_t *words, uint8_t *check_bits,
+                            size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_22_16_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_28_22_word(uint32_t word) {
   return (calc_parity(word & 0x3003ff, false) << 0) |
          (calc_parity(word & 0x10fc0f, false) << 1) |
          (calc_parity(word & 0x271c71, false) << 2) |
@@ -48,10 +58,21 @@ uint8_t enc_secded_28_22(const uint8_t bytes[3]) {
          (calc_parity(word & 0x3ed348, false) << 5);
 }
 
-uint8_t enc_secded_39_32(const uint8_t bytes[4]) {
+uint8_t enc_secded_28_22(const uint8_t bytes[3]) {
   uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+                  ((uint32_t)bytes[2] << 16);
 
+  return enc_secded_28_22_word(word);
+}
+
+void enc_secded_28_22_words(const uint32_t *words, uint8_t *check_bits,
+                            size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_28_22_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_39_32_word(uint32_t word) {
   return (calc_parity(word & 0x2606bd25, false) << 0) |
          (calc_parity(word & 0xdeba8050, false) << 1) |
          (calc_parity(word & 0x413d89aa, false) << 2) |
@@ -61,12 +82,21 @@ uint8_t enc_secded_39_32(const uint8_t bytes[4]) {
          (calc_parity(word & 0x98505586, false) << 6);
 }
 
-uint8_t enc_secded_64_57(const uint8_t bytes[8]) {
-  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
-                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
-                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
-                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+uint8_t enc_secded_39_32(const uint8_t bytes[4]) {
+  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
+                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+
+  return enc_secded_39_32_word(word);
+}
+
+void enc_secded_39_32_words(const uint32_t *words, uint8_t *check_bits,
+                            size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_39_32_word(words[i]);
+  }
+}
 
+uint8_t enc_secded_64_57_word(uint64_t word) {
   return (calc_parity(word & 0x103fff800007fff, false) << 0) |
          (calc_parity(word & 0x17c1ff801ff801f, false) << 1) |
          (calc_parity(word & 0x1bde1f87e0781e1, false) << 2) |
@@ -76,12 +106,23 @@ uint8_t enc_secded_64_57(const uint8_t bytes[8]) {
          (calc_parity(word & 0x1fbdda769a46910, false) << 6);
 }
 
-uint8_t enc_secded_72_64(const uint8_t bytes[8]) {
+uint8_t enc_secded_64_57(const uint8_t bytes[8]) {
   uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
                   ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
                   ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
                   ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
 
+  return enc_secded_64_57_word(word);
+}
+
+void enc_secded_64_57_words(const uint64_t *words, uint8_t *check_bits,
+                            size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_64_57_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_72_64_word(uint64_t word) {
   return (calc_parity(word & 0xb9000000001fffff, false) << 0) |
          (calc_parity(word & 0x5e00000fffe0003f, false) << 1) |
          (calc_parity(word & 0x67003ff003e007c1, false) << 2) |
@@ -92,9 +133,23 @@ uint8_t enc_secded_72_64(const uint8_t bytes[8]) {
          (calc_parity(word & 0x7aed348d221a4420, false) << 7);
 }
 
-uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]) {
-  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
+uint8_t enc_secded_72_64(const uint8_t bytes[8]) {
+  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
+                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
+                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
+                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+
+  return enc_secded_72_64_word(word);
+}
 
+void enc_secded_72_64_words(const uint64_t *words, uint8_t *check_bits,
+                            size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_72_64_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_inv_22_16_word(uint16_t word) {
   return (calc_parity(word & 0x496e, false) << 0) |
          (calc_parity(word & 0xf20b, true) << 1) |
          (calc_parity(word & 0x8ed8, false) << 2) |
@@ -103,10 +158,20 @@ uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]) {
          (calc_parity(word & 0x11f3, true) << 5);
 }
 
-uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]) {
-  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16);
+uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]) {
+  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
+
+  return enc_secded_inv_22_16_word(word);
+}
 
+void enc_secded_inv_22_16_words(const uint16_t *words, uint8_t *check_bits,
+                                size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_inv_22_16_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_inv_28_22_word(uint32_t word) {
   return (calc_parity(word & 0x3003ff, false) << 0) |
          (calc_parity(word & 0x10fc0f, true) << 1) |
          (calc_parity(word & 0x271c71, false) << 2) |
@@ -115,10 +180,21 @@ uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]) {
          (calc_parity(word & 0x3ed348, true) << 5);
 }
 
-uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]) {
+uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]) {
   uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+                  ((uint32_t)bytes[2] << 16);
 
+  return enc_secded_inv_28_22_word(word);
+}
+
+void enc_secded_inv_28_22_words(const uint32_t *words, uint8_t *check_bits,
+                                size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_inv_28_22_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_inv_39_32_word(uint32_t word) {
   return (calc_parity(word & 0x2606bd25, false) << 0) |
          (calc_parity(word & 0xdeba8050, true) << 1) |
          (calc_parity(word & 0x413d89aa, false) << 2) |
@@ -128,12 +204,21 @@ uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]) {
          (calc_parity(word & 0x98505586, false) << 6);
 }
 
-uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]) {
-  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
-                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
-                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
-                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]) {
+  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
+                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
 
+  return enc_secded_inv_39_32_word(word);
+}
+
+void enc_secded_inv_39_32_words(const uint32_t *words, uint8_t *check_bits,
+                                size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_inv_39_32_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_inv_64_57_word(uint64_t word) {
   return (calc_parity(word & 0x103fff800007fff, false) << 0) |
          (calc_parity(word & 0x17c1ff801ff801f, true) << 1) |
          (calc_parity(word & 0x1bde1f87e0781e1, false) << 2) |
@@ -143,12 +228,23 @@ uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]) {
          (calc_parity(word & 0x1fbdda769a46910, false) << 6);
 }
 
-uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]) {
+uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]) {
   uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
                   ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
                   ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
                   ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
 
+  return enc_secded_inv_64_57_word(word);
+}
+
+void enc_secded_inv_64_57_words(const uint64_t *words, uint8_t *check_bits,
+                                size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_inv_64_57_word(words[i]);
+  }
+}
+
+uint8_t enc_secded_inv_72_64_word(uint64_t word) {
   return (calc_parity(word & 0xb9000000001fffff, false) << 0) |
          (calc_parity(word & 0x5e00000fffe0003f, true) << 1) |
          (calc_parity(word & 0x67003ff003e007c1, false) << 2) |
@@ -158,3 +254,19 @@ uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]) {
          (calc_parity(word & 0xcbdaaa4a91152210, false) << 6) |
          (calc_parity(word & 0x7aed348d221a4420, true) << 7);
 }
+
+uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]) {
+  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
+                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
+                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
+                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+
+  return enc_secded_inv_72_64_word(word);
+}
+
+void enc_secded_inv_72_64_words(const uint64_t *words, uint8_t *check_bits,
+                                size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    check_bits[i] = enc_secded_inv_72_64_word(words[i]);
+  }
+}
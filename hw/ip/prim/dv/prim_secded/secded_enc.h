@@ -8,6 +8,7 @@
 #ifndef OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 #define OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -15,19 +16,53 @@ extern "C" {
 #endif  // __cplusplus
 
 // Integrity encode functions for varying bit widths matching the functionality
-// of the RTL modules of the same name. Each takes an array of bytes in
-// little-endian order and returns the calculated integrity bits.
+// of the RTL modules of the same name. For each code there are three variants:
+// - enc_secded_<n>_<k>() takes an array of bytes in little-endian order and
+//   returns the calculated integrity bits.
+// - enc_secded_<n>_<k>_word() takes the data as a single integer.
+// - enc_secded_<n>_<k>_words() encodes `count` data words from `words`,
+//   writing the integrity bits of each to `check_bits`.
 
 uint8_t enc_secded_22_16(const uint8_t bytes[2]);
+uint8_t enc_secded_22_16_word(uint16_t word);
+void enc_secded_22_16_words(const uint16_t *words, uint8_t *check_bits,
+                            size_t count);
 uint8_t enc_secded_28_22(const uint8_t bytes[3]);
+uint8_t enc_secded_28_22_word(uint32_t word);
+void enc_secded_28_22_words(const uint32_t *words, uint8_t *check_bits,
+                            size_t count);
 uint8_t enc_secded_39_32(const uint8_t bytes[4]);
+uint8_t enc_secded_39_32_word(uint32_t word);
+void enc_secded_39_32_words(const uint32_t *words, uint8_t *check_bits,
+                            size_t count);
 uint8_t enc_secded_64_57(const uint8_t bytes[8]);
+uint8_t enc_secded_64_57_word(uint64_t word);
+void enc_secded_64_57_words(const uint64_t *words, uint8_t *check_bits,
+                            size_t count);
 uint8_t enc_secded_72_64(const uint8_t bytes[8]);
+uint8_t enc_secded_72_64_word(uint64_t word);
+void enc_secded_72_64_words(const uint64_t *words, uint8_t *check_bits,
+                            size_t count);
 uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]);
+uint8_t enc_secded_inv_22_16_word(uint16_t word);
+void enc_secded_inv_22_16_words(const uint16_t *words, uint8_t *check_bits,
+                                size_t count);
 uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]);
+uint8_t enc_secded_inv_28_22_word(uint32_t word);
+void enc_secded_inv_28_22_words(const uint32_t *words, uint8_t *check_bits,
+                                size_t count);
 uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]);
+uint8_t enc_secded_inv_39_32_word(uint32_t word);
+void enc_secded_inv_39_32_words(const uint32_t *words, uint8_t *check_bits,
+                                size_t count);
 uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]);
+uint8_t enc_secded_inv_64_57_word(uint64_t word);
+void enc_secded_inv_64_57_words(const uint64_t *words, uint8_t *check_bits,
+                                size_t count);
 uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]);
+uint8_t enc_secded_inv_72_64_word(uint64_t word);
+void enc_secded_inv_72_64_words(const uint64_t *words, uint8_t *check_bits,
+                                size_t count);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -69,6 +69,10 @@ module uart_core (
   logic           event_rx_overflow, event_rx_frame_err, event_rx_break_err, event_rx_timeout;
   logic           event_rx_parity_err;
   logic           tx_uart_idle_q;
+  logic           tx_out_idle, tx_wr;
+  logic   [7:0]   rx_fifo_wdata;
+  logic           ff_path, ff_tx_busy_q, ff_rx_valid_q;
+  logic   [7:0]   ff_rx_data_q;
 
   assign tx_enable        = reg2hw.ctrl.tx.q;
   assign rx_enable        = reg2hw.ctrl.rx.q;
@@ -172,11 +176,65 @@ module uart_core (
 
   assign tick_baud_x16 = nco_sum_q[16];
 
+  //////////////////
+  // Fast-forward //
+  //////////////////
+
+`ifdef UART_FAST_FORWARD
+  // With UART_FAST_FORWARD defined, a uartdpi terminal can be connected directly
+  // to the FIFOs (see hw/dv/dpi/uartdpi). Bytes are then exchanged with the host
+  // at up to one every two cycles instead of bit-serially. The FIFOs, status
+  // bits and interrupts behave as normal, but the pins are idle and there can be
+  // no RX errors or overflows (the host side waits for space in the RX FIFO).
+  // The loopback modes always use the serial path.
+  import "DPI-C" function chandle uartdpi_ff_port(input string scope);
+  import "DPI-C" function int uartdpi_ff_enabled(input chandle port);
+  import "DPI-C" function int uartdpi_ff_read(input chandle port, output bit [7:0] data);
+  import "DPI-C" function void uartdpi_ff_write(input chandle port, input bit [7:0] data);
+
+  chandle ff_port;
+  logic   ff_enabled_q;
+  initial ff_port = uartdpi_ff_port($sformatf("%m"));
+
+  assign ff_path = ff_enabled_q & ~sys_loopback & ~line_loopback;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      ff_enabled_q  <= 1'b0;
+      ff_tx_busy_q  <= 1'b0;
+      ff_rx_valid_q <= 1'b0;
+      ff_rx_data_q  <= '0;
+    end else begin
+      automatic bit [7:0] rx_byte;
+      ff_enabled_q  <= uartdpi_ff_enabled(ff_port) != 0;
+      // A popped byte keeps the transmitter busy for a cycle, so that tx_done
+      // and TX idle behave as they do on the serial path.
+      ff_tx_busy_q  <= ff_path & tx_fifo_rready;
+      if (ff_path && tx_fifo_rready) begin
+        uartdpi_ff_write(ff_port, tx_fifo_data);
+      end
+      ff_rx_valid_q <= 1'b0;
+      if (ff_path && rx_enable && rx_fifo_wready && !ff_rx_valid_q &&
+          uartdpi_ff_read(ff_port, rx_byte) != 0) begin
+        ff_rx_valid_q <= 1'b1;
+        ff_rx_data_q  <= rx_byte;
+      end
+    end
+  end
+`else
+  assign ff_path       = 1'b0;
+  assign ff_tx_busy_q  = 1'b0;
+  assign ff_rx_valid_q = 1'b0;
+  assign ff_rx_data_q  = '0;
+`endif
+
   //////////////
   // TX Logic //
   //////////////
 
+  assign tx_uart_idle   = tx_out_idle & ~ff_tx_busy_q;
   assign tx_fifo_rready = tx_uart_idle & tx_fifo_rvalid & tx_enable;
+  assign tx_wr          = tx_fifo_rready & ~ff_path;
 
   prim_fifo_sync #(
     .Width   (8),
@@ -203,10 +261,10 @@ module uart_core (
     .tx_enable,
     .tick_baud_x16,
     .parity_enable  (reg2hw.ctrl.parity_en.q),
-    .wr             (tx_fifo_rready),
+    .wr             (tx_wr),
     .wr_parity      ((^tx_fifo_data) ^ reg2hw.ctrl.parity_odd.q),
     .wr_data        (tx_fifo_data),
-    .idle           (tx_uart_idle),
+    .idle           (tx_out_idle),
     .tx             (tx_out)
   );
 
@@ -277,7 +335,9 @@ module uart_core (
     .rx_parity_err  (event_rx_parity_err)
   );
 
-  assign rx_fifo_wvalid = rx_valid & ~event_rx_frame_err & ~event_rx_parity_err;
+  assign rx_fifo_wvalid = ff_path ? ff_rx_valid_q :
+                          rx_valid & ~event_rx_frame_err & ~event_rx_parity_err;
+  assign rx_fifo_wdata  = ff_path ? ff_rx_data_q : rx_fifo_data;
 
   prim_fifo_sync #(
     .Width   (8),
@@ -289,7 +349,7 @@ module uart_core (
     .clr_i   (uart_fifo_rxrst),
     .wvalid_i(rx_fifo_wvalid),
     .wready_o(rx_fifo_wready),
-    .wdata_i (rx_fifo_data),
+    .wdata_i (rx_fifo_wdata),
     .depth_o (rx_fifo_depth),
     .full_o (),
     .rvalid_o(rx_fifo_rvalid),
@@ -160,6 +160,135 @@ module usb_fs_nb_pe #(
 
   logic usb_oe;
 
+  // rx interface of usb_fs_rx
+  logic phy_rx_pkt_start;
+  logic phy_rx_pkt_end;
+  logic [3:0] phy_rx_pid;
+  logic [6:0] phy_rx_addr;
+  logic [3:0] phy_rx_endp;
+  logic [10:0] phy_rx_frame_num;
+  logic phy_rx_data_put;
+  logic [7:0] phy_rx_data;
+  logic phy_rx_pid_valid;
+  logic phy_rx_pkt_valid;
+
+  // tx interface of usb_fs_tx
+  logic phy_tx_pkt_start;
+  logic phy_tx_pkt_end;
+  logic phy_tx_data_get;
+
+  // Packet-level connection to a DPI host
+  logic pkt_path, pkt_rx_sel_q;
+  logic pkt_rx_start_q, pkt_rx_end_q, pkt_rx_data_put_q;
+  logic pkt_rx_pid_valid_q, pkt_rx_pkt_valid_q;
+  logic [3:0] pkt_rx_pid_q;
+  logic [15:0] pkt_rx_token_q;
+  logic [7:0] pkt_rx_data_q;
+  logic pkt_tx_data_get_q, pkt_tx_end_q;
+
+`ifdef USBDEV_PACKET_DPI
+  // With USBDEV_PACKET_DPI defined, a usbdpi host can exchange packets with the protocol engines
+  // directly (see hw/dv/dpi/usbdpi/usbdpi_packet.c). Host packets then arrive a byte at a time,
+  // much faster than over the bus, and device packets are collected in place of usb_fs_tx, which
+  // stays idle. SOF packets and bus resets are still received from the bus, so that link state,
+  // suspend and frame timing behave as normal.
+  import "DPI-C" function chandle usbdpi_pkt_port(input string scope);
+  import "DPI-C" function int usbdpi_pkt_enabled(input chandle port);
+  import "DPI-C" function int usbdpi_pkt_rx(input chandle port, output bit [7:0] data);
+  import "DPI-C" function int usbdpi_pkt_tx(input chandle port, input int start, input int pid,
+                                            input int avail, input int data);
+
+  chandle pkt_port;
+  logic   pkt_enabled_q;
+  initial pkt_port = usbdpi_pkt_port($sformatf("%m"));
+
+  assign pkt_path = pkt_enabled_q;
+
+  always_ff @(posedge clk_48mhz_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      pkt_enabled_q      <= 1'b0;
+      pkt_rx_sel_q       <= 1'b0;
+      pkt_rx_start_q     <= 1'b0;
+      pkt_rx_end_q       <= 1'b0;
+      pkt_rx_data_put_q  <= 1'b0;
+      pkt_rx_pid_valid_q <= 1'b0;
+      pkt_rx_pkt_valid_q <= 1'b0;
+      pkt_rx_pid_q       <= '0;
+      pkt_rx_token_q     <= '0;
+      pkt_rx_data_q      <= '0;
+      pkt_tx_data_get_q  <= 1'b0;
+      pkt_tx_end_q       <= 1'b0;
+    end else begin
+      automatic bit [7:0] rx_byte;
+      automatic int tx_flags = 0;
+      pkt_enabled_q     <= usbdpi_pkt_enabled(pkt_port) != 0;
+      pkt_rx_start_q    <= 1'b0;
+      pkt_rx_end_q      <= 1'b0;
+      pkt_rx_data_put_q <= 1'b0;
+      // The packet fields follow whichever source started the latest packet
+      if (phy_rx_pkt_start) begin
+        pkt_rx_sel_q <= 1'b0;
+      end
+      if (pkt_path) begin
+        case (usbdpi_pkt_rx(pkt_port, rx_byte))
+          1: begin  // PID
+            pkt_rx_sel_q   <= 1'b1;
+            pkt_rx_start_q <= 1'b1;
+            pkt_rx_pid_q   <= rx_byte[3:0];
+          end
+          2: pkt_rx_token_q <= {rx_byte, pkt_rx_token_q[15:8]};
+          3: begin  // Data field or CRC16
+            pkt_rx_data_put_q <= 1'b1;
+            pkt_rx_data_q     <= rx_byte;
+          end
+          4: begin  // End of packet, with validity
+            pkt_rx_end_q       <= 1'b1;
+            pkt_rx_pid_valid_q <= rx_byte[0];
+            pkt_rx_pkt_valid_q <= rx_byte[1];
+          end
+          default: ;
+        endcase
+        tx_flags = usbdpi_pkt_tx(pkt_port, int'(tx_pkt_start), int'(tx_pid), int'(tx_data_avail),
+                                 int'(tx_data));
+      end
+      pkt_tx_data_get_q <= tx_flags[0];
+      pkt_tx_end_q      <= tx_flags[1];
+    end
+  end
+`else
+  assign pkt_path           = 1'b0;
+  assign pkt_rx_sel_q       = 1'b0;
+  assign pkt_rx_start_q     = 1'b0;
+  assign pkt_rx_end_q       = 1'b0;
+  assign pkt_rx_data_put_q  = 1'b0;
+  assign pkt_rx_pid_valid_q = 1'b0;
+  assign pkt_rx_pkt_valid_q = 1'b0;
+  assign pkt_rx_pid_q       = '0;
+  assign pkt_rx_token_q     = '0;
+  assign pkt_rx_data_q      = '0;
+  assign pkt_tx_data_get_q  = 1'b0;
+  assign pkt_tx_end_q       = 1'b0;
+`endif
+
+  assign rx_pkt_start = phy_rx_pkt_start | pkt_rx_start_q;
+  assign rx_pkt_end   = phy_rx_pkt_end | pkt_rx_end_q;
+  assign rx_data_put  = phy_rx_data_put | pkt_rx_data_put_q;
+  assign rx_pid       = pkt_rx_sel_q ? pkt_rx_pid_q : phy_rx_pid;
+  assign rx_addr      = pkt_rx_sel_q ? pkt_rx_token_q[6:0] : phy_rx_addr;
+  assign rx_endp      = pkt_rx_sel_q ? pkt_rx_token_q[10:7] : phy_rx_endp;
+  assign rx_frame_num = pkt_rx_sel_q ? pkt_rx_token_q[10:0] : phy_rx_frame_num;
+  assign rx_data      = pkt_rx_sel_q ? pkt_rx_data_q : phy_rx_data;
+  assign rx_pid_valid = pkt_rx_sel_q ? pkt_rx_pid_valid_q : phy_rx_pid_valid;
+  assign rx_pkt_valid = pkt_rx_sel_q ? pkt_rx_pkt_valid_q : phy_rx_pkt_valid;
+
+  // Only the address and endpoint are taken from the token payload
+  logic unused_pkt_rx_token;
+  assign unused_pkt_rx_token = ^pkt_rx_token_q[15:11];
+
+  assign phy_tx_pkt_start = tx_pkt_start & ~pkt_path;
+  assign tx_pkt_end       = pkt_path ? pkt_tx_end_q : phy_tx_pkt_end;
+  assign tx_data_get      = pkt_path ? pkt_tx_data_get_q : phy_tx_data_get;
+
   // Start Of Frame handling
   //
   // - SOF is detected and may be used for timing/synchronization purposes if the PID is valid.
@@ -291,16 +420,16 @@ module usb_fs_nb_pe #(
     .usb_dn_i               (usb_dn_i),
     .tx_en_i                (usb_oe),
     .bit_strobe_o           (bit_strobe),
-    .pkt_start_o            (rx_pkt_start),
-    .pkt_end_o              (rx_pkt_end),
-    .pid_o                  (rx_pid),
-    .addr_o                 (rx_addr),
-    .endp_o                 (rx_endp),
-    .frame_num_o            (rx_frame_num),
-    .rx_data_put_o          (rx_data_put),
-    .rx_data_o              (rx_data),
-    .valid_pid_o            (rx_pid_valid),
-    .valid_packet_o         (rx_pkt_valid),
+    .pkt_start_o            (phy_rx_pkt_start),
+    .pkt_end_o              (phy_rx_pkt_end),
+    .pid_o                  (phy_rx_pid),
+    .addr_o                 (phy_rx_addr),
+    .endp_o                 (phy_rx_endp),
+    .frame_num_o            (phy_rx_frame_num),
+    .rx_data_put_o          (phy_rx_data_put),
+    .rx_data_o              (phy_rx_data),
+    .valid_pid_o            (phy_rx_pid_valid),
+    .valid_packet_o         (phy_rx_pkt_valid),
     .rx_idle_det_o          (rx_idle_det_o),
     .rx_j_det_o             (rx_j_det_o),
     .crc5_error_o           (rx_crc5_err_o),
@@ -335,11 +464,11 @@ module usb_fs_nb_pe #(
     .usb_dp_o               (usb_dp_o),
     .usb_dn_o               (usb_dn_o),
     .usb_oe_o               (usb_oe),
-    .pkt_start_i            (tx_pkt_start),
-    .pkt_end_o              (tx_pkt_end),
+    .pkt_start_i            (phy_tx_pkt_start),
+    .pkt_end_o              (phy_tx_pkt_end),
     .pid_i                  (tx_pid),
     .tx_data_avail_i        (tx_data_avail),
-    .tx_data_get_o          (tx_data_get),
+    .tx_data_get_o          (phy_tx_data_get),
     .tx_data_i              (tx_data)
   );
 
@@ -7,10 +7,15 @@
 #include <string>
 #include <vector>
 
+#include "sw_log_extension.h"
 #include "verilated_toplevel.h"
 #include "verilator_memutil.h"
 #include "verilator_sim_ctrl.h"
 
+static SwLogExtension sw_log;
+
+extern "C" void chip_sim_sw_log_write(uint32_t data) { sw_log.Write(data); }
+
 int main(int argc, char **argv) {
   chip_sim_tb top;
   VerilatorMemUtil memutil;
@@ -57,6 +62,7 @@ int main(int argc, char **argv) {
   memutil.RegisterMemoryArea("flash1", 0x20080000u, &flash1);
   memutil.RegisterMemoryArea("otp", 0x40000000u /* (bogus LMA) */, &otp);
   simctrl.RegisterExtension(&memutil);
+  simctrl.RegisterExtension(&sw_log);
 
   // The initial reset delay must be long enough such that pwr/rst/clkmgr will
   // release clocks to the entire design.  This allows for synchronous resets
@@ -13,8 +13,8 @@ module chip_sim_tb (
   logic cio_uart_rx_p2d, cio_uart_tx_d2p, cio_uart_tx_en_d2p;
 
   logic cio_spi_device_sck_p2d, cio_spi_device_csb_p2d;
-  logic cio_spi_device_sdi_p2d;
-  logic cio_spi_device_sdo_d2p, cio_spi_device_sdo_en_d2p;
+  logic [3:0] cio_spi_device_sd_p2d;
+  logic [3:0] cio_spi_device_sd_d2p, cio_spi_device_sd_en_d2p;
 
   logic cio_usbdev_sense_p2d;
   logic cio_usbdev_se0_d2p;
@@ -44,9 +44,9 @@ module chip_sim_tb (
     // communication with SPI
     .cio_spi_device_sck_p2d_i(cio_spi_device_sck_p2d),
     .cio_spi_device_csb_p2d_i(cio_spi_device_csb_p2d),
-    .cio_spi_device_sdi_p2d_i(cio_spi_device_sdi_p2d),
-    .cio_spi_device_sdo_d2p_o(cio_spi_device_sdo_d2p),
-    .cio_spi_device_sdo_en_d2p_o(cio_spi_device_sdo_en_d2p),
+    .cio_spi_device_sd_p2d_i(cio_spi_device_sd_p2d),
+    .cio_spi_device_sd_d2p_o(cio_spi_device_sd_d2p),
+    .cio_spi_device_sd_en_d2p_o(cio_spi_device_sd_en_d2p),
 
     // communication with USB
     .cio_usbdev_sense_p2d_i(cio_usbdev_sense_p2d),
@@ -84,7 +84,8 @@ module chip_sim_tb (
   // `sw/device/lib/arch/device_sim_verilator.c`.
   uartdpi #(
     .BAUD('d7_200),
-    .FREQ('d500_000)
+    .FREQ('d500_000),
+    .FAST_FORWARD_SCOPE("u_uart0")
   ) u_uart (
     .clk_i  (clk_i),
     .rst_ni (rst_ni),
@@ -95,7 +96,9 @@ module chip_sim_tb (
 
 `ifdef DMIDirectTAP
   // OpenOCD direct DMI TAP
-  bind rv_dm dmidpi u_dmidpi (
+  bind rv_dm dmidpi #(
+    .DmiListenPort(44854)
+  ) u_dmidpi (
     .clk_i,
     .rst_ni,
     .dmi_req_valid,
@@ -134,13 +137,19 @@ module chip_sim_tb (
     .rst_ni (rst_ni),
     .spi_device_sck_o     (cio_spi_device_sck_p2d),
     .spi_device_csb_o     (cio_spi_device_csb_p2d),
-    .spi_device_sdi_o     (cio_spi_device_sdi_p2d),
-    .spi_device_sdo_i     (cio_spi_device_sdo_d2p),
-    .spi_device_sdo_en_i  (cio_spi_device_sdo_en_d2p)
+    .spi_device_sdi_o     (),
+    .spi_device_sdo_i     (cio_spi_device_sd_d2p[1]),
+    .spi_device_sdo_en_i  (cio_spi_device_sd_en_d2p[1]),
+    .spi_device_sd_o      (cio_spi_device_sd_p2d),
+    .spi_device_sd_en_o   (),
+    .spi_device_sd_i      (cio_spi_device_sd_d2p),
+    .spi_device_sd_en_i   (cio_spi_device_sd_en_d2p)
   );
 
   // USB DPI
-  usbdpi u_usbdpi (
+  usbdpi #(
+    .PACKET_SCOPE("u_usbdev")
+  ) u_usbdpi (
     .clk_i           (clk_i),
     .rst_ni          (rst_ni),
     .clk_48MHz_i     (clk_i),
@@ -198,6 +207,17 @@ module chip_sim_tb (
     u_sw_test_status_if.sw_test_status_addr = `SIM_SRAM_IF.start_addr;
   end
 
+  // Forward DV log bypass writes (offset 4 within the sim SRAM, as in the DV testbench) to the
+  // SW log decoder in chip_sim_tb.cc, which formats them using the strings in the test ELF.
+  import "DPI-C" function void chip_sim_sw_log_write(input int unsigned data);
+
+  always @(posedge `SIM_SRAM_IF.clk_i) begin
+    if (`SIM_SRAM_IF.wr_valid &&
+        `SIM_SRAM_IF.tl_h2d.a_address == `SIM_SRAM_IF.start_addr + 4) begin
+      chip_sim_sw_log_write(`SIM_SRAM_IF.tl_h2d.a_data);
+    end
+  end
+
   always @(posedge clk_i) begin
     if (u_sw_test_status_if.sw_test_done) begin
       $display("Verilator sim termination requested");
@@ -2,12 +2,20 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include "sw_log_extension.h"
 #include "verilated_toplevel.h"
 #include "verilator_memutil.h"
 #include "verilator_sim_ctrl.h"
 
+static SwLogExtension sw_log;
+
+extern "C" void chip_sim_sw_log_write(uint32_t data) { sw_log.Write(data); }
+
 int main(int argc, char **argv) {
   chip_englishbreakfast_verilator top;
   VerilatorMemUtil memutil;
@@ -34,11 +42,16 @@ int main(int argc, char **argv) {
           "gen_prim_flash_banks[0].u_prim_flash_bank.u_mem."
           "gen_generic.u_impl_generic",
       0x100000 / 8, 8);
+  // Start with the flash region erased. Future loads can overwrite.
+  std::vector<uint8_t> all_ones(flash0.GetSizeBytes());
+  std::fill(all_ones.begin(), all_ones.end(), 0xffu);
+  flash0.Write(/*word_offset=*/0, all_ones);
 
   memutil.RegisterMemoryArea("rom", 0x8000, &rom);
   memutil.RegisterMemoryArea("ram", 0x10000000u, &ram);
   memutil.RegisterMemoryArea("flash0", 0x20000000u, &flash0);
   simctrl.RegisterExtension(&memutil);
+  simctrl.RegisterExtension(&sw_log);
 
   // see chip_earlgrey_verilator.cc for justification and explanation
   simctrl.SetInitialResetDelay(1000);
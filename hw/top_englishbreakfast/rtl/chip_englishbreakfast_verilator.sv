@@ -293,7 +293,11 @@ module chip_englishbreakfast_verilator (
     .spi_device_csb_o     (cio_spi_device_csb_p2d),
     .spi_device_sdi_o     (cio_spi_device_sdi_p2d),
     .spi_device_sdo_i     (cio_spi_device_sdo_d2p),
-    .spi_device_sdo_en_i  (cio_spi_device_sdo_en_d2p)
+    .spi_device_sdo_en_i  (cio_spi_device_sdo_en_d2p),
+    .spi_device_sd_o      (),
+    .spi_device_sd_en_o   (),
+    .spi_device_sd_i      ('0),
+    .spi_device_sd_en_i   ('0)
   );
 
   // USB DPI
@@ -352,6 +356,18 @@ module chip_englishbreakfast_verilator (
     u_sw_test_status_if.sw_test_status_addr = `SIM_SRAM_IF.start_addr;
   end
 
+  // Forward DV log bypass writes (offset 4 within the sim SRAM, as in the DV testbench) to the
+  // SW log decoder in chip_englishbreakfast_verilator.cc, which formats them using the strings in
+  // the test ELF.
+  import "DPI-C" function void chip_sim_sw_log_write(input int unsigned data);
+
+  always @(posedge `SIM_SRAM_IF.clk_i) begin
+    if (`SIM_SRAM_IF.wr_valid &&
+        `SIM_SRAM_IF.tl_h2d.a_address == `SIM_SRAM_IF.start_addr + 4) begin
+      chip_sim_sw_log_write(`SIM_SRAM_IF.tl_h2d.a_data);
+    end
+  end
+
   always @(posedge clk_i) begin
     if (u_sw_test_status_if.sw_test_done) begin
       $display("Verilator sim termination requested");
@@ -68,6 +68,15 @@ const uintptr_t kDeviceTestStatusAddress =
     TOP_EARLGREY_RV_CORE_IBEX_CFG_BASE_ADDR +
     RV_CORE_IBEX_DV_SIM_WINDOW_REG_OFFSET;
 
+// Logging through the sim SRAM is opt-in: the default test harness matches on
+// the UART console, so it only works with a simulator started with
+// `--sw-log-elf` pointing at the same ELF.
+#ifdef OT_SIM_VERILATOR_LOG_BYPASS
+const uintptr_t kDeviceLogBypassUartAddress =
+    TOP_EARLGREY_RV_CORE_IBEX_CFG_BASE_ADDR +
+    RV_CORE_IBEX_DV_SIM_WINDOW_REG_OFFSET + 0x04;
+#else
 const uintptr_t kDeviceLogBypassUartAddress = 0;
+#endif
 
 void device_fpga_version_print(void) {}
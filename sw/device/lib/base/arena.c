@@ -0,0 +1,47 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/arena.h"
+
+#include "sw/device/lib/base/hardened_memory.h"
+
+void arena_init(arena_t *arena, uint32_t *buf, size_t word_len,
+                hardened_bool_t wipe) {
+  *arena = (arena_t){
+      .base = buf,
+      .word_len = word_len,
+      .wipe = wipe,
+  };
+}
+
+void *arena_alloc(arena_t *arena, size_t byte_len) {
+  // Written so that a huge `byte_len` cannot overflow.
+  size_t words = byte_len / sizeof(uint32_t) +
+                 (byte_len % sizeof(uint32_t) != 0 ? 1 : 0);
+  if (words > arena->word_len - arena->used) {
+    return NULL;
+  }
+  uint32_t *ptr = arena->base + arena->used;
+  arena->used += words;
+  if (arena->used > arena->high_water) {
+    arena->high_water = arena->used;
+  }
+  return ptr;
+}
+
+size_t arena_mark(const arena_t *arena) { return arena->used; }
+
+void arena_release(arena_t *arena, size_t mark) {
+  HARDENED_CHECK_LE(mark, arena->used);
+  if (launder32(arena->wipe) == kHardenedBoolTrue) {
+    hardened_memshred(arena->base + mark, arena->used - mark);
+  }
+  arena->used = mark;
+}
+
+void arena_reset(arena_t *arena) { arena_release(arena, 0); }
+
+size_t arena_high_water(const arena_t *arena) {
+  return arena->high_water * sizeof(uint32_t);
+}
@@ -0,0 +1,131 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_BASE_ARENA_H_
+#define OPENTITAN_SW_DEVICE_LIB_BASE_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * @file
+ * @brief A bump allocator over a caller-provided static buffer.
+ *
+ * Allocations are word-aligned and are freed in bulk by releasing the arena
+ * back to a mark taken earlier, so that scratch space can be reused between
+ * operations that would otherwise each need their own worst-case buffer:
+ *
+ *   size_t mark = arena_mark(&arena);
+ *   uint32_t *scratch = arena_alloc(&arena, len);
+ *   if (scratch == NULL) {
+ *     return kErrorOutOfMemory;
+ *   }
+ *   // Do some stuff
+ *   arena_release(&arena, mark);
+ *
+ * Arenas that hold secrets can be initialized to shred memory on release.
+ */
+
+/**
+ * A bump allocator.
+ *
+ * The fields are private; use the functions below.
+ */
+typedef struct arena {
+  /**
+   * Backing buffer.
+   */
+  uint32_t *base;
+  /**
+   * Size of the backing buffer, in words.
+   */
+  size_t word_len;
+  /**
+   * Number of words currently allocated.
+   */
+  size_t used;
+  /**
+   * Largest value `used` has had since the arena was initialized.
+   */
+  size_t high_water;
+  /**
+   * Whether released memory is shredded with `hardened_memshred()`.
+   */
+  hardened_bool_t wipe;
+} arena_t;
+
+/**
+ * Static initializer for an arena over the array `buf_`.
+ *
+ * @param buf_ A `uint32_t` array with static storage duration.
+ * @param wipe_ Whether to shred memory when it is released.
+ */
+#define ARENA_INIT(buf_, wipe_) \
+  { .base = (buf_), .word_len = ARRAYSIZE(buf_), .wipe = (wipe_) }
+
+/**
+ * Initializes an arena over `buf`.
+ *
+ * @param arena The arena to initialize.
+ * @param buf Backing buffer, which must outlive the arena.
+ * @param word_len Size of `buf`, in words.
+ * @param wipe Whether to shred memory when it is released.
+ */
+void arena_init(arena_t *arena, uint32_t *buf, size_t word_len,
+                hardened_bool_t wipe);
+
+/**
+ * Allocates `byte_len` bytes, rounded up to whole words.
+ *
+ * The memory is not cleared.
+ *
+ * @param arena The arena to allocate from.
+ * @param byte_len Number of bytes to allocate.
+ * @return Word-aligned memory, or NULL if the arena does not have room.
+ */
+OT_WARN_UNUSED_RESULT
+void *arena_alloc(arena_t *arena, size_t byte_len);
+
+/**
+ * Returns a mark that `arena_release()` can later roll the arena back to.
+ */
+OT_WARN_UNUSED_RESULT
+size_t arena_mark(const arena_t *arena);
+
+/**
+ * Frees everything allocated since `mark` was taken.
+ *
+ * If the arena was initialized with `wipe`, the freed memory is shredded.
+ *
+ * @param arena The arena to release.
+ * @param mark A mark from `arena_mark()` on this arena.
+ */
+void arena_release(arena_t *arena, size_t mark);
+
+/**
+ * Frees everything allocated from the arena.
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * Returns the most memory the arena has had allocated at once, in bytes.
+ *
+ * Like the stack utilization check, this is meant for sizing the backing
+ * buffer.
+ */
+OT_WARN_UNUSED_RESULT
+size_t arena_high_water(const arena_t *arena);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_BASE_ARENA_H_
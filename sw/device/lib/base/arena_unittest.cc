@@ -0,0 +1,85 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/arena.h"
+
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/hardened_memory.h"
+
+namespace arena_unittest {
+namespace {
+
+class ArenaTest : public testing::Test {
+ protected:
+  void Init(hardened_bool_t wipe) {
+    for (auto &word : buf_) {
+      word = 0;
+    }
+    arena_init(&arena_, buf_, sizeof(buf_) / sizeof(buf_[0]), wipe);
+  }
+
+  uint32_t buf_[8];
+  arena_t arena_;
+};
+
+TEST_F(ArenaTest, AllocAligned) {
+  Init(kHardenedBoolFalse);
+  uint32_t *a = static_cast<uint32_t *>(arena_alloc(&arena_, 1));
+  uint32_t *b = static_cast<uint32_t *>(arena_alloc(&arena_, 5));
+  uint32_t *c = static_cast<uint32_t *>(arena_alloc(&arena_, 0));
+  EXPECT_EQ(a, &buf_[0]);
+  EXPECT_EQ(b, &buf_[1]);
+  EXPECT_EQ(c, &buf_[3]);
+  EXPECT_EQ(arena_mark(&arena_), 3);
+}
+
+TEST_F(ArenaTest, Full) {
+  Init(kHardenedBoolFalse);
+  EXPECT_NE(arena_alloc(&arena_, 7 * sizeof(uint32_t)), nullptr);
+  EXPECT_EQ(arena_alloc(&arena_, 2 * sizeof(uint32_t)), nullptr);
+  EXPECT_EQ(arena_alloc(&arena_, SIZE_MAX), nullptr);
+  EXPECT_EQ(arena_alloc(&arena_, sizeof(uint32_t)), &buf_[7]);
+  EXPECT_EQ(arena_alloc(&arena_, 1), nullptr);
+}
+
+TEST_F(ArenaTest, ReleaseAndHighWater) {
+  Init(kHardenedBoolFalse);
+  EXPECT_NE(arena_alloc(&arena_, sizeof(uint32_t)), nullptr);
+  size_t mark = arena_mark(&arena_);
+  EXPECT_NE(arena_alloc(&arena_, 4 * sizeof(uint32_t)), nullptr);
+  buf_[1] = 0x5a5a5a5a;
+  arena_release(&arena_, mark);
+
+  // Without `wipe`, released memory is left as is.
+  EXPECT_EQ(buf_[1], 0x5a5a5a5a);
+  EXPECT_EQ(arena_alloc(&arena_, sizeof(uint32_t)), &buf_[1]);
+  arena_reset(&arena_);
+  EXPECT_EQ(arena_mark(&arena_), 0);
+  EXPECT_EQ(arena_high_water(&arena_), 5 * sizeof(uint32_t));
+}
+
+TEST_F(ArenaTest, Wipe) {
+  Init(kHardenedBoolTrue);
+  uint32_t *a =
+      static_cast<uint32_t *>(arena_alloc(&arena_, sizeof(uint32_t)));
+  size_t mark = arena_mark(&arena_);
+  uint32_t *b =
+      static_cast<uint32_t *>(arena_alloc(&arena_, 2 * sizeof(uint32_t)));
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  a[0] = 0xa5a5a5a5;
+  b[0] = 0xa5a5a5a5;
+  b[1] = 0xa5a5a5a5;
+  arena_release(&arena_, mark);
+
+  EXPECT_EQ(a[0], 0xa5a5a5a5);
+  EXPECT_EQ(buf_[1], hardened_memshred_random_word());
+  EXPECT_EQ(buf_[2], hardened_memshred_random_word());
+  EXPECT_EQ(buf_[3], 0);
+}
+
+}  // namespace
+}  // namespace arena_unittest
@@ -26,6 +26,14 @@ extern uint32_t bitfield_bit32_copy(uint32_t dest,
                                     uint32_t src,
                                     bitfield_bit32_index_t src_bit);
 
+extern bitfield_update32_t bitfield_update32_field(bitfield_update32_t update,
+                                                   bitfield_field32_t field,
+                                                   uint32_t value);
+extern bitfield_update32_t bitfield_update32_bit(
+    bitfield_update32_t update, bitfield_bit32_index_t bit_index, bool value);
+extern uint32_t bitfield_update32_apply(uint32_t bitfield,
+                                        bitfield_update32_t update);
+
 extern int32_t bitfield_find_first_set32(int32_t bitfield);
 extern int32_t bitfield_count_leading_zeroes32(uint32_t bitfield);
 extern int32_t bitfield_count_trailing_zeroes32(uint32_t bitfield);
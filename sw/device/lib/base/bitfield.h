@@ -156,6 +156,78 @@ inline uint32_t bitfield_bit32_copy(uint32_t dest,
                               bitfield_bit32_read(src, src_bit));
 }
 
+/**
+ * A set of field writes to a 32-bit bitfield, to be applied all at once.
+ *
+ * `mask` has a one in every bit covered by one of the fields, and `value`
+ * holds the new contents of those bits. Building an update field by field and
+ * then applying it with `bitfield_update32_apply()` replaces a chain of
+ * `bitfield_field32_write()` calls with a single clear-and-set of the source
+ * bitfield. When the fields and values are compile-time constants, the whole
+ * update folds down to two constants.
+ *
+ * Updates start out empty:
+ *
+ *     bitfield_update32_t update = {0};
+ *     update = bitfield_update32_field(update, FOO_FIELD, foo);
+ *     update = bitfield_update32_bit(update, BAR_BIT, true);
+ *     reg = bitfield_update32_apply(reg, update);
+ */
+typedef struct bitfield_update32 {
+  /** The bits covered by the update. */
+  uint32_t mask;
+  /** The new values of the bits in `mask`. */
+  uint32_t value;
+} bitfield_update32_t;
+
+/**
+ * Adds a write of `value` to `field` to `update`.
+ *
+ * If `field` overlaps a field already in `update`, the later write wins, as it
+ * would with chained `bitfield_field32_write()` calls.
+ *
+ * @param update Update to add the field to.
+ * @param field Field to be set.
+ * @param value Value for the new field.
+ * @return `update` with `field` set to `value`.
+ */
+OT_WARN_UNUSED_RESULT
+inline bitfield_update32_t bitfield_update32_field(bitfield_update32_t update,
+                                                   bitfield_field32_t field,
+                                                   uint32_t value) {
+  update.mask |= field.mask << field.index;
+  update.value = bitfield_field32_write(update.value, field, value);
+  return update;
+}
+
+/**
+ * Adds a write of `value` to the `bit_index`th bit to `update`.
+ *
+ * @param update Update to add the bit to.
+ * @param bit_index Bit to be set.
+ * @param value Bit value to write.
+ * @return `update` with the `bit_index`th bit set to `value`.
+ */
+OT_WARN_UNUSED_RESULT
+inline bitfield_update32_t bitfield_update32_bit(
+    bitfield_update32_t update, bitfield_bit32_index_t bit_index, bool value) {
+  return bitfield_update32_field(update, bitfield_bit32_to_field32(bit_index),
+                                 value ? 0x1u : 0x0u);
+}
+
+/**
+ * Applies all the field writes in `update` to `bitfield`.
+ *
+ * @param bitfield Bitfield to update.
+ * @param update Field writes to apply.
+ * @return `bitfield` with the bits in `update.mask` replaced by `update.value`.
+ */
+OT_WARN_UNUSED_RESULT
+inline uint32_t bitfield_update32_apply(uint32_t bitfield,
+                                        bitfield_update32_t update) {
+  return (bitfield & ~update.mask) | update.value;
+}
+
 /**
  * Find First Set Bit
  *
@@ -0,0 +1,56 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/bitfield.h"
+
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+
+namespace bitfield_unittest {
+namespace {
+
+constexpr bitfield_field32_t kLowField = {.mask = 0xff, .index = 0};
+constexpr bitfield_field32_t kMidField = {.mask = 0x7, .index = 12};
+constexpr bitfield_bit32_index_t kHighBit = 31;
+
+TEST(BitfieldUpdate32, Empty) {
+  bitfield_update32_t update = {0};
+  EXPECT_EQ(bitfield_update32_apply(0x12345678, update), 0x12345678);
+}
+
+TEST(BitfieldUpdate32, MatchesChainedWrites) {
+  for (uint32_t reg : {0x00000000u, 0xffffffffu, 0xa5a5a5a5u, 0x12345678u}) {
+    uint32_t chained = reg;
+    chained = bitfield_field32_write(chained, kLowField, 0x1c3);
+    chained = bitfield_field32_write(chained, kMidField, 0x5);
+    chained = bitfield_bit32_write(chained, kHighBit, false);
+
+    bitfield_update32_t update = {0};
+    update = bitfield_update32_field(update, kLowField, 0x1c3);
+    update = bitfield_update32_field(update, kMidField, 0x5);
+    update = bitfield_update32_bit(update, kHighBit, false);
+
+    EXPECT_EQ(bitfield_update32_apply(reg, update), chained);
+  }
+}
+
+TEST(BitfieldUpdate32, Mask) {
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_field(update, kMidField, 0);
+  update = bitfield_update32_bit(update, kHighBit, true);
+  EXPECT_EQ(update.mask, 0x80007000u);
+  EXPECT_EQ(update.value, 0x80000000u);
+}
+
+TEST(BitfieldUpdate32, LaterWriteWins) {
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_field(update, kMidField, 0x7);
+  update = bitfield_update32_bit(update, 13, false);
+  EXPECT_EQ(bitfield_update32_apply(0, update), 0x5000u);
+  EXPECT_EQ(bitfield_update32_apply(0xffffffff, update), 0xffffdfffu);
+}
+
+}  // namespace
+}  // namespace bitfield_unittest
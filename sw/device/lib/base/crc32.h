@@ -14,6 +14,17 @@
 extern "C" {
 #endif  // __cplusplus
 
+/**
+ * The implementation is chosen at build time by `OT_CRC32_TABLE`, which is set
+ * with the `//sw/device/lib/base:crc32_impl` build flag:
+ *
+ * - 0 (`default`): the `crc32.b`/`crc32.w` instructions on RV32, or a bitwise
+ *   loop elsewhere.
+ * - 1 (`table`): a 256-entry (1 KiB) lookup table, with one lookup per byte.
+ * - 4 (`slice_by_4`): four 256-entry (4 KiB) lookup tables, with four lookups
+ *   per word.
+ */
+
 /**
  * Initializes the context variable for a CRC32 computation.
  *
@@ -15,6 +15,16 @@
 
 OTTF_DEFINE_TEST_CONFIG();
 
+// The implementation that crc32.c was built with. Use the
+// `//sw/device/lib/base:crc32_impl` flag to measure the others.
+#if !defined(OT_CRC32_TABLE) || OT_CRC32_TABLE == 0
+static const char kCrc32Impl[] = "default";
+#elif OT_CRC32_TABLE == 1
+static const char kCrc32Impl[] = "table";
+#else
+static const char kCrc32Impl[] = "slice_by_4";
+#endif
+
 bool test_main(void) {
   uint8_t buf[4096];
   for (size_t i = 0; i < ARRAYSIZE(buf); ++i) {
@@ -30,7 +40,13 @@ bool test_main(void) {
 
     CHECK(num_cycles <= UINT32_MAX);
     const uint32_t num_cycles_u32 = (uint32_t)num_cycles;
-    LOG_INFO("CRC32 computed in %d cycles.", num_cycles_u32);
+    // Report cycles per byte to two decimal places, since `base_printf()`
+    // cannot print floating point values.
+    CHECK(num_cycles_u32 < UINT32_MAX / 100);
+    const uint32_t centi_cycles_per_byte = num_cycles_u32 * 100 / sizeof(buf);
+    LOG_INFO("CRC32 (%s) computed in %d cycles (%d.%02d cycles/byte).",
+             kCrc32Impl, num_cycles_u32, centi_cycles_per_byte / 100,
+             centi_cycles_per_byte % 100);
 
     const uint32_t kExpectedChecksum = 0xa2912082;
     if (checksum != kExpectedChecksum) {
@@ -4,12 +4,112 @@
 
 #include "sw/device/lib/base/hardened_memory.h"
 
+#include <stdbool.h>
+
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/random_order.h"
 
+#ifndef OT_HARDENED_MEMORY_STRENGTH
+#define OT_HARDENED_MEMORY_STRENGTH 1
+#endif
+
+#if OT_HARDENED_MEMORY_STRENGTH != 0 && OT_HARDENED_MEMORY_STRENGTH != 1
+#error "OT_HARDENED_MEMORY_STRENGTH must be 0 or 1"
+#endif
+
+enum {
+  /**
+   * The size of the `decoys` scratch arrays, in words.
+   */
+  kDecoyWords = 8,
+  kDecoyBytes = kDecoyWords * sizeof(uint32_t),
+};
+
+/**
+ * Selects between a real address and a decoy address, depending on whether
+ * `byte_idx` is in bounds.
+ *
+ * Pretty much everything needs to be laundered: we need to launder `byte_idx`
+ * for obvious reasons, and we need to launder the result of the select, so
+ * that the compiler cannot delete the resulting loads and stores. This is
+ * similar to having used `volatile uint32_t *`.
+ *
+ * @param base The start of the real buffer.
+ * @param byte_idx The offset into the real buffer, in bytes.
+ * @param byte_len The length of the real buffer, in bytes.
+ * @param decoy The address to use if `byte_idx` is out of bounds.
+ * @return The selected address.
+ */
+OT_ALWAYS_INLINE
+static uintptr_t select_addr(uintptr_t base, size_t byte_idx, size_t byte_len,
+                             uintptr_t decoy) {
+  return launderw(ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len),
+                           base + byte_idx, decoy));
+}
+
+/**
+ * Returns the next index of `order`, in bytes.
+ *
+ * The value obtained from `advance()` is laundered, to prevent implementation
+ * details from leaking across procedures, and the barrier prevents the
+ * compiler from reordering the loop; this ensures a happens-before among
+ * indices consistent with `order`.
+ *
+ * @param order The random order to advance.
+ * @return The next offset, in bytes.
+ */
+OT_ALWAYS_INLINE
+static size_t next_byte_idx(random_order_t *order) {
+  size_t byte_idx = launderw(random_order_advance(order)) * sizeof(uint32_t);
+  barrierw(byte_idx);
+  return byte_idx;
+}
+
 // NOTE: The three hardened_mem* functions have similar contents, but the parts
 // that are shared between them are commented only in `memcpy()`.
+//
+// The loops handle two indices per iteration, which halves the number of loop
+// branches and lets the second load issue before the first value is used,
+// followed by a single step for an odd-length tail.
+#if OT_HARDENED_MEMORY_STRENGTH == 0
+void hardened_memcpy(uint32_t *restrict dest, const uint32_t *restrict src,
+                     size_t word_len) {
+  uintptr_t src_addr = (uintptr_t)src;
+  uintptr_t dest_addr = (uintptr_t)dest;
+
+  // At this strength the words are copied in ascending order, with no decoys.
+  // Each word is read back after it is written and compared with the value
+  // that was loaded, which catches a skipped or corrupted store. The read-back
+  // address is laundered so that the compiler cannot forward the stored value.
+  size_t count = 0;
+  uint32_t diff = 0;
+  size_t byte_len = word_len * sizeof(uint32_t);
+  size_t byte_idx = 0;
+  for (; launderw(byte_idx) + 2 * sizeof(uint32_t) <= byte_len;
+       byte_idx = launderw(byte_idx) + 2 * sizeof(uint32_t)) {
+    uintptr_t srcp = src_addr + byte_idx;
+    uintptr_t destp = dest_addr + byte_idx;
+    uint32_t a0 = read_32((void *)launderw(srcp));
+    uint32_t a1 = read_32((void *)launderw(srcp + sizeof(uint32_t)));
+    write_32(a0, (void *)launderw(destp));
+    write_32(a1, (void *)launderw(destp + sizeof(uint32_t)));
+    diff = launder32(diff) | (read_32((void *)launderw(destp)) ^ a0) |
+           (read_32((void *)launderw(destp + sizeof(uint32_t))) ^ a1);
+    count = launderw(count) + 2;
+  }
+  if (launderw(byte_idx) < byte_len) {
+    uintptr_t destp = dest_addr + byte_idx;
+    uint32_t a0 = read_32((void *)launderw(src_addr + byte_idx));
+    write_32(a0, (void *)launderw(destp));
+    diff = launder32(diff) | (read_32((void *)launderw(destp)) ^ a0);
+    count = launderw(count) + 1;
+  }
+
+  HARDENED_CHECK_EQ(count, word_len);
+  HARDENED_CHECK_EQ(diff, 0);
+}
+#else
 void hardened_memcpy(uint32_t *restrict dest, const uint32_t *restrict src,
                      size_t word_len) {
   random_order_t order;
@@ -31,52 +131,54 @@ void hardened_memcpy(uint32_t *restrict dest, const uint32_t *restrict src,
   // These extra operations also introduce noise that an attacker must do work
   // to filter, such as by applying side-channel analysis to obtain an address
   // trace.
-  uint32_t decoys[8];
+  uint32_t decoys[kDecoyWords];
   uintptr_t decoy_addr = (uintptr_t)&decoys;
 
   // We need to launder `count`, so that the SW.LOOP-COMPLETION check is not
   // deleted by the compiler.
   size_t byte_len = word_len * sizeof(uint32_t);
-  for (; launderw(count) < expected_count; count = launderw(count) + 1) {
-    // The order values themselves are in units of words, but we need `byte_idx`
-    // to be in units of bytes.
-    //
-    // The value obtained from `advance()` is laundered, to prevent
-    // implementation details from leaking across procedures.
-    size_t byte_idx = launderw(random_order_advance(&order)) * sizeof(uint32_t);
-
-    // Prevent the compiler from reordering the loop; this ensures a
-    // happens-before among indices consistent with `order`.
-    barrierw(byte_idx);
-
-    // Compute putative offsets into `src`, `dest`, and `decoys`. Some of these
-    // may go off the end of `src` and `dest`, but they will not be cast to
-    // pointers in that case. (Note that casting out-of-range addresses to
-    // pointers is UB.)
-    uintptr_t srcp = src_addr + byte_idx;
-    uintptr_t destp = dest_addr + byte_idx;
-    uintptr_t decoy1 = decoy_addr + (byte_idx % sizeof(decoys));
-    uintptr_t decoy2 =
-        decoy_addr + ((byte_idx + sizeof(decoys) / 2) % sizeof(decoys));
-
-    // Branchlessly select whether to do a "real" copy or a decoy copy,
-    // depending on whether we've gone off the end of the array or not.
-    //
-    // Pretty much everything needs to be laundered: we need to launder
-    // `byte_idx` for obvious reasons, and we need to launder the result of the
-    // select, so that the compiler cannot delete the resulting loads and
-    // stores. This is similar to having used `volatile uint32_t *`.
-    void *src = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), srcp, decoy1));
-    void *dest = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), destp, decoy2));
-
-    // Perform the copy, without performing a typed dereference operation.
-    write_32(read_32(src), dest);
+  for (; launderw(count) + 1 < expected_count; count = launderw(count) + 2) {
+    // The order values themselves are in units of words, but we need the
+    // indices to be in units of bytes.
+    size_t idx0 = next_byte_idx(&order);
+    size_t idx1 = next_byte_idx(&order);
+
+    // Compute the offsets into `src`, `dest`, and `decoys`, branchlessly
+    // selecting a decoy copy if we've gone off the end of the array. Some of
+    // the real offsets may go off the end of `src` and `dest`, but they will
+    // not be cast to pointers in that case. (Note that casting out-of-range
+    // addresses to pointers is UB.)
+    void *src0 = (void *)select_addr(src_addr, idx0, byte_len,
+                                     decoy_addr + (idx0 % kDecoyBytes));
+    void *src1 = (void *)select_addr(src_addr, idx1, byte_len,
+                                     decoy_addr + (idx1 % kDecoyBytes));
+    void *dest0 = (void *)select_addr(
+        dest_addr, idx0, byte_len,
+        decoy_addr + ((idx0 + kDecoyBytes / 2) % kDecoyBytes));
+    void *dest1 = (void *)select_addr(
+        dest_addr, idx1, byte_len,
+        decoy_addr + ((idx1 + kDecoyBytes / 2) % kDecoyBytes));
+
+    // Perform the copies, without performing a typed dereference operation.
+    uint32_t a0 = read_32(src0);
+    uint32_t a1 = read_32(src1);
+    write_32(a0, dest0);
+    write_32(a1, dest1);
+  }
+  if (launderw(count) < expected_count) {
+    size_t idx0 = next_byte_idx(&order);
+    void *src0 = (void *)select_addr(src_addr, idx0, byte_len,
+                                     decoy_addr + (idx0 % kDecoyBytes));
+    void *dest0 = (void *)select_addr(
+        dest_addr, idx0, byte_len,
+        decoy_addr + ((idx0 + kDecoyBytes / 2) % kDecoyBytes));
+    write_32(read_32(src0), dest0);
+    count = launderw(count) + 1;
   }
 
   HARDENED_CHECK_EQ(count, expected_count);
 }
+#endif
 
 // The source of randomness for shred, which may be replaced at link-time.
 OT_WEAK
@@ -91,22 +193,30 @@ void hardened_memshred(uint32_t *dest, size_t word_len) {
 
   uintptr_t data_addr = (uintptr_t)dest;
 
-  uint32_t decoys[8];
+  uint32_t decoys[kDecoyWords];
   uintptr_t decoy_addr = (uintptr_t)&decoys;
 
+  // Shredding is only done to secrets, so this always uses a random order.
   size_t byte_len = word_len * sizeof(uint32_t);
-  for (; count < expected_count; count = launderw(count) + 1) {
-    size_t byte_idx = launderw(random_order_advance(&order)) * sizeof(uint32_t);
-    barrierw(byte_idx);
-
-    uintptr_t datap = data_addr + byte_idx;
-    uintptr_t decoy = decoy_addr + (byte_idx % sizeof(decoys));
-
-    void *data = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), datap, decoy));
-
-    // Write a freshly-generated random word to `*data`.
-    write_32(hardened_memshred_random_word(), data);
+  for (; launderw(count) + 1 < expected_count; count = launderw(count) + 2) {
+    size_t idx0 = next_byte_idx(&order);
+    size_t idx1 = next_byte_idx(&order);
+
+    void *data0 = (void *)select_addr(data_addr, idx0, byte_len,
+                                      decoy_addr + (idx0 % kDecoyBytes));
+    void *data1 = (void *)select_addr(data_addr, idx1, byte_len,
+                                      decoy_addr + (idx1 % kDecoyBytes));
+
+    // Write freshly-generated random words.
+    write_32(hardened_memshred_random_word(), data0);
+    write_32(hardened_memshred_random_word(), data1);
+  }
+  if (launderw(count) < expected_count) {
+    size_t idx0 = next_byte_idx(&order);
+    void *data0 = (void *)select_addr(data_addr, idx0, byte_len,
+                                      decoy_addr + (idx0 % kDecoyBytes));
+    write_32(hardened_memshred_random_word(), data0);
+    count = launderw(count) + 1;
   }
 
   HARDENED_CHECK_EQ(count, expected_count);
@@ -114,59 +224,104 @@ void hardened_memshred(uint32_t *dest, size_t word_len) {
 
 hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
                                size_t word_len) {
+  uintptr_t lhs_addr = (uintptr_t)lhs;
+  uintptr_t rhs_addr = (uintptr_t)rhs;
+
+  uint32_t zeros = 0;
+  uint32_t ones = UINT32_MAX;
+
+  // We launder `zeroes` so that compiler cannot learn that `zeroes` has
+  // strictly more bits set at the end of the loop, and launder one of the
+  // operands so that the compiler cannot cache the result of the xor for use
+  // in the next operation. The compiler can cache the value of `a`, but it has
+  // no chance to strength-reduce the operations on `ones`.
+#define HARDENED_MEMEQ_ACCUMULATE_(a_, b_)             \
+  do {                                                 \
+    zeros = launder32(zeros) | (launder32(a_) ^ (b_)); \
+    ones = launder32(ones) & (launder32(a_) ^ ~(b_));  \
+  } while (false)
+
+#if OT_HARDENED_MEMORY_STRENGTH == 0
+  size_t count = 0;
+  size_t expected_count = word_len;
+
+  // At this strength the words are compared in ascending order, with no
+  // decoys. The comparison is still constant-time.
+  size_t byte_len = word_len * sizeof(uint32_t);
+  size_t byte_idx = 0;
+  for (; launderw(byte_idx) + 2 * sizeof(uint32_t) <= byte_len;
+       byte_idx = launderw(byte_idx) + 2 * sizeof(uint32_t)) {
+    uintptr_t ap = lhs_addr + byte_idx;
+    uintptr_t bp = rhs_addr + byte_idx;
+    uint32_t a0 = read_32((void *)launderw(ap));
+    uint32_t a1 = read_32((void *)launderw(ap + sizeof(uint32_t)));
+    uint32_t b0 = read_32((void *)launderw(bp));
+    uint32_t b1 = read_32((void *)launderw(bp + sizeof(uint32_t)));
+    HARDENED_MEMEQ_ACCUMULATE_(a0, b0);
+    HARDENED_MEMEQ_ACCUMULATE_(a1, b1);
+    count = launderw(count) + 2;
+  }
+  if (launderw(byte_idx) < byte_len) {
+    uint32_t a0 = read_32((void *)launderw(lhs_addr + byte_idx));
+    uint32_t b0 = read_32((void *)launderw(rhs_addr + byte_idx));
+    HARDENED_MEMEQ_ACCUMULATE_(a0, b0);
+    count = launderw(count) + 1;
+  }
+#else
   random_order_t order;
   random_order_init(&order, word_len);
 
   size_t count = 0;
   size_t expected_count = random_order_len(&order);
 
-  uintptr_t lhs_addr = (uintptr_t)lhs;
-  uintptr_t rhs_addr = (uintptr_t)rhs;
-
   // `decoys` needs to be filled with equal values this time around. It
   // should be filled with values with a Hamming weight of around 16, which is
   // the most common hamming weight among 32-bit words.
-  uint32_t decoys[8] = {
+  uint32_t decoys[kDecoyWords] = {
       0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa,
       0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa,
   };
   uintptr_t decoy_addr = (uintptr_t)&decoys;
 
-  uint32_t zeros = 0;
-  uint32_t ones = UINT32_MAX;
-
-  // The loop is almost token-for-token the one above, but the copy is
+  // The loop is almost token-for-token the one in `memcpy()`, but the copy is
   // replaced with something else.
   size_t byte_len = word_len * sizeof(uint32_t);
-  for (; count < expected_count; count = launderw(count) + 1) {
-    size_t byte_idx = launderw(random_order_advance(&order)) * sizeof(uint32_t);
-    barrierw(byte_idx);
-
-    uintptr_t ap = lhs_addr + byte_idx;
-    uintptr_t bp = rhs_addr + byte_idx;
-    uintptr_t decoy1 = decoy_addr + (byte_idx % sizeof(decoys));
-    uintptr_t decoy2 =
-        decoy_addr + ((byte_idx + sizeof(decoys) / 2) % sizeof(decoys));
-
-    void *av = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), ap, decoy1));
-    void *bv = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), bp, decoy2));
-
-    uint32_t a = read_32(av);
-    uint32_t b = read_32(bv);
-
-    // Launder one of the operands, so that the compiler cannot cache the result
-    // of the xor for use in the next operation.
-    //
-    // We launder `zeroes` so that compiler cannot learn that `zeroes` has
-    // strictly more bits set at the end of the loop.
-    zeros = launder32(zeros) | (launder32(a) ^ b);
-
-    // Same as above. The compiler can cache the value of `a[offset]`, but it
-    // has no chance to strength-reduce this operation.
-    ones = launder32(ones) & (launder32(a) ^ ~b);
+  for (; launderw(count) + 1 < expected_count; count = launderw(count) + 2) {
+    size_t idx0 = next_byte_idx(&order);
+    size_t idx1 = next_byte_idx(&order);
+
+    void *a0p = (void *)select_addr(lhs_addr, idx0, byte_len,
+                                    decoy_addr + (idx0 % kDecoyBytes));
+    void *a1p = (void *)select_addr(lhs_addr, idx1, byte_len,
+                                    decoy_addr + (idx1 % kDecoyBytes));
+    void *b0p = (void *)select_addr(
+        rhs_addr, idx0, byte_len,
+        decoy_addr + ((idx0 + kDecoyBytes / 2) % kDecoyBytes));
+    void *b1p = (void *)select_addr(
+        rhs_addr, idx1, byte_len,
+        decoy_addr + ((idx1 + kDecoyBytes / 2) % kDecoyBytes));
+
+    uint32_t a0 = read_32(a0p);
+    uint32_t a1 = read_32(a1p);
+    uint32_t b0 = read_32(b0p);
+    uint32_t b1 = read_32(b1p);
+    HARDENED_MEMEQ_ACCUMULATE_(a0, b0);
+    HARDENED_MEMEQ_ACCUMULATE_(a1, b1);
+  }
+  if (launderw(count) < expected_count) {
+    size_t idx0 = next_byte_idx(&order);
+    void *a0p = (void *)select_addr(lhs_addr, idx0, byte_len,
+                                    decoy_addr + (idx0 % kDecoyBytes));
+    void *b0p = (void *)select_addr(
+        rhs_addr, idx0, byte_len,
+        decoy_addr + ((idx0 + kDecoyBytes / 2) % kDecoyBytes));
+    uint32_t a0 = read_32(a0p);
+    uint32_t b0 = read_32(b0p);
+    HARDENED_MEMEQ_ACCUMULATE_(a0, b0);
+    count = launderw(count) + 1;
   }
+#endif
+#undef HARDENED_MEMEQ_ACCUMULATE_
 
   HARDENED_CHECK_EQ(count, expected_count);
   if (launder32(zeros) == 0) {
@@ -8,6 +8,17 @@
 /**
  * @file
  * @brief Hardened memory operations for constant power buffer manipulation.
+ *
+ * The strength of `hardened_memcpy()` and `hardened_memeq()` is chosen when
+ * `hardened_memory.c` is compiled, with `OT_HARDENED_MEMORY_STRENGTH`:
+ * - 1 (the default) walks the buffers in a random order, with decoy accesses,
+ *   to mitigate power-analysis attacks.
+ * - 0 walks the buffers in ascending order without decoys. Copies are still
+ *   read back and every loop still checks that it ran to completion, so this
+ *   still detects glitches, but it should only be used in builds where these
+ *   functions never handle secrets.
+ *
+ * `hardened_memshred()` always uses a random order.
  */
 
 #include <stddef.h>
@@ -59,6 +70,16 @@ void hardened_memcpy(uint32_t *OT_RESTRICT dest,
  */
 void hardened_memshred(uint32_t *dest, size_t word_len);
 
+/**
+ * Returns a random word for `hardened_memshred()` to write.
+ *
+ * The default implementation returns a constant. It is a weak symbol, so that
+ * a driver for a hardware entropy source can replace it at link time.
+ *
+ * @return A random word.
+ */
+uint32_t hardened_memshred_random_word(void);
+
 /**
  * Compare two potentially-overlapping 32-bit aligned regions of memory for
  * equality.
@@ -29,11 +29,29 @@ TEST(HardenedMemory, Memcpy) {
   EXPECT_THAT(ys, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
 }
 
+TEST(HardenedMemory, MemcpyLengths) {
+  // Cover both odd and even lengths, since the loops handle two words at a
+  // time.
+  for (size_t len = 0; len <= 9; ++len) {
+    std::vector<uint32_t> xs(len + 1);
+    for (size_t i = 0; i < xs.size(); ++i) {
+      xs[i] = 0x1000 + i;
+    }
+    std::vector<uint32_t> ys(len + 1, 0);
+
+    hardened_memcpy(ys.data(), xs.data(), len);
+    for (size_t i = 0; i < len; ++i) {
+      EXPECT_EQ(ys[i], xs[i]) << "len = " << len << ", i = " << i;
+    }
+    EXPECT_EQ(ys[len], 0) << "len = " << len;
+  }
+}
+
 constexpr uint32_t kRandomWord = 0xdeadbeef;
 
 // Override whatever the default randomness source is so we can verify it
 // actually gets used.
-extern "C" size_t hardened_memshred_random_word() { return kRandomWord; }
+extern "C" uint32_t hardened_memshred_random_word() { return kRandomWord; }
 
 TEST(HardenedMemory, MemShred) {
   std::vector<uint32_t> xs = {1, 2, 3, 4, 5, 6, 7, 8};
@@ -53,5 +71,22 @@ TEST(HardenedMemory, MemEq) {
             kHardenedBoolFalse);
 }
 
+TEST(HardenedMemory, MemEqEachWord) {
+  for (size_t len = 1; len <= 9; ++len) {
+    std::vector<uint32_t> xs(len);
+    for (size_t i = 0; i < len; ++i) {
+      xs[i] = 0x1000 + i;
+    }
+    EXPECT_EQ(hardened_memeq(xs.data(), xs.data(), len), kHardenedBoolTrue);
+
+    for (size_t i = 0; i < len; ++i) {
+      std::vector<uint32_t> ys = xs;
+      ys[i] ^= 1;
+      EXPECT_EQ(hardened_memeq(ys.data(), xs.data(), len), kHardenedBoolFalse)
+          << "len = " << len << ", i = " << i;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace hardened_memory_unittest
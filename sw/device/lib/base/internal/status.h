@@ -53,6 +53,25 @@ extern "C" {
   ((bitfield_field32_t){.mask = 0x7fff, .index = 16})
 #define STATUS_BIT_ERROR 31
 
+/*
+ * Lean error statuses (see `OT_STATUS_LEAN` in status.h) use the third
+ * module-id character field as a marker, with a value that no filename or
+ * module ID produces. The rest of the status holds the index of the status'
+ * creation site in the `.ot.status_site` section.
+ *
+ *     31      26                            7  5     0
+ *  +---+-------+----------------------------+--+-------+
+ *  |   | 5 bit |          19 bit            |  | 5 bit |
+ *  | 1 | 0x1b  |        Site Index          |00| code  |
+ *  +---+-------+----------------------------+--+-------+
+ */
+#define STATUS_LEAN_MARKER 0x1b
+#define STATUS_FIELD_LEAN_MARKER \
+  ((bitfield_field32_t){.mask = 0x1f, .index = 26})
+#define STATUS_FIELD_LEAN_SITE \
+  ((bitfield_field32_t){.mask = 0x7ffff, .index = 7})
+#define STATUS_LEAN_BASE (0x80000000u | (STATUS_LEAN_MARKER << 26))
+
 // clang-format off
 #define ASCII_5BIT(v) ( \
     /*uppercase characters*/  (v) >= '@' && (v) <= '_' ? OT_UNSIGNED((v) - '@') \
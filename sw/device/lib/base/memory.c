@@ -5,6 +5,7 @@
 #include "sw/device/lib/base/memory.h"
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/macros.h"
@@ -58,6 +59,77 @@ static uint32_t repeat_byte_to_u32(uint8_t byte) {
   return word << 24 | word << 16 | word << 8 | word;
 }
 
+enum {
+  /**
+   * The number of words that each iteration of an unrolled word loop handles.
+   * Ibex spends two of the four instructions in a simple copy loop on the
+   * loop itself, so unrolling four times removes most of that overhead.
+   */
+  kUnrollWords = 4,
+  /**
+   * The shortest copy between mutually misaligned buffers that uses
+   * `memcpy_misaligned()`. Shorter copies are done byte by byte.
+   */
+  kMisalignedCopyMinLen = 16,
+};
+
+/**
+ * Returns true if any of the four bytes of `word` is zero.
+ *
+ * Subtracting one from each byte only sets the top bit of bytes that were zero
+ * or that borrowed from a zero byte below them. Masking with `~word` drops
+ * bytes whose top bit was already set, so the result is nonzero exactly when
+ * there is a zero byte.
+ */
+static bool word_has_zero_byte(uint32_t word) {
+  return ((word - 0x01010101) & ~word & 0x80808080) != 0;
+}
+
+/**
+ * Copy the start of `src8` to `dest8`, where the two buffers have different
+ * alignments.
+ *
+ * After copying bytes until `dest8` is aligned, this reads aligned words from
+ * `src8` and merges each with the bytes left over from the previous one, so
+ * every load and store is a single aligned word access. It never reads outside
+ * `src8[0:len]`.
+ *
+ * @param dest8 The destination buffer.
+ * @param src8 The source buffer, whose alignment must differ from `dest8`.
+ * @param len The length of both buffers. Must be at least
+ * `kMisalignedCopyMinLen`.
+ * @return The number of bytes that were copied. The caller must copy the rest.
+ */
+static size_t memcpy_misaligned(unsigned char *restrict dest8,
+                                const unsigned char *restrict src8,
+                                size_t len) {
+  size_t i = 0;
+  for (; misalignment32_of((uintptr_t)&dest8[i]) != 0; ++i) {
+    dest8[i] = src8[i];
+  }
+
+  // `&src8[i]` is misaligned, so there are between one and three bytes before
+  // the next aligned word of the source. Collect them into `carry`.
+  const size_t carry_bytes =
+      sizeof(uint32_t) - OT_UNSIGNED(misalignment32_of((uintptr_t)&src8[i]));
+  const uint32_t carry_shift = 8 * carry_bytes;
+  uint32_t carry = 0;
+  for (size_t j = 0; j < carry_bytes; ++j) {
+    carry |= (uint32_t)src8[i + j] << (8 * j);
+  }
+
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "memcpy assumes that the system is little endian.");
+  const unsigned char *src_word = &src8[i + carry_bytes];
+  for (; i + carry_bytes + sizeof(uint32_t) <= len;
+       i += sizeof(uint32_t), src_word += sizeof(uint32_t)) {
+    const uint32_t word = read_32(src_word);
+    write_32(carry | word << carry_shift, &dest8[i]);
+    carry = word >> (32 - carry_shift);
+  }
+  return i;
+}
+
 void *OT_PREFIX_IF_NOT_RV32(memcpy)(void *restrict dest,
                                     const void *restrict src, size_t len) {
   if (dest == NULL || src == NULL) {
@@ -65,15 +137,31 @@ void *OT_PREFIX_IF_NOT_RV32(memcpy)(void *restrict dest,
   }
   unsigned char *dest8 = (unsigned char *)dest;
   const unsigned char *src8 = (const unsigned char *)src;
-  size_t body_offset, tail_offset;
-  compute_alignment(dest, src, len, &body_offset, &tail_offset);
   size_t i = 0;
-  for (; i < body_offset; ++i) {
-    dest8[i] = src8[i];
-  }
-  for (; i < tail_offset; i += sizeof(uint32_t)) {
-    uint32_t word = read_32(&src8[i]);
-    write_32(word, &dest8[i]);
+  if (len >= kMisalignedCopyMinLen &&
+      misalignment32_of((uintptr_t)dest) != misalignment32_of((uintptr_t)src)) {
+    i = memcpy_misaligned(dest8, src8, len);
+  } else {
+    size_t body_offset, tail_offset;
+    compute_alignment(dest, src, len, &body_offset, &tail_offset);
+    for (; i < body_offset; ++i) {
+      dest8[i] = src8[i];
+    }
+    for (; i + kUnrollWords * sizeof(uint32_t) <= tail_offset;
+         i += kUnrollWords * sizeof(uint32_t)) {
+      const uint32_t word0 = read_32(&src8[i]);
+      const uint32_t word1 = read_32(&src8[i + 4]);
+      const uint32_t word2 = read_32(&src8[i + 8]);
+      const uint32_t word3 = read_32(&src8[i + 12]);
+      write_32(word0, &dest8[i]);
+      write_32(word1, &dest8[i + 4]);
+      write_32(word2, &dest8[i + 8]);
+      write_32(word3, &dest8[i + 12]);
+    }
+    for (; i < tail_offset; i += sizeof(uint32_t)) {
+      uint32_t word = read_32(&src8[i]);
+      write_32(word, &dest8[i]);
+    }
   }
   for (; i < len; ++i) {
     dest8[i] = src8[i];
@@ -92,6 +180,13 @@ void *OT_PREFIX_IF_NOT_RV32(memset)(void *dest, int value, size_t len) {
     dest8[i] = value8;
   }
   const uint32_t value32 = repeat_byte_to_u32(value8);
+  for (; i + kUnrollWords * sizeof(uint32_t) <= tail_offset;
+       i += kUnrollWords * sizeof(uint32_t)) {
+    write_32(value32, &dest8[i]);
+    write_32(value32, &dest8[i + 4]);
+    write_32(value32, &dest8[i + 8]);
+    write_32(value32, &dest8[i + 12]);
+  }
   for (; i < tail_offset; i += sizeof(uint32_t)) {
     write_32(value32, &dest8[i]);
   }
@@ -126,15 +221,18 @@ int OT_PREFIX_IF_NOT_RV32(memcmp)(const void *lhs, const void *rhs,
     assert(&lhs8[i] != NULL);
     assert(&rhs8[i] != NULL);
 #endif
-    uint32_t word_left = __builtin_bswap32(read_32(&lhs8[i]));
-    uint32_t word_right = __builtin_bswap32(read_32(&rhs8[i]));
+    uint32_t word_left = read_32(&lhs8[i]);
+    uint32_t word_right = read_32(&rhs8[i]);
+    if (word_left == word_right) {
+      continue;
+    }
+    // Only byte-swap the first pair of words that differ, so that comparing
+    // them as integers compares their bytes in memory order.
     static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
                   "memcmp assumes that the system is little endian.");
-    if (word_left < word_right) {
-      return kMemCmpLt;
-    } else if (word_left > word_right) {
-      return kMemCmpGt;
-    }
+    return __builtin_bswap32(word_left) < __builtin_bswap32(word_right)
+               ? kMemCmpLt
+               : kMemCmpGt;
   }
   for (; i < len; ++i) {
     if (lhs8[i] < rhs8[i]) {
@@ -201,21 +299,10 @@ void *OT_PREFIX_IF_NOT_RV32(memchr)(const void *ptr, int value, size_t len) {
   }
   const uint32_t value32 = repeat_byte_to_u32(value8);
   for (; i < tail_offset; i += sizeof(uint32_t)) {
-    uint32_t word = read_32(&ptr8[i]);
-    uint32_t bits_eq = ~(word ^ value32);
-    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
-                  "memchr assumes that the system is little endian.");
-    if ((bits_eq & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i];
-    }
-    if (((bits_eq >> 8) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 1];
-    }
-    if (((bits_eq >> 16) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 2];
-    }
-    if (((bits_eq >> 24) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 3];
+    // A byte of `word ^ value32` is zero where `word` has a matching byte. If
+    // there is one, stop here and let the byte loop below find it.
+    if (word_has_zero_byte(read_32(&ptr8[i]) ^ value32)) {
+      break;
     }
   }
   for (; i < len; ++i) {
@@ -242,22 +329,10 @@ void *OT_PREFIX_IF_NOT_RV32(memrchr)(const void *ptr, int value, size_t len) {
   }
   const uint32_t value32 = repeat_byte_to_u32(value8);
   for (; end > body_offset; end -= sizeof(uint32_t)) {
-    const size_t i = end - sizeof(uint32_t);
-    uint32_t word = read_32(&ptr8[i]);
-    uint32_t bits_eq = ~(word ^ value32);
-    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
-                  "memrchr assumes that the system is little endian.");
-    if (((bits_eq >> 24) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 3];
-    }
-    if (((bits_eq >> 16) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 2];
-    }
-    if (((bits_eq >> 8) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 1];
-    }
-    if ((bits_eq & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i];
+    // As in memchr, stop at a word with a matching byte and let the byte loop
+    // below find which one it is.
+    if (word_has_zero_byte(read_32(&ptr8[end - sizeof(uint32_t)]) ^ value32)) {
+      break;
     }
   }
   for (; end > 0; --end) {
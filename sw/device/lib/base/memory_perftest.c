@@ -97,6 +97,12 @@ OT_NOINLINE void test_memcpy(uint8_t *buf1, uint8_t *buf2, size_t len) {
   memcpy(buf1, buf2, len);
 }
 
+// Copy between buffers that are misaligned relative to each other.
+OT_NOINLINE void test_memcpy_misaligned(uint8_t *buf1, uint8_t *buf2,
+                                        size_t len) {
+  memcpy(buf1 + 1, buf2 + 2, len - 2);
+}
+
 OT_NOINLINE void test_memset(uint8_t *buf1, uint8_t *buf2, size_t len) {
   const int value = buf2[0];
   memset(buf1, value, len);
@@ -157,6 +163,15 @@ static const perf_test_t kPerfTests[] = {
         .func = &test_memcpy,
         .expected_max_num_cycles = 33270,
     },
+    {
+        .label = "memcpy_misaligned",
+        .setup_buf1 = &fill_buf_deterministic_values,
+        .setup_buf2 = &fill_buf_deterministic_values,
+        .func = &test_memcpy_misaligned,
+        // Estimated from the cycle counts of the aligned memcpy test and the
+        // extra shift-and-merge instructions. Tighten after measuring.
+        .expected_max_num_cycles = 40000,
+    },
     {
         .label = "memset",
         .setup_buf1 = &fill_buf_zeroes,
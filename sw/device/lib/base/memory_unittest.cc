@@ -193,6 +193,39 @@ TEST_P(MemCpyTest, VaryDestAlignment) {
   }
 }
 
+TEST_P(MemCpyTest, VaryByteAlignment) {
+  auto memcpy_func = GetParam();
+
+  static constexpr size_t kMaxLen = 48;
+  std::vector<uint8_t> src(kMaxLen + sizeof(uint32_t));
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>(i * 7 + 1);
+  }
+
+  // Copy between every pair of byte offsets within a word, at every length up
+  // to `kMaxLen`. This covers both co-aligned and mutually misaligned copies,
+  // and checks that no bytes outside the destination range are written.
+  for (size_t dest_off = 0; dest_off < sizeof(uint32_t); ++dest_off) {
+    for (size_t src_off = 0; src_off < sizeof(uint32_t); ++src_off) {
+      for (size_t len = 0; len <= kMaxLen; ++len) {
+        SCOPED_TRACE(testing::Message() << "dest_off=" << dest_off
+                                        << " src_off=" << src_off
+                                        << " len=" << len);
+
+        std::vector<uint32_t> dest_words(kMaxLen / sizeof(uint32_t) + 2, 0);
+        uint8_t *dest = reinterpret_cast<uint8_t *>(dest_words.data());
+        memcpy_func(dest + dest_off, src.data() + src_off, len);
+
+        for (size_t i = 0; i < dest_words.size() * sizeof(uint32_t); ++i) {
+          const bool copied = i >= dest_off && i < dest_off + len;
+          const uint8_t expected = copied ? src[i - dest_off + src_off] : 0;
+          ASSERT_EQ(dest[i], expected) << "i=" << i;
+        }
+      }
+    }
+  }
+}
+
 TEST_P(MemCmpTest, NullParam) {
   auto memcmp_func = GetParam();
 
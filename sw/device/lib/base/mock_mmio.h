@@ -6,6 +6,7 @@
 #define OPENTITAN_SW_DEVICE_LIB_BASE_MOCK_MMIO_H_
 
 #include <initializer_list>
+#include <map>
 #include <memory>
 #include <random>
 #include <stdint.h>
@@ -100,6 +101,95 @@ class MmioTest {
       std::make_unique<testing::StrictMock<MockDevice>>();
   testing::InSequence seq_;
 };
+
+/**
+ * A behavioural model of the registers of a device.
+ *
+ * By default, a model behaves like plain memory: reads return the last value
+ * written to the same offset, or zero. Models of specific peripherals derive
+ * from this class and override `Read32()` and `Write32()` to add side effects,
+ * such as FIFOs, write-one-to-clear bits or status bits that are set once an
+ * operation completes.
+ *
+ * 8-bit accesses are forwarded to the 32-bit accessors of the enclosing word.
+ */
+class RegisterModel {
+ public:
+  virtual ~RegisterModel() = default;
+
+  virtual uint32_t Read32(ptrdiff_t offset) { return Get(offset); }
+  virtual void Write32(ptrdiff_t offset, uint32_t value) { Set(offset, value); }
+
+  uint8_t Read8(ptrdiff_t offset) {
+    return static_cast<uint8_t>(Read32(WordOffset(offset)) >>
+                                ByteShift(offset));
+  }
+
+  void Write8(ptrdiff_t offset, uint8_t value) {
+    ptrdiff_t word = WordOffset(offset);
+    uint32_t shift = ByteShift(offset);
+    uint32_t word_value = Get(word) & ~(0xffu << shift);
+    Write32(word, word_value | static_cast<uint32_t>(value) << shift);
+  }
+
+  /**
+   * Returns the stored value of a register, without side effects.
+   */
+  uint32_t Get(ptrdiff_t offset) const {
+    auto it = regs_.find(offset);
+    return it == regs_.end() ? 0 : it->second;
+  }
+
+  /**
+   * Sets the stored value of a register, without side effects.
+   */
+  void Set(ptrdiff_t offset, uint32_t value) { regs_[offset] = value; }
+
+ private:
+  static ptrdiff_t WordOffset(ptrdiff_t offset) {
+    return offset & ~static_cast<ptrdiff_t>(sizeof(uint32_t) - 1);
+  }
+  static uint32_t ByteShift(ptrdiff_t offset) {
+    return static_cast<uint32_t>(offset & (sizeof(uint32_t) - 1)) * 8;
+  }
+
+  std::map<ptrdiff_t, uint32_t> regs_;
+};
+
+/**
+ * Convenience fixture for tests that run code against `RegisterModel`s instead
+ * of scripted `EXPECT_READN` and `EXPECT_WRITEN` sequences.
+ *
+ * Each call to `Attach()` creates a device that forwards all of its accesses to
+ * the given model, so a test can wire up one model per peripheral used by the
+ * code under test. Further expectations can still be set on a device with
+ * `EXPECT_CALL`, but accesses without one are allowed.
+ */
+class FakeMmioTest {
+ protected:
+  /**
+   * Creates a device backed by `model` and returns its MMIO region.
+   *
+   * @param model Model of the device; must outlive the test.
+   * @return The MMIO region of the device.
+   */
+  mmio_region_t Attach(RegisterModel *model) {
+    devs_.push_back(std::make_unique<testing::NiceMock<MockDevice>>());
+    MockDevice &dev = *devs_.back();
+    ON_CALL(dev, Read8(testing::_))
+        .WillByDefault(testing::Invoke(model, &RegisterModel::Read8));
+    ON_CALL(dev, Read32(testing::_))
+        .WillByDefault(testing::Invoke(model, &RegisterModel::Read32));
+    ON_CALL(dev, Write8(testing::_, testing::_))
+        .WillByDefault(testing::Invoke(model, &RegisterModel::Write8));
+    ON_CALL(dev, Write32(testing::_, testing::_))
+        .WillByDefault(testing::Invoke(model, &RegisterModel::Write32));
+    return dev.region();
+  }
+
+ private:
+  std::vector<std::unique_ptr<MockDevice>> devs_;
+};
 }  // namespace mock_mmio
 
 /**
@@ -4,12 +4,16 @@
 
 #include "sw/device/lib/base/mock_mmio.h"
 
+#include <deque>
+
 #include "gtest/gtest.h"
 #include "sw/device/lib/base/mmio.h"
 
 namespace {
+using ::mock_mmio::FakeMmioTest;
 using ::mock_mmio::LeInt;
 using ::mock_mmio::MmioTest;
+using ::mock_mmio::RegisterModel;
 using ::testing::Test;
 
 /**
@@ -78,4 +82,104 @@ TEST_F(MockMmioTest, ExpectMask) {
   value &= ~(1 << 0x10);
   mmio_region_write32(dev().region(), 0x8, value);
 }
+
+/**
+ * Model of a device with a FIFO and an operation that completes after a few
+ * polls of its status register.
+ */
+class FifoModel : public RegisterModel {
+ public:
+  enum : ptrdiff_t {
+    kFifoOffset = 0x0,
+    kStatusOffset = 0x4,
+    kCmdOffset = 0x8,
+  };
+  enum : uint32_t {
+    kStatusDoneBit = 1u << 31,
+    kPollsUntilDone = 3,
+  };
+
+  uint32_t Read32(ptrdiff_t offset) override {
+    switch (offset) {
+      case kFifoOffset: {
+        uint32_t value = fifo_.front();
+        fifo_.pop_front();
+        return value;
+      }
+      case kStatusOffset:
+        if (polls_left_ > 0 && --polls_left_ == 0) {
+          Set(kStatusOffset, Get(kStatusOffset) | kStatusDoneBit);
+        }
+        return Get(kStatusOffset) | static_cast<uint32_t>(fifo_.size());
+      default:
+        return RegisterModel::Read32(offset);
+    }
+  }
+
+  void Write32(ptrdiff_t offset, uint32_t value) override {
+    switch (offset) {
+      case kFifoOffset:
+        fifo_.push_back(value);
+        break;
+      case kCmdOffset:
+        Set(kStatusOffset, 0);
+        polls_left_ = kPollsUntilDone;
+        break;
+      default:
+        RegisterModel::Write32(offset, value);
+    }
+  }
+
+ private:
+  std::deque<uint32_t> fifo_;
+  uint32_t polls_left_ = 0;
+};
+
+class FakeMmioTestTest : public Test, public FakeMmioTest {};
+
+TEST_F(FakeMmioTestTest, PlainRegisters) {
+  RegisterModel model;
+  mmio_region_t dev = Attach(&model);
+
+  EXPECT_EQ(mmio_region_read32(dev, 0x10), 0);
+  mmio_region_write32(dev, 0x10, 0xdeadbeef);
+  EXPECT_EQ(mmio_region_read32(dev, 0x10), 0xdeadbeef);
+  EXPECT_EQ(mmio_region_read8(dev, 0x13), 0xde);
+
+  mmio_region_write8(dev, 0x11, 0x00);
+  EXPECT_EQ(model.Get(0x10), 0xdead00ef);
+}
+
+TEST_F(FakeMmioTestTest, BehaviouralModel) {
+  FifoModel model;
+  mmio_region_t dev = Attach(&model);
+
+  mmio_region_write32(dev, FifoModel::kFifoOffset, 1);
+  mmio_region_write32(dev, FifoModel::kFifoOffset, 2);
+  mmio_region_write32(dev, FifoModel::kCmdOffset, 1);
+
+  uint32_t polls = 0;
+  uint32_t status;
+  do {
+    status = mmio_region_read32(dev, FifoModel::kStatusOffset);
+    ++polls;
+  } while ((status & FifoModel::kStatusDoneBit) == 0);
+  EXPECT_EQ(polls, FifoModel::kPollsUntilDone);
+  EXPECT_EQ(status & ~FifoModel::kStatusDoneBit, 2);
+
+  EXPECT_EQ(mmio_region_read32(dev, FifoModel::kFifoOffset), 1);
+  EXPECT_EQ(mmio_region_read32(dev, FifoModel::kFifoOffset), 2);
+}
+
+TEST_F(FakeMmioTestTest, SeveralDevices) {
+  RegisterModel model_a;
+  RegisterModel model_b;
+  mmio_region_t dev_a = Attach(&model_a);
+  mmio_region_t dev_b = Attach(&model_b);
+
+  mmio_region_write32(dev_a, 0x0, 0xa);
+  mmio_region_write32(dev_b, 0x0, 0xb);
+  EXPECT_EQ(mmio_region_read32(dev_a, 0x0), 0xa);
+  EXPECT_EQ(mmio_region_read32(dev_b, 0x0), 0xb);
+}
 }  // namespace
@@ -0,0 +1,90 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/profiler.h"
+
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/csr.h"
+
+static profiler_site_t arena[kProfilerSites];
+static size_t arena_used;
+static uint32_t arena_dropped;
+
+static uint32_t mcycle_read(void) {
+  uint32_t cycles;
+  CSR_READ(CSR_REG_MCYCLE, &cycles);
+  return cycles;
+}
+
+static void site_clear(profiler_site_t *site, const char *name) {
+  *site = (profiler_site_t){
+      .name = name,
+      .min = UINT32_MAX,
+  };
+}
+
+profiler_site_t *profiler_site_register(const char *name) {
+  if (arena_used == kProfilerSites) {
+    ++arena_dropped;
+    return NULL;
+  }
+  profiler_site_t *site = &arena[arena_used++];
+  site_clear(site, name);
+  return site;
+}
+
+void profiler_record(profiler_site_t *site, uint32_t cycles) {
+  if (site == NULL) {
+    return;
+  }
+  ++site->count;
+  site->total += cycles;
+  if (cycles < site->min) {
+    site->min = cycles;
+  }
+  if (cycles > site->max) {
+    site->max = cycles;
+  }
+  // Two bits of magnitude per bucket: 32-bit durations fit in 16 buckets.
+  size_t bucket = 0;
+  if (cycles != 0) {
+    bucket = (size_t)(31 - bitfield_count_leading_zeroes32(cycles)) / 2;
+  }
+  ++site->histogram[bucket];
+}
+
+profiler_timer_t profiler_timer_start(profiler_site_t **site,
+                                      const char *name) {
+  if (*site == NULL) {
+    *site = profiler_site_register(name);
+  }
+  // Read the counter last so that registration is not part of the duration.
+  return (profiler_timer_t){
+      .site = *site,
+      .start = mcycle_read(),
+  };
+}
+
+void profiler_timer_stop(profiler_timer_t *timer) {
+  // Unsigned subtraction gives the right duration across a counter wrap.
+  uint32_t cycles = mcycle_read() - timer->start;
+  profiler_record(timer->site, cycles);
+}
+
+void profiler_reset(void) {
+  for (size_t i = 0; i < arena_used; ++i) {
+    site_clear(&arena[i], arena[i].name);
+  }
+}
+
+size_t profiler_site_count(void) { return arena_used; }
+
+const profiler_site_t *profiler_site_get(size_t index) {
+  if (index >= arena_used) {
+    return NULL;
+  }
+  return &arena[index];
+}
+
+uint32_t profiler_sites_dropped(void) { return arena_dropped; }
@@ -0,0 +1,206 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_BASE_PROFILER_H_
+#define OPENTITAN_SW_DEVICE_LIB_BASE_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * @file
+ * @brief Cycle-count profiling of named call sites.
+ *
+ * Each profiled call site gets a `profiler_site_t` from a fixed static arena
+ * the first time it runs. Every run of the site adds its duration, measured
+ * with the Ibex `mcycle` counter, to the site's statistics and histogram.
+ *
+ * The `PROFILER_*` macros only do anything when `OT_PROFILER` is defined,
+ * e.g. with `--copt=-DOT_PROFILER`; otherwise they compile to nothing, so
+ * call sites can stay in production code:
+ *
+ *   rom_error_t do_stuff(void) {
+ *     PROFILER_SCOPE("do_stuff");
+ *     // Timed until `do_stuff()` returns, including early returns.
+ *   }
+ *
+ *   PROFILER_START(verify, "verify");
+ *   // Do some stuff
+ *   PROFILER_STOP(verify);
+ *
+ * The collected sites can be walked with `profiler_site_count()` and
+ * `profiler_site_get()`.
+ */
+
+enum {
+  /**
+   * Number of call sites the arena has room for.
+   */
+  kProfilerSites = 32,
+  /**
+   * Number of histogram buckets per call site.
+   *
+   * Bucket `i` counts durations in `[4^i, 4^(i+1))` cycles; bucket 0 also
+   * counts zero-length durations.
+   */
+  kProfilerBuckets = 16,
+};
+
+/**
+ * Statistics of a profiled call site.
+ */
+typedef struct profiler_site {
+  /**
+   * Name of the site.
+   */
+  const char *name;
+  /**
+   * Number of durations recorded.
+   */
+  uint32_t count;
+  /**
+   * Shortest duration recorded, in cycles.
+   */
+  uint32_t min;
+  /**
+   * Longest duration recorded, in cycles.
+   */
+  uint32_t max;
+  /**
+   * Sum of all durations recorded, in cycles.
+   */
+  uint64_t total;
+  /**
+   * Number of durations recorded in each bucket.
+   */
+  uint32_t histogram[kProfilerBuckets];
+} profiler_site_t;
+
+/**
+ * A running timer for a call site.
+ */
+typedef struct profiler_timer {
+  /**
+   * Site to record the duration to, or NULL if the arena was full.
+   */
+  profiler_site_t *site;
+  /**
+   * Low 32 bits of `mcycle` when the timer started.
+   */
+  uint32_t start;
+} profiler_timer_t;
+
+/**
+ * Takes the next free site from the arena.
+ *
+ * @param name Name of the site, which must have static storage duration.
+ * @return The new site, or NULL if the arena is full.
+ */
+OT_WARN_UNUSED_RESULT
+profiler_site_t *profiler_site_register(const char *name);
+
+/**
+ * Adds a duration to a site's statistics.
+ *
+ * @param site Site to record to; NULL is ignored.
+ * @param cycles Duration, in cycles.
+ */
+void profiler_record(profiler_site_t *site, uint32_t cycles);
+
+/**
+ * Starts a timer for a call site.
+ *
+ * `*site` caches the site between calls; it must have static storage duration
+ * and start out NULL, in which case a site named `name` is registered.
+ *
+ * @param site Cached site of the caller.
+ * @param name Name of the site.
+ * @return The running timer.
+ */
+OT_WARN_UNUSED_RESULT
+profiler_timer_t profiler_timer_start(profiler_site_t **site,
+                                      const char *name);
+
+/**
+ * Stops a timer and records its duration.
+ *
+ * Durations must be shorter than 2^32 cycles.
+ *
+ * @param timer Timer from `profiler_timer_start()`.
+ */
+void profiler_timer_stop(profiler_timer_t *timer);
+
+/**
+ * Clears the statistics of every registered site.
+ *
+ * Sites stay registered, so cached sites remain valid.
+ */
+void profiler_reset(void);
+
+/**
+ * Returns the number of sites registered so far.
+ */
+OT_WARN_UNUSED_RESULT
+size_t profiler_site_count(void);
+
+/**
+ * Returns the `index`th registered site, or NULL if there is no such site.
+ */
+OT_WARN_UNUSED_RESULT
+const profiler_site_t *profiler_site_get(size_t index);
+
+/**
+ * Returns the number of sites that could not be registered because the arena
+ * was full.
+ */
+OT_WARN_UNUSED_RESULT
+uint32_t profiler_sites_dropped(void);
+
+#ifdef OT_PROFILER
+#define PROFILER_SITE_(id_) OT_CAT(profiler_site_, id_)
+
+/**
+ * Times the rest of the enclosing scope as the site `name_`.
+ */
+#define PROFILER_SCOPE(name_)                              \
+  static profiler_site_t *PROFILER_SITE_(__LINE__) = NULL; \
+  profiler_timer_t OT_CAT(profiler_timer_, __LINE__)       \
+      __attribute__((cleanup(profiler_timer_stop))) =      \
+          profiler_timer_start(&PROFILER_SITE_(__LINE__), name_)
+
+/**
+ * Starts the timer `timer_` for the site `name_`.
+ */
+#define PROFILER_START(timer_, name_)                    \
+  static profiler_site_t *PROFILER_SITE_(timer_) = NULL; \
+  profiler_timer_t timer_ =                              \
+      profiler_timer_start(&PROFILER_SITE_(timer_), name_)
+
+/**
+ * Stops the timer `timer_` started by `PROFILER_START()`.
+ */
+#define PROFILER_STOP(timer_) profiler_timer_stop(&timer_)
+#else
+#define PROFILER_SCOPE(name_) \
+  do {                        \
+  } while (0)
+#define PROFILER_START(timer_, name_) \
+  do {                                \
+  } while (0)
+#define PROFILER_STOP(timer_) \
+  do {                        \
+  } while (0)
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_BASE_PROFILER_H_
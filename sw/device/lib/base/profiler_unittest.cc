@@ -0,0 +1,89 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/profiler.h"
+
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/csr.h"
+#include "sw/device/silicon_creator/lib/base/mock_csr.h"
+
+namespace profiler_unittest {
+namespace {
+
+class ProfilerTest : public testing::Test {
+ protected:
+  void SetUp() override { profiler_reset(); }
+
+  mock_csr::MockCsr csr_;
+};
+
+TEST_F(ProfilerTest, Timer) {
+  profiler_site_t *cached = nullptr;
+  EXPECT_CSR_READ(CSR_REG_MCYCLE, 1000);
+  profiler_timer_t timer = profiler_timer_start(&cached, "timer");
+  ASSERT_NE(cached, nullptr);
+  EXPECT_STREQ(cached->name, "timer");
+  EXPECT_CSR_READ(CSR_REG_MCYCLE, 1300);
+  profiler_timer_stop(&timer);
+
+  // A second run reuses the cached site, across a counter wrap.
+  profiler_site_t *site = cached;
+  EXPECT_CSR_READ(CSR_REG_MCYCLE, UINT32_MAX - 9);
+  timer = profiler_timer_start(&cached, "timer");
+  EXPECT_EQ(cached, site);
+  EXPECT_CSR_READ(CSR_REG_MCYCLE, 10);
+  profiler_timer_stop(&timer);
+
+  EXPECT_EQ(site->count, 2);
+  EXPECT_EQ(site->min, 20);
+  EXPECT_EQ(site->max, 300);
+  EXPECT_EQ(site->total, 320);
+}
+
+TEST_F(ProfilerTest, Histogram) {
+  profiler_site_t *site = profiler_site_register("histogram");
+  ASSERT_NE(site, nullptr);
+  for (uint32_t cycles : {0u, 1u, 3u, 4u, 15u, 16u, 1000u, UINT32_MAX}) {
+    profiler_record(site, cycles);
+  }
+  EXPECT_EQ(site->histogram[0], 3);
+  EXPECT_EQ(site->histogram[1], 2);
+  EXPECT_EQ(site->histogram[2], 1);
+  EXPECT_EQ(site->histogram[4], 1);
+  EXPECT_EQ(site->histogram[kProfilerBuckets - 1], 1);
+  EXPECT_EQ(site->min, 0);
+  EXPECT_EQ(site->max, UINT32_MAX);
+}
+
+TEST_F(ProfilerTest, Reset) {
+  profiler_site_t *site = profiler_site_register("reset");
+  ASSERT_NE(site, nullptr);
+  profiler_record(site, 42);
+  profiler_reset();
+  EXPECT_EQ(site->count, 0);
+  EXPECT_EQ(site->total, 0);
+  EXPECT_EQ(site->histogram[2], 0);
+  EXPECT_STREQ(site->name, "reset");
+}
+
+// Fills the arena, so this must stay the last test.
+TEST_F(ProfilerTest, ArenaFull) {
+  size_t used = profiler_site_count();
+  for (size_t i = used; i < kProfilerSites; ++i) {
+    EXPECT_NE(profiler_site_register("fill"), nullptr);
+  }
+  EXPECT_EQ(profiler_site_count(), kProfilerSites);
+  EXPECT_EQ(profiler_site_get(kProfilerSites), nullptr);
+  EXPECT_STREQ(profiler_site_get(kProfilerSites - 1)->name, "fill");
+
+  EXPECT_EQ(profiler_site_register("dropped"), nullptr);
+  EXPECT_EQ(profiler_sites_dropped(), 1);
+  // Recording to a dropped site is a no-op.
+  profiler_record(nullptr, 1);
+}
+
+}  // namespace
+}  // namespace profiler_unittest
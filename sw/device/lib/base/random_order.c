@@ -4,16 +4,37 @@
 
 #include "sw/device/lib/base/random_order.h"
 
-#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/macros.h"
 
-// TODO: The current implementation is just a skeleton, and currently just
-// traverses from 0 to `min_len * 2`.
+// The source of randomness for the order, which may be replaced at link-time.
+OT_WEAK
+uint32_t random_order_random_word(void) { return 0x6d2b79f5; }
 
 void random_order_init(random_order_t *ctx, size_t min_len) {
-  ctx->state = 0;
-  ctx->max = min_len * 2;
+  size_t max = 1;
+  while (max <= min_len) {
+    max <<= 1;
+  }
+
+  // An LCG `x' = (mul * x + inc) mod max` has full period when `max` is a
+  // power of two, `mul` is 1 modulo 4 and `inc` is odd (Hull-Dobell), so it
+  // visits each of `0..max` once. The parameters and start only use the bits
+  // that matter modulo `max`; the low bits of `seed0` and `seed1` pick `mul`
+  // and `inc`, and their high bits pick the start and the output mask, so each
+  // is independent for orders of up to 2^16 elements.
+  uint32_t seed0 = random_order_random_word();
+  uint32_t seed1 = random_order_random_word();
+  ctx->max = max;
+  ctx->mul = ((size_t)seed0 << 2) | 1;
+  ctx->inc = ((size_t)seed1 << 1) | 1;
+  ctx->state = (seed0 >> 16) & (max - 1);
+  ctx->mask = (seed1 >> 16) & (max - 1);
 }
 
 size_t random_order_len(const random_order_t *ctx) { return ctx->max; }
 
-size_t random_order_advance(random_order_t *ctx) { return ctx->state++; }
+size_t random_order_advance(random_order_t *ctx) {
+  size_t ret = ctx->state ^ ctx->mask;
+  ctx->state = (ctx->state * ctx->mul + ctx->inc) & (ctx->max - 1);
+  return ret;
+}
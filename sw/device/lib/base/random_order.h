@@ -6,6 +6,7 @@
 #define OPENTITAN_SW_DEVICE_LIB_BASE_RANDOM_ORDER_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,12 +32,50 @@ extern "C" {
  * Users must be mindful of these constraints when using `random_order_t`.
  * These caveats are intended to allow for implementation flexibility, such as
  * intentionally adding decoys to the sequence.
+ *
+ * The current implementation visits every integer in `0..m` exactly once,
+ * where `m` is the smallest power of two greater than `n`, so there is always
+ * at least one decoy. The order is given by a full-period linear congruential
+ * generator modulo `m`, with a random multiplier, increment and start, whose
+ * output is xored with a random mask. This needs no tables and costs a
+ * multiply and a few ALU operations per element. The low bits of an LCG have
+ * short periods, so this hides the order of the traversal from an attacker
+ * without being a cryptographically strong permutation.
  */
 typedef struct random_order {
+  /**
+   * The next output of the generator, before masking.
+   */
   size_t state;
+  /**
+   * The length of the sequence, which is a power of two.
+   */
   size_t max;
+  /**
+   * The LCG multiplier, which is 1 modulo 4.
+   */
+  size_t mul;
+  /**
+   * The LCG increment, which is odd.
+   */
+  size_t inc;
+  /**
+   * The mask that is xored with each output, which is less than `max`.
+   */
+  size_t mask;
 } random_order_t;
 
+/**
+ * Returns a random word for seeding `random_order_init()`.
+ *
+ * The default implementation returns a constant, which gives a fixed order.
+ * It is a weak symbol, so that a driver for a hardware entropy source can
+ * replace it at link time.
+ *
+ * @return A random word.
+ */
+uint32_t random_order_random_word(void);
+
 /**
  * Constructs a new, randomly-seeded traversal order,
  * running from `0` to at least `min_len`.
@@ -0,0 +1,67 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/random_order.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/testing/test_framework/ottf_test_config.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  // The minimum length of each order, which gives 128 elements.
+  kMinLen = 100,
+  kNumRepetitions = 10,
+};
+
+bool test_main(void) {
+  uint8_t seen[2 * kMinLen];
+
+  for (size_t i = 0; i < kNumRepetitions; ++i) {
+    memset(seen, 0, sizeof(seen));
+
+    random_order_t order;
+    const uint64_t start_cycles = ibex_mcycle_read();
+    random_order_init(&order, kMinLen);
+    const uint64_t init_cycles = ibex_mcycle_read();
+    const size_t len = random_order_len(&order);
+    size_t sum = 0;
+    for (size_t j = 0; j < len; ++j) {
+      sum += random_order_advance(&order);
+    }
+    const uint64_t end_cycles = ibex_mcycle_read();
+
+    // Check that the order was a permutation of `0..len` outside of the
+    // timed loop; `sum` keeps the timed calls from being optimized away.
+    CHECK(len > kMinLen && len <= ARRAYSIZE(seen));
+    random_order_init(&order, kMinLen);
+    for (size_t j = 0; j < len; ++j) {
+      size_t idx = random_order_advance(&order);
+      CHECK(idx < len && seen[idx] == 0);
+      seen[idx] = 1;
+    }
+    CHECK(sum == len * (len - 1) / 2);
+
+    CHECK(end_cycles - start_cycles <= UINT32_MAX);
+    const uint32_t num_init_cycles = (uint32_t)(init_cycles - start_cycles);
+    const uint32_t num_advance_cycles = (uint32_t)(end_cycles - init_cycles);
+    // Report cycles per element to two decimal places, since `base_printf()`
+    // cannot print floating point values.
+    CHECK(num_advance_cycles < UINT32_MAX / 100);
+    const uint32_t centi_cycles_per_elem = num_advance_cycles * 100 / len;
+    LOG_INFO(
+        "random_order of %d elements: init in %d cycles, advanced in %d "
+        "cycles (%d.%02d cycles/element).",
+        len, num_init_cycles, num_advance_cycles, centi_cycles_per_elem / 100,
+        centi_cycles_per_elem % 100);
+  }
+  return true;
+}
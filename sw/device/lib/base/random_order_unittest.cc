@@ -0,0 +1,61 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/random_order.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace random_order_unittest {
+namespace {
+
+uint32_t random_word_state = 0;
+
+// Override the default randomness source so that each order gets a different
+// seed.
+extern "C" uint32_t random_order_random_word() {
+  random_word_state = random_word_state * 1664525 + 1013904223;
+  return random_word_state;
+}
+
+TEST(RandomOrder, IsPermutationWithDecoy) {
+  for (size_t min_len = 0; min_len <= 70; ++min_len) {
+    for (int seed = 0; seed < 16; ++seed) {
+      random_order_t order;
+      random_order_init(&order, min_len);
+
+      size_t len = random_order_len(&order);
+      EXPECT_GT(len, min_len);
+      EXPECT_LE(len, 2 * min_len + 1);
+      EXPECT_EQ(len & (len - 1), 0) << "len = " << len;
+
+      std::vector<int> seen(len, 0);
+      for (size_t i = 0; i < len; ++i) {
+        size_t idx = random_order_advance(&order);
+        ASSERT_LT(idx, len);
+        ++seen[idx];
+      }
+      for (size_t i = 0; i < len; ++i) {
+        EXPECT_EQ(seen[i], 1) << "min_len = " << min_len << ", i = " << i;
+      }
+    }
+  }
+}
+
+TEST(RandomOrder, SeedChangesOrder) {
+  std::vector<size_t> first;
+  std::vector<size_t> second;
+  for (std::vector<size_t> *out : {&first, &second}) {
+    random_order_t order;
+    random_order_init(&order, 32);
+    for (size_t i = 0; i < random_order_len(&order); ++i) {
+      out->push_back(random_order_advance(&order));
+    }
+  }
+  EXPECT_NE(first, second);
+}
+
+}  // namespace
+}  // namespace random_order_unittest
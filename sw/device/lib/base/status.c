@@ -104,7 +104,18 @@ bool status_extract(status_t s, const char **code, int32_t *arg, char *mod_id) {
     err = sizeof(status_codes) / sizeof(status_codes[0]) - 1;
   }
   *code = status_codes[err];
-  if (err) {
+  bool lean = bitfield_field32_read((uint32_t)s.value,
+                                    STATUS_FIELD_LEAN_MARKER) ==
+              STATUS_LEAN_MARKER;
+  if (err && lean) {
+    // Lean statuses only know the index of their creation site.
+    *arg = (int32_t)bitfield_field32_read((uint32_t)s.value,
+                                          STATUS_FIELD_LEAN_SITE);
+    *mod_id++ = '[';
+    *mod_id++ = '*';
+    *mod_id++ = ']';
+    return true;
+  } else if (err) {
     *arg = (int32_t)bitfield_field32_read((uint32_t)s.value, STATUS_FIELD_ARG);
     uint32_t module_id =
         bitfield_field32_read((uint32_t)s.value, STATUS_FIELD_MODULE_ID);
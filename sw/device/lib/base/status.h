@@ -51,6 +51,14 @@ extern "C" {
  *
  * The module identifier value is interpreted as three 5-bit fields
  * representing the characters [0x40..0x5F] (e.g. [@ABC ... _]).
+ *
+ * When `OT_STATUS_LEAN` is defined, e.g. with
+ * `--//sw/device/lib/base:status_format=lean`, C code creates error statuses
+ * without calling `status_create()`. Instead, each creation site gets an
+ * `ot_status_site_record_t` in the `.ot.status_site` section, and the status
+ * holds the index of that record next to the error code. `opentitantool status decode --elf` maps the index
+ * back to a module, file and line. Arguments of lean error statuses are
+ * dropped.
  */
 typedef struct status {
   int32_t value;
@@ -76,6 +84,59 @@ enum ot_status_create_record_magic {
   OT_SCR_UNKNOWN_MOD_ID = 0xffffffff,
 };
 
+/* In lean builds, each site that creates an error status puts one instance
+ * of this structure in the .ot.status_site section; the status holds its
+ * index. Tools read the section, so the layout of this structure must remain
+ * stable. */
+typedef struct ot_status_site_record {
+  // Set to OT_SCR_UNKNOWN_MOD_ID if not fixed at compile time
+  uint32_t module_id;
+  uint32_t line;
+  char filename[120];
+} ot_status_site_record_t;
+
+enum ot_status_site_record_magic {
+  /* Size and alignment of a site record, so that the address of a record in
+   * the section is its index shifted into `STATUS_FIELD_LEAN_SITE`. */
+  OT_SSR_SIZE = 128,
+};
+
+static_assert(sizeof(ot_status_site_record_t) == OT_SSR_SIZE,
+              "Unexpected size of ot_status_site_record_t");
+
+#if defined(OT_STATUS_LEAN) && !defined(__cplusplus)
+/* The section is not loaded and starts at address zero (see
+ * info_sections.ld), so the value is a link-time constant for a constant
+ * code. */
+#define STATUS_LEAN_CREATE_(code_)                                        \
+  ({                                                                      \
+    OT_SECTION(".ot.status_site")                                         \
+    OT_USED __attribute__((aligned(OT_SSR_SIZE)))                         \
+    static const ot_status_site_record_t kOtStatusSite = {                \
+        .module_id = __builtin_constant_p(MODULE_ID)                      \
+                         ? MODULE_ID                                      \
+                         : OT_SCR_UNKNOWN_MOD_ID,                         \
+        .line = __LINE__,                                                 \
+        .filename = __FILE__,                                             \
+    };                                                                    \
+    (status_t){.value = (int32_t)((uintptr_t)&kOtStatusSite +             \
+                                  STATUS_LEAN_BASE + (uint32_t)(code_))}; \
+  })
+
+#define STATUS_CREATE_AT_(code_, mod_id_, arg_) \
+  ({                                            \
+    (void)(mod_id_);                            \
+    absl_status_t lean_code_ = (code_);         \
+    int32_t lean_arg_ = (arg_);                 \
+    lean_code_ == kOk && lean_arg_ >= 0         \
+        ? (status_t){.value = lean_arg_}        \
+        : STATUS_LEAN_CREATE_(lean_code_);      \
+  })
+#else
+#define STATUS_CREATE_AT_(code_, mod_id_, arg_) \
+  status_create(code_, mod_id_, __FILE__, arg_)
+#endif
+
 #ifdef __cplusplus
 /* Recording statuses in C++ is not really useful since that means the code
  * will not run on the target. It also creates problems with g++ because
@@ -108,7 +169,7 @@ enum ot_status_create_record_magic {
     typeof(expr_) _val = (expr_);                                         \
     absl_status_t code;                                                   \
     memcpy(&code, &_val, sizeof(code));                                   \
-    status_create(code, MODULE_ID, __FILE__, code == kOk ? 0 : __LINE__); \
+    STATUS_CREATE_AT_(code, MODULE_ID, code == kOk ? 0 : __LINE__);       \
   })
 
 #define ROM_ERROR_INTO_STATUS(expr_)                                          \
@@ -122,7 +183,7 @@ enum ot_status_create_record_magic {
     int32_t arg = (int32_t)bitfield_field32_read(val, ROM_ERROR_FIELD_ERROR); \
     uint32_t mod = bitfield_field32_read(val, ROM_ERROR_FIELD_MODULE);        \
     uint32_t module = (mod & 0x1F) << 16 | (mod & 0x1F00) << (21 - 8);        \
-    status_create(code, module, __FILE__, code == kOk ? kErrorOk : arg);      \
+    STATUS_CREATE_AT_(code, module, code == kOk ? kErrorOk : arg);            \
   })
 
 /**
@@ -162,7 +223,7 @@ void status_report(status_t value);
 #define STATUS_REPORT_HERE(status)                                       \
   ({                                                                     \
     absl_status_t err = status_err(status);                              \
-    status_t report = status_create(err, MODULE_ID, __FILE__, __LINE__); \
+    status_t report = STATUS_CREATE_AT_(err, MODULE_ID, __LINE__);       \
     status_report(report);                                               \
   })
 
@@ -250,7 +311,7 @@ OT_ALWAYS_INLINE absl_status_t status_err(status_t s) {
     static_assert(OT_VA_ARGS_COUNT(_, __VA_ARGS__) <= 2,                  \
                   "status macros take 0 or 1 arguments");                 \
     RECORD_STATUS_CREATE(s_, MODULE_ID, __FILE__);                        \
-    status_create(s_, MODULE_ID, __FILE__, OT_GET_LAST_ARG(__VA_ARGS__)); \
+    STATUS_CREATE_AT_(s_, MODULE_ID, OT_GET_LAST_ARG(__VA_ARGS__));       \
   })
 
 // Helpers for creating statuses of various kinds.
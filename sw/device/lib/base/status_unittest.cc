@@ -84,5 +84,25 @@ TEST(Status, ErrorValuesInModule) {
   EXPECT_EQ(std::string(mod_id), "ZZZ");
 }
 
+TEST(Status, LeanErrorValues) {
+  int32_t arg;
+  const char *message;
+  char mod_id[4]{};
+
+  // Lean statuses are only created by C code, so build one by hand: the site
+  // record at index 5 of .ot.status_site with a kNotFound code.
+  status_t status = {
+      .value = static_cast<int32_t>(STATUS_LEAN_BASE + 5 * OT_SSR_SIZE +
+                                    absl_status_t::kNotFound),
+  };
+  bool err = status_extract(status, &message, &arg, mod_id);
+  EXPECT_EQ(status_ok(status), false);
+  EXPECT_EQ(status_err(status), absl_status_t::kNotFound);
+  EXPECT_EQ(err, true);
+  EXPECT_EQ(std::string(message), "NotFound");
+  EXPECT_EQ(arg, 5);
+  EXPECT_EQ(std::string(mod_id), "[*]");
+}
+
 }  // namespace
 }  // namespace status_unittest
@@ -246,6 +246,30 @@ status_t aes_decrypt_begin(const aes_key_t key, const aes_block_t *iv) {
   return aes_begin(key, iv, kHardenedBoolFalse);
 }
 
+/**
+ * Write a block to the AES input data registers.
+ *
+ * @param src Input block.
+ */
+static void aes_write_block(const aes_block_t *src) {
+  uint32_t offset = kBase + AES_DATA_IN_0_REG_OFFSET;
+  for (size_t i = 0; i < ARRAYSIZE(src->data); ++i) {
+    abs_mmio_write32(offset + i * sizeof(uint32_t), src->data[i]);
+  }
+}
+
+/**
+ * Read a block from the AES output data registers.
+ *
+ * @param[out] dest Output block.
+ */
+static void aes_read_block(aes_block_t *dest) {
+  uint32_t offset = kBase + AES_DATA_OUT_0_REG_OFFSET;
+  for (size_t i = 0; i < ARRAYSIZE(dest->data); ++i) {
+    dest->data[i] = abs_mmio_read32(offset + i * sizeof(uint32_t));
+  }
+}
+
 status_t aes_update(aes_block_t *dest, const aes_block_t *src) {
   if (dest != NULL) {
     // Check that either the output is valid or AES is busy, to avoid spinning
@@ -258,21 +282,48 @@ status_t aes_update(aes_block_t *dest, const aes_block_t *src) {
     }
 
     HARDENED_TRY(spin_until(AES_STATUS_OUTPUT_VALID_BIT));
-
-    uint32_t offset = kBase + AES_DATA_OUT_0_REG_OFFSET;
-    for (size_t i = 0; i < ARRAYSIZE(dest->data); ++i) {
-      dest->data[i] = abs_mmio_read32(offset + i * sizeof(uint32_t));
-    }
+    aes_read_block(dest);
   }
 
   if (src != NULL) {
     HARDENED_TRY(spin_until(AES_STATUS_INPUT_READY_BIT));
+    aes_write_block(src);
+  }
+
+  return OTCRYPTO_OK;
+}
 
-    uint32_t offset = kBase + AES_DATA_IN_0_REG_OFFSET;
-    for (size_t i = 0; i < ARRAYSIZE(src->data); ++i) {
-      abs_mmio_write32(offset + i * sizeof(uint32_t), src->data[i]);
+status_t aes_update_blocks(aes_block_t *dest, const aes_block_t *src,
+                           size_t num_blocks) {
+  if (num_blocks == 0) {
+    return OTCRYPTO_OK;
+  }
+  if (dest == NULL || src == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Fill the double buffer: the first block moves into the core as soon as it
+  // is written, and the second one waits in the input registers.
+  HARDENED_TRY(spin_until(AES_STATUS_INPUT_READY_BIT));
+  aes_write_block(&src[0]);
+  if (num_blocks > 1) {
+    HARDENED_TRY(spin_until(AES_STATUS_INPUT_READY_BIT));
+    aes_write_block(&src[1]);
+  }
+
+  // When the output of block `i` becomes valid, the core has already taken
+  // block `i + 1` from the input registers, so block `i + 2` can be written
+  // right after the output is read without checking INPUT_READY again (see
+  // the programmer's guide of the AES block).
+  size_t i = 0;
+  for (; launder32(i) < num_blocks; ++i) {
+    HARDENED_TRY(spin_until(AES_STATUS_OUTPUT_VALID_BIT));
+    aes_read_block(&dest[i]);
+    if (i + 2 < num_blocks) {
+      aes_write_block(&src[i + 2]);
     }
   }
+  HARDENED_CHECK_EQ(i, num_blocks);
 
   return OTCRYPTO_OK;
 }
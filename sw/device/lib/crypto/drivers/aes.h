@@ -140,6 +140,29 @@ status_t aes_decrypt_begin(const aes_key_t key, const aes_block_t *iv);
 OT_WARN_UNUSED_RESULT
 status_t aes_update(aes_block_t *dest, const aes_block_t *src);
 
+/**
+ * Runs multiple blocks through the AES hardware.
+ *
+ * Unlike `aes_update`, this function is not offset by one: it feeds all of
+ * `src` into the hardware and returns once all of the corresponding output has
+ * been written to `dest`. While block `i` is being processed, block `i + 1`
+ * already waits in the input buffer, so the hardware never idles between
+ * blocks. Each block costs a single wait on the status register.
+ *
+ * It may be called several times between `aes_*_begin` and `aes_end` (for
+ * example, to process a long message in chunks), but there must be no output
+ * pending from a previous `aes_update` call.
+ *
+ * @param[out] dest Output blocks, `num_blocks` long. May be equal to `src`, but
+ * must not otherwise overlap with it.
+ * @param src Input blocks, `num_blocks` long.
+ * @param num_blocks Number of blocks to process.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_update_blocks(aes_block_t *dest, const aes_block_t *src,
+                           size_t num_blocks);
+
 /**
  * Completes an AES session by clearing control settings and key material.
  *
@@ -65,7 +65,7 @@ static const aes_block_t kCiphertext[] = {
     {.data = 0xda1d031e, 0xd103be2f, 0xa0702179, 0xee9c00f3},
 };
 
-static status_t run_aes_test(void) {
+static status_t run_aes_test(bool multi_block) {
   // This is a weak share intended to exercise correct configuration of the
   // hardware; in general, the key should be generated by either generating
   // two shares and setting key = a ^ b, or generating a mask and setting
@@ -91,13 +91,18 @@ static status_t run_aes_test(void) {
   TRY(aes_encrypt_begin(key, &kIv));
 
   aes_block_t ciphertext[ARRAYSIZE(kCiphertext)] = {0};
-  aes_block_t *out = NULL;
-  for (size_t i = 0; i < ARRAYSIZE(kPlaintext); ++i) {
-    LOG_INFO("Processing block %d.", i);
-    TRY(aes_update(out, &kPlaintext[i]));
-    out = &ciphertext[i];
+  if (multi_block) {
+    LOG_INFO("Processing %d blocks.", ARRAYSIZE(kPlaintext));
+    TRY(aes_update_blocks(ciphertext, kPlaintext, ARRAYSIZE(kPlaintext)));
+  } else {
+    aes_block_t *out = NULL;
+    for (size_t i = 0; i < ARRAYSIZE(kPlaintext); ++i) {
+      LOG_INFO("Processing block %d.", i);
+      TRY(aes_update(out, &kPlaintext[i]));
+      out = &ciphertext[i];
+    }
+    TRY(aes_update(out, NULL));
   }
-  TRY(aes_update(out, NULL));
 
   CHECK_ARRAYS_EQ((uint32_t *)ciphertext, (uint32_t *)kCiphertext,
                   sizeof(ciphertext) / (sizeof(uint32_t)));
@@ -115,7 +120,8 @@ OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
   CHECK_STATUS_OK(entropy_complex_init());
-  CHECK_STATUS_OK(run_aes_test());
+  CHECK_STATUS_OK(run_aes_test(/*multi_block=*/false));
+  CHECK_STATUS_OK(run_aes_test(/*multi_block=*/true));
 
   return true;
 }
@@ -904,35 +904,55 @@ status_t entropy_csrng_generate_start(
                             kEntropyCsrngSendAppCmdTypeCsrng, true);
 }
 
+/**
+ * Waits for the next 128-bit block of CSRNG output.
+ *
+ * @param fips_check Whether to require FIPS-compatible entropy.
+ * @return `false` if `fips_check` is set and the block is not FIPS-compatible.
+ */
+static bool csrng_genbits_wait(hardened_bool_t fips_check) {
+  uint32_t reg;
+  do {
+    reg = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_VLD_REG_OFFSET);
+  } while (!bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_VLD_BIT));
+  return fips_check == kHardenedBoolFalse ||
+         bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_FIPS_BIT);
+}
+
 status_t entropy_csrng_generate_data_get(uint32_t *buf, size_t len,
                                          hardened_bool_t fips_check) {
   static_assert(kEntropyCsrngBitsBufferNumWords == 4,
                 "kEntropyCsrngBitsBufferNumWords must be 4.");
-  size_t nblocks = ceil_div(len, 4);
   status_t res = OTCRYPTO_OK;
-  for (size_t block_idx = 0; block_idx < nblocks; ++block_idx) {
-    // Block until there is more data available in the genbits buffer. CSRNG
-    // generates data in 128bit chunks (i.e. 4 words).
-    uint32_t reg;
-    do {
-      reg = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_VLD_REG_OFFSET);
-    } while (!bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_VLD_BIT));
 
-    if (fips_check != kHardenedBoolFalse &&
-        !bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_FIPS_BIT)) {
+  // Full 128-bit blocks, read in reverse word order to match known-answer
+  // tests. CSRNG generates data in 128bit chunks (i.e. 4 words), so a single
+  // poll of the valid bit covers the whole block.
+  size_t nfull = len / kEntropyCsrngBitsBufferNumWords;
+  for (size_t block_idx = 0; block_idx < nfull; ++block_idx) {
+    if (!csrng_genbits_wait(fips_check)) {
       // Entropy isn't FIPS-compatible, so we should return an error when
       // done. However, we still need to read the result to clear CSRNG's FIFO.
       res = OTCRYPTO_RECOV_ERR;
     }
+    uint32_t *block = &buf[block_idx * kEntropyCsrngBitsBufferNumWords];
+    block[3] = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_REG_OFFSET);
+    block[2] = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_REG_OFFSET);
+    block[1] = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_REG_OFFSET);
+    block[0] = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_REG_OFFSET);
+  }
 
-    // Read the full 128-bit block, in reverse word order to match known-answer
-    // tests. To clear the FIFO, we need to read all blocks generated by the
-    // request even if we don't use them.
+  // Partial trailing block. To clear the FIFO, we need to read all words
+  // generated by the request even if we don't use them.
+  size_t tail_idx = nfull * kEntropyCsrngBitsBufferNumWords;
+  if (tail_idx < len) {
+    if (!csrng_genbits_wait(fips_check)) {
+      res = OTCRYPTO_RECOV_ERR;
+    }
     for (size_t offset = 0; offset < kEntropyCsrngBitsBufferNumWords;
          ++offset) {
       uint32_t word = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_REG_OFFSET);
-      size_t word_idx = (block_idx * kEntropyCsrngBitsBufferNumWords) +
-                        kEntropyCsrngBitsBufferNumWords - 1 - offset;
+      size_t word_idx = tail_idx + kEntropyCsrngBitsBufferNumWords - 1 - offset;
       if (word_idx < len) {
         buf[word_idx] = word;
       }
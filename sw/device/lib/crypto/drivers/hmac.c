@@ -67,8 +67,33 @@ OT_ASSERT_ENUM_VALUE(HMAC_DIGEST_15_REG_OFFSET, HMAC_DIGEST_14_REG_OFFSET + 4);
 enum {
   /* The beginning of the address space of HMAC. */
   kHmacBaseAddr = TOP_EARLGREY_HMAC_BASE_ADDR,
+  /**
+   * Number of words written to `MSG_FIFO` per iteration of the inner loop.
+   *
+   * Writes to a full `MSG_FIFO` stall the bus until there is room, so the
+   * FIFO status is never polled; the fixed trip count only lets the compiler
+   * unroll the stores.
+   */
+  kHmacMsgFifoBurstWords = 8,
 };
 
+/**
+ * Tag of the context state currently held by HMAC HWIP, or 0 if none.
+ *
+ * `hmac_update` leaves HMAC HWIP stopped with the context it just saved still
+ * loaded, and stamps both the context and this variable with a fresh tag. If
+ * the next `hmac_update` or `hmac_final` call comes from a context carrying the
+ * same tag, the (expensive) wipe and full context restore are skipped and the
+ * operation simply continues. Copies of a context share a tag only until one
+ * of them is updated, so a stale copy never matches.
+ */
+static uint32_t resident_hw_tag = 0;
+
+/**
+ * Counter used to generate fresh tags for `resident_hw_tag`.
+ */
+static uint32_t next_hw_tag = 0;
+
 /**
  * Wait until HMAC becomes idle.
  *
@@ -112,6 +137,8 @@ static status_t hmac_idle_wait(void) {
  * values with 1s.
  */
 static void hmac_hwip_clear(void) {
+  resident_hw_tag = 0;
+
   // Do not clear the config yet, we just need to deassert sha_en, see #23014.
   uint32_t cfg_reg = abs_mmio_read32(kHmacBaseAddr + HMAC_CFG_REG_OFFSET);
   cfg_reg = bitfield_bit32_write(cfg_reg, HMAC_CFG_SHA_EN_BIT, false);
@@ -167,11 +194,27 @@ static void digest_read(uint32_t *digest, size_t digest_wordlen) {
  * the first such call.
  *
  * If this function is being called from `ctx` object with previously stored
- * context (i.e. `ctx->hw_started = true`), then this state is restored.
+ * context (i.e. `ctx->hw_started = true`), then this state is restored, unless
+ * HMAC HWIP still holds it (see `resident_hw_tag`).
  *
  * @param ctx Context from which values are written to CSRs.
  */
 static void context_restore(hmac_ctx_t *ctx) {
+  // If HMAC HWIP still holds exactly the state saved in `ctx`, it is stopped
+  // with `sha_en` set and only needs to be told to continue.
+  if (ctx->hw_started && ctx->hw_tag != 0 && ctx->hw_tag == resident_hw_tag) {
+    // The state is about to advance; it no longer matches any saved context.
+    resident_hw_tag = 0;
+    uint32_t cmd_reg = bitfield_bit32_write(HMAC_CMD_REG_RESVAL,
+                                            HMAC_CMD_HASH_CONTINUE_BIT, 1);
+    abs_mmio_write32(kHmacBaseAddr + HMAC_CMD_REG_OFFSET, cmd_reg);
+    return;
+  }
+
+  // The previous caller should have left it clean, but it doesn't hurt to
+  // clear again.
+  hmac_hwip_clear();
+
   // Restore CFG register from `ctx->cfg_reg`.
   abs_mmio_write32(kHmacBaseAddr + HMAC_CFG_REG_OFFSET, ctx->cfg_reg);
 
@@ -226,6 +269,13 @@ static void context_save(hmac_ctx_t *ctx) {
       abs_mmio_read32(kHmacBaseAddr + HMAC_MSG_LENGTH_LOWER_REG_OFFSET);
   ctx->upper =
       abs_mmio_read32(kHmacBaseAddr + HMAC_MSG_LENGTH_UPPER_REG_OFFSET);
+
+  // HMAC HWIP keeps holding this state; remember that it matches `ctx`.
+  if (++next_hw_tag == 0) {
+    ++next_hw_tag;
+  }
+  ctx->hw_tag = next_hw_tag;
+  resident_hw_tag = next_hw_tag;
 }
 
 /**
@@ -236,7 +286,6 @@ static void context_save(hmac_ctx_t *ctx) {
  * @param message_len The length of `message` in bytes.
  */
 static void msg_fifo_write(const uint8_t *message, size_t message_len) {
-  // TODO(#23191): Should we handle backpressure here?
   // Begin by writing a one byte at a time until the data is aligned.
   size_t i = 0;
   for (; misalignment32_of((uintptr_t)(&message[i])) > 0 && i < message_len;
@@ -244,7 +293,15 @@ static void msg_fifo_write(const uint8_t *message, size_t message_len) {
     abs_mmio_write8(kHmacBaseAddr + HMAC_MSG_FIFO_REG_OFFSET, message[i]);
   }
 
-  // Write one word at a time as long as there is a full word available.
+  // Write whole bursts of words, then one word at a time as long as there is
+  // a full word available.
+  enum { kBurstBytes = kHmacMsgFifoBurstWords * sizeof(uint32_t) };
+  for (; i + kBurstBytes <= message_len; i += kBurstBytes) {
+    for (size_t j = 0; j < kHmacMsgFifoBurstWords; j++) {
+      abs_mmio_write32(kHmacBaseAddr + HMAC_MSG_FIFO_REG_OFFSET,
+                       read_32(&message[i + j * sizeof(uint32_t)]));
+    }
+  }
   for (; i + sizeof(uint32_t) <= message_len; i += sizeof(uint32_t)) {
     uint32_t next_word = read_32(&message[i]);
     abs_mmio_write32(kHmacBaseAddr + HMAC_MSG_FIFO_REG_OFFSET, next_word);
@@ -361,6 +418,7 @@ status_t hmac_init(hmac_ctx_t *ctx, const hmac_mode_t hmac_mode,
 
   ctx->hw_started = 0;
   ctx->partial_block_len = 0;
+  ctx->hw_tag = 0;
 
   return OTCRYPTO_OK;
 }
@@ -384,11 +442,8 @@ status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
   // handle the current partial block and the incoming message bytes.
   size_t leftover_len = (ctx->partial_block_len + len) % ctx->msg_block_bytelen;
 
-  // The previous caller should have left it clean, but it doesn't hurt to
-  // clear again.
-  hmac_hwip_clear();
-  // Retore context will restore the context and also hit start or continue
-  // button as necessary.
+  // Restore context will restore the context (unless HMAC HWIP still holds
+  // it) and also hit start or continue button as necessary.
   context_restore(ctx);
 
   // Write `partial_block` to MSG_FIFO
@@ -414,8 +469,9 @@ status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
   memcpy(ctx->partial_block, data + len - leftover_len, leftover_len);
   ctx->partial_block_len = leftover_len;
 
-  // Clean up HMAC HWIP so it can be reused by other driver calls.
-  hmac_hwip_clear();
+  // HMAC HWIP is left holding the saved state so that the next call on this
+  // context can continue without a restore. Any other driver call clears it
+  // first, and `hmac_final` wipes it.
   return OTCRYPTO_OK;
 }
 
@@ -429,12 +485,8 @@ status_t hmac_final(hmac_ctx_t *ctx, uint32_t *digest, size_t digest_wordlen) {
     return OTCRYPTO_BAD_ARGS;
   }
 
-  // The previous caller should have left it clean, but it doesn't hurt to
-  // clear again.
-  hmac_hwip_clear();
-
-  // Retore context will restore the context and also hit start or continue
-  // button as necessary.
+  // Restore context will restore the context (unless HMAC HWIP still holds
+  // it) and also hit start or continue button as necessary.
   context_restore(ctx);
 
   // Feed the final leftover bytes to HMAC HWIP.
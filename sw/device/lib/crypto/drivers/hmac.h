@@ -74,6 +74,9 @@ typedef struct hmac_ctx {
   uint8_t partial_block[kHmacMaxBlockBytes];
   // The number of valid bytes in `partial_block`.
   size_t partial_block_len;
+  // Tag of the last state saved into this context, used to tell whether HMAC
+  // HWIP still holds that state (0 if never saved).
+  uint32_t hw_tag;
 } hmac_ctx_t;
 
 typedef enum hmac_mode {
@@ -139,8 +142,15 @@ status_t hmac_init(hmac_ctx_t *ctx, const hmac_mode_t hmac_mode,
  * MSG_FIFO in internal block granularity. When all blocks are processed, HWIP
  * is stopped and the state of HWIP is saved to `ctx`. The leftover message
  * bytes that are not sufficient to be a block are stored in `ctx-partial_block`
- * to be used in future `hmac_update` or `hmac_final` calls. Finally, the state
- * of HWIP is cleared.
+ * to be used in future `hmac_update` or `hmac_final` calls.
+ *
+ * HWIP is left stopped with the saved state still loaded. If the next
+ * `hmac_update` or `hmac_final` call uses the same context, that state is
+ * continued directly instead of being wiped and restored from `ctx`; any other
+ * driver call (or a call with a different context) wipes HWIP first. This
+ * makes interleaving several streams cheap when consecutive calls mostly hit
+ * the same one. It assumes no code outside this driver uses HMAC HWIP between
+ * calls.
 
  * If the available message bytes are smaller than a single internal block,
  * `ctx->partial_block` is appended with the incoming bytes and no HWIP
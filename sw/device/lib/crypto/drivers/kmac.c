@@ -579,13 +579,197 @@ static status_t kmac_write_key_block(kmac_blinded_key_t *key) {
   return OTCRYPTO_OK;
 }
 
+/**
+ * Issue a command to KMAC HWIP.
+ *
+ * @param cmd One of the `KMAC_CMD_CMD_VALUE_*` values.
+ */
+static void kmac_issue_cmd(uint32_t cmd) {
+  uint32_t cmd_reg = KMAC_CMD_REG_RESVAL;
+  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD, cmd);
+  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+}
+
+/**
+ * Start absorbing a new message.
+ *
+ * Waits for KMAC HWIP to be idle, then issues the start command so that data
+ * written to MSG_FIFO is forwarded to Keccak.
+ *
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_absorb_start(void) {
+  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
+  kmac_issue_cmd(KMAC_CMD_CMD_VALUE_START);
+  return wait_status_bit(KMAC_STATUS_SHA3_ABSORB_BIT, 1);
+}
+
+/**
+ * Get the number of 32-bit words that can be written to MSG_FIFO right away.
+ *
+ * @param[out] free_words Number of words that fit into the message FIFO.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_msg_fifo_free_words(size_t *free_words) {
+  uint32_t reg = abs_mmio_read32(kKmacBaseAddr + KMAC_STATUS_REG_OFFSET);
+  if (bitfield_bit32_read(reg, KMAC_STATUS_ALERT_FATAL_FAULT_BIT)) {
+    return OTCRYPTO_FATAL_ERR;
+  }
+  if (bitfield_bit32_read(reg, KMAC_STATUS_ALERT_RECOV_CTRL_UPDATE_ERR_BIT)) {
+    return OTCRYPTO_RECOV_ERR;
+  }
+  size_t depth = bitfield_field32_read(reg, KMAC_STATUS_FIFO_DEPTH_FIELD);
+  if (depth >= KMAC_PARAM_NUM_ENTRIES_MSG_FIFO) {
+    *free_words = 0;
+    return OTCRYPTO_OK;
+  }
+  *free_words = (KMAC_PARAM_NUM_ENTRIES_MSG_FIFO - depth) *
+                KMAC_PARAM_NUM_BYTES_MSG_FIFO_ENTRY / sizeof(uint32_t);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Write message bytes to MSG_FIFO.
+ *
+ * The unaligned head and tail of `message` are written one byte at a time.
+ * The aligned middle is written as whole words in bursts: the FIFO fill level
+ * is read once per burst and as many words as fit are written without polling
+ * in between.
+ *
+ * KMAC HWIP must be in the absorb state.
+ *
+ * @param message Input message bytes.
+ * @param message_len Message length in bytes.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_msg_write(const uint8_t *message, size_t message_len) {
+  // Begin by writing a one byte at a time until the data is aligned.
+  size_t i = 0;
+  for (; misalignment32_of((uintptr_t)(&message[i])) > 0 && i < message_len;
+       i++) {
+    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
+    abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, message[i]);
+  }
+
+  // Write whole words in bursts sized to the free space in the FIFO.
+  while (i + sizeof(uint32_t) <= message_len) {
+    size_t burst_words;
+    HARDENED_TRY(kmac_msg_fifo_free_words(&burst_words));
+    size_t remaining_words = (message_len - i) / sizeof(uint32_t);
+    if (burst_words > remaining_words) {
+      burst_words = remaining_words;
+    }
+    for (size_t j = 0; j < burst_words; j++) {
+      abs_mmio_write32(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET,
+                       read_32(&message[i]));
+      i += sizeof(uint32_t);
+    }
+  }
+
+  // For the last few bytes, we need to write one byte at a time again.
+  for (; i < message_len; i++) {
+    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
+    abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, message[i]);
+  }
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Finish absorbing and wait for the first block of output.
+ *
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_absorb_finish(void) {
+  kmac_issue_cmd(KMAC_CMD_CMD_VALUE_PROCESS);
+  return wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1);
+}
+
+/**
+ * Get the Keccak rate of the currently configured operation.
+ *
+ * @param[out] rate_words Keccak rate in 32-bit words.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_rate_words_get(size_t *rate_words) {
+  uint32_t cfg_reg =
+      abs_mmio_read32(kKmacBaseAddr + KMAC_CFG_SHADOWED_REG_OFFSET);
+  uint32_t keccak_str =
+      bitfield_field32_read(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD);
+  return kmac_get_keccak_rate_words(keccak_str, rate_words);
+}
+
+/**
+ * Read output words from the state window, generating more state as needed.
+ *
+ * `offset` is the number of words of the current state block that were
+ * already read. Once a block is exhausted, `CMD.RUN` is issued to generate the
+ * next one, but only when more output is actually requested, so that output
+ * can be squeezed in arbitrary pieces.
+ *
+ * @param rate_words Keccak rate in 32-bit words.
+ * @param[in,out] offset Read position within the current state block.
+ * @param[out] digest Output buffer.
+ * @param digest_len_words Number of words to read.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_squeeze_words(size_t rate_words, size_t *offset,
+                                   uint32_t *digest, size_t digest_len_words) {
+  size_t idx = 0;
+  while (launder32(idx) < digest_len_words) {
+    // If the current block is exhausted, issue `CMD.RUN` to generate more
+    // state.
+    if (launder32(*offset) >= rate_words) {
+      HARDENED_CHECK_EQ(*offset, rate_words);
+      kmac_issue_cmd(KMAC_CMD_CMD_VALUE_RUN);
+      *offset = 0;
+    }
+
+    // Poll the status register until in the 'squeeze' state.
+    HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
+
+    // Read the two shares of the state and XOR them (either the remaining
+    // requested words or the rest of the current block).
+    for (; launder32(idx) < digest_len_words && *offset < rate_words;
+         ++*offset) {
+      uint32_t share0 =
+          abs_mmio_read32(kKmacStateShare0Addr + *offset * sizeof(uint32_t));
+      uint32_t share1 =
+          abs_mmio_read32(kKmacStateShare1Addr + *offset * sizeof(uint32_t));
+      digest[idx] = share0 ^ share1;
+      ++idx;
+    }
+  }
+  HARDENED_CHECK_EQ(idx, digest_len_words);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Release KMAC HWIP after squeezing, so that it goes back to idle mode.
+ *
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_squeeze_end(void) {
+  // Poll the status register until in the 'squeeze' state.
+  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
+  kmac_issue_cmd(KMAC_CMD_CMD_VALUE_DONE);
+  return OTCRYPTO_OK;
+}
+
 /**
  * Common routine for feeding message blocks during SHA/SHAKE/cSHAKE/KMAC.
  *
  * Before running this, the operation type must be configured with kmac_init.
  * Then, we can use this function to feed various bytes of data to the KMAC
- * core. Note that this is a one-shot implementation, and it does not support
- * streaming mode.
+ * core. Note that this is a one-shot implementation; see `kmac_xof_absorb` and
+ * `kmac_xof_squeeze` for streaming.
  *
  * This routine does not check input parameters for consistency. For instance,
  * one can invoke SHA-3_224 with digest_len=32, which will produce 256 bits of
@@ -609,37 +793,8 @@ static status_t kmac_process_msg_blocks(kmac_operation_t operation,
                                         const uint8_t *message,
                                         size_t message_len, uint32_t *digest,
                                         size_t digest_len_words) {
-  // Block until KMAC is idle.
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
-
-  // Issue the start command, so that messages written to MSG_FIFO are forwarded
-  // to Keccak
-  uint32_t cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_START);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_ABSORB_BIT, 1));
-
-  // Begin by writing a one byte at a time until the data is aligned.
-  size_t i = 0;
-  for (; misalignment32_of((uintptr_t)(&message[i])) > 0 && i < message_len;
-       i++) {
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
-    abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, message[i]);
-  }
-
-  // Write one word at a time as long as there is a full word available.
-  for (; i + sizeof(uint32_t) <= message_len; i += sizeof(uint32_t)) {
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
-    uint32_t next_word = read_32(&message[i]);
-    abs_mmio_write32(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, next_word);
-  }
-
-  // For the last few bytes, we need to write one byte at a time again.
-  for (; i < message_len; i++) {
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
-    abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, message[i]);
-  }
+  HARDENED_TRY(kmac_absorb_start());
+  HARDENED_TRY(kmac_msg_write(message, message_len));
 
   // If operation=KMAC, then we need to write `right_encode(digest->len)`
   if (operation == kKmacOperationKMAC) {
@@ -662,67 +817,15 @@ static status_t kmac_process_msg_blocks(kmac_operation_t operation,
   }
 
   // Issue the process command, so that squeezing phase can start
-  cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_PROCESS);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+  HARDENED_TRY(kmac_absorb_finish());
 
-  // Wait until squeezing is done
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
-
-  uint32_t cfg_reg =
-      abs_mmio_read32(kKmacBaseAddr + KMAC_CFG_SHADOWED_REG_OFFSET);
-  uint32_t keccak_str =
-      bitfield_field32_read(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD);
   size_t keccak_rate_words;
-  HARDENED_TRY(kmac_get_keccak_rate_words(keccak_str, &keccak_rate_words));
-
-  // Finally, we can read the two shares of digest and XOR them.
-  size_t idx = 0;
-
-  while (launder32(idx) < digest_len_words) {
-    // Since we always read in increments of the Keccak rate, the index at
-    // start should always be a multiple of the rate.
-    HARDENED_CHECK_EQ(idx % keccak_rate_words, 0);
+  HARDENED_TRY(kmac_rate_words_get(&keccak_rate_words));
 
-    // Poll the status register until in the 'squeeze' state.
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
-
-    // Read words from the state registers (either `digest_len_words` or the
-    // maximum number of words available).
-    size_t offset = 0;
-    for (; launder32(idx) < digest_len_words && offset < keccak_rate_words;
-         offset++) {
-      uint32_t share0 =
-          abs_mmio_read32(kKmacStateShare0Addr + offset * sizeof(uint32_t));
-      uint32_t share1 =
-          abs_mmio_read32(kKmacStateShare1Addr + offset * sizeof(uint32_t));
-      digest[idx] = share0 ^ share1;
-      ++idx;
-    }
-
-    // If we read all the remaining words and still need more digest, issue
-    // `CMD.RUN` to generate more state.
-    if (launder32(offset) == keccak_rate_words && idx < digest_len_words) {
-      HARDENED_CHECK_EQ(offset, keccak_rate_words);
-      cmd_reg = KMAC_CMD_REG_RESVAL;
-      cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                       KMAC_CMD_CMD_VALUE_RUN);
-      abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
-    }
-  }
-  HARDENED_CHECK_EQ(idx, digest_len_words);
-
-  // Poll the status register until in the 'squeeze' state.
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
-
-  // Release the KMAC core, so that it goes back to idle mode
-  cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_DONE);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
-
-  return OTCRYPTO_OK;
+  size_t offset = 0;
+  HARDENED_TRY(kmac_squeeze_words(keccak_rate_words, &offset, digest,
+                                  digest_len_words));
+  return kmac_squeeze_end();
 }
 
 status_t kmac_sha3_224(const uint8_t *message, size_t message_len,
@@ -868,3 +971,93 @@ status_t kmac_kmac_256(kmac_blinded_key_t *key, const uint8_t *message,
   return kmac_process_msg_blocks(kKmacOperationKMAC, message, message_len,
                                  digest, digest_len);
 }
+
+/**
+ * Start a streaming XOF operation once KMAC HWIP has been configured.
+ *
+ * @param[out] ctx Streaming context.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_xof_start(kmac_xof_ctx_t *ctx) {
+  HARDENED_TRY(kmac_rate_words_get(&ctx->rate_words));
+  ctx->squeeze_offset = 0;
+  ctx->squeezing = kHardenedBoolFalse;
+  return kmac_absorb_start();
+}
+
+status_t kmac_shake_128_start(kmac_xof_ctx_t *ctx) {
+  HARDENED_TRY(kmac_init(kKmacOperationSHAKE, kKmacSecurityStrength128,
+                         /*hw_backed=*/kHardenedBoolFalse));
+  return kmac_xof_start(ctx);
+}
+
+status_t kmac_shake_256_start(kmac_xof_ctx_t *ctx) {
+  HARDENED_TRY(kmac_init(kKmacOperationSHAKE, kKmacSecurityStrength256,
+                         /*hw_backed=*/kHardenedBoolFalse));
+  return kmac_xof_start(ctx);
+}
+
+status_t kmac_cshake_128_start(kmac_xof_ctx_t *ctx,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len) {
+  HARDENED_TRY(kmac_init(kKmacOperationCSHAKE, kKmacSecurityStrength128,
+                         /*hw_backed=*/kHardenedBoolFalse));
+  HARDENED_TRY(kmac_write_prefix_block(kKmacOperationCSHAKE, func_name,
+                                       func_name_len, cust_str, cust_str_len));
+  return kmac_xof_start(ctx);
+}
+
+status_t kmac_cshake_256_start(kmac_xof_ctx_t *ctx,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len) {
+  HARDENED_TRY(kmac_init(kKmacOperationCSHAKE, kKmacSecurityStrength256,
+                         /*hw_backed=*/kHardenedBoolFalse));
+  HARDENED_TRY(kmac_write_prefix_block(kKmacOperationCSHAKE, func_name,
+                                       func_name_len, cust_str, cust_str_len));
+  return kmac_xof_start(ctx);
+}
+
+status_t kmac_xof_absorb(kmac_xof_ctx_t *ctx, const uint8_t *message,
+                         size_t message_len) {
+  if (ctx == NULL || (message == NULL && message_len > 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  // No more input can be absorbed once output has been squeezed.
+  if (ctx->squeezing != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return kmac_msg_write(message, message_len);
+}
+
+status_t kmac_xof_squeeze(kmac_xof_ctx_t *ctx, uint32_t *digest,
+                          size_t digest_len) {
+  if (ctx == NULL || (digest == NULL && digest_len > 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (launder32(ctx->squeezing) == kHardenedBoolFalse) {
+    HARDENED_CHECK_EQ(ctx->squeezing, kHardenedBoolFalse);
+    HARDENED_TRY(kmac_absorb_finish());
+    ctx->squeezing = kHardenedBoolTrue;
+  }
+  HARDENED_CHECK_EQ(ctx->squeezing, kHardenedBoolTrue);
+  return kmac_squeeze_words(ctx->rate_words, &ctx->squeeze_offset, digest,
+                            digest_len);
+}
+
+status_t kmac_xof_end(kmac_xof_ctx_t *ctx) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  // The hardware only returns to idle from the squeeze state.
+  if (ctx->squeezing == kHardenedBoolFalse) {
+    HARDENED_TRY(kmac_absorb_finish());
+  }
+  ctx->squeezing = kHardenedBoolFalse;
+  ctx->squeeze_offset = 0;
+  return kmac_squeeze_end();
+}
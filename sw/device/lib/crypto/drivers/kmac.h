@@ -57,6 +57,21 @@ typedef struct kmac_blinded_key {
   hardened_bool_t hw_backed;
 } kmac_blinded_key_t;
 
+/**
+ * State of a streaming SHAKE/cSHAKE operation.
+ *
+ * KMAC HWIP cannot save and restore its Keccak state, so a streaming operation
+ * owns the hardware from `kmac_*_start` until `kmac_xof_end`.
+ */
+typedef struct kmac_xof_ctx {
+  // Keccak rate of the operation in 32-bit words.
+  size_t rate_words;
+  // Number of words of the current state block that were already output.
+  size_t squeeze_offset;
+  // Whether absorbing has finished and output is being squeezed.
+  hardened_bool_t squeezing;
+} kmac_xof_ctx_t;
+
 /**
  * Check whether given key length is valid for KMAC.
 
@@ -285,6 +300,97 @@ status_t kmac_kmac_256(kmac_blinded_key_t *key, const uint8_t *message,
                        size_t cust_str_len, uint32_t *digest,
                        size_t digest_len);
 
+/**
+ * Start a streaming SHAKE-128 operation.
+ *
+ * @param[out] ctx Streaming context.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_shake_128_start(kmac_xof_ctx_t *ctx);
+
+/**
+ * Start a streaming SHAKE-256 operation.
+ *
+ * @param[out] ctx Streaming context.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_shake_256_start(kmac_xof_ctx_t *ctx);
+
+/**
+ * Start a streaming CSHAKE-128 operation.
+ *
+ * @param[out] ctx Streaming context.
+ * @param func_name The function name.
+ * @param func_name_len The function name length in bytes.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_cshake_128_start(kmac_xof_ctx_t *ctx,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len);
+
+/**
+ * Start a streaming CSHAKE-256 operation.
+ *
+ * @param[out] ctx Streaming context.
+ * @param func_name The function name.
+ * @param func_name_len The function name length in bytes.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_cshake_256_start(kmac_xof_ctx_t *ctx,
+                               const unsigned char *func_name,
+                               size_t func_name_len,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len);
+
+/**
+ * Absorb more message bytes into a streaming operation.
+ *
+ * May be called any number of times before the first `kmac_xof_squeeze`.
+ *
+ * @param ctx Streaming context.
+ * @param message The input message.
+ * @param message_len The input message length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_xof_absorb(kmac_xof_ctx_t *ctx, const uint8_t *message,
+                         size_t message_len);
+
+/**
+ * Squeeze output words from a streaming operation.
+ *
+ * The first call finishes absorbing. Later calls continue the output stream
+ * where the previous call stopped, so the output can be read in pieces of any
+ * length.
+ *
+ * @param ctx Streaming context.
+ * @param[out] digest Output buffer for the result.
+ * @param digest_len Requested output length in 32-bit words.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_xof_squeeze(kmac_xof_ctx_t *ctx, uint32_t *digest,
+                          size_t digest_len);
+
+/**
+ * End a streaming operation and release KMAC HWIP.
+ *
+ * @param ctx Streaming context.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_xof_end(kmac_xof_ctx_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,6 +63,78 @@ typedef enum otbn_status {
   kOtbnStatusLocked = 0xFF,
 } otbn_status_t;
 
+/**
+ * Record of the application currently resident in OTBN's IMEM.
+ *
+ * OTBN keeps IMEM intact across executions; it is only lost on an IMEM secure
+ * wipe or a fatal error (which also wipes IMEM and locks OTBN). Tracking the
+ * resident application lets `otbn_load_app` skip rewriting IMEM when the same
+ * application is loaded again.
+ */
+typedef struct otbn_resident_app {
+  /**
+   * Whether IMEM holds the application described below.
+   */
+  hardened_bool_t valid;
+  /**
+   * Start of the resident application's IMEM image.
+   */
+  const uint32_t *imem_start;
+  /**
+   * End of the resident application's IMEM image.
+   */
+  const uint32_t *imem_end;
+  /**
+   * Expected LOAD_CHECKSUM for the full application (IMEM and DMEM data).
+   */
+  uint32_t checksum;
+  /**
+   * Value of LOAD_CHECKSUM after the IMEM image was written.
+   *
+   * Restoring this value on a reload lets the DMEM data writes extend the CRC
+   * exactly as they would after a full load, so the full-application checksum
+   * can still be verified.
+   */
+  uint32_t imem_checksum;
+} otbn_resident_app_t;
+
+static otbn_resident_app_t resident_app = {
+    .valid = kHardenedBoolFalse,
+};
+
+/**
+ * Number of DMEM wipes issued so far; see `otbn_dmem_epoch_get`.
+ */
+static uint32_t dmem_epoch = 0;
+
+/**
+ * Forgets the application currently resident in IMEM.
+ */
+static void otbn_resident_app_clear(void) {
+  resident_app.valid = kHardenedBoolFalse;
+  resident_app.imem_start = NULL;
+  resident_app.imem_end = NULL;
+}
+
+/**
+ * Checks whether `app` is the application currently resident in IMEM.
+ *
+ * @param app The application to check.
+ * @return `kHardenedBoolTrue` if `app` is resident, `kHardenedBoolFalse`
+ * otherwise.
+ */
+static hardened_bool_t otbn_resident_app_matches(const otbn_app_t *app) {
+  if (launder32(resident_app.valid) == kHardenedBoolTrue &&
+      resident_app.imem_start == app->imem_start &&
+      resident_app.imem_end == app->imem_end &&
+      launder32(resident_app.checksum) == app->checksum) {
+    HARDENED_CHECK_EQ(resident_app.valid, kHardenedBoolTrue);
+    HARDENED_CHECK_EQ(resident_app.checksum, app->checksum);
+    return kHardenedBoolTrue;
+  }
+  return kHardenedBoolFalse;
+}
+
 /**
  * Ensures that a memory access fits within the given memory size.
  *
@@ -180,22 +252,34 @@ status_t otbn_execute(void) {
   // Ensure OTBN is idle before attempting to run a command.
   HARDENED_TRY(otbn_assert_idle());
 
+  // Clear any stale done interrupt so that it signals this execution only.
+  abs_mmio_write32(kBase + OTBN_INTR_STATE_REG_OFFSET,
+                   1 << OTBN_INTR_COMMON_DONE_BIT);
+
   abs_mmio_write32(kBase + OTBN_CMD_REG_OFFSET, kOtbnCmdExecute);
   return OTCRYPTO_OK;
 }
 
-status_t otbn_busy_wait_for_done(void) {
-  uint32_t status = launder32(UINT32_MAX);
+/**
+ * Computes the result of an OTBN operation that is no longer running.
+ *
+ * @param status Value of the STATUS register; must be idle or locked.
+ * @return `OTCRYPTO_OK` on success, `OTCRYPTO_RECOV_ERR` if OTBN is idle but
+ * reported an error, `OTCRYPTO_FATAL_ERR` if OTBN is locked.
+ */
+static status_t otbn_done_result(uint32_t status) {
   status_t res = (status_t){
-      .value = (int32_t)launder32((uint32_t)kHardenedBoolTrue ^ status)};
-  do {
-    status = abs_mmio_read32(kBase + OTBN_STATUS_REG_OFFSET);
-  } while (launder32(status) != kOtbnStatusIdle &&
-           launder32(status) != kOtbnStatusLocked);
+      .value = (int32_t)launder32((uint32_t)kHardenedBoolTrue ^ UINT32_MAX)};
   res.value ^= ~status;
 
   uint32_t err_bits = otbn_err_bits_get();
 
+  // Do not trust IMEM contents after any error; a fatal error wipes it.
+  if (launder32(OT_UNSIGNED(res.value)) != kHardenedBoolTrue ||
+      launder32(err_bits) != kOtbnErrBitsNoError) {
+    otbn_resident_app_clear();
+  }
+
   if (launder32(OT_UNSIGNED(res.value)) == kHardenedBoolTrue &&
       launder32(err_bits) == kOtbnErrBitsNoError) {
     HARDENED_CHECK_EQ(res.value, kHardenedBoolTrue);
@@ -217,6 +301,34 @@ status_t otbn_busy_wait_for_done(void) {
   return OTCRYPTO_FATAL_ERR;
 }
 
+status_t otbn_busy_wait_for_done(void) {
+  uint32_t status;
+  do {
+    status = abs_mmio_read32(kBase + OTBN_STATUS_REG_OFFSET);
+  } while (launder32(status) != kOtbnStatusIdle &&
+           launder32(status) != kOtbnStatusLocked);
+  return otbn_done_result(status);
+}
+
+status_t otbn_poll_done(void) {
+  uint32_t status = abs_mmio_read32(kBase + OTBN_STATUS_REG_OFFSET);
+  if (launder32(status) != kOtbnStatusIdle &&
+      launder32(status) != kOtbnStatusLocked) {
+    return OTCRYPTO_ASYNC_INCOMPLETE;
+  }
+
+  // Acknowledge the done interrupt (`INTR_STATE` is rw1c).
+  abs_mmio_write32(kBase + OTBN_INTR_STATE_REG_OFFSET,
+                   1 << OTBN_INTR_COMMON_DONE_BIT);
+  return otbn_done_result(status);
+}
+
+void otbn_done_irq_set_enabled(bool enable) {
+  uint32_t reg = abs_mmio_read32(kBase + OTBN_INTR_ENABLE_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, OTBN_INTR_COMMON_DONE_BIT, enable);
+  abs_mmio_write32(kBase + OTBN_INTR_ENABLE_REG_OFFSET, reg);
+}
+
 uint32_t otbn_err_bits_get(void) {
   return abs_mmio_read32(kBase + OTBN_ERR_BITS_REG_OFFSET);
 }
@@ -228,6 +340,7 @@ uint32_t otbn_instruction_count_get(void) {
 status_t otbn_imem_sec_wipe(void) {
   HARDENED_TRY(entropy_complex_check());
   HARDENED_TRY(otbn_assert_idle());
+  otbn_resident_app_clear();
   abs_mmio_write32(kBase + OTBN_CMD_REG_OFFSET, kOtbnCmdSecWipeImem);
   HARDENED_TRY(otbn_busy_wait_for_done());
   return OTCRYPTO_OK;
@@ -236,11 +349,16 @@ status_t otbn_imem_sec_wipe(void) {
 status_t otbn_dmem_sec_wipe(void) {
   HARDENED_TRY(entropy_complex_check());
   HARDENED_TRY(otbn_assert_idle());
+  ++dmem_epoch;
   abs_mmio_write32(kBase + OTBN_CMD_REG_OFFSET, kOtbnCmdSecWipeDmem);
   HARDENED_TRY(otbn_busy_wait_for_done());
   return OTCRYPTO_OK;
 }
 
+uint32_t otbn_dmem_epoch_get(void) {
+  return dmem_epoch;
+}
+
 status_t otbn_set_ctrl_software_errs_fatal(bool enable) {
   // Ensure OTBN is idle (otherwise CTRL writes will be ignored).
   HARDENED_TRY(otbn_assert_idle());
@@ -296,12 +414,6 @@ status_t otbn_load_app(const otbn_app_t app) {
   const size_t data_num_words =
       (size_t)(app.dmem_data_end - app.dmem_data_start);
 
-  HARDENED_TRY(otbn_imem_sec_wipe());
-  HARDENED_TRY(otbn_dmem_sec_wipe());
-
-  // Reset the LOAD_CHECKSUM register.
-  abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
-
   // Ensure that the IMEM section fits in IMEM and the data section fits in
   // DMEM.
   HARDENED_TRY(check_offset_len(app.dmem_data_start_addr, data_num_words,
@@ -311,13 +423,36 @@ status_t otbn_load_app(const otbn_app_t app) {
   otbn_addr_t imem_offset = 0;
   HARDENED_TRY(
       check_offset_len(imem_offset, imem_num_words, kOtbnIMemSizeBytes));
-  uint32_t imem_start_addr = kBase + OTBN_IMEM_REG_OFFSET + imem_offset;
+
+  // DMEM may hold secrets from the previous operation, so it is always wiped.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
   uint32_t i = 0;
-  for (; launder32(i) < imem_num_words; i++) {
-    HARDENED_CHECK_LT(i, imem_num_words);
-    abs_mmio_write32(imem_start_addr + i * sizeof(uint32_t), app.imem_start[i]);
+  if (otbn_resident_app_matches(&app) == kHardenedBoolTrue) {
+    // The application is already resident: skip the IMEM wipe and rewrite,
+    // and resume the checksum from where the original IMEM load left it.
+    abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET,
+                     resident_app.imem_checksum);
+  } else {
+    HARDENED_TRY(otbn_imem_sec_wipe());
+
+    // Reset the LOAD_CHECKSUM register.
+    abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
+
+    uint32_t imem_start_addr = kBase + OTBN_IMEM_REG_OFFSET + imem_offset;
+    for (; launder32(i) < imem_num_words; i++) {
+      HARDENED_CHECK_LT(i, imem_num_words);
+      abs_mmio_write32(imem_start_addr + i * sizeof(uint32_t),
+                       app.imem_start[i]);
+    }
+    HARDENED_CHECK_EQ(i, imem_num_words);
+
+    resident_app.imem_start = app.imem_start;
+    resident_app.imem_end = app.imem_end;
+    resident_app.checksum = app.checksum;
+    resident_app.imem_checksum =
+        abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   }
-  HARDENED_CHECK_EQ(i, imem_num_words);
 
   // Write the data portion to DMEM.
   otbn_addr_t data_offset = app.dmem_data_start_addr;
@@ -335,9 +470,11 @@ status_t otbn_load_app(const otbn_app_t app) {
   // Ensure that the checksum matches expectations.
   uint32_t checksum = abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   if (launder32(checksum) != app.checksum) {
+    otbn_resident_app_clear();
     return OTCRYPTO_FATAL_ERR;
   }
   HARDENED_CHECK_EQ(checksum, app.checksum);
+  resident_app.valid = kHardenedBoolTrue;
 
   return OTCRYPTO_OK;
 }
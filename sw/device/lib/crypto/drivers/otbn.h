@@ -255,6 +255,27 @@ status_t otbn_execute(void);
  */
 status_t otbn_busy_wait_for_done(void);
 
+/**
+ * Checks whether OTBN has finished the current operation without blocking.
+ *
+ * Returns `OTCRYPTO_ASYNC_INCOMPLETE` while OTBN is still busy. Once OTBN is
+ * idle or locked, acknowledges the done interrupt and returns the same result
+ * as `otbn_busy_wait_for_done()`.
+ *
+ * @return Result of the operation.
+ */
+status_t otbn_poll_done(void);
+
+/**
+ * Enables or disables OTBN's done interrupt.
+ *
+ * The interrupt is cleared whenever an execution starts and acknowledged by
+ * `otbn_poll_done()`, so it only signals completion of the current operation.
+ *
+ * @param enable Whether the done interrupt should be enabled.
+ */
+void otbn_done_irq_set_enabled(bool enable);
+
 /**
  * Get the error bits set by the device if the operation failed.
  *
@@ -298,6 +319,17 @@ status_t otbn_imem_sec_wipe(void);
  */
 status_t otbn_dmem_sec_wipe(void);
 
+/**
+ * Returns a value that changes whenever DMEM is wiped.
+ *
+ * DMEM is wiped on every `otbn_load_app`, so callers that keep state in DMEM
+ * across several OTBN runs can compare this value with the one taken after
+ * their own load to tell whether that state is still there.
+ *
+ * @return The current DMEM epoch.
+ */
+uint32_t otbn_dmem_epoch_get(void);
+
 /**
  * Sets the software errors are fatal bit in the control register.
  *
@@ -317,6 +349,12 @@ status_t otbn_set_ctrl_software_errs_fatal(bool enable);
  * Load the application image with both instruction and data segments into
  * OTBN.
  *
+ * DMEM is always securely wiped before the data segment is written. If the
+ * same application is already resident in IMEM (i.e. it was the last one
+ * loaded and IMEM has not been wiped or invalidated by an error since), the
+ * IMEM wipe and rewrite are skipped; the load checksum is still verified over
+ * the full application.
+ *
  * This function will return an error if called when OTBN is not idle.
  *
  * @param ctx The context object.
@@ -8,6 +8,7 @@
 #include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/math.h"
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/profiler.h"
 #include "sw/device/lib/crypto/drivers/aes.h"
 #include "sw/device/lib/crypto/drivers/keymgr.h"
 #include "sw/device/lib/crypto/impl/aes_gcm/aes_gcm.h"
@@ -47,6 +48,10 @@ static_assert(sizeof(aes_gcm_context_t) % sizeof(uint32_t) == 0,
               "size for use with `hardened_memcpy`.");
 enum {
   kAesGcmContextNumWords = sizeof(aes_gcm_context_t) / sizeof(uint32_t),
+  /**
+   * Number of blocks that `otcrypto_aes` passes to the AES driver at once.
+   */
+  kAesBatchNumBlocks = 4,
 };
 
 /**
@@ -292,6 +297,7 @@ otcrypto_status_t otcrypto_aes(const otcrypto_blinded_key_t *key,
                                otcrypto_const_byte_buf_t cipher_input,
                                otcrypto_aes_padding_t aes_padding,
                                otcrypto_byte_buf_t cipher_output) {
+  PROFILER_SCOPE("otcrypto_aes");
   // Check for NULL pointers in input pointers and data buffers.
   if (key == NULL || (aes_mode != kOtcryptoAesModeEcb && iv.data == NULL) ||
       cipher_input.data == NULL || cipher_output.data == NULL) {
@@ -355,41 +361,51 @@ otcrypto_status_t otcrypto_aes(const otcrypto_blinded_key_t *key,
       return OTCRYPTO_BAD_ARGS;
   }
 
-  // Perform the cipher operation for all full blocks (excluding last block).
-  // The input and output are offset by one, so if unrolled this loop would
-  // look like:
-  //   aes_update(NULL, input[0]);
-  //   aes_update(output[0], input[1]);
-  //   aes_update(output[1], input[2]);
-  //   ...
-  // See the AES driver for details.
-  aes_block_t block_in;
-  aes_block_t block_out;
-  size_t i;
-  for (i = 0; launder32(i) < input_nblocks; i++) {
-    HARDENED_TRY(get_block(cipher_input, aes_padding, i, &block_in));
-
-    // Call the AES cipher and copy data to output buffer if needed.
-    if (launder32(i) == 0) {
-      HARDENED_CHECK_EQ(i, 0);
-      HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
-    } else {
-      HARDENED_TRY(aes_update(&block_out, &block_in));
-      // TODO(#17711) Change to `hardened_memcpy`.
-      memcpy(&cipher_output.data[(i - 1) * kAesBlockNumBytes], block_out.data,
-             kAesBlockNumBytes);
+  // Perform the cipher operation in batches of blocks, which keeps the AES
+  // input/output double buffer full within each batch. See the AES driver for
+  // details.
+  aes_block_t blocks[kAesBatchNumBlocks];
+  size_t i = 0;
+
+  // If both buffers are word-aligned, the full (unpadded) input blocks can be
+  // streamed between the caller's buffers and the hardware without staging
+  // them in `blocks`. The driver allows in-place operation but no other
+  // overlap, so partially overlapping buffers take the staged path below.
+  size_t num_full_blocks = cipher_input.len / kAesBlockNumBytes;
+  const uint8_t *input_end = cipher_input.data + cipher_input.len;
+  const uint8_t *output_end = cipher_output.data + cipher_output.len;
+  bool buffers_disjoint = cipher_input.data == cipher_output.data ||
+                          input_end <= cipher_output.data ||
+                          output_end <= cipher_input.data;
+  if (misalignment32_of((uintptr_t)cipher_input.data) == 0 &&
+      misalignment32_of((uintptr_t)cipher_output.data) == 0 &&
+      buffers_disjoint && num_full_blocks > 0) {
+    HARDENED_TRY(aes_update_blocks((aes_block_t *)cipher_output.data,
+                                   (const aes_block_t *)cipher_input.data,
+                                   num_full_blocks));
+    i = num_full_blocks;
+  }
+
+  while (launder32(i) < input_nblocks) {
+    size_t batch_nblocks = input_nblocks - i;
+    if (batch_nblocks > kAesBatchNumBlocks) {
+      batch_nblocks = kAesBatchNumBlocks;
+    }
+    for (size_t j = 0; j < batch_nblocks; j++) {
+      HARDENED_TRY(get_block(cipher_input, aes_padding, i + j, &blocks[j]));
     }
+
+    // Call the AES cipher and copy data to the output buffer.
+    HARDENED_TRY(aes_update_blocks(blocks, blocks, batch_nblocks));
+    // TODO(#17711) Change to `hardened_memcpy`.
+    memcpy(&cipher_output.data[i * kAesBlockNumBytes], blocks,
+           batch_nblocks * kAesBlockNumBytes);
+    i += batch_nblocks;
   }
 
   // Check that the loop ran for the correct number of iterations.
   HARDENED_CHECK_EQ(i, input_nblocks);
 
-  // Retrieve the output from the final block (providing no input).
-  HARDENED_TRY(aes_update(&block_out, /*src=*/NULL));
-  // TODO(#17711) Change to `hardened_memcpy`.
-  memcpy(&cipher_output.data[(input_nblocks - 1) * kAesBlockNumBytes],
-         block_out.data, kAesBlockNumBytes);
-
   // Deinitialize the AES block and update the IV (in ECB mode, skip the IV).
   if (aes_mode == launder32(kAesCipherModeEcb)) {
     HARDENED_TRY(aes_end(NULL));
@@ -71,20 +71,117 @@ static status_t aes_encrypt_block(const aes_key_t key, const aes_block_t *iv,
 }
 
 /**
- * Run GCTR on exactly one block of input.
+ * Fetch the next GCTR input block.
+ *
+ * Takes `*first` if it is non-null (and clears it), otherwise copies the next
+ * block from the byte buffer `*input` and advances it.
+ *
+ * @param[in,out] first Optional first block.
+ * @param[in,out] input Input buffer for the remaining blocks.
+ * @param[out] block Destination block.
+ */
+static inline void gctr_next_block(const aes_block_t **first,
+                                   const uint8_t **input, aes_block_t *block) {
+  if (*first != NULL) {
+    memcpy(block->data, (*first)->data, kAesBlockNumBytes);
+    *first = NULL;
+  } else {
+    memcpy(block->data, *input, kAesBlockNumBytes);
+    *input += kAesBlockNumBytes;
+  }
+}
+
+/**
+ * Run GCTR on a run of full blocks in a single AES hardware session.
+ *
+ * The AES block runs in CTR mode, so it encrypts the counter, XORs the result
+ * with the input and increments the counter by itself. The key and IV are
+ * written only once, and the input is kept one block ahead of the output so
+ * that the next block is loaded while the previous one is being read.
+ *
+ * The hardware increments the full 128-bit counter, while GCTR only increments
+ * the last 32 bits, so the run must not wrap the last word of the IV.
  *
  * Updates the IV in-place.
  *
  * @param key The AES key
  * @param iv Initialization vector, 128 bits
- * @param input Input block
- * @param[out] output Output block
+ * @param[in,out] first Optional first input block, cleared once consumed.
+ * @param[in,out] input Input buffer for the remaining blocks, advanced.
+ * @param num_blocks Number of blocks in the run (nonzero).
+ * @param[out] output Output buffer, `num_blocks` blocks long.
  */
 OT_WARN_UNUSED_RESULT
-static status_t gctr_process_block(const aes_key_t key, aes_block_t *iv,
-                                   aes_block_t *input, aes_block_t *output) {
-  HARDENED_TRY(aes_encrypt_block(key, iv, input, output));
-  block_inc32(iv);
+static status_t gctr_process_run(const aes_key_t key, aes_block_t *iv,
+                                 const aes_block_t **first,
+                                 const uint8_t **input, size_t num_blocks,
+                                 uint8_t *output) {
+  HARDENED_TRY(aes_encrypt_begin(key, iv));
+
+  // Fill both the AES core and the input buffer.
+  aes_block_t block_in;
+  size_t num_loaded = 0;
+  for (; num_loaded < num_blocks && num_loaded < 2; ++num_loaded) {
+    gctr_next_block(first, input, &block_in);
+    HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
+  }
+
+  // Read each output block, then feed the hardware the next input.
+  aes_block_t block_out;
+  for (size_t i = 0; i < num_blocks; ++i) {
+    const aes_block_t *src = NULL;
+    if (num_loaded < num_blocks) {
+      gctr_next_block(first, input, &block_in);
+      src = &block_in;
+      ++num_loaded;
+    }
+    HARDENED_TRY(aes_update(&block_out, src));
+    memcpy(output, block_out.data, kAesBlockNumBytes);
+    output += kAesBlockNumBytes;
+  }
+  HARDENED_CHECK_EQ(num_loaded, num_blocks);
+  HARDENED_TRY(aes_end(NULL));
+
+  // Apply inc32() `num_blocks` times.
+  iv->data[kAesBlockNumWords - 1] = __builtin_bswap32(
+      __builtin_bswap32(iv->data[kAesBlockNumWords - 1]) +
+      (uint32_t)num_blocks);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Run GCTR on full blocks of input.
+ *
+ * Splits the input into runs that do not wrap the last 32 bits of the counter
+ * and processes each run in one hardware session.
+ *
+ * Updates the IV in-place.
+ *
+ * @param key The AES key
+ * @param iv Initialization vector, 128 bits
+ * @param first Optional first input block (may be NULL)
+ * @param input Input buffer for the remaining blocks
+ * @param num_blocks Number of blocks, including `first`
+ * @param[out] output Output buffer, `num_blocks` blocks long
+ */
+OT_WARN_UNUSED_RESULT
+static status_t gctr_process_blocks(const aes_key_t key, aes_block_t *iv,
+                                    const aes_block_t *first,
+                                    const uint8_t *input, size_t num_blocks,
+                                    uint8_t *output) {
+  while (num_blocks > 0) {
+    size_t run_blocks = num_blocks;
+    // Number of counter values left before the last word wraps, or zero if
+    // all 2^32 are left.
+    uint32_t until_wrap =
+        0u - __builtin_bswap32(iv->data[kAesBlockNumWords - 1]);
+    if (until_wrap != 0 && run_blocks > until_wrap) {
+      run_blocks = until_wrap;
+    }
+    HARDENED_TRY(gctr_process_run(key, iv, &first, &input, run_blocks, output));
+    output += run_blocks * kAesBlockNumBytes;
+    num_blocks -= run_blocks;
+  }
   return OTCRYPTO_OK;
 }
 
@@ -138,23 +235,13 @@ static status_t aes_gcm_gctr(const aes_key_t key, aes_block_t *iv,
     input += kAesBlockNumBytes - partial_len;
     input_len -= kAesBlockNumBytes - partial_len;
 
-    // Process the block.
-    aes_block_t block_out;
-    HARDENED_TRY(gctr_process_block(key, iv, partial, &block_out));
-    memcpy(output, block_out.data, kAesBlockNumBytes);
-    output += kAesBlockNumBytes;
-    *output_len = kAesBlockNumBytes;
-
-    // Process any remaining full blocks of input.
-    while (input_len >= kAesBlockNumBytes) {
-      memcpy(partial->data, input, kAesBlockNumBytes);
-      HARDENED_TRY(gctr_process_block(key, iv, partial, &block_out));
-      memcpy(output, block_out.data, kAesBlockNumBytes);
-      output += kAesBlockNumBytes;
-      *output_len += kAesBlockNumBytes;
-      input += kAesBlockNumBytes;
-      input_len -= kAesBlockNumBytes;
-    }
+    // Process the block along with any remaining full blocks of input.
+    size_t num_blocks = 1 + input_len / kAesBlockNumBytes;
+    HARDENED_TRY(
+        gctr_process_blocks(key, iv, partial, input, num_blocks, output));
+    *output_len = num_blocks * kAesBlockNumBytes;
+    input += (num_blocks - 1) * kAesBlockNumBytes;
+    input_len -= (num_blocks - 1) * kAesBlockNumBytes;
 
     // Copy any remaining input into the partial block.
     memcpy(partial->data, input, input_len);
@@ -477,8 +564,10 @@ status_t aes_gcm_final(aes_gcm_context_t *ctx, size_t tag_len, uint32_t *tag,
     memset(partial_aes_block_bytes + partial_aes_block_len, 0,
            kAesBlockNumBytes - partial_aes_block_len);
     aes_block_t block_out;
-    HARDENED_TRY(gctr_process_block(ctx->key, &ctx->gctr_iv,
-                                    &ctx->partial_aes_block, &block_out));
+    HARDENED_TRY(gctr_process_blocks(ctx->key, &ctx->gctr_iv,
+                                     &ctx->partial_aes_block, /*input=*/NULL,
+                                     /*num_blocks=*/1,
+                                     (unsigned char *)block_out.data));
     memcpy(output, block_out.data, partial_aes_block_len);
     *output_len = partial_aes_block_len;
   }
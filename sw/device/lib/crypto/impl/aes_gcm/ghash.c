@@ -26,6 +26,7 @@ enum {
 static_assert(kGhashBlockNumBytes == (1 << kGhashBlockLog2NumBytes),
               "kGhashBlockLog2NumBytes does not match kGhashBlockNumBytes");
 
+#ifndef OT_GHASH_CLMUL
 /**
  * Precomputed modular reduction constants for Galois field multiplication.
  *
@@ -49,6 +50,48 @@ static const uint16_t kGFReduceTable[16] = {
     0x0000, 0x201c, 0x4038, 0x6024, 0x8070, 0xa06c, 0xc048, 0xe054,
     0x00e1, 0x20fd, 0x40d9, 0x60c5, 0x8091, 0xa08d, 0xc0a9, 0xe0b5};
 
+/**
+ * Precomputed modular reduction constants for 8-bit windows.
+ *
+ * Same as `kGFReduceTable`, for the 8 bits that overflow when a field element
+ * is multiplied by x^8. The bytes here represent 16-bit little-endian values.
+ */
+static const uint16_t kGFReduceTable8[256] = {
+    0x0000, 0xc201, 0x8403, 0x4602, 0x0807, 0xca06, 0x8c04, 0x4e05,
+    0x100e, 0xd20f, 0x940d, 0x560c, 0x1809, 0xda08, 0x9c0a, 0x5e0b,
+    0x201c, 0xe21d, 0xa41f, 0x661e, 0x281b, 0xea1a, 0xac18, 0x6e19,
+    0x3012, 0xf213, 0xb411, 0x7610, 0x3815, 0xfa14, 0xbc16, 0x7e17,
+    0x4038, 0x8239, 0xc43b, 0x063a, 0x483f, 0x8a3e, 0xcc3c, 0x0e3d,
+    0x5036, 0x9237, 0xd435, 0x1634, 0x5831, 0x9a30, 0xdc32, 0x1e33,
+    0x6024, 0xa225, 0xe427, 0x2626, 0x6823, 0xaa22, 0xec20, 0x2e21,
+    0x702a, 0xb22b, 0xf429, 0x3628, 0x782d, 0xba2c, 0xfc2e, 0x3e2f,
+    0x8070, 0x4271, 0x0473, 0xc672, 0x8877, 0x4a76, 0x0c74, 0xce75,
+    0x907e, 0x527f, 0x147d, 0xd67c, 0x9879, 0x5a78, 0x1c7a, 0xde7b,
+    0xa06c, 0x626d, 0x246f, 0xe66e, 0xa86b, 0x6a6a, 0x2c68, 0xee69,
+    0xb062, 0x7263, 0x3461, 0xf660, 0xb865, 0x7a64, 0x3c66, 0xfe67,
+    0xc048, 0x0249, 0x444b, 0x864a, 0xc84f, 0x0a4e, 0x4c4c, 0x8e4d,
+    0xd046, 0x1247, 0x5445, 0x9644, 0xd841, 0x1a40, 0x5c42, 0x9e43,
+    0xe054, 0x2255, 0x6457, 0xa656, 0xe853, 0x2a52, 0x6c50, 0xae51,
+    0xf05a, 0x325b, 0x7459, 0xb658, 0xf85d, 0x3a5c, 0x7c5e, 0xbe5f,
+    0x00e1, 0xc2e0, 0x84e2, 0x46e3, 0x08e6, 0xcae7, 0x8ce5, 0x4ee4,
+    0x10ef, 0xd2ee, 0x94ec, 0x56ed, 0x18e8, 0xdae9, 0x9ceb, 0x5eea,
+    0x20fd, 0xe2fc, 0xa4fe, 0x66ff, 0x28fa, 0xeafb, 0xacf9, 0x6ef8,
+    0x30f3, 0xf2f2, 0xb4f0, 0x76f1, 0x38f4, 0xfaf5, 0xbcf7, 0x7ef6,
+    0x40d9, 0x82d8, 0xc4da, 0x06db, 0x48de, 0x8adf, 0xccdd, 0x0edc,
+    0x50d7, 0x92d6, 0xd4d4, 0x16d5, 0x58d0, 0x9ad1, 0xdcd3, 0x1ed2,
+    0x60c5, 0xa2c4, 0xe4c6, 0x26c7, 0x68c2, 0xaac3, 0xecc1, 0x2ec0,
+    0x70cb, 0xb2ca, 0xf4c8, 0x36c9, 0x78cc, 0xbacd, 0xfccf, 0x3ece,
+    0x8091, 0x4290, 0x0492, 0xc693, 0x8896, 0x4a97, 0x0c95, 0xce94,
+    0x909f, 0x529e, 0x149c, 0xd69d, 0x9898, 0x5a99, 0x1c9b, 0xde9a,
+    0xa08d, 0x628c, 0x248e, 0xe68f, 0xa88a, 0x6a8b, 0x2c89, 0xee88,
+    0xb083, 0x7282, 0x3480, 0xf681, 0xb884, 0x7a85, 0x3c87, 0xfe86,
+    0xc0a9, 0x02a8, 0x44aa, 0x86ab, 0xc8ae, 0x0aaf, 0x4cad, 0x8eac,
+    0xd0a7, 0x12a6, 0x54a4, 0x96a5, 0xd8a0, 0x1aa1, 0x5ca3, 0x9ea2,
+    0xe0b5, 0x22b4, 0x64b6, 0xa6b7, 0xe8b2, 0x2ab3, 0x6cb1, 0xaeb0,
+    0xf0bb, 0x32ba, 0x74b8, 0xb6b9, 0xf8bc, 0x3abd, 0x7cbf, 0xbebe,
+};
+#endif  // OT_GHASH_CLMUL
+
 /**
  * Performs a bitwise XOR of two blocks.
  *
@@ -103,6 +146,20 @@ static inline uint8_t block_byte_get(const ghash_block_t *block, size_t index) {
   return ((char *)block->data)[index];
 }
 
+#ifdef OT_GHASH_CLMUL
+/**
+ * Reverse the bits of each byte of a word.
+ *
+ * @param word Input word.
+ * @return `word` with the bits of each byte reversed.
+ */
+static inline uint32_t brev8(uint32_t word) {
+  word = ((word >> 1) & 0x55555555) | ((word & 0x55555555) << 1);
+  word = ((word >> 2) & 0x33333333) | ((word & 0x33333333) << 2);
+  return ((word >> 4) & 0x0f0f0f0f) | ((word & 0x0f0f0f0f) << 4);
+}
+#endif  // OT_GHASH_CLMUL
+
 /**
  * Multiply an element of the GCM Galois field by the polynomial `x`.
  *
@@ -126,6 +183,7 @@ static inline void galois_mulx(const ghash_block_t *p, ghash_block_t *out) {
   out->data[0] ^= (0xe1 & mask);
 }
 
+#ifndef OT_GHASH_CLMUL
 /**
  * Reverse the bits of a 4-bit number.
  *
@@ -142,12 +200,21 @@ static uint8_t reverse_bits(uint8_t byte) {
   }
   return out;
 }
+#endif  // OT_GHASH_CLMUL
 
 void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx) {
-  // Initialize 0 * H = 0.
-  memset(ctx->tbl[0].data, 0, kGhashBlockNumBytes);
   // Initialize 1 * H = H.
   memcpy(ctx->tbl[0x8].data, hash_subkey, kGhashBlockNumBytes);
+  ctx->tbl8 = NULL;
+
+#ifdef OT_GHASH_CLMUL
+  // The carry-less multiply backend only needs H, in its own bit order.
+  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
+    ctx->tbl[0].data[i] = brev8(hash_subkey[i]);
+  }
+#else
+  // Initialize 0 * H = 0.
+  memset(ctx->tbl[0].data, 0, kGhashBlockNumBytes);
 
   // To get remaining entries, we use a variant of "shift and add"; in
   // polynomial terms, a shift is a multiplication by x. Note that, because the
@@ -163,12 +230,131 @@ void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx) {
     block_xor(&ctx->tbl[reverse_bits(i)], &ctx->tbl[0x8],
               &ctx->tbl[reverse_bits(i + 1)]);
   }
+#endif  // OT_GHASH_CLMUL
+}
+
+void ghash_init_subkey_table8(ghash_context_t *ctx, ghash_table8_t *tbl8) {
+#ifdef OT_GHASH_CLMUL
+  // Nothing to do; the carry-less multiply backend needs no table.
+  (void)ctx;
+  (void)tbl8;
+#else
+  // The MSB of an index is the lowest-degree coefficient, so 0x80 * H = H,
+  // and each lower power of two is the next one multiplied by x.
+  memset(tbl8->tbl[0].data, 0, kGhashBlockNumBytes);
+  memcpy(tbl8->tbl[0x80].data, ctx->tbl[0x8].data, kGhashBlockNumBytes);
+  for (size_t i = 0x40; i > 0; i >>= 1) {
+    galois_mulx(&tbl8->tbl[i << 1], &tbl8->tbl[i]);
+  }
+
+  // Every other entry is the sum of the entries for its bits.
+  for (size_t i = 2; i < ARRAYSIZE(tbl8->tbl); i <<= 1) {
+    for (size_t j = 1; j < i; ++j) {
+      block_xor(&tbl8->tbl[i], &tbl8->tbl[j], &tbl8->tbl[i | j]);
+    }
+  }
+  ctx->tbl8 = tbl8;
+#endif  // OT_GHASH_CLMUL
 }
 
 void ghash_init(ghash_context_t *ctx) {
   memset(ctx->state.data, 0, kGhashBlockNumBytes);
 }
 
+#ifdef OT_GHASH_CLMUL
+/**
+ * Carry-less multiplication of two 32-bit words, low half.
+ *
+ * @param a First operand.
+ * @param b Second operand.
+ * @return Bits 0..31 of the carry-less product.
+ */
+static inline uint32_t clmul32(uint32_t a, uint32_t b) {
+#ifdef OT_PLATFORM_RV32
+  uint32_t out;
+  asm(".option push;"
+      ".option arch, +zbc;"
+      "clmul %0, %1, %2;"
+      ".option pop;"
+      : "=r"(out)
+      : "r"(a), "r"(b));
+  return out;
+#else
+  uint32_t out = 0;
+  for (size_t i = 0; i < 32; ++i) {
+    out ^= ((b >> i) & 1) ? a << i : 0;
+  }
+  return out;
+#endif
+}
+
+/**
+ * Carry-less multiplication of two 32-bit words, high half.
+ *
+ * @param a First operand.
+ * @param b Second operand.
+ * @return Bits 32..63 of the carry-less product.
+ */
+static inline uint32_t clmulh32(uint32_t a, uint32_t b) {
+#ifdef OT_PLATFORM_RV32
+  uint32_t out;
+  asm(".option push;"
+      ".option arch, +zbc;"
+      "clmulh %0, %1, %2;"
+      ".option pop;"
+      : "=r"(out)
+      : "r"(a), "r"(b));
+  return out;
+#else
+  uint32_t out = 0;
+  for (size_t i = 1; i < 32; ++i) {
+    out ^= ((b >> i) & 1) ? a >> (32 - i) : 0;
+  }
+  return out;
+#endif
+}
+
+/**
+ * Multiply the GHASH state by the hash subkey with carry-less multiplication.
+ *
+ * GCM puts the lowest-degree coefficient in the MSB of each byte. After
+ * reversing the bits of each byte, bit j of word i is the coefficient of
+ * x^(32i + j), so the 256-bit product is the XOR of the 16 word products,
+ * which is then reduced modulo x^128 + x^7 + x^2 + x + 1 with shifts.
+ *
+ * Runs in constant time.
+ *
+ * @param ctx GHASH context, updated in place.
+ */
+static void galois_mul_state_key(ghash_context_t *ctx) {
+  uint32_t a[kGhashBlockNumWords];
+  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
+    a[i] = brev8(ctx->state.data[i]);
+  }
+  const uint32_t *b = ctx->tbl[0].data;
+
+  uint32_t product[2 * kGhashBlockNumWords] = {0};
+  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
+    for (size_t j = 0; j < kGhashBlockNumWords; ++j) {
+      product[i + j] ^= clmul32(a[i], b[j]);
+      product[i + j + 1] ^= clmulh32(a[i], b[j]);
+    }
+  }
+
+  // Fold the high words, most significant first, using
+  // x^128 = x^7 + x^2 + x + 1. The bits that the fold pushes past x^127 land
+  // in a high word that has not been folded yet.
+  for (size_t i = 2 * kGhashBlockNumWords - 1; i >= kGhashBlockNumWords; --i) {
+    uint32_t w = product[i];
+    product[i - kGhashBlockNumWords] ^= w ^ (w << 1) ^ (w << 2) ^ (w << 7);
+    product[i - kGhashBlockNumWords + 1] ^= (w >> 31) ^ (w >> 30) ^ (w >> 25);
+  }
+
+  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
+    ctx->state.data[i] = brev8(product[i]);
+  }
+}
+#else
 /**
  * Multiply the GHASH state by the hash subkey.
  *
@@ -184,7 +370,7 @@ void ghash_init(ghash_context_t *ctx) {
  *
  * @param ctx GHASH context, updated in place.
  */
-static void galois_mul_state_key(ghash_context_t *ctx) {
+static void galois_mul_state_key4(ghash_context_t *ctx) {
   // Initialize the multiplication result to 0.
   ghash_block_t result;
   memset(result.data, 0, kGhashBlockNumBytes);
@@ -233,6 +419,51 @@ static void galois_mul_state_key(ghash_context_t *ctx) {
   memcpy(ctx->state.data, result.data, kGhashBlockNumBytes);
 }
 
+/**
+ * Multiply the GHASH state by the hash subkey with 8-bit windows.
+ *
+ * Same as `galois_mul_state_key4`, but looks up one byte of the state at a
+ * time in the table from `ghash_init_subkey_table8`.
+ *
+ * @param ctx GHASH context with `tbl8` set, updated in place.
+ */
+static void galois_mul_state_key8(ghash_context_t *ctx) {
+  ghash_block_t result;
+  memset(result.data, 0, kGhashBlockNumBytes);
+
+  for (size_t i = 0; i < kGhashBlockNumBytes; ++i) {
+    if (i != 0) {
+      // Multiply `result` by x^8 and reduce the byte that overflows.
+      uint8_t overflow = block_byte_get(&result, kGhashBlockNumBytes - 1);
+      block_shiftr(&result, 8);
+      result.data[0] ^= kGFReduceTable8[overflow];
+    }
+
+    // Add the product of the next byte and H, most significant byte first.
+    uint8_t tbl_index =
+        block_byte_get(&ctx->state, kGhashBlockNumBytes - 1 - i);
+    block_xor(&result, &ctx->tbl8->tbl[tbl_index], &result);
+  }
+
+  memcpy(ctx->state.data, result.data, kGhashBlockNumBytes);
+}
+
+/**
+ * Multiply the GHASH state by the hash subkey.
+ *
+ * Uses the 8-bit window table if the caller provided one.
+ *
+ * @param ctx GHASH context, updated in place.
+ */
+static void galois_mul_state_key(ghash_context_t *ctx) {
+  if (ctx->tbl8 != NULL) {
+    galois_mul_state_key8(ctx);
+  } else {
+    galois_mul_state_key4(ctx);
+  }
+}
+#endif  // OT_GHASH_CLMUL
+
 /**
  * Single-block update function for GHASH.
  *
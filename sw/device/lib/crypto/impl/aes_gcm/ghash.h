@@ -30,11 +30,38 @@ typedef struct ghash_block {
   uint32_t data[kGhashBlockNumWords];
 } ghash_block_t;
 
+/**
+ * Optional 8-bit window product table for a hash subkey (4 KiB).
+ *
+ * See `ghash_init_subkey_table8`.
+ */
+typedef struct ghash_table8 {
+  ghash_block_t tbl[256];
+} ghash_table8_t;
+
+/**
+ * GHASH context.
+ *
+ * The multiplication backend is chosen at build time by `OT_GHASH_CLMUL`,
+ * which is set with `--//sw/device/lib/crypto/impl/aes_gcm:ghash_impl=clmul`:
+ *   - By default, products are computed with 4-bit windows from `tbl`, or
+ *     with 8-bit windows from `tbl8` if the caller attached one.
+ *   - With `OT_GHASH_CLMUL`, products are computed with the carry-less
+ *     multiply instructions of the Zbc extension and no table is needed.
+ */
 typedef struct ghash_context {
   /**
    * Precomputed product table for the hash subkey.
+   *
+   * `tbl[0x8]` always holds the hash subkey. With `OT_GHASH_CLMUL`, `tbl[0]`
+   * holds the hash subkey with the bits of each byte reversed and the other
+   * entries are unused.
    */
   ghash_block_t tbl[16];
+  /**
+   * Optional 8-bit window product table, or NULL.
+   */
+  const ghash_table8_t *tbl8;
   /**
    * Cipher block representing the current GHASH state.
    */
@@ -59,6 +86,22 @@ typedef struct ghash_context {
  */
 void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx);
 
+/**
+ * Precompute an 8-bit window product table for GHASH.
+ *
+ * Computing products with 8-bit windows takes half as many steps as with the
+ * default 4-bit windows, at the cost of a 4 KiB table per hash subkey. This is
+ * opt-in for callers with RAM to spare: call it after `ghash_init_subkey`, and
+ * the context uses `tbl8` until the next call to `ghash_init_subkey`. The
+ * caller must keep `tbl8` alive for as long as it uses the context.
+ *
+ * With `OT_GHASH_CLMUL`, this does nothing, since that backend needs no table.
+ *
+ * @param ctx Context object with the hash subkey set.
+ * @param[out] tbl8 Product table to populate.
+ */
+void ghash_init_subkey_table8(ghash_context_t *ctx, ghash_table8_t *tbl8);
+
 /**
  * Start a GHASH operation.
  *
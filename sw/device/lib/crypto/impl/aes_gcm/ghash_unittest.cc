@@ -5,6 +5,8 @@
 #include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
 
 #include <array>
+#include <cstring>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -266,5 +268,126 @@ TEST(Ghash, McGrawViegaTestCase18) {
   EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
 }
 
+TEST(Ghash, McGrawViegaTestCase18Table8) {
+  // Same as test case 18, with the 8-bit window table.
+  std::array<uint32_t, 4> H = {
+      0x05f2beac,
+      0xebb8b479,
+      0xac9b88ce,
+      0xd7da3287,
+  };
+  std::array<uint32_t, 5> A = {
+      0xcefaedfe, 0xefbeadde, 0xcefaedfe, 0xefbeadde, 0xd2daadab,
+  };
+  std::array<uint32_t, 15> C = {
+      0x2fef8d5a, 0xf1539e0c, 0x53785df7, 0x202a9e65, 0x2ab2b2ee,
+      0x1964deaf, 0x4fab58a0, 0xf46b746f, 0xb7c3c00f, 0x4544f280,
+      0xf1eba32d, 0xde2cd8c5, 0x978941a2, 0x2ef80e20, 0x3f7eae44,
+  };
+  std::array<uint32_t, 4> exp_result = {
+      0x6fcfffd5,
+      0x694dacc5,
+      0x42872172,
+      0x0b177f1a,
+  };
+
+  // Encode bitlengths of A and C as big-endian 64-bit integers.
+  std::array<uint64_t, 2> bitlengths = {
+      A.size() * sizeof(uint32_t) * 8,
+      C.size() * sizeof(uint32_t) * 8,
+  };
+  bitlengths[0] = __builtin_bswap64(bitlengths[0]);
+  bitlengths[1] = __builtin_bswap64(bitlengths[1]);
+
+  // Compute GHASH(H, A, C).
+  ghash_context_t ctx;
+  ghash_table8_t tbl8;
+  ghash_init_subkey(H.data(), &ctx);
+  ghash_init_subkey_table8(&ctx, &tbl8);
+  ghash_init(&ctx);
+  ghash_update(&ctx, A.size() * sizeof(uint32_t), (unsigned char *)A.data());
+  ghash_update(&ctx, C.size() * sizeof(uint32_t), (unsigned char *)C.data());
+  ghash_update(&ctx, bitlengths.size() * sizeof(uint64_t),
+               (unsigned char *)bitlengths.data());
+  uint32_t result[kGhashBlockNumWords];
+  ghash_final(&ctx, result);
+
+  EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
+}
+
+/**
+ * Reference GHASH from NIST SP800-38D, algorithms 1 and 2, one bit at a time.
+ */
+std::array<uint32_t, 4> GhashReference(const std::array<uint32_t, 4> &H,
+                                       const std::vector<uint8_t> &input) {
+  std::array<uint8_t, 16> h;
+  std::memcpy(h.data(), H.data(), h.size());
+  std::array<uint8_t, 16> y = {0};
+  for (size_t offset = 0; offset < input.size(); offset += 16) {
+    for (size_t i = 0; i < 16 && offset + i < input.size(); ++i) {
+      y[i] ^= input[offset + i];
+    }
+    // Z = Y * H: for each bit of Y, most significant (x^0) first.
+    std::array<uint8_t, 16> z = {0};
+    std::array<uint8_t, 16> v = h;
+    for (size_t bit = 0; bit < 128; ++bit) {
+      if ((y[bit / 8] >> (7 - bit % 8)) & 1) {
+        for (size_t i = 0; i < 16; ++i) {
+          z[i] ^= v[i];
+        }
+      }
+      bool lsb = v[15] & 1;
+      for (size_t i = 15; i > 0; --i) {
+        v[i] = static_cast<uint8_t>((v[i] >> 1) | (v[i - 1] << 7));
+      }
+      v[0] >>= 1;
+      if (lsb) {
+        v[0] ^= 0xe1;
+      }
+    }
+    y = z;
+  }
+  std::array<uint32_t, 4> result;
+  std::memcpy(result.data(), y.data(), y.size());
+  return result;
+}
+
+TEST(Ghash, CrossCheckBackends) {
+  // Compare the 4-bit and 8-bit window tables (or the carry-less multiply
+  // backend, if enabled) with the bitwise reference for pseudo-random keys
+  // and inputs of various lengths.
+  uint32_t seed = 0x12345678;
+  auto next = [&seed]() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  };
+
+  for (size_t len : {1, 15, 16, 17, 64, 100}) {
+    std::array<uint32_t, 4> H = {next(), next(), next(), next()};
+    std::vector<uint8_t> input(len);
+    for (uint8_t &byte : input) {
+      byte = static_cast<uint8_t>(next());
+    }
+    std::array<uint32_t, 4> exp_result = GhashReference(H, input);
+
+    ghash_context_t ctx;
+    ghash_init_subkey(H.data(), &ctx);
+    ghash_init(&ctx);
+    ghash_update(&ctx, input.size(), input.data());
+    uint32_t result[kGhashBlockNumWords];
+    ghash_final(&ctx, result);
+    EXPECT_THAT(result, testing::ElementsAreArray(exp_result)) << len;
+
+    ghash_table8_t tbl8;
+    ghash_init_subkey_table8(&ctx, &tbl8);
+    ghash_init(&ctx);
+    ghash_update(&ctx, input.size(), input.data());
+    ghash_final(&ctx, result);
+    EXPECT_THAT(result, testing::ElementsAreArray(exp_result)) << len;
+  }
+}
+
 }  // namespace
 }  // namespace ghash_unittest
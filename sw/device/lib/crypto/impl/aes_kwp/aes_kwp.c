@@ -41,7 +41,9 @@ status_t aes_kwp_wrap(const aes_key_t kek, const uint32_t *plaintext,
     return OTCRYPTO_BAD_ARGS;
   }
 
-  // Load the AES block with the encryption key.
+  // Load the AES block with the encryption key. The block stays configured
+  // for ECB with the same key for all 6*n steps below, and is only reset by
+  // `aes_end` once the last step is done.
   HARDENED_TRY(aes_encrypt_begin(kek, /*iv=*/NULL));
 
   // This implementation follows the "indexing" method for the wrapping
@@ -68,8 +70,7 @@ status_t aes_kwp_wrap(const aes_key_t kek, const uint32_t *plaintext,
       // Copy R[i] into the block (A should already be present).
       hardened_memcpy(block.data + kSemiblockWords,
                       ciphertext + i * kSemiblockWords, kSemiblockWords);
-      HARDENED_TRY(aes_update(/*dest=*/NULL, &block));
-      HARDENED_TRY(aes_update(&block, /*src=*/NULL));
+      HARDENED_TRY(aes_update_blocks(&block, &block, /*num_blocks=*/1));
 
       // Encode the index and XOR it with the first semiblock, creating A for
       // the next iteration.
@@ -83,6 +84,9 @@ status_t aes_kwp_wrap(const aes_key_t kek, const uint32_t *plaintext,
     }
   }
 
+  // Clear the key and data registers of the AES block.
+  HARDENED_TRY(aes_end(NULL));
+
   // Copy A into the first semiblock of the ciphertext.
   hardened_memcpy(ciphertext, block.data, kSemiblockWords);
   return OTCRYPTO_OK;
@@ -106,7 +110,8 @@ status_t aes_kwp_unwrap(const aes_key_t kek, const uint32_t *ciphertext,
     return OTCRYPTO_BAD_ARGS;
   }
 
-  // Load the AES block with the decryption key.
+  // Load the AES block with the decryption key. As for wrapping, the block
+  // stays configured for the whole unwrap operation.
   HARDENED_TRY(aes_decrypt_begin(kek, /*iv=*/NULL));
 
   // This implementation follows the "indexing" method for the wrapping
@@ -133,8 +138,7 @@ status_t aes_kwp_unwrap(const aes_key_t kek, const uint32_t *ciphertext,
       // Copy R[i] into the block (A ^ t should already be present).
       hardened_memcpy(block.data + kSemiblockWords,
                       r + (i - 1) * kSemiblockWords, kSemiblockWords);
-      HARDENED_TRY(aes_update(/*dest=*/NULL, &block));
-      HARDENED_TRY(aes_update(&block, /*src=*/NULL));
+      HARDENED_TRY(aes_update_blocks(&block, &block, /*num_blocks=*/1));
 
       // Copy the last two words back into R[i].
       hardened_memcpy(r + (i - 1) * kSemiblockWords,
@@ -142,6 +146,9 @@ status_t aes_kwp_unwrap(const aes_key_t kek, const uint32_t *ciphertext,
     }
   }
 
+  // Clear the key and data registers of the AES block.
+  HARDENED_TRY(aes_end(NULL));
+
   // Check that the first 32 bits of A match the AES-KWP fixed prefix.
   if (block.data[0] != 0xa65959a6) {
     *success = kHardenedBoolFalse;
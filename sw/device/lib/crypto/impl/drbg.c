@@ -13,6 +13,68 @@
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('r', 'b', 'g')
 
+enum {
+  /**
+   * Number of words held by the software-side DRBG output pool.
+   *
+   * A multiple of the CSRNG block size (4 words), so a refill does not discard
+   * any generated output.
+   */
+  kDrbgPoolWords = 64,
+};
+
+/**
+ * Software-side pool of DRBG output.
+ *
+ * The unused words are the last `avail` words of `data`. Words are wiped as
+ * soon as they are handed out, so everything before them is already cleared.
+ */
+static struct {
+  /**
+   * Whether `otcrypto_drbg_generate` may be served from the pool.
+   */
+  hardened_bool_t enabled;
+  /**
+   * Number of unused words at the end of `data`.
+   */
+  size_t avail;
+  uint32_t data[kDrbgPoolWords];
+} drbg_pool;
+
+/**
+ * Wipes any unused words from the DRBG output pool.
+ *
+ * Must be called whenever the DRBG state changes, so that output generated
+ * from a previous state is never handed out afterwards.
+ */
+static void drbg_pool_discard(void) {
+  if (drbg_pool.avail != 0) {
+    hardened_memshred(drbg_pool.data, kDrbgPoolWords);
+    drbg_pool.avail = 0;
+  }
+}
+
+/**
+ * Refills the DRBG output pool with a single generate command.
+ *
+ * The pool is left empty if the command fails or the output is not
+ * FIPS-compatible.
+ *
+ * @return Result status; OK or error.
+ */
+static status_t drbg_pool_fill(void) {
+  drbg_pool.avail = 0;
+  status_t res =
+      entropy_csrng_generate(&kEntropyEmptySeed, drbg_pool.data,
+                             kDrbgPoolWords, /*fips_check=*/kHardenedBoolTrue);
+  if (!status_ok(res)) {
+    hardened_memshred(drbg_pool.data, kDrbgPoolWords);
+    return res;
+  }
+  drbg_pool.avail = kDrbgPoolWords;
+  return OTCRYPTO_OK;
+}
+
 /**
  * Construct seed material for the CSRNG.
  *
@@ -94,6 +156,7 @@ otcrypto_status_t otcrypto_drbg_instantiate(
   entropy_seed_material_t seed_material;
   seed_material_construct(perso_string, &seed_material);
 
+  drbg_pool_discard();
   HARDENED_TRY(entropy_csrng_uninstantiate());
   return entropy_csrng_instantiate(/*disable_trng_input=*/kHardenedBoolFalse,
                                    &seed_material);
@@ -109,6 +172,7 @@ otcrypto_status_t otcrypto_drbg_reseed(
   entropy_seed_material_t seed_material;
   seed_material_construct(additional_input, &seed_material);
 
+  drbg_pool_discard();
   return entropy_csrng_reseed(/*disable_trng_input=*/kHardenedBoolFalse,
                               &seed_material);
 }
@@ -129,6 +193,7 @@ otcrypto_status_t otcrypto_drbg_manual_instantiate(
 
   HARDENED_CHECK_EQ(seed_material.len, kEntropySeedWords);
 
+  drbg_pool_discard();
   return entropy_csrng_instantiate(/*disable_trng_input=*/kHardenedBoolTrue,
                                    &seed_material);
 }
@@ -150,6 +215,7 @@ otcrypto_status_t otcrypto_drbg_manual_reseed(
 
   HARDENED_CHECK_EQ(seed_material.len, kEntropySeedWords);
 
+  drbg_pool_discard();
   return entropy_csrng_reseed(/*disable_trng_input=*/kHardenedBoolTrue,
                               &seed_material);
 }
@@ -178,6 +244,22 @@ static otcrypto_status_t generate(hardened_bool_t fips_check,
     return OTCRYPTO_BAD_ARGS;
   }
 
+  // Serve small requests without additional input from the pool. The pool
+  // is always filled with the FIPS check enabled, so only the FIPS-checked
+  // entry point may use it.
+  if (drbg_pool.enabled == kHardenedBoolTrue &&
+      fips_check == kHardenedBoolTrue && additional_input.len == 0 &&
+      drbg_output.len <= kDrbgPoolWords) {
+    if (drbg_output.len > drbg_pool.avail) {
+      HARDENED_TRY(drbg_pool_fill());
+    }
+    size_t start = kDrbgPoolWords - drbg_pool.avail;
+    hardened_memcpy(drbg_output.data, &drbg_pool.data[start], drbg_output.len);
+    hardened_memshred(&drbg_pool.data[start], drbg_output.len);
+    drbg_pool.avail -= drbg_output.len;
+    return OTCRYPTO_OK;
+  }
+
   entropy_seed_material_t seed_material;
   seed_material_construct(additional_input, &seed_material);
   HARDENED_TRY(entropy_csrng_generate(&seed_material, drbg_output.data,
@@ -200,6 +282,22 @@ otcrypto_status_t otcrypto_drbg_manual_generate(
                   drbg_output);
 }
 
+otcrypto_status_t otcrypto_drbg_pool_refill(void) {
+  drbg_pool.enabled = kHardenedBoolTrue;
+  if (drbg_pool.avail == kDrbgPoolWords) {
+    // Already full.
+    return OTCRYPTO_OK;
+  }
+  return drbg_pool_fill();
+}
+
+otcrypto_status_t otcrypto_drbg_pool_flush(void) {
+  drbg_pool.enabled = kHardenedBoolFalse;
+  drbg_pool_discard();
+  return OTCRYPTO_OK;
+}
+
 otcrypto_status_t otcrypto_drbg_uninstantiate(void) {
+  drbg_pool_discard();
   return entropy_csrng_uninstantiate();
 }
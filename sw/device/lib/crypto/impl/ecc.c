@@ -4,12 +4,14 @@
 
 #include "sw/device/lib/crypto/include/ecc.h"
 
+#include "sw/device/lib/base/profiler.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
 #include "sw/device/lib/crypto/drivers/hmac.h"
 #include "sw/device/lib/crypto/impl/ecc/ecdh_p256.h"
 #include "sw/device/lib/crypto/impl/ecc/ecdh_p384.h"
 #include "sw/device/lib/crypto/impl/ecc/ecdsa_p256.h"
 #include "sw/device/lib/crypto/impl/ecc/ecdsa_p384.h"
+#include "sw/device/lib/crypto/impl/ecc/ed25519.h"
 #include "sw/device/lib/crypto/impl/integrity.h"
 #include "sw/device/lib/crypto/impl/keyblob.h"
 #include "sw/device/lib/crypto/include/datatypes.h"
@@ -30,6 +32,7 @@ otcrypto_status_t otcrypto_ecdsa_sign(
     const otcrypto_hash_digest_t message_digest,
     const otcrypto_ecc_curve_t *elliptic_curve,
     otcrypto_word32_buf_t signature) {
+  PROFILER_SCOPE("otcrypto_ecdsa_sign");
   HARDENED_TRY(otcrypto_ecdsa_sign_async_start(private_key, message_digest,
                                                elliptic_curve));
   return otcrypto_ecdsa_sign_async_finalize(elliptic_curve, signature);
@@ -41,6 +44,7 @@ otcrypto_status_t otcrypto_ecdsa_verify(
     otcrypto_const_word32_buf_t signature,
     const otcrypto_ecc_curve_t *elliptic_curve,
     hardened_bool_t *verification_result) {
+  PROFILER_SCOPE("otcrypto_ecdsa_verify");
   HARDENED_TRY(otcrypto_ecdsa_verify_async_start(public_key, message_digest,
                                                  signature, elliptic_curve));
   return otcrypto_ecdsa_verify_async_finalize(elliptic_curve, signature,
@@ -83,8 +87,9 @@ otcrypto_status_t otcrypto_ed25519_verify(
     otcrypto_const_byte_buf_t input_message,
     otcrypto_eddsa_sign_mode_t sign_mode, otcrypto_const_word32_buf_t signature,
     hardened_bool_t *verification_result) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  HARDENED_TRY(otcrypto_ed25519_verify_async_start(public_key, input_message,
+                                                   sign_mode, signature));
+  return otcrypto_ed25519_verify_async_finalize(verification_result);
 }
 
 otcrypto_status_t otcrypto_x25519_keygen(otcrypto_blinded_key_t *private_key,
@@ -819,6 +824,141 @@ otcrypto_status_t otcrypto_ecdsa_verify_async_finalize(
   return OTCRYPTO_FATAL_ERR;
 }
 
+/**
+ * Check an ECDSA-P256 public key for verification.
+ *
+ * Performs the same key checks as `otcrypto_ecdsa_verify_async_start`.
+ *
+ * @param public_key Public key to check.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ecdsa_p256_public_key_check(
+    const otcrypto_unblinded_key_t *public_key) {
+  if (public_key->key == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the public key mode.
+  if (launder32(public_key->key_mode) != kOtcryptoKeyModeEcdsa) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(public_key->key_mode, kOtcryptoKeyModeEcdsa);
+
+  // Check the integrity of the public key.
+  if (launder32(integrity_unblinded_key_check(public_key)) !=
+      kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(integrity_unblinded_key_check(public_key),
+                    kHardenedBoolTrue);
+
+  // Check the public key size.
+  return p256_public_key_length_check(public_key);
+}
+
+/**
+ * Check one item of an ECDSA-P256 verification batch.
+ *
+ * Performs the same input checks as `otcrypto_ecdsa_verify_async_start`.
+ *
+ * @param item Batch item to check.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ecdsa_p256_verify_batch_item_check(
+    const otcrypto_ecdsa_verify_batch_item_t *item) {
+  if (item->public_key == NULL || item->signature.data == NULL ||
+      item->message_digest.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(ecdsa_p256_public_key_check(item->public_key));
+
+  // Check the digest length.
+  if (launder32(item->message_digest.len) != kP256ScalarWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(item->message_digest.len, kP256ScalarWords);
+
+  // Check the signature lengths.
+  return p256_signature_length_check(item->signature.len);
+}
+
+otcrypto_status_t otcrypto_ecdsa_p256_verify_batch(
+    const otcrypto_ecdsa_verify_batch_item_t *items, size_t num_items,
+    hardened_bool_t *verification_results) {
+  if (num_items == 0) {
+    // Nothing to do.
+    return OTCRYPTO_OK;
+  }
+  if (items == NULL || verification_results == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check every item before touching OTBN.
+  size_t i = 0;
+  for (; launder32(i) < num_items; i++) {
+    HARDENED_TRY(ecdsa_p256_verify_batch_item_check(&items[i]));
+  }
+  HARDENED_CHECK_EQ(i, num_items);
+
+  // Load the app once and run each item through it.
+  HARDENED_TRY(ecdsa_p256_verify_batch_start());
+  for (i = 0; launder32(i) < num_items; i++) {
+    p256_point_t *pk = (p256_point_t *)items[i].public_key->key;
+    ecdsa_p256_signature_t *sig =
+        (ecdsa_p256_signature_t *)items[i].signature.data;
+    HARDENED_TRY(ecdsa_p256_verify_batch_item(
+        sig, items[i].message_digest.data, pk, &verification_results[i]));
+  }
+  HARDENED_CHECK_EQ(i, num_items);
+
+  return ecdsa_p256_verify_batch_end();
+}
+
+static_assert(sizeof(otcrypto_ecdsa_p256_verify_table_t) ==
+                  sizeof(p256_verify_table_t),
+              "ECDSA-P256 verification table size mismatch");
+
+otcrypto_status_t otcrypto_ecdsa_p256_verify_table_build(
+    const otcrypto_unblinded_key_t *public_key,
+    otcrypto_ecdsa_p256_verify_table_t *table) {
+  if (public_key == NULL || table == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(ecdsa_p256_public_key_check(public_key));
+
+  p256_point_t *pk = (p256_point_t *)public_key->key;
+  HARDENED_TRY(ecdsa_p256_verify_table_build_start(pk));
+  return ecdsa_p256_verify_table_build_finalize(
+      (p256_verify_table_t *)table->data);
+}
+
+otcrypto_status_t otcrypto_ecdsa_p256_verify_with_table(
+    const otcrypto_ecdsa_p256_verify_table_t *table,
+    const otcrypto_hash_digest_t message_digest,
+    otcrypto_const_word32_buf_t signature,
+    hardened_bool_t *verification_result) {
+  if (table == NULL || message_digest.data == NULL || signature.data == NULL ||
+      verification_result == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the digest length.
+  if (launder32(message_digest.len) != kP256ScalarWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(message_digest.len, kP256ScalarWords);
+
+  // Check the signature lengths.
+  HARDENED_TRY(p256_signature_length_check(signature.len));
+  ecdsa_p256_signature_t *sig = (ecdsa_p256_signature_t *)signature.data;
+
+  HARDENED_TRY(ecdsa_p256_verify_table_start(
+      sig, message_digest.data, (const p256_verify_table_t *)table->data));
+  return ecdsa_p256_verify_finalize(sig, verification_result);
+}
+
 otcrypto_status_t otcrypto_ecdh_keygen_async_start(
     const otcrypto_ecc_curve_t *elliptic_curve,
     const otcrypto_blinded_key_t *private_key) {
@@ -1150,14 +1290,21 @@ static status_t internal_ecdh_p256_finalize(
       shared_secret->keyblob_length,
       keyblob_num_words(shared_secret->config) * sizeof(uint32_t));
 
+  // The shares are read straight into the keyblob, so its layout must match
+  // the driver struct exactly.
+  if (launder32(shared_secret->keyblob_length) !=
+      sizeof(ecdh_p256_shared_key_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(shared_secret->keyblob_length,
+                    sizeof(ecdh_p256_shared_key_t));
+
   // Note: This operation wipes DMEM after retrieving the keys, so if an error
   // occurs after this point then the keys would be unrecoverable. This should
   // be the last potentially error-causing line before returning to the caller.
-  ecdh_p256_shared_key_t ss;
-  HARDENED_TRY(ecdh_p256_shared_key_finalize(&ss));
-
-  keyblob_from_shares(ss.share0, ss.share1, shared_secret->config,
-                      shared_secret->keyblob);
+  ecdh_p256_shared_key_t *ss =
+      (ecdh_p256_shared_key_t *)shared_secret->keyblob;
+  HARDENED_TRY(ecdh_p256_shared_key_finalize(ss));
 
   // Set the checksum.
   shared_secret->checksum = integrity_blinded_checksum(shared_secret);
@@ -1198,14 +1345,21 @@ static status_t internal_ecdh_p384_finalize(
       shared_secret->keyblob_length,
       keyblob_num_words(shared_secret->config) * sizeof(uint32_t));
 
+  // The shares are read straight into the keyblob, so its layout must match
+  // the driver struct exactly.
+  if (launder32(shared_secret->keyblob_length) !=
+      sizeof(ecdh_p384_shared_key_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(shared_secret->keyblob_length,
+                    sizeof(ecdh_p384_shared_key_t));
+
   // Note: This operation wipes DMEM after retrieving the keys, so if an error
   // occurs after this point then the keys would be unrecoverable. This should
   // be the last potentially error-causing line before returning to the caller.
-  ecdh_p384_shared_key_t ss;
-  HARDENED_TRY(ecdh_p384_shared_key_finalize(&ss));
-
-  keyblob_from_shares(ss.share0, ss.share1, shared_secret->config,
-                      shared_secret->keyblob);
+  ecdh_p384_shared_key_t *ss =
+      (ecdh_p384_shared_key_t *)shared_secret->keyblob;
+  HARDENED_TRY(ecdh_p384_shared_key_finalize(ss));
 
   // Set the checksum.
   shared_secret->checksum = integrity_blinded_checksum(shared_secret);
@@ -1272,19 +1426,151 @@ otcrypto_status_t otcrypto_ed25519_sign_async_finalize(
   return OTCRYPTO_NOT_IMPLEMENTED;
 }
 
+/**
+ * Check an Ed25519 public key.
+ *
+ * Checks the mode, integrity and length of the key. If this check passes, it
+ * is safe to interpret `public_key->key` as an encoded Ed25519 point.
+ *
+ * @param public_key Public key struct to check.
+ * @return OK if the key is usable or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_public_key_check(
+    const otcrypto_unblinded_key_t *public_key) {
+  // Check the public key mode.
+  if (launder32(public_key->key_mode) != kOtcryptoKeyModeEd25519) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(public_key->key_mode, kOtcryptoKeyModeEd25519);
+
+  // Check the integrity of the public key.
+  if (launder32(integrity_unblinded_key_check(public_key)) !=
+      kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(integrity_unblinded_key_check(public_key),
+                    kHardenedBoolTrue);
+
+  // Check the public key size.
+  if (launder32(public_key->key_length) != kEd25519PointBytes) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(public_key->key_length, kEd25519PointBytes);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check the length of a signature buffer for Ed25519.
+ *
+ * If this check passes on `signature.len`, it is safe to interpret
+ * `signature.data` as `ed25519_signature_t *`.
+ *
+ * @param len Length to check.
+ * @return OK if the lengths are correct or BAD_ARGS otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_signature_length_check(size_t len) {
+  if (launder32(len) > UINT32_MAX / sizeof(uint32_t) ||
+      launder32(len) * sizeof(uint32_t) != sizeof(ed25519_signature_t)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(len * sizeof(uint32_t), sizeof(ed25519_signature_t));
+
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Compute the Ed25519 verification hash k on the HMAC block.
+ *
+ * For EdDSA, k = SHA-512(enc(R) || enc(A) || M). For HashEdDSA (Ed25519ph
+ * with an empty context), k = SHA-512(dom2(1, "") || enc(R) || enc(A) ||
+ * SHA-512(M)); see RFC 8032, section 5.1.
+ *
+ * @param signature Signature to be verified.
+ * @param public_key Encoded public key enc(A).
+ * @param input_message Message to be verified.
+ * @param sign_mode EdDSA or HashEdDSA.
+ * @param[out] hash Resulting hash k.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t ed25519_verify_hash(const ed25519_signature_t *signature,
+                                    const uint32_t *public_key,
+                                    otcrypto_const_byte_buf_t input_message,
+                                    otcrypto_eddsa_sign_mode_t sign_mode,
+                                    uint32_t hash[kEd25519HashWords]) {
+  // dom2(1, ""): the prefix string, the prehash flag and a zero context length.
+  static const uint8_t kEd25519Dom2Prefix[] = {
+      'S', 'i', 'g', 'E', 'd', '2', '5', '5', '1', '9', ' ', 'n',
+      'o', ' ', 'E', 'd', '2', '5', '5', '1', '9', ' ', 'c', 'o',
+      'l', 'l', 'i', 's', 'i', 'o', 'n', 's', 0x01, 0x00,
+  };
+  uint32_t prehash[kEd25519HashWords];
+  hmac_ctx_t ctx;
+
+  switch (launder32(sign_mode)) {
+    case kOtcryptoEddsaSignModeEddsa:
+      HARDENED_CHECK_EQ(sign_mode, kOtcryptoEddsaSignModeEddsa);
+      HARDENED_TRY(hmac_init(&ctx, kHmacModeSha512, /*key=*/NULL,
+                             /*key_wordlen=*/0));
+      HARDENED_TRY(hmac_update(&ctx, (const uint8_t *)signature->r,
+                               kEd25519PointBytes));
+      HARDENED_TRY(
+          hmac_update(&ctx, (const uint8_t *)public_key, kEd25519PointBytes));
+      HARDENED_TRY(hmac_update(&ctx, input_message.data, input_message.len));
+      break;
+    case kOtcryptoEddsaSignModeHashEddsa:
+      HARDENED_CHECK_EQ(sign_mode, kOtcryptoEddsaSignModeHashEddsa);
+      HARDENED_TRY(hmac(kHmacModeSha512, /*key=*/NULL, /*key_wordlen=*/0,
+                        input_message.data, input_message.len, prehash,
+                        kEd25519HashWords));
+      HARDENED_TRY(hmac_init(&ctx, kHmacModeSha512, /*key=*/NULL,
+                             /*key_wordlen=*/0));
+      HARDENED_TRY(
+          hmac_update(&ctx, kEd25519Dom2Prefix, sizeof(kEd25519Dom2Prefix)));
+      HARDENED_TRY(hmac_update(&ctx, (const uint8_t *)signature->r,
+                               kEd25519PointBytes));
+      HARDENED_TRY(
+          hmac_update(&ctx, (const uint8_t *)public_key, kEd25519PointBytes));
+      HARDENED_TRY(
+          hmac_update(&ctx, (const uint8_t *)prehash, sizeof(prehash)));
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  return hmac_final(&ctx, hash, kEd25519HashWords);
+}
+
 otcrypto_status_t otcrypto_ed25519_verify_async_start(
     const otcrypto_unblinded_key_t *public_key,
     otcrypto_const_byte_buf_t input_message,
     otcrypto_eddsa_sign_mode_t sign_mode,
     otcrypto_const_word32_buf_t signature) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (public_key == NULL || public_key->key == NULL ||
+      signature.data == NULL ||
+      (input_message.data == NULL && input_message.len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  HARDENED_TRY(ed25519_public_key_check(public_key));
+  HARDENED_TRY(ed25519_signature_length_check(signature.len));
+  const ed25519_signature_t *sig = (const ed25519_signature_t *)signature.data;
+
+  // Compute the hash on the HMAC block, then hand it to OTBN.
+  uint32_t hash[kEd25519HashWords];
+  HARDENED_TRY(ed25519_verify_hash(sig, public_key->key, input_message,
+                                   sign_mode, hash));
+  return ed25519_verify_start(sig, hash, public_key->key);
 }
 
 otcrypto_status_t otcrypto_ed25519_verify_async_finalize(
     hardened_bool_t *verification_result) {
-  // TODO: Ed25519 is not yet implemented.
-  return OTCRYPTO_NOT_IMPLEMENTED;
+  if (verification_result == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return ed25519_verify_finalize(verification_result);
 }
 
 otcrypto_status_t otcrypto_x25519_keygen_async_start(
@@ -26,6 +26,8 @@ OTBN_DECLARE_SYMBOL_ADDR(p256_ecdsa,
                          d1);  // The private key scalar d (share 1).
 OTBN_DECLARE_SYMBOL_ADDR(p256_ecdsa, x_r);  // Verification result.
 OTBN_DECLARE_SYMBOL_ADDR(p256_ecdsa, ok);   // Status code.
+OTBN_DECLARE_SYMBOL_ADDR(p256_ecdsa,
+                         q_table);  // Comb table for the public key.
 
 static const otbn_app_t kOtbnAppEcdsa = OTBN_APP_T_INIT(p256_ecdsa);
 static const otbn_addr_t kOtbnVarEcdsaMode = OTBN_ADDR_T_INIT(p256_ecdsa, mode);
@@ -38,6 +40,8 @@ static const otbn_addr_t kOtbnVarEcdsaD0 = OTBN_ADDR_T_INIT(p256_ecdsa, d0);
 static const otbn_addr_t kOtbnVarEcdsaD1 = OTBN_ADDR_T_INIT(p256_ecdsa, d1);
 static const otbn_addr_t kOtbnVarEcdsaXr = OTBN_ADDR_T_INIT(p256_ecdsa, x_r);
 static const otbn_addr_t kOtbnVarEcdsaOk = OTBN_ADDR_T_INIT(p256_ecdsa, ok);
+static const otbn_addr_t kOtbnVarEcdsaQTable =
+    OTBN_ADDR_T_INIT(p256_ecdsa, q_table);
 
 enum {
   /*
@@ -74,6 +78,22 @@ enum {
    * Value taken from `p256_ecdsa.s`.
    */
   kOtbnEcdsaModeSideloadSign = 0x49e,
+  /*
+   * Mode to compute the comb table for a public key.
+   *
+   * Value taken from `p256_ecdsa.s`.
+   */
+  kOtbnEcdsaModeVerifyPrecompute = 0x6e,
+  /*
+   * Mode to verify a signature with a precomputed comb table.
+   *
+   * Value taken from `p256_ecdsa.s`.
+   */
+  kOtbnEcdsaModeVerifyComb = 0x2b9,
+  /*
+   * Number of words in the comb table.
+   */
+  kOtbnEcdsaQTableWords = sizeof(p256_verify_table_t) / sizeof(uint32_t),
 };
 
 status_t ecdsa_p256_keygen_start(void) {
@@ -212,14 +232,23 @@ status_t ecdsa_p256_sign_finalize(ecdsa_p256_signature_t *result) {
   return OTCRYPTO_OK;
 }
 
-status_t ecdsa_p256_verify_start(const ecdsa_p256_signature_t *signature,
-                                 const uint32_t digest[kP256ScalarWords],
-                                 const p256_point_t *public_key) {
-  // Load the ECDSA/P-256 app and set up data pointers
-  HARDENED_TRY(otbn_load_app(kOtbnAppEcdsa));
-
+/**
+ * Write the inputs for one ECDSA/P-256 signature verification to OTBN.
+ *
+ * Expects the ECDSA/P-256 app to be loaded already.
+ *
+ * @param mode Verification mode for the app.
+ * @param signature Signature to be verified.
+ * @param digest Digest of the message to check the signature against.
+ * @param public_key Key to check the signature against.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t verify_inputs_write(uint32_t mode,
+                                    const ecdsa_p256_signature_t *signature,
+                                    const uint32_t digest[kP256ScalarWords],
+                                    const p256_point_t *public_key) {
   // Set mode so start() will jump into verifying.
-  uint32_t mode = kOtbnEcdsaModeVerify;
   HARDENED_TRY(otbn_dmem_write(kOtbnEcdsaModeWords, &mode, kOtbnVarEcdsaMode));
 
   // Set the message digest.
@@ -235,7 +264,18 @@ status_t ecdsa_p256_verify_start(const ecdsa_p256_signature_t *signature,
   HARDENED_TRY(otbn_dmem_write(kP256CoordWords, public_key->x, kOtbnVarEcdsaX));
 
   // Set the public key y coordinate.
-  HARDENED_TRY(otbn_dmem_write(kP256CoordWords, public_key->y, kOtbnVarEcdsaY));
+  return otbn_dmem_write(kP256CoordWords, public_key->y, kOtbnVarEcdsaY);
+}
+
+status_t ecdsa_p256_verify_start(const ecdsa_p256_signature_t *signature,
+                                 const uint32_t digest[kP256ScalarWords],
+                                 const p256_point_t *public_key) {
+  // Load the ECDSA/P-256 app and set up data pointers
+  HARDENED_TRY(otbn_load_app(kOtbnAppEcdsa));
+
+  // Write the signature, digest and public key.
+  HARDENED_TRY(verify_inputs_write(kOtbnEcdsaModeVerify, signature, digest,
+                                   public_key));
 
   // Start the OTBN routine.
   return otbn_execute();
@@ -266,3 +306,102 @@ status_t ecdsa_p256_verify_finalize(const ecdsa_p256_signature_t *signature,
 
   return OTCRYPTO_OK;
 }
+
+status_t ecdsa_p256_verify_batch_start(void) {
+  // Load the ECDSA/P-256 app once for the whole batch.
+  return otbn_load_app(kOtbnAppEcdsa);
+}
+
+status_t ecdsa_p256_verify_batch_item(const ecdsa_p256_signature_t *signature,
+                                      const uint32_t digest[kP256ScalarWords],
+                                      const p256_point_t *public_key,
+                                      hardened_bool_t *result) {
+  // The app only ever sets `ok` to true, so clear it to avoid seeing the
+  // result of the previous item.
+  uint32_t ok = kHardenedBoolFalse;
+  HARDENED_TRY(otbn_dmem_write(1, &ok, kOtbnVarEcdsaOk));
+
+  // Write the signature, digest and public key and run the app. The curve
+  // constants from the app's data section are still in DMEM.
+  HARDENED_TRY(verify_inputs_write(kOtbnEcdsaModeVerify, signature, digest,
+                                   public_key));
+  HARDENED_TRY(otbn_execute());
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // A signature or key that fails the basic validity checks is simply
+  // invalid here, rather than an error for the whole batch.
+  HARDENED_TRY(otbn_dmem_read(1, kOtbnVarEcdsaOk, &ok));
+  if (launder32(ok) != kHardenedBoolTrue) {
+    *result = kHardenedBoolFalse;
+    return OTCRYPTO_OK;
+  }
+  HARDENED_CHECK_EQ(ok, kHardenedBoolTrue);
+
+  // Read x_r (recovered R) out of OTBN dmem.
+  uint32_t x_r[kP256ScalarWords];
+  HARDENED_TRY(otbn_dmem_read(kP256ScalarWords, kOtbnVarEcdsaXr, x_r));
+
+  *result = hardened_memeq(x_r, signature->r, kP256ScalarWords);
+  return OTCRYPTO_OK;
+}
+
+status_t ecdsa_p256_verify_batch_end(void) {
+  // Wipe DMEM.
+  return otbn_dmem_sec_wipe();
+}
+
+status_t ecdsa_p256_verify_table_build_start(const p256_point_t *public_key) {
+  // Load the ECDSA/P-256 app.
+  HARDENED_TRY(otbn_load_app(kOtbnAppEcdsa));
+
+  // Set mode so start() will jump into computing the table.
+  uint32_t mode = kOtbnEcdsaModeVerifyPrecompute;
+  HARDENED_TRY(otbn_dmem_write(kOtbnEcdsaModeWords, &mode, kOtbnVarEcdsaMode));
+
+  // Set the public key.
+  HARDENED_TRY(otbn_dmem_write(kP256CoordWords, public_key->x, kOtbnVarEcdsaX));
+  HARDENED_TRY(otbn_dmem_write(kP256CoordWords, public_key->y, kOtbnVarEcdsaY));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t ecdsa_p256_verify_table_build_finalize(p256_verify_table_t *table) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the status code out of DMEM (false if the public key is invalid).
+  uint32_t ok;
+  HARDENED_TRY(otbn_dmem_read(1, kOtbnVarEcdsaOk, &ok));
+  if (launder32(ok) != kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(ok, kHardenedBoolTrue);
+
+  // Read the table out of OTBN dmem.
+  HARDENED_TRY(otbn_dmem_read(kOtbnEcdsaQTableWords, kOtbnVarEcdsaQTable,
+                              (uint32_t *)table->entries));
+
+  // Wipe DMEM.
+  return otbn_dmem_sec_wipe();
+}
+
+status_t ecdsa_p256_verify_table_start(const ecdsa_p256_signature_t *signature,
+                                       const uint32_t digest[kP256ScalarWords],
+                                       const p256_verify_table_t *table) {
+  // Load the ECDSA/P-256 app.
+  HARDENED_TRY(otbn_load_app(kOtbnAppEcdsa));
+
+  // Write the signature, digest and public key; the first table entry is the
+  // public key itself.
+  HARDENED_TRY(verify_inputs_write(kOtbnEcdsaModeVerifyComb, signature, digest,
+                                   &table->entries[0]));
+
+  // Write the table.
+  HARDENED_TRY(otbn_dmem_write(kOtbnEcdsaQTableWords,
+                               (const uint32_t *)table->entries,
+                               kOtbnVarEcdsaQTable));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
@@ -26,6 +26,25 @@ typedef struct ecdsa_p256_signature_t {
   uint32_t s[kP256ScalarWords];
 } ecdsa_p256_signature_t;
 
+enum {
+  /**
+   * Number of points in a P-256 verification comb table.
+   */
+  kP256VerifyTableEntries = 15,
+};
+
+/**
+ * A precomputed comb table for verifying signatures against one public key.
+ *
+ * Entry k-1 holds the affine point
+ *   (k_0 + k_1 * 2^64 + k_2 * 2^128 + k_3 * 2^192) * Q
+ * for k = k_0 + 2 * k_1 + 4 * k_2 + 8 * k_3, where Q is the public key. The
+ * first entry is therefore the public key itself.
+ */
+typedef struct p256_verify_table {
+  p256_point_t entries[kP256VerifyTableEntries];
+} p256_verify_table_t;
+
 /**
  * Start an async ECDSA/P-256 keypair generation operation on OTBN.
  *
@@ -152,6 +171,104 @@ OT_WARN_UNUSED_RESULT
 status_t ecdsa_p256_verify_finalize(const ecdsa_p256_signature_t *signature,
                                     hardened_bool_t *result);
 
+/**
+ * Start a batch of ECDSA/P-256 signature verifications on OTBN.
+ *
+ * Loads the ECDSA/P-256 app once; each following call to
+ * `ecdsa_p256_verify_batch_item` reuses it, including the curve constants in
+ * DMEM. The caller must end the batch with `ecdsa_p256_verify_batch_end` and
+ * must not run other OTBN operations in between.
+ *
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p256_verify_batch_start(void);
+
+/**
+ * Verify one ECDSA/P-256 signature within a batch.
+ *
+ * Blocks until OTBN is idle.
+ *
+ * Unlike `ecdsa_p256_verify_finalize`, a signature or public key that fails
+ * the basic validity checks is reported by writing `kHardenedBoolFalse` to
+ * `result` rather than by returning an error, so that one bad item does not
+ * abort the rest of the batch.
+ *
+ * @param signature Signature to be verified.
+ * @param digest Digest of the message to check the signature against.
+ * @param public_key Key to check the signature against.
+ * @param[out] result Output buffer (true if signature is valid, false
+ * otherwise)
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p256_verify_batch_item(const ecdsa_p256_signature_t *signature,
+                                      const uint32_t digest[kP256ScalarWords],
+                                      const p256_point_t *public_key,
+                                      hardened_bool_t *result);
+
+/**
+ * End a batch of ECDSA/P-256 signature verifications.
+ *
+ * Wipes OTBN DMEM.
+ *
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p256_verify_batch_end(void);
+
+/**
+ * Start an async computation of the comb table for a public key on OTBN.
+ *
+ * The table lets `ecdsa_p256_verify_table_start` verify signatures against
+ * the key with about half the work of `ecdsa_p256_verify_start`. Computing it
+ * costs about as much as one ordinary verification, so it pays off from the
+ * second signature onwards.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param public_key Key to compute the table for.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p256_verify_table_build_start(const p256_point_t *public_key);
+
+/**
+ * Finish an async comb table computation on OTBN.
+ *
+ * Blocks until OTBN is idle.
+ *
+ * Returns `OTCRYPTO_BAD_ARGS` if the public key is not a valid P-256 point.
+ *
+ * @param[out] table Output buffer for the table.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p256_verify_table_build_finalize(p256_verify_table_t *table);
+
+/**
+ * Start an async ECDSA/P-256 signature verification with a comb table.
+ *
+ * Same as `ecdsa_p256_verify_start`, but the public key is taken from the
+ * table and verification uses the table's precomputed multiples. Finish the
+ * operation with `ecdsa_p256_verify_finalize`.
+ *
+ * The table is trusted as much as the public key: OTBN only checks that its
+ * first entry matches the key, so it must be kept in memory that is as well
+ * protected as the key itself.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param signature Signature to be verified.
+ * @param digest Digest of the message to check the signature against.
+ * @param table Comb table for the key to check the signature against.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p256_verify_table_start(const ecdsa_p256_signature_t *signature,
+                                       const uint32_t digest[kP256ScalarWords],
+                                       const p256_verify_table_t *table);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -23,6 +23,7 @@ OTBN_DECLARE_SYMBOL_ADDR(p384_ecdsa_verify,
                          msg);                   // hash message to sign/verify
 OTBN_DECLARE_SYMBOL_ADDR(p384_ecdsa_verify, r);  // r part of signature
 OTBN_DECLARE_SYMBOL_ADDR(p384_ecdsa_verify, s);  // s part of signature
+OTBN_DECLARE_SYMBOL_ADDR(p384_ecdsa_verify, mode);  // Operation mode.
 
 static const otbn_app_t kOtbnAppEcdsaVerify =
     OTBN_APP_T_INIT(p384_ecdsa_verify);
@@ -38,16 +39,56 @@ static const otbn_addr_t kOtbnVarEcdsaS =
     OTBN_ADDR_T_INIT(p384_ecdsa_verify, s);
 static const otbn_addr_t kOtbnVarEcdsaRnd =
     OTBN_ADDR_T_INIT(p384_ecdsa_verify, x_r);
-
-status_t ecdsa_p384_verify_start(const ecdsa_p384_signature_t *signature,
-                                 const uint32_t digest[kP384ScalarWords],
-                                 const p384_point_t *public_key) {
-  // Check if public key is valid
-  HARDENED_TRY(p384_curve_point_validate_start(public_key));
-  HARDENED_TRY(p384_curve_point_validate_finalize());
-
-  // Load the ECDSA/P-384 app
-  HARDENED_TRY(otbn_load_app(kOtbnAppEcdsaVerify));
+static const otbn_addr_t kOtbnVarEcdsaMode =
+    OTBN_ADDR_T_INIT(p384_ecdsa_verify, mode);
+
+enum {
+  /*
+   * Mode is represented by a single word.
+   */
+  kOtbnEcdsaModeWords = 1,
+  /*
+   * Mode to set up the public key and verify a signature.
+   */
+  kOtbnEcdsaModeVerify = 0x1d6,
+  /*
+   * Mode to verify a signature under the public key set up by the last
+   * `kOtbnEcdsaModeVerify` run.
+   */
+  kOtbnEcdsaModeVerifyResidentKey = 0x62b,
+};
+
+/**
+ * Loads the verification app and starts a verification in the given mode.
+ *
+ * @param signature Signature to be verified.
+ * @param digest Digest of the message to check the signature against.
+ * @param public_key Key to check the signature against, or NULL to use the
+ * resident key.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t verify_start(const ecdsa_p384_signature_t *signature,
+                             const uint32_t digest[kP384ScalarWords],
+                             const p384_point_t *public_key) {
+  uint32_t mode = kOtbnEcdsaModeVerifyResidentKey;
+  if (public_key != NULL) {
+    mode = kOtbnEcdsaModeVerify;
+
+    // Load the ECDSA/P-384 app
+    HARDENED_TRY(otbn_load_app(kOtbnAppEcdsaVerify));
+
+    // Set the public key x coordinate.
+    HARDENED_TRY(
+        otbn_dmem_write(kP384CoordWords, public_key->x, kOtbnVarEcdsaX));
+
+    // Set the public key y coordinate.
+    HARDENED_TRY(
+        otbn_dmem_write(kP384CoordWords, public_key->y, kOtbnVarEcdsaY));
+  }
+
+  // Set mode so start() will jump into the requested verification.
+  HARDENED_TRY(otbn_dmem_write(kOtbnEcdsaModeWords, &mode, kOtbnVarEcdsaMode));
 
   // Set the message digest.
   HARDENED_TRY(set_message_digest(digest, kOtbnVarEcdsaMsg));
@@ -58,18 +99,20 @@ status_t ecdsa_p384_verify_start(const ecdsa_p384_signature_t *signature,
   // Set the signature S.
   HARDENED_TRY(otbn_dmem_write(kP384ScalarWords, signature->s, kOtbnVarEcdsaS));
 
-  // Set the public key x coordinate.
-  HARDENED_TRY(otbn_dmem_write(kP384CoordWords, public_key->x, kOtbnVarEcdsaX));
-
-  // Set the public key y coordinate.
-  HARDENED_TRY(otbn_dmem_write(kP384CoordWords, public_key->y, kOtbnVarEcdsaY));
-
   // Start the OTBN routine.
   return otbn_execute();
 }
 
-status_t ecdsa_p384_verify_finalize(const ecdsa_p384_signature_t *signature,
-                                    hardened_bool_t *result) {
+/**
+ * Waits for a verification to finish and compares the result with `r`.
+ *
+ * @param signature Signature to be verified.
+ * @param[out] result Whether the signature is valid.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t verify_result_get(const ecdsa_p384_signature_t *signature,
+                                  hardened_bool_t *result) {
   // Spin here waiting for OTBN to complete.
   HARDENED_TRY(otbn_busy_wait_for_done());
 
@@ -78,9 +121,72 @@ status_t ecdsa_p384_verify_finalize(const ecdsa_p384_signature_t *signature,
   HARDENED_TRY(otbn_dmem_read(kP384ScalarWords, kOtbnVarEcdsaRnd, x_r));
 
   *result = hardened_memeq(x_r, signature->r, kP384ScalarWords);
+  return OTCRYPTO_OK;
+}
+
+status_t ecdsa_p384_verify_start(const ecdsa_p384_signature_t *signature,
+                                 const uint32_t digest[kP384ScalarWords],
+                                 const p384_point_t *public_key) {
+  // Check if public key is valid
+  HARDENED_TRY(p384_curve_point_validate_start(public_key));
+  HARDENED_TRY(p384_curve_point_validate_finalize());
+
+  return verify_start(signature, digest, public_key);
+}
+
+status_t ecdsa_p384_verify_finalize(const ecdsa_p384_signature_t *signature,
+                                    hardened_bool_t *result) {
+  HARDENED_TRY(verify_result_get(signature, result));
 
   // Wipe DMEM.
   HARDENED_TRY(otbn_dmem_sec_wipe());
 
   return OTCRYPTO_OK;
 }
+
+status_t ecdsa_p384_verify_batch_init(ecdsa_p384_verify_batch_t *batch,
+                                      const p384_point_t *public_key) {
+  // Check if public key is valid. This is the only validation for the whole
+  // batch.
+  HARDENED_TRY(p384_curve_point_validate_start(public_key));
+  HARDENED_TRY(p384_curve_point_validate_finalize());
+
+  batch->public_key = *public_key;
+  batch->key_resident = kHardenedBoolFalse;
+  batch->dmem_epoch = 0;
+  return OTCRYPTO_OK;
+}
+
+status_t ecdsa_p384_verify_batch_start(
+    ecdsa_p384_verify_batch_t *batch, const ecdsa_p384_signature_t *signature,
+    const uint32_t digest[kP384ScalarWords]) {
+  // Reuse the precomputed key only if DMEM has not been wiped (in particular,
+  // no other app has been loaded) since the last run of this batch.
+  if (launder32(batch->key_resident) == kHardenedBoolTrue &&
+      batch->dmem_epoch == otbn_dmem_epoch_get()) {
+    HARDENED_CHECK_EQ(batch->key_resident, kHardenedBoolTrue);
+    return verify_start(signature, digest, /*public_key=*/NULL);
+  }
+
+  batch->key_resident = kHardenedBoolFalse;
+  HARDENED_TRY(verify_start(signature, digest, &batch->public_key));
+  batch->dmem_epoch = otbn_dmem_epoch_get();
+  return OTCRYPTO_OK;
+}
+
+status_t ecdsa_p384_verify_batch_finalize(
+    ecdsa_p384_verify_batch_t *batch, const ecdsa_p384_signature_t *signature,
+    hardened_bool_t *result) {
+  // If the run fails, the next one sets up the key again from scratch.
+  batch->key_resident = kHardenedBoolFalse;
+  HARDENED_TRY(verify_result_get(signature, result));
+  batch->key_resident = kHardenedBoolTrue;
+  return OTCRYPTO_OK;
+}
+
+status_t ecdsa_p384_verify_batch_end(ecdsa_p384_verify_batch_t *batch) {
+  batch->key_resident = kHardenedBoolFalse;
+
+  // Wipe DMEM.
+  return otbn_dmem_sec_wipe();
+}
@@ -58,6 +58,86 @@ OT_WARN_UNUSED_RESULT
 status_t ecdsa_p384_verify_finalize(const ecdsa_p384_signature_t *signature,
                                     hardened_bool_t *result);
 
+/**
+ * State of a batch of ECDSA/P-384 verifications under one public key.
+ *
+ * The first verification of a batch sets up the points that only depend on
+ * the public key in OTBN's DMEM; later ones reuse them, and skip the public
+ * key validation, the app load and the key setup.
+ */
+typedef struct ecdsa_p384_verify_batch {
+  /**
+   * Public key of the batch, already validated.
+   */
+  p384_point_t public_key;
+  /**
+   * Whether the last run of this batch left the key set up in DMEM.
+   */
+  hardened_bool_t key_resident;
+  /**
+   * OTBN DMEM epoch right after the key was loaded.
+   */
+  uint32_t dmem_epoch;
+} ecdsa_p384_verify_batch_t;
+
+/**
+ * Starts a batch of ECDSA/P-384 verifications under the same public key.
+ *
+ * Validates the public key on OTBN; blocks until OTBN is done.
+ *
+ * @param[out] batch Batch state.
+ * @param public_key Key to check the signatures against.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p384_verify_batch_init(ecdsa_p384_verify_batch_t *batch,
+                                      const p384_point_t *public_key);
+
+/**
+ * Starts an async verification of one signature of a batch.
+ *
+ * Same as `ecdsa_p384_verify_start`, with the public key of `batch`. If the
+ * previous verification of the batch left OTBN holding the key setup, and
+ * nothing else used OTBN in between, the verification starts right away with
+ * the resident key. Otherwise, the app is loaded and the key set up again.
+ *
+ * @param batch Batch state.
+ * @param signature Signature to be verified.
+ * @param digest Digest of the message to check the signature against.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p384_verify_batch_start(
+    ecdsa_p384_verify_batch_t *batch, const ecdsa_p384_signature_t *signature,
+    const uint32_t digest[kP384ScalarWords]);
+
+/**
+ * Finishes an async verification of one signature of a batch.
+ *
+ * Same as `ecdsa_p384_verify_finalize`, except that DMEM is not wiped so that
+ * the next verification of the batch can reuse the key setup. DMEM only holds
+ * public values.
+ *
+ * @param batch Batch state.
+ * @param signature Signature to be verified.
+ * @param[out] result Output buffer (true if signature is valid, false
+ * otherwise)
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p384_verify_batch_finalize(
+    ecdsa_p384_verify_batch_t *batch, const ecdsa_p384_signature_t *signature,
+    hardened_bool_t *result);
+
+/**
+ * Ends a batch of verifications and wipes OTBN's DMEM.
+ *
+ * @param batch Batch state.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ecdsa_p384_verify_batch_end(ecdsa_p384_verify_batch_t *batch);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
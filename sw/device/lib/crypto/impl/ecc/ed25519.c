@@ -0,0 +1,74 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/impl/ecc/ed25519.h"
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('e', 'd', 'v')
+
+OTBN_DECLARE_APP_SYMBOLS(run_ed25519_verify);  // The OTBN Ed25519 verify app.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519_verify,
+                         ed25519_hash_k);  // SHA-512 hash k.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519_verify,
+                         ed25519_sig);  // Signature enc(R) || S.
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519_verify,
+                         ed25519_public_key);  // Public key enc(A).
+OTBN_DECLARE_SYMBOL_ADDR(run_ed25519_verify,
+                         ed25519_verify_result);  // Verification result.
+
+static const otbn_app_t kOtbnAppEd25519Verify =
+    OTBN_APP_T_INIT(run_ed25519_verify);
+static const otbn_addr_t kOtbnVarEd25519HashK =
+    OTBN_ADDR_T_INIT(run_ed25519_verify, ed25519_hash_k);
+static const otbn_addr_t kOtbnVarEd25519Sig =
+    OTBN_ADDR_T_INIT(run_ed25519_verify, ed25519_sig);
+static const otbn_addr_t kOtbnVarEd25519PublicKey =
+    OTBN_ADDR_T_INIT(run_ed25519_verify, ed25519_public_key);
+static const otbn_addr_t kOtbnVarEd25519VerifyResult =
+    OTBN_ADDR_T_INIT(run_ed25519_verify, ed25519_verify_result);
+
+status_t ed25519_verify_start(const ed25519_signature_t *signature,
+                              const uint32_t hash[kEd25519HashWords],
+                              const uint32_t public_key[kEd25519PointWords]) {
+  // Load the Ed25519 verification app.
+  HARDENED_TRY(otbn_load_app(kOtbnAppEd25519Verify));
+
+  // Set the hash k.
+  HARDENED_TRY(otbn_dmem_write(kEd25519HashWords, hash, kOtbnVarEd25519HashK));
+
+  // Set the signature; R and S are adjacent in DMEM.
+  HARDENED_TRY(
+      otbn_dmem_write(kEd25519PointWords, signature->r, kOtbnVarEd25519Sig));
+  HARDENED_TRY(otbn_dmem_write(kEd25519ScalarWords, signature->s,
+                               kOtbnVarEd25519Sig + kEd25519PointBytes));
+
+  // Set the public key.
+  HARDENED_TRY(otbn_dmem_write(kEd25519PointWords, public_key,
+                               kOtbnVarEd25519PublicKey));
+
+  // Start the OTBN routine.
+  return otbn_execute();
+}
+
+status_t ed25519_verify_finalize(hardened_bool_t *result) {
+  // Spin here waiting for OTBN to complete.
+  HARDENED_TRY(otbn_busy_wait_for_done());
+
+  // Read the verification result out of DMEM.
+  uint32_t ok;
+  HARDENED_TRY(otbn_dmem_read(1, kOtbnVarEd25519VerifyResult, &ok));
+  *result = kHardenedBoolFalse;
+  if (launder32(ok) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(ok, kHardenedBoolTrue);
+    *result = kHardenedBoolTrue;
+  }
+
+  // Wipe DMEM.
+  return otbn_dmem_sec_wipe();
+}
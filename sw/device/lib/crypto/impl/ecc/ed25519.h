@@ -0,0 +1,99 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_ED25519_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_ED25519_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+enum {
+  /**
+   * Length of an encoded Ed25519 point in bits.
+   */
+  kEd25519PointBits = 256,
+  /**
+   * Length of an encoded Ed25519 point in bytes.
+   */
+  kEd25519PointBytes = kEd25519PointBits / 8,
+  /**
+   * Length of an encoded Ed25519 point in words.
+   */
+  kEd25519PointWords = kEd25519PointBytes / sizeof(uint32_t),
+  /**
+   * Length of an Ed25519 scalar in bits.
+   */
+  kEd25519ScalarBits = 256,
+  /**
+   * Length of an Ed25519 scalar in bytes.
+   */
+  kEd25519ScalarBytes = kEd25519ScalarBits / 8,
+  /**
+   * Length of an Ed25519 scalar in words.
+   */
+  kEd25519ScalarWords = kEd25519ScalarBytes / sizeof(uint32_t),
+  /**
+   * Length of the SHA-512 hash used in Ed25519 in words.
+   */
+  kEd25519HashWords = 512 / 32,
+};
+
+/**
+ * A type that holds an Ed25519 signature.
+ *
+ * The signature consists of the encoded point R and the scalar S, both in the
+ * little-endian byte order of RFC 8032.
+ */
+typedef struct ed25519_signature_t {
+  uint32_t r[kEd25519PointWords];
+  uint32_t s[kEd25519ScalarWords];
+} ed25519_signature_t;
+
+/**
+ * Start an async Ed25519 signature verification operation on OTBN.
+ *
+ * The caller computes the SHA-512 hash k = SHA-512(enc(R) || enc(A) || M)
+ * (with the dom2 prefix and prehashed message for HashEdDSA); OTBN reduces it
+ * and checks [S]B = R + [k]A.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param signature Signature to be verified.
+ * @param hash SHA-512 hash k, as the digest bytes in order.
+ * @param public_key Encoded public key enc(A).
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_verify_start(const ed25519_signature_t *signature,
+                              const uint32_t hash[kEd25519HashWords],
+                              const uint32_t public_key[kEd25519PointWords]);
+
+/**
+ * Finish an async Ed25519 signature verification operation on OTBN.
+ *
+ * See the documentation of `ed25519_verify_start` for details.
+ *
+ * Blocks until OTBN is idle. Malformed signatures and public keys (for
+ * example S >= L or a key that does not decode to a curve point) are reported
+ * as a failed verification, as in RFC 8032.
+ *
+ * @param[out] result Output buffer (true if signature is valid, false
+ * otherwise)
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t ed25519_verify_finalize(hardened_bool_t *result);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_ECC_ED25519_H_
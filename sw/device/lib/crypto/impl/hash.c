@@ -7,6 +7,7 @@
 #include <stdbool.h>
 
 #include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/profiler.h"
 #include "sw/device/lib/crypto/drivers/hmac.h"
 #include "sw/device/lib/crypto/drivers/kmac.h"
 #include "sw/device/lib/crypto/impl/status.h"
@@ -38,6 +39,16 @@ static_assert(sizeof(hmac_ctx_t) % sizeof(uint32_t) == 0,
               "Size of `hmac_ctx_t` must be a multiple of the word size for "
               "`hardened_memcpy()`");
 
+// Ensure that the XOF context is large enough for the KMAC streaming struct.
+static_assert(
+    sizeof(otcrypto_xof_context_t) >= sizeof(kmac_xof_ctx_t),
+    "`otcrypto_xof_context_t` must be big enough to hold `kmac_xof_ctx_t`.");
+
+// Ensure that KMAC streaming struct is suitable for `hardened_memcpy()`.
+static_assert(sizeof(kmac_xof_ctx_t) % sizeof(uint32_t) == 0,
+              "Size of `kmac_xof_ctx_t` must be a multiple of the word size "
+              "for `hardened_memcpy()`");
+
 /**
  * Save the internal HMAC driver context to a generic hash context.
  *
@@ -68,6 +79,30 @@ static void hmac_ctx_restore(const otcrypto_hash_context_t *restrict ctx,
                   sizeof(hmac_ctx_t) / sizeof(uint32_t));
 }
 
+/**
+ * Save the internal KMAC streaming context to a generic XOF context.
+ *
+ * @param[out] ctx Generic XOF context to copy to.
+ * @param kmac_ctx The internal context object from KMAC driver.
+ */
+static void kmac_ctx_save(otcrypto_xof_context_t *restrict ctx,
+                          const kmac_xof_ctx_t *restrict kmac_ctx) {
+  hardened_memcpy(ctx->data, (uint32_t *)kmac_ctx,
+                  sizeof(kmac_xof_ctx_t) / sizeof(uint32_t));
+}
+
+/**
+ * Restore an internal KMAC streaming context from a generic XOF context.
+ *
+ * @param ctx Generic XOF context to restore from.
+ * @param[out] kmac_ctx Destination KMAC driver context object.
+ */
+static void kmac_ctx_restore(const otcrypto_xof_context_t *restrict ctx,
+                             kmac_xof_ctx_t *restrict kmac_ctx) {
+  hardened_memcpy((uint32_t *)kmac_ctx, ctx->data,
+                  sizeof(kmac_xof_ctx_t) / sizeof(uint32_t));
+}
+
 /**
  * Checks that the `mode` and `len` fields of the digest match.
  *
@@ -119,6 +154,7 @@ static status_t check_digest_len(otcrypto_hash_digest_t digest) {
 
 otcrypto_status_t otcrypto_hash(otcrypto_const_byte_buf_t input_message,
                                 otcrypto_hash_digest_t digest) {
+  PROFILER_SCOPE("otcrypto_hash");
   if (input_message.data == NULL && input_message.len != 0) {
     return OTCRYPTO_BAD_ARGS;
   }
@@ -281,3 +317,89 @@ otcrypto_status_t otcrypto_hash_final(otcrypto_hash_context_t *const ctx,
   hmac_ctx_save(ctx, &hmac_ctx);
   return OTCRYPTO_OK;
 }
+
+otcrypto_status_t otcrypto_xof_shake_init(otcrypto_xof_context_t *const ctx,
+                                          otcrypto_hash_mode_t xof_mode) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_xof_ctx_t kmac_ctx;
+  switch (xof_mode) {
+    case kOtcryptoHashXofModeShake128:
+      HARDENED_TRY(kmac_shake_128_start(&kmac_ctx));
+      break;
+    case kOtcryptoHashXofModeShake256:
+      HARDENED_TRY(kmac_shake_256_start(&kmac_ctx));
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_ctx_save(ctx, &kmac_ctx);
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_xof_cshake_init(
+    otcrypto_xof_context_t *const ctx, otcrypto_hash_mode_t xof_mode,
+    otcrypto_const_byte_buf_t function_name_string,
+    otcrypto_const_byte_buf_t customization_string) {
+  if (ctx == NULL ||
+      (function_name_string.data == NULL && function_name_string.len != 0) ||
+      (customization_string.data == NULL && customization_string.len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_xof_ctx_t kmac_ctx;
+  switch (xof_mode) {
+    case kOtcryptoHashXofModeCshake128:
+      HARDENED_TRY(kmac_cshake_128_start(
+          &kmac_ctx, function_name_string.data, function_name_string.len,
+          customization_string.data, customization_string.len));
+      break;
+    case kOtcryptoHashXofModeCshake256:
+      HARDENED_TRY(kmac_cshake_256_start(
+          &kmac_ctx, function_name_string.data, function_name_string.len,
+          customization_string.data, customization_string.len));
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_ctx_save(ctx, &kmac_ctx);
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_xof_update(otcrypto_xof_context_t *const ctx,
+                                      otcrypto_const_byte_buf_t input_message) {
+  if (ctx == NULL || (input_message.data == NULL && input_message.len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_xof_ctx_t kmac_ctx;
+  kmac_ctx_restore(ctx, &kmac_ctx);
+  HARDENED_TRY(
+      kmac_xof_absorb(&kmac_ctx, input_message.data, input_message.len));
+  kmac_ctx_save(ctx, &kmac_ctx);
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_xof_squeeze(otcrypto_xof_context_t *const ctx,
+                                       otcrypto_word32_buf_t output) {
+  if (ctx == NULL || (output.data == NULL && output.len != 0)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_xof_ctx_t kmac_ctx;
+  kmac_ctx_restore(ctx, &kmac_ctx);
+  HARDENED_TRY(kmac_xof_squeeze(&kmac_ctx, output.data, output.len));
+  kmac_ctx_save(ctx, &kmac_ctx);
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_xof_final(otcrypto_xof_context_t *const ctx) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_xof_ctx_t kmac_ctx;
+  kmac_ctx_restore(ctx, &kmac_ctx);
+  HARDENED_TRY(kmac_xof_end(&kmac_ctx));
+  kmac_ctx_save(ctx, &kmac_ctx);
+  return OTCRYPTO_OK;
+}
@@ -4,6 +4,7 @@
 
 #include "sw/device/lib/crypto/include/kdf.h"
 
+#include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/math.h"
 #include "sw/device/lib/crypto/drivers/kmac.h"
 #include "sw/device/lib/crypto/impl/integrity.h"
@@ -150,13 +151,22 @@ otcrypto_status_t otcrypto_kdf_hmac_ctr(
   // [L]_2 is the binary representation of the required bit length
   // The counter value is updated within the loop
 
-  uint32_t keying_material_len =
-      required_word_len + digest_word_len - required_word_len % digest_word_len;
-  uint32_t keying_material_data[keying_material_len];
+  // Process the key once and keep a copy of the keyed HMAC context; each
+  // iteration starts from a copy of it instead of re-initializing HMAC.
+  otcrypto_hmac_context_t keyed_ctx;
+  HARDENED_TRY(otcrypto_hmac_init(&keyed_ctx, &key_derivation_key));
+
+  // Write the output blocks directly into the first share of the keyblob. The
+  // second share (the mask) is all-zero for now, since HMAC is unhardened
+  // anyway.
+  uint32_t *share0;
+  uint32_t *share1;
+  HARDENED_TRY(keyblob_to_shares(keying_material, &share0, &share1));
+  memset(share1, 0, required_word_len * sizeof(uint32_t));
 
   for (uint32_t i = 0; i < num_iterations; i++) {
     otcrypto_hmac_context_t ctx;
-    HARDENED_TRY(otcrypto_hmac_init(&ctx, &key_derivation_key));
+    hardened_memcpy(ctx.data, keyed_ctx.data, ARRAYSIZE(ctx.data));
     uint32_t counter_be = __builtin_bswap32(i + 1);
     HARDENED_TRY(otcrypto_hmac_update(
         &ctx, (otcrypto_const_byte_buf_t){
@@ -172,20 +182,25 @@ otcrypto_status_t otcrypto_kdf_hmac_ctr(
         &ctx, (otcrypto_const_byte_buf_t){
                   .data = (const unsigned char *const)&required_bit_len,
                   .len = sizeof(required_bit_len)}));
-    uint32_t *tag_dest = keying_material_data + i * digest_word_len;
-    HARDENED_TRY(otcrypto_hmac_final(
-        &ctx,
-        (otcrypto_word32_buf_t){.data = tag_dest, .len = digest_word_len}));
-  }
 
-  // Generate a mask (all-zero for now, since HMAC is unhardened anyway).
-  uint32_t mask[digest_word_len];
-  memset(mask, 0, sizeof(mask));
-
-  // Construct a blinded key.
-  HARDENED_TRY(keyblob_from_key_and_mask(keying_material_data, mask,
-                                         keying_material->config,
-                                         keying_material->keyblob));
+    // Full blocks go straight into the keyblob; only the last block may need
+    // to be truncated through a temporary buffer.
+    size_t offset = i * digest_word_len;
+    size_t remaining = required_word_len - offset;
+    if (remaining >= digest_word_len) {
+      HARDENED_TRY(otcrypto_hmac_final(
+          &ctx, (otcrypto_word32_buf_t){.data = share0 + offset,
+                                        .len = digest_word_len}));
+    } else {
+      uint32_t tag[digest_word_len];
+      HARDENED_TRY(otcrypto_hmac_final(
+          &ctx,
+          (otcrypto_word32_buf_t){.data = tag, .len = digest_word_len}));
+      hardened_memcpy(share0 + offset, tag, remaining);
+      hardened_memshred(tag, digest_word_len);
+    }
+  }
+  hardened_memshred(keyed_ctx.data, ARRAYSIZE(keyed_ctx.data));
 
   keying_material->checksum = integrity_blinded_checksum(keying_material);
 
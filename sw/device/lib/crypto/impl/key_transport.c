@@ -14,8 +14,16 @@
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('k', 't', 'r')
 
-otcrypto_status_t otcrypto_symmetric_keygen(
-    otcrypto_const_byte_buf_t perso_string, otcrypto_blinded_key_t *key) {
+/**
+ * Checks that a key can be generated with `otcrypto_symmetric_keygen`.
+ *
+ * @param key Destination blinded key struct.
+ * @param[out] share0 Pointer to the first share within the keyblob.
+ * @param[out] share1 Pointer to the second share within the keyblob.
+ * @return OK if the key is a symmetric, XOR-masked key of valid length.
+ */
+static status_t symmetric_keygen_check(otcrypto_blinded_key_t *key,
+                                       uint32_t **share0, uint32_t **share1) {
   if (key == NULL || key->keyblob == NULL) {
     return OTCRYPTO_BAD_ARGS;
   }
@@ -26,10 +34,19 @@ otcrypto_status_t otcrypto_symmetric_keygen(
 
   // Get pointers to the shares within the keyblob. Fails if the key length
   // doesn't match the mode.
-  uint32_t *share0;
-  uint32_t *share1;
-  HARDENED_TRY(keyblob_to_shares(key, &share0, &share1));
+  return keyblob_to_shares(key, share0, share1);
+}
 
+/**
+ * Fills both shares of a checked key from the instantiated DRBG.
+ *
+ * @param key Destination blinded key struct.
+ * @param share0 Pointer to the first share within the keyblob.
+ * @param share1 Pointer to the second share within the keyblob.
+ * @return Result of the DRBG generate operations.
+ */
+static status_t symmetric_keygen_generate(otcrypto_blinded_key_t *key,
+                                          uint32_t *share0, uint32_t *share1) {
   // Construct buffers to direct the DRBG output into the keyblob.
   otcrypto_word32_buf_t share0_buf = {
       .data = share0,
@@ -45,15 +62,72 @@ otcrypto_status_t otcrypto_symmetric_keygen(
   otcrypto_const_byte_buf_t empty = {.data = NULL, .len = 0};
 
   // Generate each share of the key independently.
-  HARDENED_TRY(otcrypto_drbg_instantiate(perso_string));
   HARDENED_TRY(otcrypto_drbg_generate(empty, share0_buf));
   HARDENED_TRY(otcrypto_drbg_generate(empty, share1_buf));
 
-  // Populate the checksum and return.
+  // Populate the checksum.
   key->checksum = integrity_blinded_checksum(key);
   return OTCRYPTO_OK;
 }
 
+otcrypto_status_t otcrypto_symmetric_keygen(
+    otcrypto_const_byte_buf_t perso_string, otcrypto_blinded_key_t *key) {
+  uint32_t *share0;
+  uint32_t *share1;
+  HARDENED_TRY(symmetric_keygen_check(key, &share0, &share1));
+
+  HARDENED_TRY(otcrypto_drbg_instantiate(perso_string));
+  return symmetric_keygen_generate(key, share0, share1);
+}
+
+otcrypto_status_t otcrypto_symmetric_keygen_batch(
+    otcrypto_const_byte_buf_t perso_string, otcrypto_blinded_key_t *keys,
+    size_t num_keys, otcrypto_status_t *results) {
+  if (num_keys == 0) {
+    // Nothing to do.
+    return OTCRYPTO_OK;
+  }
+  if (keys == NULL || results == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check every key first so that the DRBG is only instantiated if there is
+  // something to generate.
+  status_t first_error = OTCRYPTO_OK;
+  size_t num_valid = 0;
+  size_t i = 0;
+  for (; launder32(i) < num_keys; i++) {
+    uint32_t *share0;
+    uint32_t *share1;
+    results[i] = symmetric_keygen_check(&keys[i], &share0, &share1);
+    if (status_ok(results[i])) {
+      num_valid++;
+    } else if (status_ok(first_error)) {
+      first_error = results[i];
+    }
+  }
+  HARDENED_CHECK_EQ(i, num_keys);
+  if (num_valid == 0) {
+    return first_error;
+  }
+
+  // A single instantiation serves the whole batch. DRBG errors are not
+  // specific to one key, so they abort the batch.
+  HARDENED_TRY(otcrypto_drbg_instantiate(perso_string));
+  for (i = 0; launder32(i) < num_keys; i++) {
+    if (!status_ok(results[i])) {
+      continue;
+    }
+    uint32_t *share0;
+    uint32_t *share1;
+    HARDENED_TRY(keyblob_to_shares(&keys[i], &share0, &share1));
+    HARDENED_TRY(symmetric_keygen_generate(&keys[i], share0, share1));
+  }
+  HARDENED_CHECK_EQ(i, num_keys);
+
+  return first_error;
+}
+
 otcrypto_status_t otcrypto_hw_backed_key(uint32_t version,
                                          const uint32_t salt[7],
                                          otcrypto_blinded_key_t *key) {
@@ -176,3 +250,57 @@ otcrypto_status_t otcrypto_export_blinded_key(
   hardened_memcpy(key_share1.data, keyblob_share1, key_share1.len);
   return OTCRYPTO_OK;
 }
+
+otcrypto_status_t otcrypto_import_blinded_key_batch(
+    const otcrypto_key_import_batch_item_t *items, size_t num_items,
+    otcrypto_status_t *results) {
+  if (num_items == 0) {
+    // Nothing to do.
+    return OTCRYPTO_OK;
+  }
+  if (items == NULL || results == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  status_t first_error = OTCRYPTO_OK;
+  size_t i = 0;
+  for (; launder32(i) < num_items; i++) {
+    results[i] = otcrypto_import_blinded_key(
+        items[i].key_share0, items[i].key_share1, items[i].blinded_key);
+    if (!status_ok(results[i]) && status_ok(first_error)) {
+      first_error = results[i];
+    }
+  }
+  HARDENED_CHECK_EQ(i, num_items);
+
+  return first_error;
+}
+
+otcrypto_status_t otcrypto_export_blinded_key_batch(
+    const otcrypto_key_export_batch_item_t *items, size_t num_items,
+    otcrypto_status_t *results) {
+  if (num_items == 0) {
+    // Nothing to do.
+    return OTCRYPTO_OK;
+  }
+  if (items == NULL || results == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  status_t first_error = OTCRYPTO_OK;
+  size_t i = 0;
+  for (; launder32(i) < num_items; i++) {
+    if (items[i].blinded_key == NULL) {
+      results[i] = OTCRYPTO_BAD_ARGS;
+    } else {
+      results[i] = otcrypto_export_blinded_key(
+          *items[i].blinded_key, items[i].key_share0, items[i].key_share1);
+    }
+    if (!status_ok(results[i]) && status_ok(first_error)) {
+      first_error = results[i];
+    }
+  }
+  HARDENED_CHECK_EQ(i, num_items);
+
+  return first_error;
+}
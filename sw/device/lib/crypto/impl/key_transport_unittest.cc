@@ -320,5 +320,86 @@ TEST(KeyTransport, BlindedKeyExportNotExportable) {
             false);
 }
 
+TEST(KeyTransport, BlindedKeyBatchImportExport) {
+  std::array<uint32_t, 4> share0 = {0x00010203, 0x04050607, 0x08090a0b,
+                                    0x0c0d0e0f};
+  std::array<uint32_t, 4> share1 = {0xf0f1f2f3, 0xf4f5f6f7, 0xf8f9fafb,
+                                    0xfcfdfeff};
+  otcrypto_const_word32_buf_t share0_buf = {
+      .data = share0.data(),
+      .len = share0.size(),
+  };
+  otcrypto_const_word32_buf_t share1_buf = {
+      .data = share1.data(),
+      .len = share1.size(),
+  };
+  otcrypto_const_word32_buf_t short_share1_buf = {
+      .data = share1.data(),
+      .len = share1.size() - 1,
+  };
+
+  // Two exportable keys, one non-exportable key, and one key whose share has
+  // a bad length.
+  uint32_t keyblobs[4][share0.size() * 2];
+  otcrypto_blinded_key_t blinded_keys[] = {
+      {.config = kConfigExportableAesCtr128,
+       .keyblob_length = sizeof(keyblobs[0]),
+       .keyblob = keyblobs[0]},
+      {.config = kConfigExportableAesCtr128,
+       .keyblob_length = sizeof(keyblobs[1]),
+       .keyblob = keyblobs[1]},
+      {.config = kConfigNonExportableAesCtr128,
+       .keyblob_length = sizeof(keyblobs[2]),
+       .keyblob = keyblobs[2]},
+      {.config = kConfigExportableAesCtr128,
+       .keyblob_length = sizeof(keyblobs[3]),
+       .keyblob = keyblobs[3]},
+  };
+  const otcrypto_key_import_batch_item_t import_items[] = {
+      {share0_buf, share1_buf, &blinded_keys[0]},
+      {share0_buf, share1_buf, &blinded_keys[1]},
+      {share0_buf, share1_buf, &blinded_keys[2]},
+      {share0_buf, short_share1_buf, &blinded_keys[3]},
+  };
+
+  // Only the bad item fails to import; the others are unaffected.
+  otcrypto_status_t results[4];
+  EXPECT_EQ(
+      status_ok(otcrypto_import_blinded_key_batch(import_items, 4, results)),
+      false);
+  EXPECT_EQ(status_ok(results[0]), true);
+  EXPECT_EQ(status_ok(results[1]), true);
+  EXPECT_EQ(status_ok(results[2]), true);
+  EXPECT_EQ(status_ok(results[3]), false);
+
+  // Export the three imported keys; only the non-exportable one fails.
+  std::array<uint32_t, 4> out_shares[3][2];
+  const otcrypto_key_export_batch_item_t export_items[] = {
+      {&blinded_keys[0],
+       {out_shares[0][0].data(), out_shares[0][0].size()},
+       {out_shares[0][1].data(), out_shares[0][1].size()}},
+      {&blinded_keys[1],
+       {out_shares[1][0].data(), out_shares[1][0].size()},
+       {out_shares[1][1].data(), out_shares[1][1].size()}},
+      {&blinded_keys[2],
+       {out_shares[2][0].data(), out_shares[2][0].size()},
+       {out_shares[2][1].data(), out_shares[2][1].size()}},
+  };
+  EXPECT_EQ(
+      status_ok(otcrypto_export_blinded_key_batch(export_items, 3, results)),
+      false);
+  EXPECT_EQ(status_ok(results[0]), true);
+  EXPECT_EQ(status_ok(results[1]), true);
+  EXPECT_EQ(status_ok(results[2]), false);
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_THAT(out_shares[i][0], ElementsAreArray(share0));
+    EXPECT_THAT(out_shares[i][1], ElementsAreArray(share1));
+  }
+
+  // An empty batch succeeds without touching the results.
+  EXPECT_EQ(status_ok(otcrypto_export_blinded_key_batch(nullptr, 0, nullptr)),
+            true);
+}
+
 }  // namespace
 }  // namespace key_transport_unittest
@@ -185,15 +185,17 @@ status_t keyblob_from_key_and_mask(const uint32_t *key, const uint32_t *mask,
   HARDENED_TRY(keyblob_ensure_xor_masked(config));
 
   // share0 = key ^ mask, share1 = mask
+  // Write each word straight into the keyblob rather than building share0 in
+  // a temporary buffer first.
   size_t key_words = keyblob_share_num_words(config);
-  uint32_t share0[key_words];
+  uint32_t *share0 = keyblob;
+  uint32_t *share1 = keyblob + key_words;
   size_t i = 0;
   for (; launder32(i) < key_words; i++) {
     share0[i] = key[i] ^ mask[i];
   }
   HARDENED_CHECK_EQ(i, key_words);
-
-  keyblob_from_shares(share0, mask, config, keyblob);
+  hardened_memcpy(share1, mask, key_words);
   return OTCRYPTO_OK;
 }
 
@@ -135,6 +135,9 @@ status_t keyblob_ensure_xor_masked(const otcrypto_key_config_t config);
  * 20 bytes would technically fit in 5. This is to preserve word-alignment of
  * the shares.
  *
+ * The shares are written directly into `keyblob` word by word, so neither
+ * `key` nor `mask` may overlap with it.
+ *
  * Returns an error if called for an asymmetric key configuration; asymmetric
  * keys are likely to be masked with arithmetic rather than boolean (XOR)
  * schemes, and this function cannot be used for them.
@@ -37,6 +37,15 @@ static_assert(kOtcryptoRsa3072PrivateKeyblobBytes ==
 static_assert(kOtcryptoRsa4096PrivateKeyblobBytes ==
                   sizeof(rsa_4096_private_key_t),
               "RSA-4096 keyblob size mismatch.");
+static_assert(kOtcryptoRsa2048PrivateKeyCrtKeyblobBytes ==
+                  sizeof(rsa_2048_crt_private_key_t),
+              "RSA-2048 CRT keyblob size mismatch.");
+static_assert(kOtcryptoRsa3072PrivateKeyCrtKeyblobBytes ==
+                  sizeof(rsa_3072_crt_private_key_t),
+              "RSA-3072 CRT keyblob size mismatch.");
+static_assert(kOtcryptoRsa4096PrivateKeyCrtKeyblobBytes ==
+                  sizeof(rsa_4096_crt_private_key_t),
+              "RSA-4096 CRT keyblob size mismatch.");
 
 otcrypto_status_t otcrypto_rsa_keygen(otcrypto_rsa_size_t size,
                                       otcrypto_unblinded_key_t *public_key,
@@ -115,6 +124,39 @@ otcrypto_status_t otcrypto_rsa_public_key_construct(
   return OTCRYPTO_OK;
 }
 
+/**
+ * Determine whether an RSA private key is in CRT form.
+ *
+ * CRT keys are distinguished from regular keys by their keyblob length.
+ *
+ * @param size RSA size parameter.
+ * @param private_key Key to check.
+ * @return kHardenedBoolTrue if the keyblob length matches a CRT key.
+ */
+static hardened_bool_t private_key_is_crt(
+    const otcrypto_rsa_size_t size, const otcrypto_blinded_key_t *private_key) {
+  size_t crt_keyblob_length = 0;
+  switch (launder32(size)) {
+    case kOtcryptoRsaSize2048:
+      crt_keyblob_length = kOtcryptoRsa2048PrivateKeyCrtKeyblobBytes;
+      break;
+    case kOtcryptoRsaSize3072:
+      crt_keyblob_length = kOtcryptoRsa3072PrivateKeyCrtKeyblobBytes;
+      break;
+    case kOtcryptoRsaSize4096:
+      crt_keyblob_length = kOtcryptoRsa4096PrivateKeyCrtKeyblobBytes;
+      break;
+    default:
+      return kHardenedBoolFalse;
+  }
+
+  if (launder32(private_key->keyblob_length) == crt_keyblob_length) {
+    HARDENED_CHECK_EQ(private_key->keyblob_length, crt_keyblob_length);
+    return kHardenedBoolTrue;
+  }
+  return kHardenedBoolFalse;
+}
+
 /**
  * Basic structural validity checks for RSA private key buffers.
  *
@@ -124,11 +166,13 @@ otcrypto_status_t otcrypto_rsa_public_key_construct(
  * not yet populated.
  *
  * @param size RSA size parameter.
+ * @param crt Whether the key is expected to be in CRT form.
  * @param private_key Key to check.
  * @return OK if the key is valid, OTCRYPTO_BAD_ARGS otherwise.
  */
 static status_t private_key_structural_check(
-    const otcrypto_rsa_size_t size, const otcrypto_blinded_key_t *private_key) {
+    const otcrypto_rsa_size_t size, const hardened_bool_t crt,
+    const otcrypto_blinded_key_t *private_key) {
   // Check that the key mode is a valid RSA mode.
   HARDENED_TRY(rsa_mode_check(private_key->config.key_mode));
 
@@ -145,16 +189,25 @@ static status_t private_key_structural_check(
       HARDENED_CHECK_EQ(size, kOtcryptoRsaSize2048);
       key_length = kOtcryptoRsa2048PrivateKeyBytes;
       keyblob_length = kOtcryptoRsa2048PrivateKeyblobBytes;
+      if (launder32(crt) == kHardenedBoolTrue) {
+        keyblob_length = kOtcryptoRsa2048PrivateKeyCrtKeyblobBytes;
+      }
       break;
     case kOtcryptoRsaSize3072:
       HARDENED_CHECK_EQ(size, kOtcryptoRsaSize3072);
       key_length = kOtcryptoRsa3072PrivateKeyBytes;
       keyblob_length = kOtcryptoRsa3072PrivateKeyblobBytes;
+      if (launder32(crt) == kHardenedBoolTrue) {
+        keyblob_length = kOtcryptoRsa3072PrivateKeyCrtKeyblobBytes;
+      }
       break;
     case kOtcryptoRsaSize4096:
       HARDENED_CHECK_EQ(size, kOtcryptoRsaSize4096);
       key_length = kOtcryptoRsa4096PrivateKeyBytes;
       keyblob_length = kOtcryptoRsa4096PrivateKeyblobBytes;
+      if (launder32(crt) == kHardenedBoolTrue) {
+        keyblob_length = kOtcryptoRsa4096PrivateKeyCrtKeyblobBytes;
+      }
       break;
     default:
       return OTCRYPTO_BAD_ARGS;
@@ -193,7 +246,8 @@ otcrypto_status_t otcrypto_rsa_private_key_from_exponents(
   }
 
   // Check the mode and lengths for the private key.
-  HARDENED_TRY(private_key_structural_check(size, private_key));
+  HARDENED_TRY(
+      private_key_structural_check(size, kHardenedBoolFalse, private_key));
 
   switch (size) {
     case kOtcryptoRsaSize2048: {
@@ -249,6 +303,95 @@ otcrypto_status_t otcrypto_rsa_private_key_from_exponents(
   return OTCRYPTO_OK;
 }
 
+otcrypto_status_t otcrypto_rsa_private_key_from_crt(
+    otcrypto_rsa_size_t size, otcrypto_const_word32_buf_t modulus, uint32_t e,
+    otcrypto_const_word32_buf_t p, otcrypto_const_word32_buf_t q,
+    otcrypto_const_word32_buf_t d_p, otcrypto_const_word32_buf_t d_q,
+    otcrypto_const_word32_buf_t q_inv, otcrypto_blinded_key_t *private_key) {
+  if (modulus.data == NULL || p.data == NULL || q.data == NULL ||
+      d_p.data == NULL || d_q.data == NULL || q_inv.data == NULL ||
+      private_key == NULL || private_key->keyblob == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(rsa_mode_check(private_key->config.key_mode));
+
+  // The CRT result is checked with the public exponent on OTBN, which
+  // supports only F4 = 65537.
+  if (e != 65537) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Ensure that all CRT components are half the length of the modulus.
+  size_t half_len = modulus.len / 2;
+  if (p.len != half_len || q.len != half_len || d_p.len != half_len ||
+      d_q.len != half_len || q_inv.len != half_len || half_len == 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Ensure that the prime factors are exactly half the length of the modulus;
+  // the OTBN implementation relies on this to reduce intermediate values.
+  if ((p.data[half_len - 1] >> 31) != 1 || (q.data[half_len - 1] >> 31) != 1) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the mode and lengths for the private key.
+  HARDENED_TRY(
+      private_key_structural_check(size, kHardenedBoolTrue, private_key));
+
+  switch (size) {
+    case kOtcryptoRsaSize2048: {
+      if (private_key->keyblob_length != sizeof(rsa_2048_crt_private_key_t) ||
+          modulus.len != kRsa2048NumWords) {
+        return OTCRYPTO_BAD_ARGS;
+      }
+      rsa_2048_crt_private_key_t *sk =
+          (rsa_2048_crt_private_key_t *)private_key->keyblob;
+      hardened_memcpy(sk->n.data, modulus.data, modulus.len);
+      hardened_memcpy(sk->p.data, p.data, p.len);
+      hardened_memcpy(sk->q.data, q.data, q.len);
+      hardened_memcpy(sk->d_p.data, d_p.data, d_p.len);
+      hardened_memcpy(sk->d_q.data, d_q.data, d_q.len);
+      hardened_memcpy(sk->q_inv.data, q_inv.data, q_inv.len);
+      break;
+    }
+    case kOtcryptoRsaSize3072: {
+      if (private_key->keyblob_length != sizeof(rsa_3072_crt_private_key_t) ||
+          modulus.len != kRsa3072NumWords) {
+        return OTCRYPTO_BAD_ARGS;
+      }
+      rsa_3072_crt_private_key_t *sk =
+          (rsa_3072_crt_private_key_t *)private_key->keyblob;
+      hardened_memcpy(sk->n.data, modulus.data, modulus.len);
+      hardened_memcpy(sk->p.data, p.data, p.len);
+      hardened_memcpy(sk->q.data, q.data, q.len);
+      hardened_memcpy(sk->d_p.data, d_p.data, d_p.len);
+      hardened_memcpy(sk->d_q.data, d_q.data, d_q.len);
+      hardened_memcpy(sk->q_inv.data, q_inv.data, q_inv.len);
+      break;
+    }
+    case kOtcryptoRsaSize4096: {
+      if (private_key->keyblob_length != sizeof(rsa_4096_crt_private_key_t) ||
+          modulus.len != kRsa4096NumWords) {
+        return OTCRYPTO_BAD_ARGS;
+      }
+      rsa_4096_crt_private_key_t *sk =
+          (rsa_4096_crt_private_key_t *)private_key->keyblob;
+      hardened_memcpy(sk->n.data, modulus.data, modulus.len);
+      hardened_memcpy(sk->p.data, p.data, p.len);
+      hardened_memcpy(sk->q.data, q.data, q.len);
+      hardened_memcpy(sk->d_p.data, d_p.data, d_p.len);
+      hardened_memcpy(sk->d_q.data, d_q.data, d_q.len);
+      hardened_memcpy(sk->q_inv.data, q_inv.data, q_inv.len);
+      break;
+    }
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  private_key->checksum = integrity_blinded_checksum(private_key);
+  return OTCRYPTO_OK;
+}
+
 otcrypto_status_t otcrypto_rsa_keypair_from_cofactor(
     otcrypto_rsa_size_t size, otcrypto_const_word32_buf_t modulus, uint32_t e,
     otcrypto_const_word32_buf_t cofactor_share0,
@@ -445,7 +588,8 @@ otcrypto_status_t otcrypto_rsa_keygen_async_finalize(
   HARDENED_TRY(public_key_structural_check(public_key));
 
   // Check the caller-provided private key buffer.
-  HARDENED_TRY(private_key_structural_check(size, private_key));
+  HARDENED_TRY(
+      private_key_structural_check(size, kHardenedBoolFalse, private_key));
 
   // Call the required finalize() operation.
   switch (size) {
@@ -548,7 +692,8 @@ otcrypto_status_t otcrypto_rsa_keypair_from_cofactor_async_finalize(
   HARDENED_TRY(public_key_structural_check(public_key));
 
   // Check the caller-provided private key buffer.
-  HARDENED_TRY(private_key_structural_check(size, private_key));
+  HARDENED_TRY(
+      private_key_structural_check(size, kHardenedBoolFalse, private_key));
 
   // Call the required finalize() operation.
   switch (size) {
@@ -626,7 +771,8 @@ otcrypto_status_t otcrypto_rsa_sign_async_start(
   HARDENED_TRY(rsa_size_from_private_key(private_key, &size));
 
   // Check the caller-provided private key buffer.
-  HARDENED_TRY(private_key_structural_check(size, private_key));
+  hardened_bool_t crt = private_key_is_crt(size, private_key);
+  HARDENED_TRY(private_key_structural_check(size, crt, private_key));
 
   // Ensure the key mode matches the padding mode.
   HARDENED_TRY(
@@ -640,18 +786,42 @@ otcrypto_status_t otcrypto_rsa_sign_async_start(
   // Start the appropriate signature generation routine.
   switch (size) {
     case kOtcryptoRsaSize2048: {
+      if (launder32(crt) == kHardenedBoolTrue) {
+        HARDENED_CHECK_EQ(private_key->keyblob_length,
+                          sizeof(rsa_2048_crt_private_key_t));
+        rsa_2048_crt_private_key_t *sk =
+            (rsa_2048_crt_private_key_t *)private_key->keyblob;
+        return rsa_signature_generate_2048_crt_start(
+            sk, message_digest, (rsa_signature_padding_t)padding_mode);
+      }
       rsa_2048_private_key_t *sk =
           (rsa_2048_private_key_t *)private_key->keyblob;
       return rsa_signature_generate_2048_start(
           sk, message_digest, (rsa_signature_padding_t)padding_mode);
     }
     case kOtcryptoRsaSize3072: {
+      if (launder32(crt) == kHardenedBoolTrue) {
+        HARDENED_CHECK_EQ(private_key->keyblob_length,
+                          sizeof(rsa_3072_crt_private_key_t));
+        rsa_3072_crt_private_key_t *sk =
+            (rsa_3072_crt_private_key_t *)private_key->keyblob;
+        return rsa_signature_generate_3072_crt_start(
+            sk, message_digest, (rsa_signature_padding_t)padding_mode);
+      }
       rsa_3072_private_key_t *sk =
           (rsa_3072_private_key_t *)private_key->keyblob;
       return rsa_signature_generate_3072_start(
           sk, message_digest, (rsa_signature_padding_t)padding_mode);
     }
     case kOtcryptoRsaSize4096: {
+      if (launder32(crt) == kHardenedBoolTrue) {
+        HARDENED_CHECK_EQ(private_key->keyblob_length,
+                          sizeof(rsa_4096_crt_private_key_t));
+        rsa_4096_crt_private_key_t *sk =
+            (rsa_4096_crt_private_key_t *)private_key->keyblob;
+        return rsa_signature_generate_4096_crt_start(
+            sk, message_digest, (rsa_signature_padding_t)padding_mode);
+      }
       rsa_4096_private_key_t *sk =
           (rsa_4096_private_key_t *)private_key->keyblob;
       return rsa_signature_generate_4096_start(
@@ -886,7 +1056,8 @@ otcrypto_status_t otcrypto_rsa_decrypt_async_start(
   HARDENED_TRY(rsa_size_from_private_key(private_key, &size));
 
   // Check the caller-provided private key buffer.
-  HARDENED_TRY(private_key_structural_check(size, private_key));
+  hardened_bool_t crt = private_key_is_crt(size, private_key);
+  HARDENED_TRY(private_key_structural_check(size, crt, private_key));
 
   // Verify the checksum.
   if (integrity_blinded_key_check(private_key) != kHardenedBoolTrue) {
@@ -905,38 +1076,59 @@ otcrypto_status_t otcrypto_rsa_decrypt_async_start(
   switch (launder32(size)) {
     case kOtcryptoRsaSize2048: {
       HARDENED_CHECK_EQ(size, kOtcryptoRsaSize2048);
-      HARDENED_CHECK_EQ(private_key->keyblob_length,
-                        sizeof(rsa_2048_private_key_t));
       if (ciphertext.len != kRsa2048NumWords) {
         return OTCRYPTO_BAD_ARGS;
       }
+      rsa_2048_int_t *ctext = (rsa_2048_int_t *)ciphertext.data;
+      if (launder32(crt) == kHardenedBoolTrue) {
+        HARDENED_CHECK_EQ(private_key->keyblob_length,
+                          sizeof(rsa_2048_crt_private_key_t));
+        rsa_2048_crt_private_key_t *sk =
+            (rsa_2048_crt_private_key_t *)private_key->keyblob;
+        return rsa_decrypt_2048_crt_start(sk, ctext);
+      }
+      HARDENED_CHECK_EQ(private_key->keyblob_length,
+                        sizeof(rsa_2048_private_key_t));
       rsa_2048_private_key_t *sk =
           (rsa_2048_private_key_t *)private_key->keyblob;
-      rsa_2048_int_t *ctext = (rsa_2048_int_t *)ciphertext.data;
       return rsa_decrypt_2048_start(sk, ctext);
     }
     case kOtcryptoRsaSize3072: {
       HARDENED_CHECK_EQ(size, kOtcryptoRsaSize3072);
-      HARDENED_CHECK_EQ(private_key->keyblob_length,
-                        sizeof(rsa_3072_private_key_t));
       if (ciphertext.len != kRsa3072NumWords) {
         return OTCRYPTO_BAD_ARGS;
       }
+      rsa_3072_int_t *ctext = (rsa_3072_int_t *)ciphertext.data;
+      if (launder32(crt) == kHardenedBoolTrue) {
+        HARDENED_CHECK_EQ(private_key->keyblob_length,
+                          sizeof(rsa_3072_crt_private_key_t));
+        rsa_3072_crt_private_key_t *sk =
+            (rsa_3072_crt_private_key_t *)private_key->keyblob;
+        return rsa_decrypt_3072_crt_start(sk, ctext);
+      }
+      HARDENED_CHECK_EQ(private_key->keyblob_length,
+                        sizeof(rsa_3072_private_key_t));
       rsa_3072_private_key_t *sk =
           (rsa_3072_private_key_t *)private_key->keyblob;
-      rsa_3072_int_t *ctext = (rsa_3072_int_t *)ciphertext.data;
       return rsa_decrypt_3072_start(sk, ctext);
     }
     case kOtcryptoRsaSize4096: {
       HARDENED_CHECK_EQ(size, kOtcryptoRsaSize4096);
-      HARDENED_CHECK_EQ(private_key->keyblob_length,
-                        sizeof(rsa_4096_private_key_t));
       if (ciphertext.len != kRsa4096NumWords) {
         return OTCRYPTO_BAD_ARGS;
       }
+      rsa_4096_int_t *ctext = (rsa_4096_int_t *)ciphertext.data;
+      if (launder32(crt) == kHardenedBoolTrue) {
+        HARDENED_CHECK_EQ(private_key->keyblob_length,
+                          sizeof(rsa_4096_crt_private_key_t));
+        rsa_4096_crt_private_key_t *sk =
+            (rsa_4096_crt_private_key_t *)private_key->keyblob;
+        return rsa_decrypt_4096_crt_start(sk, ctext);
+      }
+      HARDENED_CHECK_EQ(private_key->keyblob_length,
+                        sizeof(rsa_4096_private_key_t));
       rsa_4096_private_key_t *sk =
           (rsa_4096_private_key_t *)private_key->keyblob;
-      rsa_4096_int_t *ctext = (rsa_4096_int_t *)ciphertext.data;
       return rsa_decrypt_4096_start(sk, ctext);
     }
     default:
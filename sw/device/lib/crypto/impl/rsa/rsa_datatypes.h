@@ -156,6 +156,57 @@ typedef struct rsa_4096_cofactor_t {
   uint32_t data[kRsa4096NumWords / 2];
 } rsa_4096_cofactor_t;
 
+/**
+ * A type that holds an RSA-2048 private key in CRT form.
+ *
+ * The private key consists of the prime factors p and q, the CRT exponents
+ * d_p = d mod (p-1) and d_q = d mod (q-1), the CRT coefficient q_inv = q^-1
+ * mod p, and the public modulus n. All values except n are half the size of
+ * the modulus. The public exponent must be 65537.
+ */
+typedef struct rsa_2048_crt_private_key_t {
+  rsa_2048_cofactor_t p;
+  rsa_2048_cofactor_t q;
+  rsa_2048_cofactor_t d_p;
+  rsa_2048_cofactor_t d_q;
+  rsa_2048_cofactor_t q_inv;
+  rsa_2048_int_t n;
+} rsa_2048_crt_private_key_t;
+
+/**
+ * A type that holds an RSA-3072 private key in CRT form.
+ *
+ * The private key consists of the prime factors p and q, the CRT exponents
+ * d_p = d mod (p-1) and d_q = d mod (q-1), the CRT coefficient q_inv = q^-1
+ * mod p, and the public modulus n. All values except n are half the size of
+ * the modulus. The public exponent must be 65537.
+ */
+typedef struct rsa_3072_crt_private_key_t {
+  rsa_3072_cofactor_t p;
+  rsa_3072_cofactor_t q;
+  rsa_3072_cofactor_t d_p;
+  rsa_3072_cofactor_t d_q;
+  rsa_3072_cofactor_t q_inv;
+  rsa_3072_int_t n;
+} rsa_3072_crt_private_key_t;
+
+/**
+ * A type that holds an RSA-4096 private key in CRT form.
+ *
+ * The private key consists of the prime factors p and q, the CRT exponents
+ * d_p = d mod (p-1) and d_q = d mod (q-1), the CRT coefficient q_inv = q^-1
+ * mod p, and the public modulus n. All values except n are half the size of
+ * the modulus. The public exponent must be 65537.
+ */
+typedef struct rsa_4096_crt_private_key_t {
+  rsa_4096_cofactor_t p;
+  rsa_4096_cofactor_t q;
+  rsa_4096_cofactor_t d_p;
+  rsa_4096_cofactor_t d_q;
+  rsa_4096_cofactor_t q_inv;
+  rsa_4096_int_t n;
+} rsa_4096_crt_private_key_t;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -66,6 +66,22 @@ OT_WARN_UNUSED_RESULT
 status_t rsa_decrypt_2048_start(const rsa_2048_private_key_t *private_key,
                                 const rsa_2048_int_t *ciphertext);
 
+/**
+ * Start decrypting a message with an RSA-2048 CRT key; returns immediately.
+ *
+ * The result can be retrieved with `rsa_decrypt_finalize()`.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key RSA private key in CRT form.
+ * @param ciphertext Encrypted message.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t rsa_decrypt_2048_crt_start(
+    const rsa_2048_crt_private_key_t *private_key,
+    const rsa_2048_int_t *ciphertext);
+
 /**
  * Waits for an RSA decryption to complete.
  *
@@ -153,6 +169,22 @@ OT_WARN_UNUSED_RESULT
 status_t rsa_decrypt_3072_start(const rsa_3072_private_key_t *private_key,
                                 const rsa_3072_int_t *ciphertext);
 
+/**
+ * Start decrypting a message with an RSA-3072 CRT key; returns immediately.
+ *
+ * The result can be retrieved with `rsa_decrypt_finalize()`.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key RSA private key in CRT form.
+ * @param ciphertext Encrypted message.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t rsa_decrypt_3072_crt_start(
+    const rsa_3072_crt_private_key_t *private_key,
+    const rsa_3072_int_t *ciphertext);
+
 /**
  * Starts encrypting a message with RSA-4096; returns immediately.
  *
@@ -202,6 +234,22 @@ OT_WARN_UNUSED_RESULT
 status_t rsa_decrypt_4096_start(const rsa_4096_private_key_t *private_key,
                                 const rsa_4096_int_t *ciphertext);
 
+/**
+ * Start decrypting a message with an RSA-4096 CRT key; returns immediately.
+ *
+ * The result can be retrieved with `rsa_decrypt_finalize()`.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key RSA private key in CRT form.
+ * @param ciphertext Encrypted message.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t rsa_decrypt_4096_crt_start(
+    const rsa_4096_crt_private_key_t *private_key,
+    const rsa_4096_int_t *ciphertext);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -14,6 +14,9 @@ OTBN_DECLARE_SYMBOL_ADDR(run_rsa_modexp, mode);   // Application mode.
 OTBN_DECLARE_SYMBOL_ADDR(run_rsa_modexp, n);      // Public modulus n.
 OTBN_DECLARE_SYMBOL_ADDR(run_rsa_modexp, d);      // Private exponent d.
 OTBN_DECLARE_SYMBOL_ADDR(run_rsa_modexp, inout);  // Input/output buffer.
+OTBN_DECLARE_SYMBOL_ADDR(run_rsa_modexp, p);      // Prime factor p.
+OTBN_DECLARE_SYMBOL_ADDR(run_rsa_modexp, q);      // Prime factor q.
+OTBN_DECLARE_SYMBOL_ADDR(run_rsa_modexp, q_inv);  // CRT coefficient.
 
 static const otbn_app_t kOtbnAppRsaModexp = OTBN_APP_T_INIT(run_rsa_modexp);
 static const otbn_addr_t kOtbnVarRsaMode =
@@ -22,6 +25,10 @@ static const otbn_addr_t kOtbnVarRsaN = OTBN_ADDR_T_INIT(run_rsa_modexp, n);
 static const otbn_addr_t kOtbnVarRsaD = OTBN_ADDR_T_INIT(run_rsa_modexp, d);
 static const otbn_addr_t kOtbnVarRsaInOut =
     OTBN_ADDR_T_INIT(run_rsa_modexp, inout);
+static const otbn_addr_t kOtbnVarRsaP = OTBN_ADDR_T_INIT(run_rsa_modexp, p);
+static const otbn_addr_t kOtbnVarRsaQ = OTBN_ADDR_T_INIT(run_rsa_modexp, q);
+static const otbn_addr_t kOtbnVarRsaQInv =
+    OTBN_ADDR_T_INIT(run_rsa_modexp, q_inv);
 
 enum {
   /**
@@ -34,6 +41,9 @@ enum {
   kMode3072ModexpF4 = 0x6d1,
   kMode4096Modexp = 0x70b,
   kMode4096ModexpF4 = 0x0ee,
+  kMode2048ModexpCrt = 0x1a3,
+  kMode3072ModexpCrt = 0x472,
+  kMode4096ModexpCrt = 0x62c,
   /**
    * Common RSA exponent with a specialized implementation.
    *
@@ -56,16 +66,22 @@ status_t rsa_modexp_wait(size_t *num_words) {
     case kMode2048Modexp:
       OT_FALLTHROUGH_INTENDED;
     case kMode2048ModexpF4:
+      OT_FALLTHROUGH_INTENDED;
+    case kMode2048ModexpCrt:
       *num_words = kRsa2048NumWords;
       break;
     case kMode3072Modexp:
       OT_FALLTHROUGH_INTENDED;
     case kMode3072ModexpF4:
+      OT_FALLTHROUGH_INTENDED;
+    case kMode3072ModexpCrt:
       *num_words = kRsa3072NumWords;
       break;
     case kMode4096Modexp:
       OT_FALLTHROUGH_INTENDED;
     case kMode4096ModexpF4:
+      OT_FALLTHROUGH_INTENDED;
+    case kMode4096ModexpCrt:
       *num_words = kRsa4096NumWords;
       break;
     default:
@@ -103,6 +119,51 @@ static status_t rsa_modexp_finalize(const size_t num_words, uint32_t *result) {
   return otbn_dmem_sec_wipe();
 }
 
+/**
+ * Loads the OTBN app and writes the inputs for a CRT modular exponentiation.
+ *
+ * Each of the CRT private key components is half the size of the modulus;
+ * d_q is written immediately after d_p in the exponent buffer.
+ *
+ * @param mode Application mode.
+ * @param num_words Number of words for the modulus.
+ * @param base Exponentiation base (`num_words` words).
+ * @param modulus Public modulus n (`num_words` words).
+ * @param p Prime factor p (`num_words / 2` words).
+ * @param q Prime factor q (`num_words / 2` words).
+ * @param d_p CRT exponent d mod (p-1) (`num_words / 2` words).
+ * @param d_q CRT exponent d mod (q-1) (`num_words / 2` words).
+ * @param q_inv CRT coefficient q^-1 mod p (`num_words / 2` words).
+ * @return Status of the operation (OK or error).
+ */
+static status_t rsa_modexp_crt_start(
+    const uint32_t mode, const size_t num_words, const uint32_t *base,
+    const uint32_t *modulus, const uint32_t *p, const uint32_t *q,
+    const uint32_t *d_p, const uint32_t *d_q, const uint32_t *q_inv) {
+  const size_t half_words = num_words / 2;
+
+  // Load the OTBN app. Fails if OTBN is not idle.
+  HARDENED_TRY(otbn_load_app(kOtbnAppRsaModexp));
+
+  // Set mode.
+  HARDENED_TRY(otbn_dmem_write(1, &mode, kOtbnVarRsaMode));
+
+  // Set the base and the modulus n.
+  HARDENED_TRY(otbn_dmem_write(num_words, base, kOtbnVarRsaInOut));
+  HARDENED_TRY(otbn_dmem_write(num_words, modulus, kOtbnVarRsaN));
+
+  // Set the CRT components of the private key.
+  HARDENED_TRY(otbn_dmem_write(half_words, p, kOtbnVarRsaP));
+  HARDENED_TRY(otbn_dmem_write(half_words, q, kOtbnVarRsaQ));
+  HARDENED_TRY(otbn_dmem_write(half_words, d_p, kOtbnVarRsaD));
+  HARDENED_TRY(otbn_dmem_write(
+      half_words, d_q, kOtbnVarRsaD + half_words * sizeof(uint32_t)));
+  HARDENED_TRY(otbn_dmem_write(half_words, q_inv, kOtbnVarRsaQInv));
+
+  // Start OTBN.
+  return otbn_execute();
+}
+
 status_t rsa_modexp_consttime_2048_start(const rsa_2048_int_t *base,
                                          const rsa_2048_int_t *exp,
                                          const rsa_2048_int_t *modulus) {
@@ -149,6 +210,14 @@ status_t rsa_modexp_vartime_2048_start(const rsa_2048_int_t *base,
   return otbn_execute();
 }
 
+status_t rsa_modexp_crt_2048_start(
+    const rsa_2048_int_t *base, const rsa_2048_crt_private_key_t *private_key) {
+  return rsa_modexp_crt_start(kMode2048ModexpCrt, kRsa2048NumWords, base->data,
+                              private_key->n.data, private_key->p.data,
+                              private_key->q.data, private_key->d_p.data,
+                              private_key->d_q.data, private_key->q_inv.data);
+}
+
 status_t rsa_modexp_2048_finalize(rsa_2048_int_t *result) {
   return rsa_modexp_finalize(kRsa2048NumWords, result->data);
 }
@@ -199,6 +268,14 @@ status_t rsa_modexp_vartime_3072_start(const rsa_3072_int_t *base,
   return otbn_execute();
 }
 
+status_t rsa_modexp_crt_3072_start(
+    const rsa_3072_int_t *base, const rsa_3072_crt_private_key_t *private_key) {
+  return rsa_modexp_crt_start(kMode3072ModexpCrt, kRsa3072NumWords, base->data,
+                              private_key->n.data, private_key->p.data,
+                              private_key->q.data, private_key->d_p.data,
+                              private_key->d_q.data, private_key->q_inv.data);
+}
+
 status_t rsa_modexp_3072_finalize(rsa_3072_int_t *result) {
   return rsa_modexp_finalize(kRsa3072NumWords, result->data);
 }
@@ -249,6 +326,14 @@ status_t rsa_modexp_vartime_4096_start(const rsa_4096_int_t *base,
   return otbn_execute();
 }
 
+status_t rsa_modexp_crt_4096_start(
+    const rsa_4096_int_t *base, const rsa_4096_crt_private_key_t *private_key) {
+  return rsa_modexp_crt_start(kMode4096ModexpCrt, kRsa4096NumWords, base->data,
+                              private_key->n.data, private_key->p.data,
+                              private_key->q.data, private_key->d_p.data,
+                              private_key->d_q.data, private_key->q_inv.data);
+}
+
 status_t rsa_modexp_4096_finalize(rsa_4096_int_t *result) {
   return rsa_modexp_finalize(kRsa4096NumWords, result->data);
 }
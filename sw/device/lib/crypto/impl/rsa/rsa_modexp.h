@@ -64,12 +64,31 @@ status_t rsa_modexp_vartime_2048_start(const rsa_2048_int_t *base,
                                        const uint32_t exp,
                                        const rsa_2048_int_t *modulus);
 
+/**
+ * Start a constant-time RSA-2048 modular exponentiation with a CRT key.
+ *
+ * Computes (base ^ d) mod n from the CRT form of the private key, which is
+ * several times faster than `rsa_modexp_consttime_2048_start()`. The result is
+ * checked against the base using the public exponent 65537 before it is
+ * released; if the check fails (for example, because the base is not less
+ * than the modulus, or because of a fault), OTBN reports an error.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param base Exponentiation base.
+ * @param private_key Private key in CRT form.
+ * @return Status of the operation (OK or error).
+ */
+status_t rsa_modexp_crt_2048_start(
+    const rsa_2048_int_t *base, const rsa_2048_crt_private_key_t *private_key);
+
 /**
  * Waits for an RSA-2048 modular exponentiation to complete.
  *
- * Can be used after either:
+ * Can be used after any of:
  * - `rsa_modexp_consttime_2048_start()`
  * - `rsa_modexp_vartime_2048_start()`
+ * - `rsa_modexp_crt_2048_start()`
  *
  * @param[out] result Exponentiation result = (base ^ exp) mod modulus.
  * @return Status of the operation (OK or error).
@@ -110,12 +129,31 @@ status_t rsa_modexp_vartime_3072_start(const rsa_3072_int_t *base,
                                        const uint32_t exp,
                                        const rsa_3072_int_t *modulus);
 
+/**
+ * Start a constant-time RSA-3072 modular exponentiation with a CRT key.
+ *
+ * Computes (base ^ d) mod n from the CRT form of the private key, which is
+ * several times faster than `rsa_modexp_consttime_3072_start()`. The result is
+ * checked against the base using the public exponent 65537 before it is
+ * released; if the check fails (for example, because the base is not less
+ * than the modulus, or because of a fault), OTBN reports an error.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param base Exponentiation base.
+ * @param private_key Private key in CRT form.
+ * @return Status of the operation (OK or error).
+ */
+status_t rsa_modexp_crt_3072_start(
+    const rsa_3072_int_t *base, const rsa_3072_crt_private_key_t *private_key);
+
 /**
  * Waits for an RSA-3072 modular exponentiation to complete.
  *
- * Can be used after either:
+ * Can be used after any of:
  * - `rsa_modexp_consttime_3072_start()`
  * - `rsa_modexp_vartime_3072_start()`
+ * - `rsa_modexp_crt_3072_start()`
  *
  * @param[out] result Exponentiation result = (base ^ exp) mod modulus.
  * @return Status of the operation (OK or error).
@@ -156,12 +194,31 @@ status_t rsa_modexp_vartime_4096_start(const rsa_4096_int_t *base,
                                        const uint32_t exp,
                                        const rsa_4096_int_t *modulus);
 
+/**
+ * Start a constant-time RSA-4096 modular exponentiation with a CRT key.
+ *
+ * Computes (base ^ d) mod n from the CRT form of the private key, which is
+ * several times faster than `rsa_modexp_consttime_4096_start()`. The result is
+ * checked against the base using the public exponent 65537 before it is
+ * released; if the check fails (for example, because the base is not less
+ * than the modulus, or because of a fault), OTBN reports an error.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param base Exponentiation base.
+ * @param private_key Private key in CRT form.
+ * @return Status of the operation (OK or error).
+ */
+status_t rsa_modexp_crt_4096_start(
+    const rsa_4096_int_t *base, const rsa_4096_crt_private_key_t *private_key);
+
 /**
  * Waits for an RSA-4096 modular exponentiation to complete.
  *
- * Can be used after either:
+ * Can be used after any of:
  * - `rsa_modexp_consttime_4096_start()`
  * - `rsa_modexp_vartime_4096_start()`
+ * - `rsa_modexp_crt_4096_start()`
  *
  * @param[out] result Exponentiation result = (base ^ exp) mod modulus.
  * @return Status of the operation (OK or error).
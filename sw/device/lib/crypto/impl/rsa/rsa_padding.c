@@ -4,6 +4,7 @@
 
 #include "sw/device/lib/crypto/impl/rsa/rsa_padding.h"
 
+#include "sw/device/lib/base/arena.h"
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/math.h"
@@ -14,6 +15,16 @@
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('r', 'p', 'a')
 
+/**
+ * Scratch space for the OAEP data block and its mask.
+ *
+ * The data block is shorter than the modulus, so two modulus-sized buffers are
+ * enough for the largest supported key. The data block holds the plaintext,
+ * so released memory is shredded.
+ */
+static uint32_t oaep_arena_buf[2 * kRsa4096NumWords];
+static arena_t oaep_arena = ARENA_INIT(oaep_arena_buf, kHardenedBoolTrue);
+
 /**
  * Digest identifiers for different hash functions (little-endian).
  *
@@ -540,11 +551,14 @@ status_t rsa_padding_oaep_max_message_bytelen(
   return OTCRYPTO_OK;
 }
 
-status_t rsa_padding_oaep_encode(const otcrypto_hash_mode_t hash_mode,
-                                 const uint8_t *message, size_t message_bytelen,
-                                 const uint8_t *label, size_t label_bytelen,
-                                 size_t encoded_message_len,
-                                 uint32_t *encoded_message) {
+/**
+ * Implements `rsa_padding_oaep_encode()`, allocating from `oaep_arena`.
+ */
+static status_t oaep_encode(const otcrypto_hash_mode_t hash_mode,
+                            const uint8_t *message, size_t message_bytelen,
+                            const uint8_t *label, size_t label_bytelen,
+                            size_t encoded_message_len,
+                            uint32_t *encoded_message) {
   // Check that the message is not too long (RFC 8017, section 7.1.1, step 1a).
   size_t max_message_bytelen = 0;
   HARDENED_TRY(rsa_padding_oaep_max_message_bytelen(
@@ -585,7 +599,10 @@ status_t rsa_padding_oaep_encode(const otcrypto_hash_mode_t hash_mode,
   size_t encoded_message_bytelen = encoded_message_len * sizeof(uint32_t);
   size_t db_bytelen = encoded_message_bytelen - digest_bytelen - 1;
   size_t db_wordlen = ceil_div(db_bytelen, sizeof(uint32_t));
-  uint32_t db[db_wordlen];
+  uint32_t *db = arena_alloc(&oaep_arena, db_wordlen * sizeof(uint32_t));
+  if (db == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
   HARDENED_TRY(
       mgf1(hash_mode, (unsigned char *)seed, sizeof(seed), db_bytelen, db));
 
@@ -617,18 +634,35 @@ status_t rsa_padding_oaep_encode(const otcrypto_hash_mode_t hash_mode,
   unsigned char *encoded_message_bytes = (unsigned char *)encoded_message;
   encoded_message_bytes[0] = 0x00;
   memcpy(encoded_message_bytes + 1, seed, sizeof(seed));
-  memcpy(encoded_message_bytes + 1 + sizeof(seed), db, sizeof(db));
+  memcpy(encoded_message_bytes + 1 + sizeof(seed), db,
+         db_wordlen * sizeof(uint32_t));
 
   // Reverse the byte-order.
   reverse_bytes(encoded_message_len, encoded_message);
   return OTCRYPTO_OK;
 }
 
-status_t rsa_padding_oaep_decode(const otcrypto_hash_mode_t hash_mode,
+status_t rsa_padding_oaep_encode(const otcrypto_hash_mode_t hash_mode,
+                                 const uint8_t *message, size_t message_bytelen,
                                  const uint8_t *label, size_t label_bytelen,
-                                 uint32_t *encoded_message,
-                                 size_t encoded_message_len, uint8_t *message,
-                                 size_t *message_bytelen) {
+                                 size_t encoded_message_len,
+                                 uint32_t *encoded_message) {
+  size_t mark = arena_mark(&oaep_arena);
+  status_t result =
+      oaep_encode(hash_mode, message, message_bytelen, label, label_bytelen,
+                  encoded_message_len, encoded_message);
+  arena_release(&oaep_arena, mark);
+  return result;
+}
+
+/**
+ * Implements `rsa_padding_oaep_decode()`, allocating from `oaep_arena`.
+ */
+static status_t oaep_decode(const otcrypto_hash_mode_t hash_mode,
+                            const uint8_t *label, size_t label_bytelen,
+                            uint32_t *encoded_message,
+                            size_t encoded_message_len, uint8_t *message,
+                            size_t *message_bytelen) {
   // Reverse the byte-order.
   reverse_bytes(encoded_message_len, encoded_message);
   *message_bytelen = 0;
@@ -650,7 +684,11 @@ status_t rsa_padding_oaep_decode(const otcrypto_hash_mode_t hash_mode,
   size_t encoded_message_bytelen = encoded_message_len * sizeof(uint32_t);
   size_t db_bytelen = encoded_message_bytelen - digest_bytelen - 1;
   size_t db_wordlen = ceil_div(db_bytelen, sizeof(uint32_t));
-  uint32_t db[db_wordlen];
+  uint32_t *db = arena_alloc(&oaep_arena, db_wordlen * sizeof(uint32_t));
+  uint32_t *db_mask = arena_alloc(&oaep_arena, db_wordlen * sizeof(uint32_t));
+  if (db == NULL || db_mask == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
   memcpy(db, encoded_message_bytes + 1 + sizeof(seed), db_bytelen);
 
   // Compute seedMask = MGF(maskedDB, hLen) (step 3c).
@@ -664,19 +702,18 @@ status_t rsa_padding_oaep_decode(const otcrypto_hash_mode_t hash_mode,
   }
 
   // Generate dbMask = MGF(seed, k - hLen - 1) (step 3e).
-  uint32_t db_mask[db_wordlen];
   HARDENED_TRY(mgf1(hash_mode, (unsigned char *)seed, sizeof(seed), db_bytelen,
                     db_mask));
 
   // Zero trailing bytes of DB and dbMask if needed.
-  size_t num_trailing_bytes = sizeof(db) - db_bytelen;
+  size_t num_trailing_bytes = db_wordlen * sizeof(uint32_t) - db_bytelen;
   if (num_trailing_bytes > 0) {
     memset(((unsigned char *)db) + db_bytelen, 0, num_trailing_bytes);
     memset(((unsigned char *)db_mask) + db_bytelen, 0, num_trailing_bytes);
   }
 
   // Construct DB = dbMask XOR maskedDB.
-  for (size_t i = 0; i < ARRAYSIZE(db); i++) {
+  for (size_t i = 0; i < db_wordlen; i++) {
     db[i] ^= db_mask[i];
   }
 
@@ -753,3 +790,16 @@ status_t rsa_padding_oaep_decode(const otcrypto_hash_mode_t hash_mode,
   }
   return OTCRYPTO_OK;
 }
+
+status_t rsa_padding_oaep_decode(const otcrypto_hash_mode_t hash_mode,
+                                 const uint8_t *label, size_t label_bytelen,
+                                 uint32_t *encoded_message,
+                                 size_t encoded_message_len, uint8_t *message,
+                                 size_t *message_bytelen) {
+  size_t mark = arena_mark(&oaep_arena);
+  status_t result =
+      oaep_decode(hash_mode, label, label_bytelen, encoded_message,
+                  encoded_message_len, message, message_bytelen);
+  arena_release(&oaep_arena, mark);
+  return result;
+}
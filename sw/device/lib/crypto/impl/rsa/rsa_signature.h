@@ -58,6 +58,24 @@ status_t rsa_signature_generate_2048_start(
     const otcrypto_hash_digest_t message_digest,
     const rsa_signature_padding_t padding_mode);
 
+/**
+ * Starts generating an RSA-2048 signature with a CRT key; returns immediately.
+ *
+ * The result can be retrieved with `rsa_signature_generate_2048_finalize()`.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key RSA private key in CRT form.
+ * @param message_digest Message digest to sign.
+ * @param padding_mode Signature padding mode.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t rsa_signature_generate_2048_crt_start(
+    const rsa_2048_crt_private_key_t *private_key,
+    const otcrypto_hash_digest_t message_digest,
+    const rsa_signature_padding_t padding_mode);
+
 /**
  * Waits for an RSA-2048 signature generation to complete.
  *
@@ -124,6 +142,24 @@ status_t rsa_signature_generate_3072_start(
     const otcrypto_hash_digest_t message_digest,
     const rsa_signature_padding_t padding_mode);
 
+/**
+ * Starts generating an RSA-3072 signature with a CRT key; returns immediately.
+ *
+ * The result can be retrieved with `rsa_signature_generate_3072_finalize()`.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key RSA private key in CRT form.
+ * @param message_digest Message digest to sign.
+ * @param padding_mode Signature padding mode.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t rsa_signature_generate_3072_crt_start(
+    const rsa_3072_crt_private_key_t *private_key,
+    const otcrypto_hash_digest_t message_digest,
+    const rsa_signature_padding_t padding_mode);
+
 /**
  * Waits for an RSA-3072 signature generation to complete.
  *
@@ -167,6 +203,24 @@ status_t rsa_signature_generate_4096_start(
     const otcrypto_hash_digest_t message_digest,
     const rsa_signature_padding_t padding_mode);
 
+/**
+ * Starts generating an RSA-4096 signature with a CRT key; returns immediately.
+ *
+ * The result can be retrieved with `rsa_signature_generate_4096_finalize()`.
+ *
+ * Returns an `OTCRYPTO_ASYNC_INCOMPLETE` error if OTBN is busy.
+ *
+ * @param private_key RSA private key in CRT form.
+ * @param message_digest Message digest to sign.
+ * @param padding_mode Signature padding mode.
+ * @return Result of the operation (OK or error).
+ */
+OT_WARN_UNUSED_RESULT
+status_t rsa_signature_generate_4096_crt_start(
+    const rsa_4096_crt_private_key_t *private_key,
+    const otcrypto_hash_digest_t message_digest,
+    const rsa_signature_padding_t padding_mode);
+
 /**
  * Waits for an RSA-4096 signature generation to complete.
  *
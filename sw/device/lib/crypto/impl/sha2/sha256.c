@@ -220,10 +220,19 @@ static status_t process_message(sha256_state_t *state, const uint8_t *msg,
   // present (which is only possible on the first iteration).
   while (msg_len >= kSha256MessageBlockBytes - partial_block_len) {
     size_t available_len = kSha256MessageBlockBytes - partial_block_len;
-    memcpy((unsigned char *)block.data + partial_block_len, msg, available_len);
+    if (partial_block_len == 0 && misalignment32_of((uintptr_t)msg) == 0) {
+      // Whole, word-aligned block: load it into DMEM straight from the
+      // caller's buffer instead of staging it in `block`.
+      const sha256_message_block_t *msg_block =
+          (const sha256_message_block_t *)msg;
+      HARDENED_TRY(process_block(&ctx, msg_block));
+    } else {
+      memcpy((unsigned char *)block.data + partial_block_len, msg,
+             available_len);
+      HARDENED_TRY(process_block(&ctx, &block));
+    }
     msg += available_len;
     msg_len -= available_len;
-    HARDENED_TRY(process_block(&ctx, &block));
     partial_block_len = 0;
   }
 
@@ -0,0 +1,63 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_INCLUDE_ASYNC_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_INCLUDE_ASYNC_H_
+
+#include "datatypes.h"
+
+/**
+ * @file
+ * @brief Completion helpers for asynchronous operations in the OpenTitan
+ * cryptography library.
+ *
+ * Asymmetric operations (ECDSA, ECDH, RSA) are split into `_async_start` and
+ * `_async_finalize` calls; the hardware computes between the two. The
+ * `_async_finalize` functions block until the hardware is done, so a caller
+ * that wants to do other work in the meantime should only call them once
+ * `otcrypto_async_poll()` reports completion, either by polling or from the
+ * handler of the completion interrupt.
+ *
+ * Only one asynchronous asymmetric operation can be in flight at a time.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Checks whether the in-flight asynchronous operation has completed.
+ *
+ * Does not block. Returns `kOtcryptoStatusValueAsyncIncomplete` while the
+ * operation is still running. Once it has finished, acknowledges the
+ * completion interrupt and returns `kOtcryptoStatusValueOk`, after which the
+ * corresponding `_async_finalize` function returns without waiting. Any other
+ * value indicates that the operation failed; the `_async_finalize` function
+ * will report the same error.
+ *
+ * @return Result of the poll operation.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_async_poll(void);
+
+/**
+ * Enables or disables the completion interrupt for asynchronous operations.
+ *
+ * When enabled, the accelerator raises its done interrupt when an operation
+ * started by an `_async_start` function finishes. Routing the interrupt to a
+ * handler is up to the caller; the handler should call
+ * `otcrypto_async_poll()` to acknowledge it.
+ *
+ * @param enable `kHardenedBoolTrue` to enable the interrupt,
+ * `kHardenedBoolFalse` to disable it.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_async_irq_set_enabled(hardened_bool_t enable);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_INCLUDE_ASYNC_H_
@@ -103,6 +103,14 @@ typedef struct otcrypto_byte_buf {
  * necessary to have this structure separate from `otcrypto_byte_buf_t` because
  * data pointed to by a struct does not inherit `const`, so `const
  * otcrypto_byte_buf_t` would still allow data to change.
+ *
+ * Byte buffers may have any alignment, and `data` may point into any memory
+ * the CPU can read (including flash or retention SRAM). Buffers whose `data`
+ * pointer is 32-bit aligned are faster: SHA-2 loads whole message blocks into
+ * OTBN directly from them, AES streams full blocks between aligned input and
+ * output buffers without an intermediate copy, and the HMAC and KMAC drivers
+ * write them to the message FIFO a word at a time from the start rather than
+ * byte-by-byte until the first word boundary.
  */
 typedef struct otcrypto_const_byte_buf {
   // Pointer to the data.
@@ -120,6 +120,33 @@ otcrypto_status_t otcrypto_drbg_manual_generate(
     otcrypto_const_byte_buf_t additional_input,
     otcrypto_word32_buf_t drbg_output);
 
+/**
+ * Fills the software-side DRBG output pool.
+ *
+ * Requests a full pool of output from the DRBG in a single generate command
+ * and enables the pool. While the pool is enabled, `otcrypto_drbg_generate`
+ * calls with empty additional input that fit in the pool are served from it
+ * instead of issuing their own generate command; when the pool runs dry it is
+ * refilled in one command. Calling this function while the system is idle
+ * moves the CSRNG latency out of later small requests.
+ *
+ * Pooled output is checked for FIPS compatibility in the same way as
+ * `otcrypto_drbg_generate` output. The pool is discarded by any instantiate,
+ * reseed or uninstantiate operation, so output generated before a reseed is
+ * never handed out after it. Requests with additional input, requests larger
+ * than the pool, and `otcrypto_drbg_manual_generate` always bypass the pool.
+ *
+ * @return Result of the refill operation.
+ */
+otcrypto_status_t otcrypto_drbg_pool_refill(void);
+
+/**
+ * Disables the software-side DRBG output pool and wipes its contents.
+ *
+ * @return Result of the flush operation.
+ */
+otcrypto_status_t otcrypto_drbg_pool_flush(void);
+
 /**
  * Uninstantiates DRBG and clears the context.
  *
@@ -165,6 +165,97 @@ otcrypto_status_t otcrypto_ecdsa_verify(
     const otcrypto_ecc_curve_t *elliptic_curve,
     hardened_bool_t *verification_result);
 
+/**
+ * One signature to check with `otcrypto_ecdsa_p256_verify_batch`.
+ */
+typedef struct otcrypto_ecdsa_verify_batch_item {
+  // Unblinded public key (Q) to check against.
+  const otcrypto_unblinded_key_t *public_key;
+  // Message digest to be verified (pre-hashed).
+  otcrypto_hash_digest_t message_digest;
+  // Signature to be verified.
+  otcrypto_const_word32_buf_t signature;
+} otcrypto_ecdsa_verify_batch_item_t;
+
+/**
+ * Performs a batch of ECDSA-P256 signature verifications.
+ *
+ * Equivalent to calling `otcrypto_ecdsa_verify` for each item with the P-256
+ * curve, but loads the OTBN app only once for the whole batch. All items are
+ * checked for well-formed inputs (key mode, integrity and lengths) before any
+ * signature is verified; if any item is malformed, the function returns an
+ * error without verifying anything.
+ *
+ * A signature or public key that fails the basic mathematical validity
+ * checks is reported as `kHardenedBoolFalse` for that item, and does not stop
+ * the remaining items from being verified.
+ *
+ * @param items Signatures to verify, with their keys and digests.
+ * @param num_items Number of items.
+ * @param[out] verification_results Result for each item (Pass/Fail); must
+ * have space for `num_items` entries.
+ * @return Result of the batch verification operation.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_ecdsa_p256_verify_batch(
+    const otcrypto_ecdsa_verify_batch_item_t *items, size_t num_items,
+    hardened_bool_t *verification_results);
+
+enum {
+  /**
+   * Number of words in an ECDSA-P256 verification table.
+   */
+  kOtcryptoEcdsaP256VerifyTableWords = 240,
+};
+
+/**
+ * Precomputed table for verifying ECDSA-P256 signatures against one key.
+ *
+ * The representation is internal to the cryptolib and may change. The table
+ * includes the public key and must be protected as well as the key itself.
+ */
+typedef struct otcrypto_ecdsa_p256_verify_table {
+  uint32_t data[kOtcryptoEcdsaP256VerifyTableWords];
+} otcrypto_ecdsa_p256_verify_table_t;
+
+/**
+ * Precomputes a verification table for an ECDSA-P256 public key.
+ *
+ * Verifying with the table (see `otcrypto_ecdsa_p256_verify_with_table`)
+ * takes roughly half as long as `otcrypto_ecdsa_verify`. Computing it costs
+ * about one ordinary verification, so it is worthwhile for long-lived keys
+ * that check more than one signature. The table depends only on the key and
+ * can be kept in RAM for as long as the key is in use.
+ *
+ * @param public_key Pointer to the unblinded public key (Q) struct.
+ * @param[out] table Destination for the table.
+ * @return Result of the table computation.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_ecdsa_p256_verify_table_build(
+    const otcrypto_unblinded_key_t *public_key,
+    otcrypto_ecdsa_p256_verify_table_t *table);
+
+/**
+ * Performs ECDSA-P256 signature verification with a precomputed table.
+ *
+ * Equivalent to `otcrypto_ecdsa_verify` with the public key the table was
+ * built for.
+ *
+ * @param table Table from `otcrypto_ecdsa_p256_verify_table_build`.
+ * @param message_digest Message digest to be verified (pre-hashed).
+ * @param signature Pointer to the signature to be verified.
+ * @param[out] verification_result Result of signature verification
+ * (Pass/Fail).
+ * @return Result of the ECDSA verification operation.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_ecdsa_p256_verify_with_table(
+    const otcrypto_ecdsa_p256_verify_table_t *table,
+    const otcrypto_hash_digest_t message_digest,
+    otcrypto_const_word32_buf_t signature,
+    hardened_bool_t *verification_result);
+
 /**
  * Performs the key generation for ECDH key agreement.
  *
@@ -257,6 +348,11 @@ otcrypto_status_t otcrypto_ed25519_sign(
 /**
  * Verifies an Ed25519 signature.
  *
+ * The public key is the 32-byte encoded point and the signature is the
+ * 64-byte concatenation of R and S, both as specified in RFC 8032. For
+ * HashEdDSA, the context string is empty. Malformed signatures and public keys
+ * that cannot be decoded are reported as a failed verification.
+ *
  * @param public_key Pointer to the unblinded public key struct.
  * @param input_message Input message to be signed for verification.
  * @param sign_mode Parameter for EdDSA or Hash EdDSA sign mode.
@@ -39,6 +39,12 @@ enum {
    * struct.
    */
   kOtcryptoHashCtxStructWords = 92,
+  /**
+   * The size of the publicly exposed XOF context in words.
+   * We assert that this value is large enough to host the internal KMAC driver
+   * streaming struct.
+   */
+  kOtcryptoXofCtxStructWords = 4,
 };
 
 /**
@@ -51,6 +57,16 @@ typedef struct otcrypto_hash_context {
   uint32_t data[kOtcryptoHashCtxStructWords];
 } otcrypto_hash_context_t;
 
+/**
+ * Generic opaque context for streaming extendable-output functions.
+ *
+ * Representation is internal to the XOF implementation; initialize with
+ * #otcrypto_xof_shake_init or #otcrypto_xof_cshake_init.
+ */
+typedef struct otcrypto_xof_context {
+  uint32_t data[kOtcryptoXofCtxStructWords];
+} otcrypto_xof_context_t;
+
 /**
  * Performs the required hash function on the input data.
  *
@@ -164,6 +180,76 @@ otcrypto_status_t otcrypto_hash_update(otcrypto_hash_context_t *const ctx,
 otcrypto_status_t otcrypto_hash_final(otcrypto_hash_context_t *const ctx,
                                       otcrypto_hash_digest_t digest);
 
+/**
+ * Starts a streaming SHAKE extendable output function (XOF).
+ *
+ * The `xof_mode` parameter must be `kOtcryptoHashXofModeShake128` or
+ * `kOtcryptoHashXofModeShake256`; other values will result in errors.
+ *
+ * The SHA-3 hardware cannot be context-switched, so it stays reserved for this
+ * operation until #otcrypto_xof_final is called; no other SHA-3, SHAKE, cSHAKE
+ * or KMAC operation may run in between.
+ *
+ * @param[out] ctx Pointer to the generic XOF context struct.
+ * @param xof_mode Required XOF mode.
+ * @return Result of the XOF init operation.
+ */
+otcrypto_status_t otcrypto_xof_shake_init(otcrypto_xof_context_t *const ctx,
+                                          otcrypto_hash_mode_t xof_mode);
+
+/**
+ * Starts a streaming cSHAKE extendable output function (XOF).
+ *
+ * The `xof_mode` parameter must be `kOtcryptoHashXofModeCshake128` or
+ * `kOtcryptoHashXofModeCshake256`; other values will result in errors. See
+ * #otcrypto_xof_cshake for the meaning of the strings, and
+ * #otcrypto_xof_shake_init for the restrictions of streaming operations.
+ *
+ * @param[out] ctx Pointer to the generic XOF context struct.
+ * @param xof_mode Required XOF mode.
+ * @param function_name_string NIST Function name string.
+ * @param customization_string Customization string for cSHAKE.
+ * @return Result of the XOF init operation.
+ */
+otcrypto_status_t otcrypto_xof_cshake_init(
+    otcrypto_xof_context_t *const ctx, otcrypto_hash_mode_t xof_mode,
+    otcrypto_const_byte_buf_t function_name_string,
+    otcrypto_const_byte_buf_t customization_string);
+
+/**
+ * Absorbs more input into a streaming XOF.
+ *
+ * May be called any number of times, but only before the first call to
+ * #otcrypto_xof_squeeze.
+ *
+ * @param ctx Pointer to the generic XOF context struct.
+ * @param input_message Input message for the extendable output function.
+ * @return Result of the XOF update operation.
+ */
+otcrypto_status_t otcrypto_xof_update(otcrypto_xof_context_t *const ctx,
+                                      otcrypto_const_byte_buf_t input_message);
+
+/**
+ * Squeezes output from a streaming XOF.
+ *
+ * Each call continues the output stream where the previous call stopped, so
+ * output of any total length can be produced in pieces without buffering it.
+ *
+ * @param ctx Pointer to the generic XOF context struct.
+ * @param[out] output Buffer for the next `output.len` words of output.
+ * @return Result of the XOF squeeze operation.
+ */
+otcrypto_status_t otcrypto_xof_squeeze(otcrypto_xof_context_t *const ctx,
+                                       otcrypto_word32_buf_t output);
+
+/**
+ * Ends a streaming XOF and releases the SHA-3 hardware.
+ *
+ * @param ctx Pointer to the generic XOF context struct.
+ * @return Result of the XOF final operation.
+ */
+otcrypto_status_t otcrypto_xof_final(otcrypto_xof_context_t *const ctx);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
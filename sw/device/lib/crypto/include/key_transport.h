@@ -49,6 +49,31 @@ extern "C" {
 otcrypto_status_t otcrypto_symmetric_keygen(
     otcrypto_const_byte_buf_t perso_string, otcrypto_blinded_key_t *key);
 
+/**
+ * Generates several random symmetric keys.
+ *
+ * Equivalent to calling `otcrypto_symmetric_keygen` for each key with the same
+ * personalization string, but instantiates the DRBG only once for the whole
+ * batch. If the DRBG output pool is enabled (see `otcrypto_drbg_pool_refill`),
+ * the shares of consecutive keys are served from a single generate command.
+ *
+ * Each key is checked independently: a key with a bad configuration or length
+ * is reported in `results` and skipped, without stopping the others. DRBG
+ * errors are not specific to a key and abort the batch; the contents of
+ * `results` are then unspecified.
+ *
+ * @param perso_string Optional personalization string to be passed to DRBG.
+ * @param[out] keys Destination blinded key structs.
+ * @param num_keys Number of keys.
+ * @param[out] results Result for each key; must have space for `num_keys`
+ * entries.
+ * @return OK if all keys were generated, otherwise the error of the first key
+ * that failed or of the DRBG.
+ */
+otcrypto_status_t otcrypto_symmetric_keygen_batch(
+    otcrypto_const_byte_buf_t perso_string, otcrypto_blinded_key_t *keys,
+    size_t num_keys, otcrypto_status_t *results);
+
 /**
  * Creates a handle for a hardware-backed key.
  *
@@ -97,6 +122,35 @@ otcrypto_status_t otcrypto_import_blinded_key(
     const otcrypto_const_word32_buf_t key_share1,
     otcrypto_blinded_key_t *blinded_key);
 
+/**
+ * One key to import with `otcrypto_import_blinded_key_batch`.
+ */
+typedef struct otcrypto_key_import_batch_item {
+  // First share of the user provided key.
+  otcrypto_const_word32_buf_t key_share0;
+  // Second share of the user provided key.
+  otcrypto_const_word32_buf_t key_share1;
+  // Destination blinded key struct.
+  otcrypto_blinded_key_t *blinded_key;
+} otcrypto_key_import_batch_item_t;
+
+/**
+ * Creates several blinded key structs from masked key material.
+ *
+ * Equivalent to calling `otcrypto_import_blinded_key` for each item. A key
+ * that fails to import is reported in `results` and does not stop the others.
+ *
+ * @param items Keys to import.
+ * @param num_items Number of items.
+ * @param[out] results Result for each item; must have space for `num_items`
+ * entries.
+ * @return OK if all keys were imported, otherwise the error of the first item
+ * that failed.
+ */
+otcrypto_status_t otcrypto_import_blinded_key_batch(
+    const otcrypto_key_import_batch_item_t *items, size_t num_items,
+    otcrypto_status_t *results);
+
 /**
  * Exports a blinded key to the user provided key buffer, in shares.
  *
@@ -116,6 +170,35 @@ otcrypto_status_t otcrypto_export_blinded_key(
     const otcrypto_blinded_key_t blinded_key, otcrypto_word32_buf_t key_share0,
     otcrypto_word32_buf_t key_share1);
 
+/**
+ * One key to export with `otcrypto_export_blinded_key_batch`.
+ */
+typedef struct otcrypto_key_export_batch_item {
+  // Blinded key struct to be exported.
+  const otcrypto_blinded_key_t *blinded_key;
+  // First share of the blinded key.
+  otcrypto_word32_buf_t key_share0;
+  // Second share of the blinded key.
+  otcrypto_word32_buf_t key_share1;
+} otcrypto_key_export_batch_item_t;
+
+/**
+ * Exports several blinded keys to user provided key buffers, in shares.
+ *
+ * Equivalent to calling `otcrypto_export_blinded_key` for each item. A key
+ * that fails to export is reported in `results` and does not stop the others.
+ *
+ * @param items Keys to export, with their destination buffers.
+ * @param num_items Number of items.
+ * @param[out] results Result for each item; must have space for `num_items`
+ * entries.
+ * @return OK if all keys were exported, otherwise the error of the first item
+ * that failed.
+ */
+otcrypto_status_t otcrypto_export_blinded_key_batch(
+    const otcrypto_key_export_batch_item_t *items, size_t num_items,
+    otcrypto_status_t *results);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -75,6 +75,17 @@ enum {
   kOtcryptoRsa2048PrivateKeyblobBytes = 512,
   kOtcryptoRsa3072PrivateKeyblobBytes = 768,
   kOtcryptoRsa4096PrivateKeyblobBytes = 1024,
+  /**
+   * Number of bytes needed for RSA private keyblobs in CRT form.
+   *
+   * Keys constructed with `otcrypto_rsa_private_key_from_crt` use this
+   * keyblob length instead of the one above; `key_length` is the same for
+   * both forms. The exact representation is an implementation-specific detail
+   * and subject to change.
+   */
+  kOtcryptoRsa2048PrivateKeyCrtKeyblobBytes = 896,
+  kOtcryptoRsa3072PrivateKeyCrtKeyblobBytes = 1344,
+  kOtcryptoRsa4096PrivateKeyCrtKeyblobBytes = 1792,
 };
 
 /**
@@ -137,6 +148,39 @@ otcrypto_status_t otcrypto_rsa_private_key_from_exponents(
     otcrypto_const_word32_buf_t d_share0, otcrypto_const_word32_buf_t d_share1,
     otcrypto_blinded_key_t *private_key);
 
+/**
+ * Constructs an RSA private key in CRT form.
+ *
+ * Signing and decryption with a CRT key split the private-key operation into
+ * two half-size exponentiations, which is several times faster than using the
+ * private exponent d directly. The result is checked with the public exponent
+ * before it is released, so the public exponent must be 65537.
+ *
+ * The prime factors must each be exactly half the length of the modulus
+ * (i.e. their most significant bits must be set), and `modulus` must be p*q.
+ *
+ * The caller should allocate space for the private key and set the `keyblob`,
+ * `keyblob_length`, and `key_length` fields accordingly. The keyblob length
+ * must be the CRT keyblob length for the given size (e.g.
+ * `kOtcryptoRsa2048PrivateKeyCrtKeyblobBytes`).
+ *
+ * @param size RSA size parameter.
+ * @param modulus RSA modulus (n).
+ * @param exponent RSA public exponent (e), must be 65537.
+ * @param p First prime factor of n (half the length of n).
+ * @param q Second prime factor of n (half the length of n).
+ * @param d_p CRT exponent d mod (p-1) (half the length of n).
+ * @param d_q CRT exponent d mod (q-1) (half the length of n).
+ * @param q_inv CRT coefficient q^-1 mod p (half the length of n).
+ * @param[out] private_key Destination private key struct.
+ * @return Result of the RSA key construction.
+ */
+otcrypto_status_t otcrypto_rsa_private_key_from_crt(
+    otcrypto_rsa_size_t size, otcrypto_const_word32_buf_t modulus, uint32_t e,
+    otcrypto_const_word32_buf_t p, otcrypto_const_word32_buf_t q,
+    otcrypto_const_word32_buf_t d_p, otcrypto_const_word32_buf_t d_q,
+    otcrypto_const_word32_buf_t q_inv, otcrypto_blinded_key_t *private_key);
+
 /**
  * Constructs an RSA keypair from the public key and one prime cofactor.
  *
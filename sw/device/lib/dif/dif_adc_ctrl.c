@@ -82,16 +82,22 @@ dif_result_t dif_adc_ctrl_configure(const dif_adc_ctrl_t *adc_ctrl,
   return kDifOk;
 }
 
-dif_result_t dif_adc_ctrl_configure_filter(const dif_adc_ctrl_t *adc_ctrl,
-                                           dif_adc_ctrl_channel_t channel,
-                                           dif_adc_ctrl_filter_config_t config,
-                                           dif_toggle_t enabled) {
-  if (adc_ctrl == NULL || config.min_voltage > 1023 ||
-      config.max_voltage > 1023) {
-    return kDifBadArg;
+/**
+ * Computes the filter control register of a single filter.
+ *
+ * Returns false if the channel or any of the configuration parameters are
+ * invalid, in which case no outputs are written.
+ */
+static bool filter_ctrl_reg_compute(dif_adc_ctrl_channel_t channel,
+                                    dif_adc_ctrl_filter_config_t config,
+                                    dif_toggle_t enabled,
+                                    ptrdiff_t *filter_ctrl_reg_offset,
+                                    uint32_t *filter_ctrl_reg) {
+  if (config.min_voltage > 1023 || config.max_voltage > 1023) {
+    return false;
   }
 
-  ptrdiff_t filter_ctrl_reg_offset;
+  ptrdiff_t offset;
   bitfield_field32_t min_voltage_field;
   bitfield_field32_t max_voltage_field;
   bitfield_bit32_index_t in_range_bit;
@@ -99,8 +105,7 @@ dif_result_t dif_adc_ctrl_configure_filter(const dif_adc_ctrl_t *adc_ctrl,
 
 #define DIF_ADC_CTRL_CHANNEL0_FILTER_CONFIG_CASE_(filter_)                    \
   case kDifAdcCtrlFilter##filter_:                                            \
-    filter_ctrl_reg_offset =                                                  \
-        ADC_CTRL_ADC_CHN0_FILTER_CTL_##filter_##_REG_OFFSET;                  \
+    offset = ADC_CTRL_ADC_CHN0_FILTER_CTL_##filter_##_REG_OFFSET;             \
     min_voltage_field =                                                       \
         ADC_CTRL_ADC_CHN0_FILTER_CTL_##filter_##_MIN_V_##filter_##_FIELD;     \
     max_voltage_field =                                                       \
@@ -112,8 +117,7 @@ dif_result_t dif_adc_ctrl_configure_filter(const dif_adc_ctrl_t *adc_ctrl,
 
 #define DIF_ADC_CTRL_CHANNEL1_FILTER_CONFIG_CASE_(filter_)                    \
   case kDifAdcCtrlFilter##filter_:                                            \
-    filter_ctrl_reg_offset =                                                  \
-        ADC_CTRL_ADC_CHN1_FILTER_CTL_##filter_##_REG_OFFSET;                  \
+    offset = ADC_CTRL_ADC_CHN1_FILTER_CTL_##filter_##_REG_OFFSET;             \
     min_voltage_field =                                                       \
         ADC_CTRL_ADC_CHN1_FILTER_CTL_##filter_##_MIN_V_##filter_##_FIELD;     \
     max_voltage_field =                                                       \
@@ -128,32 +132,47 @@ dif_result_t dif_adc_ctrl_configure_filter(const dif_adc_ctrl_t *adc_ctrl,
       switch (config.filter) {
         DIF_ADC_CTRL_FILTER_LIST(DIF_ADC_CTRL_CHANNEL0_FILTER_CONFIG_CASE_)
         default:
-          return kDifBadArg;
+          return false;
       }
       break;
     case kDifAdcCtrlChannel1:
       switch (config.filter) {
         DIF_ADC_CTRL_FILTER_LIST(DIF_ADC_CTRL_CHANNEL1_FILTER_CONFIG_CASE_)
         default:
-          return kDifBadArg;
+          return false;
       }
       break;
     default:
-      return kDifBadArg;
+      return false;
   }
 
 #undef DIF_ADC_CTRL_CHANNEL0_FILTER_CONFIG_CASE_
 #undef DIF_ADC_CTRL_CHANNEL1_FILTER_CONFIG_CASE_
 
-  // Configure filter control register.
-  uint32_t filter_ctrl_reg =
+  uint32_t reg =
       bitfield_field32_write(0, min_voltage_field, config.min_voltage);
-  filter_ctrl_reg = bitfield_field32_write(filter_ctrl_reg, max_voltage_field,
-                                           config.max_voltage);
-  filter_ctrl_reg =
-      bitfield_bit32_write(filter_ctrl_reg, in_range_bit, !config.in_range);
-  filter_ctrl_reg = bitfield_bit32_write(filter_ctrl_reg, enable_bit,
-                                         dif_toggle_to_bool(enabled));
+  reg = bitfield_field32_write(reg, max_voltage_field, config.max_voltage);
+  reg = bitfield_bit32_write(reg, in_range_bit, !config.in_range);
+  reg = bitfield_bit32_write(reg, enable_bit, dif_toggle_to_bool(enabled));
+
+  *filter_ctrl_reg_offset = offset;
+  *filter_ctrl_reg = reg;
+  return true;
+}
+
+dif_result_t dif_adc_ctrl_configure_filter(const dif_adc_ctrl_t *adc_ctrl,
+                                           dif_adc_ctrl_channel_t channel,
+                                           dif_adc_ctrl_filter_config_t config,
+                                           dif_toggle_t enabled) {
+  ptrdiff_t filter_ctrl_reg_offset;
+  uint32_t filter_ctrl_reg;
+  if (adc_ctrl == NULL ||
+      !filter_ctrl_reg_compute(channel, config, enabled,
+                               &filter_ctrl_reg_offset, &filter_ctrl_reg)) {
+    return kDifBadArg;
+  }
+
+  // Configure filter control register.
   mmio_region_write32(adc_ctrl->base_addr, filter_ctrl_reg_offset,
                       filter_ctrl_reg);
 
@@ -176,6 +195,57 @@ dif_result_t dif_adc_ctrl_configure_filter(const dif_adc_ctrl_t *adc_ctrl,
   return kDifOk;
 }
 
+dif_result_t dif_adc_ctrl_configure_filters(
+    const dif_adc_ctrl_t *adc_ctrl, dif_adc_ctrl_channel_t channel,
+    const dif_adc_ctrl_filter_config_t *configs, size_t num_configs,
+    dif_toggle_t enabled) {
+  if (adc_ctrl == NULL || configs == NULL || num_configs == 0 ||
+      num_configs > ADC_CTRL_PARAM_NUM_ADC_FILTER) {
+    return kDifBadArg;
+  }
+
+  // Validate the whole bank before touching the hardware, so that a bad entry
+  // does not leave it half programmed.
+  ptrdiff_t filter_ctrl_reg_offsets[ADC_CTRL_PARAM_NUM_ADC_FILTER];
+  uint32_t filter_ctrl_regs[ADC_CTRL_PARAM_NUM_ADC_FILTER];
+  uint32_t filters_mask = 0;
+  uint32_t wakeup_bits = 0;
+  uint32_t irq_bits = 0;
+  for (size_t i = 0; i < num_configs; ++i) {
+    if (!filter_ctrl_reg_compute(channel, configs[i], enabled,
+                                 &filter_ctrl_reg_offsets[i],
+                                 &filter_ctrl_regs[i])) {
+      return kDifBadArg;
+    }
+    filters_mask |= 1u << configs[i].filter;
+    wakeup_bits = bitfield_bit32_write(wakeup_bits, configs[i].filter,
+                                       configs[i].generate_wakeup_on_match);
+    irq_bits = bitfield_bit32_write(irq_bits, configs[i].filter,
+                                    configs[i].generate_irq_on_match);
+  }
+
+  for (size_t i = 0; i < num_configs; ++i) {
+    mmio_region_write32(adc_ctrl->base_addr, filter_ctrl_reg_offsets[i],
+                        filter_ctrl_regs[i]);
+  }
+
+  // The wakeup and interrupt enables of all filters in the bank are updated
+  // with a single read-modify-write each.
+  uint32_t wakeup_ctrl_reg = mmio_region_read32(
+      adc_ctrl->base_addr, ADC_CTRL_ADC_WAKEUP_CTL_REG_OFFSET);
+  wakeup_ctrl_reg = (wakeup_ctrl_reg & ~filters_mask) | wakeup_bits;
+  mmio_region_write32(adc_ctrl->base_addr, ADC_CTRL_ADC_WAKEUP_CTL_REG_OFFSET,
+                      wakeup_ctrl_reg);
+
+  uint32_t intr_ctrl_reg =
+      mmio_region_read32(adc_ctrl->base_addr, ADC_CTRL_ADC_INTR_CTL_REG_OFFSET);
+  intr_ctrl_reg = (intr_ctrl_reg & ~filters_mask) | irq_bits;
+  mmio_region_write32(adc_ctrl->base_addr, ADC_CTRL_ADC_INTR_CTL_REG_OFFSET,
+                      intr_ctrl_reg);
+
+  return kDifOk;
+}
+
 dif_result_t dif_adc_ctrl_set_enabled(const dif_adc_ctrl_t *adc_ctrl,
                                       dif_toggle_t enabled) {
   if (adc_ctrl == NULL || !dif_is_valid_toggle(enabled)) {
@@ -264,6 +264,28 @@ dif_result_t dif_adc_ctrl_configure_filter(const dif_adc_ctrl_t *adc_ctrl,
                                            dif_adc_ctrl_filter_config_t config,
                                            dif_toggle_t enabled);
 
+/**
+ * Configures a bank of channel filters at once.
+ *
+ * Equivalent to calling `dif_adc_ctrl_configure_filter()` for each entry of
+ * `configs`, but updates the wakeup and interrupt enables of all filters with
+ * a single read-modify-write each. All entries are validated before any
+ * register is written.
+ *
+ * @param adc_ctrl An adc_ctrl handle.
+ * @param channel The channel of the filters to configure.
+ * @param configs Runtime configuration parameters, one entry per filter.
+ * @param num_configs Number of entries in `configs`; must be non-zero and no
+ *                    greater than the number of filters.
+ * @param enabled The enablement state to configure the filters in.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_adc_ctrl_configure_filters(
+    const dif_adc_ctrl_t *adc_ctrl, dif_adc_ctrl_channel_t channel,
+    const dif_adc_ctrl_filter_config_t *configs, size_t num_configs,
+    dif_toggle_t enabled);
+
 /**
  * Sets the enablement state of the ADC Controller.
  *
@@ -184,6 +184,66 @@ TEST_F(FilterConfigTest, Success) {
       &adc_ctrl_, kDifAdcCtrlChannel0, filter_config_, kDifToggleEnabled));
 }
 
+class FilterBankConfigTest : public AdcCtrlTest {
+ protected:
+  dif_adc_ctrl_filter_config_t bank_[2] = {
+      filter_config_,
+      {
+          .filter = kDifAdcCtrlFilter5,
+          .min_voltage = 100,
+          .max_voltage = 200,
+          .in_range = false,
+          .generate_wakeup_on_match = false,
+          .generate_irq_on_match = true,
+      },
+  };
+};
+
+TEST_F(FilterBankConfigTest, NullArgs) {
+  EXPECT_DIF_BADARG(dif_adc_ctrl_configure_filters(
+      nullptr, kDifAdcCtrlChannel0, bank_, 2, kDifToggleEnabled));
+  EXPECT_DIF_BADARG(dif_adc_ctrl_configure_filters(
+      &adc_ctrl_, kDifAdcCtrlChannel0, nullptr, 2, kDifToggleEnabled));
+}
+
+TEST_F(FilterBankConfigTest, BadNumConfigs) {
+  EXPECT_DIF_BADARG(dif_adc_ctrl_configure_filters(
+      &adc_ctrl_, kDifAdcCtrlChannel0, bank_, 0, kDifToggleEnabled));
+  EXPECT_DIF_BADARG(dif_adc_ctrl_configure_filters(
+      &adc_ctrl_, kDifAdcCtrlChannel0, bank_, ADC_CTRL_PARAM_NUM_ADC_FILTER + 1,
+      kDifToggleEnabled));
+}
+
+TEST_F(FilterBankConfigTest, BadEntryWritesNothing) {
+  bank_[1].max_voltage = 1024;
+  EXPECT_DIF_BADARG(dif_adc_ctrl_configure_filters(
+      &adc_ctrl_, kDifAdcCtrlChannel0, bank_, 2, kDifToggleEnabled));
+  EXPECT_DIF_BADARG(dif_adc_ctrl_configure_filters(
+      &adc_ctrl_,
+      static_cast<dif_adc_ctrl_channel_t>(ADC_CTRL_PARAM_NUM_ADC_CHANNEL),
+      bank_, 1, kDifToggleEnabled));
+}
+
+TEST_F(FilterBankConfigTest, Success) {
+  EXPECT_WRITE32(ADC_CTRL_ADC_CHN1_FILTER_CTL_2_REG_OFFSET,
+                 {{ADC_CTRL_ADC_CHN1_FILTER_CTL_2_MIN_V_2_OFFSET, 512},
+                  {ADC_CTRL_ADC_CHN1_FILTER_CTL_2_MAX_V_2_OFFSET, 768},
+                  {ADC_CTRL_ADC_CHN1_FILTER_CTL_2_COND_2_BIT, false},
+                  {ADC_CTRL_ADC_CHN1_FILTER_CTL_2_EN_2_BIT, true}});
+  EXPECT_WRITE32(ADC_CTRL_ADC_CHN1_FILTER_CTL_5_REG_OFFSET,
+                 {{ADC_CTRL_ADC_CHN1_FILTER_CTL_5_MIN_V_5_OFFSET, 100},
+                  {ADC_CTRL_ADC_CHN1_FILTER_CTL_5_MAX_V_5_OFFSET, 200},
+                  {ADC_CTRL_ADC_CHN1_FILTER_CTL_5_COND_5_BIT, true},
+                  {ADC_CTRL_ADC_CHN1_FILTER_CTL_5_EN_5_BIT, true}});
+  // Bits of filters outside the bank are preserved.
+  EXPECT_READ32(ADC_CTRL_ADC_WAKEUP_CTL_REG_OFFSET, 0xa1);
+  EXPECT_WRITE32(ADC_CTRL_ADC_WAKEUP_CTL_REG_OFFSET, 0x85);
+  EXPECT_READ32(ADC_CTRL_ADC_INTR_CTL_REG_OFFSET, 0x100);
+  EXPECT_WRITE32(ADC_CTRL_ADC_INTR_CTL_REG_OFFSET, 0x124);
+  EXPECT_DIF_OK(dif_adc_ctrl_configure_filters(
+      &adc_ctrl_, kDifAdcCtrlChannel1, bank_, 2, kDifToggleEnabled));
+}
+
 class SetEnabledTest : public AdcCtrlTest {};
 
 TEST_F(SetEnabledTest, NullHandle) {
@@ -80,13 +80,14 @@ static void aes_clear_internal_state(const dif_aes_t *aes) {
 
   aes_shadowed_write(aes->base_addr, AES_CTRL_SHADOWED_REG_OFFSET, ctrl_reg);
 
-  uint32_t trigger_reg =
-      bitfield_bit32_write(0, AES_TRIGGER_KEY_IV_DATA_IN_CLEAR_BIT, true);
+  bitfield_update32_t trigger = {0};
+  trigger = bitfield_update32_bit(trigger,
+                                  AES_TRIGGER_KEY_IV_DATA_IN_CLEAR_BIT, true);
+  trigger =
+      bitfield_update32_bit(trigger, AES_TRIGGER_DATA_OUT_CLEAR_BIT, true);
 
-  trigger_reg =
-      bitfield_bit32_write(trigger_reg, AES_TRIGGER_DATA_OUT_CLEAR_BIT, true);
-
-  mmio_region_write32(aes->base_addr, AES_TRIGGER_REG_OFFSET, trigger_reg);
+  mmio_region_write32(aes->base_addr, AES_TRIGGER_REG_OFFSET,
+                      bitfield_update32_apply(0, trigger));
 
   // Make sure AES is cleared before proceeding (may take multiple cycles).
   AES_WAIT_FOR_STATUS(aes, AES_STATUS_IDLE_BIT, true);
@@ -101,25 +102,28 @@ static void aes_clear_internal_state(const dif_aes_t *aes) {
  */
 static dif_result_t configure(const dif_aes_t *aes,
                               const dif_aes_transaction_t *transaction) {
-  uint32_t reg = bitfield_field32_write(0, AES_CTRL_SHADOWED_OPERATION_FIELD,
-                                        transaction->operation);
+  bitfield_update32_t ctrl = {0};
+  ctrl = bitfield_update32_field(ctrl, AES_CTRL_SHADOWED_OPERATION_FIELD,
+                                 transaction->operation);
 
-  reg = bitfield_field32_write(reg, AES_CTRL_SHADOWED_MODE_FIELD,
-                               transaction->mode);
+  ctrl = bitfield_update32_field(ctrl, AES_CTRL_SHADOWED_MODE_FIELD,
+                                 transaction->mode);
 
-  reg = bitfield_field32_write(reg, AES_CTRL_SHADOWED_KEY_LEN_FIELD,
-                               transaction->key_len);
+  ctrl = bitfield_update32_field(ctrl, AES_CTRL_SHADOWED_KEY_LEN_FIELD,
+                                 transaction->key_len);
 
-  reg = bitfield_field32_write(reg, AES_CTRL_SHADOWED_PRNG_RESEED_RATE_FIELD,
-                               transaction->mask_reseeding);
+  ctrl = bitfield_update32_field(ctrl, AES_CTRL_SHADOWED_PRNG_RESEED_RATE_FIELD,
+                                 transaction->mask_reseeding);
 
   bool flag = transaction->manual_operation == kDifAesManualOperationManual;
-  reg = bitfield_bit32_write(reg, AES_CTRL_SHADOWED_MANUAL_OPERATION_BIT, flag);
+  ctrl = bitfield_update32_bit(ctrl, AES_CTRL_SHADOWED_MANUAL_OPERATION_BIT,
+                               flag);
 
   flag = transaction->key_provider == kDifAesKeySideload;
-  reg = bitfield_bit32_write(reg, AES_CTRL_SHADOWED_SIDELOAD_BIT, flag);
+  ctrl = bitfield_update32_bit(ctrl, AES_CTRL_SHADOWED_SIDELOAD_BIT, flag);
 
-  aes_shadowed_write(aes->base_addr, AES_CTRL_SHADOWED_REG_OFFSET, reg);
+  aes_shadowed_write(aes->base_addr, AES_CTRL_SHADOWED_REG_OFFSET,
+                     bitfield_update32_apply(0, ctrl));
 
   return kDifOk;
 }
@@ -309,13 +313,6 @@ dif_result_t dif_aes_process_data(const dif_aes_t *aes,
     return kDifBadArg;
   }
 
-  // The algorithm below just makes sense for at least 2 blocks. Otherwise
-  // it is better to use the `load_data` and `read_output` functions.
-  if (block_count < 2) {
-    DIF_RETURN_IF_ERROR(dif_aes_load_data(aes, plain_text[0]));
-    return dif_aes_read_output(aes, cipher_text);
-  }
-
   // Ensure that the INPUT_READY bit in STATUS is 1.
   if (!aes_input_ready(aes)) {
     return kDifUnavailable;
@@ -327,14 +324,17 @@ dif_result_t dif_aes_process_data(const dif_aes_t *aes,
 
   // Wait for the INPUT_READY bit in STATUS to become 1, i.e. wait for the AES
   // unit to load Input Data Block 0 into the internal state register and start
-  // operation.
-  AES_WAIT_FOR_STATUS(aes, AES_STATUS_INPUT_READY_BIT, true);
-  // Then for every Data Block I=0,..,N-3, software must:
+  // operation. Only needed if there is a next block to write.
+  if (block_count > 1) {
+    AES_WAIT_FOR_STATUS(aes, AES_STATUS_INPUT_READY_BIT, true);
+  }
+  // Then for every Data Block I=0,..,N-1, software must:
   for (size_t i = 0; i < block_count; ++i) {
     // Write Input Data Block I+1 into the Input Data register. There is no need
     // to explicitly check INPUT_READY as in the same cycle OUTPUT_VALID becomes
     // 1, the current input is loaded in (meaning INPUT_READY becomes 1 one
-    // cycle later).
+    // cycle later). Block I+1 is consumed before Output Data Block I is
+    // written back, which makes processing in place safe.
     if (i + 1 < block_count) {
       aes_set_multireg(aes, plain_text[i + 1].data, AES_DATA_IN_MULTIREG_COUNT,
                        AES_DATA_IN_0_REG_OFFSET);
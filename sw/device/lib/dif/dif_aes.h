@@ -358,7 +358,12 @@ dif_result_t dif_aes_read_output(const dif_aes_t *aes, dif_aes_data_t *data);
  * automatic operation mode activated.
  *
  * The peripheral must be able to accept the input (INPUT_READY set), and
- * will return `kDifAesLoadDataBusy` if this condition is not met.
+ * will return `kDifUnavailable` if this condition is not met.
+ *
+ * Loading the next input block overlaps with the processing of the current
+ * one. Each output block is read only after the input block with the same
+ * index has been loaded, so `cipher_text` may alias `plain_text` to process
+ * a buffer in place. Any number of blocks, including one, may be processed.
  *
  * @param aes AES handle.
  * @param plain_text AES Input Data.
@@ -425,6 +425,38 @@ TEST_F(DataProcessTest, OneBlockSuccess) {
   EXPECT_THAT(out[0].data, ElementsAreArray(kDataOut[0].data));
 }
 
+TEST_F(DataProcessTest, OneBlockWaitsForOutput) {
+  EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_INPUT_READY_BIT, true}});
+  ExpectWriteMultreg(AES_DATA_IN_0_REG_OFFSET, kDataIn[0].data, kBlockSize);
+
+  EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_OUTPUT_VALID_BIT, false}});
+  EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_OUTPUT_VALID_BIT, true}});
+  ExpectReadMultreg(AES_DATA_OUT_0_REG_OFFSET, kDataOut[0].data, kBlockSize);
+
+  dif_aes_data_t out[kBlockCount];
+  EXPECT_DIF_OK(dif_aes_process_data(&aes_, kDataIn, out, 1));
+  EXPECT_THAT(out[0].data, ElementsAreArray(kDataOut[0].data));
+}
+
+TEST_F(DataProcessTest, InPlaceSuccess) {
+  dif_aes_data_t buf[2] = {kDataIn[0], kDataIn[1]};
+
+  EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_INPUT_READY_BIT, true}});
+  ExpectWriteMultreg(AES_DATA_IN_0_REG_OFFSET, kDataIn[0].data, kBlockSize);
+  EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_INPUT_READY_BIT, true}});
+
+  ExpectWriteMultreg(AES_DATA_IN_0_REG_OFFSET, kDataIn[1].data, kBlockSize);
+  EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_OUTPUT_VALID_BIT, true}});
+  ExpectReadMultreg(AES_DATA_OUT_0_REG_OFFSET, kDataOut[0].data, kBlockSize);
+
+  EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_OUTPUT_VALID_BIT, true}});
+  ExpectReadMultreg(AES_DATA_OUT_0_REG_OFFSET, kDataOut[1].data, kBlockSize);
+
+  EXPECT_DIF_OK(dif_aes_process_data(&aes_, buf, buf, 2));
+  EXPECT_THAT(buf[0].data, ElementsAreArray(kDataOut[0].data));
+  EXPECT_THAT(buf[1].data, ElementsAreArray(kDataOut[1].data));
+}
+
 TEST_F(DataProcessTest, OneBlockUnavailable) {
   EXPECT_READ32(AES_STATUS_REG_OFFSET, {{AES_STATUS_INPUT_READY_BIT, false}});
 
@@ -188,6 +188,123 @@ dif_result_t dif_alert_handler_configure_alert(
   return kDifOk;
 }
 
+static_assert(ALERT_HANDLER_PARAM_N_ALERTS <=
+                  kDifAlertHandlerAlertBitmapWords * 32,
+              "Alert bitmaps are too small for the number of alerts!");
+
+enum {
+  /**
+   * Number of bitmap words that hold at least one valid alert.
+   */
+  kAlertBitmapUsedWords = (ALERT_HANDLER_PARAM_N_ALERTS + 31) / 32,
+};
+
+/**
+ * Returns whether `alert` is set in `bitmap`.
+ */
+static bool alert_bitmap_get(const uint32_t *bitmap,
+                             dif_alert_handler_alert_t alert) {
+  return (bitmap[alert / 32] >> (alert % 32)) & 1;
+}
+
+dif_result_t dif_alert_handler_configure_alerts(
+    const dif_alert_handler_t *alert_handler,
+    const dif_alert_handler_alert_classes_t *alert_classes,
+    dif_toggle_t locked) {
+  if (alert_handler == NULL || alert_classes == NULL ||
+      !dif_is_valid_toggle(locked)) {
+    return kDifBadArg;
+  }
+
+  // Merge the class bitmaps, rejecting alerts that are assigned to several
+  // classes or that do not exist.
+  uint32_t selected[kDifAlertHandlerAlertBitmapWords] = {0};
+  for (size_t i = 0; i < ARRAYSIZE(alert_classes->class_masks); ++i) {
+    for (size_t j = 0; j < kDifAlertHandlerAlertBitmapWords; ++j) {
+      uint32_t mask = alert_classes->class_masks[i][j];
+      if ((selected[j] & mask) != 0) {
+        return kDifBadArg;
+      }
+      selected[j] |= mask;
+    }
+  }
+  for (size_t j = kAlertBitmapUsedWords; j < kDifAlertHandlerAlertBitmapWords;
+       ++j) {
+    if (selected[j] != 0) {
+      return kDifBadArg;
+    }
+  }
+  if (ALERT_HANDLER_PARAM_N_ALERTS % 32 != 0 &&
+      (selected[kAlertBitmapUsedWords - 1] >>
+       (ALERT_HANDLER_PARAM_N_ALERTS % 32)) != 0) {
+    return kDifBadArg;
+  }
+
+  // Check all locks up front so that nothing is written if any alert is
+  // locked.
+  uint32_t classification[ALERT_HANDLER_PARAM_N_ALERTS];
+  for (dif_alert_handler_alert_t alert = 0;
+       alert < ALERT_HANDLER_PARAM_N_ALERTS; ++alert) {
+    if (!alert_bitmap_get(selected, alert)) {
+      continue;
+    }
+    for (size_t i = 0; i < ARRAYSIZE(alert_classes->class_masks); ++i) {
+      if (alert_bitmap_get(alert_classes->class_masks[i], alert)) {
+        if (!class_to_uint32((dif_alert_handler_class_t)i,
+                             &classification[alert])) {
+          return kDifBadArg;
+        }
+        break;
+      }
+    }
+    ptrdiff_t regwen_offset = ALERT_HANDLER_ALERT_REGWEN_0_REG_OFFSET +
+                              (ptrdiff_t)alert * (ptrdiff_t)sizeof(uint32_t);
+    if (!mmio_region_read32(alert_handler->base_addr, regwen_offset)) {
+      return kDifLocked;
+    }
+  }
+
+  // Classify and enable the alerts in a single pass.
+  for (dif_alert_handler_alert_t alert = 0;
+       alert < ALERT_HANDLER_PARAM_N_ALERTS; ++alert) {
+    if (!alert_bitmap_get(selected, alert)) {
+      continue;
+    }
+    ptrdiff_t offset = (ptrdiff_t)alert * (ptrdiff_t)sizeof(uint32_t);
+    mmio_region_write32_shadowed(
+        alert_handler->base_addr,
+        ALERT_HANDLER_ALERT_CLASS_SHADOWED_0_REG_OFFSET + offset,
+        classification[alert]);
+    mmio_region_write32_shadowed(
+        alert_handler->base_addr,
+        ALERT_HANDLER_ALERT_EN_SHADOWED_0_REG_OFFSET + offset, 0x1);
+    if (locked == kDifToggleEnabled) {
+      mmio_region_write32(alert_handler->base_addr,
+                          ALERT_HANDLER_ALERT_REGWEN_0_REG_OFFSET + offset, 0);
+    }
+  }
+
+  // Verify the configuration in a single sweep.
+  for (dif_alert_handler_alert_t alert = 0;
+       alert < ALERT_HANDLER_PARAM_N_ALERTS; ++alert) {
+    if (!alert_bitmap_get(selected, alert)) {
+      continue;
+    }
+    ptrdiff_t offset = (ptrdiff_t)alert * (ptrdiff_t)sizeof(uint32_t);
+    uint32_t class_reg = mmio_region_read32(
+        alert_handler->base_addr,
+        ALERT_HANDLER_ALERT_CLASS_SHADOWED_0_REG_OFFSET + offset);
+    uint32_t enable_reg = mmio_region_read32(
+        alert_handler->base_addr,
+        ALERT_HANDLER_ALERT_EN_SHADOWED_0_REG_OFFSET + offset);
+    if (class_reg != classification[alert] || enable_reg != 0x1) {
+      return kDifError;
+    }
+  }
+
+  return kDifOk;
+}
+
 dif_result_t dif_alert_handler_configure_local_alert(
     const dif_alert_handler_t *alert_handler,
     dif_alert_handler_local_alert_t local_alert,
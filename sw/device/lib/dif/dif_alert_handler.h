@@ -335,6 +335,54 @@ dif_result_t dif_alert_handler_configure_alert(
     dif_alert_handler_class_t alert_class, dif_toggle_t enabled,
     dif_toggle_t locked);
 
+enum {
+  /**
+   * Number of 32-bit words in an alert bitmap.
+   *
+   * Large enough for every top; the DIF checks at compile time that the
+   * bitmap covers all alerts of the alert handler it is built for.
+   */
+  kDifAlertHandlerAlertBitmapWords = 8,
+};
+
+/**
+ * Class assignment of a set of alerts.
+ *
+ * `class_masks[c]` is a bitmap of the alerts to assign to class `c`, where
+ * alert `n` is bit `n % 32` of word `n / 32`. Alerts that appear in no bitmap
+ * are left untouched.
+ */
+typedef struct dif_alert_handler_alert_classes {
+  uint32_t class_masks[kDifAlertHandlerClassD + 1]
+                      [kDifAlertHandlerAlertBitmapWords];
+} dif_alert_handler_alert_classes_t;
+
+/**
+ * Configures and enables a set of alerts in the alert handler.
+ *
+ * Equivalent to calling `dif_alert_handler_configure_alert()` with
+ * `kDifToggleEnabled` for every alert in `alert_classes`, but checks all
+ * locks before writing anything, then programs the class and enable registers
+ * of all alerts in a single pass. The written configuration is verified with a
+ * readback sweep once all alerts are programmed.
+ *
+ * This operation is lock-protected, meaning once the configuration is locked,
+ * it cannot be reconfigured until after a system reset.
+ *
+ * @param alert_handler An alert handler handle.
+ * @param alert_classes The alerts to configure, as one bitmap per class. An
+ * alert may appear in at most one bitmap.
+ * @param locked The locked state to configure the alerts in.
+ * @return The result of the operation; `kDifLocked` if any of the alerts is
+ * locked, in which case no alert is modified, and `kDifError` if the readback
+ * does not match the written configuration.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_alert_handler_configure_alerts(
+    const dif_alert_handler_t *alert_handler,
+    const dif_alert_handler_alert_classes_t *alert_classes,
+    dif_toggle_t locked);
+
 /**
  * Configures a local alert in the alert handler.
  *
@@ -135,6 +135,107 @@ INSTANTIATE_TEST_SUITE_P(
                                      kDifAlertHandlerClassC,
                                      kDifAlertHandlerClassD)));
 
+class AlertBulkConfigTest : public AlertHandlerTest {
+ protected:
+  void Assign(dif_alert_handler_alert_t alert,
+              dif_alert_handler_class_t alert_class) {
+    alert_classes_.class_masks[alert_class][alert / 32] |= 1u << (alert % 32);
+  }
+
+  static ptrdiff_t Offset(ptrdiff_t reg0, dif_alert_handler_alert_t alert) {
+    return reg0 + alert * sizeof(uint32_t);
+  }
+
+  dif_alert_handler_alert_classes_t alert_classes_ = {};
+};
+
+TEST_F(AlertBulkConfigTest, BadArgs) {
+  EXPECT_DIF_BADARG(dif_alert_handler_configure_alerts(
+      nullptr, &alert_classes_, kDifToggleDisabled));
+  EXPECT_DIF_BADARG(dif_alert_handler_configure_alerts(&alert_handler_, nullptr,
+                                                       kDifToggleDisabled));
+  EXPECT_DIF_BADARG(dif_alert_handler_configure_alerts(
+      &alert_handler_, &alert_classes_, static_cast<dif_toggle_t>(2)));
+
+  // Out of range alert.
+  Assign(kAlerts, kDifAlertHandlerClassA);
+  EXPECT_DIF_BADARG(dif_alert_handler_configure_alerts(
+      &alert_handler_, &alert_classes_, kDifToggleDisabled));
+
+  // Alert assigned to two classes.
+  alert_classes_ = {};
+  Assign(3, kDifAlertHandlerClassA);
+  Assign(3, kDifAlertHandlerClassC);
+  EXPECT_DIF_BADARG(dif_alert_handler_configure_alerts(
+      &alert_handler_, &alert_classes_, kDifToggleDisabled));
+}
+
+TEST_F(AlertBulkConfigTest, Locked) {
+  Assign(0, kDifAlertHandlerClassA);
+  Assign(kAlerts - 1, kDifAlertHandlerClassB);
+
+  EXPECT_READ32(ALERT_HANDLER_ALERT_REGWEN_0_REG_OFFSET, 1);
+  EXPECT_READ32(Offset(ALERT_HANDLER_ALERT_REGWEN_0_REG_OFFSET, kAlerts - 1),
+                0);
+  EXPECT_EQ(dif_alert_handler_configure_alerts(
+                &alert_handler_, &alert_classes_, kDifToggleDisabled),
+            kDifLocked);
+}
+
+TEST_F(AlertBulkConfigTest, EnableAndLock) {
+  const std::vector<std::pair<dif_alert_handler_alert_t,
+                              dif_alert_handler_class_t>>
+      alerts = {
+          {0, kDifAlertHandlerClassA},
+          {31, kDifAlertHandlerClassD},
+          {32, kDifAlertHandlerClassB},
+          {kAlerts - 1, kDifAlertHandlerClassC},
+      };
+  for (const auto &[alert, alert_class] : alerts) {
+    Assign(alert, alert_class);
+  }
+
+  for (const auto &[alert, alert_class] : alerts) {
+    EXPECT_READ32(Offset(ALERT_HANDLER_ALERT_REGWEN_0_REG_OFFSET, alert), 1);
+  }
+  for (const auto &[alert, alert_class] : alerts) {
+    EXPECT_WRITE32_SHADOWED(
+        Offset(ALERT_HANDLER_ALERT_CLASS_SHADOWED_0_REG_OFFSET, alert),
+        alert_class);
+    EXPECT_WRITE32_SHADOWED(
+        Offset(ALERT_HANDLER_ALERT_EN_SHADOWED_0_REG_OFFSET, alert), 1);
+    EXPECT_WRITE32(Offset(ALERT_HANDLER_ALERT_REGWEN_0_REG_OFFSET, alert), 0);
+  }
+  for (const auto &[alert, alert_class] : alerts) {
+    EXPECT_READ32(
+        Offset(ALERT_HANDLER_ALERT_CLASS_SHADOWED_0_REG_OFFSET, alert),
+        alert_class);
+    EXPECT_READ32(Offset(ALERT_HANDLER_ALERT_EN_SHADOWED_0_REG_OFFSET, alert),
+                  1);
+  }
+
+  EXPECT_DIF_OK(dif_alert_handler_configure_alerts(
+      &alert_handler_, &alert_classes_, kDifToggleEnabled));
+}
+
+TEST_F(AlertBulkConfigTest, ReadbackMismatch) {
+  Assign(5, kDifAlertHandlerClassB);
+
+  EXPECT_READ32(Offset(ALERT_HANDLER_ALERT_REGWEN_0_REG_OFFSET, 5), 1);
+  EXPECT_WRITE32_SHADOWED(
+      Offset(ALERT_HANDLER_ALERT_CLASS_SHADOWED_0_REG_OFFSET, 5),
+      kDifAlertHandlerClassB);
+  EXPECT_WRITE32_SHADOWED(
+      Offset(ALERT_HANDLER_ALERT_EN_SHADOWED_0_REG_OFFSET, 5), 1);
+  EXPECT_READ32(Offset(ALERT_HANDLER_ALERT_CLASS_SHADOWED_0_REG_OFFSET, 5),
+                kDifAlertHandlerClassA);
+  EXPECT_READ32(Offset(ALERT_HANDLER_ALERT_EN_SHADOWED_0_REG_OFFSET, 5), 1);
+
+  EXPECT_EQ(dif_alert_handler_configure_alerts(
+                &alert_handler_, &alert_classes_, kDifToggleDisabled),
+            kDifError);
+}
+
 class LocalAlertConfigTest
     : public AlertHandlerTest,
       public testing::WithParamInterface<std::tuple<
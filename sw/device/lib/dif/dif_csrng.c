@@ -4,6 +4,8 @@
 
 #include "sw/device/lib/dif/dif_csrng.h"
 
+#include <assert.h>
+
 #include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
@@ -26,13 +28,12 @@ static void get_output_status(const dif_csrng_t *csrng,
 }
 
 /**
- * Returns true if the data register has valid data.
+ * Spins until the data register has valid data.
  */
-static void spin_until_ready(const dif_csrng_t *csrng) {
-  dif_csrng_output_status_t status;
-  do {
-    get_output_status(csrng, &status);
-  } while (!status.valid_data);
+static void genbits_spin_until_valid(const dif_csrng_t *csrng) {
+  while (!mmio_region_get_bit32(csrng->base_addr, CSRNG_GENBITS_VLD_REG_OFFSET,
+                                CSRNG_GENBITS_VLD_GENBITS_VLD_BIT)) {
+  }
 }
 
 static dif_result_t check_locked(const dif_csrng_t *csrng) {
@@ -119,12 +120,50 @@ dif_result_t dif_csrng_generate_read(const dif_csrng_t *csrng, uint32_t *buf,
     return kDifBadArg;
   }
 
-  for (size_t i = 0; i < len; ++i) {
-    // Block until there is more data available in the genbits buffer.
-    if (i % kCsrngGenBitsBufferSize == 0) {
-      spin_until_ready(csrng);
-    }
+  // Poll once per 128-bit block and read the whole block back to back.
+  static_assert(kCsrngGenBitsBufferSize == 4,
+                "The unrolled loop below assumes four words per block.");
+  size_t i = 0;
+  for (; i + kCsrngGenBitsBufferSize <= len; i += kCsrngGenBitsBufferSize) {
+    genbits_spin_until_valid(csrng);
     buf[i] = mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+    buf[i + 1] =
+        mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+    buf[i + 2] =
+        mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+    buf[i + 3] =
+        mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+  }
+
+  // Partial trailing block.
+  if (i < len) {
+    genbits_spin_until_valid(csrng);
+    for (; i < len; ++i) {
+      buf[i] = mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+    }
+  }
+  return kDifOk;
+}
+
+dif_result_t dif_csrng_generate(const dif_csrng_t *csrng, uint32_t *buf,
+                                size_t len) {
+  if (csrng == NULL || buf == NULL || len == 0) {
+    return kDifBadArg;
+  }
+
+  // Generate commands are limited in size, and the command interface only
+  // accepts the next command once all bits of the previous one have been
+  // read, so large requests are split into back-to-back maximum-size
+  // commands.
+  while (len > 0) {
+    size_t chunk_len = len;
+    if (chunk_len > kCsrngGenerateMaxWords) {
+      chunk_len = kCsrngGenerateMaxWords;
+    }
+    DIF_RETURN_IF_ERROR(dif_csrng_generate_start(csrng, chunk_len));
+    DIF_RETURN_IF_ERROR(dif_csrng_generate_read(csrng, buf, chunk_len));
+    buf += chunk_len;
+    len -= chunk_len;
   }
   return kDifOk;
 }
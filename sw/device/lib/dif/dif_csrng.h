@@ -458,6 +458,23 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_csrng_generate_read(const dif_csrng_t *csrng, uint32_t *buf,
                                      size_t len);
 
+/**
+ * Generates `len` words of random data into `buf`.
+ *
+ * Issues as many generate commands as needed, each no larger than the
+ * maximum generate length, and reads each command's output block by block
+ * before issuing the next. This function will block until `len` words are
+ * read.
+ *
+ * @param csrng A CSRNG handle.
+ * @param[out] buf A buffer to fill with words from the pipeline.
+ * @param len The number of words to generate into `buf`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_csrng_generate(const dif_csrng_t *csrng, uint32_t *buf,
+                                size_t len);
+
 /**
  * Uninstantiates CSRNG
  *
@@ -21,6 +21,18 @@ enum {
    * CSRNG genbits buffer size in uint32_t words.
    */
   kCsrngGenBitsBufferSize = 4,
+  /**
+   * Maximum generate command length in 128-bit blocks.
+   *
+   * This is to maintain full compliance with NIST SP 800-90A, which requires
+   * the max generate output to be constrained to gen < 2 ^ 12 bits or 0x800
+   * 128-bit blocks.
+   */
+  kCsrngGenerateMaxBlocks = 0x800,
+  /**
+   * Maximum generate command length in uint32_t words.
+   */
+  kCsrngGenerateMaxWords = kCsrngGenerateMaxBlocks * kCsrngGenBitsBufferSize,
 };
 
 /**
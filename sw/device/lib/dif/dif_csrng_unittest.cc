@@ -350,6 +350,38 @@ TEST_F(GenerateEndTest, ReadOk) {
   EXPECT_THAT(got, testing::ElementsAreArray(kExpected));
 }
 
+TEST_F(GenerateEndTest, ReadMultiBlockWithTail) {
+  constexpr std::array<uint32_t, 6> kExpected = {
+      0x00000000, 0x11111111, 0x22222222,
+      0x33333333, 0x44444444, 0x55555555,
+  };
+
+  // The valid bit is polled once per 128-bit block, including the partial
+  // trailing block.
+  EXPECT_READ32(CSRNG_GENBITS_VLD_REG_OFFSET,
+                {
+                    {CSRNG_GENBITS_VLD_GENBITS_VLD_BIT, false},
+                });
+  EXPECT_READ32(CSRNG_GENBITS_VLD_REG_OFFSET,
+                {
+                    {CSRNG_GENBITS_VLD_GENBITS_VLD_BIT, true},
+                });
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_READ32(CSRNG_GENBITS_REG_OFFSET, kExpected[i]);
+  }
+  EXPECT_READ32(CSRNG_GENBITS_VLD_REG_OFFSET,
+                {
+                    {CSRNG_GENBITS_VLD_GENBITS_VLD_BIT, true},
+                });
+  for (size_t i = 4; i < kExpected.size(); ++i) {
+    EXPECT_READ32(CSRNG_GENBITS_REG_OFFSET, kExpected[i]);
+  }
+
+  std::vector<uint32_t> got(kExpected.size());
+  EXPECT_DIF_OK(dif_csrng_generate_read(&csrng_, got.data(), got.size()));
+  EXPECT_THAT(got, testing::ElementsAreArray(kExpected));
+}
+
 TEST_F(GenerateEndTest, ReadBadArgs) {
   EXPECT_DIF_BADARG(dif_csrng_generate_read(&csrng_, nullptr, /*len=*/0));
 
@@ -357,6 +389,53 @@ TEST_F(GenerateEndTest, ReadBadArgs) {
   EXPECT_DIF_BADARG(dif_csrng_generate_read(nullptr, &data, /*len=*/1));
 }
 
+TEST_F(GenerateEndTest, GenerateSplitsCommands) {
+  enum {
+    kMaxBlocks = 0x800,
+    kLen = kMaxBlocks * 4 + 2,
+  };
+
+  // First command: a maximum-size generate.
+  EXPECT_READ32(CSRNG_SW_CMD_STS_REG_OFFSET,
+                {{CSRNG_SW_CMD_STS_CMD_RDY_BIT, true}});
+  EXPECT_WRITE32(CSRNG_CMD_REQ_REG_OFFSET,
+                 kMaxBlocks << 12 | 0x003 | kMultiBitBool4False << 8);
+  for (uint32_t block = 0; block < kMaxBlocks; ++block) {
+    EXPECT_READ32(CSRNG_GENBITS_VLD_REG_OFFSET,
+                  {
+                      {CSRNG_GENBITS_VLD_GENBITS_VLD_BIT, true},
+                  });
+    for (uint32_t word = 0; word < 4; ++word) {
+      EXPECT_READ32(CSRNG_GENBITS_REG_OFFSET, block * 4 + word);
+    }
+  }
+
+  // Second command: the remaining two words, rounded up to one block.
+  EXPECT_READ32(CSRNG_SW_CMD_STS_REG_OFFSET,
+                {{CSRNG_SW_CMD_STS_CMD_RDY_BIT, true}});
+  EXPECT_WRITE32(CSRNG_CMD_REQ_REG_OFFSET,
+                 0x00001003 | kMultiBitBool4False << 8);
+  EXPECT_READ32(CSRNG_GENBITS_VLD_REG_OFFSET,
+                {
+                    {CSRNG_GENBITS_VLD_GENBITS_VLD_BIT, true},
+                });
+  EXPECT_READ32(CSRNG_GENBITS_REG_OFFSET, kMaxBlocks * 4);
+  EXPECT_READ32(CSRNG_GENBITS_REG_OFFSET, kMaxBlocks * 4 + 1);
+
+  std::vector<uint32_t> got(kLen);
+  EXPECT_DIF_OK(dif_csrng_generate(&csrng_, got.data(), got.size()));
+  for (uint32_t i = 0; i < kLen; ++i) {
+    EXPECT_EQ(got[i], i);
+  }
+}
+
+TEST_F(GenerateEndTest, GenerateBadArgs) {
+  uint32_t data;
+  EXPECT_DIF_BADARG(dif_csrng_generate(nullptr, &data, /*len=*/1));
+  EXPECT_DIF_BADARG(dif_csrng_generate(&csrng_, nullptr, /*len=*/1));
+  EXPECT_DIF_BADARG(dif_csrng_generate(&csrng_, &data, /*len=*/0));
+}
+
 class GetInternalStateTest : public DifCsrngTest {};
 
 TEST_F(GetInternalStateTest, GetInternalStateOk) {
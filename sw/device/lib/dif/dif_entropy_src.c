@@ -484,6 +484,48 @@ dif_result_t dif_entropy_src_non_blocking_read(
   return kDifOk;
 }
 
+/**
+ * Returns true if the entropy source is in firmware override mode, which is
+ * required to read from the observe FIFO.
+ */
+static bool fw_ov_mode_enabled(const dif_entropy_src_t *entropy_src) {
+  uint32_t reg = mmio_region_read32(entropy_src->base_addr,
+                                    ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET);
+  return bitfield_field32_read(reg,
+                               ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_FIELD) ==
+         kMultiBitBool4True;
+}
+
+/**
+ * Waits for the observe FIFO to reach its threshold, reads `len` words without
+ * checking the FIFO depth and clears the FIFO ready status bit.
+ *
+ * `len` must not exceed the observe FIFO threshold. `buf` may be `NULL`.
+ */
+static void observe_fifo_threshold_read(const dif_entropy_src_t *entropy_src,
+                                        uint32_t *buf, size_t len) {
+  // Block until there is enough data in the observe FIFO.
+  while (!mmio_region_get_bit32(
+      entropy_src->base_addr, ENTROPY_SRC_INTR_STATE_REG_OFFSET,
+      ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT)) {
+  }
+
+  // Read post-health test, pre-conditioned, entropy from the observe FIFO.
+  for (size_t i = 0; i < len; ++i) {
+    uint32_t reg = mmio_region_read32(entropy_src->base_addr,
+                                      ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET);
+    if (buf != NULL) {
+      buf[i] = reg;
+    }
+  }
+
+  // Clear the status bit.
+  uint32_t reg = bitfield_bit32_write(
+      0, ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT, true);
+  mmio_region_write32(entropy_src->base_addr, ENTROPY_SRC_INTR_STATE_REG_OFFSET,
+                      reg);
+}
+
 dif_result_t dif_entropy_src_observe_fifo_blocking_read(
     const dif_entropy_src_t *entropy_src, uint32_t *buf, size_t len) {
   if (entropy_src == NULL) {
@@ -500,35 +542,40 @@ dif_result_t dif_entropy_src_observe_fifo_blocking_read(
 
   // Check that we are in firmware override mode. We can only read from the
   // observe FIFO if we are.
-  reg = mmio_region_read32(entropy_src->base_addr,
-                           ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET);
-  if (bitfield_field32_read(reg, ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_FIELD) !=
-      kMultiBitBool4True) {
+  if (!fw_ov_mode_enabled(entropy_src)) {
     return kDifError;
   }
 
-  // Block until there is enough data in the observe FIFO.
-  do {
-    reg = mmio_region_read32(entropy_src->base_addr,
-                             ENTROPY_SRC_INTR_STATE_REG_OFFSET);
-  } while (!bitfield_bit32_read(
-      reg, ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT));
+  observe_fifo_threshold_read(entropy_src, buf, len);
+  return kDifOk;
+}
 
-  // Read post-health test, pre-conditioned, entropy from the observe FIFO.
-  for (size_t i = 0; i < len; ++i) {
-    reg = mmio_region_read32(entropy_src->base_addr,
-                             ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET);
-    if (buf != NULL) {
-      buf[i] = reg;
-    }
+dif_result_t dif_entropy_src_observe_fifo_bulk_read(
+    const dif_entropy_src_t *entropy_src, uint32_t *buf, size_t len) {
+  if (entropy_src == NULL) {
+    return kDifBadArg;
   }
 
-  // Clear the status bit.
-  reg = bitfield_bit32_write(
-      0, ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT, true);
-  mmio_region_write32(entropy_src->base_addr, ENTROPY_SRC_INTR_STATE_REG_OFFSET,
-                      reg);
+  // The threshold is the number of words that are guaranteed to be available
+  // each time the FIFO ready status bit is set.
+  uint32_t threshold = mmio_region_read32(
+      entropy_src->base_addr, ENTROPY_SRC_OBSERVE_FIFO_THRESH_REG_OFFSET);
+  if (threshold == 0) {
+    return kDifError;
+  }
+
+  if (!fw_ov_mode_enabled(entropy_src)) {
+    return kDifError;
+  }
 
+  while (len > 0) {
+    size_t chunk_len = len < threshold ? len : threshold;
+    observe_fifo_threshold_read(entropy_src, buf, chunk_len);
+    if (buf != NULL) {
+      buf += chunk_len;
+    }
+    len -= chunk_len;
+  }
   return kDifOk;
 }
 
@@ -540,22 +587,30 @@ dif_result_t dif_entropy_src_observe_fifo_nonblocking_read(
 
   // Check that we are in firmware override mode. We can only read from the
   // observe FIFO if we are.
-  uint32_t reg = mmio_region_read32(entropy_src->base_addr,
-                                    ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET);
-  if (bitfield_field32_read(reg, ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_FIELD) !=
-      kMultiBitBool4True) {
+  if (!fw_ov_mode_enabled(entropy_src)) {
     return kDifError;
   }
 
-  // Read until FIFO is empty or we have read `*len` words.
+  // Read until FIFO is empty or we have read `*len` words. The FIFO depth is
+  // only sampled once per batch: every word counted in a depth snapshot can be
+  // read without checking the depth again.
   size_t read_count = 0;
-  while (read_count < *len &&
-         mmio_region_read32(entropy_src->base_addr,
-                            ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET) > 0) {
-    uint32_t reg = mmio_region_read32(entropy_src->base_addr,
-                                      ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET);
-    if (buf != NULL) {
-      buf[read_count++] = reg;
+  while (read_count < *len) {
+    uint32_t depth = mmio_region_read32(
+        entropy_src->base_addr, ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET);
+    if (depth == 0) {
+      break;
+    }
+    size_t batch_end = read_count + depth;
+    if (batch_end > *len) {
+      batch_end = *len;
+    }
+    for (; read_count < batch_end; ++read_count) {
+      uint32_t reg = mmio_region_read32(entropy_src->base_addr,
+                                        ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET);
+      if (buf != NULL) {
+        buf[read_count] = reg;
+      }
     }
   }
   // Update `*len`.
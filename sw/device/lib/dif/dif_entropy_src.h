@@ -690,6 +690,26 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_entropy_src_observe_fifo_blocking_read(
     const dif_entropy_src_t *entropy_src, uint32_t *buf, size_t len);
 
+/**
+ * Performs a blocking bulk read from the entropy pipeline through the observe
+ * FIFO, which contains post health-test, unconditioned entropy.
+ *
+ * The entropy source must be configured with firmware override mode enabled.
+ * Unlike `dif_entropy_src_observe_fifo_blocking_read()`, `len` may exceed the
+ * FIFO threshold: the read is split into threshold-sized chunks, each of which
+ * waits for the observe FIFO ready status bit and then reads the whole chunk
+ * without checking the FIFO depth. `buf` may be `NULL`; in this case, reads
+ * will be discarded.
+ *
+ * @param entropy_src An entropy source handle.
+ * @param[out] buf A buffer to fill with words from the pipeline.
+ * @param len The number of words to read into `buf`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_entropy_src_observe_fifo_bulk_read(
+    const dif_entropy_src_t *entropy_src, uint32_t *buf, size_t len);
+
 /**
  * Performs a nonblocking read from the entropy pipeline through the observe
  * FIFO, which contains  post health-test, unconditioned entropy.
@@ -587,6 +587,108 @@ TEST_F(ObserveFifoBlockingReadTest, SuccessDataSave) {
   }
 }
 
+class ObserveFifoBulkReadTest : public EntropySrcTest {};
+
+TEST_F(ObserveFifoBulkReadTest, NullHandle) {
+  uint32_t buf[8];
+  EXPECT_DIF_BADARG(dif_entropy_src_observe_fifo_bulk_read(nullptr, buf, 8));
+}
+
+TEST_F(ObserveFifoBulkReadTest, ZeroThreshold) {
+  uint32_t buf[8];
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_THRESH_REG_OFFSET, 0);
+  EXPECT_EQ(dif_entropy_src_observe_fifo_bulk_read(&entropy_src_, buf, 8),
+            kDifError);
+}
+
+TEST_F(ObserveFifoBulkReadTest, BadConfig) {
+  uint32_t buf[8];
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_THRESH_REG_OFFSET, 4);
+  EXPECT_READ32(
+      ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET,
+      {{ENTROPY_SRC_FW_OV_CONTROL_FW_OV_ENTROPY_INSERT_OFFSET,
+        kMultiBitBool4False},
+       {ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_OFFSET, kMultiBitBool4False}});
+  EXPECT_EQ(dif_entropy_src_observe_fifo_bulk_read(&entropy_src_, buf, 8),
+            kDifError);
+}
+
+TEST_F(ObserveFifoBulkReadTest, Success) {
+  // Ten words with a threshold of four are read in chunks of 4, 4 and 2.
+  uint32_t buf[10];
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_THRESH_REG_OFFSET, 4);
+  EXPECT_READ32(
+      ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET,
+      {{ENTROPY_SRC_FW_OV_CONTROL_FW_OV_ENTROPY_INSERT_OFFSET,
+        kMultiBitBool4False},
+       {ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_OFFSET, kMultiBitBool4True}});
+  uint32_t word = 0;
+  for (size_t chunk_len : {4, 4, 2}) {
+    EXPECT_READ32(ENTROPY_SRC_INTR_STATE_REG_OFFSET, 0);
+    EXPECT_READ32(ENTROPY_SRC_INTR_STATE_REG_OFFSET,
+                  {{ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT, 1}});
+    for (size_t i = 0; i < chunk_len; ++i) {
+      EXPECT_READ32(ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET, word++);
+    }
+    EXPECT_WRITE32(ENTROPY_SRC_INTR_STATE_REG_OFFSET,
+                   {{ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT, 1}});
+  }
+  EXPECT_DIF_OK(
+      dif_entropy_src_observe_fifo_bulk_read(&entropy_src_, buf, 10));
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(buf[i], i);
+  }
+}
+
+class ObserveFifoNonblockingReadTest : public EntropySrcTest {};
+
+TEST_F(ObserveFifoNonblockingReadTest, NullArgs) {
+  uint32_t buf[8];
+  size_t len = 8;
+  EXPECT_DIF_BADARG(
+      dif_entropy_src_observe_fifo_nonblocking_read(nullptr, buf, &len));
+  EXPECT_DIF_BADARG(dif_entropy_src_observe_fifo_nonblocking_read(
+      &entropy_src_, buf, nullptr));
+}
+
+TEST_F(ObserveFifoNonblockingReadTest, ReadsDepthWithoutPolling) {
+  // The depth is sampled once per batch rather than once per word.
+  uint32_t buf[8];
+  size_t len = 8;
+  EXPECT_READ32(
+      ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET,
+      {{ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_OFFSET, kMultiBitBool4True}});
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, 3);
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_READ32(ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET, i);
+  }
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, 2);
+  for (uint32_t i = 3; i < 5; ++i) {
+    EXPECT_READ32(ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET, i);
+  }
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, 0);
+  EXPECT_DIF_OK(
+      dif_entropy_src_observe_fifo_nonblocking_read(&entropy_src_, buf, &len));
+  EXPECT_EQ(len, 5);
+  for (uint32_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(buf[i], i);
+  }
+}
+
+TEST_F(ObserveFifoNonblockingReadTest, DiscardStopsAtLen) {
+  size_t len = 4;
+  EXPECT_READ32(
+      ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET,
+      {{ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_OFFSET, kMultiBitBool4True}});
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, 16);
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_READ32(ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET, i);
+  }
+  EXPECT_DIF_OK(dif_entropy_src_observe_fifo_nonblocking_read(&entropy_src_,
+                                                              nullptr, &len));
+  EXPECT_EQ(len, 4);
+}
+
 class ObserveFifoWriteTest : public EntropySrcTest {};
 
 TEST_F(ObserveFifoWriteTest, NullArgs) {
@@ -630,6 +630,172 @@ dif_result_t dif_flash_ctrl_end(dif_flash_ctrl_state_t *handle,
   return kDifOk;
 }
 
+/**
+ * Number of words in the next transaction of an asynchronous operation.
+ */
+static uint32_t async_transaction_words(const dif_flash_ctrl_async_t *async) {
+  uint32_t words = async->next.word_count;
+  if (async->next.op != kDifFlashCtrlOpRead) {
+    // Programs must not cross program resolution window boundaries.
+    const uint32_t window_words =
+        (uint32_t)FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t);
+    uint32_t word_address = async->next.byte_address / sizeof(uint32_t);
+    uint32_t window_limit = window_words - (word_address % window_words);
+    if (words > window_limit) {
+      words = window_limit;
+    }
+  }
+  const uint32_t max_words = FLASH_CTRL_CONTROL_NUM_MASK + 1;
+  if (words > max_words) {
+    words = max_words;
+  }
+  return words;
+}
+
+/**
+ * Starts the next transaction of an asynchronous operation.
+ */
+static dif_result_t async_issue(dif_flash_ctrl_state_t *handle,
+                                dif_flash_ctrl_async_t *async, bool first) {
+  dif_flash_ctrl_transaction_t transaction = async->next;
+  transaction.word_count = async_transaction_words(async);
+  // The FIFOs are known to be drained between transactions of the same
+  // operation, so only the first one needs the full set of checks.
+  DIF_RETURN_IF_ERROR(first ? dif_flash_ctrl_start(handle, transaction)
+                            : dif_flash_ctrl_start_unsafe(handle, transaction));
+  async->next.byte_address += transaction.word_count * sizeof(uint32_t);
+  async->next.word_count -= transaction.word_count;
+  return kDifOk;
+}
+
+/**
+ * Moves as many words of the current transaction through the FIFO as possible
+ * without waiting.
+ */
+static void async_transfer(dif_flash_ctrl_state_t *handle,
+                           dif_flash_ctrl_async_t *async) {
+  if (handle->words_remaining == 0) {
+    return;
+  }
+  uint32_t level = mmio_region_read32(handle->dev.base_addr,
+                                      FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET);
+  uint32_t words;
+  if (async->next.op == kDifFlashCtrlOpRead) {
+    words = bitfield_field32_read(level, FLASH_CTRL_CURR_FIFO_LVL_RD_FIELD);
+    if (words > handle->words_remaining) {
+      words = handle->words_remaining;
+    }
+    // Arguments were checked when the operation was started.
+    OT_DISCARD(dif_flash_ctrl_read_fifo_pop_unsafe(handle, words,
+                                                   async->read_data));
+    async->read_data += words;
+  } else {
+    words = FLASH_CTRL_PARAM_PROG_FIFO_DEPTH -
+            bitfield_field32_read(level, FLASH_CTRL_CURR_FIFO_LVL_PROG_FIELD);
+    if (words > handle->words_remaining) {
+      words = handle->words_remaining;
+    }
+    OT_DISCARD(dif_flash_ctrl_prog_fifo_push_unsafe(handle, words,
+                                                    async->prog_data));
+    async->prog_data += words;
+  }
+}
+
+/**
+ * Keeps the program FIFO level interrupt enabled only while there are words
+ * left to push: it is a status interrupt and would otherwise keep firing while
+ * the last words of a transaction are programmed.
+ */
+static dif_result_t async_update_irq(dif_flash_ctrl_state_t *handle,
+                                     dif_flash_ctrl_async_t *async) {
+  if (async->next.op == kDifFlashCtrlOpRead) {
+    return kDifOk;
+  }
+  return dif_flash_ctrl_irq_set_enabled(
+      &handle->dev, kDifFlashCtrlIrqProgLvl,
+      dif_bool_to_toggle(handle->words_remaining != 0));
+}
+
+static dif_result_t async_start(dif_flash_ctrl_state_t *handle,
+                                dif_flash_ctrl_async_t *async,
+                                dif_flash_ctrl_transaction_t transaction) {
+  if (transaction.word_count == 0 ||
+      transaction.byte_address % sizeof(uint32_t) != 0) {
+    return kDifBadArg;
+  }
+  async->next = transaction;
+  DIF_RETURN_IF_ERROR(async_issue(handle, async, /*first=*/true));
+  async_transfer(handle, async);
+  return async_update_irq(handle, async);
+}
+
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_flash_ctrl_async_program_start(
+    dif_flash_ctrl_state_t *handle, dif_flash_ctrl_async_t *async,
+    dif_flash_ctrl_transaction_t transaction, const uint32_t *data) {
+  if (handle == NULL || async == NULL || data == NULL ||
+      (transaction.op != kDifFlashCtrlOpProgram &&
+       transaction.op != kDifFlashCtrlOpProgramRepair)) {
+    return kDifBadArg;
+  }
+  async->prog_data = data;
+  async->read_data = NULL;
+  return async_start(handle, async, transaction);
+}
+
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_flash_ctrl_async_read_start(
+    dif_flash_ctrl_state_t *handle, dif_flash_ctrl_async_t *async,
+    dif_flash_ctrl_transaction_t transaction, uint32_t *data_out) {
+  if (handle == NULL || async == NULL || data_out == NULL ||
+      transaction.op != kDifFlashCtrlOpRead) {
+    return kDifBadArg;
+  }
+  async->prog_data = NULL;
+  async->read_data = data_out;
+  return async_start(handle, async, transaction);
+}
+
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_flash_ctrl_async_service(dif_flash_ctrl_state_t *handle,
+                                          dif_flash_ctrl_async_t *async,
+                                          dif_flash_ctrl_output_t *out,
+                                          bool *done_out) {
+  if (handle == NULL || async == NULL || out == NULL || done_out == NULL) {
+    return kDifBadArg;
+  }
+  if (!handle->transaction_pending) {
+    return kDifError;
+  }
+
+  // Acknowledge completion before checking for it so that a transaction
+  // finishing in between is not missed.
+  DIF_RETURN_IF_ERROR(
+      dif_flash_ctrl_irq_acknowledge(&handle->dev, kDifFlashCtrlIrqOpDone));
+
+  *done_out = false;
+  while (true) {
+    async_transfer(handle, async);
+    if (handle->words_remaining != 0) {
+      break;
+    }
+    dif_flash_ctrl_output_t output;
+    dif_result_t result = dif_flash_ctrl_end(handle, &output);
+    if (result == kDifUnavailable) {
+      break;
+    }
+    DIF_RETURN_IF_ERROR(result);
+    if (output.operation_error || async->next.word_count == 0) {
+      *out = output;
+      *done_out = true;
+      break;
+    }
+    DIF_RETURN_IF_ERROR(async_issue(handle, async, /*first=*/false));
+  }
+
+  return async_update_irq(handle, async);
+}
+
 OT_WARN_UNUSED_RESULT
 dif_result_t dif_flash_ctrl_set_data_region_enablement(
     dif_flash_ctrl_state_t *handle, uint32_t region, dif_toggle_t enable) {
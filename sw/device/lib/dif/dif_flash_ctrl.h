@@ -581,6 +581,111 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_flash_ctrl_end(dif_flash_ctrl_state_t *handle,
                                 dif_flash_ctrl_output_t *out);
 
+/**
+ * State of a multi-transaction program or read operation.
+ *
+ * The operation is split into transactions that each fit in a program
+ * resolution window (program) or in the controller's maximum word count
+ * (read). `dif_flash_ctrl_async_service()` moves data between memory and the
+ * FIFOs and starts the next transaction as soon as the previous one is done,
+ * so it can be driven entirely from interrupts:
+ *   - the program FIFO level interrupt (`kDifFlashCtrlIrqProgLvl`), which is
+ *     enabled and disabled by this API for program operations,
+ *   - the read FIFO level interrupt (`kDifFlashCtrlIrqRdLvl`) for read
+ *     operations, and
+ *   - the operation done interrupt (`kDifFlashCtrlIrqOpDone`), which is
+ *     acknowledged by this API.
+ * The FIFO watermarks are left to the caller, see
+ * `dif_flash_ctrl_set_prog_fifo_watermark()` and
+ * `dif_flash_ctrl_set_read_fifo_watermark()`.
+ *
+ * All members should be considered private.
+ */
+typedef struct dif_flash_ctrl_async {
+  /**
+   * The part of the operation not covered by a started transaction yet.
+   */
+  dif_flash_ctrl_transaction_t next;
+  /**
+   * Next word to push into the program FIFO.
+   */
+  const uint32_t *prog_data;
+  /**
+   * Next location to store a word popped from the read FIFO.
+   */
+  uint32_t *read_data;
+} dif_flash_ctrl_async_t;
+
+/**
+ * Start a program operation of arbitrary length.
+ *
+ * `transaction.op` must be `kDifFlashCtrlOpProgram` or
+ * `kDifFlashCtrlOpProgramRepair`, `transaction.byte_address` must be word
+ * aligned, and `transaction.word_count` may exceed both the program window
+ * and the maximum transaction size. The first transaction is started and the
+ * program FIFO filled before this function returns.
+ *
+ * @param handle The flash controller device to program.
+ * @param[out] async State of the operation.
+ * @param transaction The parameters of the operation.
+ * @param data The data to program; must remain valid until the operation
+ * completes.
+ * @return `kDifBadArg` if `handle`, `async` or `data` are null or
+ * `transaction` is invalid, `kDifUnavailable` if a transaction is in
+ * progress, `kDifIpFifoFull` if the FIFOs are not empty, and `kDifOk`
+ * otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_flash_ctrl_async_program_start(
+    dif_flash_ctrl_state_t *handle, dif_flash_ctrl_async_t *async,
+    dif_flash_ctrl_transaction_t transaction, const uint32_t *data);
+
+/**
+ * Start a read operation of arbitrary length.
+ *
+ * `transaction.op` must be `kDifFlashCtrlOpRead` and `transaction.word_count`
+ * may exceed the maximum transaction size.
+ *
+ * @param handle The flash controller device to read from.
+ * @param[out] async State of the operation.
+ * @param transaction The parameters of the operation.
+ * @param[out] data_out Buffer for `transaction.word_count` words; must remain
+ * valid until the operation completes.
+ * @return `kDifBadArg` if `handle`, `async` or `data_out` are null or
+ * `transaction` is invalid, `kDifUnavailable` if a transaction is in
+ * progress, `kDifIpFifoFull` if the FIFOs are not empty, and `kDifOk`
+ * otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_flash_ctrl_async_read_start(
+    dif_flash_ctrl_state_t *handle, dif_flash_ctrl_async_t *async,
+    dif_flash_ctrl_transaction_t transaction, uint32_t *data_out);
+
+/**
+ * Advance an operation started with `dif_flash_ctrl_async_program_start()` or
+ * `dif_flash_ctrl_async_read_start()`.
+ *
+ * Moves as many words through the FIFO as possible without waiting, and
+ * starts the next transaction if the current one has completed. Safe to call
+ * from the interrupt handlers listed in `dif_flash_ctrl_async_t` or from a
+ * polling loop.
+ *
+ * The operation stops at the first transaction that completes with an error.
+ *
+ * @param handle The flash controller device.
+ * @param async State of the operation.
+ * @param[out] out The status of the last transaction; only written once the
+ * operation is done.
+ * @param[out] done_out Whether the operation is done.
+ * @return `kDifBadArg` if any argument is null, `kDifError` if no operation is
+ * in progress, and `kDifOk` otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_flash_ctrl_async_service(dif_flash_ctrl_state_t *handle,
+                                          dif_flash_ctrl_async_t *async,
+                                          dif_flash_ctrl_output_t *out,
+                                          bool *done_out);
+
 /**
  * Memory protection configuration options.
  */
@@ -511,6 +511,167 @@ TEST_F(FlashCtrlTest, ProgramTransaction) {
   EXPECT_EQ(output.error_code.codes.shadow_register_error, 1);
 }
 
+class FlashCtrlAsyncTest : public FlashCtrlTest {
+ protected:
+  void ExpectStart(uint32_t op, uint32_t byte_address, uint32_t word_count) {
+    EXPECT_READ32(FLASH_CTRL_CTRL_REGWEN_REG_OFFSET,
+                  {{FLASH_CTRL_CTRL_REGWEN_EN_BIT, 1}});
+    EXPECT_WRITE32(FLASH_CTRL_CONTROL_REG_OFFSET,
+                   {
+                       {FLASH_CTRL_CONTROL_OP_OFFSET, op},
+                       {FLASH_CTRL_CONTROL_NUM_OFFSET, word_count - 1},
+                   });
+    EXPECT_WRITE32(FLASH_CTRL_ADDR_REG_OFFSET, byte_address);
+    EXPECT_WRITE32(FLASH_CTRL_CONTROL_REG_OFFSET,
+                   {
+                       {FLASH_CTRL_CONTROL_START_BIT, 1},
+                       {FLASH_CTRL_CONTROL_OP_OFFSET, op},
+                       {FLASH_CTRL_CONTROL_NUM_OFFSET, word_count - 1},
+                   });
+  }
+
+  void ExpectFifosEmpty() {
+    EXPECT_READ32(FLASH_CTRL_STATUS_REG_OFFSET,
+                  {
+                      {FLASH_CTRL_STATUS_RD_EMPTY_BIT, 1},
+                      {FLASH_CTRL_STATUS_PROG_EMPTY_BIT, 1},
+                  });
+  }
+
+  void ExpectProgLvlIrq(bool enabled) {
+    EXPECT_READ32(FLASH_CTRL_INTR_ENABLE_REG_OFFSET, 0);
+    EXPECT_WRITE32(FLASH_CTRL_INTR_ENABLE_REG_OFFSET,
+                   {{FLASH_CTRL_INTR_ENABLE_PROG_LVL_BIT, enabled}});
+  }
+
+  void ExpectEnd(bool done) {
+    EXPECT_READ32(FLASH_CTRL_OP_STATUS_REG_OFFSET,
+                  {{FLASH_CTRL_OP_STATUS_DONE_BIT, done}});
+    if (done) {
+      EXPECT_READ32(FLASH_CTRL_ERR_CODE_REG_OFFSET, 0);
+      EXPECT_READ32(FLASH_CTRL_ERR_ADDR_REG_OFFSET, 0);
+      EXPECT_WRITE32(FLASH_CTRL_OP_STATUS_REG_OFFSET, 0);
+    }
+  }
+
+  void ExpectOpDoneAck() {
+    EXPECT_WRITE32(FLASH_CTRL_INTR_STATE_REG_OFFSET,
+                   {{FLASH_CTRL_INTR_STATE_OP_DONE_BIT, 1}});
+  }
+
+  dif_flash_ctrl_async_t async_;
+  dif_flash_ctrl_output_t output_;
+  bool done_;
+};
+
+TEST_F(FlashCtrlAsyncTest, BadArgs) {
+  uint32_t data[4];
+  dif_flash_ctrl_transaction_t transaction = {
+      .op = kDifFlashCtrlOpRead,
+      .partition_type = kDifFlashCtrlPartitionTypeData,
+      .byte_address = 0x1000,
+      .word_count = 4,
+  };
+  EXPECT_DIF_BADARG(dif_flash_ctrl_async_program_start(
+      &dif_flash_ctrl_, &async_, transaction, data));
+  EXPECT_DIF_BADARG(dif_flash_ctrl_async_read_start(&dif_flash_ctrl_, nullptr,
+                                                    transaction, data));
+  transaction.byte_address = 0x1002;
+  EXPECT_DIF_BADARG(dif_flash_ctrl_async_read_start(&dif_flash_ctrl_, &async_,
+                                                    transaction, data));
+  transaction.byte_address = 0x1000;
+  transaction.word_count = 0;
+  EXPECT_DIF_BADARG(dif_flash_ctrl_async_read_start(&dif_flash_ctrl_, &async_,
+                                                    transaction, data));
+  EXPECT_EQ(dif_flash_ctrl_async_service(&dif_flash_ctrl_, &async_, &output_,
+                                         &done_),
+            kDifError);
+}
+
+TEST_F(FlashCtrlAsyncTest, ProgramAcrossWindows) {
+  // Four words up to the end of a program window, then two more.
+  const uint32_t kAddr = 0x1800 + FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES - 16;
+  uint32_t data[6] = {0, 1, 2, 3, 4, 5};
+  dif_flash_ctrl_transaction_t transaction = {
+      .op = kDifFlashCtrlOpProgram,
+      .partition_type = kDifFlashCtrlPartitionTypeData,
+      .byte_address = kAddr,
+      .word_count = 6,
+  };
+
+  ExpectFifosEmpty();
+  ExpectStart(FLASH_CTRL_CONTROL_OP_VALUE_PROG, kAddr, 4);
+  EXPECT_READ32(FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET, 0);
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_WRITE32(FLASH_CTRL_PROG_FIFO_REG_OFFSET, i);
+  }
+  ExpectProgLvlIrq(false);
+  EXPECT_DIF_OK(dif_flash_ctrl_async_program_start(&dif_flash_ctrl_, &async_,
+                                                   transaction, data));
+
+  // The first transaction completes and the second one is chained.
+  ExpectOpDoneAck();
+  ExpectEnd(true);
+  ExpectStart(FLASH_CTRL_CONTROL_OP_VALUE_PROG, kAddr + 16, 2);
+  EXPECT_READ32(FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET, 0);
+  EXPECT_WRITE32(FLASH_CTRL_PROG_FIFO_REG_OFFSET, 4);
+  EXPECT_WRITE32(FLASH_CTRL_PROG_FIFO_REG_OFFSET, 5);
+  ExpectEnd(false);
+  ExpectProgLvlIrq(false);
+  EXPECT_DIF_OK(dif_flash_ctrl_async_service(&dif_flash_ctrl_, &async_,
+                                             &output_, &done_));
+  EXPECT_FALSE(done_);
+
+  ExpectOpDoneAck();
+  ExpectEnd(true);
+  ExpectProgLvlIrq(false);
+  EXPECT_DIF_OK(dif_flash_ctrl_async_service(&dif_flash_ctrl_, &async_,
+                                             &output_, &done_));
+  EXPECT_TRUE(done_);
+  EXPECT_FALSE(output_.operation_error);
+}
+
+TEST_F(FlashCtrlAsyncTest, ReadDrainsFifo) {
+  uint32_t data[5] = {};
+  dif_flash_ctrl_transaction_t transaction = {
+      .op = kDifFlashCtrlOpRead,
+      .partition_type = kDifFlashCtrlPartitionTypeData,
+      .byte_address = 0x2000,
+      .word_count = 5,
+  };
+
+  ExpectFifosEmpty();
+  ExpectStart(FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x2000, 5);
+  EXPECT_READ32(FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET, 0);
+  EXPECT_DIF_OK(dif_flash_ctrl_async_read_start(&dif_flash_ctrl_, &async_,
+                                                transaction, data));
+
+  // Read FIFO level interrupt with three words available.
+  ExpectOpDoneAck();
+  EXPECT_READ32(FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET,
+                {{FLASH_CTRL_CURR_FIFO_LVL_RD_OFFSET, 3}});
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_READ32(FLASH_CTRL_RD_FIFO_REG_OFFSET, 0x10 + i);
+  }
+  EXPECT_DIF_OK(dif_flash_ctrl_async_service(&dif_flash_ctrl_, &async_,
+                                             &output_, &done_));
+  EXPECT_FALSE(done_);
+
+  // Operation done interrupt: drain the rest.
+  ExpectOpDoneAck();
+  EXPECT_READ32(FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET,
+                {{FLASH_CTRL_CURR_FIFO_LVL_RD_OFFSET, 2}});
+  EXPECT_READ32(FLASH_CTRL_RD_FIFO_REG_OFFSET, 0x13);
+  EXPECT_READ32(FLASH_CTRL_RD_FIFO_REG_OFFSET, 0x14);
+  ExpectEnd(true);
+  EXPECT_DIF_OK(dif_flash_ctrl_async_service(&dif_flash_ctrl_, &async_,
+                                             &output_, &done_));
+  EXPECT_TRUE(done_);
+  for (uint32_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(data[i], 0x10 + i);
+  }
+}
+
 TEST_F(FlashCtrlTest, SuspendErase) {
   EXPECT_WRITE32(FLASH_CTRL_ERASE_SUSPEND_REG_OFFSET,
                  {
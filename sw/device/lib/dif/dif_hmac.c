@@ -118,21 +118,22 @@ dif_result_t dif_hmac_mode_hmac_start(const dif_hmac_t *hmac,
     }
   }
 
-  // Set HMAC to process in HMAC mode (not SHA256-only mode).
-  reg = bitfield_bit32_write(reg, HMAC_CFG_SHA_EN_BIT, true);
-  reg = bitfield_bit32_write(reg, HMAC_CFG_HMAC_EN_BIT, true);
-
-  // Set digest size to SHA-2 256 and 256-bit key
-  reg = bitfield_field32_write(reg, HMAC_CFG_DIGEST_SIZE_FIELD,
-                               HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_256);
-  reg = bitfield_field32_write(reg, HMAC_CFG_KEY_LENGTH_FIELD,
-                               HMAC_CFG_KEY_LENGTH_VALUE_KEY_256);
+  // Set HMAC to process in HMAC mode (not SHA256-only mode), with a SHA-2 256
+  // digest and a 256-bit key.
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_bit(update, HMAC_CFG_SHA_EN_BIT, true);
+  update = bitfield_update32_bit(update, HMAC_CFG_HMAC_EN_BIT, true);
+  update = bitfield_update32_field(update, HMAC_CFG_DIGEST_SIZE_FIELD,
+                                   HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_256);
+  update = bitfield_update32_field(update, HMAC_CFG_KEY_LENGTH_FIELD,
+                                   HMAC_CFG_KEY_LENGTH_VALUE_KEY_256);
+  reg = bitfield_update32_apply(reg, update);
 
   mmio_region_write32(hmac->base_addr, HMAC_CFG_REG_OFFSET, reg);
 
-  // Begin HMAC operation.
-  mmio_region_nonatomic_set_bit32(hmac->base_addr, HMAC_CMD_REG_OFFSET,
-                                  HMAC_CMD_HASH_START_BIT);
+  // Begin HMAC operation. CMD reads as zero, so there is nothing to preserve.
+  mmio_region_write32(hmac->base_addr, HMAC_CMD_REG_OFFSET,
+                      bitfield_bit32_write(0, HMAC_CMD_HASH_START_BIT, true));
   return kDifOk;
 }
 
@@ -148,22 +149,23 @@ dif_result_t dif_hmac_mode_sha256_start(const dif_hmac_t *hmac,
   // Set the byte-order of the input message and the digest.
   DIF_RETURN_IF_ERROR(dif_hmac_calculate_device_config_value(&reg, config));
 
-  // Set HMAC to process in SHA256-only mode (without HMAC mode).
-  reg = bitfield_bit32_write(reg, HMAC_CFG_SHA_EN_BIT, true);
-  reg = bitfield_bit32_write(reg, HMAC_CFG_HMAC_EN_BIT, false);
-
-  // Set digest size to SHA-2 256 and 256-bit key
-  reg = bitfield_field32_write(reg, HMAC_CFG_DIGEST_SIZE_FIELD,
-                               HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_256);
-  reg = bitfield_field32_write(reg, HMAC_CFG_KEY_LENGTH_FIELD,
-                               HMAC_CFG_KEY_LENGTH_VALUE_KEY_256);
+  // Set HMAC to process in SHA256-only mode (without HMAC mode), with a SHA-2
+  // 256 digest and a 256-bit key.
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_bit(update, HMAC_CFG_SHA_EN_BIT, true);
+  update = bitfield_update32_bit(update, HMAC_CFG_HMAC_EN_BIT, false);
+  update = bitfield_update32_field(update, HMAC_CFG_DIGEST_SIZE_FIELD,
+                                   HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_256);
+  update = bitfield_update32_field(update, HMAC_CFG_KEY_LENGTH_FIELD,
+                                   HMAC_CFG_KEY_LENGTH_VALUE_KEY_256);
+  reg = bitfield_update32_apply(reg, update);
 
   // Write new CFG register value.
   mmio_region_write32(hmac->base_addr, HMAC_CFG_REG_OFFSET, reg);
 
   // Begin SHA256-only operation.
-  mmio_region_nonatomic_set_bit32(hmac->base_addr, HMAC_CMD_REG_OFFSET,
-                                  HMAC_CMD_HASH_START_BIT);
+  mmio_region_write32(hmac->base_addr, HMAC_CMD_REG_OFFSET,
+                      bitfield_bit32_write(0, HMAC_CMD_HASH_START_BIT, true));
 
   return kDifOk;
 }
@@ -239,8 +241,8 @@ dif_result_t dif_hmac_process(const dif_hmac_t *hmac) {
     return kDifBadArg;
   }
 
-  mmio_region_nonatomic_set_bit32(hmac->base_addr, HMAC_CMD_REG_OFFSET,
-                                  HMAC_CMD_HASH_PROCESS_BIT);
+  mmio_region_write32(hmac->base_addr, HMAC_CMD_REG_OFFSET,
+                      bitfield_bit32_write(0, HMAC_CMD_HASH_PROCESS_BIT, true));
   return kDifOk;
 }
 
@@ -292,18 +294,15 @@ dif_result_t dif_hmac_finish(const dif_hmac_t *hmac, bool disable_after_done,
   if (disable_after_done) {
     // Disable HMAC and SHA256 until the next transaction, clearing the
     // current digest.
-    uint32_t device_config =
-        mmio_region_read32(hmac->base_addr, HMAC_CFG_REG_OFFSET);
-    device_config =
-        bitfield_bit32_write(device_config, HMAC_CFG_SHA_EN_BIT, false);
-    device_config =
-        bitfield_bit32_write(device_config, HMAC_CFG_HMAC_EN_BIT, false);
-    device_config =
-        bitfield_field32_write(device_config, HMAC_CFG_DIGEST_SIZE_FIELD,
-                               HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_NONE);
-    device_config =
-        bitfield_field32_write(device_config, HMAC_CFG_KEY_LENGTH_FIELD,
-                               HMAC_CFG_KEY_LENGTH_VALUE_KEY_256);
+    bitfield_update32_t update = {0};
+    update = bitfield_update32_bit(update, HMAC_CFG_SHA_EN_BIT, false);
+    update = bitfield_update32_bit(update, HMAC_CFG_HMAC_EN_BIT, false);
+    update = bitfield_update32_field(update, HMAC_CFG_DIGEST_SIZE_FIELD,
+                                     HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_NONE);
+    update = bitfield_update32_field(update, HMAC_CFG_KEY_LENGTH_FIELD,
+                                     HMAC_CFG_KEY_LENGTH_VALUE_KEY_256);
+    uint32_t device_config = bitfield_update32_apply(
+        mmio_region_read32(hmac->base_addr, HMAC_CFG_REG_OFFSET), update);
 
     mmio_region_write32(hmac->base_addr, HMAC_CFG_REG_OFFSET, device_config);
   }
@@ -76,7 +76,6 @@ class HmacMacTest : public HmacTest {
     EXPECT_READ32(HMAC_CFG_REG_OFFSET, 0);
     ExpectKey(kKey.data(), kKey.size());
     ExpectConfig();
-    EXPECT_READ32(HMAC_CMD_REG_OFFSET, 0);
     EXPECT_WRITE32(HMAC_CMD_REG_OFFSET, {{HMAC_CMD_HASH_START_BIT, true}});
 
     EXPECT_DIF_OK(dif_hmac_mode_hmac_start(&hmac_, kKey.data(), transaction_));
@@ -126,7 +125,6 @@ class HmacSha256Test : public HmacTest {
 TEST_F(HmacSha256Test, StartSuccess) {
   EXPECT_READ32(HMAC_CFG_REG_OFFSET, 0);
   ExpectConfig();
-  EXPECT_READ32(HMAC_CMD_REG_OFFSET, 0);
   EXPECT_WRITE32(HMAC_CMD_REG_OFFSET, {{HMAC_CMD_HASH_START_BIT, true}});
 
   EXPECT_DIF_OK(dif_hmac_mode_sha256_start(&hmac_, transaction_));
@@ -138,7 +136,6 @@ TEST_F(HmacSha256Test, StartMsgBigEndianSuccess) {
 
   EXPECT_READ32(HMAC_CFG_REG_OFFSET, 0);
   ExpectConfig();
-  EXPECT_READ32(HMAC_CMD_REG_OFFSET, 0);
   EXPECT_WRITE32(HMAC_CMD_REG_OFFSET, {{HMAC_CMD_HASH_START_BIT, true}});
 
   EXPECT_DIF_OK(dif_hmac_mode_sha256_start(&hmac_, transaction_));
@@ -150,7 +147,6 @@ TEST_F(HmacSha256Test, StartDigestLittleEndianSuccess) {
 
   EXPECT_READ32(HMAC_CFG_REG_OFFSET, 0);
   ExpectConfig();
-  EXPECT_READ32(HMAC_CMD_REG_OFFSET, 0);
   EXPECT_WRITE32(HMAC_CMD_REG_OFFSET, {{HMAC_CMD_HASH_START_BIT, true}});
 
   EXPECT_DIF_OK(dif_hmac_mode_sha256_start(&hmac_, transaction_));
@@ -177,7 +173,6 @@ class HmacProcessTest : public HmacTest {
 };
 
 TEST_F(HmacProcessTest, StartSuccess) {
-  EXPECT_READ32(HMAC_CMD_REG_OFFSET, 0);
   EXPECT_WRITE32(HMAC_CMD_REG_OFFSET, {{HMAC_CMD_HASH_PROCESS_BIT, true}});
   EXPECT_DIF_OK(dif_hmac_process(&hmac_));
 }
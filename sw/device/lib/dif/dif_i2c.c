@@ -784,6 +784,116 @@ dif_result_t dif_i2c_write_byte(const dif_i2c_t *i2c, uint8_t byte,
   return dif_i2c_write_byte_raw(i2c, byte, flags);
 }
 
+dif_result_t dif_i2c_txn_init(dif_i2c_txn_t *txn, uint32_t *entries,
+                              size_t capacity, uint8_t *rx_buf,
+                              size_t rx_capacity) {
+  if (txn == NULL || entries == NULL || capacity == 0 ||
+      (rx_buf == NULL && rx_capacity != 0)) {
+    return kDifBadArg;
+  }
+
+  *txn = (dif_i2c_txn_t){
+      .entries = entries,
+      .capacity = capacity,
+      .rx_buf = rx_buf,
+      .rx_capacity = rx_capacity,
+  };
+  return kDifOk;
+}
+
+/**
+ * Appends an encoded FMT FIFO entry to a transaction. The caller must have
+ * checked that there is space for it.
+ */
+static void txn_append(dif_i2c_txn_t *txn, uint8_t byte,
+                       dif_i2c_fmt_flags_t flags) {
+  uint32_t fmt_byte = 0;
+  // The callers only build valid flag combinations.
+  (void)parse_flags(flags, &fmt_byte);
+  txn->entries[txn->len++] =
+      bitfield_field32_write(fmt_byte, I2C_FDATA_FBYTE_FIELD, byte);
+}
+
+dif_result_t dif_i2c_txn_add_write(dif_i2c_txn_t *txn, uint8_t addr,
+                                   const uint8_t *data, size_t len, bool stop) {
+  if (txn == NULL || data == NULL || len == 0 || addr > 0x7f) {
+    return kDifBadArg;
+  }
+  if (txn->capacity - txn->len < len + 1) {
+    return kDifOutOfRange;
+  }
+
+  txn_append(txn, (uint8_t)(addr << 1), (dif_i2c_fmt_flags_t){.start = true});
+  for (size_t i = 0; i < len; ++i) {
+    txn_append(txn, data[i],
+               (dif_i2c_fmt_flags_t){.stop = stop && i == len - 1});
+  }
+  return kDifOk;
+}
+
+dif_result_t dif_i2c_txn_add_read(dif_i2c_txn_t *txn, uint8_t addr, size_t len,
+                                  bool stop) {
+  if (txn == NULL || len == 0 || addr > 0x7f) {
+    return kDifBadArg;
+  }
+  // Each read entry requests at most 256 bytes.
+  size_t num_reads = (len + 255) / 256;
+  if (txn->capacity - txn->len < num_reads + 1 ||
+      txn->rx_capacity - txn->rx_len < len) {
+    return kDifOutOfRange;
+  }
+
+  txn_append(txn, (uint8_t)(addr << 1 | 1),
+             (dif_i2c_fmt_flags_t){.start = true});
+  txn->rx_len += len;
+  while (len > 256) {
+    // A byte value of 0 requests 256 bytes. The last byte is ACK'd so that the
+    // next read entry can continue the transfer.
+    txn_append(txn, 0, (dif_i2c_fmt_flags_t){.read = true, .read_cont = true});
+    len -= 256;
+  }
+  txn_append(txn, (uint8_t)len,
+             (dif_i2c_fmt_flags_t){.read = true, .stop = stop});
+  return kDifOk;
+}
+
+dif_result_t dif_i2c_txn_service(const dif_i2c_t *i2c, dif_i2c_txn_t *txn,
+                                 bool *done) {
+  if (i2c == NULL || txn == NULL || done == NULL) {
+    return kDifBadArg;
+  }
+
+  uint32_t reg =
+      mmio_region_read32(i2c->base_addr, I2C_HOST_FIFO_STATUS_REG_OFFSET);
+  size_t fmt_level =
+      bitfield_field32_read(reg, I2C_HOST_FIFO_STATUS_FMTLVL_FIELD);
+  size_t rx_level =
+      bitfield_field32_read(reg, I2C_HOST_FIFO_STATUS_RXLVL_FIELD);
+
+  // Fill the free space of the FMT FIFO.
+  size_t fmt_free =
+      fmt_level < I2C_PARAM_FIFO_DEPTH ? I2C_PARAM_FIFO_DEPTH - fmt_level : 0;
+  size_t push_end = txn->len - txn->pushed < fmt_free ? txn->len
+                                                      : txn->pushed + fmt_free;
+  for (; txn->pushed < push_end; ++txn->pushed) {
+    mmio_region_write32(i2c->base_addr, I2C_FDATA_REG_OFFSET,
+                        txn->entries[txn->pushed]);
+  }
+
+  // Drain the RX FIFO.
+  size_t rx_end = txn->rx_len - txn->rx_received < rx_level
+                      ? txn->rx_len
+                      : txn->rx_received + rx_level;
+  for (; txn->rx_received < rx_end; ++txn->rx_received) {
+    reg = mmio_region_read32(i2c->base_addr, I2C_RDATA_REG_OFFSET);
+    txn->rx_buf[txn->rx_received] =
+        (uint8_t)bitfield_field32_read(reg, I2C_RDATA_RDATA_FIELD);
+  }
+
+  *done = txn->pushed == txn->len && txn->rx_received == txn->rx_len;
+  return kDifOk;
+}
+
 dif_result_t dif_i2c_transmit_byte(const dif_i2c_t *i2c, uint8_t byte) {
   if (i2c == NULL) {
     return kDifBadArg;
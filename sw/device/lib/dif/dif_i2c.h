@@ -827,6 +827,124 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_i2c_write_byte(const dif_i2c_t *i2c, uint8_t byte,
                                 dif_i2c_fmt_t code, bool suppress_nak_irq);
 
+/**
+ * A host-mode I2C transaction whose FMT FIFO entries are precomputed.
+ *
+ * A transaction is built up front with `dif_i2c_txn_add_write()` and
+ * `dif_i2c_txn_add_read()`, which encode every START, address, data, repeated
+ * START, read request and STOP into FMT FIFO entries. It is then executed with
+ * `dif_i2c_txn_service()`, which pushes entries in bursts sized to the free FMT
+ * FIFO space and drains the RX FIFO in bursts, with no status checks between
+ * individual entries.
+ *
+ * The fields of this struct are private and should only be modified through
+ * the `dif_i2c_txn_*()` functions.
+ */
+typedef struct dif_i2c_txn {
+  /**
+   * Encoded FMT FIFO entries.
+   */
+  uint32_t *entries;
+  /**
+   * Capacity of `entries`.
+   */
+  size_t capacity;
+  /**
+   * Number of entries built.
+   */
+  size_t len;
+  /**
+   * Number of entries pushed onto the FMT FIFO.
+   */
+  size_t pushed;
+  /**
+   * Buffer for bytes read by the transaction, in the order of the reads.
+   */
+  uint8_t *rx_buf;
+  /**
+   * Capacity of `rx_buf`.
+   */
+  size_t rx_capacity;
+  /**
+   * Number of bytes requested by the reads in the transaction.
+   */
+  size_t rx_len;
+  /**
+   * Number of bytes received.
+   */
+  size_t rx_received;
+} dif_i2c_txn_t;
+
+/**
+ * Initializes an empty I2C transaction.
+ *
+ * @param[out] txn The transaction to initialize.
+ * @param entries Storage for the encoded FMT FIFO entries.
+ * @param capacity The number of entries `entries` can hold.
+ * @param rx_buf Buffer for read data; may be `NULL` if `rx_capacity` is 0.
+ * @param rx_capacity The size of `rx_buf` in bytes.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_txn_init(dif_i2c_txn_t *txn, uint32_t *entries,
+                              size_t capacity, uint8_t *rx_buf,
+                              size_t rx_capacity);
+
+/**
+ * Appends a write to a target to an I2C transaction.
+ *
+ * Encodes a START (or repeated START) with the 7-bit target address, followed
+ * by `len` data bytes.
+ *
+ * @param txn The transaction.
+ * @param addr The 7-bit target address.
+ * @param data The bytes to write.
+ * @param len The number of bytes to write; must be non-zero.
+ * @param stop Whether to send a STOP after the last byte.
+ * @return `kDifOutOfRange` if `txn` does not have space for the entries, or
+ * the result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_txn_add_write(dif_i2c_txn_t *txn, uint8_t addr,
+                                   const uint8_t *data, size_t len, bool stop);
+
+/**
+ * Appends a read from a target to an I2C transaction.
+ *
+ * Encodes a START (or repeated START) with the 7-bit target address, followed
+ * by read requests of up to 256 bytes each. The read bytes are appended to the
+ * transaction's RX buffer.
+ *
+ * @param txn The transaction.
+ * @param addr The 7-bit target address.
+ * @param len The number of bytes to read; must be non-zero.
+ * @param stop Whether to send a STOP after the last byte.
+ * @return `kDifOutOfRange` if `txn` does not have space for the entries or the
+ * read data, or the result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_txn_add_read(dif_i2c_txn_t *txn, uint8_t addr, size_t len,
+                                  bool stop);
+
+/**
+ * Advances the execution of an I2C transaction without blocking.
+ *
+ * Reads the host FIFO levels once, pushes as many pending entries as fit in
+ * the FMT FIFO and pops every byte waiting in the RX FIFO. This is meant to be
+ * called from the FMT and RX threshold interrupt handlers, or in a loop, until
+ * `done` is set. Controller halt events are not checked; callers should
+ * handle the `kDifI2cIrqControllerHalt` interrupt as usual.
+ *
+ * @param i2c An I2C handle.
+ * @param txn The transaction.
+ * @param[out] done Set to true once all entries have been pushed and all read
+ * bytes have been received.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_txn_service(const dif_i2c_t *i2c, dif_i2c_txn_t *txn,
+                                 bool *done);
+
 /**
  * Pushes a byte into the TX FIFO to make it available when this I2C block
  * responds to an I2C Read as a target device.
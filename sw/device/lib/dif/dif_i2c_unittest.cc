@@ -992,6 +992,111 @@ TEST_F(FifoTest, TransmitBadArgs) {
   EXPECT_DIF_BADARG(dif_i2c_transmit_byte(nullptr, 0xff));
 }
 
+class TxnTest : public I2cTest {
+ protected:
+  uint32_t entries_[8];
+  uint8_t rx_buf_[4];
+  dif_i2c_txn_t txn_;
+};
+
+TEST_F(TxnTest, WriteRead) {
+  EXPECT_DIF_OK(dif_i2c_txn_init(&txn_, entries_, ARRAYSIZE(entries_), rx_buf_,
+                                 ARRAYSIZE(rx_buf_)));
+  const uint8_t reg_addr = 0x10;
+  EXPECT_DIF_OK(
+      dif_i2c_txn_add_write(&txn_, 0x50, &reg_addr, 1, /*stop=*/false));
+  EXPECT_DIF_OK(dif_i2c_txn_add_read(&txn_, 0x50, 3, /*stop=*/true));
+
+  // Only two FMT FIFO slots are free: push two entries.
+  EXPECT_READ32(I2C_HOST_FIFO_STATUS_REG_OFFSET,
+                {{I2C_HOST_FIFO_STATUS_FMTLVL_OFFSET, I2C_PARAM_FIFO_DEPTH - 2},
+                 {I2C_HOST_FIFO_STATUS_RXLVL_OFFSET, 0}});
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {
+                                           {I2C_FDATA_FBYTE_OFFSET, 0xa0},
+                                           {I2C_FDATA_START_BIT, 0x1},
+                                       });
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {
+                                           {I2C_FDATA_FBYTE_OFFSET, 0x10},
+                                       });
+  bool done;
+  EXPECT_DIF_OK(dif_i2c_txn_service(&i2c_, &txn_, &done));
+  EXPECT_FALSE(done);
+
+  // The rest of the entries fit; two bytes have been received.
+  EXPECT_READ32(I2C_HOST_FIFO_STATUS_REG_OFFSET,
+                {{I2C_HOST_FIFO_STATUS_FMTLVL_OFFSET, 0},
+                 {I2C_HOST_FIFO_STATUS_RXLVL_OFFSET, 2}});
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {
+                                           {I2C_FDATA_FBYTE_OFFSET, 0xa1},
+                                           {I2C_FDATA_START_BIT, 0x1},
+                                       });
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {
+                                           {I2C_FDATA_FBYTE_OFFSET, 3},
+                                           {I2C_FDATA_READB_BIT, 0x1},
+                                           {I2C_FDATA_STOP_BIT, 0x1},
+                                       });
+  EXPECT_READ32(I2C_RDATA_REG_OFFSET, 0x11);
+  EXPECT_READ32(I2C_RDATA_REG_OFFSET, 0x22);
+  EXPECT_DIF_OK(dif_i2c_txn_service(&i2c_, &txn_, &done));
+  EXPECT_FALSE(done);
+
+  EXPECT_READ32(I2C_HOST_FIFO_STATUS_REG_OFFSET,
+                {{I2C_HOST_FIFO_STATUS_FMTLVL_OFFSET, 0},
+                 {I2C_HOST_FIFO_STATUS_RXLVL_OFFSET, 1}});
+  EXPECT_READ32(I2C_RDATA_REG_OFFSET, 0x33);
+  EXPECT_DIF_OK(dif_i2c_txn_service(&i2c_, &txn_, &done));
+  EXPECT_TRUE(done);
+  EXPECT_EQ(rx_buf_[0], 0x11);
+  EXPECT_EQ(rx_buf_[1], 0x22);
+  EXPECT_EQ(rx_buf_[2], 0x33);
+}
+
+TEST_F(TxnTest, LongReadIsSplit) {
+  uint8_t rx_buf[300];
+  EXPECT_DIF_OK(dif_i2c_txn_init(&txn_, entries_, ARRAYSIZE(entries_), rx_buf,
+                                 sizeof(rx_buf)));
+  EXPECT_DIF_OK(
+      dif_i2c_txn_add_read(&txn_, 0x50, sizeof(rx_buf), /*stop=*/true));
+  ASSERT_EQ(txn_.len, 3);
+  EXPECT_EQ(txn_.entries[1], 1u << I2C_FDATA_READB_BIT |
+                                 1u << I2C_FDATA_RCONT_BIT);
+  EXPECT_EQ(txn_.entries[2], 1u << I2C_FDATA_READB_BIT |
+                                 1u << I2C_FDATA_STOP_BIT | (300 - 256));
+}
+
+TEST_F(TxnTest, OutOfRange) {
+  EXPECT_DIF_OK(dif_i2c_txn_init(&txn_, entries_, ARRAYSIZE(entries_), rx_buf_,
+                                 ARRAYSIZE(rx_buf_)));
+  uint8_t data[8] = {0};
+  EXPECT_EQ(dif_i2c_txn_add_write(&txn_, 0x50, data, sizeof(data), true),
+            kDifOutOfRange);
+  EXPECT_EQ(dif_i2c_txn_add_read(&txn_, 0x50, sizeof(rx_buf_) + 1, true),
+            kDifOutOfRange);
+  EXPECT_EQ(txn_.len, 0);
+}
+
+TEST_F(TxnTest, BadArgs) {
+  uint8_t data = 0;
+  bool done;
+  EXPECT_DIF_BADARG(dif_i2c_txn_init(nullptr, entries_, ARRAYSIZE(entries_),
+                                     rx_buf_, ARRAYSIZE(rx_buf_)));
+  EXPECT_DIF_BADARG(
+      dif_i2c_txn_init(&txn_, nullptr, 1, rx_buf_, ARRAYSIZE(rx_buf_)));
+  EXPECT_DIF_BADARG(dif_i2c_txn_init(&txn_, entries_, 1, nullptr, 1));
+  EXPECT_DIF_OK(dif_i2c_txn_init(&txn_, entries_, ARRAYSIZE(entries_), rx_buf_,
+                                 ARRAYSIZE(rx_buf_)));
+  EXPECT_DIF_BADARG(dif_i2c_txn_add_write(nullptr, 0x50, &data, 1, true));
+  EXPECT_DIF_BADARG(dif_i2c_txn_add_write(&txn_, 0x50, nullptr, 1, true));
+  EXPECT_DIF_BADARG(dif_i2c_txn_add_write(&txn_, 0x50, &data, 0, true));
+  EXPECT_DIF_BADARG(dif_i2c_txn_add_write(&txn_, 0x80, &data, 1, true));
+  EXPECT_DIF_BADARG(dif_i2c_txn_add_read(nullptr, 0x50, 1, true));
+  EXPECT_DIF_BADARG(dif_i2c_txn_add_read(&txn_, 0x50, 0, true));
+  EXPECT_DIF_BADARG(dif_i2c_txn_add_read(&txn_, 0x80, 1, true));
+  EXPECT_DIF_BADARG(dif_i2c_txn_service(nullptr, &txn_, &done));
+  EXPECT_DIF_BADARG(dif_i2c_txn_service(&i2c_, nullptr, &done));
+  EXPECT_DIF_BADARG(dif_i2c_txn_service(&i2c_, &txn_, nullptr));
+}
+
 class StretchTest : public I2cTest {};
 
 TEST_F(StretchTest, ConfigTimeouts) {
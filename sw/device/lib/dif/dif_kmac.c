@@ -108,20 +108,6 @@ static bool is_state_idle(const dif_kmac_t *kmac) {
   return bitfield_bit32_read(reg, KMAC_STATUS_SHA3_IDLE_BIT);
 }
 
-/**
- * Report whether the hardware is currently in the absorb state and accepting
- * writes to the message FIFO.
- *
- * Note that writes to the message FIFO may still block if it is full.
- *
- * @param kmac Handle.
- * @returns Whether the hardware is currently absorbing or not.
- */
-static bool is_state_absorb(const dif_kmac_t *kmac) {
-  uint32_t reg = mmio_region_read32(kmac->base_addr, KMAC_STATUS_REG_OFFSET);
-  return bitfield_bit32_read(reg, KMAC_STATUS_SHA3_ABSORB_BIT);
-}
-
 /**
  * Report whether the hardware is currently in the squeeze state which means
  * that the output state is valid and may be read by software.
@@ -199,16 +185,16 @@ dif_result_t dif_kmac_configure(dif_kmac_t *kmac, dif_kmac_config_t config) {
   }
 
   // Write entropy period register.
-  uint32_t entropy_period_reg = 0;
-  entropy_period_reg = bitfield_field32_write(
-      entropy_period_reg, KMAC_ENTROPY_PERIOD_WAIT_TIMER_FIELD,
+  bitfield_update32_t entropy_period = {0};
+  entropy_period = bitfield_update32_field(
+      entropy_period, KMAC_ENTROPY_PERIOD_WAIT_TIMER_FIELD,
       config.entropy_wait_timer);
-  entropy_period_reg = bitfield_field32_write(
-      entropy_period_reg, KMAC_ENTROPY_PERIOD_PRESCALER_FIELD,
+  entropy_period = bitfield_update32_field(
+      entropy_period, KMAC_ENTROPY_PERIOD_PRESCALER_FIELD,
       config.entropy_prescaler);
 
   mmio_region_write32(kmac->base_addr, KMAC_ENTROPY_PERIOD_REG_OFFSET,
-                      entropy_period_reg);
+                      bitfield_update32_apply(0, entropy_period));
 
   // Write threshold register.
   uint32_t entropy_threshold_reg =
@@ -223,27 +209,24 @@ dif_result_t dif_kmac_configure(dif_kmac_t *kmac, dif_kmac_config_t config) {
       entropy_threshold_reg);
 
   // Write configuration register.
-  uint32_t cfg_reg = 0;
-  cfg_reg = bitfield_bit32_write(cfg_reg, KMAC_CFG_SHADOWED_MSG_ENDIANNESS_BIT,
-                                 config.message_big_endian);
-  cfg_reg =
-      bitfield_bit32_write(cfg_reg, KMAC_CFG_SHADOWED_STATE_ENDIANNESS_BIT,
-                           config.output_big_endian);
-  cfg_reg = bitfield_field32_write(
-      cfg_reg, KMAC_CFG_SHADOWED_ENTROPY_MODE_FIELD, entropy_mode_value);
-  cfg_reg =
-      bitfield_bit32_write(cfg_reg, KMAC_CFG_SHADOWED_ENTROPY_FAST_PROCESS_BIT,
-                           config.entropy_fast_process);
-  cfg_reg = bitfield_bit32_write(cfg_reg, KMAC_CFG_SHADOWED_SIDELOAD_BIT,
-                                 config.sideload);
-  cfg_reg = bitfield_bit32_write(cfg_reg, KMAC_CFG_SHADOWED_ENTROPY_READY_BIT,
-                                 entropy_ready);
-
-  cfg_reg = bitfield_bit32_write(cfg_reg, KMAC_CFG_SHADOWED_MSG_MASK_BIT,
-                                 config.msg_mask);
+  bitfield_update32_t cfg = {0};
+  cfg = bitfield_update32_bit(cfg, KMAC_CFG_SHADOWED_MSG_ENDIANNESS_BIT,
+                              config.message_big_endian);
+  cfg = bitfield_update32_bit(cfg, KMAC_CFG_SHADOWED_STATE_ENDIANNESS_BIT,
+                              config.output_big_endian);
+  cfg = bitfield_update32_field(cfg, KMAC_CFG_SHADOWED_ENTROPY_MODE_FIELD,
+                                entropy_mode_value);
+  cfg = bitfield_update32_bit(cfg, KMAC_CFG_SHADOWED_ENTROPY_FAST_PROCESS_BIT,
+                              config.entropy_fast_process);
+  cfg = bitfield_update32_bit(cfg, KMAC_CFG_SHADOWED_SIDELOAD_BIT,
+                              config.sideload);
+  cfg = bitfield_update32_bit(cfg, KMAC_CFG_SHADOWED_ENTROPY_READY_BIT,
+                              entropy_ready);
+  cfg = bitfield_update32_bit(cfg, KMAC_CFG_SHADOWED_MSG_MASK_BIT,
+                              config.msg_mask);
 
   mmio_region_write32_shadowed(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET,
-                               cfg_reg);
+                               bitfield_update32_apply(0, cfg));
 
   // Write entropy seed registers.
   for (int i = 0; i < kDifKmacEntropySeedWords; ++i) {
@@ -317,12 +300,14 @@ dif_result_t dif_kmac_mode_sha3_start(
   operation_state->append_d = false;
 
   // Configure SHA-3 mode with the given strength.
-  uint32_t cfg_reg =
-      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
                                    kstrength);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_MODE_FIELD,
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_MODE_FIELD,
                                    KMAC_CFG_SHADOWED_MODE_VALUE_SHA3);
+  uint32_t cfg_reg = bitfield_update32_apply(
+      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET),
+      update);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
 
@@ -367,12 +352,14 @@ dif_result_t dif_kmac_mode_shake_start(
   operation_state->offset = 0;
 
   // Configure SHAKE mode with the given strength.
-  uint32_t cfg_reg =
-      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
                                    kstrength);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_MODE_FIELD,
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_MODE_FIELD,
                                    KMAC_CFG_SHADOWED_MODE_VALUE_SHAKE);
+  uint32_t cfg_reg = bitfield_update32_apply(
+      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET),
+      update);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
 
@@ -433,12 +420,14 @@ dif_result_t dif_kmac_mode_cshake_start(
   operation_state->offset = 0;
 
   // Configure cSHAKE mode with the given strength.
-  uint32_t cfg_reg =
-      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
                                    kstrength);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_MODE_FIELD,
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_MODE_FIELD,
                                    KMAC_CFG_SHADOWED_MODE_VALUE_CSHAKE);
+  uint32_t cfg_reg = bitfield_update32_apply(
+      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET),
+      update);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
 
@@ -551,13 +540,15 @@ dif_result_t dif_kmac_mode_kmac_start(
   }
 
   // Configure cSHAKE mode with the given strength and enable KMAC mode.
-  uint32_t cfg_reg =
-      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET);
-  cfg_reg = bitfield_bit32_write(cfg_reg, KMAC_CFG_SHADOWED_KMAC_EN_BIT, true);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_bit(update, KMAC_CFG_SHADOWED_KMAC_EN_BIT, true);
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD,
                                    kstrength);
-  cfg_reg = bitfield_field32_write(cfg_reg, KMAC_CFG_SHADOWED_MODE_FIELD,
+  update = bitfield_update32_field(update, KMAC_CFG_SHADOWED_MODE_FIELD,
                                    KMAC_CFG_SHADOWED_MODE_VALUE_CSHAKE);
+  uint32_t cfg_reg = bitfield_update32_apply(
+      mmio_region_read32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET),
+      update);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
   mmio_region_write32(kmac->base_addr, KMAC_CFG_SHADOWED_REG_OFFSET, cfg_reg);
 
@@ -636,25 +627,29 @@ dif_result_t dif_kmac_absorb(const dif_kmac_t *kmac,
     return kDifError;
   }
 
-  // Poll until the status register is in the 'absorb' state.
-  if (!is_state_absorb(kmac)) {
+  // A single status read serves both to check that the hardware is in the
+  // 'absorb' state and to size the first burst.
+  uint32_t reg = mmio_region_read32(kmac->base_addr, KMAC_STATUS_REG_OFFSET);
+  if (!bitfield_bit32_read(reg, KMAC_STATUS_SHA3_ABSORB_BIT)) {
     return kDifError;
   }
 
-  // Copy message using aligned word sized loads and stores where possible to
-  // improve performance. Note: the parts of the message copied a byte at a time
-  // will not be byte swapped in big-endian mode.
   const unsigned char *data = (const unsigned char *)msg;
-  dif_kmac_status_t status;
   while (len > 0) {
-    // Read the status register.
-    DIF_RETURN_IF_ERROR(dif_kmac_get_status(kmac, &status));
-
     // Calculate the remaining space in the message FIFO based on the
     // `FIFO_DEPTH` status field.
-    size_t free_entries = (KMAC_PARAM_NUM_ENTRIES_MSG_FIFO - status.fifo_depth);
+    size_t fifo_depth =
+        bitfield_field32_read(reg, KMAC_STATUS_FIFO_DEPTH_FIELD);
+    size_t free_entries = fifo_depth < KMAC_PARAM_NUM_ENTRIES_MSG_FIFO
+                              ? KMAC_PARAM_NUM_ENTRIES_MSG_FIFO - fifo_depth
+                              : 0;
     size_t max_len = free_entries * KMAC_PARAM_NUM_BYTES_MSG_FIFO_ENTRY;
     size_t write_len = (len < max_len) ? len : max_len;
+    if (write_len != 0 && write_len < len) {
+      // End the burst on a word boundary so that only the first and the last
+      // bursts need byte writes for an unaligned message.
+      write_len -= (size_t)misalignment32_of((uintptr_t)(data + write_len));
+    }
     msg_fifo_write(kmac, data, write_len);
     data += write_len;
     len -= write_len;
@@ -665,6 +660,10 @@ dif_result_t dif_kmac_absorb(const dif_kmac_t *kmac,
       *processed = write_len;
       break;
     }
+
+    if (len > 0) {
+      reg = mmio_region_read32(kmac->base_addr, KMAC_STATUS_REG_OFFSET);
+    }
   }
 
   return kDifOk;
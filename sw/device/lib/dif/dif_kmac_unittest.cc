@@ -582,11 +582,8 @@ TEST_F(AbsorbalignmentMessage, Success) {
     uint8_t *pMsg = &buffer[i];
     std::copy(kMsg.begin(), kMsg.end(), pMsg);
 
-    // First status read: checks for absorb bit.
-    EXPECT_READ32(KMAC_STATUS_REG_OFFSET, 1 << KMAC_STATUS_SHA3_ABSORB_BIT);
-
-    // Second status read: checks FIFO depth. Always return 0 (i.e. 0 entries
-    // occupied, FIFO is completely free).
+    // A single status read checks for the absorb bit and the FIFO depth.
+    // Always return 0 (i.e. 0 entries occupied, FIFO is completely free).
     EXPECT_READ32(KMAC_STATUS_REG_OFFSET, 1 << KMAC_STATUS_SHA3_ABSORB_BIT);
     ExpectMessageInt32(pMsg, kMsg.size());
 
@@ -595,6 +592,37 @@ TEST_F(AbsorbalignmentMessage, Success) {
   }
 }
 
+TEST_F(AbsorbalignmentMessage, BurstsStayAligned) {
+  // The FIFO has room for a single entry at a time, so the message is written
+  // in several bursts. Only the first and the last one use byte writes.
+  static_assert(KMAC_PARAM_NUM_BYTES_MSG_FIFO_ENTRY % sizeof(uint32_t) == 0,
+                "FIFO entries must hold whole words.");
+  constexpr size_t kEntry = KMAC_PARAM_NUM_BYTES_MSG_FIFO_ENTRY;
+  const uint32_t kOneFree = (1 << KMAC_STATUS_SHA3_ABSORB_BIT) |
+                            ((KMAC_PARAM_NUM_ENTRIES_MSG_FIFO - 1)
+                             << KMAC_STATUS_FIFO_DEPTH_OFFSET);
+
+  alignas(uint32_t) uint8_t buffer[3 * kEntry + 1];
+  for (size_t i = 0; i < sizeof(buffer); ++i) {
+    buffer[i] = static_cast<uint8_t>(i);
+  }
+  const uint8_t *msg = &buffer[1];
+  const size_t len = sizeof(buffer) - 1;
+
+  size_t offset = 0;
+  while (offset < len) {
+    EXPECT_READ32(KMAC_STATUS_REG_OFFSET, kOneFree);
+    size_t chunk = len - offset;
+    if (chunk > kEntry) {
+      chunk = kEntry - ((uintptr_t)&msg[offset + kEntry]) % sizeof(uint32_t);
+    }
+    ExpectMessageInt32(&msg[offset], chunk);
+    offset += chunk;
+  }
+
+  EXPECT_DIF_OK(dif_kmac_absorb(&kmac_, &op_state_, msg, len, nullptr));
+}
+
 class ConfigLock : public KmacTest {};
 
 TEST_F(ConfigLock, Locked) {
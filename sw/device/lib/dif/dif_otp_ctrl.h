@@ -719,6 +719,155 @@ dif_result_t dif_otp_ctrl_read_blocking(const dif_otp_ctrl_t *otp,
                                         uint32_t address, uint32_t *buf,
                                         size_t len);
 
+/**
+ * A multi-word read on the Direct Access Interface.
+ *
+ * The Direct Access Interface can only have one operation in flight. A batched
+ * read keeps it busy by collecting the result of one word and issuing the read
+ * of the next from the same `dif_otp_ctrl_dai_read_batch_service()` call.
+ *
+ * This struct should be treated as opaque by users.
+ */
+typedef struct dif_otp_ctrl_dai_read {
+  /**
+   * The partition being read.
+   */
+  dif_otp_ctrl_partition_t partition;
+  /**
+   * The partition-relative address of the read in flight.
+   */
+  uint32_t address;
+  /**
+   * Where the result of the read in flight is stored.
+   */
+  uint32_t *buf;
+  /**
+   * The number of 32-bit words left to collect, including the read in flight.
+   */
+  size_t words_left;
+} dif_otp_ctrl_dai_read_t;
+
+/**
+ * Starts a batched read of `len` 32-bit words on the Direct Access Interface.
+ *
+ * The same caveats for `dif_otp_ctrl_dai_read_start()` apply to `address`; in
+ * addition, the whole range must be in-range and, for secret partitions, `len`
+ * must be a whole number of 64-bit words. The results of 64-bit reads are
+ * stored least significant word first.
+ *
+ * The Direct Access Interface must be idle when this function is called. Once
+ * started, the read is advanced with `dif_otp_ctrl_dai_read_batch_service()`;
+ * `buf` must stay valid until it reports completion.
+ *
+ * @param otp An OTP handle.
+ * @param[out] read The batched read state.
+ * @param partition The partition to read from.
+ * @param address A partition-relative address to read from.
+ * @param[out] buf A buffer of words to write read values to.
+ * @param len The number of 32-bit words to read.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_otp_ctrl_dai_read_batch_start(
+    const dif_otp_ctrl_t *otp, dif_otp_ctrl_dai_read_t *read,
+    dif_otp_ctrl_partition_t partition, uint32_t address, uint32_t *buf,
+    size_t len);
+
+/**
+ * Advances a batched read on the Direct Access Interface.
+ *
+ * This function does not block. If the Direct Access Interface has finished
+ * the word in flight, its result is stored and the read of the next word is
+ * issued before returning.
+ *
+ * `kDifError` is returned if the Direct Access Interface reports an error; the
+ * cause can be retrieved with `dif_otp_ctrl_get_status()`.
+ *
+ * @param otp An OTP handle.
+ * @param read The batched read state.
+ * @param[out] done Set to true once all words have been read.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_otp_ctrl_dai_read_batch_service(const dif_otp_ctrl_t *otp,
+                                                 dif_otp_ctrl_dai_read_t *read,
+                                                 bool *done);
+
+/**
+ * A software copy of a whole partition.
+ *
+ * The copy is filled on first use and then serves reads without touching the
+ * hardware. It is not kept coherent with the OTP: it must be invalidated with
+ * `dif_otp_ctrl_partition_cache_invalidate()` after the partition has been
+ * programmed or digested.
+ *
+ * This struct should be treated as opaque by users.
+ */
+typedef struct dif_otp_ctrl_partition_cache {
+  /**
+   * The cached partition.
+   */
+  dif_otp_ctrl_partition_t partition;
+  /**
+   * Backing storage for the partition contents, including the digest.
+   */
+  uint32_t *buf;
+  /**
+   * Whether `buf` holds the current partition contents.
+   */
+  bool valid;
+} dif_otp_ctrl_partition_cache_t;
+
+/**
+ * Initializes an empty partition cache.
+ *
+ * `buf` must be large enough to hold the whole partition, including its
+ * digest.
+ *
+ * @param[out] cache The partition cache.
+ * @param partition The partition to cache.
+ * @param buf Backing storage for the cache.
+ * @param len The number of words in `buf`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_otp_ctrl_partition_cache_init(
+    dif_otp_ctrl_partition_cache_t *cache, dif_otp_ctrl_partition_t partition,
+    uint32_t *buf, size_t len);
+
+/**
+ * Reads `len` words, starting at `address`, from a partition cache.
+ *
+ * If the cache is not valid, the whole partition is read first: through the
+ * memory-mapped window for software partitions and through the Direct Access
+ * Interface for all others. In the latter case, the Direct Access Interface
+ * must be idle and this function blocks until the partition has been read.
+ *
+ * The same caveats for `dif_otp_ctrl_read_blocking()` apply to `address` and
+ * `len`.
+ *
+ * @param otp An OTP handle.
+ * @param cache The partition cache.
+ * @param address A partition-relative address to read from.
+ * @param[out] buf A buffer of words to write read values to.
+ * @param len The number of words to read.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_otp_ctrl_partition_cache_read(
+    const dif_otp_ctrl_t *otp, dif_otp_ctrl_partition_cache_t *cache,
+    uint32_t address, uint32_t *buf, size_t len);
+
+/**
+ * Invalidates a partition cache, so that the next read refills it.
+ *
+ * @param cache The partition cache.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_otp_ctrl_partition_cache_invalidate(
+    dif_otp_ctrl_partition_cache_t *cache);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -1231,5 +1231,188 @@ TEST_F(BlockingIoTest, NullArgs) {
       &otp_, kDifOtpCtrlPartitionOwnerSwCfg, 0x10, nullptr, buf.size()));
 }
 
+class DaiReadBatchTest : public OtpTest {
+ protected:
+  void ExpectIssue(uint32_t address) {
+    EXPECT_WRITE32(OTP_CTRL_DIRECT_ACCESS_ADDRESS_REG_OFFSET, address);
+    EXPECT_WRITE32(OTP_CTRL_DIRECT_ACCESS_CMD_REG_OFFSET,
+                   {{OTP_CTRL_DIRECT_ACCESS_CMD_RD_BIT, true}});
+  }
+};
+
+TEST_F(DaiReadBatchTest, Read32) {
+  ExpectIssue(OTP_CTRL_PARAM_HW_CFG0_OFFSET + 0x8);
+
+  dif_otp_ctrl_dai_read_t read;
+  std::vector<uint32_t> buf(2);
+  EXPECT_DIF_OK(dif_otp_ctrl_dai_read_batch_start(
+      &otp_, &read, kDifOtpCtrlPartitionHwCfg0, 0x8, buf.data(), buf.size()));
+
+  bool done;
+  EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET, 0);
+  EXPECT_DIF_OK(dif_otp_ctrl_dai_read_batch_service(&otp_, &read, &done));
+  EXPECT_FALSE(done);
+
+  EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET,
+                {{OTP_CTRL_STATUS_DAI_IDLE_BIT, true}});
+  EXPECT_READ32(OTP_CTRL_DIRECT_ACCESS_RDATA_0_REG_OFFSET, 0x11111111);
+  ExpectIssue(OTP_CTRL_PARAM_HW_CFG0_OFFSET + 0xc);
+  EXPECT_DIF_OK(dif_otp_ctrl_dai_read_batch_service(&otp_, &read, &done));
+  EXPECT_FALSE(done);
+
+  EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET,
+                {{OTP_CTRL_STATUS_DAI_IDLE_BIT, true}});
+  EXPECT_READ32(OTP_CTRL_DIRECT_ACCESS_RDATA_0_REG_OFFSET, 0x22222222);
+  EXPECT_DIF_OK(dif_otp_ctrl_dai_read_batch_service(&otp_, &read, &done));
+  EXPECT_TRUE(done);
+
+  EXPECT_THAT(buf, ElementsAre(0x11111111, 0x22222222));
+}
+
+TEST_F(DaiReadBatchTest, Read64) {
+  ExpectIssue(OTP_CTRL_PARAM_SECRET0_OFFSET + 0x8);
+
+  dif_otp_ctrl_dai_read_t read;
+  std::vector<uint32_t> buf(2);
+  EXPECT_DIF_OK(dif_otp_ctrl_dai_read_batch_start(
+      &otp_, &read, kDifOtpCtrlPartitionSecret0, 0x8, buf.data(), buf.size()));
+
+  bool done;
+  EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET,
+                {{OTP_CTRL_STATUS_DAI_IDLE_BIT, true}});
+  EXPECT_READ32(OTP_CTRL_DIRECT_ACCESS_RDATA_0_REG_OFFSET, 0x90abcdef);
+  EXPECT_READ32(OTP_CTRL_DIRECT_ACCESS_RDATA_1_REG_OFFSET, 0x12345678);
+  EXPECT_DIF_OK(dif_otp_ctrl_dai_read_batch_service(&otp_, &read, &done));
+  EXPECT_TRUE(done);
+
+  EXPECT_THAT(buf, ElementsAre(0x90abcdef, 0x12345678));
+}
+
+TEST_F(DaiReadBatchTest, Error) {
+  ExpectIssue(OTP_CTRL_PARAM_HW_CFG0_OFFSET);
+
+  dif_otp_ctrl_dai_read_t read;
+  std::vector<uint32_t> buf(1);
+  EXPECT_DIF_OK(dif_otp_ctrl_dai_read_batch_start(
+      &otp_, &read, kDifOtpCtrlPartitionHwCfg0, 0, buf.data(), buf.size()));
+
+  bool done;
+  EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET,
+                {{OTP_CTRL_STATUS_DAI_IDLE_BIT, true},
+                 {OTP_CTRL_STATUS_DAI_ERROR_BIT, true}});
+  EXPECT_EQ(dif_otp_ctrl_dai_read_batch_service(&otp_, &read, &done),
+            kDifError);
+}
+
+TEST_F(DaiReadBatchTest, BadRange) {
+  dif_otp_ctrl_dai_read_t read;
+  std::vector<uint32_t> buf(3);
+  EXPECT_EQ(dif_otp_ctrl_dai_read_batch_start(
+                &otp_, &read, kDifOtpCtrlPartitionSecret0, 0x4, buf.data(), 2),
+            kDifUnaligned);
+  EXPECT_EQ(dif_otp_ctrl_dai_read_batch_start(
+                &otp_, &read, kDifOtpCtrlPartitionSecret0, 0x8, buf.data(), 3),
+            kDifUnaligned);
+  EXPECT_EQ(dif_otp_ctrl_dai_read_batch_start(
+                &otp_, &read, kDifOtpCtrlPartitionHwCfg0,
+                OTP_CTRL_PARAM_HW_CFG0_SIZE - 0x4, buf.data(), 2),
+            kDifOutOfRange);
+}
+
+TEST_F(DaiReadBatchTest, NullArgs) {
+  dif_otp_ctrl_dai_read_t read;
+  std::vector<uint32_t> buf(1);
+  bool done;
+  EXPECT_DIF_BADARG(dif_otp_ctrl_dai_read_batch_start(
+      nullptr, &read, kDifOtpCtrlPartitionHwCfg0, 0, buf.data(), 1));
+  EXPECT_DIF_BADARG(dif_otp_ctrl_dai_read_batch_start(
+      &otp_, nullptr, kDifOtpCtrlPartitionHwCfg0, 0, buf.data(), 1));
+  EXPECT_DIF_BADARG(dif_otp_ctrl_dai_read_batch_start(
+      &otp_, &read, kDifOtpCtrlPartitionHwCfg0, 0, nullptr, 1));
+  EXPECT_DIF_BADARG(dif_otp_ctrl_dai_read_batch_start(
+      &otp_, &read, kDifOtpCtrlPartitionHwCfg0, 0, buf.data(), 0));
+  EXPECT_DIF_BADARG(
+      dif_otp_ctrl_dai_read_batch_service(nullptr, &read, &done));
+  EXPECT_DIF_BADARG(
+      dif_otp_ctrl_dai_read_batch_service(&otp_, nullptr, &done));
+  EXPECT_DIF_BADARG(
+      dif_otp_ctrl_dai_read_batch_service(&otp_, &read, nullptr));
+}
+
+class PartitionCacheTest : public OtpTest {
+ protected:
+  static constexpr size_t kWords =
+      OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE / sizeof(uint32_t);
+  std::vector<uint32_t> storage_ = std::vector<uint32_t>(kWords);
+  dif_otp_ctrl_partition_cache_t cache_;
+
+  void ExpectFill() {
+    for (size_t i = 0; i < kWords; ++i) {
+      auto offset = OTP_CTRL_PARAM_OWNER_SW_CFG_OFFSET + i * sizeof(uint32_t);
+      EXPECT_READ32(OTP_CTRL_SW_CFG_WINDOW_REG_OFFSET + offset, i);
+    }
+  }
+};
+
+TEST_F(PartitionCacheTest, FillsOnce) {
+  EXPECT_DIF_OK(dif_otp_ctrl_partition_cache_init(
+      &cache_, kDifOtpCtrlPartitionOwnerSwCfg, storage_.data(),
+      storage_.size()));
+
+  ExpectFill();
+  uint32_t val;
+  EXPECT_DIF_OK(dif_otp_ctrl_partition_cache_read(&otp_, &cache_, 0x10, &val,
+                                                  /*len=*/1));
+  EXPECT_EQ(val, 4);
+
+  // Served from the cache without touching the hardware.
+  std::vector<uint32_t> buf(2);
+  EXPECT_DIF_OK(dif_otp_ctrl_partition_cache_read(&otp_, &cache_, 0x20,
+                                                  buf.data(), buf.size()));
+  EXPECT_THAT(buf, ElementsAre(8, 9));
+}
+
+TEST_F(PartitionCacheTest, Invalidate) {
+  EXPECT_DIF_OK(dif_otp_ctrl_partition_cache_init(
+      &cache_, kDifOtpCtrlPartitionOwnerSwCfg, storage_.data(),
+      storage_.size()));
+
+  ExpectFill();
+  uint32_t val;
+  EXPECT_DIF_OK(
+      dif_otp_ctrl_partition_cache_read(&otp_, &cache_, 0x0, &val, 1));
+
+  EXPECT_DIF_OK(dif_otp_ctrl_partition_cache_invalidate(&cache_));
+  ExpectFill();
+  EXPECT_DIF_OK(
+      dif_otp_ctrl_partition_cache_read(&otp_, &cache_, 0x4, &val, 1));
+  EXPECT_EQ(val, 1);
+}
+
+TEST_F(PartitionCacheTest, BadArgs) {
+  EXPECT_DIF_BADARG(dif_otp_ctrl_partition_cache_init(
+      &cache_, kDifOtpCtrlPartitionOwnerSwCfg, storage_.data(), kWords - 1));
+  EXPECT_DIF_BADARG(dif_otp_ctrl_partition_cache_init(
+      nullptr, kDifOtpCtrlPartitionOwnerSwCfg, storage_.data(), kWords));
+  EXPECT_DIF_BADARG(dif_otp_ctrl_partition_cache_init(
+      &cache_, kDifOtpCtrlPartitionOwnerSwCfg, nullptr, kWords));
+
+  EXPECT_DIF_OK(dif_otp_ctrl_partition_cache_init(
+      &cache_, kDifOtpCtrlPartitionOwnerSwCfg, storage_.data(), kWords));
+  uint32_t val;
+  EXPECT_EQ(dif_otp_ctrl_partition_cache_read(&otp_, &cache_, 0x2, &val, 1),
+            kDifUnaligned);
+  EXPECT_EQ(dif_otp_ctrl_partition_cache_read(
+                &otp_, &cache_, OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE, &val, 1),
+            kDifOutOfRange);
+  EXPECT_DIF_BADARG(
+      dif_otp_ctrl_partition_cache_read(nullptr, &cache_, 0, &val, 1));
+  EXPECT_DIF_BADARG(
+      dif_otp_ctrl_partition_cache_read(&otp_, nullptr, 0, &val, 1));
+  EXPECT_DIF_BADARG(
+      dif_otp_ctrl_partition_cache_read(&otp_, &cache_, 0, nullptr, 1));
+  EXPECT_DIF_BADARG(dif_otp_ctrl_partition_cache_invalidate(nullptr));
+}
+
 }  // namespace
 }  // namespace dif_otp_ctrl_unittest
@@ -9,16 +9,10 @@
 
 #include "pattgen_regs.h"  // Generated.
 
-dif_result_t dif_pattgen_configure_channel(
-    const dif_pattgen_t *pattgen, dif_pattgen_channel_t channel,
-    dif_pattgen_channel_config_t config) {
-  if (pattgen == NULL || config.polarity >= kDifPattgenPolarityCount ||
-      config.seed_pattern_length == 0 || config.seed_pattern_length > 64 ||
-      config.num_pattern_repetitions == 0 ||
-      config.num_pattern_repetitions > 1024) {
-    return kDifBadArg;
-  }
-
+/**
+ * Register locations of a Pattern Generator channel.
+ */
+typedef struct channel_regs {
   bitfield_bit32_index_t enable_bit_idx;
   bitfield_bit32_index_t polarity_bit_idx;
   ptrdiff_t clock_divisor_reg_offset;
@@ -26,58 +20,158 @@ dif_result_t dif_pattgen_configure_channel(
   ptrdiff_t seed_upper_reg_offset;
   bitfield_field32_t seed_pattern_length_field;
   bitfield_field32_t num_pattern_repetitions_field;
-
+} channel_regs_t;
+
+/**
+ * Gets the register locations of a channel.
+ *
+ * @return False if `channel` is not a valid channel.
+ */
+static bool channel_regs_get(dif_pattgen_channel_t channel,
+                             channel_regs_t *regs) {
 #define DIF_PATTGEN_CHANNEL_CONFIG_CASE_(channel_)                          \
   case kDifPattgenChannel##channel_:                                        \
-    enable_bit_idx = PATTGEN_CTRL_ENABLE_CH##channel_##_BIT;                \
-    polarity_bit_idx = PATTGEN_CTRL_POLARITY_CH##channel_##_BIT;            \
-    clock_divisor_reg_offset = PATTGEN_PREDIV_CH##channel_##_REG_OFFSET;    \
-    seed_lower_reg_offset = PATTGEN_DATA_CH##channel_##_0_REG_OFFSET;       \
-    seed_upper_reg_offset = PATTGEN_DATA_CH##channel_##_1_REG_OFFSET;       \
-    seed_pattern_length_field = PATTGEN_SIZE_LEN_CH##channel_##_FIELD;      \
-    num_pattern_repetitions_field = PATTGEN_SIZE_REPS_CH##channel_##_FIELD; \
-    break;
+    *regs = (channel_regs_t){                                               \
+        .enable_bit_idx = PATTGEN_CTRL_ENABLE_CH##channel_##_BIT,           \
+        .polarity_bit_idx = PATTGEN_CTRL_POLARITY_CH##channel_##_BIT,       \
+        .clock_divisor_reg_offset =                                         \
+            PATTGEN_PREDIV_CH##channel_##_REG_OFFSET,                       \
+        .seed_lower_reg_offset = PATTGEN_DATA_CH##channel_##_0_REG_OFFSET,  \
+        .seed_upper_reg_offset = PATTGEN_DATA_CH##channel_##_1_REG_OFFSET,  \
+        .seed_pattern_length_field = PATTGEN_SIZE_LEN_CH##channel_##_FIELD, \
+        .num_pattern_repetitions_field =                                    \
+            PATTGEN_SIZE_REPS_CH##channel_##_FIELD,                         \
+    };                                                                      \
+    return true;
 
   switch (channel) {
     DIF_PATTGEN_CHANNEL_LIST(DIF_PATTGEN_CHANNEL_CONFIG_CASE_)
     default:
-      return kDifBadArg;
+      return false;
   }
 #undef DIF_PATTGEN_CHANNEL_CONFIG_CASE_
+}
+
+/**
+ * Checks the runtime configuration of a channel.
+ */
+static bool config_is_valid(const dif_pattgen_channel_config_t *config) {
+  return config->polarity < kDifPattgenPolarityCount &&
+         config->seed_pattern_length != 0 &&
+         config->seed_pattern_length <= 64 &&
+         config->num_pattern_repetitions != 0 &&
+         config->num_pattern_repetitions <= 1024;
+}
+
+/**
+ * Writes the clock divisor and seed registers of a channel.
+ */
+static void channel_data_write(const dif_pattgen_t *pattgen,
+                               const channel_regs_t *regs,
+                               const dif_pattgen_channel_config_t *config) {
+  // Set the clock divisor.
+  mmio_region_write32(pattgen->base_addr, regs->clock_divisor_reg_offset,
+                      config->clock_divisor);
+
+  // Write the seed data.
+  mmio_region_write32(pattgen->base_addr, regs->seed_lower_reg_offset,
+                      config->seed_pattern_lower_word);
+  if (config->seed_pattern_length > 31) {
+    mmio_region_write32(pattgen->base_addr, regs->seed_upper_reg_offset,
+                        config->seed_pattern_upper_word);
+  }
+}
+
+/**
+ * Updates the size and repetition fields of a channel in a SIZE value.
+ */
+static uint32_t size_reg_update(uint32_t size_reg, const channel_regs_t *regs,
+                                const dif_pattgen_channel_config_t *config) {
+  size_reg = bitfield_field32_write(size_reg, regs->seed_pattern_length_field,
+                                    config->seed_pattern_length - 1u);
+  return bitfield_field32_write(size_reg, regs->num_pattern_repetitions_field,
+                                config->num_pattern_repetitions - 1u);
+}
+
+dif_result_t dif_pattgen_configure_channel(
+    const dif_pattgen_t *pattgen, dif_pattgen_channel_t channel,
+    dif_pattgen_channel_config_t config) {
+  channel_regs_t regs;
+  if (pattgen == NULL || !config_is_valid(&config) ||
+      !channel_regs_get(channel, &regs)) {
+    return kDifBadArg;
+  }
 
   uint32_t ctrl_reg =
       mmio_region_read32(pattgen->base_addr, PATTGEN_CTRL_REG_OFFSET);
 
   // Check if channel is enabled. We cannot configure the channel if so.
-  if (bitfield_bit32_read(ctrl_reg, enable_bit_idx)) {
+  if (bitfield_bit32_read(ctrl_reg, regs.enable_bit_idx)) {
     return kDifError;
   }
 
   // Set the polarity.
-  ctrl_reg = bitfield_bit32_write(ctrl_reg, polarity_bit_idx, config.polarity);
+  ctrl_reg =
+      bitfield_bit32_write(ctrl_reg, regs.polarity_bit_idx, config.polarity);
   mmio_region_write32(pattgen->base_addr, PATTGEN_CTRL_REG_OFFSET, ctrl_reg);
 
-  // Set the clock divisor.
-  mmio_region_write32(pattgen->base_addr, clock_divisor_reg_offset,
-                      config.clock_divisor);
-
-  // Write the seed data.
-  mmio_region_write32(pattgen->base_addr, seed_lower_reg_offset,
-                      config.seed_pattern_lower_word);
-  if (config.seed_pattern_length > 31) {
-    mmio_region_write32(pattgen->base_addr, seed_upper_reg_offset,
-                        config.seed_pattern_upper_word);
-  }
+  channel_data_write(pattgen, &regs, &config);
 
   // Set the size and repetition values.
   uint32_t size_reg =
       mmio_region_read32(pattgen->base_addr, PATTGEN_SIZE_REG_OFFSET);
-  size_reg = bitfield_field32_write(size_reg, seed_pattern_length_field,
-                                    config.seed_pattern_length - 1);
-  size_reg = bitfield_field32_write(size_reg, num_pattern_repetitions_field,
-                                    config.num_pattern_repetitions - 1);
+  size_reg = size_reg_update(size_reg, &regs, &config);
+  mmio_region_write32(pattgen->base_addr, PATTGEN_SIZE_REG_OFFSET, size_reg);
+
+  return kDifOk;
+}
+
+dif_result_t dif_pattgen_configure_and_start_all(
+    const dif_pattgen_t *pattgen,
+    const dif_pattgen_channel_config_t configs[kDifPattgenChannelCount]) {
+  if (pattgen == NULL || configs == NULL) {
+    return kDifBadArg;
+  }
+  channel_regs_t regs[kDifPattgenChannelCount];
+  for (size_t i = 0; i < kDifPattgenChannelCount; ++i) {
+    if (!config_is_valid(&configs[i]) ||
+        !channel_regs_get((dif_pattgen_channel_t)i, &regs[i])) {
+      return kDifBadArg;
+    }
+  }
+
+  uint32_t ctrl_reg =
+      mmio_region_read32(pattgen->base_addr, PATTGEN_CTRL_REG_OFFSET);
+
+  // Check if any channel is enabled. We cannot configure the channels if so.
+  for (size_t i = 0; i < kDifPattgenChannelCount; ++i) {
+    if (bitfield_bit32_read(ctrl_reg, regs[i].enable_bit_idx)) {
+      return kDifError;
+    }
+  }
+
+  // Set the polarities of all channels in a single write.
+  for (size_t i = 0; i < kDifPattgenChannelCount; ++i) {
+    ctrl_reg = bitfield_bit32_write(ctrl_reg, regs[i].polarity_bit_idx,
+                                    configs[i].polarity);
+  }
+  mmio_region_write32(pattgen->base_addr, PATTGEN_CTRL_REG_OFFSET, ctrl_reg);
+
+  // The size and repetition values of all channels share the SIZE register,
+  // so it is written once and without reading it back first.
+  uint32_t size_reg = 0;
+  for (size_t i = 0; i < kDifPattgenChannelCount; ++i) {
+    channel_data_write(pattgen, &regs[i], &configs[i]);
+    size_reg = size_reg_update(size_reg, &regs[i], &configs[i]);
+  }
   mmio_region_write32(pattgen->base_addr, PATTGEN_SIZE_REG_OFFSET, size_reg);
 
+  // Start all channels in the same cycle.
+  for (size_t i = 0; i < kDifPattgenChannelCount; ++i) {
+    ctrl_reg = bitfield_bit32_write(ctrl_reg, regs[i].enable_bit_idx, true);
+  }
+  mmio_region_write32(pattgen->base_addr, PATTGEN_CTRL_REG_OFFSET, ctrl_reg);
+
   return kDifOk;
 }
 
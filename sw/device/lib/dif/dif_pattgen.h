@@ -46,6 +46,17 @@ typedef enum dif_pattgen_channel {
 
 #undef PATTGEN_CHANNEL_ENUM_INIT_
 
+#define PATTGEN_CHANNEL_COUNT_(channel_) +1
+
+enum {
+  /**
+   * Number of Pattern Generator channels.
+   */
+  kDifPattgenChannelCount = 0 DIF_PATTGEN_CHANNEL_LIST(PATTGEN_CHANNEL_COUNT_),
+};
+
+#undef PATTGEN_CHANNEL_COUNT_
+
 /**
  * The polarity of a Pattern Generator channel.
  */
@@ -130,6 +141,25 @@ dif_result_t dif_pattgen_configure_channel(const dif_pattgen_t *pattgen,
                                            dif_pattgen_channel_t channel,
                                            dif_pattgen_channel_config_t config);
 
+/**
+ * Configures all Pattern Generator channels and starts them together.
+ *
+ * Equivalent to calling `dif_pattgen_configure_channel()` and then
+ * `dif_pattgen_channel_set_enabled()` for each channel, but all channels are
+ * enabled by a single write, so that their outputs are phase-aligned. The size
+ * register shared by the channels is written once.
+ *
+ * Returns `kDifError` without writing anything if any channel is enabled.
+ *
+ * @param pattgen A Pattern Generator handle.
+ * @param configs Runtime configuration parameters, indexed by channel.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_pattgen_configure_and_start_all(
+    const dif_pattgen_t *pattgen,
+    const dif_pattgen_channel_config_t configs[kDifPattgenChannelCount]);
+
 /**
  * Sets the enablement state of a Pattern Generator channel.
  *
@@ -121,6 +121,56 @@ TEST_F(ConfigChannelTest, HalfSeedSuccess) {
       dif_pattgen_configure_channel(&pattgen_, kDifPattgenChannel1, config_));
 }
 
+class ConfigureAndStartAllTest : public PattgenTest {
+ protected:
+  ConfigureAndStartAllTest() {
+    configs_[0] = config_;
+    configs_[1] = config_;
+    configs_[1].polarity = kDifPattgenPolarityLow;
+    configs_[1].clock_divisor = 7;
+    configs_[1].seed_pattern_length = 16;
+    configs_[1].num_pattern_repetitions = 3;
+  }
+
+  dif_pattgen_channel_config_t configs_[kDifPattgenChannelCount];
+};
+
+TEST_F(ConfigureAndStartAllTest, BadArgs) {
+  EXPECT_DIF_BADARG(dif_pattgen_configure_and_start_all(nullptr, configs_));
+  EXPECT_DIF_BADARG(dif_pattgen_configure_and_start_all(&pattgen_, nullptr));
+
+  configs_[1].seed_pattern_length = 0;
+  EXPECT_DIF_BADARG(dif_pattgen_configure_and_start_all(&pattgen_, configs_));
+}
+
+TEST_F(ConfigureAndStartAllTest, ChannelEnabled) {
+  EXPECT_READ32(PATTGEN_CTRL_REG_OFFSET, {{PATTGEN_CTRL_ENABLE_CH1_BIT, 1}});
+  EXPECT_EQ(dif_pattgen_configure_and_start_all(&pattgen_, configs_),
+            kDifError);
+}
+
+TEST_F(ConfigureAndStartAllTest, Success) {
+  EXPECT_READ32(PATTGEN_CTRL_REG_OFFSET, 0);
+  EXPECT_WRITE32(PATTGEN_CTRL_REG_OFFSET, {{PATTGEN_CTRL_POLARITY_CH0_BIT, 1}});
+  EXPECT_WRITE32(PATTGEN_PREDIV_CH0_REG_OFFSET, configs_[0].clock_divisor);
+  EXPECT_WRITE32(PATTGEN_DATA_CH0_0_REG_OFFSET,
+                 configs_[0].seed_pattern_lower_word);
+  EXPECT_WRITE32(PATTGEN_DATA_CH0_1_REG_OFFSET,
+                 configs_[0].seed_pattern_upper_word);
+  EXPECT_WRITE32(PATTGEN_PREDIV_CH1_REG_OFFSET, configs_[1].clock_divisor);
+  EXPECT_WRITE32(PATTGEN_DATA_CH1_0_REG_OFFSET,
+                 configs_[1].seed_pattern_lower_word);
+  EXPECT_WRITE32(PATTGEN_SIZE_REG_OFFSET,
+                 {{PATTGEN_SIZE_LEN_CH0_OFFSET, 63},
+                  {PATTGEN_SIZE_REPS_CH0_OFFSET, 63},
+                  {PATTGEN_SIZE_LEN_CH1_OFFSET, 15},
+                  {PATTGEN_SIZE_REPS_CH1_OFFSET, 2}});
+  EXPECT_WRITE32(PATTGEN_CTRL_REG_OFFSET, {{PATTGEN_CTRL_POLARITY_CH0_BIT, 1},
+                                           {PATTGEN_CTRL_ENABLE_CH0_BIT, 1},
+                                           {PATTGEN_CTRL_ENABLE_CH1_BIT, 1}});
+  EXPECT_DIF_OK(dif_pattgen_configure_and_start_all(&pattgen_, configs_));
+}
+
 class ChannelSetEnabledTest : public PattgenTest {};
 
 TEST_F(ChannelSetEnabledTest, NullHandle) {
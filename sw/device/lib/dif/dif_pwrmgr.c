@@ -324,6 +324,38 @@ dif_result_t dif_pwrmgr_set_request_sources(
   return kDifOk;
 }
 
+dif_result_t dif_pwrmgr_configure_low_power(
+    const dif_pwrmgr_t *pwrmgr, dif_pwrmgr_request_sources_t wakeups,
+    dif_pwrmgr_domain_config_t config) {
+  request_reg_info_t reg_info = request_reg_infos[kDifPwrmgrReqTypeWakeup];
+  if (pwrmgr == NULL || !is_valid_for_bitfield(wakeups, reg_info.bitfield) ||
+      !is_valid_for_bitfield(config, kDomainConfigBitfield)) {
+    return kDifBadArg;
+  }
+
+  // Check both locks before writing anything so that a failure leaves the
+  // configuration untouched.
+  if (request_sources_is_locked(pwrmgr, kDifPwrmgrReqTypeWakeup) ||
+      control_register_is_locked(pwrmgr)) {
+    return kDifLocked;
+  }
+
+  mmio_region_write32(pwrmgr->base_addr, reg_info.sources_enable_reg_offset,
+                      bitfield_field32_write(0, reg_info.bitfield, wakeups));
+
+  // Domain config and the low power hint share the CONTROL register.
+  uint32_t reg_val =
+      mmio_region_read32(pwrmgr->base_addr, PWRMGR_CONTROL_REG_OFFSET);
+  reg_val = bitfield_field32_write(reg_val, kDomainConfigBitfield, config);
+  reg_val =
+      bitfield_bit32_write(reg_val, PWRMGR_CONTROL_LOW_POWER_HINT_BIT, true);
+  mmio_region_write32(pwrmgr->base_addr, PWRMGR_CONTROL_REG_OFFSET, reg_val);
+
+  sync_slow_clock_domain_polled(pwrmgr);
+
+  return kDifOk;
+}
+
 dif_result_t dif_pwrmgr_get_request_sources(
     const dif_pwrmgr_t *pwrmgr, dif_pwrmgr_req_type_t req_type,
     dif_pwrmgr_request_sources_t *sources) {
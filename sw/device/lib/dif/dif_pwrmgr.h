@@ -278,6 +278,27 @@ dif_result_t dif_pwrmgr_set_request_sources(
     const dif_pwrmgr_t *pwrmgr, dif_pwrmgr_req_type_t req_type,
     dif_pwrmgr_request_sources_t sources, dif_toggle_t sync_state);
 
+/**
+ * Prepares the power manager for entering low power state on the next WFI.
+ *
+ * Equivalent to `dif_pwrmgr_set_request_sources()` for wakeup requests,
+ * `dif_pwrmgr_set_domain_config()` and `dif_pwrmgr_low_power_set_enabled()`
+ * with low power enabled, but does a single read-modify-write of the control
+ * register and a single synchronization to the slow clock domain.
+ *
+ * Since the hardware clears the low power hint automatically, this function
+ * must be called before each transition to low power state.
+ *
+ * @param pwrmgr A power manager handle.
+ * @param wakeups Sources enabled for wakeup requests.
+ * @param config A domain configuration.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_pwrmgr_configure_low_power(
+    const dif_pwrmgr_t *pwrmgr, dif_pwrmgr_request_sources_t wakeups,
+    dif_pwrmgr_domain_config_t config);
+
 /**
  * Gets sources enabled for a request type.
  *
@@ -242,6 +242,71 @@ TEST_F(DomainConfig, Get) {
   }
 }
 
+class ConfigureLowPower : public DomainConfig {};
+
+TEST_F(ConfigureLowPower, BadArgs) {
+  EXPECT_DIF_BADARG(dif_pwrmgr_configure_low_power(nullptr, 0, 0));
+  EXPECT_DIF_BADARG(dif_pwrmgr_configure_low_power(&pwrmgr_, kBadSources, 0));
+  EXPECT_DIF_BADARG(dif_pwrmgr_configure_low_power(&pwrmgr_, 0, kBadConfig));
+}
+
+TEST_F(ConfigureLowPower, WakeupLocked) {
+  EXPECT_READ32(PWRMGR_WAKEUP_EN_REGWEN_REG_OFFSET,
+                AllOnesExcept(PWRMGR_WAKEUP_EN_REGWEN_EN_BIT));
+
+  EXPECT_EQ(dif_pwrmgr_configure_low_power(
+                &pwrmgr_, kDifPwrmgrWakeupRequestSourceOne, 0),
+            kDifLocked);
+}
+
+TEST_F(ConfigureLowPower, ControlLocked) {
+  EXPECT_READ32(PWRMGR_WAKEUP_EN_REGWEN_REG_OFFSET,
+                {{
+                    .offset = PWRMGR_WAKEUP_EN_REGWEN_EN_BIT,
+                    .value = 1,
+                }});
+  EXPECT_READ32(PWRMGR_CTRL_CFG_REGWEN_REG_OFFSET,
+                AllOnesExcept(PWRMGR_CTRL_CFG_REGWEN_EN_BIT));
+
+  EXPECT_EQ(dif_pwrmgr_configure_low_power(
+                &pwrmgr_, kDifPwrmgrWakeupRequestSourceOne, 0),
+            kDifLocked);
+}
+
+TEST_F(ConfigureLowPower, Configure) {
+  for (auto config : kConfigs) {
+    EXPECT_READ32(PWRMGR_WAKEUP_EN_REGWEN_REG_OFFSET,
+                  {{
+                      .offset = PWRMGR_WAKEUP_EN_REGWEN_EN_BIT,
+                      .value = 1,
+                  }});
+    EXPECT_READ32(PWRMGR_CTRL_CFG_REGWEN_REG_OFFSET,
+                  {{
+                      .offset = PWRMGR_CTRL_CFG_REGWEN_EN_BIT,
+                      .value = 1,
+                  }});
+    EXPECT_WRITE32(PWRMGR_WAKEUP_EN_REG_OFFSET,
+                   kDifPwrmgrWakeupRequestSourceTwo);
+    EXPECT_MASK32(PWRMGR_CONTROL_REG_OFFSET,
+                  {
+                      {
+                          .offset = kConfigBitfield.index,
+                          .mask = kConfigBitfield.mask,
+                          .value = config,
+                      },
+                      {
+                          .offset = PWRMGR_CONTROL_LOW_POWER_HINT_BIT,
+                          .mask = 1,
+                          .value = 1,
+                      },
+                  });
+    ExpectSync();
+
+    EXPECT_DIF_OK(dif_pwrmgr_configure_low_power(
+        &pwrmgr_, kDifPwrmgrWakeupRequestSourceTwo, config));
+  }
+}
+
 class RequestSources : public DifPwrmgrInitialized {
  protected:
   /**
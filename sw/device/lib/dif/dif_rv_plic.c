@@ -197,6 +197,45 @@ dif_result_t dif_rv_plic_irq_set_enabled(const dif_rv_plic_t *plic,
   return kDifOk;
 }
 
+dif_result_t dif_rv_plic_irq_range_set_enabled(const dif_rv_plic_t *plic,
+                                               dif_rv_plic_irq_id_t first_irq,
+                                               dif_rv_plic_irq_id_t last_irq,
+                                               dif_rv_plic_target_t target,
+                                               dif_toggle_t state) {
+  if (plic == NULL || first_irq > last_irq ||
+      last_irq >= RV_PLIC_PARAM_NUM_SRC || target >= RV_PLIC_PARAM_NUM_TARGET ||
+      !dif_is_valid_toggle(state)) {
+    return kDifBadArg;
+  }
+
+  bool flag = dif_toggle_to_bool(state);
+  dif_rv_plic_irq_id_t irq = first_irq;
+  while (irq <= last_irq) {
+    plic_reg_info_t reg_info = plic_irq_enable_reg_info(irq, target);
+
+    // Number of IRQs of the range that live in this register.
+    uint32_t count = RV_PLIC_PARAM_REG_WIDTH - reg_info.bit_index;
+    if (count > last_irq - irq + 1) {
+      count = last_irq - irq + 1;
+    }
+    uint32_t mask = count == RV_PLIC_PARAM_REG_WIDTH ? UINT32_MAX
+                                                     : (1u << count) - 1;
+    mask <<= reg_info.bit_index;
+
+    // Registers entirely covered by the range do not need to be read.
+    uint32_t reg = 0;
+    if (mask != UINT32_MAX) {
+      reg = mmio_region_read32(plic->base_addr, reg_info.offset);
+    }
+    reg = flag ? reg | mask : reg & ~mask;
+    mmio_region_write32(plic->base_addr, reg_info.offset, reg);
+
+    irq += count;
+  }
+
+  return kDifOk;
+}
+
 dif_result_t dif_rv_plic_irq_set_priority(const dif_rv_plic_t *plic,
                                           dif_rv_plic_irq_id_t irq,
                                           uint32_t priority) {
@@ -211,6 +250,23 @@ dif_result_t dif_rv_plic_irq_set_priority(const dif_rv_plic_t *plic,
   return kDifOk;
 }
 
+dif_result_t dif_rv_plic_irq_range_set_priority(const dif_rv_plic_t *plic,
+                                                dif_rv_plic_irq_id_t first_irq,
+                                                dif_rv_plic_irq_id_t last_irq,
+                                                uint32_t priority) {
+  if (plic == NULL || first_irq > last_irq ||
+      last_irq >= RV_PLIC_PARAM_NUM_SRC || priority > kDifRvPlicMaxPriority) {
+    return kDifBadArg;
+  }
+
+  for (dif_rv_plic_irq_id_t irq = first_irq; irq <= last_irq; ++irq) {
+    mmio_region_write32(plic->base_addr, plic_priority_reg_offset(irq),
+                        priority);
+  }
+
+  return kDifOk;
+}
+
 dif_result_t dif_rv_plic_target_set_threshold(const dif_rv_plic_t *plic,
                                               dif_rv_plic_target_t target,
                                               uint32_t threshold) {
@@ -268,6 +324,65 @@ dif_result_t dif_rv_plic_irq_complete(const dif_rv_plic_t *plic,
   return kDifOk;
 }
 
+dif_result_t dif_rv_plic_dispatch_init(dif_rv_plic_dispatch_t *dispatch,
+                                       dif_rv_plic_isr_entry_t *entries,
+                                       size_t len) {
+  if (dispatch == NULL || entries == NULL || len == 0) {
+    return kDifBadArg;
+  }
+
+  for (size_t i = 0; i < len; ++i) {
+    entries[i] = (dif_rv_plic_isr_entry_t){.isr = NULL, .context = NULL};
+  }
+  *dispatch = (dif_rv_plic_dispatch_t){.entries = entries, .len = len};
+
+  return kDifOk;
+}
+
+dif_result_t dif_rv_plic_dispatch_register(dif_rv_plic_dispatch_t *dispatch,
+                                           dif_rv_plic_irq_id_t irq,
+                                           dif_rv_plic_isr_t isr,
+                                           void *context) {
+  // IRQ ID 0 means "No Interrupt" and can never be claimed.
+  if (dispatch == NULL || irq == 0 || irq >= dispatch->len) {
+    return kDifBadArg;
+  }
+
+  dispatch->entries[irq] =
+      (dif_rv_plic_isr_entry_t){.isr = isr, .context = context};
+
+  return kDifOk;
+}
+
+dif_result_t dif_rv_plic_irq_dispatch(const dif_rv_plic_t *plic,
+                                      dif_rv_plic_target_t target,
+                                      const dif_rv_plic_dispatch_t *dispatch,
+                                      dif_rv_plic_irq_id_t *unhandled) {
+  if (plic == NULL || target >= RV_PLIC_PARAM_NUM_TARGET || dispatch == NULL) {
+    return kDifBadArg;
+  }
+
+  ptrdiff_t claim_complete_reg = plic_claim_complete_base_for_target(target);
+  while (true) {
+    dif_rv_plic_irq_id_t irq =
+        mmio_region_read32(plic->base_addr, claim_complete_reg);
+    if (irq == 0) {
+      return kDifOk;
+    }
+
+    if (irq >= dispatch->len || dispatch->entries[irq].isr == NULL) {
+      if (unhandled != NULL) {
+        *unhandled = irq;
+      }
+      return kDifError;
+    }
+
+    const dif_rv_plic_isr_entry_t *entry = &dispatch->entries[irq];
+    entry->isr(entry->context, irq);
+    mmio_region_write32(plic->base_addr, claim_complete_reg, irq);
+  }
+}
+
 dif_result_t dif_rv_plic_software_irq_force(const dif_rv_plic_t *plic,
                                             dif_rv_plic_target_t target) {
   if (plic == NULL || target >= RV_PLIC_PARAM_NUM_TARGET) {
@@ -18,6 +18,7 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/macros.h"
@@ -126,6 +127,27 @@ dif_result_t dif_rv_plic_irq_set_enabled(const dif_rv_plic_t *plic,
                                          dif_rv_plic_target_t target,
                                          dif_toggle_t state);
 
+/**
+ * Sets whether a contiguous range of interrupts is enabled or disabled.
+ *
+ * This is equivalent to calling `dif_rv_plic_irq_set_enabled()` for every
+ * interrupt between `first_irq` and `last_irq` (inclusive), but touches each
+ * Interrupt Enable register only once.
+ *
+ * @param plic A PLIC handle.
+ * @param first_irq The first interrupt of the range.
+ * @param last_irq The last interrupt of the range.
+ * @param target An interrupt target.
+ * @param state The new toggle state for the interrupts.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_rv_plic_irq_range_set_enabled(const dif_rv_plic_t *plic,
+                                               dif_rv_plic_irq_id_t first_irq,
+                                               dif_rv_plic_irq_id_t last_irq,
+                                               dif_rv_plic_target_t target,
+                                               dif_toggle_t state);
+
 /**
  * Sets IRQ source priority (0-3).
  *
@@ -143,6 +165,21 @@ dif_result_t dif_rv_plic_irq_set_priority(const dif_rv_plic_t *plic,
                                           dif_rv_plic_irq_id_t irq,
                                           uint32_t priority);
 
+/**
+ * Sets the priority of a contiguous range of IRQ sources.
+ *
+ * @param plic A PLIC handle.
+ * @param first_irq The first interrupt of the range.
+ * @param last_irq The last interrupt of the range.
+ * @param priority Priority to set.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_rv_plic_irq_range_set_priority(const dif_rv_plic_t *plic,
+                                                dif_rv_plic_irq_id_t first_irq,
+                                                dif_rv_plic_irq_id_t last_irq,
+                                                uint32_t priority);
+
 /**
  * Sets the target priority threshold.
  *
@@ -212,6 +249,100 @@ dif_result_t dif_rv_plic_irq_complete(const dif_rv_plic_t *plic,
                                       dif_rv_plic_target_t target,
                                       dif_rv_plic_irq_id_t complete_data);
 
+/**
+ * A handler for a single IRQ source.
+ *
+ * @param context The context registered with the handler.
+ * @param irq The claimed IRQ.
+ */
+typedef void (*dif_rv_plic_isr_t)(void *context, dif_rv_plic_irq_id_t irq);
+
+/**
+ * An entry of an IRQ dispatch table.
+ */
+typedef struct dif_rv_plic_isr_entry {
+  /**
+   * The handler, or NULL if the IRQ has none.
+   */
+  dif_rv_plic_isr_t isr;
+  /**
+   * Context passed to `isr`.
+   */
+  void *context;
+} dif_rv_plic_isr_entry_t;
+
+/**
+ * An IRQ dispatch table, indexed by IRQ ID.
+ *
+ * The entries are provided by the caller so that tables only need to cover
+ * the IRQ IDs that are actually in use.
+ *
+ * This struct should be treated as opaque by users.
+ */
+typedef struct dif_rv_plic_dispatch {
+  /**
+   * Table entries, indexed by IRQ ID.
+   */
+  dif_rv_plic_isr_entry_t *entries;
+  /**
+   * Number of entries in `entries`.
+   */
+  size_t len;
+} dif_rv_plic_dispatch_t;
+
+/**
+ * Initializes an IRQ dispatch table with no handlers.
+ *
+ * @param[out] dispatch The dispatch table.
+ * @param entries Storage for `len` table entries.
+ * @param len The number of entries; IRQ IDs up to `len - 1` can be handled.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_rv_plic_dispatch_init(dif_rv_plic_dispatch_t *dispatch,
+                                       dif_rv_plic_isr_entry_t *entries,
+                                       size_t len);
+
+/**
+ * Registers the handler of an IRQ in a dispatch table.
+ *
+ * Registering a NULL `isr` removes the handler of `irq`.
+ *
+ * @param dispatch The dispatch table.
+ * @param irq The IRQ to handle.
+ * @param isr The handler.
+ * @param context Context passed to `isr`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_rv_plic_dispatch_register(dif_rv_plic_dispatch_t *dispatch,
+                                           dif_rv_plic_irq_id_t irq,
+                                           dif_rv_plic_isr_t isr,
+                                           void *context);
+
+/**
+ * Services every IRQ pending for `target`.
+ *
+ * Repeatedly claims an IRQ, calls its handler and completes it, until the
+ * Claim/Complete register reads "No Interrupt". The PLIC hands out pending
+ * IRQs in priority order, so higher-priority IRQs are serviced first. This
+ * lets an interrupt handler service a burst of IRQs in a single trap.
+ *
+ * If an IRQ without a handler is claimed, it is left claimed, reported in
+ * `unhandled` and `kDifError` is returned.
+ *
+ * @param plic A PLIC handle.
+ * @param target Target to claim IRQs for.
+ * @param dispatch The dispatch table.
+ * @param[out] unhandled Optional out-param for the IRQ without a handler.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_rv_plic_irq_dispatch(const dif_rv_plic_t *plic,
+                                      dif_rv_plic_target_t target,
+                                      const dif_rv_plic_dispatch_t *dispatch,
+                                      dif_rv_plic_irq_id_t *unhandled);
+
 /**
  * Forces the software interrupt for a particular target.
  *
@@ -5,7 +5,9 @@
 #include "sw/device/lib/dif/dif_rv_plic.h"
 
 #include <array>
+#include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/base/mock_mmio.h"
@@ -170,6 +172,41 @@ TEST_F(IrqEnableSetTest, Target0Disable) {
   }
 }
 
+class IrqRangeEnableSetTest : public PlicTest {};
+
+TEST_F(IrqRangeEnableSetTest, BadArgs) {
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_enabled(nullptr, 1, 2, kTarget0,
+                                                      kDifToggleEnabled));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_enabled(&plic_, 2, 1, kTarget0,
+                                                      kDifToggleEnabled));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_enabled(
+      &plic_, 1, RV_PLIC_PARAM_NUM_SRC, kTarget0, kDifToggleEnabled));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_enabled(
+      &plic_, 1, 2, RV_PLIC_PARAM_NUM_TARGET, kDifToggleEnabled));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_enabled(
+      &plic_, 1, 2, kTarget0, static_cast<dif_toggle_t>(2)));
+}
+
+TEST_F(IrqRangeEnableSetTest, Enable) {
+  // IRQs 30 to 65 span the end of IE0_0, all of IE0_1 and the start of IE0_2.
+  EXPECT_READ32(RV_PLIC_IE0_0_REG_OFFSET, 0x1);
+  EXPECT_WRITE32(RV_PLIC_IE0_0_REG_OFFSET, 0xc0000001);
+  EXPECT_WRITE32(RV_PLIC_IE0_1_REG_OFFSET, 0xffffffff);
+  EXPECT_READ32(RV_PLIC_IE0_2_REG_OFFSET, 0x80000000);
+  EXPECT_WRITE32(RV_PLIC_IE0_2_REG_OFFSET, 0x80000003);
+
+  EXPECT_DIF_OK(dif_rv_plic_irq_range_set_enabled(&plic_, 30, 65, kTarget0,
+                                                  kDifToggleEnabled));
+}
+
+TEST_F(IrqRangeEnableSetTest, Disable) {
+  EXPECT_READ32(RV_PLIC_IE0_5_REG_OFFSET, 0x3ffffff);
+  EXPECT_WRITE32(RV_PLIC_IE0_5_REG_OFFSET, 0x3fffff1);
+
+  EXPECT_DIF_OK(dif_rv_plic_irq_range_set_enabled(&plic_, 161, 163, kTarget0,
+                                                  kDifToggleDisabled));
+}
+
 class IrqPrioritySetTest : public PlicTest {};
 
 TEST_F(IrqPrioritySetTest, NullArgs) {
@@ -193,6 +230,27 @@ TEST_F(IrqPrioritySetTest, Success) {
   }
 }
 
+TEST_F(IrqPrioritySetTest, RangeBadArgs) {
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_priority(nullptr, 1, 2,
+                                                       kDifRvPlicMaxPriority));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_priority(&plic_, 2, 1,
+                                                       kDifRvPlicMaxPriority));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_priority(
+      &plic_, 1, RV_PLIC_PARAM_NUM_SRC, kDifRvPlicMaxPriority));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_range_set_priority(
+      &plic_, 1, 2, kDifRvPlicMaxPriority + 1));
+}
+
+TEST_F(IrqPrioritySetTest, RangeSuccess) {
+  for (int i = 10; i <= 12; ++i) {
+    ptrdiff_t offset = RV_PLIC_PRIO0_REG_OFFSET + (sizeof(uint32_t) * i);
+    EXPECT_WRITE32(offset, kDifRvPlicMaxPriority);
+  }
+
+  EXPECT_DIF_OK(dif_rv_plic_irq_range_set_priority(&plic_, 10, 12,
+                                                   kDifRvPlicMaxPriority));
+}
+
 class TargetThresholdSetTest : public PlicTest {};
 
 TEST_F(TargetThresholdSetTest, NullArgs) {
@@ -297,6 +355,80 @@ TEST_F(IrqCompleteTest, Target0Success) {
   }
 }
 
+class IrqDispatchTest : public PlicTest {
+ protected:
+  static void Record(void *context, dif_rv_plic_irq_id_t irq) {
+    static_cast<std::vector<dif_rv_plic_irq_id_t> *>(context)->push_back(irq);
+  }
+
+  void SetUp() override {
+    EXPECT_DIF_OK(dif_rv_plic_dispatch_init(&dispatch_, entries_.data(),
+                                            entries_.size()));
+  }
+
+  std::array<dif_rv_plic_isr_entry_t, 8> entries_;
+  dif_rv_plic_dispatch_t dispatch_;
+  std::vector<dif_rv_plic_irq_id_t> serviced_;
+};
+
+TEST_F(IrqDispatchTest, BadArgs) {
+  EXPECT_DIF_BADARG(dif_rv_plic_dispatch_init(nullptr, entries_.data(), 1));
+  EXPECT_DIF_BADARG(dif_rv_plic_dispatch_init(&dispatch_, nullptr, 1));
+  EXPECT_DIF_BADARG(dif_rv_plic_dispatch_init(&dispatch_, entries_.data(), 0));
+
+  EXPECT_DIF_BADARG(
+      dif_rv_plic_dispatch_register(nullptr, 1, &Record, &serviced_));
+  EXPECT_DIF_BADARG(
+      dif_rv_plic_dispatch_register(&dispatch_, 0, &Record, &serviced_));
+  EXPECT_DIF_BADARG(dif_rv_plic_dispatch_register(&dispatch_, entries_.size(),
+                                                  &Record, &serviced_));
+
+  EXPECT_DIF_BADARG(
+      dif_rv_plic_irq_dispatch(nullptr, kTarget0, &dispatch_, nullptr));
+  EXPECT_DIF_BADARG(dif_rv_plic_irq_dispatch(
+      &plic_, RV_PLIC_PARAM_NUM_TARGET, &dispatch_, nullptr));
+  EXPECT_DIF_BADARG(
+      dif_rv_plic_irq_dispatch(&plic_, kTarget0, nullptr, nullptr));
+}
+
+TEST_F(IrqDispatchTest, DrainsAllPending) {
+  EXPECT_DIF_OK(
+      dif_rv_plic_dispatch_register(&dispatch_, 3, &Record, &serviced_));
+  EXPECT_DIF_OK(
+      dif_rv_plic_dispatch_register(&dispatch_, 5, &Record, &serviced_));
+
+  EXPECT_READ32(RV_PLIC_CC0_REG_OFFSET, 5);
+  EXPECT_WRITE32(RV_PLIC_CC0_REG_OFFSET, 5);
+  EXPECT_READ32(RV_PLIC_CC0_REG_OFFSET, 3);
+  EXPECT_WRITE32(RV_PLIC_CC0_REG_OFFSET, 3);
+  EXPECT_READ32(RV_PLIC_CC0_REG_OFFSET, 0);
+
+  EXPECT_DIF_OK(
+      dif_rv_plic_irq_dispatch(&plic_, kTarget0, &dispatch_, nullptr));
+  EXPECT_THAT(serviced_, testing::ElementsAre(5, 3));
+}
+
+TEST_F(IrqDispatchTest, Unhandled) {
+  EXPECT_DIF_OK(
+      dif_rv_plic_dispatch_register(&dispatch_, 3, &Record, &serviced_));
+
+  EXPECT_READ32(RV_PLIC_CC0_REG_OFFSET, 3);
+  EXPECT_WRITE32(RV_PLIC_CC0_REG_OFFSET, 3);
+  EXPECT_READ32(RV_PLIC_CC0_REG_OFFSET, 4);
+
+  dif_rv_plic_irq_id_t unhandled;
+  EXPECT_EQ(dif_rv_plic_irq_dispatch(&plic_, kTarget0, &dispatch_, &unhandled),
+            kDifError);
+  EXPECT_EQ(unhandled, 4);
+  EXPECT_THAT(serviced_, testing::ElementsAre(3));
+
+  // IRQ IDs beyond the table have no handler either.
+  EXPECT_READ32(RV_PLIC_CC0_REG_OFFSET, 100);
+  EXPECT_EQ(dif_rv_plic_irq_dispatch(&plic_, kTarget0, &dispatch_, &unhandled),
+            kDifError);
+  EXPECT_EQ(unhandled, 100);
+}
+
 class SoftwareIrqForceTest : public PlicTest {
   static_assert(RV_PLIC_PARAM_NUM_TARGET == 1, "");
 };
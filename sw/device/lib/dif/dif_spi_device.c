@@ -757,6 +757,21 @@ dif_result_t dif_spi_device_read_flash_payload_buffer(
   return kDifOk;
 }
 
+dif_result_t dif_spi_device_get_flash_payload_buffer_offset(
+    dif_spi_device_handle_t *spi, uint32_t offset, size_t length,
+    uint32_t *mmio_offset) {
+  if (spi == NULL || mmio_offset == NULL) {
+    return kDifBadArg;
+  }
+  if (offset > kDifSpiDevicePayloadLen ||
+      length > kDifSpiDevicePayloadLen - offset) {
+    return kDifBadArg;
+  }
+  *mmio_offset = SPI_DEVICE_INGRESS_BUFFER_REG_OFFSET +
+                 kDifSpiDevicePayloadOffset + offset;
+  return kDifOk;
+}
+
 dif_result_t dif_spi_device_write_flash_buffer(
     dif_spi_device_handle_t *spi,
     dif_spi_device_flash_buffer_type_t buffer_type, uint32_t offset,
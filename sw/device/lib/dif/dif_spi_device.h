@@ -624,6 +624,30 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_spi_device_read_flash_payload_buffer(
     dif_spi_device_handle_t *spi, uint32_t offset, size_t length, uint8_t *buf);
 
+/**
+ * Get the location of data in the payload buffer associated with flash /
+ * passthrough modes.
+ *
+ * The payload buffer is part of the memory-mapped ingress buffer, so adding
+ * the returned offset to the spi_device base address lets a payload be
+ * consumed in place, e.g. handed to the SPI host or to the flash controller,
+ * instead of being copied out with `dif_spi_device_read_flash_payload_buffer()`
+ * first. The data only stays valid until the next command with a payload is
+ * uploaded.
+ *
+ * @param spi A handle to a spi device.
+ * @param offset The starting offset of the data in the payload buffer.
+ * @param length The length, in bytes, of the data.
+ * @param[out] mmio_offset The offset of the data from the spi_device base
+ * address.
+ * @return `kDifBadArg` if any pointers are NULL or the requested `offset` and
+ * `length` go beyond the payload buffer region. `kDifOk` otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_device_get_flash_payload_buffer_offset(
+    dif_spi_device_handle_t *spi, uint32_t offset, size_t length,
+    uint32_t *mmio_offset);
+
 /**
  * Write data to one of the memories associated with flash / passthrough modes.
  *
@@ -161,6 +161,10 @@ TEST_F(FlashTest, NullArgs) {
       nullptr, /*offset=*/0, /*length=*/1, &uint8_arg));
   EXPECT_DIF_BADARG(dif_spi_device_read_flash_payload_buffer(
       &spi_, /*offset=*/0, /*length=*/1, nullptr));
+  EXPECT_DIF_BADARG(dif_spi_device_get_flash_payload_buffer_offset(
+      nullptr, /*offset=*/0, /*length=*/1, &uint32_arg));
+  EXPECT_DIF_BADARG(dif_spi_device_get_flash_payload_buffer_offset(
+      &spi_, /*offset=*/0, /*length=*/1, nullptr));
   EXPECT_DIF_BADARG(dif_spi_device_write_flash_buffer(
       nullptr, kDifSpiDeviceFlashBufferTypeSfdp, /*offset=*/0, /*length=*/1,
       &uint8_arg));
@@ -670,6 +674,18 @@ TEST_F(FlashTest, MemoryOps) {
   }
 }
 
+TEST_F(FlashTest, PayloadBufferOffset) {
+  uint32_t mmio_offset;
+  EXPECT_DIF_OK(dif_spi_device_get_flash_payload_buffer_offset(
+      &spi_, /*offset=*/16, /*length=*/240, &mmio_offset));
+  EXPECT_EQ(mmio_offset, SPI_DEVICE_INGRESS_BUFFER_REG_OFFSET + 16);
+
+  EXPECT_DIF_BADARG(dif_spi_device_get_flash_payload_buffer_offset(
+      &spi_, /*offset=*/16, /*length=*/241, &mmio_offset));
+  EXPECT_DIF_BADARG(dif_spi_device_get_flash_payload_buffer_offset(
+      &spi_, /*offset=*/257, /*length=*/0, &mmio_offset));
+}
+
 TEST_F(FlashTest, CommandFilters) {
   dif_toggle_t toggle;
   EXPECT_READ32(SPI_DEVICE_CMD_FILTER_0_REG_OFFSET, 0xa5642301u);
@@ -58,14 +58,6 @@ static void spi_host_reset(const dif_spi_host_t *spi_host) {
       bitfield_bit32_write(0, SPI_HOST_CONTROL_SW_RST_BIT, false));
 }
 
-static void spi_host_enable(const dif_spi_host_t *spi_host, bool enable) {
-  uint32_t reg =
-      mmio_region_read32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
-  mmio_region_write32(
-      spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET,
-      bitfield_bit32_write(reg, SPI_HOST_CONTROL_SPIEN_BIT, enable));
-}
-
 dif_result_t dif_spi_host_configure(const dif_spi_host_t *spi_host,
                                     dif_spi_host_config_t config) {
   if (spi_host == NULL) {
@@ -82,29 +74,35 @@ dif_result_t dif_spi_host_configure(const dif_spi_host_t *spi_host,
   }
 
   spi_host_reset(spi_host);
-  uint32_t reg = 0;
-  reg =
-      bitfield_field32_write(reg, SPI_HOST_CONFIGOPTS_CLKDIV_0_FIELD, divider);
-  reg = bitfield_field32_write(reg, SPI_HOST_CONFIGOPTS_CSNIDLE_0_FIELD,
-                               config.chip_select.idle);
-  reg = bitfield_field32_write(reg, SPI_HOST_CONFIGOPTS_CSNTRAIL_0_FIELD,
-                               config.chip_select.trail);
-  reg = bitfield_field32_write(reg, SPI_HOST_CONFIGOPTS_CSNLEAD_0_FIELD,
-                               config.chip_select.lead);
-  reg = bitfield_bit32_write(reg, SPI_HOST_CONFIGOPTS_FULLCYC_0_BIT,
-                             config.full_cycle);
-  reg = bitfield_bit32_write(reg, SPI_HOST_CONFIGOPTS_CPHA_0_BIT, config.cpha);
-  reg = bitfield_bit32_write(reg, SPI_HOST_CONFIGOPTS_CPOL_0_BIT, config.cpol);
-  mmio_region_write32(spi_host->base_addr, SPI_HOST_CONFIGOPTS_REG_OFFSET, reg);
-
-  reg = mmio_region_read32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
-  reg = bitfield_field32_write(reg, SPI_HOST_CONTROL_TX_WATERMARK_FIELD,
-                               config.tx_watermark);
-  reg = bitfield_field32_write(reg, SPI_HOST_CONTROL_RX_WATERMARK_FIELD,
-                               config.rx_watermark);
-  mmio_region_write32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET, reg);
-
-  spi_host_enable(spi_host, true);
+  bitfield_update32_t opts = {0};
+  opts = bitfield_update32_field(opts, SPI_HOST_CONFIGOPTS_CLKDIV_0_FIELD,
+                                 divider);
+  opts = bitfield_update32_field(opts, SPI_HOST_CONFIGOPTS_CSNIDLE_0_FIELD,
+                                 config.chip_select.idle);
+  opts = bitfield_update32_field(opts, SPI_HOST_CONFIGOPTS_CSNTRAIL_0_FIELD,
+                                 config.chip_select.trail);
+  opts = bitfield_update32_field(opts, SPI_HOST_CONFIGOPTS_CSNLEAD_0_FIELD,
+                                 config.chip_select.lead);
+  opts = bitfield_update32_bit(opts, SPI_HOST_CONFIGOPTS_FULLCYC_0_BIT,
+                               config.full_cycle);
+  opts = bitfield_update32_bit(opts, SPI_HOST_CONFIGOPTS_CPHA_0_BIT,
+                               config.cpha);
+  opts = bitfield_update32_bit(opts, SPI_HOST_CONFIGOPTS_CPOL_0_BIT,
+                               config.cpol);
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_CONFIGOPTS_REG_OFFSET,
+                      bitfield_update32_apply(0, opts));
+
+  // Set the watermarks and enable the block in the same read-modify-write.
+  bitfield_update32_t control = {0};
+  control = bitfield_update32_field(
+      control, SPI_HOST_CONTROL_TX_WATERMARK_FIELD, config.tx_watermark);
+  control = bitfield_update32_field(
+      control, SPI_HOST_CONTROL_RX_WATERMARK_FIELD, config.rx_watermark);
+  control = bitfield_update32_bit(control, SPI_HOST_CONTROL_SPIEN_BIT, true);
+  uint32_t reg =
+      mmio_region_read32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET,
+                      bitfield_update32_apply(reg, control));
   return kDifOk;
 }
 
@@ -132,34 +130,58 @@ static void wait_ready(const dif_spi_host_t *spi_host) {
   } while (!ready);
 }
 
-static void wait_tx_fifo(const dif_spi_host_t *spi_host) {
+/**
+ * Waits for space in the transmit FIFO.
+ *
+ * @return The number of free TX FIFO entries, always non-zero.
+ */
+static uint32_t wait_tx_fifo(const dif_spi_host_t *spi_host) {
   uint32_t txqd;
   do {
     uint32_t reg =
         mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
     txqd = bitfield_field32_read(reg, SPI_HOST_STATUS_TXQD_FIELD);
   } while (txqd == SPI_HOST_PARAM_TX_DEPTH);
+  return SPI_HOST_PARAM_TX_DEPTH - txqd;
 }
 
-static void wait_rx_fifo(const dif_spi_host_t *spi_host) {
+/**
+ * Waits for data in the receive FIFO.
+ *
+ * @return The number of occupied RX FIFO entries, always non-zero.
+ */
+static uint32_t wait_rx_fifo(const dif_spi_host_t *spi_host) {
   uint32_t rxqd;
   do {
     uint32_t reg =
         mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
     rxqd = bitfield_field32_read(reg, SPI_HOST_STATUS_RXQD_FIELD);
   } while (rxqd == 0);
+  return rxqd;
+}
+
+/**
+ * Takes one TX FIFO entry from `credit`, polling STATUS only once the free
+ * space reported by the last poll has been used up.
+ */
+static inline void tx_fifo_take(const dif_spi_host_t *spi_host,
+                                uint32_t *credit) {
+  if (*credit == 0) {
+    *credit = wait_tx_fifo(spi_host);
+  }
+  *credit -= 1;
 }
 
 static inline void tx_fifo_write8(const dif_spi_host_t *spi_host,
-                                  uintptr_t srcaddr) {
+                                  uintptr_t srcaddr, uint32_t *credit) {
   uint8_t *src = (uint8_t *)srcaddr;
-  wait_tx_fifo(spi_host);
+  tx_fifo_take(spi_host, credit);
   mmio_region_write8(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET, *src);
 }
 
 static inline void tx_fifo_write32(const dif_spi_host_t *spi_host,
-                                   uintptr_t srcaddr) {
-  wait_tx_fifo(spi_host);
+                                   uintptr_t srcaddr, uint32_t *credit) {
+  tx_fifo_take(spi_host, credit);
   uint32_t val = read_32((const void *)srcaddr);
   mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET, val);
 }
@@ -171,23 +193,45 @@ dif_result_t dif_spi_host_fifo_write(const dif_spi_host_t *spi_host,
     return kDifBadArg;
   }
 
+  // Free TX FIFO entries left over from the last STATUS poll.
+  uint32_t credit = 0;
+
   // If the pointer starts mis-aligned, write until we are aligned.
   while (misalignment32_of(ptr) && len > 0) {
-    tx_fifo_write8(spi_host, ptr);
+    tx_fifo_write8(spi_host, ptr, &credit);
     ptr += 1;
     len -= 1;
   }
 
-  // Write complete 32-bit words to the fifo.
+  // Write complete 32-bit words to the fifo, four at a time while the FIFO is
+  // known to have room for them.
   while (len > 3) {
-    tx_fifo_write32(spi_host, ptr);
+    if (credit == 0) {
+      credit = wait_tx_fifo(spi_host);
+    }
+    if (len > 15 && credit > 3) {
+      mmio_region_t base = spi_host->base_addr;
+      uint32_t w0 = read_32((const void *)ptr);
+      uint32_t w1 = read_32((const void *)(ptr + 4));
+      uint32_t w2 = read_32((const void *)(ptr + 8));
+      uint32_t w3 = read_32((const void *)(ptr + 12));
+      mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, w0);
+      mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, w1);
+      mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, w2);
+      mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, w3);
+      credit -= 4;
+      ptr += 16;
+      len -= 16;
+      continue;
+    }
+    tx_fifo_write32(spi_host, ptr, &credit);
     ptr += 4;
     len -= 4;
   }
 
   // Clean up any leftover bytes.
   while (len > 0) {
-    tx_fifo_write8(spi_host, ptr);
+    tx_fifo_write8(spi_host, ptr, &credit);
     ptr += 1;
     len -= 1;
   }
@@ -231,6 +275,19 @@ static uint32_t dequeue_word(queue_t *queue) {
   return val;
 }
 
+/**
+ * Pops one word from the RX FIFO, polling STATUS only once the occupancy
+ * reported by the last poll has been drained.
+ */
+static inline uint32_t rx_fifo_read32(const dif_spi_host_t *spi_host,
+                                      uint32_t *avail) {
+  if (*avail == 0) {
+    *avail = wait_rx_fifo(spi_host);
+  }
+  *avail -= 1;
+  return mmio_region_read32(spi_host->base_addr, SPI_HOST_RXDATA_REG_OFFSET);
+}
+
 dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
                                     uint16_t len) {
   if (spi_host == NULL || (dst == NULL && len > 0)) {
@@ -241,14 +298,14 @@ dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
   // We always have to read from the RXFIFO as a 32-bit word.  We use a
   // two-word queue to handle destination and length mis-alignments.
   queue_t queue = {0};
+  // Occupied RX FIFO entries left over from the last STATUS poll.
+  uint32_t avail = 0;
 
   // If the buffer is misaligned, write a byte at a time until we reach
   // alignment.
   while (misalignment32_of(ptr) && len > 0) {
     if (queue.length < 1) {
-      wait_rx_fifo(spi_host);
-      enqueue_word(&queue, mmio_region_read32(spi_host->base_addr,
-                                              SPI_HOST_RXDATA_REG_OFFSET));
+      enqueue_word(&queue, rx_fifo_read32(spi_host, &avail));
     }
     uint8_t *p = (uint8_t *)ptr;
     *p = dequeue_byte(&queue);
@@ -257,11 +314,31 @@ dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
   }
 
   // While we can write complete words to memory, operate on 4 bytes at a time.
+  // When nothing is queued and the FIFO is known to hold enough data, copy four
+  // words at a time.
   while (len > 3) {
+    if (queue.length == 0 && len > 15) {
+      if (avail == 0) {
+        avail = wait_rx_fifo(spi_host);
+      }
+      if (avail > 3) {
+        mmio_region_t base = spi_host->base_addr;
+        uint32_t w0 = mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET);
+        uint32_t w1 = mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET);
+        uint32_t w2 = mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET);
+        uint32_t w3 = mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET);
+        write_32(w0, (void *)ptr);
+        write_32(w1, (void *)(ptr + 4));
+        write_32(w2, (void *)(ptr + 8));
+        write_32(w3, (void *)(ptr + 12));
+        avail -= 4;
+        ptr += 16;
+        len -= 16;
+        continue;
+      }
+    }
     if (queue.length < 4) {
-      wait_rx_fifo(spi_host);
-      enqueue_word(&queue, mmio_region_read32(spi_host->base_addr,
-                                              SPI_HOST_RXDATA_REG_OFFSET));
+      enqueue_word(&queue, rx_fifo_read32(spi_host, &avail));
     }
     write_32(dequeue_word(&queue), (void *)ptr);
     ptr += 4;
@@ -271,9 +348,7 @@ dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
   // Finish up any left over buffer a byte at a time.
   while (len > 0) {
     if (queue.length < 1) {
-      wait_rx_fifo(spi_host);
-      enqueue_word(&queue, mmio_region_read32(spi_host->base_addr,
-                                              SPI_HOST_RXDATA_REG_OFFSET));
+      enqueue_word(&queue, rx_fifo_read32(spi_host, &avail));
     }
     uint8_t *p = (uint8_t *)ptr;
     *p = dequeue_byte(&queue);
@@ -288,13 +363,17 @@ static void write_command_reg(const dif_spi_host_t *spi_host, uint16_t length,
                               dif_spi_host_width_t speed,
                               dif_spi_host_direction_t direction,
                               bool last_segment) {
-  uint32_t reg = 0;
-  reg = bitfield_field32_write(reg, SPI_HOST_COMMAND_LEN_FIELD, length - 1);
-  reg = bitfield_field32_write(reg, SPI_HOST_COMMAND_SPEED_FIELD, speed);
-  reg =
-      bitfield_field32_write(reg, SPI_HOST_COMMAND_DIRECTION_FIELD, direction);
-  reg = bitfield_bit32_write(reg, SPI_HOST_COMMAND_CSAAT_BIT, !last_segment);
-  mmio_region_write32(spi_host->base_addr, SPI_HOST_COMMAND_REG_OFFSET, reg);
+  bitfield_update32_t command = {0};
+  command =
+      bitfield_update32_field(command, SPI_HOST_COMMAND_LEN_FIELD, length - 1);
+  command =
+      bitfield_update32_field(command, SPI_HOST_COMMAND_SPEED_FIELD, speed);
+  command = bitfield_update32_field(command, SPI_HOST_COMMAND_DIRECTION_FIELD,
+                                    direction);
+  command =
+      bitfield_update32_bit(command, SPI_HOST_COMMAND_CSAAT_BIT, !last_segment);
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_COMMAND_REG_OFFSET,
+                      bitfield_update32_apply(0, command));
 }
 
 static void issue_opcode(const dif_spi_host_t *spi_host,
@@ -306,22 +385,28 @@ static void issue_opcode(const dif_spi_host_t *spi_host,
                     last_segment);
 }
 
-static void issue_address(const dif_spi_host_t *spi_host,
-                          dif_spi_host_segment_t *segment, bool last_segment) {
-  wait_tx_fifo(spi_host);
+/**
+ * Returns the TXDATA word for an address segment and its length in bytes.
+ */
+static uint32_t address_word(const dif_spi_host_segment_t *segment,
+                             uint16_t *length) {
   // The address appears on the wire in big-endian order.
   uint32_t address = bitfield_byteswap32(segment->address.address);
-  uint16_t length;
   if (segment->address.mode == kDifSpiHostAddrMode4b) {
-    length = 4;
-    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
-                        address);
+    *length = 4;
   } else {
-    length = 3;
+    *length = 3;
     address >>= 8;
-    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
-                        address);
   }
+  return address;
+}
+
+static void issue_address(const dif_spi_host_t *spi_host,
+                          dif_spi_host_segment_t *segment, bool last_segment) {
+  wait_tx_fifo(spi_host);
+  uint16_t length;
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                      address_word(segment, &length));
   write_command_reg(spi_host, length, segment->address.width,
                     kDifSpiHostDirectionTx, last_segment);
 }
@@ -555,3 +640,274 @@ dif_result_t dif_spi_host_wait_until_idle(const dif_spi_host_t *spi_host) {
 
   return kDifOk;
 }
+
+/**
+ * Issues the command of the next segment of an asynchronous transaction.
+ *
+ * Transmit data is written separately by `async_tx_step()`.
+ */
+static void async_issue_command(const dif_spi_host_t *spi_host,
+                                dif_spi_host_async_t *async) {
+  dif_spi_host_segment_t *segment = &async->segments[async->cmd_index];
+  bool last_segment = async->cmd_index == async->length - 1;
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeOpcode:
+      write_command_reg(spi_host, 1, segment->opcode.width,
+                        kDifSpiHostDirectionTx, last_segment);
+      break;
+    case kDifSpiHostSegmentTypeAddress: {
+      uint16_t length;
+      address_word(segment, &length);
+      write_command_reg(spi_host, length, segment->address.width,
+                        kDifSpiHostDirectionTx, last_segment);
+      break;
+    }
+    case kDifSpiHostSegmentTypeDummy:
+      issue_dummy(spi_host, segment, last_segment);
+      break;
+    case kDifSpiHostSegmentTypeTx:
+      write_command_reg(spi_host, (uint16_t)segment->tx.length,
+                        segment->tx.width, kDifSpiHostDirectionTx,
+                        last_segment);
+      break;
+    case kDifSpiHostSegmentTypeBidirectional:
+      write_command_reg(spi_host, (uint16_t)segment->bidir.length,
+                        segment->bidir.width, kDifSpiHostDirectionBidirectional,
+                        last_segment);
+      break;
+    case kDifSpiHostSegmentTypeRx:
+      write_command_reg(spi_host, (uint16_t)segment->rx.length,
+                        segment->rx.width, kDifSpiHostDirectionRx,
+                        last_segment);
+      break;
+    default:
+      // Segment types are validated by `dif_spi_host_async_start`.
+      break;
+  }
+  ++async->cmd_index;
+}
+
+/**
+ * Skips segments of an asynchronous transaction that have no transmit data.
+ */
+static void async_tx_skip(dif_spi_host_async_t *async) {
+  while (async->tx_index < async->length) {
+    dif_spi_host_segment_type_t type = async->segments[async->tx_index].type;
+    if (type == kDifSpiHostSegmentTypeOpcode ||
+        type == kDifSpiHostSegmentTypeAddress ||
+        type == kDifSpiHostSegmentTypeTx ||
+        type == kDifSpiHostSegmentTypeBidirectional) {
+      return;
+    }
+    ++async->tx_index;
+  }
+}
+
+/**
+ * Writes one TX FIFO entry of an asynchronous transaction.
+ *
+ * Data segments are written in the same byte / word pattern as
+ * `dif_spi_host_fifo_write()`.
+ */
+static void async_tx_step(const dif_spi_host_t *spi_host,
+                          dif_spi_host_async_t *async) {
+  dif_spi_host_segment_t *segment = &async->segments[async->tx_index];
+  const uint8_t *buf;
+  size_t length;
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeOpcode:
+      mmio_region_write8(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                         segment->opcode.opcode);
+      ++async->tx_index;
+      async_tx_skip(async);
+      return;
+    case kDifSpiHostSegmentTypeAddress: {
+      uint16_t unused;
+      mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                          address_word(segment, &unused));
+      ++async->tx_index;
+      async_tx_skip(async);
+      return;
+    }
+    case kDifSpiHostSegmentTypeTx:
+      buf = segment->tx.buf;
+      length = segment->tx.length;
+      break;
+    default:
+      buf = segment->bidir.txbuf;
+      length = segment->bidir.length;
+      break;
+  }
+
+  uintptr_t ptr = (uintptr_t)(buf + async->tx_offset);
+  if (misalignment32_of(ptr) || length - async->tx_offset < 4) {
+    mmio_region_write8(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                       *(const uint8_t *)ptr);
+    async->tx_offset += 1;
+  } else {
+    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                        read_32((const void *)ptr));
+    async->tx_offset += 4;
+  }
+  if (async->tx_offset == length) {
+    async->tx_offset = 0;
+    ++async->tx_index;
+    async_tx_skip(async);
+  }
+}
+
+/**
+ * Skips segments of an asynchronous transaction that have no receive data.
+ */
+static void async_rx_skip(dif_spi_host_async_t *async) {
+  while (async->rx_index < async->length) {
+    dif_spi_host_segment_type_t type = async->segments[async->rx_index].type;
+    if (type == kDifSpiHostSegmentTypeRx ||
+        type == kDifSpiHostSegmentTypeBidirectional) {
+      return;
+    }
+    ++async->rx_index;
+  }
+}
+
+/**
+ * Reads one RX FIFO entry of an asynchronous transaction.
+ *
+ * Each segment's data starts at a new RX FIFO word, so the unused bytes of
+ * the last word of a segment are discarded.
+ */
+static void async_rx_step(const dif_spi_host_t *spi_host,
+                          dif_spi_host_async_t *async) {
+  dif_spi_host_segment_t *segment = &async->segments[async->rx_index];
+  uint8_t *buf;
+  size_t length;
+  if (segment->type == kDifSpiHostSegmentTypeRx) {
+    buf = segment->rx.buf;
+    length = segment->rx.length;
+  } else {
+    buf = segment->bidir.rxbuf;
+    length = segment->bidir.length;
+  }
+
+  uint32_t word =
+      mmio_region_read32(spi_host->base_addr, SPI_HOST_RXDATA_REG_OFFSET);
+  uintptr_t ptr = (uintptr_t)(buf + async->rx_offset);
+  size_t remaining = length - async->rx_offset;
+  if (!misalignment32_of(ptr) && remaining >= 4) {
+    write_32(word, (void *)ptr);
+    async->rx_offset += 4;
+  } else {
+    size_t count = remaining < 4 ? remaining : 4;
+    for (size_t i = 0; i < count; ++i) {
+      buf[async->rx_offset++] = (uint8_t)word;
+      word >>= 8;
+    }
+  }
+  if (async->rx_offset == length) {
+    async->rx_offset = 0;
+    ++async->rx_index;
+    async_rx_skip(async);
+  }
+}
+
+static const dif_spi_host_events_t kAsyncEvents =
+    kDifSpiHostEvtReady | kDifSpiHostEvtTxWm | kDifSpiHostEvtRxWm |
+    kDifSpiHostEvtIdle;
+
+dif_result_t dif_spi_host_async_start(const dif_spi_host_t *spi_host,
+                                      dif_spi_host_async_t *async,
+                                      uint32_t csid,
+                                      dif_spi_host_segment_t *segments,
+                                      size_t length) {
+  if (spi_host == NULL || async == NULL || (segments == NULL && length > 0)) {
+    return kDifBadArg;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    switch (segments[i].type) {
+      case kDifSpiHostSegmentTypeOpcode:
+      case kDifSpiHostSegmentTypeAddress:
+      case kDifSpiHostSegmentTypeDummy:
+      case kDifSpiHostSegmentTypeTx:
+      case kDifSpiHostSegmentTypeRx:
+      case kDifSpiHostSegmentTypeBidirectional:
+        break;
+      default:
+        return kDifBadArg;
+    }
+  }
+
+  *async = (dif_spi_host_async_t){
+      .segments = segments,
+      .length = length,
+  };
+  async_tx_skip(async);
+  async_rx_skip(async);
+
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_CSID_REG_OFFSET, csid);
+  bool done;
+  return dif_spi_host_async_service(spi_host, async, &done);
+}
+
+dif_result_t dif_spi_host_async_service(const dif_spi_host_t *spi_host,
+                                        dif_spi_host_async_t *async,
+                                        bool *done) {
+  if (spi_host == NULL || async == NULL || done == NULL) {
+    return kDifBadArg;
+  }
+
+  uint32_t status;
+  bool progress;
+  do {
+    progress = false;
+    status =
+        mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
+
+    // The command queue accepts a new command whenever READY is set.
+    if (async->cmd_index < async->length &&
+        bitfield_bit32_read(status, SPI_HOST_STATUS_READY_BIT)) {
+      async_issue_command(spi_host, async);
+      progress = true;
+    }
+
+    // Spend the FIFO levels sampled above without polling STATUS again.
+    uint32_t credit = SPI_HOST_PARAM_TX_DEPTH -
+                      bitfield_field32_read(status, SPI_HOST_STATUS_TXQD_FIELD);
+    for (; credit > 0 && async->tx_index < async->length; --credit) {
+      async_tx_step(spi_host, async);
+      progress = true;
+    }
+    uint32_t avail = bitfield_field32_read(status, SPI_HOST_STATUS_RXQD_FIELD);
+    for (; avail > 0 && async->rx_index < async->length; --avail) {
+      async_rx_step(spi_host, async);
+      progress = true;
+    }
+  } while (progress);
+
+  // Only wait for the events that can unblock the remaining work. IDLE
+  // signals the end of the transaction and flushes a final partial RX
+  // watermark.
+  dif_spi_host_events_t events = kDifSpiHostEvtIdle;
+  if (async->cmd_index < async->length) {
+    events |= kDifSpiHostEvtReady;
+  }
+  if (async->tx_index < async->length) {
+    events |= kDifSpiHostEvtTxWm;
+  }
+  if (async->rx_index < async->length) {
+    events |= kDifSpiHostEvtRxWm;
+  }
+  *done = async->cmd_index == async->length &&
+          async->tx_index == async->length &&
+          async->rx_index == async->length &&
+          !bitfield_bit32_read(status, SPI_HOST_STATUS_ACTIVE_BIT);
+  if (*done) {
+    events = 0;
+  }
+
+  uint32_t reg =
+      mmio_region_read32(spi_host->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET);
+  reg = (reg & ~kAsyncEvents) | events;
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                      reg);
+  return kDifOk;
+}
@@ -463,6 +463,75 @@ dif_result_t dif_spi_host_get_error(const dif_spi_host_t *spi_host,
 OT_WARN_UNUSED_RESULT
 dif_result_t dif_spi_host_wait_until_idle(const dif_spi_host_t *spi_host);
 
+/**
+ * Progress of an asynchronous SPI Host transaction.
+ *
+ * The state is owned by the caller and, together with the segments and
+ * buffers it refers to, must remain valid until the transaction completes.
+ * The fields are private to the DIF.
+ */
+typedef struct dif_spi_host_async {
+  /** The segments of the transaction. */
+  dif_spi_host_segment_t *segments;
+  /** The number of segments in the transaction. */
+  size_t length;
+  /** Index of the next segment whose command has not been issued. */
+  size_t cmd_index;
+  /** Index of the segment whose transmit data is being written. */
+  size_t tx_index;
+  /** Number of transmit bytes already written for `tx_index`. */
+  size_t tx_offset;
+  /** Index of the segment whose receive data is being read. */
+  size_t rx_index;
+  /** Number of receive bytes already read for `rx_index`. */
+  size_t rx_offset;
+} dif_spi_host_async_t;
+
+/**
+ * Starts an asynchronous SPI Host transaction.
+ *
+ * Issues as many commands and moves as much data as the SPI Host can accept
+ * without waiting, then enables the `READY`, `TXWM`, `RXWM` and `IDLE` events
+ * that are needed to make further progress. The caller should enable the
+ * `spi_event` interrupt and call `dif_spi_host_async_service()` from its
+ * handler until the transaction completes.
+ *
+ * Only one transaction may be in flight at a time, and the blocking
+ * transaction functions must not be used while it is.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param[out] async Progress of the transaction.
+ * @param csid The chip-select ID of the SPI target.
+ * @param segments The SPI segments to send in this transaction.
+ * @param length The number of SPI segments in this transaction.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_async_start(const dif_spi_host_t *spi_host,
+                                      dif_spi_host_async_t *async,
+                                      uint32_t csid,
+                                      dif_spi_host_segment_t *segments,
+                                      size_t length);
+
+/**
+ * Advances an asynchronous SPI Host transaction.
+ *
+ * Never waits on the SPI Host. Issues pending commands, refills the transmit
+ * FIFO and drains the receive FIFO as far as the current FIFO levels allow,
+ * and updates the enabled events to match the remaining work. Once the
+ * transaction is complete the events enabled by `dif_spi_host_async_start()`
+ * are disabled again.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param async Progress of the transaction.
+ * @param[out] done Whether the transaction has completed.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_async_service(const dif_spi_host_t *spi_host,
+                                        dif_spi_host_async_t *async,
+                                        bool *done);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -139,8 +139,6 @@ TEST_F(ConfigTest, Default) {
                      {SPI_HOST_CONFIGOPTS_CPOL_0_BIT, false},
                  });
 
-  EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET, 0);
   EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
   EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
                  {
@@ -181,8 +179,6 @@ TEST_F(ConfigTest, ClockRate) {
                      {SPI_HOST_CONFIGOPTS_CPOL_0_BIT, false},
                  });
   EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
   EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
                  {
                      {SPI_HOST_CONTROL_SPIEN_BIT, true},
@@ -210,8 +206,6 @@ TEST_F(ConfigTest, ChipSelectOptions) {
                      {SPI_HOST_CONFIGOPTS_CPOL_0_BIT, false},
                  });
   EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
   EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
                  {
                      {SPI_HOST_CONTROL_SPIEN_BIT, true},
@@ -239,8 +233,6 @@ TEST_F(ConfigTest, SpiOptions) {
                      {SPI_HOST_CONFIGOPTS_CPOL_0_BIT, true},
                  });
   EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
   EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
                  {
                      {SPI_HOST_CONTROL_SPIEN_BIT, true},
@@ -268,12 +260,8 @@ TEST_F(ConfigTest, SpiTxRxWatermark) {
   EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
   EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
                  {{SPI_HOST_CONTROL_TX_WATERMARK_OFFSET, 0x7f},
-                  {SPI_HOST_CONTROL_RX_WATERMARK_OFFSET, 0x7e}});
-  EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET, 0);
-  EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
-                 {
-                     {SPI_HOST_CONTROL_SPIEN_BIT, true},
-                 });
+                  {SPI_HOST_CONTROL_RX_WATERMARK_OFFSET, 0x7e},
+                  {SPI_HOST_CONTROL_SPIEN_BIT, true}});
 
   EXPECT_DIF_OK(dif_spi_host_configure(&spi_host_, config_));
 }
@@ -463,7 +451,6 @@ TEST_F(FifoTest, AlignedWrite) {
 
   EXPECT_TXQD(0);
   EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 1);
-  EXPECT_TXQD(0);
   EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 2);
 
   EXPECT_DIF_OK(dif_spi_host_fifo_write(&spi_host_, buffer, sizeof(buffer)));
@@ -482,12 +469,11 @@ TEST_F(FifoTest, MisalignedWrite) {
   // dif_spi_host_fifo_write.
   Aligned<9, 4> buffer = {0, 1, 2, 3, 4, 5, 6, 7, 8};
 
-  // Because of the misalignment, expect three byte writes.
-  EXPECT_TXQD(0);
+  // Because of the misalignment, expect three byte writes. The FIFO only
+  // reports room for three entries, so it is polled again before the fourth.
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 3);
   EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 1);
-  EXPECT_TXQD(0);
   EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 2);
-  EXPECT_TXQD(0);
   EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 3);
 
   // Then a word write when we reach alignment.
@@ -495,7 +481,6 @@ TEST_F(FifoTest, MisalignedWrite) {
   EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x07060504);
 
   // Then a byte write to finish the buffer.
-  EXPECT_TXQD(0);
   EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 8);
 
   EXPECT_DIF_OK(dif_spi_host_fifo_write(&spi_host_, buffer.get() + 1, 8));
@@ -508,7 +493,6 @@ TEST_F(FifoTest, AlignedRead) {
 
   EXPECT_RXQD(2);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 1);
-  EXPECT_RXQD(1);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 2);
 
   EXPECT_DIF_OK(dif_spi_host_fifo_read(&spi_host_, buffer, sizeof(buffer)));
@@ -522,7 +506,7 @@ TEST_F(FifoTest, MisalignedRead) {
   // dif_spi_host_fifo_read.
   Aligned<9, 4> buffer{};
 
-  EXPECT_RXQD(2);
+  EXPECT_RXQD(1);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x04030201);
   EXPECT_RXQD(1);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x08070605);
@@ -531,6 +515,170 @@ TEST_F(FifoTest, MisalignedRead) {
   EXPECT_THAT(buffer.value, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8));
 }
 
+// Checks that aligned words are written in bursts of four while the transmit
+// FIFO has room for them.
+TEST_F(FifoTest, BurstWrite) {
+  uint32_t buffer[] = {1, 2, 3, 4, 5, 6};
+
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 5);
+  for (uint32_t word = 1; word <= 5; ++word) {
+    EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, word);
+  }
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 1);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 6);
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_write(&spi_host_, buffer, sizeof(buffer)));
+}
+
+// Checks that words are read in bursts of four while the receive FIFO holds
+// enough data.
+TEST_F(FifoTest, BurstRead) {
+  uint32_t buffer[6];
+
+  EXPECT_RXQD(2);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 1);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 2);
+  EXPECT_RXQD(4);
+  for (uint32_t word = 3; word <= 6; ++word) {
+    EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, word);
+  }
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_read(&spi_host_, buffer, sizeof(buffer)));
+  EXPECT_THAT(buffer, ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+class AsyncTest : public SpiHostTest {
+ protected:
+  dif_spi_host_async_t async_;
+};
+
+// Checks that arguments are validated.
+TEST_F(AsyncTest, NullArgs) {
+  dif_spi_host_segment segment;
+  segment.type = kDifSpiHostSegmentTypeDummy;
+  bool done;
+
+  EXPECT_DIF_BADARG(dif_spi_host_async_start(nullptr, &async_, 0, &segment, 1));
+  EXPECT_DIF_BADARG(
+      dif_spi_host_async_start(&spi_host_, nullptr, 0, &segment, 1));
+  EXPECT_DIF_BADARG(
+      dif_spi_host_async_start(&spi_host_, &async_, 0, nullptr, 1));
+
+  EXPECT_DIF_BADARG(dif_spi_host_async_service(nullptr, &async_, &done));
+  EXPECT_DIF_BADARG(dif_spi_host_async_service(&spi_host_, nullptr, &done));
+  EXPECT_DIF_BADARG(dif_spi_host_async_service(&spi_host_, &async_, nullptr));
+}
+
+// Checks that invalid segment types are rejected before touching the device.
+TEST_F(AsyncTest, BadSegmentType) {
+  dif_spi_host_segment segment;
+  segment.type = static_cast<dif_spi_host_segment_type_t>(42);
+
+  EXPECT_DIF_BADARG(
+      dif_spi_host_async_start(&spi_host_, &async_, 0, &segment, 1));
+}
+
+// Checks that a read transaction makes progress from the start call and the
+// event handler without waiting on the device.
+TEST_F(AsyncTest, OpcodeRead) {
+  uint32_t buffer[2];
+  dif_spi_host_segment segment[2];
+  segment[0].type = kDifSpiHostSegmentTypeOpcode;
+  segment[0].opcode.opcode = 0x03;
+  segment[0].opcode.width = kDifSpiHostWidthStandard;
+  segment[1].type = kDifSpiHostSegmentTypeRx;
+  segment[1].rx.width = kDifSpiHostWidthStandard;
+  segment[1].rx.buf = buffer;
+  segment[1].rx.length = sizeof(buffer);
+
+  // Start issues both commands and the opcode byte, then waits for data.
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 1);
+  EXPECT_READY(true);
+  EXPECT_COMMAND_REG(/*length=*/1, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/false);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 0x03);
+  EXPECT_READY(true);
+  EXPECT_COMMAND_REG(/*length=*/sizeof(buffer),
+                     /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionRx, /*last=*/true);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {{SPI_HOST_STATUS_ACTIVE_BIT, true}});
+  EXPECT_READ32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                {{SPI_HOST_EVENT_ENABLE_RXFULL_BIT, true}});
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                 {
+                     {SPI_HOST_EVENT_ENABLE_RXFULL_BIT, true},
+                     {SPI_HOST_EVENT_ENABLE_RXWM_BIT, true},
+                     {SPI_HOST_EVENT_ENABLE_IDLE_BIT, true},
+                 });
+  EXPECT_DIF_OK(dif_spi_host_async_start(&spi_host_, &async_, 1, segment,
+                                         ARRAYSIZE(segment)));
+
+  // The handler drains the RX FIFO and, once idle, disables its events.
+  EXPECT_RXQD(2);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 1);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 2);
+  EXPECT_RXQD(0);
+  EXPECT_READ32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                {
+                    {SPI_HOST_EVENT_ENABLE_RXFULL_BIT, true},
+                    {SPI_HOST_EVENT_ENABLE_RXWM_BIT, true},
+                    {SPI_HOST_EVENT_ENABLE_IDLE_BIT, true},
+                });
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                 {{SPI_HOST_EVENT_ENABLE_RXFULL_BIT, true}});
+  bool done;
+  EXPECT_DIF_OK(dif_spi_host_async_service(&spi_host_, &async_, &done));
+  EXPECT_TRUE(done);
+  EXPECT_THAT(buffer, ElementsAre(1, 2));
+}
+
+// Checks that transmit data is only written while the FIFO has room and that
+// the TXWM event is requested for the rest.
+TEST_F(AsyncTest, TransmitWaitsForSpace) {
+  uint32_t buffer[] = {1, 2};
+  dif_spi_host_segment segment;
+  segment.type = kDifSpiHostSegmentTypeTx;
+  segment.tx.width = kDifSpiHostWidthStandard;
+  segment.tx.buf = buffer;
+  segment.tx.length = sizeof(buffer);
+
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 0);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {
+                    {SPI_HOST_STATUS_READY_BIT, true},
+                    {SPI_HOST_STATUS_TXQD_OFFSET, SPI_HOST_PARAM_TX_DEPTH - 1},
+                });
+  EXPECT_COMMAND_REG(/*length=*/sizeof(buffer),
+                     /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/true);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 1);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {
+                    {SPI_HOST_STATUS_ACTIVE_BIT, true},
+                    {SPI_HOST_STATUS_TXQD_OFFSET, SPI_HOST_PARAM_TX_DEPTH},
+                });
+  EXPECT_READ32(SPI_HOST_EVENT_ENABLE_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                 {
+                     {SPI_HOST_EVENT_ENABLE_TXWM_BIT, true},
+                     {SPI_HOST_EVENT_ENABLE_IDLE_BIT, true},
+                 });
+  EXPECT_DIF_OK(dif_spi_host_async_start(&spi_host_, &async_, 0, &segment, 1));
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {{SPI_HOST_STATUS_ACTIVE_BIT, true}});
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 2);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {{SPI_HOST_STATUS_ACTIVE_BIT, true}});
+  EXPECT_READ32(SPI_HOST_EVENT_ENABLE_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                 {{SPI_HOST_EVENT_ENABLE_IDLE_BIT, true}});
+  bool done;
+  EXPECT_DIF_OK(dif_spi_host_async_service(&spi_host_, &async_, &done));
+  EXPECT_FALSE(done);
+}
+
 class EventEnableRegTest : public SpiHostTest {
  protected:
   static constexpr std::array<std::array<uint32_t, 2>, 6> kEventsMap{{
@@ -135,22 +135,19 @@ dif_result_t dif_uart_configure(const dif_uart_t *uart,
   uart_reset(uart);
 
   // Set baudrate, enable RX and TX, configure parity.
-  uint32_t reg = 0;
-  reg = bitfield_field32_write(reg, UART_CTRL_NCO_FIELD, nco_masked);
-  reg = bitfield_field32_write(reg, UART_CTRL_RXBLVL_FIELD, rxblvl);
-  if (dif_toggle_to_bool(config.tx_enable)) {
-    reg = bitfield_bit32_write(reg, UART_CTRL_TX_BIT, true);
-  }
-  if (dif_toggle_to_bool(config.rx_enable)) {
-    reg = bitfield_bit32_write(reg, UART_CTRL_RX_BIT, true);
-  }
-  if (config.parity_enable == kDifToggleEnabled) {
-    reg = bitfield_bit32_write(reg, UART_CTRL_PARITY_EN_BIT, true);
-  }
-  if (config.parity == kDifUartParityOdd) {
-    reg = bitfield_bit32_write(reg, UART_CTRL_PARITY_ODD_BIT, true);
-  }
-  mmio_region_write32(uart->base_addr, UART_CTRL_REG_OFFSET, reg);
+  bitfield_update32_t ctrl = {0};
+  ctrl = bitfield_update32_field(ctrl, UART_CTRL_NCO_FIELD, nco_masked);
+  ctrl = bitfield_update32_field(ctrl, UART_CTRL_RXBLVL_FIELD, rxblvl);
+  ctrl = bitfield_update32_bit(ctrl, UART_CTRL_TX_BIT,
+                               dif_toggle_to_bool(config.tx_enable));
+  ctrl = bitfield_update32_bit(ctrl, UART_CTRL_RX_BIT,
+                               dif_toggle_to_bool(config.rx_enable));
+  ctrl = bitfield_update32_bit(ctrl, UART_CTRL_PARITY_EN_BIT,
+                               config.parity_enable == kDifToggleEnabled);
+  ctrl = bitfield_update32_bit(ctrl, UART_CTRL_PARITY_ODD_BIT,
+                               config.parity == kDifUartParityOdd);
+  mmio_region_write32(uart->base_addr, UART_CTRL_REG_OFFSET,
+                      bitfield_update32_apply(0, ctrl));
 
   // Disable interrupts.
   mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, 0u);
@@ -261,25 +258,24 @@ dif_result_t dif_uart_set_enable(const dif_uart_t *uart,
 
   uint32_t reg = mmio_region_read32(uart->base_addr, UART_CTRL_REG_OFFSET);
 
+  bool enable = dif_toggle_to_bool(enabled);
+  bitfield_update32_t update = {0};
   switch (datapath) {
     case kDifUartDatapathRx:
-      reg = bitfield_bit32_write(reg, UART_CTRL_RX_BIT,
-                                 dif_toggle_to_bool(enabled));
+      update = bitfield_update32_bit(update, UART_CTRL_RX_BIT, enable);
       break;
     case kDifUartDatapathTx:
-      reg = bitfield_bit32_write(reg, UART_CTRL_TX_BIT,
-                                 dif_toggle_to_bool(enabled));
+      update = bitfield_update32_bit(update, UART_CTRL_TX_BIT, enable);
       break;
     case kDifUartDatapathAll:
-      reg = bitfield_bit32_write(reg, UART_CTRL_RX_BIT,
-                                 dif_toggle_to_bool(enabled));
-      reg = bitfield_bit32_write(reg, UART_CTRL_TX_BIT,
-                                 dif_toggle_to_bool(enabled));
+      update = bitfield_update32_bit(update, UART_CTRL_RX_BIT, enable);
+      update = bitfield_update32_bit(update, UART_CTRL_TX_BIT, enable);
       break;
     default:
       return kDifBadArg;
   }
 
+  reg = bitfield_update32_apply(reg, update);
   mmio_region_write32(uart->base_addr, UART_CTRL_REG_OFFSET, reg);
 
   return kDifOk;
@@ -389,21 +385,23 @@ dif_result_t dif_uart_fifo_reset(const dif_uart_t *uart,
 
   uint32_t reg = mmio_region_read32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET);
 
+  bitfield_update32_t update = {0};
   switch (fifo) {
     case kDifUartDatapathRx:
-      reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_RXRST_BIT, true);
+      update = bitfield_update32_bit(update, UART_FIFO_CTRL_RXRST_BIT, true);
       break;
     case kDifUartDatapathTx:
-      reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_TXRST_BIT, true);
+      update = bitfield_update32_bit(update, UART_FIFO_CTRL_TXRST_BIT, true);
       break;
     case kDifUartDatapathAll:
-      reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_RXRST_BIT, true);
-      reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_TXRST_BIT, true);
+      update = bitfield_update32_bit(update, UART_FIFO_CTRL_RXRST_BIT, true);
+      update = bitfield_update32_bit(update, UART_FIFO_CTRL_TXRST_BIT, true);
       break;
     default:
       return kDifBadArg;
   }
 
+  reg = bitfield_update32_apply(reg, update);
   mmio_region_write32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET, reg);
 
   return kDifOk;
@@ -431,10 +429,12 @@ dif_result_t dif_uart_enable_rx_timeout(const dif_uart_t *uart,
     return kDifBadArg;
   }
 
-  uint32_t reg = bitfield_bit32_write(0, UART_TIMEOUT_CTRL_EN_BIT, true);
-  reg =
-      bitfield_field32_write(reg, UART_TIMEOUT_CTRL_VAL_FIELD, duration_ticks);
-  mmio_region_write32(uart->base_addr, UART_TIMEOUT_CTRL_REG_OFFSET, reg);
+  bitfield_update32_t update = {0};
+  update = bitfield_update32_bit(update, UART_TIMEOUT_CTRL_EN_BIT, true);
+  update = bitfield_update32_field(update, UART_TIMEOUT_CTRL_VAL_FIELD,
+                                   duration_ticks);
+  mmio_region_write32(uart->base_addr, UART_TIMEOUT_CTRL_REG_OFFSET,
+                      bitfield_update32_apply(0, update));
 
   return kDifOk;
 }
@@ -470,3 +470,207 @@ dif_result_t dif_uart_get_rx_timeout(const dif_uart_t *uart,
 
   return kDifOk;
 }
+
+static bool uart_tx_watermark_enabled(const dif_uart_t *uart) {
+  uint32_t reg =
+      mmio_region_read32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET);
+  return bitfield_bit32_read(reg, UART_INTR_ENABLE_TX_WATERMARK_BIT);
+}
+
+static void uart_tx_watermark_set_enabled(const dif_uart_t *uart,
+                                          bool enabled) {
+  uint32_t reg =
+      mmio_region_read32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, UART_INTR_ENABLE_TX_WATERMARK_BIT, enabled);
+  mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, reg);
+}
+
+/**
+ * Moves as many bytes from the TX ring into the TX FIFO as fit.
+ *
+ * @return The number of bytes still buffered.
+ */
+static size_t uart_async_tx_push(const dif_uart_t *uart,
+                                 dif_uart_async_ring_t *ring) {
+  size_t head = ring->head;
+  size_t tail = ring->tail;
+  while (tail != head) {
+    size_t start = tail & ring->mask;
+    size_t chunk = head - tail;
+    if (chunk > ring->mask + 1 - start) {
+      chunk = ring->mask + 1 - start;
+    }
+    size_t written = uart_bytes_send(uart, &ring->buf[start], chunk);
+    tail += written;
+    if (written < chunk) {
+      // The FIFO is full.
+      break;
+    }
+  }
+  ring->tail = tail;
+  return head - tail;
+}
+
+static bool uart_async_ring_init(dif_uart_async_ring_t *ring, uint8_t *buf,
+                                 size_t len) {
+  if ((buf == NULL) != (len == 0) || (len & (len - 1)) != 0) {
+    return false;
+  }
+  ring->buf = buf;
+  ring->mask = len - 1;
+  ring->head = 0;
+  ring->tail = 0;
+  return true;
+}
+
+dif_result_t dif_uart_async_init(dif_uart_async_t *async, uint8_t *tx_buf,
+                                 size_t tx_len, uint8_t *rx_buf,
+                                 size_t rx_len) {
+  if (async == NULL || !uart_async_ring_init(&async->tx, tx_buf, tx_len) ||
+      !uart_async_ring_init(&async->rx, rx_buf, rx_len)) {
+    return kDifBadArg;
+  }
+  async->rx_dropped = 0;
+
+  return kDifOk;
+}
+
+dif_result_t dif_uart_async_send(const dif_uart_t *uart,
+                                 dif_uart_async_t *async, const uint8_t *data,
+                                 size_t len, size_t *bytes_queued) {
+  if (uart == NULL || async == NULL || data == NULL ||
+      async->tx.buf == NULL) {
+    return kDifBadArg;
+  }
+
+  // Keep the ISR away from `tail` while the ring is being filled.
+  uart_tx_watermark_set_enabled(uart, false);
+
+  // Make room by moving older bytes into the FIFO first.
+  dif_uart_async_ring_t *ring = &async->tx;
+  size_t head = ring->head;
+  size_t space = ring->mask + 1 - uart_async_tx_push(uart, ring);
+  size_t queued = len < space ? len : space;
+  for (size_t i = 0; i < queued; ++i) {
+    ring->buf[head & ring->mask] = data[i];
+    ++head;
+  }
+  ring->head = head;
+
+  // TX watermark is a status interrupt: it stays asserted for as long as the
+  // FIFO is below the watermark, so it is only enabled while there is
+  // something left to send.
+  if (uart_async_tx_push(uart, ring) != 0) {
+    uart_tx_watermark_set_enabled(uart, true);
+  }
+
+  // `bytes_queued` is an optional parameter.
+  if (bytes_queued != NULL) {
+    *bytes_queued = queued;
+  }
+
+  return kDifOk;
+}
+
+dif_result_t dif_uart_async_tx_isr(const dif_uart_t *uart,
+                                   dif_uart_async_t *async,
+                                   size_t *bytes_pending) {
+  if (uart == NULL || async == NULL) {
+    return kDifBadArg;
+  }
+
+  // The interrupt can still be taken just after `dif_uart_async_send()`
+  // masked it; leave the ring to the sender in that case.
+  size_t left = async->tx.head - async->tx.tail;
+  if (uart_tx_watermark_enabled(uart)) {
+    left = uart_async_tx_push(uart, &async->tx);
+    if (left == 0) {
+      uart_tx_watermark_set_enabled(uart, false);
+    }
+  }
+
+  // `bytes_pending` is an optional parameter.
+  if (bytes_pending != NULL) {
+    *bytes_pending = left;
+  }
+
+  return kDifOk;
+}
+
+dif_result_t dif_uart_async_tx_flush(const dif_uart_t *uart,
+                                     dif_uart_async_t *async) {
+  if (uart == NULL || async == NULL) {
+    return kDifBadArg;
+  }
+
+  uart_tx_watermark_set_enabled(uart, false);
+  while (uart_async_tx_push(uart, &async->tx) != 0) {
+  }
+
+  return kDifOk;
+}
+
+dif_result_t dif_uart_async_rx_isr(const dif_uart_t *uart,
+                                   dif_uart_async_t *async) {
+  if (uart == NULL || async == NULL || async->rx.buf == NULL) {
+    return kDifBadArg;
+  }
+
+  dif_uart_async_ring_t *ring = &async->rx;
+  size_t head = ring->head;
+  size_t dropped = 0;
+  while (!uart_rx_empty(uart)) {
+    uint8_t byte = uart_rx_fifo_read(uart);
+    if (head - ring->tail > ring->mask) {
+      ++dropped;
+      continue;
+    }
+    ring->buf[head & ring->mask] = byte;
+    ++head;
+  }
+  ring->head = head;
+  async->rx_dropped += dropped;
+
+  // RX timeout is an event interrupt and must be acknowledged. RX watermark
+  // deasserts on its own now that the FIFO is empty.
+  mmio_region_write32(uart->base_addr, UART_INTR_STATE_REG_OFFSET,
+                      bitfield_bit32_write(0, UART_INTR_STATE_RX_TIMEOUT_BIT,
+                                           true));
+
+  return kDifOk;
+}
+
+dif_result_t dif_uart_async_receive(dif_uart_async_t *async, uint8_t *data,
+                                    size_t len, size_t *bytes_read) {
+  if (async == NULL || data == NULL || async->rx.buf == NULL) {
+    return kDifBadArg;
+  }
+
+  dif_uart_async_ring_t *ring = &async->rx;
+  size_t tail = ring->tail;
+  size_t avail = ring->head - tail;
+  size_t read = len < avail ? len : avail;
+  for (size_t i = 0; i < read; ++i) {
+    data[i] = ring->buf[tail & ring->mask];
+    ++tail;
+  }
+  ring->tail = tail;
+
+  // `bytes_read` is an optional parameter.
+  if (bytes_read != NULL) {
+    *bytes_read = read;
+  }
+
+  return kDifOk;
+}
+
+dif_result_t dif_uart_async_rx_bytes_available(const dif_uart_async_t *async,
+                                               size_t *num_bytes) {
+  if (async == NULL || num_bytes == NULL || async->rx.buf == NULL) {
+    return kDifBadArg;
+  }
+
+  *num_bytes = async->rx.head - async->rx.tail;
+
+  return kDifOk;
+}
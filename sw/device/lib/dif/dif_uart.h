@@ -395,6 +395,169 @@ dif_result_t dif_uart_get_rx_timeout(const dif_uart_t *uart,
                                      dif_toggle_t *status,
                                      uint32_t *duration_ticks);
 
+/**
+ * A software ring buffer used by the asynchronous UART API.
+ *
+ * `head` and `tail` are free-running counts of the bytes written into and
+ * read out of `buf`; their difference is the number of bytes buffered.
+ */
+typedef struct dif_uart_async_ring {
+  /**
+   * Backing storage, owned by the caller.
+   */
+  uint8_t *buf;
+  /**
+   * Size of `buf` minus one. The size must be a power of two.
+   */
+  size_t mask;
+  volatile size_t head;
+  volatile size_t tail;
+} dif_uart_async_ring_t;
+
+/**
+ * State of the interrupt-driven, buffered UART API.
+ *
+ * Bytes queued with `dif_uart_async_send()` are moved into the TX FIFO by
+ * `dif_uart_async_tx_isr()`, which should be called on the TX watermark
+ * interrupt. Bytes received by the hardware are moved out of the RX FIFO by
+ * `dif_uart_async_rx_isr()`, which should be called on the RX watermark and
+ * RX timeout interrupts, and handed to the application by
+ * `dif_uart_async_receive()`.
+ *
+ * On the TX side, the ISR and `dif_uart_async_send()` never touch the ring at
+ * the same time because the latter masks the TX watermark interrupt while it
+ * runs. On the RX side, the ISR only advances `rx.head` and
+ * `dif_uart_async_receive()` only advances `rx.tail`.
+ *
+ * This struct should be treated as opaque by users.
+ */
+typedef struct dif_uart_async {
+  dif_uart_async_ring_t tx;
+  dif_uart_async_ring_t rx;
+  /**
+   * Number of received bytes dropped because the RX ring was full.
+   */
+  volatile size_t rx_dropped;
+} dif_uart_async_t;
+
+/**
+ * Initializes the asynchronous UART state with caller-supplied buffers.
+ *
+ * Either direction may be left unbuffered by passing NULL and a length of 0.
+ * This function does not touch the hardware: the caller is expected to
+ * configure the FIFO watermarks and, for RX, enable the RX watermark and RX
+ * timeout interrupts. The TX watermark interrupt is managed by this API and
+ * should be left disabled.
+ *
+ * @param[out] async The asynchronous UART state.
+ * @param tx_buf Backing storage for the TX ring.
+ * @param tx_len Size of `tx_buf`; must be zero or a power of two.
+ * @param rx_buf Backing storage for the RX ring.
+ * @param rx_len Size of `rx_buf`; must be zero or a power of two.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_async_init(dif_uart_async_t *async, uint8_t *tx_buf,
+                                 size_t tx_len, uint8_t *rx_buf,
+                                 size_t rx_len);
+
+/**
+ * Queues bytes for transmission without waiting for the UART.
+ *
+ * As many bytes as fit are copied into the TX ring and pushed into the TX
+ * FIFO. If any bytes remain buffered, the TX watermark interrupt is enabled
+ * so that `dif_uart_async_tx_isr()` can send them.
+ *
+ * Must not be called from the TX watermark ISR.
+ *
+ * @param uart A UART handle.
+ * @param async The asynchronous UART state.
+ * @param data Data to be sent.
+ * @param len Number of bytes in `data`.
+ * @param[out] bytes_queued Number of bytes accepted (optional).
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_async_send(const dif_uart_t *uart,
+                                 dif_uart_async_t *async, const uint8_t *data,
+                                 size_t len, size_t *bytes_queued);
+
+/**
+ * Services the TX watermark interrupt.
+ *
+ * Moves buffered bytes into the TX FIFO and disables the TX watermark
+ * interrupt once the ring is empty. Does nothing if the interrupt is
+ * disabled, which happens when it is taken while `dif_uart_async_send()`
+ * owns the ring.
+ *
+ * @param uart A UART handle.
+ * @param async The asynchronous UART state.
+ * @param[out] bytes_pending Number of bytes still buffered (optional).
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_async_tx_isr(const dif_uart_t *uart,
+                                   dif_uart_async_t *async,
+                                   size_t *bytes_pending);
+
+/**
+ * Moves all buffered TX bytes into the TX FIFO, busy waiting for space.
+ *
+ * Disables the TX watermark interrupt. Can be used where interrupts are not
+ * serviced, for example before a reset or from an exception handler.
+ *
+ * @param uart A UART handle.
+ * @param async The asynchronous UART state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_async_tx_flush(const dif_uart_t *uart,
+                                     dif_uart_async_t *async);
+
+/**
+ * Services the RX watermark and RX timeout interrupts.
+ *
+ * Drains the RX FIFO into the RX ring and acknowledges the RX timeout
+ * interrupt. Bytes that do not fit into the ring are discarded and counted in
+ * `rx_dropped`, so that the RX watermark interrupt is always deasserted.
+ *
+ * @param uart A UART handle.
+ * @param async The asynchronous UART state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_async_rx_isr(const dif_uart_t *uart,
+                                   dif_uart_async_t *async);
+
+/**
+ * Reads bytes received by `dif_uart_async_rx_isr()`.
+ *
+ * Does not access the hardware and does not wait for data.
+ *
+ * @param async The asynchronous UART state.
+ * @param[out] data Buffer for up to `len` bytes.
+ * @param len Size of `data`.
+ * @param[out] bytes_read Number of bytes read (optional).
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_async_receive(dif_uart_async_t *async, uint8_t *data,
+                                    size_t len, size_t *bytes_read);
+
+/**
+ * Gets the number of received bytes waiting in the RX ring.
+ *
+ * Does not access the hardware.
+ *
+ * @param async The asynchronous UART state.
+ * @param[out] num_bytes Number of bytes that `dif_uart_async_receive()` can
+ * read.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_async_rx_bytes_available(const dif_uart_async_t *async,
+                                               size_t *num_bytes);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
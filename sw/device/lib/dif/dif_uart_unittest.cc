@@ -666,5 +666,147 @@ TEST_F(RxTimeoutTest, GetAll) {
   EXPECT_EQ(out, duration);
 }
 
+class AsyncTest : public UartTest {
+ protected:
+  void SetUp() override {
+    EXPECT_DIF_OK(dif_uart_async_init(&async_, tx_buf_, sizeof(tx_buf_),
+                                      rx_buf_, sizeof(rx_buf_)));
+  }
+
+  void ExpectTxWatermarkEnable(bool enabled) {
+    EXPECT_READ32(UART_INTR_ENABLE_REG_OFFSET,
+                  {{UART_INTR_ENABLE_RX_WATERMARK_BIT, true}});
+    EXPECT_WRITE32(UART_INTR_ENABLE_REG_OFFSET,
+                   {{UART_INTR_ENABLE_RX_WATERMARK_BIT, true},
+                    {UART_INTR_ENABLE_TX_WATERMARK_BIT, enabled}});
+  }
+
+  void ExpectTxFifoFull() {
+    EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_TXFULL_BIT, true}});
+  }
+
+  uint8_t tx_buf_[8];
+  uint8_t rx_buf_[4];
+  dif_uart_async_t async_;
+};
+
+TEST_F(AsyncTest, InitBadArgs) {
+  EXPECT_DIF_BADARG(dif_uart_async_init(nullptr, tx_buf_, 8, nullptr, 0));
+  EXPECT_DIF_BADARG(dif_uart_async_init(&async_, tx_buf_, 6, nullptr, 0));
+  EXPECT_DIF_BADARG(dif_uart_async_init(&async_, tx_buf_, 0, nullptr, 0));
+  EXPECT_DIF_BADARG(dif_uart_async_init(&async_, nullptr, 0, nullptr, 4));
+  EXPECT_DIF_OK(dif_uart_async_init(&async_, nullptr, 0, rx_buf_, 4));
+}
+
+TEST_F(AsyncTest, SendNullArgs) {
+  EXPECT_DIF_BADARG(dif_uart_async_send(nullptr, &async_, kBytesArray.data(),
+                                        1, nullptr));
+  EXPECT_DIF_BADARG(
+      dif_uart_async_send(&uart_, nullptr, kBytesArray.data(), 1, nullptr));
+  EXPECT_DIF_BADARG(dif_uart_async_send(&uart_, &async_, nullptr, 1, nullptr));
+  EXPECT_DIF_BADARG(dif_uart_async_tx_isr(nullptr, &async_, nullptr));
+  EXPECT_DIF_BADARG(dif_uart_async_tx_flush(&uart_, nullptr));
+  size_t avail;
+  EXPECT_DIF_BADARG(dif_uart_async_rx_bytes_available(nullptr, &avail));
+  EXPECT_DIF_BADARG(dif_uart_async_rx_bytes_available(&async_, nullptr));
+}
+
+TEST_F(AsyncTest, SendFitsInFifo) {
+  ExpectTxWatermarkEnable(false);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_READ32(UART_STATUS_REG_OFFSET, 0);
+    EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kBytesArray[i]);
+  }
+
+  size_t queued;
+  EXPECT_DIF_OK(
+      dif_uart_async_send(&uart_, &async_, kBytesArray.data(), 3, &queued));
+  EXPECT_EQ(queued, 3);
+}
+
+TEST_F(AsyncTest, SendBuffersAndIsrDrains) {
+  // The FIFO is full: bytes are buffered up to the size of the ring and the TX
+  // watermark interrupt is enabled.
+  ExpectTxWatermarkEnable(false);
+  ExpectTxFifoFull();
+  ExpectTxWatermarkEnable(true);
+
+  size_t queued;
+  EXPECT_DIF_OK(dif_uart_async_send(&uart_, &async_, kBytesArray.data(),
+                                    kBytesArray.size(), &queued));
+  EXPECT_EQ(queued, sizeof(tx_buf_));
+
+  // The ISR makes partial progress.
+  EXPECT_READ32(UART_INTR_ENABLE_REG_OFFSET,
+                {{UART_INTR_ENABLE_TX_WATERMARK_BIT, true}});
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_READ32(UART_STATUS_REG_OFFSET, 0);
+    EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kBytesArray[i]);
+  }
+  ExpectTxFifoFull();
+
+  size_t pending;
+  EXPECT_DIF_OK(dif_uart_async_tx_isr(&uart_, &async_, &pending));
+  EXPECT_EQ(pending, 3);
+
+  // The ISR sends the rest and masks the interrupt.
+  EXPECT_READ32(UART_INTR_ENABLE_REG_OFFSET,
+                {{UART_INTR_ENABLE_TX_WATERMARK_BIT, true}});
+  for (size_t i = 5; i < 8; ++i) {
+    EXPECT_READ32(UART_STATUS_REG_OFFSET, 0);
+    EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kBytesArray[i]);
+  }
+  EXPECT_READ32(UART_INTR_ENABLE_REG_OFFSET,
+                {{UART_INTR_ENABLE_TX_WATERMARK_BIT, true}});
+  EXPECT_WRITE32(UART_INTR_ENABLE_REG_OFFSET, 0);
+
+  EXPECT_DIF_OK(dif_uart_async_tx_isr(&uart_, &async_, &pending));
+  EXPECT_EQ(pending, 0);
+}
+
+TEST_F(AsyncTest, TxIsrMasked) {
+  ExpectTxWatermarkEnable(false);
+  ExpectTxFifoFull();
+  ExpectTxWatermarkEnable(true);
+  EXPECT_DIF_OK(
+      dif_uart_async_send(&uart_, &async_, kBytesArray.data(), 2, nullptr));
+
+  // A stale interrupt taken while the sender owns the ring is ignored.
+  EXPECT_READ32(UART_INTR_ENABLE_REG_OFFSET, 0);
+
+  size_t pending;
+  EXPECT_DIF_OK(dif_uart_async_tx_isr(&uart_, &async_, &pending));
+  EXPECT_EQ(pending, 2);
+}
+
+TEST_F(AsyncTest, RxIsrAndReceive) {
+  // Five bytes arrive, one more than the ring holds.
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_READ32(UART_STATUS_REG_OFFSET, 0);
+    EXPECT_READ32(UART_RDATA_REG_OFFSET, kBytesArray[i]);
+  }
+  EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_RXEMPTY_BIT, true}});
+  EXPECT_WRITE32(UART_INTR_STATE_REG_OFFSET,
+                 {{UART_INTR_STATE_RX_TIMEOUT_BIT, true}});
+  EXPECT_DIF_OK(dif_uart_async_rx_isr(&uart_, &async_));
+  EXPECT_EQ(async_.rx_dropped, 1);
+
+  size_t avail;
+  EXPECT_DIF_OK(dif_uart_async_rx_bytes_available(&async_, &avail));
+  EXPECT_EQ(avail, 4);
+
+  std::vector<uint8_t> data(8);
+  size_t read;
+  EXPECT_DIF_OK(dif_uart_async_receive(&async_, data.data(), 3, &read));
+  EXPECT_EQ(read, 3);
+  EXPECT_DIF_OK(dif_uart_async_rx_bytes_available(&async_, &avail));
+  EXPECT_EQ(avail, 1);
+  EXPECT_DIF_OK(
+      dif_uart_async_receive(&async_, data.data() + 3, data.size(), &read));
+  EXPECT_EQ(read, 1);
+  EXPECT_EQ(std::vector<uint8_t>(data.begin(), data.begin() + 4),
+            std::vector<uint8_t>(kBytesArray.begin(), kBytesArray.begin() + 4));
+}
+
 }  // namespace
 }  // namespace dif_uart_unittest
@@ -7,6 +7,7 @@
 #include <assert.h>
 
 #include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/memory.h"
 
 #include "usbdev_regs.h"  // Generated.
 
@@ -22,6 +23,18 @@ static_assert(USBDEV_NUM_ENDPOINTS == USBDEV_PARAM_N_ENDPOINTS,
  */
 #define USBDEV_BUFFER_ENTRY_SIZE_BYTES USBDEV_MAX_PACKET_SIZE
 
+enum {
+  /**
+   * Number of buffers that software keeps in the Available SETUP Buffer FIFO.
+   */
+  kAvSetupMinDepth = 2,
+  /**
+   * Depth of the Available OUT Buffer FIFO; must match `AVOutFifoDepth` in the
+   * hardware.
+   */
+  kAvOutFifoDepth = 8,
+};
+
 /**
  * Constants used to indicate that a buffer pool is full or empty.
  */
@@ -205,6 +218,41 @@ static uint32_t get_buffer_addr(uint8_t buffer_id, size_t offset) {
          (buffer_id * USBDEV_BUFFER_ENTRY_SIZE_BYTES) + offset;
 }
 
+/**
+ * Copies `len` bytes out of packet buffer memory starting at `addr`.
+ *
+ * Whole words are moved directly when both sides are word aligned; only the
+ * remainder goes through the generic byte-handling copy.
+ */
+static void buffer_copy_from(const dif_usbdev_t *usbdev, uint32_t addr,
+                             uint8_t *dst, size_t len) {
+  if (misalignment32_of(addr) == 0 && misalignment32_of((uintptr_t)dst) == 0) {
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+      write_32(mmio_region_read32(usbdev->base_addr, (ptrdiff_t)addr), dst);
+      addr += sizeof(uint32_t);
+      dst += sizeof(uint32_t);
+    }
+  }
+  mmio_region_memcpy_from_mmio32(usbdev->base_addr, addr, dst, len);
+}
+
+/**
+ * Copies `len` bytes into packet buffer memory starting at `addr`.
+ *
+ * See `buffer_copy_from()`.
+ */
+static void buffer_copy_to(const dif_usbdev_t *usbdev, uint32_t addr,
+                           const uint8_t *src, size_t len) {
+  if (misalignment32_of(addr) == 0 && misalignment32_of((uintptr_t)src) == 0) {
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+      mmio_region_write32(usbdev->base_addr, (ptrdiff_t)addr, read_32(src));
+      addr += sizeof(uint32_t);
+      src += sizeof(uint32_t);
+    }
+  }
+  mmio_region_memcpy_to_mmio32(usbdev->base_addr, addr, src, len);
+}
+
 /**
  * USBDEV DIF library functions.
  */
@@ -261,37 +309,44 @@ dif_result_t dif_usbdev_fill_available_fifos(
     return kDifBadArg;
   }
 
-  // Remove buffers from the pool and write as many as possible into the FIFOs
-  while (!buffer_pool_is_empty(buffer_pool)) {
-    uint32_t status =
-        mmio_region_read32(usbdev->base_addr, USBDEV_USBSTAT_REG_OFFSET);
-    // Prioritize available SETUP buffers
-    uint32_t av_setup_depth =
-        bitfield_field32_read(status, USBDEV_USBSTAT_AV_SETUP_DEPTH_FIELD);
-    if (av_setup_depth >= 2) {
-      // Available SETUP Buffer FIFO is okay, what about the OUT buffers?
-      bool av_out_full =
-          bitfield_bit32_read(status, USBDEV_USBSTAT_AV_OUT_FULL_BIT);
-      if (av_out_full) {
-        break;
-      }
-    }
+  // Work out how many buffers each FIFO can take from a single status read;
+  // software is the only producer, so the FIFOs can only drain meanwhile.
+  uint32_t status =
+      mmio_region_read32(usbdev->base_addr, USBDEV_USBSTAT_REG_OFFSET);
+  uint32_t av_setup_depth =
+      bitfield_field32_read(status, USBDEV_USBSTAT_AV_SETUP_DEPTH_FIELD);
+  uint32_t av_out_depth =
+      bitfield_field32_read(status, USBDEV_USBSTAT_AV_OUT_DEPTH_FIELD);
+  // Prioritize available SETUP buffers
+  uint32_t setup_needed = av_setup_depth < kAvSetupMinDepth
+                              ? kAvSetupMinDepth - av_setup_depth
+                              : 0;
+  uint32_t out_needed = 0;
+  if (!bitfield_bit32_read(status, USBDEV_USBSTAT_AV_OUT_FULL_BIT) &&
+      av_out_depth < kAvOutFifoDepth) {
+    out_needed = kAvOutFifoDepth - av_out_depth;
+  }
+
+  // Remove buffers from the pool and write them into the FIFOs
+  while (setup_needed + out_needed > 0 && !buffer_pool_is_empty(buffer_pool)) {
     uint8_t buffer_id;
     if (!buffer_pool_remove(buffer_pool, &buffer_id)) {
       return kDifError;
     }
-    if (av_setup_depth >= 2) {
-      // Supply Available OUT Buffer
-      uint32_t reg_val =
-          bitfield_field32_write(0, USBDEV_AVOUTBUFFER_BUFFER_FIELD, buffer_id);
-      mmio_region_write32(usbdev->base_addr, USBDEV_AVOUTBUFFER_REG_OFFSET,
-                          reg_val);
-    } else {
+    if (setup_needed > 0) {
       // Supply Available SETUP Buffer
       uint32_t reg_val = bitfield_field32_write(
           0, USBDEV_AVSETUPBUFFER_BUFFER_FIELD, buffer_id);
       mmio_region_write32(usbdev->base_addr, USBDEV_AVSETUPBUFFER_REG_OFFSET,
                           reg_val);
+      --setup_needed;
+    } else {
+      // Supply Available OUT Buffer
+      uint32_t reg_val =
+          bitfield_field32_write(0, USBDEV_AVOUTBUFFER_BUFFER_FIELD, buffer_id);
+      mmio_region_write32(usbdev->base_addr, USBDEV_AVOUTBUFFER_REG_OFFSET,
+                          reg_val);
+      --out_needed;
     }
   }
 
@@ -388,23 +443,12 @@ dif_result_t dif_usbdev_interface_enable(const dif_usbdev_t *usbdev,
   return kDifOk;
 }
 
-dif_result_t dif_usbdev_recv(const dif_usbdev_t *usbdev,
-                             dif_usbdev_rx_packet_info_t *info,
-                             dif_usbdev_buffer_t *buffer) {
-  if (usbdev == NULL || info == NULL || buffer == NULL) {
-    return kDifBadArg;
-  }
-
-  // Check if the RX FIFO is empty
-  uint32_t fifo_status =
-      mmio_region_read32(usbdev->base_addr, USBDEV_USBSTAT_REG_OFFSET);
-  if (bitfield_bit32_read(fifo_status, USBDEV_USBSTAT_RX_EMPTY_BIT)) {
-    return kDifUnavailable;
-  }
-
-  // Read fifo entry
-  const uint32_t fifo_entry =
-      mmio_region_read32(usbdev->base_addr, USBDEV_RXFIFO_REG_OFFSET);
+/**
+ * Decodes an RX FIFO entry into packet information and a read buffer.
+ */
+static void rx_fifo_entry_decode(uint32_t fifo_entry,
+                                 dif_usbdev_rx_packet_info_t *info,
+                                 dif_usbdev_buffer_t *buffer) {
   // Init packet info
   *info = (dif_usbdev_rx_packet_info_t){
       .endpoint =
@@ -421,6 +465,58 @@ dif_result_t dif_usbdev_recv(const dif_usbdev_t *usbdev,
       .remaining_bytes = info->length,
       .type = kDifUsbdevBufferTypeRead,
   };
+}
+
+dif_result_t dif_usbdev_recv(const dif_usbdev_t *usbdev,
+                             dif_usbdev_rx_packet_info_t *info,
+                             dif_usbdev_buffer_t *buffer) {
+  if (usbdev == NULL || info == NULL || buffer == NULL) {
+    return kDifBadArg;
+  }
+
+  // Check if the RX FIFO is empty
+  uint32_t fifo_status =
+      mmio_region_read32(usbdev->base_addr, USBDEV_USBSTAT_REG_OFFSET);
+  if (bitfield_bit32_read(fifo_status, USBDEV_USBSTAT_RX_EMPTY_BIT)) {
+    return kDifUnavailable;
+  }
+
+  // Read fifo entry
+  rx_fifo_entry_decode(
+      mmio_region_read32(usbdev->base_addr, USBDEV_RXFIFO_REG_OFFSET), info,
+      buffer);
+
+  return kDifOk;
+}
+
+dif_result_t dif_usbdev_recv_batch(const dif_usbdev_t *usbdev,
+                                   dif_usbdev_rx_packet_info_t *info,
+                                   dif_usbdev_buffer_t *buffers,
+                                   size_t max_packets, size_t *num_packets) {
+  if (usbdev == NULL || info == NULL || buffers == NULL ||
+      num_packets == NULL) {
+    return kDifBadArg;
+  }
+
+  // Entries already in the RX FIFO stay there until popped, so a single
+  // depth read bounds how many can be popped without checking again.
+  uint32_t fifo_status =
+      mmio_region_read32(usbdev->base_addr, USBDEV_USBSTAT_REG_OFFSET);
+  size_t count = 0;
+  if (!bitfield_bit32_read(fifo_status, USBDEV_USBSTAT_RX_EMPTY_BIT)) {
+    count =
+        bitfield_field32_read(fifo_status, USBDEV_USBSTAT_RX_DEPTH_FIELD);
+  }
+  if (count > max_packets) {
+    count = max_packets;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    rx_fifo_entry_decode(
+        mmio_region_read32(usbdev->base_addr, USBDEV_RXFIFO_REG_OFFSET),
+        &info[i], &buffers[i]);
+  }
+  *num_packets = count;
 
   return kDifOk;
 }
@@ -489,8 +585,7 @@ dif_result_t dif_usbdev_buffer_read(const dif_usbdev_t *usbdev,
   }
   // Copy from buffer to dst
   const uint32_t buffer_addr = get_buffer_addr(buffer->id, buffer->offset);
-  mmio_region_memcpy_from_mmio32(usbdev->base_addr, buffer_addr, dst,
-                                 bytes_to_copy);
+  buffer_copy_from(usbdev, buffer_addr, dst, bytes_to_copy);
   // Update buffer state
   buffer->offset += bytes_to_copy;
   buffer->remaining_bytes -= bytes_to_copy;
@@ -531,8 +626,7 @@ dif_result_t dif_usbdev_buffer_write(const dif_usbdev_t *usbdev,
 
   // Write bytes to the buffer
   uint32_t buffer_addr = get_buffer_addr(buffer->id, buffer->offset);
-  mmio_region_memcpy_to_mmio32(usbdev->base_addr, buffer_addr, src,
-                               bytes_to_copy);
+  buffer_copy_to(usbdev, buffer_addr, src, bytes_to_copy);
 
   buffer->offset += bytes_to_copy;
   buffer->remaining_bytes -= bytes_to_copy;
@@ -548,6 +642,63 @@ dif_result_t dif_usbdev_buffer_write(const dif_usbdev_t *usbdev,
   return kDifOk;
 }
 
+dif_result_t dif_usbdev_buffer_map(const dif_usbdev_t *usbdev,
+                                   const dif_usbdev_buffer_t *buffer,
+                                   dif_usbdev_buffer_view_t *view) {
+  if (usbdev == NULL || buffer == NULL || view == NULL ||
+      (buffer->type != kDifUsbdevBufferTypeRead &&
+       buffer->type != kDifUsbdevBufferTypeWrite)) {
+    return kDifBadArg;
+  }
+
+  *view = (dif_usbdev_buffer_view_t){
+      .region = usbdev->base_addr,
+      .offset = get_buffer_addr(buffer->id, buffer->offset),
+      .length = buffer->remaining_bytes,
+  };
+  return kDifOk;
+}
+
+dif_result_t dif_usbdev_buffer_consume(const dif_usbdev_t *usbdev,
+                                       dif_usbdev_buffer_pool_t *buffer_pool,
+                                       dif_usbdev_buffer_t *buffer,
+                                       size_t len) {
+  if (usbdev == NULL || buffer_pool == NULL || buffer == NULL ||
+      buffer->type != kDifUsbdevBufferTypeRead ||
+      len > buffer->remaining_bytes) {
+    return kDifBadArg;
+  }
+
+  buffer->offset += len;
+  buffer->remaining_bytes -= len;
+  if (buffer->remaining_bytes > 0) {
+    return kDifOk;
+  }
+
+  // Return the buffer to the free buffer pool
+  if (!buffer_pool_add(buffer_pool, buffer->id)) {
+    return kDifError;
+  }
+
+  // Mark the buffer as stale
+  buffer->type = kDifUsbdevBufferTypeStale;
+  return kDifOk;
+}
+
+dif_result_t dif_usbdev_buffer_commit(const dif_usbdev_t *usbdev,
+                                      dif_usbdev_buffer_t *buffer,
+                                      size_t len) {
+  if (usbdev == NULL || buffer == NULL ||
+      buffer->type != kDifUsbdevBufferTypeWrite ||
+      len > buffer->remaining_bytes) {
+    return kDifBadArg;
+  }
+
+  buffer->offset += len;
+  buffer->remaining_bytes -= len;
+  return kDifOk;
+}
+
 dif_result_t dif_usbdev_send(const dif_usbdev_t *usbdev, uint8_t endpoint,
                              dif_usbdev_buffer_t *buffer) {
   if (usbdev == NULL || !is_valid_endpoint(endpoint) || buffer == NULL ||
@@ -174,6 +174,8 @@ dif_result_t dif_usbdev_configure(const dif_usbdev_t *usbdev,
  * to send a NAK. Thus, the software must make sure that the AV FIFO is never
  * empty by calling this function periodically.
  *
+ * The FIFOs are topped up based on a single read of the USB device status.
+ *
  * @param usbdev A USB device.
  * @param buffer_pool A USB device buffer pool.
  * @return The result of the operation.
@@ -369,6 +371,28 @@ dif_result_t dif_usbdev_recv(const dif_usbdev_t *usbdev,
                              dif_usbdev_rx_packet_info_t *packet_info,
                              dif_usbdev_buffer_t *buffer);
 
+/**
+ * Get up to `max_packets` packets from the front of the RX FIFO.
+ *
+ * Equivalent to calling `dif_usbdev_recv` until either the RX FIFO is empty or
+ * `max_packets` packets have been received, but reads the USB device status
+ * only once. Packets that arrive while this function runs are left for the
+ * next call.
+ *
+ * @param usbdev A USB device.
+ * @param[out] info Packet information, one entry per received packet.
+ * @param[out] buffers Buffers that hold the packet payloads, one entry per
+ *                     received packet.
+ * @param max_packets Number of entries in `info` and `buffers`.
+ * @param[out] num_packets Number of packets received, possibly zero.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_recv_batch(const dif_usbdev_t *usbdev,
+                                   dif_usbdev_rx_packet_info_t *info,
+                                   dif_usbdev_buffer_t *buffers,
+                                   size_t max_packets, size_t *num_packets);
+
 /**
  * Read incoming packet payload.
  *
@@ -480,6 +504,87 @@ dif_result_t dif_usbdev_buffer_write(const dif_usbdev_t *usbdev,
                                      const uint8_t *src, size_t src_len,
                                      size_t *bytes_written);
 
+/**
+ * An in-place view of the unused part of a USB device buffer.
+ *
+ * The packet data lives in the USB device packet buffer memory, so it must be
+ * accessed with the `mmio_region_*32()` functions at word-aligned offsets
+ * from `offset`. The view is only valid until the buffer is consumed,
+ * committed, sent or returned.
+ */
+typedef struct dif_usbdev_buffer_view {
+  /**
+   * MMIO region that holds the buffer.
+   */
+  mmio_region_t region;
+  /**
+   * Byte offset of the first unused byte of the buffer within `region`.
+   */
+  uint32_t offset;
+  /**
+   * For read buffers: number of bytes that can be read.
+   * For write buffers: number of bytes that can be written.
+   */
+  size_t length;
+} dif_usbdev_buffer_view_t;
+
+/**
+ * Map a buffer for in-place access.
+ *
+ * Lets clients fill an outgoing packet or consume an incoming packet directly
+ * in packet buffer memory instead of staging it in a separate buffer for
+ * `dif_usbdev_buffer_write` or `dif_usbdev_buffer_read`. Once done, clients
+ * should call `dif_usbdev_buffer_consume` or `dif_usbdev_buffer_commit` with
+ * the number of bytes that they read or wrote.
+ *
+ * See also: `dif_usbdev_recv`, `dif_usbdev_buffer_request`.
+ *
+ * @param usbdev A USB device.
+ * @param buffer A buffer provided by `dif_usbdev_recv` or
+ *               `dif_usbdev_buffer_request`.
+ * @param[out] view View of the unused part of the buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_map(const dif_usbdev_t *usbdev,
+                                   const dif_usbdev_buffer_t *buffer,
+                                   dif_usbdev_buffer_view_t *view);
+
+/**
+ * Mark bytes of an incoming packet as read in place.
+ *
+ * The counterpart of `dif_usbdev_buffer_read` for buffers accessed through
+ * `dif_usbdev_buffer_map`. The buffer is returned to the free buffer pool when
+ * the entire packet payload has been consumed.
+ *
+ * @param usbdev A USB device.
+ * @param buffer_pool A USB device buffer pool.
+ * @param buffer A buffer provided by `dif_usbdev_recv`.
+ * @param len Number of bytes read from the buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_consume(const dif_usbdev_t *usbdev,
+                                       dif_usbdev_buffer_pool_t *buffer_pool,
+                                       dif_usbdev_buffer_t *buffer,
+                                       size_t len);
+
+/**
+ * Mark bytes of an outgoing packet as written in place.
+ *
+ * The counterpart of `dif_usbdev_buffer_write` for buffers accessed through
+ * `dif_usbdev_buffer_map`.
+ *
+ * @param usbdev A USB device.
+ * @param buffer A buffer provided by `dif_usbdev_buffer_request`.
+ * @param len Number of bytes written to the buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_commit(const dif_usbdev_t *usbdev,
+                                      dif_usbdev_buffer_t *buffer,
+                                      size_t len);
+
 /**
  * Mark a packet ready for transmission from an endpoint.
  *
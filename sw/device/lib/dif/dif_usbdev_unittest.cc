@@ -493,23 +493,21 @@ TEST_F(UsbdevTest, OutPacket) {
                  });
   EXPECT_DIF_OK(dif_usbdev_configure(&usbdev_, &buffer_pool, phy_config));
 
-  // Add buffers to the AV SETUP FIFO and Av OUT FIFO to receive.
+  // Add buffers to the AV SETUP FIFO and Av OUT FIFO to receive; a single
+  // status read determines how many buffers each FIFO takes.
+  EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET,
+                {
+                    {USBDEV_USBSTAT_FRAME_OFFSET, 10},
+                    {USBDEV_USBSTAT_LINK_STATE_OFFSET,
+                     USBDEV_USBSTAT_LINK_STATE_VALUE_ACTIVE},
+                    {USBDEV_USBSTAT_SENSE_BIT, 1},
+                    {USBDEV_USBSTAT_AV_OUT_DEPTH_OFFSET, 0},
+                    {USBDEV_USBSTAT_AV_SETUP_DEPTH_OFFSET, 0},
+                    {USBDEV_USBSTAT_AV_OUT_FULL_BIT, 0},
+                    {USBDEV_USBSTAT_AV_SETUP_FULL_BIT, 0},
+                });
   for (uint32_t i = 0u; i < kMaxAvSetupBuffers + kMaxAvOutBuffers; ++i) {
-    uint8_t setup_depth = (i >= kMaxAvSetupBuffers) ? kMaxAvSetupBuffers : i;
-    uint8_t out_depth =
-        (i >= kMaxAvSetupBuffers) ? (i - kMaxAvSetupBuffers) : 0u;
     int top = buffer_pool.top;
-    EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET,
-                  {
-                      {USBDEV_USBSTAT_FRAME_OFFSET, 10},
-                      {USBDEV_USBSTAT_LINK_STATE_OFFSET,
-                       USBDEV_USBSTAT_LINK_STATE_VALUE_ACTIVE},
-                      {USBDEV_USBSTAT_SENSE_BIT, 1},
-                      {USBDEV_USBSTAT_AV_OUT_DEPTH_OFFSET, out_depth},
-                      {USBDEV_USBSTAT_AV_SETUP_DEPTH_OFFSET, setup_depth},
-                      {USBDEV_USBSTAT_AV_OUT_FULL_BIT, 0},
-                      {USBDEV_USBSTAT_AV_SETUP_FULL_BIT, 0},
-                  });
     if (i >= kMaxAvSetupBuffers) {
       EXPECT_WRITE32(
           USBDEV_AVOUTBUFFER_REG_OFFSET,
@@ -520,18 +518,6 @@ TEST_F(UsbdevTest, OutPacket) {
           {{USBDEV_AVSETUPBUFFER_BUFFER_OFFSET, buffer_pool.buffers[top - i]}});
     }
   }
-  EXPECT_READ32(
-      USBDEV_USBSTAT_REG_OFFSET,
-      {
-          {USBDEV_USBSTAT_FRAME_OFFSET, 10},
-          {USBDEV_USBSTAT_LINK_STATE_OFFSET,
-           USBDEV_USBSTAT_LINK_STATE_VALUE_ACTIVE},
-          {USBDEV_USBSTAT_SENSE_BIT, 1},
-          {USBDEV_USBSTAT_AV_OUT_DEPTH_OFFSET, kMaxAvOutBuffers},
-          {USBDEV_USBSTAT_AV_SETUP_DEPTH_OFFSET, kMaxAvSetupBuffers},
-          {USBDEV_USBSTAT_AV_OUT_FULL_BIT, 1},
-          {USBDEV_USBSTAT_AV_SETUP_FULL_BIT, 0},  // FIFO is physically larger
-      });
   EXPECT_DIF_OK(dif_usbdev_fill_available_fifos(&usbdev_, &buffer_pool));
 
   // No read data available yet.
@@ -820,6 +806,109 @@ TEST_F(UsbdevTest, InPacket) {
       dif_usbdev_clear_tx_status(&usbdev_, &buffer_pool, /*endpoint=*/5));
 }
 
+TEST_F(UsbdevTest, InPlaceBuffer) {
+  dif_usbdev_buffer_pool_t buffer_pool;
+  dif_usbdev_config_t phy_config = {
+      .have_differential_receiver = kDifToggleEnabled,
+      .use_tx_d_se0 = kDifToggleDisabled,
+      .single_bit_eop = kDifToggleDisabled,
+      .pin_flip = kDifToggleDisabled,
+      .clock_sync_signals = kDifToggleEnabled,
+  };
+  EXPECT_WRITE32(USBDEV_PHY_CONFIG_REG_OFFSET,
+                 {
+                     {USBDEV_PHY_CONFIG_USE_DIFF_RCVR_BIT, 1},
+                     {USBDEV_PHY_CONFIG_TX_USE_D_SE0_BIT, 0},
+                     {USBDEV_PHY_CONFIG_EOP_SINGLE_BIT_BIT, 0},
+                     {USBDEV_PHY_CONFIG_PINFLIP_BIT, 0},
+                     {USBDEV_PHY_CONFIG_USB_REF_DISABLE_BIT, 0},
+                 });
+  EXPECT_DIF_OK(dif_usbdev_configure(&usbdev_, &buffer_pool, phy_config));
+
+  // Fill an outgoing packet in place.
+  dif_usbdev_buffer_t buffer;
+  dif_usbdev_buffer_view_t view;
+  EXPECT_DIF_OK(dif_usbdev_buffer_request(&usbdev_, &buffer_pool, &buffer));
+  EXPECT_DIF_OK(dif_usbdev_buffer_map(&usbdev_, &buffer, &view));
+  EXPECT_EQ(view.offset, USBDEV_BUFFER_REG_OFFSET + buffer.id * 64);
+  EXPECT_EQ(view.length, 64);
+
+  EXPECT_WRITE32(view.offset, 0x03020100);
+  mmio_region_write32(view.region, view.offset, 0x03020100);
+  EXPECT_DIF_OK(dif_usbdev_buffer_commit(&usbdev_, &buffer, 4));
+  EXPECT_EQ(buffer.offset, 4);
+  EXPECT_EQ(buffer.remaining_bytes, 60);
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_commit(&usbdev_, &buffer, 61));
+  EXPECT_DIF_OK(dif_usbdev_buffer_map(&usbdev_, &buffer, &view));
+  EXPECT_EQ(view.offset, USBDEV_BUFFER_REG_OFFSET + buffer.id * 64 + 4);
+  EXPECT_EQ(view.length, 60);
+  EXPECT_DIF_OK(dif_usbdev_buffer_return(&usbdev_, &buffer_pool, &buffer));
+
+  // Consume an incoming packet in place; the buffer returns to the pool once
+  // it has been fully consumed.
+  EXPECT_DIF_OK(dif_usbdev_buffer_request(&usbdev_, &buffer_pool, &buffer));
+  buffer.remaining_bytes = 6;
+  buffer.type = kDifUsbdevBufferTypeRead;
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_commit(&usbdev_, &buffer, 1));
+  EXPECT_DIF_OK(dif_usbdev_buffer_map(&usbdev_, &buffer, &view));
+  EXPECT_EQ(view.length, 6);
+  EXPECT_DIF_OK(dif_usbdev_buffer_consume(&usbdev_, &buffer_pool, &buffer, 4));
+  EXPECT_EQ(buffer.type, kDifUsbdevBufferTypeRead);
+  EXPECT_DIF_BADARG(
+      dif_usbdev_buffer_consume(&usbdev_, &buffer_pool, &buffer, 3));
+  EXPECT_DIF_OK(dif_usbdev_buffer_consume(&usbdev_, &buffer_pool, &buffer, 2));
+  EXPECT_EQ(buffer.type, kDifUsbdevBufferTypeStale);
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_map(&usbdev_, &buffer, &view));
+}
+
+TEST_F(UsbdevTest, RecvBatch) {
+  dif_usbdev_rx_packet_info_t info[2];
+  dif_usbdev_buffer_t buffers[2];
+  size_t num_packets;
+
+  EXPECT_DIF_BADARG(
+      dif_usbdev_recv_batch(nullptr, info, buffers, 2, &num_packets));
+  EXPECT_DIF_BADARG(
+      dif_usbdev_recv_batch(&usbdev_, info, buffers, 2, nullptr));
+
+  // Nothing received.
+  EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET, {{USBDEV_USBSTAT_RX_EMPTY_BIT, 1}});
+  EXPECT_DIF_OK(
+      dif_usbdev_recv_batch(&usbdev_, info, buffers, 2, &num_packets));
+  EXPECT_EQ(num_packets, 0);
+
+  // Three packets queued; only as many as requested are popped.
+  EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET,
+                {{USBDEV_USBSTAT_RX_DEPTH_OFFSET, 3}});
+  EXPECT_READ32(USBDEV_RXFIFO_REG_OFFSET,
+                {
+                    {USBDEV_RXFIFO_EP_OFFSET, 1},
+                    {USBDEV_RXFIFO_SETUP_BIT, 0},
+                    {USBDEV_RXFIFO_SIZE_OFFSET, 64},
+                    {USBDEV_RXFIFO_BUFFER_OFFSET, 5},
+                });
+  EXPECT_READ32(USBDEV_RXFIFO_REG_OFFSET,
+                {
+                    {USBDEV_RXFIFO_EP_OFFSET, 0},
+                    {USBDEV_RXFIFO_SETUP_BIT, 1},
+                    {USBDEV_RXFIFO_SIZE_OFFSET, 8},
+                    {USBDEV_RXFIFO_BUFFER_OFFSET, 6},
+                });
+  EXPECT_DIF_OK(
+      dif_usbdev_recv_batch(&usbdev_, info, buffers, 2, &num_packets));
+  EXPECT_EQ(num_packets, 2);
+  EXPECT_EQ(info[0].endpoint, 1);
+  EXPECT_EQ(info[0].length, 64);
+  EXPECT_FALSE(info[0].is_setup);
+  EXPECT_EQ(buffers[0].id, 5);
+  EXPECT_EQ(buffers[0].remaining_bytes, 64);
+  EXPECT_EQ(buffers[0].type, kDifUsbdevBufferTypeRead);
+  EXPECT_EQ(info[1].endpoint, 0);
+  EXPECT_EQ(info[1].length, 8);
+  EXPECT_TRUE(info[1].is_setup);
+  EXPECT_EQ(buffers[1].id, 6);
+}
+
 TEST_F(UsbdevTest, DeviceAddresses) {
   uint8_t address = 101;
   EXPECT_READ32(USBDEV_USBCTRL_REG_OFFSET,
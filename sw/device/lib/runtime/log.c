@@ -9,6 +9,7 @@
 #include "sw/device/lib/arch/device.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/status.h"
 #include "sw/device/lib/runtime/print.h"
 
 /**
@@ -93,3 +94,174 @@ void base_log_internal_dv(const log_fields_t *log, uint32_t nargs, ...) {
   }
   va_end(args);
 }
+
+enum {
+  /**
+   * The first byte of each binary log record.
+   */
+  kLogBinaryRecordStart = 0x1e,
+  /**
+   * The size of the buffer that binary log records are built in; records that
+   * are longer than this are written in several pieces.
+   */
+  kLogBinaryBufferLen = 32,
+  /**
+   * The maximum length of a ULEB128-encoded `uint32_t`.
+   */
+  kLogBinaryMaxUlebLen = 5,
+};
+
+/**
+ * A binary log record that is being written to stdout.
+ */
+typedef struct log_binary_record {
+  char buf[kLogBinaryBufferLen];
+  size_t len;
+} log_binary_record_t;
+
+/**
+ * Writes out the buffered part of `record`.
+ */
+static void log_binary_flush(log_binary_record_t *record) {
+  if (record->len > 0) {
+    base_printf("%!s", record->len, record->buf);
+    record->len = 0;
+  }
+}
+
+/**
+ * Appends `value` to `record` as a ULEB128 value.
+ */
+static void log_binary_put_word(log_binary_record_t *record, uint32_t value) {
+  if (record->len > kLogBinaryBufferLen - kLogBinaryMaxUlebLen) {
+    log_binary_flush(record);
+  }
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) {
+      byte |= 0x80;
+    }
+    record->buf[record->len++] = (char)byte;
+  } while (value != 0);
+}
+
+/**
+ * Appends `len` and then the `len` bytes at `bytes` to `record`.
+ */
+static void log_binary_put_bytes(log_binary_record_t *record,
+                                 const char *bytes, size_t len) {
+  log_binary_put_word(record, len);
+  log_binary_flush(record);
+  base_printf("%!s", len, bytes);
+}
+
+/**
+ * Logs `log` and the values that follow to stdout as a binary record.
+ *
+ * See log.h for the record format. This only walks the format string to find
+ * the type of each argument, following the same rules as `base_vfprintf()`,
+ * so that the host can split the record back up in the same way.
+ *
+ * @param log the log data to log.
+ * @param ... format parameters matching the format string.
+ */
+void base_log_internal_binary(const log_fields_t *log, ...) {
+  log_binary_record_t record = {.len = 0};
+  record.buf[record.len++] = kLogBinaryRecordStart;
+  log_binary_put_word(&record, (uintptr_t)log);
+
+  va_list args;
+  va_start(args, log);
+  const char *format = log->format;
+  while (true) {
+    while (*format != '\0' && *format != '%') {
+      ++format;
+    }
+    if (*format == '\0') {
+      break;
+    }
+    ++format;
+
+    bool is_nonstd = *format == '!';
+    if (is_nonstd) {
+      ++format;
+    }
+    // Widths don't affect the arguments, but bad widths end the formatting.
+    char padding = 0;
+    uint32_t width = 0;
+    for (; *format >= '0' && *format <= '9'; ++format) {
+      if (padding == 0) {
+        padding = *format == '0' ? '0' : ' ';
+      }
+      width = width * 10 + (uint32_t)(*format - '0');
+    }
+    if (*format == '\0' || (width == 0 && padding != 0) || width > 32) {
+      break;
+    }
+
+    switch (*format++) {
+      case 's': {
+        size_t len = 0;
+        if (is_nonstd) {
+          len = va_arg(args, size_t);
+        }
+        const char *value = va_arg(args, const char *);
+        if (!is_nonstd) {
+          len = (size_t)((const char *)memchr(value, '\0', PTRDIFF_MAX) -
+                         value);
+        }
+        log_binary_put_bytes(&record, value, len);
+        break;
+      }
+      case 'x':
+      case 'X':
+      case 'y':
+      case 'Y': {
+        if (is_nonstd) {
+          size_t len = va_arg(args, size_t);
+          const char *value = va_arg(args, const char *);
+          log_binary_put_bytes(&record, value, len);
+        } else if (format[-1] == 'x' || format[-1] == 'X') {
+          log_binary_put_word(&record, va_arg(args, uint32_t));
+        }
+        break;
+      }
+      case 'c':
+      case 'd':
+      case 'i':
+      case 'o':
+      case 'u':
+        if (!is_nonstd) {
+          log_binary_put_word(&record, va_arg(args, uint32_t));
+        }
+        break;
+      case 'p':
+        if (!is_nonstd) {
+          log_binary_put_word(&record, (uint32_t)va_arg(args, uintptr_t));
+        }
+        break;
+      case 'b':
+        // %!b takes a bool, which is promoted to int.
+        log_binary_put_word(&record, is_nonstd ? (uint32_t)va_arg(args, int)
+                                               : va_arg(args, uint32_t));
+        break;
+      case 'h':
+      case 'H':
+      case 'C':
+        log_binary_put_word(&record, va_arg(args, uint32_t));
+        break;
+      case 'r': {
+        status_t value = va_arg(args, status_t);
+        log_binary_put_word(&record, (uint32_t)value.value);
+        break;
+      }
+      default:
+        // This includes %%, and unknown specifiers, which take no arguments.
+        break;
+    }
+  }
+  va_end(args);
+
+  log_binary_flush(&record);
+}
@@ -36,6 +36,18 @@
  * in print.h. DV testbenches may use an alternative, more efficient mechanism.
  *
  * In DV mode, some format specifiers may be unsupported, such as %s.
+ *
+ * When built with `OT_LOG_BINARY` (set with the Bazel flag
+ * `--//sw/device/lib/runtime:log_format=binary`), logs are instead written to
+ * `stdout` as compact binary records, which must be rendered on the host using
+ * the ELF file, for example with `opentitantool console --log-elf`. Each record
+ * is the byte 0x1e (ASCII record separator), followed by the address of the
+ * `log_fields_t` for the log line and then by the arguments, all as ULEB128
+ * values. The contents of `%s`, `%!s` and the `%!x`-style hex dumps are sent
+ * inline, as a ULEB128 length followed by that many bytes. This skips the
+ * formatting on the device, and typically shrinks a log line to a few bytes.
+ * Output that doesn't come from the log macros, such as `base_printf()`, is
+ * unaffected.
  */
 
 /**
@@ -97,6 +109,19 @@ void base_log_internal_core(const log_fields_t *log, ...);
  * Implementation detail.
  */
 void base_log_internal_dv(const log_fields_t *log, uint32_t nargs, ...);
+/**
+ * Implementation detail.
+ */
+void base_log_internal_binary(const log_fields_t *log, ...);
+
+/**
+ * Implementation detail of `LOG`.
+ */
+#ifdef OT_LOG_BINARY
+#define LOG_INTERNAL_UART_ base_log_internal_binary
+#else
+#define LOG_INTERNAL_UART_ base_log_internal_core
+#endif
 
 /**
  * Basic logging macro that all other logging macros delegate to.
@@ -125,7 +150,7 @@ void base_log_internal_dv(const log_fields_t *log, uint32_t nargs, ...);
     } else {                                                     \
       static const log_fields_t log_fields =                     \
           LOG_MAKE_FIELDS_(severity, format, ##__VA_ARGS__);     \
-      base_log_internal_core(&log_fields, ##__VA_ARGS__);        \
+      LOG_INTERNAL_UART_(&log_fields, ##__VA_ARGS__);            \
     }                                                            \
   } while (false)
 
@@ -83,6 +83,63 @@ void base_uart_stdout(const dif_uart_t *uart) {
       (buffer_sink_t){.data = (void *)uart, .sink = &base_dev_uart});
 }
 
+/**
+ * State of the buffered UART stdout, see `base_uart_buffered_stdout()`.
+ */
+static struct {
+  const dif_uart_t *uart;
+  dif_uart_async_t async;
+} uart_buffered;
+
+static size_t base_dev_uart_buffered(void *data, const char *buf, size_t len) {
+  const dif_uart_t *uart = (const dif_uart_t *)data;
+  size_t sent = 0;
+  while (sent < len) {
+    // When the buffer is full, fall back to waiting for the UART rather than
+    // dropping output; each call moves buffered bytes into the FIFO first.
+    size_t queued = 0;
+    if (dif_uart_async_send(uart, &uart_buffered.async,
+                            (const uint8_t *)&buf[sent], len - sent,
+                            &queued) != kDifOk) {
+      break;
+    }
+    sent += queued;
+  }
+  return sent;
+}
+
+void base_uart_buffered_stdout(const dif_uart_t *uart, char *buf, size_t len) {
+  if (buf == NULL ||
+      dif_uart_async_init(&uart_buffered.async, (uint8_t *)buf, len, NULL,
+                          0) != kDifOk) {
+    base_uart_stdout(uart);
+    return;
+  }
+  uart_buffered.uart = uart;
+  base_set_stdout(
+      (buffer_sink_t){.data = (void *)uart, .sink = &base_dev_uart_buffered});
+}
+
+size_t base_uart_buffered_stdout_drain(void) {
+  if (base_stdout.sink != &base_dev_uart_buffered) {
+    return 0;
+  }
+  size_t left = 0;
+  if (dif_uart_async_tx_isr(uart_buffered.uart, &uart_buffered.async,
+                            &left) != kDifOk) {
+    return 0;
+  }
+  return left;
+}
+
+void base_stdout_flush(void) {
+  if (base_stdout.sink != &base_dev_uart_buffered) {
+    return;
+  }
+  OT_DISCARD(
+      dif_uart_async_tx_flush(uart_buffered.uart, &uart_buffered.async));
+}
+
 size_t base_printf(const char *format, ...) {
   va_list args;
   va_start(args, format);
@@ -290,4 +290,45 @@ void base_set_stdout(buffer_sink_t out);
  */
 void base_uart_stdout(const dif_uart_t *uart);
 
+/**
+ * Configures a buffered, interrupt-driven UART stdout for `base_print.h` to
+ * use.
+ *
+ * Printed bytes are copied into `buf` and moved into the UART TX FIFO as space
+ * becomes available, so printing does not wait for the UART unless `buf` is
+ * full. Whenever bytes are left over, the UART's TX watermark interrupt is
+ * enabled; its handler must call `base_uart_buffered_stdout_drain()`. If that
+ * interrupt is not routed to the CPU, buffered bytes are only sent by later
+ * prints or by `base_stdout_flush()`.
+ *
+ * Like `base_uart_stdout()`, this function saves `uart` and `buf` in a global
+ * variable, so both must have static storage duration.
+ *
+ * @param uart The UART handle to use for stdout.
+ * @param buf Storage for buffered bytes.
+ * @param len The size of `buf`, which must be a power of two; otherwise the
+ * unbuffered `base_uart_stdout()` is used instead.
+ */
+void base_uart_buffered_stdout(const dif_uart_t *uart, char *buf, size_t len);
+
+/**
+ * Moves buffered stdout bytes into the UART TX FIFO.
+ *
+ * This should be called from the handler for the TX watermark interrupt of the
+ * UART passed to `base_uart_buffered_stdout()`. The interrupt is masked once
+ * the buffer is empty.
+ *
+ * @return The number of bytes still buffered.
+ */
+size_t base_uart_buffered_stdout_drain(void);
+
+/**
+ * Waits until all buffered stdout bytes are in the UART TX FIFO.
+ *
+ * This does not rely on interrupts, so it can be used from exception handlers
+ * and before halting. It does nothing unless stdout was configured with
+ * `base_uart_buffered_stdout()`.
+ */
+void base_stdout_flush(void);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_RUNTIME_PRINT_H_
@@ -0,0 +1,78 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/adc_ctrl_testutils.h"
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/dif/dif_adc_ctrl.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/irq.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+
+#define MODULE_ID MAKE_MODULE_ID('a', 'd', 't')
+
+status_t adc_ctrl_testutils_sampler_start(adc_ctrl_testutils_sampler_t *sampler,
+                                          const dif_adc_ctrl_t *adc_ctrl,
+                                          dif_adc_ctrl_mode_t mode,
+                                          adc_ctrl_testutils_sample_t *samples,
+                                          size_t capacity) {
+  TRY_CHECK(sampler != NULL && adc_ctrl != NULL && samples != NULL);
+  TRY_CHECK(capacity > 0);
+
+  sampler->adc_ctrl = adc_ctrl;
+  sampler->mode = mode;
+  sampler->samples = samples;
+  sampler->capacity = capacity;
+  sampler->count = 0;
+
+  TRY(dif_adc_ctrl_irq_clear_causes(adc_ctrl, kDifAdcCtrlIrqCauseAll));
+  if (mode == kDifAdcCtrlOneshotMode) {
+    TRY(dif_adc_ctrl_irq_cause_set_enabled(adc_ctrl, kDifAdcCtrlIrqCauseOneshot,
+                                           kDifToggleEnabled));
+  }
+  TRY(dif_adc_ctrl_set_enabled(adc_ctrl, kDifToggleEnabled));
+
+  return OK_STATUS();
+}
+
+status_t adc_ctrl_testutils_sampler_irq_handler(
+    adc_ctrl_testutils_sampler_t *sampler) {
+  const dif_adc_ctrl_t *adc_ctrl = sampler->adc_ctrl;
+  size_t count = sampler->count;
+
+  uint32_t causes;
+  TRY(dif_adc_ctrl_irq_get_causes(adc_ctrl, &causes));
+  if (causes == 0 || count >= sampler->capacity) {
+    return OK_STATUS();
+  }
+
+  adc_ctrl_testutils_sample_t *sample = &sampler->samples[count];
+  sample->timestamp = ibex_mcycle_read();
+  sample->causes = causes;
+  TRY(dif_adc_ctrl_get_triggered_value(adc_ctrl, kDifAdcCtrlChannel0,
+                                       &sample->values[kDifAdcCtrlChannel0]));
+  TRY(dif_adc_ctrl_get_triggered_value(adc_ctrl, kDifAdcCtrlChannel1,
+                                       &sample->values[kDifAdcCtrlChannel1]));
+  TRY(dif_adc_ctrl_irq_clear_causes(adc_ctrl, causes));
+  ++count;
+
+  if (count == sampler->capacity) {
+    TRY(dif_adc_ctrl_set_enabled(adc_ctrl, kDifToggleDisabled));
+  } else if (sampler->mode == kDifAdcCtrlOneshotMode) {
+    // A oneshot conversion leaves the sampling FSM powered down; toggling the
+    // enable triggers the next one.
+    TRY(dif_adc_ctrl_set_enabled(adc_ctrl, kDifToggleDisabled));
+    TRY(dif_adc_ctrl_set_enabled(adc_ctrl, kDifToggleEnabled));
+  }
+  sampler->count = count;
+
+  return OK_STATUS();
+}
+
+status_t adc_ctrl_testutils_sampler_wait(
+    const adc_ctrl_testutils_sampler_t *sampler) {
+  TRY_CHECK(sampler != NULL);
+  ATOMIC_WAIT_FOR_INTERRUPT(sampler->count >= sampler->capacity);
+  return OK_STATUS();
+}
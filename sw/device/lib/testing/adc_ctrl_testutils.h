@@ -0,0 +1,97 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_ADC_CTRL_TESTUTILS_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_ADC_CTRL_TESTUTILS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_adc_ctrl.h"
+
+/**
+ * A sample collected by the interrupt-driven sampler.
+ */
+typedef struct adc_ctrl_testutils_sample {
+  /**
+   * Value of each channel when the interrupt was raised, indexed by
+   * `dif_adc_ctrl_channel_t`.
+   */
+  uint16_t values[ADC_CTRL_PARAM_NUM_ADC_CHANNEL];
+  /**
+   * Interrupt causes (`dif_adc_ctrl_irq_cause_t` bits) that were pending.
+   */
+  uint32_t causes;
+  /**
+   * Value of the `mcycle` counter when the sample was collected.
+   */
+  uint64_t timestamp;
+} adc_ctrl_testutils_sample_t;
+
+/**
+ * State of the interrupt-driven sampler.
+ *
+ * The fields are private to the sampler and must not be modified while it is
+ * running.
+ */
+typedef struct adc_ctrl_testutils_sampler {
+  const dif_adc_ctrl_t *adc_ctrl;
+  dif_adc_ctrl_mode_t mode;
+  adc_ctrl_testutils_sample_t *samples;
+  size_t capacity;
+  volatile size_t count;
+} adc_ctrl_testutils_sampler_t;
+
+/**
+ * Starts collecting samples into a caller-provided buffer.
+ *
+ * The ADC Controller must already be configured with `dif_adc_ctrl_configure()`
+ * in `mode`; in the scan modes, its filters must also be configured to raise
+ * interrupts. This clears any pending causes, enables the oneshot interrupt
+ * cause when `mode` is `kDifAdcCtrlOneshotMode`, and enables the ADC
+ * Controller. The test must route the `match_pending` interrupt to
+ * `adc_ctrl_testutils_sampler_irq_handler()`.
+ *
+ * @param sampler Sampler state.
+ * @param adc_ctrl An adc_ctrl handle.
+ * @param mode The mode the ADC Controller is configured in.
+ * @param[out] samples Buffer for the collected samples.
+ * @param capacity Number of samples to collect; must be non-zero.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t adc_ctrl_testutils_sampler_start(adc_ctrl_testutils_sampler_t *sampler,
+                                          const dif_adc_ctrl_t *adc_ctrl,
+                                          dif_adc_ctrl_mode_t mode,
+                                          adc_ctrl_testutils_sample_t *samples,
+                                          size_t capacity);
+
+/**
+ * Collects one sample; to be called from the test's external ISR.
+ *
+ * Records the triggered value of each channel with a timestamp and clears the
+ * pending causes. In oneshot mode the next conversion is triggered right away.
+ * The ADC Controller is disabled once the buffer is full.
+ *
+ * @param sampler Sampler state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t adc_ctrl_testutils_sampler_irq_handler(
+    adc_ctrl_testutils_sampler_t *sampler);
+
+/**
+ * Sleeps until the sampler buffer is full.
+ *
+ * Interrupts must be enabled globally and at the PLIC.
+ *
+ * @param sampler Sampler state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t adc_ctrl_testutils_sampler_wait(
+    const adc_ctrl_testutils_sampler_t *sampler);
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_ADC_CTRL_TESTUTILS_H_
@@ -115,11 +115,22 @@ status_t alert_handler_testutils_configure_all(
       config.ping_timeout <=
       ALERT_HANDLER_PING_TIMEOUT_CYC_SHADOWED_PING_TIMEOUT_CYC_SHADOWED_MASK);
 
-  // Configure and enable the requested alerts.
-  for (int i = 0; i < config.alerts_len; ++i) {
-    TRY(dif_alert_handler_configure_alert(alert_handler, config.alerts[i],
-                                          config.alert_classes[i],
-                                          kDifToggleEnabled, locked));
+  // Configure and enable the requested alerts in bulk. As with individual
+  // configuration, the last class given for an alert wins.
+  if (config.alerts_len > 0) {
+    dif_alert_handler_alert_classes_t alert_classes = {0};
+    for (int i = 0; i < config.alerts_len; ++i) {
+      dif_alert_handler_alert_t alert = config.alerts[i];
+      dif_alert_handler_class_t alert_class = config.alert_classes[i];
+      TRY_CHECK(alert < ALERT_HANDLER_PARAM_N_ALERTS);
+      TRY_CHECK(alert_class < ARRAYSIZE(alert_classes.class_masks));
+      for (size_t c = 0; c < ARRAYSIZE(alert_classes.class_masks); ++c) {
+        alert_classes.class_masks[c][alert / 32] &= ~(1u << (alert % 32));
+      }
+      alert_classes.class_masks[alert_class][alert / 32] |= 1u << (alert % 32);
+    }
+    TRY(dif_alert_handler_configure_alerts(alert_handler, &alert_classes,
+                                           locked));
   }
 
   // Configure and enable the requested local alerts.
@@ -211,6 +211,30 @@ status_t entropy_testutils_drain_observe_fifo(dif_entropy_src_t *entropy_src) {
   return OK_STATUS();
 }
 
+status_t entropy_testutils_observe_fifo_stream(dif_entropy_src_t *entropy_src,
+                                               buffer_sink_t out, uint32_t *buf,
+                                               size_t buf_len,
+                                               size_t nr_words) {
+  TRY_CHECK(buf != NULL && buf_len > 0);
+  entropy_testutils_stream_frame_header_t header = {
+      .magic = kEntropyTestutilsStreamFrameMagic,
+      .seq = 0,
+  };
+  while (nr_words > 0) {
+    size_t len = nr_words < buf_len ? nr_words : buf_len;
+    TRY(dif_entropy_src_observe_fifo_bulk_read(entropy_src, buf, len));
+    header.len = (uint32_t)len;
+    size_t payload_size = len * sizeof(uint32_t);
+    TRY_CHECK(out.sink(out.data, (const char *)&header, sizeof(header)) ==
+              sizeof(header));
+    TRY_CHECK(out.sink(out.data, (const char *)buf, payload_size) ==
+              payload_size);
+    ++header.seq;
+    nr_words -= len;
+  }
+  return OK_STATUS();
+}
+
 status_t entropy_testutils_stop_csrng_edn(void) {
   const dif_csrng_t csrng = {
       .base_addr = mmio_region_from_addr(TOP_EARLGREY_CSRNG_BASE_ADDR)};
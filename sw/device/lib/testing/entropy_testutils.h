@@ -9,6 +9,7 @@
 #include "sw/device/lib/dif/dif_csrng.h"
 #include "sw/device/lib/dif/dif_edn.h"
 #include "sw/device/lib/dif/dif_entropy_src.h"
+#include "sw/device/lib/runtime/print.h"
 
 /**
  * Returns default entropy source configuration.
@@ -59,6 +60,57 @@ status_t entropy_testutils_fw_override_enable(dif_entropy_src_t *entropy_src,
 OT_WARN_UNUSED_RESULT
 status_t entropy_testutils_drain_observe_fifo(dif_entropy_src_t *entropy_src);
 
+enum {
+  /**
+   * Magic value of an observe FIFO stream frame header (ASCII "ESOF").
+   */
+  kEntropyTestutilsStreamFrameMagic = 0x464f5345,
+};
+
+/**
+ * Header of a binary frame of raw observe FIFO samples.
+ *
+ * Each frame consists of this header followed by `len` little-endian words
+ * read from the observe FIFO.
+ */
+typedef struct entropy_testutils_stream_frame_header {
+  /**
+   * Frame magic, `kEntropyTestutilsStreamFrameMagic`.
+   */
+  uint32_t magic;
+  /**
+   * Sequence number of the frame, starting at 0. A gap means a frame was lost
+   * by the receiver.
+   */
+  uint32_t seq;
+  /**
+   * Number of sample words following the header.
+   */
+  uint32_t len;
+} entropy_testutils_stream_frame_header_t;
+
+/**
+ * Streams raw observe FIFO samples to `out` in binary frames.
+ *
+ * The entropy source must be in firmware override mode. Samples are read with
+ * `dif_entropy_src_observe_fifo_bulk_read()` into `buf` and forwarded as one
+ * frame per filled buffer, so `buf_len` should be a multiple of the observe
+ * FIFO threshold. `out` can be any byte sink, e.g. the OTTF console UART or an
+ * SPI device upload buffer.
+ *
+ * @param entropy_src Entropy source handle.
+ * @param out Sink the frames are written to.
+ * @param buf Scratch buffer for one frame of samples.
+ * @param buf_len Length of `buf` in words.
+ * @param nr_words Total number of sample words to stream.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t entropy_testutils_observe_fifo_stream(dif_entropy_src_t *entropy_src,
+                                               buffer_sink_t out, uint32_t *buf,
+                                               size_t buf_len,
+                                               size_t nr_words);
+
 /**
  * Waits for the entropy_src to reach a certain state.
  *
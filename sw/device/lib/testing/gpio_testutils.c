@@ -0,0 +1,62 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/gpio_testutils.h"
+
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/dif/dif_gpio.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+
+#include "gpio_regs.h"  // Generated
+
+#define MODULE_ID MAKE_MODULE_ID('g', 'p', 't')
+
+/**
+ * Spins until the cycle counter reaches `deadline`.
+ */
+static inline void wait_until(uint64_t deadline) {
+  while (ibex_mcycle_read() < deadline) {
+  }
+}
+
+status_t gpio_testutils_sequence_play(const dif_gpio_t *gpio,
+                                      const gpio_testutils_step_t *steps,
+                                      size_t num_steps) {
+  TRY_CHECK(gpio != NULL);
+  TRY_CHECK(steps != NULL || num_steps == 0);
+
+  // A zero mask in either half makes the corresponding write a no-op, so both
+  // halves are always written to keep the per-step cost constant.
+  uint64_t deadline = ibex_mcycle_read();
+  for (size_t i = 0; i < num_steps; ++i) {
+    const uint32_t mask = steps[i].mask;
+    const uint32_t value = steps[i].value;
+    mmio_region_write32(gpio->base_addr, GPIO_MASKED_OUT_LOWER_REG_OFFSET,
+                        (mask << 16) | (value & 0x0000FFFFu));
+    mmio_region_write32(gpio->base_addr, GPIO_MASKED_OUT_UPPER_REG_OFFSET,
+                        (mask & 0xFFFF0000u) | (value >> 16));
+    deadline += steps[i].delay_cycles;
+    wait_until(deadline);
+  }
+
+  return OK_STATUS();
+}
+
+status_t gpio_testutils_capture_burst(const dif_gpio_t *gpio,
+                                      uint32_t interval_cycles,
+                                      dif_gpio_state_t *samples,
+                                      size_t num_samples) {
+  TRY_CHECK(gpio != NULL);
+  TRY_CHECK(samples != NULL || num_samples == 0);
+
+  uint64_t deadline = ibex_mcycle_read();
+  for (size_t i = 0; i < num_samples; ++i) {
+    wait_until(deadline);
+    samples[i] = mmio_region_read32(gpio->base_addr, GPIO_DATA_IN_REG_OFFSET);
+    deadline += interval_cycles;
+  }
+
+  return OK_STATUS();
+}
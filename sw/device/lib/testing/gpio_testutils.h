@@ -0,0 +1,71 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_GPIO_TESTUTILS_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_GPIO_TESTUTILS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_gpio.h"
+
+/**
+ * A single step of a GPIO waveform.
+ *
+ * The pins selected by `mask` are driven to the corresponding bits of
+ * `value`; all other pins are left untouched, as with
+ * `dif_gpio_write_masked()`. The new levels are held for `delay_cycles` CPU
+ * cycles, measured from the start of this step to the start of the next one.
+ */
+typedef struct gpio_testutils_step {
+  dif_gpio_mask_t mask;
+  dif_gpio_state_t value;
+  uint32_t delay_cycles;
+} gpio_testutils_step_t;
+
+/**
+ * Plays a waveform on the GPIO outputs.
+ *
+ * Writes the MASKED_OUT_LOWER/UPPER registers directly for each step and paces
+ * the steps against the `mcycle` counter, so that edges land at fixed cycle
+ * offsets from the start of the sequence regardless of the loop overhead. Both
+ * halves are written on every step so that each step takes the same number of
+ * instructions; a delay shorter than that overhead plays the step as fast as
+ * possible instead. The call returns once the delay of the last step has
+ * elapsed.
+ *
+ * The output enables and pinmux must already be configured by the caller.
+ *
+ * @param gpio A GPIO handle.
+ * @param steps Steps to play, in order.
+ * @param num_steps Number of entries in `steps`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t gpio_testutils_sequence_play(const dif_gpio_t *gpio,
+                                      const gpio_testutils_step_t *steps,
+                                      size_t num_steps);
+
+/**
+ * Samples the GPIO inputs at a fixed interval.
+ *
+ * Reads the DATA_IN register `num_samples` times, `interval_cycles` CPU cycles
+ * apart, the first sample being taken immediately. As with
+ * `gpio_testutils_sequence_play()`, an interval shorter than the loop overhead
+ * yields back-to-back samples.
+ *
+ * @param gpio A GPIO handle.
+ * @param interval_cycles Number of CPU cycles between two samples.
+ * @param[out] samples Buffer for the sampled pin states.
+ * @param num_samples Number of samples to take.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t gpio_testutils_capture_burst(const dif_gpio_t *gpio,
+                                      uint32_t interval_cycles,
+                                      dif_gpio_state_t *samples,
+                                      size_t num_samples);
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_GPIO_TESTUTILS_H_
@@ -4,54 +4,164 @@
 
 #include "sw/device/lib/testing/hexstr.h"
 
+#include <stdbool.h>
+
 static const char hex[] = "0123456789abcdef";
 
+/**
+ * Loads four bytes as a little-endian word.
+ *
+ * Hex strings and binary buffers have no alignment guarantee, so the word is
+ * assembled from byte loads.
+ */
+static inline uint32_t load_le32(const uint8_t *src) {
+  return (uint32_t)src[0] | (uint32_t)src[1] << 8 | (uint32_t)src[2] << 16 |
+         (uint32_t)src[3] << 24;
+}
+
+static inline void store_le32(uint8_t *dst, uint32_t word) {
+  dst[0] = (uint8_t)word;
+  dst[1] = (uint8_t)(word >> 8);
+  dst[2] = (uint8_t)(word >> 16);
+  dst[3] = (uint8_t)(word >> 24);
+}
+
+/**
+ * Encodes the four bytes of `word` (least significant first) as eight hex
+ * digits.
+ */
+static inline void encode_word(char *dst, uint32_t word) {
+  for (size_t i = 0; i < 4; ++i, word >>= 8) {
+    dst[2 * i] = hex[(word >> 4) & 15];
+    dst[2 * i + 1] = hex[word & 15];
+  }
+}
+
+/**
+ * Sets the top bit of each byte of `word` that lies in `[lo, hi]`.
+ *
+ * All bytes of `word` must be below 0x80 so that no carry crosses a byte.
+ */
+#define SWAR_IN_RANGE(word, lo, hi)                          \
+  (((word) + (0x80u - (lo)) * 0x01010101u) &                 \
+   ~((word) + (0x7fu - (hi)) * 0x01010101u) & 0x80808080u)
+
+/**
+ * Decodes four hex digits (first digit in the least significant byte) into two
+ * bytes.
+ *
+ * All four digits are validated at once without branching on the input.
+ *
+ * @param chars Four hex digits.
+ * @param[out] bytes The decoded bytes, first byte in the least significant
+ *                   byte.
+ * @return Whether all four digits are valid.
+ */
+static inline bool decode_word(uint32_t chars, uint32_t *bytes) {
+  uint32_t ascii = ~chars & 0x80808080u;
+  uint32_t low7 = chars & 0x7f7f7f7fu;
+  uint32_t digit = SWAR_IN_RANGE(low7, '0', '9');
+  // Setting bit 5 maps 'A'-'F' onto 'a'-'f' and nothing else onto them.
+  uint32_t alpha = SWAR_IN_RANGE(low7 | 0x20202020u, 'a', 'f');
+  // '0'-'9' have their value in the low nibble, 'a'-'f' have it minus 9.
+  uint32_t nibbles = (chars & 0x0f0f0f0fu) + (alpha >> 7) * 9;
+  uint32_t pairs = ((nibbles << 4) | (nibbles >> 8)) & 0x00ff00ffu;
+  *bytes = (pairs & 0xffu) | ((pairs >> 8) & 0xff00u);
+  return ((digit | alpha) & ascii) == 0x80808080u;
+}
+
+static size_t hexstr_len(const char *src) {
+  size_t len = 0;
+  while (src[len] != '\0') {
+    ++len;
+  }
+  return len;
+}
+
 status_t hexstr_encode(char *dst, size_t dst_size, const void *src,
                        size_t src_size) {
+  if (dst_size == 0 || src_size > (dst_size - 1) / 2) {
+    return INVALID_ARGUMENT();
+  }
   const uint8_t *data = (const uint8_t *)src;
+  for (; src_size >= 4; src_size -= 4, data += 4, dst += 8) {
+    encode_word(dst, load_le32(data));
+  }
   for (; src_size > 0; --src_size, ++data) {
-    if (dst_size < 3) {
-      return INVALID_ARGUMENT();
-    }
     *dst++ = hex[*data >> 4];
     *dst++ = hex[*data & 15];
-    dst_size -= 2;
   }
   *dst = '\0';
   return OK_STATUS();
 }
 
-static status_t decode_nibble(char ch) {
-  if (ch == 0) {
-    // Unexpected end of string.
+status_t hexstr_encode_inplace(char *buf, size_t buf_size, size_t src_size) {
+  if (buf_size == 0 || src_size > (buf_size - 1) / 2) {
     return INVALID_ARGUMENT();
   }
-  int nibble = (ch >= '0' && ch <= '9')   ? ch - '0'
-               : (ch >= 'A' && ch <= 'F') ? ch - 'A' + 10
-               : (ch >= 'a' && ch <= 'f') ? ch - 'a' + 10
-                                          : -1;
-  if (nibble == -1) {
+  uint8_t *data = (uint8_t *)buf;
+  buf[2 * src_size] = '\0';
+  // Work backwards so that each output pair lands at or after the bytes it
+  // was encoded from. A word is read before its eight digits are written.
+  size_t i = src_size;
+  for (; i >= 4; i -= 4) {
+    encode_word(&buf[2 * (i - 4)], load_le32(&data[i - 4]));
+  }
+  while (i > 0) {
+    --i;
+    uint8_t byte = data[i];
+    buf[2 * i] = hex[byte >> 4];
+    buf[2 * i + 1] = hex[byte & 15];
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Decodes `len` hex digits from `src` into `dst`.
+ *
+ * `dst` may alias `src` as long as `dst <= src`.
+ */
+static status_t decode(uint8_t *dst, const char *src, size_t len) {
+  const uint8_t *chars = (const uint8_t *)src;
+  // OR together the validity of every chunk and check it once at the end.
+  uint32_t invalid = 0;
+  for (; len >= 8; len -= 8, chars += 8, dst += 4) {
+    uint32_t lo, hi;
+    invalid |= !decode_word(load_le32(chars), &lo);
+    invalid |= !decode_word(load_le32(chars + 4), &hi);
+    store_le32(dst, lo | hi << 16);
+  }
+  for (; len > 0; len -= 2, chars += 2, ++dst) {
+    uint32_t byte;
+    invalid |= !decode_word(chars[0] | chars[1] << 8 | 0x30300000u, &byte);
+    *dst = (uint8_t)byte;
+  }
+  if (invalid) {
     // Not a valid hex digit.
     return INVALID_ARGUMENT();
   }
-  return OK_STATUS(nibble);
+  return OK_STATUS();
 }
 
 status_t hexstr_decode(void *dst, size_t dst_size, const char *src) {
-  uint8_t *data = (uint8_t *)dst;
-  while (*src) {
-    if (dst_size == 0) {
-      // Dest buffer too short.
-      return INVALID_ARGUMENT();
-    }
-    // Decode two hex digits the destination byte.
-    uint8_t nibble = (uint8_t)TRY(decode_nibble(*src++));
-    *data = (uint8_t)(nibble << 4);
-    nibble = (uint8_t)TRY(decode_nibble(*src++));
-    *data |= nibble;
-
-    ++data;
-    --dst_size;
+  size_t len = hexstr_len(src);
+  if (len % 2 != 0) {
+    // Unexpected end of string.
+    return INVALID_ARGUMENT();
   }
-  return OK_STATUS();
+  if (len / 2 > dst_size) {
+    // Dest buffer too short.
+    return INVALID_ARGUMENT();
+  }
+  return decode((uint8_t *)dst, src, len);
+}
+
+status_t hexstr_decode_inplace(char *buf) {
+  size_t len = hexstr_len(buf);
+  if (len % 2 != 0) {
+    // Unexpected end of string.
+    return INVALID_ARGUMENT();
+  }
+  TRY(decode((uint8_t *)buf, buf, len));
+  return OK_STATUS((int32_t)(len / 2));
 }
@@ -26,6 +26,20 @@ extern "C" {
 status_t hexstr_encode(char *dst, size_t dst_size, const void *src,
                        size_t src_size);
 
+/**
+ * Encode binary data as a hexadecimal string in place.
+ *
+ * The binary data at the start of `buf` is replaced by its hexadecimal
+ * encoding, so no second buffer is needed.
+ *
+ * @param buf The buffer holding the source data on entry and the string on
+ *            return.
+ * @param buf_size The size of the buffer (including the nul terminator).
+ * @param src_size The size of the source data at the start of `buf`.
+ * @return status_t Success or error code.
+ */
+status_t hexstr_encode_inplace(char *buf, size_t buf_size, size_t src_size);
+
 /**
  * Decode binary data from a hexadecimal string.
  *
@@ -36,6 +50,18 @@ status_t hexstr_encode(char *dst, size_t dst_size, const void *src,
  */
 status_t hexstr_decode(void *dst, size_t dst_size, const char *src);
 
+/**
+ * Decode binary data from a hexadecimal string in place.
+ *
+ * The decoded data is written to the start of `buf`. On error, the contents of
+ * `buf` are unspecified.
+ *
+ * @param buf The buffer holding the nul-terminated source string on entry and
+ *            the decoded data on return.
+ * @return status_t The number of decoded bytes or an error code.
+ */
+status_t hexstr_decode_inplace(char *buf);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -5,6 +5,7 @@
 #include "sw/device/lib/testing/hexstr.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -65,4 +66,74 @@ TEST(HexStr, DecodeIllegalInput) {
   EXPECT_FALSE(status_ok(result));
 }
 
+TEST(HexStr, EncodeWords) {
+  const uint8_t data[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+                          0xcd, 0xef, 0xfe, 0xdc, 0xba};
+  char buf[2 * sizeof(data) + 1];
+
+  status_t result = hexstr_encode(buf, sizeof(buf), data, sizeof(data));
+  EXPECT_TRUE(status_ok(result));
+  EXPECT_EQ(std::string(buf), "0123456789abcdeffedcba");
+}
+
+TEST(HexStr, EncodeInplace) {
+  const uint8_t data[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+                          0xcd, 0xef, 0xfe, 0xdc, 0xba};
+  char buf[2 * sizeof(data) + 1];
+  memcpy(buf, data, sizeof(data));
+
+  status_t result = hexstr_encode_inplace(buf, sizeof(buf), sizeof(data));
+  EXPECT_TRUE(status_ok(result));
+  EXPECT_EQ(std::string(buf), "0123456789abcdeffedcba");
+}
+
+TEST(HexStr, EncodeInplaceShortBuf) {
+  char buf[8] = {1, 2, 3, 4};
+
+  status_t result = hexstr_encode_inplace(buf, sizeof(buf), 4);
+  EXPECT_FALSE(status_ok(result));
+}
+
+TEST(HexStr, DecodeWords) {
+  char str[] = "0123456789ABCDEFfedcba";
+  uint8_t data[11] = {0};
+
+  status_t result = hexstr_decode(data, sizeof(data), str);
+  EXPECT_TRUE(status_ok(result));
+  EXPECT_THAT(data, testing::ElementsAre(0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+                                         0xcd, 0xef, 0xfe, 0xdc, 0xba));
+}
+
+TEST(HexStr, DecodeIllegalInputAnyPosition) {
+  // Every character next to the valid hex ranges is rejected wherever it
+  // appears in the string.
+  for (char bad : {'/', ':', '@', 'G', '`', 'g', '\x80', '\xb0'}) {
+    for (size_t i = 0; i < 10; ++i) {
+      char str[] = "0123456789";
+      str[i] = bad;
+      uint8_t data[5];
+
+      status_t result = hexstr_decode(data, sizeof(data), str);
+      EXPECT_FALSE(status_ok(result)) << "char " << (int)bad << " at " << i;
+    }
+  }
+}
+
+TEST(HexStr, DecodeInplace) {
+  char buf[] = "0123456789abcdefFEDCBA";
+
+  status_t result = hexstr_decode_inplace(buf);
+  EXPECT_TRUE(status_ok(result));
+  EXPECT_EQ(result.value, 11);
+  EXPECT_EQ(std::string(buf, 11),
+            "\x01\x23\x45\x67\x89\xab\xcd\xef\xfe\xdc\xba");
+}
+
+TEST(HexStr, DecodeInplaceShortInput) {
+  char buf[] = "1122334";
+
+  status_t result = hexstr_decode_inplace(buf);
+  EXPECT_FALSE(status_ok(result));
+}
+
 }  // namespace
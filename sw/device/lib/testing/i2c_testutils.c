@@ -253,6 +253,52 @@ status_t i2c_testutils_read(const dif_i2c_t *i2c, uint8_t addr,
   return OK_STATUS((int32_t)nak_count);
 }
 
+status_t i2c_testutils_write_read(const dif_i2c_t *i2c, uint8_t addr,
+                                  size_t write_count, const uint8_t *write_data,
+                                  size_t read_count, uint8_t *read_data,
+                                  uint32_t timeout) {
+  enum {
+    // Enough entries for a short register address write and a read of up to
+    // a few kilobytes.
+    kTxnMaxEntries = 32,
+  };
+  uint32_t entries[kTxnMaxEntries];
+  dif_i2c_txn_t txn;
+  TRY(dif_i2c_txn_init(&txn, entries, ARRAYSIZE(entries), read_data,
+                       read_count));
+  TRY(dif_i2c_txn_add_write(&txn, addr, write_data, write_count,
+                            /*stop=*/false));
+  TRY(dif_i2c_txn_add_read(&txn, addr, read_count, /*stop=*/true));
+
+  // Make sure to start from a clean state.
+  dif_i2c_controller_halt_events_t halt_events = {0};
+  TRY(dif_i2c_get_controller_halt_events(i2c, &halt_events));
+  TRY(dif_i2c_clear_controller_halt_events(i2c, halt_events));
+  TRY(dif_i2c_reset_rx_fifo(i2c));
+
+  ibex_timeout_t timer = ibex_timeout_init(timeout);
+  bool done = false;
+  while (!done) {
+    bool controller_halted = false;
+    TRY(dif_i2c_irq_is_pending(i2c, kDifI2cIrqControllerHalt,
+                               &controller_halted));
+    if (controller_halted) {
+      // Same recovery as `i2c_testutils_issue_read()`.
+      TRY(dif_i2c_get_controller_halt_events(i2c, &halt_events));
+      TRY(dif_i2c_reset_fmt_fifo(i2c));
+      TRY(dif_i2c_clear_controller_halt_events(i2c, halt_events));
+      TRY(dif_i2c_host_set_enabled(i2c, kDifToggleDisabled));
+      TRY(dif_i2c_host_set_enabled(i2c, kDifToggleEnabled));
+      return OK_STATUS(1);
+    }
+    if (ibex_timeout_check(&timer)) {
+      return DEADLINE_EXCEEDED();
+    }
+    TRY(dif_i2c_txn_service(i2c, &txn, &done));
+  }
+  return OK_STATUS(0);
+}
+
 status_t i2c_testutils_target_check_start(const dif_i2c_t *i2c, uint8_t *addr) {
   dif_i2c_level_t acq_fifo_lvl;
   TRY(dif_i2c_get_fifo_levels(i2c, NULL, NULL, NULL, &acq_fifo_lvl));
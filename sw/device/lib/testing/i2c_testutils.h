@@ -39,6 +39,30 @@ OT_WARN_UNUSED_RESULT
 status_t i2c_testutils_issue_read(const dif_i2c_t *i2c, uint8_t addr,
                                   uint8_t byte_count);
 
+/**
+ * Issue a write followed by a repeated-START read as a single I2C host
+ * transaction.
+ *
+ * This is the usual register read sequence of I2C sensors. All FMT FIFO
+ * entries are precomputed with `dif_i2c_txn_add_write()` and
+ * `dif_i2c_txn_add_read()` and pushed in bursts by `dif_i2c_txn_service()`.
+ *
+ * @param i2c An I2C DIF handle.
+ * @param addr The device address for the transaction.
+ * @param write_count The number of bytes to be written.
+ * @param write_data Bytes to be written, e.g. a register address.
+ * @param read_count The number of bytes to be read.
+ * @param[out] read_data Buffer for the bytes read.
+ * @param timeout Timeout in microseconds.
+ * @return kOk(nak) Where nak indicates whether the transaction was halted by a
+ * NACK (true) or completed (false), otherwise an error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t i2c_testutils_write_read(const dif_i2c_t *i2c, uint8_t addr,
+                                  size_t write_count, const uint8_t *write_data,
+                                  size_t read_count, uint8_t *read_data,
+                                  uint32_t timeout);
+
 /**
  * Check that the target I2C device received the start of a transaction.
  *
@@ -22,10 +22,15 @@ extern "C" {
     value(_, I2cStartTransferRead) \
     value(_, I2cStartTransferWriteRead) \
     value(_, I2cTestConfig) \
+    value(_, MemDump) \
+    value(_, MemLoad) \
     value(_, MemRead) \
     value(_, MemRead32) \
+    value(_, MemReadBlob) \
     value(_, MemWrite) \
     value(_, MemWrite32) \
+    value(_, MemWriteBlob) \
+    value(_, OttfRunTests) \
     value(_, PinmuxConfig) \
     value(_, SpiConfigureJedecId) \
     value(_, SpiReadStatus) \
@@ -5,6 +5,7 @@
 #define UJSON_SERDE_IMPL 1
 #include "sw/device/lib/testing/json/mem.h"
 
+#include "sw/device/lib/base/crc32.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/testing/test_framework/ujson_ottf.h"
 
@@ -52,3 +53,62 @@ status_t ujcmd_mem_write(ujson_t *uj) {
   memcpy((void *)op.address, op.data, op.data_len);
   return RESP_OK_STATUS(uj);
 }
+
+status_t ujcmd_mem_read_blob(ujson_t *uj) {
+  mem_blob_req_t op;
+  TRY(UJSON_WITH_CRC(ujson_deserialize_mem_blob_req_t, uj, &op));
+  RESP_OK_STATUS(uj);
+  return ujson_putblob(uj, (const void *)op.address, op.data_len);
+}
+
+status_t ujcmd_mem_write_blob(ujson_t *uj) {
+  mem_blob_req_t op;
+  TRY(UJSON_WITH_CRC(ujson_deserialize_mem_blob_req_t, uj, &op));
+  // Let the host know it may send the frame.
+  RESP_OK_STATUS(uj);
+  TRY(ujson_getblob(uj, (void *)op.address, op.data_len));
+  return RESP_OK_STATUS(uj);
+}
+
+status_t ujcmd_mem_dump(ujson_t *uj) {
+  mem_stream_req_t op;
+  TRY(UJSON_WITH_CRC(ujson_deserialize_mem_stream_req_t, uj, &op));
+  if (op.chunk_len == 0) {
+    return INVALID_ARGUMENT();
+  }
+  RESP_OK_STATUS(uj);
+  const uint8_t *data = (const uint8_t *)op.address;
+  uint32_t crc;
+  crc32_init(&crc);
+  while (op.data_len > 0) {
+    uint32_t len = op.data_len < op.chunk_len ? op.data_len : op.chunk_len;
+    TRY(ujson_putchunk(uj, data, len, &crc));
+    data += len;
+    op.data_len -= len;
+  }
+  return OK_STATUS();
+}
+
+status_t ujcmd_mem_load(ujson_t *uj) {
+  mem_stream_req_t op;
+  TRY(UJSON_WITH_CRC(ujson_deserialize_mem_stream_req_t, uj, &op));
+  if (op.chunk_len == 0) {
+    return INVALID_ARGUMENT();
+  }
+  // Let the host know it may send the first chunk.
+  RESP_OK_STATUS(uj);
+  uint8_t *data = (uint8_t *)op.address;
+  uint32_t crc;
+  crc32_init(&crc);
+  while (op.data_len > 0) {
+    uint32_t max_len = op.data_len < op.chunk_len ? op.data_len : op.chunk_len;
+    uint32_t len = (uint32_t)TRY(ujson_getchunk(uj, data, max_len, &crc));
+    if (len == 0) {
+      return INVALID_ARGUMENT();
+    }
+    data += len;
+    op.data_len -= len;
+    RESP_OK_STATUS(uj);
+  }
+  return OK_STATUS();
+}
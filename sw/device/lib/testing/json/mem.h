@@ -42,6 +42,17 @@ UJSON_SERDE_STRUCT(MemWrite32Req, mem_write32_req_t, STRUCT_MEM_WRITE32_REQ);
     field(data_len, uint16_t)
 UJSON_SERDE_STRUCT(MemWriteReq, mem_write_req_t, STRUCT_MEM_WRITE_REQ);
 
+#define STRUCT_MEM_BLOB_REQ(field, string) \
+    field(address, uint32_t) \
+    field(data_len, uint32_t)
+UJSON_SERDE_STRUCT(MemBlobReq, mem_blob_req_t, STRUCT_MEM_BLOB_REQ);
+
+#define STRUCT_MEM_STREAM_REQ(field, string) \
+    field(address, uint32_t) \
+    field(data_len, uint32_t) \
+    field(chunk_len, uint32_t)
+UJSON_SERDE_STRUCT(MemStreamReq, mem_stream_req_t, STRUCT_MEM_STREAM_REQ);
+
 #ifndef RUST_PREPROCESSOR_EMIT
 
 status_t ujcmd_mem_read32(ujson_t *uj);
@@ -49,6 +60,44 @@ status_t ujcmd_mem_read(ujson_t *uj);
 status_t ujcmd_mem_write32(ujson_t *uj);
 status_t ujcmd_mem_write(ujson_t *uj);
 
+/**
+ * Reads memory and sends it as a binary frame.
+ *
+ * After acknowledging a `mem_blob_req_t` with an OK status, sends `data_len`
+ * bytes starting at `address` with `ujson_putblob()`.
+ */
+status_t ujcmd_mem_read_blob(ujson_t *uj);
+
+/**
+ * Writes memory from a binary frame.
+ *
+ * After acknowledging a `mem_blob_req_t` with an OK status, receives
+ * `data_len` bytes with `ujson_getblob()` and writes them starting at
+ * `address`. Responds with an OK status once the frame has been received.
+ */
+status_t ujcmd_mem_write_blob(ujson_t *uj);
+
+/**
+ * Dumps memory as a chunked binary stream.
+ *
+ * After acknowledging a `mem_stream_req_t` with an OK status, sends the
+ * `data_len` bytes starting at `address` with `ujson_putchunk()`, in chunks of
+ * at most `chunk_len` bytes. Each chunk carries the running CRC32 of the
+ * stream, so the host can check the data as it arrives.
+ */
+status_t ujcmd_mem_dump(ujson_t *uj);
+
+/**
+ * Loads memory from a chunked binary stream.
+ *
+ * After acknowledging a `mem_stream_req_t` with an OK status, receives chunks
+ * of at most `chunk_len` bytes with `ujson_getchunk()` and writes them
+ * starting at `address` until `data_len` bytes have been written. Every chunk
+ * is acknowledged with an OK status once it has been written, and the host
+ * waits for it before sending the next one.
+ */
+status_t ujcmd_mem_load(ujson_t *uj);
+
 #endif
 
 #undef MODULE_ID
@@ -16,6 +16,25 @@ extern "C" {
     field(crc, uint32_t)
 UJSON_SERDE_STRUCT(OttfCrc, ottf_crc_t, STRUCT_OTTF_CRC);
 
+#define OTTF_RUN_TESTS_MAX 64
+
+#define STRUCT_OTTF_RUN_TESTS_REQ(field, string) \
+    field(tests, uint16_t, OTTF_RUN_TESTS_MAX) \
+    field(count, uint16_t) \
+    field(reset_peripherals, bool)
+UJSON_SERDE_STRUCT(OttfRunTestsReq, ottf_run_tests_req_t, STRUCT_OTTF_RUN_TESTS_REQ);
+
+#define STRUCT_OTTF_RUN_TESTS_RESP(field, string) \
+    field(num_tests, uint16_t)
+UJSON_SERDE_STRUCT(OttfRunTestsResp, ottf_run_tests_resp_t, STRUCT_OTTF_RUN_TESTS_RESP);
+
+#define STRUCT_OTTF_TEST_RESULT(field, string) \
+    field(index, uint16_t) \
+    string(name, 32) \
+    field(status, status_t) \
+    field(cycles, uint64_t)
+UJSON_SERDE_STRUCT(OttfTestResult, ottf_test_result_t, STRUCT_OTTF_TEST_RESULT);
+
 #undef MODULE_ID
 
 // clang-format on
@@ -0,0 +1,46 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#define UJSON_SERDE_IMPL 1
+#include "sw/device/lib/testing/json/profiler.h"
+
+#include <assert.h>
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/profiler.h"
+#include "sw/device/lib/testing/test_framework/ujson_ottf.h"
+
+#define MODULE_ID MAKE_MODULE_ID('j', 's', 'p')
+
+static_assert(sizeof(((profiler_site_resp_t *)NULL)->histogram) ==
+                  sizeof(((profiler_site_t *)NULL)->histogram),
+              "Histogram size does not match the profiler.");
+
+status_t ujcmd_profiler_dump(ujson_t *uj) {
+  profiler_summary_t summary = {
+      .sites = (uint32_t)profiler_site_count(),
+      .dropped = profiler_sites_dropped(),
+  };
+  TRY(RESP_OK(ujson_serialize_profiler_summary_t, uj, &summary));
+
+  for (size_t i = 0; i < summary.sites; ++i) {
+    const profiler_site_t *site = profiler_site_get(i);
+    profiler_site_resp_t resp = {
+        .count = site->count,
+        .min = site->min,
+        .max = site->max,
+        .total = site->total,
+    };
+    // Truncate long names, keeping the terminator.
+    size_t len = 0;
+    while (len < sizeof(resp.name) - 1 && site->name[len] != '\0') {
+      ++len;
+    }
+    memcpy(resp.name, site->name, len);
+    resp.name[len] = '\0';
+    memcpy(resp.histogram, site->histogram, sizeof(resp.histogram));
+    TRY(RESP_OK(ujson_serialize_profiler_site_resp_t, uj, &resp));
+  }
+  return OK_STATUS();
+}
@@ -0,0 +1,48 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_PROFILER_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_PROFILER_H_
+
+#include "sw/device/lib/ujson/ujson_derive.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format off
+
+#define MODULE_ID MAKE_MODULE_ID('j', 'p', 'h')
+
+#define STRUCT_PROFILER_SUMMARY(field, string) \
+    field(sites, uint32_t) \
+    field(dropped, uint32_t)
+UJSON_SERDE_STRUCT(ProfilerSummary, profiler_summary_t, STRUCT_PROFILER_SUMMARY);
+
+#define STRUCT_PROFILER_SITE(field, string) \
+    string(name, 32) \
+    field(count, uint32_t) \
+    field(min, uint32_t) \
+    field(max, uint32_t) \
+    field(total, uint64_t) \
+    field(histogram, uint32_t, 16)
+UJSON_SERDE_STRUCT(ProfilerSite, profiler_site_resp_t, STRUCT_PROFILER_SITE);
+
+#ifndef RUST_PREPROCESSOR_EMIT
+
+/**
+ * Sends the statistics collected by `sw/device/lib/base/profiler.h`.
+ *
+ * Responds with a `ProfilerSummary`, followed by one `ProfilerSite` for each
+ * registered site.
+ */
+status_t ujcmd_profiler_dump(ujson_t *uj);
+
+#endif
+
+#undef MODULE_ID
+
+// clang-format on
+#ifdef __cplusplus
+}
+#endif
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_PROFILER_H_
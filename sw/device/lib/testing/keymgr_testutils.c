@@ -85,6 +85,61 @@ status_t keymgr_testutils_flash_init(
   return OK_STATUS();
 }
 
+/**
+ * Checks whether an info page already holds the given secret.
+ *
+ * A page that cannot be read, e.g. because it has never been programmed with
+ * scrambling enabled, is reported as not matching.
+ */
+static status_t info_page_matches(dif_flash_ctrl_state_t *flash,
+                                  uint32_t page_id,
+                                  const keymgr_testutils_secret_t *data,
+                                  bool *matches) {
+  uint32_t address = 0;
+  TRY(flash_ctrl_testutils_info_region_scrambled_setup(
+      flash, page_id, kFlashInfoBankId, kFlashInfoPartitionId, &address));
+
+  keymgr_testutils_secret_t readback_data;
+  status_t res = flash_ctrl_testutils_read(
+      flash, address, kFlashInfoPartitionId, readback_data.value,
+      kDifFlashCtrlPartitionTypeInfo, ARRAYSIZE(readback_data.value), 0);
+  *matches = status_ok(res) && memcmp(data->value, readback_data.value,
+                                      sizeof(data->value)) == 0;
+  return OK_STATUS();
+}
+
+/**
+ * Checks whether flash and OTP are already provisioned for keymgr.
+ *
+ * The secrets in flash and the OTP partition digest persist across POR, so
+ * they act as the marker that a previous run already did the provisioning.
+ */
+static status_t nvm_is_provisioned(dif_flash_ctrl_state_t *flash,
+                                   bool *provisioned) {
+  *provisioned = false;
+
+  dif_otp_ctrl_t otp;
+  TRY(dif_otp_ctrl_init(
+      mmio_region_from_addr(TOP_EARLGREY_OTP_CTRL_CORE_BASE_ADDR), &otp));
+  bool is_computed;
+  TRY(dif_otp_ctrl_is_digest_computed(&otp, kDifOtpCtrlPartitionSecret2,
+                                      &is_computed));
+  if (!is_computed) {
+    return OK_STATUS();
+  }
+
+  bool matches;
+  TRY(info_page_matches(flash, kFlashInfoPageIdCreatorSecret, &kCreatorSecret,
+                        &matches));
+  if (!matches) {
+    return OK_STATUS();
+  }
+  TRY(info_page_matches(flash, kFlashInfoPageIdOwnerSecret, &kOwnerSecret,
+                        &matches));
+  *provisioned = matches;
+  return OK_STATUS();
+}
+
 static status_t check_lock_otp_partition(void) {
   dif_otp_ctrl_t otp;
   TRY(dif_otp_ctrl_init(
@@ -200,6 +255,15 @@ status_t keymgr_testutils_init_nvm_then_reset(void) {
     TRY(dif_flash_ctrl_init_state(
         &flash, mmio_region_from_addr(TOP_EARLGREY_FLASH_CTRL_CORE_BASE_ADDR)));
 
+    // Secrets that were provisioned by an earlier run are already visible to
+    // keymgr, so neither reprogramming nor a reset is needed.
+    bool provisioned;
+    TRY(nvm_is_provisioned(&flash, &provisioned));
+    if (provisioned) {
+      LOG_INFO("Flash and OTP already provisioned, skipping reset");
+      return OK_STATUS();
+    }
+
     TRY(keymgr_testutils_flash_init(&flash, &kCreatorSecret, &kOwnerSecret));
 
     TRY(check_lock_otp_partition());
@@ -239,8 +303,9 @@ status_t keymgr_testutils_startup(dif_keymgr_t *keymgr, dif_kmac_t *kmac) {
                       &rstmgr));
   const dif_rstmgr_reset_info_bitfield_t info = rstmgr_testutils_reason_get();
 
-  TRY_CHECK(info == kDifRstmgrResetInfoSw, "Unexpected reset reason: %08x",
-            info);
+  // The reset is skipped if flash and OTP were already provisioned.
+  TRY_CHECK(info == kDifRstmgrResetInfoSw || info == kDifRstmgrResetInfoPor,
+            "Unexpected reset reason: %08x", info);
 
   LOG_INFO("Initializing entropy complex in Auto mode");
 
@@ -250,22 +315,24 @@ status_t keymgr_testutils_startup(dif_keymgr_t *keymgr, dif_kmac_t *kmac) {
 
   TRY(dif_init(keymgr, kmac));
 
-  // Advance to Initialized state.
-  TRY(keymgr_testutils_check_state(keymgr, kDifKeymgrStateReset));
-  TRY(keymgr_testutils_advance_state(keymgr, NULL));
-  TRY(keymgr_testutils_check_state(keymgr, kDifKeymgrStateInitialized));
-  LOG_INFO("Keymgr entered Init State");
-
   // Advance to CreatorRootKey state.
+  TRY(keymgr_testutils_check_state(keymgr, kDifKeymgrStateReset));
   if (is_using_test_rom) {
     LOG_INFO("Using test_rom, setting inputs and advancing state...");
-    TRY(keymgr_testutils_advance_state(keymgr, &kCreatorParams));
+    const dif_keymgr_state_params_t *params[] = {
+        [kDifKeymgrStateReset] = NULL,
+        [kDifKeymgrStateInitialized] = &kCreatorParams,
+    };
+    TRY(keymgr_testutils_advance_to(keymgr, kDifKeymgrStateCreatorRootKey,
+                                    params));
   } else {
     LOG_INFO("Using rom, only advancing state...");
+    TRY(keymgr_testutils_advance_state(keymgr, NULL));
+    TRY(keymgr_testutils_check_state(keymgr, kDifKeymgrStateInitialized));
     TRY(dif_keymgr_advance_state_raw(keymgr));
     TRY(keymgr_testutils_wait_for_operation_done(keymgr));
+    TRY(keymgr_testutils_check_state(keymgr, kDifKeymgrStateCreatorRootKey));
   }
-  TRY(keymgr_testutils_check_state(keymgr, kDifKeymgrStateCreatorRootKey));
   LOG_INFO("Keymgr entered CreatorRootKey State");
 
   // Identity generation is not really necessary for all tests, but it is
@@ -283,6 +350,24 @@ status_t keymgr_testutils_advance_state(
   return keymgr_testutils_wait_for_operation_done(keymgr);
 }
 
+status_t keymgr_testutils_advance_to(
+    const dif_keymgr_t *keymgr, dif_keymgr_state_t state,
+    const dif_keymgr_state_params_t *const params[]) {
+  TRY_CHECK(state <= kDifKeymgrStateOwnerRootKey);
+  dif_keymgr_state_t cur_state;
+  TRY(dif_keymgr_get_state(keymgr, &cur_state));
+  TRY_CHECK(cur_state <= state, "Keymgr already past state %x: %x", state,
+            cur_state);
+
+  // The key manager runs one operation at a time, so each advance still has
+  // to finish before the next one is issued. Only the final state is checked.
+  for (; cur_state < state; ++cur_state) {
+    TRY(dif_keymgr_advance_state(keymgr, params[cur_state]));
+    TRY(keymgr_testutils_wait_for_operation_done(keymgr));
+  }
+  return keymgr_testutils_check_state(keymgr, state);
+}
+
 status_t keymgr_testutils_check_state(const dif_keymgr_t *keymgr,
                                       const dif_keymgr_state_t exp_state) {
   dif_keymgr_state_t act_state;
@@ -153,6 +153,10 @@ status_t keymgr_testutils_try_startup(dif_keymgr_t *keymgr, dif_kmac_t *kmac,
  * Initialize non-volatile memory (flash and OTP) for keymgr and then reset, so
  * that the relevant OTP partitions become accessible to keymgr.  After calling
  * this function, keymgr can be initialized.
+ *
+ * If flash and OTP already hold the keymgr secrets at POR, e.g. from an earlier
+ * test run on the same device, this function returns without reprogramming or
+ * resetting.
  */
 OT_WARN_UNUSED_RESULT
 status_t keymgr_testutils_init_nvm_then_reset(void);
@@ -196,6 +200,23 @@ OT_WARN_UNUSED_RESULT
 status_t keymgr_testutils_advance_state(
     const dif_keymgr_t *keymgr, const dif_keymgr_state_params_t *params);
 
+/**
+ * Advances the key manager from its current state to `state`.
+ *
+ * Issues one advance operation per intermediate state and waits for each of
+ * them, but reads the state only before the first and after the last one.
+ *
+ * @param keymgr A key manager handle.
+ * @param state The state to advance to, at most `kDifKeymgrStateOwnerRootKey`.
+ * @param params Binding and max key version values, indexed by the state that
+ * is being left, i.e. `params[kDifKeymgrStateInitialized]` is used to advance
+ * to CreatorRootKey. Must have an entry for each state before `state`.
+ */
+OT_WARN_UNUSED_RESULT
+status_t keymgr_testutils_advance_to(
+    const dif_keymgr_t *keymgr, dif_keymgr_state_t state,
+    const dif_keymgr_state_params_t *const params[]);
+
 /**
  * Checks if the current keymgr state matches the expected state
  *
@@ -70,6 +70,43 @@ status_t kmac_testutils_kmac(const dif_kmac_t *kmac,
   return OK_STATUS();
 }
 
+/**
+ * Absorbs `message` and squeezes `output_len` words for an operation that has
+ * already been started.
+ */
+static status_t absorb_and_squeeze(const dif_kmac_t *kmac,
+                                   dif_kmac_operation_state_t *operation_state,
+                                   const void *message, size_t message_len,
+                                   size_t output_len, uint32_t *output) {
+  TRY(kmac_testutils_check_error(kmac));
+  TRY(dif_kmac_absorb(kmac, operation_state, message, message_len, NULL));
+  TRY(kmac_testutils_check_error(kmac));
+  TRY(dif_kmac_squeeze(kmac, operation_state, output, output_len, NULL,
+                       NULL));
+  TRY(kmac_testutils_check_error(kmac));
+  TRY(dif_kmac_end(kmac, operation_state));
+  return kmac_testutils_check_error(kmac);
+}
+
+status_t kmac_testutils_sha3(const dif_kmac_t *kmac, dif_kmac_mode_sha3_t mode,
+                             const void *message, size_t message_len,
+                             size_t output_len, uint32_t *output) {
+  dif_kmac_operation_state_t operation_state;
+  TRY(dif_kmac_mode_sha3_start(kmac, &operation_state, mode));
+  return absorb_and_squeeze(kmac, &operation_state, message, message_len,
+                            output_len, output);
+}
+
+status_t kmac_testutils_shake(const dif_kmac_t *kmac,
+                              dif_kmac_mode_shake_t mode, const void *message,
+                              size_t message_len, size_t output_len,
+                              uint32_t *output) {
+  dif_kmac_operation_state_t operation_state;
+  TRY(dif_kmac_mode_shake_start(kmac, &operation_state, mode));
+  return absorb_and_squeeze(kmac, &operation_state, message, message_len,
+                            output_len, output);
+}
+
 status_t kmac_testutils_check_error(const dif_kmac_t *kmac) {
   bool error;
   TRY(dif_kmac_has_error_occurred(kmac, &error));
@@ -51,6 +51,48 @@ status_t kmac_testutils_kmac(const dif_kmac_t *kmac, dif_kmac_mode_kmac_t mode,
                              const size_t output_len, uint32_t *output,
                              uint32_t *capacity);
 
+/**
+ * Runs a full SHA-3 operation.
+ *
+ * Assumes that the KMAC block has already been initialized and configured.
+ * The message is absorbed in bursts sized to the free space in the message
+ * FIFO.
+ *
+ * @param kmac KMAC block context.
+ * @param mode Mode (security strength) for SHA-3.
+ * @param message Input message.
+ * @param message_len Length of message in bytes.
+ * @param output_len Requested length of output in words.
+ * @param[out] output Pre-allocated output buffer (length must match
+ * output_len).
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_testutils_sha3(const dif_kmac_t *kmac, dif_kmac_mode_sha3_t mode,
+                             const void *message, size_t message_len,
+                             size_t output_len, uint32_t *output);
+
+/**
+ * Runs a full SHAKE operation.
+ *
+ * Same as `kmac_testutils_sha3()`, but `output_len` may exceed the Keccak
+ * rate.
+ *
+ * @param kmac KMAC block context.
+ * @param mode Mode (security strength) for SHAKE.
+ * @param message Input message.
+ * @param message_len Length of message in bytes.
+ * @param output_len Requested length of output in words.
+ * @param[out] output Pre-allocated output buffer (length must match
+ * output_len).
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_testutils_shake(const dif_kmac_t *kmac,
+                              dif_kmac_mode_shake_t mode, const void *message,
+                              size_t message_len, size_t output_len,
+                              uint32_t *output);
+
 /**
  * Check if the KMAC HW has flagged any errors and acknowledge them.
  *
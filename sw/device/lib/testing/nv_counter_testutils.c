@@ -42,12 +42,16 @@ static uint64_t *const kNvCounters[] = {
     nv_counter_3,
 };
 
-status_t flash_ctrl_testutils_counter_get(size_t counter, uint32_t *value) {
-  TRY_CHECK(value != NULL);
-  TRY_CHECK(counter < ARRAYSIZE(kNvCounters));
-  TRY_CHECK((uint32_t)&_non_volatile_counter_flash_words ==
-            kNonVolatileCounterFlashWords);
+// Counter values known to this boot stage, so that reads do not need to scan
+// the counter's flash region every time. Only valid if the corresponding
+// entry of `nv_counter_cached` is true.
+static uint32_t nv_counter_cache[ARRAYSIZE(kNvCounters)];
+static bool nv_counter_cached[ARRAYSIZE(kNvCounters)];
 
+/**
+ * Scans the flash region of a counter for its value.
+ */
+static uint32_t nv_counter_scan(size_t counter) {
   // Use a reverse loop since `flash_ctrl_testutils_counter_set_at_least()` can
   // introduce gaps.
   size_t i = kNonVolatileCounterFlashWords - 1;
@@ -56,20 +60,41 @@ status_t flash_ctrl_testutils_counter_get(size_t counter, uint32_t *value) {
       break;
     }
   }
-  *value = i + 1;
+  return i + 1;
+}
+
+status_t flash_ctrl_testutils_counter_get(size_t counter, uint32_t *value) {
+  TRY_CHECK(value != NULL);
+  TRY_CHECK(counter < ARRAYSIZE(kNvCounters));
+  TRY_CHECK((uint32_t)&_non_volatile_counter_flash_words ==
+            kNonVolatileCounterFlashWords);
+
+  // All updates in this boot go through this file and keep the cache up to
+  // date, but check the next word anyway in case another agent (e.g. a
+  // debugger) wrote to the counter.
+  uint32_t cached = nv_counter_cache[counter];
+  if (nv_counter_cached[counter] &&
+      (cached == kNonVolatileCounterFlashWords ||
+       kNvCounters[counter][cached] != 0)) {
+    *value = cached;
+    return OK_STATUS();
+  }
+
+  *value = nv_counter_scan(counter);
+  nv_counter_cache[counter] = *value;
+  nv_counter_cached[counter] = true;
   return OK_STATUS();
 }
 
 status_t flash_ctrl_testutils_counter_increment(
     dif_flash_ctrl_state_t *flash_state, size_t counter) {
-  size_t i;
+  uint32_t i;
   TRY(flash_ctrl_testutils_counter_get(counter, &i));
   TRY_CHECK(i < kNonVolatileCounterFlashWords,
             "Non-volatile counter %u is at its maximum", counter);
   TRY(flash_ctrl_testutils_counter_set_at_least(flash_state, counter, i + 1));
-  uint32_t value;
-  TRY(flash_ctrl_testutils_counter_get(counter, &value));
-  TRY_CHECK(value == i + 1, "Counter increment failed");
+  // Only the word that was just written needs to be checked.
+  TRY_CHECK(kNvCounters[counter][i] == 0, "Counter increment failed");
   return OK_STATUS();
 }
 
@@ -82,11 +107,15 @@ status_t flash_ctrl_testutils_counter_set_at_least(
     return OK_STATUS();
   }
   uint32_t new_val[FLASH_CTRL_PARAM_BYTES_PER_WORD / sizeof(uint32_t)] = {0, 0};
-  return flash_ctrl_testutils_write(flash_state,
-                                    (uint32_t)&kNvCounters[counter][val - 1] -
-                                        TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR,
-                                    0, new_val, kDifFlashCtrlPartitionTypeData,
-                                    ARRAYSIZE(new_val));
+  TRY(flash_ctrl_testutils_write(flash_state,
+                                 (uint32_t)&kNvCounters[counter][val - 1] -
+                                     TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR,
+                                 0, new_val, kDifFlashCtrlPartitionTypeData,
+                                 ARRAYSIZE(new_val)));
+  if (nv_counter_cached[counter] && nv_counter_cache[counter] < val) {
+    nv_counter_cache[counter] = val;
+  }
+  return OK_STATUS();
 }
 
 // At the beginning of the simulation (Verilator, VCS,etc.),
@@ -106,5 +135,7 @@ status_t flash_ctrl_testutils_counter_init_zero(
             TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR,
         0, new_val, kDifFlashCtrlPartitionTypeData, ARRAYSIZE(new_val)));
   }
+  nv_counter_cache[counter] = 0;
+  nv_counter_cached[counter] = true;
   return OK_STATUS();
 }
@@ -13,6 +13,10 @@
 /**
  * Returns the value of a non-volatile counter in flash.
  *
+ * The first call in a boot stage scans the counter's flash region. The value
+ * is then cached, and later calls only read one flash word to check that the
+ * counter has not been changed behind this library's back.
+ *
  * @param counter Counter ID, [0, 2].
  * @param[out] Value of the non-volatile counter
  * @return The result of the operation.
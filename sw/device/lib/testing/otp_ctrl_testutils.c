@@ -79,13 +79,23 @@ status_t otp_ctrl_testutils_dai_read32_array(const dif_otp_ctrl_t *otp,
                                              dif_otp_ctrl_partition_t partition,
                                              uint32_t start_address,
                                              uint32_t *buffer, size_t len) {
-  uint32_t stop_address = start_address + (len * sizeof(uint32_t));
-  for (uint32_t addr = start_address, i = 0; addr < stop_address;
-       addr += sizeof(uint32_t), ++i) {
-    TRY(otp_ctrl_testutils_wait_for_dai(otp));
-    TRY(dif_otp_ctrl_dai_read_start(otp, partition, addr));
-    TRY(otp_ctrl_testutils_wait_for_dai(otp));
-    TRY(dif_otp_ctrl_dai_read32_end(otp, &buffer[i]));
+  if (len == 0) {
+    return OK_STATUS();
+  }
+
+  // Let the DIF issue each word as soon as the previous one completes instead
+  // of polling the full status between every start and end.
+  dif_otp_ctrl_dai_read_t read;
+  TRY(otp_ctrl_testutils_wait_for_dai(otp));
+  TRY(dif_otp_ctrl_dai_read_batch_start(otp, &read, partition, start_address,
+                                        buffer, len));
+  const ibex_timeout_t timeout = ibex_timeout_init(kOtpDaiTimeoutUs * len);
+  bool done = false;
+  while (!done) {
+    TRY(dif_otp_ctrl_dai_read_batch_service(otp, &read, &done));
+    if (!done && ibex_timeout_check(&timeout)) {
+      return DEADLINE_EXCEEDED();
+    }
   }
   return OK_STATUS();
 }
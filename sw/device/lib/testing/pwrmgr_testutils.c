@@ -8,19 +8,29 @@
 #include <stdint.h>
 
 #include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/dif/dif_pwrmgr.h"
+#include "sw/device/lib/testing/ret_sram_testutils.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 
+/**
+ * Encoding of a wakeup reason in a single word of the wakeup reason log.
+ */
+static const bitfield_field32_t kWakeupLogSourcesField = {
+    .mask = 0xffff,
+    .index = 0,
+};
+static const bitfield_field32_t kWakeupLogTypesField = {
+    .mask = 0xffff,
+    .index = 16,
+};
+
 status_t pwrmgr_testutils_enable_low_power(
     const dif_pwrmgr_t *pwrmgr, dif_pwrmgr_request_sources_t wakeups,
     dif_pwrmgr_domain_config_t domain_config) {
   // Enable low power on the next WFI with clocks and power domains configured
   // per domain_config.
-  TRY(dif_pwrmgr_set_request_sources(pwrmgr, kDifPwrmgrReqTypeWakeup, wakeups,
-                                     kDifToggleDisabled));
-  TRY(dif_pwrmgr_set_domain_config(pwrmgr, domain_config, kDifToggleDisabled));
-  TRY(dif_pwrmgr_low_power_set_enabled(pwrmgr, kDifToggleEnabled,
-                                       kDifToggleEnabled));
+  TRY(dif_pwrmgr_configure_low_power(pwrmgr, wakeups, domain_config));
   return OK_STATUS();
 }
 
@@ -33,3 +43,47 @@ status_t pwrmgr_testutils_is_wakeup_reason(
                     wakeup_reason.types == kDifPwrmgrWakeupTypeRequest) &&
                    wakeup_reason.request_sources == reasons);
 }
+
+status_t pwrmgr_testutils_wakeup_log_clear(
+    const pwrmgr_testutils_wakeup_log_t *log) {
+  TRY_CHECK(log != NULL);
+  TRY_CHECK(log->scratch_offset + log->capacity <=
+            kRetSramTestutilsScratchSizeAsInts);
+  return ret_sram_testutils_counter_clear(log->counter);
+}
+
+status_t pwrmgr_testutils_wakeup_log_append(
+    const dif_pwrmgr_t *pwrmgr, const pwrmgr_testutils_wakeup_log_t *log) {
+  TRY_CHECK(log != NULL);
+  uint32_t count;
+  TRY(ret_sram_testutils_counter_get(log->counter, &count));
+  if (count >= log->capacity) {
+    return FAILED_PRECONDITION();
+  }
+
+  dif_pwrmgr_wakeup_reason_t wakeup_reason;
+  TRY(dif_pwrmgr_wakeup_reason_get(pwrmgr, &wakeup_reason));
+  uint32_t entry = bitfield_field32_write(0, kWakeupLogSourcesField,
+                                          wakeup_reason.request_sources);
+  entry = bitfield_field32_write(entry, kWakeupLogTypesField,
+                                 wakeup_reason.types);
+  TRY(ret_sram_testutils_scratch_write(log->scratch_offset + count, 1, &entry));
+  return ret_sram_testutils_counter_increment(log->counter);
+}
+
+status_t pwrmgr_testutils_wakeup_log_get(
+    const pwrmgr_testutils_wakeup_log_t *log, size_t index,
+    dif_pwrmgr_wakeup_reason_t *reason) {
+  TRY_CHECK(log != NULL && reason != NULL);
+  uint32_t count;
+  TRY(ret_sram_testutils_counter_get(log->counter, &count));
+  TRY_CHECK(index < count);
+
+  uint32_t entry;
+  TRY(ret_sram_testutils_scratch_read(log->scratch_offset + index, 1, &entry));
+  reason->request_sources =
+      bitfield_field32_read(entry, kWakeupLogSourcesField);
+  reason->types = (dif_pwrmgr_wakeup_types_t)bitfield_field32_read(
+      entry, kWakeupLogTypesField);
+  return OK_STATUS();
+}
@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_PWRMGR_TESTUTILS_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_PWRMGR_TESTUTILS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/status.h"
@@ -39,4 +40,62 @@ OT_WARN_UNUSED_RESULT
 status_t pwrmgr_testutils_is_wakeup_reason(
     const dif_pwrmgr_t *pwrmgr, dif_pwrmgr_request_sources_t reasons);
 
+/**
+ * Location of a wakeup reason log in retention SRAM.
+ *
+ * The log lets sleep/wake tests record the reason of each wakeup without
+ * printing it, and check all of them at the end of the test. It is stored in
+ * the counters and scratch array of `ret_sram_testutils`, so it survives low
+ * power entry and resets other than POR.
+ */
+typedef struct pwrmgr_testutils_wakeup_log {
+  /**
+   * `ret_sram_testutils` counter that holds the number of entries.
+   */
+  size_t counter;
+  /**
+   * Offset in the `ret_sram_testutils` scratch array of the first entry.
+   */
+  size_t scratch_offset;
+  /**
+   * Maximum number of entries, one scratch word each.
+   */
+  size_t capacity;
+} pwrmgr_testutils_wakeup_log_t;
+
+/**
+ * Clears a wakeup reason log.
+ *
+ * @param log A wakeup reason log.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t pwrmgr_testutils_wakeup_log_clear(
+    const pwrmgr_testutils_wakeup_log_t *log);
+
+/**
+ * Appends the current wakeup reason to a wakeup reason log.
+ *
+ * @param pwrmgr A power manager handle.
+ * @param log A wakeup reason log.
+ * @return The result of the operation, `kFailedPrecondition` if the log is
+ * full.
+ */
+OT_WARN_UNUSED_RESULT
+status_t pwrmgr_testutils_wakeup_log_append(
+    const dif_pwrmgr_t *pwrmgr, const pwrmgr_testutils_wakeup_log_t *log);
+
+/**
+ * Reads an entry of a wakeup reason log.
+ *
+ * @param log A wakeup reason log.
+ * @param index Index of the entry, in the order the entries were appended.
+ * @param[out] reason The recorded wakeup reason.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t pwrmgr_testutils_wakeup_log_get(
+    const pwrmgr_testutils_wakeup_log_t *log, size_t index,
+    dif_pwrmgr_wakeup_reason_t *reason);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_PWRMGR_TESTUTILS_H_
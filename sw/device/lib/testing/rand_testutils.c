@@ -4,11 +4,11 @@
 
 #include "sw/device/lib/testing/rand_testutils.h"
 
+#include <stdalign.h>
 #include <stdbool.h>
 #include <stdint.h>
 
 #include "sw/device/lib/arch/device.h"
-#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/dif/dif_rv_core_ibex.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/rv_core_ibex_testutils.h"
@@ -78,30 +78,79 @@ uint32_t rand_testutils_gen32(void) {
   return rand_testutils_rng_ctx.lfsr;
 }
 
+void rand_testutils_fill(uint32_t *buf, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    buf[i] = rand_testutils_gen32();
+  }
+}
+
 uint32_t rand_testutils_gen32_range(uint32_t min, uint32_t max) {
   CHECK(max >= min);
   uint32_t range = max - min;
   if (range == 0) {
     return min;
   }
-  uint32_t result = min + (rand_testutils_gen32() % (range + 1));
-  CHECK(result >= min && result <= max);
-  return result;
+  if (range == UINT32_MAX) {
+    return rand_testutils_gen32();
+  }
+
+  // Lemire's multiply-shift reduction: the high word of `x * n` is uniform in
+  // [0, n) once the low words that would introduce a bias are rejected. The
+  // rejection threshold needs a division, but it is only computed in the rare
+  // case where the low word is small enough to possibly be rejected.
+  uint32_t n = range + 1;
+  uint64_t product = (uint64_t)rand_testutils_gen32() * n;
+  if ((uint32_t)product < n) {
+    uint32_t threshold = -n % n;
+    while ((uint32_t)product < threshold) {
+      product = (uint64_t)rand_testutils_gen32() * n;
+    }
+  }
+  return min + (uint32_t)(product >> 32);
+}
+
+/**
+ * Swaps two elements of `size` bytes, one byte at a time.
+ */
+static void swap_bytes(unsigned char *a, unsigned char *b, size_t size) {
+  for (size_t k = 0; k < size; ++k) {
+    unsigned char temp = a[k];
+    a[k] = b[k];
+    b[k] = temp;
+  }
 }
 
 void rand_testutils_shuffle(void *array, size_t size, size_t length) {
   if (length <= 1) {
     return;
   }
-  unsigned char temp[size];
-  unsigned char *array8 = array;
   uint32_t reseed_frequency = rand_testutils_rng_ctx.reseed_frequency;
   rand_testutils_rng_ctx.reseed_frequency = UINT32_MAX;
-  for (size_t i = length - 2; i > 0; i--) {
-    size_t j = rand_testutils_gen32_range(0, i + 1);
-    memcpy(temp, array8 + j * size, size);
-    memcpy(array8 + j * size, array8 + i * size, size);
-    memcpy(array8 + i * size, temp, size);
+  uintptr_t addr = (uintptr_t)array;
+  // Fisher-Yates: element `i` is swapped with a uniformly chosen element in
+  // [0, i]. Word-sized elements are swapped with plain loads and stores.
+  if (size == sizeof(uint32_t) && addr % alignof(uint32_t) == 0) {
+    uint32_t *array32 = array;
+    for (size_t i = length - 1; i > 0; --i) {
+      size_t j = rand_testutils_gen32_range(0, (uint32_t)i);
+      uint32_t temp = array32[j];
+      array32[j] = array32[i];
+      array32[i] = temp;
+    }
+  } else if (size == sizeof(uint64_t) && addr % alignof(uint64_t) == 0) {
+    uint64_t *array64 = array;
+    for (size_t i = length - 1; i > 0; --i) {
+      size_t j = rand_testutils_gen32_range(0, (uint32_t)i);
+      uint64_t temp = array64[j];
+      array64[j] = array64[i];
+      array64[i] = temp;
+    }
+  } else {
+    unsigned char *array8 = array;
+    for (size_t i = length - 1; i > 0; --i) {
+      size_t j = rand_testutils_gen32_range(0, (uint32_t)i);
+      swap_bytes(array8 + j * size, array8 + i * size, size);
+    }
   }
   rand_testutils_rng_ctx.reseed_frequency = reseed_frequency;
 }
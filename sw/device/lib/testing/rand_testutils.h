@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_RAND_TESTUTILS_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_RAND_TESTUTILS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/testing/rv_core_ibex_testutils.h"
@@ -91,19 +92,31 @@ uint32_t rand_testutils_gen32(void);
  * Returns a random unsigned integer within a given range.
  *
  * This function invokes `rand_testutils_gen32()` and restricts the returned
- * value to be within the supplied range, inclusive of the range limits. Note
- * that a uniform distribution of values within the given range is not
- * guaranteed.
+ * value to be within the supplied range, inclusive of the range limits. The
+ * values are uniformly distributed within the range, assuming that
+ * `rand_testutils_gen32()` is. The reduction uses a multiplication instead of a
+ * division.
  * @param min The lower limit of the range.
  * @param max The upper limit of the range.
  * @return The computed random value within the supplied range.
  */
 uint32_t rand_testutils_gen32_range(uint32_t min, uint32_t max);
 
+/**
+ * Fills a buffer with random words.
+ *
+ * Equivalent to calling `rand_testutils_gen32()` once for each word.
+ *
+ * @param[out] buf Buffer to fill.
+ * @param len Number of words in `buf`.
+ */
+void rand_testutils_fill(uint32_t *buf, size_t len);
+
 /** Shuffles an arbitrary array of elements.
  *
- * The shuffling occurs in-place. The reseeding of the LFSR is temporarily
- * turned off to allow faster runtime performance.
+ * The shuffling occurs in-place. Elements of 4 or 8 bytes are swapped as whole
+ * words when the array is suitably aligned. The reseeding of the LFSR is
+ * temporarily turned off to allow faster runtime performance.
  * @param array Pointer to the array being shuffled.
  * @param size The size of each element in the array.
  * @param length The number of elements in the array.
@@ -4,6 +4,8 @@
 
 #include "sw/device/lib/testing/randomness_quality.h"
 
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 
@@ -26,6 +28,25 @@ enum {
    */
   kMonobitOnePercentThresholdNumerator = 66349,
   kMonobitOnePercentThresholdDenominator = 10000,
+  /**
+   * Thresholds for the poker test with m = 4 (alpha=0.05).
+   *
+   * The statistic follows a chi-square distribution with 15 degrees of
+   * freedom, see the Handbook of Applied Cryptography, Table 5.1.
+   */
+  kPokerFivePercentThresholdNumerator = 249958,
+  kPokerFivePercentThresholdDenominator = 10000,
+  /**
+   * Thresholds for the poker test with m = 4 (alpha=0.01).
+   */
+  kPokerOnePercentThresholdNumerator = 305779,
+  kPokerOnePercentThresholdDenominator = 10000,
+  /**
+   * Maximum number of bits that the tests accept.
+   *
+   * Keeps all intermediate values of the threshold comparisons within 64 bits.
+   */
+  kMaxNumBits = 1u << 31,
 };
 
 /**
@@ -42,49 +63,156 @@ static uint64_t diff_squared(uint64_t a, uint64_t b) {
   return (a - b) * (a - b);
 }
 
+/**
+ * Checks that a statistic does not exceed a threshold.
+ *
+ * Compares `stat_numerator / stat_denominator` with `threshold_numerator /
+ * threshold_denominator` without floating-point arithmetic.
+ *
+ * @param stat_numerator Numerator of the statistic.
+ * @param stat_denominator Denominator of the statistic, at most `kMaxNumBits`.
+ * @param threshold_numerator Numerator of the threshold.
+ * @param threshold_denominator Denominator of the threshold.
+ * @return OK if the statistic is within the threshold, a failure code
+ * otherwise.
+ */
+static status_t threshold_check(uint64_t stat_numerator,
+                                uint64_t stat_denominator,
+                                uint64_t threshold_numerator,
+                                uint64_t threshold_denominator) {
+  // Reject clearly failing results first, using the integer ceiling of the
+  // threshold, so that the exact comparison below cannot overflow.
+  uint64_t threshold_ceil = threshold_numerator / threshold_denominator + 1;
+  TRY_CHECK(stat_numerator <= threshold_ceil * stat_denominator);
+
+  // Return true if the result value is <= to the threshold.
+  uint64_t lhs = (stat_numerator * threshold_denominator);
+  uint64_t rhs = (threshold_numerator * stat_denominator);
+  TRY_CHECK(lhs <= rhs);
+
+  return OK_STATUS();
+}
+
+/**
+ * Checks a statistic with one degree of freedom, i.e. the monobit thresholds.
+ */
+static status_t one_dof_check(uint64_t stat_numerator,
+                              uint64_t stat_denominator,
+                              randomness_quality_significance_t significance) {
+  switch (significance) {
+    case kRandomnessQualitySignificanceFivePercent:
+      return threshold_check(stat_numerator, stat_denominator,
+                             kMonobitFivePercentThresholdNumerator,
+                             kMonobitFivePercentThresholdDenominator);
+    case kRandomnessQualitySignificanceOnePercent:
+      return threshold_check(stat_numerator, stat_denominator,
+                             kMonobitOnePercentThresholdNumerator,
+                             kMonobitOnePercentThresholdDenominator);
+    default:
+      return INVALID_ARGUMENT();
+  }
+}
+
 status_t randomness_quality_monobit_test(
     uint8_t *data, size_t len, randomness_quality_significance_t significance) {
   // Guard against overflow in the bit-count.
-  TRY_CHECK(len <= UINT32_MAX);
-
-  // Count the number of zeroes and the number of ones in the data.
-  uint32_t num_ones = 0;
-  uint32_t num_zeroes = 0;
-  for (size_t i = 0; i < len; i++) {
-    uint8_t byte = data[i];
-    for (size_t j = 0; j < 8; j++) {
-      num_ones += byte & 1;
-      num_zeroes += (byte ^ 1) & 1;
-      byte >>= 1;
-    }
+  TRY_CHECK(len <= kMaxNumBits / 8);
+
+  // Count the number of ones in the data, a word at a time where possible.
+  uint64_t num_ones = 0;
+  size_t i = 0;
+  for (; i < len && misalignment32_of((uintptr_t)&data[i]) != 0; ++i) {
+    num_ones += (uint32_t)bitfield_popcount32(data[i]);
+  }
+  for (; len - i >= sizeof(uint32_t); i += sizeof(uint32_t)) {
+    num_ones += (uint32_t)bitfield_popcount32(read_32(&data[i]));
   }
+  for (; i < len; ++i) {
+    num_ones += (uint32_t)bitfield_popcount32(data[i]);
+  }
+  uint64_t num_bits = (uint64_t)len * 8;
 
   // Numerical result of the test is (#zeroes - #ones)^2 / bitlen.
-  uint64_t numerator = diff_squared(num_ones, num_zeroes);
-  uint64_t denominator = len * 8;
+  return one_dof_check(diff_squared(num_ones, num_bits - num_ones), num_bits,
+                       significance);
+}
 
-  // Retrieve the threshold values.
-  uint64_t threshold_numerator = 0;
-  uint64_t threshold_denominator = 1;
-  switch (significance) {
-    case kRandomnessQualitySignificanceFivePercent: {
-      threshold_numerator = kMonobitFivePercentThresholdNumerator;
-      threshold_denominator = kMonobitFivePercentThresholdDenominator;
-      break;
+void randomness_quality_init(randomness_quality_ctx_t *ctx) {
+  *ctx = (randomness_quality_ctx_t){0};
+}
+
+status_t randomness_quality_update(randomness_quality_ctx_t *ctx,
+                                   const uint32_t *data, size_t len) {
+  TRY_CHECK(len <= (kMaxNumBits - ctx->num_bits) / 32);
+
+  for (size_t i = 0; i < len; ++i) {
+    uint32_t word = data[i];
+    ctx->num_ones += (uint32_t)bitfield_popcount32(word);
+
+    // Bit `j` of `changes` is set if bits `j` and `j + 1` of the word differ;
+    // the top bit has no successor in this word and is masked off.
+    uint32_t changes = (word ^ (word >> 1)) & 0x7fffffff;
+    ctx->num_transitions += (uint32_t)bitfield_popcount32(changes);
+    if (ctx->num_bits != 0) {
+      ctx->num_transitions += (word & 1) ^ ctx->last_bit;
     }
-    case kRandomnessQualitySignificanceOnePercent: {
-      threshold_numerator = kMonobitOnePercentThresholdNumerator;
-      threshold_denominator = kMonobitOnePercentThresholdDenominator;
-      break;
+    ctx->last_bit = word >> 31;
+
+    for (size_t j = 0; j < 32; j += 4) {
+      ++ctx->poker_counts[(word >> j) & 0xf];
     }
-    default:
-      return INVALID_ARGUMENT();
+    ctx->num_bits += 32;
   }
+  return OK_STATUS();
+}
 
-  // Return true if the result value is <= to the threshold.
-  uint64_t lhs = (numerator * threshold_denominator);
-  uint64_t rhs = (threshold_numerator * denominator);
-  TRY_CHECK(lhs <= rhs);
+status_t randomness_quality_monobit_check(
+    const randomness_quality_ctx_t *ctx,
+    randomness_quality_significance_t significance) {
+  TRY_CHECK(ctx->num_bits > 0);
+  // Numerical result of the test is (#zeroes - #ones)^2 / bitlen.
+  uint64_t num_zeroes = ctx->num_bits - ctx->num_ones;
+  return one_dof_check(diff_squared(ctx->num_ones, num_zeroes), ctx->num_bits,
+                       significance);
+}
 
-  return OK_STATUS();
+status_t randomness_quality_runs_check(
+    const randomness_quality_ctx_t *ctx,
+    randomness_quality_significance_t significance) {
+  TRY_CHECK(ctx->num_bits > 1);
+  // Each of the n - 1 pairs of adjacent bits differs with probability 1/2, so
+  // (2 * #transitions - (n - 1))^2 / (n - 1) is approximately chi-square
+  // distributed with one degree of freedom.
+  uint64_t num_pairs = ctx->num_bits - 1;
+  return one_dof_check(diff_squared(2 * ctx->num_transitions, num_pairs),
+                       num_pairs, significance);
+}
+
+status_t randomness_quality_poker_check(
+    const randomness_quality_ctx_t *ctx,
+    randomness_quality_significance_t significance) {
+  TRY_CHECK(ctx->num_bits > 0);
+  // Numerical result of the test is (16 / k) * sum(n_i^2) - k, where k is the
+  // number of 4-bit blocks and n_i the number of occurrences of the value i.
+  // Scaling by k gives an integer numerator.
+  uint64_t num_blocks = ctx->num_bits / 4;
+  uint64_t sum_squares = 0;
+  for (size_t i = 0; i < ARRAYSIZE(ctx->poker_counts); ++i) {
+    sum_squares += (uint64_t)ctx->poker_counts[i] * ctx->poker_counts[i];
+  }
+  uint64_t numerator = 16 * sum_squares - num_blocks * num_blocks;
+  uint64_t denominator = num_blocks;
+
+  switch (significance) {
+    case kRandomnessQualitySignificanceFivePercent:
+      return threshold_check(numerator, denominator,
+                             kPokerFivePercentThresholdNumerator,
+                             kPokerFivePercentThresholdDenominator);
+    case kRandomnessQualitySignificanceOnePercent:
+      return threshold_check(numerator, denominator,
+                             kPokerOnePercentThresholdNumerator,
+                             kPokerOnePercentThresholdDenominator);
+    default:
+      return INVALID_ARGUMENT();
+  }
 }
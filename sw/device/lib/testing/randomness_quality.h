@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_RANDOMNESS_QUALITY_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_RANDOMNESS_QUALITY_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/status.h"
@@ -46,6 +47,101 @@ typedef enum randomness_quality_significance {
 status_t randomness_quality_monobit_test(
     uint8_t *data, size_t len, randomness_quality_significance_t significance);
 
+/**
+ * State of the streaming statistical tests.
+ *
+ * Accumulates the counts needed by the monobit, runs and poker tests, so that
+ * large samples can be checked in chunks, e.g. as they are read from
+ * entropy_src or CSRNG, without buffering the whole sample. The fields are
+ * internal to this library.
+ *
+ * Bits are consumed from the least significant bit of each word upwards, in
+ * the same order as `randomness_quality_monobit_test()` on little-endian data.
+ */
+typedef struct randomness_quality_ctx {
+  /**
+   * Number of bits consumed so far.
+   */
+  uint64_t num_bits;
+  /**
+   * Number of one bits.
+   */
+  uint64_t num_ones;
+  /**
+   * Number of pairs of adjacent bits that differ.
+   */
+  uint64_t num_transitions;
+  /**
+   * Value of the last bit consumed.
+   */
+  uint32_t last_bit;
+  /**
+   * Number of occurrences of each 4-bit value, for the poker test.
+   */
+  uint32_t poker_counts[16];
+} randomness_quality_ctx_t;
+
+/**
+ * Initializes the state of the streaming statistical tests.
+ *
+ * @param[out] ctx State to initialize.
+ */
+void randomness_quality_init(randomness_quality_ctx_t *ctx);
+
+/**
+ * Adds a chunk of data to the streaming statistical tests.
+ *
+ * At most 2^31 bits can be consumed in total.
+ *
+ * @param ctx State of the tests.
+ * @param data Random data to add.
+ * @param len Length of data in words.
+ * @return OK if the data was added, a failure code otherwise.
+ */
+status_t randomness_quality_update(randomness_quality_ctx_t *ctx,
+                                   const uint32_t *data, size_t len);
+
+/**
+ * Monobit test over all data added to `ctx`.
+ *
+ * Same test as `randomness_quality_monobit_test()`.
+ *
+ * @param ctx State of the tests.
+ * @param significance Test statistical significance setting.
+ * @return OK if the test passes, a failure code otherwise.
+ */
+status_t randomness_quality_monobit_check(
+    const randomness_quality_ctx_t *ctx,
+    randomness_quality_significance_t significance);
+
+/**
+ * Runs test over all data added to `ctx`.
+ *
+ * This test counts the number of runs, i.e. of pairs of adjacent bits that
+ * differ, and expects it to be roughly half the number of bits.
+ *
+ * @param ctx State of the tests.
+ * @param significance Test statistical significance setting.
+ * @return OK if the test passes, a failure code otherwise.
+ */
+status_t randomness_quality_runs_check(
+    const randomness_quality_ctx_t *ctx,
+    randomness_quality_significance_t significance);
+
+/**
+ * Poker test from section 5.4.4 of the Handbook of Applied Cryptography.
+ *
+ * This test splits the data in 4-bit blocks and expects each of the 16
+ * possible values to occur roughly equally often.
+ *
+ * @param ctx State of the tests.
+ * @param significance Test statistical significance setting.
+ * @return OK if the test passes, a failure code otherwise.
+ */
+status_t randomness_quality_poker_check(
+    const randomness_quality_ctx_t *ctx,
+    randomness_quality_significance_t significance);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -19,9 +19,9 @@ void rv_plic_testutils_irq_range_enable(dif_rv_plic_t *plic,
     uint32_t priority = rand_testutils_gen32_range(kDifRvPlicMinPriority + 1,
                                                    kDifRvPlicMaxPriority);
     CHECK_DIF_OK(dif_rv_plic_irq_set_priority(plic, irq_id, priority));
-    CHECK_DIF_OK(
-        dif_rv_plic_irq_set_enabled(plic, irq_id, target, kDifToggleEnabled));
   }
+  CHECK_DIF_OK(dif_rv_plic_irq_range_set_enabled(
+      plic, start_irq_id, end_irq_id, target, kDifToggleEnabled));
   CHECK_DIF_OK(
       dif_rv_plic_target_set_threshold(plic, target, kDifRvPlicMinPriority));
 }
@@ -0,0 +1,141 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/rv_timer_testutils.h"
+
+#include <stdbool.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/dif/dif_rv_timer.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+
+#define MODULE_ID MAKE_MODULE_ID('r', 't', 't')
+
+enum {
+  kHartId = 0,
+  kComparatorId = 0,
+};
+
+static uint64_t saturating_add(uint64_t a, uint64_t b) {
+  return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+static void swap_entries(rv_timer_testutils_deadline_t *heap, size_t i,
+                         size_t j) {
+  rv_timer_testutils_deadline_t tmp = heap[i];
+  heap[i] = heap[j];
+  heap[j] = tmp;
+}
+
+static void sift_up(rv_timer_testutils_deadline_t *heap, size_t i) {
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (heap[parent].expiry <= heap[i].expiry) {
+      break;
+    }
+    swap_entries(heap, i, parent);
+    i = parent;
+  }
+}
+
+static void sift_down(rv_timer_testutils_deadline_t *heap, size_t count,
+                      size_t i) {
+  while (true) {
+    size_t min = i;
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    if (left < count && heap[left].expiry < heap[min].expiry) {
+      min = left;
+    }
+    if (right < count && heap[right].expiry < heap[min].expiry) {
+      min = right;
+    }
+    if (min == i) {
+      break;
+    }
+    swap_entries(heap, i, min);
+    i = min;
+  }
+}
+
+/**
+ * Arms the comparator for the earliest deadline, skipping the write if it is
+ * already armed for it.
+ */
+static status_t arm_earliest(rv_timer_testutils_deadlines_t *deadlines) {
+  uint64_t threshold =
+      deadlines->count > 0 ? deadlines->heap[0].expiry : UINT64_MAX;
+  if (threshold != deadlines->armed) {
+    TRY(dif_rv_timer_arm(deadlines->timer, kHartId, kComparatorId, threshold));
+    deadlines->armed = threshold;
+  }
+  return OK_STATUS();
+}
+
+status_t rv_timer_testutils_deadlines_init(
+    rv_timer_testutils_deadlines_t *deadlines, const dif_rv_timer_t *timer,
+    uint64_t slack, rv_timer_testutils_deadline_t *storage, size_t capacity) {
+  TRY_CHECK(deadlines != NULL && timer != NULL && storage != NULL);
+  TRY_CHECK(capacity > 0);
+
+  deadlines->timer = timer;
+  deadlines->slack = slack;
+  deadlines->heap = storage;
+  deadlines->capacity = capacity;
+  deadlines->count = 0;
+  TRY(dif_rv_timer_arm(timer, kHartId, kComparatorId, UINT64_MAX));
+  deadlines->armed = UINT64_MAX;
+
+  return OK_STATUS();
+}
+
+status_t rv_timer_testutils_deadlines_add(
+    rv_timer_testutils_deadlines_t *deadlines, uint64_t delay, uint64_t period,
+    rv_timer_testutils_deadline_cb_t callback, void *arg) {
+  TRY_CHECK(deadlines != NULL && callback != NULL);
+  TRY_CHECK(deadlines->count < deadlines->capacity);
+
+  uint64_t now;
+  TRY(dif_rv_timer_counter_read(deadlines->timer, kHartId, &now));
+
+  size_t i = deadlines->count++;
+  deadlines->heap[i] = (rv_timer_testutils_deadline_t){
+      .expiry = saturating_add(now, delay),
+      .period = period,
+      .callback = callback,
+      .arg = arg,
+  };
+  sift_up(deadlines->heap, i);
+
+  return arm_earliest(deadlines);
+}
+
+status_t rv_timer_testutils_deadlines_irq_handler(
+    rv_timer_testutils_deadlines_t *deadlines) {
+  rv_timer_testutils_deadline_t *heap = deadlines->heap;
+
+  uint64_t now;
+  TRY(dif_rv_timer_counter_read(deadlines->timer, kHartId, &now));
+  uint64_t limit = saturating_add(now, deadlines->slack);
+
+  while (deadlines->count > 0 && heap[0].expiry <= limit) {
+    rv_timer_testutils_deadline_t expired = heap[0];
+    // Update the heap before the callback so that it may add deadlines.
+    if (expired.period != 0 && expired.expiry != UINT64_MAX) {
+      heap[0].expiry = saturating_add(expired.expiry, expired.period);
+    } else {
+      heap[0] = heap[--deadlines->count];
+    }
+    sift_down(heap, deadlines->count, 0);
+    expired.callback(expired.arg);
+  }
+
+  // Move the comparator away before acknowledging, as the interrupt is raised
+  // again for as long as the counter is past it.
+  TRY(arm_earliest(deadlines));
+  TRY(dif_rv_timer_irq_acknowledge(deadlines->timer,
+                                   kDifRvTimerIrqTimerExpiredHart0Timer0));
+
+  return OK_STATUS();
+}
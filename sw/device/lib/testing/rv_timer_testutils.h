@@ -0,0 +1,109 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_RV_TIMER_TESTUTILS_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_RV_TIMER_TESTUTILS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_rv_timer.h"
+
+/**
+ * Function called when a software deadline expires.
+ *
+ * Runs in the context of `rv_timer_testutils_deadlines_irq_handler()`.
+ */
+typedef void (*rv_timer_testutils_deadline_cb_t)(void *arg);
+
+/**
+ * A software deadline.
+ */
+typedef struct rv_timer_testutils_deadline {
+  /**
+   * Counter value at which the deadline expires.
+   */
+  uint64_t expiry;
+  /**
+   * Number of counter ticks between expirations, or zero for a one-shot
+   * deadline.
+   */
+  uint64_t period;
+  rv_timer_testutils_deadline_cb_t callback;
+  void *arg;
+} rv_timer_testutils_deadline_t;
+
+/**
+ * A set of software deadlines multiplexed onto hart 0's only comparator.
+ *
+ * The deadlines are kept in a min-heap in caller-provided storage, and the
+ * comparator is only reprogrammed when the earliest deadline changes. The
+ * fields are private and must not be modified directly.
+ */
+typedef struct rv_timer_testutils_deadlines {
+  const dif_rv_timer_t *timer;
+  uint64_t slack;
+  rv_timer_testutils_deadline_t *heap;
+  size_t capacity;
+  size_t count;
+  uint64_t armed;
+} rv_timer_testutils_deadlines_t;
+
+/**
+ * Initializes an empty set of deadlines and disarms the comparator.
+ *
+ * The timer's tick parameters, counter and `timer_expired_hart0_timer0`
+ * interrupt are left to the caller, who must route that interrupt to
+ * `rv_timer_testutils_deadlines_irq_handler()`.
+ *
+ * @param deadlines Deadline set.
+ * @param timer An rv_timer handle.
+ * @param slack Deadlines expiring within this many ticks of the one that
+ *        raised the interrupt are handled by the same interrupt.
+ * @param storage Storage for the heap.
+ * @param capacity Number of entries in `storage`; must be non-zero.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t rv_timer_testutils_deadlines_init(
+    rv_timer_testutils_deadlines_t *deadlines, const dif_rv_timer_t *timer,
+    uint64_t slack, rv_timer_testutils_deadline_t *storage, size_t capacity);
+
+/**
+ * Adds a deadline expiring `delay` ticks from now.
+ *
+ * The comparator is rearmed if the new deadline is the earliest one. Must not
+ * be called while the timer interrupt can preempt the caller.
+ *
+ * @param deadlines Deadline set.
+ * @param delay Number of ticks until the first expiration.
+ * @param period Number of ticks between subsequent expirations, or zero for a
+ *        one-shot deadline.
+ * @param callback Function to call on every expiration.
+ * @param arg Argument passed to `callback`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t rv_timer_testutils_deadlines_add(
+    rv_timer_testutils_deadlines_t *deadlines, uint64_t delay, uint64_t period,
+    rv_timer_testutils_deadline_cb_t callback, void *arg);
+
+/**
+ * Handles the expired deadlines; to be called from the test's timer ISR.
+ *
+ * Calls back every deadline expiring within the slack of the current counter
+ * value, earliest first. Periodic deadlines are rescheduled one period after
+ * their previous expiry, so they do not drift but may run more than once if
+ * they fall behind. The comparator is then armed for the earliest remaining
+ * deadline before the interrupt is acknowledged.
+ *
+ * @param deadlines Deadline set.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t rv_timer_testutils_deadlines_irq_handler(
+    rv_timer_testutils_deadlines_t *deadlines);
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_RV_TIMER_TESTUTILS_H_
@@ -7,6 +7,9 @@
 #include "sw/device/lib/dif/dif_spi_device.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+#include "spi_device_regs.h"  // Generated.
+
 #define MODULE_ID MAKE_MODULE_ID('s', 'd', 't')
 
 status_t spi_device_testutils_configure_passthrough(
@@ -326,8 +329,15 @@ status_t spi_device_testutils_configure_read_pipeline(
   return OK_STATUS();
 }
 
-status_t spi_device_testutils_wait_for_upload(dif_spi_device_handle_t *spid,
-                                              upload_info_t *info) {
+/**
+ * Waits for a spi command upload and populates `info`.
+ *
+ * If `payload` is `NULL`, the payload is copied into `info->data`. Otherwise
+ * `*payload` is pointed at the payload in the ingress buffer and `info->data`
+ * is left untouched.
+ */
+static status_t wait_for_upload(dif_spi_device_handle_t *spid,
+                                upload_info_t *info, const uint8_t **payload) {
   // Wait for a SPI transaction cause an upload.
   bool upload_pending;
   do {
@@ -368,8 +378,16 @@ status_t spi_device_testutils_wait_for_upload(dif_spi_device_handle_t *spid,
       // We aren't expecting more than 256 bytes of data.
       return INVALID_ARGUMENT();
     }
-    TRY(dif_spi_device_read_flash_payload_buffer(spid, start, info->data_len,
-                                                 info->data));
+    if (payload == NULL) {
+      TRY(dif_spi_device_read_flash_payload_buffer(spid, start, info->data_len,
+                                                   info->data));
+    } else {
+      uint32_t mmio_offset;
+      TRY(dif_spi_device_get_flash_payload_buffer_offset(
+          spid, start, info->data_len, &mmio_offset));
+      *payload = (const uint8_t *)(uintptr_t)(
+          TOP_EARLGREY_SPI_DEVICE_BASE_ADDR + mmio_offset);
+    }
   }
 
   // Finished: ack the IRQ.
@@ -377,3 +395,104 @@ status_t spi_device_testutils_wait_for_upload(dif_spi_device_handle_t *spid,
                                      kDifSpiDeviceIrqUploadCmdfifoNotEmpty));
   return OK_STATUS();
 }
+
+status_t spi_device_testutils_wait_for_upload(dif_spi_device_handle_t *spid,
+                                              upload_info_t *info) {
+  return wait_for_upload(spid, info, NULL);
+}
+
+status_t spi_device_testutils_wait_for_upload_in_place(
+    dif_spi_device_handle_t *spid, upload_info_t *info,
+    const uint8_t **payload) {
+  TRY_CHECK(payload != NULL);
+  *payload = NULL;
+  return wait_for_upload(spid, info, payload);
+}
+
+enum {
+  /**
+   * Size of the read buffer in bytes.
+   */
+  kReadBufferSize = SPI_DEVICE_PARAM_SRAM_READ_BUFFER_DEPTH * sizeof(uint32_t),
+  /**
+   * Size of one half of the read buffer in bytes.
+   */
+  kReadBufferHalfSize = kReadBufferSize / 2,
+};
+
+/**
+ * Fills the read buffer half that holds flash address `addr`, which must be
+ * aligned to the half size.
+ */
+static status_t readbuf_fill_half(
+    dif_spi_device_handle_t *spid,
+    const spi_device_testutils_readbuf_prefetch_t *prefetch, uint32_t addr) {
+  static const uint32_t kErased[16] = {
+      UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+      UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+      UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+  };
+  uint32_t offset = addr % kReadBufferSize;
+  size_t copy_len = 0;
+  if (addr < prefetch->len) {
+    copy_len = prefetch->len - addr;
+    if (copy_len > kReadBufferHalfSize) {
+      copy_len = kReadBufferHalfSize;
+    }
+    TRY(dif_spi_device_write_flash_buffer(spid,
+                                          kDifSpiDeviceFlashBufferTypeEFlash,
+                                          offset, copy_len,
+                                          &prefetch->src[addr]));
+  }
+  // Pad past the end of the image with erased flash contents.
+  for (size_t i = copy_len; i < kReadBufferHalfSize; i += sizeof(kErased)) {
+    size_t pad_len = kReadBufferHalfSize - i;
+    if (pad_len > sizeof(kErased)) {
+      pad_len = sizeof(kErased);
+    }
+    TRY(dif_spi_device_write_flash_buffer(
+        spid, kDifSpiDeviceFlashBufferTypeEFlash, offset + (uint32_t)i,
+        pad_len, (const uint8_t *)kErased));
+  }
+  return OK_STATUS();
+}
+
+status_t spi_device_testutils_readbuf_prefetch_init(
+    dif_spi_device_handle_t *spid,
+    spi_device_testutils_readbuf_prefetch_t *prefetch, const uint8_t *src,
+    size_t len) {
+  TRY_CHECK(prefetch != NULL && (src != NULL || len == 0));
+  *prefetch = (spi_device_testutils_readbuf_prefetch_t){
+      .src = src,
+      .len = len,
+      .filled_end = 0,
+  };
+  TRY(dif_spi_device_reset_eflash_buffer(spid));
+  for (; prefetch->filled_end < kReadBufferSize;
+       prefetch->filled_end += kReadBufferHalfSize) {
+    TRY(readbuf_fill_half(spid, prefetch, prefetch->filled_end));
+  }
+  TRY(dif_spi_device_set_eflash_read_threshold(spid, kReadBufferHalfSize / 2));
+  return OK_STATUS();
+}
+
+status_t spi_device_testutils_readbuf_prefetch_service(
+    dif_spi_device_handle_t *spid,
+    spi_device_testutils_readbuf_prefetch_t *prefetch) {
+  uint32_t addr;
+  TRY(dif_spi_device_get_last_read_address(spid, &addr));
+  uint32_t half_start = addr & ~(uint32_t)(kReadBufferHalfSize - 1);
+  if (half_start >= prefetch->filled_end ||
+      half_start < prefetch->filled_end - kReadBufferSize) {
+    // The host jumped outside of the buffered range, start over from the half
+    // it is reading.
+    prefetch->filled_end = half_start;
+  }
+  // Keep the half after the one the host is reading filled.
+  uint32_t want_end = half_start + kReadBufferSize;
+  while (prefetch->filled_end < want_end) {
+    TRY(readbuf_fill_half(spid, prefetch, prefetch->filled_end));
+    prefetch->filled_end += kReadBufferHalfSize;
+  }
+  return OK_STATUS();
+}
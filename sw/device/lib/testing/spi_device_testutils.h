@@ -127,4 +127,87 @@ OT_WARN_UNUSED_RESULT
 status_t spi_device_testutils_wait_for_upload(dif_spi_device_handle_t *spid,
                                               upload_info_t *info);
 
+/**
+ * Wait for a spi command upload without copying its payload.
+ *
+ * Same as `spi_device_testutils_wait_for_upload()`, except that `info->data`
+ * is not filled. Instead, `payload` is pointed at the `info->data_len` payload
+ * bytes in the spi_device ingress buffer, or set to `NULL` if the command has
+ * no payload. The payload stays valid until the next command with a payload is
+ * uploaded, i.e. as long as the flash status BUSY bit is kept set.
+ *
+ * @param spid A spid_device DIF handle.
+ * @param info Pointer to an upload_info_t.
+ * @param[out] payload The location of the payload in the ingress buffer.
+ * @return A status_t indicating success or failure in receving the uploaded
+ *         command.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_device_testutils_wait_for_upload_in_place(
+    dif_spi_device_handle_t *spid, upload_info_t *info,
+    const uint8_t **payload);
+
+/**
+ * State of the spi_device read buffer prefetcher.
+ *
+ * In flash mode, spi_device serves read commands from a read buffer that is
+ * split into two halves. When the host crosses into one half, the other one
+ * can be refilled with the flash contents that follow. The prefetcher keeps
+ * the read buffer filled ahead of sequential host reads from a memory-mapped
+ * image, e.g. a region of the embedded flash.
+ */
+typedef struct spi_device_testutils_readbuf_prefetch {
+  /**
+   * Contents of the emulated flash, starting at flash address 0.
+   */
+  const uint8_t *src;
+  /**
+   * Size of `src` in bytes. Reads beyond it return `0xff`.
+   */
+  size_t len;
+  /**
+   * End (exclusive) of the flash address range held in the read buffer.
+   */
+  uint32_t filled_end;
+} spi_device_testutils_readbuf_prefetch_t;
+
+/**
+ * Initialize the read buffer prefetcher.
+ *
+ * Clears the read buffer state, fills both halves with the start of `src`,
+ * and sets the read threshold to the middle of each half so that the
+ * `kDifSpiDeviceIrqReadbufWatermark` interrupt fires while the host is still
+ * reading the current half.
+ *
+ * @param spid A spi_device DIF handle, configured in flash mode.
+ * @param[out] prefetch The prefetcher state.
+ * @param src Contents of the emulated flash.
+ * @param len Size of `src` in bytes.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_device_testutils_readbuf_prefetch_init(
+    dif_spi_device_handle_t *spid,
+    spi_device_testutils_readbuf_prefetch_t *prefetch, const uint8_t *src,
+    size_t len);
+
+/**
+ * Refill the read buffer ahead of the host.
+ *
+ * Meant to be called when the `kDifSpiDeviceIrqReadbufFlip` or
+ * `kDifSpiDeviceIrqReadbufWatermark` interrupt fires; the caller acknowledges
+ * the interrupts. Based on the last address read by the host, refills the half
+ * the host is not reading with the flash contents that follow. If the host
+ * jumped outside of the buffered range, both halves are refilled around the
+ * new address. Calling this function again without new host reads is a no-op.
+ *
+ * @param spid A spi_device DIF handle.
+ * @param prefetch The prefetcher state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_device_testutils_readbuf_prefetch_service(
+    dif_spi_device_handle_t *spid,
+    spi_device_testutils_readbuf_prefetch_t *prefetch);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_SPI_DEVICE_TESTUTILS_H_
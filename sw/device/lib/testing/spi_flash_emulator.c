@@ -36,22 +36,43 @@ typedef struct sfdp {
   bfpt_t bfpt;
 } sfdp_t;
 
+/**
+ * Flash descriptors presented to the upstream host, derived from the backend
+ * EEPROM.
+ */
+typedef struct descriptors {
+  // The downstream-visible SFDP table.
+  sfdp_t sfdp;
+  // The quad-enable mechanism of the backend EEPROM.
+  uint8_t quad_enable;
+} descriptors_t;
+
+/**
+ * Descriptors kept across emulator runs in the cached-descriptor mode.
+ */
+static struct {
+  bool valid;
+  // Whether the backend EEPROM's QE bit has been set.
+  bool quad_enabled;
+  descriptors_t descriptors;
+} cache;
+
 // This function prepares the downstream-visible SFDP table.
 // Out of convenience, it also checks the quad-enable mechanism from
-// the backend EEPROM part and returns the mechanism value
+// the backend EEPROM part.
 //
 // TODO: Restructure this into something more general for dealing
 // with backend-eeprom properties that the emulator loop might
 // care about.
-static status_t read_and_prepare_sfdp(dif_spi_host_t *spih,
-                                      dif_spi_device_handle_t *spid) {
+static status_t read_descriptors(dif_spi_host_t *spih,
+                                 descriptors_t *descriptors) {
   alignas(uint32_t) uint8_t data[256];
   TRY(spi_flash_testutils_read_sfdp(spih, 0, data, sizeof(data)));
 
   // TODO: present a better SFDP table.  This table is as simple
   // as possible and copies only a few bits of relevant data
   // from the backend EEPROM's table.
-  sfdp_t sfdp = {
+  descriptors->sfdp = (sfdp_t){
       .header = {.signature = kSfdpSignature,
                  .minor = 0,
                  .major = 1,
@@ -68,6 +89,7 @@ static status_t read_and_prepare_sfdp(dif_spi_host_t *spih,
           },
       .bfpt = {0},
   };
+  sfdp_t *sfdp = &descriptors->sfdp;
 
   uint32_t offset =
       read_32(data + offsetof(sfdp_t, param.table_pointer)) & 0x00FFFFFF;
@@ -80,28 +102,56 @@ static status_t read_and_prepare_sfdp(dif_spi_host_t *spih,
   // block_erase_size, write_granularity, write_en_required, write_en_opcode,
   // erase_opcode, support_fast_read_112, address_modes and
   // support_fast_read_114 fields.
-  sfdp.bfpt.data[0] = read_32(data + offset);
-  sfdp.bfpt.data[0] &= 0x0047FFFF;
+  sfdp->bfpt.data[0] = read_32(data + offset);
+  sfdp->bfpt.data[0] &= 0x0047FFFF;
   // Preserve the entire density field.
-  sfdp.bfpt.data[1] = read_32(data + offset + 1 * sizeof(uint32_t));
+  sfdp->bfpt.data[1] = read_32(data + offset + 1 * sizeof(uint32_t));
   // Preserve the 1-1-4 parameters, discard the 1-4-4 parameters.
-  sfdp.bfpt.data[2] = read_32(data + offset + 2 * sizeof(uint32_t));
-  sfdp.bfpt.data[2] &= 0xFFFF0000;
+  sfdp->bfpt.data[2] = read_32(data + offset + 2 * sizeof(uint32_t));
+  sfdp->bfpt.data[2] &= 0xFFFF0000;
   // Preserve the sector erase information.
-  sfdp.bfpt.data[7] = read_32(data + offset + 7 * sizeof(uint32_t));
-  sfdp.bfpt.data[8] = read_32(data + offset + 8 * sizeof(uint32_t));
+  sfdp->bfpt.data[7] = read_32(data + offset + 7 * sizeof(uint32_t));
+  sfdp->bfpt.data[8] = read_32(data + offset + 8 * sizeof(uint32_t));
 
-  TRY(dif_spi_device_write_flash_buffer(spid, kDifSpiDeviceFlashBufferTypeSfdp,
-                                        0, sizeof(sfdp), (uint8_t *)&sfdp));
-
-  uint32_t quad_enable = 0;
+  descriptors->quad_enable = 0;
   if (length >= 14) {
     // JESD216F, section 6.4.18:
     // The Quad Enable mechanism is bits 20:23 of the 15th dword.
-    quad_enable = read_32(data + offset + 14 * sizeof(uint32_t));
-    quad_enable = bitfield_field32_read(quad_enable, SPI_FLASH_QUAD_ENABLE);
+    uint32_t quad_enable = read_32(data + offset + 14 * sizeof(uint32_t));
+    descriptors->quad_enable =
+        (uint8_t)bitfield_field32_read(quad_enable, SPI_FLASH_QUAD_ENABLE);
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Presents the SFDP table to the upstream host and sets the backend EEPROM's
+ * QE bit.
+ *
+ * In the cached-descriptor mode, the backend EEPROM's SFDP is only read, and
+ * its QE bit only set, on the first run.
+ */
+static status_t prepare_sfdp(dif_spi_host_t *spih,
+                             dif_spi_device_handle_t *spid, bool use_cache) {
+  if (!use_cache || !cache.valid) {
+    cache.valid = false;
+    TRY(read_descriptors(spih, &cache.descriptors));
+    cache.valid = true;
+    cache.quad_enabled = false;
   }
-  return OK_STATUS((int32_t)quad_enable);
+  const descriptors_t *descriptors = &cache.descriptors;
+  TRY(dif_spi_device_write_flash_buffer(
+      spid, kDifSpiDeviceFlashBufferTypeSfdp, 0, sizeof(descriptors->sfdp),
+      (const uint8_t *)&descriptors->sfdp));
+
+  if (!use_cache || !cache.quad_enabled) {
+    LOG_INFO("Setting the EEPROM's QE bit via mechanism %d",
+             descriptors->quad_enable);
+    TRY(spi_flash_testutils_quad_enable(spih, descriptors->quad_enable,
+                                        /*enabled=*/true));
+    cache.quad_enabled = true;
+  }
+  return OK_STATUS();
 }
 
 static status_t prepare_jedec_id(dif_spi_device_handle_t *spid) {
@@ -116,24 +166,87 @@ static status_t prepare_jedec_id(dif_spi_device_handle_t *spid) {
   return OK_STATUS();
 }
 
+/**
+ * Waits until the backend EEPROM has finished the program in flight, and
+ * hands the bus back to the upstream host if `passthrough` is set.
+ */
+static status_t backend_finish(dif_spi_host_t *spih,
+                               dif_spi_device_handle_t *spid, bool *busy,
+                               bool passthrough) {
+  if (*busy) {
+    TRY(spi_flash_testutils_wait_until_not_busy(spih));
+    *busy = false;
+  }
+  if (passthrough) {
+    TRY(dif_spi_device_set_passthrough_mode(spid, kDifToggleEnabled));
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Waits for the next upload while the backend EEPROM finishes a pipelined
+ * program.
+ *
+ * Passthrough is restored as soon as the backend EEPROM is idle, unless an
+ * upload arrives first.
+ */
+static status_t backend_poll_until_upload(dif_spi_host_t *spih,
+                                          dif_spi_device_handle_t *spid,
+                                          bool *busy) {
+  while (*busy) {
+    bool upload_pending;
+    TRY(dif_spi_device_irq_is_pending(
+        &spid->dev, kDifSpiDeviceIrqUploadCmdfifoNotEmpty, &upload_pending));
+    if (upload_pending) {
+      return OK_STATUS();
+    }
+    int32_t status = TRY(
+        spi_flash_testutils_read_status(spih, kSpiDeviceFlashOpReadStatus1, 1));
+    if ((status & kSpiFlashStatusBitWip) == 0) {
+      *busy = false;
+      TRY(dif_spi_device_set_passthrough_mode(spid, kDifToggleEnabled));
+    }
+  }
+  return OK_STATUS();
+}
+
 status_t spi_flash_emulator(dif_spi_host_t *spih,
                             dif_spi_device_handle_t *spid) {
+  spi_flash_emulator_config_t config = {0};
+  return spi_flash_emulator_with_config(spih, spid, &config);
+}
+
+void spi_flash_emulator_cache_reset(void) { cache.valid = false; }
+
+status_t spi_flash_emulator_with_config(
+    dif_spi_host_t *spih, dif_spi_device_handle_t *spid,
+    const spi_flash_emulator_config_t *config) {
   // TODO: add a mode that uses spi_device address translation.
   LOG_INFO("Configuring spi_flash_emulator.");
   TRY(dif_spi_device_set_passthrough_mode(spid, kDifToggleDisabled));
   TRY(prepare_jedec_id(spid));
-  uint8_t quad_enable = (uint8_t)TRY(read_and_prepare_sfdp(spih, spid));
-  LOG_INFO("Setting the EEPROM's QE bit via mechanism %d", quad_enable);
-  TRY(spi_flash_testutils_quad_enable(spih, quad_enable, /*enabled=*/true));
+  TRY(prepare_sfdp(spih, spid, config->cache_descriptors));
   TRY(dif_spi_device_set_passthrough_mode(spid, kDifToggleEnabled));
   LOG_INFO("Starting spi_flash_emulator.");
 
+  // Whether the backend EEPROM is still busy with a pipelined program. The
+  // bus stays with the SPI host, i.e. passthrough stays disabled, until it is
+  // done.
+  bool backend_busy = false;
   bool running = true;
   while (running) {
+    TRY(backend_poll_until_upload(spih, spid, &backend_busy));
+
     upload_info_t info = {0};
-    TRY(spi_device_testutils_wait_for_upload(spid, &info));
+    // Program payloads are forwarded to the SPI host straight from the
+    // spi_device ingress buffer. The host cannot upload the next payload
+    // before the BUSY bit is cleared at the end of this iteration.
+    const uint8_t *payload;
+    TRY(spi_device_testutils_wait_for_upload_in_place(spid, &info, &payload));
 
     TRY(dif_spi_device_set_passthrough_mode(spid, kDifToggleDisabled));
+    // Only one operation can be in flight on the backend EEPROM.
+    TRY(backend_finish(spih, spid, &backend_busy, /*passthrough=*/false));
     switch (info.opcode) {
       case kSpiDeviceFlashOpChipErase:
         TRY(spi_flash_testutils_erase_chip(spih));
@@ -150,8 +263,12 @@ status_t spi_flash_emulator(dif_spi_host_t *spih,
                                          info.address, info.addr_4b));
         break;
       case kSpiDeviceFlashOpPageProgram:
-        TRY(spi_flash_testutils_program_page(spih, info.data, info.data_len,
-                                             info.address, info.addr_4b));
+        // Once the payload is handed to the SPI host, the ingress buffer may
+        // take the next upload while the backend EEPROM is still programming.
+        TRY(spi_flash_testutils_program_op_start(
+            spih, kSpiDeviceFlashOpPageProgram, payload, info.data_len,
+            info.address, info.addr_4b, kTransactionWidthMode111));
+        backend_busy = true;
         break;
       case kSpiDeviceFlashOpSectorErase4b:
         TRY(spi_flash_testutils_erase_op(spih, kSpiDeviceFlashOpSectorErase4b,
@@ -166,10 +283,11 @@ status_t spi_flash_emulator(dif_spi_host_t *spih,
                                          info.address, /*addr_is_4b=*/true));
         break;
       case kSpiDeviceFlashOpPageProgram4b:
-        TRY(spi_flash_testutils_program_op(
-            spih, kSpiDeviceFlashOpPageProgram4b, info.data, info.data_len,
+        TRY(spi_flash_testutils_program_op_start(
+            spih, kSpiDeviceFlashOpPageProgram4b, payload, info.data_len,
             info.address,
             /*addr_is_4b=*/true, kTransactionWidthMode111));
+        backend_busy = true;
         break;
       case kSpiDeviceFlashOpReset:
         running = false;
@@ -177,7 +295,9 @@ status_t spi_flash_emulator(dif_spi_host_t *spih,
       default:
         LOG_ERROR("Unknown SPI op: %02x", info.opcode);
     }
-    TRY(dif_spi_device_set_passthrough_mode(spid, kDifToggleEnabled));
+    if (!backend_busy || !config->pipeline_programs || !running) {
+      TRY(backend_finish(spih, spid, &backend_busy, /*passthrough=*/true));
+    }
     TRY(dif_spi_device_set_flash_status_registers(spid, 0));
   }
   LOG_INFO("Exiting spi_flash_emulator.");
@@ -12,9 +12,35 @@
 #include "sw/device/lib/dif/dif_spi_device.h"
 #include "sw/device/lib/dif/dif_spi_host.h"
 
+/**
+ * Options of the SPI eeprom emulator.
+ */
+typedef struct spi_flash_emulator_config {
+  /**
+   * Read the backend eeprom's SFDP and set its QE bit only on the first run,
+   * and reuse the prepared descriptors on later runs.
+   *
+   * The cache can be dropped with `spi_flash_emulator_cache_reset()`.
+   */
+  bool cache_descriptors;
+  /**
+   * Acknowledge a page program to the upstream host as soon as its payload
+   * has been forwarded, without waiting for the backend eeprom to finish.
+   *
+   * The next upload is accepted into the spi_device payload buffer while the
+   * backend eeprom is still programming, so back-to-back programs do not pay
+   * for the backend WIP time twice. Passthrough is restored once the backend
+   * eeprom is idle: until then, the upstream host may poll the status and
+   * issue further uploaded commands, but its reads are not forwarded.
+   */
+  bool pipeline_programs;
+} spi_flash_emulator_config_t;
+
 /**
  * Emulate a SPI eeprom.
  *
+ * Same as `spi_flash_emulator_with_config()` with all options disabled.
+ *
  * @param spih A SPI host handle.
  * @param spid A SPI device handle.
  * @return A status.
@@ -22,4 +48,27 @@
 status_t spi_flash_emulator(dif_spi_host_t *spih,
                             dif_spi_device_handle_t *spid);
 
+/**
+ * Emulate a SPI eeprom.
+ *
+ * Presents the backend eeprom's JEDEC ID and SFDP to the upstream host, passes
+ * reads through and forwards uploaded program and erase commands to the
+ * backend eeprom until the upstream host issues a Reset.
+ *
+ * @param spih A SPI host handle.
+ * @param spid A SPI device handle.
+ * @param config Emulator options.
+ * @return A status.
+ */
+status_t spi_flash_emulator_with_config(
+    dif_spi_host_t *spih, dif_spi_device_handle_t *spid,
+    const spi_flash_emulator_config_t *config);
+
+/**
+ * Drop the descriptors cached by the cached-descriptor mode.
+ *
+ * Must be called if a different backend eeprom is attached.
+ */
+void spi_flash_emulator_cache_reset(void);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_SPI_FLASH_EMULATOR_H_
@@ -12,6 +12,40 @@
 
 #define MODULE_ID MAKE_MODULE_ID('s', 'f', 't')
 
+// JESD216F, section 6.4.2: fast read support bits of the 1st BFPT dword.
+enum {
+  kSfdpFastRead112Bit = 16,
+  kSfdpFastRead122Bit = 20,
+  kSfdpFastRead144Bit = 21,
+  kSfdpFastRead114Bit = 22,
+};
+
+// JESD216F, sections 6.4.4 and 6.4.5: each half of the 3rd and 4th BFPT
+// dwords describes one fast read mode.
+#define SFDP_FAST_READ_DUMMY ((bitfield_field32_t){.mask = 0x1f, .index = 0})
+#define SFDP_FAST_READ_MODE ((bitfield_field32_t){.mask = 0x7, .index = 5})
+#define SFDP_FAST_READ_OPCODE ((bitfield_field32_t){.mask = 0xff, .index = 8})
+
+/**
+ * Fast read capabilities of the SPI flash, parsed once from its SFDP.
+ */
+static struct {
+  bool valid;
+  /** 1st BFPT dword: supported fast read modes. */
+  uint32_t modes;
+  /** 3rd BFPT dword: 1-4-4 (low half) and 1-1-4 (high half) parameters. */
+  uint32_t quad;
+  /** 4th BFPT dword: 1-1-2 (low half) and 1-2-2 (high half) parameters. */
+  uint32_t dual;
+  /** Quad Enable mechanism from the 15th BFPT dword. */
+  uint8_t quad_enable_method;
+} read_caps;
+
+/**
+ * Whether the Quad Enable bit was set by `spi_flash_testutils_quad_enable()`.
+ */
+static bool quad_enabled;
+
 status_t spi_flash_testutils_read_id(dif_spi_host_t *spih,
                                      spi_flash_testutils_jedec_id_t *id) {
   TRY_CHECK(spih != NULL);
@@ -216,7 +250,7 @@ status_t spi_flash_testutils_erase_block64k(dif_spi_host_t *spih,
                                       address, addr_is_4b);
 }
 
-status_t spi_flash_testutils_program_op(
+status_t spi_flash_testutils_program_op_start(
     dif_spi_host_t *spih, uint8_t opcode, const void *payload, size_t length,
     uint32_t address, bool addr_is_4b,
     spi_flash_testutils_transaction_width_mode_t page_program_mode) {
@@ -256,7 +290,16 @@ status_t spi_flash_testutils_program_op(
   };
   TRY(dif_spi_host_transaction(spih, /*csid=*/0, transaction,
                                ARRAYSIZE(transaction)));
+  return OK_STATUS();
+}
 
+status_t spi_flash_testutils_program_op(
+    dif_spi_host_t *spih, uint8_t opcode, const void *payload, size_t length,
+    uint32_t address, bool addr_is_4b,
+    spi_flash_testutils_transaction_width_mode_t page_program_mode) {
+  TRY(spi_flash_testutils_program_op_start(spih, opcode, payload, length,
+                                           address, addr_is_4b,
+                                           page_program_mode));
   return spi_flash_testutils_wait_until_not_busy(spih);
 }
 
@@ -318,6 +361,180 @@ status_t spi_flash_testutils_read_op(dif_spi_host_t *spih, uint8_t opcode,
   return OK_STATUS();
 }
 
+/**
+ * Reads the fast read capabilities from the SFDP into `read_caps`.
+ */
+static status_t read_caps_load(dif_spi_host_t *spih) {
+  struct {
+    spi_flash_testutils_sfdp_header_t header;
+    spi_flash_testutils_parameter_header_t bfpt;
+  } headers;
+  TRY(spi_flash_testutils_read_sfdp(spih, 0, &headers, sizeof(headers)));
+  TRY_CHECK(headers.header.signature == kSfdpSignature);
+  TRY_CHECK(headers.bfpt.param_id == 0 && headers.bfpt.length >= 4);
+
+  uint32_t bfpt[15] = {0};
+  size_t words = headers.bfpt.length < ARRAYSIZE(bfpt) ? headers.bfpt.length
+                                                       : ARRAYSIZE(bfpt);
+  uint32_t offset = (uint32_t)headers.bfpt.table_pointer[0] |
+                    (uint32_t)headers.bfpt.table_pointer[1] << 8 |
+                    (uint32_t)headers.bfpt.table_pointer[2] << 16;
+  TRY(spi_flash_testutils_read_sfdp(spih, offset, bfpt,
+                                    words * sizeof(uint32_t)));
+
+  read_caps.modes = bfpt[0];
+  read_caps.quad = bfpt[2];
+  read_caps.dual = bfpt[3];
+  read_caps.quad_enable_method =
+      (uint8_t)bitfield_field32_read(bfpt[14], SPI_FLASH_QUAD_ENABLE);
+  read_caps.valid = true;
+  return OK_STATUS();
+}
+
+/**
+ * Fills `config` from the fast read parameters `params` (one half of a BFPT
+ * dword) if the mode is supported.
+ *
+ * @return Whether the mode is supported.
+ */
+static bool read_config_try(uint32_t mode_bit, uint32_t params,
+                            spi_flash_testutils_transaction_width_mode_t mode,
+                            spi_flash_testutils_read_config_t *config) {
+  uint8_t opcode =
+      (uint8_t)bitfield_field32_read(params, SFDP_FAST_READ_OPCODE);
+  if (!bitfield_bit32_read(read_caps.modes, mode_bit) || opcode == 0) {
+    return false;
+  }
+  uint8_t mode_clocks =
+      (uint8_t)bitfield_field32_read(params, SFDP_FAST_READ_MODE);
+  uint8_t dummy = (uint8_t)bitfield_field32_read(params, SFDP_FAST_READ_DUMMY);
+  // Mode bits travel at the address width. They are sent as 0xff, which never
+  // selects continuous read mode, unless they do not fill whole bytes; then
+  // the lines are left undriven as for dummy cycles.
+  uint32_t mode_bits =
+      mode_clocks * (1u << spi_flash_testutils_get_address_width(mode));
+  *config = (spi_flash_testutils_read_config_t){
+      .opcode = opcode,
+      .width_mode = mode,
+  };
+  if (mode_bits % 8 == 0) {
+    config->mode_bytes = (uint8_t)(mode_bits / 8);
+    config->dummy = dummy;
+  } else {
+    config->dummy = dummy + mode_clocks;
+  }
+  return true;
+}
+
+status_t spi_flash_testutils_read_config_get(
+    dif_spi_host_t *spih, spi_flash_testutils_read_config_t *config) {
+  TRY_CHECK(spih != NULL);
+  TRY_CHECK(config != NULL);
+  if (!read_caps.valid) {
+    TRY(read_caps_load(spih));
+  }
+
+  // Quad modes need the Quad Enable bit, if the flash has one.
+  bool quad = read_caps.quad_enable_method == 0 || quad_enabled;
+  if (quad && read_config_try(kSfdpFastRead144Bit, read_caps.quad,
+                              kTransactionWidthMode144, config)) {
+    return OK_STATUS();
+  }
+  if (quad && read_config_try(kSfdpFastRead114Bit, read_caps.quad >> 16,
+                              kTransactionWidthMode114, config)) {
+    return OK_STATUS();
+  }
+  if (read_config_try(kSfdpFastRead122Bit, read_caps.dual >> 16,
+                      kTransactionWidthMode122, config)) {
+    return OK_STATUS();
+  }
+  if (read_config_try(kSfdpFastRead112Bit, read_caps.dual,
+                      kTransactionWidthMode112, config)) {
+    return OK_STATUS();
+  }
+  *config = (spi_flash_testutils_read_config_t){
+      .opcode = kSpiDeviceFlashOpReadFast,
+      .width_mode = kTransactionWidthMode111,
+      .dummy = 8,
+  };
+  return OK_STATUS();
+}
+
+void spi_flash_testutils_read_config_reset(void) {
+  read_caps.valid = false;
+  quad_enabled = false;
+}
+
+status_t spi_flash_testutils_read_bulk(dif_spi_host_t *spih, void *payload,
+                                       size_t length, uint32_t address,
+                                       bool addr_is_4b) {
+  TRY_CHECK(spih != NULL);
+  TRY_CHECK(payload != NULL || length == 0);
+  spi_flash_testutils_read_config_t config;
+  TRY(spi_flash_testutils_read_config_get(spih, &config));
+
+  static const uint8_t kModeBytes[4] = {0xff, 0xff, 0xff, 0xff};
+  TRY_CHECK(config.mode_bytes <= sizeof(kModeBytes));
+  dif_spi_host_width_t addr_width =
+      spi_flash_testutils_get_address_width(config.width_mode);
+  dif_spi_host_width_t data_width =
+      spi_flash_testutils_get_data_width(config.width_mode);
+
+  uint8_t *data = (uint8_t *)payload;
+  while (length > 0) {
+    dif_spi_host_segment_t segments[4 + kSpiFlashTestutilsReadBulkSegments];
+    size_t count = 0;
+    segments[count++] = (dif_spi_host_segment_t){
+        .type = kDifSpiHostSegmentTypeOpcode,
+        .opcode = {.opcode = config.opcode, .width = kDifSpiHostWidthStandard},
+    };
+    segments[count++] = (dif_spi_host_segment_t){
+        .type = kDifSpiHostSegmentTypeAddress,
+        .address = {.width = addr_width,
+                    .mode = addr_is_4b ? kDifSpiHostAddrMode4b
+                                       : kDifSpiHostAddrMode3b,
+                    .address = address},
+    };
+    if (config.mode_bytes > 0) {
+      segments[count++] = (dif_spi_host_segment_t){
+          .type = kDifSpiHostSegmentTypeTx,
+          .tx = {.width = addr_width,
+                 .buf = kModeBytes,
+                 .length = config.mode_bytes},
+      };
+    }
+    segments[count++] = (dif_spi_host_segment_t){
+        .type = kDifSpiHostSegmentTypeDummy,
+        .dummy = {.width = kDifSpiHostWidthStandard, .length = config.dummy},
+    };
+    // Chip select stays asserted across the data segments, so the flash
+    // streams them as one continuous read.
+    for (size_t i = 0; i < kSpiFlashTestutilsReadBulkSegments && length > 0;
+         ++i) {
+      size_t len = length < kSpiFlashTestutilsReadBulkSegmentLen
+                       ? length
+                       : kSpiFlashTestutilsReadBulkSegmentLen;
+      segments[count++] = (dif_spi_host_segment_t){
+          .type = kDifSpiHostSegmentTypeRx,
+          .rx = {.width = data_width, .buf = data, .length = len},
+      };
+      data += len;
+      address += (uint32_t)len;
+      length -= len;
+    }
+
+    // The asynchronous API drains the RX FIFO while later segments are still
+    // being issued, which the blocking `dif_spi_host_transaction()` cannot.
+    dif_spi_host_async_t async;
+    TRY(dif_spi_host_async_start(spih, &async, /*csid=*/0, segments, count));
+    bool done = false;
+    while (!done) {
+      TRY(dif_spi_host_async_service(spih, &async, &done));
+    }
+  }
+  return OK_STATUS();
+}
+
 status_t spi_flash_testutils_quad_enable(dif_spi_host_t *spih, uint8_t method,
                                          bool enabled) {
   uint32_t status = 0;
@@ -390,6 +607,7 @@ status_t spi_flash_testutils_quad_enable(dif_spi_host_t *spih, uint8_t method,
       return INVALID_ARGUMENT();
       break;
   }
+  quad_enabled = enabled;
   return OK_STATUS();
 }
 
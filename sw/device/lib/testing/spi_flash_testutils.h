@@ -21,6 +21,11 @@ typedef struct spi_flash_testutils_jedec_id {
 enum {
   // The standard SFDP signature value.
   kSfdpSignature = 0x50444653,
+  // The longest SPI host segment (limited by the COMMAND.LEN field).
+  kSpiFlashTestutilsReadBulkSegmentLen = 512,
+  // The number of data segments in one `spi_flash_testutils_read_bulk()`
+  // burst.
+  kSpiFlashTestutilsReadBulkSegments = 16,
 };
 
 /**
@@ -251,6 +256,32 @@ status_t spi_flash_testutils_program_op(
     uint32_t address, bool addr_is_4b,
     spi_flash_testutils_transaction_width_mode_t page_program_mode);
 
+/**
+ * Start a Page Program sequence via the requested opcode.
+ *
+ * Same as `spi_flash_testutils_program_op()`, but returns as soon as the
+ * payload has been handed to the SPI host, without waiting for the WIP bit to
+ * clear. The caller must wait with `spi_flash_testutils_wait_until_not_busy()`
+ * before issuing another command to the flash, other than Read Status.
+ *
+ * @param spih A SPI host handle.
+ * @param opcode The desired program opcode.
+ * @param payload A pointer to the payload to be written to the page. It is no
+ *                longer accessed once this function returns.
+ * @param length Number of bytes in the payload. Must be less than or equal to
+ *               256 bytes.
+ * @param address The start address where the payload programming should begin.
+ * @param addr_is_4b True if `address` is 4 bytes long, else 3 bytes.
+ * @param page_program_mode The width of the transaction sections (opcode,
+ * address and data).
+ * @return status_t containing either OK or an error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_flash_testutils_program_op_start(
+    dif_spi_host_t *spih, uint8_t opcode, const void *payload, size_t length,
+    uint32_t address, bool addr_is_4b,
+    spi_flash_testutils_transaction_width_mode_t page_program_mode);
+
 /**
  * Perform full Page Program sequence via the standard page program opcode.
  * The sequence includes the Write Enable and Page Program commands,
@@ -318,6 +349,79 @@ status_t spi_flash_testutils_read_op(dif_spi_host_t *spih, uint8_t opcode,
                                      uint32_t address, bool addr_is_4b,
                                      uint8_t width, uint8_t dummy);
 
+/**
+ * Parameters of the read command used by `spi_flash_testutils_read_bulk()`.
+ */
+typedef struct spi_flash_testutils_read_config {
+  /**
+   * The read opcode.
+   */
+  uint8_t opcode;
+  /**
+   * The width of the transaction sections (opcode, address and data).
+   */
+  spi_flash_testutils_transaction_width_mode_t width_mode;
+  /**
+   * The number of mode bytes (sent as 0xff) after the address, at the address
+   * width.
+   */
+  uint8_t mode_bytes;
+  /**
+   * The number of dummy cycles after the mode bytes.
+   */
+  uint8_t dummy;
+} spi_flash_testutils_read_config_t;
+
+/**
+ * Get the fastest read command supported by the SPI flash.
+ *
+ * The fast read capabilities are parsed from the SFDP basic flash parameter
+ * table on the first call and cached for later calls. Quad reads are only
+ * selected if the flash has no Quad Enable bit or if it has been set with
+ * `spi_flash_testutils_quad_enable()`. Falls back to Fast Read (1-1-1).
+ *
+ * @param spih A SPI host handle.
+ * @param[out] config The parameters of the read command.
+ * @return status_t containing either OK or an error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_flash_testutils_read_config_get(
+    dif_spi_host_t *spih, spi_flash_testutils_read_config_t *config);
+
+/**
+ * Forget the SFDP capabilities cached by
+ * `spi_flash_testutils_read_config_get()`.
+ *
+ * Must be called if a different SPI flash is accessed afterwards.
+ */
+void spi_flash_testutils_read_config_reset(void);
+
+/**
+ * Read an arbitrary amount of data with the fastest read command.
+ *
+ * The read command is chosen by `spi_flash_testutils_read_config_get()`. The
+ * data is read in bursts of up to
+ * `kSpiFlashTestutilsReadBulkSegments * kSpiFlashTestutilsReadBulkSegmentLen`
+ * bytes, each split into the longest SPI host segments, and the receive FIFO is
+ * drained while the burst is in progress. Bursts may cross page boundaries.
+ *
+ * Uses the asynchronous SPI host transaction API in a polling loop, so the SPI
+ * host event interrupt must not be enabled.
+ *
+ * @param spih A SPI host handle.
+ * @param[out] payload A pointer to the buffer to receive data from the device.
+ * @param length Number of bytes to read.
+ * @param address The start address where the read should begin.
+ * @param addr_is_4b True if `address` is 4 bytes long, else 3 bytes. For 4-byte
+ *                   addresses the flash must be in 4-byte address mode; see
+ *                   `spi_flash_testutils_enter_4byte_address_mode()`.
+ * @return status_t containing either OK or an error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_flash_testutils_read_bulk(dif_spi_host_t *spih, void *payload,
+                                       size_t length, uint32_t address,
+                                       bool addr_is_4b);
+
 /**
  * Enable or disable Quad mode on the EEPROM according to the SFDP-described
  * method.
@@ -4,7 +4,7 @@
 
 #include "sw/device/lib/testing/sram_ctrl_testutils.h"
 
-#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/dif/dif_sram_ctrl.h"
 #include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/log.h"
@@ -14,11 +14,9 @@
 
 void sram_ctrl_testutils_write(uintptr_t address,
                                const sram_ctrl_testutils_data_t data) {
-  mmio_region_t region = mmio_region_from_addr(address);
-  for (size_t index = 0; index < data.len; ++index) {
-    ptrdiff_t offset = (ptrdiff_t)(sizeof(uint32_t)) * (ptrdiff_t)index;
-    mmio_region_write32(region, offset, data.words[index]);
-  }
+  // SRAM is plain memory, so the word-aligned `memcpy` fast path can be used
+  // instead of one MMIO write per word.
+  memcpy((void *)address, data.words, data.len * sizeof(uint32_t));
 }
 
 /**
@@ -31,9 +29,10 @@ static bool check_finished(const dif_sram_ctrl_t *sram_ctrl,
   return (res == kDifOk) && (status & flag);
 }
 
-status_t sram_ctrl_testutils_scramble(const dif_sram_ctrl_t *sram_ctrl) {
-  TRY(dif_sram_ctrl_request_new_key(sram_ctrl));
-
+/**
+ * Returns the timeout for a scrambling or wipe operation in microseconds.
+ */
+static uint32_t operation_timeout_usec(void) {
   // Calculate the timeout time.
   // The SRAM Controller documentation says that it takes approximately 800
   // cycles to perform the SRAM scrambling operation (50 cycles were added to
@@ -49,8 +48,13 @@ status_t sram_ctrl_testutils_scramble(const dif_sram_ctrl_t *sram_ctrl) {
   // inaccurate results due to clock period being zero. It should not be a
   // problem with the second version, as clock frequency won't be less than
   // 850. We add 1 microsecond to account for flooring.
-  uint32_t usec = (uint32_t)udiv64_slow(
+  return (uint32_t)udiv64_slow(
       1000000, udiv64_slow(kClockFreqCpuHz, 850, NULL) + 1, NULL);
+}
+
+status_t sram_ctrl_testutils_scramble(const dif_sram_ctrl_t *sram_ctrl) {
+  TRY(dif_sram_ctrl_request_new_key(sram_ctrl));
+  uint32_t usec = operation_timeout_usec();
 
   // Loop until new scrambling key has been obtained.
   LOG_INFO("Waiting for SRAM scrambling to finish");
@@ -59,11 +63,38 @@ status_t sram_ctrl_testutils_scramble(const dif_sram_ctrl_t *sram_ctrl) {
   return OK_STATUS();
 }
 
+/**
+ * Checks whether the SRAM operation has finished on all controllers.
+ */
+static bool check_all_finished(const dif_sram_ctrl_t *const *sram_ctrls,
+                               size_t count, dif_sram_ctrl_status_t flag) {
+  for (size_t i = 0; i < count; ++i) {
+    if (!check_finished(sram_ctrls[i], flag)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+status_t sram_ctrl_testutils_scramble_all(
+    const dif_sram_ctrl_t *const *sram_ctrls, size_t count) {
+  // Start all key requests before polling so that the controllers obtain
+  // their new keys concurrently.
+  for (size_t i = 0; i < count; ++i) {
+    TRY(dif_sram_ctrl_request_new_key(sram_ctrls[i]));
+  }
+  uint32_t usec = operation_timeout_usec();
+
+  LOG_INFO("Waiting for SRAM scrambling to finish on %d controllers", count);
+  IBEX_TRY_SPIN_FOR(
+      check_all_finished(sram_ctrls, count, kDifSramCtrlStatusScrKeyValid),
+      usec);
+  return OK_STATUS();
+}
+
 status_t sram_ctrl_testutils_wipe(const dif_sram_ctrl_t *sram_ctrl) {
   CHECK_DIF_OK(dif_sram_ctrl_wipe(sram_ctrl));
-  // The timeout calculation is the same as the scramble timeout.
-  uint32_t usec = (uint32_t)udiv64_slow(
-      1000000, udiv64_slow(kClockFreqCpuHz, 850, NULL) + 1, NULL);
+  uint32_t usec = operation_timeout_usec();
   LOG_INFO("Waiting for SRAM wipe to finish");
   IBEX_SPIN_FOR(check_finished(sram_ctrl, kDifSramCtrlStatusInitDone), usec);
   return OK_STATUS();
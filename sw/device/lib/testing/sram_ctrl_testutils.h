@@ -6,6 +6,7 @@
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_SRAM_CTRL_TESTUTILS_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/status.h"
@@ -38,6 +39,21 @@ void sram_ctrl_testutils_write(uintptr_t address,
 OT_WARN_UNUSED_RESULT
 status_t sram_ctrl_testutils_scramble(const dif_sram_ctrl_t *sram_ctrl);
 
+/**
+ * Triggers the SRAM scrambling operation on several SRAM controllers.
+ *
+ * New keys are requested from all controllers before any of them is polled, so
+ * the operations run concurrently and the whole call takes about as long as a
+ * single `sram_ctrl_testutils_scramble()`.
+ *
+ * @param sram_ctrls SRAM controllers to scramble, e.g. main and retention SRAM.
+ * @param count Number of controllers in `sram_ctrls`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t sram_ctrl_testutils_scramble_all(
+    const dif_sram_ctrl_t *const *sram_ctrls, size_t count);
+
 /**
  * Triggers the SRAM wipe operation and waits for it to finish.
  *
@@ -5,6 +5,8 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_FREERTOSCONFIG_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_FREERTOSCONFIG_H_
 
+#include <stdint.h>
+
 // These macros configure FreeRTOS. A description of each macro can be found
 // here: https://www.freertos.org/a00110.html
 
@@ -43,6 +45,12 @@
 #define configUSE_PREEMPTION 0
 #define configUSE_TIME_SLICING 0
 #define configUSE_16_BIT_TICKS 0
+#define configUSE_TICKLESS_IDLE 1
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime) \
+  vPortSuppressTicksAndSleep(xExpectedIdleTime)
+// Implemented in freertos_port.c. `TickType_t` is not defined yet, but it is a
+// `uint32_t` since `configUSE_16_BIT_TICKS` is 0.
+void vPortSuppressTicksAndSleep(uint32_t xExpectedIdleTime);
 
 // Software timers.
 #define configUSE_TIMERS 0
@@ -10,8 +10,19 @@
  *
  * This function must be called at the end of a test. Note that this profile
  * data is raw and must be indexed before it can be used to generate coverage
- * reports.
+ * reports. The profile is zero-RLE encoded, see
+ * `util/coverage/device_profile_data.py` for the host side.
  */
 void coverage_send_buffer(void);
 
+/**
+ * Sends the LLVM profile buffer and resets the profile counters.
+ *
+ * This can be called at checkpoints of long tests so that coverage survives
+ * a test that does not reach its end, and so that each upload only covers the
+ * counts since the previous checkpoint. The host concatenates the profiles of
+ * a test, which `llvm-profdata merge` accumulates.
+ */
+void coverage_send_checkpoint(void);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_COVERAGE_H_
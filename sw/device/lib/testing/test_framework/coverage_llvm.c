@@ -23,13 +23,94 @@ int __llvm_profile_runtime;
  */
 static char buf[0x8000] = {0};
 
+enum {
+  /**
+   * Number of encoded bytes per line of output.
+   */
+  kBytesPerLine = 40,
+  /**
+   * Maximum length of a single zero-RLE run.
+   */
+  kRleMaxRun = 128,
+  /**
+   * Control byte flag of a run of zeros.
+   */
+  kRleZeroRun = 0x80,
+};
+
+/**
+ * Line buffer for the zero-RLE encoder.
+ */
+static struct {
+  uint8_t data[kBytesPerLine];
+  size_t len;
+} line;
+
+/**
+ * Appends a byte to the output, printing the line once it is full.
+ */
+static void line_put(uint8_t byte) {
+  line.data[line.len++] = byte;
+  if (line.len == kBytesPerLine) {
+    LOG_INFO("%!y", line.len, line.data);
+    line.len = 0;
+  }
+}
+
 /**
- * Sends the given buffer as a hex string over UART.
+ * Prints the bytes left in the output line.
+ */
+static void line_flush(void) {
+  if (line.len > 0) {
+    LOG_INFO("%!y", line.len, line.data);
+    line.len = 0;
+  }
+}
+
+/**
+ * Sends `len` bytes of `data` as zero-RLE encoded hex lines.
+ *
+ * The encoding is a sequence of runs, each starting with a control byte `c`:
+ * - `c < 0x80`: `c + 1` literal bytes follow.
+ * - `c >= 0x80`: `(c & 0x7f) + 1` zero bytes, nothing follows.
  *
- * Lines are limited to 80 characters. Longer buffers will be broken to multiple
- * lines.
+ * Most counters of a profile are zero, which this encoding collapses to a byte
+ * per 128 bytes of the raw profile.
  */
-void coverage_send_buffer(void) {
+static void send_zero_rle(const uint8_t *data, size_t len) {
+  size_t i = 0;
+  while (i < len) {
+    size_t run = 0;
+    while (i + run < len && run < kRleMaxRun && data[i + run] == 0) {
+      ++run;
+    }
+    // Encode pairs of zeros or more as a zero run, a single zero is cheaper as
+    // a literal.
+    if (run >= 2) {
+      line_put((uint8_t)(kRleZeroRun | (run - 1)));
+      i += run;
+      continue;
+    }
+    // Extend the literal run up to the next pair of zeros.
+    run = 0;
+    while (i + run < len && run < kRleMaxRun &&
+           !(i + run + 1 < len && data[i + run] == 0 &&
+             data[i + run + 1] == 0)) {
+      ++run;
+    }
+    line_put((uint8_t)(run - 1));
+    for (size_t j = 0; j < run; ++j) {
+      line_put(data[i + j]);
+    }
+    i += run;
+  }
+  line_flush();
+}
+
+/**
+ * Sends the LLVM profile buffer followed by `terminator`.
+ */
+static void send_profile(const char *terminator) {
   // It looks like we don't have a way to read the profile buffer incrementally.
   // Thus, we define the following buffer.
   // Write the profile buffer to the buffer defined above.
@@ -38,33 +119,30 @@ void coverage_send_buffer(void) {
     LOG_ERROR("ERROR: LLVM profile buffer is too large: %u bytes.",
               (uint32_t)buf_size_u64);
     OT_UNREACHABLE();
-  } else {
-    size_t buf_size = (size_t)buf_size_u64;
-    __llvm_profile_write_buffer(buf);
-    // Send the buffer along with its length and CRC32.
-    uint32_t checksum = crc32(buf, buf_size);
-    LOG_INFO("LLVM profile data (length: %u bytes, CRC32: 0x%08x):",
-             (uint32_t)buf_size, checksum);
-    enum {
-      kBytesPerLine = 40,
-      // Print one less byte in the first line to account for "0x".
-      kBytesFirstLine = kBytesPerLine - 1,
-    };
-    size_t bytes_this_line =
-        buf_size < kBytesFirstLine ? buf_size : kBytesFirstLine;
-    char *read_ptr = (char *)buf + buf_size - bytes_this_line;
-    LOG_INFO("0x%!x", bytes_this_line, read_ptr);
-    buf_size -= bytes_this_line;
-    while (buf_size > 0) {
-      size_t bytes_this_line =
-          buf_size < kBytesPerLine ? buf_size : kBytesPerLine;
-      read_ptr -= bytes_this_line;
-      LOG_INFO("%!x", bytes_this_line, read_ptr);
-      buf_size -= bytes_this_line;
-    }
   }
+  size_t buf_size = (size_t)buf_size_u64;
+  __llvm_profile_write_buffer(buf);
+  // Send the buffer along with its length and CRC32.
+  uint32_t checksum = crc32(buf, buf_size);
+  LOG_INFO(
+      "LLVM profile data (length: %u bytes, CRC32: 0x%08x, encoding: "
+      "zero-rle):",
+      (uint32_t)buf_size, checksum);
+  send_zero_rle((const uint8_t *)buf, buf_size);
+  base_printf(terminator);
+  base_printf("\r\n");
+}
+
+void coverage_send_buffer(void) {
   // Send `EOT` so that `cat` can exit. Note that this requires enabling
   // `icanon` using `stty`.
-  base_printf("\x4");
-  base_printf("\r\n");
+  send_profile("\x4");
+}
+
+void coverage_send_checkpoint(void) {
+  // Send `ETB` rather than `EOT` since more profile data follows.
+  send_profile("\x17");
+  // Only send the counts accumulated since this checkpoint next time. The host
+  // sums up the counts of all profiles when merging them.
+  __llvm_profile_reset_counters();
 }
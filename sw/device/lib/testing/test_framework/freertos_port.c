@@ -4,6 +4,7 @@
 
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/dif/dif_rv_timer.h"
+#include "sw/device/lib/runtime/hart.h"
 #include "sw/device/lib/runtime/irq.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/test_framework/FreeRTOSConfig.h"
@@ -42,17 +43,14 @@ static const uint64_t kTimerDeadline =
 
 // Override the timer ISR to support preemptive context switching.
 void ottf_timer_isr(uint32_t *exc_info) {
-  LOG_INFO("Handling timer IQR ...");
-  dif_rv_timer_irq_enable_snapshot_t irq_enable_snapshot;
-  CHECK_DIF_OK(
-      dif_rv_timer_irq_disable_all(&timer, kTimerHartId, &irq_enable_snapshot));
   CHECK_DIF_OK(dif_rv_timer_counter_write(&timer, kTimerHartId, 0));
   CHECK_DIF_OK(dif_rv_timer_irq_acknowledge(
       &timer, kDifRvTimerIrqTimerExpiredHart0Timer0));
-  // TODO: increment scheduler tick and switch context if necessary
-  CHECK_DIF_OK(
-      dif_rv_timer_irq_restore_all(&timer, kTimerHartId, &irq_enable_snapshot));
-  LOG_INFO("Done.");
+  // The OTTF ISR exit path restores the context of `pxCurrentTCB`, so
+  // switching the context here is enough to preempt the interrupted task.
+  if (xTaskIncrementTick() != pdFALSE) {
+    vTaskSwitchContext();
+  }
 }
 
 void vPortSetupTimerInterrupt(void) {
@@ -85,6 +83,52 @@ void vPortSetupTimerInterrupt(void) {
 
 #endif  // configUSE_PREEMPTION
 
+// ----------------------------------------------------------------------------
+// Tickless Idle
+// ----------------------------------------------------------------------------
+#if configUSE_TICKLESS_IDLE
+
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime) {
+  irq_global_ctrl(false);
+  if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+    irq_global_ctrl(true);
+    return;
+  }
+
+#if configUSE_PREEMPTION
+  // The tick ISR restarts the counter from zero on every tick, so the counter
+  // holds the time since the last tick. Move the comparator out to the tick
+  // at which the first blocked task times out.
+  CHECK_DIF_OK(dif_rv_timer_arm(&timer, kTimerHartId, kTimerComparatorId,
+                                xExpectedIdleTime * kTimerDeadline));
+#endif  // configUSE_PREEMPTION
+
+  // Interrupts are globally disabled, but still wake Ibex up. They are handled
+  // once they are re-enabled below.
+  wait_for_interrupt();
+
+#if configUSE_PREEMPTION
+  uint64_t counter;
+  CHECK_DIF_OK(dif_rv_timer_counter_read(&timer, kTimerHartId, &counter));
+  TickType_t elapsed_ticks = (TickType_t)(counter / kTimerDeadline);
+  if (elapsed_ticks >= xExpectedIdleTime) {
+    // The timer interrupt is pending and its ISR accounts for the last tick.
+    vTaskStepTick(xExpectedIdleTime - 1);
+  } else {
+    // Woken up by another interrupt, keep the phase of the current tick.
+    vTaskStepTick(elapsed_ticks);
+    CHECK_DIF_OK(dif_rv_timer_counter_write(
+        &timer, kTimerHartId, counter - elapsed_ticks * kTimerDeadline));
+  }
+  CHECK_DIF_OK(dif_rv_timer_arm(&timer, kTimerHartId, kTimerComparatorId,
+                                kTimerDeadline));
+#endif  // configUSE_PREEMPTION
+
+  irq_global_ctrl(true);
+}
+
+#endif  // configUSE_TICKLESS_IDLE
+
 // ----------------------------------------------------------------------------
 // Scheduler Setup
 // ----------------------------------------------------------------------------
@@ -7,11 +7,13 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/dif/dif_rv_plic.h"
 #include "sw/device/lib/dif/dif_spi_device.h"
 #include "sw/device/lib/dif/dif_uart.h"
+#include "sw/device/lib/runtime/hart.h"
 #include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/irq.h"
 #include "sw/device/lib/runtime/print.h"
@@ -38,6 +40,22 @@ enum {
   kFlowControlLowWatermark = 4,   // bytes
   kFlowControlHighWatermark = 8,  // bytes
   kFlowControlRxWatermark = kDifUartWatermarkByte8,
+  /**
+   * Buffered console output parameters.
+   */
+  kTxBufferBytes = 1024,
+  kTxBufferWatermark = kDifUartWatermarkByte16,
+  /**
+   * Console input ring parameters.
+   *
+   * `Pause` is sent early enough to leave room for the bytes the host sends
+   * before it reacts, and `Resume` once most of the ring has been consumed.
+   */
+  kRxRingBytes = 1024,
+  kRxRingWatermark = kDifUartWatermarkByte16,
+  kRxRingTimeoutBitTimes = 40,  // 4 characters
+  kRxRingPauseLevel = kRxRingBytes - 256,
+  kRxRingResumeLevel = kRxRingBytes / 4,
   /**
    * HART PLIC Target.
    */
@@ -53,6 +71,14 @@ static dif_uart_t ottf_console_uart;
 static volatile ottf_console_flow_control_t flow_control_state;
 static volatile uint32_t flow_control_irqs;
 
+// Backing storage for the console output when `enable_uart_tx_buffer` is set.
+static char tx_buffer[kTxBufferBytes];
+
+// Console input state when `enable_uart_rx_ring` is set. Only the RX half of
+// the asynchronous UART state is used.
+static dif_uart_async_t rx_async;
+static uint8_t rx_ring[kRxRingBytes];
+
 void *ottf_console_get(void) {
   switch (kOttfTestConfig.console.type) {
     case kOttfConsoleSpiDevice:
@@ -110,7 +136,17 @@ void ottf_console_configure_uart(uintptr_t base_addr) {
                               .tx_enable = kDifToggleEnabled,
                               .rx_enable = kDifToggleEnabled,
                           }));
-  base_uart_stdout(&ottf_console_uart);
+  if (kOttfTestConfig.enable_uart_tx_buffer) {
+    ottf_console_tx_buffer_enable();
+  } else {
+    base_uart_stdout(&ottf_console_uart);
+  }
+
+  // The RX ring has to be set up first as it changes how flow control is
+  // managed.
+  if (kOttfTestConfig.enable_uart_rx_ring) {
+    ottf_console_rx_ring_enable();
+  }
 
   // Initialize/Configure console flow control (if requested).
   if (kOttfTestConfig.enable_uart_flow_control) {
@@ -118,6 +154,53 @@ void ottf_console_configure_uart(uintptr_t base_addr) {
   }
 }
 
+static uint32_t get_tx_watermark_plic_id(void) {
+  switch (kOttfTestConfig.console.base_addr) {
+#if !OT_IS_ENGLISH_BREAKFAST
+    case TOP_EARLGREY_UART1_BASE_ADDR:
+      return kTopEarlgreyPlicIrqIdUart1TxWatermark;
+    case TOP_EARLGREY_UART2_BASE_ADDR:
+      return kTopEarlgreyPlicIrqIdUart2TxWatermark;
+    case TOP_EARLGREY_UART3_BASE_ADDR:
+      return kTopEarlgreyPlicIrqIdUart3TxWatermark;
+#endif
+    case TOP_EARLGREY_UART0_BASE_ADDR:
+    default:
+      return kTopEarlgreyPlicIrqIdUart0TxWatermark;
+  }
+}
+
+void ottf_console_tx_buffer_enable(void) {
+  CHECK_DIF_OK(dif_rv_plic_init(
+      mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR), &ottf_plic));
+
+  dif_uart_t *uart = (dif_uart_t *)ottf_console_get();
+  CHECK_DIF_OK(dif_uart_watermark_tx_set(uart, kTxBufferWatermark));
+  // The sink enables the TX watermark IRQ whenever it has bytes left over.
+  CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqTxWatermark,
+                                        kDifToggleDisabled));
+  base_uart_buffered_stdout(uart, tx_buffer, sizeof(tx_buffer));
+
+  CHECK_DIF_OK(dif_rv_plic_irq_set_priority(
+      &ottf_plic, get_tx_watermark_plic_id(), kDifRvPlicMaxPriority));
+  CHECK_DIF_OK(dif_rv_plic_target_set_threshold(&ottf_plic, kPlicTarget,
+                                                kDifRvPlicMinPriority));
+  CHECK_DIF_OK(dif_rv_plic_irq_set_enabled(&ottf_plic,
+                                           get_tx_watermark_plic_id(),
+                                           kPlicTarget, kDifToggleEnabled));
+
+  irq_global_ctrl(true);
+  irq_external_ctrl(true);
+}
+
+bool ottf_console_tx_buffer_isr(uint32_t *exc_info) {
+  if (!kOttfTestConfig.enable_uart_tx_buffer) {
+    return false;
+  }
+  base_uart_buffered_stdout_drain();
+  return true;
+}
+
 static uint32_t get_flow_control_watermark_plic_id(void) {
   switch (kOttfTestConfig.console.base_addr) {
 #if !OT_IS_ENGLISH_BREAKFAST
@@ -134,12 +217,62 @@ static uint32_t get_flow_control_watermark_plic_id(void) {
   }
 }
 
+static uint32_t get_rx_timeout_plic_id(void) {
+  switch (kOttfTestConfig.console.base_addr) {
+#if !OT_IS_ENGLISH_BREAKFAST
+    case TOP_EARLGREY_UART1_BASE_ADDR:
+      return kTopEarlgreyPlicIrqIdUart1RxTimeout;
+    case TOP_EARLGREY_UART2_BASE_ADDR:
+      return kTopEarlgreyPlicIrqIdUart2RxTimeout;
+    case TOP_EARLGREY_UART3_BASE_ADDR:
+      return kTopEarlgreyPlicIrqIdUart3RxTimeout;
+#endif
+    case TOP_EARLGREY_UART0_BASE_ADDR:
+    default:
+      return kTopEarlgreyPlicIrqIdUart0RxTimeout;
+  }
+}
+
+void ottf_console_rx_ring_enable(void) {
+  CHECK_DIF_OK(dif_rv_plic_init(
+      mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR), &ottf_plic));
+
+  dif_uart_t *uart = (dif_uart_t *)ottf_console_get();
+  CHECK_DIF_OK(
+      dif_uart_async_init(&rx_async, NULL, 0, rx_ring, sizeof(rx_ring)));
+  CHECK_DIF_OK(dif_uart_watermark_rx_set(uart, kRxRingWatermark));
+  // The RX timeout picks up the bytes left below the watermark at the end of a
+  // transfer.
+  CHECK_DIF_OK(dif_uart_enable_rx_timeout(uart, kRxRingTimeoutBitTimes));
+  CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark,
+                                        kDifToggleEnabled));
+  CHECK_DIF_OK(
+      dif_uart_irq_set_enabled(uart, kDifUartIrqRxTimeout, kDifToggleEnabled));
+
+  const uint32_t plic_ids[] = {get_flow_control_watermark_plic_id(),
+                               get_rx_timeout_plic_id()};
+  for (size_t i = 0; i < ARRAYSIZE(plic_ids); ++i) {
+    CHECK_DIF_OK(dif_rv_plic_irq_set_priority(&ottf_plic, plic_ids[i],
+                                              kDifRvPlicMaxPriority));
+    CHECK_DIF_OK(dif_rv_plic_irq_set_enabled(&ottf_plic, plic_ids[i],
+                                             kPlicTarget, kDifToggleEnabled));
+  }
+  CHECK_DIF_OK(dif_rv_plic_target_set_threshold(&ottf_plic, kPlicTarget,
+                                                kDifRvPlicMinPriority));
+
+  irq_global_ctrl(true);
+  irq_external_ctrl(true);
+}
+
 void ottf_console_flow_control_enable(void) {
   CHECK_DIF_OK(dif_rv_plic_init(
       mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR), &ottf_plic));
 
   dif_uart_t *uart = (dif_uart_t *)ottf_console_get();
-  CHECK_DIF_OK(dif_uart_watermark_rx_set(uart, kFlowControlRxWatermark));
+  // The RX ring keeps its own, higher RX watermark.
+  if (!kOttfTestConfig.enable_uart_rx_ring) {
+    CHECK_DIF_OK(dif_uart_watermark_rx_set(uart, kFlowControlRxWatermark));
+  }
   CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark,
                                         kDifToggleEnabled));
 
@@ -168,7 +301,22 @@ static status_t manage_flow_control(const dif_uart_t *uart,
   if (flow_control_state == kOttfConsoleFlowControlNone) {
     return OK_STATUS((int32_t)flow_control_state);
   }
-  if (ctrl == kOttfConsoleFlowControlAuto) {
+  if (ctrl == kOttfConsoleFlowControlAuto &&
+      kOttfTestConfig.enable_uart_rx_ring) {
+    // The RX FIFO is drained on every RX interrupt, so the ring occupancy is
+    // what matters and the RX watermark interrupt stays enabled.
+    size_t avail;
+    TRY(dif_uart_async_rx_bytes_available(&rx_async, &avail));
+    if (avail < kRxRingResumeLevel &&
+        flow_control_state != kOttfConsoleFlowControlResume) {
+      ctrl = kOttfConsoleFlowControlResume;
+    } else if (avail >= kRxRingPauseLevel &&
+               flow_control_state != kOttfConsoleFlowControlPause) {
+      ctrl = kOttfConsoleFlowControlPause;
+    } else {
+      return OK_STATUS((int32_t)flow_control_state);
+    }
+  } else if (ctrl == kOttfConsoleFlowControlAuto) {
     uint32_t avail;
     TRY(dif_uart_rx_bytes_available(uart, &avail));
     if (avail < kFlowControlLowWatermark &&
@@ -196,6 +344,10 @@ static status_t manage_flow_control(const dif_uart_t *uart,
 }
 
 bool ottf_console_flow_control_isr(uint32_t *exc_info) {
+  // The RX ring ISR handles the RX watermark IRQ.
+  if (kOttfTestConfig.enable_uart_rx_ring) {
+    return false;
+  }
   dif_uart_t *uart = (dif_uart_t *)ottf_console_get();
   flow_control_irqs += 1;
   bool rx;
@@ -208,6 +360,49 @@ bool ottf_console_flow_control_isr(uint32_t *exc_info) {
   return false;
 }
 
+bool ottf_console_rx_ring_isr(uint32_t *exc_info) {
+  if (!kOttfTestConfig.enable_uart_rx_ring) {
+    return false;
+  }
+  dif_uart_t *uart = (dif_uart_t *)ottf_console_get();
+  bool watermark;
+  bool timeout;
+  CHECK_DIF_OK(
+      dif_uart_irq_is_pending(uart, kDifUartIrqRxWatermark, &watermark));
+  CHECK_DIF_OK(dif_uart_irq_is_pending(uart, kDifUartIrqRxTimeout, &timeout));
+  if (!watermark && !timeout) {
+    return false;
+  }
+  CHECK_DIF_OK(dif_uart_async_rx_isr(uart, &rx_async));
+  if (flow_control_state != kOttfConsoleFlowControlNone) {
+    flow_control_irqs += 1;
+    manage_flow_control(uart, kOttfConsoleFlowControlAuto);
+  }
+  return true;
+}
+
+status_t ottf_console_rx_ring_read(uint8_t *buf, size_t len) {
+  if (len == 0) {
+    return OK_STATUS(0);
+  }
+  size_t count = 0;
+  while (count == 0) {
+    // Check the ring with interrupts masked so that the RX interrupt cannot be
+    // taken between the check and the WFI.
+    irq_global_ctrl(false);
+    CHECK_DIF_OK(dif_uart_async_receive(&rx_async, buf, len, &count));
+    if (count == 0) {
+      wait_for_interrupt();
+    }
+    irq_global_ctrl(true);
+  }
+  TRY(ottf_console_flow_control((dif_uart_t *)ottf_console_get(),
+                                kOttfConsoleFlowControlAuto));
+  return OK_STATUS((int32_t)count);
+}
+
+size_t ottf_console_get_rx_ring_dropped(void) { return rx_async.rx_dropped; }
+
 // The public API has to save and restore interrupts to avoid an
 // unexpected write to the global `flow_control_state`.
 status_t ottf_console_flow_control(const dif_uart_t *uart,
@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/status.h"
@@ -47,6 +48,70 @@ void ottf_console_init(void);
  */
 void ottf_console_configure_uart(uintptr_t base_addr);
 
+/**
+ * Buffer the OTTF console output.
+ *
+ * Console output is copied into a RAM buffer and moved into the UART TX FIFO
+ * from the TX watermark IRQ, so printing does not wait for the UART unless the
+ * buffer is full.
+ *
+ * This function configures UART interrupts at the PLIC and enables interrupts
+ * at the CPU.
+ */
+void ottf_console_tx_buffer_enable(void);
+
+/**
+ * Send buffered console output from interrupt context.
+ *
+ * Call this when a console UART interrupt triggers.
+ *
+ * @param exc_info The OTTF execution info passed to all ISRs.
+ * @return True if console output is buffered and the buffer was drained.
+ * False otherwise.
+ */
+bool ottf_console_tx_buffer_isr(uint32_t *exc_info);
+
+/**
+ * Receive the OTTF console input into a RAM ring.
+ *
+ * The RX FIFO is drained into the ring from the RX watermark and RX timeout
+ * IRQs. If flow control is enabled, it is driven by the ring occupancy rather
+ * than the RX FIFO level.
+ *
+ * This function configures UART interrupts at the PLIC and enables interrupts
+ * at the CPU.
+ */
+void ottf_console_rx_ring_enable(void);
+
+/**
+ * Fill the console RX ring from interrupt context.
+ *
+ * Call this when a console UART interrupt triggers.
+ *
+ * @param exc_info The OTTF execution info passed to all ISRs.
+ * @return True if the RX ring is enabled and an RX watermark or RX timeout IRQ
+ * was handled. False otherwise.
+ */
+bool ottf_console_rx_ring_isr(uint32_t *exc_info);
+
+/**
+ * Read console input from the RX ring.
+ *
+ * Waits for at least one byte, then reads as many bytes as are available, up
+ * to `len`. Sends a `Resume` once the ring has drained if flow control is
+ * enabled.
+ *
+ * @param[out] buf Buffer for the received bytes.
+ * @param len Size of `buf`.
+ * @return The number of bytes read.
+ */
+status_t ottf_console_rx_ring_read(uint8_t *buf, size_t len);
+
+/**
+ * Returns the number of bytes dropped because the console RX ring was full.
+ */
+size_t ottf_console_get_rx_ring_dropped(void);
+
 /**
  * Manage flow control by inspecting the OTTF console device's receive FIFO.
  *
@@ -7,7 +7,6 @@
 
 #include "sw/device/lib/arch/device.h"
 #include "sw/device/lib/base/status.h"
-#include "sw/device/lib/runtime/hart.h"
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/test_framework/ottf_console.h"
@@ -28,7 +27,7 @@ status_t ottf_flow_control_test(ujson_t *uj) {
     // driving the transmitter while the host sends data
     // to the UART.
     base_printf("WAIT\r\n");
-    busy_spin_micros(delay);
+    ottf_sleep_micros(delay);
   }
 
   base_printf("Reading\r\n");
@@ -97,6 +97,9 @@ void ottf_generic_fault_print(uint32_t *exc_info, const char *reason,
   }
   LOG_ERROR("FAULT: %s. MCAUSE=%08x MEPC=%08x MTVAL=%08x", reason, mcause, mepc,
             mtval);
+  // Interrupts are off from here on, so buffered output has to be pushed out
+  // before halting.
+  base_stdout_flush();
 }
 
 static void generic_fault_handler(uint32_t *exc_info) {
@@ -192,25 +195,38 @@ void ottf_timer_isr(uint32_t *exc_info) {
 OT_WEAK
 bool ottf_console_flow_control_isr(uint32_t *exc_info) { return false; }
 
+OT_WEAK
+bool ottf_console_tx_buffer_isr(uint32_t *exc_info) { return false; }
+
+OT_WEAK
+bool ottf_console_rx_ring_isr(uint32_t *exc_info) { return false; }
+
 OT_WEAK
 void ottf_external_isr(uint32_t *exc_info) {
   const uint32_t kPlicTarget = kTopEarlgreyPlicTargetIbex0;
   dif_rv_plic_irq_id_t plic_irq_id;
   CHECK_DIF_OK(dif_rv_plic_irq_claim(&ottf_plic, kPlicTarget, &plic_irq_id));
 
-  top_earlgrey_plic_peripheral_t peripheral = (top_earlgrey_plic_peripheral_t)
-      top_earlgrey_plic_interrupt_for_peripheral[plic_irq_id];
+  // Keep claiming until nothing is pending so that a burst of console IRQs is
+  // serviced in a single trap.
+  do {
+    top_earlgrey_plic_peripheral_t peripheral =
+        (top_earlgrey_plic_peripheral_t)
+            top_earlgrey_plic_interrupt_for_peripheral[plic_irq_id];
+
+    if (peripheral != kTopEarlgreyPlicPeripheralUart0 ||
+        !(ottf_console_rx_ring_isr(exc_info) ||
+          ottf_console_flow_control_isr(exc_info) ||
+          ottf_console_tx_buffer_isr(exc_info))) {
+      ottf_generic_fault_print(exc_info, "External IRQ", ibex_mcause_read());
+      abort();
+    }
 
-  if (peripheral == kTopEarlgreyPlicPeripheralUart0 &&
-      ottf_console_flow_control_isr(exc_info)) {
     // Complete the IRQ at PLIC.
     CHECK_DIF_OK(
         dif_rv_plic_irq_complete(&ottf_plic, kPlicTarget, plic_irq_id));
-    return;
-  }
-
-  ottf_generic_fault_print(exc_info, "External IRQ", ibex_mcause_read());
-  abort();
+    CHECK_DIF_OK(dif_rv_plic_irq_claim(&ottf_plic, kPlicTarget, &plic_irq_id));
+  } while (plic_irq_id != 0);
 }
 
 static void generic_internal_irq_handler(uint32_t *exc_info) {
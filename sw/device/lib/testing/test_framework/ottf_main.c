@@ -11,14 +11,18 @@
 #include "external/freertos/include/queue.h"
 #include "external/freertos/include/task.h"
 #include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/csr.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/dif/dif_base.h"
 #include "sw/device/lib/dif/dif_rstmgr.h"
 #include "sw/device/lib/dif/dif_rv_core_ibex.h"
+#include "sw/device/lib/dif/dif_rv_timer.h"
 #include "sw/device/lib/dif/dif_uart.h"
 #include "sw/device/lib/runtime/hart.h"
+#include "sw/device/lib/runtime/irq.h"
 #include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/json/profiler.h"
 #include "sw/device/lib/testing/rand_testutils.h"
 #include "sw/device/lib/testing/test_framework/FreeRTOSConfig.h"
 #include "sw/device/lib/testing/test_framework/check.h"
@@ -26,6 +30,7 @@
 #include "sw/device/lib/testing/test_framework/ottf_console.h"
 #include "sw/device/lib/testing/test_framework/ottf_test_config.h"
 #include "sw/device/lib/testing/test_framework/status.h"
+#include "sw/device/lib/testing/test_framework/ujson_ottf.h"
 #include "sw/device/silicon_creator/lib/manifest_def.h"
 
 // TODO: make this toplevel agnostic.
@@ -72,10 +77,97 @@ bool ottf_task_create(TaskFunction_t task_function, const char *task_name,
              : false;
 }
 
-void ottf_task_yield(void) { taskYIELD(); }
+// Voluntary context switch that only saves the callee-saved registers, see
+// sw/device/lib/testing/test_framework/freertos_port.S.
+extern void vPortYield(void);
+
+void ottf_task_yield(void) { vPortYield(); }
 
 void ottf_task_delete_self(void) { vTaskDelete(/*xTask=*/NULL); }
 
+enum {
+  /**
+   * Sleeps shorter than this spin, as the timer setup takes about as long.
+   */
+  kSleepMinMicros = 10,
+  /**
+   * rv_timer hart and comparator used to wake up from a sleep.
+   */
+  kSleepTimerHartId = kTopEarlgreyPlicTargetIbex0,
+  kSleepTimerComparatorId = 0,
+  /**
+   * Bit of `mstatus` and `mie` that globally enables interrupts and enables the
+   * timer interrupt, respectively.
+   */
+  kSleepMstatusMie = 1 << 3,
+  kSleepMieMtie = 1 << 7,
+};
+
+void ottf_sleep_micros(uint32_t usec) {
+  if (usec < kSleepMinMicros) {
+    busy_spin_micros(usec);
+    return;
+  }
+
+#if configUSE_PREEMPTION
+  // rv_timer drives the FreeRTOS tick, so block on the tick instead.
+  if (pxCurrentTCB != NULL) {
+    const uint32_t kMicrosPerTick = 1000000 / configTICK_RATE_HZ;
+    vTaskDelay(usec / kMicrosPerTick);
+    busy_spin_micros(usec % kMicrosPerTick);
+    return;
+  }
+#endif  // configUSE_PREEMPTION
+
+  dif_rv_timer_t timer;
+  CHECK_DIF_OK(dif_rv_timer_init(
+      mmio_region_from_addr(TOP_EARLGREY_RV_TIMER_BASE_ADDR), &timer));
+  dif_rv_timer_tick_params_t tick_params;
+  CHECK_DIF_OK(dif_rv_timer_approximate_tick_params(kClockFreqPeripheralHz,
+                                                    1000000, &tick_params));
+  CHECK_DIF_OK(
+      dif_rv_timer_set_tick_params(&timer, kSleepTimerHartId, tick_params));
+  CHECK_DIF_OK(dif_rv_timer_counter_write(&timer, kSleepTimerHartId, 0));
+  CHECK_DIF_OK(dif_rv_timer_arm(&timer, kSleepTimerHartId,
+                                kSleepTimerComparatorId, usec));
+  CHECK_DIF_OK(dif_rv_timer_irq_set_enabled(
+      &timer, kDifRvTimerIrqTimerExpiredHart0Timer0, kDifToggleEnabled));
+
+  uint32_t mstatus;
+  uint32_t mie;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_READ(CSR_REG_MIE, &mie);
+  bool irqs_enabled = (mstatus & kSleepMstatusMie) != 0;
+  irq_global_ctrl(false);
+  CHECK_DIF_OK(dif_rv_timer_counter_set_enabled(&timer, kSleepTimerHartId,
+                                                kDifToggleEnabled));
+  bool expired = false;
+  while (!expired) {
+    // Interrupts are globally disabled, but an enabled interrupt still wakes
+    // Ibex up. The timer interrupt is only enabled while waiting so that it is
+    // never taken, and no handler is needed for it.
+    irq_timer_ctrl(true);
+    wait_for_interrupt();
+    irq_timer_ctrl(false);
+    CHECK_DIF_OK(dif_rv_timer_irq_is_pending(
+        &timer, kDifRvTimerIrqTimerExpiredHart0Timer0, &expired));
+    if (!expired && irqs_enabled) {
+      // Woken up by another interrupt: let its handler run.
+      irq_global_ctrl(true);
+      irq_global_ctrl(false);
+    }
+  }
+
+  CHECK_DIF_OK(dif_rv_timer_counter_set_enabled(&timer, kSleepTimerHartId,
+                                                kDifToggleDisabled));
+  CHECK_DIF_OK(dif_rv_timer_irq_set_enabled(
+      &timer, kDifRvTimerIrqTimerExpiredHart0Timer0, kDifToggleDisabled));
+  CHECK_DIF_OK(dif_rv_timer_irq_acknowledge(
+      &timer, kDifRvTimerIrqTimerExpiredHart0Timer0));
+  irq_timer_ctrl((mie & kSleepMieMtie) != 0);
+  irq_global_ctrl(irqs_enabled);
+}
+
 char *ottf_task_get_self_name(void) {
   return pcTaskGetName(/*xTaskToQuery=*/NULL);
 }
@@ -131,6 +223,13 @@ static void report_test_status(bool result) {
     }
   }
 
+#ifdef OT_PROFILER
+  if (kDeviceType != kDeviceSimDV) {
+    ujson_t uj = ujson_ottf_console();
+    CHECK_STATUS_OK(ujcmd_profiler_dump(&uj));
+  }
+#endif
+
   coverage_send_buffer();
   test_status_set(result ? kTestStatusPassed : kTestStatusFailed);
 }
@@ -98,6 +98,24 @@ void ottf_task_yield(void);
  */
 void ottf_task_delete_self(void);
 
+/**
+ * Sleep for at least the given number of microseconds.
+ *
+ * Unlike `busy_spin_micros()`, Ibex waits for interrupts instead of spinning:
+ * - With preemptive concurrency, the calling task blocks for the whole ticks
+ *   of the duration so that other tasks can run, and spins for the rest.
+ * - Otherwise, an rv_timer comparator is armed for the duration and Ibex
+ *   executes `wfi` until it fires. Other interrupts are still serviced while
+ *   sleeping if they were enabled on entry. Tests that use rv_timer themselves
+ *   must not use this function.
+ *
+ * Very short durations, for which arming the timer would overshoot, fall back
+ * to `busy_spin_micros()`.
+ *
+ * @param usec Duration in microseconds.
+ */
+void ottf_sleep_micros(uint32_t usec);
+
 /**
  * Returns the name of the currently executing FreeRTOS task.
  *
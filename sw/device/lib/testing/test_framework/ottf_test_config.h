@@ -73,6 +73,24 @@ typedef struct ottf_test_config {
    */
   bool enable_uart_flow_control;
 
+  /**
+   * Indicates that console output should be buffered in RAM and sent from the
+   * UART TX watermark interrupt instead of waiting for the UART on every
+   * print. Note that this will unmask the external interrupt and enable
+   * interrupt handling before `test_main` begins.
+   */
+  bool enable_uart_tx_buffer;
+
+  /**
+   * Indicates that console input should be moved into a RAM ring from the UART
+   * RX watermark and RX timeout interrupts instead of being read from the RX
+   * FIFO on demand. With `enable_uart_flow_control`, `Pause` and `Resume` are
+   * then sent based on the ring occupancy, so the host can stream data without
+   * throttling. Note that this will unmask the external interrupt and enable
+   * interrupt handling before `test_main` begins.
+   */
+  bool enable_uart_rx_ring;
+
   /**
    * Indicates that this test needs an explicit clear of the RSTMGR reset_reason
    * register.  This may be necessary for tests that execute with the OTP
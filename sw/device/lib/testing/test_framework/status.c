@@ -8,6 +8,7 @@
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/runtime/hart.h"
 #include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/runtime/print.h"
 
 /**
  * Writes the test status to the test status device address.
@@ -26,12 +27,14 @@ void test_status_set(test_status_t test_status) {
   switch (test_status) {
     case kTestStatusPassed: {
       LOG_INFO("PASS!");
+      base_stdout_flush();
       test_status_device_write(test_status);
       abort();
       break;
     }
     case kTestStatusFailed: {
       LOG_INFO("FAIL!");
+      base_stdout_flush();
       test_status_device_write(test_status);
       abort();
       break;
@@ -8,6 +8,7 @@
 #include "sw/device/lib/dif/dif_uart.h"
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/lib/testing/test_framework/ottf_console.h"
+#include "sw/device/lib/testing/test_framework/ottf_test_config.h"
 #include "sw/device/lib/ujson/ujson.h"
 
 static status_t ottf_putbuf(void *io, const char *buf, size_t len) {
@@ -18,14 +19,19 @@ static status_t ottf_putbuf(void *io, const char *buf, size_t len) {
   return OK_STATUS((int32_t)len);
 }
 
-static status_t ottf_getc(void *io) {
+static status_t ottf_getbuf(void *io, char *buf, size_t len) {
+  if (kOttfTestConfig.enable_uart_rx_ring) {
+    return ottf_console_rx_ring_read((uint8_t *)buf, len);
+  }
   const dif_uart_t *uart = (const dif_uart_t *)io;
-  uint8_t byte;
-  TRY(dif_uart_byte_receive_polled(uart, &byte));
+  // Wait for the first byte, then take whatever else is already in the FIFO.
+  TRY(dif_uart_byte_receive_polled(uart, (uint8_t *)buf));
+  size_t count = 0;
+  TRY(dif_uart_bytes_receive(uart, len - 1, (uint8_t *)buf + 1, &count));
   TRY(ottf_console_flow_control(uart, kOttfConsoleFlowControlAuto));
-  return OK_STATUS(byte);
+  return OK_STATUS((int32_t)count + 1);
 }
 
 ujson_t ujson_ottf_console(void) {
-  return ujson_init(ottf_console_get(), ottf_getc, ottf_putbuf);
+  return ujson_init_buffered(ottf_console_get(), ottf_getbuf, ottf_putbuf);
 }
@@ -29,6 +29,9 @@ extern "C" {
 /**
  * Initializes and returns a ujson context linked to the OTTF console.
  *
+ * The context reads the console in bulk, so a test should create a single
+ * context and use it for all of its console input.
+ *
  * @return An initialized ujson_t context.
  */
 ujson_t ujson_ottf_console(void);
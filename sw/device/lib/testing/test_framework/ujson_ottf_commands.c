@@ -4,9 +4,79 @@
 
 #include "sw/device/lib/testing/test_framework/ujson_ottf_commands.h"
 
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/dif/dif_rstmgr.h"
+#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/testing/json/mem.h"
+#include "sw/device/lib/testing/json/ottf.h"
+#include "sw/device/lib/testing/test_framework/ottf_test_config.h"
 #include "sw/device/lib/testing/test_framework/ujson_ottf.h"
 
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+// Default to no test cases for images that do not register any.
+OT_WEAK const size_t kOttfTestCasesCount = 0;
+OT_WEAK const ottf_test_case_t kOttfTestCases[1];
+
+/**
+ * Resets the peripherals that have an rstmgr software reset.
+ */
+static status_t reset_peripherals(void) {
+  dif_rstmgr_t rstmgr;
+  TRY(dif_rstmgr_init(mmio_region_from_addr(TOP_EARLGREY_RSTMGR_AON_BASE_ADDR),
+                      &rstmgr));
+  for (dif_rstmgr_peripheral_t peripheral = 0;
+       peripheral <= kTopEarlgreyResetManagerSwResetsLast; ++peripheral) {
+    // Keep the console alive.
+    if (peripheral == kTopEarlgreyResetManagerSwResetsSpiDevice &&
+        kOttfTestConfig.console.type == kOttfConsoleSpiDevice) {
+      continue;
+    }
+    TRY(dif_rstmgr_software_reset(&rstmgr, peripheral,
+                                  kDifRstmgrSoftwareReset));
+  }
+  return OK_STATUS();
+}
+
+status_t ujcmd_ottf_run_tests(ujson_t *uj) {
+  ottf_run_tests_req_t req;
+  TRY(ujson_deserialize_ottf_run_tests_req_t(uj, &req));
+  if (req.count > ARRAYSIZE(req.tests)) {
+    return INVALID_ARGUMENT();
+  }
+  for (size_t i = 0; i < req.count; ++i) {
+    if (req.tests[i] >= kOttfTestCasesCount) {
+      return INVALID_ARGUMENT();
+    }
+  }
+
+  ottf_run_tests_resp_t resp = {
+      .num_tests = req.count == 0 ? (uint16_t)kOttfTestCasesCount : req.count,
+  };
+  RESP_OK(ujson_serialize_ottf_run_tests_resp_t, uj, &resp);
+
+  for (uint16_t i = 0; i < resp.num_tests; ++i) {
+    uint16_t index = req.count == 0 ? i : req.tests[i];
+    const ottf_test_case_t *test_case = &kOttfTestCases[index];
+    if (req.reset_peripherals) {
+      TRY(reset_peripherals());
+    }
+
+    ottf_test_result_t result = {.index = index};
+    uint64_t start = ibex_mcycle_read();
+    result.status = test_case->test_fn();
+    result.cycles = ibex_mcycle_read() - start;
+    // Truncate the name to the size of the response field.
+    for (size_t j = 0;
+         j < sizeof(result.name) - 1 && test_case->name[j] != '\0'; ++j) {
+      result.name[j] = test_case->name[j];
+    }
+    RESP_OK(ujson_serialize_ottf_test_result_t, uj, &result);
+  }
+  return OK_STATUS();
+}
+
 status_t ujson_ottf_dispatch(ujson_t *uj, test_command_t command) {
   if (uj == NULL) {
     return INVALID_ARGUMENT();
@@ -24,6 +94,21 @@ status_t ujson_ottf_dispatch(ujson_t *uj, test_command_t command) {
     case kTestCommandMemWrite:
       RESP_ERR(uj, ujcmd_mem_write(uj));
       break;
+    case kTestCommandMemReadBlob:
+      RESP_ERR(uj, ujcmd_mem_read_blob(uj));
+      break;
+    case kTestCommandMemWriteBlob:
+      RESP_ERR(uj, ujcmd_mem_write_blob(uj));
+      break;
+    case kTestCommandMemDump:
+      RESP_ERR(uj, ujcmd_mem_dump(uj));
+      break;
+    case kTestCommandMemLoad:
+      RESP_ERR(uj, ujcmd_mem_load(uj));
+      break;
+    case kTestCommandOttfRunTests:
+      RESP_ERR(uj, ujcmd_ottf_run_tests(uj));
+      break;
     default:
       return UNIMPLEMENTED();
   }
@@ -5,6 +5,8 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_UJSON_OTTF_COMMANDS_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_UJSON_OTTF_COMMANDS_H_
 
+#include <stddef.h>
+
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/testing/json/command.h"
 #include "sw/device/lib/ujson/ujson.h"
@@ -13,6 +15,67 @@
 extern "C" {
 #endif
 
+/**
+ * A test case of a multi-test image.
+ */
+typedef struct ottf_test_case {
+  /**
+   * Name of the test case, reported back to the host.
+   */
+  const char *name;
+  /**
+   * The test function.
+   */
+  status_t (*test_fn)(void);
+} ottf_test_case_t;
+
+/**
+ * Initializer for an `ottf_test_case_t` named after its test function.
+ */
+#define OTTF_TEST_CASE(test_function_) \
+  { .name = #test_function_, .test_fn = test_function_ }
+
+/**
+ * Registers the test cases of a multi-test image.
+ *
+ * The host selects and runs test cases with the `OttfRunTests` command, so
+ * that a single image (and a single boot) covers many small tests. The image
+ * has to process commands with `ujson_ottf_dispatch()`, e.g.:
+ *
+ *   OTTF_DEFINE_TEST_CASES(OTTF_TEST_CASE(test_foo), OTTF_TEST_CASE(test_bar));
+ *
+ * This must be used at the global scope.
+ */
+#define OTTF_DEFINE_TEST_CASES(...)                            \
+  const ottf_test_case_t kOttfTestCases[] = {__VA_ARGS__};     \
+  const size_t kOttfTestCasesCount =                           \
+      sizeof(kOttfTestCases) / sizeof(kOttfTestCases[0]);
+
+/**
+ * Test cases of the image, see `OTTF_DEFINE_TEST_CASES()`.
+ *
+ * These are weak symbols which default to an empty list.
+ */
+extern const ottf_test_case_t kOttfTestCases[];
+extern const size_t kOttfTestCasesCount;
+
+/**
+ * Runs the test cases selected by an `ottf_run_tests_req_t`.
+ *
+ * Test cases run back to back in the requested order, or in registration order
+ * if `count` is zero. If `reset_peripherals` is set, all peripherals that can
+ * be reset through the rstmgr software resets are reset before each test case,
+ * except for the SPI device if it is the OTTF console. The response is an
+ * `ottf_run_tests_resp_t` with the number of test cases to run, followed by an
+ * `ottf_test_result_t` per test case.
+ *
+ * A test case that aborts, e.g. through a failed `CHECK()`, ends the image.
+ *
+ * @param uj A ujson IO context.
+ * @return The status result of the operation.
+ */
+status_t ujcmd_ottf_run_tests(ujson_t *uj);
+
 /**
  * Handles basic memory commands known to the OTTF ujson framework.
  *
@@ -154,13 +154,14 @@ bool rom_test_main(void) {
     base_uart_stdout(&uart0);
   }
 
-  // Print the chip version information
-  LOG_INFO("kChipInfo: scm_revision=%x", kChipInfo.scm_revision);
-
   // Skip sram_init for test_rom
   dif_rstmgr_reset_info_bitfield_t reset_reasons;
   CHECK_DIF_OK(dif_rstmgr_reset_info_get(&rstmgr, &reset_reasons));
 
+  // Only print the boot banner once per power cycle: on FPGAs, the UART
+  // output takes longer than the rest of the boot, and tests that reset
+  // repeatedly would pay for it on every reset.
+  bool print_banner = true;
 #if !OT_IS_ENGLISH_BREAKFAST
   // Store the reset reason in retention RAM and clear the register.
   volatile retention_sram_t *ret_ram = retention_sram_get();
@@ -168,19 +169,28 @@ bool rom_test_main(void) {
   CHECK_DIF_OK(dif_rstmgr_reset_info_clear(&rstmgr));
 
   // Write 0x54534554 (ASCII: TEST) to the end of the retention SRAM creator
-  // area to be able to determine the type of ROM in tests.
+  // area to be able to determine the type of ROM in tests. The retention SRAM
+  // survives all resets but POR, so finding the identifier already there means
+  // that the banner has been printed since the last POR.
   volatile uint32_t *creator_last_word =
       &ret_ram->creator.reserved[ARRAYSIZE(ret_ram->creator.reserved) - 1];
+  print_banner = (reset_reasons & kDifRstmgrResetInfoPor) != 0 ||
+                 *creator_last_word != TEST_ROM_IDENTIFIER;
   *creator_last_word = TEST_ROM_IDENTIFIER;
 #endif
 
+  // Print the chip version information
+  if (print_banner) {
+    LOG_INFO("kChipInfo: scm_revision=%x", kChipInfo.scm_revision);
+  }
+
   // Print the FPGA version-id.
   // This is guaranteed to be zero on all non-FPGA implementations.
   dif_rv_core_ibex_fpga_info_t fpga;
   CHECK_DIF_OK(dif_rv_core_ibex_init(
       mmio_region_from_addr(TOP_EARLGREY_RV_CORE_IBEX_CFG_BASE_ADDR), &ibex));
   CHECK_DIF_OK(dif_rv_core_ibex_read_fpga_info(&ibex, &fpga));
-  if (fpga != 0) {
+  if (print_banner && fpga != 0) {
     LOG_INFO("TestROM:%08x", fpga);
   }
 
@@ -227,7 +237,9 @@ bool rom_test_main(void) {
 
   // Jump to the OTTF in flash. Within the flash binary, it is the
   // responsibily of the OTTF to set up its own stack, and to never return.
-  LOG_INFO("Test ROM complete, jumping to flash (addr: %x)!", entry_point);
+  if (print_banner) {
+    LOG_INFO("Test ROM complete, jumping to flash (addr: %x)!", entry_point);
+  }
   ((ottf_entry_point *)entry_point)();
 
   // If the flash image returns, we should abort anyway.
@@ -13,6 +13,14 @@
 
 #define USBDEV_BASE_ADDR TOP_EARLGREY_USBDEV_BASE_ADDR
 
+enum {
+  /**
+   * Maximum number of received packets popped per status read; matches the
+   * depth of the RX FIFO.
+   */
+  kRxBatchSize = 8,
+};
+
 static dif_usbdev_t usbdev;
 static dif_usbdev_buffer_pool_t buffer_pool;
 
@@ -147,24 +155,28 @@ status_t usb_testutils_poll(usb_testutils_ctx_t *ctx) {
     // TODO: we run the risk of starving the IN side here if the rx_callback(s)
     // are time-consuming
     while (true) {
-      bool is_empty;
-      TRY(dif_usbdev_status_get_rx_fifo_empty(ctx->dev, &is_empty));
-      if (is_empty) {
+      // Pop everything currently in the RX FIFO with a single status read.
+      dif_usbdev_rx_packet_info_t packet_info[kRxBatchSize];
+      dif_usbdev_buffer_t buffer[kRxBatchSize];
+      size_t num_packets;
+      TRY(dif_usbdev_recv_batch(ctx->dev, packet_info, buffer, kRxBatchSize,
+                                &num_packets));
+      if (num_packets == 0) {
         break;
       }
 
-      dif_usbdev_rx_packet_info_t packet_info;
-      dif_usbdev_buffer_t buffer;
-      TRY(dif_usbdev_recv(ctx->dev, &packet_info, &buffer));
-
-      unsigned ep = packet_info.endpoint;
-      if (ctx->out[ep].rx_callback) {
-        TRY(ctx->out[ep].rx_callback(ctx->out[ep].ep_ctx, packet_info, buffer));
-      } else {
-        // Note: this could happen following endpoint removal
-        TRC_S("USB: unexpected RX ");
-        TRC_I(ep, 8);
-        TRY(dif_usbdev_buffer_return(ctx->dev, ctx->buffer_pool, &buffer));
+      for (size_t i = 0; i < num_packets; ++i) {
+        unsigned ep = packet_info[i].endpoint;
+        if (ctx->out[ep].rx_callback) {
+          TRY(ctx->out[ep].rx_callback(ctx->out[ep].ep_ctx, packet_info[i],
+                                       buffer[i]));
+        } else {
+          // Note: this could happen following endpoint removal
+          TRC_S("USB: unexpected RX ");
+          TRC_I(ep, 8);
+          TRY(dif_usbdev_buffer_return(ctx->dev, ctx->buffer_pool,
+                                       &buffer[i]));
+        }
       }
     }
   }
@@ -14,6 +14,9 @@
 
 #include "sw/device/lib/testing/usb_testutils_streams.h"
 
+#include <assert.h>
+
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/usb_testutils_diags.h"
@@ -27,7 +30,7 @@ static const enum {
   kReadMethodNone = 0u,  // Just discard the data; do not read it from usbdev
   kReadMethodStandard,   // Use standard dif_usbdev_buffer_read() function
   kReadMethodFaster      // Faster implementation
-} read_method = kReadMethodStandard;
+} read_method = USBUTILS_MEM_FASTER ? kReadMethodFaster : kReadMethodStandard;
 
 /**
  * Write method to be employed
@@ -35,13 +38,57 @@ static const enum {
 static const enum {
   kWriteMethodStandard = 1u,  // Use standard dif_usbdev_buffer_write() function
   kWriteMethodFaster          // Faster implementation
-} write_method = kWriteMethodStandard;
+} write_method =
+    USBUTILS_MEM_FASTER ? kWriteMethodFaster : kWriteMethodStandard;
 
 /**
  * Diagnostic logging; expensive
  */
 static bool log_traffic = false;
 
+enum {
+  /**
+   * Period of the LFSR; zero is the only state outside of the cycle.
+   */
+  kLfsrPeriod = 255u,
+};
+
+/**
+ * LFSR output sequence starting from state 1, extended so that a run of up to
+ * one period, plus a partial word, may be taken from any position in the cycle
+ * without wrapping.
+ */
+static uint8_t lfsr_seq[2u * kLfsrPeriod + sizeof(uint32_t)];
+
+/**
+ * Position of each LFSR state within `lfsr_seq`.
+ */
+static uint8_t lfsr_pos[256];
+
+static bool lfsr_tables_ready = false;
+
+// Precompute the LFSR output sequence, so that packets may be generated and
+// checked a word at a time.
+static void lfsr_tables_init(void) {
+  uint8_t lfsr = 1u;
+  for (size_t i = 0u; i < ARRAYSIZE(lfsr_seq); i++) {
+    lfsr_seq[i] = lfsr;
+    if (i < kLfsrPeriod) {
+      lfsr_pos[lfsr] = (uint8_t)i;
+    }
+    lfsr = LFSR_ADVANCE(lfsr);
+  }
+  lfsr_tables_ready = true;
+}
+
+// Return the run of `len` bytes generated from the (non-zero) LFSR state
+// `*lfsr`, advancing the state past them; the run may be read a word at a time
+static const uint8_t *lfsr_run(uint8_t *lfsr, size_t len) {
+  const uint8_t *run = &lfsr_seq[lfsr_pos[*lfsr]];
+  *lfsr = run[len];
+  return run;
+}
+
 // Determine the length of the next packet in the data stream, _including_
 // any required signature.
 static uint8_t packet_length(const usbdev_stream_t *s, uint32_t bytes_done,
@@ -98,6 +145,26 @@ static void buffer_dump(const uint8_t *data, size_t n) {
   base_hexdump_with(fmt, (char *)data, n);
 }
 
+#if USBUTILS_MEM_FASTER
+// Read a received packet out of packet buffer memory a word at a time,
+// returning the buffer to the pool; `data` must be word-aligned and have room
+// for `len` rounded up to whole words.
+static status_t buffer_read_words(usb_testutils_ctx_t *usbdev,
+                                  dif_usbdev_buffer_t *buf, uint8_t *data,
+                                  size_t len) {
+  dif_usbdev_buffer_view_t view;
+  TRY(dif_usbdev_buffer_map(usbdev->dev, buf, &view));
+  TRY_CHECK(view.length >= len && (view.offset & 3u) == 0u);
+  uint32_t *wp = (uint32_t *)data;
+  for (size_t i = 0u; i < len; i += sizeof(uint32_t)) {
+    *wp++ = mmio_region_read32(view.region, (ptrdiff_t)(view.offset + i));
+  }
+  TRY(dif_usbdev_buffer_consume(usbdev->dev, usbdev->buffer_pool, buf,
+                                view.length));
+  return OK_STATUS();
+}
+#endif
+
 // Create a stream signature buffer
 static uint8_t buffer_sig_create(usb_testutils_streams_ctx_t *ctx,
                                  usbdev_stream_t *s, dif_usbdev_buffer_t *buf) {
@@ -128,10 +195,23 @@ static uint8_t buffer_sig_create(usb_testutils_streams_ctx_t *ctx,
   size_t bytes_written;
   switch (write_method) {
 #if USBUTILS_MEM_FASTER
-    case kWriteMethodFaster:
-      // TODO: integrate faster transfers to/from USB device packet buffer
-      // memory.
-      OT_FALLTHROUGH_INTENDED;
+    case kWriteMethodFaster: {
+      // The signature is word-sized and starts the packet, so write it
+      // straight into packet buffer memory.
+      static_assert(sizeof(sig) % sizeof(uint32_t) == 0,
+                    "Signature must be a whole number of words");
+      dif_usbdev_buffer_view_t view;
+      CHECK_DIF_OK(dif_usbdev_buffer_map(ctx->usbdev->dev, buf, &view));
+      CHECK(view.length >= sizeof(sig) && (view.offset & 3u) == 0u);
+      const uint8_t *sp = (const uint8_t *)&sig;
+      for (size_t i = 0; i < sizeof(sig); i += sizeof(uint32_t)) {
+        mmio_region_write32(view.region, (ptrdiff_t)(view.offset + i),
+                            read_32(&sp[i]));
+      }
+      CHECK_DIF_OK(
+          dif_usbdev_buffer_commit(ctx->usbdev->dev, buf, sizeof(sig)));
+      bytes_written = sizeof(sig);
+    } break;
 #endif
     default:
       CHECK_DIF_OK(dif_usbdev_buffer_write(
@@ -237,21 +317,31 @@ static void buffer_fill(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
   CHECK(num_bytes <= buf->remaining_bytes);
   CHECK(num_bytes <= sizeof(data));
 
+#if USBUTILS_MEM_FASTER
+  // Generate the byte stream straight into packet buffer memory, one word at
+  // a time, rather than staging it in `data` and copying it across.
+  if (write_method == kWriteMethodFaster && !(s->verbose && log_traffic)) {
+    dif_usbdev_buffer_view_t view;
+    CHECK_DIF_OK(dif_usbdev_buffer_map(ctx->usbdev->dev, buf, &view));
+    CHECK((view.offset & 3u) == 0u);
+    if (s->generating) {
+      const uint8_t *run = lfsr_run(&s->tx.lfsr, num_bytes);
+      for (uint32_t i = 0u; i < num_bytes; i += sizeof(uint32_t)) {
+        mmio_region_write32(view.region, (ptrdiff_t)(view.offset + i),
+                            read_32(&run[i]));
+      }
+    }
+    CHECK_DIF_OK(dif_usbdev_buffer_commit(ctx->usbdev->dev, buf, num_bytes));
+    s->tx.bytes += num_bytes;
+    return;
+  }
+#endif
+
   if (s->generating) {
     // Emit LFSR-generated byte stream; keep this brief so that we can
     // reduce our latency in responding to USB events (usb_testutils employs
     // polling at present)
-    uint8_t lfsr = s->tx.lfsr;
-
-    const uint8_t *edp = &data[num_bytes];
-    uint8_t *dp = data;
-    while (dp < edp) {
-      *dp++ = lfsr;
-      lfsr = LFSR_ADVANCE(lfsr);
-    }
-
-    // Update the LFSR for the next packet
-    s->tx.lfsr = lfsr;
+    memcpy(data, lfsr_run(&s->tx.lfsr, num_bytes), num_bytes);
   } else {
     // Undefined buffer contents; useful for profiling IN throughput on
     // CW310, because the CPU load at 10MHz can be an appreciable slowdown
@@ -263,12 +353,6 @@ static void buffer_fill(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
 
   size_t bytes_written;
   switch (write_method) {
-#if USBUTILS_MEM_FASTER
-    case kWriteMethodFaster:
-      // TODO: integrate faster transfers to/from USB device packet buffer
-      // memory.
-      OT_FALLTHROUGH_INTENDED;
-#endif
     default:
       CHECK_DIF_OK(dif_usbdev_buffer_write(ctx->usbdev->dev, buf, data,
                                            num_bytes, &bytes_written));
@@ -300,8 +384,9 @@ static void buffer_check(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
 #if USBUTILS_MEM_FASTER
       // Faster read performance using custom routine
       case kReadMethodFaster:
-        // TODO: faster read method not yet integrated, defaulting to standard
-        OT_FALLTHROUGH_INTENDED;
+        CHECK_STATUS_OK(buffer_read_words(usbdev, &buf, data, len));
+        bytes_read = len;
+        break;
 #endif
       default:
         CHECK_DIF_OK(dif_usbdev_buffer_read(usbdev->dev, usbdev->buffer_pool,
@@ -334,28 +419,30 @@ static void buffer_check(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
         // Check received data against expected LFSR-generated byte stream;
         // keep this brief so that we can reduce our latency in responding to
         // USB events (usb_testutils employs polling at present)
-        uint8_t rxtx_lfsr = s->rxtx_lfsr;
-        uint8_t rx_lfsr = s->rx_lfsr;
-
-        const uint8_t *esp = &data[bytes_read];
+        size_t n = bytes_read - offset;
         const uint8_t *sp = &data[offset];
-        while (sp < esp) {
-          // Received data should be the XOR of two LFSR-generated PRND streams
-          // - ours on the transmission side, and that of the DPI model
-          uint8_t expected = rxtx_lfsr ^ rx_lfsr;
-          CHECK(expected == *sp,
+        CHECK(s->rxtx_lfsr != 0u && s->rx_lfsr != 0u,
+              "S%u: LFSR in isolated zero state", s->id);
+        const uint8_t *rxtx_run = lfsr_run(&s->rxtx_lfsr, n);
+        const uint8_t *rx_run = lfsr_run(&s->rx_lfsr, n);
+
+        // Received data should be the XOR of two LFSR-generated PRND streams
+        // - ours on the transmission side, and that of the DPI model; compare
+        // whole words and locate the offending byte only upon a mismatch
+        size_t i = 0u;
+        for (; i + sizeof(uint32_t) <= n; i += sizeof(uint32_t)) {
+          uint32_t expected = read_32(&rxtx_run[i]) ^ read_32(&rx_run[i]);
+          if (read_32(&sp[i]) != expected) {
+            break;
+          }
+        }
+        for (; i < n; i++) {
+          uint8_t expected = rxtx_run[i] ^ rx_run[i];
+          CHECK(expected == sp[i],
                 "S%u: Unexpected received data 0x%02x : (LFSRs 0x%02x 0x%02x)",
-                s->id, *sp, rxtx_lfsr, rx_lfsr);
-
-          rxtx_lfsr = LFSR_ADVANCE(rxtx_lfsr);
-          rx_lfsr = LFSR_ADVANCE(rx_lfsr);
-          sp++;
+                s->id, sp[i], rxtx_run[i], rx_run[i]);
         }
 
-        // Update the LFSRs for the next packet
-        s->rxtx_lfsr = rxtx_lfsr;
-        s->rx_lfsr = rx_lfsr;
-
         // Update the count of LFSR bytes received
         s->rx_bytes += bytes_read - offset;
       } break;
@@ -451,8 +538,8 @@ static status_t strm_rx(void *cb_v, dif_usbdev_rx_packet_info_t packet_info,
 #if USBUTILS_MEM_FASTER
         // Faster read performance using custom routine
         case kReadMethodFaster:
-          // TODO: faster read method not yet integrated, defaulting to standard
-          OT_FALLTHROUGH_INTENDED;
+          TRY(buffer_read_words(usbdev, &buf, data, len));
+          break;
 #endif
         //  Use the standard interface
         default:
@@ -520,6 +607,10 @@ status_t usb_testutils_stream_init(usb_testutils_streams_ctx_t *ctx, uint8_t id,
   TRY_CHECK(id < USBUTILS_STREAMS_MAX);
   usbdev_stream_t *s = &ctx->streams[id];
 
+  if (!lfsr_tables_ready) {
+    lfsr_tables_init();
+  }
+
   // Remember the stream IDentifier and flags
   s->id = id;
   s->flags = flags;
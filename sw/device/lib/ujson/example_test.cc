@@ -125,6 +125,17 @@ TEST(Derive, MatrixDeserialize) {
   EXPECT_EQ(memcmp(&m, &expected, sizeof(m)), 0);
 }
 
+TEST(Derive, MatrixDeserializeHex) {
+  matrix expected = {
+      {{1, -2, 0, 0, 0}, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}},
+  };
+  matrix m{};
+  SourceSink ss(R"json({"k":"01000000feffffff"})json");
+  ujson_t uj = ss.UJsonBuffered();
+  EXPECT_TRUE(status_ok(ujson_deserialize_matrix(&uj, &m)));
+  EXPECT_EQ(memcmp(&m, &expected, sizeof(m)), 0);
+}
+
 TEST(Derive, DirectionSerialize) {
   direction d = kDirectionEast;
   SourceSink ss;
@@ -5,6 +5,8 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_UJSON_TEST_HELPERS_H_
 #define OPENTITAN_SW_DEVICE_LIB_UJSON_TEST_HELPERS_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
 
 #include "sw/device/lib/base/status.h"
@@ -22,6 +24,13 @@ class SourceSink {
     return ujson_init((void *)this, &SourceSink::getc, &SourceSink::putbuf);
   }
 
+  // Returns a buffered context that reads at most `chunk` bytes at a time.
+  ujson_t UJsonBuffered(size_t chunk = SIZE_MAX) {
+    chunk_ = chunk;
+    return ujson_init_buffered((void *)this, &SourceSink::getbuf,
+                               &SourceSink::putbuf);
+  }
+
   void Reset() {
     pos_ = 0;
     sink_.clear();
@@ -40,6 +49,16 @@ class SourceSink {
     }
   }
 
+  status_t GetBuf(char *buf, size_t len) {
+    if (pos_ >= source_.size()) {
+      return RESOURCE_EXHAUSTED();
+    }
+    size_t n = std::min({len, chunk_, source_.size() - pos_});
+    source_.copy(buf, n, pos_);
+    pos_ += n;
+    return OK_STATUS(static_cast<int32_t>(n));
+  }
+
   status_t PutBuf(const char *buf, size_t len) {
     sink_.append(buf, len);
     return OK_STATUS();
@@ -50,11 +69,16 @@ class SourceSink {
     return static_cast<SourceSink *>(self)->GetChar();
   }
 
+  static status_t getbuf(void *self, char *buf, size_t len) {
+    return static_cast<SourceSink *>(self)->GetBuf(buf, len);
+  }
+
   static status_t putbuf(void *self, const char *buf, size_t len) {
     return static_cast<SourceSink *>(self)->PutBuf(buf, len);
   }
 
   size_t pos_ = 0;
+  size_t chunk_ = SIZE_MAX;
   std::string source_;
   std::string sink_;
 };
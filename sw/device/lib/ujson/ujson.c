@@ -22,6 +22,14 @@ ujson_t ujson_init(void *context, status_t (*getc)(void *),
   return u;
 }
 
+ujson_t ujson_init_buffered(void *context,
+                            status_t (*getbuf)(void *, char *, size_t),
+                            status_t (*putbuf)(void *, const char *, size_t)) {
+  ujson_t u = UJSON_INIT(context, NULL, putbuf);
+  u.getbuf = getbuf;
+  return u;
+}
+
 void ujson_crc32_reset(ujson_t *uj) { crc32_init(&uj->crc32); }
 
 uint32_t ujson_crc32_finish(ujson_t *uj) { return crc32_finish(&uj->crc32); }
@@ -31,13 +39,43 @@ status_t ujson_putbuf(ujson_t *uj, const char *buf, size_t len) {
   return uj->putbuf(uj->io_context, buf, len);
 }
 
+// Reads the next character from the input, refilling the receive buffer if
+// the context is buffered.
+static status_t input_getc(ujson_t *uj) {
+  if (uj->getbuf == NULL) {
+    return uj->getc(uj->io_context);
+  }
+  if (uj->rx_pos == uj->rx_len) {
+    size_t len = (size_t)TRY(
+        uj->getbuf(uj->io_context, uj->rx_buffer, sizeof(uj->rx_buffer)));
+    if (len == 0 || len > sizeof(uj->rx_buffer)) {
+      return RESOURCE_EXHAUSTED();
+    }
+    uj->rx_pos = 0;
+    uj->rx_len = (uint8_t)len;
+  }
+  return OK_STATUS((uint8_t)uj->rx_buffer[uj->rx_pos++]);
+}
+
+// Returns the number of characters that can be scanned directly in the
+// receive buffer.
+static inline size_t rx_available(const ujson_t *uj) {
+  return uj->buffer >= 0 ? 0 : (size_t)(uj->rx_len - uj->rx_pos);
+}
+
+// Consumes `len` characters scanned directly in the receive buffer.
+static inline void rx_consume(ujson_t *uj, size_t len) {
+  crc32_add(&uj->crc32, &uj->rx_buffer[uj->rx_pos], len);
+  uj->rx_pos += (uint8_t)len;
+}
+
 status_t ujson_getc(ujson_t *uj) {
   int16_t buffer = uj->buffer;
   if (buffer >= 0) {
     uj->buffer = -1;
     return OK_STATUS(buffer);
   } else {
-    status_t s = uj->getc(uj->io_context);
+    status_t s = input_getc(uj);
     if (!status_err(s)) {
       crc32_add8(&uj->crc32, (uint8_t)s.value);
     }
@@ -53,6 +91,118 @@ status_t ujson_ungetc(ujson_t *uj, char ch) {
   return OK_STATUS();
 }
 
+// Reads a character without adding it to the rolling CRC32.
+static status_t blob_getc(ujson_t *uj) {
+  int16_t buffer = uj->buffer;
+  if (buffer >= 0) {
+    uj->buffer = -1;
+    return OK_STATUS(buffer);
+  }
+  return input_getc(uj);
+}
+
+static status_t blob_get32(ujson_t *uj, uint32_t *value) {
+  uint32_t v = 0;
+  for (size_t i = 0; i < sizeof(v); ++i) {
+    v |= (uint32_t)(uint8_t)TRY(blob_getc(uj)) << (8 * i);
+  }
+  *value = v;
+  return OK_STATUS();
+}
+
+static void blob_put32(char *buf, uint32_t value) {
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    buf[i] = (char)(value >> (8 * i));
+  }
+}
+
+status_t ujson_putblob(ujson_t *uj, const void *buf, size_t len) {
+  char word[2 * sizeof(uint32_t)];
+  blob_put32(&word[0], kUjsonBlobMagic);
+  blob_put32(&word[sizeof(uint32_t)], (uint32_t)len);
+  TRY(uj->putbuf(uj->io_context, word, sizeof(word)));
+  if (len > 0) {
+    TRY(uj->putbuf(uj->io_context, (const char *)buf, len));
+  }
+  blob_put32(&word[0], crc32(buf, len));
+  TRY(uj->putbuf(uj->io_context, word, sizeof(uint32_t)));
+  return OK_STATUS();
+}
+
+// Reads `len` bytes of frame data into `buf`.
+static status_t blob_read(ujson_t *uj, void *buf, size_t len) {
+  uint8_t *data = (uint8_t *)buf;
+  size_t i = 0;
+  if (uj->getbuf != NULL) {
+    // Drain the receive buffer, then read the rest straight into `buf`.
+    size_t avail = (size_t)(uj->rx_len - uj->rx_pos);
+    i = avail < len ? avail : len;
+    memcpy(data, &uj->rx_buffer[uj->rx_pos], i);
+    uj->rx_pos += (uint8_t)i;
+    while (i < len) {
+      size_t got =
+          (size_t)TRY(uj->getbuf(uj->io_context, (char *)&data[i], len - i));
+      if (got == 0) {
+        return RESOURCE_EXHAUSTED();
+      }
+      i += got;
+    }
+  }
+  for (; i < len; ++i) {
+    data[i] = (uint8_t)TRY(blob_getc(uj));
+  }
+  return OK_STATUS();
+}
+
+status_t ujson_getblob(ujson_t *uj, void *buf, size_t len) {
+  uint32_t value;
+  TRY(blob_get32(uj, &value));
+  if (value != kUjsonBlobMagic) {
+    return NOT_FOUND();
+  }
+  TRY(blob_get32(uj, &value));
+  if (value != len) {
+    return OUT_OF_RANGE();
+  }
+  TRY(blob_read(uj, buf, len));
+  TRY(blob_get32(uj, &value));
+  if (value != crc32(buf, len)) {
+    return DATA_LOSS();
+  }
+  return OK_STATUS();
+}
+
+status_t ujson_putchunk(ujson_t *uj, const void *buf, size_t len,
+                        uint32_t *crc) {
+  char word[sizeof(uint32_t)];
+  blob_put32(word, (uint32_t)len);
+  TRY(uj->putbuf(uj->io_context, word, sizeof(word)));
+  if (len > 0) {
+    TRY(uj->putbuf(uj->io_context, (const char *)buf, len));
+  }
+  crc32_add(crc, buf, len);
+  blob_put32(word, crc32_finish(crc));
+  TRY(uj->putbuf(uj->io_context, word, sizeof(word)));
+  return OK_STATUS();
+}
+
+status_t ujson_getchunk(ujson_t *uj, void *buf, size_t max_len,
+                        uint32_t *crc) {
+  uint32_t len;
+  TRY(blob_get32(uj, &len));
+  if (len > max_len) {
+    return OUT_OF_RANGE();
+  }
+  TRY(blob_read(uj, buf, len));
+  crc32_add(crc, buf, len);
+  uint32_t value;
+  TRY(blob_get32(uj, &value));
+  if (value != crc32_finish(crc)) {
+    return DATA_LOSS();
+  }
+  return OK_STATUS((int32_t)len);
+}
+
 bool ujson_streq(const char *a, const char *b) {
   while (*a && *b && *a == *b) {
     ++a;
@@ -70,17 +220,25 @@ static status_t consume_whitespace(ujson_t *uj) {
   return OK_STATUS(ch);
 }
 
-static status_t consume_hexdigit(ujson_t *uj) {
-  int ch = TRY(ujson_getc(uj));
+// Returns the value of a hex digit or -1 if `ch` is not a hex digit.
+static int hex_value(int ch) {
   if (ch >= '0' && ch <= '9') {
-    return OK_STATUS(ch - '0');
+    return ch - '0';
   } else if (ch >= 'A' && ch <= 'F') {
-    return OK_STATUS(ch - 'A' + 10);
+    return ch - 'A' + 10;
   } else if (ch >= 'a' && ch <= 'f') {
-    return OK_STATUS(ch - 'a' + 10);
+    return ch - 'a' + 10;
   } else {
+    return -1;
+  }
+}
+
+static status_t consume_hexdigit(ujson_t *uj) {
+  int value = hex_value(TRY(ujson_getc(uj)));
+  if (value < 0) {
     return OUT_OF_RANGE();
   }
+  return OK_STATUS(value);
 }
 
 static status_t consume_hex(ujson_t *uj) {
@@ -113,6 +271,21 @@ status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len) {
   len--;  // One char for the nul terminator.
   TRY(ujson_consume(uj, '"'));
   while (true) {
+    // Copy plain characters straight out of the receive buffer.
+    size_t avail = rx_available(uj);
+    if (avail > 0) {
+      const char *run = &uj->rx_buffer[uj->rx_pos];
+      size_t run_len = 0;
+      while (run_len < avail && run[run_len] != '"' && run[run_len] != '\\') {
+        ++run_len;
+      }
+      size_t copy_len = run_len < len ? run_len : len;
+      memcpy(str, run, copy_len);
+      str += copy_len;
+      len -= copy_len;
+      n += (int)copy_len;
+      rx_consume(uj, run_len);
+    }
     ch = (char)TRY(ujson_getc(uj));
     if (ch == '\"')
       break;
@@ -172,6 +345,16 @@ status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz) {
   while (ch >= '0' && ch <= '9') {
     value *= 10;
     value += ch - '0';
+    // Accumulate digits straight out of the receive buffer.
+    size_t avail = rx_available(uj);
+    const char *digits = &uj->rx_buffer[uj->rx_pos];
+    size_t ndigits = 0;
+    while (ndigits < avail && digits[ndigits] >= '0' &&
+           digits[ndigits] <= '9') {
+      value *= 10;
+      value += digits[ndigits++] - '0';
+    }
+    rx_consume(uj, ndigits);
     s = ujson_getc(uj);
     if (status_err(s))
       break;
@@ -185,6 +368,44 @@ status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz) {
   return OK_STATUS();
 }
 
+status_t ujson_parse_hex(ujson_t *uj, void *buf, size_t len) {
+  uint8_t *data = (uint8_t *)buf;
+  size_t n = 0;
+  TRY(ujson_consume(uj, '"'));
+  while (true) {
+    // Decode digit pairs straight out of the receive buffer.
+    size_t avail = rx_available(uj);
+    const char *digits = &uj->rx_buffer[uj->rx_pos];
+    size_t ndigits = 0;
+    while (ndigits + 1 < avail) {
+      int hi = hex_value(digits[ndigits]);
+      int lo = hex_value(digits[ndigits + 1]);
+      if (hi < 0 || lo < 0) {
+        break;
+      }
+      if (n < len) {
+        data[n++] = (uint8_t)(hi << 4 | lo);
+      }
+      ndigits += 2;
+    }
+    rx_consume(uj, ndigits);
+
+    int ch = TRY(ujson_getc(uj));
+    if (ch == '"') {
+      break;
+    }
+    int hi = hex_value(ch);
+    int lo = TRY(consume_hexdigit(uj));
+    if (hi < 0) {
+      return OUT_OF_RANGE();
+    }
+    if (n < len) {
+      data[n++] = (uint8_t)(hi << 4 | lo);
+    }
+  }
+  return OK_STATUS((int32_t)n);
+}
+
 status_t ujson_deserialize_bool(ujson_t *uj, bool *value) {
   char got = (char)TRY(consume_whitespace(uj));
   if (got == 't') {
@@ -239,6 +460,16 @@ status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
   uint8_t ch;
   TRY(ujson_putbuf(uj, "\"", 1));
   while ((ch = (uint8_t)*buf) != '\0') {
+    // Emit runs of characters that need no escaping in one go.
+    size_t run = 0;
+    while (ch >= 0x20 && ch != '"' && ch != '\\' && ch < 0x7f) {
+      ch = (uint8_t)buf[++run];
+    }
+    if (run > 0) {
+      TRY(ujson_putbuf(uj, buf, run));
+      buf += run;
+      continue;
+    }
     if (ch < 0x20 || ch == '"' || ch == '\\' || ch >= 0x7f) {
       switch (ch) {
         case '"':
@@ -276,51 +507,100 @@ status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
   return OK_STATUS();
 }
 
+static const char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * Formats `value` in decimal into the characters preceding `end`, padding
+ * with zeros to at least `min_digits` digits.
+ *
+ * @return A pointer to the first character written.
+ */
+static char *format_uint32(char *end, uint32_t value, size_t min_digits) {
+  char *start = end;
+  while (value >= 100) {
+    uint32_t pair = value % 100;
+    value /= 100;
+    *--start = kDigitPairs[2 * pair + 1];
+    *--start = kDigitPairs[2 * pair];
+  }
+  if (value >= 10) {
+    *--start = kDigitPairs[2 * value + 1];
+    *--start = kDigitPairs[2 * value];
+  } else {
+    *--start = (char)('0' + value);
+  }
+  while ((size_t)(end - start) < min_digits) {
+    *--start = '0';
+  }
+  return start;
+}
+
 static status_t ujson_serialize_integer64(ujson_t *uj, uint64_t value,
                                           bool neg) {
   char buf[24];
   char *end = buf + sizeof(buf);
-  size_t len = 0;
-  *--end = '\0';
+  char *start = end;
 
   // If negative, two's complement for the absolute value.
   if (neg)
     value = ~value + 1;
-  do {
+  // Peel off nine digits at a time until the rest fits in 32 bits, so that at
+  // most two slow 64-bit divisions are needed.
+  while (value > UINT32_MAX) {
     // We've banned __udivdi3; do division with the replacement function.
     uint64_t remainder;
-    value = udiv64_slow(value, 10, &remainder);
-    *--end = '0' + (char)remainder;
-    ++len;
-  } while (value);
+    value = udiv64_slow(value, 1000000000, &remainder);
+    start = format_uint32(start, (uint32_t)remainder, 9);
+  }
+  start = format_uint32(start, (uint32_t)value, 0);
   if (neg) {
-    *--end = '-';
-    ++len;
+    *--start = '-';
   }
-  TRY(ujson_putbuf(uj, end, len));
+  TRY(ujson_putbuf(uj, start, (size_t)(end - start)));
   return OK_STATUS();
 }
 
 static status_t ujson_serialize_integer32(ujson_t *uj, uint32_t value,
                                           bool neg) {
-  char buf[24];
+  char buf[12];
   char *end = buf + sizeof(buf);
-  size_t len = 0;
-  *--end = '\0';
 
   // If negative, two's complement for the absolute value.
   if (neg)
     value = ~value + 1;
-  do {
-    *--end = '0' + value % 10;
-    value /= 10;
-    ++len;
-  } while (value);
+  char *start = format_uint32(end, value, 0);
   if (neg) {
-    *--end = '-';
-    ++len;
+    *--start = '-';
   }
-  TRY(ujson_putbuf(uj, end, len));
+  TRY(ujson_putbuf(uj, start, (size_t)(end - start)));
+  return OK_STATUS();
+}
+
+status_t ujson_serialize_hex(ujson_t *uj, const void *buf, size_t len) {
+  const uint8_t *data = (const uint8_t *)buf;
+  char chunk[32];
+  TRY(ujson_putbuf(uj, "\"", 1));
+  while (len > 0) {
+    size_t n = len < sizeof(chunk) / 2 ? len : sizeof(chunk) / 2;
+    for (size_t i = 0; i < n; ++i) {
+      chunk[2 * i] = hex[data[i] >> 4];
+      chunk[2 * i + 1] = hex[data[i] & 0xf];
+    }
+    TRY(ujson_putbuf(uj, chunk, 2 * n));
+    data += n;
+    len -= n;
+  }
+  TRY(ujson_putbuf(uj, "\"", 1));
   return OK_STATUS();
 }
 
@@ -11,6 +11,13 @@
 extern "C" {
 #endif
 
+enum {
+  /**
+   * Size of the receive buffer of a ujson context.
+   */
+  kUjsonRxBufferSize = 32,
+};
+
 /**
  * Input/Output context for ujson.
  */
@@ -21,10 +28,24 @@ typedef struct ujson {
   status_t (*putbuf)(void *, const char *, size_t);
   /** A pointer to an IO function for reading data from the input. */
   status_t (*getc)(void *);
+  /**
+   * A pointer to an IO function for reading up to `len` bytes from the input.
+   *
+   * Optional. When set, it is used instead of `getc` to fill the receive
+   * buffer. It must block until at least one byte is available and return
+   * the number of bytes read.
+   */
+  status_t (*getbuf)(void *, char *, size_t);
   /** An internal single character buffer for ungetting a character. */
   int16_t buffer;
+  /** Index of the next unread character in `rx_buffer`. */
+  uint8_t rx_pos;
+  /** Number of valid characters in `rx_buffer`. */
+  uint8_t rx_len;
   /** Holds the rolling CRC32 of characters that are sent and received.*/
   uint32_t crc32;
+  /** Characters read ahead from the input through `getbuf`. */
+  char rx_buffer[kUjsonRxBufferSize];
 } ujson_t;
 
 // clang-format off
@@ -33,7 +54,10 @@ typedef struct ujson {
     .io_context = (void*)(context_),         \
     .putbuf_ = (putbuf_),                    \
     .getc = (getc_),                         \
+    .getbuf = NULL,                          \
     .buffer = -1,                            \
+    .rx_pos = 0,                             \
+    .rx_len = 0,                             \
     .crc32 = UINT32_MAX,                     \
   }
 // clang-format on
@@ -49,6 +73,24 @@ typedef struct ujson {
 ujson_t ujson_init(void *context, status_t (*getc)(void *),
                    status_t (*putbuf)(void *, const char *, size_t));
 
+/**
+ * Initializes and returns a ujson context with buffered input.
+ *
+ * The input is read in bulk into a receive buffer that the parsers scan
+ * directly. Characters read ahead of the current message stay in the context,
+ * so all reads from the input must go through the same context.
+ *
+ * @param context An IO context for the `getbuf` and `putbuf` functions.
+ * @param getbuf A function to read up to `len` bytes from the input. It must
+ * block until at least one byte is available and return the number of bytes
+ * read.
+ * @param putbuf A function to write a buffer to the output.
+ * @return An initialized ujson_t context.
+ */
+ujson_t ujson_init_buffered(void *context,
+                            status_t (*getbuf)(void *, char *, size_t),
+                            status_t (*putbuf)(void *, const char *, size_t));
+
 /**
  * Gets a single character from the input.
  *
@@ -76,6 +118,84 @@ status_t ujson_ungetc(ujson_t *uj, char ch);
  */
 status_t ujson_putbuf(ujson_t *uj, const char *buf, size_t len);
 
+enum {
+  /**
+   * Magic value at the start of a binary frame (ASCII "UJBF").
+   */
+  kUjsonBlobMagic = 0x46424a55,
+};
+
+/**
+ * Writes a binary frame to the output.
+ *
+ * Binary frames carry bulk data without JSON encoding. A frame consists of
+ * the little-endian 32-bit words `kUjsonBlobMagic` and `len`, followed by the
+ * `len` bytes of data and the little-endian CRC32 of the data.
+ *
+ * The frame does not contribute to the rolling CRC32 of the context.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The data to send.
+ * @param len The length of the data.
+ * @return OK or an error.
+ */
+status_t ujson_putblob(ujson_t *uj, const void *buf, size_t len);
+
+/**
+ * Reads a binary frame from the input.
+ *
+ * Reads a frame written in the format described for `ujson_putblob()`. The
+ * frame must carry exactly `len` bytes of data.
+ *
+ * The frame does not contribute to the rolling CRC32 of the context.
+ *
+ * @param uj A ujson IO context.
+ * @param[out] buf The buffer to read the data into.
+ * @param len The expected length of the data.
+ * @return OK, `NOT_FOUND` if the frame does not start with the magic value,
+ * `OUT_OF_RANGE` if the frame length is not `len` or `DATA_LOSS` if the CRC32
+ * does not match.
+ */
+status_t ujson_getblob(ujson_t *uj, void *buf, size_t len);
+
+/**
+ * Writes one chunk of a chunked binary stream to the output.
+ *
+ * Chunked streams move ranges that are too large to buffer or to acknowledge
+ * as a single frame. A chunk consists of the little-endian 32-bit `len`,
+ * followed by the `len` bytes of data and the little-endian running CRC32 of
+ * all data sent in the stream so far, including this chunk.
+ *
+ * The chunk does not contribute to the rolling CRC32 of the context.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The data to send.
+ * @param len The length of the data.
+ * @param[in,out] crc Running CRC32 context of the stream; initialize it with
+ *                `crc32_init()` before the first chunk.
+ * @return OK or an error.
+ */
+status_t ujson_putchunk(ujson_t *uj, const void *buf, size_t len,
+                        uint32_t *crc);
+
+/**
+ * Reads one chunk of a chunked binary stream from the input.
+ *
+ * Reads a chunk written in the format described for `ujson_putchunk()`.
+ *
+ * The chunk does not contribute to the rolling CRC32 of the context.
+ *
+ * @param uj A ujson IO context.
+ * @param[out] buf The buffer to read the data into.
+ * @param max_len The maximum length of the data.
+ * @param[in,out] crc Running CRC32 context of the stream; initialize it with
+ *                `crc32_init()` before the first chunk.
+ * @return The length of the chunk, `OUT_OF_RANGE` if it exceeds `max_len` or
+ * `DATA_LOSS` if the running CRC32 does not match.
+ */
+status_t ujson_getchunk(ujson_t *uj, void *buf, size_t max_len,
+                        uint32_t *crc);
+
 /**
  * Resets the CRC32 calculation to an initial state.
  *
@@ -154,6 +274,20 @@ status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len);
  */
 status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz);
 
+/**
+ * Parse a JSON string of hex digits into bytes.
+ *
+ * Consume whitespace until finding a double-quote, then decode pairs of hex
+ * digits until the next double-quote. Bytes beyond `len` are consumed and
+ * dropped; the rest of `buf` is left untouched if the string is shorter.
+ *
+ * @param uj A ujson IO context.
+ * @param buf A buffer to write the bytes into.
+ * @param len The length of the target buffer.
+ * @return The number of bytes written to `buf` or an error.
+ */
+status_t ujson_parse_hex(ujson_t *uj, void *buf, size_t len);
+
 /**
  * The following functions parse integers of specific sizes.
  */
@@ -194,6 +328,19 @@ status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value);
  */
 status_t ujson_serialize_string(ujson_t *uj, const char *buf);
 
+/**
+ * Serialize bytes as a JSON string of hex digits.
+ *
+ * This is the counterpart of `ujson_parse_hex()`, and much more compact than
+ * an array of integers.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The bytes to serialize.
+ * @param len The number of bytes.
+ * @return OK or an error.
+ */
+status_t ujson_serialize_hex(ujson_t *uj, const void *buf, size_t len);
+
 /**
  * Serialize an integer.
  *
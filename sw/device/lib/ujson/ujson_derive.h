@@ -71,9 +71,6 @@
     } name_
 
 
-// Helper to count number of fields.
-#define ujson_count(name_, type_, ...) +1
-
 //////////////////////////////////////////////////////////////////////
 // Serialize Implementation
 //////////////////////////////////////////////////////////////////////
@@ -91,9 +88,14 @@
     } \
     TRY(ujson_putbuf(uj, "]", 1));
 
+// Emits the separator (`{` for the first field, `,` otherwise) and the quoted
+// key in a single write.
+#define ujson_ser_key(name_) \
+        TRY(ujson_putbuf(uj, nfield++ ? ",\"" #name_ "\":" : "{\"" #name_ "\":", \
+                         sizeof("{\"" #name_ "\":") - 1));
+
 #define ujson_ser_field(name_, type_, ...) { \
-        TRY(ujson_serialize_string(uj, #name_)); \
-        TRY(ujson_putbuf(uj, ":", 1)); \
+        ujson_ser_key(name_) \
         OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
         ( /*then*/ \
             TRY(ujson_serialize_##type_(uj, &self->name_)); \
@@ -102,12 +104,10 @@
             OT_EVAL(ujson_ser_loop( \
                     TRY(ujson_serialize_##type_(uj, p++)), __VA_ARGS__)) \
         ) /*endif*/ \
-        if (--nfield) TRY(ujson_putbuf(uj, ",", 1)); \
     }
 
 #define ujson_ser_string(name_, size_, ...) { \
-        TRY(ujson_serialize_string(uj, #name_)); \
-        TRY(ujson_putbuf(uj, ":", 1)); \
+        ujson_ser_key(name_) \
         OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
         ( /*then*/ \
             TRY(ujson_serialize_string(uj, self->name_)); \
@@ -116,15 +116,13 @@
             OT_EVAL(ujson_ser_loop( \
                     TRY(ujson_serialize_string(uj, p)); p+=size_, __VA_ARGS__)) \
         ) /*endif*/ \
-        if (--nfield) TRY(ujson_putbuf(uj, ",", 1)); \
     }
 
 #define UJSON_IMPL_SERIALIZE_STRUCT(name_, decl_) \
     status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) { \
-        size_t nfield = decl_(ujson_count, ujson_count); \
-        TRY(ujson_putbuf(uj, "{", 1)); \
+        size_t nfield = 0; \
         decl_(ujson_ser_field, ujson_ser_string) \
-        TRY(ujson_putbuf(uj, "}", 1)); \
+        TRY(ujson_putbuf(uj, nfield ? "}" : "{}", nfield ? 1 : 2)); \
         return OK_STATUS(); \
     } \
     extern const int __never_referenced___here_to_eat_a_semicolon[]
@@ -183,9 +181,15 @@
         ( /*then*/ \
             TRY(ujson_deserialize_##type_(uj, &self->name_)); \
         , /*else*/ \
-            type_ *p = (type_*)self->name_; \
-            OT_EVAL(ujson_de_loop(1, \
-                TRY(ujson_deserialize_##type_(uj, p++)), __VA_ARGS__)) \
+            /* A hex string holds the memory image of the whole array. */ \
+            if (TRY(ujson_consume_maybe(uj, '"'))) { \
+                TRY(ujson_ungetc(uj, '"')); \
+                TRY(ujson_parse_hex(uj, self->name_, sizeof(self->name_))); \
+            } else { \
+                type_ *p = (type_*)self->name_; \
+                OT_EVAL(ujson_de_loop(1, \
+                    TRY(ujson_deserialize_##type_(uj, p++)), __VA_ARGS__)) \
+            } \
         ) /*endif*/ \
     }
 
@@ -6,7 +6,9 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 
+#include "sw/device/lib/base/crc32.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/ujson/test_helpers.h"
 
@@ -161,6 +163,70 @@ TEST(UJson, ParseIntegerError) {
   EXPECT_EQ(status_err(s), kNotFound);
 }
 
+TEST(UJson, Buffered) {
+  const std::string input =
+      R"json( "Hello \"World\"\u0021", 1234567890123, -42 )json";
+  // Reading in small chunks makes tokens straddle buffer refills.
+  for (size_t chunk : {size_t{1}, size_t{3}, size_t{7}, SIZE_MAX}) {
+    SourceSink ss(input);
+    ujson_t uj = ss.UJsonBuffered(chunk);
+    char buf[32];
+    int64_t big;
+    int32_t small;
+
+    status_t s = ujson_parse_qs(&uj, buf, sizeof(buf));
+    EXPECT_EQ(status_err(s), kOk);
+    EXPECT_EQ(s.value, 14);
+    EXPECT_EQ(std::string(buf), "Hello \"World\"!");
+    EXPECT_EQ(status_err(ujson_consume(&uj, ',')), kOk);
+    EXPECT_EQ(status_err(ujson_parse_integer(&uj, &big, sizeof(big))), kOk);
+    EXPECT_EQ(big, 1234567890123);
+    EXPECT_EQ(status_err(ujson_consume(&uj, ',')), kOk);
+    EXPECT_EQ(status_err(ujson_parse_integer(&uj, &small, sizeof(small))),
+              kOk);
+    EXPECT_EQ(small, -42);
+    EXPECT_EQ(status_err(ujson_consume(&uj, '"')), kResourceExhausted);
+
+    // The rolling CRC covers the same characters as the unbuffered reads.
+    uint32_t crc = ujson_crc32_finish(&uj);
+    ss.Reset();
+    uj = ss.UJson();
+    while (status_ok(ujson_getc(&uj))) {
+    }
+    EXPECT_EQ(crc, ujson_crc32_finish(&uj));
+  }
+}
+
+TEST(UJson, ParseHex) {
+  for (bool buffered : {false, true}) {
+    SourceSink ss(R"json( "00a1B2ff" )json");
+    ujson_t uj = buffered ? ss.UJsonBuffered(3) : ss.UJson();
+    uint8_t buf[4] = {0};
+
+    status_t s = ujson_parse_hex(&uj, buf, sizeof(buf));
+    EXPECT_EQ(status_err(s), kOk);
+    EXPECT_EQ(s.value, 4);
+    EXPECT_EQ(buf[0], 0x00);
+    EXPECT_EQ(buf[1], 0xa1);
+    EXPECT_EQ(buf[2], 0xb2);
+    EXPECT_EQ(buf[3], 0xff);
+
+    // Excess bytes are dropped.
+    ss.Reset(R"json("0102030405")json");
+    s = ujson_parse_hex(&uj, buf, 2);
+    EXPECT_EQ(status_err(s), kOk);
+    EXPECT_EQ(s.value, 2);
+    EXPECT_EQ(buf[1], 0x02);
+    EXPECT_EQ(buf[2], 0xb2);
+
+    // Odd number of digits and invalid digits.
+    ss.Reset(R"json("012")json");
+    EXPECT_EQ(status_err(ujson_parse_hex(&uj, buf, sizeof(buf))), kOutOfRange);
+    ss.Reset(R"json("0g")json");
+    EXPECT_EQ(status_err(ujson_parse_hex(&uj, buf, sizeof(buf))), kOutOfRange);
+  }
+}
+
 TEST(UJson, SerializeString) {
   SourceSink ss;
   ujson uj = ss.UJson();
@@ -212,6 +278,36 @@ TEST(UJson, SerializeIntegers) {
   INT(int32_t, "-1", 0xFFFFFFFF);
   INT(int16_t, "-32768", 0x8000);
   INT(int8_t, "-2", 0xfe);
+
+  // Zero padding of the lower nine-digit groups of 64-bit values.
+  INT(uint64_t, "18446744073709551615", UINT64_MAX);
+  INT(uint64_t, "4294967296", 1UL << 32);
+  INT(uint64_t, "1000000000000000007", 1000000000000000007UL);
+  INT(uint64_t, "0", 0);
+  INT(uint32_t, "100", 100);
+  INT(uint32_t, "7", 7);
+}
+
+TEST(UJson, SerializeHex) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  std::vector<uint8_t> data(40);
+  std::string expected = "\"";
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7);
+    char pair[3];
+    snprintf(pair, sizeof(pair), "%02x", data[i]);
+    expected += pair;
+  }
+  expected += "\"";
+  EXPECT_TRUE(status_ok(ujson_serialize_hex(&uj, data.data(), data.size())));
+  EXPECT_EQ(ss.Sink(), expected);
+
+  ss.Reset(expected);
+  std::vector<uint8_t> parsed(data.size());
+  EXPECT_EQ(ujson_parse_hex(&uj, parsed.data(), parsed.size()).value,
+            static_cast<int32_t>(data.size()));
+  EXPECT_EQ(parsed, data);
 }
 
 TEST(UJson, SerializeStatus) {
@@ -248,4 +344,130 @@ TEST(UJson, DeerializeStatus) {
   EXPECT_EQ(arg, 77);
 }
 
+TEST(UJson, BlobRoundTrip) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  const std::string data("\x00\x01\xff\"binary\"\n", 12);
+
+  EXPECT_TRUE(status_ok(ujson_putblob(&uj, data.data(), data.size())));
+  std::string frame = ss.Sink();
+  ASSERT_EQ(frame.size(), data.size() + 12);
+  EXPECT_EQ(frame.substr(0, 4), "UJBF");
+  EXPECT_EQ(frame.substr(4, 4), std::string("\x0c\x00\x00\x00", 4));
+  EXPECT_EQ(frame.substr(8, data.size()), data);
+
+  ss.Reset(frame);
+  char buf[12];
+  EXPECT_TRUE(status_ok(ujson_getblob(&uj, buf, sizeof(buf))));
+  EXPECT_EQ(std::string(buf, sizeof(buf)), data);
+}
+
+TEST(UJson, BlobBuffered) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  std::string data(100, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i);
+  }
+  EXPECT_TRUE(status_ok(ujson_putblob(&uj, data.data(), data.size())));
+
+  // The start of the frame goes through the receive buffer, the rest is read
+  // straight into the destination.
+  std::string frame = ss.Sink();
+  ss.Reset(frame);
+  uj = ss.UJsonBuffered();
+  char buf[100];
+  EXPECT_TRUE(status_ok(ujson_getblob(&uj, buf, sizeof(buf))));
+  EXPECT_EQ(std::string(buf, sizeof(buf)), data);
+}
+
+TEST(UJson, BlobErrors) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  const char data[] = "abcd";
+  EXPECT_TRUE(status_ok(ujson_putblob(&uj, data, 4)));
+  std::string frame = ss.Sink();
+  char buf[4];
+
+  // Wrong length.
+  ss.Reset(frame);
+  EXPECT_EQ(status_err(ujson_getblob(&uj, buf, 3)), kOutOfRange);
+
+  // Corrupted data.
+  std::string corrupted = frame;
+  corrupted[9] ^= 1;
+  ss.Reset(corrupted);
+  EXPECT_EQ(status_err(ujson_getblob(&uj, buf, sizeof(buf))), kDataLoss);
+
+  // Not a frame.
+  ss.Reset(R"json({"Ok":0})json");
+  EXPECT_EQ(status_err(ujson_getblob(&uj, buf, sizeof(buf))), kNotFound);
+
+  // Truncated frame.
+  ss.Reset(frame.substr(0, 10));
+  EXPECT_EQ(status_err(ujson_getblob(&uj, buf, sizeof(buf))),
+            kResourceExhausted);
+}
+
+TEST(UJson, ChunkStream) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  const std::string data("0123456789abcdef\x00\xff", 18);
+
+  uint32_t crc;
+  crc32_init(&crc);
+  EXPECT_TRUE(status_ok(ujson_putchunk(&uj, data.data(), 10, &crc)));
+  EXPECT_TRUE(status_ok(ujson_putchunk(&uj, data.data() + 10, 8, &crc)));
+  std::string stream = ss.Sink();
+  ASSERT_EQ(stream.size(), data.size() + 16);
+  EXPECT_EQ(stream.substr(0, 4), std::string("\x0a\x00\x00\x00", 4));
+  EXPECT_EQ(stream.substr(4, 10), data.substr(0, 10));
+  // The last chunk carries the CRC32 of the whole stream.
+  uint32_t expected = crc32(data.data(), data.size());
+  EXPECT_EQ(stream.substr(stream.size() - 4),
+            std::string(reinterpret_cast<const char *>(&expected), 4));
+
+  ss.Reset(stream);
+  uj = ss.UJsonBuffered();
+  char buf[18];
+  crc32_init(&crc);
+  status_t s = ujson_getchunk(&uj, buf, sizeof(buf), &crc);
+  EXPECT_TRUE(status_ok(s));
+  EXPECT_EQ(s.value, 10);
+  s = ujson_getchunk(&uj, buf + 10, sizeof(buf) - 10, &crc);
+  EXPECT_TRUE(status_ok(s));
+  EXPECT_EQ(s.value, 8);
+  EXPECT_EQ(std::string(buf, sizeof(buf)), data);
+}
+
+TEST(UJson, ChunkErrors) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uint32_t crc;
+  crc32_init(&crc);
+  EXPECT_TRUE(status_ok(ujson_putchunk(&uj, "abcd", 4, &crc)));
+  EXPECT_TRUE(status_ok(ujson_putchunk(&uj, "efgh", 4, &crc)));
+  std::string stream = ss.Sink();
+  char buf[8];
+
+  // Chunk longer than the buffer.
+  ss.Reset(stream);
+  crc32_init(&crc);
+  EXPECT_EQ(status_err(ujson_getchunk(&uj, buf, 3, &crc)), kOutOfRange);
+
+  // Corrupted data.
+  std::string corrupted = stream;
+  corrupted[5] ^= 1;
+  ss.Reset(corrupted);
+  crc32_init(&crc);
+  EXPECT_EQ(status_err(ujson_getchunk(&uj, buf, sizeof(buf), &crc)),
+            kDataLoss);
+
+  // A chunk received out of order fails the running CRC32.
+  ss.Reset(stream.substr(12));
+  crc32_init(&crc);
+  EXPECT_EQ(status_err(ujson_getchunk(&uj, buf, sizeof(buf), &crc)),
+            kDataLoss);
+}
+
 }  // namespace
@@ -71,6 +71,12 @@ static dif_gpio_t gpio;
 static dif_pinmux_t pinmux;
 static dif_rv_timer_t timer;
 
+/**
+ * Set while `sca_call_and_sleep_batch()` runs to keep the timer counter
+ * running across timer interrupts.
+ */
+static volatile bool timer_free_running = false;
+
 #if !OT_IS_ENGLISH_BREAKFAST
 static dif_uart_t uart1;
 static dif_csrng_t csrng;
@@ -193,8 +199,16 @@ static void sca_init_edn(void) {
 void ottf_timer_isr(uint32_t *exc_info) {
   // Return values of below functions are ignored to improve capture
   // performance.
-  OT_DISCARD(dif_rv_timer_counter_set_enabled(&timer, kRvTimerHart,
-                                              kDifToggleDisabled));
+  if (timer_free_running) {
+    // Keep counting so that the next deadline of the batch stays a fixed
+    // number of cycles after the previous one. Move the comparator out of
+    // reach to clear the interrupt condition instead.
+    OT_DISCARD(dif_rv_timer_arm(&timer, kRvTimerHart, kRvTimerComparator,
+                                UINT64_MAX));
+  } else {
+    OT_DISCARD(dif_rv_timer_counter_set_enabled(&timer, kRvTimerHart,
+                                                kDifToggleDisabled));
+  }
   OT_DISCARD(dif_rv_timer_irq_acknowledge(
       &timer, kDifRvTimerIrqTimerExpiredHart0Timer0));
 }
@@ -346,6 +360,49 @@ void sca_call_and_sleep(sca_callee callee, uint32_t sleep_cycles,
       &clkmgr, CLKMGR_CLK_ENABLES_CLK_IO_DIV4_PERI_EN_BIT, kDifToggleEnabled));
 }
 
+void sca_call_and_sleep_batch(sca_batch_callee callee, size_t num_ops,
+                              uint32_t period_cycles, bool sw_trigger) {
+  dif_clkmgr_t clkmgr;
+  OT_DISCARD(dif_clkmgr_init(
+      mmio_region_from_addr(TOP_EARLGREY_CLKMGR_AON_BASE_ADDR), &clkmgr));
+
+  // Deadlines are absolute and the counter is never stopped in between, so
+  // the windows are exactly `period_cycles` apart regardless of how long the
+  // wake-up and the loop overhead take.
+  uint64_t deadline;
+  OT_DISCARD(dif_rv_timer_counter_read(&timer, kRvTimerHart, &deadline));
+  timer_free_running = true;
+  OT_DISCARD(dif_rv_timer_counter_set_enabled(&timer, kRvTimerHart,
+                                              kDifToggleEnabled));
+
+  for (size_t i = 0; i < num_ops; ++i) {
+    deadline += period_cycles;
+    OT_DISCARD(dif_rv_timer_arm(&timer, kRvTimerHart, kRvTimerComparator,
+                                deadline));
+
+    if (sw_trigger) {
+      sca_set_trigger_high();
+    }
+
+    callee(i);
+
+    if (sw_trigger) {
+      sca_set_trigger_low();
+    }
+
+    wait_for_interrupt();
+
+    // The trigger GPIO of the next window needs the IO_DIV4_PERI clock.
+    OT_DISCARD(dif_clkmgr_gateable_clock_set_enabled(
+        &clkmgr, CLKMGR_CLK_ENABLES_CLK_IO_DIV4_PERI_EN_BIT,
+        kDifToggleEnabled));
+  }
+
+  timer_free_running = false;
+  OT_DISCARD(dif_rv_timer_counter_set_enabled(&timer, kRvTimerHart,
+                                              kDifToggleDisabled));
+}
+
 static uint32_t sca_lfsr_state_masking = 0xdeadbeef;
 static uint32_t sca_lfsr_state_order = 0x99999999;
 
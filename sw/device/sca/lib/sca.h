@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_SCA_LIB_SCA_H_
 #define OPENTITAN_SW_DEVICE_SCA_LIB_SCA_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/dif/dif_uart.h"
@@ -201,6 +202,37 @@ typedef void (*sca_callee)(void);
 void sca_call_and_sleep(sca_callee callee, uint32_t sleep_cycles,
                         bool sw_trigger);
 
+/**
+ * Functions called by `sca_call_and_sleep_batch()` must conform to this
+ * prototype.
+ *
+ * The argument is the index of the operation within the batch and is meant to
+ * select stimulus that the caller prepared before starting the batch.
+ */
+typedef void (*sca_batch_callee)(size_t index);
+
+/**
+ * Runs a batch of operations with a fixed spacing between trigger windows.
+ *
+ * Like `sca_call_and_sleep()` but for `num_ops` back-to-back operations. The
+ * timer deadlines are computed from a single counter read and the counter
+ * keeps running for the whole batch, so operation `i` starts `i *
+ * period_cycles` cycles after the first one without accumulating jitter from
+ * per-operation setup. All stimulus (inputs, masks, LFSR outputs) should be
+ * generated before calling this function so that `callee` only has to load
+ * it.
+ *
+ * `period_cycles` must exceed the duration of `callee` plus the wake-up
+ * latency, otherwise Ibex sleeps until the counter wraps.
+ *
+ * @param callee Function to call for each operation.
+ * @param num_ops Number of operations in the batch.
+ * @param period_cycles Number of cycles between the start of two operations.
+ * @param sw_trigger Raise trigger before each call of the target function.
+ */
+void sca_call_and_sleep_batch(sca_batch_callee callee, size_t num_ops,
+                              uint32_t period_cycles, bool sw_trigger);
+
 /**
  * Seeds the software LFSR usable e.g. for key masking.
  *
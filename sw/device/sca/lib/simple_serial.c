@@ -5,6 +5,7 @@
 #include "sw/device/sca/lib/simple_serial.h"
 
 #include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/crc32.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/dif/dif_uart.h"
@@ -36,13 +37,15 @@ enum {
  *
  * Clients can register handlers for commands 'a'-'z' using
  * `simple_serial_register_handler()` except for 'v' (version), 's' (seed
- * PRNG), and 't' (select trigger type) which are handled by this library. This
+ * PRNG), 't' (select trigger type), and 'w' (wire format) which are handled by
+ * this library. This
  * array has an extra element (27) that is initialized in `simple_serial_init()`
  * to point to `simple_serial_unknown_command()` in order to simplify handling
  * of invalid commands in `simple_serial_process_packet()`.
  */
 static simple_serial_command_handler handlers[27];
 static const dif_uart_t *uart;
+static simple_serial_framing_t framing = kSimpleSerialFramingHex;
 
 static bool simple_serial_is_valid_command(uint8_t cmd) {
   return cmd >= 'a' && cmd <= 'z';
@@ -118,6 +121,64 @@ static void simple_serial_receive_packet(uint8_t *cmd, uint8_t *data,
   }
 }
 
+/**
+ * Receives `len` bytes over UART and adds them to a CRC32 computation.
+ *
+ * @param[out] buf Buffer for the received bytes.
+ * @param len Number of bytes to receive.
+ * @param[in,out] crc_ctx CRC32 context.
+ */
+static void simple_serial_receive_bytes(uint8_t *buf, size_t len,
+                                        uint32_t *crc_ctx) {
+  for (size_t i = 0; i < len; ++i) {
+    IGNORE_RESULT(dif_uart_byte_receive_polled(uart, &buf[i]));
+  }
+  crc32_add(crc_ctx, buf, len);
+}
+
+/**
+ * Receives a binary simple serial packet over UART.
+ *
+ * See `kSimpleSerialFramingBinary` for the packet format. Payloads longer
+ * than the buffer are received in full so that the next packet starts at the
+ * right place, but are reported as errors.
+ *
+ * @param[out] cmd Simple serial command.
+ * @param[out] data Buffer for received packet payload.
+ * @param data_buf_len Length of the packet payload buffer.
+ * @param[out] data_len Received packet payload length.
+ * @return Result of the operation.
+ */
+static simple_serial_result_t simple_serial_receive_binary_packet(
+    uint8_t *cmd, uint8_t *data, size_t data_buf_len, size_t *data_len) {
+  uint32_t crc_ctx;
+  crc32_init(&crc_ctx);
+  uint8_t header[3];
+  simple_serial_receive_bytes(header, sizeof(header), &crc_ctx);
+  *cmd = header[0];
+  *data_len = header[1] | (size_t)header[2] << 8;
+
+  simple_serial_result_t res = kSimpleSerialOk;
+  for (size_t i = 0; i < *data_len; ++i) {
+    uint8_t byte;
+    simple_serial_receive_bytes(&byte, 1, &crc_ctx);
+    if (i < data_buf_len) {
+      data[i] = byte;
+    } else {
+      res = kSimpleSerialError;
+    }
+  }
+
+  uint8_t crc[sizeof(uint32_t)];
+  for (size_t i = 0; i < sizeof(crc); ++i) {
+    IGNORE_RESULT(dif_uart_byte_receive_polled(uart, &crc[i]));
+  }
+  if (read_32(crc) != crc32_finish(&crc_ctx)) {
+    res = kSimpleSerialError;
+  }
+  return res;
+}
+
 /**
  * Returns the index of a command's handler in `handlers`.
  *
@@ -176,6 +237,24 @@ static void simple_serial_select_trigger_type(const uint8_t *trigger,
   sca_select_trigger_type((sca_trigger_type_t)trigger[0]);
 }
 
+/**
+ * Simple serial 'w' (wire format) command handler.
+ *
+ * Acknowledges the command in the current framing and then switches to the
+ * requested one. This function only supports 1-byte framing values.
+ *
+ * @param framing_ A buffer holding the framing, see `simple_serial_framing_t`.
+ * @param framing_len Buffer length.
+ */
+static void simple_serial_select_framing(const uint8_t *framing_,
+                                         size_t framing_len) {
+  SS_CHECK(framing_len == 1);
+  SS_CHECK(framing_[0] == kSimpleSerialFramingHex ||
+           framing_[0] == kSimpleSerialFramingBinary);
+  simple_serial_send_status(kSimpleSerialOk);
+  framing = (simple_serial_framing_t)framing_[0];
+}
+
 /**
  * Handler for uninmplemented simple serial commands.
  *
@@ -191,6 +270,7 @@ static void simple_serial_unknown_command(const uint8_t *data,
 
 void simple_serial_init(const dif_uart_t *uart_) {
   uart = uart_;
+  framing = kSimpleSerialFramingHex;
 
   for (size_t i = 0; i < ARRAYSIZE(handlers); ++i) {
     handlers[i] = simple_serial_unknown_command;
@@ -199,13 +279,15 @@ void simple_serial_init(const dif_uart_t *uart_) {
   handlers[simple_serial_get_handler_index('t')] =
       simple_serial_select_trigger_type;
   handlers[simple_serial_get_handler_index('v')] = simple_serial_version;
+  handlers[simple_serial_get_handler_index('w')] =
+      simple_serial_select_framing;
 }
 
 simple_serial_result_t simple_serial_register_handler(
     uint8_t cmd, simple_serial_command_handler handler) {
   if (!simple_serial_is_valid_command(cmd)) {
     return kSimpleSerialError;
-  } else if (cmd == 's' || cmd == 't' || cmd == 'v') {
+  } else if (cmd == 's' || cmd == 't' || cmd == 'v' || cmd == 'w') {
     // Cannot register handlers for built-in commands.
     return kSimpleSerialError;
   } else {
@@ -218,12 +300,48 @@ void simple_serial_process_packet(void) {
   uint8_t cmd;
   uint8_t data[kUartMaxRxPacketSize];
   size_t data_len;
-  simple_serial_receive_packet(&cmd, data, ARRAYSIZE(data), &data_len);
+  if (framing == kSimpleSerialFramingBinary) {
+    if (simple_serial_receive_binary_packet(&cmd, data, ARRAYSIZE(data),
+                                            &data_len) != kSimpleSerialOk) {
+      simple_serial_send_status(kSimpleSerialError);
+      return;
+    }
+  } else {
+    simple_serial_receive_packet(&cmd, data, ARRAYSIZE(data), &data_len);
+  }
   handlers[simple_serial_get_handler_index(cmd)](data, data_len);
 }
 
+/**
+ * Sends `len` bytes over UART and adds them to a CRC32 computation.
+ *
+ * @param buf Bytes to send.
+ * @param len Number of bytes to send.
+ * @param[in,out] crc_ctx CRC32 context.
+ */
+static void simple_serial_send_bytes(const uint8_t *buf, size_t len,
+                                     uint32_t *crc_ctx) {
+  for (size_t i = 0; i < len; ++i) {
+    IGNORE_RESULT(dif_uart_byte_send_polled(uart, buf[i]));
+  }
+  crc32_add(crc_ctx, buf, len);
+}
+
 void simple_serial_send_packet(const uint8_t cmd, const uint8_t *data,
                                size_t data_len) {
+  if (framing == kSimpleSerialFramingBinary) {
+    uint32_t crc_ctx;
+    crc32_init(&crc_ctx);
+    uint8_t header[3] = {cmd, data_len & 0xff, (data_len >> 8) & 0xff};
+    simple_serial_send_bytes(header, sizeof(header), &crc_ctx);
+    simple_serial_send_bytes(data, data_len, &crc_ctx);
+    uint32_t crc = crc32_finish(&crc_ctx);
+    for (size_t i = 0; i < sizeof(crc); ++i) {
+      IGNORE_RESULT(dif_uart_byte_send_polled(uart, (crc >> (8 * i)) & 0xff));
+    }
+    return;
+  }
+
   char buf;
   base_snprintf(&buf, 1, "%c", cmd);
   IGNORE_RESULT(dif_uart_byte_send_polled(uart, buf));
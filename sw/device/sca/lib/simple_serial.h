@@ -21,6 +21,9 @@
  * can implement additional command by registering their handlers using
  * `simple_serial_register_handler()`. See https://wiki.newae.com/SimpleSerial
  * for details on the protocol.
+ *
+ * The built-in 'w' (wire format) command switches to a binary framing that
+ * avoids hex encoding. See `simple_serial_framing_t`.
  */
 
 /**
@@ -66,6 +69,27 @@ typedef enum simple_serial_result {
   kSimpleSerialError = 1,
 } simple_serial_result_t;
 
+/**
+ * Simple serial packet framings.
+ *
+ * The host selects the framing with the 'w' command, whose 1-byte payload is
+ * one of these values. The device acknowledges the command with a status
+ * packet in the old framing and uses the new framing from then on, in both
+ * directions.
+ */
+typedef enum simple_serial_framing {
+  /**
+   * Command byte, hex encoded payload, '\n'.
+   */
+  kSimpleSerialFramingHex = 0,
+  /**
+   * Command byte, payload length (16 bits, little endian), raw payload and
+   * the CRC32 of all preceding bytes of the packet (32 bits, little endian).
+   * Packets with a bad CRC are answered with an error status.
+   */
+  kSimpleSerialFramingBinary = 1,
+} simple_serial_framing_t;
+
 /**
  * Command handlers must conform to this prototype.
  */
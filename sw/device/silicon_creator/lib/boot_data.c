@@ -315,11 +315,12 @@ typedef struct active_page_info {
  * Updates the given active page info struct and last valid boot data entry
  * using the given page.
  *
- * This function performs a forward search to find the first empty boot data
- * entry followed by a backward search to find the last valid boot data entry.
- * If the page has an entry that is newer than the one passed in, this function
- * updates `page_info` and `boot_data`. Reads must be enabled for the given page
- * before this function is called, see `boot_data_page_info_get()`.
+ * This function performs a binary search over the sniffed entries followed by a
+ * short forward search to find the first empty boot data entry, and then a
+ * backward search to find the last valid boot data entry. If the page has an
+ * entry that is newer than the one passed in, this function updates
+ * `page_info` and `boot_data`. Reads must be enabled for the given page before
+ * this function is called, see `boot_data_page_info_get()`.
  *
  * @param page A boot data page.
  * @param[in,out] page_info Active page info struct. Updated if the given page
@@ -332,19 +333,43 @@ OT_WARN_UNUSED_RESULT
 static rom_error_t boot_data_page_info_update_impl(
     const flash_ctrl_info_page_t *page, active_page_info_t *page_info,
     boot_data_t *boot_data) {
+  static_assert(kBootDataEntriesPerPage <= 32,
+                "`sniffed` must have a bit for each entry.");
   uint32_t sniff_results[kBootDataEntriesPerPage];
+  // Bit `i` is set once `sniff_results[i]` holds the sniff of entry `i`.
+  uint32_t sniffed = 0;
 
   boot_data_t buf;
 
+  // Entries are only appended to a page, so the entries that can be empty form
+  // a suffix of the page. Find where it starts using sniffs only. An entry
+  // whose write was interrupted can also look empty, but the first empty
+  // entry always follows such entries, so the forward search below finds it.
+  size_t lo = 0, hi = kBootDataEntriesPerPage;
+  while (launder32(lo) < hi) {
+    size_t mid = (lo + hi) / 2;
+    HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, mid, &sniff_results[mid]));
+    sniffed |= 1u << mid;
+    if (sniff_results[mid] == kFlashCtrlErasedWord) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  HARDENED_CHECK_EQ(lo, hi);
+
   // Perform a forward search to find the first empty entry.
   hardened_bool_t has_empty_entry = kHardenedBoolFalse;
-  size_t i = 0, r = kBootDataEntriesPerPage - 1;
+  size_t i = lo, r = kBootDataEntriesPerPage - 1 - lo;
   for (; launder32(i) < kBootDataEntriesPerPage &&
          launder32(r) < kBootDataEntriesPerPage;
        ++i, --r) {
     // Read and cache the identifier to quickly determine if an entry can be
     // empty or valid.
-    HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, i, &sniff_results[i]));
+    if (((sniffed >> i) & 1) == 0) {
+      HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, i, &sniff_results[i]));
+      sniffed |= 1u << i;
+    }
     // Check all words of this entry only if it can be empty.
     if (sniff_results[i] == kFlashCtrlErasedWord) {
       HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
@@ -367,6 +392,10 @@ static rom_error_t boot_data_page_info_update_impl(
   for (--i, ++r; launder32(i) < kBootDataEntriesPerPage &&
                  launder32(r) < kBootDataEntriesPerPage;
        --i, ++r) {
+    if (((sniffed >> i) & 1) == 0) {
+      HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, i, &sniff_results[i]));
+      sniffed |= 1u << i;
+    }
     // Check the digest only if this entry can be valid.
     if (sniff_results[i] == kBootDataIdentifier) {
       HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
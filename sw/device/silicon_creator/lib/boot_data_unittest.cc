@@ -264,35 +264,67 @@ class BootDataTest : public rom_test::RomTest {
     // #1. Non-erased and bootable provided boot_data.
     // #2. Non-erased and bootable but invalid digest.
     // #3. Entry with sniffed area erased but the rest not.
-    // #4. Fully erased entry.
+    // #4+. Fully erased entries.
     return [=](const flash_ctrl_info_page_t *page) {
-      // Expect to sniff each entry, fully reading if it could be erased.
-      ExpectSniff(page, 0, non_erased_entry_, kErrorOk);
-      ExpectSniff(page, 1, boot_data_raw, kErrorOk);
+      // Expect a binary search over sniffs: #8, #4, #2, #3.
+      ExpectSniff(page, 8, erased_entry_, kErrorOk);
+      ExpectSniff(page, 4, erased_entry_, kErrorOk);
       ExpectSniff(page, 2, boot_data_raw, kErrorOk);
       ExpectSniff(page, 3, part_erased_entry_, kErrorOk);
+
+      // Step forward over the partially erased entry to the empty one.
       ExpectRead(page, 3, part_erased_entry_, kErrorOk);
-      ExpectSniff(page, 4, erased_entry_, kErrorOk);
       ExpectRead(page, 4, erased_entry_, kErrorOk);
 
       // Check the last seen bootable entry's digest (mocked as invalid).
       ExpectRead(page, 2, boot_data_raw, kErrorOk);
       ExpectDigestCompute(boot_data, false);
 
-      // Step back to the previously seen bootable entry (provided `boot_data`).
+      // Step back to the previous bootable entry (provided `boot_data`).
+      ExpectSniff(page, 1, boot_data_raw, kErrorOk);
       ExpectRead(page, 1, boot_data_raw, kErrorOk);
       ExpectDigestCompute(boot_data, valid_digest);
+
+      // Without a valid entry, the search continues to the start of the page.
+      if (!valid_digest) {
+        ExpectSniff(page, 0, non_erased_entry_, kErrorOk);
+      }
     };
   }
 
   /**
-   * Provides a lambda function mocking a page with only an erased entry.
+   * Provides a lambda function mocking a page where every entry is written and
+   * the last one is the given bootable `boot_data`.
+   *
+   * @param boot_data Bootable boot data entry at the end of the page.
+   * @return Lambda function for use with `ExpectPageScan`.
+   */
+  auto FullPage(boot_data_t boot_data) {
+    std::array<uint32_t, kBootDataNumWords> boot_data_raw = {};
+    std::memcpy(boot_data_raw.data(), &boot_data, sizeof(boot_data_t));
+
+    return [=](const flash_ctrl_info_page_t *page) {
+      // The binary search only sniffs #8, #12, #14 and #15.
+      ExpectSniff(page, 8, non_erased_entry_, kErrorOk);
+      ExpectSniff(page, 12, non_erased_entry_, kErrorOk);
+      ExpectSniff(page, 14, non_erased_entry_, kErrorOk);
+      ExpectSniff(page, kBootDataEntriesPerPage - 1, boot_data_raw, kErrorOk);
+
+      ExpectRead(page, kBootDataEntriesPerPage - 1, boot_data_raw, kErrorOk);
+      ExpectDigestCompute(boot_data, true);
+    };
+  }
+
+  /**
+   * Provides a lambda function mocking a page with only erased entries.
    *
    * @return Lambda function for use with `ExpectPageScan`.
    */
   auto ErasedPage() {
     return [this](auto page) {
-      ExpectSniff(page, 0, erased_entry_, kErrorOk);
+      for (size_t i : {8, 4, 2, 1, 0}) {
+        ExpectSniff(page, i, erased_entry_, kErrorOk);
+      }
       ExpectRead(page, 0, erased_entry_, kErrorOk);
     };
   }
@@ -362,6 +394,15 @@ TEST_F(BootDataReadTest, ReadOneEntryTest) {
   EXPECT_EQ(boot_data, kValidEntry0);
 }
 
+TEST_F(BootDataReadTest, ReadFullPageTest) {
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, FullPage(kValidEntry0));
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+
+  boot_data_t boot_data;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry0);
+}
+
 TEST_F(BootDataReadTest, ReadOneValidTest) {
   // Expect both pages to be searched, but give only a valid entry for one.
   ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
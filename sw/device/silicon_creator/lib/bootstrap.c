@@ -112,6 +112,14 @@ static rom_error_t bootstrap_sector_erase(uint32_t addr) {
  * If `byte_count` is not a multiple of flash word size, it's rounded up to next
  * flash word and missing bytes in `data` are set to `0xff`.
  *
+ * Once `addr` has been validated, this function clears the WIP and WEL bits
+ * before programming the flash. Since `data` has already been copied out of
+ * the SPI device payload buffer, this lets the host transfer the next page
+ * while the current one is being programmed. The next PAGE_PROGRAM keeps WIP
+ * set until it is picked up, i.e. until this function has returned. A
+ * programming error aborts bootstrap, after which the host no longer sees WIP
+ * clear.
+ *
  * @param addr Address to write to, must be flash word aligned.
  * @param byte_count Number of bytes to write. Rounded up to next flash word if
  * not a multiple of flash word size. Missing bytes in `data` are set to `0xff`.
@@ -158,6 +166,7 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
   }
   size_t rem_word_count = byte_count / sizeof(uint32_t);
 
+  spi_device_flash_status_clear();
   flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
       .read = kMultiBitBool4False,
       .write = kMultiBitBool4True,
@@ -293,7 +302,10 @@ static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
     case kSpiDeviceOpcodePageProgram:
       error = bootstrap_page_program(cmd.address, cmd.payload_byte_count,
                                      cmd.payload);
-      break;
+      HARDENED_RETURN_IF_ERROR(error);
+      // `bootstrap_page_program()` already cleared the status register. It
+      // must not be cleared again since it may now belong to the next command.
+      return error;
     case kSpiDeviceOpcodeReset:
       // In a normal build, this function inlines to nothing.
       stack_utilization_print();
@@ -41,6 +41,10 @@ rom_error_t enter_bootstrap(void);
  * @private @pure
  * Handles access permissions and erases both data banks of the embedded flash.
  *
+ * Implementations may also verify parts of the flash that they can check while
+ * the rest is being erased. `bootstrap_erase_verify()` then only needs to cover
+ * the remainder.
+ *
  * NOTE: This abstract function must be implemented by dependent code.
  *
  * @return Result of the operation.
@@ -52,6 +56,9 @@ rom_error_t bootstrap_chip_erase(void);
  * @private @pure
  * Verify that all data banks have been erased.
  *
+ * Always called right after `bootstrap_chip_erase()`, so it may skip any
+ * region that `bootstrap_chip_erase()` has already verified.
+ *
  * This function also clears the WIP and WEN bits of the flash status register.
  *
  * NOTE: This abstract function must be implemented by dependent code.
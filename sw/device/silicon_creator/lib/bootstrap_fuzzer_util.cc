@@ -44,6 +44,7 @@ void AbstractBootstrapMockGroup::ConfigureMocks() {
   using ::testing::Return;
 
   ON_CALL(flash_ctrl_, DataErase(_, _)).WillByDefault(Return(kErrorOk));
+  ON_CALL(flash_ctrl_, DataEraseFinish()).WillByDefault(Return(kErrorOk));
   ON_CALL(flash_ctrl_, DataWrite(_, _, _)).WillByDefault(Return(kErrorOk));
   ON_CALL(flash_ctrl_, DataEraseVerify(_, _)).WillByDefault(Return(kErrorOk));
 
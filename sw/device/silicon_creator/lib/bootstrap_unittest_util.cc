@@ -74,13 +74,18 @@ void BootstrapTest::ExpectFlashCtrlAllDisable() {
 }
 
 void BootstrapTest::ExpectFlashCtrlChipErase(rom_error_t err0,
-                                             rom_error_t err1) {
+                                             rom_error_t err1,
+                                             rom_error_t verify0) {
   EXPECT_CALL(flash_ctrl_, BankErasePermsSet(kHardenedBoolTrue));
   EXPECT_CALL(flash_ctrl_, DataErase(0, kFlashCtrlEraseTypeBank))
       .WillOnce(Return(err0));
-  EXPECT_CALL(flash_ctrl_, DataErase(FLASH_CTRL_PARAM_BYTES_PER_BANK,
-                                     kFlashCtrlEraseTypeBank))
-      .WillOnce(Return(err1));
+  EXPECT_CALL(flash_ctrl_, DataEraseStart(FLASH_CTRL_PARAM_BYTES_PER_BANK,
+                                          kFlashCtrlEraseTypeBank));
+  if (err0 == kErrorOk) {
+    EXPECT_CALL(flash_ctrl_, DataEraseVerify(0, kFlashCtrlEraseTypeBank))
+        .WillOnce(Return(verify0));
+  }
+  EXPECT_CALL(flash_ctrl_, DataEraseFinish()).WillOnce(Return(err1));
   EXPECT_CALL(flash_ctrl_, BankErasePermsSet(kHardenedBoolFalse));
 }
 
@@ -100,10 +105,7 @@ void BootstrapTest::ExpectFlashCtrlSectorErase(rom_error_t err0,
   ExpectFlashCtrlAllDisable();
 }
 
-void BootstrapTest::ExpectFlashCtrlEraseVerify(rom_error_t err0,
-                                               rom_error_t err1) {
-  EXPECT_CALL(flash_ctrl_, DataEraseVerify(0, kFlashCtrlEraseTypeBank))
-      .WillOnce(Return(err0));
+void BootstrapTest::ExpectFlashCtrlEraseVerify(rom_error_t err1) {
   EXPECT_CALL(flash_ctrl_, DataEraseVerify(FLASH_CTRL_PARAM_BYTES_PER_BANK,
                                            kFlashCtrlEraseTypeBank))
       .WillOnce(Return(err1));
@@ -58,10 +58,15 @@ class BootstrapTest : public rom_test::RomTest {
   /**
    * Sets expectations for a chip erase.
    *
+   * The first bank is erase-verified while the second bank is being erased.
+   *
    * @param err0 Result of erase for the first bank.
    * @param err1 Result of erase for the second bank.
+   * @param verify0 Result of erase verification for the first bank. Only
+   * expected if `err0` is `kErrorOk`.
    */
-  void ExpectFlashCtrlChipErase(rom_error_t err0, rom_error_t err1);
+  void ExpectFlashCtrlChipErase(rom_error_t err0, rom_error_t err1,
+                                rom_error_t verify0 = kErrorOk);
 
   /**
    * Sets expectations for a sector erase.
@@ -76,10 +81,11 @@ class BootstrapTest : public rom_test::RomTest {
   /**
    * Sets expectations for a chip erase verification.
    *
-   * @param err0 Result of erase verification for the first bank.
+   * Only covers the second bank, see `ExpectFlashCtrlChipErase()`.
+   *
    * @param err1 Result of erase verification for the second bank.
    */
-  void ExpectFlashCtrlEraseVerify(rom_error_t err0, rom_error_t err1);
+  void ExpectFlashCtrlEraseVerify(rom_error_t err1);
 
   ::rom_test::MockAbsMmio mmio_;
   ::rom_test::MockFlashCtrl flash_ctrl_;
@@ -43,17 +43,45 @@ rom_error_t asn1_push_bytes(asn1_state_t *state, const uint8_t *bytes,
   return kErrorOk;
 }
 
+/**
+ * Returns the number of bytes of the minimal DER encoding of `length`, or 0 if
+ * the length is too large.
+ */
+static size_t asn1_len_size(size_t length) {
+  if (length <= 0x7f) {
+    // We only need one byte to hold the length.
+    return 1;
+  } else if (length <= 0xff) {
+    // One byte to specify the number of bytes and one to hold the length.
+    return 2;
+  } else if (length <= 0xffff) {
+    // One byte to specify the number of bytes and two to hold the length.
+    return 3;
+  }
+  return 0;
+}
+
 rom_error_t asn1_start_tag(asn1_state_t *state, asn1_tag_t *new_tag,
                            uint8_t id) {
+  return asn1_start_tag_sized(state, new_tag, id, 0);
+}
+
+rom_error_t asn1_start_tag_sized(asn1_state_t *state, asn1_tag_t *new_tag,
+                                 uint8_t id, size_t max_len) {
   new_tag->state = state;
   RETURN_IF_ERROR(asn1_push_byte(state, id));
   new_tag->len_offset = state->offset;
   // We do not yet known how many bytes we need to encode the length. For now
-  // reserve one byte which is the minimum. This is then fixed in
-  // asn1_finish_tag by moving the data if necessary.
-
-  RETURN_IF_ERROR(asn1_push_byte(state, 0));
-  new_tag->len_size = 1;
+  // reserve as many bytes as the largest expected length needs. This is then
+  // fixed in asn1_finish_tag by moving the data if necessary.
+  size_t len_size = asn1_len_size(max_len);
+  if (len_size == 0) {
+    return kErrorAsn1Internal;
+  }
+  for (size_t i = 0; i < len_size; ++i) {
+    RETURN_IF_ERROR(asn1_push_byte(state, 0));
+  }
+  new_tag->len_size = len_size;
   return kErrorOk;
 }
 
@@ -62,33 +90,25 @@ rom_error_t asn1_finish_tag(asn1_tag_t *tag) {
   if (tag->state == NULL) {
     return kErrorAsn1Internal;
   }
-  // Sanity check: asn1_start_tag should have output one byte.
-  if (tag->len_size != 1) {
+  // Sanity check: asn1_start_tag_sized should have output one to three
+  // bytes.
+  if (tag->len_size < 1 || tag->len_size > 3) {
     return kErrorAsn1Internal;
   }
   // Compute actually used length.
   size_t length = tag->state->offset - tag->len_offset - tag->len_size;
   // Compute the size of the minimal encoding.
-  size_t final_len_size;
-  if (length <= 0x7f) {
-    // We only need one byte to hold the length.
-    final_len_size = 1;
-  } else if (length <= 0xff) {
-    // We need two bytes to hold the length: we need to move the data before
-    // we can write the second byte.
-    final_len_size = 2;
-  } else if (length <= 0xffff) {
-    // We need three bytes to hold the length: we need to move the data before
-    // we can write the second and third bytes.
-    final_len_size = 3;
-  } else {
+  size_t final_len_size = asn1_len_size(length);
+  if (final_len_size == 0) {
     // Length too large.
     return kErrorAsn1Internal;
   }
-  // If the final length uses more bytes than we initially allocated, we
-  // need to shift all the tag data backwards.
-  if (tag->len_size != final_len_size) {
-    // Make sure that the data actually fits into the buffer.
+  uint8_t *src = tag->state->buffer + tag->len_offset + tag->len_size;
+  uint8_t *dst = tag->state->buffer + tag->len_offset + final_len_size;
+  if (final_len_size > tag->len_size) {
+    // The final length uses more bytes than we initially allocated, we need
+    // to shift all the tag data backwards. Make sure that the data actually
+    // fits into the buffer.
     size_t new_buffer_size =
         tag->state->offset + final_len_size - tag->len_size;
     if (new_buffer_size > tag->state->size) {
@@ -96,8 +116,13 @@ rom_error_t asn1_finish_tag(asn1_tag_t *tag) {
     }
     // Copy backwards.
     for (size_t i = 0; i < length; i++) {
-      tag->state->buffer[tag->len_offset + final_len_size + length - 1 - i] =
-          tag->state->buffer[tag->len_offset + tag->len_size + length - 1 - i];
+      dst[length - 1 - i] = src[length - 1 - i];
+    }
+  } else if (final_len_size < tag->len_size) {
+    // The final length uses fewer bytes than we initially allocated, we need
+    // to shift all the tag data forwards.
+    for (size_t i = 0; i < length; i++) {
+      dst[i] = src[i];
     }
   }
   // Write the length in the buffer.
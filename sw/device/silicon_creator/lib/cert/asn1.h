@@ -141,10 +141,30 @@ typedef enum asn1_tag_number {
 rom_error_t asn1_start_tag(asn1_state_t *state, asn1_tag_t *new_tag,
                            uint8_t id);
 
+/**
+ * Start an ASN1 tag whose content is expected to be at most `max_len` bytes.
+ *
+ * This reserves room for the length encoding of `max_len` so that
+ * asn1_finish_tag does not need to move the content when the actual length
+ * needs as many length bytes as `max_len`. Generated code knows an upper
+ * bound of the size of every tag, which avoids repeatedly moving the content
+ * of nested tags.
+ *
+ * @param state Pointer to the state initialized by asn1_start.
+ * @param[out] new_tag Pointer to a user-allocated tag to be initialized.
+ * @param id Identifier byte of the tag (see ASN1_CLASS_*, ASN1_FORM_* and
+ * ASN1_TAG_*).
+ * @param max_len Expected maximum size of the content of the tag, at most
+ * 0xffff.
+ * @return The result of the operation.
+ */
+rom_error_t asn1_start_tag_sized(asn1_state_t *state, asn1_tag_t *new_tag,
+                                 uint8_t id, size_t max_len);
+
 /**
  * Finish an ASN1 tag.
  *
- * If size hint provided to asn1_start_tag does not match the actual size
+ * If size hint provided to asn1_start_tag_sized does not match the actual size
  * of the data, this function will fix it up, potentially at the cost of moving
  * bytes within the buffer.
  *
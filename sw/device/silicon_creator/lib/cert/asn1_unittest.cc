@@ -436,5 +436,57 @@ TEST(Asn1, TagLengthEncoding) {
   EXPECT_EQ(buf, expected);
 }
 
+// Make sure that the tag encoding is correct regardless of the size hint.
+TEST(Asn1, TagLengthEncodingSized) {
+  asn1_state_t state;
+  std::vector<uint8_t> buf;
+  buf.resize(0xfffff);
+  std::vector<uint8_t> expected;
+
+#define ADD_BYTES_SIZED(max_len, fill, fill_size, ...)                      \
+  do {                                                                      \
+    std::vector<uint8_t> tmp(fill_size, fill);                              \
+    const uint8_t kData[] = {__VA_ARGS__};                                  \
+    expected.push_back(0x30); /* Identifier octet (universal, sequence). */ \
+    expected.insert(expected.end(), kData,                                  \
+                    kData + sizeof(kData)); /* Length encoding */           \
+    expected.insert(expected.end(), tmp.begin(), tmp.end());                \
+    asn1_tag_t tag;                                                         \
+    EXPECT_EQ(asn1_start_tag_sized(&state, &tag, kAsn1TagNumberSequence,    \
+                                   max_len),                                \
+              kErrorOk);                                                    \
+    EXPECT_EQ(asn1_push_bytes(&state, tmp.data(), tmp.size()), kErrorOk);   \
+    EXPECT_EQ(asn1_finish_tag(&tag), kErrorOk);                             \
+  } while (0)
+
+  EXPECT_EQ(asn1_start(&state, &buf[0], buf.size()), kErrorOk);
+  // Exact hints.
+  ADD_BYTES_SIZED(0x7f, 0xa5, 0x7f, 0x7f);
+  ADD_BYTES_SIZED(0x80, 0xb6, 0x80, 0x81, 0x80);
+  ADD_BYTES_SIZED(0x100, 0xd8, 0x100, 0x82, 0x01, 0x00);
+  // Hints that are too large.
+  ADD_BYTES_SIZED(0xffff, 0x00, 0, 0x00);
+  ADD_BYTES_SIZED(0x100, 0xc7, 0xff, 0x81, 0xff);
+  // Hints that are too small.
+  ADD_BYTES_SIZED(0, 0xb6, 0x80, 0x81, 0x80);
+  ADD_BYTES_SIZED(0x80, 0xe9, 0xffff, 0x82, 0xff, 0xff);
+  size_t out_size;
+  EXPECT_EQ(asn1_finish(&state, &out_size), kErrorOk);
+  EXPECT_EQ(out_size, expected.size());
+  buf.resize(out_size);
+  EXPECT_EQ(buf, expected);
+}
+
+// Make sure that hints larger than the library supports are rejected.
+TEST(Asn1, TagSizedTooLarge) {
+  asn1_state_t state;
+  uint8_t buf[8];
+  EXPECT_EQ(asn1_start(&state, buf, sizeof(buf)), kErrorOk);
+  asn1_tag_t tag;
+  EXPECT_EQ(
+      asn1_start_tag_sized(&state, &tag, kAsn1TagNumberSequence, 0x10000),
+      kErrorAsn1Internal);
+}
+
 }  // namespace
 }  // namespace asn1_unittest
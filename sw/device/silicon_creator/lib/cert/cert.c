@@ -32,17 +32,18 @@ rom_error_t cert_x509_asn1_get_size_in_bytes(
   return kErrorOk;
 }
 
-rom_error_t cert_x509_asn1_check_serial_number(const uint8_t *cert_page_buffer,
-                                               size_t offset,
-                                               uint8_t *expected_sn_bytes,
-                                               hardened_bool_t *matches,
-                                               uint32_t *out_cert_size) {
-  if (cert_page_buffer == NULL || expected_sn_bytes == NULL ||
-      matches == NULL || offset >= FLASH_CTRL_PARAM_BYTES_PER_PAGE) {
-    return kErrorCertInvalidArgument;
-  }
-  *matches = kHardenedBoolFalse;
-
+/**
+ * Extracts the serial number of the certificate at `offset` into
+ * `actual_serial_number`.
+ *
+ * @param cert_page_buffer Pointer to the buffer holding the certificate blob.
+ * @param offset Byte offset into the certificate buffer to start reading at.
+ * @param[out] out_cert_size The certificate size in bytes. Can be NULL.
+ * @return Whether a certificate with a serial number is present.
+ */
+static hardened_bool_t serial_number_extract(const uint8_t *cert_page_buffer,
+                                             size_t offset,
+                                             uint32_t *out_cert_size) {
   // Check if the cert is missing by checking if the ASN.1 header cannot be
   // decoded or the size is not large enough to include a serial number.
   uint32_t cert_size =
@@ -52,7 +53,7 @@ rom_error_t cert_x509_asn1_check_serial_number(const uint8_t *cert_page_buffer,
   }
   if (launder32(cert_size) < kCertX509Asn1FirstBytesWithSerialNumber) {
     HARDENED_CHECK_LT(cert_size, kCertX509Asn1FirstBytesWithSerialNumber);
-    return kErrorOk;
+    return kHardenedBoolFalse;
   }
 
   // Extract tag and length of serial number field.
@@ -94,6 +95,26 @@ rom_error_t cert_x509_asn1_check_serial_number(const uint8_t *cert_page_buffer,
   memcpy(&actual_serial_number[kCertX509Asn1SerialNumberSizeInBytes -
                                asn1_integer_length],
          &cert_page_buffer[sn_bytes_offset], asn1_integer_length);
+  return kHardenedBoolTrue;
+}
+
+rom_error_t cert_x509_asn1_check_serial_number(const uint8_t *cert_page_buffer,
+                                               size_t offset,
+                                               uint8_t *expected_sn_bytes,
+                                               hardened_bool_t *matches,
+                                               uint32_t *out_cert_size) {
+  if (cert_page_buffer == NULL || expected_sn_bytes == NULL ||
+      matches == NULL || offset >= FLASH_CTRL_PARAM_BYTES_PER_PAGE) {
+    return kErrorCertInvalidArgument;
+  }
+  *matches = kHardenedBoolFalse;
+
+  hardened_bool_t found =
+      serial_number_extract(cert_page_buffer, offset, out_cert_size);
+  if (launder32(found) != kHardenedBoolTrue) {
+    return kErrorOk;
+  }
+  HARDENED_CHECK_EQ(found, kHardenedBoolTrue);
 
   // Check the serial number in the certificate matches what was expected.
   *matches = kHardenedBoolFalse;
@@ -108,3 +129,35 @@ rom_error_t cert_x509_asn1_check_serial_number(const uint8_t *cert_page_buffer,
 
   return kErrorOk;
 }
+
+rom_error_t cert_x509_asn1_read_serial_number(const uint8_t *cert_page_buffer,
+                                              size_t offset, uint8_t *sn_bytes,
+                                              hardened_bool_t *found,
+                                              uint32_t *out_cert_size) {
+  if (cert_page_buffer == NULL || sn_bytes == NULL || found == NULL ||
+      offset >= FLASH_CTRL_PARAM_BYTES_PER_PAGE) {
+    return kErrorCertInvalidArgument;
+  }
+  *found = serial_number_extract(cert_page_buffer, offset, out_cert_size);
+  if (launder32(*found) == kHardenedBoolTrue) {
+    memcpy(sn_bytes, actual_serial_number,
+           kCertX509Asn1SerialNumberSizeInBytes);
+  }
+  return kErrorOk;
+}
+
+hardened_bool_t cert_x509_asn1_find_value(const uint8_t *cert,
+                                          size_t cert_size, uint8_t tag,
+                                          const uint8_t *bytes, size_t len) {
+  // Only short-form lengths are supported.
+  if (len > 0x7f || cert_size < len + 2) {
+    return kHardenedBoolFalse;
+  }
+  for (size_t i = 0; i <= cert_size - len - 2; ++i) {
+    if (cert[i] == tag && cert[i + 1] == len &&
+        memcmp(&cert[i + 2], bytes, len) == 0) {
+      return kHardenedBoolTrue;
+    }
+  }
+  return kHardenedBoolFalse;
+}
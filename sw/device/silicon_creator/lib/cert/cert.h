@@ -41,6 +41,12 @@ enum {
   kCertX509Asn1FirstBytesWithSerialNumber =
       kCertX509Asn1SerialNumberFieldByteOffset +
       kCertX509Asn1SerialNumberSizeInBytes + 3,
+
+  /**
+   * Identifier byte of the keyIdentifier field of the authority key
+   * identifier extension ([0] IMPLICIT OCTET STRING).
+   */
+  kCertX509Asn1AuthorityKeyIdTag = 0x80,
 };
 
 /**
@@ -109,6 +115,44 @@ rom_error_t cert_x509_asn1_check_serial_number(const uint8_t *cert_page_buffer,
                                                hardened_bool_t *matches,
                                                uint32_t *out_cert_size);
 
+/**
+ * Extracts the serial number field from an ASN.1 DER encoded X.509
+ * certificate.
+ *
+ * @param cert_page_buffer Pointer to the buffer holding the certificate blob.
+ * @param offset Byte offset into the certificate buffer to start reading at.
+ * @param[out] sn_bytes Serial number bytes (in big endian order, 20 bytes).
+ * @param[out] found True if a certificate with a serial number was found.
+ * @param[out] out_cert_size The certificate size in bytes. Can be NULL if
+ *                           caller does not want it returned.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t cert_x509_asn1_read_serial_number(const uint8_t *cert_page_buffer,
+                                              size_t offset, uint8_t *sn_bytes,
+                                              hardened_bool_t *found,
+                                              uint32_t *out_cert_size);
+
+/**
+ * Searches an ASN.1 DER encoded certificate for a primitive value with the
+ * given tag holding `bytes`.
+ *
+ * This is a byte-level search that does not parse the certificate. It is meant
+ * for values such as digests and key IDs that are unlikely to appear by
+ * accident.
+ *
+ * @param cert Pointer to the certificate.
+ * @param cert_size Size of the certificate in bytes.
+ * @param tag Identifier byte of the value.
+ * @param bytes The expected content of the value.
+ * @param len Length of `bytes`, at most 127.
+ * @return Whether the value was found.
+ */
+OT_WARN_UNUSED_RESULT
+hardened_bool_t cert_x509_asn1_find_value(const uint8_t *cert,
+                                          size_t cert_size, uint8_t tag,
+                                          const uint8_t *bytes, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,7 @@
 
 #include "gtest/gtest.h"
 #include "sw/device/lib/base/hardened.h"
+#include "sw/device/silicon_creator/lib/cert/asn1.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/testing/rom_test.h"
 
@@ -196,5 +197,56 @@ TEST_F(CertTest, CertValidFullSerialNumberThenShortSerialNumber) {
       old_length;
 }
 
+TEST_F(CertTest, ReadSerialNumber) {
+  hardened_bool_t found = kHardenedBoolFalse;
+  uint32_t cert_size = 0;
+  uint8_t sn_bytes[kCertX509Asn1SerialNumberSizeInBytes] = {0};
+  EXPECT_EQ(cert_x509_asn1_read_serial_number(valid_dice_cert_bytes_, 0,
+                                              sn_bytes, &found, &cert_size),
+            kErrorOk);
+  EXPECT_EQ(found, kHardenedBoolTrue);
+  EXPECT_EQ(cert_size, expected_cert_size_);
+  EXPECT_EQ(memcmp(sn_bytes, expected_sn_bytes_, sizeof(sn_bytes)), 0);
+}
+
+TEST_F(CertTest, ReadSerialNumberUnprovisioned) {
+  hardened_bool_t found = kHardenedBoolTrue;
+  uint32_t unprovisioned_cert_bytes = UINT32_MAX;
+  uint8_t sn_bytes[kCertX509Asn1SerialNumberSizeInBytes] = {0};
+  EXPECT_EQ(cert_x509_asn1_read_serial_number(
+                (uint8_t *)&unprovisioned_cert_bytes, 0, sn_bytes, &found,
+                nullptr),
+            kErrorOk);
+  EXPECT_EQ(found, kHardenedBoolFalse);
+
+  EXPECT_EQ(cert_x509_asn1_read_serial_number(nullptr, 0, sn_bytes, &found,
+                                              nullptr),
+            kErrorCertInvalidArgument);
+}
+
+TEST_F(CertTest, FindValue) {
+  // The subject key identifier holds the key ID that is also the serial
+  // number.
+  EXPECT_EQ(cert_x509_asn1_find_value(
+                valid_dice_cert_bytes_, expected_cert_size_,
+                kAsn1TagNumberOctetString, expected_sn_bytes_,
+                sizeof(expected_sn_bytes_)),
+            kHardenedBoolTrue);
+  // The serial number itself is an INTEGER, not an OCTET STRING.
+  EXPECT_EQ(cert_x509_asn1_find_value(
+                valid_dice_cert_bytes_, expected_cert_size_,
+                kAsn1TagNumberBitString, expected_sn_bytes_,
+                sizeof(expected_sn_bytes_)),
+            kHardenedBoolFalse);
+
+  uint8_t other_bytes[kCertX509Asn1SerialNumberSizeInBytes];
+  memcpy(other_bytes, expected_sn_bytes_, sizeof(other_bytes));
+  other_bytes[sizeof(other_bytes) - 1] ^= 1;
+  EXPECT_EQ(cert_x509_asn1_find_value(
+                valid_dice_cert_bytes_, expected_cert_size_,
+                kAsn1TagNumberOctetString, other_bytes, sizeof(other_bytes)),
+            kHardenedBoolFalse);
+}
+
 }  // namespace
 }  // namespace cert_unittest
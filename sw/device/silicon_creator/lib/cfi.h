@@ -6,6 +6,7 @@
 #define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CFI_H_
 
 #include "sw/device/lib/base/hardened.h"
+#include "sw/device/silicon_creator/lib/stack_utilization.h"
 
 /**
  * @brief Control Flow Integrity (CFI).
@@ -143,6 +144,7 @@ enum {
     HARDENED_CHECK_EQ(table[index], CFI_STEP_TO_COUNT(index, step)); \
     table[index] += kCfiIncrement;                                   \
     barrier32(table[index]);                                         \
+    stack_utilization_mark(((uint32_t)(index) << 8) | (step));       \
   } while (0)
 
 /**
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include "sw/device/lib/base/arena.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/testing/json/provisioning_data.h"
 #include "sw/device/lib/testing/test_framework/check.h"
@@ -24,40 +25,25 @@
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/otbn_boot_services.h"
 
-#include "otp_ctrl_regs.h"  // Generated.
-
 enum {
   /**
-   * Size of the largest OTP partition to be measured.
+   * Size of the scratch arena for TBS certificates, in words.
+   *
+   * Only one certificate is built at a time, so the CDI_0 and CDI_1 TBS
+   * certificates share the arena.
    */
-  kDiceMeasuredOtpPartitionMaxSizeIn32bitWords =
-      (OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE -
-       OTP_CTRL_PARAM_OWNER_SW_CFG_DIGEST_SIZE) /
+  kDiceTbsArenaWords =
+      ((kCdi0MaxTbsSizeBytes > kCdi1MaxTbsSizeBytes ? kCdi0MaxTbsSizeBytes
+                                                    : kCdi1MaxTbsSizeBytes) +
+       sizeof(uint32_t) - 1) /
       sizeof(uint32_t),
 };
 
-static uint32_t otp_state[kDiceMeasuredOtpPartitionMaxSizeIn32bitWords] = {0};
 static ecdsa_p256_signature_t curr_tbs_signature = {.r = {0}, .s = {0}};
-static uint8_t cdi_0_tbs_buffer[kCdi0MaxTbsSizeBytes];
-static cdi_0_sig_values_t cdi_0_cert_params = {
-    .tbs = cdi_0_tbs_buffer,
-    .tbs_size = kCdi0MaxTbsSizeBytes,
-};
-static uint8_t cdi_1_tbs_buffer[kCdi1MaxTbsSizeBytes];
-static cdi_1_sig_values_t cdi_1_cert_params = {
-    .tbs = cdi_1_tbs_buffer,
-    .tbs_size = kCdi1MaxTbsSizeBytes,
-};
-
-// clang-format off
-static_assert(
-    OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE > OTP_CTRL_PARAM_CREATOR_SW_CFG_SIZE &&
-    OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE > OTP_CTRL_PARAM_ROT_CREATOR_AUTH_CODESIGN_SIZE &&
-    OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE > OTP_CTRL_PARAM_ROT_CREATOR_AUTH_STATE_SIZE,
-    "The largest DICE measured OTP partition is no longer the "
-    "OwnerSwCfg partition. Update the "
-    "kDiceMeasuredOtpPartitionMaxSizeIn32bitWords constant.");
-// clang-format on
+static uint32_t tbs_arena_buf[kDiceTbsArenaWords];
+static arena_t tbs_arena = ARENA_INIT(tbs_arena_buf, kHardenedBoolFalse);
+static cdi_0_sig_values_t cdi_0_cert_params;
+static cdi_1_sig_values_t cdi_1_cert_params;
 
 static_assert(kDiceMeasurementSizeInBytes == 32,
               "The DICE attestation measurement size should equal the size of "
@@ -96,61 +82,62 @@ static void curr_pubkey_le_to_be_convert(ecdsa_p256_public_key_t *pubkey) {
   le_be_buf_format((unsigned char *)pubkey->y, kEcdsaP256PublicKeyCoordBytes);
 }
 
-rom_error_t dice_attestation_keygen(dice_key_t desired_key,
-                                    hmac_digest_t *pubkey_id,
-                                    ecdsa_p256_public_key_t *pubkey) {
-  otbn_boot_attestation_key_type_t key_type;
-  attestation_key_seed_t otbn_ecc_keygen_seed;
-  const sc_keymgr_diversification_t *keymgr_diversifier;
-  sc_keymgr_state_t desired_keymgr_state;
-
+/**
+ * Looks up the key manager stage and OTBN key generation arguments of a DICE
+ * attestation key.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t dice_key_params_get(
+    dice_key_t desired_key, sc_keymgr_state_t *keymgr_state,
+    otbn_boot_attestation_keygen_req_t *req) {
   switch (desired_key) {
     case kDiceKeyUds:
-      desired_keymgr_state = kScKeymgrStateCreatorRootKey;
-      key_type = kOtbnBootAttestationKeyTypeDice;
-      keymgr_diversifier = &kUdsKeymgrDiversifier;
-      otbn_ecc_keygen_seed = kUdsAttestationKeySeed;
+      *keymgr_state = kScKeymgrStateCreatorRootKey;
+      req->key_type = kOtbnBootAttestationKeyTypeDice;
+      req->diversification = kUdsKeymgrDiversifier;
+      req->additional_seed = kUdsAttestationKeySeed;
       break;
     case kDiceKeyCdi0:
-      desired_keymgr_state = kScKeymgrStateOwnerIntermediateKey;
-      key_type = kOtbnBootAttestationKeyTypeDice;
-      keymgr_diversifier = &kCdi0KeymgrDiversifier;
-      otbn_ecc_keygen_seed = kCdi0AttestationKeySeed;
+      *keymgr_state = kScKeymgrStateOwnerIntermediateKey;
+      req->key_type = kOtbnBootAttestationKeyTypeDice;
+      req->diversification = kCdi0KeymgrDiversifier;
+      req->additional_seed = kCdi0AttestationKeySeed;
       break;
     case kDiceKeyCdi1:
-      desired_keymgr_state = kScKeymgrStateOwnerKey;
-      key_type = kOtbnBootAttestationKeyTypeDice;
-      keymgr_diversifier = &kCdi1KeymgrDiversifier;
-      otbn_ecc_keygen_seed = kCdi1AttestationKeySeed;
+      *keymgr_state = kScKeymgrStateOwnerKey;
+      req->key_type = kOtbnBootAttestationKeyTypeDice;
+      req->diversification = kCdi1KeymgrDiversifier;
+      req->additional_seed = kCdi1AttestationKeySeed;
       break;
     case kDiceKeyTpmEk:
-      desired_keymgr_state = kScKeymgrStateOwnerKey;
-      key_type = kOtbnBootAttestationKeyTypeTpm;
-      keymgr_diversifier = &kTpmEkKeymgrDiversifier;
-      otbn_ecc_keygen_seed = kTpmEkAttestationKeySeed;
+      *keymgr_state = kScKeymgrStateOwnerKey;
+      req->key_type = kOtbnBootAttestationKeyTypeTpm;
+      req->diversification = kTpmEkKeymgrDiversifier;
+      req->additional_seed = kTpmEkAttestationKeySeed;
       break;
     case kDiceKeyTpmCek:
-      desired_keymgr_state = kScKeymgrStateOwnerKey;
-      key_type = kOtbnBootAttestationKeyTypeTpm;
-      keymgr_diversifier = &kTpmCekKeymgrDiversifier;
-      otbn_ecc_keygen_seed = kTpmCekAttestationKeySeed;
+      *keymgr_state = kScKeymgrStateOwnerKey;
+      req->key_type = kOtbnBootAttestationKeyTypeTpm;
+      req->diversification = kTpmCekKeymgrDiversifier;
+      req->additional_seed = kTpmCekAttestationKeySeed;
       break;
     case kDiceKeyTpmCik:
-      desired_keymgr_state = kScKeymgrStateOwnerKey;
-      key_type = kOtbnBootAttestationKeyTypeTpm;
-      keymgr_diversifier = &kTpmCikKeymgrDiversifier;
-      otbn_ecc_keygen_seed = kTpmCikAttestationKeySeed;
+      *keymgr_state = kScKeymgrStateOwnerKey;
+      req->key_type = kOtbnBootAttestationKeyTypeTpm;
+      req->diversification = kTpmCikKeymgrDiversifier;
+      req->additional_seed = kTpmCikAttestationKeySeed;
       break;
     default:
       return kErrorDiceInvalidKeyType;
   };
+  return kErrorOk;
+}
 
-  HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(desired_keymgr_state));
-
-  // Generate / sideload key material into OTBN, and generate the ECC keypair.
-  HARDENED_RETURN_IF_ERROR(otbn_boot_attestation_keygen(
-      otbn_ecc_keygen_seed, key_type, *keymgr_diversifier, pubkey));
-
+/**
+ * Converts a freshly generated public key to big endian and computes its ID.
+ */
+static void dice_pubkey_finalize(hmac_digest_t *pubkey_id,
+                                 ecdsa_p256_public_key_t *pubkey) {
   // Keys are represented in certificates in big endian format, but the key is
   // output from OTBN in little endian format, so we convert the key to
   // big endian format.
@@ -163,6 +150,57 @@ rom_error_t dice_attestation_keygen(dice_key_t desired_key,
   // re-format it.
   hmac_sha256(pubkey, kEcdsaP256PublicKeyCoordBytes * 2, pubkey_id);
   le_be_buf_format((unsigned char *)pubkey_id, kHmacDigestNumBytes);
+}
+
+rom_error_t dice_attestation_keygen(dice_key_t desired_key,
+                                    hmac_digest_t *pubkey_id,
+                                    ecdsa_p256_public_key_t *pubkey) {
+  sc_keymgr_state_t desired_keymgr_state;
+  otbn_boot_attestation_keygen_req_t req;
+  HARDENED_RETURN_IF_ERROR(
+      dice_key_params_get(desired_key, &desired_keymgr_state, &req));
+
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(desired_keymgr_state));
+
+  // Generate / sideload key material into OTBN, and generate the ECC keypair.
+  HARDENED_RETURN_IF_ERROR(otbn_boot_attestation_keygen(
+      req.additional_seed, req.key_type, req.diversification, pubkey));
+
+  dice_pubkey_finalize(pubkey_id, pubkey);
+
+  return kErrorOk;
+}
+
+rom_error_t dice_attestation_keygen_batch(const dice_key_t *desired_keys,
+                                          size_t num_keys,
+                                          hmac_digest_t *pubkey_ids,
+                                          ecdsa_p256_public_key_t *pubkeys) {
+  if (num_keys == 0 || num_keys > kDiceAttestationKeygenBatchMaxKeys) {
+    return kErrorDiceInvalidArgument;
+  }
+
+  // All keys must come from the same key manager stage.
+  sc_keymgr_state_t desired_keymgr_state;
+  otbn_boot_attestation_keygen_req_t reqs[kDiceAttestationKeygenBatchMaxKeys];
+  HARDENED_RETURN_IF_ERROR(
+      dice_key_params_get(desired_keys[0], &desired_keymgr_state, &reqs[0]));
+  for (size_t i = 1; i < num_keys; ++i) {
+    sc_keymgr_state_t keymgr_state;
+    HARDENED_RETURN_IF_ERROR(
+        dice_key_params_get(desired_keys[i], &keymgr_state, &reqs[i]));
+    if (keymgr_state != desired_keymgr_state) {
+      return kErrorDiceInvalidArgument;
+    }
+  }
+
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(desired_keymgr_state));
+
+  HARDENED_RETURN_IF_ERROR(
+      otbn_boot_attestation_keygen_batch(reqs, num_keys, pubkeys));
+
+  for (size_t i = 0; i < num_keys; ++i) {
+    dice_pubkey_finalize(&pubkey_ids[i], &pubkeys[i]);
+  }
 
   return kErrorOk;
 }
@@ -182,10 +220,16 @@ static void curr_tbs_signature_le_to_be_convert(ecdsa_p256_signature_t *sig) {
  */
 static void measure_otp_partition(otp_partition_t partition,
                                   hmac_digest_t *measurement) {
-  // Compute the digest.
-  otp_dai_read(partition, /*address=*/0, otp_state,
-               kOtpPartitions[partition].size / sizeof(uint32_t));
-  hmac_sha256(otp_state, kOtpPartitions[partition].size, measurement);
+  // Compute the digest. Each word is fed to the HMAC FIFO as soon as it is
+  // read so that the partition does not need to be buffered in RAM.
+  hmac_sha256_init();
+  size_t num_words = kOtpPartitions[partition].size / sizeof(uint32_t);
+  uint32_t addr = 0;
+  for (size_t i = 0; i < num_words; ++i, addr += sizeof(uint32_t)) {
+    uint32_t word = otp_dai_read32(partition, addr);
+    hmac_sha256_update_words(&word, 1);
+  }
+  hmac_sha256_final(measurement);
 
   // Check the digest matches what is stored in OTP.
   // TODO(#21554): remove this conditional once the root keys and key policies
@@ -268,6 +312,10 @@ rom_error_t dice_cdi_0_cert_build(hmac_digest_t *rom_ext_measurement,
       .owner_intermediate_pub_key_ec_y = (unsigned char *)cdi_0_pubkey->y,
       .owner_intermediate_pub_key_ec_y_size = kEcdsaP256PublicKeyCoordBytes,
   };
+  // The TBS certificate is public, so the arena is not wiped.
+  arena_reset(&tbs_arena);
+  cdi_0_cert_params.tbs = arena_alloc(&tbs_arena, kCdi0MaxTbsSizeBytes);
+  cdi_0_cert_params.tbs_size = kCdi0MaxTbsSizeBytes;
   HARDENED_RETURN_IF_ERROR(cdi_0_build_tbs(&cdi_0_cert_tbs_params,
                                            cdi_0_cert_params.tbs,
                                            &cdi_0_cert_params.tbs_size));
@@ -275,8 +323,11 @@ rom_error_t dice_cdi_0_cert_build(hmac_digest_t *rom_ext_measurement,
   // Sign the TBS and generate the certificate.
   hmac_digest_t tbs_digest;
   hmac_sha256(cdi_0_cert_params.tbs, cdi_0_cert_params.tbs_size, &tbs_digest);
-  HARDENED_RETURN_IF_ERROR(
-      otbn_boot_attestation_endorse(&tbs_digest, &curr_tbs_signature));
+  // The same OTBN run saves the CDI_0 private key so it can endorse the next
+  // stage.
+  HARDENED_RETURN_IF_ERROR(otbn_boot_attestation_endorse_and_key_save(
+      &tbs_digest, kCdi0AttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
+      kCdi0KeymgrDiversifier, &curr_tbs_signature));
   curr_tbs_signature_le_to_be_convert(&curr_tbs_signature);
   cdi_0_cert_params.cert_signature_r = (unsigned char *)curr_tbs_signature.r;
   cdi_0_cert_params.cert_signature_r_size = kAttestationSignatureBytes / 2;
@@ -285,11 +336,6 @@ rom_error_t dice_cdi_0_cert_build(hmac_digest_t *rom_ext_measurement,
   HARDENED_RETURN_IF_ERROR(
       cdi_0_build_cert(&cdi_0_cert_params, cert, cert_size));
 
-  // Save the CDI_0 private key to OTBN DMEM so it can endorse the next stage.
-  HARDENED_RETURN_IF_ERROR(otbn_boot_attestation_key_save(
-      kCdi0AttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
-      kCdi0KeymgrDiversifier));
-
   return kErrorOk;
 }
 
@@ -317,6 +363,9 @@ rom_error_t dice_cdi_1_cert_build(hmac_digest_t *owner_measurement,
       .owner_pub_key_ec_y = (unsigned char *)cdi_1_pubkey->y,
       .owner_pub_key_ec_y_size = kEcdsaP256PublicKeyCoordBytes,
   };
+  arena_reset(&tbs_arena);
+  cdi_1_cert_params.tbs = arena_alloc(&tbs_arena, kCdi1MaxTbsSizeBytes);
+  cdi_1_cert_params.tbs_size = kCdi1MaxTbsSizeBytes;
   HARDENED_RETURN_IF_ERROR(cdi_1_build_tbs(&cdi_1_cert_tbs_params,
                                            cdi_1_cert_params.tbs,
                                            &cdi_1_cert_params.tbs_size));
@@ -324,8 +373,11 @@ rom_error_t dice_cdi_1_cert_build(hmac_digest_t *owner_measurement,
   // Sign the TBS and generate the certificate.
   hmac_digest_t tbs_digest;
   hmac_sha256(cdi_1_cert_params.tbs, cdi_1_cert_params.tbs_size, &tbs_digest);
-  HARDENED_RETURN_IF_ERROR(
-      otbn_boot_attestation_endorse(&tbs_digest, &curr_tbs_signature));
+  // The same OTBN run saves the CDI_1 private key so it can endorse the next
+  // stage.
+  HARDENED_RETURN_IF_ERROR(otbn_boot_attestation_endorse_and_key_save(
+      &tbs_digest, kCdi1AttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
+      kCdi1KeymgrDiversifier, &curr_tbs_signature));
   curr_tbs_signature_le_to_be_convert(&curr_tbs_signature);
   cdi_1_cert_params.cert_signature_r = (unsigned char *)curr_tbs_signature.r;
   cdi_1_cert_params.cert_signature_r_size = kAttestationSignatureBytes / 2;
@@ -334,11 +386,6 @@ rom_error_t dice_cdi_1_cert_build(hmac_digest_t *owner_measurement,
   HARDENED_RETURN_IF_ERROR(
       cdi_1_build_cert(&cdi_1_cert_params, cert, cert_size));
 
-  // Save the CDI_1 private key to OTBN DMEM so it can endorse the next stage.
-  HARDENED_RETURN_IF_ERROR(otbn_boot_attestation_key_save(
-      kCdi1AttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
-      kCdi1KeymgrDiversifier));
-
   return kErrorOk;
 }
 
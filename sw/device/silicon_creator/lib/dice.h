@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_DICE_H_
 #define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_DICE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/testing/json/provisioning_data.h"
@@ -86,6 +87,34 @@ rom_error_t dice_attestation_keygen(dice_key_t desired_key,
                                     hmac_digest_t *pubkey_id,
                                     ecdsa_p256_public_key_t *pubkey);
 
+enum {
+  /**
+   * Maximum number of keys in a `dice_attestation_keygen_batch()` call.
+   */
+  kDiceAttestationKeygenBatchMaxKeys = 4,
+};
+
+/**
+ * Generates several attestation ECC P256 keypairs of the same key manager
+ * stage, returning their public keys and key IDs.
+ *
+ * Same as calling `dice_attestation_keygen()` for each key, but reads all OTBN
+ * keygen seeds from flash in one go.
+ *
+ * Preconditions: keymgr has been initialized and cranked to the stage of all
+ * the desired keys.
+ *
+ * @param desired_keys The desired attestation keys to generate.
+ * @param num_keys Number of keys, at most `kDiceAttestationKeygenBatchMaxKeys`.
+ * @param[out] pubkey_ids The public key IDs, one per key.
+ * @param[out] pubkeys The public keys, one per key.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t dice_attestation_keygen_batch(const dice_key_t *desired_keys,
+                                          size_t num_keys,
+                                          hmac_digest_t *pubkey_ids,
+                                          ecdsa_p256_public_key_t *pubkeys);
+
 /**
  * Generates the UDS attestation keypair and (unendorsed) X.509 TBS certificate.
  *
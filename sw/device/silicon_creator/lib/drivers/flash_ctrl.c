@@ -13,6 +13,7 @@
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/multibits.h"
 #include "sw/device/silicon_creator/lib/base/sec_mmio.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/drivers/otp.h"
 #include "sw/device/silicon_creator/lib/error.h"
 
@@ -220,6 +221,67 @@ static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
   return kErrorOk;
 }
 
+/**
+ * Reads data from the given partition and feeds it to the SHA2-256 function.
+ *
+ * Reads are split into transactions of one read FIFO worth of words. As soon
+ * as a transaction has been drained into `buf`, the next one is started so
+ * that the controller refills the read FIFO while `buf` is being pushed to
+ * HMAC. The read FIFO and `buf` thus act as a double buffer.
+ *
+ * The caller is responsible for initializing and finalizing the HMAC
+ * operation.
+ *
+ * @param addr Full byte address to read from.
+ * @param partition The partition to read from.
+ * @param word_count Number of bus words to read.
+ * @param error Error code to return in case of a flash controller error.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t read_hash(uint32_t addr, flash_ctrl_partition_t partition,
+                             uint32_t word_count, rom_error_t error) {
+  enum {
+    kChunkWordCount = FLASH_CTRL_PARAM_RD_FIFO_DEPTH,
+  };
+  uint32_t buf[kChunkWordCount];
+  uint32_t chunk_word_count =
+      word_count < kChunkWordCount ? word_count : kChunkWordCount;
+  if (chunk_word_count > 0) {
+    transaction_start((transaction_params_t){
+        .addr = addr,
+        .op_type = FLASH_CTRL_CONTROL_OP_VALUE_READ,
+        .partition = partition,
+        .word_count = chunk_word_count,
+        // Does not apply to read transactions.
+        .erase_type = kFlashCtrlEraseTypePage,
+    });
+  }
+  while (chunk_word_count > 0) {
+    fifo_read(chunk_word_count, buf);
+    RETURN_IF_ERROR(wait_for_done(error));
+    addr += chunk_word_count * sizeof(uint32_t);
+    word_count -= chunk_word_count;
+
+    uint32_t buf_word_count = chunk_word_count;
+    chunk_word_count =
+        word_count < kChunkWordCount ? word_count : kChunkWordCount;
+    if (chunk_word_count > 0) {
+      transaction_start((transaction_params_t){
+          .addr = addr,
+          .op_type = FLASH_CTRL_CONTROL_OP_VALUE_READ,
+          .partition = partition,
+          .word_count = chunk_word_count,
+          // Does not apply to read transactions.
+          .erase_type = kFlashCtrlEraseTypePage,
+      });
+    }
+    hmac_sha256_update_words(buf, buf_word_count);
+  }
+  HARDENED_CHECK_EQ(word_count, 0);
+  return kErrorOk;
+}
+
 /**
  * Disables all access to a page until next reset.
  *
@@ -356,6 +418,17 @@ rom_error_t flash_ctrl_info_read(const flash_ctrl_info_page_t *info_page,
   return wait_for_done(kErrorFlashCtrlInfoRead);
 }
 
+rom_error_t flash_ctrl_data_read_hash(uint32_t addr, uint32_t word_count) {
+  return read_hash(addr, kFlashCtrlPartitionData, word_count,
+                   kErrorFlashCtrlDataRead);
+}
+
+rom_error_t flash_ctrl_info_read_hash(const flash_ctrl_info_page_t *info_page,
+                                      uint32_t offset, uint32_t word_count) {
+  return read_hash(info_page->base_addr + offset, kFlashCtrlPartitionInfo0,
+                   word_count, kErrorFlashCtrlInfoRead);
+}
+
 rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
                                   const void *data) {
   return write(addr, kFlashCtrlPartitionData, word_count, data,
@@ -370,8 +443,8 @@ rom_error_t flash_ctrl_info_write(const flash_ctrl_info_page_t *info_page,
                kErrorFlashCtrlInfoWrite);
 }
 
-rom_error_t flash_ctrl_data_erase(uint32_t addr,
-                                  flash_ctrl_erase_type_t erase_type) {
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type) {
   transaction_start((transaction_params_t){
       .addr = addr,
       .op_type = FLASH_CTRL_CONTROL_OP_VALUE_ERASE,
@@ -380,9 +453,18 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
       // Does not apply to erase transactions.
       .word_count = 1,
   });
+}
+
+rom_error_t flash_ctrl_data_erase_finish(void) {
   return wait_for_done(kErrorFlashCtrlDataErase);
 }
 
+rom_error_t flash_ctrl_data_erase(uint32_t addr,
+                                  flash_ctrl_erase_type_t erase_type) {
+  flash_ctrl_data_erase_start(addr, erase_type);
+  return flash_ctrl_data_erase_finish();
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   static_assert(__builtin_popcount(FLASH_CTRL_PARAM_BYTES_PER_BANK) == 1,
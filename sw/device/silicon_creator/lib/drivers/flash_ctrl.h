@@ -318,6 +318,38 @@ rom_error_t flash_ctrl_info_read(const flash_ctrl_info_page_t *info_page,
                                  uint32_t offset, uint32_t word_count,
                                  void *data);
 
+/**
+ * Reads data from the data partition and feeds it to the SHA2-256 function.
+ *
+ * Equivalent to `flash_ctrl_data_read()` followed by
+ * `hmac_sha256_update_words()`, but without a caller-provided buffer. Flash
+ * reads are overlapped with hashing: the next read transaction is started
+ * before the previously read words are pushed to HMAC.
+ *
+ * The caller must have started the HMAC operation, e.g. with
+ * `hmac_sha256_init()`, and is responsible for finalizing it.
+ *
+ * @param addr Address to read from. Must be word aligned.
+ * @param word_count Number of bus words to read.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_read_hash(uint32_t addr, uint32_t word_count);
+
+/**
+ * Reads data from an information page and feeds it to the SHA2-256 function.
+ *
+ * See `flash_ctrl_data_read_hash()`.
+ *
+ * @param info_page Information page to read from.
+ * @param offset Offset from the start of the page. Must be word aligned.
+ * @param word_count Number of bus words to read.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_info_read_hash(const flash_ctrl_info_page_t *info_page,
+                                      uint32_t offset, uint32_t word_count);
+
 /**
  * Writes data to the data partition.
  *
@@ -389,6 +421,27 @@ OT_WARN_UNUSED_RESULT
 rom_error_t flash_ctrl_data_erase(uint32_t addr,
                                   flash_ctrl_erase_type_t erase_type);
 
+/**
+ * Starts erasing a data partition page or bank without waiting for it.
+ *
+ * Must be followed by `flash_ctrl_data_erase_finish()` before any other flash
+ * controller operation is issued. In the meantime, the other bank can still be
+ * read through the memory-mapped window.
+ *
+ * @param addr Address that falls within the bank or page being deleted.
+ * @param erase_type Whether to erase a page or a bank.
+ */
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type);
+
+/**
+ * Waits for an erase started by `flash_ctrl_data_erase_start()` to complete.
+ *
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_erase_finish(void);
+
 /**
  * Verifies that a data partition page or bank was erased.
  *
@@ -12,6 +12,7 @@
 #include "sw/device/lib/base/mock_mmio_test_utils.h"
 #include "sw/device/lib/base/multibits.h"
 #include "sw/device/silicon_creator/lib/base/mock_sec_mmio.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_hmac.h"
 #include "sw/device/silicon_creator/lib/drivers/mock_otp.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/testing/rom_test.h"
@@ -22,6 +23,7 @@
 
 namespace flash_ctrl_unittest {
 namespace {
+using ::testing::_;
 using ::testing::Each;
 using ::testing::Return;
 using ::testing::SizeIs;
@@ -65,6 +67,7 @@ class FlashCtrlTest : public rom_test::RomTest {
   rom_test::MockAbsMmio mmio_;
   rom_test::MockSecMmio sec_mmio_;
   rom_test::MockOtp otp_;
+  rom_test::MockHmac hmac_;
 };
 
 class InfoPagesTest : public FlashCtrlTest {};
@@ -338,6 +341,54 @@ TEST_F(TransferTest, ReadInfoOk) {
   EXPECT_EQ(words_out, words_);
 }
 
+TEST_F(TransferTest, ReadDataHashOk) {
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x01234560,
+                      words_.size());
+  ExpectReadData(words_);
+  ExpectWaitForDone(true, false);
+  EXPECT_CALL(hmac_, sha256_update_words(_, words_.size()))
+      .WillOnce([&](const uint32_t *data, size_t len) {
+        EXPECT_EQ(std::vector<uint32_t>(data, data + len), words_);
+      });
+  EXPECT_EQ(flash_ctrl_data_read_hash(0x01234560, words_.size()), kErrorOk);
+}
+
+TEST_F(TransferTest, ReadDataHashMultipleChunks) {
+  constexpr uint32_t kChunk = FLASH_CTRL_PARAM_RD_FIFO_DEPTH;
+  std::vector<uint32_t> chunk(kChunk, 0xa5a5a5a5);
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x1000,
+                      kChunk);
+  ExpectReadData(chunk);
+  ExpectWaitForDone(true, false);
+  // The second transaction starts before the first chunk is hashed.
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ,
+                      0x1000 + kChunk * sizeof(uint32_t), words_.size());
+  ExpectReadData(words_);
+  ExpectWaitForDone(true, false);
+  EXPECT_CALL(hmac_, sha256_update_words(_, kChunk))
+      .WillOnce([&](const uint32_t *data, size_t len) {
+        EXPECT_EQ(std::vector<uint32_t>(data, data + len), chunk);
+      });
+  EXPECT_CALL(hmac_, sha256_update_words(_, words_.size()))
+      .WillOnce([&](const uint32_t *data, size_t len) {
+        EXPECT_EQ(std::vector<uint32_t>(data, data + len), words_);
+      });
+  EXPECT_EQ(flash_ctrl_data_read_hash(0x1000, kChunk + words_.size()),
+            kErrorOk);
+}
+
+TEST_F(TransferTest, ReadInfoHashError) {
+  const uint32_t addr =
+      1 * FLASH_CTRL_PARAM_BYTES_PER_BANK + 2 * FLASH_CTRL_PARAM_BYTES_PER_PAGE;
+  ExpectTransferStart(1, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, addr,
+                      words_.size());
+  ExpectReadData(words_);
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_info_read_hash(&kFlashCtrlInfoPageOwnerSlot0, 0,
+                                      words_.size()),
+            kErrorFlashCtrlInfoRead);
+}
+
 TEST_F(TransferTest, ProgDataOk) {
   ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, 0x01234567,
                       words_.size());
@@ -368,6 +419,16 @@ TEST_F(TransferTest, EraseDataPageOk) {
             kErrorOk);
 }
 
+TEST_F(TransferTest, EraseDataBankStartFinish) {
+  ExpectTransferStart(0, 0, 1, FLASH_CTRL_CONTROL_OP_VALUE_ERASE,
+                      FLASH_CTRL_PARAM_BYTES_PER_BANK, 1);
+  flash_ctrl_data_erase_start(FLASH_CTRL_PARAM_BYTES_PER_BANK,
+                              kFlashCtrlEraseTypeBank);
+  ExpectWaitForDone(false, false);
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_data_erase_finish(), kErrorFlashCtrlDataErase);
+}
+
 TEST_F(TransferTest, EraseInfoPageOk) {
   // Address of the `kFlashCtrlInfoPageOwnerSlot0` page, see `info_page_addr`.
   const uint32_t addr =
@@ -13,6 +13,40 @@
 #include "hmac_regs.h"  // Generated.
 #include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
 
+enum {
+  /**
+   * Number of words pushed to `MSG_FIFO` per iteration of the inner loop.
+   *
+   * Writes to a full `MSG_FIFO` stall the bus until there is room, so the
+   * loop never polls the FIFO status; the fixed trip count only lets the
+   * compiler unroll the stores.
+   */
+  kHmacMsgFifoBurstWords = 8,
+};
+
+/**
+ * Writes `num_words` word-aligned 32-bit words from `data` to `MSG_FIFO`.
+ *
+ * @param data Word-aligned buffer to copy data from.
+ * @param num_words Number of words to write.
+ */
+static void msg_fifo_write_words(const void *data, size_t num_words) {
+  const char *next = (const char *)data;
+  for (; num_words >= kHmacMsgFifoBurstWords;
+       num_words -= kHmacMsgFifoBurstWords) {
+    for (size_t i = 0; i < kHmacMsgFifoBurstWords; ++i) {
+      abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
+                       read_32(next + i * sizeof(uint32_t)));
+    }
+    next += kHmacMsgFifoBurstWords * sizeof(uint32_t);
+  }
+  for (; num_words != 0; --num_words) {
+    abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
+                     read_32(next));
+    next += sizeof(uint32_t);
+  }
+}
+
 void hmac_sha256_configure(bool big_endian_digest) {
   // Clear the config, stopping the SHA engine.
   abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET, 0u);
@@ -50,12 +84,10 @@ void hmac_sha256_update(const void *data, size_t len) {
                     *data_sent++);
   }
 
-  for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
-    uint32_t data_aligned = read_32(data_sent);
-    abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
-                     data_aligned);
-    data_sent += sizeof(uint32_t);
-  }
+  size_t num_words = len / sizeof(uint32_t);
+  msg_fifo_write_words(data_sent, num_words);
+  data_sent += num_words * sizeof(uint32_t);
+  len -= num_words * sizeof(uint32_t);
 
   // Handle non-32bit aligned bytes at the end of the buffer.
   for (; len != 0; --len) {
@@ -65,10 +97,7 @@ void hmac_sha256_update(const void *data, size_t len) {
 }
 
 void hmac_sha256_update_words(const uint32_t *data, size_t len) {
-  for (size_t i = 0; i < len; i++) {
-    abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
-                     data[i]);
-  }
+  msg_fifo_write_words(data, len);
 }
 
 inline void hmac_sha256_process(void) {
@@ -150,21 +179,18 @@ void hmac_sha256_save(hmac_context_t *ctx) {
                                        HMAC_MSG_LENGTH_UPPER_REG_OFFSET);
 
   // Momentarily clear the `sha_en` bit, which clears the digest.
-  uint32_t cfg =
-      abs_mmio_read32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET);
+  ctx->cfg = abs_mmio_read32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET);
   abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET,
-                   bitfield_bit32_write(cfg, HMAC_CFG_SHA_EN_BIT, false));
+                   bitfield_bit32_write(ctx->cfg, HMAC_CFG_SHA_EN_BIT, false));
 
   // Restore the full original configuration.
-  abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET, cfg);
+  abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET, ctx->cfg);
 }
 
 void hmac_sha256_restore(const hmac_context_t *ctx) {
-  // Clear the `sha_en` bit to ensure the message length registers are
-  // writeable. Leave the rest of the configuration unchanged.
-  uint32_t cfg =
-      abs_mmio_read32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET);
-  cfg = bitfield_bit32_write(cfg, HMAC_CFG_SHA_EN_BIT, false);
+  // Apply the saved configuration with the `sha_en` bit cleared to ensure the
+  // message length registers are writeable.
+  uint32_t cfg = bitfield_bit32_write(ctx->cfg, HMAC_CFG_SHA_EN_BIT, false);
   abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_CFG_REG_OFFSET, cfg);
 
   // Write the digest registers. Note that endianness does not matter here,
@@ -117,6 +117,16 @@ TEST_F(Sha256UpdateTest, SendData) {
   hmac_sha256_update(&kData[2], 8);
 }
 
+TEST_F(Sha256UpdateTest, SendWords) {
+  // More than one FIFO burst, followed by a partial burst.
+  std::array<uint32_t, 11> data;
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = 0x01010101 * i;
+    EXPECT_ABS_WRITE32(base_ + HMAC_MSG_FIFO_REG_OFFSET, data[i]);
+  }
+  hmac_sha256_update_words(data.data(), data.size());
+}
+
 class Sha256FinalTest : public HmacTest {};
 
 TEST_F(Sha256FinalTest, GetDigest) {
@@ -280,6 +280,28 @@ rom_error_t sc_keymgr_owner_int_advance(keymgr_binding_value_t *attest_binding,
                                         keymgr_binding_value_t *sealing_binding,
                                         uint32_t max_key_version);
 
+/**
+ * Sets the binding registers and starts advancing the keymgr to the
+ * `OwnerIntermediateKey` (CDI_0) key stage without waiting for it to finish.
+ *
+ * Callers must use `sc_keymgr_state_check(kScKeymgrStateOwnerIntermediateKey)`
+ * to wait for the operation to complete before issuing another keymgr
+ * operation. Work that does not depend on the keymgr can be done in between.
+ *
+ * Preconditions: keymgr has been initialized and cranked to the
+ * `CreatorRootKey` stage.
+ *
+ * @param attest_binding The attestation binding value to use.
+ * @param sealing_binding The sealing binding value to use.
+ * @param max_key_version Maximum key version associated with the Silicon Owner
+ *                        Intermediate key manager stage.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sc_keymgr_owner_int_advance_start(
+    keymgr_binding_value_t *attest_binding,
+    keymgr_binding_value_t *sealing_binding, uint32_t max_key_version);
+
 /**
  * Sets the binding registers and advances the keymgr to the `OwnerKey` (CDI_1)
  * key stage.
@@ -298,6 +320,27 @@ rom_error_t sc_keymgr_owner_advance(keymgr_binding_value_t *attest_binding,
                                     keymgr_binding_value_t *sealing_binding,
                                     uint32_t max_key_version);
 
+/**
+ * Sets the binding registers and starts advancing the keymgr to the `OwnerKey`
+ * (CDI_1) key stage without waiting for it to finish.
+ *
+ * Callers must use `sc_keymgr_state_check(kScKeymgrStateOwnerKey)` to wait for
+ * the operation to complete before issuing another keymgr operation.
+ *
+ * Preconditions: keymgr has been initialized and cranked to the
+ * `OwnerIntermediateKey` stage.
+ *
+ * @param attest_binding The attestation binding value to use.
+ * @param sealing_binding The sealing binding value to use.
+ * @param max_key_version Maximum key version associated with the Silicon Owner
+ *                        key manager stage.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sc_keymgr_owner_advance_start(
+    keymgr_binding_value_t *attest_binding,
+    keymgr_binding_value_t *sealing_binding, uint32_t max_key_version);
+
 #ifdef __cplusplus
 }
 #endif
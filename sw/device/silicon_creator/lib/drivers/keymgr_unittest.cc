@@ -393,6 +393,23 @@ TEST_F(KeymgrTest, OwnerIntAdvance) {
             kErrorOk);
 }
 
+TEST_F(KeymgrTest, OwnerIntAdvanceStart) {
+  ExpectStatusCheck(KEYMGR_OP_STATUS_STATUS_VALUE_IDLE,
+                    KEYMGR_WORKING_STATE_STATE_VALUE_CREATOR_ROOT_KEY,
+                    /*err_code=*/0u);
+  ExpectSwBindingValueSet(&cfg_.binding_value_sealing,
+                          &cfg_.binding_value_attestation);
+  EXPECT_SEC_WRITE32_SHADOWED(
+      base_ + KEYMGR_MAX_OWNER_INT_KEY_VER_SHADOWED_REG_OFFSET,
+      cfg_.max_key_ver);
+  EXPECT_SEC_WRITE32(base_ + KEYMGR_MAX_OWNER_INT_KEY_VER_REGWEN_REG_OFFSET, 0);
+  ExpectAdvanceState();
+  EXPECT_EQ(sc_keymgr_owner_int_advance_start(&cfg_.binding_value_sealing,
+                                              &cfg_.binding_value_attestation,
+                                              cfg_.max_key_ver),
+            kErrorOk);
+}
+
 TEST_F(KeymgrTest, OwnerAdvance) {
   ExpectStatusCheck(KEYMGR_OP_STATUS_STATUS_VALUE_IDLE,
                     KEYMGR_WORKING_STATE_STATE_VALUE_OWNER_INTERMEDIATE_KEY,
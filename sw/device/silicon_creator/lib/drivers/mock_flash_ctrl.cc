@@ -29,6 +29,15 @@ rom_error_t flash_ctrl_info_read(const flash_ctrl_info_page_t *info_page,
                                             data);
 }
 
+rom_error_t flash_ctrl_data_read_hash(uint32_t addr, uint32_t word_count) {
+  return MockFlashCtrl::Instance().DataReadHash(addr, word_count);
+}
+
+rom_error_t flash_ctrl_info_read_hash(const flash_ctrl_info_page_t *info_page,
+                                      uint32_t offset, uint32_t word_count) {
+  return MockFlashCtrl::Instance().InfoReadHash(info_page, offset, word_count);
+}
+
 rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
                                   const void *data) {
   return MockFlashCtrl::Instance().DataWrite(addr, word_count, data);
@@ -46,6 +55,15 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
   return MockFlashCtrl::Instance().DataErase(addr, erase_type);
 }
 
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type) {
+  MockFlashCtrl::Instance().DataEraseStart(addr, erase_type);
+}
+
+rom_error_t flash_ctrl_data_erase_finish(void) {
+  return MockFlashCtrl::Instance().DataEraseFinish();
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   return MockFlashCtrl::Instance().DataEraseVerify(addr, erase_type);
@@ -23,11 +23,16 @@ class MockFlashCtrl : public global_mock::GlobalMock<MockFlashCtrl> {
   MOCK_METHOD(rom_error_t, DataRead, (uint32_t, uint32_t, void *));
   MOCK_METHOD(rom_error_t, InfoRead,
               (const flash_ctrl_info_page_t *, uint32_t, uint32_t, void *));
+  MOCK_METHOD(rom_error_t, DataReadHash, (uint32_t, uint32_t));
+  MOCK_METHOD(rom_error_t, InfoReadHash,
+              (const flash_ctrl_info_page_t *, uint32_t, uint32_t));
   MOCK_METHOD(rom_error_t, DataWrite, (uint32_t, uint32_t, const void *));
   MOCK_METHOD(rom_error_t, InfoWrite,
               (const flash_ctrl_info_page_t *, uint32_t, uint32_t,
                const void *));
   MOCK_METHOD(rom_error_t, DataErase, (uint32_t, flash_ctrl_erase_type_t));
+  MOCK_METHOD(void, DataEraseStart, (uint32_t, flash_ctrl_erase_type_t));
+  MOCK_METHOD(rom_error_t, DataEraseFinish, ());
   MOCK_METHOD(rom_error_t, DataEraseVerify,
               (uint32_t, flash_ctrl_erase_type_t));
   MOCK_METHOD(rom_error_t, InfoErase,
@@ -10,6 +10,12 @@ rom_error_t rnd_health_config_check(lifecycle_state_t lc_state) {
   return MockRnd::Instance().HealthConfigCheck(lc_state);
 }
 
+void rnd_init(void) { MockRnd::Instance().Init(); }
+
 uint32_t rnd_uint32(void) { return MockRnd::Instance().Uint32(); }
+
+void rnd_fill(uint32_t *buf, size_t words) {
+  MockRnd::Instance().Fill(buf, words);
+}
 }
 }  // namespace rom_test
@@ -18,7 +18,9 @@ namespace internal {
 class MockRnd : public global_mock::GlobalMock<MockRnd> {
  public:
   MOCK_METHOD(rom_error_t, HealthConfigCheck, (lifecycle_state_t));
+  MOCK_METHOD(void, Init, ());
   MOCK_METHOD(uint32_t, Uint32, ());
+  MOCK_METHOD(void, Fill, (uint32_t *, size_t));
 };
 
 }  // namespace internal
@@ -256,6 +256,30 @@ rom_error_t sc_otbn_dmem_read(size_t num_words, const sc_otbn_addr_t src,
 OT_WARN_UNUSED_RESULT
 rom_error_t sc_otbn_execute(void);
 
+/**
+ * Start the execution of the application loaded into OTBN without waiting for
+ * it to finish.
+ *
+ * Blocks only until any previous OTBN operation is done. The caller must
+ * collect the result with `sc_otbn_execute_finish()` before accessing OTBN
+ * again, and may do unrelated work on Ibex (or other peripherals) meanwhile.
+ * Performs the same sec_mmio writes as `sc_otbn_execute()`.
+ *
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sc_otbn_execute_start(void);
+
+/**
+ * Wait for an execution started with `sc_otbn_execute_start()` to finish.
+ *
+ * This function blocks until OTBN is idle.
+ *
+ * @return Result of the execution.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sc_otbn_execute_finish(void);
+
 /**
  * Blocks until OTBN is idle.
  *
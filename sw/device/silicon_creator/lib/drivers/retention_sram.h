@@ -11,6 +11,7 @@
 #include "sw/device/silicon_creator/lib/boot_log.h"
 #include "sw/device/silicon_creator/lib/boot_svc/boot_svc_msg.h"
 #include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/verify_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,10 +51,19 @@ typedef struct retention_sram_creator {
    */
   uint32_t reserved[(2044 - (sizeof(uint32_t)          // reset_reason
                              + sizeof(boot_svc_msg_t)  // boot services message
+                             + sizeof(verify_cache_t)  // bl0_verify_cache
                              + sizeof(boot_log_t)      // boot_log
                              + sizeof(rom_error_t)     // last_shutdown_reason
                              )) /
                     sizeof(uint32_t)];
+  /**
+   * BL0 verify cache.
+   *
+   * Sealed record of the last BL0 image whose signature the ROM_EXT verified.
+   * Used to skip the signature check on resets that preserve the retention
+   * SRAM.
+   */
+  verify_cache_t bl0_verify_cache;
   /**
    * Boot log area.
    *
@@ -72,6 +82,7 @@ typedef struct retention_sram_creator {
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reset_reasons, 0);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_svc_msg, 4);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reserved, 260);
+OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, bl0_verify_cache, 1836);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_log, 1912);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, last_shutdown_reason, 2040);
 OT_ASSERT_SIZE(boot_svc_msg_t, 256);
@@ -9,7 +9,9 @@
 #include "sw/device/lib/base/crc32.h"
 #include "sw/device/lib/base/csr.h"
 #include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/random_order.h"
 #include "sw/device/silicon_creator/lib/drivers/otp.h"
 
 #include "entropy_src_regs.h"
@@ -106,10 +108,40 @@ rom_error_t rnd_health_config_check(lifecycle_state_t lc_state) {
   return res;
 }
 
-uint32_t rnd_uint32(void) {
-  if (kBootStage == kBootStageOwner ||
-      otp_read32(OTP_CTRL_PARAM_CREATOR_SW_CFG_RNG_EN_OFFSET) ==
-          kHardenedBoolTrue) {
+/**
+ * Cached value of the CREATOR_SW_CFG_RNG_EN OTP item.
+ *
+ * Zero (neither `kHardenedBoolTrue` nor `kHardenedBoolFalse`) until
+ * `rnd_init()` is called, in which case OTP is read on every use.
+ */
+static hardened_bool_t rnd_en_cache;
+
+void rnd_init(void) {
+  rnd_en_cache = otp_read32(OTP_CTRL_PARAM_CREATOR_SW_CFG_RNG_EN_OFFSET);
+}
+
+/**
+ * Returns whether reads of RND_DATA must wait for fresh entropy.
+ */
+static hardened_bool_t rnd_wait_for_entropy(void) {
+  if (kBootStage == kBootStageOwner) {
+    return kHardenedBoolTrue;
+  }
+  hardened_bool_t en = launder32(rnd_en_cache);
+  if (en != kHardenedBoolTrue && en != kHardenedBoolFalse) {
+    en = otp_read32(OTP_CTRL_PARAM_CREATOR_SW_CFG_RNG_EN_OFFSET);
+  }
+  return en;
+}
+
+/**
+ * Reads one random word, optionally waiting for RND_DATA to be valid.
+ *
+ * Reading RND_DATA triggers the next EDN request, which then runs while the
+ * caller consumes the word.
+ */
+static uint32_t rnd_word_read(hardened_bool_t wait) {
+  if (launder32(wait) == kHardenedBoolTrue) {
     // When bit-0 is clear an EDN request for new data for RND_DATA is
     // pending.
     while (!abs_mmio_read32(kBaseIbex + RV_CORE_IBEX_RND_STATUS_REG_OFFSET)) {
@@ -119,3 +151,19 @@ uint32_t rnd_uint32(void) {
   CSR_READ(CSR_REG_MCYCLE, &mcycle);
   return mcycle + abs_mmio_read32(kBaseIbex + RV_CORE_IBEX_RND_DATA_REG_OFFSET);
 }
+
+uint32_t rnd_uint32(void) { return rnd_word_read(rnd_wait_for_entropy()); }
+
+void rnd_fill(uint32_t *buf, size_t words) {
+  hardened_bool_t wait = rnd_wait_for_entropy();
+  for (size_t i = 0; i < words; ++i) {
+    buf[i] = rnd_word_read(wait);
+  }
+}
+
+// Replace the weak defaults in `hardened_memory.c` and `random_order.c`, so
+// that any program using this driver shreds memory with random data and
+// traverses hardened loops in a random order, rather than using constants.
+uint32_t hardened_memshred_random_word(void) { return rnd_uint32(); }
+
+uint32_t random_order_random_word(void) { return rnd_uint32(); }
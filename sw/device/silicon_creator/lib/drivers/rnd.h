@@ -5,6 +5,9 @@
 #ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_DRIVERS_RND_H_
 #define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_DRIVERS_RND_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
 #include "sw/device/silicon_creator/lib/error.h"
@@ -26,18 +29,40 @@ extern "C" {
 OT_WARN_UNUSED_RESULT
 rom_error_t rnd_health_config_check(lifecycle_state_t lc_state);
 
+/**
+ * Caches the CREATOR_SW_CFG_RNG_EN OTP value.
+ *
+ * After this call, `rnd_uint32()` and `rnd_fill()` no longer read OTP, so they
+ * can also be used after the creator OTP partitions are locked down. Like any
+ * `otp_read32()`, the read is recorded by `sec_mmio`, so later calls to
+ * `sec_mmio_check_values()` check that the OTP value has not changed.
+ */
+void rnd_init(void);
+
 /**
  * Returns a random word from the RISC-V Ibex core wrapper.
  *
  * Requires the CREATOR_SW_CFG_RNG_EN OTP value set to `kHardenedBoolTrue`
  * in order to enable the use of entropy, otherwise it only returns the current
- * value of the MCYCLE CSR register.
+ * value of the MCYCLE CSR register. The OTP value is read on every call unless
+ * `rnd_init()` has been called.
  *
  * @returns MCYCLE CSR + entropy value.
  */
 OT_WARN_UNUSED_RESULT
 uint32_t rnd_uint32(void);
 
+/**
+ * Fills a buffer with random words.
+ *
+ * Equivalent to calling `rnd_uint32()` for each word, but only checks whether
+ * entropy is enabled once.
+ *
+ * @param[out] buf Buffer to fill.
+ * @param words Number of words to write to `buf`.
+ */
+void rnd_fill(uint32_t *buf, size_t words);
+
 #ifdef __cplusplus
 }
 #endif
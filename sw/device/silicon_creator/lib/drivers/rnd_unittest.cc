@@ -40,7 +40,9 @@ class RndTest : public rom_test::RomTest {
 TEST_F(RndTest, GetUint32Enabled) {
   EXPECT_CALL(otp_, read32(OTP_CTRL_PARAM_CREATOR_SW_CFG_RNG_EN_OFFSET))
       .WillOnce(Return(kHardenedBoolTrue));
+  rnd_init();
 
+  // The OTP value is cached, so it is not read again.
   EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_STATUS_REG_OFFSET,
                     {{RV_CORE_IBEX_RND_STATUS_RND_DATA_VALID_BIT, false}});
   EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_STATUS_REG_OFFSET,
@@ -48,17 +50,40 @@ TEST_F(RndTest, GetUint32Enabled) {
   EXPECT_CSR_READ(CSR_REG_MCYCLE, 67894);
   EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_DATA_REG_OFFSET, 12345);
   EXPECT_EQ(rnd_uint32(), 67894 + 12345);
+
+  EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_STATUS_REG_OFFSET,
+                    {{RV_CORE_IBEX_RND_STATUS_RND_DATA_VALID_BIT, true}});
+  EXPECT_CSR_READ(CSR_REG_MCYCLE, 1);
+  EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_DATA_REG_OFFSET, 2);
+  EXPECT_EQ(rnd_uint32(), 1 + 2);
 }
 
 TEST_F(RndTest, GetUint32Disabled) {
   EXPECT_CALL(otp_, read32(OTP_CTRL_PARAM_CREATOR_SW_CFG_RNG_EN_OFFSET))
       .WillOnce(Return(kHardenedBoolFalse));
+  rnd_init();
 
   EXPECT_CSR_READ(CSR_REG_MCYCLE, 978465);
   EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_DATA_REG_OFFSET, 193475837);
   EXPECT_EQ(rnd_uint32(), 978465 + 193475837);
 }
 
+TEST_F(RndTest, Fill) {
+  EXPECT_CALL(otp_, read32(OTP_CTRL_PARAM_CREATOR_SW_CFG_RNG_EN_OFFSET))
+      .WillOnce(Return(kHardenedBoolTrue));
+  rnd_init();
+
+  std::vector<uint32_t> got(3);
+  for (uint32_t i = 0; i < got.size(); ++i) {
+    EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_STATUS_REG_OFFSET,
+                      {{RV_CORE_IBEX_RND_STATUS_RND_DATA_VALID_BIT, true}});
+    EXPECT_CSR_READ(CSR_REG_MCYCLE, i);
+    EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_DATA_REG_OFFSET, 100 * i);
+  }
+  rnd_fill(got.data(), got.size());
+  EXPECT_EQ(got, std::vector<uint32_t>({0, 101, 202}));
+}
+
 struct RndtLcStateTestCfg {
   lifecycle_state_t lc_state;
   bool expect_error_ok;
@@ -70,6 +70,13 @@ enum {
    * Value taken from `boot.s`.
    */
   kOtbnBootModeAttestationKeySave = 0x64d,
+  /*
+   * Mode to endorse a message with a saved private key and then save a new
+   * attestation private key.
+   *
+   * Value taken from `boot.s`.
+   */
+  kOtbnBootModeAttestationEndorseAndKeySave = 0x51e,
   /* Size of the OTBN attestation seed buffer in 32-bit words (rounding the
      attestation seed size up to the next OTBN wide word). */
   kOtbnAttestationSeedBufferWords =
@@ -79,13 +86,13 @@ enum {
 };
 
 OT_WARN_UNUSED_RESULT
-static rom_error_t load_attestation_keygen_seed(
-    attestation_key_seed_t additional_seed, uint32_t *seed) {
-  // Read seed from flash info page.
-  uint32_t seed_flash_offset = 0 + (additional_seed * kAttestationSeedBytes);
-  rom_error_t err =
-      flash_ctrl_info_read(&kFlashCtrlInfoPageAttestationKeySeeds,
-                           seed_flash_offset, kAttestationSeedWords, seed);
+static rom_error_t load_attestation_keygen_seeds(
+    attestation_key_seed_t first_seed, size_t num_seeds, uint32_t *seeds) {
+  // Read seeds from flash info page.
+  uint32_t seed_flash_offset = 0 + (first_seed * kAttestationSeedBytes);
+  rom_error_t err = flash_ctrl_info_read(
+      &kFlashCtrlInfoPageAttestationKeySeeds, seed_flash_offset,
+      num_seeds * kAttestationSeedWords, seeds);
 
   if (err != kErrorOk) {
     flash_ctrl_error_code_t flash_ctrl_err_code;
@@ -107,11 +114,34 @@ static rom_error_t load_attestation_keygen_seed(
   return kErrorOk;
 }
 
-rom_error_t otbn_boot_app_load(void) { return sc_otbn_load_app(kOtbnAppBoot); }
+OT_WARN_UNUSED_RESULT
+static rom_error_t write_attestation_keygen_seed_words(const uint32_t *seed) {
+  HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_write(
+      kAttestationSeedWords, seed, kOtbnVarBootAttestationAdditionalSeed));
+  // Pad remaining DMEM field with zeros to prevent a DMEM integrity error
+  // (since data is aligned to 256-bit words).
+  uint32_t zero_buf[kOtbnAttestationSeedBufferWords - kAttestationSeedWords] = {
+      0};
+  return sc_otbn_dmem_write(
+      ARRAYSIZE(zero_buf), zero_buf,
+      kOtbnVarBootAttestationAdditionalSeed + kAttestationSeedBytes);
+}
 
-rom_error_t otbn_boot_attestation_keygen(
-    attestation_key_seed_t additional_seed,
-    otbn_boot_attestation_key_type_t key_type,
+OT_WARN_UNUSED_RESULT
+static rom_error_t write_attestation_keygen_seed(
+    attestation_key_seed_t additional_seed) {
+  uint32_t seed[kAttestationSeedWords];
+  HARDENED_RETURN_IF_ERROR(
+      load_attestation_keygen_seeds(additional_seed, 1, seed));
+  return write_attestation_keygen_seed_words(seed);
+}
+
+/**
+ * Runs attestation key generation with an already loaded additional seed.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t attestation_keygen_run(
+    const uint32_t *seed, otbn_boot_attestation_key_type_t key_type,
     sc_keymgr_diversification_t diversification,
     ecdsa_p256_public_key_t *public_key) {
   // Trigger key manager to sideload the attestation key into OTBN.
@@ -123,20 +153,8 @@ rom_error_t otbn_boot_attestation_keygen(
   HARDENED_RETURN_IF_ERROR(
       sc_otbn_dmem_write(kOtbnBootModeWords, &mode, kOtbnVarBootMode));
 
-  // Load the additional seed from flash info.
-  uint32_t seed[kAttestationSeedWords];
-  HARDENED_RETURN_IF_ERROR(load_attestation_keygen_seed(additional_seed, seed));
-
   // Write the additional seed to OTBN DMEM.
-  HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_write(
-      kAttestationSeedWords, seed, kOtbnVarBootAttestationAdditionalSeed));
-  // Pad remaining DMEM field with zeros to prevent a DMEM integrity error
-  // (since data is aligned to 256-bit words).
-  uint32_t zero_buf[kOtbnAttestationSeedBufferWords - kAttestationSeedWords] = {
-      0};
-  HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_write(
-      ARRAYSIZE(zero_buf), zero_buf,
-      kOtbnVarBootAttestationAdditionalSeed + kAttestationSeedBytes));
+  HARDENED_RETURN_IF_ERROR(write_attestation_keygen_seed_words(seed));
 
   // Run the OTBN program (blocks until OTBN is done).
   HARDENED_RETURN_IF_ERROR(sc_otbn_execute());
@@ -153,6 +171,59 @@ rom_error_t otbn_boot_attestation_keygen(
   return kErrorOk;
 }
 
+rom_error_t otbn_boot_app_load(void) { return sc_otbn_load_app(kOtbnAppBoot); }
+
+rom_error_t otbn_boot_attestation_keygen(
+    attestation_key_seed_t additional_seed,
+    otbn_boot_attestation_key_type_t key_type,
+    sc_keymgr_diversification_t diversification,
+    ecdsa_p256_public_key_t *public_key) {
+  // Load the additional seed from flash info.
+  uint32_t seed[kAttestationSeedWords];
+  HARDENED_RETURN_IF_ERROR(
+      load_attestation_keygen_seeds(additional_seed, 1, seed));
+
+  return attestation_keygen_run(seed, key_type, diversification, public_key);
+}
+
+rom_error_t otbn_boot_attestation_keygen_batch(
+    const otbn_boot_attestation_keygen_req_t *reqs, size_t num_reqs,
+    ecdsa_p256_public_key_t *public_keys) {
+  if (num_reqs == 0) {
+    return kErrorOtbnInvalidArgument;
+  }
+
+  // Find the range of seed slots that covers all requests.
+  attestation_key_seed_t first_seed = reqs[0].additional_seed;
+  attestation_key_seed_t last_seed = reqs[0].additional_seed;
+  for (size_t i = 1; i < num_reqs; ++i) {
+    if (reqs[i].additional_seed < first_seed) {
+      first_seed = reqs[i].additional_seed;
+    }
+    if (reqs[i].additional_seed > last_seed) {
+      last_seed = reqs[i].additional_seed;
+    }
+  }
+  size_t num_seeds = (size_t)(last_seed - first_seed) + 1;
+  if (num_seeds > kOtbnBootAttestationKeygenBatchMaxSeeds) {
+    return kErrorOtbnInvalidArgument;
+  }
+
+  // Load all additional seeds from flash info in a single read.
+  uint32_t seeds[kOtbnBootAttestationKeygenBatchMaxSeeds]
+                [kAttestationSeedWords];
+  HARDENED_RETURN_IF_ERROR(
+      load_attestation_keygen_seeds(first_seed, num_seeds, seeds[0]));
+
+  for (size_t i = 0; i < num_reqs; ++i) {
+    HARDENED_RETURN_IF_ERROR(attestation_keygen_run(
+        seeds[reqs[i].additional_seed - first_seed], reqs[i].key_type,
+        reqs[i].diversification, &public_keys[i]));
+  }
+
+  return kErrorOk;
+}
+
 rom_error_t otbn_boot_attestation_key_save(
     attestation_key_seed_t additional_seed,
     otbn_boot_attestation_key_type_t key_type,
@@ -166,20 +237,8 @@ rom_error_t otbn_boot_attestation_key_save(
   HARDENED_RETURN_IF_ERROR(
       sc_otbn_dmem_write(kOtbnBootModeWords, &mode, kOtbnVarBootMode));
 
-  // Load the additional seed from flash info.
-  uint32_t seed[kAttestationSeedWords];
-  HARDENED_RETURN_IF_ERROR(load_attestation_keygen_seed(additional_seed, seed));
-  // Pad remaining DMEM field with zeros to prevent a DMEM integrity error
-  // (since data is aligned to 256-bit words).
-  uint32_t zero_buf[kOtbnAttestationSeedBufferWords - kAttestationSeedWords] = {
-      0};
-  HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_write(
-      ARRAYSIZE(zero_buf), zero_buf,
-      kOtbnVarBootAttestationAdditionalSeed + kAttestationSeedBytes));
-
-  // Write the additional seed to OTBN DMEM.
-  HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_write(
-      kAttestationSeedWords, seed, kOtbnVarBootAttestationAdditionalSeed));
+  // Load the additional seed from flash info and write it to OTBN DMEM.
+  HARDENED_RETURN_IF_ERROR(write_attestation_keygen_seed(additional_seed));
 
   // Run the OTBN program (blocks until OTBN is done).
   HARDENED_RETURN_IF_ERROR(sc_otbn_execute());
@@ -237,10 +296,44 @@ rom_error_t otbn_boot_attestation_endorse(const hmac_digest_t *digest,
   return kErrorOk;
 }
 
-rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
-                                const ecdsa_p256_signature_t *sig,
-                                const hmac_digest_t *digest,
-                                uint32_t *recovered_r) {
+rom_error_t otbn_boot_attestation_endorse_and_key_save(
+    const hmac_digest_t *digest, attestation_key_seed_t additional_seed,
+    otbn_boot_attestation_key_type_t key_type,
+    sc_keymgr_diversification_t diversification, ecdsa_p256_signature_t *sig) {
+  // Trigger key manager to sideload the attestation key into OTBN.
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_generate_key_otbn(
+      (sc_keymgr_key_type_t)key_type, diversification));
+
+  // Write the mode.
+  uint32_t mode = kOtbnBootModeAttestationEndorseAndKeySave;
+  HARDENED_RETURN_IF_ERROR(
+      sc_otbn_dmem_write(kOtbnBootModeWords, &mode, kOtbnVarBootMode));
+
+  // Load the additional seed from flash info and write it to OTBN DMEM.
+  HARDENED_RETURN_IF_ERROR(write_attestation_keygen_seed(additional_seed));
+
+  // Write the message digest.
+  HARDENED_RETURN_IF_ERROR(
+      sc_otbn_dmem_write(kHmacDigestNumWords, digest->digest, kOtbnVarBootMsg));
+
+  // Run the OTBN program (blocks until OTBN is done).
+  HARDENED_RETURN_IF_ERROR(sc_otbn_execute());
+  SEC_MMIO_WRITE_INCREMENT(kScOtbnSecMmioExecute);
+
+  // TODO(#20023): Check the instruction count register (see `mod_exp_otbn`).
+
+  // Retrieve the signature (in two parts, r and s).
+  HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_read(kEcdsaP256SignatureComponentWords,
+                                             kOtbnVarBootR, sig->r));
+  HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_read(kEcdsaP256SignatureComponentWords,
+                                             kOtbnVarBootS, sig->s));
+
+  return kErrorOk;
+}
+
+rom_error_t otbn_boot_sigverify_start(const ecdsa_p256_public_key_t *key,
+                                      const ecdsa_p256_signature_t *sig,
+                                      const hmac_digest_t *digest) {
   // Write the mode.
   uint32_t mode = kOtbnBootModeSigverify;
   HARDENED_RETURN_IF_ERROR(
@@ -263,8 +356,14 @@ rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
                                               sig->s, kOtbnVarBootS));
 
   // Start the OTBN routine.
-  HARDENED_RETURN_IF_ERROR(sc_otbn_execute());
+  HARDENED_RETURN_IF_ERROR(sc_otbn_execute_start());
   SEC_MMIO_WRITE_INCREMENT(kScOtbnSecMmioExecute);
+  return kErrorOk;
+}
+
+rom_error_t otbn_boot_sigverify_finish(uint32_t *recovered_r) {
+  // Wait for the OTBN routine to complete.
+  HARDENED_RETURN_IF_ERROR(sc_otbn_execute_finish());
 
   // Check if the signature passed basic checks.
   uint32_t ok;
@@ -283,3 +382,11 @@ rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
   return sc_otbn_dmem_read(kEcdsaP256SignatureComponentWords, kOtbnVarBootXr,
                            recovered_r);
 }
+
+rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
+                                const ecdsa_p256_signature_t *sig,
+                                const hmac_digest_t *digest,
+                                uint32_t *recovered_r) {
+  HARDENED_RETURN_IF_ERROR(otbn_boot_sigverify_start(key, sig, digest));
+  return otbn_boot_sigverify_finish(recovered_r);
+}
@@ -70,6 +70,48 @@ rom_error_t otbn_boot_attestation_keygen(
     sc_keymgr_diversification_t diversification,
     ecdsa_p256_public_key_t *public_key);
 
+enum {
+  /**
+   * Maximum span of seed slots (last - first + 1) in a keygen batch.
+   */
+  kOtbnBootAttestationKeygenBatchMaxSeeds = 8,
+};
+
+/**
+ * Arguments of a single key generation in a keygen batch.
+ *
+ * See `otbn_boot_attestation_keygen` for the meaning of each field.
+ */
+typedef struct otbn_boot_attestation_keygen_req {
+  attestation_key_seed_t additional_seed;
+  otbn_boot_attestation_key_type_t key_type;
+  sc_keymgr_diversification_t diversification;
+} otbn_boot_attestation_keygen_req_t;
+
+/**
+ * Generates several attestation public keys from the same key manager stage.
+ *
+ * Equivalent to calling `otbn_boot_attestation_keygen` for each request, but
+ * reads all additional seeds from flash info in a single read.
+ *
+ * The key manager sideload slot is shared by all requests, so the keys are
+ * still generated one after the other.
+ *
+ * Expects the OTBN boot-services program to already be loaded; see
+ * `otbn_boot_app_load`.
+ *
+ * @param reqs Key generation requests.
+ * @param num_reqs Number of requests; must be non-zero. The seed slots of all
+ *                 requests must span at most
+ *                 `kOtbnBootAttestationKeygenBatchMaxSeeds` slots.
+ * @param[out] public_keys Attestation public keys, one per request.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t otbn_boot_attestation_keygen_batch(
+    const otbn_boot_attestation_keygen_req_t *reqs, size_t num_reqs,
+    ecdsa_p256_public_key_t *public_keys);
+
 /**
  * Saves an attestation private key to OTBN's scratchpad.
  *
@@ -130,6 +172,31 @@ OT_WARN_UNUSED_RESULT
 rom_error_t otbn_boot_attestation_endorse(const hmac_digest_t *digest,
                                           ecdsa_p256_signature_t *sig);
 
+/**
+ * Signs the message with the saved attestation key, then saves a new one.
+ *
+ * Equivalent to `otbn_boot_attestation_endorse` followed by
+ * `otbn_boot_attestation_key_save`, but runs OTBN only once. This is the usual
+ * last step of a DICE stage: the current stage's certificate is signed with
+ * the previous stage's key, and the current stage's key is saved to endorse
+ * the next one.
+ *
+ * Expects the OTBN boot-services program to already be loaded; see
+ * `otbn_boot_app_load`.
+ *
+ * @param digest Digest to sign.
+ * @param additional_seed The attestation key generation seed of the new key.
+ * @param key_type OTBN attestation key type of the new key.
+ * @param diversification Salt and version information for key manager.
+ * @param[out] sig Resulting signature.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t otbn_boot_attestation_endorse_and_key_save(
+    const hmac_digest_t *digest, attestation_key_seed_t additional_seed,
+    otbn_boot_attestation_key_type_t key_type,
+    sc_keymgr_diversification_t diversification, ecdsa_p256_signature_t *sig);
+
 /**
  * Computes an ECDSA-P256 signature verification on OTBN.
  *
@@ -153,6 +220,37 @@ rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
                                 const hmac_digest_t *digest,
                                 uint32_t *recovered_r);
 
+/**
+ * Starts an ECDSA-P256 signature verification on OTBN.
+ *
+ * Same as `otbn_boot_sigverify`, but returns as soon as OTBN is running, so
+ * that the caller can do other work on Ibex in the meantime. The result must be
+ * collected with `otbn_boot_sigverify_finish` before OTBN is used again.
+ *
+ * Expects the OTBN boot-services program to already be loaded; see
+ * `otbn_boot_app_load`.
+ *
+ * @param key An ECDSA-P256 public key.
+ * @param sig An ECDSA-P256 signature.
+ * @param digest Message digest to check against.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t otbn_boot_sigverify_start(const ecdsa_p256_public_key_t *key,
+                                      const ecdsa_p256_signature_t *sig,
+                                      const hmac_digest_t *digest);
+
+/**
+ * Waits for a verification started with `otbn_boot_sigverify_start`.
+ *
+ * Returns the recovered `r` value in `recovered_r`; see `otbn_boot_sigverify`.
+ *
+ * @param[out] recovered_r Buffer for the recovered `r` value.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t otbn_boot_sigverify_finish(uint32_t *recovered_r);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -120,6 +120,63 @@ rom_error_t attestation_keygen_test(void) {
   return kErrorOk;
 }
 
+rom_error_t attestation_keygen_batch_test(void) {
+  // Check that a batch produces the same keys as individual key generations.
+  const otbn_boot_attestation_keygen_req_t reqs[] = {
+      {kCdi1AttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
+       kDiversification},
+      {kUdsAttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
+       kDiversification},
+      {kTpmEkAttestationKeySeed, kOtbnBootAttestationKeyTypeTpm,
+       kDiversification},
+  };
+  ecdsa_p256_public_key_t pks[ARRAYSIZE(reqs)];
+  RETURN_IF_ERROR(
+      otbn_boot_attestation_keygen_batch(reqs, ARRAYSIZE(reqs), pks));
+  for (size_t i = 0; i < ARRAYSIZE(reqs); ++i) {
+    ecdsa_p256_public_key_t pk;
+    RETURN_IF_ERROR(otbn_boot_attestation_keygen(
+        reqs[i].additional_seed, reqs[i].key_type, reqs[i].diversification,
+        &pk));
+    CHECK_ARRAYS_EQ((unsigned char *)&pks[i], (unsigned char *)&pk,
+                    sizeof(pk));
+  }
+  return kErrorOk;
+}
+
+rom_error_t attestation_endorse_and_key_save_test(void) {
+  // Save a first key and generate the public half of a second one.
+  ecdsa_p256_public_key_t pk0;
+  RETURN_IF_ERROR(otbn_boot_attestation_keygen(kUdsAttestationKeySeed,
+                                               kOtbnBootAttestationKeyTypeDice,
+                                               kDiversification, &pk0));
+  RETURN_IF_ERROR(otbn_boot_attestation_key_save(
+      kUdsAttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
+      kDiversification));
+  ecdsa_p256_public_key_t pk1;
+  RETURN_IF_ERROR(otbn_boot_attestation_keygen(kCdi0AttestationKeySeed,
+                                               kOtbnBootAttestationKeyTypeDice,
+                                               kDiversification, &pk1));
+
+  // Sign with the first key and save the second one in the same run.
+  hmac_digest_t digest;
+  hmac_sha256(kTestMessage, kTestMessageLen, &digest);
+  ecdsa_p256_signature_t sig;
+  RETURN_IF_ERROR(otbn_boot_attestation_endorse_and_key_save(
+      &digest, kCdi0AttestationKeySeed, kOtbnBootAttestationKeyTypeDice,
+      kDiversification, &sig));
+  uint32_t recovered_r[kEcdsaP256SignatureComponentWords];
+  RETURN_IF_ERROR(otbn_boot_sigverify(&pk0, &sig, &digest, recovered_r));
+  CHECK_ARRAYS_EQ(recovered_r, sig.r, ARRAYSIZE(sig.r));
+
+  // The saved key should now be the second one.
+  RETURN_IF_ERROR(otbn_boot_attestation_endorse(&digest, &sig));
+  RETURN_IF_ERROR(otbn_boot_sigverify(&pk1, &sig, &digest, recovered_r));
+  CHECK_ARRAYS_EQ(recovered_r, sig.r, ARRAYSIZE(sig.r));
+
+  return kErrorOk;
+}
+
 rom_error_t attestation_advance_and_endorse_test(void) {
   // Generate and save the a keypair.
   ecdsa_p256_public_key_t pk;
@@ -230,6 +287,8 @@ bool test_main(void) {
 
   EXECUTE_TEST(result, sigverify_test);
   EXECUTE_TEST(result, attestation_keygen_test);
+  EXECUTE_TEST(result, attestation_keygen_batch_test);
+  EXECUTE_TEST(result, attestation_endorse_and_key_save_test);
   EXECUTE_TEST(result, attestation_advance_and_endorse_test);
   EXECUTE_TEST(result, attestation_save_clear_key_test);
 
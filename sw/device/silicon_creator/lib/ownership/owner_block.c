@@ -4,6 +4,7 @@
 
 #include "sw/device/silicon_creator/lib/ownership/owner_block.h"
 
+#include <assert.h>
 #include <stdio.h>
 
 #include "sw/device/lib/base/bitfield.h"
@@ -19,6 +20,35 @@ enum {
   kFlashBankSize = FLASH_CTRL_PARAM_REG_PAGES_PER_BANK,
 };
 
+/**
+ * Returns the first slot to probe in the keyring index for a key.
+ *
+ * @param key_alg The algorithm of the key.
+ * @param key_id The ID of the key.
+ * @return A slot in the keyring index.
+ */
+static size_t keyring_slot(uint32_t key_alg, uint32_t key_id) {
+  static_assert(sizeof((owner_application_keyring_t){0}.index) == 32,
+                "The keyring index hash must produce 5 bits");
+  return ((key_alg ^ key_id) * 0x9e3779b1) >> 27;
+}
+
+/**
+ * Adds the last key in the keyring to the keyring index.
+ *
+ * @param keyring A pointer to the keyring.
+ */
+static void keyring_index_add(owner_application_keyring_t *keyring) {
+  static_assert(ARRAYSIZE(keyring->index) > ARRAYSIZE(keyring->key),
+                "The keyring index must always have an empty slot");
+  const owner_application_key_t *key = keyring->key[keyring->length - 1];
+  size_t slot = keyring_slot(key->key_alg, key->data.id);
+  while (keyring->index[slot] != 0) {
+    slot = (slot + 1) % ARRAYSIZE(keyring->index);
+  }
+  keyring->index[slot] = (uint8_t)keyring->length;
+}
+
 rom_error_t owner_block_parse(const owner_block_t *block,
                               owner_config_t *config,
                               owner_application_keyring_t *keyring) {
@@ -53,6 +83,7 @@ rom_error_t owner_block_parse(const owner_block_t *block,
         if (keyring->length < ARRAYSIZE(keyring->key)) {
           keyring->key[keyring->length++] =
               (const owner_application_key_t *)item;
+          keyring_index_add(keyring);
         }
         break;
       case kTlvTagFlashConfig:
@@ -182,12 +213,21 @@ rom_error_t owner_block_info_apply(const owner_flash_info_config_t *info) {
 rom_error_t owner_keyring_find_key(const owner_application_keyring_t *keyring,
                                    uint32_t key_alg, uint32_t key_id,
                                    size_t *index) {
-  for (size_t i = 0; i < keyring->length; ++i) {
-    if (keyring->key[i]->key_alg == key_alg &&
-        keyring->key[i]->data.id == key_id) {
+  size_t slot = keyring_slot(key_alg, key_id);
+  for (size_t n = 0; n < ARRAYSIZE(keyring->index); ++n) {
+    size_t i = keyring->index[slot];
+    if (i == 0 || i > keyring->length) {
+      break;
+    }
+    const owner_application_key_t *key = keyring->key[--i];
+    if (launder32(key->key_alg) == key_alg &&
+        launder32(key->data.id) == key_id) {
+      HARDENED_CHECK_EQ(key->key_alg, key_alg);
+      HARDENED_CHECK_EQ(key->data.id, key_id);
       *index = i;
       return kErrorOk;
     }
+    slot = (slot + 1) % ARRAYSIZE(keyring->index);
   }
   return kErrorOwnershipKeyNotFound;
 }
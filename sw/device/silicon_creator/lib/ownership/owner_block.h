@@ -36,6 +36,13 @@ typedef struct owner_application_keyring {
   size_t length;
   /** Pointers to the application keys. */
   const owner_application_key_t *key[16];
+  /**
+   * Hash index of the application keys by algorithm and ID.
+   *
+   * Each slot holds one plus the index of a key in `key`, or zero if the slot
+   * is empty.  Collisions are resolved by linear probing.
+   */
+  uint8_t index[32];
 } owner_application_keyring_t;
 
 /**
@@ -71,6 +78,15 @@ rom_error_t owner_block_flash_apply(const owner_flash_config_t *flash,
  */
 rom_error_t owner_block_info_apply(const owner_flash_info_config_t *info);
 
+/**
+ * Find an application key in the keyring.
+ *
+ * @param keyring A pointer to a keyring populated by `owner_block_parse`.
+ * @param key_alg The algorithm of the key.
+ * @param key_id The ID of the key.
+ * @param index The index of the key in the keyring.
+ * @return error code.
+ */
 rom_error_t owner_keyring_find_key(const owner_application_keyring_t *keyring,
                                    uint32_t key_alg, uint32_t key_id,
                                    size_t *index);
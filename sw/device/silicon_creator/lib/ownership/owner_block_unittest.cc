@@ -347,6 +347,26 @@ TEST_F(OwnerBlockTest, ParseBlock) {
   EXPECT_EQ(keyring.key[0]->header.tag, kTlvTagApplicationKey);
 }
 
+TEST_F(OwnerBlockTest, FindKey) {
+  BinaryBlob<owner_block_t> block(basic_owner, sizeof(basic_owner));
+  owner_config_t config;
+  owner_application_keyring_t keyring{};
+  rom_error_t error = owner_block_parse(block.get(), &config, &keyring);
+  EXPECT_EQ(error, kErrorOk);
+
+  uint32_t key_alg = keyring.key[0]->key_alg;
+  uint32_t key_id = keyring.key[0]->data.id;
+  size_t index = SIZE_MAX;
+  error = owner_keyring_find_key(&keyring, key_alg, key_id, &index);
+  EXPECT_EQ(error, kErrorOk);
+  EXPECT_EQ(index, 0);
+
+  error = owner_keyring_find_key(&keyring, key_alg, key_id + 1, &index);
+  EXPECT_EQ(error, kErrorOwnershipKeyNotFound);
+  error = owner_keyring_find_key(&keyring, key_alg + 1, key_id, &index);
+  EXPECT_EQ(error, kErrorOwnershipKeyNotFound);
+}
+
 TEST_F(OwnerBlockTest, ParseBlockBadHeader) {
   BinaryBlob<owner_block_t> block(basic_owner, sizeof(basic_owner));
   // Rewrite the header length to a bad value
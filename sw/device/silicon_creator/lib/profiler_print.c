@@ -0,0 +1,32 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/profiler_print.h"
+
+#include "sw/device/lib/base/profiler.h"
+#include "sw/device/silicon_creator/lib/drivers/uart.h"
+
+#ifdef OT_PROFILER
+void profiler_print(void) {
+  //                          : F R P
+  const uint32_t kPrefix = 0x3a465250;
+  size_t count = profiler_site_count();
+  for (size_t i = 0; i < count; ++i) {
+    const profiler_site_t *site = profiler_site_get(i);
+    uart_write_imm(kPrefix);
+    for (const char *c = site->name; *c != '\0'; ++c) {
+      uart_write_imm((uint8_t)*c);
+    }
+    uart_write_imm(' ');
+    uart_write_hex(site->count, sizeof(site->count), '/');
+    uart_write_hex(site->min, sizeof(site->min), '/');
+    uart_write_hex(site->max, sizeof(site->max), '/');
+    uart_write_hex((uint32_t)(site->total >> 32), sizeof(uint32_t), 0);
+    uart_write_hex((uint32_t)site->total, sizeof(uint32_t), '\r');
+    // Send the last char with putchar so we'll wait for the
+    // transmitter to finish.
+    uart_putchar('\n');
+  }
+}
+#endif
@@ -0,0 +1,30 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_PROFILER_PRINT_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_PROFILER_PRINT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Print the cycle counts of the sites profiled so far.
+ *
+ * Each site is printed as `PRF:<name> <count>/<min>/<max>/<total>` with the
+ * numbers in hex.
+ */
+#ifdef OT_PROFILER
+void profiler_print(void);
+#else
+#define profiler_print() \
+  do {                   \
+  } while (0)
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_PROFILER_PRINT_H_
@@ -42,6 +42,15 @@ static_assert(
         OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_LOCAL_ALERT_CLASSIFICATION_SIZE / 4,
     "More local alerts than local alert classification OTP words!");
 
+enum {
+  /**
+   * Number of alert classification words read from OTP at once.
+   *
+   * Bounds the stack used by `shutdown_init()`.
+   */
+  kOtpBurstWords = 16,
+};
+
 #define NO_MODIFIERS
 
 #ifndef OT_PLATFORM_RV32
@@ -145,14 +154,21 @@ rom_error_t shutdown_init(lifecycle_state_t lc_state) {
   }
 
   // For each alert, read its corresponding OTP word and extract the class
-  // configuration for the current lifecycle state.
+  // configuration for the current lifecycle state. The OTP words are fetched
+  // in bursts of `kOtpBurstWords` to amortize the cost of the reads.
+  uint32_t words[kOtpBurstWords];
   for (i = 0; launder32(i) < ALERT_HANDLER_ALERT_CLASS_SHADOWED_MULTIREG_COUNT;
        ++i) {
-    uint32_t value =
-        otp_read32(OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_ALERT_CLASSIFICATION_OFFSET +
-                   i * sizeof(uint32_t));
+    size_t word = i % kOtpBurstWords;
+    if (word == 0) {
+      size_t remaining = ALERT_HANDLER_ALERT_CLASS_SHADOWED_MULTIREG_COUNT - i;
+      otp_read(OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_ALERT_CLASSIFICATION_OFFSET +
+                   i * sizeof(uint32_t),
+               words,
+               remaining < kOtpBurstWords ? remaining : kOtpBurstWords);
+    }
     alert_class_t cls = (alert_class_t)bitfield_field32_read(
-        value, (bitfield_field32_t){.mask = 0xff, .index = lc_shift});
+        words[word], (bitfield_field32_t){.mask = 0xff, .index = lc_shift});
     rom_error_t e = alert_configure(i, cls, enable[clsindex(cls)]);
     if (e != kErrorOk) {
       // Keep going if there is an error programming one alert.  We want to
@@ -169,11 +185,17 @@ rom_error_t shutdown_init(lifecycle_state_t lc_state) {
   for (i = 0;
        launder32(i) < ALERT_HANDLER_LOC_ALERT_CLASS_SHADOWED_MULTIREG_COUNT;
        ++i) {
-    uint32_t value = otp_read32(
-        OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_LOCAL_ALERT_CLASSIFICATION_OFFSET +
-        i * sizeof(uint32_t));
+    size_t word = i % kOtpBurstWords;
+    if (word == 0) {
+      size_t remaining =
+          ALERT_HANDLER_LOC_ALERT_CLASS_SHADOWED_MULTIREG_COUNT - i;
+      otp_read(
+          OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_LOCAL_ALERT_CLASSIFICATION_OFFSET +
+              i * sizeof(uint32_t),
+          words, remaining < kOtpBurstWords ? remaining : kOtpBurstWords);
+    }
     alert_class_t cls = (alert_class_t)bitfield_field32_read(
-        value, (bitfield_field32_t){.mask = 0xff, .index = lc_shift});
+        words[word], (bitfield_field32_t){.mask = 0xff, .index = lc_shift});
     rom_error_t e = alert_local_configure(i, cls, enable[clsindex(cls)]);
     if (e != kErrorOk) {
       // Keep going if there is an error programming one alert.  We want to
@@ -207,15 +229,9 @@ rom_error_t shutdown_init(lifecycle_state_t lc_state) {
     config.timeout_cycles =
         otp_read32(OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_ALERT_TIMEOUT_CYCLES_OFFSET +
                    i * sizeof(uint32_t));
-    size_t phase = 0;
-    for (; launder32(phase) < ARRAYSIZE(config.phase_cycles); ++phase) {
-      config.phase_cycles[phase] = otp_read32(
-          OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_ALERT_PHASE_CYCLES_OFFSET +
-          (i * ARRAYSIZE(config.phase_cycles) + phase) * sizeof(uint32_t));
-    }
-    if (phase != ARRAYSIZE(config.phase_cycles)) {
-      error = kErrorUnknown;
-    }
+    otp_read(OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_ALERT_PHASE_CYCLES_OFFSET +
+                 i * sizeof(config.phase_cycles),
+             config.phase_cycles, ARRAYSIZE(config.phase_cycles));
 
     rom_error_t e = alert_class_configure(kClasses[i], &config);
     if (e != kErrorOk) {
@@ -314,6 +314,13 @@ class ShutdownTest : public rom_test::RomTest {
           reinterpret_cast<const uint32_t *>(&this->otp_config_);
       return words[index];
     });
+    ON_CALL(otp_, read(::testing::_, ::testing::_, ::testing::_))
+        .WillByDefault(
+            [this](uint32_t address, uint32_t *data, size_t num_words) {
+              for (size_t i = 0; i < num_words; ++i) {
+                data[i] = otp_.read32(address + i * sizeof(uint32_t));
+              }
+            });
   }
 
   void ExpectClassConfigure() {
@@ -39,6 +39,36 @@ rom_error_t sigverify_ecdsa_p256_verify(const ecdsa_p256_signature_t *signature,
                                         const hmac_digest_t *act_digest,
                                         uint32_t *flash_exec);
 
+/**
+ * Starts verifying an ECDSA-P256 signature on OTBN.
+ *
+ * Returns while OTBN is still running, so that other work that does not use
+ * OTBN (e.g. SPHINCS+ verification) can proceed on Ibex in the meantime. The
+ * verification must be completed with `sigverify_ecdsa_p256_finish()`.
+ *
+ * @param signature The signature to verify, little endian.
+ * @param key The public key to use for verification, little endian.
+ * @param act_digest The actual digest of the signed message.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sigverify_ecdsa_p256_start(const ecdsa_p256_signature_t *signature,
+                                       const ecdsa_p256_public_key_t *key,
+                                       const hmac_digest_t *act_digest);
+
+/**
+ * Completes a verification started with `sigverify_ecdsa_p256_start()`.
+ *
+ * @param signature The signature to verify, little endian. Must be the same as
+ * the one passed to `sigverify_ecdsa_p256_start()`.
+ * @param[out] flash_exec The partial value to write to the flash_ctrl EXEC
+ * register.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sigverify_ecdsa_p256_finish(const ecdsa_p256_signature_t *signature,
+                                        uint32_t *flash_exec);
+
 /**
  * Transforms `kSigverifyEcdsaSuccess` into `kErrorOk`.
  *
@@ -4,6 +4,7 @@
 
 #include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex.h"
 
+#include <assert.h>
 #include <stddef.h>
 
 #include "sw/device/lib/base/macros.h"
@@ -91,6 +92,8 @@ static void mont_mul(const sigverify_rsa_key_t *key,
                      const sigverify_rsa_buffer_t *x,
                      const sigverify_rsa_buffer_t *y,
                      sigverify_rsa_buffer_t *result) {
+  static_assert(kSigVerifyRsaNumWords % 2 == 0,
+                "The inner loop of `mont_mul` must be updated");
   memset(result->data, 0, sizeof(result->data));
 
   for (size_t i = 0; i < ARRAYSIZE(x->data); ++i) {
@@ -109,12 +112,24 @@ static void mont_mul(const sigverify_rsa_key_t *key,
     // Holds the sum of the all three addends in step 2.2.
     uint64_t acc1 = (uint64_t)u_i * key->n.data[0] + (uint32_t)acc0;
 
-    // Process the i^th digit of `x`, i.e. `x[i]`.
-    for (size_t j = 1; j < ARRAYSIZE(result->data); ++j) {
-      acc0 = (uint64_t)x->data[i] * y->data[j] + result->data[j] + (acc0 >> 32);
+    // Process the i^th digit of `x`, i.e. `x[i]`. The loop is unrolled by two
+    // to halve the loop overhead, which is significant next to the two
+    // multiplications per digit on Ibex. The last digit is processed
+    // separately since there is an odd number of digits after the first.
+    const uint32_t x_i = x->data[i];
+    size_t j = 1;
+    for (; j < ARRAYSIZE(result->data) - 1; j += 2) {
+      acc0 = (uint64_t)x_i * y->data[j] + result->data[j] + (acc0 >> 32);
       acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)acc0 + (acc1 >> 32);
       result->data[j - 1] = (uint32_t)acc1;
+      acc0 =
+          (uint64_t)x_i * y->data[j + 1] + result->data[j + 1] + (acc0 >> 32);
+      acc1 = (uint64_t)u_i * key->n.data[j + 1] + (uint32_t)acc0 + (acc1 >> 32);
+      result->data[j] = (uint32_t)acc1;
     }
+    acc0 = (uint64_t)x_i * y->data[j] + result->data[j] + (acc0 >> 32);
+    acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)acc0 + (acc1 >> 32);
+    result->data[j - 1] = (uint32_t)acc1;
     acc0 = (acc0 >> 32) + (acc1 >> 32);
     result->data[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
 
@@ -20,41 +20,6 @@
 // into a single byte.
 static_assert(sizeof(uint8_t) <= kSpxWotsLogW,
               "Base-w integers must fit in a `uint8_t`.");
-/**
- * Computes the chaining function.
- *
- * Interprets `in` as the value of the chain at index `start`. `addr` must
- * contain the address of the chain.
- *
- * The chain `hash` value that is incremented at each step is stored in a
- * single byte, so the caller must ensure that `start + steps <= UINT8_MAX`.
- *
- * @param in Input buffer (`kSpxN` bytes).
- * @param start Start index.
- * @param steps Number of steps.
- * @param addr Hypertree address.
- * @param[out] Output buffer (`kSpxNWords` words).
- */
-static void gen_chain(const uint32_t *in, uint8_t start, const spx_ctx_t *ctx,
-                      spx_addr_t *addr, uint32_t *out) {
-  // Initialize out with the value at position `start`.
-  memcpy(out, in, kSpxN);
-
-  // Iterate `kSpxWotsW - 1` calls to the hash function. This loop is
-  // performance-critical.
-  spx_addr_hash_set(addr, start);
-  for (uint8_t i = start; i + 1 < kSpxWotsW; i++) {
-    // This loop body is essentially just `thash`, inlined for performance.
-    hmac_sha256_restore(&ctx->state_seeded);
-    hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
-    hmac_sha256_update_words(out, kSpxNWords);
-    hmac_sha256_process();
-    // Update the address while HMAC is processing for performance reasons.
-    spx_addr_hash_set(addr, i + 1);
-    hmac_sha256_final_truncated(out, kSpxNWords);
-  }
-}
-
 /**
  * Interprets an array of bytes as integers in base w.
  *
@@ -135,6 +100,23 @@ static void chain_lengths(const uint32_t *msg, uint8_t *lengths) {
   wots_checksum(lengths, &lengths[kSpxWotsLen1]);
 }
 
+/**
+ * Find the next chain that still needs hashing.
+ *
+ * A chain needs hashing unless the signature already holds its final value,
+ * i.e. its start index is `kSpxWotsW - 1`.
+ *
+ * @param lengths Chain start indices (`kSpxWotsLen` entries).
+ * @param chain Index of the first chain to consider.
+ * @return Index of the next chain to hash, or `kSpxWotsLen` if there is none.
+ */
+static uint8_t next_chain(const uint8_t *lengths, uint8_t chain) {
+  while (chain < kSpxWotsLen && lengths[chain] + 1 >= kSpxWotsW) {
+    chain++;
+  }
+  return chain;
+}
+
 static_assert(kSpxWotsLen - 1 <= UINT8_MAX,
               "Maximum chain value must fit into a `uint8_t`");
 void wots_pk_from_sig(const uint32_t *sig, const uint32_t *msg,
@@ -142,9 +124,42 @@ void wots_pk_from_sig(const uint32_t *sig, const uint32_t *msg,
   uint8_t lengths[kSpxWotsLen];
   chain_lengths(msg, lengths);
 
-  for (uint8_t i = 0; i < kSpxWotsLen; i++) {
-    spx_addr_chain_set(addr, i);
-    size_t word_offset = i * kSpxNWords;
-    gen_chain(sig + word_offset, lengths[i], ctx, addr, pk + word_offset);
+  // Each chain starts from its signature block; chains that start at the end
+  // are already done.
+  memcpy(pk, sig, kSpxWotsBytes);
+
+  // Compute the remaining chaining function steps of all chains as a single
+  // stream of hashes. Each step depends on the previous step of the same
+  // chain, so only one step can be in flight. While HMAC processes it, the
+  // address for the next step, which may belong to the next chain, is prepared
+  // on Ibex. This loop is performance-critical.
+  uint8_t chain = next_chain(lengths, 0);
+  if (chain == kSpxWotsLen) {
+    return;
+  }
+  uint8_t hash = lengths[chain];
+  spx_addr_chain_set(addr, chain);
+  spx_addr_hash_set(addr, hash);
+  while (chain < kSpxWotsLen) {
+    uint32_t *out = pk + chain * kSpxNWords;
+
+    // This is essentially just `thash`, inlined for performance.
+    hmac_sha256_restore(&ctx->state_seeded);
+    hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
+    hmac_sha256_update_words(out, kSpxNWords);
+    hmac_sha256_process();
+
+    // Update the address while HMAC is processing for performance reasons.
+    hash++;
+    if (hash + 1 >= kSpxWotsW) {
+      chain = next_chain(lengths, chain + 1);
+      if (chain < kSpxWotsLen) {
+        hash = lengths[chain];
+        spx_addr_chain_set(addr, chain);
+      }
+    }
+    spx_addr_hash_set(addr, hash);
+
+    hmac_sha256_final_truncated(out, kSpxNWords);
   }
 }
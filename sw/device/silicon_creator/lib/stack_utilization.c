@@ -4,11 +4,35 @@
 
 #include "sw/device/silicon_creator/lib/stack_utilization.h"
 
+#include "sw/device/silicon_creator/lib/drivers/ibex.h"
 #include "sw/device/silicon_creator/lib/drivers/uart.h"
 
 #ifdef STACK_UTILIZATION_CHECK
-void stack_utilization_print(void) {
-  extern uint32_t _stack_start[], _stack_end[];
+enum {
+  /**
+   * Number of marks the buffer has room for.
+   */
+  kStackUtilizationMarks = 48,
+};
+
+/**
+ * A point of the boot flow recorded by `stack_utilization_mark()`.
+ */
+typedef struct stack_utilization_mark {
+  uint32_t id;
+  uint32_t mcycle;
+  uint32_t used;
+} stack_utilization_mark_t;
+
+static stack_utilization_mark_t marks[kStackUtilizationMarks];
+static uint32_t mark_count;
+
+extern uint32_t _stack_start[], _stack_end[];
+
+/**
+ * Returns the number of bytes of the stack that have been used so far.
+ */
+static uint32_t stack_used(void) {
   // We configure a No-Access ePMP NA4 region at stack_start as a
   // stack guard.  We cannot access that word, so start the scan
   // after the stack guard.
@@ -19,7 +43,33 @@ void stack_utilization_print(void) {
     free += sizeof(uint32_t);
     sp++;
   }
-  uint32_t used = total - free;
+  return total - free;
+}
+
+void stack_utilization_mark(uint32_t id) {
+  uint32_t mcycle = ibex_mcycle32();
+  if (mark_count < kStackUtilizationMarks) {
+    marks[mark_count++] = (stack_utilization_mark_t){
+        .id = id,
+        .mcycle = mcycle,
+        .used = stack_used(),
+    };
+  }
+}
+
+void stack_utilization_print(void) {
+  //                          : K R M
+  const uint32_t kMarkPrefix = 0x3a4b524d;
+  for (uint32_t i = 0; i < mark_count; ++i) {
+    uart_write_imm(kMarkPrefix);
+    uart_write_hex(marks[i].id, sizeof(marks[i].id), ' ');
+    uart_write_hex(marks[i].mcycle, sizeof(marks[i].mcycle), '/');
+    uart_write_hex(marks[i].used, sizeof(marks[i].used), '\r');
+    uart_putchar('\n');
+  }
+
+  uint32_t used = stack_used();
+  uint32_t total = (uintptr_t)_stack_end - (uintptr_t)_stack_start;
   //                          : K T S
   const uint32_t kPrefix = 0x3a4b5453;
   uart_write_imm(kPrefix);
@@ -14,6 +14,9 @@ extern "C" {
 
 /**
  * Examine stack utilization.
+ *
+ * Also prints the marks recorded with `stack_utilization_mark()`, one line
+ * each, as `MRK:<id> <mcycle>/<used>` with the numbers in hex.
  */
 #ifdef STACK_UTILIZATION_CHECK
 void stack_utilization_print(void);
@@ -23,6 +26,21 @@ void stack_utilization_print(void);
   } while (0)
 #endif
 
+/**
+ * Record the cycle count and stack utilization at a point of the boot flow.
+ *
+ * Marks beyond the capacity of the static buffer are dropped.
+ *
+ * @param id Identifier of the point, e.g. a CFI counter and step.
+ */
+#ifdef STACK_UTILIZATION_CHECK
+void stack_utilization_mark(uint32_t id);
+#else
+#define stack_utilization_mark(id_) \
+  do {                              \
+  } while (0)
+#endif
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,93 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/verify_cache.h"
+
+#include <stddef.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/silicon_creator/lib/drivers/keymgr.h"
+#include "sw/device/silicon_creator/lib/drivers/kmac.h"
+
+static const sc_keymgr_diversification_t kVerifyCacheDiversifier = {
+    .salt = {0x56434143, 0x8a3f1c5e, 0x2d7b94e1, 0xc16e0f38, 0x5f92a7d4,
+             0xe04b3c69, 0x3a8d5127, 0x97c2e6b0},
+    .version = 0,
+};
+
+/**
+ * Computes the seal of `cache`.
+ *
+ * Sideloads a sealing key into KMAC for the duration of the computation. The
+ * sideloaded key is cleared and KMAC is handed back to the key manager
+ * regardless of the outcome.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t seal_compute(const verify_cache_t *cache, uint32_t *seal) {
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_generate_key(
+      kScKeymgrDestKmac, kScKeymgrKeyTypeSealing, kVerifyCacheDiversifier));
+  rom_error_t error = kmac_kmac256_hw_configure();
+  if (launder32(error) == kErrorOk) {
+    kmac_kmac256_set_prefix("VerifyCache", 11);
+    error = kmac_kmac256_start();
+  }
+  if (launder32(error) == kErrorOk) {
+    kmac_kmac256_absorb(cache, offsetof(verify_cache_t, seal));
+    error = kmac_kmac256_final(seal, ARRAYSIZE(cache->seal));
+  }
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_sideload_clear(kScKeymgrDestKmac));
+  HARDENED_RETURN_IF_ERROR(kmac_keymgr_configure());
+  return error;
+}
+
+rom_error_t verify_cache_check(const verify_cache_t *cache, uint32_t key_id,
+                               lifecycle_state_t lc_state,
+                               const hmac_digest_t *digest) {
+  // Cheap rejection of entries that cannot match before paying for KMAC.
+  if (cache->identifier != kVerifyCacheIdentifier ||
+      cache->key_id != key_id || cache->lc_state != lc_state ||
+      memcmp(&cache->digest, digest, sizeof(*digest)) != 0) {
+    return kErrorRetRamVerifyCacheInvalid;
+  }
+
+  // Seal the expected values rather than the stored ones so that the result
+  // only depends on the stored `seal`.
+  verify_cache_t expected = {
+      .identifier = kVerifyCacheIdentifier,
+      .key_id = key_id,
+      .lc_state = lc_state,
+      .digest = *digest,
+  };
+  HARDENED_RETURN_IF_ERROR(seal_compute(&expected, expected.seal));
+  hardened_bool_t result =
+      hardened_memeq(cache->seal, expected.seal, ARRAYSIZE(cache->seal));
+  if (launder32(result) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(result, kHardenedBoolTrue);
+    // Translate to kErrorOk.  A cast is sufficient because kHardenedBoolTrue
+    // and kErrorOk have the same bit pattern.
+    return (rom_error_t)result;
+  }
+  return kErrorRetRamVerifyCacheInvalid;
+}
+
+rom_error_t verify_cache_update(verify_cache_t *cache, uint32_t key_id,
+                                lifecycle_state_t lc_state,
+                                const hmac_digest_t *digest) {
+  verify_cache_invalidate(cache);
+  verify_cache_t entry = {
+      .identifier = kVerifyCacheIdentifier,
+      .key_id = key_id,
+      .lc_state = lc_state,
+      .digest = *digest,
+  };
+  HARDENED_RETURN_IF_ERROR(seal_compute(&entry, entry.seal));
+  *cache = entry;
+  return kErrorOk;
+}
+
+void verify_cache_invalidate(verify_cache_t *cache) {
+  memset(cache, 0, sizeof(*cache));
+}
@@ -0,0 +1,105 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_VERIFY_CACHE_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_VERIFY_CACHE_H_
+
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
+#include "sw/device/silicon_creator/lib/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Record of the last next-stage image whose signature was verified.
+ *
+ * The ROM_EXT keeps this record in the retention SRAM so that, on a reset
+ * that preserves the retention SRAM, it can skip the signature verification
+ * of an image whose freshly computed digest matches the one recorded here.
+ * The image is always re-hashed; only the signature check is elided.
+ *
+ * The record is sealed with a key manager sealing key that is only available
+ * to the ROM_EXT, so later boot stages cannot forge an entry.
+ */
+typedef struct verify_cache {
+  /** Identifier (`VCAC`). */
+  uint32_t identifier;
+  /** ID of the key that verified the image. */
+  uint32_t key_id;
+  /** Life cycle state the image was verified in. */
+  uint32_t lc_state;
+  /** Digest of the signed region of the image. */
+  hmac_digest_t digest;
+  /** KMAC over all preceding fields. */
+  uint32_t seal[8];
+} verify_cache_t;
+
+OT_ASSERT_MEMBER_OFFSET(verify_cache_t, identifier, 0);
+OT_ASSERT_MEMBER_OFFSET(verify_cache_t, key_id, 4);
+OT_ASSERT_MEMBER_OFFSET(verify_cache_t, lc_state, 8);
+OT_ASSERT_MEMBER_OFFSET(verify_cache_t, digest, 12);
+OT_ASSERT_MEMBER_OFFSET(verify_cache_t, seal, 44);
+OT_ASSERT_SIZE(verify_cache_t, 76);
+
+enum {
+  /**
+   * Verify cache identifier value (ASCII "VCAC").
+   */
+  kVerifyCacheIdentifier = 0x43414356,
+};
+
+/**
+ * Checks whether the verify cache vouches for an image.
+ *
+ * The entry must carry the cache identifier, match all of `key_id`,
+ * `lc_state` and `digest`, and have a valid seal.
+ *
+ * The key manager must be in a state that can generate sealing keys. This
+ * function uses KMAC with a sideloaded key and restores the key manager KMAC
+ * configuration before returning.
+ *
+ * @param cache The verify cache entry.
+ * @param key_id ID of the key the image is signed with.
+ * @param lc_state Current life cycle state.
+ * @param digest Digest of the image.
+ * @return `kErrorOk` if the entry is valid for the given image.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t verify_cache_check(const verify_cache_t *cache, uint32_t key_id,
+                               lifecycle_state_t lc_state,
+                               const hmac_digest_t *digest);
+
+/**
+ * Records a successfully verified image in the verify cache.
+ *
+ * Same key manager requirements as `verify_cache_check()`.
+ *
+ * @param[out] cache The verify cache entry.
+ * @param key_id ID of the key that verified the image.
+ * @param lc_state Current life cycle state.
+ * @param digest Digest of the image.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t verify_cache_update(verify_cache_t *cache, uint32_t key_id,
+                                lifecycle_state_t lc_state,
+                                const hmac_digest_t *digest);
+
+/**
+ * Invalidates the verify cache entry.
+ *
+ * @param[out] cache The verify cache entry.
+ */
+void verify_cache_invalidate(verify_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_VERIFY_CACHE_H_
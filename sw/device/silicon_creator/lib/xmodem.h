@@ -24,6 +24,16 @@ void xmodem_recv_start(void *iohandle);
  */
 void xmodem_ack(void *iohandle, bool ack);
 
+/**
+ * Discard incoming data until the line has been idle for a short while.
+ *
+ * Used to drop frames that are already in flight before NAKing a window of
+ * frames.
+ *
+ * @param iohandle An opaque user point associated with the io device.
+ */
+void xmodem_recv_purge(void *iohandle);
+
 /**
  * Receive a frame using Xmodem-CRC
  *
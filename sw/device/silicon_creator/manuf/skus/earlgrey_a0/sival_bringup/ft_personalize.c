@@ -4,6 +4,7 @@
 
 #include "sw/device/lib/arch/device.h"
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
 #include "sw/device/lib/dif/dif_flash_ctrl.h"
 #include "sw/device/lib/dif/dif_lc_ctrl.h"
@@ -138,6 +139,12 @@ static const unsigned char *kEndorsedTpmCerts[] = {
     endorsed_certs.tpm_cik_certificate,
 };
 
+/**
+ * Staging buffer for the contents of a certificate flash info page.
+ */
+static uint32_t cert_page_buf[FLASH_CTRL_PARAM_BYTES_PER_PAGE /
+                              sizeof(uint32_t)];
+
 /**
  * Certificates flash info page layout.
  */
@@ -422,23 +429,31 @@ static status_t personalize_dice_certificates(ujson_t *uj) {
   /*****************************************************************************
    * TPM certificates.
    ****************************************************************************/
-  // Generate TPM EK keys and (TBS) cert.
-  TRY(dice_attestation_keygen(kDiceKeyTpmEk, &tpm_pubkey_id, &curr_pubkey));
-  TRY(dice_tpm_ek_tbs_cert_build(&tpm_key_ids, &curr_pubkey,
+  // Generate all TPM keys at once, since they come from the same keymgr stage.
+  static const dice_key_t kTpmKeys[] = {kDiceKeyTpmEk, kDiceKeyTpmCek,
+                                        kDiceKeyTpmCik};
+  hmac_digest_t tpm_pubkey_ids[ARRAYSIZE(kTpmKeys)];
+  ecdsa_p256_public_key_t tpm_pubkeys[ARRAYSIZE(kTpmKeys)];
+  TRY(dice_attestation_keygen_batch(kTpmKeys, ARRAYSIZE(kTpmKeys),
+                                    tpm_pubkey_ids, tpm_pubkeys));
+
+  // Generate TPM EK (TBS) cert.
+  tpm_pubkey_id = tpm_pubkey_ids[0];
+  TRY(dice_tpm_ek_tbs_cert_build(&tpm_key_ids, &tpm_pubkeys[0],
                                  tbs_certs.tpm_ek_tbs_certificate,
                                  &tbs_certs.tpm_ek_tbs_certificate_size));
   LOG_INFO("Generated TPM EK TBS certificate.");
 
-  // Generate TPM CEK keys and (TBS) cert.
-  TRY(dice_attestation_keygen(kDiceKeyTpmCek, &tpm_pubkey_id, &curr_pubkey));
-  TRY(dice_tpm_cek_tbs_cert_build(&tpm_key_ids, &curr_pubkey,
+  // Generate TPM CEK (TBS) cert.
+  tpm_pubkey_id = tpm_pubkey_ids[1];
+  TRY(dice_tpm_cek_tbs_cert_build(&tpm_key_ids, &tpm_pubkeys[1],
                                   tbs_certs.tpm_cek_tbs_certificate,
                                   &tbs_certs.tpm_cek_tbs_certificate_size));
   LOG_INFO("Generated TPM CEK TBS certificate.");
 
-  // Generate TPM CIK keys and (TBS) cert.
-  TRY(dice_attestation_keygen(kDiceKeyTpmCik, &tpm_pubkey_id, &curr_pubkey));
-  TRY(dice_tpm_cik_tbs_cert_build(&tpm_key_ids, &curr_pubkey,
+  // Generate TPM CIK (TBS) cert.
+  tpm_pubkey_id = tpm_pubkey_ids[2];
+  TRY(dice_tpm_cik_tbs_cert_build(&tpm_key_ids, &tpm_pubkeys[2],
                                   tbs_certs.tpm_cik_tbs_certificate,
                                   &tbs_certs.tpm_cik_tbs_certificate_size));
   LOG_INFO("Generated TPM CIK TBS certificate.");
@@ -461,9 +476,13 @@ static status_t personalize_dice_certificates(ujson_t *uj) {
   /*****************************************************************************
    * Save Certificates to Flash.
    ****************************************************************************/
+  // The certificates of each page are staged in RAM and programmed with a
+  // single write since the pages were erased in
+  // `config_and_erase_certificate_flash_pages()`.
   for (size_t i = 0; i < ARRAYSIZE(kCertFlashInfoLayout); i++) {
     uint32_t page_offset = 0;
     const cert_flash_info_layout_t curr_layout = kCertFlashInfoLayout[i];
+    memset(cert_page_buf, 0xff, sizeof(cert_page_buf));
     for (size_t j = 0; j < curr_layout.num_certs; j++) {
       // Number of words necessary for certificate storage.
       uint32_t cert_size_words = util_size_to_words(
@@ -475,15 +494,19 @@ static status_t personalize_dice_certificates(ujson_t *uj) {
                   curr_layout.group_name, curr_layout.names[j]);
         return OUT_OF_RANGE();
       }
-      TRY(flash_ctrl_info_write(curr_layout.info_page, page_offset,
-                                cert_size_words, curr_layout.certs[j]));
-      LOG_INFO("Imported %s %s certificate.", curr_layout.group_name,
-               curr_layout.names[j]);
+      memcpy((unsigned char *)cert_page_buf + page_offset,
+             curr_layout.certs[j], cert_size_bytes);
       page_offset += cert_size_bytes;
 
       // Each certificate must be 8 bytes aligned (flash word size).
       page_offset = util_round_up_to(page_offset, 3);
     }
+    TRY(flash_ctrl_info_write(curr_layout.info_page, /*offset=*/0,
+                              page_offset / sizeof(uint32_t), cert_page_buf));
+    for (size_t j = 0; j < curr_layout.num_certs; j++) {
+      LOG_INFO("Imported %s %s certificate.", curr_layout.group_name,
+               curr_layout.names[j]);
+    }
   }
 
   // DO NOT CHANGE THE BELOW STRING without modifying the host code in
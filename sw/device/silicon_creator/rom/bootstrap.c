@@ -19,8 +19,14 @@
 rom_error_t bootstrap_chip_erase(void) {
   flash_ctrl_bank_erase_perms_set(kHardenedBoolTrue);
   rom_error_t err_0 = flash_ctrl_data_erase(0, kFlashCtrlEraseTypeBank);
-  rom_error_t err_1 = flash_ctrl_data_erase(FLASH_CTRL_PARAM_BYTES_PER_BANK,
-                                            kFlashCtrlEraseTypeBank);
+  flash_ctrl_data_erase_start(FLASH_CTRL_PARAM_BYTES_PER_BANK,
+                              kFlashCtrlEraseTypeBank);
+  // Bank 0 remains readable while bank 1 is being erased, so verify it here
+  // instead of in `bootstrap_erase_verify()`.
+  if (launder32(err_0) == kErrorOk) {
+    err_0 = flash_ctrl_data_erase_verify(0, kFlashCtrlEraseTypeBank);
+  }
+  rom_error_t err_1 = flash_ctrl_data_erase_finish();
   flash_ctrl_bank_erase_perms_set(kHardenedBoolFalse);
 
   HARDENED_RETURN_IF_ERROR(err_0);
@@ -28,11 +34,9 @@ rom_error_t bootstrap_chip_erase(void) {
 }
 
 rom_error_t bootstrap_erase_verify(void) {
-  rom_error_t err_0 = flash_ctrl_data_erase_verify(0, kFlashCtrlEraseTypeBank);
-  rom_error_t err_1 = flash_ctrl_data_erase_verify(
-      FLASH_CTRL_PARAM_BYTES_PER_BANK, kFlashCtrlEraseTypeBank);
-  HARDENED_RETURN_IF_ERROR(err_0);
-  return err_1;
+  // Bank 0 has already been verified by `bootstrap_chip_erase()`.
+  return flash_ctrl_data_erase_verify(FLASH_CTRL_PARAM_BYTES_PER_BANK,
+                                      kFlashCtrlEraseTypeBank);
 }
 
 hardened_bool_t bootstrap_requested(void) {
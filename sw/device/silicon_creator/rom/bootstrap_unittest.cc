@@ -79,7 +79,7 @@ TEST_F(BootstrapTest, PayloadOverflowProgram) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   EXPECT_CALL(spi_device_, CmdGet(NotNull()))
@@ -96,7 +96,7 @@ TEST_F(BootstrapTest, BootstrapSimple) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(0, 16);
@@ -127,7 +127,7 @@ TEST_F(BootstrapTest, BootstrapOddPayload) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(0, 17);
@@ -161,7 +161,7 @@ TEST_F(BootstrapTest, BootstrapMisalignedAddrLongPayload) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(0xfff0, 256);
@@ -195,7 +195,7 @@ TEST_F(BootstrapTest, BootstrapMisalignedAddrShortPayload) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(816, 8);
@@ -226,7 +226,7 @@ TEST_F(BootstrapTest, BootstrapStartWithSectorErase) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(0, 16);
@@ -259,7 +259,7 @@ TEST_F(BootstrapTest, BootstrapProgramWithErase) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(0, 16);
@@ -303,7 +303,7 @@ TEST_F(BootstrapTest, MisalignedEraseAddress) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Erase with misaligned and aligned addresses
   ExpectSpiCmd(SectorEraseCmd(5));
@@ -340,7 +340,7 @@ TEST_F(BootstrapTest, IgnoredCommands) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Phase 1: Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Phase 2: Erase/Program
   ExpectSpiCmd(SectorEraseCmd(0));
@@ -382,9 +382,8 @@ TEST_F(BootstrapTest, EraseVerifyBank0Error) {
   EXPECT_CALL(spi_device_, Init());
   ExpectSpiCmd(ChipEraseCmd());
   ExpectSpiFlashStatusGet(true);
-  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
-  // Verify
-  ExpectFlashCtrlEraseVerify(kErrorUnknown, kErrorOk);
+  // Bank 0 is verified during the chip erase.
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk, kErrorUnknown);
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
 }
@@ -397,7 +396,7 @@ TEST_F(BootstrapTest, EraseVerifyBank1Error) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorUnknown);
+  ExpectFlashCtrlEraseVerify(kErrorUnknown);
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
 }
@@ -410,7 +409,7 @@ TEST_F(BootstrapTest, DataWriteError) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(0, 16);
@@ -426,6 +425,8 @@ TEST_F(BootstrapTest, DataWriteError) {
                         HasBytes(flash_bytes)))
       .WillOnce(Return(kErrorUnknown));
   ExpectFlashCtrlAllDisable();
+  // Status is released before programming.
+  EXPECT_CALL(spi_device_, FlashStatusClear());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
 }
@@ -438,7 +439,7 @@ TEST_F(BootstrapTest, DataWriteErrorMisalignedAddr) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto cmd = PageProgramCmd(0xf0, 16);
@@ -452,6 +453,8 @@ TEST_F(BootstrapTest, DataWriteErrorMisalignedAddr) {
   EXPECT_CALL(flash_ctrl_, DataWrite(0xf0, 4, HasBytes(flash_bytes)))
       .WillOnce(Return(kErrorUnknown));
   ExpectFlashCtrlAllDisable();
+  // Status is released before programming.
+  EXPECT_CALL(spi_device_, FlashStatusClear());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
 }
@@ -464,7 +467,7 @@ TEST_F(BootstrapTest, BadProgramAddress) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
   auto page_program_cmd = PageProgramCmd(3, 16);
@@ -482,7 +485,7 @@ TEST_F(BootstrapTest, BadEraseAddress) {
   ExpectSpiFlashStatusGet(true);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   // Verify
-  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  ExpectFlashCtrlEraseVerify(kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Erase
   ExpectSpiCmd(SectorEraseCmd(FLASH_CTRL_PARAM_BYTES_PER_BANK *
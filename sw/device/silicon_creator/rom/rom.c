@@ -14,6 +14,7 @@
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/profiler.h"
 #include "sw/device/lib/base/stdasm.h"
 #include "sw/device/silicon_creator/lib/base/boot_measurements.h"
 #include "sw/device/silicon_creator/lib/base/sec_mmio.h"
@@ -42,6 +43,7 @@
 #include "sw/device/silicon_creator/lib/otbn_boot_services.h"
 #include "sw/device/silicon_creator/lib/shutdown.h"
 #include "sw/device/silicon_creator/lib/sigverify/sigverify.h"
+#include "sw/device/silicon_creator/lib/profiler_print.h"
 #include "sw/device/silicon_creator/lib/stack_utilization.h"
 #include "sw/device/silicon_creator/rom/boot_policy.h"
 #include "sw/device/silicon_creator/rom/boot_policy_ptrs.h"
@@ -150,8 +152,10 @@ static void rom_bootstrap_message(void) {
  */
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_init(void) {
+  PROFILER_SCOPE("rom_init");
   CFI_FUNC_COUNTER_INCREMENT(rom_counters, kCfiRomInit, 1);
   sec_mmio_init();
+  rnd_init();
   uint32_t reset_reasons = rstmgr_reason_get();
   reset_reason_check =
       reset_reasons ^
@@ -309,6 +313,7 @@ static rom_error_t rom_init(void) {
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_verify(const manifest_t *manifest,
                               uint32_t *flash_exec) {
+  PROFILER_SCOPE("rom_verify");
   // Check security version and manifest constraints.
   //
   // The poisoning work (`anti_rollback`) invalidates signatures if the
@@ -390,27 +395,27 @@ static rom_error_t rom_verify(const manifest_t *manifest,
   /**
    * Verify the ECDSA/SPX+ signatures of ROM_EXT.
    *
-   * We swap the order of signature verifications randomly.
+   * ECDSA runs on OTBN while SPX+ runs on Ibex and HMAC/KMAC, so the ECDSA
+   * verification is started first and collected after SPX+ is done. Both
+   * verifications always run to completion, and their results are checked in
+   * random order.
    */
   *flash_exec = 0;
+  HARDENED_RETURN_IF_ERROR(sigverify_ecdsa_p256_start(
+      &manifest->ecdsa_signature, ecdsa_key, &act_digest));
+  rom_error_t spx_error = sigverify_spx_verify(
+      spx_signature, spx_key, spx_config, lc_state, &usage_constraints_from_hw,
+      sizeof(usage_constraints_from_hw), anti_rollback, anti_rollback_len,
+      digest_region.start, digest_region.length, &act_digest, flash_exec);
+  rom_error_t ecdsa_error =
+      sigverify_ecdsa_p256_finish(&manifest->ecdsa_signature, flash_exec);
+
   if (rnd_uint32() < 0x80000000) {
-    HARDENED_RETURN_IF_ERROR(sigverify_ecdsa_p256_verify(
-        &manifest->ecdsa_signature, ecdsa_key, &act_digest, flash_exec));
-
-    return sigverify_spx_verify(
-        spx_signature, spx_key, spx_config, lc_state,
-        &usage_constraints_from_hw, sizeof(usage_constraints_from_hw),
-        anti_rollback, anti_rollback_len, digest_region.start,
-        digest_region.length, &act_digest, flash_exec);
+    HARDENED_RETURN_IF_ERROR(ecdsa_error);
+    return spx_error;
   } else {
-    HARDENED_RETURN_IF_ERROR(sigverify_spx_verify(
-        spx_signature, spx_key, spx_config, lc_state,
-        &usage_constraints_from_hw, sizeof(usage_constraints_from_hw),
-        anti_rollback, anti_rollback_len, digest_region.start,
-        digest_region.length, &act_digest, flash_exec));
-
-    return sigverify_ecdsa_p256_verify(&manifest->ecdsa_signature, ecdsa_key,
-                                       &act_digest, flash_exec);
+    HARDENED_RETURN_IF_ERROR(spx_error);
+    return ecdsa_error;
   }
 }
 
@@ -662,7 +667,8 @@ static rom_error_t rom_boot(const manifest_t *manifest, uint32_t flash_exec) {
   }
   CFI_FUNC_COUNTER_INCREMENT(rom_counters, kCfiRomBoot, 5);
 
-  // In a normal build, this function inlines to nothing.
+  // In a normal build, these functions inline to nothing.
+  profiler_print();
   stack_utilization_print();
 
   // (Potentially) Execute the immutable ROM_EXT section.
@@ -667,6 +667,8 @@ TEST_F(RomExtBootstrapTest, BootstrapProtectsRomExtWithPageProgramInSlotA) {
   ExpectFlashCtrlWriteEnable();
   EXPECT_CALL(flash_ctrl_, DataWrite(testing::_, 4, testing::_));
   ExpectFlashCtrlAllDisable();
+  // Status is released before programming.
+  EXPECT_CALL(spi_device_, FlashStatusClear());
 
   EXPECT_THAT(flash_ctrl_sim_.GetFlash(), Each(Eq(FlashByte::kDefault)))
       << "Before rom_ext_bootstrap(), flash should be unmodified.";
@@ -723,6 +725,8 @@ TEST_F(RomExtBootstrapTest, BootstrapProtectsRomExtWithPageProgramInSlotB) {
   ExpectFlashCtrlWriteEnable();
   EXPECT_CALL(flash_ctrl_, DataWrite(testing::_, 4, testing::_));
   ExpectFlashCtrlAllDisable();
+  // Status is released before programming.
+  EXPECT_CALL(spi_device_, FlashStatusClear());
 
   EXPECT_THAT(flash_ctrl_sim_.GetFlash(), Each(Eq(FlashByte::kDefault)))
       << "Before rom_ext_bootstrap(), flash should be unmodified.";
@@ -5,11 +5,13 @@
 #include "sw/device/silicon_creator/rom_ext/rescue.h"
 
 #include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/silicon_creator/lib/dbg_print.h"
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
 #include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
 #include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
+#include "sw/device/silicon_creator/lib/drivers/spi_device.h"
 #include "sw/device/silicon_creator/lib/drivers/uart.h"
 #include "sw/device/silicon_creator/lib/xmodem.h"
 
@@ -134,6 +136,10 @@ static void validate_mode(uint32_t mode, rescue_state_t *state) {
       state->reboot = false;
       dbg_printf("ok: wait after upload\r\n");
       return;
+    case kRescueModeWindow:
+      state->window = true;
+      dbg_printf("ok: windowed xmodem-crc for next upload\r\n");
+      return;
     default:
       // User input error.  Do not change modes.
       dbg_printf("error: unrecognized mode\r\n");
@@ -237,8 +243,16 @@ static rom_error_t protocol(rescue_state_t *state) {
       case kErrorOk:
         // Packet ok.
         state->offset += rxlen;
+        state->window_frames += 1;
         HARDENED_RETURN_IF_ERROR(handle_recv_modes(&rescue_state));
-        xmodem_ack(iohandle, true);
+        // In windowed mode, the sender transmits frames back-to-back until
+        // it has filled the data buffer and only then waits for our ACK.
+        // Since the buffer is flushed to flash before we ACK, the sender is
+        // always idle while we program flash.
+        if (!state->window || state->offset == 0) {
+          xmodem_ack(iohandle, true);
+          state->window_frames = 0;
+        }
         break;
       case kErrorXModemEndOfFile:
         if (state->offset % 2048 != 0) {
@@ -250,6 +264,8 @@ static rom_error_t protocol(rescue_state_t *state) {
           HARDENED_RETURN_IF_ERROR(handle_recv_modes(&rescue_state));
         }
         xmodem_ack(iohandle, true);
+        state->window = false;
+        state->window_frames = 0;
         if (!state->reboot) {
           state->frame = 1;
           state->offset = 0;
@@ -258,6 +274,13 @@ static rom_error_t protocol(rescue_state_t *state) {
         }
         return kErrorRescueReboot;
       case kErrorXModemCrc:
+        if (state->window) {
+          // Drop the rest of the window and ask for all of it again.
+          state->frame -= state->window_frames;
+          state->offset = 0;
+          state->window_frames = 0;
+          xmodem_recv_purge(iohandle);
+        }
         xmodem_ack(iohandle, false);
         continue;
       case kErrorXModemCancel:
@@ -287,3 +310,86 @@ rom_error_t rescue_protocol(void) {
   }
   return result;
 }
+
+/**
+ * Handles a PAGE_PROGRAM command received over the spi_device.
+ *
+ * The address space seen by the host is the rescue region of each flash bank:
+ * the bank bit of the address selects the slot and the remaining bits are the
+ * offset into the image.  Pages must be sent in order.
+ */
+static rom_error_t spi_page_program(rescue_state_t *state,
+                                    const spi_device_cmd_t *cmd) {
+  uint32_t received = state->offset;
+  if (state->flash_offset != 0) {
+    received += state->flash_offset - state->flash_start;
+  }
+  uint32_t bank = cmd->address & kFlashBankSize;
+  if (received == 0) {
+    validate_mode(bank ? kRescueModeFirmwareSlotB : kRescueModeFirmware,
+                  state);
+  }
+  if (bank != (state->flash_start & kFlashBankSize) ||
+      (cmd->address & (kFlashBankSize - 1)) != received) {
+    return kErrorRescueBadAddress;
+  }
+
+  const uint8_t *payload = cmd->payload;
+  size_t len = cmd->payload_byte_count;
+  while (len > 0) {
+    size_t chunk = sizeof(state->data) - state->offset;
+    if (chunk > len) {
+      chunk = len;
+    }
+    memcpy(state->data + state->offset, payload, chunk);
+    state->offset += chunk;
+    payload += chunk;
+    len -= chunk;
+    HARDENED_RETURN_IF_ERROR(handle_recv_modes(state));
+  }
+  return kErrorOk;
+}
+
+static rom_error_t spi_protocol(rescue_state_t *state) {
+  validate_mode(kRescueModeFirmware, state);
+  state->flash_start = 0x10000;
+  state->flash_limit = 0x7FFFF;
+
+  spi_device_init();
+  while (true) {
+    spi_device_cmd_t cmd;
+    HARDENED_RETURN_IF_ERROR(spi_device_cmd_get(&cmd));
+    // Program requires WREN, ignore if WEL is not set.
+    if (cmd.opcode != kSpiDeviceOpcodeReset &&
+        !bitfield_bit32_read(spi_device_flash_status_get(), kSpiDeviceWelBit)) {
+      continue;
+    }
+    switch (cmd.opcode) {
+      case kSpiDeviceOpcodePageProgram:
+        HARDENED_RETURN_IF_ERROR(spi_page_program(state, &cmd));
+        break;
+      case kSpiDeviceOpcodeReset:
+        if (state->offset != 0) {
+          // Extend any residue out to a full block and then handle it.
+          memset(state->data + state->offset, 0xFF,
+                 sizeof(state->data) - state->offset);
+          state->offset = sizeof(state->data);
+          HARDENED_RETURN_IF_ERROR(handle_recv_modes(state));
+        }
+        return kErrorRescueReboot;
+      default:
+        // The rescue region is erased before the first block is written, so
+        // erase commands need no action.
+        break;
+    }
+    spi_device_flash_status_clear();
+  }
+}
+
+rom_error_t rescue_spi_protocol(void) {
+  rom_error_t result = spi_protocol(&rescue_state);
+  if (result == kErrorRescueReboot) {
+    rstmgr_reset();
+  }
+  return result;
+}
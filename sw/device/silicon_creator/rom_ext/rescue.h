@@ -36,6 +36,8 @@ typedef enum {
   kRescueModeReboot = 0x5245424f,
   /** `WAIT` */
   kRescueModeWait = 0x57414954,
+  /** `WNDW` */
+  kRescueModeWindow = 0x574e4457,
 } rescue_mode_t;
 
 typedef enum {
@@ -57,6 +59,10 @@ typedef struct RescueState {
   rescue_mode_t mode;
   // Whether to reboot automatically after an xmodem upload.
   bool reboot;
+  // Whether the next upload acknowledges a whole data buffer at a time.
+  bool window;
+  // Number of frames received since the last acknowledgement.
+  uint32_t window_frames;
   // Current xmodem frame.
   uint32_t frame;
   // Current data offset.
@@ -72,4 +78,18 @@ typedef struct RescueState {
 
 rom_error_t rescue_protocol(void);
 
+/**
+ * Runs the firmware rescue protocol over the spi_device.
+ *
+ * The spi_device emulates a SPI flash in the same way as bootstrap.  The host
+ * sends the image with WREN/PAGE_PROGRAM sequences at increasing addresses,
+ * polling the busy bit in between, and ends the session with RESET.  Addresses
+ * with the flash bank bit set target slot B.  Data is buffered and written
+ * with the same block handler as the UART transport, so a 2 KiB block is
+ * programmed every eight pages.
+ *
+ * @return The error that ended the session; does not return on success.
+ */
+rom_error_t rescue_spi_protocol(void);
+
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_RESCUE_H_
@@ -7,6 +7,7 @@
 #include "sw/device/lib/arch/device.h"
 #include "sw/device/lib/base/csr.h"
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/profiler.h"
 #include "sw/device/lib/base/stdasm.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
 #include "sw/device/lib/runtime/hart.h"
@@ -21,6 +22,7 @@
 #include "sw/device/silicon_creator/lib/boot_svc/boot_svc_empty.h"
 #include "sw/device/silicon_creator/lib/boot_svc/boot_svc_header.h"
 #include "sw/device/silicon_creator/lib/boot_svc/boot_svc_msg.h"
+#include "sw/device/silicon_creator/lib/cert/asn1.h"
 #include "sw/device/silicon_creator/lib/cert/cdi_0.h"  // Generated.
 #include "sw/device/silicon_creator/lib/cert/cdi_1.h"  // Generated.
 #include "sw/device/silicon_creator/lib/cert/cert.h"
@@ -44,10 +46,12 @@
 #include "sw/device/silicon_creator/lib/otbn_boot_services.h"
 #include "sw/device/silicon_creator/lib/ownership/ownership.h"
 #include "sw/device/silicon_creator/lib/ownership/ownership_unlock.h"
+#include "sw/device/silicon_creator/lib/profiler_print.h"
 #include "sw/device/silicon_creator/lib/shutdown.h"
 #include "sw/device/silicon_creator/lib/sigverify/ecdsa_p256_key.h"
 #include "sw/device/silicon_creator/lib/sigverify/rsa_verify.h"
 #include "sw/device/silicon_creator/lib/sigverify/sigverify.h"
+#include "sw/device/silicon_creator/lib/verify_cache.h"
 #include "sw/device/silicon_creator/rom_ext/rescue.h"
 #include "sw/device/silicon_creator/rom_ext/rom_ext_boot_policy.h"
 #include "sw/device/silicon_creator/rom_ext/rom_ext_boot_policy_ptrs.h"
@@ -67,6 +71,23 @@ extern char _rom_ext_start_address[];
 // Declaration for the chip_info structure stored in ROM.
 extern const char _chip_info_start[];
 
+#ifndef ROM_EXT_BL0_VERIFY_CACHE
+/**
+ * Whether to skip the BL0 signature check on resets that preserve the
+ * retention SRAM when the BL0 digest matches the sealed record left by a
+ * previous boot (see `verify_cache.h`). Off by default.
+ */
+#define ROM_EXT_BL0_VERIFY_CACHE 0
+#endif
+
+#ifndef ROM_EXT_RESCUE_SPI
+/**
+ * Whether rescue, once requested with a UART break, receives the firmware
+ * over the spi_device instead of over the UART.  Off by default.
+ */
+#define ROM_EXT_RESCUE_SPI 0
+#endif
+
 // Life cycle state of the chip.
 lifecycle_state_t lc_state = kLcStateProd;
 
@@ -184,7 +205,9 @@ void rom_ext_check_rom_expectations(void) {
 
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_ext_init(boot_data_t *boot_data) {
+  PROFILER_SCOPE("rom_ext_init");
   sec_mmio_next_stage_init();
+  rnd_init();
   lc_state = lifecycle_state_get();
   pinmux_init();
   // Configure UART0 as stdout.
@@ -235,10 +258,11 @@ void rom_ext_sram_exec(hardened_bool_t enable) {
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_ext_verify(const manifest_t *manifest,
                                   const boot_data_t *boot_data) {
+  PROFILER_SCOPE("rom_ext_verify");
   RETURN_IF_ERROR(rom_ext_boot_policy_manifest_check(manifest, boot_data));
   const sigverify_rsa_key_t *key;
-  RETURN_IF_ERROR(sigverify_rsa_key_get(
-      sigverify_rsa_key_id_get(&manifest->rsa_modulus), &key));
+  uint32_t key_id = sigverify_rsa_key_id_get(&manifest->rsa_modulus);
+  RETURN_IF_ERROR(sigverify_rsa_key_get(key_id, &key));
 
   memset(boot_measurements.bl0.data, (int)rnd_uint32(),
          sizeof(boot_measurements.bl0.data));
@@ -262,9 +286,29 @@ static rom_error_t rom_ext_verify(const manifest_t *manifest,
                 "Unexpected BL0 digest size.");
   memcpy(&boot_measurements.bl0, &act_digest, sizeof(boot_measurements.bl0));
 
+  if (!ROM_EXT_BL0_VERIFY_CACHE) {
+    uint32_t flash_exec = 0;
+    return sigverify_rsa_verify(&manifest->rsa_signature, key, &act_digest,
+                                lc_state, &flash_exec);
+  }
+
+  // The image is always re-hashed above; only the signature check is skipped
+  // when a sealed record from a previous boot vouches for this exact digest.
+  verify_cache_t *cache = &retention_sram_get()->creator.bl0_verify_cache;
+  rom_error_t error = verify_cache_check(cache, key_id, lc_state, &act_digest);
+  if (launder32(error) == kErrorOk) {
+    HARDENED_CHECK_EQ(error, kErrorOk);
+    return error;
+  }
   uint32_t flash_exec = 0;
-  return sigverify_rsa_verify(&manifest->rsa_signature, key, &act_digest,
-                              lc_state, &flash_exec);
+  error = sigverify_rsa_verify(&manifest->rsa_signature, key, &act_digest,
+                               lc_state, &flash_exec);
+  if (launder32(error) != kErrorOk) {
+    verify_cache_invalidate(cache);
+    return error;
+  }
+  HARDENED_CHECK_EQ(error, kErrorOk);
+  return verify_cache_update(cache, key_id, lc_state, &act_digest);
 }
 
 /**
@@ -322,6 +366,7 @@ static rom_error_t rom_ext_buffer_dice_certs_into_ram(void) {
 
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_ext_attestation_silicon(void) {
+  PROFILER_SCOPE("rom_ext_attestation_silicon");
   // Initialize the entropy complex and KMAC for key manager operations.
   // Note: `OTCRYPTO_OK.value` is equal to `kErrorOk` but we cannot add a static
   // assertion here since its definition is not an integer constant expression.
@@ -383,25 +428,83 @@ static rom_error_t rom_ext_attestation_silicon(void) {
   return kErrorOk;
 }
 
+/**
+ * Checks whether the certificate at the current DICE cert page offset can be
+ * kept without regenerating the attestation key it certifies.
+ *
+ * This is the case if the certificate was issued by `issuer_key_id` for a
+ * stage with measurement `measurement`: the key manager derives the
+ * attestation key from the same inputs, so the key and its ID are unchanged.
+ * The key ID is then read back from the certificate serial number.
+ *
+ * @param issuer_key_id ID of the key that endorses the certificate.
+ * @param measurement Measurement of the stage the certificate is for.
+ * @param[out] key_id ID of the certified key, if the certificate is kept.
+ * @param[out] keep Whether the certificate can be kept.
+ * @param[out] cert_size Size of the certificate.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t rom_ext_attestation_cert_check(
+    const hmac_digest_t *issuer_key_id,
+    const keymgr_binding_value_t *measurement, hmac_digest_t *key_id,
+    hardened_bool_t *keep, uint32_t *cert_size) {
+  *keep = kHardenedBoolFalse;
+  hardened_bool_t found = kHardenedBoolFalse;
+  uint8_t serial_number[kCertX509Asn1SerialNumberSizeInBytes];
+  HARDENED_RETURN_IF_ERROR(cert_x509_asn1_read_serial_number(
+      dice_certs_page, dice_certs_page_offset, serial_number, &found,
+      cert_size));
+  if (launder32(found) != kHardenedBoolTrue ||
+      *cert_size > sizeof(dice_certs_page) - dice_certs_page_offset) {
+    return kErrorOk;
+  }
+  const uint8_t *cert = &dice_certs_page[dice_certs_page_offset];
+  if (cert_x509_asn1_find_value(cert, *cert_size, kAsn1TagNumberOctetString,
+                                (const uint8_t *)measurement->data,
+                                sizeof(measurement->data)) !=
+          kHardenedBoolTrue ||
+      cert_x509_asn1_find_value(cert, *cert_size,
+                                kCertX509Asn1AuthorityKeyIdTag,
+                                (const uint8_t *)issuer_key_id->digest,
+                                kDiceCertKeyIdSizeInBytes) !=
+          kHardenedBoolTrue) {
+    return kErrorOk;
+  }
+  memcpy(key_id->digest, serial_number, sizeof(serial_number));
+  *keep = kHardenedBoolTrue;
+  return kErrorOk;
+}
+
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_ext_attestation_creator(
     const manifest_t *rom_ext_manifest) {
+  PROFILER_SCOPE("rom_ext_attestation_creator");
   // Generate CDI_0 attestation keys and (potentially) update certificate.
   keymgr_binding_value_t seal_binding_value = {
       .data = {rom_ext_manifest->identifier, 0}};
   SEC_MMIO_WRITE_INCREMENT(kScKeymgrSecMmioSwBindingSet +
                            kScKeymgrSecMmioOwnerIntMaxVerSet);
-  HARDENED_RETURN_IF_ERROR(
-      sc_keymgr_owner_int_advance(/*sealing_binding=*/&seal_binding_value,
-                                  /*attest_binding=*/&boot_measurements.rom_ext,
-                                  rom_ext_manifest->max_key_version));
-  HARDENED_RETURN_IF_ERROR(dice_attestation_keygen(
-      kDiceKeyCdi0, &cdi_0_pubkey_id, &curr_attestation_pubkey));
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_owner_int_advance_start(
+      /*sealing_binding=*/&seal_binding_value,
+      /*attest_binding=*/&boot_measurements.rom_ext,
+      rom_ext_manifest->max_key_version));
+  // If the existing certificate already attests this ROM_EXT, skip the
+  // attestation keygen. The certificate is checked while the keymgr advances.
   hardened_bool_t cert_valid = kHardenedBoolFalse;
   uint32_t cert_size = 0;
-  HARDENED_RETURN_IF_ERROR(cert_x509_asn1_check_serial_number(
-      dice_certs_page, dice_certs_page_offset,
-      (uint8_t *)cdi_0_pubkey_id.digest, &cert_valid, &cert_size));
+  HARDENED_RETURN_IF_ERROR(rom_ext_attestation_cert_check(
+      &uds_pubkey_id, &boot_measurements.rom_ext, &cdi_0_pubkey_id,
+      &cert_valid, &cert_size));
+  HARDENED_RETURN_IF_ERROR(
+      sc_keymgr_state_check(kScKeymgrStateOwnerIntermediateKey));
+  if (launder32(cert_valid) != kHardenedBoolTrue) {
+    HARDENED_RETURN_IF_ERROR(dice_attestation_keygen(
+        kDiceKeyCdi0, &cdi_0_pubkey_id, &curr_attestation_pubkey));
+    HARDENED_RETURN_IF_ERROR(cert_x509_asn1_check_serial_number(
+        dice_certs_page, dice_certs_page_offset,
+        (uint8_t *)cdi_0_pubkey_id.digest, &cert_valid, &cert_size));
+  }
   if (launder32(cert_valid) == kHardenedBoolFalse) {
     HARDENED_CHECK_EQ(cert_valid, kHardenedBoolFalse);
     dbg_printf("CDI_0 certificate not valid. Updating it ...\r\n");
@@ -427,6 +530,7 @@ static rom_error_t rom_ext_attestation_creator(
 
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_ext_attestation_owner(const manifest_t *owner_manifest) {
+  PROFILER_SCOPE("rom_ext_attestation_owner");
   keymgr_binding_value_t zero_binding_value = {.data = {0}};
   // Generate CDI_1 attestation keys and (potentially) update certificate.
   SEC_MMIO_WRITE_INCREMENT(kScKeymgrSecMmioSwBindingSet +
@@ -434,16 +538,24 @@ static rom_error_t rom_ext_attestation_owner(const manifest_t *owner_manifest) {
   // TODO(cfrantz): setup sealing binding to value specified in owner
   // configuration block.
   HARDENED_RETURN_IF_ERROR(
-      sc_keymgr_owner_advance(/*sealing_binding=*/&zero_binding_value,
-                              /*attest_binding=*/&boot_measurements.bl0,
-                              owner_manifest->max_key_version));
-  HARDENED_RETURN_IF_ERROR(dice_attestation_keygen(
-      kDiceKeyCdi1, &cdi_1_pubkey_id, &curr_attestation_pubkey));
+      sc_keymgr_owner_advance_start(/*sealing_binding=*/&zero_binding_value,
+                                    /*attest_binding=*/&boot_measurements.bl0,
+                                    owner_manifest->max_key_version));
+  // If the existing certificate already attests this owner stage, skip the
+  // attestation keygen. The certificate is checked while the keymgr advances.
   hardened_bool_t cert_valid = kHardenedBoolFalse;
   uint32_t cert_size = 0;
-  HARDENED_RETURN_IF_ERROR(cert_x509_asn1_check_serial_number(
-      dice_certs_page, dice_certs_page_offset,
-      (uint8_t *)cdi_1_pubkey_id.digest, &cert_valid, &cert_size));
+  HARDENED_RETURN_IF_ERROR(rom_ext_attestation_cert_check(
+      &cdi_0_pubkey_id, &boot_measurements.bl0, &cdi_1_pubkey_id, &cert_valid,
+      &cert_size));
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(kScKeymgrStateOwnerKey));
+  if (launder32(cert_valid) != kHardenedBoolTrue) {
+    HARDENED_RETURN_IF_ERROR(dice_attestation_keygen(
+        kDiceKeyCdi1, &cdi_1_pubkey_id, &curr_attestation_pubkey));
+    HARDENED_RETURN_IF_ERROR(cert_x509_asn1_check_serial_number(
+        dice_certs_page, dice_certs_page_offset,
+        (uint8_t *)cdi_1_pubkey_id.digest, &cert_valid, &cert_size));
+  }
   if (launder32(cert_valid) == kHardenedBoolFalse) {
     HARDENED_CHECK_EQ(cert_valid, kHardenedBoolFalse);
     dbg_printf("CDI_1 certificate not valid. Updating it ...\r\n");
@@ -571,7 +683,6 @@ static rom_error_t rom_ext_boot(const manifest_t *manifest) {
       SEC_MMIO_WRITE_INCREMENT(kAddressTranslationSecMmioConfigure);
 
       // Unlock read-only for the whole rom_ext virtual memory.
-      HARDENED_RETURN_IF_ERROR(epmp_state_check());
       rom_ext_epmp_set_napot(
           4,
           (epmp_region_t){.start = (uintptr_t)_owner_virtual_start_address,
@@ -602,7 +713,7 @@ static rom_error_t rom_ext_boot(const manifest_t *manifest) {
   // Allow execution of owner stage executable code (text) sections,
   // unlock the ROM_EXT code regions so the next stage can re-use those
   // entries and clear RLB to prevent further changes to locked ePMP regions.
-  HARDENED_RETURN_IF_ERROR(epmp_state_check());
+  // The ePMP has not been modified since the last check on either path above.
   rom_ext_epmp_set_tor(2, text_region, kEpmpPermReadExecute);
 
   // Now that we're done reconfiguring the ePMP, we'll clear the RLB bit to
@@ -618,12 +729,12 @@ static rom_error_t rom_ext_boot(const manifest_t *manifest) {
   ibex_addr_remap_lockdown(1);
 
   dbg_print_epmp();
+  // In a normal build, this function inlines to nothing.
+  profiler_print();
 
-  // Verify expectations before jumping to owner code.
-  // TODO: we really want to call rnd_uint32 here to select a random starting
-  // location for checking expectations.  However, rnd_uint32 read from OTP
-  // to know if it's allowed to used the CSRNG and OTP is locked down.
-  sec_mmio_check_values_except_otp(/*rnd_uint32()*/ 0,
+  // Verify expectations before jumping to owner code. OTP is locked down at
+  // this point, but `rnd_uint32()` no longer reads it after `rnd_init()`.
+  sec_mmio_check_values_except_otp(rnd_uint32(),
                                    TOP_EARLGREY_OTP_CTRL_CORE_BASE_ADDR);
   // Jump to OWNER entry point.
   dbg_printf("entry: 0x%x\r\n", (unsigned int)entry_point);
@@ -860,7 +971,7 @@ static rom_error_t rom_ext_start(boot_data_t *boot_data, boot_log_t *boot_log) {
   if (uart_break_detect(kRescueDetectTime) == kHardenedBoolTrue) {
     dbg_printf("rescue: remember to clear break\r\n");
     uart_enable_receiver();
-    error = rescue_protocol();
+    error = ROM_EXT_RESCUE_SPI ? rescue_spi_protocol() : rescue_protocol();
   } else {
     error = rom_ext_try_next_stage(boot_data);
   }
@@ -16,19 +16,18 @@
 
 static const int P256_KEY_BYTES = 32;
 
-status_t handle_ecdh(ujson_t *uj) {
-  // Declare ECDH parameter ujson deserializer types
-  cryptotest_ecdh_curve_t uj_curve;
-  cryptotest_ecdh_private_key_t uj_private_key;
-  cryptotest_ecdh_coordinate_t uj_qx;
-  cryptotest_ecdh_coordinate_t uj_qy;
-
-  // Deserialize ujson byte stream into ECDH parameters
-  TRY(ujson_deserialize_cryptotest_ecdh_curve_t(uj, &uj_curve));
-  TRY(ujson_deserialize_cryptotest_ecdh_private_key_t(uj, &uj_private_key));
-  TRY(ujson_deserialize_cryptotest_ecdh_coordinate_t(uj, &uj_qx));
-  TRY(ujson_deserialize_cryptotest_ecdh_coordinate_t(uj, &uj_qy));
-
+/**
+ * Derives the shared secret for one ECDH test vector.
+ *
+ * Inputs rejected by the cryptolib are reported with `ok = false`; any other
+ * error is returned.
+ */
+static status_t ecdh_derive(
+    cryptotest_ecdh_curve_t uj_curve,
+    const cryptotest_ecdh_private_key_t *uj_private_key,
+    const cryptotest_ecdh_coordinate_t *uj_qx,
+    const cryptotest_ecdh_coordinate_t *uj_qy,
+    cryptotest_ecdh_derive_output_t *uj_output) {
   otcrypto_ecc_curve_type_t curve_type;
   otcrypto_unblinded_key_t public_key;
   p256_point_t pub_p256;
@@ -46,9 +45,9 @@ status_t handle_ecdh(ujson_t *uj) {
     case kCryptotestEcdhCurveP256:
       curve_type = kOtcryptoEccCurveTypeNistP256;
       memset(pub_p256.x, 0, kP256CoordWords * 4);
-      memcpy(pub_p256.x, uj_qx.coordinate, uj_qx.coordinate_len);
+      memcpy(pub_p256.x, uj_qx->coordinate, uj_qx->coordinate_len);
       memset(pub_p256.y, 0, kP256CoordWords * 4);
-      memcpy(pub_p256.y, uj_qy.coordinate, uj_qy.coordinate_len);
+      memcpy(pub_p256.y, uj_qy->coordinate, uj_qy->coordinate_len);
       public_key.key_mode = kOtcryptoKeyModeEcdh;
       public_key.key_length = sizeof(p256_point_t);
       public_key.key = (uint32_t *)&pub_p256;
@@ -56,9 +55,9 @@ status_t handle_ecdh(ujson_t *uj) {
       shared_key_words = P256_KEY_BYTES / sizeof(uint32_t);
       p256_masked_scalar_t private_key_masked;
       memset(private_key_masked.share0, 0, kP256MaskedScalarShareBytes);
-      memcpy(private_key_masked.share0, uj_private_key.d0, kP256ScalarBytes);
+      memcpy(private_key_masked.share0, uj_private_key->d0, kP256ScalarBytes);
       memset(private_key_masked.share1, 0, kP256MaskedScalarShareBytes);
-      memcpy(private_key_masked.share1, uj_private_key.d1, kP256ScalarBytes);
+      memcpy(private_key_masked.share1, uj_private_key->d1, kP256ScalarBytes);
       private_key_masked_raw = (uint32_t *)&private_key_masked;
       private_keyblob_length = sizeof(private_key_masked);
       break;
@@ -90,10 +89,9 @@ status_t handle_ecdh(ujson_t *uj) {
 
   otcrypto_status_t status =
       otcrypto_ecdh(&private_key, &public_key, &elliptic_curve, &shared_key);
-  cryptotest_ecdh_derive_output_t uj_output;
   switch (status.value) {
     case kOtcryptoStatusValueOk: {
-      uj_output.ok = true;
+      uj_output->ok = true;
 
       // Recover the shared secret key (Z) from its shares
       uint32_t *zShare0;
@@ -101,11 +99,11 @@ status_t handle_ecdh(ujson_t *uj) {
       TRY(keyblob_to_shares(&shared_key, &zShare0, &zShare1));
 
       // XOR the two shares to get the raw key
-      uint32_t *uj_shared_secret_u32 = (uint32_t *)uj_output.shared_secret;
+      uint32_t *uj_shared_secret_u32 = (uint32_t *)uj_output->shared_secret;
       for (size_t i = 0; i < shared_key_words; i++) {
         uj_shared_secret_u32[i] = zShare0[i] ^ zShare1[i];
       }
-      uj_output.shared_secret_len = shared_key_words * sizeof(uint32_t);
+      uj_output->shared_secret_len = shared_key_words * sizeof(uint32_t);
 
       break;
     }
@@ -113,7 +111,7 @@ status_t handle_ecdh(ujson_t *uj) {
       // Some ECDH test vectors test invalid inputs. If cryptolib
       // returns an invalid input code, we simply respond with ok =
       // false. For other error codes, we error out entirely.
-      uj_output.ok = false;
+      uj_output->ok = false;
       break;
     }
     default: {
@@ -124,6 +122,62 @@ status_t handle_ecdh(ujson_t *uj) {
       return INTERNAL();
     }
   }
+  return OK_STATUS(0);
+}
+
+status_t handle_ecdh(ujson_t *uj) {
+  // Declare ECDH parameter ujson deserializer types
+  cryptotest_ecdh_curve_t uj_curve;
+  cryptotest_ecdh_private_key_t uj_private_key;
+  cryptotest_ecdh_coordinate_t uj_qx;
+  cryptotest_ecdh_coordinate_t uj_qy;
+
+  // Deserialize ujson byte stream into ECDH parameters
+  TRY(ujson_deserialize_cryptotest_ecdh_curve_t(uj, &uj_curve));
+  TRY(ujson_deserialize_cryptotest_ecdh_private_key_t(uj, &uj_private_key));
+  TRY(ujson_deserialize_cryptotest_ecdh_coordinate_t(uj, &uj_qx));
+  TRY(ujson_deserialize_cryptotest_ecdh_coordinate_t(uj, &uj_qy));
+
+  cryptotest_ecdh_derive_output_t uj_output;
+  TRY(ecdh_derive(uj_curve, &uj_private_key, &uj_qx, &uj_qy, &uj_output));
   RESP_OK(ujson_serialize_cryptotest_ecdh_derive_output_t, uj, &uj_output);
   return OK_STATUS(0);
 }
+
+status_t handle_ecdh_batch(ujson_t *uj) {
+  cryptotest_ecdh_curve_t uj_curve;
+  cryptotest_ecdh_batch_t uj_batch;
+  TRY(ujson_deserialize_cryptotest_ecdh_curve_t(uj, &uj_curve));
+  TRY(ujson_deserialize_cryptotest_ecdh_batch_t(uj, &uj_batch));
+  if (uj_batch.count > ECDH_CMD_MAX_BATCH_ITEMS) {
+    LOG_ERROR("ECDH batch too large (have = %d items, max = %d items)",
+              uj_batch.count, ECDH_CMD_MAX_BATCH_ITEMS);
+    return INVALID_ARGUMENT();
+  }
+
+  // Each vector is processed as soon as it is received; only the results are
+  // kept until the whole batch is answered.
+  cryptotest_ecdh_derive_batch_output_t uj_output;
+  memset(&uj_output, 0, sizeof(uj_output));
+  uj_output.count = uj_batch.count;
+  for (size_t i = 0; i < uj_batch.count; ++i) {
+    cryptotest_ecdh_private_key_t uj_private_key;
+    cryptotest_ecdh_coordinate_t uj_qx;
+    cryptotest_ecdh_coordinate_t uj_qy;
+    TRY(ujson_deserialize_cryptotest_ecdh_private_key_t(uj, &uj_private_key));
+    TRY(ujson_deserialize_cryptotest_ecdh_coordinate_t(uj, &uj_qx));
+    TRY(ujson_deserialize_cryptotest_ecdh_coordinate_t(uj, &uj_qy));
+
+    cryptotest_ecdh_derive_output_t item;
+    TRY(ecdh_derive(uj_curve, &uj_private_key, &uj_qx, &uj_qy, &item));
+    uj_output.ok[i] = item.ok;
+    if (item.ok) {
+      uj_output.shared_secret_len = item.shared_secret_len;
+      memcpy(&uj_output.shared_secrets[i * item.shared_secret_len],
+             item.shared_secret, item.shared_secret_len);
+    }
+  }
+  RESP_OK(ujson_serialize_cryptotest_ecdh_derive_batch_output_t, uj,
+          &uj_output);
+  return OK_STATUS(0);
+}
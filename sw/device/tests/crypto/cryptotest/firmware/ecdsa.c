@@ -29,6 +29,34 @@ static const otcrypto_key_config_t kP256PrivateKeyConfig = {
     .security_level = kOtcryptoKeySecurityLevelLow,
 };
 
+static status_t hash_mode_get(cryptotest_ecdsa_hash_alg_t uj_hash_alg,
+                              otcrypto_hash_mode_t *mode) {
+  switch (uj_hash_alg) {
+    case kCryptotestEcdsaHashAlgSha256:
+      *mode = kOtcryptoHashModeSha256;
+      break;
+    case kCryptotestEcdsaHashAlgSha384:
+      *mode = kOtcryptoHashModeSha384;
+      break;
+    case kCryptotestEcdsaHashAlgSha512:
+      *mode = kOtcryptoHashModeSha512;
+      break;
+    case kCryptotestEcdsaHashAlgSha3_256:
+      *mode = kOtcryptoHashModeSha3_256;
+      break;
+    case kCryptotestEcdsaHashAlgSha3_384:
+      *mode = kOtcryptoHashModeSha3_384;
+      break;
+    case kCryptotestEcdsaHashAlgSha3_512:
+      *mode = kOtcryptoHashModeSha3_512;
+      break;
+    default:
+      LOG_ERROR("Unrecognized ECDSA hash mode: %d", uj_hash_alg);
+      return INVALID_ARGUMENT();
+  }
+  return OK_STATUS(0);
+}
+
 int set_nist_p256_params(
     cryptotest_ecdsa_coordinate_t uj_qx, cryptotest_ecdsa_coordinate_t uj_qy,
     cryptotest_ecdsa_signature_t uj_signature,
@@ -213,29 +241,7 @@ status_t handle_ecdsa(ujson_t *uj) {
       .domain_parameter = NULL,
   };
   otcrypto_hash_mode_t mode;
-  switch (uj_hash_alg) {
-    case kCryptotestEcdsaHashAlgSha256:
-      mode = kOtcryptoHashModeSha256;
-      break;
-    case kCryptotestEcdsaHashAlgSha384:
-      mode = kOtcryptoHashModeSha384;
-      break;
-    case kCryptotestEcdsaHashAlgSha512:
-      mode = kOtcryptoHashModeSha512;
-      break;
-    case kCryptotestEcdsaHashAlgSha3_256:
-      mode = kOtcryptoHashModeSha3_256;
-      break;
-    case kCryptotestEcdsaHashAlgSha3_384:
-      mode = kOtcryptoHashModeSha3_384;
-      break;
-    case kCryptotestEcdsaHashAlgSha3_512:
-      mode = kOtcryptoHashModeSha3_512;
-      break;
-    default:
-      LOG_ERROR("Unrecognized ECDSA hash mode: %d", uj_hash_alg);
-      return INVALID_ARGUMENT();
-  }
+  TRY(hash_mode_get(uj_hash_alg, &mode));
   uint8_t message_buf[ECDSA_CMD_MAX_MESSAGE_BYTES];
   memset(message_buf, 0, digest_len * sizeof(uint32_t));
   memcpy(message_buf, uj_message.input, uj_message.input_len);
@@ -272,3 +278,128 @@ status_t handle_ecdsa(ujson_t *uj) {
   }
   return OK_STATUS(0);
 }
+
+// Inputs of the signatures in a batch; too large for the stack.
+static ecdsa_p256_signature_t batch_signatures[ECDSA_CMD_MAX_BATCH_ITEMS];
+static uint32_t batch_digests[ECDSA_CMD_MAX_BATCH_ITEMS][kP256ScalarWords];
+static otcrypto_ecdsa_verify_batch_item_t
+    batch_items[ECDSA_CMD_MAX_BATCH_ITEMS];
+
+status_t handle_ecdsa_batch(ujson_t *uj) {
+  cryptotest_ecdsa_hash_alg_t uj_hash_alg;
+  cryptotest_ecdsa_curve_t uj_curve;
+  cryptotest_ecdsa_coordinate_t uj_qx;
+  cryptotest_ecdsa_coordinate_t uj_qy;
+  cryptotest_ecdsa_batch_t uj_batch;
+  TRY(ujson_deserialize_cryptotest_ecdsa_hash_alg_t(uj, &uj_hash_alg));
+  TRY(ujson_deserialize_cryptotest_ecdsa_curve_t(uj, &uj_curve));
+  TRY(ujson_deserialize_cryptotest_ecdsa_coordinate_t(uj, &uj_qx));
+  TRY(ujson_deserialize_cryptotest_ecdsa_coordinate_t(uj, &uj_qy));
+  TRY(ujson_deserialize_cryptotest_ecdsa_batch_t(uj, &uj_batch));
+
+  if (uj_curve != kCryptotestEcdsaCurveP256) {
+    LOG_ERROR("Unsupported ECC curve for batch verification: %d", uj_curve);
+    return INVALID_ARGUMENT();
+  }
+  if (uj_batch.count > ECDSA_CMD_MAX_BATCH_ITEMS) {
+    LOG_ERROR("ECDSA batch too large (have = %d items, max = %d items)",
+              uj_batch.count, ECDSA_CMD_MAX_BATCH_ITEMS);
+    return INVALID_ARGUMENT();
+  }
+  otcrypto_hash_mode_t mode;
+  TRY(hash_mode_get(uj_hash_alg, &mode));
+
+  // All signatures in the batch share this public key.
+  p256_point_t pub_p256;
+  if (uj_qx.coordinate_len > kP256CoordBytes ||
+      uj_qy.coordinate_len > kP256CoordBytes) {
+    LOG_ERROR("Public key coordinate too large for P256");
+    return INVALID_ARGUMENT();
+  }
+  memset(&pub_p256, 0, sizeof(pub_p256));
+  memcpy(pub_p256.x, uj_qx.coordinate, uj_qx.coordinate_len);
+  memcpy(pub_p256.y, uj_qy.coordinate, uj_qy.coordinate_len);
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = kOtcryptoKeyModeEcdsa,
+      .key_length = sizeof(pub_p256),
+      .key = (uint32_t *)&pub_p256,
+  };
+  public_key.checksum = integrity_unblinded_checksum(&public_key);
+
+  for (size_t i = 0; i < uj_batch.count; ++i) {
+    cryptotest_ecdsa_message_t uj_message;
+    cryptotest_ecdsa_signature_t uj_signature;
+    TRY(ujson_deserialize_cryptotest_ecdsa_message_t(uj, &uj_message));
+    TRY(ujson_deserialize_cryptotest_ecdsa_signature_t(uj, &uj_signature));
+    if (uj_signature.r_len > kP256ScalarBytes ||
+        uj_signature.s_len > kP256ScalarBytes) {
+      LOG_ERROR("Signature of batch item %d too large for P256", i);
+      return INVALID_ARGUMENT();
+    }
+    if (uj_message.input_len > ECDSA_CMD_MAX_MESSAGE_BYTES) {
+      LOG_ERROR("Digest of batch item %d too large", i);
+      return INVALID_ARGUMENT();
+    }
+
+    // As for a single verification, longer digests are truncated to the
+    // scalar size.
+    memset(batch_digests[i], 0, kP256ScalarBytes);
+    memcpy(batch_digests[i], uj_message.input,
+           uj_message.input_len < kP256ScalarBytes ? uj_message.input_len
+                                                   : kP256ScalarBytes);
+    memset(&batch_signatures[i], 0, sizeof(batch_signatures[i]));
+    memcpy(batch_signatures[i].r, uj_signature.r, uj_signature.r_len);
+    memcpy(batch_signatures[i].s, uj_signature.s, uj_signature.s_len);
+
+    // The signature buffer has const members, so the item is copied in
+    // rather than assigned.
+    const otcrypto_ecdsa_verify_batch_item_t item = {
+        .public_key = &public_key,
+        .message_digest =
+            {
+                .mode = mode,
+                .len = kP256ScalarWords,
+                .data = batch_digests[i],
+            },
+        .signature =
+            {
+                .len = kP256ScalarWords * 2,
+                .data = (uint32_t *)&batch_signatures[i],
+            },
+    };
+    memcpy(&batch_items[i], &item, sizeof(item));
+  }
+
+  // The OTBN app and curve constants stay loaded for the whole batch.
+  hardened_bool_t results[ECDSA_CMD_MAX_BATCH_ITEMS];
+  otcrypto_status_t status =
+      otcrypto_ecdsa_p256_verify_batch(batch_items, uj_batch.count, results);
+  if (status.value != kOtcryptoStatusValueOk) {
+    LOG_ERROR(
+        "Unexpected status value returned from "
+        "otcrypto_ecdsa_p256_verify_batch: 0x%x",
+        status.value);
+    return INTERNAL();
+  }
+
+  cryptotest_ecdsa_verify_batch_output_t uj_output;
+  memset(&uj_output, 0, sizeof(uj_output));
+  uj_output.count = uj_batch.count;
+  for (size_t i = 0; i < uj_batch.count; ++i) {
+    switch (results[i]) {
+      case kHardenedBoolTrue:
+        uj_output.valid[i] = 1;
+        break;
+      case kHardenedBoolFalse:
+        uj_output.valid[i] = 0;
+        break;
+      default:
+        LOG_ERROR("Unexpected verification result for batch item %d: %d", i,
+                  results[i]);
+        return INTERNAL();
+    }
+  }
+  RESP_OK(ujson_serialize_cryptotest_ecdsa_verify_batch_output_t, uj,
+          &uj_output);
+  return OK_STATUS(0);
+}
@@ -9,5 +9,6 @@
 #include "sw/device/lib/ujson/ujson.h"
 
 status_t handle_ecdsa(ujson_t *uj);
+status_t handle_ecdsa_batch(ujson_t *uj);
 
 #endif  // OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_FIRMWARE_ECDSA_H_
@@ -64,6 +64,12 @@ status_t process_cmd(ujson_t *uj) {
       case kCryptotestCommandEcdh:
         RESP_ERR(uj, handle_ecdh(uj));
         break;
+      case kCryptotestCommandEcdsaBatch:
+        RESP_ERR(uj, handle_ecdsa_batch(uj));
+        break;
+      case kCryptotestCommandEcdhBatch:
+        RESP_ERR(uj, handle_ecdh_batch(uj));
+        break;
       case kCryptotestCommandHash:
         RESP_ERR(uj, handle_hash(uj));
         break;
@@ -4,6 +4,8 @@
 
 #include "sw/device/tests/crypto/cryptotest/firmware/ibex_fi.h"
 
+#include <assert.h>
+
 #include "sw/device/lib/base/csr.h"
 #include "sw/device/lib/base/csr_registers.h"
 #include "sw/device/lib/base/memory.h"
@@ -21,6 +23,9 @@
 
 #include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
 
+static_assert(IBEXFI_CAMPAIGN_MAX_SAMPLES == kScaFiCampaignNumSamples,
+              "Campaign sample count mismatch");
+
 // A function which takes an uint32_t as its only argument.
 typedef uint32_t (*str_fn_t)(uint32_t);
 
@@ -715,6 +720,100 @@ status_t handle_ibex_fi_char_conditional_branch(ujson_t *uj) {
   return OK_STATUS();
 }
 
+/**
+ * FI target of the char.mem.op.loop test.
+ *
+ * Increments and decrements two counters in memory 10000 times.
+ *
+ * @param[out] loop_counter1 The incremented counter, 10000 without a fault.
+ * @param[out] loop_counter2 The decremented counter, 0 without a fault.
+ */
+static void char_mem_op_loop(uint32_t *loop_counter1,
+                             uint32_t *loop_counter2) {
+  uint32_t counter1 = 0;
+  uint32_t counter2 = 10000;
+  sca_set_trigger_high();
+  asm volatile(NOP100);
+  for (int loop_cnt = 0; loop_cnt < 10000; loop_cnt++) {
+    asm volatile(LWADDISW1 : : "r"((uint32_t *)&counter1));
+    asm volatile(LWSUBISW1 : : "r"((uint32_t *)&counter2));
+  }
+  sca_set_trigger_low();
+  *loop_counter1 = counter1;
+  *loop_counter2 = counter2;
+}
+
+/**
+ * FI target of the char.unrolled.mem.op.loop test.
+ *
+ * @returns A counter in memory incremented 10000 times.
+ */
+static uint32_t char_unrolled_mem_op_loop(void) {
+  uint32_t loop_counter = 0;
+  sca_set_trigger_high();
+  asm volatile(NOP100);
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
+  sca_set_trigger_low();
+  return loop_counter;
+}
+
+/**
+ * FI target of the char.reg.op.loop test.
+ *
+ * Increments and decrements two counters in registers 10000 times.
+ *
+ * @param[out] loop_counter1 The incremented counter, 10000 without a fault.
+ * @param[out] loop_counter2 The decremented counter, 0 without a fault.
+ */
+static void char_reg_op_loop(uint32_t *loop_counter1,
+                             uint32_t *loop_counter2) {
+  sca_set_trigger_high();
+  asm volatile(INITX5);
+  asm volatile(INITX6);
+  asm volatile(NOP100);
+  for (int loop_cnt = 0; loop_cnt < 10000; loop_cnt++) {
+    asm volatile(ADDI1);
+    asm volatile(SUBI1);
+  }
+  asm volatile("mv %0, x5" : "=r"(*loop_counter1));
+  asm volatile("mv %0, x6" : "=r"(*loop_counter2));
+  sca_set_trigger_low();
+}
+
+/**
+ * FI target of the char.unrolled.reg.op.loop test.
+ *
+ * @returns A counter in a register incremented 10000 times.
+ */
+static uint32_t char_unrolled_reg_op_loop(void) {
+  uint32_t loop_counter;
+  sca_set_trigger_high();
+  asm volatile(INITX5);
+  asm volatile(NOP100);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile(ADDI1000);
+  asm volatile("mv %0, x5" : "=r"(loop_counter));
+  sca_set_trigger_low();
+  return loop_counter;
+}
+
 status_t handle_ibex_fi_char_mem_op_loop(ujson_t *uj) {
   // Configure Ibex to allow reading ERR_STATUS register.
   dif_rv_core_ibex_t rv_core_ibex;
@@ -723,15 +822,9 @@ status_t handle_ibex_fi_char_mem_op_loop(ujson_t *uj) {
       &rv_core_ibex));
 
   // FI code target.
-  uint32_t loop_counter1 = 0;
-  uint32_t loop_counter2 = 10000;
-  sca_set_trigger_high();
-  asm volatile(NOP100);
-  for (int loop_cnt = 0; loop_cnt < 10000; loop_cnt++) {
-    asm volatile(LWADDISW1 : : "r"((uint32_t *)&loop_counter1));
-    asm volatile(LWSUBISW1 : : "r"((uint32_t *)&loop_counter2));
-  }
-  sca_set_trigger_low();
+  uint32_t loop_counter1;
+  uint32_t loop_counter2;
+  char_mem_op_loop(&loop_counter1, &loop_counter2);
 
   // Read ERR_STATUS register.
   dif_rv_core_ibex_error_status_t codes;
@@ -754,20 +847,7 @@ status_t handle_ibex_fi_char_unrolled_mem_op_loop(ujson_t *uj) {
       &rv_core_ibex));
 
   // FI code target.
-  uint32_t loop_counter = 0;
-  sca_set_trigger_high();
-  asm volatile(NOP100);
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  asm volatile(LWADDISW1000 : : "r"((uint32_t *)&loop_counter));
-  sca_set_trigger_low();
+  uint32_t loop_counter = char_unrolled_mem_op_loop();
 
   // Read ERR_STATUS register.
   dif_rv_core_ibex_error_status_t codes;
@@ -789,19 +869,9 @@ status_t handle_ibex_fi_char_reg_op_loop(ujson_t *uj) {
       &rv_core_ibex));
 
   // FI code target.
-  uint32_t loop_counter1 = 0;
-  uint32_t loop_counter2 = 10000;
-  sca_set_trigger_high();
-  asm volatile(INITX5);
-  asm volatile(INITX6);
-  asm volatile(NOP100);
-  for (int loop_cnt = 0; loop_cnt < 10000; loop_cnt++) {
-    asm volatile(ADDI1);
-    asm volatile(SUBI1);
-  }
-  asm volatile("mv %0, x5" : "=r"(loop_counter1));
-  asm volatile("mv %0, x6" : "=r"(loop_counter2));
-  sca_set_trigger_low();
+  uint32_t loop_counter1;
+  uint32_t loop_counter2;
+  char_reg_op_loop(&loop_counter1, &loop_counter2);
 
   // Read ERR_STATUS register.
   dif_rv_core_ibex_error_status_t codes;
@@ -824,22 +894,7 @@ status_t handle_ibex_fi_char_unrolled_reg_op_loop(ujson_t *uj) {
       &rv_core_ibex));
 
   // FI code target.
-  uint32_t loop_counter = 0;
-  sca_set_trigger_high();
-  asm volatile(INITX5);
-  asm volatile(NOP100);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile(ADDI1000);
-  asm volatile("mv %0, x5" : "=r"(loop_counter));
-  sca_set_trigger_low();
+  uint32_t loop_counter = char_unrolled_reg_op_loop();
 
   // Read ERR_STATUS register.
   dif_rv_core_ibex_error_status_t codes;
@@ -956,6 +1011,71 @@ status_t handle_ibex_fi_char_register_file_read(ujson_t *uj) {
   return OK_STATUS();
 }
 
+status_t handle_ibex_fi_campaign(ujson_t *uj) {
+  ibex_fi_campaign_cfg_t uj_cfg;
+  TRY(ujson_deserialize_ibex_fi_campaign_cfg_t(uj, &uj_cfg));
+
+  // Configure Ibex to allow reading ERR_STATUS register.
+  dif_rv_core_ibex_t rv_core_ibex;
+  TRY(dif_rv_core_ibex_init(
+      mmio_region_from_addr(TOP_EARLGREY_RV_CORE_IBEX_CFG_BASE_ADDR),
+      &rv_core_ibex));
+
+  sca_fi_campaign_t campaign;
+  sca_fi_campaign_init(&campaign);
+  for (uint32_t i = 0; i < uj_cfg.iterations; ++i) {
+    uint32_t result1 = 0;
+    uint32_t result2 = 0;
+    bool correct;
+    switch (uj_cfg.target) {
+      case kIbexFiSubcommandCharMemOpLoop:
+        char_mem_op_loop(&result1, &result2);
+        correct = result1 == 10000 && result2 == 0;
+        break;
+      case kIbexFiSubcommandCharUnrolledMemOpLoop:
+        result1 = char_unrolled_mem_op_loop();
+        correct = result1 == 10000;
+        break;
+      case kIbexFiSubcommandCharRegOpLoop:
+        char_reg_op_loop(&result1, &result2);
+        correct = result1 == 10000 && result2 == 0;
+        break;
+      case kIbexFiSubcommandCharUnrolledRegOpLoop:
+        result1 = char_unrolled_reg_op_loop();
+        correct = result1 == 10000;
+        break;
+      default:
+        LOG_ERROR("Unsupported IBEX FI campaign target: %d", uj_cfg.target);
+        return INVALID_ARGUMENT();
+    }
+
+    dif_rv_core_ibex_error_status_t codes;
+    TRY(dif_rv_core_ibex_get_error_status(&rv_core_ibex, &codes));
+    if (codes != 0) {
+      TRY(dif_rv_core_ibex_clear_error_status(&rv_core_ibex, codes));
+    }
+    sca_fi_campaign_record(&campaign, i, correct, result1, result2, codes);
+  }
+
+  // Send the campaign summary to host.
+  sca_fi_sample_t samples[kScaFiCampaignNumSamples];
+  ibex_fi_campaign_result_t uj_output;
+  memset(&uj_output, 0, sizeof(uj_output));
+  uj_output.no_effect = campaign.outcomes[kScaFiOutcomeNoEffect];
+  uj_output.alert = campaign.outcomes[kScaFiOutcomeAlert];
+  uj_output.wrong_result = campaign.outcomes[kScaFiOutcomeWrongResult];
+  uj_output.num_anomalies = campaign.num_anomalies;
+  uj_output.num_samples = sca_fi_campaign_samples(&campaign, samples);
+  for (size_t i = 0; i < uj_output.num_samples; ++i) {
+    uj_output.samples[i].iteration = samples[i].iteration;
+    uj_output.samples[i].result1 = samples[i].result1;
+    uj_output.samples[i].result2 = samples[i].result2;
+    uj_output.samples[i].err_status = samples[i].err_status;
+  }
+  RESP_OK(ujson_serialize_ibex_fi_campaign_result_t, uj, &uj_output);
+  return OK_STATUS();
+}
+
 status_t handle_ibex_fi_init_trigger(ujson_t *uj) {
   sca_select_trigger_type(kScaTriggerTypeSw);
   // As we are using the software defined trigger, the first argument of
@@ -1012,6 +1132,8 @@ status_t handle_ibex_fi(ujson_t *uj) {
       return handle_ibex_fi_address_translation_config(uj);
     case kIbexFiSubcommandAddressTranslation:
       return handle_ibex_fi_address_translation(uj);
+    case kIbexFiSubcommandCampaign:
+      return handle_ibex_fi_campaign(uj);
     default:
       LOG_ERROR("Unrecognized IBEX FI subcommand: %d", cmd);
       return INVALID_ARGUMENT();
@@ -276,6 +276,22 @@ status_t handle_ibex_fi_char_unrolled_mem_op_loop(ujson_t *uj);
  */
 status_t handle_ibex_fi_char_unrolled_reg_op_loop(ujson_t *uj);
 
+/**
+ * ibex.fi.campaign command handler.
+ *
+ * Runs a number of fault injection attempts on one of the mem/reg op loop
+ * targets without a host round trip per attempt. Each attempt is classified
+ * as no effect, alert (non-zero ERR_STATUS) or wrong result. Only the outcome
+ * counters and the most recent anomalous attempts are sent back at the end.
+ * ERR_STATUS is cleared after an alert so that attempts are classified
+ * independently. Attempts that crash the chip never report back; the host
+ * detects those by the missing response.
+ *
+ * @param uj An initialized uJSON context.
+ * @return OK or error.
+ */
+status_t handle_ibex_fi_campaign(ujson_t *uj);
+
 /**
  * Initializes the trigger and configures the device for the Ibex FI test.
  *
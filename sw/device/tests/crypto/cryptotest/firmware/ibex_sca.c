@@ -13,6 +13,7 @@
 #include "sw/device/lib/testing/test_framework/ottf_test_config.h"
 #include "sw/device/lib/testing/test_framework/ujson_ottf.h"
 #include "sw/device/lib/ujson/ujson.h"
+#include "sw/device/sca/lib/prng.h"
 #include "sw/device/sca/lib/sca.h"
 #include "sw/device/tests/crypto/cryptotest/firmware/sca_lib.h"
 #include "sw/device/tests/crypto/cryptotest/json/ibex_sca_commands.h"
@@ -97,6 +98,39 @@ status_t handle_ibex_sca_tl_write(ujson_t *uj) {
   return OK_STATUS();
 }
 
+status_t handle_ibex_sca_tl_write_batch_random(ujson_t *uj) {
+  // Get number of iterations.
+  ibex_sca_test_data_t uj_data;
+  TRY(ujson_deserialize_ibex_sca_test_data_t(uj, &uj_data));
+
+  // Get address of buffer located in SRAM.
+  uintptr_t sram_main_buffer_addr = (uintptr_t)&sram_main_buffer;
+  mmio_region_t sram_region_main_addr =
+      mmio_region_from_addr(sram_main_buffer_addr);
+
+  uint32_t data[8];
+  ibex_sca_batch_digest_t uj_output;
+  memset(uj_output.batch_digest, 0, sizeof(uj_output.batch_digest));
+
+  // SCA code target.
+  for (int it = 0; it < uj_data.num_iterations; it++) {
+    // Generate the data for this iteration outside of the trigger window.
+    prng_rand_bytes((uint8_t *)data, sizeof(data));
+    sca_set_trigger_high();
+    // Write generated data into SRAM.
+    for (int i = 0; i < 8; i++) {
+      mmio_region_write32(sram_region_main_addr,
+                          i * (ptrdiff_t)sizeof(uint32_t), data[i]);
+    }
+    sca_set_trigger_low();
+    sca_batch_digest_update(uj_output.batch_digest, data, ARRAYSIZE(data));
+  }
+
+  // Send the batch digest to the host for verification.
+  RESP_OK(ujson_serialize_ibex_sca_batch_digest_t, uj, &uj_output);
+  return OK_STATUS();
+}
+
 status_t handle_ibex_sca_tl_read(ujson_t *uj) {
   // Get data to write into SRAM.
   ibex_sca_test_data_t uj_data;
@@ -156,6 +190,37 @@ status_t handle_ibex_sca_register_file_write(ujson_t *uj) {
   return OK_STATUS();
 }
 
+status_t handle_ibex_sca_register_file_write_batch_random(ujson_t *uj) {
+  // Get number of iterations.
+  ibex_sca_test_data_t uj_data;
+  TRY(ujson_deserialize_ibex_sca_test_data_t(uj, &uj_data));
+
+  uint32_t data[8];
+  ibex_sca_batch_digest_t uj_output;
+  memset(uj_output.batch_digest, 0, sizeof(uj_output.batch_digest));
+
+  // SCA code target.
+  for (int it = 0; it < uj_data.num_iterations; it++) {
+    // Generate the data for this iteration outside of the trigger window.
+    prng_rand_bytes((uint8_t *)data, sizeof(data));
+    sca_set_trigger_high();
+    // Write generated data into register file.
+    asm volatile("mv x5, %0" : : "r"(data[0]));
+    asm volatile("mv x6, %0" : : "r"(data[1]));
+    asm volatile("mv x7, %0" : : "r"(data[2]));
+    asm volatile("mv x28, %0" : : "r"(data[3]));
+    asm volatile("mv x29, %0" : : "r"(data[4]));
+    asm volatile("mv x30, %0" : : "r"(data[5]));
+    asm volatile("mv x31, %0" : : "r"(data[6]));
+    sca_set_trigger_low();
+    sca_batch_digest_update(uj_output.batch_digest, data, ARRAYSIZE(data));
+  }
+
+  // Send the batch digest to the host for verification.
+  RESP_OK(ujson_serialize_ibex_sca_batch_digest_t, uj, &uj_output);
+  return OK_STATUS();
+}
+
 status_t handle_ibex_sca_register_file_read(ujson_t *uj) {
   // Get data to write into RF.
   ibex_sca_test_data_t uj_data;
@@ -211,6 +276,10 @@ status_t handle_ibex_sca(ujson_t *uj) {
       return handle_ibex_sca_tl_read(uj);
     case kIbexScaSubcommandTLWrite:
       return handle_ibex_sca_tl_write(uj);
+    case kIbexScaSubcommandRFWriteBatchRandom:
+      return handle_ibex_sca_register_file_write_batch_random(uj);
+    case kIbexScaSubcommandTLWriteBatchRandom:
+      return handle_ibex_sca_tl_write_batch_random(uj);
     case kIbexScaSubcommandKeySideloading:
       return handle_ibex_sca_key_sideloading(uj);
     default:
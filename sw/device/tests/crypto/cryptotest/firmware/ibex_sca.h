@@ -41,6 +41,24 @@ status_t handle_ibex_sca_key_sideloading(ujson_t *uj);
  */
 status_t handle_ibex_sca_tl_write(ujson_t *uj);
 
+/**
+ * ibex.sca.tl_write_batch_random
+ *
+ * This SCA penetration test executes the following instructions:
+ * - Loop num_iterations:
+ *  - Generate random data with the SCA PRNG
+ *  - Set trigger
+ *  - Write the data over TL-UL into SRAM.
+ *  - Unset trigger
+ *
+ * SCA traces are captured during trigger_high & trigger_low. The XOR of all
+ * written data is sent back once at the end of the batch.
+ *
+ * @param uj An initialized uJSON context.
+ * @return OK or error.
+ */
+status_t handle_ibex_sca_tl_write_batch_random(ujson_t *uj);
+
 /**
  * ibex.sca.tl_read
  *
@@ -73,6 +91,24 @@ status_t handle_ibex_sca_tl_read(ujson_t *uj);
  */
 status_t handle_ibex_sca_register_file_write(ujson_t *uj);
 
+/**
+ * ibex.sca.register_file_write_batch_random
+ *
+ * This SCA penetration test executes the following instructions:
+ * - Loop num_iterations:
+ *  - Generate random data with the SCA PRNG
+ *  - Set trigger
+ *  - Write the data to registers in RF
+ *  - Unset trigger
+ *
+ * SCA traces are captured during trigger_high & trigger_low. The XOR of all
+ * written data is sent back once at the end of the batch.
+ *
+ * @param uj An initialized uJSON context.
+ * @return OK or error.
+ */
+status_t handle_ibex_sca_register_file_write_batch_random(ujson_t *uj);
+
 /**
  * ibex.sca.register_file_read
  *
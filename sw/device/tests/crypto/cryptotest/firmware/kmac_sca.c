@@ -657,17 +657,16 @@ status_t handle_kmac_sca_batch(ujson_t *uj) {
   uint32_t batch_digest[kDigestLength];
 
   num_encryptions = read_32(uj_data.data);
+  if (num_encryptions > kNumBatchOpsMax) {
+    return OUT_OF_RANGE();
+  }
 
   for (uint32_t j = 0; j < kDigestLength; ++j) {
     batch_digest[j] = 0;
   }
 
   for (uint32_t i = 0; i < num_encryptions; ++i) {
-    if (run_fixed) {
-      memcpy(kmac_batch_keys[i], key_fixed, kKeyLength);
-    } else {
-      prng_rand_bytes(kmac_batch_keys[i], kKeyLength);
-    }
+    sca_batch_fvsr_input(kmac_batch_keys[i], key_fixed, kKeyLength, run_fixed);
     prng_rand_bytes(batch_messages[i], kMessageLength);
     run_fixed = batch_messages[i][0] & 0x1;
   }
@@ -688,11 +687,8 @@ status_t handle_kmac_sca_batch(ujson_t *uj) {
     }
 
     // The correctness of each batch is verified by computing and sending
-    // the batch digest. This digest is computed by XORing all outputs of
-    // the batch.
-    for (uint32_t j = 0; j < kDigestLength; ++j) {
-      batch_digest[j] ^= out[j];
-    }
+    // the batch digest.
+    sca_batch_digest_update(batch_digest, out, kDigestLength);
   }
   // Send the batch digest to the host for verification.
   cryptotest_kmac_sca_batch_digest_t uj_output;
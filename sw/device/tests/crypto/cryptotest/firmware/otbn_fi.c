@@ -4,6 +4,8 @@
 
 #include "sw/device/tests/crypto/cryptotest/firmware/otbn_fi.h"
 
+#include <assert.h>
+
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/runtime/log.h"
@@ -12,12 +14,16 @@
 #include "sw/device/lib/testing/test_framework/ujson_ottf.h"
 #include "sw/device/lib/ujson/ujson.h"
 #include "sw/device/sca/lib/sca.h"
+#include "sw/device/tests/crypto/cryptotest/firmware/sca_lib.h"
 #include "sw/device/tests/crypto/cryptotest/firmware/status.h"
 #include "sw/device/tests/crypto/cryptotest/json/otbn_fi_commands.h"
 
 #include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
 #include "otbn_regs.h"
 
+static_assert(OTBNFI_CAMPAIGN_MAX_SAMPLES == kScaFiCampaignNumSamples,
+              "Campaign sample count mismatch");
+
 /**
  * Reat the error bits of the OTBN accelerator.
  *
@@ -31,6 +37,56 @@ status_t read_otbn_err_bits(dif_otbn_err_bits_t *err_bits) {
   return OK_STATUS(0);
 }
 
+OTBN_DECLARE_APP_SYMBOLS(otbn_char_hardware_dmem_op_loop);
+OTBN_DECLARE_SYMBOL_ADDR(otbn_char_hardware_dmem_op_loop, lc);
+static const otbn_app_t kOtbnAppCharHardwareDmemOpLoop =
+    OTBN_APP_T_INIT(otbn_char_hardware_dmem_op_loop);
+static const otbn_addr_t kOtbnAppCharHardwareDmemOpLoopLC =
+    OTBN_ADDR_T_INIT(otbn_char_hardware_dmem_op_loop, lc);
+
+OTBN_DECLARE_APP_SYMBOLS(otbn_char_hardware_reg_op_loop);
+OTBN_DECLARE_SYMBOL_ADDR(otbn_char_hardware_reg_op_loop, lc);
+static const otbn_app_t kOtbnAppCharHardwareRegOpLoop =
+    OTBN_APP_T_INIT(otbn_char_hardware_reg_op_loop);
+static const otbn_addr_t kOtbnAppCharHardwareRegOpLoopLC =
+    OTBN_ADDR_T_INIT(otbn_char_hardware_reg_op_loop, lc);
+
+OTBN_DECLARE_APP_SYMBOLS(otbn_char_unrolled_dmem_op_loop);
+OTBN_DECLARE_SYMBOL_ADDR(otbn_char_unrolled_dmem_op_loop, lc);
+static const otbn_app_t kOtbnAppCharUnrolledDmemOpLoop =
+    OTBN_APP_T_INIT(otbn_char_unrolled_dmem_op_loop);
+static const otbn_addr_t kOtbnAppCharUnrolledDmemOpLoopLC =
+    OTBN_ADDR_T_INIT(otbn_char_unrolled_dmem_op_loop, lc);
+
+OTBN_DECLARE_APP_SYMBOLS(otbn_char_unrolled_reg_op_loop);
+OTBN_DECLARE_SYMBOL_ADDR(otbn_char_unrolled_reg_op_loop, lc);
+static const otbn_app_t kOtbnAppCharUnrolledRegOpLoop =
+    OTBN_APP_T_INIT(otbn_char_unrolled_reg_op_loop);
+static const otbn_addr_t kOtbnAppCharUnrolledRegOpLoopLC =
+    OTBN_ADDR_T_INIT(otbn_char_unrolled_reg_op_loop, lc);
+
+/**
+ * Loads and runs one of the loop counter OTBN apps.
+ *
+ * Faults are injected during the trigger_high & trigger_low.
+ *
+ * @param app The OTBN app.
+ * @param lc Address of the loop counter in OTBN data memory.
+ * @param[out] loop_counter The loop counter after the app finished.
+ */
+static void otbn_fi_run_loop_app(const otbn_app_t app, otbn_addr_t lc,
+                                 uint32_t *loop_counter) {
+  otbn_load_app(app);
+
+  sca_set_trigger_high();
+  otbn_execute();
+  otbn_busy_wait_for_done();
+  sca_set_trigger_low();
+
+  // Read loop counter from OTBN data memory.
+  otbn_dmem_read(1, lc, loop_counter);
+}
+
 /**
  * otbn.fi.char.hardware.dmem.op.loop command handler.
  *
@@ -46,25 +102,10 @@ status_t read_otbn_err_bits(dif_otbn_err_bits_t *err_bits) {
  * @param uj The received uJSON data.
  */
 status_t handle_otbn_fi_char_hardware_dmem_op_loop(ujson_t *uj) {
-  // Initialize OTBN app, load it, and get interface to OTBN data memory.
-  OTBN_DECLARE_APP_SYMBOLS(otbn_char_hardware_dmem_op_loop);
-  OTBN_DECLARE_SYMBOL_ADDR(otbn_char_hardware_dmem_op_loop, lc);
-  const otbn_app_t kOtbnAppCharHardwareDmemOpLoop =
-      OTBN_APP_T_INIT(otbn_char_hardware_dmem_op_loop);
-  static const otbn_addr_t kOtbnAppCharHardwareDmemOpLoopLC =
-      OTBN_ADDR_T_INIT(otbn_char_hardware_dmem_op_loop, lc);
-  otbn_load_app(kOtbnAppCharHardwareDmemOpLoop);
-
-  uint32_t loop_counter;
-
   // FI code target.
-  sca_set_trigger_high();
-  otbn_execute();
-  otbn_busy_wait_for_done();
-  sca_set_trigger_low();
-
-  // Read loop counter from OTBN data memory.
-  otbn_dmem_read(1, kOtbnAppCharHardwareDmemOpLoopLC, &loop_counter);
+  uint32_t loop_counter;
+  otbn_fi_run_loop_app(kOtbnAppCharHardwareDmemOpLoop,
+                       kOtbnAppCharHardwareDmemOpLoopLC, &loop_counter);
 
   // Read ERR_STATUS register from OTBN.
   dif_otbn_err_bits_t err_bits;
@@ -92,25 +133,10 @@ status_t handle_otbn_fi_char_hardware_dmem_op_loop(ujson_t *uj) {
  * @param uj The received uJSON data.
  */
 status_t handle_otbn_fi_char_hardware_reg_op_loop(ujson_t *uj) {
-  // Initialize OTBN app, load it, and get interface to OTBN data memory.
-  OTBN_DECLARE_APP_SYMBOLS(otbn_char_hardware_reg_op_loop);
-  OTBN_DECLARE_SYMBOL_ADDR(otbn_char_hardware_reg_op_loop, lc);
-  const otbn_app_t kOtbnAppCharHardwareRegOpLoop =
-      OTBN_APP_T_INIT(otbn_char_hardware_reg_op_loop);
-  static const otbn_addr_t kOtbnAppCharHardwareRegOpLoopLC =
-      OTBN_ADDR_T_INIT(otbn_char_hardware_reg_op_loop, lc);
-  otbn_load_app(kOtbnAppCharHardwareRegOpLoop);
-
-  uint32_t loop_counter;
-
   // FI code target.
-  sca_set_trigger_high();
-  otbn_execute();
-  otbn_busy_wait_for_done();
-  sca_set_trigger_low();
-
-  // Read loop counter from OTBN data memory.
-  otbn_dmem_read(1, kOtbnAppCharHardwareRegOpLoopLC, &loop_counter);
+  uint32_t loop_counter;
+  otbn_fi_run_loop_app(kOtbnAppCharHardwareRegOpLoop,
+                       kOtbnAppCharHardwareRegOpLoopLC, &loop_counter);
 
   // Read ERR_STATUS register from OTBN.
   dif_otbn_err_bits_t err_bits;
@@ -140,25 +166,10 @@ status_t handle_otbn_fi_char_hardware_reg_op_loop(ujson_t *uj) {
  * @param uj The received uJSON data.
  */
 status_t handle_otbn_fi_char_unrolled_dmem_op_loop(ujson_t *uj) {
-  // Initialize OTBN app, load it, and get interface to OTBN data memory.
-  OTBN_DECLARE_APP_SYMBOLS(otbn_char_unrolled_dmem_op_loop);
-  OTBN_DECLARE_SYMBOL_ADDR(otbn_char_unrolled_dmem_op_loop, lc);
-  const otbn_app_t kOtbnAppCharUnrolledDmemOpLoop =
-      OTBN_APP_T_INIT(otbn_char_unrolled_dmem_op_loop);
-  static const otbn_addr_t kOtbnAppCharUnrolledDmemOpLoopLC =
-      OTBN_ADDR_T_INIT(otbn_char_unrolled_dmem_op_loop, lc);
-  otbn_load_app(kOtbnAppCharUnrolledDmemOpLoop);
-
-  uint32_t loop_counter;
-
   // FI code target.
-  sca_set_trigger_high();
-  otbn_execute();
-  otbn_busy_wait_for_done();
-  sca_set_trigger_low();
-
-  // Read loop counter from OTBN data memory.
-  otbn_dmem_read(1, kOtbnAppCharUnrolledDmemOpLoopLC, &loop_counter);
+  uint32_t loop_counter;
+  otbn_fi_run_loop_app(kOtbnAppCharUnrolledDmemOpLoop,
+                       kOtbnAppCharUnrolledDmemOpLoopLC, &loop_counter);
 
   // Read ERR_STATUS register from OTBN.
   dif_otbn_err_bits_t err_bits;
@@ -186,25 +197,10 @@ status_t handle_otbn_fi_char_unrolled_dmem_op_loop(ujson_t *uj) {
  * @param uj The received uJSON data.
  */
 status_t handle_otbn_fi_char_unrolled_reg_op_loop(ujson_t *uj) {
-  // Initialize OTBN app, load it, and get interface to OTBN data memory.
-  OTBN_DECLARE_APP_SYMBOLS(otbn_char_unrolled_reg_op_loop);
-  OTBN_DECLARE_SYMBOL_ADDR(otbn_char_unrolled_reg_op_loop, lc);
-  const otbn_app_t kOtbnAppCharUnrolledRegOpLoop =
-      OTBN_APP_T_INIT(otbn_char_unrolled_reg_op_loop);
-  static const otbn_addr_t kOtbnAppCharUnrolledRegOpLoopLC =
-      OTBN_ADDR_T_INIT(otbn_char_unrolled_reg_op_loop, lc);
-  otbn_load_app(kOtbnAppCharUnrolledRegOpLoop);
-
-  uint32_t loop_counter;
-
   // FI code target.
-  sca_set_trigger_high();
-  otbn_execute();
-  otbn_busy_wait_for_done();
-  sca_set_trigger_low();
-
-  // Read loop counter from OTBN data memory.
-  otbn_dmem_read(1, kOtbnAppCharUnrolledRegOpLoopLC, &loop_counter);
+  uint32_t loop_counter;
+  otbn_fi_run_loop_app(kOtbnAppCharUnrolledRegOpLoop,
+                       kOtbnAppCharUnrolledRegOpLoopLC, &loop_counter);
 
   // Read ERR_STATUS register from OTBN.
   dif_otbn_err_bits_t err_bits;
@@ -218,6 +214,81 @@ status_t handle_otbn_fi_char_unrolled_reg_op_loop(ujson_t *uj) {
   return OK_STATUS(0);
 }
 
+/**
+ * otbn.fi.campaign command handler.
+ *
+ * Runs a number of fault injection attempts on one of the loop counter apps
+ * without a host round trip per attempt. The app is reloaded for every
+ * attempt. Each attempt is classified as no effect, alert (non-zero ERR_BITS)
+ * or wrong result. Only the outcome counters and the most recent anomalous
+ * attempts are sent back at the end. Attempts that crash the chip never
+ * report back; the host detects those by the missing response.
+ *
+ * @param uj The received uJSON data.
+ */
+status_t handle_otbn_fi_campaign(ujson_t *uj) {
+  otbn_fi_campaign_cfg_t uj_cfg;
+  TRY(ujson_deserialize_otbn_fi_campaign_cfg_t(uj, &uj_cfg));
+
+  const otbn_app_t *app;
+  otbn_addr_t lc;
+  uint32_t expected;
+  switch (uj_cfg.target) {
+    case kOtbnFiSubcommandCharHardwareDmemOpLoop:
+      app = &kOtbnAppCharHardwareDmemOpLoop;
+      lc = kOtbnAppCharHardwareDmemOpLoopLC;
+      expected = 10000;
+      break;
+    case kOtbnFiSubcommandCharHardwareRegOpLoop:
+      app = &kOtbnAppCharHardwareRegOpLoop;
+      lc = kOtbnAppCharHardwareRegOpLoopLC;
+      expected = 10000;
+      break;
+    case kOtbnFiSubcommandCharUnrolledDmemOpLoop:
+      app = &kOtbnAppCharUnrolledDmemOpLoop;
+      lc = kOtbnAppCharUnrolledDmemOpLoopLC;
+      expected = 100;
+      break;
+    case kOtbnFiSubcommandCharUnrolledRegOpLoop:
+      app = &kOtbnAppCharUnrolledRegOpLoop;
+      lc = kOtbnAppCharUnrolledRegOpLoopLC;
+      expected = 100;
+      break;
+    default:
+      LOG_ERROR("Unsupported OTBN FI campaign target: %d", uj_cfg.target);
+      return INVALID_ARGUMENT();
+  }
+
+  sca_fi_campaign_t campaign;
+  sca_fi_campaign_init(&campaign);
+  for (uint32_t i = 0; i < uj_cfg.iterations; ++i) {
+    uint32_t loop_counter;
+    otbn_fi_run_loop_app(*app, lc, &loop_counter);
+
+    dif_otbn_err_bits_t err_bits;
+    read_otbn_err_bits(&err_bits);
+    sca_fi_campaign_record(&campaign, i, loop_counter == expected,
+                           loop_counter, 0, err_bits);
+  }
+
+  // Send the campaign summary to host.
+  sca_fi_sample_t samples[kScaFiCampaignNumSamples];
+  otbn_fi_campaign_result_t uj_output;
+  memset(&uj_output, 0, sizeof(uj_output));
+  uj_output.no_effect = campaign.outcomes[kScaFiOutcomeNoEffect];
+  uj_output.alert = campaign.outcomes[kScaFiOutcomeAlert];
+  uj_output.wrong_result = campaign.outcomes[kScaFiOutcomeWrongResult];
+  uj_output.num_anomalies = campaign.num_anomalies;
+  uj_output.num_samples = sca_fi_campaign_samples(&campaign, samples);
+  for (size_t i = 0; i < uj_output.num_samples; ++i) {
+    uj_output.samples[i].iteration = samples[i].iteration;
+    uj_output.samples[i].loop_counter = samples[i].result1;
+    uj_output.samples[i].err_status = samples[i].err_status;
+  }
+  RESP_OK(ujson_serialize_otbn_fi_campaign_result_t, uj, &uj_output);
+  return OK_STATUS(0);
+}
+
 /**
  * Initializes the SCA trigger.
  *
@@ -253,6 +324,8 @@ status_t handle_otbn_fi(ujson_t *uj) {
       return handle_otbn_fi_char_hardware_reg_op_loop(uj);
     case kOtbnFiSubcommandCharHardwareDmemOpLoop:
       return handle_otbn_fi_char_hardware_dmem_op_loop(uj);
+    case kOtbnFiSubcommandCampaign:
+      return handle_otbn_fi_campaign(uj);
     default:
       LOG_ERROR("Unrecognized OTBN FI subcommand: %d", cmd);
       return INVALID_ARGUMENT();
@@ -2,8 +2,12 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include "sw/device/tests/crypto/cryptotest/firmware/sca_lib.h"
+
 #include "sw/device/lib/base/csr.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/sca/lib/prng.h"
 
 /**
  * Configures Ibex for SCA and FI.
@@ -25,3 +29,63 @@ void sca_configure_cpu(void) {
   // Write back config.
   CSR_WRITE(CSR_REG_CPUCTRL, cpuctrl_csr);
 }
+
+void sca_batch_fvsr_input(uint8_t *dest, const uint8_t *fixed, size_t len,
+                          bool use_fixed) {
+  if (use_fixed) {
+    memcpy(dest, fixed, len);
+  } else {
+    prng_rand_bytes(dest, len);
+  }
+}
+
+void sca_batch_digest_update(uint32_t *digest, const uint32_t *result,
+                             size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    digest[i] ^= result[i];
+  }
+}
+
+void sca_fi_campaign_init(sca_fi_campaign_t *campaign) {
+  memset(campaign, 0, sizeof(*campaign));
+}
+
+sca_fi_outcome_t sca_fi_campaign_record(sca_fi_campaign_t *campaign,
+                                        uint32_t iteration, bool correct,
+                                        uint32_t result1, uint32_t result2,
+                                        uint32_t err_status) {
+  sca_fi_outcome_t outcome = kScaFiOutcomeNoEffect;
+  if (err_status != 0) {
+    outcome = kScaFiOutcomeAlert;
+  } else if (!correct) {
+    outcome = kScaFiOutcomeWrongResult;
+  }
+  ++campaign->outcomes[outcome];
+
+  if (outcome != kScaFiOutcomeNoEffect) {
+    campaign->samples[campaign->num_anomalies % kScaFiCampaignNumSamples] =
+        (sca_fi_sample_t){
+            .iteration = iteration,
+            .result1 = result1,
+            .result2 = result2,
+            .err_status = err_status,
+        };
+    ++campaign->num_anomalies;
+  }
+  return outcome;
+}
+
+size_t sca_fi_campaign_samples(const sca_fi_campaign_t *campaign,
+                               sca_fi_sample_t *samples) {
+  if (campaign->num_anomalies <= kScaFiCampaignNumSamples) {
+    memcpy(samples, campaign->samples,
+           campaign->num_anomalies * sizeof(*samples));
+    return campaign->num_anomalies;
+  }
+  // The ring is full, the oldest sample is the next one to be overwritten.
+  size_t oldest = campaign->num_anomalies % kScaFiCampaignNumSamples;
+  for (size_t i = 0; i < kScaFiCampaignNumSamples; ++i) {
+    samples[i] = campaign->samples[(oldest + i) % kScaFiCampaignNumSamples];
+  }
+  return kScaFiCampaignNumSamples;
+}
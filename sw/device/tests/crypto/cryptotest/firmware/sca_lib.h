@@ -5,6 +5,123 @@
 #ifndef OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_FIRMWARE_SCA_LIB_H_
 #define OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_FIRMWARE_SCA_LIB_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 void sca_configure_cpu(void);
 
+/**
+ * Fills in the input of one operation of a fixed-vs-random batch.
+ *
+ * Copies `fixed` to `dest` if `use_fixed` is set, and fills `dest` from the
+ * SCA PRNG otherwise. The PRNG is only advanced for random inputs, so the host
+ * can replay the batch from the PRNG seed.
+ *
+ * @param[out] dest The input of the operation.
+ * @param fixed The fixed input.
+ * @param len Length of the input in bytes.
+ * @param use_fixed Whether to use the fixed input.
+ */
+void sca_batch_fvsr_input(uint8_t *dest, const uint8_t *fixed, size_t len,
+                          bool use_fixed);
+
+/**
+ * Folds the result of one batch operation into the batch digest.
+ *
+ * The batch digest is the XOR of the results of all operations in the batch.
+ * It is sent to the host in a single response at the end of the batch, so
+ * that the host can check the batch without a round trip per operation.
+ *
+ * @param[in,out] digest The batch digest, zeroed before the first operation.
+ * @param result The result of the operation.
+ * @param len Length of the result in 32-bit words.
+ */
+void sca_batch_digest_update(uint32_t *digest, const uint32_t *result,
+                             size_t len);
+
+/**
+ * Outcome classes of a single fault injection attempt.
+ */
+typedef enum sca_fi_outcome {
+  /** The result was correct and no error was reported. */
+  kScaFiOutcomeNoEffect = 0,
+  /** The target reported an error, regardless of the result. */
+  kScaFiOutcomeAlert = 1,
+  /** The result was wrong and no error was reported. */
+  kScaFiOutcomeWrongResult = 2,
+  kScaFiOutcomeNumClasses,
+} sca_fi_outcome_t;
+
+enum {
+  /**
+   * Number of anomalous attempts kept by a fault injection campaign.
+   */
+  kScaFiCampaignNumSamples = 8,
+};
+
+/**
+ * An anomalous fault injection attempt.
+ */
+typedef struct sca_fi_sample {
+  /** Index of the attempt within the campaign. */
+  uint32_t iteration;
+  /** Results of the attempt, unused results are zero. */
+  uint32_t result1;
+  uint32_t result2;
+  /** Error status reported by the target. */
+  uint32_t err_status;
+} sca_fi_sample_t;
+
+/**
+ * Outcome aggregation of an on-device fault injection campaign.
+ *
+ * Running the attempts of a campaign on the device and only reporting the
+ * aggregate avoids a uJSON round trip per glitch.
+ */
+typedef struct sca_fi_campaign {
+  /** Number of attempts per outcome class. */
+  uint32_t outcomes[kScaFiOutcomeNumClasses];
+  /** Ring of the most recent anomalous attempts. */
+  sca_fi_sample_t samples[kScaFiCampaignNumSamples];
+  /** Total number of anomalous attempts. */
+  uint32_t num_anomalies;
+} sca_fi_campaign_t;
+
+/**
+ * Resets a fault injection campaign.
+ *
+ * @param[out] campaign The campaign.
+ */
+void sca_fi_campaign_init(sca_fi_campaign_t *campaign);
+
+/**
+ * Classifies a fault injection attempt and records it in the campaign.
+ *
+ * Attempts that are not classified as `kScaFiOutcomeNoEffect` are also added
+ * to the sample ring, overwriting the oldest sample once it is full.
+ *
+ * @param[in,out] campaign The campaign.
+ * @param iteration Index of the attempt.
+ * @param correct Whether the results of the attempt match the expected ones.
+ * @param result1 First result of the attempt.
+ * @param result2 Second result of the attempt, zero if unused.
+ * @param err_status Error status reported by the target, zero if none.
+ * @return The outcome class of the attempt.
+ */
+sca_fi_outcome_t sca_fi_campaign_record(sca_fi_campaign_t *campaign,
+                                        uint32_t iteration, bool correct,
+                                        uint32_t result1, uint32_t result2,
+                                        uint32_t err_status);
+
+/**
+ * Copies the sampled anomalous attempts of a campaign, oldest first.
+ *
+ * @param campaign The campaign.
+ * @param[out] samples Buffer for `kScaFiCampaignNumSamples` samples.
+ * @return The number of samples copied.
+ */
+size_t sca_fi_campaign_samples(const sca_fi_campaign_t *campaign,
+                               sca_fi_sample_t *samples);
+
 #endif  // OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_FIRMWARE_SCA_LIB_H_
@@ -513,17 +513,17 @@ status_t handle_sha3_sca_batch(ujson_t *uj) {
   uint32_t batch_digest[kDigestLength];
   uint8_t dummy_message[kMessageLength];
   num_hashes = read_32(uj_data.data);
+  if (num_hashes > kNumBatchOpsMax) {
+    return OUT_OF_RANGE();
+  }
 
   for (uint32_t j = 0; j < kDigestLength; ++j) {
     batch_digest[j] = 0;
   }
 
   for (uint32_t i = 0; i < num_hashes; ++i) {
-    if (run_fixed) {
-      memcpy(sha3_batch_messages[i], message_fixed, kMessageLength);
-    } else {
-      prng_rand_bytes(sha3_batch_messages[i], kMessageLength);
-    }
+    sca_batch_fvsr_input(sha3_batch_messages[i], message_fixed, kMessageLength,
+                         run_fixed);
     prng_rand_bytes(dummy_message, kMessageLength);
     run_fixed = dummy_message[0] & 0x1;
   }
@@ -542,11 +542,8 @@ status_t handle_sha3_sca_batch(ujson_t *uj) {
     }
 
     // The correctness of each batch is verified by computing and sending
-    // the batch digest. This digest is computed by XORing all outputs of
-    // the batch.
-    for (uint32_t j = 0; j < kDigestLength; ++j) {
-      batch_digest[j] ^= out[j];
-    }
+    // the batch digest.
+    sca_batch_digest_update(batch_digest, out, kDigestLength);
   }
 
   // Acknowledge the batch command. This is crucial to be in sync with the host
@@ -16,6 +16,8 @@ extern "C" {
     value(_, Drbg) \
     value(_, Ecdsa) \
     value(_, Ecdh) \
+    value(_, EcdsaBatch) \
+    value(_, EcdhBatch) \
     value(_, Hash) \
     value(_, Hmac) \
     value(_, Kmac) \
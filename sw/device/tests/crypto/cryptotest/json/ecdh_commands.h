@@ -13,6 +13,8 @@ extern "C" {
 #define ECDH_CMD_MAX_SHARED_SECRET_BYTES 48
 #define ECDH_CMD_MAX_COORDINATE_BYTES 48
 #define ECDH_CMD_MAX_PRIVATE_KEY_SHARE_BYTES 64
+#define ECDH_CMD_MAX_BATCH_ITEMS 16
+#define ECDH_CMD_MAX_BATCH_SHARED_SECRET_BYTES 768
 
 // clang-format off
 
@@ -39,6 +41,27 @@ UJSON_SERDE_STRUCT(CryptotestEcdhCoordinate, cryptotest_ecdh_coordinate_t, ECDH_
     field(shared_secret_len, size_t)
 UJSON_SERDE_STRUCT(CryptotestEcdhDeriveOutput, cryptotest_ecdh_derive_output_t, ECDH_DERIVE_OUTPUT);
 
+// Following an `EcdhBatch` command, the host is expected to send the following parameters, in order:
+// - curve (ECDH_CURVE)
+// - batch (ECDH_BATCH)
+// - `batch.count` times:
+//   - private_key (ECDH_PRIVATE_KEY)
+//   - qx (ECDH_COORDINATE)
+//   - qy (ECDH_COORDINATE)
+// The device will then respond with:
+// - result (ECDH_DERIVE_BATCH_OUTPUT)
+#define ECDH_BATCH(field, string) \
+    field(count, size_t)
+UJSON_SERDE_STRUCT(CryptotestEcdhBatch, cryptotest_ecdh_batch_t, ECDH_BATCH);
+
+// Item `i` of the batch has its shared secret at offset `i * shared_secret_len`.
+#define ECDH_DERIVE_BATCH_OUTPUT(field, string) \
+    field(ok, uint8_t, ECDH_CMD_MAX_BATCH_ITEMS) \
+    field(shared_secrets, uint8_t, ECDH_CMD_MAX_BATCH_SHARED_SECRET_BYTES) \
+    field(count, size_t) \
+    field(shared_secret_len, size_t)
+UJSON_SERDE_STRUCT(CryptotestEcdhDeriveBatchOutput, cryptotest_ecdh_derive_batch_output_t, ECDH_DERIVE_BATCH_OUTPUT);
+
 // clang-format on
 
 #ifdef __cplusplus
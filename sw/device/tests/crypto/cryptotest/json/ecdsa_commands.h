@@ -13,6 +13,7 @@ extern "C" {
 #define ECDSA_CMD_MAX_SIGNATURE_SCALAR_BYTES 64
 #define ECDSA_CMD_MAX_COORDINATE_BYTES 64
 #define ECDSA_CMD_MAX_PRIVATE_KEY_SHARE_BYTES 64
+#define ECDSA_CMD_MAX_BATCH_ITEMS 32
 
 // clang-format off
 
@@ -74,6 +75,28 @@ UJSON_SERDE_STRUCT(CryptotestEcdsaPrivateKey, cryptotest_ecdsa_private_key_t, EC
     value(_, Failure)
 UJSON_SERDE_ENUM(CryptotestEcdsaVerifyOutput, cryptotest_ecdsa_verify_output_t, ECDSA_VERIFY_OUTPUT);
 
+// Following an `EcdsaBatch` command, which verifies signatures against one public key, the host is
+// expected to send the following parameters, in order:
+// - hash_alg (ECDSA_HASH_ALG)
+// - curve (ECDSA_CURVE)
+// - qx (ECDSA_COORDINATE)
+// - qy (ECDSA_COORDINATE)
+// - batch (ECDSA_BATCH)
+// - `batch.count` times:
+//   - message_digest (ECDSA_MESSAGE)
+//   - signature (ECDSA_SIGNATURE)
+// The device will then respond with:
+// - result (ECDSA_VERIFY_BATCH_OUTPUT)
+#define ECDSA_BATCH(field, string) \
+    field(count, size_t)
+UJSON_SERDE_STRUCT(CryptotestEcdsaBatch, cryptotest_ecdsa_batch_t, ECDSA_BATCH);
+
+// `valid[i]` is 1 if the signature of item `i` is valid and 0 otherwise.
+#define ECDSA_VERIFY_BATCH_OUTPUT(field, string) \
+    field(valid, uint8_t, ECDSA_CMD_MAX_BATCH_ITEMS) \
+    field(count, size_t)
+UJSON_SERDE_STRUCT(CryptotestEcdsaVerifyBatchOutput, cryptotest_ecdsa_verify_batch_output_t, ECDSA_VERIFY_BATCH_OUTPUT);
+
 // clang-format on
 
 #ifdef __cplusplus
@@ -9,6 +9,8 @@
 extern "C" {
 #endif
 
+#define IBEXFI_CAMPAIGN_MAX_SAMPLES 8
+
 // clang-format off
 
 #define IBEXFI_SUBCOMMAND(_, value) \
@@ -28,7 +30,8 @@ extern "C" {
     value(_, CharCsrRead) \
     value(_, CharCsrWrite) \
     value(_, AddressTranslationCfg) \
-    value(_, AddressTranslation)
+    value(_, AddressTranslation) \
+    value(_, Campaign)
 UJSON_SERDE_ENUM(IbexFiSubcommand, ibex_fi_subcommand_t, IBEXFI_SUBCOMMAND);
 
 #define IBEXFI_TEST_RESULT(field, string) \
@@ -53,6 +56,27 @@ UJSON_SERDE_STRUCT(IbexFiLoopCounterOutput, ibex_fi_loop_counter_t, IBEXFI_LOOP_
     field(err_status, uint32_t)
 UJSON_SERDE_STRUCT(IbexFiLoopCounterMirroredOutput, ibex_fi_loop_counter_mirrored_t, IBEXFI_LOOP_COUNTER_MIRRORED_OUTPUT);
 
+#define IBEXFI_CAMPAIGN_CFG(field, string) \
+    field(target, ibex_fi_subcommand_t) \
+    field(iterations, uint32_t)
+UJSON_SERDE_STRUCT(IbexFiCampaignCfg, ibex_fi_campaign_cfg_t, IBEXFI_CAMPAIGN_CFG);
+
+#define IBEXFI_CAMPAIGN_SAMPLE(field, string) \
+    field(iteration, uint32_t) \
+    field(result1, uint32_t) \
+    field(result2, uint32_t) \
+    field(err_status, uint32_t)
+UJSON_SERDE_STRUCT(IbexFiCampaignSample, ibex_fi_campaign_sample_t, IBEXFI_CAMPAIGN_SAMPLE);
+
+#define IBEXFI_CAMPAIGN_RESULT(field, string) \
+    field(no_effect, uint32_t) \
+    field(alert, uint32_t) \
+    field(wrong_result, uint32_t) \
+    field(num_anomalies, uint32_t) \
+    field(num_samples, uint32_t) \
+    field(samples, ibex_fi_campaign_sample_t, IBEXFI_CAMPAIGN_MAX_SAMPLES)
+UJSON_SERDE_STRUCT(IbexFiCampaignResult, ibex_fi_campaign_result_t, IBEXFI_CAMPAIGN_RESULT);
+
 // clang-format on
 
 #ifdef __cplusplus
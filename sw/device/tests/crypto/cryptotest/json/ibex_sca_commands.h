@@ -17,6 +17,8 @@ extern "C" {
     value(_, RFWrite) \
     value(_, TLRead) \
     value(_, TLWrite) \
+    value(_, RFWriteBatchRandom) \
+    value(_, TLWriteBatchRandom) \
     value(_, KeySideloading)
 UJSON_SERDE_ENUM(IbexScaSubcommand, ibex_sca_subcommand_t, IBEXSCA_SUBCOMMAND);
 
@@ -38,6 +40,10 @@ UJSON_SERDE_STRUCT(IbexScaKey, ibex_sca_key_t, IBEXSCA_KEY);
     field(result, uint32_t)
 UJSON_SERDE_STRUCT(IbexScaResult, ibex_sca_result_t, IBEXSCA_RESULT);
 
+#define IBEXSCA_BATCH_DIGEST(field, string) \
+    field(batch_digest, uint32_t, 8)
+UJSON_SERDE_STRUCT(IbexScaBatchDigest, ibex_sca_batch_digest_t, IBEXSCA_BATCH_DIGEST);
+
 // clang-format on
 
 #ifdef __cplusplus
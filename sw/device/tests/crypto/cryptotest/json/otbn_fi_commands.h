@@ -9,6 +9,8 @@
 extern "C" {
 #endif
 
+#define OTBNFI_CAMPAIGN_MAX_SAMPLES 8
+
 // clang-format off
 
 #define OTBNFI_SUBCOMMAND(_, value) \
@@ -16,7 +18,8 @@ extern "C" {
     value(_, CharUnrolledRegOpLoop) \
     value(_, CharUnrolledDmemOpLoop) \
     value(_, CharHardwareRegOpLoop) \
-    value(_, CharHardwareDmemOpLoop)
+    value(_, CharHardwareDmemOpLoop) \
+    value(_, Campaign)
 UJSON_SERDE_ENUM(OtbnFiSubcommand, otbn_fi_subcommand_t, OTBNFI_SUBCOMMAND);
 
 #define OTBNFI_LOOP_COUNTER_OUTPUT(field, string) \
@@ -24,6 +27,26 @@ UJSON_SERDE_ENUM(OtbnFiSubcommand, otbn_fi_subcommand_t, OTBNFI_SUBCOMMAND);
     field(err_status, uint32_t)
 UJSON_SERDE_STRUCT(OtbnFiLoopCounterOutput, otbn_fi_loop_counter_t, OTBNFI_LOOP_COUNTER_OUTPUT);
 
+#define OTBNFI_CAMPAIGN_CFG(field, string) \
+    field(target, otbn_fi_subcommand_t) \
+    field(iterations, uint32_t)
+UJSON_SERDE_STRUCT(OtbnFiCampaignCfg, otbn_fi_campaign_cfg_t, OTBNFI_CAMPAIGN_CFG);
+
+#define OTBNFI_CAMPAIGN_SAMPLE(field, string) \
+    field(iteration, uint32_t) \
+    field(loop_counter, uint32_t) \
+    field(err_status, uint32_t)
+UJSON_SERDE_STRUCT(OtbnFiCampaignSample, otbn_fi_campaign_sample_t, OTBNFI_CAMPAIGN_SAMPLE);
+
+#define OTBNFI_CAMPAIGN_RESULT(field, string) \
+    field(no_effect, uint32_t) \
+    field(alert, uint32_t) \
+    field(wrong_result, uint32_t) \
+    field(num_anomalies, uint32_t) \
+    field(num_samples, uint32_t) \
+    field(samples, otbn_fi_campaign_sample_t, OTBNFI_CAMPAIGN_MAX_SAMPLES)
+UJSON_SERDE_STRUCT(OtbnFiCampaignResult, otbn_fi_campaign_result_t, OTBNFI_CAMPAIGN_RESULT);
+
 // clang-format on
 
 #ifdef __cplusplus
@@ -45,9 +45,54 @@ status_t ecdsa_p256_verify_test(
     return OTCRYPTO_RECOV_ERR;
   }
 
+  // Verify again with a precomputed table for the key; the result must match.
+  p256_verify_table_t table;
+  TRY(ecdsa_p256_verify_table_build_start(&testvec->public_key));
+  TRY(ecdsa_p256_verify_table_build_finalize(&table));
+  TRY(ecdsa_p256_verify_table_start(&testvec->signature, digest.data, &table));
+  hardened_bool_t table_result;
+  TRY(ecdsa_p256_verify_finalize(&testvec->signature, &table_result));
+  if (table_result != result) {
+    LOG_ERROR("Verification with table disagrees with plain verification.");
+    return OTCRYPTO_RECOV_ERR;
+  }
+
   return OTCRYPTO_OK;
 }
 
+/**
+ * Runs all test vectors through a single batch of verifications.
+ */
+status_t ecdsa_p256_verify_batch_test(void) {
+  TRY(ecdsa_p256_verify_batch_start());
+  for (uint32_t i = 0; i < kEcdsaP256VerifyNumTests; i++) {
+    const ecdsa_p256_verify_test_vector_t *testvec =
+        &ecdsa_p256_verify_tests[i];
+    otcrypto_const_byte_buf_t msg_buf = {
+        .data = testvec->msg,
+        .len = testvec->msg_len,
+    };
+    uint32_t digest_buf[kSha256DigestWords];
+    otcrypto_hash_digest_t digest = {
+        .mode = kOtcryptoHashModeSha256,
+        .data = digest_buf,
+        .len = kSha256DigestWords,
+    };
+    TRY(otcrypto_hash(msg_buf, digest));
+
+    hardened_bool_t result;
+    TRY(ecdsa_p256_verify_batch_item(&testvec->signature, digest.data,
+                                     &testvec->public_key, &result));
+    hardened_bool_t expected =
+        testvec->valid ? kHardenedBoolTrue : kHardenedBoolFalse;
+    if (result != expected) {
+      LOG_ERROR("Batch verification mismatch on test vector %d.", i + 1);
+      return OTCRYPTO_RECOV_ERR;
+    }
+  }
+  return ecdsa_p256_verify_batch_end();
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
@@ -77,6 +122,12 @@ bool test_main(void) {
       result = false;
     }
   }
+
+  status_t err = ecdsa_p256_verify_batch_test();
+  if (!status_ok(err)) {
+    LOG_ERROR("ecdsa_p256_verify_batch_test failed: %r", err);
+    result = false;
+  }
   LOG_INFO("Finished ecdsa_p256_verify_test:%s", RULE_NAME);
 
   return result;
@@ -0,0 +1,143 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/ecc.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/entropy_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+enum {
+  /* Number of 32-bit words in an Ed25519 public key. */
+  kEd25519PublicKeyWords = 256 / 32,
+  /* Number of 32-bit words in an Ed25519 signature. */
+  kEd25519SignatureWords = 512 / 32,
+};
+
+typedef struct ed25519_verify_test_vector {
+  otcrypto_eddsa_sign_mode_t sign_mode;
+  uint32_t public_key[kEd25519PublicKeyWords];
+  const uint8_t *msg;
+  size_t msg_len;
+  uint32_t signature[kEd25519SignatureWords];
+} ed25519_verify_test_vector_t;
+
+static const uint8_t kMsg2[] = {0x72};
+static const uint8_t kMsgAbc[] = {'a', 'b', 'c'};
+
+/**
+ * Test vectors from RFC 8032, section 7.1 (TEST 1 and TEST 2) and section 7.3
+ * (TEST abc).
+ */
+static const ed25519_verify_test_vector_t kTestVectors[] = {
+    {
+        .sign_mode = kOtcryptoEddsaSignModeEddsa,
+        .public_key = {0x01985ad7, 0xb70ab182, 0xd3fe4bd5, 0x3a0764c9,
+                       0xf372e10e, 0x2523a6da, 0x681a02af, 0x1a5107f7},
+        .msg = NULL,
+        .msg_len = 0,
+        .signature = {0x004356e5, 0x72ac60c3, 0xcce28690, 0x8a826e80,
+                      0x1e7f8784, 0x74d9e5b8, 0x65e073d8, 0x55014922,
+                      0x1582b85f, 0xac3ba390, 0x70391ec6, 0x6bb4f91c,
+                      0xf0f55bd2, 0x24be5b59, 0x43415165, 0x0b107a8e},
+    },
+    {
+        .sign_mode = kOtcryptoEddsaSignModeEddsa,
+        .public_key = {0xc317403d, 0x5a8943e8, 0xa70ab792, 0xbc7e1b4d,
+                       0xcf2c989c, 0x8c96c42e, 0xf155cdc0, 0x0c66f42a},
+        .msg = kMsg2,
+        .msg_len = sizeof(kMsg2),
+        .signature = {0xa909a092, 0xb8cad4f0, 0x0b820e72, 0x4025645f,
+                      0x547bb2a2, 0x8f3f5016, 0x232276b3, 0xda69dbeb,
+                      0xe4c15a08, 0x6e99153e, 0x13368f45, 0x8c1df1d0,
+                      0xae2e7b38, 0xee2a30b4, 0x16290db0, 0x000cbb12},
+    },
+    {
+        .sign_mode = kOtcryptoEddsaSignModeHashEddsa,
+        .public_key = {0x932b17ec, 0x3b565ead, 0x702c93f4, 0x345024e1,
+                       0xef6754c3, 0x644dfd2e, 0x6819f8eb, 0xbfe26734},
+        .msg = kMsgAbc,
+        .msg_len = sizeof(kMsgAbc),
+        .signature = {0x2202a798, 0x1a12b8f0, 0x810fd3a9, 0x803f683d,
+                      0x462b469e, 0x76f87f9c, 0xb99b4939, 0x41ae6d4e,
+                      0x4250f831, 0x352a3c46, 0xd003205a, 0xaaf5ad62,
+                      0x618c0ba1, 0x2a0636e6, 0x2a1cd1aa, 0x06340826},
+    },
+};
+
+/**
+ * Verifies the signature, then checks that a corrupted copy is rejected.
+ */
+status_t ed25519_verify_test(const ed25519_verify_test_vector_t *testvec) {
+  uint32_t pk[kEd25519PublicKeyWords];
+  memcpy(pk, testvec->public_key, sizeof(pk));
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = kOtcryptoKeyModeEd25519,
+      .key_length = sizeof(pk),
+      .key = pk,
+  };
+  public_key.checksum = integrity_unblinded_checksum(&public_key);
+
+  otcrypto_const_byte_buf_t msg = {
+      .data = testvec->msg,
+      .len = testvec->msg_len,
+  };
+  uint32_t sig[kEd25519SignatureWords];
+  memcpy(sig, testvec->signature, sizeof(sig));
+  otcrypto_const_word32_buf_t signature = {
+      .data = sig,
+      .len = ARRAYSIZE(sig),
+  };
+
+  hardened_bool_t result;
+  TRY(otcrypto_ed25519_verify(&public_key, msg, testvec->sign_mode, signature,
+                              &result));
+  if (result != kHardenedBoolTrue) {
+    LOG_ERROR("Valid signature failed verification.");
+    return OTCRYPTO_RECOV_ERR;
+  }
+
+  // Flip a bit of S; the signature must no longer verify.
+  sig[kEd25519SignatureWords / 2] ^= 1;
+  TRY(otcrypto_ed25519_verify(&public_key, msg, testvec->sign_mode, signature,
+                              &result));
+  if (result != kHardenedBoolFalse) {
+    LOG_ERROR("Invalid signature passed verification.");
+    return OTCRYPTO_RECOV_ERR;
+  }
+
+  return OTCRYPTO_OK;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  // Stays true only if all tests pass.
+  bool result = true;
+
+  CHECK_STATUS_OK(entropy_testutils_auto_mode_init());
+
+  for (uint32_t i = 0; i < ARRAYSIZE(kTestVectors); i++) {
+    LOG_INFO("Starting ed25519_verify_test on test vector %d of %d...", i + 1,
+             ARRAYSIZE(kTestVectors));
+    status_t err = ed25519_verify_test(&kTestVectors[i]);
+    if (status_ok(err)) {
+      LOG_INFO("Finished ed25519_verify_test on test vector %d : ok", i + 1);
+    } else {
+      LOG_ERROR("Finished ed25519_verify_test on test vector %d : error %r",
+                i + 1, err);
+      // For help with debugging, print the OTBN error bits and instruction
+      // count.
+      LOG_INFO("OTBN error bits: 0x%08x", otbn_err_bits_get());
+      LOG_INFO("OTBN instruction count: 0x%08x", otbn_instruction_count_get());
+      result = false;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,624 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/aes.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/drbg.h"
+#include "sw/device/lib/crypto/include/ecc.h"
+#include "sw/device/lib/crypto/include/hash.h"
+#include "sw/device/lib/crypto/include/mac.h"
+#include "sw/device/lib/crypto/include/rsa.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/testing/test_framework/ujson_ottf.h"
+#include "sw/device/lib/ujson/ujson.h"
+#include "sw/device/tests/crypto/otcrypto_perftest_json.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('p', 'r', 'f')
+
+enum {
+  /* Largest message size used by any benchmark. */
+  kMaxMsgBytes = 4096,
+  /* Number of times each benchmark is run; the reported cost is the mean. */
+  kNumRuns = 4,
+  /* Number of bytes in an AES block. */
+  kAesBlockBytes = 128 / 8,
+  /* Number of 32-bit words in an AES block. */
+  kAesBlockWords = kAesBlockBytes / sizeof(uint32_t),
+  /* Number of 32-bit words in an AES-GCM IV. */
+  kAesGcmIvWords = 96 / 32,
+  /* Number of bytes in the symmetric keys used for AES, HMAC and KMAC. */
+  kSymmetricKeyBytes = 256 / 8,
+  /* Number of 32-bit words in the symmetric keys. */
+  kSymmetricKeyWords = kSymmetricKeyBytes / sizeof(uint32_t),
+  /* Number of bytes in a P-256 private key. */
+  kP256PrivateKeyBytes = 256 / 8,
+  /* Number of 32-bit words in a masked P-256 private key (ECC shares carry 64
+     extra redundant bits each). */
+  kP256KeyblobWords = 2 * (kP256PrivateKeyBytes + 8) / sizeof(uint32_t),
+  /* Number of 32-bit words in a P-256 public key or signature. */
+  kP256PointWords = 512 / 32,
+  /* Number of bytes in a P-384 private key. */
+  kP384PrivateKeyBytes = 384 / 8,
+  /* Number of 32-bit words in a masked P-384 private key. */
+  kP384KeyblobWords = 2 * (kP384PrivateKeyBytes + 8) / sizeof(uint32_t),
+  /* Number of 32-bit words in a P-384 public key or signature. */
+  kP384PointWords = 768 / 32,
+  /* Number of 32-bit words in an RSA-2048 modulus or signature. */
+  kRsa2048NumWords = 2048 / 32,
+};
+
+typedef struct crypto_perf_test {
+  // A human-readable name for this benchmark, e.g. "aes_ctr".
+  const char *label;
+
+  // Runs the operation under test once on the first `len` bytes of the
+  // message buffer. Keys and other fixed inputs are prepared beforehand by
+  // `perf_setup`, so only the operation itself is measured.
+  status_t (*func)(size_t len);
+
+  // Number of input bytes passed to `func`; 0 for fixed-size operations such
+  // as signatures.
+  size_t len;
+
+  // Cycle budget per operation. The test fails if the measured mean exceeds
+  // it. A budget of 0 means the benchmark is only reported, not checked.
+  uint32_t max_cycles_per_op;
+} crypto_perf_test_t;
+
+// Random masks and keys for the symmetric benchmarks.
+static const uint32_t kSymmetricKey[kSymmetricKeyWords] = {
+    0x8d6e0b6a, 0x47c8f0b2, 0x2f6e5b1d, 0x93a1c5e4,
+    0x5b0f2d7c, 0xe1c49a38, 0x0d7f6b25, 0x6a93e1f0,
+};
+static const uint32_t kSymmetricMask[kSymmetricKeyWords] = {
+    0x1b81540c, 0x220733c9, 0x8bf85383, 0x05ab50b4,
+    0x8acdcb7e, 0x15e76440, 0x8459b2ce, 0xdc2110cc,
+};
+
+// Test RSA-2048 key pair (same as `rsa_2048_signature_functest`).
+static const uint32_t kRsaModulus[kRsa2048NumWords] = {
+    0x40d984b1, 0x3611356d, 0x9eb2f35c, 0x031a892c, 0x16354662, 0x6a260bad,
+    0xb2b807d6, 0xb7de7ccb, 0x278492e0, 0x41adab06, 0x9e60110f, 0x1414eeff,
+    0x8b80e14e, 0x5eb5ae79, 0x0d98fa5b, 0x58bece1f, 0xcf6bdca8, 0x82f5611f,
+    0x351e3869, 0x075005d6, 0xe813fe23, 0xdd967a37, 0x682d1c41, 0x9fdd2d8c,
+    0x21bdd5fc, 0x4fc459c7, 0x508c9293, 0x1f9ac759, 0x55aacb04, 0x58389f05,
+    0x0d0b00fb, 0x59bb4141, 0x68f9e0bf, 0xc2f1a546, 0x0a71ad19, 0x9c400301,
+    0xa4f8ecb9, 0xcdf39538, 0xaabe9cb0, 0xd9f7b2dc, 0x0e8b292d, 0x8ef6c717,
+    0x720e9520, 0xb0c6a23e, 0xda1e92b1, 0x8b6b4800, 0x2f25082b, 0x7f2d6711,
+    0x426fc94f, 0x9926ba5a, 0x89bd4d2b, 0x977718d5, 0x5a8406be, 0x87d090f3,
+    0x639f9975, 0x5948488b, 0x1d3d9cd7, 0x28c7956b, 0xebb97a3e, 0x1edbf4e2,
+    0x105cc797, 0x924ec514, 0x146810df, 0xb1ab4a49,
+};
+static const uint32_t kRsaPrivateExponent[kRsa2048NumWords] = {
+    0x0b19915b, 0xa6a935e6, 0x426b2e10, 0xb4ff0629, 0x7322343b, 0x3f28c8d5,
+    0x190757ce, 0x87409d6b, 0xd88e282b, 0x01c13c2a, 0xebb79189, 0x74cbeab9,
+    0x93de5d54, 0xae1bc80a, 0x083a75f2, 0xd574d229, 0xeb46696e, 0x7648cfb6,
+    0xe7ad1b36, 0xbd0e81b2, 0x19c72703, 0xebea5085, 0xf8c7d152, 0x34dcf84d,
+    0xa437187f, 0x41e4f88e, 0xe4e35f9f, 0xcd8bc6f8, 0x7f98e2f2, 0xffdf75ca,
+    0x3698226e, 0x903f2a56, 0xbf21a6dc, 0x97cbf653, 0xe9d80cb3, 0x55dc1685,
+    0xe0ebae21, 0xc8171e18, 0x8e73d26d, 0xbbdbaac1, 0x886e8007, 0x673c9da4,
+    0xe2cb0698, 0xa9f1ba2d, 0xedab4f0a, 0x197e890c, 0x65e7e736, 0x1de28f24,
+    0x57cf5137, 0x631ff441, 0x22539942, 0xcee3fd41, 0xd22b5f8a, 0x995dd87a,
+    0xcaa6815c, 0x08ca0fd3, 0x8f996093, 0x30b7c446, 0xf69b11f7, 0xa298dd00,
+    0xfd4e8120, 0x059df602, 0x25feb268, 0x0f3f749e,
+};
+static const uint32_t kRsaPublicExponent = 65537;
+
+static const otcrypto_ecc_curve_t kCurveP256 = {
+    .curve_type = kOtcryptoEccCurveTypeNistP256,
+    .domain_parameter = NULL,
+};
+
+static const otcrypto_ecc_curve_t kCurveP384 = {
+    .curve_type = kOtcryptoEccCurveTypeNistP384,
+    .domain_parameter = NULL,
+};
+
+static const otcrypto_const_byte_buf_t kEmptyBuffer = {.data = NULL, .len = 0};
+
+// Input and output buffers shared by all benchmarks.
+static uint32_t msg_data[kMaxMsgBytes / sizeof(uint32_t)];
+static uint32_t out_data[kMaxMsgBytes / sizeof(uint32_t)];
+
+// Key configuration shared by all benchmark keys.
+#define PERF_KEY_CONFIG(mode, length)               \
+  {                                                 \
+    .version = kOtcryptoLibVersion1,                \
+    .key_mode = (mode),                             \
+    .key_length = (length),                         \
+    .hw_backed = kHardenedBoolFalse,                \
+    .security_level = kOtcryptoKeySecurityLevelLow, \
+  }
+
+// Symmetric keys, one per mode since the key mode must match the operation.
+static uint32_t aes_ecb_keyblob[2 * kSymmetricKeyWords];
+static uint32_t aes_cbc_keyblob[2 * kSymmetricKeyWords];
+static uint32_t aes_ctr_keyblob[2 * kSymmetricKeyWords];
+static uint32_t aes_gcm_keyblob[2 * kSymmetricKeyWords];
+static uint32_t hmac_keyblob[2 * kSymmetricKeyWords];
+static uint32_t kmac_keyblob[2 * kSymmetricKeyWords];
+static otcrypto_blinded_key_t aes_ecb_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeAesEcb, kSymmetricKeyBytes),
+    .keyblob_length = sizeof(aes_ecb_keyblob),
+    .keyblob = aes_ecb_keyblob,
+};
+static otcrypto_blinded_key_t aes_cbc_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeAesCbc, kSymmetricKeyBytes),
+    .keyblob_length = sizeof(aes_cbc_keyblob),
+    .keyblob = aes_cbc_keyblob,
+};
+static otcrypto_blinded_key_t aes_ctr_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeAesCtr, kSymmetricKeyBytes),
+    .keyblob_length = sizeof(aes_ctr_keyblob),
+    .keyblob = aes_ctr_keyblob,
+};
+static otcrypto_blinded_key_t aes_gcm_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeAesGcm, kSymmetricKeyBytes),
+    .keyblob_length = sizeof(aes_gcm_keyblob),
+    .keyblob = aes_gcm_keyblob,
+};
+static otcrypto_blinded_key_t hmac_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeHmacSha256, kSymmetricKeyBytes),
+    .keyblob_length = sizeof(hmac_keyblob),
+    .keyblob = hmac_keyblob,
+};
+static otcrypto_blinded_key_t kmac_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeKmac256, kSymmetricKeyBytes),
+    .keyblob_length = sizeof(kmac_keyblob),
+    .keyblob = kmac_keyblob,
+};
+
+// ECC key pairs, generated once during setup. ECDSA and ECDH need keys of
+// different modes, so each gets its own pair.
+static uint32_t p256_ecdsa_sk_data[kP256KeyblobWords];
+static uint32_t p256_ecdsa_pk_data[kP256PointWords];
+static uint32_t p256_ecdh_sk_data[kP256KeyblobWords];
+static uint32_t p256_ecdh_pk_data[kP256PointWords];
+static uint32_t p256_shared_keyblob[2 * kP256PrivateKeyBytes /
+                                    sizeof(uint32_t)];
+static uint32_t p256_sig[kP256PointWords];
+static otcrypto_blinded_key_t p256_ecdsa_private_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeEcdsa, kP256PrivateKeyBytes),
+    .keyblob_length = sizeof(p256_ecdsa_sk_data),
+    .keyblob = p256_ecdsa_sk_data,
+};
+static otcrypto_unblinded_key_t p256_ecdsa_public_key = {
+    .key_mode = kOtcryptoKeyModeEcdsa,
+    .key_length = sizeof(p256_ecdsa_pk_data),
+    .key = p256_ecdsa_pk_data,
+};
+static otcrypto_blinded_key_t p256_ecdh_private_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeEcdh, kP256PrivateKeyBytes),
+    .keyblob_length = sizeof(p256_ecdh_sk_data),
+    .keyblob = p256_ecdh_sk_data,
+};
+static otcrypto_unblinded_key_t p256_ecdh_public_key = {
+    .key_mode = kOtcryptoKeyModeEcdh,
+    .key_length = sizeof(p256_ecdh_pk_data),
+    .key = p256_ecdh_pk_data,
+};
+// Any symmetric mode with a matching length works for the shared secret.
+static otcrypto_blinded_key_t p256_shared_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeAesCtr, kP256PrivateKeyBytes),
+    .keyblob_length = sizeof(p256_shared_keyblob),
+    .keyblob = p256_shared_keyblob,
+};
+
+static uint32_t p384_ecdsa_sk_data[kP384KeyblobWords];
+static uint32_t p384_ecdsa_pk_data[kP384PointWords];
+static uint32_t p384_ecdh_sk_data[kP384KeyblobWords];
+static uint32_t p384_ecdh_pk_data[kP384PointWords];
+static uint32_t p384_shared_keyblob[2 * kP384PrivateKeyBytes /
+                                    sizeof(uint32_t)];
+static uint32_t p384_sig[kP384PointWords];
+static otcrypto_blinded_key_t p384_ecdsa_private_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeEcdsa, kP384PrivateKeyBytes),
+    .keyblob_length = sizeof(p384_ecdsa_sk_data),
+    .keyblob = p384_ecdsa_sk_data,
+};
+static otcrypto_unblinded_key_t p384_ecdsa_public_key = {
+    .key_mode = kOtcryptoKeyModeEcdsa,
+    .key_length = sizeof(p384_ecdsa_pk_data),
+    .key = p384_ecdsa_pk_data,
+};
+static otcrypto_blinded_key_t p384_ecdh_private_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeEcdh, kP384PrivateKeyBytes),
+    .keyblob_length = sizeof(p384_ecdh_sk_data),
+    .keyblob = p384_ecdh_sk_data,
+};
+static otcrypto_unblinded_key_t p384_ecdh_public_key = {
+    .key_mode = kOtcryptoKeyModeEcdh,
+    .key_length = sizeof(p384_ecdh_pk_data),
+    .key = p384_ecdh_pk_data,
+};
+static otcrypto_blinded_key_t p384_shared_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeAesCtr, kP384PrivateKeyBytes),
+    .keyblob_length = sizeof(p384_shared_keyblob),
+    .keyblob = p384_shared_keyblob,
+};
+
+// RSA-2048 key pair, constructed from the fixed test key during setup.
+static uint32_t rsa_sk_data[kOtcryptoRsa2048PrivateKeyblobBytes /
+                            sizeof(uint32_t)];
+static uint32_t rsa_pk_data[kOtcryptoRsa2048PublicKeyBytes / sizeof(uint32_t)];
+static uint32_t rsa_sig[kRsa2048NumWords];
+static otcrypto_blinded_key_t rsa_private_key = {
+    .config = PERF_KEY_CONFIG(kOtcryptoKeyModeRsaSignPkcs,
+                              kOtcryptoRsa2048PrivateKeyBytes),
+    .keyblob_length = sizeof(rsa_sk_data),
+    .keyblob = rsa_sk_data,
+};
+static otcrypto_unblinded_key_t rsa_public_key = {
+    .key_mode = kOtcryptoKeyModeRsaSignPkcs,
+    .key_length = sizeof(rsa_pk_data),
+    .key = rsa_pk_data,
+};
+
+// Fixed message digests for the signature benchmarks.
+static uint32_t sha256_digest_data[kSha256DigestWords];
+static uint32_t sha384_digest_data[kSha384DigestWords];
+static otcrypto_hash_digest_t sha256_digest = {
+    .mode = kOtcryptoHashModeSha256,
+    .data = sha256_digest_data,
+    .len = ARRAYSIZE(sha256_digest_data),
+};
+static otcrypto_hash_digest_t sha384_digest = {
+    .mode = kOtcryptoHashModeSha384,
+    .data = sha384_digest_data,
+    .len = ARRAYSIZE(sha384_digest_data),
+};
+
+static otcrypto_const_byte_buf_t msg_buf(size_t len) {
+  return (otcrypto_const_byte_buf_t){
+      .data = (const unsigned char *)msg_data,
+      .len = len,
+  };
+}
+
+/**
+ * Mask the fixed symmetric test key into the keyblob of `key`.
+ *
+ * @param key Key whose configuration and keyblob are already set.
+ * @return OK or error.
+ */
+static status_t symmetric_key_setup(otcrypto_blinded_key_t *key) {
+  TRY(keyblob_from_key_and_mask(kSymmetricKey, kSymmetricMask, key->config,
+                                key->keyblob));
+  key->checksum = integrity_blinded_checksum(key);
+  return OK_STATUS();
+}
+
+/**
+ * Prepare keys, signatures and input data for all benchmarks.
+ *
+ * None of this is measured.
+ */
+static status_t perf_setup(void) {
+  // Fill the message buffer with arbitrary, but deterministic, data.
+  uint32_t state = 42;
+  for (size_t i = 0; i < ARRAYSIZE(msg_data); ++i) {
+    state = state * 1103515245 + 12345;
+    msg_data[i] = state;
+  }
+
+  TRY(symmetric_key_setup(&aes_ecb_key));
+  TRY(symmetric_key_setup(&aes_cbc_key));
+  TRY(symmetric_key_setup(&aes_ctr_key));
+  TRY(symmetric_key_setup(&aes_gcm_key));
+  TRY(symmetric_key_setup(&hmac_key));
+  TRY(symmetric_key_setup(&kmac_key));
+
+  TRY(otcrypto_drbg_instantiate(kEmptyBuffer));
+
+  // Digests for the signature benchmarks.
+  TRY(otcrypto_hash(msg_buf(64), sha256_digest));
+  TRY(otcrypto_hash(msg_buf(64), sha384_digest));
+
+  TRY(otcrypto_ecdsa_keygen(&kCurveP256, &p256_ecdsa_private_key,
+                            &p256_ecdsa_public_key));
+  TRY(otcrypto_ecdsa_sign(
+      &p256_ecdsa_private_key, sha256_digest, &kCurveP256,
+      (otcrypto_word32_buf_t){.data = p256_sig, .len = ARRAYSIZE(p256_sig)}));
+  TRY(otcrypto_ecdh_keygen(&kCurveP256, &p256_ecdh_private_key,
+                           &p256_ecdh_public_key));
+
+  TRY(otcrypto_ecdsa_keygen(&kCurveP384, &p384_ecdsa_private_key,
+                            &p384_ecdsa_public_key));
+  TRY(otcrypto_ecdsa_sign(
+      &p384_ecdsa_private_key, sha384_digest, &kCurveP384,
+      (otcrypto_word32_buf_t){.data = p384_sig, .len = ARRAYSIZE(p384_sig)}));
+  TRY(otcrypto_ecdh_keygen(&kCurveP384, &p384_ecdh_private_key,
+                           &p384_ecdh_public_key));
+
+  // The second share of the RSA private exponent is all-zero.
+  uint32_t d_share1[kRsa2048NumWords] = {0};
+  otcrypto_const_word32_buf_t modulus = {
+      .data = kRsaModulus,
+      .len = ARRAYSIZE(kRsaModulus),
+  };
+  TRY(otcrypto_rsa_private_key_from_exponents(
+      kOtcryptoRsaSize2048, modulus, kRsaPublicExponent,
+      (otcrypto_const_word32_buf_t){.data = kRsaPrivateExponent,
+                                    .len = ARRAYSIZE(kRsaPrivateExponent)},
+      (otcrypto_const_word32_buf_t){.data = d_share1,
+                                    .len = ARRAYSIZE(d_share1)},
+      &rsa_private_key));
+  TRY(otcrypto_rsa_public_key_construct(kOtcryptoRsaSize2048, modulus,
+                                        kRsaPublicExponent, &rsa_public_key));
+  TRY(otcrypto_rsa_sign(
+      &rsa_private_key, sha256_digest, kOtcryptoRsaPaddingPkcs,
+      (otcrypto_word32_buf_t){.data = rsa_sig, .len = ARRAYSIZE(rsa_sig)}));
+  return OK_STATUS();
+}
+
+static status_t aes_encrypt(const otcrypto_blinded_key_t *key,
+                            otcrypto_aes_mode_t mode, size_t len) {
+  uint32_t iv_data[kAesBlockWords] = {0};
+  return otcrypto_aes(
+      key, (otcrypto_word32_buf_t){.data = iv_data, .len = kAesBlockWords},
+      mode, kOtcryptoAesOperationEncrypt, msg_buf(len), kOtcryptoAesPaddingNull,
+      (otcrypto_byte_buf_t){.data = (unsigned char *)out_data, .len = len});
+}
+
+static status_t perf_aes_ecb(size_t len) {
+  return aes_encrypt(&aes_ecb_key, kOtcryptoAesModeEcb, len);
+}
+
+static status_t perf_aes_cbc(size_t len) {
+  return aes_encrypt(&aes_cbc_key, kOtcryptoAesModeCbc, len);
+}
+
+static status_t perf_aes_ctr(size_t len) {
+  return aes_encrypt(&aes_ctr_key, kOtcryptoAesModeCtr, len);
+}
+
+static status_t perf_aes_gcm(size_t len) {
+  uint32_t iv_data[kAesGcmIvWords] = {0};
+  uint32_t tag_data[kAesBlockWords];
+  return otcrypto_aes_gcm_encrypt(
+      &aes_gcm_key, msg_buf(len),
+      (otcrypto_const_word32_buf_t){.data = iv_data, .len = kAesGcmIvWords},
+      kEmptyBuffer, kOtcryptoAesGcmTagLen128,
+      (otcrypto_byte_buf_t){.data = (unsigned char *)out_data, .len = len},
+      (otcrypto_word32_buf_t){.data = tag_data, .len = ARRAYSIZE(tag_data)});
+}
+
+static status_t hash(otcrypto_hash_mode_t mode, size_t digest_words,
+                     size_t len) {
+  return otcrypto_hash(msg_buf(len),
+                       (otcrypto_hash_digest_t){
+                           .mode = mode,
+                           .data = out_data,
+                           .len = digest_words,
+                       });
+}
+
+static status_t perf_sha256(size_t len) {
+  return hash(kOtcryptoHashModeSha256, kSha256DigestWords, len);
+}
+
+static status_t perf_sha384(size_t len) {
+  return hash(kOtcryptoHashModeSha384, kSha384DigestWords, len);
+}
+
+static status_t perf_sha512(size_t len) {
+  return hash(kOtcryptoHashModeSha512, kSha512DigestWords, len);
+}
+
+static status_t perf_sha3_256(size_t len) {
+  return hash(kOtcryptoHashModeSha3_256, 256 / 32, len);
+}
+
+static status_t perf_shake256(size_t len) {
+  return otcrypto_xof_shake(msg_buf(len),
+                            (otcrypto_hash_digest_t){
+                                .mode = kOtcryptoHashXofModeShake256,
+                                .data = out_data,
+                                .len = 256 / 32,
+                            });
+}
+
+static status_t perf_hmac_sha256(size_t len) {
+  return otcrypto_hmac(
+      &hmac_key, msg_buf(len),
+      (otcrypto_word32_buf_t){.data = out_data, .len = kSha256DigestWords});
+}
+
+static status_t perf_kmac256(size_t len) {
+  return otcrypto_kmac(
+      &kmac_key, msg_buf(len), kOtcryptoKmacModeKmac256, kEmptyBuffer,
+      kSymmetricKeyBytes,
+      (otcrypto_word32_buf_t){.data = out_data, .len = kSymmetricKeyWords});
+}
+
+static status_t perf_drbg_generate(size_t len) {
+  return otcrypto_drbg_generate(
+      kEmptyBuffer, (otcrypto_word32_buf_t){
+                        .data = out_data, .len = len / sizeof(uint32_t)});
+}
+
+static status_t perf_ecdsa_p256_sign(size_t len) {
+  return otcrypto_ecdsa_sign(
+      &p256_ecdsa_private_key, sha256_digest, &kCurveP256,
+      (otcrypto_word32_buf_t){.data = out_data, .len = kP256PointWords});
+}
+
+static status_t perf_ecdsa_p256_verify(size_t len) {
+  hardened_bool_t result;
+  TRY(otcrypto_ecdsa_verify(
+      &p256_ecdsa_public_key, sha256_digest,
+      (otcrypto_const_word32_buf_t){.data = p256_sig,
+                                    .len = ARRAYSIZE(p256_sig)},
+      &kCurveP256, &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+static status_t perf_ecdsa_p384_sign(size_t len) {
+  return otcrypto_ecdsa_sign(
+      &p384_ecdsa_private_key, sha384_digest, &kCurveP384,
+      (otcrypto_word32_buf_t){.data = out_data, .len = kP384PointWords});
+}
+
+static status_t perf_ecdsa_p384_verify(size_t len) {
+  hardened_bool_t result;
+  TRY(otcrypto_ecdsa_verify(
+      &p384_ecdsa_public_key, sha384_digest,
+      (otcrypto_const_word32_buf_t){.data = p384_sig,
+                                    .len = ARRAYSIZE(p384_sig)},
+      &kCurveP384, &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+static status_t perf_ecdh_p256(size_t len) {
+  return otcrypto_ecdh(&p256_ecdh_private_key, &p256_ecdh_public_key,
+                       &kCurveP256, &p256_shared_key);
+}
+
+static status_t perf_ecdh_p384(size_t len) {
+  return otcrypto_ecdh(&p384_ecdh_private_key, &p384_ecdh_public_key,
+                       &kCurveP384, &p384_shared_key);
+}
+
+static status_t perf_rsa_2048_sign(size_t len) {
+  return otcrypto_rsa_sign(
+      &rsa_private_key, sha256_digest, kOtcryptoRsaPaddingPkcs,
+      (otcrypto_word32_buf_t){.data = out_data, .len = kRsa2048NumWords});
+}
+
+static status_t perf_rsa_2048_verify(size_t len) {
+  hardened_bool_t result;
+  TRY(otcrypto_rsa_verify(
+      &rsa_public_key, sha256_digest, kOtcryptoRsaPaddingPkcs,
+      (otcrypto_const_word32_buf_t){.data = rsa_sig,
+                                    .len = ARRAYSIZE(rsa_sig)},
+      &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+// Cycle budgets are per operation and assume `-O2`. Benchmarks with a budget
+// of 0 are reported but not checked; to start tracking one, run this test on
+// an FPGA with `--copt -O2 --test_output=all` and set the budget to the
+// reported `cycles_per_op` plus some headroom. If a benchmark gets faster,
+// consider tightening its budget.
+static const crypto_perf_test_t kPerfTests[] = {
+    {.label = "aes_ecb", .func = &perf_aes_ecb, .len = 16},
+    {.label = "aes_ecb", .func = &perf_aes_ecb, .len = 256},
+    {.label = "aes_ecb", .func = &perf_aes_ecb, .len = 4096},
+    {.label = "aes_cbc", .func = &perf_aes_cbc, .len = 16},
+    {.label = "aes_cbc", .func = &perf_aes_cbc, .len = 256},
+    {.label = "aes_cbc", .func = &perf_aes_cbc, .len = 4096},
+    {.label = "aes_ctr", .func = &perf_aes_ctr, .len = 16},
+    {.label = "aes_ctr", .func = &perf_aes_ctr, .len = 256},
+    {.label = "aes_ctr", .func = &perf_aes_ctr, .len = 4096},
+    {.label = "aes_gcm", .func = &perf_aes_gcm, .len = 16},
+    {.label = "aes_gcm", .func = &perf_aes_gcm, .len = 256},
+    {.label = "aes_gcm", .func = &perf_aes_gcm, .len = 4096},
+    {.label = "sha256", .func = &perf_sha256, .len = 64},
+    {.label = "sha256", .func = &perf_sha256, .len = 1024},
+    {.label = "sha256", .func = &perf_sha256, .len = 4096},
+    {.label = "sha384", .func = &perf_sha384, .len = 64},
+    {.label = "sha384", .func = &perf_sha384, .len = 4096},
+    {.label = "sha512", .func = &perf_sha512, .len = 64},
+    {.label = "sha512", .func = &perf_sha512, .len = 4096},
+    {.label = "sha3_256", .func = &perf_sha3_256, .len = 64},
+    {.label = "sha3_256", .func = &perf_sha3_256, .len = 1024},
+    {.label = "sha3_256", .func = &perf_sha3_256, .len = 4096},
+    {.label = "shake256", .func = &perf_shake256, .len = 64},
+    {.label = "shake256", .func = &perf_shake256, .len = 4096},
+    {.label = "hmac_sha256", .func = &perf_hmac_sha256, .len = 64},
+    {.label = "hmac_sha256", .func = &perf_hmac_sha256, .len = 1024},
+    {.label = "hmac_sha256", .func = &perf_hmac_sha256, .len = 4096},
+    {.label = "kmac256", .func = &perf_kmac256, .len = 64},
+    {.label = "kmac256", .func = &perf_kmac256, .len = 1024},
+    {.label = "kmac256", .func = &perf_kmac256, .len = 4096},
+    {.label = "drbg_generate", .func = &perf_drbg_generate, .len = 32},
+    {.label = "drbg_generate", .func = &perf_drbg_generate, .len = 256},
+    {.label = "ecdsa_p256_sign", .func = &perf_ecdsa_p256_sign},
+    {.label = "ecdsa_p256_verify", .func = &perf_ecdsa_p256_verify},
+    {.label = "ecdsa_p384_sign", .func = &perf_ecdsa_p384_sign},
+    {.label = "ecdsa_p384_verify", .func = &perf_ecdsa_p384_verify},
+    {.label = "ecdh_p256", .func = &perf_ecdh_p256},
+    {.label = "ecdh_p384", .func = &perf_ecdh_p384},
+    {.label = "rsa_2048_sign", .func = &perf_rsa_2048_sign},
+    {.label = "rsa_2048_verify", .func = &perf_rsa_2048_verify},
+};
+
+/**
+ * Run one benchmark `kNumRuns` times and summarize the cycle counts.
+ *
+ * @param test Benchmark to run.
+ * @param[out] result Mean cost of the operation.
+ * @return OK or error.
+ */
+static status_t perf_test_run(const crypto_perf_test_t *test,
+                              crypto_perf_result_t *result) {
+  uint64_t total_cycles = 0;
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    uint64_t t_start = profile_start();
+    TRY(test->func(test->len));
+    total_cycles += profile_end(t_start);
+  }
+
+  memset(result, 0, sizeof(*result));
+  for (size_t i = 0;
+       i < CRYPTO_PERF_MAX_LABEL_LEN - 1 && test->label[i] != '\0'; ++i) {
+    result->label[i] = test->label[i];
+  }
+  TRY_CHECK(total_cycles / kNumRuns <= UINT32_MAX);
+  result->input_bytes = (uint32_t)test->len;
+  result->cycles_per_op = (uint32_t)(total_cycles / kNumRuns);
+  result->cycles_per_byte =
+      test->len == 0 ? 0 : result->cycles_per_op / (uint32_t)test->len;
+  result->max_cycles_per_op = test->max_cycles_per_op;
+  return OK_STATUS();
+}
+
+static status_t perf_result_report(ujson_t *uj,
+                                   const crypto_perf_result_t *result) {
+  return RESP_OK(ujson_serialize_crypto_perf_result_t, uj, result);
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_complex_init());
+  CHECK_STATUS_OK(perf_setup());
+
+  ujson_t uj = ujson_ottf_console();
+  bool all_within_budget = true;
+  for (size_t i = 0; i < ARRAYSIZE(kPerfTests); ++i) {
+    const crypto_perf_test_t *test = &kPerfTests[i];
+    crypto_perf_result_t result;
+    CHECK_STATUS_OK(perf_test_run(test, &result));
+    CHECK_STATUS_OK(perf_result_report(&uj, &result));
+
+    if (test->max_cycles_per_op != 0 &&
+        result.cycles_per_op > test->max_cycles_per_op) {
+      all_within_budget = false;
+      LOG_WARNING(
+          "%s (%d bytes):\n"
+          "  Expected:        %10d cycles\n"
+          "  Actual:          %10d cycles\n",
+          test->label, result.input_bytes, test->max_cycles_per_op,
+          result.cycles_per_op);
+    }
+  }
+  return all_within_budget;
+}
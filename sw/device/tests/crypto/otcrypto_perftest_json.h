@@ -0,0 +1,29 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_TESTS_CRYPTO_OTCRYPTO_PERFTEST_JSON_H_
+#define OPENTITAN_SW_DEVICE_TESTS_CRYPTO_OTCRYPTO_PERFTEST_JSON_H_
+#include "sw/device/lib/ujson/ujson_derive.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRYPTO_PERF_MAX_LABEL_LEN 32
+
+// clang-format off
+
+#define CRYPTO_PERF_RESULT(field, string) \
+    string(label, CRYPTO_PERF_MAX_LABEL_LEN) \
+    field(input_bytes, uint32_t) \
+    field(cycles_per_op, uint32_t) \
+    field(cycles_per_byte, uint32_t) \
+    field(max_cycles_per_op, uint32_t)
+UJSON_SERDE_STRUCT(CryptoPerfResult, crypto_perf_result_t, CRYPTO_PERF_RESULT);
+
+// clang-format on
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // OPENTITAN_SW_DEVICE_TESTS_CRYPTO_OTCRYPTO_PERFTEST_JSON_H_
@@ -31,6 +31,7 @@ impl RescueSerial {
     pub const BOOT_SVC_RSP: [u8; 4] = *b"BRSP";
     pub const OWNER_BLOCK: [u8; 4] = *b"OWNR";
     pub const WAIT: [u8; 4] = *b"WAIT";
+    pub const WINDOW: [u8; 4] = *b"WNDW";
 
     const BAUD_115K: [u8; 4] = *b"115K";
     const BAUD_230K: [u8; 4] = *b"230K";
@@ -108,12 +109,19 @@ impl RescueSerial {
     }
 
     pub fn update_firmware(&self, slot: BootSlot, image: &[u8]) -> Result<()> {
+        // Ask for a windowed transfer; older ROM_EXTs reject the mode, in which
+        // case we fall back to plain XMODEM-CRC.
+        let windowed = self.set_mode(Self::WINDOW).is_ok();
         self.set_mode(if slot == BootSlot::SlotB {
             Self::RESCUE_B
         } else {
             Self::RESCUE
         })?;
-        let xm = Xmodem::new();
+        let mut xm = Xmodem::new();
+        if windowed {
+            // The ROM_EXT acknowledges once per 2 KiB flash block.
+            xm.window = 2;
+        }
         xm.send(&*self.uart, image)?;
         Ok(())
     }
@@ -29,6 +29,10 @@ pub struct Xmodem {
     pub max_errors: usize,
     pub pad_byte: u8,
     pub block_len: XmodemBlock,
+    /// Number of blocks sent before waiting for an ACK.  A window larger than
+    /// one is a non-standard extension and must be negotiated with the
+    /// receiver out of band.
+    pub window: usize,
 }
 
 impl Default for Xmodem {
@@ -52,6 +56,7 @@ impl Xmodem {
             max_errors: 16,
             pad_byte: 0xff,
             block_len: XmodemBlock::Block1k,
+            window: 1,
         }
     }
 
@@ -72,7 +77,13 @@ impl Xmodem {
 
     pub fn send(&self, uart: &dyn Uart, data: impl Read) -> Result<()> {
         self.send_start(uart)?;
-        self.send_data(uart, data)?;
+        if self.window > 1 {
+            if self.send_data_windowed(uart, data)? {
+                return Ok(());
+            }
+        } else {
+            self.send_data(uart, data)?;
+        }
         self.send_finish(uart)?;
         Ok(())
     }
@@ -103,26 +114,35 @@ impl Xmodem {
         }
     }
 
+    /// Reads the next block from `data` and frames it.  Returns `None` at the
+    /// end of the data.
+    fn next_block(&self, block: usize, data: &mut impl Read) -> Result<Option<Vec<u8>>> {
+        let mut buf = vec![self.pad_byte; self.block_len as usize + 3];
+        let n = data.read(&mut buf[3..])?;
+        if n == 0 {
+            return Ok(None);
+        }
+
+        buf[0] = match self.block_len {
+            XmodemBlock::Block128 => Self::SOH,
+            XmodemBlock::Block1k => Self::STX,
+        };
+        buf[1] = block as u8;
+        buf[2] = 255 - buf[1];
+        let crc = Self::crc16(&buf[3..]);
+        buf.push((crc >> 8) as u8);
+        buf.push((crc & 0xFF) as u8);
+        Ok(Some(buf))
+    }
+
     fn send_data(&self, uart: &dyn Uart, mut data: impl Read) -> Result<()> {
         let mut block = 0usize;
         let mut errors = 0usize;
         loop {
             block += 1;
-            let mut buf = vec![self.pad_byte; self.block_len as usize + 3];
-            let n = data.read(&mut buf[3..])?;
-            if n == 0 {
+            let Some(buf) = self.next_block(block, &mut data)? else {
                 break;
-            }
-
-            buf[0] = match self.block_len {
-                XmodemBlock::Block128 => Self::SOH,
-                XmodemBlock::Block1k => Self::STX,
             };
-            buf[1] = block as u8;
-            buf[2] = 255 - buf[1];
-            let crc = Self::crc16(&buf[3..]);
-            buf.push((crc >> 8) as u8);
-            buf.push((crc & 0xFF) as u8);
             log::info!("Sending block {block}");
 
             let mut cancels = 0usize;
@@ -155,6 +175,66 @@ impl Xmodem {
         Ok(())
     }
 
+    /// Sends `window` blocks back-to-back and waits for a single ACK covering
+    /// all of them.  A NAK causes the whole window to be resent.  When the data
+    /// runs out mid-window, the EOF is sent as part of the final window.
+    ///
+    /// Returns true if the EOF has already been sent and acknowledged.
+    fn send_data_windowed(&self, uart: &dyn Uart, mut data: impl Read) -> Result<bool> {
+        let mut block = 0usize;
+        let mut errors = 0usize;
+        loop {
+            let mut buf = Vec::new();
+            let mut blocks = 0usize;
+            while blocks < self.window {
+                let Some(b) = self.next_block(block + blocks + 1, &mut data)? else {
+                    break;
+                };
+                buf.extend_from_slice(&b);
+                blocks += 1;
+            }
+            let eof = blocks < self.window;
+            if eof {
+                if blocks == 0 {
+                    return Ok(false);
+                }
+                buf.push(Self::EOF);
+            }
+            log::info!("Sending blocks {}-{}", block + 1, block + blocks);
+            block += blocks;
+
+            let mut cancels = 0usize;
+            loop {
+                uart.write(&buf)?;
+                let mut ch = 0u8;
+                uart.read(std::slice::from_mut(&mut ch))?;
+                match ch {
+                    Self::ACK => break,
+                    Self::NAK => {
+                        log::info!("XMODEM send got NAK.  Retrying window.");
+                        errors += 1;
+                    }
+                    Self::CAN => {
+                        cancels += 1;
+                        if cancels >= 2 {
+                            return Err(XmodemError::Cancelled.into());
+                        }
+                    }
+                    _ => {
+                        log::info!("Expected ACK. Got {ch:#x}.");
+                        errors += 1;
+                    }
+                }
+                if errors >= self.max_errors {
+                    return Err(XmodemError::ExhaustedRetries(errors).into());
+                }
+            }
+            if eof {
+                return Ok(true);
+            }
+        }
+    }
+
     fn send_finish(&self, uart: &dyn Uart) -> Result<()> {
         uart.write(&[Self::EOF])?;
         let mut ch = 0u8;
@@ -301,6 +381,7 @@ November 19, 1863
             max_errors: 2,
             pad_byte: 0,
             block_len: XmodemBlock::Block128,
+            window: 1,
         };
         let gettysburg = GETTYSBURG.as_bytes();
         let err = xmodem.send(&child, gettysburg);
@@ -373,6 +454,7 @@ November 19, 1863
             max_errors: 2,
             pad_byte: 0,
             block_len: XmodemBlock::Block128,
+            window: 1,
         };
         let mut result = Vec::new();
         let err = xmodem.receive(&child, &mut result);
@@ -395,6 +477,7 @@ November 19, 1863
             max_errors: 2,
             pad_byte: 0,
             block_len: XmodemBlock::Block128,
+            window: 1,
         };
         let mut result = Vec::new();
         let err = xmodem.receive(&child, &mut result);
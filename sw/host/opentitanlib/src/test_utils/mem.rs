@@ -2,13 +2,14 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
-use anyhow::Result;
+use anyhow::{bail, Result};
 use arrayvec::ArrayVec;
+use crc::{Crc, CRC_32_ISO_HDLC};
 use std::time::Duration;
 
 use crate::io::uart::Uart;
 use crate::test_utils::e2e_command::TestCommand;
-use crate::test_utils::rpc::{UartRecv, UartSend};
+use crate::test_utils::rpc::{recv_blob, recv_chunk, send_blob, send_chunk, UartRecv, UartSend};
 use crate::test_utils::status::Status;
 
 // Bring in the auto-generated sources.
@@ -80,3 +81,92 @@ impl MemWriteReq {
         Ok(())
     }
 }
+
+impl MemBlobReq {
+    /// Reads `data.len()` bytes starting at `address` with a single binary frame.
+    pub fn read(uart: &dyn Uart, address: u32, data: &mut [u8]) -> Result<()> {
+        TestCommand::MemReadBlob.send_with_crc(uart)?;
+        let op = MemBlobReq {
+            address,
+            data_len: data.len().try_into()?,
+        };
+        op.send_with_crc(uart)?;
+        Status::recv(uart, Duration::from_secs(300), false)?;
+        recv_blob(uart, data, Duration::from_secs(300))
+    }
+
+    /// Writes `data` starting at `address` with a single binary frame.
+    pub fn write(uart: &dyn Uart, address: u32, data: &[u8]) -> Result<()> {
+        TestCommand::MemWriteBlob.send_with_crc(uart)?;
+        let op = MemBlobReq {
+            address,
+            data_len: data.len().try_into()?,
+        };
+        op.send_with_crc(uart)?;
+        Status::recv(uart, Duration::from_secs(300), false)?;
+        send_blob(uart, data)?;
+        Status::recv(uart, Duration::from_secs(300), false)?;
+        Ok(())
+    }
+}
+
+impl MemStreamReq {
+    /// Size of the chunks `dump()` and `load()` split a transfer into.
+    pub const CHUNK_LEN: usize = 4096;
+
+    /// Reads `data.len()` bytes starting at `address` as a chunked binary stream.
+    ///
+    /// Every chunk carries the running CRC32 of the stream, so corruption is detected as soon as
+    /// the chunk it hits has arrived.
+    pub fn dump(uart: &dyn Uart, address: u32, data: &mut [u8]) -> Result<()> {
+        TestCommand::MemDump.send_with_crc(uart)?;
+        let op = MemStreamReq {
+            address,
+            data_len: data.len().try_into()?,
+            chunk_len: Self::CHUNK_LEN.try_into()?,
+        };
+        op.send_with_crc(uart)?;
+        Status::recv(uart, Duration::from_secs(300), false)?;
+        let crc = Crc::<u32>::new(&CRC_32_ISO_HDLC);
+        let mut digest = crc.digest();
+        let mut pos = 0;
+        while pos < data.len() {
+            let end = std::cmp::min(pos + Self::CHUNK_LEN, data.len());
+            let len = recv_chunk(
+                uart,
+                &mut data[pos..end],
+                &mut digest,
+                Duration::from_secs(300),
+            )?;
+            if len == 0 {
+                bail!(
+                    "Empty chunk while dumping memory at {:#x}",
+                    address + pos as u32
+                );
+            }
+            pos += len;
+        }
+        Ok(())
+    }
+
+    /// Writes `data` starting at `address` as a chunked binary stream.
+    ///
+    /// The device acknowledges every chunk once it has been written, which paces the transfer.
+    pub fn load(uart: &dyn Uart, address: u32, data: &[u8]) -> Result<()> {
+        TestCommand::MemLoad.send_with_crc(uart)?;
+        let op = MemStreamReq {
+            address,
+            data_len: data.len().try_into()?,
+            chunk_len: Self::CHUNK_LEN.try_into()?,
+        };
+        op.send_with_crc(uart)?;
+        Status::recv(uart, Duration::from_secs(300), false)?;
+        let crc = Crc::<u32>::new(&CRC_32_ISO_HDLC);
+        let mut digest = crc.digest();
+        for chunk in data.chunks(Self::CHUNK_LEN) {
+            send_chunk(uart, chunk, &mut digest)?;
+            Status::recv(uart, Duration::from_secs(300), false)?;
+        }
+        Ok(())
+    }
+}
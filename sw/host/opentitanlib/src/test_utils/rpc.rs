@@ -2,7 +2,7 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 use anyhow::{anyhow, Result};
-use crc::{Crc, CRC_32_ISO_HDLC};
+use crc::{Crc, Digest, CRC_32_ISO_HDLC};
 use regex::Regex;
 use serde::de::DeserializeOwned;
 use serde::Serialize;
@@ -95,6 +95,101 @@ impl<T: DeserializeOwned> UartRecv for T {
     }
 }
 
+/// Magic value at the start of a binary frame (ASCII "UJBF").
+const BLOB_MAGIC: u32 = 0x46424a55;
+
+/// Sends `data` as a binary frame.
+///
+/// The frame consists of the little-endian 32-bit words `BLOB_MAGIC` and the data length,
+/// followed by the data and its little-endian CRC32. See `ujson_getblob()` on the device.
+pub fn send_blob(uart: &dyn Uart, data: &[u8]) -> Result<()> {
+    let mut frame = Vec::with_capacity(data.len() + 12);
+    frame.extend_from_slice(&BLOB_MAGIC.to_le_bytes());
+    frame.extend_from_slice(&u32::try_from(data.len())?.to_le_bytes());
+    frame.extend_from_slice(data);
+    let crc = Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(data);
+    frame.extend_from_slice(&crc.to_le_bytes());
+    uart.write(&frame)?;
+    Ok(())
+}
+
+/// Receives a binary frame carrying exactly `data.len()` bytes into `data`.
+///
+/// See `send_blob()` for the frame format and `ujson_putblob()` on the device.
+pub fn recv_blob(uart: &dyn Uart, data: &mut [u8], timeout: Duration) -> Result<()> {
+    let mut word = [0u8; 4];
+    read_exact(uart, &mut word, timeout)?;
+    if u32::from_le_bytes(word) != BLOB_MAGIC {
+        return Err(UartError::GenericError("Binary frame magic didn't match.".into()).into());
+    }
+    read_exact(uart, &mut word, timeout)?;
+    if u32::from_le_bytes(word) as usize != data.len() {
+        return Err(UartError::GenericError("Unexpected binary frame length.".into()).into());
+    }
+    read_exact(uart, data, timeout)?;
+    read_exact(uart, &mut word, timeout)?;
+    if u32::from_le_bytes(word) != Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(data) {
+        return Err(
+            UartError::GenericError("CRC didn't match received binary frame.".into()).into(),
+        );
+    }
+    Ok(())
+}
+
+/// Sends `data` as one chunk of a chunked binary stream.
+///
+/// The chunk consists of the little-endian 32-bit data length, followed by the data and the
+/// little-endian running CRC32 of the stream so far, which `crc` accumulates. See
+/// `ujson_getchunk()` on the device.
+pub fn send_chunk(uart: &dyn Uart, data: &[u8], crc: &mut Digest<'_, u32>) -> Result<()> {
+    let mut frame = Vec::with_capacity(data.len() + 8);
+    frame.extend_from_slice(&u32::try_from(data.len())?.to_le_bytes());
+    frame.extend_from_slice(data);
+    crc.update(data);
+    frame.extend_from_slice(&crc.clone().finalize().to_le_bytes());
+    uart.write(&frame)?;
+    Ok(())
+}
+
+/// Receives one chunk of a chunked binary stream into the start of `data`.
+///
+/// Returns the length of the chunk, which must fit in `data`. See `send_chunk()` for the chunk
+/// format and `ujson_putchunk()` on the device.
+pub fn recv_chunk(
+    uart: &dyn Uart,
+    data: &mut [u8],
+    crc: &mut Digest<'_, u32>,
+    timeout: Duration,
+) -> Result<usize> {
+    let mut word = [0u8; 4];
+    read_exact(uart, &mut word, timeout)?;
+    let len = u32::from_le_bytes(word) as usize;
+    if len > data.len() {
+        return Err(UartError::GenericError("Binary chunk too long.".into()).into());
+    }
+    read_exact(uart, &mut data[..len], timeout)?;
+    crc.update(&data[..len]);
+    read_exact(uart, &mut word, timeout)?;
+    if u32::from_le_bytes(word) != crc.clone().finalize() {
+        return Err(
+            UartError::GenericError("CRC didn't match received binary chunk.".into()).into(),
+        );
+    }
+    Ok(len)
+}
+
+fn read_exact(uart: &dyn Uart, buf: &mut [u8], timeout: Duration) -> Result<()> {
+    let mut pos = 0;
+    while pos < buf.len() {
+        let len = uart.read_timeout(&mut buf[pos..], timeout)?;
+        if len == 0 {
+            return Err(UartError::GenericError("Timed Out".into()).into());
+        }
+        pos += len;
+    }
+    Ok(())
+}
+
 fn check_crc(json_str: &str, crc_str: &str) -> Result<()> {
     let crc = crc_str.parse::<u32>()?;
     let actual_crc = Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(json_str.as_bytes());
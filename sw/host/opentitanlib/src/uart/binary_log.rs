@@ -0,0 +1,460 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Rendering of the binary log records written by device software built with
+// `--//sw/device/lib/runtime:log_format=binary`. See
+// sw/device/lib/runtime/log.h for the record format.
+
+use anyhow::{bail, Result};
+use object::{Object, ObjectSegment};
+
+use crate::util::status::Status;
+
+/// Decodes binary log records in a UART stream, turning them back into the
+/// text that the device would have printed.
+///
+/// Records refer to `log_fields_t` structs in the device image, so the decoder
+/// needs the ELF file that the device is running. Bytes outside of records are
+/// passed through unchanged.
+pub struct BinaryLogDecoder {
+    // The loadable segments of the ELF file, as (address, contents).
+    segments: Vec<(u32, Vec<u8>)>,
+    // The bytes of the current record, after the start byte.
+    record: Vec<u8>,
+    in_record: bool,
+    // Counts the records, like `global_log_counter` in log.c.
+    counter: u16,
+}
+
+// The result of trying to render a partial record.
+enum Render {
+    Incomplete,
+    Done(Vec<u8>),
+}
+
+// Reads the fields of a record.
+struct RecordReader<'a> {
+    data: &'a [u8],
+    pos: usize,
+}
+
+impl RecordReader<'_> {
+    fn word(&mut self) -> Option<u32> {
+        let mut value = 0u32;
+        let mut shift = 0;
+        loop {
+            let byte = *self.data.get(self.pos)?;
+            self.pos += 1;
+            if shift < 32 {
+                value |= ((byte & 0x7f) as u32) << shift;
+            }
+            shift += 7;
+            if byte & 0x80 == 0 {
+                return Some(value);
+            }
+        }
+    }
+
+    fn bytes(&mut self) -> Option<&[u8]> {
+        let len = self.word()? as usize;
+        let bytes = self.data.get(self.pos..self.pos + len)?;
+        self.pos += len;
+        Some(bytes)
+    }
+}
+
+// The fields of `log_fields_t` that are needed to render a record.
+struct LogFields<'a> {
+    severity: u32,
+    file_name: &'a [u8],
+    line: u32,
+    format: &'a [u8],
+}
+
+impl BinaryLogDecoder {
+    /// The first byte of each record.
+    pub const RECORD_START: u8 = 0x1e;
+    /// The size of `log_fields_t` on the device.
+    const LOG_FIELDS_LEN: usize = 20;
+    /// Records longer than this are assumed to be corrupt.
+    const MAX_RECORD_LEN: usize = 65536;
+
+    /// Creates a decoder for the given memory contents, as (address, contents)
+    /// pairs.
+    pub fn new(segments: Vec<(u32, Vec<u8>)>) -> Self {
+        BinaryLogDecoder {
+            segments,
+            record: Vec::new(),
+            in_record: false,
+            counter: 0,
+        }
+    }
+
+    /// Creates a decoder for the program in the given ELF file.
+    pub fn from_elf(elf: &[u8]) -> Result<Self> {
+        let file = object::File::parse(elf)?;
+        let mut segments = Vec::new();
+        for segment in file.segments() {
+            let data = segment.data()?;
+            if !data.is_empty() {
+                segments.push((segment.address() as u32, data.to_vec()));
+            }
+        }
+        if segments.is_empty() {
+            bail!("ELF file has no loadable segments");
+        }
+        Ok(Self::new(segments))
+    }
+
+    /// Decodes `data`, which follows any data that was passed to earlier
+    /// calls, and returns the text to print.
+    pub fn decode(&mut self, data: &[u8]) -> Vec<u8> {
+        let mut out = Vec::new();
+        for &byte in data {
+            if !self.in_record {
+                if byte == Self::RECORD_START {
+                    self.in_record = true;
+                    self.record.clear();
+                } else {
+                    out.push(byte);
+                }
+                continue;
+            }
+
+            self.record.push(byte);
+            if let Render::Done(text) = self.render() {
+                out.extend_from_slice(&text);
+                self.in_record = false;
+            } else if self.record.len() > Self::MAX_RECORD_LEN {
+                out.extend_from_slice(b"<truncated log record>\r\n");
+                self.in_record = false;
+            }
+        }
+        out
+    }
+
+    fn read(&self, addr: u32, len: usize) -> Option<&[u8]> {
+        self.segments.iter().find_map(|(base, data)| {
+            let offset = addr.checked_sub(*base)? as usize;
+            data.get(offset..offset.checked_add(len)?)
+        })
+    }
+
+    fn read_u32(&self, addr: u32) -> Option<u32> {
+        let bytes = self.read(addr, 4)?;
+        Some(u32::from_le_bytes(bytes.try_into().ok()?))
+    }
+
+    fn read_c_str(&self, addr: u32) -> Option<&[u8]> {
+        self.segments.iter().find_map(|(base, data)| {
+            let offset = addr.checked_sub(*base)? as usize;
+            let data = data.get(offset..)?;
+            let len = data.iter().position(|&b| b == 0)?;
+            Some(&data[..len])
+        })
+    }
+
+    fn read_fields(&self, addr: u32) -> Option<LogFields<'_>> {
+        self.read(addr, Self::LOG_FIELDS_LEN)?;
+        Some(LogFields {
+            severity: self.read_u32(addr)?,
+            file_name: self.read_c_str(self.read_u32(addr + 4)?)?,
+            line: self.read_u32(addr + 8)?,
+            format: self.read_c_str(self.read_u32(addr + 16)?)?,
+        })
+    }
+
+    // Renders the current record, if it is complete.
+    fn render(&mut self) -> Render {
+        let mut reader = RecordReader {
+            data: &self.record,
+            pos: 0,
+        };
+        let Some(addr) = reader.word() else {
+            return Render::Incomplete;
+        };
+        let Some(fields) = self.read_fields(addr) else {
+            return Render::Done(format!("<unknown log record {addr:#x}>\r\n").into_bytes());
+        };
+
+        let Some(message) = format_message(fields.format, &mut reader) else {
+            return Render::Incomplete;
+        };
+
+        let severity = match fields.severity {
+            0 => "I",
+            1 => "W",
+            2 => "E",
+            3 => "F",
+            _ => "?",
+        };
+        let base_name = match fields.file_name.iter().rposition(|&b| b == b'/') {
+            Some(pos) => &fields.file_name[pos + 1..],
+            None => fields.file_name,
+        };
+        let mut out = format!(
+            "{}{:05} {}:{}] ",
+            severity,
+            self.counter,
+            String::from_utf8_lossy(base_name),
+            fields.line
+        )
+        .into_bytes();
+        out.extend_from_slice(&message);
+        out.extend_from_slice(b"\r\n");
+        self.counter = self.counter.wrapping_add(1);
+        Render::Done(out)
+    }
+}
+
+// Writes `value` like `write_digits()` in print.c.
+fn write_digits(out: &mut Vec<u8>, value: u32, width: usize, padding: u8, base: u32, upper: bool) {
+    let glyphs: &[u8; 16] = if upper {
+        b"0123456789ABCDEF"
+    } else {
+        b"0123456789abcdef"
+    };
+    let mut digits = Vec::new();
+    let mut value = value;
+    loop {
+        digits.push(glyphs[(value % base) as usize]);
+        value /= base;
+        if value == 0 {
+            break;
+        }
+    }
+    let width = width.clamp(1, 32);
+    while digits.len() < width {
+        digits.push(padding);
+    }
+    out.extend(digits.iter().rev());
+}
+
+// Writes `bytes` like `hex_dump()` in print.c.
+fn hex_dump(
+    out: &mut Vec<u8>,
+    bytes: &[u8],
+    width: usize,
+    padding: u8,
+    big_endian: bool,
+    upper: bool,
+) {
+    if bytes.len() < width {
+        out.extend(std::iter::repeat(padding).take(width - bytes.len()));
+    }
+    let mut write = |byte: &u8| write_digits(out, *byte as u32, 2, b'0', 16, upper);
+    if big_endian {
+        bytes.iter().rev().for_each(&mut write);
+    } else {
+        bytes.iter().for_each(&mut write);
+    }
+}
+
+// Writes a `status_t` like `write_status()` in print.c.
+fn write_status(out: &mut Vec<u8>, value: u32, as_json: bool) {
+    let Ok(status) = Status::from_u32(value) else {
+        out.extend_from_slice(format!("<status {value:#010x}>").as_bytes());
+        return;
+    };
+    let code = format!("{:?}", status.code);
+    if as_json {
+        out.extend_from_slice(format!("{{\"{code}\"").as_bytes());
+    } else {
+        out.extend_from_slice(code.as_bytes());
+    }
+    out.push(b':');
+    if value as i32 >= 0 {
+        write_digits(out, status.arg as u32, 0, 0, 10, false);
+    } else {
+        out.extend_from_slice(format!("[\"{}\",", status.module_id).as_bytes());
+        write_digits(out, status.arg as u32, 0, 0, 10, false);
+        out.push(b']');
+    }
+    if as_json {
+        out.push(b'}');
+    }
+}
+
+// Formats a message like `base_vfprintf()` in print.c, taking the arguments
+// from `args` as `base_log_internal_binary()` wrote them. Returns `None` if the
+// record is incomplete.
+fn format_message(format: &[u8], args: &mut RecordReader) -> Option<Vec<u8>> {
+    let mut out = Vec::new();
+    let mut pos = 0;
+    while pos < format.len() {
+        if format[pos] != b'%' {
+            out.push(format[pos]);
+            pos += 1;
+            continue;
+        }
+        pos += 1;
+
+        let is_nonstd = format.get(pos) == Some(&b'!');
+        if is_nonstd {
+            pos += 1;
+        }
+        let mut padding = 0u8;
+        let mut width = 0usize;
+        while let Some(c @ b'0'..=b'9') = format.get(pos).copied() {
+            if padding == 0 {
+                padding = if c == b'0' { b'0' } else { b' ' };
+            }
+            width = width * 10 + (c - b'0') as usize;
+            pos += 1;
+        }
+        let Some(&spec) = format.get(pos) else {
+            out.extend_from_slice(b"%<unexpected nul>");
+            break;
+        };
+        if (width == 0 && padding != 0) || width > 32 {
+            out.extend_from_slice(b"%<bad width>");
+            break;
+        }
+        pos += 1;
+
+        match (spec, is_nonstd) {
+            (b'%', false) => out.push(b'%'),
+            (b'c', false) => out.push(args.word()? as u8),
+            (b'C', _) => {
+                for ch in args.word()?.to_le_bytes() {
+                    if (32..127).contains(&ch) {
+                        out.push(ch);
+                    } else {
+                        out.extend_from_slice(format!("\\x{ch:02x}").as_bytes());
+                    }
+                }
+            }
+            (b's', _) => out.extend_from_slice(args.bytes()?),
+            (b'd' | b'i', false) => {
+                let value = args.word()?;
+                if (value as i32) < 0 {
+                    out.push(b'-');
+                }
+                write_digits(
+                    &mut out,
+                    (value as i32).unsigned_abs(),
+                    width,
+                    padding,
+                    10,
+                    false,
+                );
+            }
+            (b'o', false) => write_digits(&mut out, args.word()?, width, padding, 8, false),
+            (b'u', false) => write_digits(&mut out, args.word()?, width, padding, 10, false),
+            (b'p', false) => {
+                out.extend_from_slice(b"0x");
+                write_digits(&mut out, args.word()?, 8, b'0', 16, false);
+            }
+            (b'x' | b'X' | b'y' | b'Y', true) => {
+                let big_endian = spec == b'x' || spec == b'X';
+                let upper = spec == b'X' || spec == b'Y';
+                hex_dump(&mut out, args.bytes()?, width, padding, big_endian, upper);
+            }
+            (b'x' | b'h', _) => write_digits(&mut out, args.word()?, width, padding, 16, false),
+            (b'X' | b'H', _) => write_digits(&mut out, args.word()?, width, padding, 16, true),
+            (b'b', true) => {
+                let value = args.word()?;
+                out.extend_from_slice(if value != 0 { b"true" } else { b"false" });
+            }
+            (b'b', false) => write_digits(&mut out, args.word()?, width, padding, 2, false),
+            (b'r', _) => write_status(&mut out, args.word()?, is_nonstd),
+            _ => out.extend_from_slice(b"%<unknown spec>"),
+        }
+    }
+    Some(out)
+}
+
+#[cfg(test)]
+mod test {
+    use super::*;
+
+    const IMAGE_BASE: u32 = 0x2000_0000;
+
+    // Builds an image holding a `log_fields_t` at `IMAGE_BASE` for the given
+    // format string.
+    fn decoder_for(severity: u32, format: &str) -> BinaryLogDecoder {
+        let file_name = b"sw/device/tests/example_test.c\0";
+        let file_addr = IMAGE_BASE + 20;
+        let format_addr = file_addr + file_name.len() as u32;
+
+        let mut image = Vec::new();
+        for word in [severity, file_addr, 42, 0, format_addr] {
+            image.extend_from_slice(&word.to_le_bytes());
+        }
+        image.extend_from_slice(file_name);
+        image.extend_from_slice(format.as_bytes());
+        image.push(0);
+        BinaryLogDecoder::new(vec![(IMAGE_BASE, image)])
+    }
+
+    fn uleb(out: &mut Vec<u8>, mut value: u32) {
+        loop {
+            let byte = (value & 0x7f) as u8;
+            value >>= 7;
+            if value == 0 {
+                out.push(byte);
+                return;
+            }
+            out.push(byte | 0x80);
+        }
+    }
+
+    fn record(words: &[u32]) -> Vec<u8> {
+        let mut out = vec![BinaryLogDecoder::RECORD_START];
+        uleb(&mut out, IMAGE_BASE);
+        words.iter().for_each(|&w| uleb(&mut out, w));
+        out
+    }
+
+    #[test]
+    fn renders_integers() {
+        let mut decoder = decoder_for(0, "a=%d b=%08x c=%u d=%b e=%X %%");
+        let data = record(&[-5i32 as u32, 0xbeef, 300, 5, 0xabc]);
+        assert_eq!(
+            decoder.decode(&data),
+            b"I00000 example_test.c:42] a=-5 b=0000beef c=300 d=101 e=ABC %\r\n"
+        );
+    }
+
+    #[test]
+    fn renders_inline_bytes() {
+        let mut decoder = decoder_for(2, "%s and %!s: %!x %!y %!b");
+        let mut data = record(&[]);
+        for bytes in [&b"hello"[..], b"wor", b"\x01\x02", b"\x01\x02"] {
+            uleb(&mut data, bytes.len() as u32);
+            data.extend_from_slice(bytes);
+        }
+        uleb(&mut data, 1);
+        assert_eq!(
+            decoder.decode(&data),
+            b"E00000 example_test.c:42] hello and wor: 0201 0102 true\r\n"
+        );
+    }
+
+    #[test]
+    fn passes_text_through_and_counts_records() {
+        let mut decoder = decoder_for(1, "%d");
+        let mut data = b"boot\r\n".to_vec();
+        data.extend(record(&[1]));
+        data.extend_from_slice(b"text");
+        data.extend(record(&[2]));
+
+        // Split the input to check that records can span calls.
+        let (first, second) = data.split_at(8);
+        let mut out = decoder.decode(first);
+        out.extend(decoder.decode(second));
+        assert_eq!(
+            out,
+            b"boot\r\nW00000 example_test.c:42] 1\r\ntextW00001 example_test.c:42] 2\r\n"
+        );
+    }
+
+    #[test]
+    fn reports_unknown_records() {
+        let mut decoder = decoder_for(0, "%d");
+        let mut data = vec![BinaryLogDecoder::RECORD_START];
+        uleb(&mut data, 0x1000);
+        assert_eq!(decoder.decode(&data), b"<unknown log record 0x1000>\r\n");
+    }
+}
@@ -12,6 +12,7 @@ use std::sync::atomic::{AtomicUsize, Ordering};
 use std::time::{Duration, Instant, SystemTime};
 
 use crate::io::console::{ConsoleDevice, ConsoleError};
+use crate::uart::binary_log::BinaryLogDecoder;
 use crate::util::file;
 
 #[derive(Default)]
@@ -25,6 +26,8 @@ pub struct UartConsole {
     pub buffer: String,
     pub newline: bool,
     pub break_en: bool,
+    // Renders binary log records, if the device software uses them.
+    pub binary_log: Option<BinaryLogDecoder>,
 }
 
 #[derive(Clone, Copy, Debug, PartialEq, Eq)]
@@ -204,6 +207,15 @@ impl UartConsole {
         if len == 0 {
             return Ok(false);
         }
+        let decoded;
+        let buf = match self.binary_log.as_mut() {
+            Some(decoder) => {
+                decoded = decoder.decode(&buf[..len]);
+                &decoded[..]
+            }
+            None => &buf[..len],
+        };
+        let len = buf.len();
         for i in 0..len {
             if self.timestamp && self.newline {
                 let t = humantime::format_rfc3339_millis(SystemTime::now());
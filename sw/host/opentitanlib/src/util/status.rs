@@ -10,7 +10,9 @@ use std::ffi::CString;
 use std::path::PathBuf;
 
 use anyhow::{bail, Context, Result};
-use bindgen::status::{ot_status_create_record_t, status_create, status_err, status_extract};
+use bindgen::status::{
+    ot_status_create_record_t, ot_status_site_record_t, status_create, status_err, status_extract,
+};
 use num_enum::TryFromPrimitive;
 use object::{Object, ObjectSection};
 use zerocopy::FromBytes;
@@ -109,8 +111,17 @@ impl Status {
             value: status as i32,
         })
     }
+
+    /// Whether this is an error status created in a lean build, in which case `arg` is the
+    /// index of its creation site in the `.ot.status_site` section.
+    pub fn is_lean(&self) -> bool {
+        self.code != StatusCode::Ok && self.module_id == LEAN_MODULE_ID
+    }
 }
 
+// Module ID reported by status_extract for lean error statuses.
+const LEAN_MODULE_ID: &str = "[*]";
+
 #[cfg(test)]
 mod test {
     use super::*;
@@ -240,3 +251,67 @@ pub fn load_elf(elf_file: &PathBuf) -> Result<StatusCreateRecords> {
         .collect::<Result<_>>()?;
     Ok(StatusCreateRecords { records })
 }
+
+#[derive(Debug, serde::Serialize, serde::Deserialize)]
+/// Hold a status creation site as stored in the `.ot.status_site` section of a lean build.
+pub struct StatusSiteRecord {
+    // Module ID, or None if it is not specified at compile time.
+    pub module_id: Option<u32>,
+    // Line that creates the status.
+    pub line: u32,
+    // Name of the file that creates the status.
+    pub filename: String,
+}
+
+impl StatusSiteRecord {
+    /// Compute the Module ID that status_create would have stored in a non-lean build.
+    pub fn get_module_id(&self) -> Result<String> {
+        StatusCreateRecord {
+            module_id: self.module_id,
+            filename: self.filename.clone(),
+        }
+        .get_module_id()
+    }
+}
+
+impl From<ot_status_site_record_t> for StatusSiteRecord {
+    fn from(record: ot_status_site_record_t) -> StatusSiteRecord {
+        StatusSiteRecord {
+            module_id: Some(record.module_id).filter(|mod_id| mod_id != &UNKNOWN_MODULE_ID),
+            line: record.line,
+            filename: c_string_to_string(&record.filename),
+        }
+    }
+}
+
+/// Load the status creation sites of a lean build, indexed like `Status::arg` of lean
+/// statuses. Returns an empty list if the ELF file has no `.ot.status_site` section.
+pub fn load_elf_sites(elf_file: &PathBuf) -> Result<Vec<StatusSiteRecord>> {
+    let file_data = std::fs::read(elf_file)
+        .with_context(|| format!("Could not read ELF file {}.", elf_file.display()))?;
+    let file = object::File::parse(&*file_data)
+        .with_context(|| format!("Could not parse ELF file {}", elf_file.display()))?;
+    let Some(section) = file.section_by_name(".ot.status_site") else {
+        return Ok(vec![]);
+    };
+    // The lean status encoding relies on the section starting at address zero.
+    if section.address() != 0 {
+        bail!(
+            ".ot.status_site section should start at address 0, not {:#x}",
+            section.address()
+        );
+    }
+    let sites = section
+        .data()
+        .context("cannot read .ot.status_site section data")?;
+    const RECORD_SIZE: usize = std::mem::size_of::<ot_status_site_record_t>();
+    if sites.len() % RECORD_SIZE != 0 {
+        bail!(".ot.status_site section size ({}) is not a multiple of the ot_status_site_record_t size ({})",
+              sites.len(), RECORD_SIZE);
+    }
+    Ok(sites
+        .chunks(RECORD_SIZE)
+        .map(|chunk| ot_status_site_record_t::read_from(chunk).unwrap())
+        .map(StatusSiteRecord::from)
+        .collect())
+}
@@ -8,12 +8,14 @@ use regex::Regex;
 use serde_annotate::Annotate;
 use std::any::Any;
 use std::fs::File;
+use std::path::PathBuf;
 use std::time::Duration;
 
 use opentitanlib::app::command::CommandDispatch;
 use opentitanlib::app::TransportWrapper;
 use opentitanlib::io::uart::UartParams;
 use opentitanlib::transport::Capability;
+use opentitanlib::uart::binary_log::BinaryLogDecoder;
 use opentitanlib::uart::console::{ExitStatus, UartConsole};
 use opentitanlib::util::raw_tty::RawTty;
 
@@ -51,6 +53,10 @@ pub struct Console {
     /// Exit with failure if the specified regex is matched.
     #[arg(long)]
     exit_failure: Option<String>,
+
+    /// Render binary log records using this ELF file of the device software.
+    #[arg(long)]
+    log_elf: Option<PathBuf>,
 }
 
 impl CommandDispatch for Console {
@@ -78,6 +84,11 @@ impl CommandDispatch for Console {
                 .transpose()?,
             timestamp: self.timestamp,
             newline: true,
+            binary_log: self
+                .log_elf
+                .as_ref()
+                .map(|path| BinaryLogDecoder::from_elf(&std::fs::read(path)?))
+                .transpose()?,
             ..Default::default()
         };
 
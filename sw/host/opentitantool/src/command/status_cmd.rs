@@ -12,7 +12,7 @@ use std::path::PathBuf;
 use opentitanlib::app::command::CommandDispatch;
 use opentitanlib::app::TransportWrapper;
 use opentitanlib::util::parse_int::ParseInt;
-use opentitanlib::util::status::{load_elf, Status};
+use opentitanlib::util::status::{load_elf, load_elf_sites, Status, StatusSiteRecord};
 
 #[derive(Debug, Subcommand, CommandDispatch)]
 /// Commands for interacting with status.
@@ -148,6 +148,8 @@ pub struct DecodeCommand {
 pub struct DecodedStatus {
     pub status: Status,
     pub filenames: Vec<String>,
+    /// Creation site of a lean status.
+    pub site: Option<StatusSiteRecord>,
 }
 
 impl CommandDispatch for DecodeCommand {
@@ -158,12 +160,37 @@ impl CommandDispatch for DecodeCommand {
     ) -> Result<Option<Box<dyn Annotate>>> {
         // Decode status.
         let status = Status::from_u32(self.raw_status)?;
+        // Lean statuses carry the index of their creation site, which gives the
+        // filename directly.
+        if status.is_lean() {
+            let site = match &self.elf {
+                None => None,
+                Some(elf) => {
+                    let index = status.arg as usize;
+                    let mut sites = load_elf_sites(elf)?;
+                    if index >= sites.len() {
+                        bail!("status site {} is not in {}", index, elf.display());
+                    }
+                    Some(sites.swap_remove(index))
+                }
+            };
+            let filenames = site.iter().map(|s| s.filename.clone()).collect();
+            return Ok(Some(Box::new(DecodedStatus {
+                status,
+                filenames,
+                site,
+            })));
+        }
         // Find filenames
         let filenames = match &self.elf {
             None => vec![],
             Some(elf) => load_elf(elf)?.find_module_id(&status.module_id),
         };
         // Gather things together and do some pretty-printing of module IDs.
-        Ok(Some(Box::new(DecodedStatus { status, filenames })))
+        Ok(Some(Box::new(DecodedStatus {
+            status,
+            filenames,
+            site: None,
+        })))
     }
 }
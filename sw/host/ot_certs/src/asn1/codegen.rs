@@ -628,10 +628,12 @@ impl Builder for Codegen<'_> {
         );
         self.tag_idx += 1;
         self.push_str_with_indent(&format!("asn1_tag_t {tag_name};\n"));
-        self.push_str_with_indent(&format!(
-            "RETURN_IF_ERROR(asn1_start_tag(&state, &{tag_name}, {}));\n",
-            tag.codestring()
-        ));
+        // The start of the tag carries a bound on the size of the content so that
+        // the asn1 library can reserve the right number of length bytes upfront.
+        // The bound is only known after generating the content, so remember where
+        // the call goes and insert it afterwards.
+        let start_indent = self.indent.repeat(self.indent_lvl);
+        let start_pos = self.output.len();
         self.push_str_with_indent("{\n");
         self.indent_lvl += 1;
         // We do not yet know how many bytes the content will use: remember the current
@@ -641,6 +643,13 @@ impl Builder for Codegen<'_> {
         gen(self)?;
         let max_size = self.max_out_size - old_max_size;
         self.max_out_size += Self::tag_size(max_size);
+        self.output.insert_str(
+            start_pos,
+            &format!(
+                "{start_indent}RETURN_IF_ERROR(asn1_start_tag_sized(&state, &{tag_name}, {}, {max_size}));\n",
+                tag.codestring()
+            ),
+        );
         self.indent_lvl -= 1;
         self.push_str_with_indent("}\n");
         self.push_str_with_indent(&format!("RETURN_IF_ERROR(asn1_finish_tag(&{tag_name}));\n"));
@@ -154,6 +154,7 @@ void ReportSyntax(void) {
   fputs(
       "Usage:\n"
       "  stream [-n<streams>][-v<bool>][-c<bool>][-r<bool>][-s<bool>][-t][-z]\n"
+      "         [-q<depth>]\n"
       "         [[-d<bus>:<address>] | [--device <bus>:<address>]]\n"
       "         [<input port>[ <output port>]]"
       "\n\n"
@@ -163,6 +164,8 @@ void ReportSyntax(void) {
       "  -c   check any retrieved data against expectations\n"
       "  -d   specify a particular USB device by bus number"
       " and device address\n"
+      "  -q   number of IN transfers to keep in progress on each libusb Bulk\n"
+      "       or Interrupt stream (1-255, default 1)\n"
       "  -r   retrieve data from device\n"
       "  -s   send data to device\n"
       "  -t   use serial ports (ttyUSBx) in preference to libusb Bulk\n"
@@ -305,8 +308,9 @@ static int RunTest(USBDevice *dev, const char *in_port, const char *out_port) {
         // Transfers.
       case USBDevStream::StreamType_Bulk: {
         USBDevInt *interrupt;
-        interrupt = new USBDevInt(dev, bulk, idx, transfer_bytes, cfg.retrieve,
-                                  cfg.check, cfg.send, cfg.verbose);
+        interrupt =
+            new USBDevInt(dev, bulk, idx, transfer_bytes, cfg.retrieve,
+                          cfg.check, cfg.send, cfg.verbose, cfg.queue_depth);
         if (interrupt) {
           opened = interrupt->Open(idx);
           if (opened) {
@@ -508,6 +512,17 @@ int main(int argc, char *argv[]) {
             return 7;
           }
           break;
+        case 'q': {
+          const char *p = &argv[i][2];
+          uint8_t depth;
+          if (!GetByte(&p, depth) || !depth || *p != '\0') {
+            std::cerr << "ERROR: Invalid queue depth '" << argv[i] << "'"
+                      << std::endl;
+            ReportSyntax();
+            return 7;
+          }
+          cfg.queue_depth = depth;
+        } break;
         case 'r':
           cfg.retrieve = GetBool(&argv[i][2]);
           cfg.override_flags = true;
@@ -30,7 +30,8 @@ struct TestConfig {
 #else
         serial(true),
 #endif
-        suspending(false) {
+        suspending(false),
+        queue_depth(1U) {
   }
   /**
    * Verbose logging/diagnostic reporting.
@@ -60,6 +61,10 @@ struct TestConfig {
    * Are we performing suspend-resume testing whilst streaming?
    */
   bool suspending;
+  /**
+   * Number of IN transfers kept in progress on each Bulk/Interrupt stream.
+   */
+  unsigned queue_depth;
 };
 
 // Has any data yet been received from the device?
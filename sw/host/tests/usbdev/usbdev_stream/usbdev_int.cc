@@ -5,6 +5,7 @@
 
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 
 #include "usbdev_utils.h"
 
@@ -33,8 +34,6 @@ bool USBDevInt::Open(unsigned interface) {
   epIn_ = 0x80U | epOut_;
 
   // No transfers in progress.
-  xfrIn_ = nullptr;
-
   xfrOut_ = nullptr;
 
   maxPacketSize_ = USBDevice::kDevDataMaxPacketSize;
@@ -57,7 +56,7 @@ void USBDevInt::Pause() {
   if (verbose_) {
     std::cout << PrefixID() << "waiting to close" << std::endl;
   }
-  while (inActive_ || outActive_) {
+  while (inFlight_ || outActive_) {
     dev_->Service();
   }
   if (verbose_) {
@@ -92,38 +91,58 @@ void USBDevInt::DumpIntTransfer(struct libusb_transfer *xfr) const {
 
 // Retrieving of IN traffic from device.
 bool USBDevInt::ServiceIN() {
-  // Ensure that we have enough space available for a full packet; the device
-  // software decides upon the length of each packet.
-  uint8_t *space;
-  bool ok = ProvisionSpace(&space, maxPacketSize_);
-  if (ok) {
-    uint32_t to_fetch = maxPacketSize_;
-    if (to_fetch > transfer_bytes_ - bytes_recvd_) {
-      to_fetch = transfer_bytes_ - bytes_recvd_;
-    }
-
-    if (!xfrIn_) {
-      xfrIn_ = dev_->AllocTransfer(0U);
-      if (!xfrIn_) {
+  // Allocate the IN transfers and their staging buffers on first use.
+  if (xfrIn_.empty()) {
+    inBuf_.resize(queueDepth_ * maxPacketSize_);
+    for (unsigned idx = 0U; idx < queueDepth_; idx++) {
+      struct libusb_transfer *xfr = dev_->AllocTransfer(0U);
+      if (!xfr) {
         return false;
       }
+      xfr->buffer = &inBuf_[idx * maxPacketSize_];
+      xfrIn_.push_back(xfr);
+      freeIn_.push(xfr);
+    }
+  }
+
+  // Don't request more data whilst there is received data waiting for space in
+  // the stream buffer.
+  if (!doneIn_.empty()) {
+    return true;
+  }
+
+  // Keep as many IN transfers in progress as permitted; the device software
+  // decides upon the length of each packet, so each transfer must be able to
+  // accept a full packet.
+  while (!freeIn_.empty()) {
+    uint32_t remaining = transfer_bytes_ - bytes_recvd_;
+    remaining =
+        (remaining > inFlightBytes_) ? (remaining - inFlightBytes_) : 0U;
+    uint32_t to_fetch = maxPacketSize_;
+    if (to_fetch > remaining) {
+      to_fetch = remaining;
+    }
+    // Additional transfers are only useful if there is more data to come.
+    if (inFlight_ && !to_fetch) {
+      break;
     }
 
+    struct libusb_transfer *xfr = freeIn_.front();
     if (bulk_) {
-      dev_->FillBulkTransfer(xfrIn_, epIn_, space, to_fetch, CbStubIN, this,
+      dev_->FillBulkTransfer(xfr, epIn_, xfr->buffer, to_fetch, CbStubIN, this,
                              kDataTimeout);
     } else {
-      dev_->FillIntTransfer(xfrIn_, epIn_, space, to_fetch, CbStubIN, this,
+      dev_->FillIntTransfer(xfr, epIn_, xfr->buffer, to_fetch, CbStubIN, this,
                             kDataTimeout);
     }
 
-    int rc = dev_->SubmitTransfer(xfrIn_);
+    int rc = dev_->SubmitTransfer(xfr);
     if (rc < 0) {
       return dev_->ErrorUSB("ERROR: Submitting IN transfer", rc);
     }
-    inActive_ = true;
-  } else {
-    inActive_ = false;
+    freeIn_.pop();
+    inFlight_++;
+    inFlightBytes_ += to_fetch;
   }
 
   return true;
@@ -170,8 +189,14 @@ bool USBDevInt::Service() {
   if (failed_) {
     return false;
   }
-  // (Re)start IN traffic if not already in progress.
-  if (!inActive_ && !ServiceIN()) {
+  // Collect any received data that was waiting for space in the stream
+  // buffer.
+  if (!DrainIN()) {
+    failed_ = true;
+    return false;
+  }
+  // (Re)start IN traffic on any transfers not already in progress.
+  if (!ServiceIN()) {
     return false;
   }
   // (Re)start OUT traffic if not already in progress and there is
@@ -182,8 +207,67 @@ bool USBDevInt::Service() {
   return true;
 }
 
+// Transfer the data from completed IN transfers into the stream buffer.
+bool USBDevInt::DrainIN() {
+  while (!doneIn_.empty()) {
+    struct libusb_transfer *xfr = doneIn_.front();
+    int nrecvd = xfr->actual_length;
+    uint8_t *dp = nullptr;
+    if (nrecvd > 0) {
+      if (!ProvisionSpace(&dp, (uint32_t)nrecvd)) {
+        // Retry when more of the buffered data has been sent.
+        return true;
+      }
+      memcpy(dp, xfr->buffer, nrecvd);
+
+      // Update the circular buffer with the amount of data that we've received
+      CommitData(nrecvd);
+    }
+
+    // The transfer may now be reused.
+    doneIn_.pop();
+    freeIn_.push(xfr);
+
+    // Collect and parse signature bytes at the start of the IN stream.
+    if (!SigReceived()) {
+      if (nrecvd > 0 && !SigReceived()) {
+        uint32_t dropped = SigDetect(&sig_, dp, (uint32_t)nrecvd);
+
+        // Consume stream signature, rather than propagating it to the output
+        // side.
+        if (SigReceived()) {
+          SigProcess(sig_);
+          dropped += sizeof(usbdev_stream_sig_t);
+        }
+
+        // Skip past any dropped bytes, including the signature, so that if
+        // there are additional bytes we may process them.
+        nrecvd =
+            ((uint32_t)nrecvd > dropped) ? ((uint32_t)nrecvd - dropped) : 0;
+        dp += dropped;
+
+        if (dropped) {
+          DiscardData(dropped);
+        }
+      }
+    }
+
+    if (nrecvd > 0) {
+      // Check the received LFSR-generated byte(s) and combine them with the
+      // output of our host-side LFSR.
+      if (!ProcessData(dp, nrecvd)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 // Callback function supplied to libusb for IN transfers.
 void USBDevInt::CallbackIN(struct libusb_transfer *xfr) {
+  inFlight_--;
+  inFlightBytes_ -= xfr->length;
+
   if (xfr->status != LIBUSB_TRANSFER_COMPLETED) {
     std::cerr << PrefixID() << " Invalid/unexpected IN transfer status "
               << xfr->status << std::endl;
@@ -198,51 +282,17 @@ void USBDevInt::CallbackIN(struct libusb_transfer *xfr) {
     DumpIntTransfer(xfr);
   }
 
-  // Collect and parse signature bytes at the start of the IN stream.
-  uint8_t *dp = xfr->buffer;
-  int nrecvd = xfr->actual_length;
-
-  // Update the circular buffer with the amount of data that we've received
-  CommitData(nrecvd);
-
-  if (!SigReceived()) {
-    if (nrecvd > 0 && !SigReceived()) {
-      uint32_t dropped = SigDetect(&sig_, dp, (uint32_t)nrecvd);
-
-      // Consume stream signature, rather than propagating it to the output
-      // side.
-      if (SigReceived()) {
-        SigProcess(sig_);
-        dropped += sizeof(usbdev_stream_sig_t);
-      }
-
-      // Skip past any dropped bytes, including the signature, so that if there
-      // are additional bytes we may process them.
-      nrecvd = ((uint32_t)nrecvd > dropped) ? ((uint32_t)nrecvd - dropped) : 0;
-      dp += dropped;
-
-      if (dropped) {
-        DiscardData(dropped);
-      }
-    }
-  }
-
-  bool ok = true;
-  if (nrecvd > 0) {
-    // Check the received LFSR-generated byte(s) and combine them with the
-    // output of our host-side LFSR.
-    ok = ProcessData(dp, nrecvd);
+  // Transfers complete in the order in which they were submitted, so the data
+  // may be processed in order of completion.
+  doneIn_.push(xfr);
+  if (!DrainIN()) {
+    failed_ = true;
+    return;
   }
 
-  if (ok) {
-    if (CanSchedule()) {
-      // Attempt to set up another IN transfer.
-      failed_ = !ServiceIN();
-    } else {
-      inActive_ = false;
-    }
-  } else {
-    failed_ = true;
+  if (CanSchedule()) {
+    // Attempt to set up further IN transfers.
+    failed_ = !ServiceIN();
   }
 }
 
@@ -4,6 +4,7 @@
 #ifndef OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USBDEV_INT_H_
 #define OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USBDEV_INT_H_
 #include <queue>
+#include <vector>
 
 #include "usb_device.h"
 #include "usbdev_stream.h"
@@ -16,14 +17,16 @@
 class USBDevInt : public USBDevStream {
  public:
   USBDevInt(USBDevice *dev, bool bulk, unsigned id, uint32_t transfer_bytes,
-            bool retrieve, bool check, bool send, bool verbose)
+            bool retrieve, bool check, bool send, bool verbose,
+            unsigned queue_depth = 1U)
       : USBDevStream(id, transfer_bytes, retrieve, check, send, verbose),
         dev_(dev),
         bulk_(bulk),
         failed_(false),
-        inActive_(false),
+        queueDepth_(queue_depth ? queue_depth : 1U),
+        inFlight_(0U),
+        inFlightBytes_(0U),
         outActive_(false),
-        xfrIn_(nullptr),
         xfrOut_(nullptr) {}
   /**
    * Open an Interrupt connection to specified device interface.
@@ -79,6 +82,13 @@ class USBDevInt : public USBDevStream {
    * @return true iff the stream is still operational.
    */
   bool ServiceOUT();
+  /**
+   * Transfer the data from completed IN transfers, in order, into the stream
+   * buffer and process it, for as long as there is space available.
+   *
+   * @return true iff the stream is still operational.
+   */
+  bool DrainIN();
   /**
    * Callback function supplied to libusb for IN transfers; transfer has
    * completed and requires attention.
@@ -118,14 +128,29 @@ class USBDevInt : public USBDevStream {
   // Has this stream experienced a failure?
   bool failed_;
 
-  // Is an IN transfer in progress?
-  bool inActive_;
+  // Maximum number of IN transfers that may be in progress at once.
+  unsigned queueDepth_;
+
+  // Number of IN transfers in progress.
+  unsigned inFlight_;
+
+  // Number of bytes requested by the IN transfers in progress.
+  uint32_t inFlightBytes_;
 
   // Is an OUT transfer in progress?
   bool outActive_;
 
-  // Do we currently have an IN transfer?
-  struct libusb_transfer *xfrIn_;
+  // IN transfers, each with a staging buffer of `maxPacketSize_` bytes within
+  // `inBuf_`.
+  std::vector<struct libusb_transfer *> xfrIn_;
+  std::vector<uint8_t> inBuf_;
+
+  // IN transfers available for submission.
+  std::queue<struct libusb_transfer *> freeIn_;
+
+  // Completed IN transfers whose data has not yet been transferred into the
+  // stream buffer, in order of completion.
+  std::queue<struct libusb_transfer *> doneIn_;
 
   // Do we currently have an OUT transfer?
   struct libusb_transfer *xfrOut_;
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "usbdev_stream.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstring>
@@ -26,6 +27,55 @@
   (((lfsr) << 1) ^         \
    ((((lfsr) >> 1) ^ ((lfsr) >> 2) ^ ((lfsr) >> 3) ^ ((lfsr) >> 7)) & 1u))
 
+namespace {
+
+// Period of the LFSR; zero is the only state outside of the cycle.
+constexpr uint32_t kLfsrPeriod = 255U;
+
+// Precomputed LFSR output sequence, so that data may be generated and checked
+// with block operations rather than by stepping the LFSR for every byte.
+class LfsrTable {
+ public:
+  LfsrTable() {
+    uint8_t lfsr = 1U;
+    for (uint32_t idx = 0U; idx < sizeof(seq_); idx++) {
+      seq_[idx] = lfsr;
+      if (idx < kLfsrPeriod) {
+        pos_[lfsr] = (uint8_t)idx;
+      }
+      lfsr = LFSR_ADVANCE(lfsr);
+    }
+  }
+  // Return the run of `len` (<= kLfsrPeriod) bytes generated from the LFSR
+  // state `lfsr`, advancing the state past them.
+  const uint8_t *Run(uint8_t &lfsr, uint32_t len) const {
+    assert(len <= kLfsrPeriod);
+    if (!lfsr) {
+      // A zero LFSR remains stuck at zero.
+      return zeros_;
+    }
+    const uint8_t *run = &seq_[pos_[lfsr]];
+    lfsr = run[len];
+    return run;
+  }
+
+ private:
+  // Sequence starting from state 1, extended so that a run of up to one
+  // period, plus the following state, may be taken from any position.
+  uint8_t seq_[2U * kLfsrPeriod];
+  // Position of each LFSR state within `seq_`.
+  uint8_t pos_[256];
+  // Output of an LFSR with zero state.
+  uint8_t zeros_[kLfsrPeriod] = {};
+};
+
+const LfsrTable &Lfsr() {
+  static const LfsrTable table;
+  return table;
+}
+
+}  // namespace
+
 USBDevStream::USBDevStream(unsigned id, uint32_t transfer_bytes, bool retrieve,
                            bool check, bool send, bool verbose) {
   // Remember Stream IDentifier and flags.
@@ -270,9 +320,11 @@ void USBDevStream::GenerateData(uint8_t *dp, uint32_t len) {
   // Generate a stream of bytes _as if_ we'd received them correctly from
   // the device
   uint8_t next_lfsr = tst_lfsr_;
-  for (unsigned idx = 0U; idx < len; idx++) {
-    dp[idx] = next_lfsr;
-    next_lfsr = LFSR_ADVANCE(next_lfsr);
+  while (len > 0U) {
+    uint32_t chunk = std::min(len, kLfsrPeriod);
+    memcpy(dp, Lfsr().Run(next_lfsr, chunk), chunk);
+    dp += chunk;
+    len -= chunk;
   }
 }
 
@@ -292,31 +344,40 @@ bool USBDevStream::ProcessData(uint8_t *dp, uint32_t len) {
                 << " byte(s)" << std::endl;
     }
 
-    // We can just check and overwrite the input data in-situ.
-    const uint8_t *sp = dp;
-    for (uint32_t idx = 0U; idx < len; idx++) {
-      uint8_t expected = tst_lfsr_;
-      uint8_t recvd = sp[idx];
-
-      // Check whether the received byte is as expected.
-      if (retrieve_ && check_) {
-        if (recvd != expected) {
-          printf("S%u: Mismatched data from device 0x%02x, expected 0x%02x\n",
-                 id_, recvd, expected);
-          ok = false;
+    // We can just check and overwrite the input data in-situ, one run of the
+    // LFSR sequences at a time.
+    uint32_t left = len;
+    while (left > 0U) {
+      uint32_t chunk = std::min(left, kLfsrPeriod);
+      const uint8_t *expected = Lfsr().Run(tst_lfsr_, chunk);
+      const uint8_t *dpi = Lfsr().Run(dpi_lfsr_, chunk);
+
+      // Check whether the received bytes are as expected; only rescan the
+      // run byte by byte to report any mismatches.
+      if (retrieve_ && check_ && memcmp(dp, expected, chunk)) {
+        for (uint32_t idx = 0U; idx < chunk; idx++) {
+          if (dp[idx] != expected[idx]) {
+            printf(
+                "S%u: Mismatched data from device 0x%02x, expected 0x%02x\n",
+                id_, dp[idx], expected[idx]);
+          }
         }
+        ok = false;
       }
 
-      // Simply XOR the two LFSR-generated streams together.
-      dp[idx] = recvd ^ dpi_lfsr_;
       if (verbose_) {
-        printf("S%u: 0x%02x <- 0x%02x ^ 0x%02x\n", id_, dp[idx], recvd,
-               dpi_lfsr_);
+        for (uint32_t idx = 0U; idx < chunk; idx++) {
+          printf("S%u: 0x%02x <- 0x%02x ^ 0x%02x\n", id_, dp[idx] ^ dpi[idx],
+                 dp[idx], dpi[idx]);
+        }
       }
 
-      // Advance our LFSRs.
-      tst_lfsr_ = LFSR_ADVANCE(tst_lfsr_);
-      dpi_lfsr_ = LFSR_ADVANCE(dpi_lfsr_);
+      // Simply XOR the two LFSR-generated streams together.
+      for (uint32_t idx = 0U; idx < chunk; idx++) {
+        dp[idx] ^= dpi[idx];
+      }
+      dp += chunk;
+      left -= chunk;
     }
 
     // Update the buffer writing state.
@@ -11,6 +11,8 @@
  *   2. MODE_ATTESTATION_KEYGEN: Derive a new attestation keypair (ECDSA-P256).
  *   3. MODE_ATTESTATION_ENDORSE: Sign with a saved attestation signing key.
  *   4. MODE_ATTESTATION_KEY_SAVE: Save an attestation signing key.
+ *   5. MODE_ATTESTATION_ENDORSE_AND_KEY_SAVE: Sign with a saved attestation
+ *      signing key, then save a new one in its place.
  *
  * Ibex will run `MODE_SEC_BOOT_MODEXP` as part of checking the code
  * signature of the next boot stage. This mode doesn't interact or interfere
@@ -28,6 +30,11 @@
  *   - Call `MODE_ATTESTATION_KEY_SAVE` to save the current stage's signing
  *     key, which will later endorse the next stage's certificate
  *
+ * The last two steps can be combined into a single run with
+ * `MODE_ATTESTATION_ENDORSE_AND_KEY_SAVE`. The key generation step cannot be
+ * merged with the endorsement, since the certificate being signed contains the
+ * public key.
+ *
  * Of course, in the first stage there is no previous stage signing key and no
  * certificate, so Ibex should skip the `MODE_ATTESTATION_ENDORSE` step. Ibex
  * may clear IMEM/DMEM if it needs to run a different OTBN routine (e.g.
@@ -50,6 +57,8 @@
  *
  * Call the same utility with the same arguments and a higher -m to generate
  * additional value(s) without changing the others or sacrificing mutual HD.
+ * MODE_ATTESTATION_ENDORSE_AND_KEY_SAVE was chosen to keep a minimum HD of 6
+ * from all other modes.
  *
  * TODO(#17727): in some places the OTBN assembler support for .equ directives
  * is lacking, so they cannot be used in bignum instructions or pseudo-ops such
@@ -60,6 +69,7 @@
 .equ MODE_ATTESTATION_KEYGEN, 0x2bf
 .equ MODE_ATTESTATION_ENDORSE, 0x5e8
 .equ MODE_ATTESTATION_KEY_SAVE, 0x64d
+.equ MODE_ATTESTATION_ENDORSE_AND_KEY_SAVE, 0x51e
 
 .section .text.start
 start:
@@ -79,6 +89,9 @@ start:
   addi  x3, x0, MODE_ATTESTATION_KEY_SAVE
   beq   x2, x3, attestation_key_save
 
+  addi  x3, x0, MODE_ATTESTATION_ENDORSE_AND_KEY_SAVE
+  beq   x2, x3, attestation_endorse_and_key_save
+
   /* Invalid mode; fail. */
   unimp
   unimp
@@ -227,6 +240,34 @@ attestation_key_save:
 
   ecall
 
+/**
+ * Sign a message with the saved signing key, then save a new signing key.
+ *
+ * Equivalent to `attestation_endorse` followed by `attestation_key_save`, but
+ * in one run. The old key is overwritten by the new one instead of being
+ * cleared with random data.
+ *
+ * @param[in]  dmem[msg]: Message digest (256 bits)
+ * @param[in]  dmem[attestation_additional_seed]: DRBG output.
+ * @param[out]   dmem[r]: Buffer for r component of signature (256 bits)
+ * @param[out]   dmem[s]: Buffer for s component of signature (256 bits)
+ * @param[in,out] dmem[d0]: First share of private key (320 bits).
+ * @param[in,out] dmem[d1]: Second share of private key (320 bits).
+ */
+attestation_endorse_and_key_save:
+  /* Generate a fresh random scalar for signing.
+       dmem[k0] <= first share of k
+       dmem[k1] <= second share of k */
+  jal      x1, p256_generate_k
+
+  /* Generate the signature with the saved key.
+       dmem[r], dmem[s] <= signature */
+  jal      x1, p256_sign
+
+  /* Tail-call `attestation_key_save` to replace the saved key.
+       dmem[d0], dmem[d1] <= new key */
+  jal      x0, attestation_key_save
+
 /**
  * Generate an attestation secret key from a sideloaded seed.
  *
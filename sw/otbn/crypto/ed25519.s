@@ -8,6 +8,14 @@
  *   https://datatracker.ietf.org/doc/html/rfc8032
  */
 
+/**
+ * Hardened boolean values.
+ *
+ * Should match the values in `hardened_asm.h`.
+ */
+.equ HARDENED_BOOL_TRUE, 0x739
+.equ HARDENED_BOOL_FALSE, 0x1d4
+
 /**
  * Add two points in extended twisted Edwards coordinates.
  *
@@ -155,3 +163,454 @@ ext_add:
   bn.mov   w13, w22
 
   ret
+
+/**
+ * Decode an Ed25519 point.
+ *
+ * Returns (X, Y, Z, T) = (x, y, 1, x*y) for the point with encoding enc.
+ *
+ * This implementation closely follows RFC 8032, section 5.1.3:
+ *   https://datatracker.ietf.org/doc/html/rfc8032#section-5.1.3
+ *
+ * The encoding consists of the 255-bit y-coordinate and, in the most
+ * significant bit, the least significant bit of the x-coordinate. Decoding
+ * fails if y >= p, if there is no square root for x^2, or if x = 0 and the
+ * sign bit is set.
+ *
+ * This routine runs in variable time and must only be used on public data.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w4: enc, encoded point
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[out] w10: X, x-coordinate
+ * @param[out] w11: Y, y-coordinate
+ * @param[out] w12: Z = 1
+ * @param[out] w13: T = x*y
+ * @param[out] x2: HARDENED_BOOL_TRUE if decoding succeeded, otherwise
+ *                 HARDENED_BOOL_FALSE
+ *
+ * clobbered registers: x2, x3, w5 to w7, w10 to w18, w20 to w26
+ * clobbered flag groups: FG0
+ */
+.globl ed25519_point_decode_var
+ed25519_point_decode_var:
+  /* w5 <= enc >> 255 = sign bit of x */
+  bn.rshi  w5, w31, w4 >> 255
+
+  /* w11 <= enc mod 2^255 = y */
+  bn.rshi  w11, w4, w31 >> 255
+  bn.rshi  w11, w31, w11 >> 1
+
+  /* Fail if y >= p.
+       FG0.C <= (y < p) */
+  bn.wsrr  w6, MOD
+  bn.cmp   w11, w6
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 1
+  beq      x2, x0, _ed25519_point_decode_fail
+
+  /* w6 <= 1 */
+  bn.addi  w6, w31, 1
+
+  /* w22 <= y^2 */
+  bn.mov   w22, w11
+  jal      x1, fe_square
+
+  /* w24 <= y^2 - 1 = u */
+  bn.subm  w24, w22, w6
+
+  /* w25 <= d*y^2 + 1 = v */
+  li       x2, 23
+  la       x3, ed25519_d
+  bn.lid   x2, 0(x3)
+  jal      x1, fe_mul
+  bn.addm  w25, w22, w6
+
+  /* w26 <= v^3 */
+  bn.mov   w22, w25
+  jal      x1, fe_square
+  bn.mov   w23, w25
+  jal      x1, fe_mul
+  bn.mov   w26, w22
+
+  /* w22 <= v^7 */
+  jal      x1, fe_square
+  bn.mov   w23, w25
+  jal      x1, fe_mul
+
+  /* w22 <= (u*v^7)^((p-5)/8) */
+  bn.mov   w23, w24
+  jal      x1, fe_mul
+  bn.mov   w16, w22
+  jal      x1, fe_pow_2252m3
+
+  /* w10 <= u*v^3*(u*v^7)^((p-5)/8) = x (candidate root) */
+  bn.mov   w23, w24
+  jal      x1, fe_mul
+  bn.mov   w23, w26
+  jal      x1, fe_mul
+  bn.mov   w10, w22
+
+  /* w22 <= v*x^2 */
+  jal      x1, fe_square
+  bn.mov   w23, w25
+  jal      x1, fe_mul
+
+  /* If v*x^2 = u, then x is a square root. */
+  bn.cmp   w22, w24
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  bne      x2, x0, _ed25519_point_decode_root_ok
+
+  /* If v*x^2 = -u, then x*sqrt(-1) is a square root; otherwise fail. */
+  bn.addm  w22, w22, w24
+  bn.cmp   w22, w31
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  beq      x2, x0, _ed25519_point_decode_fail
+
+  /* w10 <= x*sqrt(-1) */
+  li       x2, 23
+  la       x3, ed25519_sqrt_m1
+  bn.lid   x2, 0(x3)
+  bn.mov   w22, w10
+  jal      x1, fe_mul
+  bn.mov   w10, w22
+
+  _ed25519_point_decode_root_ok:
+
+  /* Fail if x = 0 and the sign bit is set. */
+  bn.cmp   w10, w31
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  beq      x2, x0, _ed25519_point_decode_x_nonzero
+  bn.cmp   w5, w31
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  beq      x2, x0, _ed25519_point_decode_fail
+
+  _ed25519_point_decode_x_nonzero:
+
+  /* If (x mod 2) != sign bit, then x <= p - x. */
+  bn.and   w7, w10, w6
+  bn.cmp   w7, w5
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  bne      x2, x0, _ed25519_point_decode_sign_ok
+  bn.subm  w10, w31, w10
+
+  _ed25519_point_decode_sign_ok:
+
+  /* w12 <= 1 = Z */
+  bn.mov   w12, w6
+
+  /* w13 <= x*y = T */
+  bn.mov   w22, w10
+  bn.mov   w23, w11
+  jal      x1, fe_mul
+  bn.mov   w13, w22
+
+  addi     x2, x0, HARDENED_BOOL_TRUE
+  ret
+
+  _ed25519_point_decode_fail:
+  addi     x2, x0, HARDENED_BOOL_FALSE
+  ret
+
+/**
+ * Verify an Ed25519 signature.
+ *
+ * Checks that [S]B = R + [k]A, where B is the base point, A is the public
+ * key, (R, S) is the signature and k is the SHA-512 hash of
+ * (enc(R) || enc(A) || M) interpreted as a little-endian integer.
+ *
+ * This implementation follows RFC 8032, section 5.1.7:
+ *   https://datatracker.ietf.org/doc/html/rfc8032#section-5.1.7
+ *
+ * Rather than decoding R, the routine computes [S]B + [k](-A) with
+ * Shamir's trick over a table of B, -A and B - A, and then compares the
+ * encoding of the result with enc(R). The hash k is supplied by the caller,
+ * so that any SHA-512 implementation can be used to compute it. The check is
+ * the unbatched equation without the cofactor, which RFC 8032 permits.
+ *
+ * This routine runs in variable time and must only be used on public data.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  [w1:w0]: k, 512-bit hash of enc(R) || enc(A) || M
+ * @param[in]  w2: enc(R), first half of the signature
+ * @param[in]  w3: S, second half of the signature
+ * @param[in]  w4: enc(A), encoded public key
+ * @param[out] x2: HARDENED_BOOL_TRUE if the signature is valid, otherwise
+ *                 HARDENED_BOOL_FALSE
+ *
+ * clobbered registers: x2 to x7, w5 to w31, MOD
+ * clobbered flag groups: FG0
+ */
+.globl ed25519_verify_var
+ed25519_verify_var:
+  /* Prepare all-zero register. */
+  bn.xor   w31, w31, w31
+
+  /* Load scalar field constants.
+       MOD <= L
+       [w15:w14] <= mu */
+  jal      x1, sc_init
+
+  /* Fail if S >= L.
+       FG0.C <= (S < L) */
+  bn.wsrr  w5, MOD
+  bn.cmp   w3, w5
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 1
+  beq      x2, x0, _ed25519_verify_fail
+
+  /* Reduce the hash modulo L in two steps, since sc_reduce only accepts
+     inputs below 2^510.
+       w18 <= k1 mod L, where k = k0 + k1 * 2^256 */
+  bn.mov   w16, w1
+  bn.mov   w17, w31
+  jal      x1, sc_reduce
+  /* w9 <= (k0 + (k1 mod L) * 2^256) mod L = k mod L */
+  bn.mov   w16, w0
+  bn.mov   w17, w18
+  jal      x1, sc_reduce
+  bn.mov   w9, w18
+
+  /* w8 <= S */
+  bn.mov   w8, w3
+
+  /* Load field constants.
+       MOD <= p
+       w19 <= 19
+       w30 <= (2*d) mod p */
+  li       x2, 5
+  la       x3, ed25519_p
+  bn.lid   x2, 0(x3)
+  bn.wsrw  MOD, w5
+  bn.addi  w19, w31, 19
+  li       x2, 30
+  la       x3, ed25519_d
+  bn.lid   x2, 0(x3)
+  bn.addm  w30, w30, w30
+
+  /* Decode the public key.
+       [w10, w11, w12, w13] <= A */
+  jal      x1, ed25519_point_decode_var
+  addi     x3, x0, HARDENED_BOOL_TRUE
+  bne      x2, x3, _ed25519_verify_fail
+
+  /* Negate the public key and store it as table entry 2.
+       [w10, w11, w12, w13] <= -A = (-X, Y, Z, -T) */
+  bn.subm  w10, w31, w10
+  bn.subm  w13, w31, w13
+  la       x3, ed25519_verify_table
+  li       x2, 10
+  bn.sid   x2++, 128(x3)
+  bn.sid   x2++, 160(x3)
+  bn.sid   x2++, 192(x3)
+  bn.sid   x2++, 224(x3)
+
+  /* Copy -A to the second operand of ext_add.
+       [w14, w15, w16, w17] <= -A */
+  bn.mov   w14, w10
+  bn.mov   w15, w11
+  bn.mov   w16, w12
+  bn.mov   w17, w13
+
+  /* Construct the base point and store it as table entry 1.
+       [w10, w11, w12, w13] <= B = (Bx, By, 1, Bx*By) */
+  li       x2, 10
+  la       x3, ed25519_Bx
+  bn.lid   x2++, 0(x3)
+  la       x3, ed25519_By
+  bn.lid   x2, 0(x3)
+  bn.addi  w12, w31, 1
+  bn.mov   w22, w10
+  bn.mov   w23, w11
+  jal      x1, fe_mul
+  bn.mov   w13, w22
+  la       x3, ed25519_verify_table
+  li       x2, 10
+  bn.sid   x2++, 0(x3)
+  bn.sid   x2++, 32(x3)
+  bn.sid   x2++, 64(x3)
+  bn.sid   x2++, 96(x3)
+
+  /* Compute B - A and store it as table entry 3.
+       [w10, w11, w12, w13] <= B + (-A) */
+  jal      x1, ext_add
+  la       x3, ed25519_verify_table
+  li       x2, 10
+  bn.sid   x2++, 256(x3)
+  bn.sid   x2++, 288(x3)
+  bn.sid   x2++, 320(x3)
+  bn.sid   x2++, 352(x3)
+
+  /* Both scalars are below L < 2^253. Shift them so that their most
+     significant bits can be read from the carry flag one at a time.
+       w8 <= S << 3
+       w9 <= k << 3 */
+  bn.rshi  w8, w8, w31 >> 253
+  bn.rshi  w9, w9, w31 >> 253
+
+  /* Initialize the accumulator to the identity.
+       [w10, w11, w12, w13] <= (0, 1, 1, 0) */
+  bn.mov   w10, w31
+  bn.addi  w11, w31, 1
+  bn.addi  w12, w31, 1
+  bn.mov   w13, w31
+
+  /* Iterate over the 253 scalar bits, most significant first. */
+  li       x5, 253
+  _ed25519_verify_loop:
+    /* Double the accumulator.
+         [w10, w11, w12, w13] <= 2 * P */
+    bn.mov   w14, w10
+    bn.mov   w15, w11
+    bn.mov   w16, w12
+    bn.mov   w17, w13
+    jal      x1, ext_add
+
+    /* x6 <= next bit of S */
+    bn.add   w8, w8, w8
+    csrrs    x6, FG0, x0
+    andi     x6, x6, 1
+
+    /* x7 <= next bit of k */
+    bn.add   w9, w9, w9
+    csrrs    x7, FG0, x0
+    andi     x7, x7, 1
+
+    /* x6 <= table index = (S bit) + 2 * (k bit); skip the addition if 0. */
+    slli     x7, x7, 1
+    or       x6, x6, x7
+    beq      x6, x0, _ed25519_verify_loop_next
+
+    /* Load the table entry.
+         [w14, w15, w16, w17] <= dmem[ed25519_verify_table + (x6 - 1) * 128] */
+    addi     x6, x6, -1
+    slli     x6, x6, 7
+    la       x3, ed25519_verify_table
+    add      x3, x3, x6
+    li       x2, 14
+    bn.lid   x2++, 0(x3)
+    bn.lid   x2++, 32(x3)
+    bn.lid   x2++, 64(x3)
+    bn.lid   x2++, 96(x3)
+
+    /* [w10, w11, w12, w13] <= P + entry */
+    jal      x1, ext_add
+
+    _ed25519_verify_loop_next:
+    addi     x5, x5, -1
+    bne      x5, x0, _ed25519_verify_loop
+
+  /* Convert the result to affine coordinates.
+       w5 <= Z^-1 */
+  bn.mov   w16, w12
+  jal      x1, fe_inv
+  bn.mov   w5, w22
+
+  /* w6 <= X * Z^-1 = x */
+  bn.mov   w22, w10
+  bn.mov   w23, w5
+  jal      x1, fe_mul
+  bn.mov   w6, w22
+
+  /* w22 <= Y * Z^-1 = y */
+  bn.mov   w22, w11
+  bn.mov   w23, w5
+  jal      x1, fe_mul
+
+  /* Encode the result.
+       w22 <= y + ((x mod 2) << 255) */
+  bn.addi  w7, w31, 1
+  bn.and   w6, w6, w7
+  bn.rshi  w6, w6, w31 >> 1
+  bn.or    w22, w22, w6
+
+  /* The signature is valid if and only if the encoding matches enc(R). */
+  bn.cmp   w22, w2
+  csrrs    x2, FG0, x0
+  andi     x2, x2, 8
+  beq      x2, x0, _ed25519_verify_fail
+
+  addi     x2, x0, HARDENED_BOOL_TRUE
+  ret
+
+  _ed25519_verify_fail:
+  addi     x2, x0, HARDENED_BOOL_FALSE
+  ret
+
+.section .data
+
+/* Modulus p = 2^255 - 19 */
+.balign 32
+ed25519_p:
+  .word 0xffffffed
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0xffffffff
+  .word 0x7fffffff
+
+/* Curve constant d = (-121665/121666) mod p */
+.balign 32
+ed25519_d:
+  .word 0x135978a3
+  .word 0x75eb4dca
+  .word 0x4141d8ab
+  .word 0x00700a4d
+  .word 0x7779e898
+  .word 0x8cc74079
+  .word 0x2b6ffe73
+  .word 0x52036cee
+
+/* Square root of -1, sqrt(-1) = 2^((p-1)/4) mod p */
+.balign 32
+ed25519_sqrt_m1:
+  .word 0x4a0ea0b0
+  .word 0xc4ee1b27
+  .word 0xad2fe478
+  .word 0x2f431806
+  .word 0x3dfbd7a7
+  .word 0x2b4d0099
+  .word 0x4fc1df0b
+  .word 0x2b832480
+
+/* Base point x-coordinate */
+.balign 32
+ed25519_Bx:
+  .word 0x8f25d51a
+  .word 0xc9562d60
+  .word 0x9525a7b2
+  .word 0x692cc760
+  .word 0xfdd6dc5c
+  .word 0xc0a4e231
+  .word 0xcd6e53fe
+  .word 0x216936d3
+
+/* Base point y-coordinate, 4/5 mod p */
+.balign 32
+ed25519_By:
+  .word 0x66666658
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+  .word 0x66666666
+
+.section .bss
+
+/* Table of B, -A and B - A in extended coordinates (X, Y, Z, T). */
+.balign 32
+ed25519_verify_table:
+  .zero 384
@@ -207,17 +207,11 @@ fe_square:
   ret
 
 /**
- * Compute the inverse of an element in the finite field modulo (2^255-19).
- *
- * Returns c = (a^(-1)) mod p.
+ * Compute a^(2^250-1) in the finite field modulo (2^255-19).
  *
- * Uses Fermat's Little Theorem, which states that for any nonzero element a of
- * the finite field modulo a prime p, then a^(p-1) mod p = 1. A corrolary of
- * this theorem is that (a * (a^(p-2))) mod p = 1, so a^(p-2) is a
- * multiplicative inverse of a modulo p.
- *
- * To compute a^(p-2), we use a square-and-multiply algorithm. This chain of
- * squares and multiplies is modified from curve25519-donna
+ * This is the common prefix of the exponentiation chains for inversion and
+ * for square roots. The chain of squares and multiplies is modified from
+ * curve25519-donna
  * (https://github.com/agl/curve25519-donna/blob/f7837adf95a2c2dcc36233cb02a1fb34081c0c4a/curve25519-donna-c64.c#L403),
  * which is in turn a modified version of the (qhasm) reference implementation
  * published with the original paper.
@@ -234,13 +228,13 @@ fe_square:
  * @param[in]  w16: a, first operand, a < p
  * @param[in]  MOD: p, modulus = 2^255 - 19
  * @param[in]  w31: all-zero
- * @param[out] w22: c, result
+ * @param[out] w22: a^(2^250-1) mod p
+ * @param[out] w14: a^11 mod p
  *
  * clobbered registers: w14, w15, w17, w18, w20 to w23
  * clobbered flag groups: FG0
  */
-.globl fe_inv
-fe_inv:
+fe_pow_2250m1:
   /* w22 <= w16^2 = a^2 */
   bn.mov  w22, w16
   jal     x1, fe_square
@@ -342,6 +336,38 @@ fe_inv:
   bn.mov  w23, w15
   jal     x1, fe_mul
 
+  ret
+
+/**
+ * Compute the inverse of an element in the finite field modulo (2^255-19).
+ *
+ * Returns c = (a^(-1)) mod p.
+ *
+ * Uses Fermat's Little Theorem, which states that for any nonzero element a of
+ * the finite field modulo a prime p, then a^(p-1) mod p = 1. A corrolary of
+ * this theorem is that (a * (a^(p-2))) mod p = 1, so a^(p-2) is a
+ * multiplicative inverse of a modulo p.
+ *
+ * To compute a^(p-2) = a^(2^255-21), we extend the chain in `fe_pow_2250m1`.
+ *
+ * This routine runs in constant time.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  w16: a, first operand, a < p
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[out] w22: c, result
+ *
+ * clobbered registers: w14, w15, w17, w18, w20 to w23
+ * clobbered flag groups: FG0
+ */
+.globl fe_inv
+fe_inv:
+  /* w22 <= a^(2^250-1), w14 <= a^11 */
+  jal     x1, fe_pow_2250m1
+
   /* w22 <= w22^(2^5) = a^(2^255-2^5) */
   loopi   5,2
     jal     x1, fe_square
@@ -352,3 +378,39 @@ fe_inv:
   jal     x1, fe_mul
 
   ret
+
+/**
+ * Raise an element of the finite field modulo (2^255-19) to the power (p-5)/8.
+ *
+ * Returns c = a^((p-5)/8) = a^(2^252-3) mod p.
+ *
+ * This exponent is used for computing square roots when decoding Ed25519
+ * points (see RFC 8032, section 5.1.3).
+ *
+ * This routine runs in constant time.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  w19: constant, w19 = 19
+ * @param[in]  w16: a, first operand, a < p
+ * @param[in]  MOD: p, modulus = 2^255 - 19
+ * @param[in]  w31: all-zero
+ * @param[out] w22: c, result
+ *
+ * clobbered registers: w14, w15, w17, w18, w20 to w23
+ * clobbered flag groups: FG0
+ */
+.globl fe_pow_2252m3
+fe_pow_2252m3:
+  /* w22 <= a^(2^250-1) */
+  jal     x1, fe_pow_2250m1
+
+  /* w22 <= w22^4 = a^(2^252-4) */
+  jal     x1, fe_square
+  jal     x1, fe_square
+
+  /* w22 <= w22 * w16 = a^(2^252-3) */
+  bn.mov  w23, w16
+  jal     x1, fe_mul
+
+  ret
@@ -11,6 +11,8 @@
  * 3. MODE_VERIFY: verify a signature
  * 4. MODE_SIDELOAD_KEYGEN: generate a keypair from a sideloaded seed
  * 5. MODE_SIDELOAD_SIGN: generate signature using sideloaded secret key/seed
+ * 6. MODE_VERIFY_PRECOMPUTE: compute the comb table for a public key
+ * 7. MODE_VERIFY_COMB: verify a signature using a precomputed comb table
  */
 
 /**
@@ -32,6 +34,21 @@
 .equ MODE_SIDELOAD_KEYGEN, 0x5e8
 .equ MODE_SIDELOAD_SIGN, 0x49e
 
+/**
+ * The generator above no longer reproduces the values above for -m 7, so the
+ * comb-table modes were picked by hand: MODE_VERIFY_COMB has a HD of at least
+ * 6 to all other modes, MODE_VERIFY_PRECOMPUTE a HD of at least 5.
+ */
+.equ MODE_VERIFY_PRECOMPUTE, 0x6e
+.equ MODE_VERIFY_COMB, 0x2b9
+
+/**
+ * Hardened boolean values.
+ *
+ * Should match the values in `hardened_asm.h`.
+ */
+.equ HARDENED_BOOL_TRUE, 0x739
+
 .section .text.start
 .globl start
 start:
@@ -54,6 +71,12 @@ start:
   addi  x3, x0, MODE_SIDELOAD_SIGN
   beq   x2, x3, sideload_ecdsa_sign
 
+  addi  x3, x0, MODE_VERIFY_PRECOMPUTE
+  beq   x2, x3, ecdsa_verify_precompute
+
+  addi  x3, x0, MODE_VERIFY_COMB
+  beq   x2, x3, ecdsa_verify_comb
+
   /* Invalid mode; fail. */
   unimp
   unimp
@@ -129,6 +152,54 @@ ecdsa_verify:
 
   ecall
 
+/**
+ * Compute the comb table for a public key.
+ *
+ * The table can be passed back in with MODE_VERIFY_COMB to verify any number
+ * of signatures against the same key.
+ *
+ * @param[in]  dmem[x]:   affine x-coordinate of public key (256 bits)
+ * @param[in]  dmem[y]:   affine y-coordinate of public key (256 bits)
+ * @param[out] dmem[ok]:  success/failure of basic checks (32 bits)
+ * @param[out] dmem[q_table]: comb table for the public key (15 * 512 bits)
+ */
+ecdsa_verify_precompute:
+  /* Validate the public key (ends the program on failure). */
+  jal      x1, p256_check_public_key
+
+  /* Compute the table. */
+  jal      x1, p256_verify_precompute
+
+  /* Set `ok` to true. */
+  la       x2, ok
+  addi     x3, x0, HARDENED_BOOL_TRUE
+  sw       x3, 0(x2)
+
+  ecall
+
+/**
+ * Verify a signature using a precomputed comb table for the public key.
+ *
+ * Same as MODE_VERIFY, but faster; see `p256_verify_comb`.
+ *
+ * @param[in]  dmem[msg]: message to be verified (256 bits)
+ * @param[in]  dmem[r]:   r component of signature (256 bits)
+ * @param[in]  dmem[s]:   s component of signature (256 bits)
+ * @param[in]  dmem[x]:   affine x-coordinate of public key (256 bits)
+ * @param[in]  dmem[y]:   affine y-coordinate of public key (256 bits)
+ * @param[in]  dmem[q_table]: comb table for the public key (15 * 512 bits)
+ * @param[out] dmem[ok]:  success/failure of basic checks (32 bits)
+ * @param[out] dmem[x_r]: dmem buffer for reduced affine x_r-coordinate (x_1)
+ */
+ecdsa_verify_comb:
+  /* Validate the public key (ends the program on failure). */
+  jal      x1, p256_check_public_key
+
+  /* Verify the signature (compute x_r). */
+  jal      x1, p256_verify_comb
+
+  ecall
+
 /**
  * Generate a keypair from a sideloaded seed.
  *
@@ -264,6 +335,12 @@ d1:
 x_r:
   .zero 32
 
+/* Comb table for the public key, see `p256_verify_precompute`. */
+.globl q_table
+.balign 32
+q_table:
+  .zero 960
+
 .section .scratchpad
 
 /* Secret scalar (k) in two shares: k = (k0 + k1) mod n */
@@ -19,6 +19,7 @@
 .equ HARDENED_BOOL_FALSE, 0x1d4
 
 .globl p256_verify
+.globl mod_inv_var
 
 .text
 
@@ -0,0 +1,734 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * Hardened boolean values.
+ *
+ * Should match the values in `hardened_asm.h`.
+ */
+.equ HARDENED_BOOL_TRUE, 0x739
+.equ HARDENED_BOOL_FALSE, 0x1d4
+
+.globl p256_verify_precompute
+.globl p256_verify_comb
+
+.text
+
+/**
+ * Precompute the comb table for a P-256 public key.
+ *
+ * Fills `q_table` with the 15 affine points
+ *   T[k] = k_0*Q + k_1*2^64*Q + k_2*2^128*Q + k_3*2^192*Q
+ * for k = k_0 + 2*k_1 + 4*k_2 + 8*k_3 in 1..15, where Q is the public key.
+ * Entry T[k] is stored at byte offset (k-1)*64, x-coordinate first; in
+ * particular, the first entry is Q itself. None of the entries can be the
+ * point at infinity, because the scalar multiples are all nonzero and smaller
+ * than the curve order n.
+ *
+ * The table only depends on the (public) key, so it may be computed once and
+ * reused by `p256_verify_comb` for any number of signatures.
+ *
+ * This routine runs in constant time.
+ *
+ * @param[in]  dmem[x]: affine x-coordinate of public key (256 bits)
+ * @param[in]  dmem[y]: affine y-coordinate of public key (256 bits)
+ * @param[out] dmem[q_table]: comb table for the public key (15 * 512 bits)
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * clobbered registers: x2 to x7, x20, w8 to w25, w27 to w29
+ * clobbered flag groups: FG0
+ */
+p256_verify_precompute:
+  /* init all-zero register */
+  bn.xor    w31, w31, w31
+
+  /* load domain parameter b from dmem
+     w27 <= b = dmem[p256_b] */
+  li        x2, 27
+  la        x3, p256_b
+  bn.lid    x2, 0(x3)
+
+  /* Set up for coordinate arithmetic.
+       MOD <= p
+       w28 <= r256
+       w29 <= r448 */
+  jal       x1, setup_modp
+
+  /* T[1] <= Q
+     (w8, w9, w10) <= (dmem[x], dmem[y], 1) */
+  la        x20, q_table
+  li        x2, 8
+  la        x3, x
+  bn.lid    x2, 0(x3)
+  bn.sid    x2, 0(x20)
+  li        x2, 9
+  la        x3, y
+  bn.lid    x2, 0(x3)
+  bn.sid    x2, 32(x20)
+  bn.addi   w10, w31, 1
+
+  /* x4 <= 1, index of the last computed power-of-two entry */
+  addi      x4, x0, 1
+  /* x5 <= 8, index of the last power-of-two entry */
+  addi      x5, x0, 8
+
+  precompute_power_loop:
+    /* (w11, w12, w13) <= 2^64 * (w8, w9, w10) = 2^64 * T[x4] */
+    loopi     64, 4
+      jal       x1, proj_double
+      bn.mov    w8, w11
+      bn.mov    w9, w12
+      bn.mov    w10, w13
+
+    /* (w11, w12) <= affine form of (w8, w9, w10) */
+    jal       x1, proj_to_affine
+
+    /* x4 <= 2 * x4; T[x4] <= (w11, w12) */
+    add       x4, x4, x4
+    addi      x6, x4, -1
+    slli      x6, x6, 6
+    add       x6, x20, x6
+    li        x2, 11
+    bn.sid    x2, 0(x6)
+    li        x2, 12
+    bn.sid    x2, 32(x6)
+
+    /* Fill in the entries between x4 and 2*x4 that combine T[x4] with the
+       entries below it: T[x4 + x7] <= T[x4] + T[x7] for x7 = 1 .. x4-1.
+       x6 keeps pointing at T[x4]. */
+    addi      x7, x0, 1
+    precompute_combine_loop:
+      /* (w8, w9, w10) <= T[x4] */
+      li        x2, 8
+      bn.lid    x2, 0(x6)
+      li        x2, 9
+      bn.lid    x2, 32(x6)
+      bn.addi   w10, w31, 1
+
+      /* Exit the loop once all combinations are done. */
+      beq       x7, x4, precompute_combine_done
+
+      /* (w11, w12, w13) <= T[x7] */
+      addi      x3, x7, -1
+      slli      x3, x3, 6
+      add       x3, x20, x3
+      li        x2, 11
+      bn.lid    x2, 0(x3)
+      li        x2, 12
+      bn.lid    x2, 32(x3)
+      bn.addi   w13, w31, 1
+
+      /* (w8, w9, w10) <= T[x4] + T[x7] */
+      jal       x1, proj_add
+      bn.mov    w8, w11
+      bn.mov    w9, w12
+      bn.mov    w10, w13
+
+      /* T[x4 + x7] <= affine form of (w8, w9, w10) */
+      jal       x1, proj_to_affine
+      add       x3, x4, x7
+      addi      x3, x3, -1
+      slli      x3, x3, 6
+      add       x3, x20, x3
+      li        x2, 11
+      bn.sid    x2, 0(x3)
+      li        x2, 12
+      bn.sid    x2, 32(x3)
+
+      addi      x7, x7, 1
+      jal       x0, precompute_combine_loop
+
+    precompute_combine_done:
+    /* Continue with the next power of two; (w8, w9, w10) holds T[x4]. */
+    bne       x4, x5, precompute_power_loop
+
+  ret
+
+/**
+ * P-256 ECDSA signature verification with a precomputed key table
+ *
+ * Computes the same result as `p256_verify`, i.e. the affine x-coordinate of
+ *         (x1, y1) = u1*G + u2*Q
+ *         with u1 = z*s^-1 mod n  and  u2 = r*s^-1 mod n
+ * but uses a fixed-base comb with four teeth for both G and Q instead of a
+ * plain double-and-add. The 256-bit scalars are split into four 64-bit limbs,
+ * and the loop runs over the 64 bit positions, adding at most one entry of
+ * each table per position:
+ *
+ *   C = O
+ *   for i in 63..0:
+ *     C = 2*C
+ *     C = C + T_G[u1[i] + 2*u1[64+i] + 4*u1[128+i] + 8*u1[192+i]]
+ *     C = C + T_Q[u2[i] + 2*u2[64+i] + 4*u2[128+i] + 8*u2[192+i]]
+ *
+ * This takes 64 doublings instead of 256, for roughly half of the point
+ * operations of `p256_verify`. The table for G is constant; the table for Q
+ * must have been computed by `p256_verify_precompute`. As a sanity check, the
+ * first entry of `q_table` must match the public key in `x` and `y`, otherwise
+ * the routine fails like it does for an invalid signature.
+ *
+ * This routine runs in variable time.
+ *
+ * @param[in]  dmem[msg]: message to be verified (256 bits)
+ * @param[in]  dmem[r]:   r component of signature (256 bits)
+ * @param[in]  dmem[s]:   s component of signature (256 bits)
+ * @param[in]  dmem[x]:   affine x-coordinate of public key (256 bits)
+ * @param[in]  dmem[y]:   affine y-coordinate of public key (256 bits)
+ * @param[in]  dmem[q_table]: comb table for the public key (15 * 512 bits)
+ * @param[out] dmem[ok]:  whether the signature passed basic checks (32 bits)
+ * @param[out] dmem[x_r]: dmem buffer for reduced affine x_r-coordinate (x_1)
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * clobbered registers: x2, x3, x9, x13, x14, x17 to x23, w0 to w30
+ * clobbered flag groups: FG0
+ */
+p256_verify_comb:
+
+  /* init all-zero register */
+  bn.xor    w31, w31, w31
+
+  /* load domain parameter b from dmem
+     w27 <= b = dmem[p256_b] */
+  li        x2, 27
+  la        x3, p256_b
+  bn.lid    x2, 0(x3)
+
+  /* setup modulus n (curve order) and Barrett constant
+     MOD <= w29 <= n = dmem[p256_n]; w28 <= u_n = dmem[p256_u_n]  */
+  li        x2, 29
+  la        x3, p256_n
+  bn.lid    x2, 0(x3)
+  bn.wsrw   MOD, w29
+  li        x2, 28
+  la        x3, p256_u_n
+  bn.lid    x2, 0(x3)
+
+  /* load s of signature from dmem: w0 = s = dmem[s] */
+  la        x20, s
+  bn.lid    x0, 0(x20)
+
+  /* Fail if w0 == w31 <=> s == 0 */
+  bn.cmp    w0, w31
+  csrrs     x2, FG0, x0
+  andi      x2, x2, 8
+  bne       x2, x0, p256_invalid_input
+
+  /* Fail if w0 >= w29 <=> s >= n */
+  bn.cmp    w0, w29
+  csrrs     x2, FG0, x0
+  andi      x2, x2, 1
+  beq       x2, x0, p256_invalid_input
+
+  /* w1 = s^-1  mod n */
+  jal       x1, mod_inv_var
+
+  /* load r of signature from dmem: w24 = r = dmem[r] */
+  la        x19, r
+  li        x2,  24
+  bn.lid    x2, 0(x19)
+
+  /* Fail if w24 == w31 <=> r == 0 */
+  bn.cmp    w24, w31
+  csrrs     x2, FG0, x0
+  andi      x2, x2, 8
+  bne       x2, x0, p256_invalid_input
+
+  /* Fail if w24 >= w29 <=> r >= n */
+  bn.cmp    w24, w29
+  csrrs     x2, FG0, x0
+  andi      x2, x2, 1
+  beq       x2, x0, p256_invalid_input
+
+  /* w25 = s^-1 = w1 */
+  bn.mov    w25, w1
+
+  /* u2 = w0 = w19 <= w24*w25 = r*s^-1 mod n */
+  jal       x1, mod_mul_256x256
+  bn.mov    w0, w19
+
+  /* load message, w24 = msg = dmem[msg] */
+  la        x18, msg
+  li        x2, 24
+  bn.lid    x2, 0(x18)
+
+  /* u1 = w1 = w19 <= w24*w25 = w24*w1 = msg*s^-1 mod n */
+  bn.mov    w25, w1
+  jal       x1, mod_mul_256x256
+  bn.mov    w1, w19
+
+  /* Fail if the first entry of the table is not the public key.
+     w11 <= dmem[x]; w12 <= dmem[q_table] */
+  la        x20, q_table
+  la        x21, x
+  li        x2, 11
+  bn.lid    x2, 0(x21)
+  li        x2, 12
+  bn.lid    x2, 0(x20)
+  bn.cmp    w11, w12
+  csrrs     x2, FG0, x0
+  andi      x2, x2, 8
+  beq       x2, x0, p256_invalid_input
+
+  /* w11 <= dmem[y]; w12 <= dmem[q_table + 32] */
+  la        x22, y
+  li        x2, 11
+  bn.lid    x2, 0(x22)
+  li        x2, 12
+  bn.lid    x2, 32(x20)
+  bn.cmp    w11, w12
+  csrrs     x2, FG0, x0
+  andi      x2, x2, 8
+  beq       x2, x0, p256_invalid_input
+
+  /* Set up for coordinate arithmetic.
+       MOD <= p
+       w28 <= r256
+       w29 <= r448 */
+  jal       x1, setup_modp
+
+  /* Move each 64-bit limb of u1 and u2 to the top of its own register, so
+     that doubling the register shifts the next bit of the limb into the carry
+     flag.
+       w2, w3, w4, w5 <= u1 << 192, u1 << 128, u1 << 64, u1
+       w6, w7, w26, w30 <= u2 << 192, u2 << 128, u2 << 64, u2 */
+  bn.rshi   w2, w1, w31 >> 64
+  bn.rshi   w3, w1, w31 >> 128
+  bn.rshi   w4, w1, w31 >> 192
+  bn.mov    w5, w1
+  bn.rshi   w6, w0, w31 >> 64
+  bn.rshi   w7, w0, w31 >> 128
+  bn.rshi   w26, w0, w31 >> 192
+  bn.mov    w30, w0
+
+  /* init C = (w11, w12, w13) with (0, 1, 0) */
+  bn.mov    w11, w31
+  bn.addi   w12, w31, 1
+  bn.mov    w13, w31
+
+  /* x23 <= pointer to the table for G; x20 still points to the table for Q */
+  la        x23, p256_comb_g_table
+  li        x13, 8
+  li        x14, 9
+
+  /* main loop with decreasing bit index i (i=63 downto 0) */
+  addi      x9, x0, 64
+  comb_loop:
+
+    /* always double: C = (w11,w12,w13) <= 2 (*) C = 2 (*) (w11,w12,w13) */
+    bn.mov    w8, w11
+    bn.mov    w9, w12
+    bn.mov    w10, w13
+    jal       x1, proj_add
+
+    /* x17 <= u1[i] + 2*u1[64+i] + 4*u1[128+i] + 8*u1[192+i] */
+    bn.add    w2, w2, w2
+    csrrs     x17, FG0, x0
+    andi      x17, x17, 1
+    bn.add    w3, w3, w3
+    csrrs     x2, FG0, x0
+    andi      x2, x2, 1
+    slli      x2, x2, 1
+    or        x17, x17, x2
+    bn.add    w4, w4, w4
+    csrrs     x2, FG0, x0
+    andi      x2, x2, 1
+    slli      x2, x2, 2
+    or        x17, x17, x2
+    bn.add    w5, w5, w5
+    csrrs     x2, FG0, x0
+    andi      x2, x2, 1
+    slli      x2, x2, 3
+    or        x17, x17, x2
+
+    /* if the index is zero, skip adding a multiple of G */
+    beq       x17, x0, comb_no_g
+
+    /* C <= C + T_G[x17] */
+    addi      x3, x17, -1
+    slli      x3, x3, 6
+    add       x3, x23, x3
+    bn.lid    x13, 0(x3)
+    bn.lid    x14, 32(x3)
+    bn.addi   w10, w31, 1
+    jal       x1, proj_add
+
+    comb_no_g:
+    /* x17 <= u2[i] + 2*u2[64+i] + 4*u2[128+i] + 8*u2[192+i] */
+    bn.add    w6, w6, w6
+    csrrs     x17, FG0, x0
+    andi      x17, x17, 1
+    bn.add    w7, w7, w7
+    csrrs     x2, FG0, x0
+    andi      x2, x2, 1
+    slli      x2, x2, 1
+    or        x17, x17, x2
+    bn.add    w26, w26, w26
+    csrrs     x2, FG0, x0
+    andi      x2, x2, 1
+    slli      x2, x2, 2
+    or        x17, x17, x2
+    bn.add    w30, w30, w30
+    csrrs     x2, FG0, x0
+    andi      x2, x2, 1
+    slli      x2, x2, 3
+    or        x17, x17, x2
+
+    /* if the index is zero, skip adding a multiple of Q */
+    beq       x17, x0, comb_no_q
+
+    /* C <= C + T_Q[x17] */
+    addi      x3, x17, -1
+    slli      x3, x3, 6
+    add       x3, x20, x3
+    bn.lid    x13, 0(x3)
+    bn.lid    x14, 32(x3)
+    bn.addi   w10, w31, 1
+    jal       x1, proj_add
+
+    comb_no_q:
+    addi      x9, x9, -1
+    bne       x9, x0, comb_loop
+
+  /* compute inverse of z-coordinate: w1 = z_c^-1  mod p */
+  bn.mov    w0, w13
+  jal       x1, mod_inv_var
+
+  /* convert x-coordinate of C back to affine: x1 = x_c * z_c^-1  mod p */
+  bn.mov    w24, w1
+  bn.mov    w25, w11
+  jal       x1, mul_modp
+
+  /* final reduction: w24 = x1 <= x1 mod n */
+  la        x3, p256_n
+  bn.lid    x0, 0(x3)
+  bn.wsrw   MOD, w0
+  bn.addm   w24, w19, w31
+
+  /* If we got here the basic validity checks passed, so set `ok` to true. */
+  la       x2, ok
+  addi     x3, x0, HARDENED_BOOL_TRUE
+  sw       x3, 0(x2)
+
+  /* store affine x-coordinate in dmem: dmem[x_r] = w24 = x_r */
+  la        x17, x_r
+  li        x2, 24
+  bn.sid    x2, 0(x17)
+
+  ret
+
+.section .data
+
+/* Comb table for the P-256 base point G, in the same layout as `q_table`:
+   15 affine points T[k] = k_0*G + k_1*2^64*G + k_2*2^128*G + k_3*2^192*G,
+   x-coordinate first. */
+.balign 32
+p256_comb_g_table:
+  /* T[1] = G */
+  .word 0xd898c296
+  .word 0xf4a13945
+  .word 0x2deb33a0
+  .word 0x77037d81
+  .word 0x63a440f2
+  .word 0xf8bce6e5
+  .word 0xe12c4247
+  .word 0x6b17d1f2
+  .word 0x37bf51f5
+  .word 0xcbb64068
+  .word 0x6b315ece
+  .word 0x2bce3357
+  .word 0x7c0f9e16
+  .word 0x8ee7eb4a
+  .word 0xfe1a7f9b
+  .word 0x4fe342e2
+  /* T[2] = 2^64 * G */
+  .word 0x8e14db63
+  .word 0x90e75cb4
+  .word 0xad651f7e
+  .word 0x29493baa
+  .word 0x326e25de
+  .word 0x8492592e
+  .word 0x2811aaa5
+  .word 0x0fa822bc
+  .word 0x5f462ee7
+  .word 0xe4112454
+  .word 0x50fe82f5
+  .word 0x34b1a650
+  .word 0xb3df188b
+  .word 0x6f4ad4bc
+  .word 0xf5dba80d
+  .word 0xbff44ae8
+  /* T[3] = (2^64 + 1) * G */
+  .word 0x097992af
+  .word 0x93391ce2
+  .word 0x0d35f1fa
+  .word 0xe96c98fd
+  .word 0x95e02789
+  .word 0xb257c0de
+  .word 0x89d6726f
+  .word 0x300a4bbc
+  .word 0xc08127a0
+  .word 0xaa54a291
+  .word 0xa9d806a5
+  .word 0x5bb1eead
+  .word 0xff1e3c6f
+  .word 0x7f1ddb25
+  .word 0xd09b4644
+  .word 0x72aac7e0
+  /* T[4] = 2^128 * G */
+  .word 0xd789bd85
+  .word 0x57c84fc9
+  .word 0xc297eac3
+  .word 0xfc35ff7d
+  .word 0x88c6766e
+  .word 0xfb982fd5
+  .word 0xeedb5e67
+  .word 0x447d739b
+  .word 0x72e25b32
+  .word 0x0c7e33c9
+  .word 0xa7fae500
+  .word 0x3d349b95
+  .word 0x3a4aaff7
+  .word 0xe12e9d95
+  .word 0x834131ee
+  .word 0x2d4825ab
+  /* T[5] = (2^128 + 1) * G */
+  .word 0x2a1d367f
+  .word 0x13949c93
+  .word 0x1a0a11b7
+  .word 0xef7fbd2b
+  .word 0xb91dfc60
+  .word 0xddc6068b
+  .word 0x8a9c72ff
+  .word 0xef951932
+  .word 0x7376d8a8
+  .word 0x196035a7
+  .word 0x95ca1740
+  .word 0x23183b08
+  .word 0x022c219c
+  .word 0xc1ee9807
+  .word 0x7dbb2c9b
+  .word 0x611e9fc3
+  /* T[6] = (2^128 + 2^64) * G */
+  .word 0x0b57f4bc
+  .word 0xcae2b192
+  .word 0xc6c9bc36
+  .word 0x2936df5e
+  .word 0xe11238bf
+  .word 0x7dea6482
+  .word 0x7b51f5d8
+  .word 0x55066379
+  .word 0x348a964c
+  .word 0x44ffe216
+  .word 0xdbdefbe1
+  .word 0x9fb3d576
+  .word 0x8d9d50e5
+  .word 0x0afa4001
+  .word 0x8aecb851
+  .word 0x15716484
+  /* T[7] = (2^128 + 2^64 + 1) * G */
+  .word 0xfc5cde01
+  .word 0xe48ecaff
+  .word 0x0d715f26
+  .word 0x7ccd84e7
+  .word 0xf43e4391
+  .word 0xa2e8f483
+  .word 0xb21141ea
+  .word 0xeb5d7745
+  .word 0x731a3479
+  .word 0xcac917e2
+  .word 0x2844b645
+  .word 0x85f22cfe
+  .word 0x58006cee
+  .word 0x0990e6a1
+  .word 0xdbecc17b
+  .word 0xeafd72eb
+  /* T[8] = 2^192 * G */
+  .word 0x313728be
+  .word 0x6cf20ffb
+  .word 0xa3c6b94a
+  .word 0x96439591
+  .word 0x44315fc5
+  .word 0x2736ff83
+  .word 0xa7849276
+  .word 0xa6d39677
+  .word 0xc357f5f4
+  .word 0xf2bab833
+  .word 0x2284059b
+  .word 0x824a920c
+  .word 0x2d27ecdf
+  .word 0x66b8babd
+  .word 0x9b0b8816
+  .word 0x674f8474
+  /* T[9] = (2^192 + 1) * G */
+  .word 0x677c8a3e
+  .word 0x2df48c04
+  .word 0x0203a56b
+  .word 0x74e02f08
+  .word 0xb8c7fedb
+  .word 0x31855f7d
+  .word 0x72c9ddad
+  .word 0x4e769e76
+  .word 0xb824bbb0
+  .word 0xa4c36165
+  .word 0x3b9122a5
+  .word 0xfb9ae16f
+  .word 0x06947281
+  .word 0x1ec00572
+  .word 0xde830663
+  .word 0x42b99082
+  /* T[10] = (2^192 + 2^64) * G */
+  .word 0xdda868b9
+  .word 0x6ef95150
+  .word 0x9c0ce131
+  .word 0xd1f89e79
+  .word 0x08a1c478
+  .word 0x7fdc1ca0
+  .word 0x1c6ce04d
+  .word 0x78878ef6
+  .word 0x1fe0d976
+  .word 0x9c62b912
+  .word 0xbde08d4f
+  .word 0x6ace570e
+  .word 0x12309def
+  .word 0xde53142c
+  .word 0x7b72c321
+  .word 0xb6cb3f5d
+  /* T[11] = (2^192 + 2^64 + 1) * G */
+  .word 0xc31a3573
+  .word 0x7f991ed2
+  .word 0xd54fb496
+  .word 0x5b82dd5b
+  .word 0x812ffcae
+  .word 0x595c5220
+  .word 0x716b1287
+  .word 0x0c88bc4d
+  .word 0x5f48aca8
+  .word 0x3a57bf63
+  .word 0xdf2564f3
+  .word 0x7c8181f4
+  .word 0x9c04e6aa
+  .word 0x18d1b5b3
+  .word 0xf3901dc6
+  .word 0xdd5ddea3
+  /* T[12] = (2^192 + 2^128) * G */
+  .word 0x3e72ad0c
+  .word 0xe96a79fb
+  .word 0x42ba792f
+  .word 0x43a0a28c
+  .word 0x083e49f3
+  .word 0xefe0a423
+  .word 0x6b317466
+  .word 0x68f344af
+  .word 0x3fb24d4a
+  .word 0xcdfe17db
+  .word 0x71f5c626
+  .word 0x668bfc22
+  .word 0x24d67ff3
+  .word 0x604ed93c
+  .word 0xf8540a20
+  .word 0x31b9c405
+  /* T[13] = (2^192 + 2^128 + 1) * G */
+  .word 0xa2582e7f
+  .word 0xd36b4789
+  .word 0x4ec39c28
+  .word 0x0d1a1014
+  .word 0xedbad7a0
+  .word 0x663c62c3
+  .word 0x6f461db9
+  .word 0x4052bf4b
+  .word 0x188d25eb
+  .word 0x235a27c3
+  .word 0x99bfcc5b
+  .word 0xe724f339
+  .word 0x71d70cc8
+  .word 0x862be6bd
+  .word 0x90b0fc61
+  .word 0xfecf4d51
+  /* T[14] = (2^192 + 2^128 + 2^64) * G */
+  .word 0xa1d4cfac
+  .word 0x74346c10
+  .word 0x8526a7a4
+  .word 0xafdf5cc0
+  .word 0xf62bff7a
+  .word 0x123202a8
+  .word 0xc802e41a
+  .word 0x1eddbae2
+  .word 0xd603f844
+  .word 0x8fa0af2d
+  .word 0x4c701917
+  .word 0x36e06b7e
+  .word 0x73db33a0
+  .word 0x0c45f452
+  .word 0x560ebcfc
+  .word 0x43104d86
+  /* T[15] = (2^192 + 2^128 + 2^64 + 1) * G */
+  .word 0x0d1d78e5
+  .word 0x9615b511
+  .word 0x25c4744b
+  .word 0x66b0de32
+  .word 0x6aaf363a
+  .word 0x0a4a46fb
+  .word 0x84f7a21c
+  .word 0xb48e26b4
+  .word 0x21a01b2d
+  .word 0x06ebb0f6
+  .word 0x8b7b0f98
+  .word 0xc004e404
+  .word 0xfed6f668
+  .word 0x64131bcd
+  .word 0x4d4d3dab
+  .word 0xfac01540
+
+.section .bss
+
+/* Success code for basic validity checks on the public key and signature.
+   Should be HARDENED_BOOL_TRUE or HARDENED_BOOL_FALSE. */
+.balign 4
+.weak ok
+ok:
+  .zero 4
+
+/* message digest */
+.balign 32
+.weak msg
+msg:
+  .zero 32
+
+/* signature R */
+.balign 32
+.weak r
+r:
+  .zero 32
+
+/* signature S */
+.balign 32
+.weak s
+s:
+  .zero 32
+
+/* public key x-coordinate */
+.balign 32
+.weak x
+x:
+  .zero 32
+
+/* public key y-coordinate */
+.balign 32
+.weak y
+y:
+  .zero 32
+
+/* verification result x_r (aka x_1) */
+.balign 32
+.weak x_r
+x_r:
+  .zero 32
+
+/* comb table for the public key (see `p256_verify_precompute`) */
+.balign 32
+.weak q_table
+q_table:
+  .zero 960
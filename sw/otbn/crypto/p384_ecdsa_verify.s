@@ -9,7 +9,25 @@
  * signature verification p384_curve_point_valid
  * binary has to be executed to check if the provided
  * public key is valid.
+ *
+ * This binary has the following modes of operation:
+ * 1. MODE_VERIFY: verify a signature, setting up the public key first
+ * 2. MODE_VERIFY_RESIDENT_KEY: verify a signature under the public key set up
+ *                              by the previous MODE_VERIFY run; DMEM must not
+ *                              have been modified since, except for `msg`,
+ *                              `r`, `s` and `mode`
+ */
+
+/**
+ * Mode magic values, with a mutual Hamming distance of 10.
+ *
+ * TODO(#17727): in some places the OTBN assembler support for .equ directives
+ * is lacking, so they cannot be used in bignum instructions or pseudo-ops such
+ * as `li`. If support is added, we could use 32-bit values here instead of
+ * 11-bit.
  */
+.equ MODE_VERIFY, 0x1d6
+.equ MODE_VERIFY_RESIDENT_KEY, 0x62b
 
 .section .text.start
 .globl start
@@ -17,7 +35,15 @@ start:
   /* Init all-zero register. */
   bn.xor    w31, w31, w31
 
-  jal       x1, ecdsa_verify
+  /* Read the mode and tail-call the requested operation. */
+  la        x2, mode
+  lw        x2, 0(x2)
+
+  addi      x3, x0, MODE_VERIFY
+  beq       x2, x3, ecdsa_verify
+
+  addi      x3, x0, MODE_VERIFY_RESIDENT_KEY
+  beq       x2, x3, ecdsa_verify_resident_key
 
   /* Invalid mode; fail. */
   unimp
@@ -50,6 +76,22 @@ ecdsa_verify:
 
   ecall
 
+/**
+ * P-384 ECDSA signature verification under the resident public key
+ *
+ * Same as `ecdsa_verify`, but skips the public key setup and reuses the
+ * precomputed points left in the scratchpad by the last `ecdsa_verify` run.
+ *
+ * @param[in]  dmem[msg]: message to be verified
+ * @param[in]    dmem[r]: r part of signature
+ * @param[in]    dmem[s]: s part of signature
+ * @param[out] dmem[x_r]: x1 coordinate to be compared to rs
+ */
+ecdsa_verify_resident_key:
+  jal      x1, p384_verify_resident
+
+  ecall
+
 .bss
 
 /* result of verify (x1 coordinate) */
@@ -60,6 +102,12 @@ x_r:
 
 .data
 
+/* Operation mode. */
+.globl mode
+.balign 4
+mode:
+  .zero 4
+
 /* Public key x-coordinate. */
 .globl x
 .balign 32
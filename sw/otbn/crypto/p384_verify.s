@@ -95,6 +95,8 @@ store_proj:
  * host side. The signature is valid if x1 == r.
  * This routine runs in variable time.
  *
+ * Equivalent to `p384_verify_key_setup` followed by `p384_verify_resident`.
+ *
  * @param[in]    dmem[r]: r component of signature in dmem
  * @param[in]    dmem[s]: s component of signature in dmem
  * @param[in]  dmem[msg]: message to be verified in dmem
@@ -120,6 +122,94 @@ store_proj:
  */
 .globl p384_verify
 p384_verify:
+  jal       x1, p384_verify_key_setup
+  jal       x1, p384_verify_resident
+  ret
+
+/**
+ * Prepare the public-key dependent part of P-384 ECDSA verification.
+ *
+ * Stores G, Q and G+Q in projective form in the scratchpad (see the layout in
+ * `p384_verify`). These points only depend on the public key, so several
+ * signatures under the same key can be checked with `p384_verify_resident`
+ * as long as the scratchpad is left untouched in between.
+ *
+ * @param[in]    dmem[x]: x-coordinate of public key in dmem
+ * @param[in]    dmem[y]: y-coordinate of public key in dmem
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * clobbered registers: x2, x3, x10 to x12, x22 to x28, w0 to w31
+ * clobbered flag groups: FG0
+ */
+.globl p384_verify_key_setup
+p384_verify_key_setup:
+
+  /* init all-zero reg */
+  bn.xor    w31, w31, w31
+
+  /* load domain parameter p (modulus)
+     [w13, w12] <= p = dmem[p384_p] */
+  li        x2, 12
+  la        x3, p384_p
+  bn.lid    x2++, 0(x3)
+  bn.lid    x2++, 32(x3)
+
+  /* set regfile pointers to in/out regs of Barrett routine */
+  li        x22, 10
+  li        x23, 11
+  li        x24, 16
+  li        x25, 17
+
+  /* set dmem pointer to domain parameter b */
+  la        x28, p384_b
+
+  /* load base point G and use in projective form (set z to 1)
+     G = (x,y,z) = scratchpad[192] <= (dmem[p384_gy], dmem[p384_gy], 1) */
+  la        x12, scratchpad
+  addi      x12, x12, 192
+  la        x10, p384_gx
+  la        x11, p384_gy
+  jal       x1, store_aff_proj
+
+  /* load public key Q from dmem and use in projective form (set z to 1)
+     Q = (x,y,z) = scratchpad[384] <= (dmem[x], dmem[y], 1) */
+  la        x10, x
+  la        x11, y
+  jal       x1,  store_aff_proj
+
+  /* Compute G+Q and store in dmem
+     GQ = (x,y,z) = dmem[dptr_sp+576]
+        <= sp[dptr_sp+192] (+) dmem[dptr_sp+384] */
+  la        x26, scratchpad
+  addi      x27, x26, 384
+  addi      x26, x26, 192
+  jal       x1, proj_add_p384
+  la        x12, scratchpad
+  addi      x12, x12, 576
+  jal       x1, store_proj
+
+  ret
+
+/**
+ * P-384 ECDSA signature verification with a prepared public key
+ *
+ * Same as `p384_verify`, but expects G, Q and G+Q to already be in the
+ * scratchpad from a previous call to `p384_verify_key_setup`. Only the
+ * scalars u1 and u2 and the point C are recomputed.
+ *
+ * @param[in]    dmem[r]: r component of signature in dmem
+ * @param[in]    dmem[s]: s component of signature in dmem
+ * @param[in]  dmem[msg]: message to be verified in dmem
+ * @param[out] dmem[x_r]: verification result: reduced affine x1-coordinate
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * clobbered registers: x2 to x5, x10, x11, x12, x22 to 28, w0 to w31
+ * clobbered flag groups: FG0
+ */
+.globl p384_verify_resident
+p384_verify_resident:
 
   /* init all-zero reg */
   bn.xor    w31, w31, w31
@@ -136,12 +226,6 @@ p384_verify:
   /* get dmem pointer of message */
   la        x9, msg
 
-  /* get dmem pointer of public key x-coordinate */
-  la        x13, x
-
-  /* get dmem pointer of public key y-coordinate */
-  la        x14, y
-
   /* load domain parameter n (order of base point)
      [w13, w12] <= n = dmem[p384_n] */
   li        x2, 12
@@ -264,31 +348,11 @@ p384_verify:
   la        x12, scratchpad
   jal       x1, store_proj
 
-  /* load base point G and use in projective form (set z to 1)
-     G = (x,y,z) = scratchpad[192] <= (dmem[p384_gy], dmem[p384_gy], 1) */
-  la        x10, p384_gx
-  la        x11, p384_gy
-  jal       x1, store_aff_proj
-
-  /* load public key Q from dmem and use in projective form (set z to 1)
-     Q = (x,y,z) = scratchpad[384] <= (dmem[*dptr_x], dmem[*dptr_y], 1) */
-  add       x10, x13, x0
-  add       x11, x14, x0
-  jal       x1,  store_aff_proj
-
   /* The remaining part of the routine implements a variable time
      double-and-add algorithm. For the signature verification we need to
      compute the point C = (x1, y1) = u1*G + _2*Q. This can be done in a
-     single double-and-add routine by using Shamir's Trick. */
-
-  /* Compute G+Q and store in dmem
-     GQ = (x,y,z) = dmem[dptr_sp+576]
-        <= sp[dptr_sp+192] (+) dmem[dptr_sp+384] */
-  la        x26, scratchpad
-  addi      x27, x26, 384
-  addi      x26, x26, 192
-  jal       x1, proj_add_p384
-  jal       x1, store_proj
+     single double-and-add routine by using Shamir's Trick. G, Q and G+Q are
+     already in the scratchpad (see `p384_verify_key_setup`). */
 
   la        x26, scratchpad
 
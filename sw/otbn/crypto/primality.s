@@ -114,11 +114,14 @@ miller_rabin_round:
        dmem[dptr_b:dptr_b+n*32] <= RND(n*32) ^ URND(n*32) = b */
   li       x23, 23
   addi     x2, x14, 0
-  loop     x30, 4
+  loop     x30, 5
     /* w22 <= URND() */
     bn.wsrr  w22, URND
     /* w23 <= RND() */
     bn.wsrr  w23, RND
+    /* Request the next RND value from EDN now, so that it is ready by the time
+       we read RND again (here or in the next round). */
+    csrrw    x0, RND_PREFETCH, x0
     /* w23 <= w22 ^ w23 */
     bn.xor   w23, w22, w23
     /* b[i] <= w23 */
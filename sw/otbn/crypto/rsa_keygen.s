@@ -949,8 +949,12 @@ _generate_q_counter_nonzero:
  *
  * For the candidate value p, this check passes only if:
  *   * GCD(p-1, 65537) = 1, and
+ *   * p has no odd prime factors below 200, and
  *   * p passes 5 rounds of the Miller-Rabin primality test.
  *
+ * The checks are ordered from cheapest to most expensive, and the routine
+ * returns as soon as one of them fails.
+ *
  * Assumes that the input is an odd number (this is a precondition for the
  * primality test) and that p >= sqrt(2)*(2^(nlen/2 - 1)), where nlen = RSA
  * public key length. Internally, `generate_prime_candidate` guarantees these
@@ -1017,6 +1021,26 @@ check_p:
   bn.addi  w20, w20, 1
   bn.sid   x20, 0(x16)
 
+  /* Check if p has any small odd prime factors. This rejects roughly 79% of
+     candidates without needing Montgomery setup or Miller-Rabin.
+       w22 <= GCD(p, 3*5*7*...*193) */
+  jal      x1, sieve_small_primes
+
+  /* Check that the GCD is 1.
+       FG0.Z <= (w22 == 1) */
+  bn.addi  w23, w31, 1
+  bn.cmp   w22, w23
+
+  /* Get the FG0.Z flag into a register.
+       x2 <= (CSRs[FG0] >> 3) & 1 = FG0.Z */
+  csrrs    x2, FG0, x0
+  srli     x2, x2, 3
+  andi     x2, x2, 1
+
+  /* If the flag is not set, then p is divisible by a small prime and we can
+     skip the remaining checks. */
+  beq      x2, x0, _check_prime_fail
+
   /* Load Montgomery constants for p.
        dmem[mont_m0inv] <= Montgomery constant m0'
        dmem[mont_rr] <= Montgomery constant RR */
@@ -1033,13 +1057,6 @@ check_p:
   li       x2, 256
   add      x15, x14, x2
 
-  /**
-   * TODO: add something like BoringSSL's is_obviously_composite to filter out
-   * numbers that are divisible by the first few hundred primes. This filters
-   * out 80-90% of composites without resorting to the very slow Miller-Rabin
-   * check.
-   */
-
   /* Calculate the number of Miller-Rabin rounds. The number of rounds is
      selected based on the bit-length according to FIPS 186-5, table B.1.
      According to that table, the minimums for an error probability matching
@@ -1180,9 +1197,13 @@ generate_prime_candidate:
   /* Generate random 256-bit limbs.
        dmem[x16..x16+(plen*32)] <= RND(n*32) ^ URND(n*32)  */
   addi     x2, x16, 0
-  loop     x30, 4
+  loop     x30, 5
     /* w20 <= RND() */
     bn.wsrr  w20, RND
+    /* Request the next RND value from EDN so that it arrives while we are
+       busy with other work (either the next limb, or the checks on this
+       candidate before a new one is needed). */
+    csrrw    x0, RND_PREFETCH, x0
     /* w21 <= URND() */
     bn.wsrr  w21, URND
     /* w20 <= w20 ^ w21 */
@@ -1353,6 +1374,109 @@ relprime_f4:
 
   ret
 
+/**
+ * Check if a large number has any small odd prime factors.
+ *
+ * Returns GCD(x, M), where M = 3 * 5 * 7 * ... * 193 is the product of all odd
+ * primes up to 193 (the largest such product that fits in 256 bits). The
+ * result is 1 if and only if x is not divisible by any of those primes; about
+ * 79% of random odd numbers fail this check, so it is a cheap way to reject
+ * most composite candidates before running the much slower Miller-Rabin test.
+ * This is similar in spirit to BoringSSL's
+ * `bn_odd_number_is_obviously_composite`.
+ *
+ * We compute r = x mod M with a constant-time division, and then compute
+ * GCD(r, M), which is equal to GCD(x, M), with single-limb operands.
+ *
+ * Uses `tmp_scratchpad` for the division and `mont_rr` and `mont_m0inv` as
+ * temporary buffers, so the Montgomery constants must be (re)computed after
+ * calling this routine.
+ *
+ * Flags: Flags have no meaning beyond the scope of this subroutine.
+ *
+ * @param[in]  x16: dptr_x, pointer to first limb of x in dmem
+ * @param[in]  x20: 20, constant
+ * @param[in]  x30: plen, number of 256-bit limbs for x
+ * @param[in]  x31: plen-1, constant
+ * @param[in]  w31: all-zero
+ * @param[out] w22: result, GCD(x, M)
+ *
+ * clobbered registers: x2, x3, x5 to x8, x10 to x12, x22 to x25,
+ *                      w20 to w27
+ * clobbered flag groups: FG0, FG1
+ */
+sieve_small_primes:
+  /* Save registers that are clobbered by `div` or `gcd`. */
+  addi     x6, x30, 0
+  addi     x7, x4, 0
+
+  /* Copy x into the temporary buffer, since division overwrites the
+     numerator with the remainder.
+       dmem[tmp_scratchpad..tmp_scratchpad+(plen*32)] <= x */
+  addi     x2, x16, 0
+  la       x3, tmp_scratchpad
+  loop     x30, 2
+    bn.lid   x20, 0(x2++)
+    bn.sid   x20, 0(x3++)
+
+  /* Write M, zero-padded to plen limbs, into `mont_rr`.
+       dmem[mont_rr..mont_rr+(plen*32)] <= M */
+  la       x2, small_primes_product
+  bn.lid   x20, 0(x2)
+  la       x2, mont_rr
+  bn.sid   x20, 0(x2++)
+  li       x3, 31
+  loop     x31, 1
+    bn.sid   x3, 0(x2++)
+
+  /* Reduce x modulo M.
+       dmem[tmp_scratchpad] <= x mod M */
+  la       x10, tmp_scratchpad
+  la       x11, mont_rr
+  li       x2, 256
+  add      x12, x10, x2
+  jal      x1, div
+
+  /* Copy M into `mont_m0inv`; `gcd` overwrites both of its inputs.
+       dmem[mont_m0inv] <= M */
+  la       x2, small_primes_product
+  li       x3, 20
+  bn.lid   x3, 0(x2)
+  la       x11, mont_m0inv
+  bn.sid   x3, 0(x11)
+
+  /* Compute the GCD of the single-limb remainder and M. Since M is odd and
+     nonzero, this is well-defined even if the remainder is 0.
+       dmem[mont_m0inv] <= GCD(x mod M, M) */
+  la       x10, tmp_scratchpad
+  li       x30, 1
+  jal      x1, gcd
+
+  /* w22 <= dmem[mont_m0inv] = GCD(x, M) */
+  li       x2, 22
+  bn.lid   x2, 0(x11)
+
+  /* Restore registers. */
+  addi     x30, x6, 0
+  addi     x4, x7, 0
+  li       x21, 21
+
+  ret
+
+.data
+
+/* Product of all odd primes from 3 to 193, M = 3 * 5 * 7 * ... * 193. */
+.balign 32
+small_primes_product:
+  .word 0x2be98677
+  .word 0xc05b9335
+  .word 0x819aed2a
+  .word 0x9f155887
+  .word 0x43958688
+  .word 0xf5243551
+  .word 0x5654b3c0
+  .word 0xdbf05b6f
+
 .section .scratchpad
 
 /* Extra label marking the start of p || q in memory. The `derive_d` function
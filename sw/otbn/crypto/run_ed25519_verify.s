@@ -0,0 +1,69 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+.section .text.start
+
+/**
+ * Standalone embeddable wrapper for Ed25519 signature verification.
+ *
+ * The SHA-512 hash k = SHA-512(enc(R) || enc(A) || M) is computed by the
+ * caller and passed in as a 512-bit little-endian integer.
+ *
+ * @param[in] dmem[ed25519_hash_k]: k, 512-bit hash (64 bytes)
+ * @param[in] dmem[ed25519_sig]: signature enc(R) || S (64 bytes)
+ * @param[in] dmem[ed25519_public_key]: enc(A), encoded public key (32 bytes)
+ * @param[out] dmem[ed25519_verify_result]: HARDENED_BOOL_TRUE if the signature
+ *                                          is valid, otherwise
+ *                                          HARDENED_BOOL_FALSE
+ */
+run_ed25519_verify:
+  /* Load the inputs.
+       [w1:w0] <= k
+       w2 <= enc(R)
+       w3 <= S
+       w4 <= enc(A) */
+  li       x2, 0
+  la       x3, ed25519_hash_k
+  bn.lid   x2++, 0(x3)
+  bn.lid   x2++, 32(x3)
+  la       x3, ed25519_sig
+  bn.lid   x2++, 0(x3)
+  bn.lid   x2++, 32(x3)
+  la       x3, ed25519_public_key
+  bn.lid   x2, 0(x3)
+
+  /* x2 <= verification result */
+  jal      x1, ed25519_verify_var
+
+  /* dmem[ed25519_verify_result] <= x2 */
+  la       x3, ed25519_verify_result
+  sw       x2, 0(x3)
+
+  ecall
+
+.bss
+
+/* 512-bit hash k. */
+.globl ed25519_hash_k
+.balign 32
+ed25519_hash_k:
+  .zero 64
+
+/* Signature enc(R) || S. */
+.globl ed25519_sig
+.balign 32
+ed25519_sig:
+  .zero 64
+
+/* Encoded public key enc(A). */
+.globl ed25519_public_key
+.balign 32
+ed25519_public_key:
+  .zero 32
+
+/* Verification result. */
+.globl ed25519_verify_result
+.balign 4
+ed25519_verify_result:
+  .zero 4
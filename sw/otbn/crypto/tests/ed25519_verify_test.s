@@ -0,0 +1,98 @@
+/* Copyright lowRISC contributors (OpenTitan project). */
+/* Licensed under the Apache License, Version 2.0, see LICENSE for details. */
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/**
+ * Standalone Ed25519 signature verification test
+ *
+ * Uses TEST 2 from RFC 8032, section 7.1 (a one-byte message 0x72). The
+ * signature is verified once with the correct hash and once with a corrupted
+ * hash, which must be rejected.
+ *
+ * The result of the first verification is written to x20 and the result of
+ * the second to x21.
+ */
+
+.section .text.start
+
+ed25519_verify_test:
+  /* Load the inputs.
+       [w1:w0] <= k
+       w2 <= enc(R)
+       w3 <= S
+       w4 <= enc(A) */
+  li       x2, 0
+  la       x3, hash_k
+  bn.lid   x2++, 0(x3)
+  bn.lid   x2++, 32(x3)
+  la       x3, sig
+  bn.lid   x2++, 0(x3)
+  bn.lid   x2++, 32(x3)
+  la       x3, public_key
+  bn.lid   x2, 0(x3)
+
+  /* x20 <= verification result for the correct hash */
+  jal      x1, ed25519_verify_var
+  addi     x20, x2, 0
+
+  /* Corrupt the hash and verify again.
+       x21 <= verification result for the corrupted hash */
+  bn.addi  w0, w0, 1
+  jal      x1, ed25519_verify_var
+  addi     x21, x2, 0
+
+  ecall
+
+.data
+
+/* Hash k = SHA-512(enc(R) || enc(A) || M) (64 bytes) */
+.balign 32
+hash_k:
+  .word 0x0ddf71a2
+  .word 0xbd030d2b
+  .word 0x9aedb417
+  .word 0xdffd6a4b
+  .word 0x7f28732e
+  .word 0xa1f130d6
+  .word 0xe87cd837
+  .word 0xcc91a573
+  .word 0x85ddb631
+  .word 0xddb5982a
+  .word 0x99fe2612
+  .word 0x2728823d
+  .word 0x1fa2eb8c
+  .word 0x95fcb880
+  .word 0xd7706a98
+  .word 0xaf3fdf1e
+
+/* Signature enc(R) || S (64 bytes) */
+.balign 32
+sig:
+  .word 0xa909a092
+  .word 0xb8cad4f0
+  .word 0x0b820e72
+  .word 0x4025645f
+  .word 0x547bb2a2
+  .word 0x8f3f5016
+  .word 0x232276b3
+  .word 0xda69dbeb
+  .word 0xe4c15a08
+  .word 0x6e99153e
+  .word 0x13368f45
+  .word 0x8c1df1d0
+  .word 0xae2e7b38
+  .word 0xee2a30b4
+  .word 0x16290db0
+  .word 0x000cbb12
+
+/* Public key enc(A) */
+.balign 32
+public_key:
+  .word 0xc317403d
+  .word 0x5a8943e8
+  .word 0xa70ab792
+  .word 0xbc7e1b4d
+  .word 0xcf2c989c
+  .word 0x8c96c42e
+  .word 0xf155cdc0
+  .word 0x0c66f42a
@@ -74,6 +74,9 @@ Original Author: Shay Gal-on
 #define COMPILER_FLAGS \
      "Please put compiler flags here (e.g. -o3)"
 #endif
+#ifndef COREMARK_CONFIG
+#define COREMARK_CONFIG "default"
+#endif
 #ifndef MEM_LOCATION
 #define MEM_LOCATION "STACK"
 #endif
@@ -92,6 +95,7 @@ typedef signed int     ee_s32;
 typedef double         ee_f32;
 typedef unsigned char  ee_u8;
 typedef unsigned int   ee_u32;
+typedef unsigned long long ee_u64;
 typedef ee_u32         ee_ptr_int;
 typedef size_t         ee_size_t;
 
@@ -108,7 +112,7 @@ typedef size_t         ee_size_t;
 /* Configuration : CORE_TICKS
         Define type of return from the timing functions.
  */
-#define CORETIMETYPE ee_u32
+#define CORETIMETYPE ee_u64
 typedef ee_u32 CORE_TICKS;
 
 /* Configuration : SEED_METHOD
@@ -19,11 +19,83 @@ import re
 import sys
 
 
+PROFILE_DATA_RE = re.compile(
+    r"""
+        LLVM\ profile\ data\ \(length:\ (?P<len>\d+)\ bytes,\ CRC32:\ (?P<crc>0x[0-9a-f]*)
+        (,\ encoding:\ (?P<encoding>[a-z-]+))?\):
+        (?P<data> (0x)? [0-9a-f]+)
+        [\x04\x17]
+    """, re.VERBOSE)
+
+
+def decode_zero_rle(data):
+    """Decode zero-RLE encoded profile data.
+
+    The encoding is a sequence of runs, each starting with a control byte `c`:
+    `c < 0x80` is followed by `c + 1` literal bytes, `c >= 0x80` stands for
+    `(c & 0x7f) + 1` zero bytes.
+
+    Args:
+        data: Encoded data.
+    Returns:
+        Decoded data.
+    Raises:
+        ValueError: If the last literal run is truncated.
+    """
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        ctrl = data[i]
+        i += 1
+        if ctrl & 0x80:
+            out += bytes((ctrl & 0x7f) + 1)
+        else:
+            run = ctrl + 1
+            if i + run > len(data):
+                raise ValueError('Truncated zero-RLE literal run.')
+            out += data[i:i + run]
+            i += run
+    return bytes(out)
+
+
+def _decode_profile(match):
+    """Decode and verify a single profile matched by `PROFILE_DATA_RE`."""
+    exp_length = int(match.group('len'))
+    exp_checksum = int(match.group('crc'), 0)
+    encoding = match.group('encoding')
+    data = match.group('data')
+    if encoding is None:
+        # Legacy format: a single big-endian hex number.
+        byte_array = int(data, 0).to_bytes(len(data) // 2 - 1,
+                                           byteorder='little',
+                                           signed=False)
+    elif encoding == 'zero-rle':
+        if len(data) % 2 != 0:
+            raise ValueError('Odd number of hex digits in profile data.')
+        byte_array = decode_zero_rle(bytes.fromhex(data))
+    else:
+        raise ValueError(f'Unknown profile data encoding: {encoding}.')
+    # Check length
+    act_length = len(byte_array)
+    if act_length != exp_length:
+        raise ValueError(('Length check failed! ',
+                          f'Expected: {exp_length}, actual: {act_length}.'))
+    # Check checksum
+    act_checksum = zlib.crc32(byte_array)
+    if act_checksum != exp_checksum:
+        raise ValueError(
+            ('Checksum check failed! ',
+             f'Expected: {exp_checksum}, actual: {act_checksum}.'))
+    return byte_array
+
+
 def extract_profile_data(device_output):
     """Parse device output to extract LLVM profile data.
 
     This function returns the LLVM profile data as a byte array after
-    verifying its length and checksum.
+    verifying its length and checksum. If the device sent several profiles,
+    e.g. at checkpoints, they are concatenated, which `llvm-profdata merge`
+    accepts and accumulates.
 
     Args:
         device_output: Device output.
@@ -39,32 +111,11 @@ def extract_profile_data(device_output):
                            flags=re.MULTILINE)
     device_output = device_output.translate(
         device_output.maketrans('', '', '\r\n'))
-    match = re.search(
-        r"""
-            LLVM\ profile\ data\ \(length:\ (?P<len>\d+)\ bytes,\ CRC32:\ (?P<crc>0x[0-9a-f]*)\):
-            (?P<data> 0x [0-9a-f]+)
-            \x04
-        """, device_output, re.VERBOSE)
-    if not match:
+    matches = list(PROFILE_DATA_RE.finditer(device_output))
+    if not matches:
         raise ValueError(
             'Could not detect LLVM profile data in device output.')
-    exp_length = int(match.group('len'))
-    exp_checksum = int(match.group('crc'), 0)
-    byte_array = int(match.group('data'), 0).to_bytes(len(match.group('data')) // 2 - 1,
-                                                      byteorder='little',
-                                                      signed=False)
-    # Check length
-    act_length = len(byte_array)
-    if act_length != exp_length:
-        raise ValueError(('Length check failed! ',
-                          f'Expected: {exp_length}, actual: {act_length}.'))
-    # Check checksum
-    act_checksum = zlib.crc32(byte_array)
-    if act_checksum != exp_checksum:
-        raise ValueError(
-            ('Checksum check failed! ',
-             f'Expected: {exp_checksum}, actual: {act_checksum}.'))
-    return byte_array
+    return b''.join(_decode_profile(m) for m in matches)
 
 
 def main():
@@ -192,5 +192,62 @@ I00034 status.c:28] PASS!\r
         self.assertEqual(zlib.crc32(raw_profile_data), 0x79a3fcf1)
 
 
+    def test_good_zero_rle_data(self):
+        DEVICE_OUTPUT = """
+I00001 coverage_test.c:37] Collecting coverage data.\r
+I00002 ottf_main.c:100] Finished sw/device/tests/coverage_test.c\r
+I00003 coverage_llvm.c:133] LLVM profile data (length: 1184 bytes, CRC32: 0x79a3fcf1, encoding: zero-rle):\r
+I00004 coverage_llvm.c:64] 088152666f72706cff078e000a8e000d8e014a028503582000108303144c00208300018608db41eb\r
+I00005 coverage_llvm.c:64] 50c84b489e188603582000108700018a070b5e9e389b4844e28703602000108700018a0b35fced9e\r
+I00006 coverage_llvm.c:64] 3b706bb7912644028303682000108700038a08f054ff15af3984f6188603802000108700018a08f4\r
+I00007 coverage_llvm.c:64] c72f55dddab055188603882000108700018a09ac122275b3b32f4358248503902000108700028a08\r
+I00008 coverage_llvm.c:64] d13086a85b786628188603a02000108700018a08ea8744750aa13a03188603a82000108700018a07\r
+I00009 coverage_llvm.c:64] 69fc300f8c986f1e8703b02000108700018a0704d04aef3511c9e58703b8200010870001f27fe608\r
+I00010 coverage_llvm.c:64] cc0278da7d52cb728420102c7f2887e4b2959f99620137538b606008d1afcf28ea2e48f6824d4ff7\r
+I00011 coverage_llvm.c:64] bc240a4f8016a98b8cdee4e7f201af83ce0c8c91e497f045987ea18fc6d41c2aa3b32979a40d06b4\r
+I00012 coverage_llvm.c:64] f7ee8ad4a3360ad6f3e39d0b087566b3eda01930496e8fd7913249e69a29a41ba7e76a76397ce0e6\r
+I00013 coverage_llvm.c:64] 343da7952e5a7f02c369d1de60d6dee9708e931768da82d18daba6e004b73415dd4fa44312e33387\r
+I00014 coverage_llvm.c:64] 81cd497b703d50721c1a06743ce20d9d85debb018452be6097f92f27a6b2ae0bb93428085f427149\r
+I00015 coverage_llvm.c:64] 758eb552f01a9b86a5240c22dc2bd34d53de7ec15a6705b90125485eb36f191f12fe3b2dc1da0e38\r
+I00016 coverage_llvm.c:64] 6ba6ff14658afdf5bcc8d192d4adbe7f1a263487ad8a648111d12aed1f287557e13daed4865227f9\r
+I00017 coverage_llvm.c:64] 6d1a9a99ca286e487fcf07ca400eeee790cdbb33a65dbe83b48b5327ae01b63e9707745cb7a752dd\r
+I00018 coverage_llvm.c:64] 1fbfbdf071cd52d8200eeb1f03e2a9c68c05f60178da6d905d7283300c84871bf5e7a5b7d1085b24\r
+I00019 coverage_llvm.c:64] 9a31d895056e387d0584008117cffad3ee5ac035fd41936e7f080349e6d8553c11f45e40a8c5041f\r
+I00020 coverage_llvm.c:64] 90494ff473a65867685b8e06d1ff6cd722ac74ba43bea38f85fc31f7fdf566bc005bb4202b345180\r
+I00021 coverage_llvm.c:64] 3b25913ed96e0edd9d0c0c18d8a35255b3364cc1c37c5a7c7ae74ce7f20d9b30a8719dbf4f8e250b\r
+I00022 coverage_llvm.c:64] bbac70313df6af75d32159a77fb6af75b1ef1482d57277839124523ecf5590c3b54921c5347b0e0c\r
+I00023 coverage_llvm.c:64] 6da5c761fb87522e98f68cb3850b09c406b4441b05ec3b4fb2a952d528c2337aaa5239fb88a0a3a1\r
+I00024 coverage_llvm.c:64] 45f54f45bfe34b2dc2b57178d9c635d997d5be8ab29acb3f0194f32185\r
+\x04\r
+I00025 status.c:28] PASS!\r
+"""  # noqa: E501
+        raw_profile_data = extract_profile_data(DEVICE_OUTPUT)
+        self.assertEqual(len(raw_profile_data), 1184)
+        self.assertEqual(zlib.crc32(raw_profile_data), 0x79a3fcf1)
+
+    def test_checkpoints(self):
+        # A checkpoint terminated by ETB followed by the final profile.
+        DEVICE_OUTPUT = """
+I00001 coverage_llvm.c:133] LLVM profile data (length: 16 bytes, CRC32: 0xea556b55, encoding: zero-rle):\r
+I00002 coverage_llvm.c:64] 0101028d\r
+\x17\r
+I00003 checkpoint_test.c:42] Checkpoint.\r
+I00004 coverage_llvm.c:133] LLVM profile data (length: 16 bytes, CRC32: 0x75b21aef, encoding: zero-rle):\r
+I00005 coverage_llvm.c:64] 8e0003\r
+\x04\r
+"""  # noqa: E501
+        raw_profile_data = extract_profile_data(DEVICE_OUTPUT)
+        self.assertEqual(raw_profile_data,
+                         bytes([1, 2] + [0] * 14 + [0] * 15 + [3]))
+
+    def test_truncated_zero_rle_data(self):
+        DEVICE_OUTPUT = """
+I00001 coverage_llvm.c:133] LLVM profile data (length: 4 bytes, CRC32: 0x00000000, encoding: zero-rle):\r
+I00002 coverage_llvm.c:64] 030102\r
+\x04\r
+"""  # noqa: E501
+        with self.assertRaisesRegex(ValueError, "Truncated"):
+            extract_profile_data(DEVICE_OUTPUT)
+
 if __name__ == '__main__':
     unittest.main()
@@ -32,21 +32,23 @@ C_SRC_TOP = """
 #include "secded_enc.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 // Calculates even parity for a 64-bit word
-static uint8_t calc_parity(uint64_t word, bool invert) {
-  bool parity = false;
-
-  while (word) {
-    if (word & 1) {
-      parity = !parity;
-    }
-
-    word >>= 1;
-  }
-
-  return parity ^ invert;
+static inline uint8_t calc_parity(uint64_t word, bool invert) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint8_t)__builtin_parityll(word) ^ invert;
+#else
+  word ^= word >> 32;
+  word ^= word >> 16;
+  word ^= word >> 8;
+  word ^= word >> 4;
+  word ^= word >> 2;
+  word ^= word >> 1;
+
+  return (uint8_t)(word & 1) ^ invert;
+#endif
 }
 """
 
@@ -54,6 +56,7 @@ C_H_TOP = """
 #ifndef OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 #define OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -61,8 +64,12 @@ extern "C" {
 #endif  // __cplusplus
 
 // Integrity encode functions for varying bit widths matching the functionality
-// of the RTL modules of the same name. Each takes an array of bytes in
-// little-endian order and returns the calculated integrity bits.
+// of the RTL modules of the same name. For each code there are three variants:
+// - enc_secded_<n>_<k>() takes an array of bytes in little-endian order and
+//   returns the calculated integrity bits.
+// - enc_secded_<n>_<k>_word() takes the data as a single integer.
+// - enc_secded_<n>_<k>_words() encodes `count` data words from `words`,
+//   writing the integrity bits of each to `check_bits`.
 
 """
 
@@ -650,19 +657,13 @@ def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
     assert codetype in ["hsiao", "inv_hsiao"]
     invert = (codetype == "inv_hsiao")
 
-    with open(c_src_filename, "a") as f:
-        # Write out function prototype in src
-        f.write(f"\n{out_type} enc_secded{suffix}_{n}_{k}"
-                f"(const uint8_t bytes[{in_bytes}]) {{\n")
-
-        # Form a single word from the incoming byte data
-        f.write(f"{in_type} word = ")
-        f.write(" | ".join(
-                [f"(({in_type})bytes[{i}] << {i*8})" for i in range(in_bytes)]))
-        f.write(";\n\n")
+    name = f"enc_secded{suffix}_{n}_{k}"
 
-        # AND the word with the codes, calculating parity of each and combine
-        # into a single word of integrity bits
+    with open(c_src_filename, "a") as f:
+        # Write out the word-wide encoder: AND the word with the codes,
+        # calculating parity of each and combine into a single word of
+        # integrity bits
+        f.write(f"\n{out_type} {name}_word({in_type} word) {{\n")
         f.write("return ")
         parity_bit_masks = enumerate(calc_bitmasks(k, m, codes, False))
         # Add ECC bit inversion if needed (see print_enc function).
@@ -670,13 +671,30 @@ def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
                 [f"(calc_parity(word & 0x{mask:x}, "
                  f"{'true' if invert and (par_bit % 2) else 'false'}) << {par_bit})"
                  for par_bit, mask in parity_bit_masks]))
-
         f.write(";\n}\n")
 
+        # Write out the byte-array encoder, which forms a single word from the
+        # incoming byte data
+        f.write(f"\n{out_type} {name}(const uint8_t bytes[{in_bytes}]) {{\n")
+        f.write(f"{in_type} word = ")
+        f.write(" | ".join(
+                [f"(({in_type})bytes[{i}] << {i*8})" for i in range(in_bytes)]))
+        f.write(";\n\n")
+        f.write(f"return {name}_word(word);\n}}\n")
+
+        # Write out the batch encoder
+        f.write(f"\nvoid {name}_words(const {in_type} *words, "
+                f"{out_type} *check_bits, size_t count) {{\n")
+        f.write("for (size_t i = 0; i < count; ++i) {\n")
+        f.write(f"check_bits[i] = {name}_word(words[i]);\n")
+        f.write("}\n}\n")
+
     with open(c_h_filename, "a") as f:
-        # Write out function declaration in header
-        f.write(f"{out_type} enc_secded{suffix}_{n}_{k}"
-                f"(const uint8_t bytes[{in_bytes}]);\n")
+        # Write out function declarations in header
+        f.write(f"{out_type} {name}(const uint8_t bytes[{in_bytes}]);\n")
+        f.write(f"{out_type} {name}_word({in_type} word);\n")
+        f.write(f"void {name}_words(const {in_type} *words, "
+                f"{out_type} *check_bits, size_t count);\n")
 
 
 def format_c_files(c_src_filename, c_h_filename):